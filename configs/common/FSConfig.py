@@ -665,7 +665,8 @@ def makeDistRoot(testSystem,
                  sync_start,
                  linkspeed,
                  linkdelay,
-                 dumpfile):
+                 dumpfile,
+                 transport='tcp'):
     self = Root(full_system = True)
     self.testsys = testSystem
 
@@ -675,6 +676,7 @@ def makeDistRoot(testSystem,
                                    dist_size = size,
                                    server_name = server_name,
                                    server_port = server_port,
+                                   transport = transport,
                                    sync_start = sync_start,
                                    sync_repeat = sync_repeat)
 
@@ -262,6 +262,15 @@ def config_mem(options, system):
     for i in range(len(nvm_intfs)):
         mem_ctrls[i].nvm = nvm_intfs[i];
 
+    # Optionally put a single multi-channel controller in front of the
+    # channels, removing the memory bus hop to them
+    opt_multi_channel = getattr(options, "mem_multi_channel", False)
+    if opt_multi_channel and opt_mem_type == "HMC_2500_1x32":
+        fatal("The HMC memory type does not support --mem-multi-channel")
+    if opt_multi_channel:
+        subsystem.mem_multi_channel = m5.objects.MultiChannelMemCtrl()
+        subsystem.mem_multi_channel.port = xbar.mem_side_ports
+
     # Connect the controller to the xbar port
     for i in range(len(mem_ctrls)):
         if opt_mem_type == "HMC_2500_1x32":
@@ -270,6 +279,9 @@ def config_mem(options, system):
             # Set memory device size. There is an independent controller
             # for each vault. All vaults are same size.
             mem_ctrls[i].dram.device_size = options.hmc_dev_vault_size
+        elif opt_multi_channel:
+            # Connect the controllers to the multi-channel controller
+            mem_ctrls[i].port = subsystem.mem_multi_channel.channel_ports
         else:
             # Connect the controllers to the membus
             mem_ctrls[i].port = xbar.mem_side_ports
@@ -113,6 +113,10 @@ def addNoISAOptions(parser):
                        help="Enable low-power states in DRAMInterface")
     parser.add_option("--mem-channels-intlv", type="int", default=0,
                       help="Memory channels interleave")
+    parser.add_option("--mem-multi-channel", action="store_true",
+                      help="Connect the memory channels to a single "
+                      "multi-channel controller rather than to the "
+                      "memory bus")
 
 
     parser.add_option("--memchecker", action="store_true")
@@ -238,6 +242,11 @@ def addCommonOptions(parser):
                       help="""Data dependency trace file input to
                       Elastic Trace probe in a capture simulation and
                       Trace CPU in a replay simulation""", default="")
+    parser.add_option("--branch-trace-file", action="store", type="string",
+                      help="""Record the branches committed by each CPU
+                      to this file, with the CPU number appended when there
+                      are several, for replay by bpred_replay.py""",
+                      default="")
 
     parser.add_option("-l", "--lpae", action="store_true")
     parser.add_option("-V", "--virtualisation", action="store_true")
@@ -262,10 +271,17 @@ def addCommonOptions(parser):
                       default=2200,
                       action="store", type="int",
                       help="Message server listen port\nDEFAULT: 2200")
+    parser.add_option("--dist-transport", default="tcp",
+                      choices=["tcp", "shm"],
+                      help="Transport between the dist-gem5 processes, shm "
+                      "needs them all to run on the same host\nDEFAULT: tcp")
     parser.add_option("--dist-sync-repeat",
                       default="0us",
                       action="store", type="string",
                       help="Repeat interval for synchronisation barriers among dist-gem5 processes\nDEFAULT: --ethernet-linkdelay")
+    parser.add_option("--dist-sync-skip-idle", action="store_true",
+                      help="Let the switch skip the dist-gem5 sync barriers "
+                      "while none of the nodes has anything to do")
     parser.add_option("--dist-sync-start",
                       default="5200000000000t",
                       action="store", type="string",
@@ -346,6 +362,35 @@ def addCommonOptions(parser):
     parser.add_option("-p", "--prog-interval", type="str",
         help="CPU Progress Interval")
 
+    # Sampled simulation, see m5.sampling
+    parser.add_option("--sample-interval", action="store", type="int",
+        default=None,
+        help="take a detailed sample every <N> instructions, running the "
+        "atomic or KVM CPU in between")
+    parser.add_option("--sample-warmup", action="store", type="int",
+        default=2000,
+        help="detailed warm-up instructions before each sample")
+    parser.add_option("--sample-length", action="store", type="int",
+        default=1000, help="instructions measured per sample")
+    parser.add_option("--sample-cpu-type", action="store", type="choice",
+        default="DerivO3CPU", choices=ObjectList.cpu_list.get_names(),
+        help="CPU type used for the samples")
+    parser.add_option("--sample-error", action="store", type="float",
+        default=0.03,
+        help="stop once the confidence interval is within this relative "
+        "error of the mean")
+    parser.add_option("--sample-confidence", action="store", type="float",
+        default=0.997, help="confidence level of the sampling interval")
+    parser.add_option("--sample-max", action="store", type="int",
+        default=None, help="maximum number of samples")
+    parser.add_option("--sample-warming-window", action="store", type="int",
+        default=65536,
+        help="with a KVM CPU type, number of sampled loads replayed into "
+        "the caches and TLBs before each sample")
+    parser.add_option("--sample-warming-period", action="store", type="int",
+        default=97,
+        help="with a KVM CPU type, sample one in <N> loads for warming")
+
     # Fastforwarding and simpoint related materials
     parser.add_option("-W", "--warmup-insts", action="store", type="int",
         default=None,
@@ -355,6 +400,9 @@ def addCommonOptions(parser):
     parser.add_option("-F", "--fast-forward", action="store", type="string",
         default=None,
         help="Number of instructions to fast forward before switching")
+    parser.add_option("--fast-forward-cpu", action="store", type="choice",
+        default="AtomicSimpleCPU", choices=ObjectList.cpu_list.get_names(),
+        help="cpu type for --fast-forward, e.g. FastForwardCPU")
     parser.add_option("-S", "--simpoint", action="store_true", default=False,
         help="""Use workload simpoints as an instruction offset for
                 --checkpoint-restore or --take-checkpoint.""")
@@ -422,6 +470,12 @@ def addSEOptions(parser):
                            "to/host/dir1 --redirects /dir2=/path/to/host/dir2")
     parser.add_option("--wait-gdb", default=False,
                       help="Wait for remote GDB to connect.")
+    parser.add_option("--parallel-cpus", action="store_true", default=False,
+                      help="Run each KVM CPU on its own event queue and "
+                           "host thread, so that independent guest threads "
+                           "execute in parallel.")
+    parser.add_option("--sim-quantum", type="string", default="1ms",
+                      help="Simulation quantum for --parallel-cpus.")
 
 
 
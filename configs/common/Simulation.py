@@ -47,6 +47,8 @@ from common import ObjectList
 import m5
 from m5.defines import buildEnv
 from m5.objects import *
+from m5.params import isNullPointer
+from m5.sampling import SampledSimulation
 from m5.util import *
 
 addToPath('../common')
@@ -78,8 +80,7 @@ def setCPUClass(options):
             TmpClass, test_mem_mode = getCPUClass(options.restore_with_cpu)
     elif options.fast_forward:
         CPUClass = TmpClass
-        TmpClass = AtomicSimpleCPU
-        test_mem_mode = 'atomic'
+        TmpClass, test_mem_mode = getCPUClass(options.fast_forward_cpu)
 
     # Ruby only supports atomic accesses in noncaching mode
     if test_mem_mode == 'atomic' and options.ruby:
@@ -444,6 +445,11 @@ def run(options, root, testsys, cpu_class):
     if options.repeat_switch and options.take_checkpoints:
         fatal("Can't specify both --repeat-switch and --take-checkpoints")
 
+    if options.sample_interval and (options.standard_switch or
+            options.repeat_switch or cpu_class or options.take_checkpoints):
+        fatal("--sample-interval can't be combined with other CPU "
+              "switching or checkpointing options")
+
     # Setup global stat filtering.
     stat_root_simobjs = []
     for stat_root_str in options.stats_root:
@@ -531,6 +537,53 @@ def run(options, root, testsys, cpu_class):
             repeat_switch_cpu_list = [(testsys.cpu[i], repeat_switch_cpus[i])
                                       for i in range(np)]
 
+    if options.sample_interval:
+        kvm_fast_forward = testsys.cpu[0].memory_mode() == 'atomic_noncaching'
+        if testsys.cpu[0].memory_mode() != 'atomic' and not kvm_fast_forward:
+            fatal("Sampling fast-forwards on the CPU type, which has to be "
+                  "an atomic or a KVM CPU")
+        if not options.caches and not options.l2cache:
+            warn("Sampling without caches, nothing will be warmed")
+        if kvm_fast_forward and not options.caches:
+            warn("KVM sampling without L1 caches, nothing will be warmed")
+        sample_class = ObjectList.cpu_list.get(options.sample_cpu_type)
+
+        sample_cpus = [sample_class(switched_out=True, cpu_id=(i))
+                       for i in range(np)]
+
+        for i in range(np):
+            sample_cpus[i].system = testsys
+            sample_cpus[i].workload = testsys.cpu[i].workload
+            sample_cpus[i].clk_domain = testsys.cpu[i].clk_domain
+            sample_cpus[i].isa = testsys.cpu[i].isa
+
+            if options.checker:
+                sample_cpus[i].addCheckerCpu()
+
+        testsys.sample_cpus = sample_cpus
+
+        # KVM CPUs bypass the caches, so replay the loads they sample
+        # into the caches and TLBs before each sample instead.
+        sample_warmers = []
+        if kvm_fast_forward and options.caches:
+            for i in range(np):
+                testsys.cpu[i].memSamplePeriod = options.sample_warming_period
+                testsys.cpu[i].cache_warmer = CacheWarmer(
+                    manager=testsys.cpu[i], cpu=sample_cpus[i],
+                    cache=testsys.cpu[i].dcache,
+                    window=options.sample_warming_window)
+                sample_warmers.append(testsys.cpu[i].cache_warmer)
+
+        # Let the fast CPUs train the branch predictors of the detailed
+        # ones, or the other way around if --bp-type gave them one.
+        for i in range(np):
+            if not hasattr(sample_class, 'branchPred'):
+                continue
+            if isNullPointer(testsys.cpu[i].branchPred):
+                testsys.cpu[i].branchPred = sample_cpus[i].branchPred
+            else:
+                sample_cpus[i].branchPred = testsys.cpu[i].branchPred
+
     if options.standard_switch:
         switch_cpus = [TimingSimpleCPU(switched_out=True, cpu_id=(i))
                        for i in range(np)]
@@ -723,6 +776,18 @@ def run(options, root, testsys, cpu_class):
         if options.repeat_switch and maxtick > options.repeat_switch:
             exit_event = repeatSwitch(testsys, repeat_switch_cpu_list,
                                       maxtick, options.repeat_switch)
+        elif options.sample_interval:
+            sampler = SampledSimulation(testsys, testsys.cpu, sample_cpus,
+                options.sample_interval, options.sample_warmup,
+                options.sample_length,
+                confidence=options.sample_confidence,
+                error=options.sample_error, max_samples=options.sample_max,
+                max_tick=maxtick, warmers=sample_warmers)
+            exit_event = sampler.run()
+            if exit_event is None:
+                print('Exiting @ tick %i because enough samples were taken' %
+                      m5.curTick())
+                return
         else:
             exit_event = benchCheckpoints(options, maxtick, cptdir)
 
@@ -51,9 +51,12 @@ def build_switch(options):
                                       dist_size = options.dist_size,
                                       server_name = options.dist_server_name,
                                       server_port = options.dist_server_port,
+                                      transport = options.dist_transport,
                                       sync_start = options.dist_sync_start,
                                       sync_repeat = options.dist_sync_repeat,
                                       is_switch = True,
+                                      dist_sync_skip_idle =
+                                          options.dist_sync_skip_idle,
                                       num_nodes = options.dist_size)
                        for i in range(options.dist_size)]
 
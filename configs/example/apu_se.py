@@ -181,6 +181,9 @@ parser.add_option("--num-hw-queues", type="int", default=10,
                   help="number of hw queues in packet processor")
 parser.add_option("--reg-alloc-policy",type="string", default="simple",
                   help="register allocation policy (simple/dynamic)")
+parser.add_option("--cu-event-queues", type="int", default=1,
+                  help="number of event queues (host threads) the CUs "
+                  "are simulated on")
 
 Ruby.define_options(parser)
 
@@ -230,6 +233,7 @@ print('Num SQC = ', num_sqc, 'Num scalar caches = ', num_scalar_cache,
 ########################## Creating the GPU system ########################
 # shader is the GPU
 shader = Shader(n_wf = options.wfs_per_simd,
+                cu_event_queues = options.cu_event_queues,
                 clk_domain = SrcClockDomain(
                     clock = options.gpu_clock,
                     voltage_domain = VoltageDomain(
@@ -68,6 +68,11 @@ def addOptions(parser):
                       default=2200,
                       action="store", type=int,
                       help="Message server listen port\nDEFAULT: 2200")
+    parser.add_argument("--dist-transport",
+                      default="tcp", choices=["tcp", "shm"],
+                      help="Transport between the dist-gem5 processes, shm"\
+                      " needs them all to run on the same host\nDEFAULT:"\
+                      " tcp")
     parser.add_argument("--dist-sync-repeat",
                       default="0us",
                       action="store", type=str,
@@ -107,6 +112,7 @@ def addEthernet(system, options):
                                      dist_size = options.dist_size,
                                      server_name = options.dist_server_name,
                                      server_port = options.dist_server_port,
+                                     transport = options.dist_transport,
                                      sync_start = options.dist_sync_start,
                                      sync_repeat = options.dist_sync_repeat)
     system.etherlink.int0 = Parent.system.ethernet.interface
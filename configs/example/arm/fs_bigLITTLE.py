@@ -309,6 +309,11 @@ def build(options):
 def _build_kvm(system, cpus):
     system.kvm_vm = KvmVM()
 
+    # Let the guest kick the virtio devices' queues through their
+    # QueueNotify registers (offset 0x50) without exiting from KVM.
+    system.kvm_vm.notifyMMIO = [ vio.pio_addr + 0x50
+        for vio in getattr(system.realview, 'vio', []) ]
+
     # Assign KVM CPUs to their own event queues / threads. This
     # has to be done after creating caches and other child objects
     # since these mustn't inherit the CPU event queue.
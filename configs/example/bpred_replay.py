@@ -0,0 +1,79 @@
+# Copyright (c) 2021 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+
+# Replay a branch trace against several branch predictors and print
+# their mispredictions per thousand instructions. Traces are recorded
+# with se.py --branch-trace-file, for instance:
+#
+#   gem5.opt configs/example/se.py --cpu-type=DerivO3CPU --caches \
+#       --branch-trace-file=app.btrc.gz -c app
+#   gem5.opt configs/example/bpred_replay.py \
+#       --bp-types=TournamentBP,LTAGE,TAGE_SC_L_64KB m5out/app.btrc.gz
+#
+# The predictors are replayed in parallel on host threads.
+
+import argparse
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath('../')
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser(
+    description="Replay a branch trace against branch predictors")
+parser.add_argument("trace", help="Branch trace recorded by BranchTrace")
+parser.add_argument("--bp-types", default="TournamentBP,BiModeBP,LTAGE",
+                    help="Comma separated list of the predictors to replay "
+                    "the trace against, out of: %s" %
+                    ", ".join(ObjectList.bp_list.get_names()))
+parser.add_argument("--num-threads", type=int, default=1,
+                    help="Number of hardware threads in the trace")
+parser.add_argument("--host-threads", type=int, default=0,
+                    help="Number of predictors replayed in parallel, "
+                    "0 for all of them")
+parser.add_argument("--max-branches", type=int, default=0,
+                    help="Number of branches to replay, 0 for the whole "
+                    "trace")
+args = parser.parse_args()
+
+predictors = [ObjectList.bp_list.get(name)()
+              for name in args.bp_types.split(",")]
+
+root = Root(full_system=False)
+root.replay = BranchTraceReplay(trace_file=args.trace,
+                                predictors=predictors,
+                                numThreads=args.num_threads,
+                                host_threads=args.host_threads,
+                                max_branches=args.max_branches)
+
+m5.instantiate()
+exit_event = m5.simulate()
+print('Exiting @ tick', m5.curTick(), 'because', exit_event.getCause())
@@ -184,8 +184,6 @@ def build_test_system(np):
 
         # Sanity check
         if options.simpoint_profile:
-            if not ObjectList.is_noncaching_cpu(TestCPUClass):
-                fatal("SimPoint generation should be done with atomic cpu")
             if np > 1:
                 fatal("SimPoint generation not supported with more than one CPUs")
 
@@ -338,7 +336,8 @@ elif len(bm) == 1 and options.dist:
                         options.dist_sync_start,
                         options.ethernet_linkspeed,
                         options.ethernet_linkdelay,
-                        options.etherdump);
+                        options.etherdump,
+                        options.dist_transport);
 elif len(bm) == 1:
     root = Root(full_system=True, system=test_sys)
 else:
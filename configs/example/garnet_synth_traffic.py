@@ -60,6 +60,11 @@ parser.add_option("--precision", type="int", default=3,
                   help="Number of digits of precision after decimal point\
                         for injection rate")
 
+parser.add_option("--geometric-injection", action="store_true",
+                  help="Only wake up the testers on the cycles they inject\
+                        in, drawing the gaps in between from a geometric\
+                        distribution rather than deciding every cycle.")
+
 parser.add_option("--sim-cycles", type="int", default=1000,
                    help="Number of simulation cycles")
 
@@ -107,6 +112,7 @@ cpus = [ GarnetSyntheticTraffic(
                      inj_rate=options.injectionrate,
                      inj_vnet=options.inj_vnet,
                      precision=options.precision,
+                     geometric_injection=options.geometric_injection,
                      num_dest=options.num_dirs) \
          for i in range(options.num_cpus) ]
 
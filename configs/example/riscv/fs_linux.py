@@ -208,8 +208,6 @@ elif not options.external_memory_system:
 
 # Sanity check
 if options.simpoint_profile:
-    if not ObjectList.is_noncaching_cpu(CPUClass):
-        fatal("SimPoint generation should be done with atomic cpu")
     if np > 1:
         fatal("SimPoint generation not supported with more than one CPUs")
 
@@ -47,7 +47,7 @@ import os
 import m5
 from m5.defines import buildEnv
 from m5.objects import *
-from m5.params import NULL
+from m5.params import NULL, isNullPointer
 from m5.util import addToPath, fatal, warn
 
 addToPath('../')
@@ -212,8 +212,6 @@ if ObjectList.is_kvm_cpu(CPUClass) or ObjectList.is_kvm_cpu(FutureClass):
 
 # Sanity check
 if options.simpoint_profile:
-    if not ObjectList.is_noncaching_cpu(CPUClass):
-        fatal("SimPoint/BPProbe should be done with an atomic cpu")
     if np > 1:
         fatal("SimPoint generation not supported with more than one CPUs")
 
@@ -240,6 +238,15 @@ for i in range(np):
             ObjectList.indirect_bp_list.get(options.indirect_bp_type)
         system.cpu[i].branchPred.indirectBranchPred = indirectBPClass()
 
+    if options.branch_trace_file:
+        if isNullPointer(system.cpu[i].branchPred):
+            fatal("--branch-trace-file needs a CPU with a branch predictor")
+        trace_file = options.branch_trace_file
+        if np > 1:
+            trace_file += ".%d" % i
+        system.cpu[i].branchPred.branch_trace = \
+            BranchTrace(trace_file=trace_file)
+
     system.cpu[i].createThreads()
 
 if options.ruby:
@@ -270,5 +277,19 @@ if options.wait_gdb:
     for cpu in system.cpu:
         cpu.wait_for_remote_gdb = True
 
+if options.parallel_cpus and np > 1:
+    if not ObjectList.is_kvm_cpu(CPUClass):
+        fatal("--parallel-cpus needs KVM CPUs")
+    # Give every CPU its own event queue. This has to be done after
+    # creating caches and other child objects since these mustn't
+    # inherit the CPU event queue; they all stay on queue 0.
+    for idx, cpu in enumerate(system.cpu):
+        for obj in cpu.descendants():
+            obj.eventq_index = 0
+        cpu.eventq_index = idx + 1
+
 root = Root(full_system = False, system = system)
+if options.parallel_cpus and np > 1:
+    root.sim_quantum = m5.ticks.fromSeconds(
+        m5.util.convert.anyToLatency(options.sim_quantum))
 Simulation.run(options, root, system, FutureClass)
@@ -39,9 +39,9 @@ def define_options(parser):
     parser.add_option("--mesh-rows", type="int", default=0,
                       help="the number of rows in the mesh topology")
     parser.add_option("--network", type="choice", default="simple",
-                      choices=['simple', 'garnet'],
-                      help="""'simple'|'garnet' (garnet2.0 will be
-                      deprecated.)""")
+                      choices=['simple', 'garnet', 'analytical'],
+                      help="""'simple'|'garnet'|'analytical' (garnet2.0
+                      will be deprecated.)""")
     parser.add_option("--router-latency", action="store", type="int",
                       default=1,
                       help="""number of pipeline stages in the garnet router.
@@ -72,6 +72,18 @@ def define_options(parser):
     parser.add_option("--garnet-deadlock-threshold", action="store",
                       type="int", default=50000,
                       help="network-level deadlock threshold.")
+    parser.add_option("--garnet-regions", action="store", type="int",
+                      default=1,
+                      help="""number of router regions in garnet, each
+                            simulated on its own event queue.""")
+    parser.add_option("--garnet-utilization-trace", action="store",
+                      type="string", default="",
+                      help="""file in the output directory to sample the
+                            utilization of the garnet links and routers
+                            to, see util/garnet_heatmap.py.""")
+    parser.add_option("--garnet-utilization-interval", action="store",
+                      type="int", default=10000,
+                      help="""cycles between two utilization samples.""")
 
 def create_network(options, ruby):
 
@@ -91,6 +103,13 @@ def create_network(options, ruby):
         RouterClass = GarnetRouter
         InterfaceClass = GarnetNetworkInterface
 
+    elif options.network == "analytical":
+        NetworkClass = AnalyticalNetwork
+        IntLinkClass = BasicIntLink
+        ExtLinkClass = BasicExtLink
+        RouterClass = BasicRouter
+        InterfaceClass = None
+
     else:
         NetworkClass = SimpleNetwork
         IntLinkClass = SimpleIntLink
@@ -113,6 +132,9 @@ def init_network(options, network, InterfaceClass):
         network.ni_flit_size = options.link_width_bits / 8
         network.routing_algorithm = options.routing_algorithm
         network.garnet_deadlock_threshold = options.garnet_deadlock_threshold
+        network.num_regions = options.garnet_regions
+        network.utilization_trace = options.garnet_utilization_trace
+        network.utilization_interval = options.garnet_utilization_interval
 
         # Create Bridges and connect them to the corresponding links
         for intLink in network.int_links:
@@ -175,9 +175,12 @@ ExtMaster::handleEvent(SST::Event* event)
     req->setContext(ev->getGroupId());
 
     auto pkt = new Packet(req, cmdO);
-    pkt->allocate();
     if (data) {
-        pkt->setData(ev->getPayload().data());
+        // The event lives until the response, so the packet can use its
+        // payload in place rather than a copy
+        pkt->dataStatic(ev->getPayload().data());
+    } else {
+        pkt->allocate();
     }
     pkt->pushSenderState(new SenderState(ev));
 
@@ -201,11 +204,13 @@ ExtMaster::recvTimingResp(PacketPtr pkt) {
     delete senderState;
 
     MemEvent* resp = ev->makeResponse();
-    delete ev;
 
-    // copy the payload and then destroy gem5 packet
-    resp->setPayload(pkt->getSize(), pkt->getPtr<uint8_t>());
+    // copy the payload, only reads return data, and then destroy gem5
+    // packet
+    if (pkt->isRead())
+        resp->setPayload(pkt->getSize(), pkt->getPtr<uint8_t>());
     delete pkt;
+    delete ev;
 
     nic->send(resp);
     return true;
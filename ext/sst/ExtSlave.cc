@@ -113,7 +113,11 @@ ExtSlave::recvTimingReq(PacketPtr pkt)
     }
 
     auto ev = new MemEvent(comp, pkt->getAddr(), pkt->getAddr(), cmd);
-    ev->setPayload(pkt->getSize(), pkt->getPtr<uint8_t>());
+    // Only writes carry data, reads just need the size
+    if (cmd == GetX)
+        ev->setPayload(pkt->getSize(), pkt->getPtr<uint8_t>());
+    else
+        ev->setSize(pkt->getSize());
     if ((::MemCmd::Command)pkt->cmd.toInt() == ::MemCmd::LoadLockedReq)
         ev->setLoadLink();
     else if ((::MemCmd::Command)pkt->cmd.toInt() == ::MemCmd::StoreCondReq)
@@ -156,7 +160,8 @@ ExtSlave::handleEvent(Event* ev)
         PacketMap.erase(mi);
 
         pkt->makeResponse();  // Convert to a response packet
-        pkt->setData(event->getPayload().data());
+        if (pkt->hasData())
+            pkt->setData(event->getPayload().data());
 
         // Resolve the success of Store Conditionals
         if (pkt->isLLSC() && pkt->isWrite()) {
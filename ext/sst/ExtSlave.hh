@@ -45,6 +45,8 @@
 #ifndef EXT_SST_EXTSLAVE_HH
 #define EXT_SST_EXTSLAVE_HH
 
+#include <unordered_map>
+
 #include <core/interfaces/simpleMem.h>
 
 #include <sim/sim_object.hh>
@@ -94,7 +96,18 @@ class ExtSlave : public ExternalSlave::Port {
     std::list<PacketPtr> respQ;
     bool blocked() { return !respQ.empty(); }
 
-    typedef std::map<Event::id_type, ::Packet*> PacketMap_t;
+    struct EventIdHash
+    {
+        size_t
+        operator()(const Event::id_type &id) const
+        {
+            return std::hash<uint64_t>()(id.first) ^
+                std::hash<int>()(id.second);
+        }
+    };
+
+    typedef std::unordered_map<Event::id_type, ::Packet*, EventIdHash>
+        PacketMap_t;
     PacketMap_t PacketMap; // SST Event id -> gem5 Packet*
 
 public:
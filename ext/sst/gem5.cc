@@ -77,13 +77,25 @@ gem5Component::gem5Component(ComponentId_t id, Params &params) :
             (Output::output_location_t)params.find<int>("comp_debug", 0));
     info.init("gem5:" + getName() + ": ", 0, 0, Output::STDOUT);
 
+    // gem5 is advanced by a whole lookahead window at a time. Without a
+    // lookahead, it is advanced every clock tick, which also clocks the
+    // NICs of the ExtMasters.
+    std::string frequency = params.find<std::string>("frequency", "1GHz");
+    std::string lookahead = params.find<std::string>("lookahead", "");
+    nic_clock = !lookahead.empty();
+
     TimeConverter *clock = registerClock(
-            params.find<std::string>("frequency", "1GHz"),
+            nic_clock ? lookahead : frequency,
             new Clock::Handler<gem5Component>(this, &gem5Component::clockTick));
 
     // This sets how many gem5 cycles we'll need to simulate per clock tick
     sim_cycles = clock->getFactor();
 
+    if (nic_clock) {
+        registerClock(frequency, new Clock::Handler<gem5Component>(
+                this, &gem5Component::nicClockTick));
+    }
+
     // Disable gem5's inform() messages.
     want_info = false;
 
@@ -124,6 +136,7 @@ gem5Component::gem5Component(ComponentId_t id, Params &params) :
     primaryComponentDoNotEndSim();
 
     clocks_processed = 0;
+    exited = false;
 }
 
 gem5Component::~gem5Component(void)
@@ -168,8 +181,10 @@ gem5Component::clockTick(Cycle_t cycle)
 {
     dbg.output(CALL_INFO, "Cycle %lu\n", cycle);
 
-    for (auto m : masters) {
-        m->clock();
+    if (!nic_clock) {
+        for (auto m : masters) {
+            m->clock();
+        }
     }
 
     GlobalSimLoopExitEvent *event = simulate(sim_cycles);
@@ -178,12 +193,23 @@ gem5Component::clockTick(Cycle_t cycle)
         info.output("exiting: curTick()=%lu cause=`%s` code=%d\n",
                 curTick(), event->getCause().c_str(), event->getCode());
         primaryComponentOKToEndSim();
+        exited = true;
         return true;
     }
 
     return false;
 }
 
+bool
+gem5Component::nicClockTick(Cycle_t cycle)
+{
+    for (auto m : masters) {
+        m->clock();
+    }
+
+    return exited;
+}
+
 
 void
 gem5Component::splitCommandArgs(std::string &cmd,
@@ -68,6 +68,8 @@ private:
     Output info;
     uint64_t sim_cycles;
     uint64_t clocks_processed;
+    bool nic_clock;
+    bool exited;
 
     std::vector<ExtMaster*> masters;
     std::vector<ExtSlave*> slaves;
@@ -82,6 +84,7 @@ public:
     virtual void setup();
     virtual void finish();
     bool clockTick(Cycle_t);
+    bool nicClockTick(Cycle_t);
 
     virtual ExternalMaster::Port *getExternalPort(
         const std::string &name, ExternalMaster &owner,
@@ -58,6 +58,9 @@ static const SST::ElementInfoParam gem5_params[] = {
     {"comp_debug", "Debug information from the component: 0 (off), 1 (stdout),"
                    " 2 (stderr), 3(file)"},
     {"frequency", "Frequency with which to call into gem5"},
+    {"lookahead", "Simulated time gem5 runs ahead of SST per call, must not "
+                  "exceed the latency of the links to gem5 (default: one "
+                  "'frequency' period)"},
     {NULL, NULL}
 };
 
@@ -49,6 +49,9 @@ class ArmTableWalker(ClockedObject):
     is_stage2 =  Param.Bool(False, "Is this object for stage 2 translation?")
     num_squash_per_cycle = Param.Unsigned(2,
             "Number of outstanding walks that can be squashed per cycle")
+    walk_cache_size = Param.Unsigned(0,
+            "Number of intermediate table pointers cached by the walker "
+            "for AArch64 walks (0 disables the walk cache)")
 
     # The port to the memory system. This port is ultimately belonging
     # to the Stage2MMU, and shared by the two table walkers, but we
@@ -50,8 +50,6 @@
 namespace ArmISA
 {
 
-GenericISA::BasicDecodeCache<Decoder, ExtMachInst> Decoder::defaultCache;
-
 Decoder::Decoder(ISA* isa)
     : data(0), fpscrLen(0), fpscrStride(0),
       decoderFlavor(isa->decoderFlavor())
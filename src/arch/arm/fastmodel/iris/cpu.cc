@@ -40,6 +40,9 @@ BaseCPU::BaseCPU(const BaseCPUParams &params, sc_core::sc_module *_evs) :
 {
     panic_if(!evs_base_cpu, "EVS should be of type BaseCpuEvs");
 
+    // The fast model has to follow clock period changes right away
+    notifyClockPeriodUpdates();
+
     // Make sure fast model knows we're using debugging mechanisms to control
     // the simulation, and it shouldn't shut down if simulation time stops
     // for some reason. Despite the misleading name, this doesn't start a CADI
@@ -87,6 +87,13 @@ class BaseCPU : public ::BaseCPU
         return [this] (PacketPtr pkt) { evs_base_cpu->sendFunc(pkt); };
     }
 
+    PortProxy::SendMemBackdoorReqFunc
+    getSendMemBackdoorReq() override
+    {
+        // Accesses have to go through the fast model.
+        return nullptr;
+    }
+
   protected:
     sc_core::sc_module *evs;
     // Hold casted pointer to *evs.
@@ -41,6 +41,10 @@
 void
 ArmISA::HTMCheckpoint::reset()
 {
+    // The register copies are only read by restore(), which needs a valid
+    // checkpoint and hence a save() that overwrote all of them first, so
+    // the (several KiB of) vector and predicate registers are not cleared
+    // on every commit and abort.
     rt = 0;
     nPc = 0;
     sp = 0;
@@ -50,13 +54,6 @@ ArmISA::HTMCheckpoint::reset()
     nzcv = 0;
     daif = 0;
     tcreason = 0;
-    x.fill(0);
-    for (auto i = 0; i < NumVecRegs; ++i) {
-      z[i].zero();
-    }
-    for (auto i = 0; i < NumVecPredRegs; ++i) {
-      p[i].reset();
-    }
     pcstateckpt = PCState();
 
     BaseHTMCheckpoint::reset();
@@ -40,6 +40,8 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <limits>
 
 #include "base/logging.hh"
 #include "fplib.hh"
@@ -1276,12 +1278,222 @@ fp16_add(uint16_t a, uint16_t b, int neg, int mode, int *flags)
                       mode, flags);
 }
 
+// In the common cases, the operations below are computed with the host
+// FPU instead of the integer code. This needs a host that computes float
+// and double operations with IEEE 754 rounding and in their own
+// precision, and that doesn't contract multiplies and adds. Whether a
+// result is exact is found without reading the host exception flags,
+// which is slow, using the error-free transformations of the operations.
+// These assume the host rounds to nearest, which is the case outside of
+// the VFP helpers that change the rounding mode temporarily.
+#if defined(__x86_64__) && defined(__SSE2_MATH__) && !defined(__FMA__)
+#define FPLIB_HOST_FP 1
+#else
+#define FPLIB_HOST_FP 0
+#endif
+
+#if FPLIB_HOST_FP
+// The exact error of a sum (Knuth's TwoSum).
+static inline double
+fp_sum_err(double a, double b, double s)
+{
+    double bb = s - a;
+    return (a - (s - bb)) + (b - bb);
+}
+
+// The exact error of a product (Dekker's TwoProduct), provided that
+// neither the operands nor the product are close to the limits of the
+// exponent range.
+static inline double
+fp_prod_err(double a, double b, double p)
+{
+    const double split = 134217729.0; // 2^27 + 1
+    double ca = split * a, cb = split * b;
+    double ah = ca - (ca - a), al = a - ah;
+    double bh = cb - (cb - b), bl = b - bh;
+    return ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+}
+
+// Check the result of an operation computed on the host, and only keep
+// it when the architecture gives the same result and flags: the result
+// is neither infinite, NaN nor possibly tiny before rounding, so that
+// only the inexact flag can be raised. NaN propagation and the
+// detection of tininess differ between hosts, so those cases are left
+// to the integer code.
+template <typename Float, typename Bits>
+static inline bool
+fp_host_result(Float fx, bool inexact, int *flags, Bits *result)
+{
+    const int mant_bits = std::numeric_limits<Float>::digits - 1;
+    const Bits exp_inf = (Bits(1) << (sizeof(Bits) * 8 - 1 - mant_bits)) - 1;
+
+    Bits x;
+    std::memcpy(&x, &fx, sizeof(x));
+    const Bits x_exp = x >> mant_bits & exp_inf;
+    if (x_exp == exp_inf ||
+        (inexact && (x_exp == 0 ||
+                     (x_exp == 1 && !(x & ((Bits(1) << mant_bits) - 1)))))) {
+        return false;
+    }
+
+    if (inexact)
+        *flags |= FPLIB_IXC;
+    *result = x;
+    return true;
+}
+#endif
+
+// Whether the operands of an operation can be handled on the host: they
+// are finite, and neither flushing to zero nor a directed rounding mode
+// is in use.
+template <typename Float, typename Bits>
+static inline bool
+fp_host_ok(Bits a, Bits b, int mode)
+{
+    if (!FPLIB_HOST_FP || (mode & (FPLIB_FZ | 3)) != FPLIB_RN)
+        return false;
+
+    const int mant_bits = std::numeric_limits<Float>::digits - 1;
+    const Bits exp_inf = (Bits(1) << (sizeof(Bits) * 8 - 1 - mant_bits)) - 1;
+    return (a >> mant_bits & exp_inf) != exp_inf &&
+        (b >> mant_bits & exp_inf) != exp_inf;
+}
+
+template <typename Float, typename Bits>
+static inline Float
+fp_host_float(Bits a)
+{
+    Float f;
+    std::memcpy(&f, &a, sizeof(f));
+    return f;
+}
+
+// Single precision operations are computed in double precision, which
+// is exact for products and wide enough for the sums and quotients to
+// be rounded correctly when converted back.
+static inline bool
+fp32_host_add(uint32_t a, uint32_t b, int mode, int *flags, uint32_t *x)
+{
+#if FPLIB_HOST_FP
+    if (!fp_host_ok<float>(a, b, mode))
+        return false;
+    double da = fp_host_float<float>(a), db = fp_host_float<float>(b);
+    double d = da + db;
+    float f = d;
+    return fp_host_result(f, fp_sum_err(da, db, d) != 0 || f != d,
+                          flags, x);
+#else
+    return false;
+#endif
+}
+
+static inline bool
+fp32_host_mul(uint32_t a, uint32_t b, int mode, int *flags, uint32_t *x)
+{
+#if FPLIB_HOST_FP
+    if (!fp_host_ok<float>(a, b, mode))
+        return false;
+    double d = (double)fp_host_float<float>(a) * fp_host_float<float>(b);
+    float f = d;
+    return fp_host_result(f, f != d, flags, x);
+#else
+    return false;
+#endif
+}
+
+static inline bool
+fp32_host_div(uint32_t a, uint32_t b, int mode, int *flags, uint32_t *x)
+{
+#if FPLIB_HOST_FP
+    if (!fp_host_ok<float>(a, b, mode) || !(b << 1))
+        return false;
+    double da = fp_host_float<float>(a), db = fp_host_float<float>(b);
+    float f = da / db;
+    return fp_host_result(f, (double)f * db != da, flags, x);
+#else
+    return false;
+#endif
+}
+
+static inline bool
+fp64_host_add(uint64_t a, uint64_t b, int mode, int *flags, uint64_t *x)
+{
+#if FPLIB_HOST_FP
+    if (!fp_host_ok<double>(a, b, mode))
+        return false;
+    double da = fp_host_float<double>(a), db = fp_host_float<double>(b);
+    double d = da + db;
+    return fp_host_result(d, fp_sum_err(da, db, d) != 0, flags, x);
+#else
+    return false;
+#endif
+}
+
+// Whether an operand is far enough from the limits of the exponent range
+// for the error of a product to be computed exactly.
+static inline bool
+fp64_host_prod_ok(uint64_t a)
+{
+    const uint64_t exp = a >> FP64_MANT_BITS & FP64_EXP_INF;
+    return exp > 2 * FP64_MANT_BITS && exp < FP64_EXP_INF - 2 * FP64_MANT_BITS;
+}
+
+static inline bool
+fp64_host_mul(uint64_t a, uint64_t b, int mode, int *flags, uint64_t *x)
+{
+#if FPLIB_HOST_FP
+    if (!fp_host_ok<double>(a, b, mode))
+        return false;
+    double da = fp_host_float<double>(a), db = fp_host_float<double>(b);
+    double d = da * db;
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    if (!fp64_host_prod_ok(a) || !fp64_host_prod_ok(b) ||
+        !fp64_host_prod_ok(bits)) {
+        return false;
+    }
+    return fp_host_result(d, fp_prod_err(da, db, d) != 0, flags, x);
+#else
+    return false;
+#endif
+}
+
+static inline bool
+fp64_host_div(uint64_t a, uint64_t b, int mode, int *flags, uint64_t *x)
+{
+#if FPLIB_HOST_FP
+    if (!fp_host_ok<double>(a, b, mode) || !(b << 1))
+        return false;
+    double da = fp_host_float<double>(a), db = fp_host_float<double>(b);
+    double d = da / db;
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    if (!fp64_host_prod_ok(a) || !fp64_host_prod_ok(b) ||
+        !fp64_host_prod_ok(bits)) {
+        return false;
+    }
+    // The quotient is exact if it multiplies back to the dividend. The
+    // difference between the dividend and the rounded product is exact
+    // as they are close.
+    double p = d * db;
+    return fp_host_result(d, (da - p) - fp_prod_err(d, db, p) != 0,
+                          flags, x);
+#else
+    return false;
+#endif
+}
+
 static uint32_t
 fp32_add(uint32_t a, uint32_t b, int neg, int mode, int *flags)
 {
     int a_sgn, a_exp, b_sgn, b_exp, x_sgn, x_exp;
     uint32_t a_mnt, b_mnt, x, x_mnt;
 
+    if (fp32_host_add(a, b ^ (uint32_t)neg << (FP32_BITS - 1), mode, flags,
+                      &x)) {
+        return x;
+    }
+
     fp32_unpack(&a_sgn, &a_exp, &a_mnt, a, mode, flags);
     fp32_unpack(&b_sgn, &b_exp, &b_mnt, b, mode, flags);
 
@@ -1342,6 +1554,11 @@ fp64_add(uint64_t a, uint64_t b, int neg, int mode, int *flags)
     int a_sgn, a_exp, b_sgn, b_exp, x_sgn, x_exp;
     uint64_t a_mnt, b_mnt, x, x_mnt;
 
+    if (fp64_host_add(a, b ^ (uint64_t)neg << (FP64_BITS - 1), mode, flags,
+                      &x)) {
+        return x;
+    }
+
     fp64_unpack(&a_sgn, &a_exp, &a_mnt, a, mode, flags);
     fp64_unpack(&b_sgn, &b_exp, &b_mnt, b, mode, flags);
 
@@ -1440,6 +1657,9 @@ fp32_mul(uint32_t a, uint32_t b, int mode, int *flags)
     uint32_t a_mnt, b_mnt, x;
     uint64_t x_mnt;
 
+    if (fp32_host_mul(a, b, mode, flags, &x))
+        return x;
+
     fp32_unpack(&a_sgn, &a_exp, &a_mnt, a, mode, flags);
     fp32_unpack(&b_sgn, &b_exp, &b_mnt, b, mode, flags);
 
@@ -1477,6 +1697,9 @@ fp64_mul(uint64_t a, uint64_t b, int mode, int *flags)
     uint64_t a_mnt, b_mnt, x;
     uint64_t x0_mnt, x1_mnt;
 
+    if (fp64_host_mul(a, b, mode, flags, &x))
+        return x;
+
     fp64_unpack(&a_sgn, &a_exp, &a_mnt, a, mode, flags);
     fp64_unpack(&b_sgn, &b_exp, &b_mnt, b, mode, flags);
 
@@ -1818,6 +2041,9 @@ fp32_div(uint32_t a, uint32_t b, int mode, int *flags)
     uint32_t a_mnt, b_mnt, x;
     uint64_t x_mnt;
 
+    if (fp32_host_div(a, b, mode, flags, &x))
+        return x;
+
     fp32_unpack(&a_sgn, &a_exp, &a_mnt, a, mode, flags);
     fp32_unpack(&b_sgn, &b_exp, &b_mnt, b, mode, flags);
 
@@ -1859,6 +2085,9 @@ fp64_div(uint64_t a, uint64_t b, int mode, int *flags)
     int a_sgn, a_exp, b_sgn, b_exp, x_sgn, x_exp, c;
     uint64_t a_mnt, b_mnt, x, x_mnt, x0_mnt, x1_mnt;
 
+    if (fp64_host_div(a, b, mode, flags, &x))
+        return x;
+
     fp64_unpack(&a_sgn, &a_exp, &a_mnt, a, mode, flags);
     fp64_unpack(&b_sgn, &b_exp, &b_mnt, b, mode, flags);
 
@@ -59,6 +59,7 @@ TableWalker::TableWalker(const Params &p)
       isStage2(p.is_stage2), tlb(NULL),
       currState(NULL), pending(false),
       numSquashable(p.num_squash_per_cycle),
+      walkCache(p.walk_cache_size, WalkCacheEntry()), walkCacheSeq(0),
       stats(this),
       pendingReqs(0),
       pendingChangeTick(curTick()),
@@ -137,7 +138,7 @@ TableWalker::WalkerState::WalkerState() :
     pxnTable(false), hpd(false), stage2Req(false),
     stage2Tran(nullptr), timing(false), functional(false),
     mode(BaseTLB::Read), tranType(TLB::NormalTran), l2Desc(l1Desc),
-    delayed(false), tableWalker(nullptr)
+    delayed(false), tableWalker(nullptr), walkRoot(0)
 {
 }
 
@@ -1095,14 +1096,34 @@ TableWalker::processWalkAArch64()
 
     }
 
-    // Determine descriptor address
-    Addr desc_addr = base_addr |
-        (bits(currState->vaddr, tsz - 1,
-              stride * (3 - start_lookup_level) + tg) << 3);
+    // Determine descriptor address, starting from the deepest table the
+    // walk cache knows about if there is one
+    currState->walkRoot = base_addr;
+    LookupLevel lookup_level = start_lookup_level;
+    Addr desc_addr;
+    if (const WalkCacheEntry *wce = lookupWalkCache(start_lookup_level, tg)) {
+        lookup_level = wce->level;
+        int va_lo = levelShift(tg, lookup_level);
+        desc_addr = wce->table |
+            (bits(currState->vaddr, va_lo + stride - 1, va_lo) << 3);
+
+        currState->secureLookup = wce->secureLookup;
+        currState->rwTable = wce->rwTable;
+        currState->userTable = wce->userTable;
+        currState->xnTable = wce->xnTable;
+        currState->pxnTable = wce->pxnTable;
+
+        DPRINTF(TLB, "Walk cache hit, starting at L%d descriptor at: %#x\n",
+                lookup_level, desc_addr);
+    } else {
+        desc_addr = base_addr |
+            (bits(currState->vaddr, tsz - 1,
+                  stride * (3 - start_lookup_level) + tg) << 3);
+    }
 
     // Trickbox address check
     Fault f = testWalk(desc_addr, sizeof(uint64_t),
-                       TlbEntry::DomainType::NoAccess, start_lookup_level);
+                       TlbEntry::DomainType::NoAccess, lookup_level);
     if (f) {
         DPRINTF(TLB, "Trickbox check caused fault on %#x\n", currState->vaddr_tainted);
         if (currState->timing) {
@@ -1121,19 +1142,19 @@ TableWalker::processWalkAArch64()
         flag.set(Request::UNCACHEABLE);
     }
 
-    if (currState->isSecure) {
+    if (currState->secureLookup) {
         flag.set(Request::SECURE);
     }
 
-    currState->longDesc.lookupLevel = start_lookup_level;
+    currState->longDesc.lookupLevel = lookup_level;
     currState->longDesc.aarch64 = true;
     currState->longDesc.grainSize = tg;
     currState->longDesc.physAddrRange = _physAddrRange;
 
     if (currState->timing) {
         fetchDescriptor(desc_addr, (uint8_t*) &currState->longDesc.data,
-                        sizeof(uint64_t), flag, start_lookup_level,
-                        LongDescEventByLevel[start_lookup_level], NULL);
+                        sizeof(uint64_t), flag, lookup_level,
+                        LongDescEventByLevel[lookup_level], NULL);
     } else {
         fetchDescriptor(desc_addr, (uint8_t*)&currState->longDesc.data,
                         sizeof(uint64_t), flag, -1, NULL,
@@ -1835,6 +1856,8 @@ TableWalker::doLongDescriptor()
 
             LookupLevel L = currState->longDesc.lookupLevel =
                 (LookupLevel) (currState->longDesc.lookupLevel + 1);
+            if (currState->aarch64)
+                insertWalkCache(currState->longDesc.nextTableAddr());
             Event *event = NULL;
             switch (L) {
               case L1:
@@ -2162,7 +2185,7 @@ TableWalker::fetchDescriptor(Addr descAddr, uint8_t *data, int numBytes,
                            currState->tc->getCpuPtr()->clockPeriod(), flags);
             (this->*doDescriptor)();
         } else {
-            RequestPtr req = std::make_shared<Request>(
+            RequestPtr req = Request::create(
                 descAddr, numBytes, flags, requestorId);
 
             req->taskId(ContextSwitchTaskId::DMA);
@@ -2315,6 +2338,83 @@ TableWalker::pageSizeNtoStatBin(uint8_t N)
 }
 
 
+const TableWalker::WalkCacheEntry *
+TableWalker::lookupWalkCache(LookupLevel start_level, GrainSize tg)
+{
+    if (walkCache.empty() || currState->functional)
+        return NULL;
+
+    WalkCacheEntry *hit = NULL;
+    for (auto &entry : walkCache) {
+        if (!entry.valid || entry.level <= start_level ||
+            (hit && entry.level <= hit->level)) {
+            continue;
+        }
+        if (entry.root == currState->walkRoot && entry.grainSize == tg &&
+            entry.el == currState->el && entry.vmid == currState->vmid &&
+            entry.isSecure == currState->isSecure &&
+            entry.vpn == walkCacheVpn(currState->vaddr, tg, entry.level)) {
+            hit = &entry;
+        }
+    }
+
+    if (hit) {
+        hit->lruSeq = ++walkCacheSeq;
+        stats.walkCacheHits[hit->level]++;
+    }
+    return hit;
+}
+
+void
+TableWalker::insertWalkCache(Addr table)
+{
+    if (walkCache.empty() || currState->functional)
+        return;
+
+    const LookupLevel level = currState->longDesc.lookupLevel;
+    const GrainSize tg = currState->longDesc.grainSize;
+    const Addr vpn = walkCacheVpn(currState->vaddr, tg, level);
+
+    WalkCacheEntry *victim = &walkCache[0];
+    for (auto &entry : walkCache) {
+        if (entry.valid && entry.root == currState->walkRoot &&
+            entry.level == level && entry.vpn == vpn &&
+            entry.grainSize == tg && entry.el == currState->el &&
+            entry.vmid == currState->vmid &&
+            entry.isSecure == currState->isSecure) {
+            victim = &entry;
+            break;
+        }
+        if (victim->valid &&
+            (!entry.valid || entry.lruSeq < victim->lruSeq)) {
+            victim = &entry;
+        }
+    }
+
+    victim->root = currState->walkRoot;
+    victim->vpn = vpn;
+    victim->table = table;
+    victim->lruSeq = ++walkCacheSeq;
+    victim->el = currState->el;
+    victim->level = level;
+    victim->grainSize = tg;
+    victim->vmid = currState->vmid;
+    victim->valid = true;
+    victim->isSecure = currState->isSecure;
+    victim->secureLookup = currState->secureLookup;
+    victim->rwTable = currState->rwTable;
+    victim->userTable = currState->userTable;
+    victim->xnTable = currState->xnTable;
+    victim->pxnTable = currState->pxnTable;
+}
+
+void
+TableWalker::flushWalkCache()
+{
+    for (auto &entry : walkCache)
+        entry.valid = false;
+}
+
 TableWalker::TableWalkerStats::TableWalkerStats(Stats::Group *parent)
     : Stats::Group(parent),
     ADD_STAT(walks, UNIT_COUNT, "Table walker walks requested"),
@@ -2341,7 +2441,10 @@ TableWalker::TableWalkerStats::TableWalkerStats(Stats::Group *parent)
     ADD_STAT(pageSizes, UNIT_COUNT,
              "Table walker page sizes translated"),
     ADD_STAT(requestOrigin, UNIT_COUNT,
-             "Table walker requests started/completed, data/inst")
+             "Table walker requests started/completed, data/inst"),
+    ADD_STAT(walkCacheHits, UNIT_COUNT,
+             "Walks started below the first level by the walk cache, by "
+             "the level they started at")
 {
     walksShortDescriptor
         .flags(Stats::nozero);
@@ -2403,4 +2506,12 @@ TableWalker::TableWalkerStats::TableWalkerStats(Stats::Group *parent)
     requestOrigin.subname(1,"Completed");
     requestOrigin.ysubname(0,"Data");
     requestOrigin.ysubname(1,"Inst");
+
+    walkCacheHits
+        .init(4)
+        .flags(Stats::nozero);
+    walkCacheHits.subname(0, "Level0");
+    walkCacheHits.subname(1, "Level1");
+    walkCacheHits.subname(2, "Level2");
+    walkCacheHits.subname(3, "Level3");
 }
@@ -39,6 +39,7 @@
 #define __ARCH_ARM_TABLE_WALKER_HH__
 
 #include <list>
+#include <vector>
 
 #include "arch/arm/faults.hh"
 #include "arch/arm/miscregs.hh"
@@ -836,6 +837,10 @@ class TableWalker : public ClockedObject
         /** Page entries walked during service (for stats) */
         unsigned levels;
 
+        /** Translation table base the walk started from, used to tag the
+         * table pointers it leaves in the walk cache */
+        Addr walkRoot;
+
         void doL1Descriptor();
         void doL2Descriptor();
 
@@ -882,6 +887,59 @@ class TableWalker : public ClockedObject
      * removed from the pendingQueue per cycle. */
     unsigned numSquashable;
 
+    /**
+     * A walk cache entry remembers the table an AArch64 walk read at
+     * one level, along with the hierarchical attributes accumulated from
+     * the table descriptors above it, so that later walks of the same
+     * region can start at that level.
+     */
+    struct WalkCacheEntry
+    {
+        Addr root;
+        Addr vpn;
+        Addr table;
+        uint64_t lruSeq;
+        ExceptionLevel el;
+        LookupLevel level;
+        GrainSize grainSize;
+        uint8_t vmid;
+        bool valid;
+        bool isSecure;
+        bool secureLookup;
+        bool rwTable;
+        bool userTable;
+        bool xnTable;
+        bool pxnTable;
+    };
+
+    /** The walk cache, fully associative with LRU replacement */
+    std::vector<WalkCacheEntry> walkCache;
+    uint64_t walkCacheSeq;
+
+    /** Lowest VA bit of the index into a table at the given level */
+    static int
+    levelShift(GrainSize tg, LookupLevel level)
+    {
+        return (tg - 3) * (3 - level) + tg;
+    }
+
+    /** Tag of the table at the given level which translates vaddr */
+    static Addr
+    walkCacheVpn(Addr vaddr, GrainSize tg, LookupLevel level)
+    {
+        return vaddr >> (levelShift(tg, level) + tg - 3);
+    }
+
+    /**
+     * Find the deepest table below start_level cached for the current
+     * walk, or NULL if there is none.
+     */
+    const WalkCacheEntry *lookupWalkCache(LookupLevel start_level,
+                                          GrainSize tg);
+
+    /** Remember the table the current walk is about to read */
+    void insertWalkCache(Addr table);
+
     /** Cached copies of system-level properties */
     bool haveSecurity;
     bool _haveLPAE;
@@ -904,6 +962,7 @@ class TableWalker : public ClockedObject
         Stats::Histogram pendingWalks; // essentially "L" of queueing theory
         Stats::Vector pageSizes;
         Stats::Vector2d requestOrigin;
+        Stats::Vector walkCacheHits;
     } stats;
 
     mutable unsigned pendingReqs;
@@ -949,6 +1008,11 @@ class TableWalker : public ClockedObject
 
     static LookupLevel toLookupLevel(uint8_t lookup_level_as_int);
 
+    /** Drop every table pointer held in the walk cache. Called whenever
+     * the TLB is invalidated, which is when software is required to
+     * tell us about changes to the translation tables. */
+    void flushWalkCache();
+
   private:
 
     void doL1Descriptor();
@@ -40,6 +40,7 @@
 
 #include "arch/arm/tlb.hh"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -55,7 +56,9 @@
 #include "arch/arm/table_walker.hh"
 #include "arch/arm/tlbi_op.hh"
 #include "arch/arm/utility.hh"
+#include "base/bitfield.hh"
 #include "base/inifile.hh"
+#include "base/intmath.hh"
 #include "base/str.hh"
 #include "base/trace.hh"
 #include "cpu/base.hh"
@@ -78,12 +81,25 @@ TLB::TLB(const ArmTLBParams &p)
       isStage2(p.is_stage2), stage2Req(false), stage2DescReq(false), _attr(0),
       directToStage2(false), tableWalker(p.walker), stage2Tlb(NULL),
       stage2Mmu(NULL), test(nullptr), stats(this),  rangeMRU(1),
+      lruPrev(size), lruNext(size), lruHead(0), lruTail(size - 1),
+      lruStamp(size), lruSeq(0),
+      hashHeads(size_t(2) << ceilLog2(std::max(size, 8)), -1),
+      hashNext(size, -1), slotBucket(size, -1), pageSizes(0), numValid(0),
       aarch64(false), aarch64EL(EL0), isPriv(false), isSecure(false),
       isHyp(false), asid(0), vmid(0), hcr(0), dacr(0),
       miscRegValid(false), miscRegContext(0), curTranType(NormalTran)
 {
     const ArmSystem *sys = dynamic_cast<const ArmSystem *>(p.sys);
 
+    // Start with the slots in table order, slot 0 most recently used.
+    for (int x = 0; x < size; x++) {
+        lruPrev[x] = x - 1;
+        lruNext[x] = x + 1 < size ? x + 1 : -1;
+        lruStamp[x] = size - x;
+    }
+    lruSeq = size;
+    sizeCount.fill(0);
+
     tableWalker->setTlb(this);
 
     // Cache system-level properties
@@ -162,6 +178,86 @@ TLB::finalizePhysical(const RequestPtr &req,
     return NoFault;
 }
 
+void
+TLB::lruMoveToFront(int slot)
+{
+    lruStamp[slot] = ++lruSeq;
+    if (slot == lruHead)
+        return;
+
+    // Unlink...
+    lruNext[lruPrev[slot]] = lruNext[slot];
+    if (lruNext[slot] >= 0)
+        lruPrev[lruNext[slot]] = lruPrev[slot];
+    else
+        lruTail = lruPrev[slot];
+
+    // ...and put back at the head
+    lruPrev[slot] = -1;
+    lruNext[slot] = lruHead;
+    lruPrev[lruHead] = slot;
+    lruHead = slot;
+}
+
+bool
+TLB::inMRURange(int slot) const
+{
+    int x = lruHead;
+    for (int pos = 0; pos <= rangeMRU && x >= 0; pos++, x = lruNext[x]) {
+        if (x == slot)
+            return true;
+    }
+    return false;
+}
+
+void
+TLB::linkEntry(int slot)
+{
+    const TlbEntry &te = table[slot];
+    assert(te.valid && slotBucket[slot] < 0);
+    // The index assumes an entry covers exactly one page of its size
+    assert(te.size == mask(te.N));
+
+    int bucket = hashBucket(te.vpn, te.N);
+    hashNext[slot] = hashHeads[bucket];
+    hashHeads[bucket] = slot;
+    slotBucket[slot] = bucket;
+
+    sizeCount[te.N]++;
+    pageSizes |= 1ULL << te.N;
+    asidCount[te.asid]++;
+    numValid++;
+}
+
+void
+TLB::unlinkEntry(int slot)
+{
+    int bucket = slotBucket[slot];
+    if (bucket < 0)
+        return;
+
+    int *link = &hashHeads[bucket];
+    while (*link != slot)
+        link = &hashNext[*link];
+    *link = hashNext[slot];
+    slotBucket[slot] = -1;
+
+    const TlbEntry &te = table[slot];
+    if (--sizeCount[te.N] == 0)
+        pageSizes &= ~(1ULL << te.N);
+    auto asid_it = asidCount.find(te.asid);
+    if (--asid_it->second == 0)
+        asidCount.erase(asid_it);
+    numValid--;
+}
+
+void
+TLB::invalidate(int slot)
+{
+    unlinkEntry(slot);
+    table[slot].valid = false;
+}
+
 TlbEntry*
 TLB::lookup(Addr va, uint16_t asn, uint8_t vmid, bool hyp, bool secure,
             bool functional, bool ignore_asn, ExceptionLevel target_el,
@@ -170,27 +266,31 @@ TLB::lookup(Addr va, uint16_t asn, uint8_t vmid, bool hyp, bool secure,
 
     TlbEntry *retval = NULL;
 
-    // Maintaining LRU array
-    int x = 0;
-    while (retval == NULL && x < size) {
-        if ((!ignore_asn && table[x].match(va, asn, vmid, hyp, secure, false,
-             target_el, in_host)) ||
-            (ignore_asn && table[x].match(va, vmid, hyp, secure, target_el,
-             in_host))) {
-            // We only move the hit entry ahead when the position is higher
-            // than rangeMRU
-            if (x > rangeMRU && !functional) {
-                TlbEntry tmp_entry = table[x];
-                for (int i = x; i > 0; i--)
-                    table[i] = table[i - 1];
-                table[0] = tmp_entry;
-                retval = &table[0];
-            } else {
-                retval = &table[x];
+    // Of the entries which match, use the most recently used one
+    int hit = -1;
+    for (uint64_t sizes = pageSizes; sizes; sizes &= sizes - 1) {
+        const unsigned n = findLsbSet(sizes);
+        const Addr vpn = va >> n;
+        for (int x = hashHeads[hashBucket(vpn, n)]; x >= 0; x = hashNext[x]) {
+            const TlbEntry &te = table[x];
+            if (te.N != n || te.vpn != vpn)
+                continue;
+            if ((hit < 0 || lruStamp[x] > lruStamp[hit]) &&
+                ((!ignore_asn && te.match(va, asn, vmid, hyp, secure, false,
+                  target_el, in_host)) ||
+                 (ignore_asn && te.match(va, vmid, hyp, secure, target_el,
+                  in_host)))) {
+                hit = x;
             }
-            break;
         }
-        ++x;
+    }
+
+    if (hit >= 0) {
+        // We only move the hit entry ahead when the position is higher
+        // than rangeMRU
+        if (!functional && !inMRURange(hit))
+            lruMoveToFront(hit);
+        retval = &table[hit];
     }
 
     DPRINTF(TLBVerbose, "Lookup %#x, asn %#x -> %s vmn 0x%x hyp %d secure %d "
@@ -218,20 +318,22 @@ TLB::insert(Addr addr, TlbEntry &entry)
             entry.ap, static_cast<uint8_t>(entry.domain), entry.ns, entry.nstid,
             entry.isHyp);
 
-    if (table[size - 1].valid)
+    //inserting to MRU position and evicting the LRU one
+    const int victim = lruTail;
+    TlbEntry &old = table[victim];
+
+    if (old.valid)
         DPRINTF(TLB, " - Replacing Valid entry %#x, asn %d vmn %d ppn %#x "
                 "size: %#x ap:%d ns:%d nstid:%d g:%d isHyp:%d el: %d\n",
-                table[size-1].vpn << table[size-1].N, table[size-1].asid,
-                table[size-1].vmid, table[size-1].pfn << table[size-1].N,
-                table[size-1].size, table[size-1].ap, table[size-1].ns,
-                table[size-1].nstid, table[size-1].global, table[size-1].isHyp,
-                table[size-1].el);
+                old.vpn << old.N, old.asid, old.vmid, old.pfn << old.N,
+                old.size, old.ap, old.ns, old.nstid, old.global, old.isHyp,
+                old.el);
 
-    //inserting to MRU position and evicting the LRU one
-
-    for (int i = size - 1; i > 0; --i)
-        table[i] = table[i-1];
-    table[0] = entry;
+    unlinkEntry(victim);
+    table[victim] = entry;
+    if (entry.valid)
+        linkEntry(victim);
+    lruMoveToFront(victim);
 
     stats.inserts++;
     ppRefills->notify(1);
@@ -240,14 +342,11 @@ TLB::insert(Addr addr, TlbEntry &entry)
 void
 TLB::printTlb() const
 {
-    int x = 0;
-    TlbEntry *te;
     DPRINTF(TLB, "Current TLB contents:\n");
-    while (x < size) {
-        te = &table[x];
+    for (int x = lruHead; x >= 0; x = lruNext[x]) {
+        const TlbEntry *te = &table[x];
         if (te->valid)
             DPRINTF(TLB, " *  %s\n", te->print());
-        ++x;
     }
 }
 
@@ -255,16 +354,12 @@ void
 TLB::flushAll()
 {
     DPRINTF(TLB, "Flushing all TLB entries\n");
-    int x = 0;
-    TlbEntry *te;
-    while (x < size) {
-        te = &table[x];
-
-        DPRINTF(TLB, " -  %s\n", te->print());
-        te->valid = false;
-        stats.flushedEntries++;
-        ++x;
+    tableWalker->flushWalkCache();
+    for (int x = 0; x < size; x++) {
+        DPRINTF(TLB, " -  %s\n", table[x].print());
+        invalidate(x);
     }
+    stats.flushedEntries += size;
 
     stats.flushTlb++;
 
@@ -279,20 +374,18 @@ TLB::flush(const TLBIALL& tlbi_op)
 {
     DPRINTF(TLB, "Flushing all TLB entries (%s lookup)\n",
             (tlbi_op.secureLookup ? "secure" : "non-secure"));
-    int x = 0;
-    TlbEntry *te;
-    while (x < size) {
-        te = &table[x];
+    tableWalker->flushWalkCache();
+    for (int x = 0; numValid && x < size; x++) {
+        TlbEntry *te = &table[x];
         const bool el_match = te->checkELMatch(
             tlbi_op.targetEL, tlbi_op.inHost);
         if (te->valid && tlbi_op.secureLookup == !te->nstid &&
             (te->vmid == vmid || tlbi_op.el2Enabled) && el_match) {
 
             DPRINTF(TLB, " -  %s\n", te->print());
-            te->valid = false;
+            invalidate(x);
             stats.flushedEntries++;
         }
-        ++x;
     }
 
     stats.flushTlb++;
@@ -309,19 +402,17 @@ TLB::flush(const TLBIALLEL &tlbi_op)
 {
     DPRINTF(TLB, "Flushing all TLB entries (%s lookup)\n",
             (tlbi_op.secureLookup ? "secure" : "non-secure"));
-    int x = 0;
-    TlbEntry *te;
-    while (x < size) {
-        te = &table[x];
+    tableWalker->flushWalkCache();
+    for (int x = 0; numValid && x < size; x++) {
+        TlbEntry *te = &table[x];
         const bool el_match = te->checkELMatch(
             tlbi_op.targetEL, tlbi_op.inHost);
         if (te->valid && tlbi_op.secureLookup == !te->nstid && el_match) {
 
             DPRINTF(TLB, " -  %s\n", te->print());
-            te->valid = false;
+            invalidate(x);
             stats.flushedEntries++;
         }
-        ++x;
     }
 
     stats.flushTlb++;
@@ -339,20 +430,18 @@ TLB::flush(const TLBIVMALL &tlbi_op)
 {
     DPRINTF(TLB, "Flushing all TLB entries (%s lookup)\n",
             (tlbi_op.secureLookup ? "secure" : "non-secure"));
-    int x = 0;
-    TlbEntry *te;
-    while (x < size) {
-        te = &table[x];
+    tableWalker->flushWalkCache();
+    for (int x = 0; numValid && x < size; x++) {
+        TlbEntry *te = &table[x];
         const bool el_match = te->checkELMatch(
             tlbi_op.targetEL, tlbi_op.inHost);
         if (te->valid && tlbi_op.secureLookup == !te->nstid &&
             (te->vmid == vmid || !tlbi_op.el2Enabled) && el_match) {
 
             DPRINTF(TLB, " -  %s\n", te->print());
-            te->valid = false;
+            invalidate(x);
             stats.flushedEntries++;
         }
-        ++x;
     }
 
     stats.flushTlb++;
@@ -371,19 +460,17 @@ TLB::flush(const TLBIALLN &tlbi_op)
 
     DPRINTF(TLB, "Flushing all NS TLB entries (%s lookup)\n",
             (hyp ? "hyp" : "non-hyp"));
-    int x = 0;
-    TlbEntry *te;
-    while (x < size) {
-        te = &table[x];
+    tableWalker->flushWalkCache();
+    for (int x = 0; numValid && x < size; x++) {
+        TlbEntry *te = &table[x];
         const bool el_match = te->checkELMatch(tlbi_op.targetEL, false);
 
         if (te->valid && te->nstid && te->isHyp == hyp && el_match) {
 
             DPRINTF(TLB, " -  %s\n", te->print());
             stats.flushedEntries++;
-            te->valid = false;
+            invalidate(x);
         }
-        ++x;
     }
 
     stats.flushTlb++;
@@ -411,21 +498,25 @@ TLB::flush(const TLBIASID &tlbi_op)
     DPRINTF(TLB, "Flushing TLB entries with asid: %#x (%s lookup)\n",
             tlbi_op.asid, (tlbi_op.secureLookup ? "secure" : "non-secure"));
 
-    int x = 0 ;
-    TlbEntry *te;
+    // Nothing to do for an ASID with no entries in this TLB
+    auto asid_it = asidCount.find(tlbi_op.asid);
+    unsigned remaining = asid_it == asidCount.end() ? 0 : asid_it->second;
+    tableWalker->flushWalkCache();
+
+    for (int x = 0; remaining && x < size; x++) {
+        TlbEntry *te = &table[x];
+        if (!te->valid || te->asid != tlbi_op.asid)
+            continue;
+        remaining--;
 
-    while (x < size) {
-        te = &table[x];
-        if (te->valid && te->asid == tlbi_op.asid &&
-            tlbi_op.secureLookup == !te->nstid &&
+        if (tlbi_op.secureLookup == !te->nstid &&
             (te->vmid == vmid || tlbi_op.el2Enabled) &&
             te->checkELMatch(tlbi_op.targetEL, tlbi_op.inHost)) {
 
-            te->valid = false;
+            invalidate(x);
             DPRINTF(TLB, " -  %s\n", te->print());
             stats.flushedEntries++;
         }
-        ++x;
     }
     stats.flushTlbAsid++;
 }
@@ -451,12 +542,13 @@ TLB::_flushMva(Addr mva, uint64_t asn, bool secure_lookup,
 
     bool hyp = target_el == EL2;
 
+    tableWalker->flushWalkCache();
     te = lookup(mva, asn, vmid, hyp, secure_lookup, true, ignore_asn,
                 target_el, in_host);
     while (te != NULL) {
         if (secure_lookup == !te->nstid) {
             DPRINTF(TLB, " -  %s\n", te->print());
-            te->valid = false;
+            invalidate(te - table);
             stats.flushedEntries++;
         }
         te = lookup(mva, asn, vmid, hyp, secure_lookup, true, ignore_asn,
@@ -42,6 +42,10 @@
 #define __ARCH_ARM_TLB_HH__
 
 
+#include <array>
+#include <unordered_map>
+#include <vector>
+
 #include "arch/arm/faults.hh"
 #include "arch/arm/isa_traits.hh"
 #include "arch/arm/pagetable.hh"
@@ -203,6 +207,57 @@ class TLB : public BaseTLB
 
     int rangeMRU; //On lookup, only move entries ahead when outside rangeMRU
 
+    /**
+     * Entries stay in the slot of the table they were inserted in. The
+     * order of the slots from most to least recently used is kept in a
+     * list, and an insert replaces the least recently used slot whether
+     * or not it holds a valid entry, as if the table were kept in LRU
+     * order.
+     */
+    std::vector<int> lruPrev;
+    std::vector<int> lruNext;
+    int lruHead;
+    int lruTail;
+    /** Higher for more recently used slots, to pick the most recently
+     *  used of several matching entries */
+    std::vector<uint64_t> lruStamp;
+    uint64_t lruSeq;
+
+    /**
+     * Valid entries are chained into buckets by page number and size so
+     * a lookup only matches against entries which cover the address.
+     * Lookups try each page size (N) with entries in the TLB.
+     */
+    std::vector<int> hashHeads;
+    std::vector<int> hashNext;
+    /** Bucket each slot is chained into, -1 if it isn't */
+    std::vector<int> slotBucket;
+    std::array<unsigned, 64> sizeCount;
+    uint64_t pageSizes;
+
+    /** Number of entries chained in, to skip flushing an empty TLB */
+    unsigned numValid;
+    /** Number of entries chained in with each ASID, so invalidating an
+     *  ASID which isn't in the TLB doesn't need to look at every entry */
+    std::unordered_map<uint16_t, unsigned> asidCount;
+
+    int
+    hashBucket(Addr vpn, unsigned n) const
+    {
+        return ((vpn ^ (vpn >> 16)) * 0x9E3779B97F4A7C15ULL + n) &
+            (hashHeads.size() - 1);
+    }
+
+    void lruMoveToFront(int slot);
+    bool inMRURange(int slot) const;
+
+    /** Chain a slot holding a valid entry into the lookup structures */
+    void linkEntry(int slot);
+    /** Take a slot out of the lookup structures */
+    void unlinkEntry(int slot);
+    /** Invalidate the entry in a slot */
+    void invalidate(int slot);
+
   public:
     using Params = ArmTLBParams;
     TLB(const Params &p);
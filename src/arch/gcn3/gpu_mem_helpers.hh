@@ -34,6 +34,9 @@
 #ifndef __ARCH_GCN3_GPU_MEM_HELPERS_HH__
 #define __ARCH_GCN3_GPU_MEM_HELPERS_HH__
 
+#include <utility>
+#include <vector>
+
 #include "arch/gcn3/insts/gpu_static_inst.hh"
 #include "arch/gcn3/insts/op_encodings.hh"
 #include "debug/GPUMem.hh"
@@ -44,6 +47,12 @@
  * takes in all of the arguments for a given memory request we are trying to
  * initialize, then submits the request or requests depending on if the
  * original request is aligned or unaligned.
+ *
+ * Non-atomic accesses from consecutive active lanes that touch consecutive
+ * bytes within the same cache line are combined into a single packet. The
+ * lanes' data is laid out contiguously in d_data, so the packet can point
+ * straight at it. Only the first lane of such a run waits for the response,
+ * the rest of the run has no pending request of its own.
  */
 template<typename T, int N>
 inline void
@@ -58,6 +67,10 @@ initMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type,
     RequestPtr req = nullptr, req1 = nullptr, req2 = nullptr;
     PacketPtr pkt = nullptr, pkt1 = nullptr, pkt2 = nullptr;
 
+    // all packets are built before any is sent, so the number of packets
+    // for this instruction is known by the time the coalescer sees them
+    std::vector<std::pair<int, PacketPtr>> lane_pkts;
+
     gpuDynInst->resetEntireStatusVector();
     for (int lane = 0; lane < Gcn3ISA::NumVecElemPerVecReg; ++lane) {
         if (gpuDynInst->exec_mask[lane]) {
@@ -77,6 +90,26 @@ initMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type,
              */
             misaligned_acc = split_addr > vaddr;
 
+            /**
+             * extend the request over the following lanes for as long as
+             * they are active and continue where the previous lane left
+             * off without leaving the cache line.
+             */
+            int last_lane = lane;
+            if (!is_atomic && !misaligned_acc) {
+                Addr line_addr = roundDown(vaddr, block_size);
+                while (last_lane + 1 < Gcn3ISA::NumVecElemPerVecReg &&
+                       gpuDynInst->exec_mask[last_lane + 1]) {
+                    Addr next_addr = gpuDynInst->addr[last_lane + 1];
+                    if (next_addr != gpuDynInst->addr[last_lane] + req_size ||
+                        roundDown(next_addr + req_size - 1, block_size) !=
+                        line_addr) {
+                        break;
+                    }
+                    ++last_lane;
+                }
+            }
+
             if (is_atomic) {
                 // make sure request is word aligned
                 assert((vaddr & 0x3) == 0);
@@ -84,14 +117,15 @@ initMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type,
                 // a given lane's atomic can't cross cache lines
                 assert(!misaligned_acc);
 
-                req = std::make_shared<Request>(vaddr, sizeof(T), 0,
+                req = Request::create(vaddr, sizeof(T), 0,
                     gpuDynInst->computeUnit()->requestorId(), 0,
                     gpuDynInst->wfDynId,
                     gpuDynInst->makeAtomicOpFunctor<T>(
                         &(reinterpret_cast<T*>(gpuDynInst->a_data))[lane],
                         &(reinterpret_cast<T*>(gpuDynInst->x_data))[lane]));
             } else {
-                req = std::make_shared<Request>(vaddr, req_size, 0,
+                req = Request::create(vaddr,
+                                  req_size * (last_lane - lane + 1), 0,
                                   gpuDynInst->computeUnit()->requestorId(), 0,
                                   gpuDynInst->wfDynId);
             }
@@ -111,20 +145,34 @@ initMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type,
                         "request for %#x\n", gpuDynInst->cu_id,
                         gpuDynInst->simdId, gpuDynInst->wfSlotId, lane,
                         split_addr);
-                gpuDynInst->computeUnit()->sendRequest(gpuDynInst, lane, pkt1);
-                gpuDynInst->computeUnit()->sendRequest(gpuDynInst, lane, pkt2);
+                lane_pkts.emplace_back(lane, pkt1);
+                lane_pkts.emplace_back(lane, pkt2);
             } else {
                 gpuDynInst->setStatusVector(lane, 1);
                 gpuDynInst->setRequestFlags(req);
                 pkt = new Packet(req, mem_req_type);
                 pkt->dataStatic(&(reinterpret_cast<T*>(
                     gpuDynInst->d_data))[lane * N]);
-                gpuDynInst->computeUnit()->sendRequest(gpuDynInst, lane, pkt);
+                if (last_lane != lane) {
+                    DPRINTF(GPUMem, "CU%d: WF[%d][%d]: lanes %d-%d combined "
+                            "into one request for %#x\n", gpuDynInst->cu_id,
+                            gpuDynInst->simdId, gpuDynInst->wfSlotId, lane,
+                            last_lane, vaddr);
+                }
+                lane_pkts.emplace_back(lane, pkt);
             }
+
+            lane = last_lane;
         } else { // if lane is not active, then no pending requests
             gpuDynInst->setStatusVector(lane, 0);
         }
     }
+
+    gpuDynInst->numVectorReqs = lane_pkts.size();
+    for (auto &lane_pkt : lane_pkts) {
+        gpuDynInst->computeUnit()->sendRequest(gpuDynInst, lane_pkt.first,
+                                               lane_pkt.second);
+    }
 }
 
 /**
@@ -155,7 +203,7 @@ initMemReqScalarHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type)
      */
     bool misaligned_acc = split_addr > vaddr;
 
-    RequestPtr req = std::make_shared<Request>(vaddr, req_size, 0,
+    RequestPtr req = Request::create(vaddr, req_size, 0,
                                  gpuDynInst->computeUnit()->requestorId(), 0,
                                  gpuDynInst->wfDynId);
 
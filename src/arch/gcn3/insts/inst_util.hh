@@ -294,6 +294,62 @@ namespace Gcn3ISA
         return (VecElemU32)(result >> 64) ? 1 : 0;
     }
 
+    /**
+     * vecLaneOp evaluates op over all lanes of the source operands and
+     * stages the results in vdst. every lane is computed, whether active
+     * or not, so the loop has no per-lane branches and the compiler is
+     * free to vectorize it; inactive lanes are masked off when vdst is
+     * written back to the vrf. only use it for ops with no side effects
+     * that are well defined for any input (e.g., no integer division,
+     * no unmasked shift amounts, no float to int conversions).
+     */
+    template<typename DstOp, typename SrcOp, typename Op>
+    void
+    vecLaneOp(DstOp &vdst, const SrcOp &src, Op op)
+    {
+        typename SrcOp::ElemType s[NumVecElemPerVecReg];
+        src.readLanes(s);
+
+        auto d = vdst.lanes();
+        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+            d[lane] = op(s[lane]);
+        }
+    }
+
+    template<typename DstOp, typename Src0Op, typename Src1Op, typename Op>
+    void
+    vecLaneOp(DstOp &vdst, const Src0Op &src0, const Src1Op &src1, Op op)
+    {
+        typename Src0Op::ElemType s0[NumVecElemPerVecReg];
+        typename Src1Op::ElemType s1[NumVecElemPerVecReg];
+        src0.readLanes(s0);
+        src1.readLanes(s1);
+
+        auto d = vdst.lanes();
+        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+            d[lane] = op(s0[lane], s1[lane]);
+        }
+    }
+
+    template<typename DstOp, typename Src0Op, typename Src1Op,
+             typename Src2Op, typename Op>
+    void
+    vecLaneOp(DstOp &vdst, const Src0Op &src0, const Src1Op &src1,
+              const Src2Op &src2, Op op)
+    {
+        typename Src0Op::ElemType s0[NumVecElemPerVecReg];
+        typename Src1Op::ElemType s1[NumVecElemPerVecReg];
+        typename Src2Op::ElemType s2[NumVecElemPerVecReg];
+        src0.readLanes(s0);
+        src1.readLanes(s1);
+        src2.readLanes(s2);
+
+        auto d = vdst.lanes();
+        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+            d[lane] = op(s0[lane], s1[lane], s2[lane]);
+        }
+    }
+
     /**
      * dppInstImpl is a helper function that performs the inputted operation
      * on the inputted vector register lane.  The returned output lane
@@ -3761,8 +3761,10 @@ namespace Gcn3ISA
         ComputeUnit *cu = gpuDynInst->computeUnit();
 
         // delete extra instructions fetched for completed work-items
-        wf->instructionBuffer.erase(wf->instructionBuffer.begin() + 1,
-            wf->instructionBuffer.end());
+        while (wf->instructionBuffer.size() > 1) {
+            wf->instructionBuffer.back() = nullptr;
+            wf->instructionBuffer.pop_back();
+        }
 
         if (wf->pendingFetch) {
             wf->dropFetch = true;
@@ -5546,7 +5548,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_SUB_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5554,11 +5555,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 - s1;
+        });
 
         vdst.write();
     }
@@ -5578,7 +5577,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_SUBREV_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5586,11 +5584,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 - s0;
+        });
 
         vdst.write();
     }
@@ -5610,7 +5606,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MUL_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5618,11 +5613,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 * s1;
+        });
 
         vdst.write();
     }
@@ -5718,7 +5711,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MUL_I32_I24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -5726,12 +5718,10 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = sext<24>(bits(src0[lane], 23, 0))
-                    * sext<24>(bits(src1[lane], 23, 0));
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return sext<24>(bits(s0, 23, 0))
+                * sext<24>(bits(s1, 23, 0));
+        });
 
         vdst.write();
     }
@@ -5895,7 +5885,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5903,11 +5892,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::fmin(s0, s1);
+        });
 
         vdst.write();
     }
@@ -5927,7 +5914,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5935,11 +5921,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::fmax(s0, s1);
+        });
 
         vdst.write();
     }
@@ -5958,7 +5942,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -5966,11 +5949,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -5989,7 +5970,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -5997,11 +5977,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -6020,7 +5998,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -6028,11 +6005,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -6051,7 +6026,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -6059,11 +6033,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -6083,7 +6055,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_LSHRREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -6091,11 +6062,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 4, 0);
+        });
 
         vdst.write();
     }
@@ -6115,7 +6084,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_ASHRREV_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -6123,11 +6091,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 4, 0);
+        });
 
         vdst.write();
     }
@@ -6219,7 +6185,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_AND_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -6227,11 +6192,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] & src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 & s1;
+        });
 
         vdst.write();
     }
@@ -6324,7 +6287,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_XOR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -6332,11 +6294,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] ^ src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 ^ s1;
+        });
 
         vdst.write();
     }
@@ -6910,7 +6870,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_ADD_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6918,11 +6877,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 + s1;
+        });
 
         vdst.write();
     }
@@ -6941,7 +6898,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_SUB_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6949,11 +6905,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 - s1;
+        });
 
         vdst.write();
     }
@@ -6972,7 +6926,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_SUBREV_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6980,11 +6933,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 - s0;
+        });
 
         vdst.write();
     }
@@ -7003,7 +6954,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MUL_LO_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -7011,11 +6961,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 * s1;
+        });
 
         vdst.write();
     }
@@ -7034,7 +6982,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_LSHLREV_B16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -7042,11 +6989,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 3, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 << bits(s0, 3, 0);
+        });
 
         vdst.write();
     }
@@ -7165,7 +7110,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -7173,11 +7117,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -7196,7 +7138,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, instData.VSRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -7204,11 +7145,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -7227,7 +7166,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -7235,11 +7173,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -7258,7 +7194,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, instData.VSRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -7266,11 +7201,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -7464,17 +7397,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F64_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF64)s;
+        });
 
         vdst.write();
     }
@@ -7494,17 +7424,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)s;
+        });
 
         vdst.write();
     }
@@ -7524,17 +7451,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)s;
+        });
 
         vdst.write();
     }
@@ -7778,17 +7702,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)s;
+        });
 
         vdst.write();
     }
@@ -7808,17 +7729,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F64_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF64)s;
+        });
 
         vdst.write();
     }
@@ -7838,17 +7756,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_UBYTE0::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)(bits(src[lane], 7, 0));
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)(bits(s, 7, 0));
+        });
 
         vdst.write();
     }
@@ -7868,17 +7783,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_UBYTE1::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)(bits(src[lane], 15, 8));
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)(bits(s, 15, 8));
+        });
 
         vdst.write();
     }
@@ -7898,17 +7810,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_UBYTE2::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)(bits(src[lane], 23, 16));
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)(bits(s, 23, 16));
+        });
 
         vdst.write();
     }
@@ -7928,17 +7837,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_UBYTE3::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)(bits(src[lane], 31, 24));
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)(bits(s, 31, 24));
+        });
 
         vdst.write();
     }
@@ -8004,17 +7910,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F64_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF64)s;
+        });
 
         vdst.write();
     }
@@ -8034,17 +7937,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_TRUNC_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::trunc(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::trunc(s);
+        });
 
         vdst.write();
     }
@@ -8064,17 +7964,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CEIL_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ceil(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::ceil(s);
+        });
 
         vdst.write();
     }
@@ -8094,17 +7991,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_RNDNE_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = roundNearestEven(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return roundNearestEven(s);
+        });
 
         vdst.write();
     }
@@ -8124,17 +8018,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_FLOOR_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::floor(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::floor(s);
+        });
 
         vdst.write();
     }
@@ -8185,17 +8076,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_TRUNC_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst (gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::trunc(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::trunc(s);
+        });
 
         vdst.write();
     }
@@ -8215,17 +8103,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CEIL_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ceil(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::ceil(s);
+        });
 
         vdst.write();
     }
@@ -8245,17 +8130,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_RNDNE_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = roundNearestEven(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return roundNearestEven(s);
+        });
 
         vdst.write();
     }
@@ -8275,17 +8157,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_FLOOR_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::floor(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::floor(s);
+        });
 
         vdst.write();
     }
@@ -8305,17 +8184,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_EXP_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::pow(2.0, src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::pow(2.0, s);
+        });
 
         vdst.write();
     }
@@ -8335,17 +8211,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_LOG_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::log2(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::log2(s);
+        });
 
         vdst.write();
     }
@@ -8365,17 +8238,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_RCP_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = 1.0 / src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return 1.0 / s;
+        });
 
         vdst.write();
     }
@@ -8395,17 +8265,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_RCP_IFLAG_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = 1.0 / src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return 1.0 / s;
+        });
 
         vdst.write();
     }
@@ -8425,17 +8292,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_RSQ_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = 1.0 / std::sqrt(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return 1.0 / std::sqrt(s);
+        });
 
         vdst.write();
     }
@@ -8538,17 +8402,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_SQRT_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sqrt(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::sqrt(s);
+        });
 
         vdst.write();
     }
@@ -8568,17 +8429,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_SQRT_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sqrt(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::sqrt(s);
+        });
 
         vdst.write();
     }
@@ -8670,17 +8528,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_NOT_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = ~src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return ~s;
+        });
 
         vdst.write();
     }
@@ -8700,17 +8555,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_BFREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = reverseBits(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return reverseBits(s);
+        });
 
         vdst.write();
     }
@@ -8730,17 +8582,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_FFBH_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = findFirstOneMsb(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return findFirstOneMsb(s);
+        });
 
         vdst.write();
     }
@@ -8760,17 +8609,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_FFBL_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = findFirstOne(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return findFirstOne(s);
+        });
 
         vdst.write();
     }
@@ -8790,17 +8636,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_FFBH_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = firstOppositeSignBit(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return firstOppositeSignBit(s);
+        });
 
         vdst.write();
     }
@@ -9358,17 +9201,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_EXP_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::pow(2.0, src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::pow(2.0, s);
+        });
 
         vdst.write();
     }
@@ -9388,17 +9228,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_LOG_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::log2(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::log2(s);
+        });
 
         vdst.write();
     }
@@ -23184,7 +23021,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_ADD_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23214,11 +23050,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 + s1;
+        });
 
         vdst.write();
     }
@@ -23238,7 +23072,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SUB_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23268,11 +23101,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 - s1;
+        });
 
         vdst.write();
     }
@@ -23292,7 +23123,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SUBREV_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23322,11 +23152,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 - s0;
+        });
 
         vdst.write();
     }
@@ -23543,7 +23371,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MUL_I32_I24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -23561,12 +23388,10 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = sext<24>(bits(src0[lane], 23, 0))
-                    * sext<24>(bits(src1[lane], 23, 0));
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return sext<24>(bits(s0, 23, 0))
+                * sext<24>(bits(s1, 23, 0));
+        });
 
         vdst.write();
     }
@@ -23631,7 +23456,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MUL_U32_U24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -23649,11 +23473,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = bits(src0[lane], 23, 0) * bits(src1[lane], 23, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return bits(s0, 23, 0) * bits(s1, 23, 0);
+        });
 
         vdst.write();
     }
@@ -23716,7 +23538,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23746,11 +23567,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::fmin(s0, s1);
+        });
 
         vdst.write();
     }
@@ -23770,7 +23589,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23800,11 +23618,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::fmax(s0, s1);
+        });
 
         vdst.write();
     }
@@ -23823,7 +23639,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -23841,11 +23656,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -23864,7 +23677,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -23882,11 +23694,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -23905,7 +23715,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -23923,11 +23732,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -23946,7 +23753,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -23964,11 +23770,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -23988,7 +23792,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LSHRREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -24006,11 +23809,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 4, 0);
+        });
 
         vdst.write();
     }
@@ -24030,7 +23831,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_ASHRREV_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -24048,11 +23848,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 4, 0);
+        });
 
         vdst.write();
     }
@@ -24071,7 +23869,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LSHLREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -24089,11 +23886,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 4, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 << bits(s0, 4, 0);
+        });
 
         vdst.write();
     }
@@ -24113,7 +23908,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_AND_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -24131,11 +23925,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] & src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 & s1;
+        });
 
         vdst.write();
     }
@@ -24155,7 +23947,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_OR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -24173,11 +23964,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] | src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 | s1;
+        });
 
         vdst.write();
     }
@@ -24197,7 +23986,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_XOR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -24215,11 +24003,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] ^ src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 ^ s1;
+        });
 
         vdst.write();
     }
@@ -24678,7 +24464,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_ADD_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24696,11 +24481,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 + s1;
+        });
 
         vdst.write();
     }
@@ -24719,7 +24502,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SUB_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24737,11 +24519,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 - s1;
+        });
 
         vdst.write();
     }
@@ -24760,7 +24540,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SUBREV_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24778,11 +24557,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 - s0;
+        });
 
         vdst.write();
     }
@@ -24801,7 +24578,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MUL_LO_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24819,11 +24595,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 * s1;
+        });
 
         vdst.write();
     }
@@ -24842,7 +24616,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LSHLREV_B16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24860,11 +24633,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 3, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 << bits(s0, 3, 0);
+        });
 
         vdst.write();
     }
@@ -24884,7 +24655,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LSHRREV_B16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24908,11 +24678,9 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 3, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 3, 0);
+        });
 
         vdst.write();
     }
@@ -24932,7 +24700,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_ASHRREV_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -24950,11 +24717,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 3, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 3, 0);
+        });
 
         vdst.write();
     }
@@ -25009,7 +24774,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -25033,11 +24797,9 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -25056,7 +24818,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -25080,11 +24841,9 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -25103,7 +24862,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -25127,11 +24885,9 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -25150,7 +24906,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -25174,11 +24929,9 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -25233,17 +24986,14 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MOV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return s;
+        });
 
         vdst.write();
     }
@@ -25315,7 +25065,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F64_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -25329,11 +25078,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF64)s;
+        });
 
         vdst.write();
     }
@@ -25353,7 +25100,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         VecOperandI32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25369,11 +25115,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)s;
+        });
 
         vdst.write();
     }
@@ -25393,7 +25137,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25407,11 +25150,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)s;
+        });
 
         vdst.write();
     }
@@ -25695,7 +25436,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25717,11 +25457,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)s;
+        });
 
         vdst.write();
     }
@@ -25741,7 +25479,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F64_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -25763,11 +25500,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF64)s;
+        });
 
         vdst.write();
     }
@@ -25787,7 +25522,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_UBYTE0::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25801,11 +25535,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)bits(src[lane], 7, 0);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)bits(s, 7, 0);
+        });
 
         vdst.write();
     }
@@ -25825,7 +25557,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_UBYTE1::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25835,16 +25566,14 @@ namespace Gcn3ISA
             src.absModifier();
         }
 
-        if (extData.NEG & 0x1) {
-            src.negModifier();
-        }
-
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)bits(src[lane], 15, 8);
-            }
+        if (extData.NEG & 0x1) {
+            src.negModifier();
         }
 
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)bits(s, 15, 8);
+        });
+
         vdst.write();
     }
 
@@ -25863,7 +25592,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_UBYTE2::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25877,11 +25605,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)bits(src[lane], 23, 16);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)bits(s, 23, 16);
+        });
 
         vdst.write();
     }
@@ -25901,7 +25627,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_UBYTE3::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25915,11 +25640,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)bits(src[lane], 31, 24);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF32)bits(s, 31, 24);
+        });
 
         vdst.write();
     }
@@ -25993,7 +25716,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F64_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -26007,11 +25729,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return (VecElemF64)s;
+        });
 
         vdst.write();
     }
@@ -26031,7 +25751,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_TRUNC_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -26045,11 +25764,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::trunc(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::trunc(s);
+        });
 
         vdst.write();
     }
@@ -26069,7 +25786,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CEIL_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -26083,11 +25799,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ceil(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::ceil(s);
+        });
 
         vdst.write();
     }
@@ -26107,7 +25821,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_RNDNE_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -26121,11 +25834,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = roundNearestEven(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return roundNearestEven(s);
+        });
 
         vdst.write();
     }
@@ -26145,7 +25856,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FLOOR_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -26159,11 +25869,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::floor(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::floor(s);
+        });
 
         vdst.write();
     }
@@ -26222,7 +25930,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_TRUNC_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26236,11 +25943,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::trunc(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::trunc(s);
+        });
 
         vdst.write();
     }
@@ -26260,7 +25965,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CEIL_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26274,11 +25978,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ceil(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::ceil(s);
+        });
 
         vdst.write();
     }
@@ -26298,7 +26000,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_RNDNE_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26312,11 +26013,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = roundNearestEven(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return roundNearestEven(s);
+        });
 
         vdst.write();
     }
@@ -26336,7 +26035,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FLOOR_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26350,11 +26048,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::floor(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::floor(s);
+        });
 
         vdst.write();
     }
@@ -26374,7 +26070,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_EXP_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26388,11 +26083,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::pow(2.0, src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::pow(2.0, s);
+        });
 
         vdst.write();
     }
@@ -26412,7 +26105,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LOG_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26434,11 +26126,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::log2(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::log2(s);
+        });
 
         vdst.write();
     }
@@ -26458,7 +26148,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_RCP_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26472,11 +26161,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = 1.0 / src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return 1.0 / s;
+        });
 
         vdst.write();
     }
@@ -26496,7 +26183,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_RCP_IFLAG_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26510,11 +26196,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = 1.0 / src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return 1.0 / s;
+        });
 
         vdst.write();
     }
@@ -26534,7 +26218,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_RSQ_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26548,11 +26231,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = 1.0 / std::sqrt(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return 1.0 / std::sqrt(s);
+        });
 
         vdst.write();
     }
@@ -26670,7 +26351,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SQRT_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26684,11 +26364,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sqrt(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::sqrt(s);
+        });
 
         vdst.write();
     }
@@ -26708,7 +26386,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SQRT_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -26722,11 +26399,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sqrt(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::sqrt(s);
+        });
 
         vdst.write();
     }
@@ -26826,17 +26501,14 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_NOT_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = ~src[lane];
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return ~s;
+        });
 
         vdst.write();
     }
@@ -26856,17 +26528,14 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_BFREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = reverseBits(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return reverseBits(s);
+        });
 
         vdst.write();
     }
@@ -26886,7 +26555,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FFBH_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
@@ -26900,11 +26568,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = findFirstOneMsb(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return findFirstOneMsb(s);
+        });
 
         vdst.write();
     }
@@ -26924,7 +26590,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FFBL_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
@@ -26938,11 +26603,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = findFirstOne(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return findFirstOne(s);
+        });
 
         vdst.write();
     }
@@ -26962,7 +26625,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FFBH_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
@@ -26976,11 +26638,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = firstOppositeSignBit(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return firstOppositeSignBit(s);
+        });
 
         vdst.write();
     }
@@ -27569,7 +27229,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_EXP_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -27591,11 +27250,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::pow(2.0, src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::pow(2.0, s);
+        });
 
         vdst.write();
     }
@@ -27615,17 +27272,14 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LOG_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::log2(src[lane]);
-            }
-        }
+        vecLaneOp(vdst, src, [](auto s) {
+            return std::log2(s);
+        });
 
         vdst.write();
     }
@@ -27646,7 +27300,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAD_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -27680,11 +27333,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::fma(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -27705,7 +27356,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAD_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -27739,11 +27389,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::fma(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -27763,7 +27411,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAD_I32_I24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandI32 src2(gpuDynInst, extData.SRC2);
@@ -27783,12 +27430,10 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = sext<24>(bits(src0[lane], 23, 0))
-                    * sext<24>(bits(src1[lane], 23, 0)) + src2[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return sext<24>(bits(s0, 23, 0))
+                * sext<24>(bits(s1, 23, 0)) + s2;
+        });
 
         vdst.write();
     }
@@ -27808,7 +27453,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAD_U32_U24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -27828,12 +27472,10 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = bits(src0[lane], 23, 0) * bits(src1[lane], 23, 0)
-                    + src2[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return bits(s0, 23, 0) * bits(s1, 23, 0)
+                + s2;
+        });
 
         vdst.write();
     }
@@ -27921,7 +27563,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_BFE_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -27941,12 +27582,10 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (src0[lane] >> bits(src1[lane], 4, 0))
-                    & ((1 << bits(src2[lane], 4, 0)) - 1);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return (s0 >> bits(s1, 4, 0))
+                & ((1 << bits(s2, 4, 0)) - 1);
+        });
 
         vdst.write();
     }
@@ -27966,7 +27605,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_BFE_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -27986,12 +27624,10 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (src0[lane] >> bits(src1[lane], 4, 0))
-                    & ((1 << bits(src2[lane], 4, 0)) - 1);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return (s0 >> bits(s1, 4, 0))
+                & ((1 << bits(s2, 4, 0)) - 1);
+        });
 
         vdst.write();
     }
@@ -28010,7 +27646,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_BFI_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -28030,12 +27665,10 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (src0[lane] & src1[lane]) | (~src0[lane]
-                    & src2[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return (s0 & s1) | (~s0
+                & s2);
+        });
 
         vdst.write();
     }
@@ -28056,7 +27689,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FMA_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -28090,11 +27722,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::fma(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -28115,7 +27745,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FMA_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF64 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF64 src2(gpuDynInst, extData.SRC2);
@@ -28149,11 +27778,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::fma(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -28616,7 +28243,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MED3_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -28650,11 +28276,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = median(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return median(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -28673,7 +28297,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MED3_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandI32 src2(gpuDynInst, extData.SRC2);
@@ -28693,11 +28316,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = median(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return median(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -28716,7 +28337,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MED3_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -28736,11 +28356,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = median(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return median(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -28762,7 +28380,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SAD_U8::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -28782,18 +28399,16 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::abs(bits(src0[lane], 31, 24)
-                    - bits(src1[lane], 31, 24))
-                    + std::abs(bits(src0[lane], 23, 16)
-                    - bits(src1[lane], 23, 16))
-                    + std::abs(bits(src0[lane], 15, 8)
-                    - bits(src1[lane], 15, 8))
-                    + std::abs(bits(src0[lane], 7, 0)
-                    - bits(src1[lane], 7, 0)) + src2[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::abs(bits(s0, 31, 24)
+                - bits(s1, 31, 24))
+                + std::abs(bits(s0, 23, 16)
+                - bits(s1, 23, 16))
+                + std::abs(bits(s0, 15, 8)
+                - bits(s1, 15, 8))
+                + std::abs(bits(s0, 7, 0)
+                - bits(s1, 7, 0)) + s2;
+        });
 
         vdst.write();
     }
@@ -28813,7 +28428,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SAD_HI_U8::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -28833,15 +28447,13 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (((bits(src0[lane], 31, 24)
-                    - bits(src1[lane], 31, 24)) + (bits(src0[lane], 23, 16)
-                    - bits(src1[lane], 23, 16)) + (bits(src0[lane], 15, 8)
-                    - bits(src1[lane], 15, 8)) + (bits(src0[lane], 7, 0)
-                    - bits(src1[lane], 7, 0))) << 16) + src2[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return (((bits(s0, 31, 24)
+                - bits(s1, 31, 24)) + (bits(s0, 23, 16)
+                - bits(s1, 23, 16)) + (bits(s0, 15, 8)
+                - bits(s1, 15, 8)) + (bits(s0, 7, 0)
+                - bits(s1, 7, 0))) << 16) + s2;
+        });
 
         vdst.write();
     }
@@ -28862,7 +28474,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SAD_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -28882,14 +28493,12 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::abs(bits(src0[lane], 31, 16)
-                    - bits(src1[lane], 31, 16))
-                    + std::abs(bits(src0[lane], 15, 0)
-                    - bits(src1[lane], 15, 0)) + src2[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::abs(bits(s0, 31, 16)
+                - bits(s1, 31, 16))
+                + std::abs(bits(s0, 15, 0)
+                - bits(s1, 15, 0)) + s2;
+        });
 
         vdst.write();
     }
@@ -28909,7 +28518,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SAD_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -28929,11 +28537,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::abs(src0[lane] - src1[lane]) + src2[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::abs(s0 - s1) + s2;
+        });
 
         vdst.write();
     }
@@ -29353,11 +28959,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::fma(s0, s1, s2);
+        });
 
         //vdst.write();
     } // execute
@@ -29632,7 +29236,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAD_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU16 src2(gpuDynInst, extData.SRC2);
@@ -29652,11 +29255,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane] + src2[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return s0 * s1 + s2;
+        });
 
         vdst.write();
     }
@@ -29677,7 +29278,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAD_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandI16 src2(gpuDynInst, extData.SRC2);
@@ -29697,11 +29297,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane] + src2[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return s0 * s1 + s2;
+        });
 
         vdst.write();
     }
@@ -30175,7 +29773,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF64 src1(gpuDynInst, extData.SRC1);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
@@ -30205,11 +29802,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::fmin(s0, s1);
+        });
 
         vdst.write();
     }
@@ -30229,7 +29824,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF64 src1(gpuDynInst, extData.SRC1);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
@@ -30259,11 +29853,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::fmax(s0, s1);
+        });
 
         vdst.write();
     }
@@ -30473,7 +30065,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LDEXP_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -30489,11 +30080,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ldexp(src0[lane], src1[lane]);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::ldexp(s0, s1);
+        });
 
         vdst.write();
     }
@@ -30592,7 +30181,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_BCNT_U32_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -30610,11 +30198,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = popCount(src0[lane]) + src1[lane];
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return popCount(s0) + s1;
+        });
 
         vdst.write();
     }
@@ -30747,11 +30333,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 5, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 << bits(s0, 5, 0);
+        });
 
         vdst.write();
     }
@@ -30771,7 +30355,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LSHRREV_B64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU64 src1(gpuDynInst, extData.SRC1);
         VecOperandU64 vdst(gpuDynInst, instData.VDST);
@@ -30789,11 +30372,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 5, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 5, 0);
+        });
 
         vdst.write();
     }
@@ -30872,7 +30453,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_BFM_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -30890,12 +30470,10 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = ((1 << bits(src0[lane], 4, 0)) - 1)
-                    << bits(src1[lane], 4, 0);
-            }
-        }
+        vecLaneOp(vdst, src0, src1, [](auto s0, auto s1) {
+            return ((1 << bits(s0, 4, 0)) - 1)
+                << bits(s1, 4, 0);
+        });
 
         vdst.write();
     }
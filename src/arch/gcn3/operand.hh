@@ -34,6 +34,7 @@
 #ifndef __ARCH_GCN3_OPERAND_HH__
 #define __ARCH_GCN3_OPERAND_HH__
 
+#include <algorithm>
 #include <array>
 
 #include "arch/gcn3/registers.hh"
@@ -103,6 +104,8 @@ namespace Gcn3ISA
             "Incorrect number of DWORDS for GCN3 operand.");
 
       public:
+        typedef DataType ElemType;
+
         VecOperand() = delete;
 
         VecOperand(GPUDynInstPtr gpuDynInst, int opIdx)
@@ -314,6 +317,52 @@ namespace Gcn3ISA
             return vecReg.template as<DataType>()[idx];
         }
 
+        /**
+         * copy the value of every lane into a flat array. a scalar source
+         * and the abs/neg modifiers are resolved once for the whole
+         * operand, rather than in each call to operator[], so that the
+         * callers' per-lane loops are straight-line and can be vectorized.
+         */
+        template<bool Condition = NumDwords == 1 || NumDwords == 2>
+        typename std::enable_if_t<Condition, void>
+        readLanes(DataType *lanes) const
+        {
+            if (scalar) {
+                std::fill_n(lanes, NumVecElemPerVecReg,
+                            (DataType)scRegData.rawData());
+            } else {
+                std::memcpy((void*)lanes,
+                    (const void*)vecReg.template raw_ptr<DataType>(),
+                    NumVecElemPerVecReg * sizeof(DataType));
+            }
+
+            if (absMod) {
+                assert(std::is_floating_point<DataType>::value);
+                for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                    lanes[lane] = std::fabs(lanes[lane]);
+                }
+            }
+
+            if (negMod) {
+                assert(std::is_floating_point<DataType>::value);
+                for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                    lanes[lane] = -lanes[lane];
+                }
+            }
+        }
+
+        /**
+         * direct access to the staged lanes of a destination operand. the
+         * exec mask is applied when the data is written back to the vrf.
+         */
+        template<bool Condition = (NumDwords == 1 || NumDwords == 2) && !Const>
+        typename std::enable_if_t<Condition, DataType*>
+        lanes()
+        {
+            assert(!scalar);
+            return vecReg.template raw_ptr<DataType>();
+        }
+
         private:
           /**
            * if we determine that this operand is a scalar (reg or constant)
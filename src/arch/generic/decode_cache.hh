@@ -40,13 +40,18 @@ template <typename Decoder, typename EMI>
 class BasicDecodeCache
 {
   private:
-    DecodeCache::InstMap<EMI> instMap;
-    struct AddrMapEntry
+    typedef typename DecodeCache::InstMap<EMI>::Entry InstMapEntry;
+
+    /// Instructions decoded by all the decoders of the ISA.
+    static DecodeCache::InstMap<EMI> &
+    instMap()
     {
-        StaticInstPtr inst;
-        EMI machInst;
-    };
-    DecodeCache::AddrMap<AddrMapEntry> decodePages;
+        static DecodeCache::InstMap<EMI> map;
+        return map;
+    }
+
+    /// The instructions this decoder last decoded at each address.
+    DecodeCache::AddrMap<const InstMapEntry *> decodePages;
 
   public:
     /// Decode a machine instruction.
@@ -56,20 +61,15 @@ class BasicDecodeCache
     decode(Decoder *const decoder, EMI mach_inst, Addr addr)
     {
         auto &entry = decodePages.lookup(addr);
-        if (entry.inst && (entry.machInst == mach_inst))
-            return entry.inst;
+        if (entry && (entry->machInst == mach_inst))
+            return entry->inst;
 
-        entry.machInst = mach_inst;
-
-        auto iter = instMap.find(mach_inst);
-        if (iter != instMap.end()) {
-            entry.inst = iter->second;
-            return entry.inst;
+        entry = instMap().find(mach_inst);
+        if (!entry) {
+            entry = instMap().insert(mach_inst,
+                                     decoder->decodeInst(mach_inst));
         }
-
-        entry.inst = decoder->decodeInst(mach_inst);
-        instMap[mach_inst] = entry.inst;
-        return entry.inst;
+        return entry->inst;
     }
 };
 
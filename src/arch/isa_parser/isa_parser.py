@@ -266,9 +266,9 @@ class GenCode(object):
         if self.header_output:
             self.parser.get_file('header').write(self.header_output)
         if self.decoder_output:
-            self.parser.get_file('decoder').write(self.decoder_output)
+            self.parser.write_splittable('decoder', self.decoder_output)
         if self.exec_output:
-            self.parser.get_file('exec').write(self.exec_output)
+            self.parser.write_splittable('exec', self.exec_output)
         if self.decode_block:
             self.parser.get_file('decode_block').write(self.decode_block)
 
@@ -277,8 +277,10 @@ class GenCode(object):
     def __add__(self, other):
         return GenCode(self.parser,
                        self.header_output + other.header_output,
-                       self.decoder_output + other.decoder_output,
-                       self.exec_output + other.exec_output,
+                       self.parser.join_splittable('decoder',
+                           self.decoder_output, other.decoder_output),
+                       self.parser.join_splittable('exec',
+                           self.exec_output, other.exec_output),
                        self.decode_block + other.decode_block,
                        self.has_decode_default or other.has_decode_default)
 
@@ -482,10 +484,19 @@ class InstObjParams(object):
 #
 
 class ISAParser(Grammar):
-    def __init__(self, output_dir):
+    def __init__(self, output_dir, decoder_splits=1, exec_splits=1):
         super(ISAParser, self).__init__()
         self.output_dir = output_dir
 
+        # Number of chunks the splittable sections should be automatically
+        # divided into. A value of 1 leaves splitting up to explicit 'split'
+        # directives in the ISA description.
+        self.autoSplits = { 'decoder' : decoder_splits,
+                            'exec' : exec_splits }
+        # Code emitted into automatically split sections, buffered until
+        # the whole description has been parsed so the chunks can be sized.
+        self.pendingChunks = { 'decoder' : [], 'exec' : [] }
+
         self.filename = None # for output file watermarking/scaremongering
 
         # variable to hold templates
@@ -857,6 +868,10 @@ class ISAParser(Grammar):
     def p_specification(self, t):
         'specification : opt_defs_and_outputs top_level_decode_block'
 
+        for sec in ('decoder', 'exec'):
+            if self.autoSplits[sec] > 1:
+                self.write_auto_splits(sec)
+
         for f in self.splits.keys():
             f.write('\n#endif\n')
 
@@ -898,16 +913,74 @@ class ISAParser(Grammar):
                          | global_let
                          | split'''
 
+    # Marks where the code of two GenCode objects was joined together, so
+    # the code generated for the instructions of a decode block can still
+    # be divided up after it's been gathered into a single emission.
+    chunkBoundary = '\n// isa_parser chunk boundary\n'
+
+    def join_splittable(self, sec, first, second):
+        if self.autoSplits[sec] > 1 and first and second:
+            return first + self.chunkBoundary + second
+        return first + second
+
+    # Write code into one of the splittable sections. If the section is
+    # split automatically, only the boundaries between emissions or between
+    # joined GenCode objects are candidates for a split, so a chunk never
+    # ends in the middle of the code generated for an instruction.
+    def write_splittable(self, sec, code):
+        if self.namespace and self.autoSplits[sec] > 1:
+            self.pendingChunks[sec].extend(code.split(self.chunkBoundary))
+        else:
+            self.get_file(sec).write(
+                    code.replace(self.chunkBoundary, ''))
+
+    cppCondRE = re.compile(r'^\s*#\s*(if|ifdef|ifndef|endif)\b',
+                           re.MULTILINE)
+
+    # Distribute the buffered emissions of an automatically split section
+    # over the requested number of chunks, balancing them by size. Chunks
+    # are never split inside a preprocessor conditional, since those are
+    # replicated around the code of the instructions they guard.
+    def write_auto_splits(self, sec):
+        chunks = self.pendingChunks[sec]
+        splits = self.autoSplits[sec]
+        f = self.get_file(sec)
+
+        total = sum(len(c) for c in chunks)
+        written = 0
+        depth = 0
+        for code in chunks:
+            if depth == 0 and self.splits[f] < splits and \
+                    written * splits >= total * self.splits[f]:
+                f.write(self.next_split(sec))
+            f.write(code)
+            written += len(code)
+            for m in self.cppCondRE.finditer(code):
+                depth += -1 if m.group(1) == 'endif' else 1
+
+        # Every chunk has to exist even if there wasn't enough to fill it.
+        while self.splits[f] < splits:
+            f.write(self.next_split(sec))
+
+    # Start the next chunk of a splittable section.
+    def next_split(self, sec):
+        f = self.get_file(sec)
+        self.splits[f] += 1
+        return '\n#endif\n#if __SPLIT == %u\n' % self.splits[f]
+
     # Utility function used by both invocations of splitting - explicit
     # 'split' keyword and split() function inside "let {{ }};" blocks.
+    # When the section is split automatically, these only mark places
+    # where the parser is allowed to start a new chunk.
     def split(self, sec, write=False):
         assert(sec != 'header' and "header cannot be split")
 
-        f = self.get_file(sec)
-        self.splits[f] += 1
-        s = '\n#endif\n#if __SPLIT == %u\n' % self.splits[f]
+        if self.autoSplits[sec] > 1:
+            s = self.chunkBoundary
+        else:
+            s = self.next_split(sec)
         if write:
-            f.write(s)
+            self.write_splittable(sec, s)
         else:
             return s
 
@@ -1658,6 +1731,7 @@ StaticInstPtr
             sys.exit(1)
 
 # Called as script: get args from command line.
-# Args are: <isa desc file> <output dir>
+# Args are: <isa desc file> <output dir> [<decoder splits> <exec splits>]
 if __name__ == '__main__':
-    ISAParser(sys.argv[2]).parse_isa_desc(sys.argv[1])
+    ISAParser(sys.argv[2], *[int(n) for n in sys.argv[3:5]]).parse_isa_desc(
+            sys.argv[1])
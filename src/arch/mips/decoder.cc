@@ -31,6 +31,4 @@
 namespace MipsISA
 {
 
-GenericISA::BasicDecodeCache<Decoder, ExtMachInst> Decoder::defaultCache;
-
 }
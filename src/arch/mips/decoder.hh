@@ -88,7 +88,7 @@ class Decoder : public InstDecoder
 
   protected:
     /// A cache of decoded instruction objects.
-    static GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
+    GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
 
   public:
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
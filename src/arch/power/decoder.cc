@@ -31,6 +31,4 @@
 namespace PowerISA
 {
 
-GenericISA::BasicDecodeCache<Decoder, ExtMachInst> Decoder::defaultCache;
-
 }
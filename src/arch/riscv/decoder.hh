@@ -46,7 +46,8 @@ class ISA;
 class Decoder : public InstDecoder
 {
   private:
-    DecodeCache::InstMap<ExtMachInst> instMap;
+    /// A cache of decoded instruction objects.
+    GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
     bool aligned;
     bool mid;
     bool more;
@@ -31,6 +31,4 @@
 namespace SparcISA
 {
 
-GenericISA::BasicDecodeCache<Decoder, ExtMachInst> Decoder::defaultCache;
-
 }
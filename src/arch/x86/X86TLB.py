@@ -47,12 +47,20 @@ class X86PagetableWalker(ClockedObject):
     system = Param.System(Parent.any, "system object")
     num_squash_per_cycle = Param.Unsigned(4,
             "Number of outstanding walks that can be squashed per cycle")
+    pwc_size = Param.Unsigned(0, "Number of entries for each level of the "
+            "page walk cache, 0 to disable it")
+    pwc_assoc = Param.Unsigned(4, "Associativity of the page walk cache")
 
 class X86TLB(BaseTLB):
     type = 'X86TLB'
     cxx_class = 'X86ISA::TLB'
     cxx_header = 'arch/x86/tlb.hh'
     size = Param.Unsigned(64, "TLB size")
+    assoc = Param.Unsigned(0, "TLB associativity, 0 for fully associative")
     system = Param.System(Parent.any, "system object")
     walker = Param.X86PagetableWalker(\
-            X86PagetableWalker(), "page table walker")
+            X86PagetableWalker(), "page table walker, NULL for a TLB "
+            "which is only used as the next level of another")
+    next_level = Param.X86TLB(NULL, "Next level TLB, looked up on a miss "
+            "before walking the page table. It may be shared by the "
+            "instruction and data TLBs of a CPU, but not between CPUs")
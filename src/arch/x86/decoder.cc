@@ -671,19 +671,15 @@ Decoder::doImmediateState()
 
 Decoder::InstBytes Decoder::dummy;
 Decoder::InstCacheMap Decoder::instCacheMap;
+std::mutex Decoder::instCacheMapLock;
 
 StaticInstPtr
 Decoder::decode(ExtMachInst mach_inst, Addr addr)
 {
-    StaticInstPtr si;
-
-    auto iter = instMap->find(mach_inst);
-    if (iter != instMap->end()) {
-        si = iter->second;
-    } else {
-        si = decodeInst(mach_inst);
-        (*instMap)[mach_inst] = si;
-    }
+    auto *entry = instMap->find(mach_inst);
+    if (!entry)
+        entry = instMap->insert(mach_inst, decodeInst(mach_inst));
+    const StaticInstPtr &si = entry->inst;
 
     DPRINTF(Decode, "Decode: Decoded %s instruction: %#x\n",
             si->getName(), mach_inst);
@@ -30,6 +30,7 @@
 #define __ARCH_X86_DECODER_HH__
 
 #include <cassert>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -236,10 +237,13 @@ class Decoder : public InstDecoder
     typedef std::unordered_map<CacheKey, DecodePages *> AddrCacheMap;
     AddrCacheMap addrCacheMap;
 
+    // The instruction maps are shared by the decoders of all the CPUs,
+    // which may be on different event queue threads.
     DecodeCache::InstMap<ExtMachInst> *instMap = nullptr;
     typedef std::unordered_map<
             CacheKey, DecodeCache::InstMap<ExtMachInst> *> InstCacheMap;
     static InstCacheMap instCacheMap;
+    static std::mutex instCacheMapLock;
 
   public:
     Decoder(ISA *isa=nullptr)
@@ -270,6 +274,7 @@ class Decoder : public InstDecoder
             addrCacheMap[m5Reg] = decodePages;
         }
 
+        std::lock_guard<std::mutex> guard(instCacheMapLock);
         InstCacheMap::iterator imIter = instCacheMap.find(m5Reg);
         if (imIter != instCacheMap.end()) {
             instMap = imIter->second;
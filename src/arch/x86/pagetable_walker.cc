@@ -49,12 +49,14 @@
 
 #include "arch/x86/pagetable_walker.hh"
 
+#include <algorithm>
 #include <memory>
 
 #include "arch/x86/faults.hh"
 #include "arch/x86/pagetable.hh"
 #include "arch/x86/tlb.hh"
 #include "base/bitfield.hh"
+#include "base/intmath.hh"
 #include "base/trie.hh"
 #include "cpu/base.hh"
 #include "cpu/thread_context.hh"
@@ -64,13 +66,89 @@
 
 namespace X86ISA {
 
+Walker::Walker(const Params &params) :
+    ClockedObject(params), port(name() + ".port", this),
+    funcState(this, NULL, NULL, true), tlb(NULL), sys(params.system),
+    requestorId(sys->getRequestorId(this)),
+    numSquashable(params.num_squash_per_cycle),
+    pwcAssoc(std::min(params.pwc_assoc, params.pwc_size)),
+    pwcSets(pwcAssoc ? params.pwc_size / pwcAssoc : 0), pwcSeq(0),
+    pwc(params.pwc_size * NumPwcLevels), stats(this),
+    startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
+{
+    fatal_if(pwcAssoc && (params.pwc_size % pwcAssoc || !isPowerOf2(pwcSets)),
+             "%s: The page walk cache size (%d) must be a power of two "
+             "multiple of its associativity (%d).\n", name(),
+             params.pwc_size, params.pwc_assoc);
+}
+
+Walker::WalkerStats::WalkerStats(Stats::Group *parent)
+  : Stats::Group(parent),
+    ADD_STAT(walks, UNIT_COUNT, "Number of page table walks started"),
+    ADD_STAT(coalesced, UNIT_COUNT,
+             "Queued walks finished from the TLB filled by an earlier walk"),
+    ADD_STAT(pwcHits, UNIT_COUNT,
+             "Walks started below the top level by the page walk cache, "
+             "by the level of the cached entry used")
+{
+    pwcHits
+        .init(NumPwcLevels)
+        .subname(0, "pml4")
+        .subname(1, "pdp")
+        .subname(2, "pd")
+        .flags(Stats::nozero);
+}
+
+const Walker::PwcEntry *
+Walker::lookupPwc(unsigned level, Addr pdtb, Addr vaddr)
+{
+    Addr vpn = bits(vaddr, 47, pwcShift(level));
+    unsigned set_start = (level * pwcSets + (vpn & (pwcSets - 1))) * pwcAssoc;
+    for (unsigned way = set_start; way < set_start + pwcAssoc; way++) {
+        PwcEntry &pwc_entry = pwc[way];
+        if (pwc_entry.valid && pwc_entry.vpn == vpn &&
+                pwc_entry.pdtb == pdtb) {
+            pwc_entry.lruSeq = ++pwcSeq;
+            return &pwc_entry;
+        }
+    }
+    return NULL;
+}
+
+void
+Walker::insertPwc(unsigned level, const PwcEntry &pwc_entry)
+{
+    unsigned set_start =
+        (level * pwcSets + (pwc_entry.vpn & (pwcSets - 1))) * pwcAssoc;
+    unsigned victim = set_start;
+    for (unsigned way = set_start; way < set_start + pwcAssoc; way++) {
+        if (pwc[way].valid && pwc[way].vpn == pwc_entry.vpn &&
+                pwc[way].pdtb == pwc_entry.pdtb) {
+            victim = way;
+            break;
+        }
+        if (!pwc[way].valid ||
+                (pwc[victim].valid && pwc[way].lruSeq < pwc[victim].lruSeq))
+            victim = way;
+    }
+    pwc[victim] = pwc_entry;
+    pwc[victim].valid = true;
+    pwc[victim].lruSeq = ++pwcSeq;
+}
+
+void
+Walker::flushPageWalkCache()
+{
+    for (auto &pwc_entry : pwc)
+        pwc_entry.valid = false;
+}
+
 Fault
 Walker::start(ThreadContext * _tc, BaseTLB::Translation *_translation,
               const RequestPtr &_req, BaseTLB::Mode _mode)
 {
-    // TODO: in timing mode, instead of blocking when there are other
-    // outstanding requests, see if this request can be coalesced with
-    // another one (i.e. either coalesce or start walk)
+    // In timing mode, requests queue up behind an outstanding walk and
+    // are coalesced with it in startWalkWrapper if it fills their page.
     WalkerState * newState = new WalkerState(this, _translation, _req);
     newState->initState(_tc, _mode, sys->isTimingMode());
     if (currStates.size()) {
@@ -218,6 +296,35 @@ Walker::startWalkWrapper()
         else
             currState = NULL;
     }
+
+    // Walks queue up behind the one in progress, so a queued walk to a
+    // page that an earlier walk has just filled in can be finished from
+    // the TLB without touching the page tables again.
+    while (currState && !currState->wasStarted() &&
+           !currState->translation->squashed() &&
+           tlb->lookup(currState->req->getVaddr(), false)) {
+        currStates.pop_front();
+        stats.coalesced++;
+
+        DPRINTF(PageTableWalker, "Coalescing table walk for address %#x\n",
+            currState->req->getVaddr());
+
+        bool delayedResponse;
+        Fault fault = tlb->translate(currState->req, currState->tc, NULL,
+                                     currState->mode, delayedResponse, true);
+        // If the translation missed after all it queued a new walk which
+        // will finish it.
+        if (!delayedResponse) {
+            currState->translation->finish(fault, currState->req,
+                                           currState->tc, currState->mode);
+        }
+        delete currState;
+
+        if (currStates.size())
+            currState = currStates.front();
+        else
+            currState = NULL;
+    }
     if (currState && !currState->wasStarted())
         currState->startWalk();
 }
@@ -308,6 +415,8 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             break;
         }
         entry.noExec = pte.nx;
+        upperNX = pte.nx;
+        cacheWalk(0, (uint64_t)pte & (mask(40) << 12), uncacheable);
         nextState = LongPDP;
         break;
       case LongPDP:
@@ -323,6 +432,8 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             fault = pageFault(pte.p);
             break;
         }
+        upperNX = upperNX || pte.nx;
+        cacheWalk(1, (uint64_t)pte & (mask(40) << 12), uncacheable);
         nextState = LongPD;
         break;
       case LongPD:
@@ -342,6 +453,8 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             entry.logBytes = 12;
             nextRead =
                 ((uint64_t)pte & (mask(40) << 12)) + vaddr.longl1 * dataSize;
+            upperNX = upperNX || pte.nx;
+            cacheWalk(2, (uint64_t)pte & (mask(40) << 12), uncacheable);
             nextState = LongPTE;
             break;
         } else {
@@ -518,7 +631,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
         //If we didn't return, we're setting up another read.
         Request::Flags flags = oldRead->req->getFlags();
         flags.set(Request::UNCACHEABLE, uncacheable);
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             nextRead, oldRead->getSize(), flags, walker->requestorId);
         read = new Packet(request, MemCmd::ReadReq);
         read->allocate();
@@ -553,9 +666,12 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     Efer efer = tc->readMiscRegNoEffect(MISCREG_EFER);
     dataSize = 8;
     Addr topAddr;
+    pdtb = 0;
+    upperNX = false;
     if (efer.lma) {
         // Do long mode.
         state = LongPML4;
+        pdtb = cr3.longPdtb;
         topAddr = (cr3.longPdtb << 12) + addr.longl4 * dataSize;
         enableNX = efer.nxe;
     } else {
@@ -587,13 +703,75 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     if (cr3.pcd)
         flags.set(Request::UNCACHEABLE);
 
-    RequestPtr request = std::make_shared<Request>(
+    if (!functional) {
+        walker->stats.walks++;
+        if (state == LongPML4 && walker->pwcAssoc)
+            resumeCachedWalk(addr, flags, topAddr);
+    }
+
+    RequestPtr request = Request::create(
         topAddr, dataSize, flags, walker->requestorId);
 
     read = new Packet(request, MemCmd::ReadReq);
     read->allocate();
 }
 
+void
+Walker::WalkerState::resumeCachedWalk(VAddr addr, Request::Flags &flags,
+                                      Addr &topAddr)
+{
+    // Start from the lowest level table the page walk cache knows.
+    static const State startStates[NumPwcLevels] = {
+        LongPDP, LongPD, LongPTE
+    };
+    const Addr indices[NumPwcLevels] = {
+        addr.longl3, addr.longl2, addr.longl1
+    };
+
+    for (int level = NumPwcLevels - 1; level >= 0; level--) {
+        const PwcEntry *cached = walker->lookupPwc(level, pdtb, addr);
+        if (!cached)
+            continue;
+
+        // Execute permission faults are raised by the level that forbids
+        // it, so leave those to a full walk.
+        if (cached->upperNX && mode == BaseTLB::Execute && enableNX)
+            return;
+
+        DPRINTF(PageTableWalker, "Page walk cache hit at level %d for "
+                "%#x, table at %#x.\n", level, (Addr)addr, cached->table);
+        walker->stats.pwcHits[level]++;
+
+        state = startStates[level];
+        topAddr = cached->table + indices[level] * dataSize;
+        flags.set(Request::UNCACHEABLE, cached->uncacheable);
+        entry.writable = cached->writable;
+        entry.user = cached->user;
+        entry.noExec = cached->noExec;
+        entry.logBytes = 12;
+        upperNX = cached->upperNX;
+        return;
+    }
+}
+
+void
+Walker::WalkerState::cacheWalk(unsigned level, Addr table, bool uncacheable)
+{
+    if (functional || !walker->pwcAssoc)
+        return;
+
+    PwcEntry pwc_entry;
+    pwc_entry.pdtb = pdtb;
+    pwc_entry.vpn = bits(entry.vaddr, 47, pwcShift(level));
+    pwc_entry.table = table;
+    pwc_entry.writable = entry.writable;
+    pwc_entry.user = entry.user;
+    pwc_entry.noExec = entry.noExec;
+    pwc_entry.upperNX = upperNX;
+    pwc_entry.uncacheable = uncacheable;
+    walker->insertPwc(level, pwc_entry);
+}
+
 bool
 Walker::WalkerState::recvPacket(PacketPtr pkt)
 {
@@ -47,6 +47,7 @@
 #include "params/X86PagetableWalker.hh"
 #include "sim/clocked_object.hh"
 #include "sim/faults.hh"
+#include "sim/stats.hh"
 #include "sim/system.hh"
 
 class ThreadContext;
@@ -110,6 +111,11 @@ namespace X86ISA
             bool retrying;
             bool started;
             bool squashed;
+            // Page table base from CR3, and whether any of the upper level
+            // entries seen so far forbid execution, for the page walk
+            // cache.
+            Addr pdtb;
+            bool upperNX;
           public:
             WalkerState(Walker * _walker, BaseTLB::Translation *_translation,
                         const RequestPtr &_req, bool _isFunctional = false) :
@@ -135,6 +141,9 @@ namespace X86ISA
 
           private:
             void setupWalk(Addr vaddr);
+            void resumeCachedWalk(VAddr addr, Request::Flags &flags,
+                                  Addr &topAddr);
+            void cacheWalk(unsigned level, Addr table, bool uncacheable);
             Fault stepWalk(PacketPtr &write);
             void sendPackets();
             void endWalk();
@@ -173,6 +182,56 @@ namespace X86ISA
         // The number of outstanding walks that can be squashed per cycle.
         unsigned numSquashable;
 
+        /**
+         * An upper level long mode page table entry held in the page walk
+         * cache, so that later walks under it can skip reading it.
+         */
+        struct PwcEntry
+        {
+            // Page table base from CR3 the entry was found under.
+            Addr pdtb = 0;
+            // Virtual address bits translated by this and the levels
+            // above it.
+            Addr vpn = 0;
+            // Physical address of the next level table.
+            Addr table = 0;
+            uint64_t lruSeq = 0;
+            bool valid = false;
+            // Permissions accumulated down to this level.
+            bool writable = false;
+            bool user = false;
+            bool noExec = false;
+            // Whether any entry down to this level forbids execution.
+            bool upperNX = false;
+            // Whether the next level table is uncacheable.
+            bool uncacheable = false;
+        };
+
+        // Cached levels: PML4, PDP and PD entries.
+        static const unsigned NumPwcLevels = 3;
+
+        // Lowest virtual address bit translated by each cached level.
+        static unsigned pwcShift(unsigned level) { return 39 - 9 * level; }
+
+        unsigned pwcAssoc;
+        unsigned pwcSets;
+        uint64_t pwcSeq;
+        // The page walk cache, one set associative array for each level
+        // stored one after the other.
+        std::vector<PwcEntry> pwc;
+
+        const PwcEntry *lookupPwc(unsigned level, Addr pdtb, Addr vaddr);
+        void insertPwc(unsigned level, const PwcEntry &pwc_entry);
+
+        struct WalkerStats : public Stats::Group
+        {
+            WalkerStats(Stats::Group *parent);
+
+            Stats::Scalar walks;
+            Stats::Scalar coalesced;
+            Stats::Vector pwcHits;
+        } stats;
+
         // Wrapper for checking for squashes before starting a translation.
         void startWalkWrapper();
 
@@ -193,16 +252,12 @@ namespace X86ISA
             tlb = _tlb;
         }
 
+        // Forget all cached page table entries.
+        void flushPageWalkCache();
+
         using Params = X86PagetableWalkerParams;
 
-        Walker(const Params &params) :
-            ClockedObject(params), port(name() + ".port", this),
-            funcState(this, NULL, NULL, true), tlb(NULL), sys(params.system),
-            requestorId(sys->getRequestorId(this)),
-            numSquashable(params.num_squash_per_cycle),
-            startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
-        {
-        }
+        Walker(const Params &params);
     };
 }
 #endif // __ARCH_X86_PAGE_TABLE_WALKER_HH__
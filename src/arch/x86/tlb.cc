@@ -47,6 +47,7 @@
 #include "arch/x86/regs/misc.hh"
 #include "arch/x86/regs/msr.hh"
 #include "arch/x86/x86_traits.hh"
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "cpu/thread_context.hh"
 #include "debug/TLB.hh"
@@ -60,69 +61,121 @@
 namespace X86ISA {
 
 TLB::TLB(const Params &p)
-    : BaseTLB(p), configAddress(0), size(p.size),
-      tlb(size), lruSeq(0), m5opRange(p.system->m5opRange()), stats(this)
+    : BaseTLB(p), configAddress(0), walker(p.walker), nextLevel(p.next_level),
+      size(p.size), assoc(p.assoc ? p.assoc : size), numSets(size / assoc),
+      tlb(size), tags(size, 0), pageSizes(0), lruSeq(0),
+      m5opRange(p.system->m5opRange()), stats(this)
 {
     if (!size)
         fatal("TLBs must have a non-zero size.\n");
+    fatal_if(size % assoc || !isPowerOf2(numSets),
+             "%s: The TLB size (%d) must be a power of two multiple of its "
+             "associativity (%d).\n", name(), size, assoc);
+    fatal_if(nextLevel == this, "%s: A TLB can't be its own next level.\n",
+             name());
 
-    for (int x = 0; x < size; x++) {
+    sizeCount.fill(0);
+
+    for (int x = 0; x < size; x++)
         tlb[x].trieHandle = NULL;
-        freeList.push_back(&tlb[x]);
-    }
 
-    walker = p.walker;
-    walker->setTLB(this);
+    if (walker)
+        walker->setTLB(this);
 }
 
-void
-TLB::evictLRU()
+unsigned
+TLB::findVictim(unsigned set_start) const
 {
-    // Find the entry with the lowest (and hence least recently updated)
-    // sequence number.
-
-    unsigned lru = 0;
-    for (unsigned i = 1; i < size; i++) {
-        if (tlb[i].lruSeq < tlb[lru].lruSeq)
-            lru = i;
+    // Use a free way if there is one, otherwise the one with the lowest
+    // (and hence least recently updated) sequence number.
+    unsigned lru = set_start;
+    for (unsigned way = set_start; way < set_start + assoc; way++) {
+        if (!tags[way])
+            return way;
+        if (tlb[way].lruSeq < tlb[lru].lruSeq)
+            lru = way;
     }
+    return lru;
+}
 
-    assert(tlb[lru].trieHandle);
-    trie.remove(tlb[lru].trieHandle);
-    tlb[lru].trieHandle = NULL;
-    freeList.push_back(&tlb[lru]);
+void
+TLB::invalidate(unsigned way)
+{
+    assert(tags[way]);
+    unsigned log_bytes = tlb[way].logBytes;
+    tags[way] = 0;
+    if (--sizeCount[log_bytes] == 0)
+        pageSizes &= ~(1ULL << log_bytes);
 }
 
 TlbEntry *
-TLB::insert(Addr vpn, const TlbEntry &entry)
+TLB::fill(Addr vpn, const TlbEntry &entry)
 {
     // If somebody beat us to it, just use that existing entry.
-    TlbEntry *newEntry = trie.lookup(vpn);
+    TlbEntry *newEntry = lookup(vpn, false);
     if (newEntry) {
         assert(newEntry->vaddr == vpn);
         return newEntry;
     }
 
-    if (freeList.empty())
-        evictLRU();
-
-    newEntry = freeList.front();
-    freeList.pop_front();
+    unsigned way = findVictim(setStart(vpn, entry.logBytes));
+    if (tags[way])
+        invalidate(way);
 
+    newEntry = &tlb[way];
     *newEntry = entry;
     newEntry->lruSeq = nextSeq();
     newEntry->vaddr = vpn;
-    newEntry->trieHandle =
-    trie.insert(vpn, TlbEntryTrie::MaxBits - entry.logBytes, newEntry);
+    newEntry->trieHandle = NULL;
+
+    tags[way] = makeTag(vpn, entry.logBytes);
+    sizeCount[entry.logBytes]++;
+    pageSizes |= 1ULL << entry.logBytes;
     return newEntry;
 }
 
+TlbEntry *
+TLB::insert(Addr vpn, const TlbEntry &entry)
+{
+    if (nextLevel)
+        nextLevel->fill(vpn, entry);
+    return fill(vpn, entry);
+}
+
 TlbEntry *
 TLB::lookup(Addr va, bool update_lru)
 {
-    TlbEntry *entry = trie.lookup(va);
-    if (entry && update_lru)
-        entry->lruSeq = nextSeq();
+    // An entry can only be in the set its page size maps it to, so look
+    // in one set for each page size in use.
+    for (uint64_t sizes = pageSizes; sizes; sizes &= sizes - 1) {
+        unsigned log_bytes = findLsbSet(sizes);
+        Addr tag = makeTag(va, log_bytes);
+        unsigned set_start = setStart(va, log_bytes);
+        for (unsigned way = set_start; way < set_start + assoc; way++) {
+            if (tags[way] == tag) {
+                TlbEntry *entry = &tlb[way];
+                if (update_lru)
+                    entry->lruSeq = nextSeq();
+                return entry;
+            }
+        }
+    }
+    return NULL;
+}
+
+TlbEntry *
+TLB::probe(Addr va, Mode mode)
+{
+    TlbEntry *entry = lookup(va);
+    if (mode == Read) {
+        stats.rdAccesses++;
+        if (!entry)
+            stats.rdMisses++;
+    } else {
+        stats.wrAccesses++;
+        if (!entry)
+            stats.wrMisses++;
+    }
     return entry;
 }
 
@@ -131,12 +184,14 @@ TLB::flushAll()
 {
     DPRINTF(TLB, "Invalidating all entries.\n");
     for (unsigned i = 0; i < size; i++) {
-        if (tlb[i].trieHandle) {
-            trie.remove(tlb[i].trieHandle);
-            tlb[i].trieHandle = NULL;
-            freeList.push_back(&tlb[i]);
-        }
+        if (tags[i])
+            invalidate(i);
     }
+
+    if (walker)
+        walker->flushPageWalkCache();
+    if (nextLevel)
+        nextLevel->flushAll();
 }
 
 void
@@ -150,23 +205,28 @@ TLB::flushNonGlobal()
 {
     DPRINTF(TLB, "Invalidating all non global entries.\n");
     for (unsigned i = 0; i < size; i++) {
-        if (tlb[i].trieHandle && !tlb[i].global) {
-            trie.remove(tlb[i].trieHandle);
-            tlb[i].trieHandle = NULL;
-            freeList.push_back(&tlb[i]);
-        }
+        if (tags[i] && !tlb[i].global)
+            invalidate(i);
     }
+
+    if (walker)
+        walker->flushPageWalkCache();
+    if (nextLevel)
+        nextLevel->flushNonGlobal();
 }
 
 void
 TLB::demapPage(Addr va, uint64_t asn)
 {
-    TlbEntry *entry = trie.lookup(va);
-    if (entry) {
-        trie.remove(entry->trieHandle);
-        entry->trieHandle = NULL;
-        freeList.push_back(entry);
-    }
+    TlbEntry *entry = lookup(va, false);
+    if (entry)
+        invalidate(entry - tlb.data());
+
+    // INVLPG also invalidates all paging-structure caches.
+    if (walker)
+        walker->flushPageWalkCache();
+    if (nextLevel)
+        nextLevel->demapPage(va, asn);
 }
 
 namespace
@@ -377,6 +437,18 @@ TLB::translate(const RequestPtr &req,
             } else {
                 stats.wrAccesses++;
             }
+            if (!entry && nextLevel) {
+                entry = nextLevel->probe(vaddr, mode);
+                if (entry) {
+                    DPRINTF(TLB, "Next level TLB hit for %#x.\n", vaddr);
+                    if (mode == Read) {
+                        stats.rdMisses++;
+                    } else {
+                        stats.wrMisses++;
+                    }
+                    entry = fill(entry->vaddr, *entry);
+                }
+            }
             if (!entry) {
                 DPRINTF(TLB, "Handling a TLB miss for "
                         "address %#x at pc %#x.\n",
@@ -531,13 +603,17 @@ void
 TLB::serialize(CheckpointOut &cp) const
 {
     // Only store the entries in use.
-    uint32_t _size = size - freeList.size();
+    uint32_t _size = 0;
+    for (uint32_t x = 0; x < size; x++) {
+        if (tags[x])
+            _size++;
+    }
     SERIALIZE_SCALAR(_size);
     SERIALIZE_SCALAR(lruSeq);
 
     uint32_t _count = 0;
     for (uint32_t x = 0; x < size; x++) {
-        if (tlb[x].trieHandle != NULL)
+        if (tags[x])
             tlb[x].serializeSection(cp, csprintf("Entry%d", _count++));
     }
 }
@@ -554,20 +630,22 @@ TLB::unserialize(CheckpointIn &cp)
 
     UNSERIALIZE_SCALAR(lruSeq);
 
+    // Entries keep the sequence numbers they were saved with so the LRU
+    // order is restored. If the checkpoint came from a TLB with fewer
+    // sets some may not fit in their set and are dropped.
+    uint64_t seq = lruSeq;
     for (uint32_t x = 0; x < _size; x++) {
-        TlbEntry *newEntry = freeList.front();
-        freeList.pop_front();
-
-        newEntry->unserializeSection(cp, csprintf("Entry%d", x));
-        newEntry->trieHandle = trie.insert(newEntry->vaddr,
-            TlbEntryTrie::MaxBits - newEntry->logBytes, newEntry);
+        TlbEntry entry;
+        entry.unserializeSection(cp, csprintf("Entry%d", x));
+        fill(entry.vaddr, entry)->lruSeq = entry.lruSeq;
     }
+    lruSeq = seq;
 }
 
 Port *
 TLB::getTableWalkerPort()
 {
-    return &walker->getPort("port");
+    return walker ? &walker->getPort("port") : NULL;
 }
 
 } // namespace X86ISA
@@ -38,12 +38,12 @@
 #ifndef __ARCH_X86_TLB_HH__
 #define __ARCH_X86_TLB_HH__
 
-#include <list>
+#include <array>
 #include <vector>
 
 #include "arch/generic/tlb.hh"
 #include "arch/x86/pagetable.hh"
-#include "base/trie.hh"
+#include "base/bitfield.hh"
 #include "mem/request.hh"
 #include "params/X86TLB.hh"
 #include "sim/stats.hh"
@@ -59,8 +59,6 @@ namespace X86ISA
       protected:
         friend class Walker;
 
-        typedef std::list<TlbEntry *> EntryList;
-
         uint32_t configAddress;
 
       public:
@@ -76,10 +74,17 @@ namespace X86ISA
 
       protected:
 
-        EntryList::iterator lookupIt(Addr va, bool update_lru = true);
-
         Walker * walker;
 
+        /**
+         * The next level TLB which is looked up on a miss before walking
+         * the page table, and filled alongside this one. It is normally
+         * shared by the instruction and data TLBs of one CPU, and must
+         * not be shared between CPUs as entries aren't tagged with the
+         * address space they belong to.
+         */
+        TLB *nextLevel;
+
       public:
         Walker *getWalker();
 
@@ -92,11 +97,28 @@ namespace X86ISA
       protected:
         uint32_t size;
 
+        /** Number of ways in each set, size if fully associative */
+        uint32_t assoc;
+        /** Number of sets, a power of two */
+        uint32_t numSets;
+
+        /** The entries, stored set by set */
         std::vector<TlbEntry> tlb;
 
-        EntryList freeList;
+        /**
+         * The tag of each entry in tlb. A tag is the virtual page base
+         * with the page size (logBytes) in the bits below it, and 0 for
+         * an unused entry. They are kept apart from the entries so
+         * searching a set only touches a few host cache lines.
+         */
+        std::vector<Addr> tags;
+
+        /** Number of entries in use of each page size, by logBytes */
+        std::array<uint32_t, 64> sizeCount;
+        /** Bit logBytes is set if there are entries of that page size.
+         *  Lookups only search the sets of the sizes in use */
+        uint64_t pageSizes;
 
-        TlbEntryTrie trie;
         uint64_t lruSeq;
 
         AddrRange m5opRange;
@@ -110,6 +132,32 @@ namespace X86ISA
             Stats::Scalar wrMisses;
         } stats;
 
+        static Addr
+        makeTag(Addr va, unsigned log_bytes)
+        {
+            return (va & ~mask(log_bytes)) | log_bytes;
+        }
+
+        /** Index of the first way of the set a page would be in */
+        unsigned
+        setStart(Addr va, unsigned log_bytes) const
+        {
+            return ((va >> log_bytes) & (numSets - 1)) * assoc;
+        }
+
+        /** Find the way a new page should be put in, the first unused way
+         *  of its set or else the least recently used one */
+        unsigned findVictim(unsigned set_start) const;
+
+        /** Put an entry in this TLB only */
+        TlbEntry *fill(Addr vpn, const TlbEntry &entry);
+
+        void invalidate(unsigned way);
+
+        /** Look up an address on behalf of the TLB above this one,
+         *  counting the access in this TLB's stats */
+        TlbEntry *probe(Addr va, Mode mode);
+
         Fault translateInt(bool read, RequestPtr req, ThreadContext *tc);
 
         Fault translate(const RequestPtr &req, ThreadContext *tc,
@@ -118,8 +166,6 @@ namespace X86ISA
 
       public:
 
-        void evictLRU();
-
         uint64_t
         nextSeq()
         {
@@ -150,6 +196,7 @@ namespace X86ISA
         Fault finalizePhysical(const RequestPtr &req, ThreadContext *tc,
                                Mode mode) const override;
 
+        /** Put an entry in this TLB and the next level TLB, if any */
         TlbEntry *insert(Addr vpn, const TlbEntry &entry);
 
         // Checkpointing
@@ -439,20 +439,47 @@ class AddrRange
         // bits from the address match the interleaving value
         bool in_range = a >= _start && a < _end;
         if (in_range) {
-            auto sel = 0;
-            for (int i = 0; i < masks.size(); i++) {
-                Addr masked = a & masks[i];
-                // The result of an xor operation is 1 if the number
-                // of bits set is odd or 0 othersize, thefore it
-                // suffices to count the number of bits set to
-                // determine the i-th bit of sel.
-                sel |= (popCount(masked) % 2) << i;
-            }
-            return sel == intlvMatch;
+            return selectIntlv(a) == intlvMatch;
         }
         return false;
     }
 
+    /**
+     * Get the interleaving value of this range, i.e. the value the
+     * interleaving bits of an address must have for the address to be
+     * in the range.
+     *
+     * @return The interleaving value, 0 if the range is not interleaved
+     *
+     * @ingroup api_addr_range
+     */
+    uint8_t getIntlvMatch() const { return intlvMatch; }
+
+    /**
+     * Compute the interleaving bits of an address using the masks of
+     * this range. The range's stripes are numbered by these bits, so
+     * an address inside the bounds of the range belongs to the stripe
+     * whose interleaving value is the result.
+     *
+     * @param a Address to compute the interleaving bits of
+     * @return The interleaving bits, 0 if the range is not interleaved
+     *
+     * @ingroup api_addr_range
+     */
+    uint8_t selectIntlv(const Addr& a) const
+    {
+        uint8_t sel = 0;
+        for (int i = 0; i < masks.size(); i++) {
+            Addr masked = a & masks[i];
+            // The result of an xor operation is 1 if the number
+            // of bits set is odd or 0 othersize, thefore it
+            // suffices to count the number of bits set to
+            // determine the i-th bit of sel.
+            sel |= (popCount(masked) % 2) << i;
+        }
+        return sel;
+    }
+
     /**
      * Remove the interleaving bits from an input address.
      *
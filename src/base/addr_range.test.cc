@@ -1065,6 +1065,39 @@ TEST(AddrRangeTest, LegacyConstructorTwoBitMaskWithXOR)
     }
 }
 
+TEST(AddrRangeTest, GetIntlvMatch)
+{
+    std::vector<Addr> masks = { 1 << 6, 1 << 7 };
+    AddrRange range(0x0, 0x10000, masks, 2);
+    EXPECT_EQ(2, range.getIntlvMatch());
+
+    AddrRange plain(0x0, 0x10000);
+    EXPECT_EQ(0, plain.getIntlvMatch());
+}
+
+TEST(AddrRangeTest, SelectIntlvMatchesContains)
+{
+    /*
+     * Every address within the bounds of the range belongs to the stripe
+     * selected by its interleaving bits, also when they are XORed.
+     */
+    std::vector<Addr> masks = { 1 << 6 | 1 << 12, 1 << 7 | 1 << 13 };
+    for (uint8_t match = 0; match < 4; match++) {
+        AddrRange range(0x0, 0x10000, masks, match);
+        for (Addr addr = 0; addr < 0x10000; addr += 0x20) {
+            EXPECT_EQ(range.contains(addr),
+                      range.selectIntlv(addr) == match);
+        }
+    }
+}
+
+TEST(AddrRangeTest, SelectIntlvNotInterleaved)
+{
+    AddrRange range(0x0, 0x10000);
+    EXPECT_EQ(0, range.selectIntlv(0x0));
+    EXPECT_EQ(0, range.selectIntlv(0xFFC0));
+}
+
 /*
  * addr_range.hh contains some convenience constructors. The following tests
  * verify they construct AddrRange correctly.
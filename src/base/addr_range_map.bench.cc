@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "base/addr_range_map.hh"
+
+namespace
+{
+
+const Addr RangeBytes = 0x10000;
+
+/** A map of n adjacent ranges, and a random sequence of addresses in them. */
+template <class Map>
+std::vector<Addr>
+setup(Map &map, int n)
+{
+    for (int i = 0; i < n; i++)
+        map.insert(RangeSize(i * RangeBytes, RangeBytes), i);
+
+    std::mt19937_64 rng(0);
+    std::uniform_int_distribution<Addr> dist(0, n * RangeBytes - 1);
+    std::vector<Addr> addrs(4096);
+    for (auto &addr: addrs)
+        addr = dist(rng);
+    return addrs;
+}
+
+template <int max_cache_size>
+void
+ContainsRandom(benchmark::State &state)
+{
+    AddrRangeMap<int, max_cache_size> map;
+    const auto addrs = setup(map, state.range(0));
+
+    size_t i = 0;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(map.contains(addrs[i]));
+        i = (i + 1) % addrs.size();
+    }
+}
+
+/** Lookups which stay in one range, like the accesses of a single core. */
+template <int max_cache_size>
+void
+ContainsLocal(benchmark::State &state)
+{
+    AddrRangeMap<int, max_cache_size> map;
+    setup(map, state.range(0));
+
+    Addr addr = 0;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(map.contains(addr));
+        addr = (addr + 64) % RangeBytes;
+    }
+}
+
+} // anonymous namespace
+
+BENCHMARK_TEMPLATE(ContainsRandom, 0)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_TEMPLATE(ContainsRandom, 3)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_TEMPLATE(ContainsLocal, 0)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_TEMPLATE(ContainsLocal, 3)->RangeMultiplier(4)->Range(4, 1024);
@@ -46,6 +46,7 @@
 #include <list>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include "base/addr_range.hh"
 #include "base/types.hh"
@@ -54,6 +55,11 @@
  * The AddrRangeMap uses an STL map to implement an interval tree for
  * address decoding. The value stored is a template type and can be
  * e.g. a port identifier, or a pointer.
+ *
+ * Lookups of the range containing an address, which is what address
+ * decoding does, go through a flat index instead of the tree. The
+ * index is rebuilt whenever the map changes, which in practice only
+ * happens while the system is being set up.
  */
 template <typename V, int max_cache_size=0>
 class AddrRangeMap
@@ -86,11 +92,17 @@ class AddrRangeMap
     const_iterator
     contains(const AddrRange &r) const
     {
-        return find(r, [r](const AddrRange r1) { return r.isSubset(r1); });
+        return const_cast<AddrRangeMap *>(this)->contains(r);
     }
     iterator
     contains(const AddrRange &r)
     {
+        if (indexed && !r.interleaved()) {
+            // Only the entry holding the first address of the range can
+            // contain all of it, as the entries don't intersect.
+            iterator it = lookup(r.start());
+            return it != end() && r.isSubset(it->first) ? it : end();
+        }
         return find(r, [r](const AddrRange r1) { return r.isSubset(r1); });
     }
     /** @} */ // end of api_addr_range
@@ -111,12 +123,15 @@ class AddrRangeMap
     const_iterator
     contains(Addr r) const
     {
-        return contains(RangeSize(r, 1));
+        return const_cast<AddrRangeMap *>(this)->contains(r);
     }
     iterator
     contains(Addr r)
     {
-        return contains(RangeSize(r, 1));
+        if (indexed)
+            return lookup(r);
+        return find(RangeSize(r, 1),
+                    [r](const AddrRange r1) { return r1.contains(r); });
     }
     /** @} */ // end of api_addr_range
 
@@ -154,7 +169,9 @@ class AddrRangeMap
         if (intersects(r) != end())
             return tree.end();
 
-        return tree.insert(std::make_pair(r, d)).first;
+        iterator it = tree.insert(std::make_pair(r, d)).first;
+        rebuildIndex();
+        return it;
     }
 
     /**
@@ -165,6 +182,7 @@ class AddrRangeMap
     {
         cache.remove(p);
         tree.erase(p);
+        rebuildIndex();
     }
 
     /**
@@ -174,9 +192,10 @@ class AddrRangeMap
     erase(iterator p, iterator q)
     {
         for (auto it = p; it != q; it++) {
-            cache.remove(p);
+            cache.remove(it);
         }
         tree.erase(p,q);
+        rebuildIndex();
     }
 
     /**
@@ -187,6 +206,7 @@ class AddrRangeMap
     {
         cache.erase(cache.begin(), cache.end());
         tree.erase(tree.begin(), tree.end());
+        rebuildIndex();
     }
 
     /**
@@ -244,6 +264,88 @@ class AddrRangeMap
     }
 
   private:
+    /**
+     * A span of addresses covered either by a single entry, or by the
+     * entries of a set of interleaved ranges which only differ by their
+     * interleaving value. The entry of an address in the span is found
+     * by using the interleaving bits of the address, computed with the
+     * masks of the ranges, as an index in the slots of the span.
+     */
+    struct Segment
+    {
+        Addr end;
+        /** One of the ranges, used to compute the interleaving bits. */
+        const AddrRange *range;
+        /** Index of the first slot of the segment. */
+        std::size_t slots;
+    };
+
+    /**
+     * Find the entry containing an address through the index.
+     *
+     * @param a The address to look up
+     * @return An iterator to the entry, end() if there is none
+     */
+    iterator
+    lookup(Addr a)
+    {
+        std::size_t n = segStarts.size();
+        if (n == 0 || a < segStarts[0])
+            return end();
+
+        // Find the last segment starting at or before the address. The
+        // loop runs a fixed number of times for a given size, and the
+        // compiler turns the selection into a conditional move.
+        const Addr *base = segStarts.data();
+        while (n > 1) {
+            const std::size_t half = n / 2;
+            base = base[half] <= a ? base + half : base;
+            n -= half;
+        }
+
+        const Segment &seg = segments[base - segStarts.data()];
+        if (a >= seg.end)
+            return end();
+        return slots[seg.slots + seg.range->selectIntlv(a)];
+    }
+
+    /**
+     * Rebuild the index from the tree. The index isn't used if the
+     * entries can't be laid out as disjoint segments.
+     */
+    void
+    rebuildIndex()
+    {
+        segStarts.clear();
+        segments.clear();
+        slots.clear();
+        indexed = true;
+
+        for (iterator it = tree.begin(); it != tree.end(); ) {
+            const AddrRange &r = it->first;
+            if (!segments.empty() && r.start() < segments.back().end) {
+                indexed = false;
+                break;
+            }
+
+            segStarts.push_back(r.start());
+            segments.push_back(Segment{r.end(), &r, slots.size()});
+            slots.resize(slots.size() + r.stripes(), tree.end());
+
+            // The tree is sorted by start address and then by
+            // interleaving value, so the ranges of a segment are next
+            // to each other.
+            for (; it != tree.end() && it->first.mergesWith(r); ++it)
+                slots[segments.back().slots + it->first.getIntlvMatch()] = it;
+        }
+
+        if (!indexed) {
+            segStarts.clear();
+            segments.clear();
+            slots.clear();
+        }
+    }
+
     /**
      * Add an address range map entry to the cache.
      *
@@ -325,6 +427,18 @@ class AddrRangeMap
 
     RangeMap tree;
 
+    /** @{ */
+    /**
+     * Index of the entries, sorted by address. The start addresses of
+     * the segments are kept on their own so that the search only
+     * touches them.
+     */
+    std::vector<Addr> segStarts;
+    std::vector<Segment> segments;
+    std::vector<iterator> slots;
+    bool indexed = true;
+    /** @} */
+
     /**
      * A list of iterator that correspond to the max_cache_size most
      * recently used entries in the address range map. This mainly
@@ -66,3 +66,54 @@ TEST(AddrRangeMapTest, LegacyTests)
 
     EXPECT_NE(r.contains(RangeIn(20, 30)), r.end());
 }
+
+TEST(AddrRangeMapTest, ContainsAddr)
+{
+    AddrRangeMap<int> r;
+
+    ASSERT_NE(r.insert(RangeIn(0x1000, 0x1fff), 1), r.end());
+    ASSERT_NE(r.insert(RangeIn(0x3000, 0x3fff), 2), r.end());
+    ASSERT_NE(r.insert(RangeIn(0x2000, 0x2fff), 3), r.end());
+
+    EXPECT_EQ(r.contains(0x0fff), r.end());
+    EXPECT_EQ(r.contains(0x1000)->second, 1);
+    EXPECT_EQ(r.contains(0x1fff)->second, 1);
+    EXPECT_EQ(r.contains(0x2000)->second, 3);
+    EXPECT_EQ(r.contains(0x3fff)->second, 2);
+    EXPECT_EQ(r.contains(0x4000), r.end());
+
+    EXPECT_EQ(r.contains(RangeIn(0x1800, 0x18ff))->second, 1);
+    EXPECT_EQ(r.contains(RangeIn(0x1800, 0x20ff)), r.end());
+
+    r.erase(r.contains(0x2000));
+    EXPECT_EQ(r.contains(0x2000), r.end());
+    EXPECT_EQ(r.contains(0x3000)->second, 2);
+
+    r.clear();
+    EXPECT_EQ(r.contains(0x1000), r.end());
+}
+
+TEST(AddrRangeMapTest, ContainsAddrInterleaved)
+{
+    AddrRangeMap<int> r;
+
+    // Four ranges interleaved on bits 6 and 7, as for four memory
+    // channels with 64 byte interleaving.
+    const std::vector<Addr> masks = { 1 << 6, 1 << 7 };
+    for (uint8_t i = 0; i < 4; i++) {
+        ASSERT_NE(r.insert(AddrRange(0x10000, 0x20000, masks, i), i),
+                  r.end());
+    }
+    ASSERT_NE(r.insert(RangeIn(0x20000, 0x2ffff), 4), r.end());
+
+    EXPECT_EQ(r.contains(0xffff), r.end());
+    for (Addr a = 0x10000; a < 0x20000; a += 0x20)
+        EXPECT_EQ(r.contains(a)->second, (a >> 6) & 0x3);
+    EXPECT_EQ(r.contains(0x20000)->second, 4);
+
+    // With a missing channel, addresses mapping to it aren't contained.
+    r.erase(r.contains(0x10080));
+    EXPECT_EQ(r.contains(0x10080), r.end());
+    EXPECT_EQ(r.contains(0x10040)->second, 1);
+    EXPECT_EQ(r.contains(0x100c0)->second, 3);
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BATCHED_READER_HH__
+#define __BASE_BATCHED_READER_HH__
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "base/logging.hh"
+
+/**
+ * Decode a stream of records ahead of its consumer.
+ *
+ * A background thread calls the decode function to fill batches of
+ * records, which are kept in a ring of a fixed number of batches. The
+ * consumer takes records out of the oldest batch without locking and
+ * only synchronises with the decoder when it moves on to the next
+ * batch. Batches are recycled, so in steady state no allocations are
+ * needed apart from those done by the records themselves.
+ *
+ * With a depth of zero no thread is created and records are decoded
+ * on demand by the consumer.
+ *
+ * The decode function is only ever called from one thread at a time.
+ * It must not touch simulator state shared with the consumer; anything
+ * else it needs to communicate should be stored in the records.
+ */
+template <class Record>
+class BatchedReader
+{
+  public:
+    /**
+     * Decode the next record of the stream.
+     *
+     * @return False once the end of the stream has been reached.
+     */
+    typedef std::function<bool(Record &)> DecodeFunc;
+
+  private:
+    struct Batch
+    {
+        std::vector<Record> records;
+        /** Is this the last batch of the stream? */
+        bool last = false;
+    };
+
+    DecodeFunc decode;
+    const size_t batchSize;
+
+    std::vector<Batch> ring;
+
+    /** Index of the batch the consumer is reading from. */
+    size_t head = 0;
+    /** Number of batches the decoder has handed over. */
+    size_t filled = 0;
+    /** Position of the consumer in the head batch. */
+    size_t pos = 0;
+    /** Has the head batch been handed over to the consumer? */
+    bool haveHead = false;
+    /** Has the consumer seen the end of the stream? */
+    bool done = false;
+    /** Tell the decoder thread to exit. */
+    bool stopping = false;
+
+    std::mutex lock;
+    std::condition_variable spaceAvailable;
+    std::condition_variable batchAvailable;
+    std::thread decoder;
+
+    void
+    decodeLoop()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        size_t tail = head;
+        while (true) {
+            spaceAvailable.wait(guard, [this] {
+                return stopping || filled < ring.size();
+            });
+            if (stopping)
+                return;
+
+            // The tail batch belongs to the decoder until it is
+            // handed over, so it can be filled without the lock.
+            guard.unlock();
+            Batch &batch = ring[tail];
+            batch.records.resize(batchSize);
+            size_t n = 0;
+            for (; n < batchSize; ++n) {
+                batch.records[n] = Record();
+                if (!decode(batch.records[n]))
+                    break;
+            }
+            batch.records.resize(n);
+            batch.last = n < batchSize;
+            guard.lock();
+
+            ++filled;
+            batchAvailable.notify_one();
+            if (batch.last)
+                return;
+            tail = (tail + 1) % ring.size();
+        }
+    }
+
+  public:
+    /**
+     * @param _decode Function producing the records.
+     * @param batch_size Number of records decoded in one go.
+     * @param depth Number of batches decoded ahead of the consumer,
+     *        zero to decode records synchronously.
+     */
+    BatchedReader(DecodeFunc _decode, size_t batch_size, size_t depth)
+        : decode(std::move(_decode)), batchSize(batch_size), ring(depth)
+    {
+        fatal_if(depth && !batch_size,
+                 "The decode batch size must be non-zero.\n");
+    }
+
+    ~BatchedReader() { stop(); }
+
+    BatchedReader(const BatchedReader &) = delete;
+    BatchedReader &operator=(const BatchedReader &) = delete;
+
+    /** Is the stream decoded by a background thread? */
+    bool threaded() const { return !ring.empty(); }
+
+    /**
+     * Start decoding. This must be called before the first read and
+     * again after stop() to resume reading, once the underlying stream
+     * is in the state decoding should start from.
+     */
+    void
+    start()
+    {
+        stop();
+        head = 0;
+        filled = 0;
+        pos = 0;
+        haveHead = false;
+        done = false;
+        stopping = false;
+        if (threaded())
+            decoder = std::thread(&BatchedReader::decodeLoop, this);
+    }
+
+    /**
+     * Stop the decoder thread. Records that have been decoded but not
+     * read are dropped, and the underlying stream may be safely
+     * accessed by the caller afterwards.
+     */
+    void
+    stop()
+    {
+        if (!decoder.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        spaceAvailable.notify_one();
+        decoder.join();
+    }
+
+    /**
+     * Move the next record of the stream into the record passed in.
+     *
+     * @return False once the end of the stream has been reached.
+     */
+    bool
+    read(Record &record)
+    {
+        if (!threaded())
+            return decode(record);
+
+        while (!done) {
+            if (!haveHead) {
+                std::unique_lock<std::mutex> guard(lock);
+                batchAvailable.wait(guard, [this] { return filled > 0; });
+                haveHead = true;
+            }
+
+            Batch &batch = ring[head];
+            if (pos < batch.records.size()) {
+                record = std::move(batch.records[pos++]);
+                return true;
+            }
+
+            // The batch has been used up, give it back to the decoder.
+            done = batch.last;
+            pos = 0;
+            haveHead = false;
+            head = (head + 1) % ring.size();
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                --filled;
+            }
+            spaceAvailable.notify_one();
+        }
+        return false;
+    }
+};
+
+#endif // __BASE_BATCHED_READER_HH__
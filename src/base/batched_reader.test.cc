@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "base/batched_reader.hh"
+
+namespace
+{
+
+/** A stream of the first n integers, as strings. */
+class CountingStream
+{
+  public:
+    int next = 0;
+    int end;
+
+    explicit CountingStream(int _end) : end(_end) {}
+
+    bool
+    decode(std::string &record)
+    {
+        if (next == end)
+            return false;
+        record = std::to_string(next++);
+        return true;
+    }
+};
+
+std::vector<std::string>
+readAll(BatchedReader<std::string> &reader)
+{
+    std::vector<std::string> records;
+    std::string record;
+    while (reader.read(record))
+        records.push_back(record);
+    // The end of the stream is sticky.
+    EXPECT_FALSE(reader.read(record));
+    return records;
+}
+
+void
+checkCount(const std::vector<std::string> &records, int from, int to)
+{
+    ASSERT_EQ(records.size(), to - from);
+    for (int i = from; i < to; ++i)
+        EXPECT_EQ(records[i - from], std::to_string(i));
+}
+
+} // anonymous namespace
+
+TEST(BatchedReaderTest, Synchronous)
+{
+    CountingStream stream(10);
+    BatchedReader<std::string> reader(
+        [&stream](std::string &r) { return stream.decode(r); }, 4, 0);
+    EXPECT_FALSE(reader.threaded());
+    reader.start();
+    checkCount(readAll(reader), 0, 10);
+}
+
+TEST(BatchedReaderTest, Threaded)
+{
+    // Sizes around multiples of the batch size, including an empty
+    // stream and streams ending on a batch boundary.
+    for (int size : { 0, 1, 3, 4, 5, 16, 1000 }) {
+        CountingStream stream(size);
+        BatchedReader<std::string> reader(
+            [&stream](std::string &r) { return stream.decode(r); }, 4, 3);
+        EXPECT_TRUE(reader.threaded());
+        reader.start();
+        checkCount(readAll(reader), 0, size);
+    }
+}
+
+TEST(BatchedReaderTest, Restart)
+{
+    CountingStream stream(100);
+    BatchedReader<std::string> reader(
+        [&stream](std::string &r) { return stream.decode(r); }, 8, 2);
+
+    reader.start();
+    std::string record;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(reader.read(record));
+        EXPECT_EQ(record, std::to_string(i));
+    }
+
+    // Rewind the stream while the decoder is stopped, records decoded
+    // ahead are dropped.
+    reader.stop();
+    stream.next = 50;
+    reader.start();
+    checkCount(readAll(reader), 50, 100);
+}
+
+TEST(BatchedReaderTest, StopWhileBlocked)
+{
+    // The decoder is blocked on a full ring when the reader is
+    // destroyed, which must not hang.
+    CountingStream stream(1000);
+    BatchedReader<std::string> reader(
+        [&stream](std::string &r) { return stream.decode(r); }, 2, 2);
+    reader.start();
+    std::string record;
+    ASSERT_TRUE(reader.read(record));
+    EXPECT_EQ(record, "0");
+}
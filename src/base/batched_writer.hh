@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BATCHED_WRITER_HH__
+#define __BASE_BATCHED_WRITER_HH__
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "base/logging.hh"
+
+/**
+ * Write a stream of records behind its producer.
+ *
+ * This is the counterpart of BatchedReader. The producer appends
+ * records to a batch without locking and only synchronises with the
+ * background thread when it hands a full batch over. The thread calls
+ * the write function on each batch in order, and batches are recycled
+ * through a ring of a fixed number of batches. If the writer falls
+ * behind, the producer waits for a batch to be freed.
+ *
+ * With a depth of zero no thread is created and batches are written
+ * by the producer as soon as they are full.
+ *
+ * The write function is only ever called from one thread at a time.
+ * It must not touch simulator state shared with the producer.
+ */
+template <class Record>
+class BatchedWriter
+{
+  public:
+    /** Write out a batch of records. */
+    typedef std::function<void(const std::vector<Record> &)> WriteFunc;
+
+  private:
+    WriteFunc writeBatch;
+    const size_t batchSize;
+
+    std::vector<std::vector<Record>> ring;
+
+    /** Batch being filled in synchronous mode. */
+    std::vector<Record> current;
+
+    /** Index of the batch the producer is filling. */
+    size_t head = 0;
+    /** Number of batches handed over and not written yet. */
+    size_t filled = 0;
+    /** Tell the writer thread to exit once it has caught up. */
+    bool stopping = false;
+
+    std::mutex lock;
+    std::condition_variable spaceAvailable;
+    std::condition_variable batchAvailable;
+    std::thread writer;
+
+    void
+    writeLoop()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        size_t tail = head;
+        while (true) {
+            batchAvailable.wait(guard, [this] {
+                return stopping || filled > 0;
+            });
+            if (filled == 0)
+                return;
+
+            // Handed over batches belong to the writer until it gives
+            // them back, so they can be written without the lock.
+            guard.unlock();
+            writeBatch(ring[tail]);
+            ring[tail].clear();
+            guard.lock();
+
+            --filled;
+            spaceAvailable.notify_one();
+            tail = (tail + 1) % ring.size();
+        }
+    }
+
+    /** Give the head batch to the writer and wait for the next one. */
+    void
+    handOver()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        ++filled;
+        batchAvailable.notify_one();
+        head = (head + 1) % ring.size();
+        spaceAvailable.wait(guard, [this] { return filled < ring.size(); });
+    }
+
+  public:
+    /**
+     * @param _write Function writing out the batches.
+     * @param batch_size Number of records written in one go.
+     * @param depth Number of batches which can wait to be written,
+     *        zero to write batches synchronously.
+     */
+    BatchedWriter(WriteFunc _write, size_t batch_size, size_t depth)
+        : writeBatch(std::move(_write)), batchSize(batch_size), ring(depth)
+    {
+        fatal_if(!batch_size, "The write batch size must be non-zero.\n");
+        for (auto &batch : ring)
+            batch.reserve(batchSize);
+        current.reserve(threaded() ? 0 : batchSize);
+        if (threaded())
+            writer = std::thread(&BatchedWriter::writeLoop, this);
+    }
+
+    ~BatchedWriter() { close(); }
+
+    BatchedWriter(const BatchedWriter &) = delete;
+    BatchedWriter &operator=(const BatchedWriter &) = delete;
+
+    /** Are batches written by a background thread? */
+    bool threaded() const { return !ring.empty(); }
+
+    /** Append a record to the stream. */
+    void
+    write(const Record &record)
+    {
+        if (!threaded()) {
+            current.push_back(record);
+            if (current.size() == batchSize) {
+                writeBatch(current);
+                current.clear();
+            }
+            return;
+        }
+
+        // Only the producer touches the head batch, no lock needed.
+        std::vector<Record> &batch = ring[head];
+        batch.push_back(record);
+        if (batch.size() == batchSize)
+            handOver();
+    }
+
+    /**
+     * Write out everything appended so far, including a partial batch,
+     * and wait until it has been written.
+     */
+    void
+    flush()
+    {
+        if (!threaded()) {
+            if (!current.empty())
+                writeBatch(current);
+            current.clear();
+            return;
+        }
+
+        if (!writer.joinable())
+            return;
+        if (!ring[head].empty())
+            handOver();
+        std::unique_lock<std::mutex> guard(lock);
+        spaceAvailable.wait(guard, [this] { return filled == 0; });
+    }
+
+    /**
+     * Flush the stream and stop the writer thread. Nothing can be
+     * written afterwards.
+     */
+    void
+    close()
+    {
+        flush();
+        if (!writer.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        batchAvailable.notify_one();
+        writer.join();
+    }
+};
+
+#endif // __BASE_BATCHED_WRITER_HH__
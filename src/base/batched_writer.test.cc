@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "base/batched_writer.hh"
+
+namespace
+{
+
+/** Collects the batches written, checking their sizes. */
+class Sink
+{
+  public:
+    std::vector<int> records;
+    size_t batches = 0;
+    size_t maxBatch;
+
+    explicit Sink(size_t max_batch) : maxBatch(max_batch) {}
+
+    void
+    write(const std::vector<int> &batch)
+    {
+        EXPECT_FALSE(batch.empty());
+        EXPECT_LE(batch.size(), maxBatch);
+        records.insert(records.end(), batch.begin(), batch.end());
+        ++batches;
+    }
+};
+
+void
+checkCount(const std::vector<int> &records, int to)
+{
+    ASSERT_EQ(records.size(), to);
+    for (int i = 0; i < to; ++i)
+        EXPECT_EQ(records[i], i);
+}
+
+} // anonymous namespace
+
+TEST(BatchedWriterTest, Synchronous)
+{
+    Sink sink(4);
+    BatchedWriter<int> writer(
+        [&sink](const std::vector<int> &b) { sink.write(b); }, 4, 0);
+    EXPECT_FALSE(writer.threaded());
+    for (int i = 0; i < 10; ++i)
+        writer.write(i);
+    // Full batches are written straight away.
+    EXPECT_EQ(sink.batches, 2);
+    writer.close();
+    EXPECT_EQ(sink.batches, 3);
+    checkCount(sink.records, 10);
+}
+
+TEST(BatchedWriterTest, Threaded)
+{
+    // Sizes around multiples of the batch size, including an empty
+    // stream and streams ending on a batch boundary.
+    for (int size : { 0, 1, 3, 4, 5, 16, 1000 }) {
+        Sink sink(4);
+        {
+            BatchedWriter<int> writer(
+                [&sink](const std::vector<int> &b) { sink.write(b); }, 4, 3);
+            EXPECT_TRUE(writer.threaded());
+            for (int i = 0; i < size; ++i)
+                writer.write(i);
+        }
+        checkCount(sink.records, size);
+        EXPECT_EQ(sink.batches, (size + 3) / 4);
+    }
+}
+
+TEST(BatchedWriterTest, Flush)
+{
+    Sink sink(8);
+    BatchedWriter<int> writer(
+        [&sink](const std::vector<int> &b) { sink.write(b); }, 8, 2);
+    for (int i = 0; i < 5; ++i)
+        writer.write(i);
+
+    // Everything written so far is out once flush returns, and writing
+    // can carry on afterwards.
+    writer.flush();
+    checkCount(sink.records, 5);
+    for (int i = 5; i < 100; ++i)
+        writer.write(i);
+    writer.close();
+    checkCount(sink.records, 100);
+}
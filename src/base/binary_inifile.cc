@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_inifile.hh"
+
+#include <cstring>
+
+#include "base/str.hh"
+
+namespace BinaryIni
+{
+
+const char magic[8] = { 'g', 'e', 'm', '5', 'b', 'i', 'n', 'i' };
+
+bool
+isBinary(const std::string &file)
+{
+    std::ifstream f(file.c_str(), std::ios::binary);
+    char buf[sizeof(magic)];
+    if (!f.read(buf, sizeof(buf)))
+        return false;
+    return std::memcmp(buf, magic, sizeof(magic)) == 0;
+}
+
+} // namespace BinaryIni
+
+namespace
+{
+
+/** Size of the header: magic, version, marker and index offset. */
+const uint64_t headerSize = sizeof(BinaryIni::magic) + 2 * sizeof(uint32_t) +
+    sizeof(uint64_t);
+
+template <class T>
+void
+putRaw(std::string &buf, T v)
+{
+    buf.append(reinterpret_cast<const char *>(&v), sizeof(v));
+}
+
+void
+putString(std::string &buf, const std::string &s)
+{
+    putRaw<uint32_t>(buf, s.size());
+    buf.append(s);
+}
+
+template <class T>
+bool
+getRaw(std::istream &is, T &v)
+{
+    return (bool)is.read(reinterpret_cast<char *>(&v), sizeof(v));
+}
+
+bool
+getString(std::istream &is, std::string &s)
+{
+    uint32_t len;
+    if (!getRaw(is, len))
+        return false;
+    s.resize(len);
+    return len == 0 || is.read(&s[0], len);
+}
+
+} // anonymous namespace
+
+BinaryIniFile::BinaryIniFile()
+{}
+
+BinaryIniFile::~BinaryIniFile()
+{
+    for (auto &section : loaded)
+        delete section.second;
+}
+
+bool
+BinaryIniFile::load(const std::string &file_name)
+{
+    file.open(file_name.c_str(), std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    char buf[sizeof(BinaryIni::magic)];
+    uint32_t file_version, marker;
+    uint64_t index_offset;
+    if (!file.read(buf, sizeof(buf)) ||
+            std::memcmp(buf, BinaryIni::magic, sizeof(buf)) != 0 ||
+            !getRaw(file, file_version) ||
+            file_version != BinaryIni::version ||
+            !getRaw(file, marker) || marker != BinaryIni::byteOrderMarker ||
+            !getRaw(file, index_offset) || index_offset < headerSize) {
+        return false;
+    }
+
+    file.seekg(index_offset);
+    uint32_t count;
+    if (!getRaw(file, count))
+        return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string name;
+        uint64_t offset;
+        if (!getString(file, name) || !getRaw(file, offset))
+            return false;
+        index[name].push_back(offset);
+    }
+
+    return true;
+}
+
+IniFile::Section *
+BinaryIniFile::findSection(const std::string &sectionName) const
+{
+    Section *section = IniFile::findSection(sectionName);
+    if (section)
+        return section;
+
+    auto l = loaded.find(sectionName);
+    if (l != loaded.end())
+        return l->second;
+
+    auto i = index.find(sectionName);
+    if (i == index.end())
+        return NULL;
+
+    // A section that was written in several pieces is merged the
+    // same way IniFile merges repeated section headers.
+    section = new Section();
+    for (uint64_t offset : i->second) {
+        file.clear();
+        file.seekg(offset);
+        uint32_t count;
+        if (!getRaw(file, count)) {
+            delete section;
+            return NULL;
+        }
+        for (uint32_t e = 0; e < count; ++e) {
+            std::string key, value;
+            if (!getString(file, key) || !getString(file, value)) {
+                delete section;
+                return NULL;
+            }
+            section->addEntry(key, value, false);
+        }
+    }
+
+    loaded[sectionName] = section;
+    return section;
+}
+
+void
+BinaryIniFile::getSectionNames(std::vector<std::string> &list) const
+{
+    for (const auto &i : index)
+        list.push_back(i.first);
+}
+
+BinaryIniWriter::BinaryIniWriter(const std::string &file_name)
+    : out(file_name.c_str(), std::ios::binary | std::ios::trunc),
+      pendingCount(0), inSection(false), _good(out.is_open())
+{
+    std::string header(BinaryIni::magic, sizeof(BinaryIni::magic));
+    putRaw<uint32_t>(header, BinaryIni::version);
+    putRaw<uint32_t>(header, BinaryIni::byteOrderMarker);
+    // Patched with the index offset by close()
+    putRaw<uint64_t>(header, 0);
+    out.write(header.data(), header.size());
+}
+
+BinaryIniWriter::~BinaryIniWriter()
+{
+    if (out.is_open())
+        close();
+}
+
+void
+BinaryIniWriter::flushSection()
+{
+    if (!inSection)
+        return;
+
+    chunks.emplace_back(pendingName, (uint64_t)out.tellp());
+    out.write(reinterpret_cast<const char *>(&pendingCount),
+              sizeof(pendingCount));
+    out.write(pending.data(), pending.size());
+
+    pending.clear();
+    pendingCount = 0;
+    inSection = false;
+}
+
+void
+BinaryIniWriter::beginSection(const std::string &name)
+{
+    flushSection();
+    pendingName = name;
+    inSection = true;
+}
+
+void
+BinaryIniWriter::addEntry(const std::string &key, const std::string &value)
+{
+    if (!inSection) {
+        _good = false;
+        return;
+    }
+    putString(pending, key);
+    putString(pending, value);
+    ++pendingCount;
+}
+
+void
+BinaryIniWriter::addAll(IniFile &ini)
+{
+    std::vector<std::string> names;
+    ini.getSectionNames(names);
+    for (const auto &name : names) {
+        beginSection(name);
+        ini.visitSection(name, [this](const std::string &key,
+                                      const std::string &value) {
+            addEntry(key, value);
+        });
+    }
+}
+
+bool
+BinaryIniWriter::close()
+{
+    if (!line.empty())
+        parseLine();
+    flushSection();
+
+    std::string index;
+    putRaw<uint32_t>(index, chunks.size());
+    for (const auto &chunk : chunks) {
+        putString(index, chunk.first);
+        putRaw<uint64_t>(index, chunk.second);
+    }
+
+    uint64_t index_offset = out.tellp();
+    out.write(index.data(), index.size());
+    out.seekp(sizeof(BinaryIni::magic) + 2 * sizeof(uint32_t));
+    out.write(reinterpret_cast<const char *>(&index_offset),
+              sizeof(index_offset));
+
+    _good = _good && out.good();
+    out.close();
+    return _good;
+}
+
+void
+BinaryIniWriter::parseLine()
+{
+    // Mirrors IniFile::load(): leading whitespace is skipped, text
+    // before the first section header is ignored.
+    eat_white(line);
+    if (line.empty())
+        return;
+
+    const size_t last = line.size() - 1;
+    if (line[0] == '[' && line[last] == ']') {
+        std::string name = line.substr(1, last - 1);
+        eat_white(name);
+        beginSection(name);
+    } else if (inSection) {
+        // Serializable never emits "+=" appends, so they are not
+        // handled here.
+        std::string::size_type offset = line.find('=');
+        if (offset == std::string::npos || offset == 0 ||
+                line[offset - 1] == '+') {
+            _good = false;
+        } else {
+            std::string key = line.substr(0, offset);
+            std::string value = line.substr(offset + 1);
+            eat_white(key);
+            eat_white(value);
+            addEntry(key, value);
+        }
+    }
+    line.clear();
+}
+
+BinaryIniWriter::int_type
+BinaryIniWriter::overflow(int_type c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+
+    const char ch = traits_type::to_char_type(c);
+    if (ch == '\n')
+        parseLine();
+    else
+        line.push_back(ch);
+    return c;
+}
+
+std::streamsize
+BinaryIniWriter::xsputn(const char *s, std::streamsize n)
+{
+    const char *end = s + n;
+    while (s != end) {
+        const char *nl = static_cast<const char *>(
+            std::memchr(s, '\n', end - s));
+        if (!nl) {
+            line.append(s, end);
+            break;
+        }
+        line.append(s, nl);
+        parseLine();
+        s = nl + 1;
+    }
+    return n;
+}
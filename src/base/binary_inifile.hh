@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_INIFILE_HH__
+#define __BASE_BINARY_INIFILE_HH__
+
+#include <cstdint>
+#include <fstream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/inifile.hh"
+
+/**
+ * @file
+ * An indexed binary encoding of an IniFile.
+ *
+ * The file starts with a fixed header (magic, version, byte order
+ * marker and the offset of the section index), followed by one chunk
+ * per section and the index itself. A section chunk is a count
+ * followed by length-prefixed key/value pairs; the index maps each
+ * section name to the offsets of its chunks. Readers only parse the
+ * header and the index up front and pull a section in the first time
+ * it is looked up, so restoring a checkpoint no longer scans every
+ * line of every section.
+ */
+
+namespace BinaryIni
+{
+
+/** Magic at the start of every binary ini file. */
+extern const char magic[8];
+/** Current format version. */
+static const uint32_t version = 1;
+/** Written in host order, used to reject foreign-endian files. */
+static const uint32_t byteOrderMarker = 0x01020304;
+
+/**
+ * Check whether a file uses the binary encoding.
+ * @param file Path of the file to check.
+ * @return True if the file starts with the binary ini magic.
+ */
+bool isBinary(const std::string &file);
+
+} // namespace BinaryIni
+
+/**
+ * An IniFile backed by the binary encoding. Sections are loaded from
+ * disk on first use; all IniFile lookups work unchanged.
+ */
+class BinaryIniFile : public IniFile
+{
+  private:
+    /** Open stream to the file, used to load sections on demand. */
+    mutable std::ifstream file;
+
+    /** Offsets of the chunks belonging to each section. */
+    std::unordered_map<std::string, std::vector<uint64_t>> index;
+
+    /** Sections that have been pulled in from the file. */
+    mutable SectionTable loaded;
+
+  protected:
+    Section *findSection(const std::string &sectionName) const override;
+
+  public:
+    BinaryIniFile();
+    ~BinaryIniFile();
+
+    /**
+     * Open a binary ini file and read its index. Only the index is
+     * read here; section contents are read lazily.
+     * @param file_name Path of the file to load.
+     * @return True if successful, false if the file is not a valid
+     * binary ini file.
+     */
+    bool load(const std::string &file_name);
+
+    void getSectionNames(std::vector<std::string> &list) const override;
+
+    /** Number of sections read from the file so far. */
+    size_t loadedSections() const { return loaded.size(); }
+};
+
+/**
+ * Writer for the binary encoding.
+ *
+ * Sections and entries can either be added directly, or the writer
+ * can be used as the buffer of a std::ostream: text written in the
+ * ini syntax that Serializable produces ("[section]" and "key=value"
+ * lines) is parsed line by line and encoded on the fly, so the
+ * existing serialization code can produce binary checkpoints without
+ * going through an intermediate text file.
+ */
+class BinaryIniWriter : public std::streambuf
+{
+  private:
+    std::ofstream out;
+
+    /** Name and offset of every section chunk written so far. */
+    std::vector<std::pair<std::string, uint64_t>> chunks;
+
+    /** Encoded entries of the open section. */
+    std::string pending;
+    /** Number of entries in the open section. */
+    uint32_t pendingCount;
+    /** Name of the open section. */
+    std::string pendingName;
+    bool inSection;
+
+    /** Partial line received through the stream interface. */
+    std::string line;
+
+    /** False once a write or parse error has been seen. */
+    bool _good;
+
+    void flushSection();
+    void parseLine();
+
+  protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char *s, std::streamsize n) override;
+
+  public:
+    /**
+     * Create a writer.
+     * @param file_name Path of the file to create.
+     */
+    BinaryIniWriter(const std::string &file_name);
+    ~BinaryIniWriter();
+
+    /** Start a new section, closing the current one. */
+    void beginSection(const std::string &name);
+
+    /** Add an entry to the current section. */
+    void addEntry(const std::string &key, const std::string &value);
+
+    /**
+     * Write the index and patch the header. The writer can not be
+     * used afterwards.
+     * @return True if the whole file was written successfully.
+     */
+    bool close();
+
+    /** Write every section of an IniFile. */
+    void addAll(IniFile &ini);
+
+    bool good() const { return _good; }
+};
+
+#endif // __BASE_BINARY_INIFILE_HH__
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/binary_inifile.hh"
+#include "base/inifile.hh"
+
+namespace {
+
+const char *iniText = R"ini_file(## checkpoint generated: now
+ignored=before any section
+
+[General]
+   Test1=BARasdf
+   Test2=bar
+
+[Junk]
+Test3=yo
+Test4=mama
+
+[Empty]
+
+[General]
+Test3=89
+Test4=
+)ini_file";
+
+std::string
+tempName()
+{
+    char name[] = "/tmp/binary_inifile_testXXXXXX";
+    int fd = mkstemp(name);
+    EXPECT_NE(fd, -1);
+    close(fd);
+    return name;
+}
+
+};
+
+/** Text fed through the stream interface is found by the reader. */
+TEST(BinaryIniTest, StreamRoundTrip)
+{
+    std::string name = tempName();
+    {
+        BinaryIniWriter writer(name);
+        std::ostream os(&writer);
+        os << iniText;
+        ASSERT_TRUE(writer.close());
+    }
+    ASSERT_TRUE(BinaryIni::isBinary(name));
+
+    BinaryIniFile ini;
+    ASSERT_TRUE(ini.load(name));
+    EXPECT_EQ(ini.loadedSections(), 0);
+
+    std::string value;
+    EXPECT_TRUE(ini.find("General", "Test1", value));
+    EXPECT_EQ(value, "BARasdf");
+    // The repeated [General] header is merged into one section
+    EXPECT_TRUE(ini.find("General", "Test3", value));
+    EXPECT_EQ(value, "89");
+    EXPECT_TRUE(ini.find("General", "Test4", value));
+    EXPECT_EQ(value, "");
+    EXPECT_EQ(ini.loadedSections(), 1);
+
+    EXPECT_FALSE(ini.find("Junk", "Test1", value));
+    EXPECT_TRUE(ini.sectionExists("Empty"));
+    EXPECT_FALSE(ini.sectionExists("Missing"));
+    EXPECT_FALSE(ini.sectionExists("ignored"));
+
+    std::vector<std::string> names;
+    ini.getSectionNames(names);
+    EXPECT_EQ(names.size(), 3);
+
+    unlink(name.c_str());
+}
+
+/** Converting an IniFile gives the same contents back. */
+TEST(BinaryIniTest, ConvertIniFile)
+{
+    std::istringstream is(iniText);
+    IniFile text;
+    ASSERT_TRUE(text.load(is));
+
+    std::string name = tempName();
+    {
+        BinaryIniWriter writer(name);
+        writer.addAll(text);
+        ASSERT_TRUE(writer.close());
+    }
+
+    BinaryIniFile ini;
+    ASSERT_TRUE(ini.load(name));
+
+    int count = 0;
+    ini.visitSection("Junk", [&count](const std::string &key,
+                                      const std::string &value) {
+        EXPECT_EQ(value, key == "Test3" ? "yo" : "mama");
+        ++count;
+    });
+    EXPECT_EQ(count, 2);
+
+    std::string value;
+    EXPECT_TRUE(ini.find("General", "Test2", value));
+    EXPECT_EQ(value, "bar");
+
+    unlink(name.c_str());
+}
+
+/** Ini files are not mistaken for binary ones and vice versa. */
+TEST(BinaryIniTest, RejectsIniText)
+{
+    std::string name = tempName();
+    {
+        std::ofstream os(name);
+        os << iniText;
+    }
+    EXPECT_FALSE(BinaryIni::isBinary(name));
+
+    BinaryIniFile ini;
+    EXPECT_FALSE(ini.load(name));
+
+    unlink(name.c_str());
+}
+
+/** Lines that can't be parsed are reported by close(). */
+TEST(BinaryIniTest, ParseError)
+{
+    std::string name = tempName();
+    BinaryIniWriter writer(name);
+    std::ostream os(&writer);
+    os << "[Section]\nnot an assignment\n";
+    EXPECT_FALSE(writer.close());
+
+    unlink(name.c_str());
+}
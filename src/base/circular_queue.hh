@@ -70,7 +70,7 @@ class CircularQueue
 
     using reference = typename std::vector<T>::reference;
     using const_reference = typename std::vector<T>::const_reference;
-    const size_t _capacity;
+    size_t _capacity;
     size_t _size = 0;
     size_t _head = 1;
 
@@ -423,6 +423,26 @@ class CircularQueue
         _size = 0;
     }
 
+    /**
+     * Increase the capacity of the queue. The elements keep their
+     * indices, so iterators to them remain valid.
+     *
+     * @param capacity The new capacity, which may not be smaller than
+     *        the current one.
+     *
+     * @ingroup api_base_utils
+     */
+    void
+    grow(size_t capacity)
+    {
+        assert(capacity >= _capacity);
+        std::vector<T> new_data(capacity);
+        for (size_t idx = _head; idx < _head + _size; ++idx)
+            new_data[idx % capacity] = std::move(data[idx % _capacity]);
+        data = std::move(new_data);
+        _capacity = capacity;
+    }
+
     /**
      * Test if the index is in the range of valid elements.
      */
@@ -436,11 +456,13 @@ class CircularQueue
      * @ingroup api_base_utils
      */
     reference front() { return (*this)[head()]; }
+    const_reference front() const { return (*this)[head()]; }
 
     /**
      * @ingroup api_base_utils
      */
     reference back() { return (*this)[tail()]; }
+    const_reference back() const { return (*this)[tail()]; }
 
     /**
      * @ingroup api_base_utils
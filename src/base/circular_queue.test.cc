@@ -263,3 +263,37 @@ TEST(CircularQueueTest, MultipleRound)
 
     ASSERT_EQ(ending_it - starting_it, cq_size);
 }
+
+/** Testing that growing a queue which has wrapped around keeps the
+ * elements, and the iterators to them, where they were */
+TEST(CircularQueueTest, Grow)
+{
+    const auto cq_size = 8;
+    CircularQueue<uint32_t> cq(cq_size);
+
+    for (auto idx = 0; idx < cq_size + 3; idx++) {
+        cq.push_back(idx);
+    }
+    cq.pop_front(2);
+
+    auto it = cq.begin() + 4;
+    ASSERT_EQ(*it, 9);
+
+    cq.grow(cq_size * 2);
+    ASSERT_EQ(cq.capacity(), cq_size * 2);
+    ASSERT_EQ(cq.size(), cq_size - 2);
+    ASSERT_EQ(*it, 9);
+
+    uint32_t expected = 5;
+    for (auto elem : cq) {
+        ASSERT_EQ(elem, expected++);
+    }
+
+    // The extra space can be used without overwriting anything
+    for (auto idx = 0; idx < cq_size + 2; idx++) {
+        cq.push_back(expected + idx);
+    }
+    ASSERT_TRUE(cq.full());
+    ASSERT_EQ(cq.front(), 5);
+    ASSERT_EQ(*it, 9);
+}
@@ -31,12 +31,104 @@
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <streambuf>
+#include <vector>
 
 #include "base/compiler.hh"
 
 namespace cp
 {
 
+namespace
+{
+
+/** Stream buffer appending to a string that keeps its capacity. */
+class StringBuf : public std::streambuf
+{
+  public:
+    std::string str;
+
+  protected:
+    int
+    overflow(int c) override
+    {
+        if (c != traits_type::eof())
+            str.push_back(c);
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize
+    xsputn(const char *s, std::streamsize n) override
+    {
+        str.append(s, n);
+        return n;
+    }
+};
+
+} // anonymous namespace
+
+struct ScratchStream::Scratch
+{
+    StringBuf buf;
+    std::ostream stream;
+
+    Scratch() : stream(&buf) {}
+};
+
+/** The scratch streams of a thread and how many of them are in use. */
+struct ScratchStream::Pool
+{
+    std::vector<Scratch *> streams;
+    size_t inUse = 0;
+};
+
+ScratchStream::Pool &
+ScratchStream::pool()
+{
+    // Never freed, so csprintf keeps working in static destructors
+    static thread_local Pool *pool = nullptr;
+    if (!pool)
+        pool = new Pool;
+    return *pool;
+}
+
+ScratchStream::Scratch &
+ScratchStream::acquire()
+{
+    Pool &p = pool();
+    if (p.inUse == p.streams.size())
+        p.streams.push_back(new Scratch);
+
+    Scratch &scratch = *p.streams[p.inUse++];
+    scratch.buf.str.clear();
+
+    // Undo anything an argument may have done to the stream
+    std::ostream &stream = scratch.stream;
+    stream.clear();
+    stream.flags(std::ios::dec | std::ios::skipws);
+    stream.fill(' ');
+    stream.precision(6);
+    stream.width(0);
+    return scratch;
+}
+
+ScratchStream::~ScratchStream()
+{
+    --pool().inUse;
+}
+
+std::ostream &
+ScratchStream::stream()
+{
+    return scratch.stream;
+}
+
+std::string
+ScratchStream::str() const
+{
+    return scratch.buf.str;
+}
+
 Print::Print(std::ostream &stream, const std::string &format)
     : stream(stream), format(format.c_str()), ptr(format.c_str()), cont(false)
 {
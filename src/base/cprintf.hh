@@ -123,6 +123,37 @@ struct Print
 
 } // namespace cp
 
+namespace cp {
+
+/**
+ * Output stream for csprintf. Constructing a string stream is about as
+ * expensive as formatting a short message, so every thread keeps one
+ * stream for every level of nesting (the arguments of csprintf may call
+ * csprintf when they are printed) and reuses it.
+ */
+class ScratchStream
+{
+  private:
+    struct Scratch;
+    struct Pool;
+    Scratch &scratch;
+
+    static Pool &pool();
+    static Scratch &acquire();
+
+  public:
+    ScratchStream() : scratch(acquire()) {}
+    ~ScratchStream();
+
+    ScratchStream(const ScratchStream &) = delete;
+    ScratchStream &operator=(const ScratchStream &) = delete;
+
+    std::ostream &stream();
+    std::string str() const;
+};
+
+} // namespace cp
+
 inline void
 ccprintf(cp::Print &print)
 {
@@ -157,8 +188,8 @@ cprintf(const char *format, const Args &...args)
 template<typename ...Args> std::string
 csprintf(const char *format, const Args &...args)
 {
-    std::stringstream stream;
-    ccprintf(stream, format, args...);
+    cp::ScratchStream stream;
+    ccprintf(stream.stream(), format, args...);
     return stream.str();
 }
 
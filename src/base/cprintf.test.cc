@@ -178,3 +178,55 @@ TEST(CPrintf, SpecialFormatting)
     CPRINTF_TEST("%07.*f\n", 4, 1.234);
     CPRINTF_TEST("%#0*x\n", 9, 123412);
 }
+
+namespace {
+
+/** Prints itself with csprintf and leaves the stream in hex mode. */
+struct Nested
+{
+    int val;
+};
+
+std::ostream &
+operator<<(std::ostream &os, const Nested &n)
+{
+    return os << csprintf("<%d>", n.val) << std::hex;
+}
+
+} // anonymous namespace
+
+TEST(CPrintf, Integers)
+{
+    CPRINTF_TEST("%d %i %u %x %X %o\n", -42, 42, 42u, 0xbeefu, 0xbeefu, 8u);
+    CPRINTF_TEST("%08d|%-8d|%+d|%8x|%-#8x|%#o\n", 42, 42, 42, 255u, 255u,
+                 8u);
+    CPRINTF_TEST("%#x %#X %#o\n", 0u, 0u, 0u);
+    CPRINTF_TEST("%lld %llu %llx\n", -1234567890123LL, 1234567890123ULL,
+                 0xfedcba9876543210ULL);
+    CPRINTF_TEST("%.5d\n", 42);
+
+    // cprintf prints the two's complement of negative numbers in hex,
+    // for the width of the original type.
+    EXPECT_EQ("ffffffff fffe ff", csprintf("%x %x %x", -1, (short)-2,
+                                           (unsigned char)255));
+    // Zero padding goes in front of the sign
+    EXPECT_EQ("000-5", csprintf("%05d", -5));
+    EXPECT_EQ("0x00ab", csprintf("%#06x", 0xab));
+}
+
+TEST(CPrintf, Strings)
+{
+    const char *cstr = "cstr";
+    std::string str = "str";
+    CPRINTF_TEST("%s|%8s|%-8s|%2s\n", cstr, cstr, cstr, cstr);
+    EXPECT_EQ("  str|str  |str", csprintf("%5s|%-5s|%1s", str, str, str));
+}
+
+TEST(CPrintf, NestedCsprintf)
+{
+    EXPECT_EQ("a <1> 10 <2>", csprintf("%s %s %d %s", "a", Nested{1}, 10,
+                                        Nested{2}));
+    // The hex mode left behind must not leak into the next call
+    EXPECT_EQ("<3>", csprintf("%s", Nested{3}));
+    EXPECT_EQ("10", csprintf("%s", 10));
+}
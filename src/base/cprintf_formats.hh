@@ -29,9 +29,12 @@
 #ifndef __BASE_CPRINTF_FORMATS_HH__
 #define __BASE_CPRINTF_FORMATS_HH__
 
+#include <cstdint>
 #include <cstring>
 #include <ostream>
 #include <sstream>
+#include <string>
+#include <type_traits>
 
 namespace cp
 {
@@ -156,6 +159,114 @@ _formatInteger(std::ostream &out, const T &data, Format &fmt)
     out.flags(flags);
 }
 
+/**
+ * Format an integer into a buffer on the stack instead of going through
+ * the num_put facet of the stream, which is a lot slower. The output is
+ * identical to what _formatInteger prints (with the "C" locale), down to
+ * the quirks, e.g., zero padding in front of the sign. Widths that don't
+ * fit in the buffer and streams with a pending width fall back to
+ * _formatInteger.
+ */
+template <typename T>
+static inline void
+_formatIntegerFast(std::ostream &out, T data, Format &fmt)
+{
+    typedef typename std::make_unsigned<T>::type U;
+
+    // Digits are written backwards from the middle of the buffer, right
+    // aligned padding goes in front of them and left aligned padding
+    // after them.
+    char buf[128];
+    char *const mid = buf + sizeof(buf) / 2;
+    char *begin = mid;
+    char *end = mid;
+
+    if (out.width() != 0 || fmt.width > (int)sizeof(buf) / 2) {
+        _formatInteger(out, data, fmt);
+        return;
+    }
+
+    if (fmt.base == Format::Dec) {
+        const bool neg = std::is_signed<T>::value && data < T(0);
+        U u = neg ? U(-U(data)) : U(data);
+        do {
+            *--begin = '0' + u % 10;
+            u /= 10;
+        } while (u);
+        if (neg)
+            *--begin = '-';
+        else if (std::is_signed<T>::value && fmt.printSign)
+            *--begin = '+';
+    } else {
+        // Hex and octal print the two's complement of negative numbers.
+        U u = U(data);
+        const bool show_base = u && fmt.alternateForm && !fmt.fillZero;
+        if (fmt.base == Format::Hex) {
+            const char *digits = fmt.uppercase ?
+                "0123456789ABCDEF" : "0123456789abcdef";
+            do {
+                *--begin = digits[u & 0xf];
+                u >>= 4;
+            } while (u);
+            if (show_base) {
+                *--begin = fmt.uppercase ? 'X' : 'x';
+                *--begin = '0';
+            }
+        } else {
+            do {
+                *--begin = '0' + (u & 0x7);
+                u >>= 3;
+            } while (u);
+            if (show_base)
+                *--begin = '0';
+        }
+    }
+
+    if (fmt.alternateForm && fmt.fillZero) {
+        // The prefix goes in front of the padding, see _formatInteger.
+        if (fmt.base == Format::Hex) {
+            out.write("0x", 2);
+            fmt.width -= 2;
+        } else if (fmt.base == Format::Oct) {
+            out.put('0');
+            fmt.width -= 1;
+        }
+    }
+
+    if (fmt.fillZero)
+        out.fill('0');
+
+    const int pad = fmt.width - (int)(end - begin);
+    if (pad > 0) {
+        const char fill = out.fill();
+        if (fmt.flushLeft && !fmt.fillZero) {
+            std::memset(end, fill, pad);
+            end += pad;
+        } else {
+            begin -= pad;
+            std::memset(begin, fill, pad);
+        }
+    }
+
+    out.write(begin, end - begin);
+}
+
+template <typename T>
+static inline void
+_formatIntegerSelect(std::ostream &out, const T &data, Format &fmt,
+                     std::true_type)
+{
+    _formatIntegerFast(out, data, fmt);
+}
+
+template <typename T>
+static inline void
+_formatIntegerSelect(std::ostream &out, const T &data, Format &fmt,
+                     std::false_type)
+{
+    _formatInteger(out, data, fmt);
+}
+
 template <typename T>
 static inline void
 _formatFloat(std::ostream &out, const T &data, Format &fmt)
@@ -239,6 +350,32 @@ _formatString(std::ostream &out, const T &data, Format &fmt)
     }
 }
 
+/**
+ * Strings are written directly instead of being measured by printing
+ * them to a temporary stream.
+ */
+static inline void
+_formatStringFast(std::ostream &out, const char *data, size_t len,
+                  Format &fmt)
+{
+    if (out.width() != 0) {
+        _formatString(out, data, fmt);
+        return;
+    }
+
+    if (fmt.width > 0 && (size_t)fmt.width > len) {
+        const size_t pad = fmt.width - len;
+        if (fmt.flushLeft)
+            out.write(data, len);
+        for (size_t i = 0; i < pad; i++)
+            out.put(' ');
+        if (!fmt.flushLeft)
+            out.write(data, len);
+    } else {
+        out.write(data, len);
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 //  The code below controls the actual usage of formats for various types
@@ -327,32 +464,35 @@ template <typename T>
 static inline void
 formatInteger(std::ostream &out, const T &data, Format &fmt)
 {
-    _formatInteger(out, data, fmt);
+    // bool is printed as a number, but with the rules of its own
+    // operator<<, leave it to the stream.
+    _formatIntegerSelect(out, data, fmt, std::integral_constant<bool,
+            std::is_integral<T>::value && !std::is_same<T, bool>::value>());
 }
 static inline void
 formatInteger(std::ostream &out, char data, Format &fmt)
 {
-    _formatInteger(out, (int)data, fmt);
+    _formatIntegerFast(out, (int)data, fmt);
 }
 static inline void
 formatInteger(std::ostream &out, unsigned char data, Format &fmt)
 {
-    _formatInteger(out, (int)data, fmt);
+    _formatIntegerFast(out, (int)data, fmt);
 }
 static inline void
 formatInteger(std::ostream &out, signed char data, Format &fmt)
 {
-    _formatInteger(out, (int)data, fmt);
+    _formatIntegerFast(out, (int)data, fmt);
 }
 static inline void
 formatInteger(std::ostream &out, const unsigned char *data, Format &fmt)
 {
-    _formatInteger(out, (uintptr_t)data, fmt);
+    _formatIntegerFast(out, (uintptr_t)data, fmt);
 }
 static inline void
 formatInteger(std::ostream &out, const signed char *data, Format &fmt)
 {
-    _formatInteger(out, (uintptr_t)data, fmt);
+    _formatIntegerFast(out, (uintptr_t)data, fmt);
 }
 
 //
@@ -387,6 +527,28 @@ formatString(std::ostream &out, const T &data, Format &fmt)
     _formatString(out, data, fmt);
 }
 
+static inline void
+formatString(std::ostream &out, const char *data, Format &fmt)
+{
+    // Leave null pointers to the stream, which flags them as an error.
+    if (data)
+        _formatStringFast(out, data, std::strlen(data), fmt);
+    else
+        _formatString(out, data, fmt);
+}
+
+static inline void
+formatString(std::ostream &out, char *data, Format &fmt)
+{
+    formatString(out, static_cast<const char *>(data), fmt);
+}
+
+static inline void
+formatString(std::ostream &out, const std::string &data, Format &fmt)
+{
+    _formatStringFast(out, data.data(), data.size(), fmt);
+}
+
 } // namespace cp
 
 #endif // __CPRINTF_FORMATS_HH__
@@ -42,9 +42,11 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 #include "base/logging.hh"
 
@@ -71,8 +73,146 @@ Fiber *_currentFiber = &_primaryFiber;
 // A pointer to the Fiber which is currently being started/initialized.
 Fiber *startingFiber = nullptr;
 
+/*
+ * Stacks (including their guard page) of destroyed Fibers, kept so that
+ * short lived Fibers, like the coroutines of device models which create
+ * one per transaction, don't mmap, mprotect and munmap a stack every
+ * time. The list is never destroyed so that Fibers with static storage
+ * duration can still return their stack on exit.
+ */
+struct FreeStack
+{
+    void *guardPage;
+    size_t stackSize;
+};
+
+const size_t MaxFreeStacks = 64;
+
+std::vector<FreeStack> &
+freeStacks()
+{
+    static auto *stacks = new std::vector<FreeStack>;
+    return *stacks;
+}
+
 } // anonymous namespace
 
+#if FIBER_ASM_SWITCH
+
+/*
+ * Save the callee-saved registers of the running fiber on its stack,
+ * store its stack pointer in *save_sp, then switch to the stack at
+ * load_sp and restore the registers saved there. Everything else is
+ * either caller-saved, so the compiler has already spilled it around
+ * the call, or shared by all fibers. Unlike swapcontext this doesn't
+ * touch the signal mask, so it never enters the kernel.
+ */
+extern "C" void fiberSwitch(void **save_sp, void *load_sp);
+
+#if defined(__x86_64__)
+
+// Frame: MXCSR and x87 control word, r15, r14, r13, r12, rbx, rbp, rip.
+asm(R"(
+    .text
+    .p2align 4
+    .globl fiberSwitch
+    .hidden fiberSwitch
+    .type fiberSwitch, @function
+fiberSwitch:
+    pushq %rbp
+    pushq %rbx
+    pushq %r12
+    pushq %r13
+    pushq %r14
+    pushq %r15
+    subq $8, %rsp
+    stmxcsr (%rsp)
+    fnstcw 4(%rsp)
+    movq %rsp, (%rdi)
+    movq %rsi, %rsp
+    ldmxcsr (%rsp)
+    fldcw 4(%rsp)
+    addq $8, %rsp
+    popq %r15
+    popq %r14
+    popq %r13
+    popq %r12
+    popq %rbx
+    popq %rbp
+    ret
+    .size fiberSwitch, .-fiberSwitch
+)");
+
+namespace
+{
+
+const size_t SwitchFrameWords = 8;
+const size_t SwitchFramePC = 7;
+
+void
+initSwitchFrame(uint64_t *frame)
+{
+    uint32_t mxcsr;
+    uint16_t fpucw;
+    asm volatile("stmxcsr %0; fnstcw %1" : "=m" (mxcsr), "=m" (fpucw));
+    frame[0] = mxcsr | ((uint64_t)fpucw << 32);
+}
+
+} // anonymous namespace
+
+#elif defined(__aarch64__)
+
+// Frame: x19-x28, fp, lr, d8-d15.
+asm(R"(
+    .text
+    .p2align 4
+    .globl fiberSwitch
+    .hidden fiberSwitch
+    .type fiberSwitch, %function
+fiberSwitch:
+    sub sp, sp, #160
+    stp x19, x20, [sp, #0]
+    stp x21, x22, [sp, #16]
+    stp x23, x24, [sp, #32]
+    stp x25, x26, [sp, #48]
+    stp x27, x28, [sp, #64]
+    stp x29, x30, [sp, #80]
+    stp d8, d9, [sp, #96]
+    stp d10, d11, [sp, #112]
+    stp d12, d13, [sp, #128]
+    stp d14, d15, [sp, #144]
+    mov x9, sp
+    str x9, [x0]
+    mov sp, x1
+    ldp x19, x20, [sp, #0]
+    ldp x21, x22, [sp, #16]
+    ldp x23, x24, [sp, #32]
+    ldp x25, x26, [sp, #48]
+    ldp x27, x28, [sp, #64]
+    ldp x29, x30, [sp, #80]
+    ldp d8, d9, [sp, #96]
+    ldp d10, d11, [sp, #112]
+    ldp d12, d13, [sp, #128]
+    ldp d14, d15, [sp, #144]
+    add sp, sp, #160
+    ret
+    .size fiberSwitch, .-fiberSwitch
+)");
+
+namespace
+{
+
+const size_t SwitchFrameWords = 20;
+const size_t SwitchFramePC = 11;
+
+void initSwitchFrame(uint64_t *frame) {}
+
+} // anonymous namespace
+
+#endif
+
+#endif // FIBER_ASM_SWITCH
+
 void
 Fiber::entryTrampoline()
 {
@@ -86,7 +226,17 @@ Fiber::Fiber(Fiber *link, size_t stack_size) :
     link(link), stack(nullptr), stackSize(stack_size), guardPage(nullptr),
     guardPageSize(sysconf(_SC_PAGE_SIZE)), _started(false), _finished(false)
 {
-    if (stack_size) {
+    auto &free_stacks = freeStacks();
+    auto free_it = std::find_if(free_stacks.begin(), free_stacks.end(),
+            [stack_size](const FreeStack &fs) {
+                return fs.stackSize == stack_size;
+            });
+
+    if (stack_size && free_it != free_stacks.end()) {
+        guardPage = free_it->guardPage;
+        stack = (void *)((uint8_t *)guardPage + guardPageSize);
+        free_stacks.erase(free_it);
+    } else if (stack_size) {
         guardPage = mmap(nullptr, guardPageSize + stack_size,
                          PROT_READ | PROT_WRITE,
                          MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
@@ -112,10 +262,76 @@ Fiber::~Fiber()
 #if HAVE_VALGRIND
     VALGRIND_STACK_DEREGISTER(valgrindStackId);
 #endif
-    if (guardPage)
+    if (!guardPage)
+        return;
+
+    auto &free_stacks = freeStacks();
+    if (free_stacks.size() < MaxFreeStacks)
+        free_stacks.push_back({ guardPage, stackSize });
+    else
         munmap(guardPage, guardPageSize + stackSize);
 }
 
+#if FIBER_ASM_SWITCH
+
+void
+Fiber::createContext()
+{
+    // Build a frame at the top of the stack which fiberSwitch will
+    // "return" through into the trampoline, with zeroed callee-saved
+    // registers. The frame is placed so that the trampoline sees the
+    // stack alignment the ABI guarantees at a function's entry.
+    uintptr_t top = ((uintptr_t)stack + stackSize) & ~(uintptr_t)0xf;
+    size_t frame_size = SwitchFrameWords * sizeof(uint64_t);
+#if defined(__x86_64__)
+    // Leave room for the trampoline's (never used) return address.
+    frame_size += 8;
+#endif
+    uint64_t *frame = (uint64_t *)(top - frame_size);
+    std::fill(frame, frame + frame_size / sizeof(uint64_t), 0);
+    initSwitchFrame(frame);
+    frame[SwitchFramePC] = (uint64_t)(uintptr_t)&entryTrampoline;
+    sp = frame;
+
+    startingFiber = this;
+    setStarted();
+}
+
+void
+Fiber::start()
+{
+    // Avoid a dangling pointer.
+    startingFiber = nullptr;
+
+    main();
+
+    // main has returned, so this Fiber has finished. Switch to the "link"
+    // Fiber.
+    _finished = true;
+    link->run();
+}
+
+void
+Fiber::run()
+{
+    panic_if(_finished, "Fiber has already run to completion.");
+
+    // If we're already running this fiber, we're done.
+    if (_currentFiber == this)
+        return;
+
+    if (!_started)
+        createContext();
+
+    // Switch out of the current Fiber's context and this one's in.
+    Fiber *prev = _currentFiber;
+    Fiber *next = this;
+    _currentFiber = next;
+    fiberSwitch(&prev->sp, next->sp);
+}
+
+#else
+
 void
 Fiber::createContext()
 {
@@ -179,5 +395,7 @@ Fiber::run()
         _longjmp(next->jmp, 1);
 }
 
+#endif // FIBER_ASM_SWITCH
+
 Fiber *Fiber::currentFiber() { return _currentFiber; }
 Fiber *Fiber::primaryFiber() { return &_primaryFiber; }
@@ -28,6 +28,17 @@
 #ifndef __BASE_FIBER_HH__
 #define __BASE_FIBER_HH__
 
+// On these hosts fibers are switched by a small assembly routine which
+// only saves the callee-saved registers. Elsewhere ucontext and
+// _setjmp/_longjmp are used.
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define FIBER_ASM_SWITCH 1
+#else
+#define FIBER_ASM_SWITCH 0
+#endif
+
+#if !FIBER_ASM_SWITCH
+
 // ucontext functions (like getcontext, setcontext etc) have been marked
 // as deprecated and are hence hidden in latest macOS releases.
 // By defining _XOPEN_SOURCE we make them available at compilation time.
@@ -45,6 +56,8 @@
 #include <setjmp.h>
 #pragma pop_macro("__USE_FORTIFY_LEVEL")
 
+#endif
+
 #include <cstddef>
 #include <cstdint>
 
@@ -142,10 +155,16 @@ class Fiber
     static void entryTrampoline();
     void start();
 
+#if FIBER_ASM_SWITCH
+    // The stack pointer of this fiber while it is switched out. The
+    // registers it needs to resume are saved on its stack.
+    void *sp;
+#else
     ucontext_t ctx;
     // ucontext is slow in swapcontext. Here we use _setjmp/_longjmp to avoid
     // the additional signals for speed up.
     jmp_buf jmp;
+#endif
 
     Fiber *link;
 
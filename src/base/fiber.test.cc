@@ -171,3 +171,20 @@ TEST(Fiber, Linked)
 
     EXPECT_EQ(currentIndex, 4);
 }
+
+/** Fibers created after others were destroyed reuse their stacks, which
+ * must still be usable by the new fibers.
+ */
+TEST(Fiber, ReusedStack)
+{
+    for (int i = 0; i < 3; i++) {
+        currentIndex = 0;
+
+        LinkedFiber lf1(Fiber::primaryFiber(), 1);
+        LinkedFiber lf0(&lf1, 0);
+
+        lf0.run();
+
+        EXPECT_EQ(currentIndex, 2);
+    }
+}
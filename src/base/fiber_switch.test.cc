@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Microbenchmarks of fiber and coroutine switching. Besides checking
+ * that every switch happens, they report the average cost of a switch
+ * as a test property, which can be compared across hosts and fiber
+ * implementations with --gtest_output=xml.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#include "base/coroutine.hh"
+#include "base/fiber.hh"
+
+using namespace m5;
+
+namespace
+{
+
+const uint64_t NumSwitches = 1000000;
+
+void
+report(const char *what, std::chrono::steady_clock::duration elapsed,
+       uint64_t switches)
+{
+    const double ns = std::chrono::duration<double, std::nano>(elapsed)
+        .count() / switches;
+    ::testing::Test::RecordProperty(what, std::to_string(ns));
+    std::cout << what << ": " << ns << " ns per switch" << std::endl;
+}
+
+/** A fiber which switches straight back to its partner every time */
+class PingPongFiber : public Fiber
+{
+  public:
+    PingPongFiber() : Fiber(primaryFiber()), partner(nullptr), count(0) {}
+
+    Fiber *partner;
+    uint64_t count;
+
+  protected:
+    void
+    main() override
+    {
+        while (count < NumSwitches) {
+            count++;
+            partner->run();
+        }
+    }
+};
+
+} // anonymous namespace
+
+/** Switch back and forth between the primary fiber and another fiber */
+TEST(FiberSwitch, PrimaryPingPong)
+{
+    PingPongFiber fiber;
+    fiber.partner = Fiber::primaryFiber();
+
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t switches = 0;
+    while (!fiber.finished()) {
+        fiber.run();
+        switches += 2;
+    }
+    report("primary_ping_pong_ns", std::chrono::steady_clock::now() - start,
+           switches);
+
+    ASSERT_EQ(fiber.count, NumSwitches);
+}
+
+/** Switch back and forth between two fibers with their own stacks */
+TEST(FiberSwitch, PingPong)
+{
+    PingPongFiber a, b;
+    a.partner = &b;
+    b.partner = &a;
+
+    const auto start = std::chrono::steady_clock::now();
+    a.run();
+    report("ping_pong_ns", std::chrono::steady_clock::now() - start,
+           a.count + b.count);
+
+    ASSERT_TRUE(a.finished());
+    ASSERT_EQ(a.count, NumSwitches);
+    ASSERT_EQ(b.count, NumSwitches);
+}
+
+/** Resume a coroutine which yields a value every time */
+TEST(FiberSwitch, CoroutineYield)
+{
+    auto task = [](Coroutine<void, uint64_t>::CallerType &yield)
+    {
+        for (uint64_t i = 0; i < NumSwitches; i++)
+            yield(i);
+    };
+
+    Coroutine<void, uint64_t> coro(task, true);
+
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < NumSwitches; i++)
+        sum += coro.get();
+    report("coroutine_yield_ns", std::chrono::steady_clock::now() - start,
+           2 * NumSwitches);
+
+    ASSERT_EQ(sum, NumSwitches * (NumSwitches - 1) / 2);
+}
@@ -103,19 +103,13 @@ FrameBuffer::clear()
 void
 FrameBuffer::copyIn(const uint8_t *fb, const PixelConverter &conv)
 {
-    for (auto &p : pixels) {
-        p = conv.toPixel(fb);
-        fb += conv.length;
-    }
+    conv.toPixels(pixels.data(), fb, pixels.size());
 }
 
 void
 FrameBuffer::copyOut(uint8_t *fb, const PixelConverter &conv) const
 {
-    for (auto &p : pixels) {
-        conv.fromPixel(fb, p);
-        fb += conv.length;
-    }
+    conv.fromPixels(fb, pixels.data(), pixels.size());
 }
 
 uint64_t
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/hyperloglog.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/logging.hh"
+
+const unsigned HyperLogLog::MinPrecision;
+const unsigned HyperLogLog::MaxPrecision;
+
+HyperLogLog::HyperLogLog(unsigned _precision)
+    : precision(_precision)
+{
+    fatal_if(precision < MinPrecision || precision > MaxPrecision,
+             "HyperLogLog precision must be between %d and %d.",
+             MinPrecision, MaxPrecision);
+    registers.resize(1ULL << precision, 0);
+}
+
+double
+HyperLogLog::estimate() const
+{
+    const double m = registers.size();
+
+    double alpha;
+    switch (registers.size()) {
+      case 16:
+        alpha = 0.673;
+        break;
+      case 32:
+        alpha = 0.697;
+        break;
+      case 64:
+        alpha = 0.709;
+        break;
+      default:
+        alpha = 0.7213 / (1.0 + 1.079 / m);
+        break;
+    }
+
+    double sum = 0.0;
+    unsigned zeros = 0;
+    for (auto r : registers) {
+        sum += std::ldexp(1.0, -r);
+        if (r == 0)
+            zeros++;
+    }
+
+    const double raw = alpha * m * m / sum;
+    if (raw <= 2.5 * m && zeros != 0)
+        return m * std::log(m / zeros);
+
+    // With 64-bit hashes no large range correction is needed
+    return raw;
+}
+
+void
+HyperLogLog::clear()
+{
+    std::fill(registers.begin(), registers.end(), 0);
+}
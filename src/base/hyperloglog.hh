@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_HYPERLOGLOG_HH__
+#define __BASE_HYPERLOGLOG_HH__
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * HyperLogLog estimator of the number of distinct values in a stream.
+ *
+ * Each value is hashed and the hash is split into a register index,
+ * taken from its top bits, and a remainder whose number of leading
+ * zeros is tracked per register. The memory used is one byte per
+ * register, independent of the number of values seen, and the
+ * standard error of the estimate is about 1.04 / sqrt(2^precision).
+ * Small cardinalities fall back to linear counting, which is close to
+ * exact while most registers are still empty.
+ */
+class HyperLogLog
+{
+  public:
+    static const unsigned MinPrecision = 4;
+    static const unsigned MaxPrecision = 18;
+
+    /**
+     * @param precision log2 of the number of registers
+     */
+    explicit HyperLogLog(unsigned precision=14);
+
+    /** Record a value. */
+    void
+    insert(uint64_t value)
+    {
+        const uint64_t hash = mix(value);
+        const uint64_t idx = hash >> (64 - precision);
+        // Guard bit so that an all-zero remainder is bounded
+        const uint64_t rest = (hash << precision) | (1ULL << (precision - 1));
+        const uint8_t rank = __builtin_clzll(rest) + 1;
+        if (rank > registers[idx])
+            registers[idx] = rank;
+    }
+
+    /** Estimate of the number of distinct values recorded. */
+    double estimate() const;
+
+    /** Forget all recorded values. */
+    void clear();
+
+    unsigned getPrecision() const { return precision; }
+
+  private:
+    /** 64-bit finalizer from MurmurHash3 */
+    static uint64_t
+    mix(uint64_t x)
+    {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    const unsigned precision;
+    std::vector<uint8_t> registers;
+};
+
+#endif // __BASE_HYPERLOGLOG_HH__
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+
+#include "base/hyperloglog.hh"
+
+/** Small cardinalities are counted almost exactly */
+TEST(HyperLogLogTest, Small)
+{
+    HyperLogLog hll;
+    ASSERT_EQ(hll.estimate(), 0.0);
+
+    for (int rep = 0; rep < 4; rep++)
+        for (uint64_t i = 0; i < 100; i++)
+            hll.insert(i * 64);
+    ASSERT_NEAR(hll.estimate(), 100.0, 2.0);
+}
+
+/** Large cardinalities are within a few standard errors */
+TEST(HyperLogLogTest, Large)
+{
+    HyperLogLog hll(12);
+    const double n = 1000000;
+    for (uint64_t i = 0; i < n; i++)
+        hll.insert(i << 6);
+
+    // Standard error is 1.04 / sqrt(4096), about 1.6%
+    ASSERT_NEAR(hll.estimate(), n, n * 0.05);
+}
+
+/** Clearing forgets all recorded values */
+TEST(HyperLogLogTest, Clear)
+{
+    HyperLogLog hll;
+    for (uint64_t i = 0; i < 1000; i++)
+        hll.insert(i);
+    hll.clear();
+    ASSERT_EQ(hll.estimate(), 0.0);
+}
+
+/** The precision has to be within the supported range */
+TEST(HyperLogLogTest, InvalidPrecision)
+{
+    ASSERT_ANY_THROW(HyperLogLog(HyperLogLog::MaxPrecision + 1));
+    ASSERT_ANY_THROW(HyperLogLog(HyperLogLog::MinPrecision - 1));
+}
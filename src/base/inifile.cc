@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -361,8 +362,10 @@ void
 IniFile::visitSection(const std::string &sectionName,
     IniFile::VisitSectionCallback cb)
 {
-    const auto& section = *table.at(sectionName);
-    for (const auto& pair : section) {
+    const Section *section = findSection(sectionName);
+    if (section == NULL)
+        throw std::out_of_range(sectionName);
+    for (const auto& pair : *section) {
         cb(pair.first, pair.second->getValue());
     }
 }
@@ -152,14 +152,14 @@ class IniFile
 
     /// Look up section with the given name.
     /// @retval Pointer to section object, or NULL if not found.
-    Section *findSection(const std::string &sectionName) const;
+    virtual Section *findSection(const std::string &sectionName) const;
 
   public:
     /// Constructor.
     IniFile();
 
     /// Destructor.
-    ~IniFile();
+    virtual ~IniFile();
 
     /// Load parameter settings from given istream.  This is a helper
     /// function for load(string) and loadCPP(), which open a file
@@ -199,7 +199,7 @@ class IniFile
     bool sectionExists(const std::string &section) const;
 
     /// Push all section names into the given vector
-    void getSectionNames(std::vector<std::string> &list) const;
+    virtual void getSectionNames(std::vector<std::string> &list) const;
 
     /// Print unreferenced entries in object.  Iteratively calls
     /// printUnreferend() on all the constituent sections.
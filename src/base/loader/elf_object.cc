@@ -163,6 +163,7 @@ ElfObject::ElfObject(ImageFileDataPtr ifd) : ObjectFile(ifd)
             Elf_Data *data = elf_getdata(section, nullptr);
             int count = shdr.sh_size / shdr.sh_entsize;
             DPRINTF(Loader, "Found Symbol Table, %d symbols present.", count);
+            _symtab.reserve(_symtab.size() + count);
 
             // Loop through all the symbols.
             for (int i = 0; i < count; ++i) {
@@ -42,11 +42,36 @@ SymbolTable debugSymbolTable;
 void
 SymbolTable::clear()
 {
-    addrMap.clear();
+    addrIndex.clear();
+    addrIndexSorted = 0;
     nameMap.clear();
     symbols.clear();
 }
 
+void
+SymbolTable::reserve(size_t count)
+{
+    symbols.reserve(count);
+    nameMap.reserve(count);
+    addrIndex.reserve(count);
+}
+
+const SymbolTable::AddrIndex &
+SymbolTable::sortedAddrIndex() const
+{
+    if (addrIndexSorted == addrIndex.size())
+        return addrIndex;
+
+    // Symbols inserted later have larger indices, so sorting by address
+    // then index keeps symbols sharing an address in insertion order.
+    auto tail = addrIndex.begin() + addrIndexSorted;
+    std::sort(tail, addrIndex.end());
+    std::inplace_merge(addrIndex.begin(), tail, addrIndex.end());
+    addrIndexSorted = addrIndex.size();
+
+    return addrIndex;
+}
+
 bool
 SymbolTable::insert(const Symbol &symbol)
 {
@@ -59,8 +84,8 @@ SymbolTable::insert(const Symbol &symbol)
         return false;
 
     // There can be multiple symbols for the same address, so always
-    // update the addrTable multimap when we see a new symbol name.
-    addrMap.insert({ symbol.address, idx });
+    // update the address index when we see a new symbol name.
+    addrIndex.emplace_back(symbol.address, idx);
 
     symbols.emplace_back(symbol);
 
@@ -71,14 +96,12 @@ bool
 SymbolTable::insert(const SymbolTable &other)
 {
     // Check if any symbol in other already exists in our table.
-    NameMap intersection;
-    std::set_intersection(other.nameMap.begin(), other.nameMap.end(),
-                          nameMap.begin(), nameMap.end(),
-                          std::inserter(intersection, intersection.begin()),
-                          nameMap.value_comp());
-    if (!intersection.empty())
-        return false;
+    for (const Symbol &symbol: other) {
+        if (nameMap.count(symbol.name))
+            return false;
+    }
 
+    reserve(symbols.size() + other.symbols.size());
     for (const Symbol &symbol: other)
         insert(symbol);
 
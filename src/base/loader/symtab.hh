@@ -29,11 +29,13 @@
 #ifndef __BASE_LOADER_SYMTAB_HH__
 #define __BASE_LOADER_SYMTAB_HH__
 
+#include <algorithm>
 #include <functional>
 #include <iosfwd>
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "base/types.hh"
@@ -62,23 +64,38 @@ class SymbolTable
 
   private:
     typedef std::vector<Symbol> SymbolVector;
-    // Map addresses to an index into the symbol vector.
-    typedef std::multimap<Addr, int> AddrMap;
     // Map a symbol name to an index into the symbol vector.
-    typedef std::map<std::string, int> NameMap;
+    typedef std::unordered_map<std::string, int> NameMap;
+    // Addresses paired with an index into the symbol vector, ordered by
+    // address and, for symbols sharing an address, by insertion order.
+    typedef std::vector<std::pair<Addr, int>> AddrIndex;
 
     SymbolVector symbols;
-    AddrMap addrMap;
     NameMap nameMap;
 
+    // Large binaries carry hundreds of thousands of symbols which are
+    // rarely looked up by address, so the address index is only
+    // appended to on insert. The unsorted tail is sorted and merged
+    // into the sorted prefix by the first lookup that needs it.
+    mutable AddrIndex addrIndex;
+    mutable size_t addrIndexSorted = 0;
+
+    /** Sort any symbols inserted since the last address lookup. */
+    const AddrIndex &sortedAddrIndex() const;
+
     bool
-    upperBound(Addr addr, AddrMap::const_iterator &iter) const
+    upperBound(Addr addr, AddrIndex::const_iterator &iter) const
     {
+        const auto &index = sortedAddrIndex();
+
         // find first key *larger* than desired address
-        iter = addrMap.upper_bound(addr);
+        iter = std::upper_bound(index.begin(), index.end(), addr,
+            [](Addr a, const AddrIndex::value_type &e) {
+                return a < e.first;
+            });
 
         // if very first key is larger, we're out of luck
-        if (iter == addrMap.begin())
+        if (iter == index.begin())
             return false;
 
         return true;
@@ -130,6 +147,10 @@ class SymbolTable
     bool insert(const Symbol &symbol);
     bool insert(const SymbolTable &other);
     bool empty() const { return symbols.empty(); }
+    size_t size() const { return symbols.size(); }
+
+    /// Make room for the given number of symbols ahead of a bulk insert.
+    void reserve(size_t count);
 
     SymbolTablePtr
     offset(Addr by) const
@@ -178,8 +199,12 @@ class SymbolTable
     const_iterator
     find(Addr address) const
     {
-        AddrMap::const_iterator i = addrMap.find(address);
-        if (i == addrMap.end())
+        const auto &index = sortedAddrIndex();
+        auto i = std::lower_bound(index.begin(), index.end(), address,
+            [](const AddrIndex::value_type &e, Addr a) {
+                return e.first < a;
+            });
+        if (i == index.end() || i->first != address)
             return end();
 
         // There are potentially multiple symbols that map to the same
@@ -206,11 +231,11 @@ class SymbolTable
     const_iterator
     findNearest(Addr addr, Addr &nextaddr) const
     {
-        AddrMap::const_iterator i = addrMap.end();
+        AddrIndex::const_iterator i;
         if (!upperBound(addr, i))
             return end();
 
-        nextaddr = i->first;
+        nextaddr = i == addrIndex.end() ? MaxAddr : i->first;
         --i;
         return symbols.begin() + i->second;
     }
@@ -220,7 +245,7 @@ class SymbolTable
     const_iterator
     findNearest(Addr addr) const
     {
-        AddrMap::const_iterator i = addrMap.end();
+        AddrIndex::const_iterator i;
         if (!upperBound(addr, i))
             return end();
 
@@ -41,6 +41,7 @@
 #include "base/logging.hh"
 
 #include <sstream>
+#include <vector>
 
 #include "base/hostinfo.hh"
 
@@ -55,6 +56,13 @@ class NormalLogger : public Logger
     void log(const Loc &loc, std::string s) override { std::cerr << s; }
 };
 
+std::vector<void (*)()> &
+exitHooks()
+{
+    static std::vector<void (*)()> hooks;
+    return hooks;
+}
+
 class ExitLogger : public NormalLogger
 {
   public:
@@ -67,6 +75,14 @@ class ExitLogger : public NormalLogger
         std::stringstream ss;
         ccprintf(ss, "Memory Usage: %ld KBytes\n", memUsage());
         NormalLogger::log(loc, s + ss.str());
+
+        // A hook that panics itself must not start over
+        static bool running_hooks = false;
+        if (!running_hooks) {
+            running_hooks = true;
+            for (auto hook : exitHooks())
+                hook();
+        }
     }
 };
 
@@ -87,6 +103,8 @@ NormalLogger hackLogger("hack: ");
 
 } // anonymous namespace
 
+void Logger::addExitHook(void (*hook)()) { exitHooks().push_back(hook); }
+
 Logger &Logger::getPanic() { return panicLogger; }
 Logger &Logger::getFatal() { return fatalLogger; }
 Logger &Logger::getWarn() { return warnLogger; }
@@ -116,6 +116,13 @@ class Logger
         print(loc, format.c_str(), args...);
     }
 
+    /**
+     * Register a function that is called after a panic or fatal message
+     * has been printed, before the simulator exits. This gives subsystems
+     * a chance to save diagnostic state.
+     */
+    static void addExitHook(void (*hook)());
+
     /**
      * This helper is necessary since noreturn isn't inherited by virtual
      * functions, and gcc will get mad if a function calls panic and then
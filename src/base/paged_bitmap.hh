@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_PAGED_BITMAP_HH__
+#define __BASE_PAGED_BITMAP_HH__
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "base/logging.hh"
+
+/**
+ * A bitmap over a large, sparsely populated index space.
+ *
+ * The index space is split into fixed size pages of bits that are
+ * only allocated once one of their bits is set, so the memory used is
+ * proportional to the regions that have actually been touched rather
+ * than to the size of the index space. The number of set bits is
+ * maintained on insertion, making count() constant time.
+ */
+class PagedBitmap
+{
+  public:
+    /**
+     * @param page_bits log2 of the number of bits held by each page
+     */
+    explicit PagedBitmap(unsigned page_bits=15)
+        : pageBits(page_bits), wordsPerPage((1ULL << page_bits) / 64),
+          numSet(0), lastIdx(0), lastPage(nullptr)
+    {
+        fatal_if(page_bits < 6 || page_bits > 30,
+                 "PagedBitmap page size must be between 2^6 and 2^30 bits.");
+    }
+
+    /**
+     * Set the bit at position idx.
+     *
+     * @return true if the bit was previously clear.
+     */
+    bool
+    insert(uint64_t idx)
+    {
+        uint64_t *page = getPage(idx >> pageBits);
+        const uint64_t offset = idx & ((1ULL << pageBits) - 1);
+        uint64_t &word = page[offset / 64];
+        const uint64_t mask = 1ULL << (offset % 64);
+        if (word & mask)
+            return false;
+        word |= mask;
+        numSet++;
+        return true;
+    }
+
+    /** Check if the bit at position idx is set. */
+    bool
+    contains(uint64_t idx) const
+    {
+        auto it = pages.find(idx >> pageBits);
+        if (it == pages.end())
+            return false;
+        const uint64_t offset = idx & ((1ULL << pageBits) - 1);
+        return it->second[offset / 64] & (1ULL << (offset % 64));
+    }
+
+    /** Number of bits set. */
+    uint64_t count() const { return numSet; }
+
+    /** Number of pages currently allocated. */
+    size_t numPages() const { return pages.size(); }
+
+    /** Clear all bits and release the pages. */
+    void
+    clear()
+    {
+        pages.clear();
+        numSet = 0;
+        lastPage = nullptr;
+    }
+
+  private:
+    uint64_t *
+    getPage(uint64_t page_idx)
+    {
+        // Accesses tend to be clustered, so remember the last page to
+        // skip the hash table lookup most of the time
+        if (lastPage && lastIdx == page_idx)
+            return lastPage;
+
+        auto &page = pages[page_idx];
+        if (!page)
+            page.reset(new uint64_t[wordsPerPage]());
+
+        lastIdx = page_idx;
+        lastPage = page.get();
+        return lastPage;
+    }
+
+    const unsigned pageBits;
+    const uint64_t wordsPerPage;
+
+    uint64_t numSet;
+
+    std::unordered_map<uint64_t, std::unique_ptr<uint64_t[]>> pages;
+
+    uint64_t lastIdx;
+    uint64_t *lastPage;
+};
+
+#endif // __BASE_PAGED_BITMAP_HH__
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "base/paged_bitmap.hh"
+
+/** Bits are only counted the first time they are set */
+TEST(PagedBitmapTest, InsertCount)
+{
+    PagedBitmap bitmap;
+    ASSERT_TRUE(bitmap.insert(5));
+    ASSERT_FALSE(bitmap.insert(5));
+    ASSERT_TRUE(bitmap.insert(6));
+    ASSERT_EQ(bitmap.count(), 2);
+    ASSERT_TRUE(bitmap.contains(5));
+    ASSERT_FALSE(bitmap.contains(7));
+}
+
+/** Pages are only allocated for the regions that are touched */
+TEST(PagedBitmapTest, Sparse)
+{
+    PagedBitmap bitmap(10);
+    bitmap.insert(0);
+    bitmap.insert(1023);
+    ASSERT_EQ(bitmap.numPages(), 1);
+
+    bitmap.insert(1024);
+    bitmap.insert(UINT64_C(1) << 50);
+    ASSERT_EQ(bitmap.numPages(), 3);
+    ASSERT_EQ(bitmap.count(), 4);
+    ASSERT_TRUE(bitmap.contains(UINT64_C(1) << 50));
+    ASSERT_FALSE(bitmap.contains((UINT64_C(1) << 50) + 1));
+}
+
+/** Clearing forgets all bits and releases the pages */
+TEST(PagedBitmapTest, Clear)
+{
+    PagedBitmap bitmap;
+    for (uint64_t i = 0; i < 100000; i += 3)
+        bitmap.insert(i);
+    bitmap.clear();
+    ASSERT_EQ(bitmap.count(), 0);
+    ASSERT_EQ(bitmap.numPages(), 0);
+    ASSERT_FALSE(bitmap.contains(3));
+    ASSERT_TRUE(bitmap.insert(3));
+    ASSERT_EQ(bitmap.count(), 1);
+}
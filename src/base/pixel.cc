@@ -38,6 +38,7 @@
 #include "base/pixel.hh"
 
 #include <cassert>
+#include <cstring>
 
 #include "base/bitfield.hh"
 
@@ -48,6 +49,43 @@ const PixelConverter PixelConverter::rgb565_le(2,  0, 5, 11, 5, 6, 5);
 const PixelConverter PixelConverter::rgb565_be(2,  0, 5, 11, 5, 6, 5,
                                                ByteOrder::big);
 
+namespace
+{
+
+/*
+ * Conversion loops for 32-bit color words with 8-bit channels, the
+ * format used by most display controllers and by the VNC server. The
+ * channels don't need any scaling in that case, which keeps the loops
+ * simple enough for the compiler to vectorize them.
+ */
+template <ByteOrder Order>
+void
+toPixelsDirect(Pixel *dst, const uint8_t *src, size_t count,
+               unsigned ro, unsigned go, unsigned bo)
+{
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t word;
+        std::memcpy(&word, src + i * sizeof(word), sizeof(word));
+        word = gtoh(word, Order);
+        dst[i] = Pixel(word >> ro, word >> go, word >> bo);
+    }
+}
+
+template <ByteOrder Order>
+void
+fromPixelsDirect(uint8_t *dst, const Pixel *src, size_t count,
+                 unsigned ro, unsigned go, unsigned bo)
+{
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t word = htog((uint32_t)src[i].red << ro |
+                                   (uint32_t)src[i].green << go |
+                                   (uint32_t)src[i].blue << bo, Order);
+        std::memcpy(dst + i * sizeof(word), &word, sizeof(word));
+    }
+}
+
+} // anonymous namespace
+
 PixelConverter::PixelConverter(unsigned _length,
                                unsigned ro, unsigned go, unsigned bo,
                                unsigned rw, unsigned gw, unsigned bw,
@@ -96,3 +134,45 @@ PixelConverter::writeWord(uint8_t *p, uint32_t word) const
             p[i] = (word >> (8 * (length - i - 1))) & 0xFF;
     }
 }
+
+void
+PixelConverter::toPixels(Pixel *dst, const uint8_t *src, size_t count) const
+{
+    if (length == 4 &&
+        ch_r.mask == 0xFF && ch_g.mask == 0xFF && ch_b.mask == 0xFF) {
+        if (byte_order == ByteOrder::little) {
+            toPixelsDirect<ByteOrder::little>(dst, src, count,
+                    ch_r.offset, ch_g.offset, ch_b.offset);
+        } else {
+            toPixelsDirect<ByteOrder::big>(dst, src, count,
+                    ch_r.offset, ch_g.offset, ch_b.offset);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = toPixel(src);
+        src += length;
+    }
+}
+
+void
+PixelConverter::fromPixels(uint8_t *dst, const Pixel *src, size_t count) const
+{
+    if (length == 4 &&
+        ch_r.mask == 0xFF && ch_g.mask == 0xFF && ch_b.mask == 0xFF) {
+        if (byte_order == ByteOrder::little) {
+            fromPixelsDirect<ByteOrder::little>(dst, src, count,
+                    ch_r.offset, ch_g.offset, ch_b.offset);
+        } else {
+            fromPixelsDirect<ByteOrder::big>(dst, src, count,
+                    ch_r.offset, ch_g.offset, ch_b.offset);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        fromPixel(dst, src[i]);
+        dst += length;
+    }
+}
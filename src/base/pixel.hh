@@ -157,6 +157,24 @@ class PixelConverter
         writeWord(rfb, fromPixel(pixel));
     }
 
+    /**
+     * Convert an array of color words in memory into Pixels.
+     *
+     * @param dst Destination Pixels.
+     * @param src First byte of the first color word.
+     * @param count Number of pixels to convert.
+     */
+    void toPixels(Pixel *dst, const uint8_t *src, size_t count) const;
+
+    /**
+     * Convert an array of Pixels into color words in memory.
+     *
+     * @param dst First byte of the first color word.
+     * @param src Source Pixels.
+     * @param count Number of pixels to convert.
+     */
+    void fromPixels(uint8_t *dst, const Pixel *src, size_t count) const;
+
     /**
      * Read a word of a given length and endianness from memory.
      *
@@ -37,6 +37,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+
 #include "base/pixel.hh"
 
 static Pixel pixel_red(0xff, 0x00, 0x00);
@@ -117,3 +119,30 @@ TEST(FBTest, MemToPixelRGBA8888BE)
     EXPECT_EQ(PixelConverter::rgba8888_be.toPixel(green), pixel_green);
     EXPECT_EQ(PixelConverter::rgba8888_be.toPixel(blue), pixel_blue);
 }
+
+TEST(FBTest, BulkConversion)
+{
+    const PixelConverter *convs[] = {
+        &PixelConverter::rgba8888_le, &PixelConverter::rgba8888_be,
+        &PixelConverter::rgb565_le, &PixelConverter::rgb565_be,
+    };
+
+    const Pixel pixels[] = {
+        pixel_red, pixel_green, pixel_blue,
+        Pixel(0x12, 0x34, 0x56), Pixel(0xfe, 0xdc, 0xba),
+    };
+    const size_t count = sizeof(pixels) / sizeof(pixels[0]);
+
+    for (auto *conv : convs) {
+        uint8_t bulk[4 * count], single[4 * count];
+        conv->fromPixels(bulk, pixels, count);
+        for (size_t i = 0; i < count; ++i)
+            conv->fromPixel(single + i * conv->length, pixels[i]);
+        EXPECT_EQ(memcmp(bulk, single, conv->length * count), 0);
+
+        Pixel back[count];
+        conv->toPixels(back, bulk, count);
+        for (size_t i = 0; i < count; ++i)
+            EXPECT_EQ(back[i], conv->toPixel(single + i * conv->length));
+    }
+}
@@ -40,6 +40,7 @@
 
 #include "base/random.hh"
 
+#include <atomic>
 #include <sstream>
 
 #include "base/logging.hh"
@@ -66,6 +67,25 @@ Random::init(uint32_t s)
     gen.seed(s);
 }
 
+namespace
+{
+
+std::atomic<uint32_t> nextThreadSeed(5489);
+
+} // anonymous namespace
+
+void
+Random::setThreadSeed(uint32_t s)
+{
+    nextThreadSeed = s;
+}
+
+uint32_t
+Random::threadSeed()
+{
+    return nextThreadSeed;
+}
+
 void
 Random::serialize(CheckpointOut &cp) const
 {
@@ -93,4 +113,4 @@ Random::unserialize(CheckpointIn &cp)
     }
 }
 
-Random random_mt;
+thread_local Random random_mt(Random::threadSeed());
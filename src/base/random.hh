@@ -75,6 +75,14 @@ class Random : public Serializable
 
     void init(uint32_t s);
 
+    /**
+     * Set the seed of the random_mt generators of the host threads
+     * that have not used theirs yet.
+     */
+    static void setThreadSeed(uint32_t s);
+    /** Seed the random_mt generator of a new host thread starts from */
+    static uint32_t threadSeed();
+
     /**
      * Use the SFINAE idiom to choose an implementation based on
      * whether the type is integral or floating point.
@@ -117,8 +125,12 @@ class Random : public Serializable
 };
 
 /**
+ * Every host thread has a generator of its own, so that simulation
+ * threads draw from it without racing. The generator of a thread is
+ * seeded with Random::threadSeed() when the thread first uses it.
+ *
  * @ingroup api_base_utils
  */
-extern Random random_mt;
+extern thread_local Random random_mt;
 
 #endif // __BASE_RANDOM_HH__
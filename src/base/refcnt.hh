@@ -102,6 +102,16 @@ class RefCounted
         if (--count <= 0)
             delete this;
     }
+
+  protected:
+    /**
+     * Decrement the reference count without destroying the object. This
+     * is meant for classes that provide their own decref to manage the
+     * storage of their objects.
+     *
+     * @return True if all references are gone.
+     */
+    bool dropRef() const { return --count <= 0; }
 };
 
 /**
@@ -207,6 +217,14 @@ class RefCountingPtr
     template <bool B = TisConst>
     RefCountingPtr(const NonConstT &r) { copy(r.data); }
 
+    /// Create a reference counting pointer to a base class of the
+    /// object another one points to.  Adds a reference.
+    template <class U, class = std::enable_if_t<
+        std::is_convertible<U *, T *>::value &&
+        !std::is_same<std::remove_const_t<U>,
+                      std::remove_const_t<T>>::value>>
+    RefCountingPtr(const RefCountingPtr<U> &r) { copy(r.get()); }
+
     /// Destroy the pointer and any reference it may hold.
     ~RefCountingPtr() { del(); }
 
@@ -68,6 +68,27 @@ class TestRC : public RefCounted
 };
 typedef RefCountingPtr<TestRC> Ptr;
 
+class TestRCDerived : public TestRC
+{
+};
+typedef RefCountingPtr<TestRCDerived> DerivedPtr;
+
+/** Recycles its objects instead of deleting them. */
+class TestRCRecycled : public RefCounted
+{
+  public:
+    static int recycled;
+
+    void
+    decref() const
+    {
+        if (dropRef())
+            ++recycled;
+    }
+};
+int TestRCRecycled::recycled = 0;
+typedef RefCountingPtr<TestRCRecycled> RecycledPtr;
+
 } // anonymous namespace
 
 TEST(RefcntTest, NullPointerCheck)
@@ -170,3 +191,30 @@ TEST(RefcntTest, EqualityOperators)
     EXPECT_TRUE(equalTestAPtr != equalTestB);
     EXPECT_TRUE(equalTestAPtr != equalTestBPtr);
 }
+
+TEST(RefcntTest, ConversionToBasePointer)
+{
+    // Convert a Ptr to a derived class into a Ptr to its base class.
+    DerivedPtr derivedPtr = new TestRCDerived();
+    Ptr basePtr = derivedPtr;
+    EXPECT_EQ(1, liveListSize());
+    EXPECT_EQ(basePtr.get(), derivedPtr.get());
+
+    // Both pointers hold a reference.
+    derivedPtr = nullptr;
+    EXPECT_EQ(1, liveListSize());
+    basePtr = nullptr;
+    EXPECT_EQ(0, liveListSize());
+}
+
+TEST(RefcntTest, CustomDecref)
+{
+    // The last reference going away calls the decref of the class.
+    TestRCRecycled recycledObj;
+    RecycledPtr recycledPtr1 = &recycledObj;
+    RecycledPtr recycledPtr2 = recycledPtr1;
+    recycledPtr1 = nullptr;
+    EXPECT_EQ(0, TestRCRecycled::recycled);
+    recycledPtr2 = nullptr;
+    EXPECT_EQ(1, TestRCRecycled::recycled);
+}
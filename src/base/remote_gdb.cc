@@ -533,7 +533,7 @@ BaseRemoteGDB::recv(std::vector<char>& bp)
             c = getbyte();
             if (c == GDBEnd)
                 break;
-            c &= 0x7f;
+            // Keep all eight bits, binary packets (X) rely on them.
             csum += c;
             bp.push_back(c);
         }
@@ -570,19 +570,25 @@ BaseRemoteGDB::recv(std::vector<char>& bp)
 void
 BaseRemoteGDB::send(const char *bp)
 {
-    const char *p;
+    send(std::string(bp));
+}
+
+// Send a packet to gdb, which may hold binary data
+void
+BaseRemoteGDB::send(const std::string &bp)
+{
     uint8_t csum, c;
 
     DPRINTF(GDBSend, "send:  %s\n", bp);
 
     do {
-        p = bp;
         // Start sending a packet
         putbyte(GDBStart);
         // Send the contents, and also keep a check sum.
-        for (csum = 0; (c = *p); p++) {
-            putbyte(c);
-            csum += c;
+        csum = 0;
+        for (const char &b : bp) {
+            putbyte(b);
+            csum += b;
         }
         // Send the ending character.
         putbyte(GDBEnd);
@@ -607,7 +613,7 @@ BaseRemoteGDB::read(Addr vaddr, size_t size, char *data)
 #if TRACING_ON
     if (DTRACE(GDBRead)) {
         if (DTRACE(GDBExtra)) {
-            char buf[1024];
+            char buf[2 * size + 1];
             mem2hex(buf, data, size);
             DPRINTFNR(": %s\n", buf);
         } else
@@ -625,7 +631,7 @@ BaseRemoteGDB::write(Addr vaddr, size_t size, const char *data)
     if (DTRACE(GDBWrite)) {
         DPRINTFN("write: addr=%#x, size=%d", vaddr, size);
         if (DTRACE(GDBExtra)) {
-            char buf[1024];
+            char buf[2 * size + 1];
             mem2hex(buf, data, size);
             DPRINTFNR(": %s\n", buf);
         } else
@@ -774,8 +780,10 @@ std::map<char, BaseRemoteGDB::GdbCommand> BaseRemoteGDB::command_map = {
     { 'T', { "KGDB_THREAD_ALIVE", &BaseRemoteGDB::cmd_unsupported } },
     // target exited
     { 'W', { "KGDB_TARGET_EXIT", &BaseRemoteGDB::cmd_unsupported } },
+    // read memory, binary reply
+    { 'x', { "KGDB_BINARY_MEM_R", &BaseRemoteGDB::cmd_bin_mem_r } },
     // write memory
-    { 'X', { "KGDB_BINARY_DLOAD", &BaseRemoteGDB::cmd_unsupported } },
+    { 'X', { "KGDB_BINARY_DLOAD", &BaseRemoteGDB::cmd_bin_mem_w } },
     // remove breakpoint or watchpoint
     { 'z', { "KGDB_CLR_HW_BKPT", &BaseRemoteGDB::cmd_clr_hw_bkpt } },
     // insert breakpoint or watchpoint
@@ -918,6 +926,56 @@ BaseRemoteGDB::cmd_mem_w(GdbCommand::Context &ctx)
     return true;
 }
 
+bool
+BaseRemoteGDB::cmd_bin_mem_r(GdbCommand::Context &ctx)
+{
+    const char *p = ctx.data;
+    Addr addr = hex2i(&p);
+    if (*p++ != ',')
+        throw CmdError("E02");
+    size_t len = hex2i(&p);
+    if (*p != '\0')
+        throw CmdError("E03");
+    if (!acc(addr, len))
+        throw CmdError("E05");
+
+    std::string buf(len, '\0');
+    if (len && !read(addr, len, &buf[0]))
+        throw CmdError("E05");
+
+    // Binary replies are about half the size of hex ones.
+    std::string encoded("b");
+    encodeBinaryData(buf, encoded);
+    send(encoded);
+    return true;
+}
+
+bool
+BaseRemoteGDB::cmd_bin_mem_w(GdbCommand::Context &ctx)
+{
+    const char *p = ctx.data;
+    Addr addr = hex2i(&p);
+    if (*p++ != ',')
+        throw CmdError("E06");
+    size_t len = hex2i(&p);
+    if (*p++ != ':')
+        throw CmdError("E07");
+    // GDB probes for X support with an empty write.
+    if (len == 0) {
+        send("OK");
+        return true;
+    }
+    char buf[len];
+    if (!decodeBinaryData(p, ctx.len - (p - ctx.data), buf, len))
+        throw CmdError("E08");
+    if (!acc(addr, len))
+        throw CmdError("E0A");
+    if (!write(addr, len, buf))
+        throw CmdError("E0B");
+    send("OK");
+    return true;
+}
+
 bool
 BaseRemoteGDB::cmd_query_var(GdbCommand::Context &ctx)
 {
@@ -927,8 +985,11 @@ BaseRemoteGDB::cmd_query_var(GdbCommand::Context &ctx)
         std::ostringstream oss;
         // This reply field mandatory. We can receive arbitrarily
         // long packets, so we could choose it to be arbitrarily large.
-        // This is just an arbitrary filler value that seems to work.
-        oss << "PacketSize=1024";
+        // GDB splits memory transfers to fit, so keep it large enough
+        // for those to take few round trips. The value is in hex.
+        oss << "PacketSize=10000";
+        // Memory reads can be answered in binary (x packets).
+        oss << ";binary-upload+";
         for (const auto& feature : availableFeatures())
             oss << ';' << feature;
         send(oss.str().c_str());
@@ -990,6 +1051,25 @@ BaseRemoteGDB::encodeBinaryData(
     }
 }
 
+bool
+BaseRemoteGDB::decodeBinaryData(const char *encoded, size_t encoded_length,
+    char *decoded, size_t decoded_length) const
+{
+    size_t out = 0;
+    for (size_t i = 0; i < encoded_length; i++) {
+        if (out == decoded_length)
+            return false;
+        char c = encoded[i];
+        if (c == '}') {
+            if (++i == encoded_length)
+                return false;
+            c = encoded[i] ^ 0x20;
+        }
+        decoded[out++] = c;
+    }
+    return out == decoded_length;
+}
+
 void
 BaseRemoteGDB::encodeXferResponse(const std::string &unencoded,
     std::string &encoded, size_t offset, size_t unencoded_length) const
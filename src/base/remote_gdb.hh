@@ -203,6 +203,7 @@ class BaseRemoteGDB
 
     void recv(std::vector<char> &bp);
     void send(const char *data);
+    void send(const std::string &data);
 
     /*
      * Simulator side debugger state.
@@ -293,6 +294,8 @@ class BaseRemoteGDB
     bool cmd_set_thread(GdbCommand::Context &ctx);
     bool cmd_mem_r(GdbCommand::Context &ctx);
     bool cmd_mem_w(GdbCommand::Context &ctx);
+    bool cmd_bin_mem_r(GdbCommand::Context &ctx);
+    bool cmd_bin_mem_w(GdbCommand::Context &ctx);
     bool cmd_query_var(GdbCommand::Context &ctx);
     bool cmd_step(GdbCommand::Context &ctx);
     bool cmd_async_step(GdbCommand::Context &ctx);
@@ -306,6 +309,18 @@ class BaseRemoteGDB
     void encodeBinaryData(const std::string &unencoded,
             std::string &encoded) const;
 
+    /**
+     * Undo the escaping of binary data sent by GDB.
+     *
+     * @param[in] encoded the escaped data
+     * @param[in] encoded_length number of bytes of escaped data
+     * @param[out] decoded buffer for the decoded bytes
+     * @param[in] decoded_length number of bytes expected in decoded
+     * @return true if exactly decoded_length bytes were decoded
+     */
+    bool decodeBinaryData(const char *encoded, size_t encoded_length,
+            char *decoded, size_t decoded_length) const;
+
     void encodeXferResponse(const std::string &unencoded,
         std::string &encoded, size_t offset, size_t unencoded_length) const;
 
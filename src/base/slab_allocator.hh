@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SLAB_ALLOCATOR_HH__
+#define __BASE_SLAB_ALLOCATOR_HH__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "base/logging.hh"
+
+/**
+ * A size class based allocator for small, short lived objects.
+ *
+ * Blocks are carved out of large chunks obtained from the global
+ * operator new and are recycled through one free list per size
+ * class. Memory is only returned to the system when the allocator is
+ * destroyed, so the memory reserved by the allocator is the high-water
+ * mark of its footprint. Requests larger than MaxBlockSize are passed
+ * straight to the global operator new.
+ *
+ * The allocator is not thread safe; it is meant to be instantiated
+ * once per thread. Blocks may be released to a different allocator
+ * than the one they were obtained from as long as both outlive the
+ * block. The statistics can be read from any thread.
+ *
+ * To catch objects that are used after they have been freed and
+ * handed out again, freed blocks can be poisoned. The poison is
+ * checked when the block is reused, which is enabled by default in
+ * debug builds.
+ */
+class SlabAllocator
+{
+  public:
+    /** Size class granularity, also the alignment of every block. */
+    static const size_t Granularity = 16;
+    /** Largest request served from the size class free lists. */
+    static const size_t MaxBlockSize = 512;
+    /** Size of the chunks blocks are carved from. */
+    static const size_t ChunkSize = 64 * 1024;
+    /** Pattern freed blocks are filled with when poisoning. */
+    static const uint8_t PoisonByte = 0xdb;
+
+#ifdef DEBUG
+    static const bool PoisonDefault = true;
+#else
+    static const bool PoisonDefault = false;
+#endif
+
+    static_assert(Granularity >= alignof(std::max_align_t),
+                  "Slab blocks must be suitably aligned for any type");
+
+    struct Stats
+    {
+        /** Number of allocations. */
+        uint64_t allocs = 0;
+        /** Allocations served without calling the global allocator. */
+        uint64_t hits = 0;
+        /** Bytes obtained from the global allocator for slabs. */
+        uint64_t reserved = 0;
+
+        Stats &
+        operator+=(const Stats &other)
+        {
+            allocs += other.allocs;
+            hits += other.hits;
+            reserved += other.reserved;
+            return *this;
+        }
+    };
+
+  private:
+    static const size_t NumClasses = MaxBlockSize / Granularity;
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    std::array<FreeBlock *, NumClasses> freeLists;
+    std::vector<void *> chunks;
+    const bool poison;
+
+    // The allocator has a single writer, these are only atomic so
+    // that statistics can be sampled by another thread.
+    std::atomic<uint64_t> allocs;
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> reserved;
+
+    static void
+    increment(std::atomic<uint64_t> &counter, uint64_t value=1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value,
+                      std::memory_order_relaxed);
+    }
+
+    static size_t
+    sizeClass(size_t size)
+    {
+        return size ? (size - 1) / Granularity : 0;
+    }
+
+    static size_t
+    blockSize(size_t size_class)
+    {
+        return (size_class + 1) * Granularity;
+    }
+
+    /** Check that a free block hasn't been written since it was freed. */
+    static void
+    checkPoison(const FreeBlock *block, size_t size_class)
+    {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(block);
+        for (size_t i = sizeof(FreeBlock); i < blockSize(size_class); ++i) {
+            panic_if(bytes[i] != PoisonByte,
+                     "Slab block %#x was written %d bytes in after it was "
+                     "freed\n", (uintptr_t)block, i);
+        }
+    }
+
+    /** Carve a new chunk into blocks of the given size class. */
+    void
+    refill(size_t size_class)
+    {
+        const size_t block_size = blockSize(size_class);
+        char *chunk = static_cast<char *>(::operator new(ChunkSize));
+        chunks.push_back(chunk);
+        increment(reserved, ChunkSize);
+        if (poison)
+            std::memset(chunk, PoisonByte, ChunkSize);
+
+        FreeBlock *head = freeLists[size_class];
+        for (size_t offset = 0; offset + block_size <= ChunkSize;
+                offset += block_size) {
+            FreeBlock *block = reinterpret_cast<FreeBlock *>(chunk + offset);
+            block->next = head;
+            head = block;
+        }
+        freeLists[size_class] = head;
+    }
+
+  public:
+    explicit SlabAllocator(bool _poison=PoisonDefault)
+        : freeLists{}, poison(_poison), allocs(0), hits(0), reserved(0)
+    {}
+
+    ~SlabAllocator()
+    {
+        for (auto *chunk : chunks)
+            ::operator delete(chunk);
+    }
+
+    SlabAllocator(const SlabAllocator &) = delete;
+    SlabAllocator &operator=(const SlabAllocator &) = delete;
+
+    void *
+    allocate(size_t size)
+    {
+        increment(allocs);
+        if (size > MaxBlockSize)
+            return ::operator new(size);
+
+        const size_t size_class = sizeClass(size);
+        FreeBlock *block = freeLists[size_class];
+        if (block) {
+            increment(hits);
+        } else {
+            refill(size_class);
+            block = freeLists[size_class];
+        }
+        freeLists[size_class] = block->next;
+        if (poison) {
+            checkPoison(block, size_class);
+            std::memset(block, 0, sizeof(FreeBlock));
+        }
+        return block;
+    }
+
+    void
+    deallocate(void *p, size_t size)
+    {
+        if (!p)
+            return;
+
+        if (size > MaxBlockSize) {
+            ::operator delete(p);
+            return;
+        }
+
+        const size_t size_class = sizeClass(size);
+        if (poison)
+            std::memset(p, PoisonByte, blockSize(size_class));
+        FreeBlock *block = static_cast<FreeBlock *>(p);
+        block->next = freeLists[size_class];
+        freeLists[size_class] = block;
+    }
+
+    Stats
+    stats() const
+    {
+        Stats s;
+        s.allocs = allocs.load(std::memory_order_relaxed);
+        s.hits = hits.load(std::memory_order_relaxed);
+        s.reserved = reserved.load(std::memory_order_relaxed);
+        return s;
+    }
+};
+
+/**
+ * Per-thread slab allocators serving one kind of object. Allocators
+ * are never destroyed since objects may outlive the thread that
+ * allocated them, including static destruction in the main thread;
+ * they are kept track of to collect statistics.
+ */
+class SlabAllocatorSet
+{
+  private:
+    std::mutex lock;
+    std::vector<SlabAllocator *> allocators;
+
+  public:
+    /** Create the allocator of a new thread. */
+    SlabAllocator *
+    create()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        allocators.push_back(new SlabAllocator());
+        return allocators.back();
+    }
+
+    /** Statistics summed over all threads. */
+    SlabAllocator::Stats
+    stats()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        SlabAllocator::Stats s;
+        for (auto *allocator : allocators)
+            s += allocator->stats();
+        return s;
+    }
+};
+
+#endif // __BASE_SLAB_ALLOCATOR_HH__
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "base/slab_allocator.hh"
+
+namespace
+{
+
+// Copies that can be bound to the references taken by the assertions.
+const uint64_t chunkSize = SlabAllocator::ChunkSize;
+const uintptr_t granularity = SlabAllocator::Granularity;
+
+} // anonymous namespace
+
+/** Freed blocks are handed out again for requests of the same class */
+TEST(SlabAllocatorTest, Recycle)
+{
+    SlabAllocator allocator;
+    void *p = allocator.allocate(40);
+    allocator.deallocate(p, 40);
+    ASSERT_EQ(allocator.allocate(33), p);
+
+    SlabAllocator::Stats stats = allocator.stats();
+    ASSERT_EQ(stats.allocs, 2);
+    ASSERT_EQ(stats.hits, 1);
+    ASSERT_EQ(stats.reserved, chunkSize);
+}
+
+/** Live blocks never overlap and are suitably aligned */
+TEST(SlabAllocatorTest, Distinct)
+{
+    SlabAllocator allocator;
+    const size_t size = 48;
+    const size_t count = 3 * chunkSize / size;
+    std::vector<char *> blocks;
+    std::set<char *> sorted;
+
+    for (size_t i = 0; i < count; ++i) {
+        char *p = static_cast<char *>(allocator.allocate(size));
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % granularity, 0);
+        blocks.push_back(p);
+        ASSERT_TRUE(sorted.insert(p).second);
+    }
+
+    char *last = nullptr;
+    for (auto *p : sorted) {
+        if (last) {
+            ASSERT_GE(p - last, size);
+        }
+        last = p;
+    }
+
+    for (auto *p : blocks)
+        allocator.deallocate(p, size);
+
+    SlabAllocator::Stats stats = allocator.stats();
+    ASSERT_EQ(stats.allocs, count);
+    ASSERT_EQ(stats.reserved, 4 * chunkSize);
+}
+
+/** Size classes don't share free lists */
+TEST(SlabAllocatorTest, SizeClasses)
+{
+    SlabAllocator allocator;
+    void *small = allocator.allocate(16);
+    allocator.deallocate(small, 16);
+    void *large = allocator.allocate(SlabAllocator::MaxBlockSize);
+    ASSERT_NE(large, small);
+    ASSERT_EQ(allocator.stats().hits, 0);
+    ASSERT_EQ(allocator.stats().reserved, 2 * chunkSize);
+}
+
+/** Large requests bypass the slabs */
+TEST(SlabAllocatorTest, Large)
+{
+    SlabAllocator allocator;
+    const size_t size = SlabAllocator::MaxBlockSize + 1;
+    void *p = allocator.allocate(size);
+    ASSERT_NE(p, nullptr);
+    allocator.deallocate(p, size);
+
+    SlabAllocator::Stats stats = allocator.stats();
+    ASSERT_EQ(stats.allocs, 1);
+    ASSERT_EQ(stats.hits, 0);
+    ASSERT_EQ(stats.reserved, 0);
+}
+
+/** Writes to a poisoned block after it was freed are caught on reuse */
+TEST(SlabAllocatorTest, Poison)
+{
+    SlabAllocator allocator(true);
+    uint64_t *p = static_cast<uint64_t *>(allocator.allocate(32));
+    p[3] = 0;
+    allocator.deallocate(p, 32);
+    ASSERT_EQ(allocator.allocate(32), p);
+    allocator.deallocate(p, 32);
+
+    p[3] = 0;
+    EXPECT_ANY_THROW(allocator.allocate(32));
+}
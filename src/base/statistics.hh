@@ -1953,6 +1953,37 @@ class Scalar : public ScalarBase<Scalar, StatStor>
     }
 };
 
+/**
+ * A scalar counter that can be updated concurrently by several
+ * simulation threads. Each thread updates its own copy, the copies
+ * are merged when the stat is read.
+ * @sa Stat, ScalarBase, ShardedStor
+ */
+class ShardedScalar : public ScalarBase<ShardedScalar, ShardedStor>
+{
+  public:
+    using ScalarBase<ShardedScalar, ShardedStor>::operator=;
+
+    ShardedScalar(Group *parent = nullptr)
+        : ScalarBase<ShardedScalar, ShardedStor>(
+            parent, nullptr, UNIT_UNSPECIFIED, nullptr)
+    {
+    }
+
+    ShardedScalar(Group *parent, const char *name,
+                  const char *desc = nullptr)
+        : ScalarBase<ShardedScalar, ShardedStor>(
+            parent, name, UNIT_UNSPECIFIED, desc)
+    {
+    }
+
+    ShardedScalar(Group *parent, const char *name, const Units::Base *unit,
+                  const char *desc = nullptr)
+        : ScalarBase<ShardedScalar, ShardedStor>(parent, name, unit, desc)
+    {
+    }
+};
+
 /**
  * A stat that calculates the per tick average of a value.
  * @sa Stat, ScalarBase, AvgStor
@@ -2025,6 +2056,34 @@ class Vector : public VectorBase<Vector, StatStor>
     }
 };
 
+/**
+ * A vector of scalar counters that can be updated concurrently by
+ * several simulation threads.
+ * @sa Stat, VectorBase, ShardedStor
+ */
+class ShardedVector : public VectorBase<ShardedVector, ShardedStor>
+{
+  public:
+    ShardedVector(Group *parent = nullptr)
+        : VectorBase<ShardedVector, ShardedStor>(
+            parent, nullptr, UNIT_UNSPECIFIED, nullptr)
+    {
+    }
+
+    ShardedVector(Group *parent, const char *name,
+                  const char *desc = nullptr)
+        : VectorBase<ShardedVector, ShardedStor>(
+            parent, name, UNIT_UNSPECIFIED, desc)
+    {
+    }
+
+    ShardedVector(Group *parent, const char *name, const Units::Base *unit,
+                  const char *desc = nullptr)
+        : VectorBase<ShardedVector, ShardedStor>(parent, name, unit, desc)
+    {
+    }
+};
+
 /**
  * A vector of Average stats.
  * @sa Stat, VectorBase, AvgStor
@@ -2529,6 +2588,137 @@ class SparseHistogram : public SparseHistBase<SparseHistogram, SparseHistStor>
     }
 };
 
+/**
+ * A streaming estimate of the quantiles of a sampled value, e.g., the
+ * tail latency of memory accesses. The stat is reported as a vector
+ * holding the number of samples, their mean and maximum, and then an
+ * estimate of each of the requested quantiles.
+ * @sa QuantileStor
+ */
+class Quantiles : public DataWrapVec<Quantiles, VectorInfoProxy>
+{
+  public:
+    typedef QuantileStor Storage;
+    typedef QuantileStor::Params Params;
+
+  protected:
+    /** The storage of this stat. */
+    M5_ALIGNED(8) char storage[sizeof(Storage)];
+    /** The number of entries reported. */
+    size_type _size;
+
+    /** Entries reported before the quantiles. */
+    enum { Samples, Mean, Max, NumFixed };
+
+    Storage *data() { return reinterpret_cast<Storage *>(storage); }
+
+    const Storage *
+    data() const
+    {
+        return reinterpret_cast<const Storage *>(storage);
+    }
+
+    const Params *
+    params() const
+    {
+        return safe_cast<const Params *>(this->info()->storageParams);
+    }
+
+  public:
+    Quantiles(Group *parent = nullptr)
+        : DataWrapVec<Quantiles, VectorInfoProxy>(parent, nullptr,
+            UNIT_UNSPECIFIED, nullptr),
+          _size(0)
+    {
+    }
+
+    Quantiles(Group *parent, const char *name, const char *desc = nullptr)
+        : DataWrapVec<Quantiles, VectorInfoProxy>(parent, name,
+            UNIT_UNSPECIFIED, desc),
+          _size(0)
+    {
+    }
+
+    Quantiles(Group *parent, const char *name, const Units::Base *unit,
+              const char *desc = nullptr)
+        : DataWrapVec<Quantiles, VectorInfoProxy>(parent, name, unit, desc),
+          _size(0)
+    {
+    }
+
+    /**
+     * Set the parameters of this stat. @sa QuantileStor::Params
+     * @param quantiles The quantiles to report, between 0 and 1.
+     * @param accuracy The relative accuracy of the estimates.
+     * @return A reference to this stat.
+     */
+    Quantiles &
+    init(const std::vector<double> &quantiles, double accuracy = 0.01)
+    {
+        assert(!_size && "already initialized");
+        this->setParams(new Params(accuracy, quantiles));
+        new (storage) Storage(this->info());
+        _size = NumFixed + quantiles.size();
+
+        this->subname(Samples, "samples");
+        this->subname(Mean, "mean");
+        this->subname(Max, "max");
+        for (off_type i = 0; i < quantiles.size(); ++i)
+            this->subname(NumFixed + i, csprintf("p%g", quantiles[i] * 100));
+
+        this->setInit();
+        return this->self();
+    }
+
+    /**
+     * Add a value to the estimate n times.
+     * @param v The value to add.
+     * @param n The number of times to add it, defaults to 1.
+     */
+    template <typename U>
+    void sample(const U &v, int n = 1) { data()->sample(v, n); }
+
+    void
+    value(VCounter &vec) const
+    {
+        vec.resize(size());
+        vec[Samples] = data()->numSamples();
+        vec[Mean] = data()->mean();
+        vec[Max] = data()->max();
+
+        const auto &quantiles = params()->quantiles;
+        for (off_type i = 0; i < quantiles.size(); ++i)
+            vec[NumFixed + i] = data()->quantile(quantiles[i]);
+    }
+
+    void
+    result(VResult &vec) const
+    {
+        VCounter cvec;
+        value(cvec);
+        vec.assign(cvec.begin(), cvec.end());
+    }
+
+    /**
+     * The entries of this stat can't be summed, the total is the
+     * number of samples.
+     */
+    Result total() const { return data()->numSamples(); }
+
+    /**
+     * @return the number of entries reported.
+     */
+    size_type size() const { return _size; }
+
+    bool zero() const { return data()->zero(); }
+
+    bool check() const { return _size != 0; }
+
+    void prepare() { }
+
+    void reset() { data()->reset(this->info()); }
+};
+
 class Temp;
 /**
  * A formula for statistics that is calculated when printed. A formula is
@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/columnar.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/stats/info.hh"
+#include "base/stats/units.hh"
+#include "sim/cur_tick.hh"
+
+namespace Stats {
+
+namespace
+{
+
+/**
+ * Name of the i-th entry of a vector stat, falling back to its index
+ * if it doesn't have a subname.
+ */
+std::string
+subname(const std::vector<std::string> &names, size_t i)
+{
+    if (i < names.size() && !names[i].empty())
+        return names[i];
+    return std::to_string(i);
+}
+
+/** Description of the i-th entry of a vector stat, if it has one. */
+const std::string &
+subdesc(const std::vector<std::string> &descs, size_t i,
+        const std::string &desc)
+{
+    if (i < descs.size() && !descs[i].empty())
+        return descs[i];
+    return desc;
+}
+
+/** Compare the bits of two values so NaNs don't always look changed. */
+bool
+sameValue(Result a, Result b)
+{
+    return std::memcmp(&a, &b, sizeof(Result)) == 0;
+}
+
+} // anonymous namespace
+
+constexpr char Columnar::magic[8];
+constexpr uint32_t Columnar::version;
+constexpr uint32_t Columnar::byteOrderMarker;
+
+Columnar::Columnar(const std::string &file, bool desc, bool formulas,
+                   bool delta)
+    : enableDescriptions(desc), enableFormula(formulas), enableDelta(delta),
+      stream(simout.create(file, true, true)->stream()),
+      layoutPos(0), rebuild(false)
+{
+    if (!valid())
+        fatal("Unable to open statistics file '%s' for writing\n", file);
+
+    stream->write(magic, sizeof(magic));
+    stream->write(reinterpret_cast<const char *>(&version), sizeof(version));
+    stream->write(reinterpret_cast<const char *>(&byteOrderMarker),
+                  sizeof(byteOrderMarker));
+}
+
+void
+Columnar::begin()
+{
+    prefix.clear();
+    layoutPos = 0;
+    rebuild = false;
+    values.clear();
+}
+
+void
+Columnar::end()
+{
+    // Stats that were dumped last time but weren't visited this time
+    // change the schema as well.
+    if (!rebuild && layoutPos != layout.size()) {
+        rebuild = true;
+        layout.resize(layoutPos);
+        columns.resize(values.size());
+    }
+
+    assert(columns.size() == values.size());
+
+    if (rebuild) {
+        put<uint64_t>(columns.size());
+        for (const auto &column : columns) {
+            putString(column.name);
+            putString(column.unit);
+            putString(column.desc);
+        }
+        writeRecord(Schema);
+    }
+
+    std::vector<uint32_t> changed;
+    bool full = !enableDelta || rebuild || previous.size() != values.size();
+    if (!full) {
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            if (!sameValue(values[i], previous[i]))
+                changed.push_back(i);
+        }
+        // A delta costs an index and a value per changed column.
+        full = changed.size() * (sizeof(uint32_t) + sizeof(Result)) >=
+            values.size() * sizeof(Result);
+    }
+
+    put<uint64_t>(curTick());
+    if (full) {
+        for (auto value : values)
+            put(value);
+        writeRecord(Dump);
+    } else {
+        put<uint64_t>(changed.size());
+        for (auto i : changed)
+            put(i);
+        for (auto i : changed)
+            put(values[i]);
+        writeRecord(Delta);
+    }
+
+    stream->flush();
+    values.swap(previous);
+}
+
+bool
+Columnar::valid() const
+{
+    return stream != nullptr && stream->good();
+}
+
+void
+Columnar::beginGroup(const char *name)
+{
+    prefixLength.push(prefix.size());
+    prefix.append(name);
+    prefix.push_back('.');
+}
+
+void
+Columnar::endGroup()
+{
+    assert(!prefixLength.empty());
+    prefix.resize(prefixLength.top());
+    prefixLength.pop();
+}
+
+bool
+Columnar::noOutput(const Info &info) const
+{
+    return !info.flags.isSet(display);
+}
+
+bool
+Columnar::beginStat(const Info &info, size_t count)
+{
+    if (!rebuild) {
+        if (layoutPos < layout.size() && layout[layoutPos].info == &info &&
+            layout[layoutPos].columns == count) {
+            ++layoutPos;
+            return false;
+        }
+
+        // The schema diverges from here on, keep the columns of the
+        // stats that still match and describe the rest.
+        rebuild = true;
+        layout.resize(layoutPos);
+        columns.resize(values.size());
+    }
+
+    layout.push_back({ &info, count });
+    ++layoutPos;
+    return true;
+}
+
+void
+Columnar::addColumn(const Info &info, const std::string &name,
+                    const std::string &desc)
+{
+    columns.push_back({ prefix + name, info.unit->getUnitString(),
+                        enableDescriptions ? desc : "" });
+}
+
+void
+Columnar::visit(const ScalarInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    if (beginStat(info, 1))
+        addColumn(info, info.name, info.desc);
+
+    values.push_back(info.result());
+}
+
+void
+Columnar::visit(const VectorInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const VResult &vr = info.result();
+    if (beginStat(info, vr.size())) {
+        for (size_t i = 0; i < vr.size(); ++i) {
+            addColumn(info,
+                      info.name + info.separatorString +
+                          subname(info.subnames, i),
+                      subdesc(info.subdescs, i, info.desc));
+        }
+    }
+
+    values.insert(values.end(), vr.begin(), vr.end());
+}
+
+size_t
+Columnar::distColumns(const DistData &data)
+{
+    // samples, sum and squares are always present
+    size_t count = 3 + data.cvec.size();
+    if (data.type == Hist)
+        count += 1;
+    if (data.type == Dist)
+        count += 2;
+    return count;
+}
+
+void
+Columnar::addDistColumns(const Info &info, const DistData &data,
+                         const std::string &base, const std::string &desc)
+{
+    const std::string name = base + info.separatorString;
+
+    addColumn(info, name + "samples", desc);
+    addColumn(info, name + "sum", desc);
+    addColumn(info, name + "squares", desc);
+    if (data.type == Hist)
+        addColumn(info, name + "logs", desc);
+    if (data.type == Dist) {
+        addColumn(info, name + "underflows", desc);
+        addColumn(info, name + "overflows", desc);
+    }
+
+    for (size_t i = 0; i < data.cvec.size(); ++i) {
+        Counter low = i * data.bucket_size + data.min;
+        Counter high = std::min(low + data.bucket_size - 1.0, data.max);
+        addColumn(info,
+                  low < high ? csprintf("%s%s-%s", name, low, high) :
+                               csprintf("%s%s", name, low),
+                  desc);
+    }
+}
+
+void
+Columnar::appendDist(const DistData &data)
+{
+    values.push_back(data.samples);
+    values.push_back(data.sum);
+    values.push_back(data.squares);
+    if (data.type == Hist)
+        values.push_back(data.logs);
+    if (data.type == Dist) {
+        values.push_back(data.underflow);
+        values.push_back(data.overflow);
+    }
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Columnar::visit(const DistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    if (beginStat(info, distColumns(info.data)))
+        addDistColumns(info, info.data, info.name, info.desc);
+
+    appendDist(info.data);
+}
+
+void
+Columnar::visit(const VectorDistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    size_t count = 0;
+    for (const auto &data : info.data)
+        count += distColumns(data);
+
+    if (beginStat(info, count)) {
+        for (size_t i = 0; i < info.data.size(); ++i) {
+            addDistColumns(info, info.data[i],
+                           info.name + "_" + subname(info.subnames, i),
+                           subdesc(info.subdescs, i, info.desc));
+        }
+    }
+
+    for (const auto &data : info.data)
+        appendDist(data);
+}
+
+void
+Columnar::visit(const Vector2dInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    if (beginStat(info, info.cvec.size())) {
+        for (size_t i = 0; i < info.x; ++i) {
+            const std::string base = info.name + "_" +
+                subname(info.subnames, i) + info.separatorString;
+            for (size_t j = 0; j < info.y; ++j) {
+                addColumn(info, base + subname(info.y_subnames, j),
+                          subdesc(info.subdescs, i, info.desc));
+            }
+        }
+    }
+
+    values.insert(values.end(), info.cvec.begin(), info.cvec.end());
+}
+
+void
+Columnar::visit(const FormulaInfo &info)
+{
+    if (!enableFormula)
+        return;
+
+    visit(static_cast<const VectorInfo &>(info));
+}
+
+void
+Columnar::visit(const SparseHistInfo &info)
+{
+    warn_once("Columnar stat files don't support sparse histograms.\n");
+}
+
+void
+Columnar::putString(const std::string &str)
+{
+    put<uint32_t>(str.size());
+    record.insert(record.end(), str.begin(), str.end());
+}
+
+void
+Columnar::writeRecord(RecordType type)
+{
+    const uint32_t record_type = type;
+    const uint64_t size = record.size();
+
+    stream->write(reinterpret_cast<const char *>(&record_type),
+                  sizeof(record_type));
+    stream->write(reinterpret_cast<const char *>(&size), sizeof(size));
+    stream->write(record.data(), record.size());
+    record.clear();
+}
+
+std::unique_ptr<Output>
+initColumnar(const std::string &filename, bool desc, bool formulas,
+             bool delta)
+{
+    return std::unique_ptr<Output>(
+        new Columnar(filename, desc, formulas, delta));
+}
+
+} // namespace Stats
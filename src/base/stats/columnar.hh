@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_COLUMNAR_HH__
+#define __BASE_STATS_COLUMNAR_HH__
+
+#include <cstdint>
+#include <memory>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace Stats {
+
+class Info;
+struct DistData;
+
+/**
+ * Append-only binary stat file with one column per stat value.
+ *
+ * The file starts with an 8 byte magic string ("gem5cols") followed
+ * by a 32-bit format version and a 32-bit byte order marker
+ * (0x01020304 written in the host's byte order). The rest of the file
+ * is a sequence of records, each made of a 32-bit record type, a
+ * 64-bit payload size in bytes and the payload:
+ *
+ *   - Schema: the number of columns (64-bit) followed by the name,
+ *     unit and description of each column. Strings are stored as a
+ *     32-bit length followed by the characters.
+ *   - Dump: the tick of the dump (64-bit) followed by one double per
+ *     column of the latest schema.
+ *   - Delta: the tick of the dump (64-bit), the number of columns
+ *     that changed since the previous dump (64-bit), their 32-bit
+ *     indices and then their values as doubles.
+ *
+ * The schema is only written by the first dump and again whenever the
+ * set of dumped stats changes (e.g., a dump of a subset of the stat
+ * tree), so periodic dumps only write values. Delta records are used
+ * when they are smaller than the corresponding full dump.
+ *
+ * Distributions are stored as their raw accumulators (samples, sum,
+ * squares, logs, underflows, overflows and buckets) so derived values
+ * can be computed exactly by the reader. Stat prerequisites are
+ * ignored to keep the set of columns stable across dumps, and sparse
+ * histograms are not supported since their size changes as they
+ * sample.
+ *
+ * The file can be loaded with the m5.stats.columnar Python module.
+ */
+class Columnar : public Output
+{
+  public:
+    /** Record types. */
+    enum RecordType : uint32_t
+    {
+        Schema = 1,
+        Dump = 2,
+        Delta = 3,
+    };
+
+    static constexpr char magic[8] = {'g', 'e', 'm', '5', 'c', 'o', 'l', 's'};
+    static constexpr uint32_t version = 1;
+    static constexpr uint32_t byteOrderMarker = 0x01020304;
+
+    Columnar(const std::string &file, bool desc, bool formulas, bool delta);
+
+    Columnar() = delete;
+    Columnar(const Columnar &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    struct Column
+    {
+        std::string name;
+        std::string unit;
+        std::string desc;
+    };
+
+    /** A stat visited by a dump and the number of columns it uses. */
+    struct LayoutEntry
+    {
+        const Info *info;
+        size_t columns;
+    };
+
+    /** Is the stat hidden from stat dumps? */
+    bool noOutput(const Info &info) const;
+
+    /**
+     * Account for a stat in the layout of the current dump.
+     *
+     * @param info Stat being visited.
+     * @param columns Number of values the stat contributes.
+     * @return true if the caller needs to describe the stat's columns
+     * with addColumn() because the schema changed.
+     */
+    bool beginStat(const Info &info, size_t columns);
+
+    /**
+     * Add a column to the schema being rebuilt.
+     *
+     * @param info Stat the column belongs to.
+     * @param name Column name relative to the current group.
+     * @param desc Column description.
+     */
+    void addColumn(const Info &info, const std::string &name,
+                   const std::string &desc);
+
+    /** Number of columns used to store a distribution. */
+    static size_t distColumns(const DistData &data);
+    /** Describe the columns of a distribution named base. */
+    void addDistColumns(const Info &info, const DistData &data,
+                        const std::string &base, const std::string &desc);
+    /** Append the values of a distribution to the current dump. */
+    void appendDist(const DistData &data);
+
+    /** Append a record to the file. */
+    void writeRecord(RecordType type);
+
+    template <typename T>
+    void
+    put(const T &value)
+    {
+        const char *bytes = reinterpret_cast<const char *>(&value);
+        record.insert(record.end(), bytes, bytes + sizeof(T));
+    }
+
+    void putString(const std::string &str);
+
+  protected:
+    const bool enableDescriptions;
+    const bool enableFormula;
+    const bool enableDelta;
+
+    std::ostream *stream;
+
+    /** Dotted name of the current group, including the final dot. */
+    std::string prefix;
+    std::stack<size_t> prefixLength;
+
+    /** Stats of the latest schema, in dump order. */
+    std::vector<LayoutEntry> layout;
+    /** Columns of the latest schema. */
+    std::vector<Column> columns;
+    /** Position in the layout of the dump in progress. */
+    size_t layoutPos;
+    /** Has the schema changed during the dump in progress? */
+    bool rebuild;
+
+    /** Values of the dump in progress and of the previous dump. */
+    std::vector<Result> values;
+    std::vector<Result> previous;
+
+    /** Payload of the record being written. */
+    std::vector<char> record;
+};
+
+std::unique_ptr<Output> initColumnar(
+    const std::string &filename, bool desc = true, bool formulas = true,
+    bool delta = true);
+
+} // namespace Stats
+
+#endif // __BASE_STATS_COLUMNAR_HH__
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/flat_tree.hh"
+
+#include "base/stats/group.hh"
+#include "base/stats/info.hh"
+#include "base/stats/output.hh"
+
+namespace Stats {
+
+FlatTree::FlatTree(const Group &root)
+{
+    flatten(root);
+}
+
+void
+FlatTree::flatten(const Group &group)
+{
+    for (auto *info : group.getStats()) {
+        entries.push_back({ info, nullptr });
+        stats.push_back(info);
+    }
+
+    for (const auto &g : group.getStatGroups()) {
+        // The group names are owned by the map in the parent group,
+        // which isn't modified once stats have been enabled.
+        entries.push_back({ nullptr, g.first.c_str() });
+        flatten(*g.second);
+        entries.push_back({ nullptr, nullptr });
+    }
+}
+
+void
+FlatTree::visit(Output &output) const
+{
+    for (const auto &entry : entries) {
+        if (entry.info)
+            entry.info->visit(output);
+        else if (entry.group)
+            output.beginGroup(entry.group);
+        else
+            output.endGroup();
+    }
+}
+
+void
+FlatTree::prepare() const
+{
+    for (auto *info : stats)
+        info->prepare();
+}
+
+} // namespace Stats
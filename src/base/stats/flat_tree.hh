@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_FLAT_TREE_HH__
+#define __BASE_STATS_FLAT_TREE_HH__
+
+#include <vector>
+
+namespace Stats {
+
+class Group;
+class Info;
+struct Output;
+
+/**
+ * Flattened view of a stat group hierarchy.
+ *
+ * Dumping stats by walking the Group tree means a map traversal per
+ * group and, when driven from Python, a round-trip per group and
+ * stat. Since the hierarchy can't change once stats have been
+ * enabled, the walk can be recorded once as a linear sequence of
+ * group entries, stats and group exits, and then replayed for every
+ * dump.
+ *
+ * The stats and groups are visited in the same order as a recursive
+ * walk of the tree: the stats of a group first, and then its
+ * sub-groups sorted by name.
+ */
+class FlatTree
+{
+  public:
+    /**
+     * Record the hierarchy below a group.
+     *
+     * @param root Group to flatten. Its own name isn't included in the
+     * tree, it is up to the caller to enter the group first if needed.
+     */
+    FlatTree(const Group &root);
+
+    /** Visit all stats of the tree with a stat output. */
+    void visit(Output &output) const;
+
+    /** Prepare all stats of the tree for dumping. */
+    void prepare() const;
+
+  private:
+    void flatten(const Group &group);
+
+    /** An entry in the flattened hierarchy. */
+    struct Entry
+    {
+        /** Stat to visit, or nullptr for group boundaries */
+        Info *info;
+        /** Name of the group entered, or nullptr when leaving a group */
+        const char *group;
+    };
+
+    std::vector<Entry> entries;
+
+    /** All the stats in the tree, for operations that ignore groups */
+    std::vector<Info *> stats;
+};
+
+} // namespace Stats
+
+#endif // __BASE_STATS_FLAT_TREE_HH__
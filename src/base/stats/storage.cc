@@ -41,10 +41,94 @@
 
 #include "base/stats/storage.hh"
 
+#include <algorithm>
 #include <cmath>
+#include <mutex>
+#include <vector>
 
 namespace Stats {
 
+namespace ThreadShards
+{
+
+__thread Counter *localSlots = nullptr;
+__thread size_t localSize = 0;
+
+namespace
+{
+
+/** Protects the shard list, the slot count and the shards' sizes */
+std::mutex &
+shardMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+/** Slots of all the threads that updated a sharded counter */
+std::vector<std::vector<Counter> *> &
+shards()
+{
+    static std::vector<std::vector<Counter> *> list;
+    return list;
+}
+
+/** Number of slots allocated so far */
+size_t numSlots = 0;
+
+/** The calling thread's shard, owned by the shard list */
+__thread std::vector<Counter> *localShard = nullptr;
+
+} // anonymous namespace
+
+size_t
+allocate()
+{
+    std::lock_guard<std::mutex> lock(shardMutex());
+    return numSlots++;
+}
+
+Counter *
+grow(size_t slot)
+{
+    std::lock_guard<std::mutex> lock(shardMutex());
+    if (!localShard) {
+        localShard = new std::vector<Counter>();
+        shards().push_back(localShard);
+    }
+
+    // Stats are normally all created before the threads start, so
+    // this only happens once per thread.
+    localShard->resize(std::max(numSlots, slot + 1), Counter());
+    localSlots = localShard->data();
+    localSize = localShard->size();
+    return localSlots;
+}
+
+Counter
+sum(size_t slot)
+{
+    std::lock_guard<std::mutex> lock(shardMutex());
+    Counter total = Counter();
+    for (const auto *shard : shards()) {
+        if (slot < shard->size())
+            total += (*shard)[slot];
+    }
+    return total;
+}
+
+void
+clear(size_t slot)
+{
+    std::lock_guard<std::mutex> lock(shardMutex());
+    for (auto *shard : shards()) {
+        if (slot < shard->size())
+            (*shard)[slot] = Counter();
+    }
+}
+
+} // namespace ThreadShards
+
 void
 DistStor::sample(Counter val, int number)
 {
@@ -222,4 +306,58 @@ HistStor::add(HistStor *hs)
         cvec[i] += hs->cvec[i];
 }
 
+void
+QuantileStor::sample(Counter val, int number)
+{
+    samples += number;
+    sum += val * number;
+    min_val = std::min(min_val, val);
+    max_val = std::max(max_val, val);
+
+    if (val <= 0) {
+        zeroCount += number;
+        return;
+    }
+
+    const int64_t key = std::ceil(std::log(val) / logGamma);
+    if (cvec.empty()) {
+        minKey = key;
+        cvec.resize(1, Counter());
+    } else if (key < minKey) {
+        cvec.insert(cvec.begin(), minKey - key, Counter());
+        minKey = key;
+    } else if (key - minKey >= (int64_t)cvec.size()) {
+        cvec.resize(key - minKey + 1, Counter());
+    }
+
+    cvec[key - minKey] += number;
+}
+
+Counter
+QuantileStor::quantile(double q) const
+{
+    if (samples == Counter())
+        return NAN;
+
+    // Find the bucket holding the sample of rank q * (samples - 1)
+    const Counter rank = q * (samples - 1);
+    Counter count = zeroCount;
+    if (count > rank)
+        return min_val;
+
+    for (size_type i = 0; i < cvec.size(); ++i) {
+        count += cvec[i];
+        if (count > rank) {
+            // The middle of the bucket in relative terms:
+            // 2 * gamma^k / (gamma + 1)
+            const double gamma = std::exp(logGamma);
+            const Counter estimate =
+                2 * std::exp((minKey + (int64_t)i) * logGamma) / (gamma + 1);
+            return std::min(std::max(estimate, min_val), max_val);
+        }
+    }
+
+    return max_val;
+}
+
 } // namespace Stats
@@ -32,8 +32,13 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
 
 #include "base/cast.hh"
+#include "base/compiler.hh"
 #include "base/logging.hh"
 #include "base/stats/info.hh"
 #include "base/stats/types.hh"
@@ -212,6 +217,123 @@ class AvgStor
 
 };
 
+/**
+ * Per-thread copies of the counters of sharded stats.
+ *
+ * Each sharded counter is given a slot when it is created. Every
+ * thread that updates a sharded counter gets its own array of slots,
+ * allocated on its first update, so threads never write to the same
+ * memory and no atomics or locks are needed on the update path. The
+ * value of a counter is the sum of its slot over all the threads.
+ *
+ * Reading, setting and resetting a counter touches the slots of all
+ * threads, so it must only be done while the other threads aren't
+ * updating it, e.g., when stats are dumped or reset at a global
+ * synchronization point.
+ */
+namespace ThreadShards
+{
+
+/** Slots of the calling thread */
+extern __thread Counter *localSlots;
+/** Number of slots allocated for the calling thread */
+extern __thread size_t localSize;
+
+/** Allocate a new slot in every thread. */
+size_t allocate();
+
+/** Make room for a slot in the calling thread's array. */
+Counter *grow(size_t slot);
+
+/** Get the calling thread's copy of a counter. */
+inline Counter &
+local(size_t slot)
+{
+    Counter *slots = localSlots;
+    if (M5_UNLIKELY(slot >= localSize))
+        slots = grow(slot);
+    return slots[slot];
+}
+
+/** Sum of a counter over all threads. */
+Counter sum(size_t slot);
+
+/** Set a counter to zero in all threads. */
+void clear(size_t slot);
+
+} // namespace ThreadShards
+
+/**
+ * Storage for a scalar stat updated from several threads, e.g., by
+ * objects in different event queues of a parallel simulation.
+ *
+ * Updates go to a copy of the counter private to the updating thread
+ * (see ThreadShards). The copies are merged when the stat is read.
+ */
+class ShardedStor
+{
+  private:
+    /** The slot of this stat in the thread shards. */
+    const size_t slot;
+
+  public:
+    struct Params : public StorageParams {};
+
+    ShardedStor(Info *info)
+        : slot(ThreadShards::allocate())
+    { }
+
+    /**
+     * The the stat to the given value.
+     * @param val The new value.
+     */
+    void
+    set(Counter val)
+    {
+        ThreadShards::clear(slot);
+        ThreadShards::local(slot) = val;
+    }
+
+    /**
+     * Increment the stat by the given value.
+     * @param val The new value.
+     */
+    void inc(Counter val) { ThreadShards::local(slot) += val; }
+
+    /**
+     * Decrement the stat by the given value.
+     * @param val The new value.
+     */
+    void dec(Counter val) { ThreadShards::local(slot) -= val; }
+
+    /**
+     * Return the value of this stat as its base type.
+     * @return The value of this stat.
+     */
+    Counter value() const { return ThreadShards::sum(slot); }
+
+    /**
+     * Return the value of this stat as a result type.
+     * @return The value of this stat.
+     */
+    Result result() const { return (Result)value(); }
+
+    /**
+     * Prepare stat data for dumping or serialization
+     */
+    void prepare(Info *info) { }
+
+    /**
+     * Reset stat value to default
+     */
+    void reset(Info *info) { ThreadShards::clear(slot); }
+
+    /**
+     * @return true if zero value
+     */
+    bool zero() const { return value() == Counter(); }
+};
+
 /** The parameters for a distribution stat. */
 struct DistParams : public StorageParams
 {
@@ -778,6 +900,124 @@ class SparseHistStor
     }
 };
 
+/**
+ * Storage for a streaming quantile estimate (a DDSketch). Samples are
+ * counted in buckets whose bounds grow geometrically, so any quantile
+ * can be estimated with a bounded relative error regardless of the
+ * range of the samples, and sampling costs a logarithm and an
+ * increment.
+ *
+ * A sample v > 0 is counted in bucket k = ceil(log(v) / log(gamma)),
+ * where gamma = (1 + a) / (1 - a) for a relative accuracy a. The
+ * value reported for a bucket is within a relative error a of all
+ * the values it counts. Samples that aren't positive are counted
+ * separately and reported as the smallest sample.
+ */
+class QuantileStor
+{
+  private:
+    /** Logarithm of the ratio between consecutive bucket bounds. */
+    double logGamma;
+    /** Key of the first bucket in cvec. */
+    int64_t minKey;
+    /** Counter for each bucket, starting at minKey. */
+    VCounter cvec;
+    /** Number of samples that aren't positive. */
+    Counter zeroCount;
+
+    /** The smallest value sampled. */
+    Counter min_val;
+    /** The largest value sampled. */
+    Counter max_val;
+    /** The current sum. */
+    Counter sum;
+    /** The number of samples. */
+    Counter samples;
+
+  public:
+    /** The parameters for a quantile stat. */
+    struct Params : public StorageParams
+    {
+        /** Relative accuracy of the estimates. */
+        double accuracy;
+        /** Quantiles to report, between 0 and 1. */
+        std::vector<double> quantiles;
+
+        Params(double _accuracy, const std::vector<double> &_quantiles)
+          : accuracy(_accuracy), quantiles(_quantiles)
+        {
+            fatal_if(accuracy <= 0 || accuracy >= 1,
+                "The accuracy of a quantile stat must be in (0, 1)");
+            for (auto q : quantiles) {
+                fatal_if(q < 0 || q > 1,
+                    "Quantile %f isn't between 0 and 1", q);
+            }
+        }
+    };
+
+    QuantileStor(Info *info)
+    {
+        const Params *params = safe_cast<const Params *>(info->storageParams);
+        logGamma = std::log((1 + params->accuracy) / (1 - params->accuracy));
+        reset(info);
+    }
+
+    /**
+     * Add a value to the sketch for the given number of times.
+     * @param val The value to add.
+     * @param number The number of times to add the value.
+     */
+    void sample(Counter val, int number);
+
+    /**
+     * Estimate a quantile of the sampled values.
+     * @param q The quantile, between 0 and 1.
+     * @return The estimate, or NaN if nothing has been sampled.
+     */
+    Counter quantile(double q) const;
+
+    /** @return The number of samples. */
+    Counter numSamples() const { return samples; }
+
+    /** @return The mean of the samples, or NaN without samples. */
+    Counter mean() const { return samples ? sum / samples : NAN; }
+
+    /** @return The largest sample, or NaN without samples. */
+    Counter max() const { return samples ? max_val : NAN; }
+
+    /**
+     * Return the number of buckets in use.
+     * @return the number of buckets.
+     */
+    size_type size() const { return cvec.size(); }
+
+    /**
+     * Returns true if any calls to sample have been made.
+     * @return True if any values have been sampled.
+     */
+    bool
+    zero() const
+    {
+        return samples == Counter();
+    }
+
+    /**
+     * Reset stat value to default
+     */
+    void
+    reset(Info *info)
+    {
+        minKey = 0;
+        cvec.clear();
+        zeroCount = Counter();
+        min_val = std::numeric_limits<Counter>::max();
+        max_val = std::numeric_limits<Counter>::lowest();
+        sum = Counter();
+        samples = Counter();
+    }
+};
+
+
 } // namespace Stats
 
 #endif // __BASE_STATS_STORAGE_HH__
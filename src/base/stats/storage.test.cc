@@ -30,6 +30,8 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <thread>
+#include <vector>
 
 #include "base/gtest/cur_tick_fake.hh"
 #include "base/stats/storage.hh"
@@ -148,6 +150,91 @@ TEST(StatsStatStorTest, ZeroReset)
     ASSERT_FALSE(stor.zero());
 }
 
+/** Test setting and getting a value to a sharded storage. */
+TEST(StatsShardedStorTest, SetValueResult)
+{
+    Stats::ShardedStor stor(nullptr);
+    Stats::Counter val;
+
+    val = 10;
+    stor.set(val);
+    ASSERT_EQ(stor.value(), val);
+    ASSERT_EQ(stor.result(), Stats::Result(val));
+
+    val = 1234;
+    stor.set(val);
+    ASSERT_EQ(stor.value(), val);
+    ASSERT_EQ(stor.result(), Stats::Result(val));
+}
+
+/** Test whether incrementing and decrementing a sharded storage works. */
+TEST(StatsShardedStorTest, IncDec)
+{
+    Stats::ShardedStor stor(nullptr);
+    Stats::Counter diff_val = 10;
+    Stats::Counter val = 0;
+
+    stor.inc(diff_val);
+    val += diff_val;
+    ASSERT_EQ(stor.value(), val);
+
+    stor.dec(diff_val);
+    val -= diff_val;
+    ASSERT_EQ(stor.value(), val);
+}
+
+/** Test whether zero is correctly set as the reset value. */
+TEST(StatsShardedStorTest, ZeroReset)
+{
+    Stats::ShardedStor stor(nullptr);
+
+    ASSERT_TRUE(stor.zero());
+
+    stor.inc(10);
+    ASSERT_FALSE(stor.zero());
+
+    stor.reset(nullptr);
+    ASSERT_TRUE(stor.zero());
+}
+
+/**
+ * Test that updates from several threads are all accounted for, and
+ * that different storages don't share their counters.
+ */
+TEST(StatsShardedStorTest, Threads)
+{
+    Stats::ShardedStor stor0(nullptr);
+    Stats::ShardedStor stor1(nullptr);
+    const int num_threads = 4;
+    const int num_incs = 1000;
+
+    stor0.inc(1);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < num_incs; i++) {
+                stor0.inc(1);
+                stor1.inc(2);
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    ASSERT_EQ(stor0.value(), num_threads * num_incs + 1);
+    ASSERT_EQ(stor1.value(), 2 * num_threads * num_incs);
+
+    // A reset clears the copies of all threads
+    stor0.reset(nullptr);
+    ASSERT_TRUE(stor0.zero());
+    ASSERT_FALSE(stor1.zero());
+
+    // Setting the value discards the other threads' copies as well
+    stor1.set(5);
+    ASSERT_EQ(stor1.value(), 5);
+}
+
 /** Test setting and getting a value to the storage. */
 TEST(StatsAvgStorTest, SetValueResult)
 {
@@ -1256,3 +1343,79 @@ TEST(StatsSparseHistStorTest, SamplePrepare)
     }
     ASSERT_EQ(data.samples, total_samples);
 }
+
+#if TRACING_ON
+/** Test that the quantile parameters are checked. */
+TEST(StatsQuantileStorDeathTest, BadParams)
+{
+    testing::internal::CaptureStderr();
+    EXPECT_ANY_THROW(Stats::QuantileStor::Params params(0, {0.5}));
+    testing::internal::GetCapturedStderr();
+
+    testing::internal::CaptureStderr();
+    EXPECT_ANY_THROW(Stats::QuantileStor::Params params(1, {0.5}));
+    testing::internal::GetCapturedStderr();
+
+    testing::internal::CaptureStderr();
+    EXPECT_ANY_THROW(Stats::QuantileStor::Params params(0.01, {1.5}));
+    testing::internal::GetCapturedStderr();
+}
+#endif
+
+/** Test whether zero is correctly set as the reset value. */
+TEST(StatsQuantileStorTest, ZeroReset)
+{
+    Stats::QuantileStor::Params params(0.01, {0.5});
+    MockInfo info(&params);
+    Stats::QuantileStor stor(&info);
+
+    ASSERT_TRUE(stor.zero());
+    ASSERT_TRUE(std::isnan(stor.quantile(0.5)));
+    ASSERT_TRUE(std::isnan(stor.mean()));
+
+    stor.sample(10, 1);
+    ASSERT_FALSE(stor.zero());
+
+    stor.reset(&info);
+    ASSERT_TRUE(stor.zero());
+    ASSERT_EQ(stor.size(), 0);
+    ASSERT_TRUE(std::isnan(stor.quantile(0.5)));
+}
+
+/** Test that the estimates are within the requested relative accuracy. */
+TEST(StatsQuantileStorTest, Accuracy)
+{
+    const double accuracy = 0.01;
+    Stats::QuantileStor::Params params(accuracy, {});
+    MockInfo info(&params);
+    Stats::QuantileStor stor(&info);
+
+    // Sample in decreasing order to also grow the buckets downwards
+    const int num_samples = 10000;
+    for (int i = num_samples; i > 0; i--)
+        stor.sample(i, 1);
+
+    ASSERT_EQ(stor.numSamples(), num_samples);
+    ASSERT_EQ(stor.mean(), (num_samples + 1) / 2.0);
+    ASSERT_EQ(stor.max(), num_samples);
+
+    for (double q : {0.0, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+        const double exact = 1 + q * (num_samples - 1);
+        ASSERT_NEAR(stor.quantile(q), exact, exact * accuracy);
+    }
+}
+
+/** Test that samples that aren't positive are accounted for. */
+TEST(StatsQuantileStorTest, NonPositive)
+{
+    Stats::QuantileStor::Params params(0.01, {});
+    MockInfo info(&params);
+    Stats::QuantileStor stor(&info);
+
+    stor.sample(0, 3);
+    stor.sample(100, 1);
+
+    ASSERT_EQ(stor.quantile(0), 0);
+    ASSERT_EQ(stor.quantile(0.5), 0);
+    ASSERT_NEAR(stor.quantile(1), 100, 1);
+}
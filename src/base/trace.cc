@@ -141,6 +141,13 @@ Logger::dump(Tick when, const std::string &name,
     }
 }
 
+void
+Logger::logArgs(Tick when, const std::string &name, const std::string &flag,
+        const char *fmt, const EncodedArgs &args)
+{
+    panic("Logger does not support deferred formatting\n");
+}
+
 void
 OstreamLogger::logMessage(Tick when, const std::string &name,
         const std::string &flag, const std::string &message)
@@ -40,6 +40,7 @@
 #include "base/cprintf.hh"
 #include "base/debug.hh"
 #include "base/match.hh"
+#include "base/trace_args.hh"
 #include "base/types.hh"
 #include "sim/core.hh"
 
@@ -53,6 +54,12 @@ class Logger
     /** Name match for objects to ignore */
     ObjectMatch ignore;
 
+    /**
+     * Set by loggers that want the raw arguments of each message passed
+     * to logArgs instead of the formatted text passed to logMessage.
+     */
+    bool deferFormatting = false;
+
   public:
     /** Log a single message */
     template <typename ...Args>
@@ -70,8 +77,15 @@ class Logger
     {
         if (!name.empty() && ignore.match(name))
             return;
-        std::ostringstream line;
-        ccprintf(line, fmt, args...);
+        if (deferFormatting) {
+            EncodedArgs &encoded = EncodedArgs::local();
+            encoded.clear();
+            encoded.add(args...);
+            logArgs(when, name, flag, fmt, encoded);
+            return;
+        }
+        cp::ScratchStream line;
+        ccprintf(line.stream(), fmt, args...);
         logMessage(when, name, flag, line.str());
     }
 
@@ -83,6 +97,11 @@ class Logger
     virtual void logMessage(Tick when, const std::string &name,
             const std::string &flag, const std::string &message) = 0;
 
+    /** Log a message that still has to be formatted with fmt and args */
+    virtual void logArgs(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const EncodedArgs &args);
+
     /** Return an ostream that can be used to send messages to
      *  the 'same place' as formatted logMessage messages.  This
      *  can be implemented to use a logger's underlying ostream,
@@ -90,6 +109,9 @@ class Logger
      *  way, or just set to one of std::cout, std::cerr */
     virtual std::ostream &getOstream() = 0;
 
+    /** Does this logger take encoded arguments through logArgs? */
+    bool defersFormatting() const { return deferFormatting; }
+
     /** Set objects to ignore */
     void setIgnore(ObjectMatch &ignore_) { ignore = ignore_; }
 
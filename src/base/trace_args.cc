@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/trace_args.hh"
+
+#include "base/cprintf.hh"
+
+namespace Trace {
+
+namespace {
+
+template <typename T>
+T
+read(const uint8_t *&pos)
+{
+    T val;
+    std::memcpy(&val, pos, sizeof(T));
+    pos += sizeof(T);
+    return val;
+}
+
+std::string
+readString(const uint8_t *&pos)
+{
+    const uint32_t len = read<uint32_t>(pos);
+    std::string str(reinterpret_cast<const char *>(pos), len);
+    pos += len;
+    return str;
+}
+
+void
+addSigned(cp::Print &print, int64_t val, size_t size)
+{
+    switch (size) {
+      case 2:
+        print.addArg(static_cast<int16_t>(val));
+        break;
+      case 4:
+        print.addArg(static_cast<int32_t>(val));
+        break;
+      default:
+        print.addArg(val);
+        break;
+    }
+}
+
+void
+addUnsigned(cp::Print &print, uint64_t val, size_t size)
+{
+    switch (size) {
+      case 2:
+        print.addArg(static_cast<uint16_t>(val));
+        break;
+      case 4:
+        print.addArg(static_cast<uint32_t>(val));
+        break;
+      default:
+        print.addArg(val);
+        break;
+    }
+}
+
+} // anonymous namespace
+
+void
+EncodedArgs::format(std::ostream &os, const char *fmt) const
+{
+    cp::Print print(os, fmt);
+
+    const uint8_t *pos = bytes.data();
+    for (int i = 0; i < num; i++) {
+        const Type type = static_cast<Type>(*pos++);
+        const size_t size = *pos++;
+
+        switch (type) {
+          case Signed:
+            addSigned(print, read<int64_t>(pos), size);
+            break;
+          case Unsigned:
+            addUnsigned(print, read<uint64_t>(pos), size);
+            break;
+          case Char: {
+              // The signedness of the original type only matters for
+              // values that don't fit in 7 bits.
+              const int64_t val = read<int64_t>(pos);
+              if (val < 0)
+                  print.addArg(static_cast<signed char>(val));
+              else if (val > 127)
+                  print.addArg(static_cast<unsigned char>(val));
+              else
+                  print.addArg(static_cast<char>(val));
+            }
+            break;
+          case Bool:
+            print.addArg(read<uint64_t>(pos) != 0);
+            break;
+          case Float: {
+              const double val = read<double>(pos);
+              if (size == sizeof(float))
+                  print.addArg(static_cast<float>(val));
+              else
+                  print.addArg(val);
+            }
+            break;
+          case Pointer:
+            print.addArg(reinterpret_cast<const void *>(
+                        static_cast<uintptr_t>(read<uint64_t>(pos))));
+            break;
+          case String:
+            print.addArg(readString(pos));
+            break;
+          case Enum: {
+              // Enums without an operator<< print as integers
+              const int64_t val = read<int64_t>(pos);
+              const std::string str = readString(pos);
+              if (str == std::to_string(val))
+                  addSigned(print, val, size);
+              else
+                  print.addArg(str);
+            }
+            break;
+        }
+    }
+
+    print.endArgs();
+}
+
+} // namespace Trace
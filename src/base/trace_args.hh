@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_TRACE_ARGS_HH__
+#define __BASE_TRACE_ARGS_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Trace {
+
+/**
+ * The arguments of a debug message in a compact, type tagged binary form.
+ * Loggers that defer formatting (see BinaryLogger) get these instead of
+ * the formatted message, so that the expensive cprintf work can be done
+ * offline. Every argument is stored as a type byte, a size byte holding
+ * the sizeof() of the original argument and a payload:
+ *
+ * - Signed, Unsigned, Char, Bool, Pointer: 8 byte integer
+ * - Float: 8 byte double
+ * - String: 4 byte length followed by the characters
+ * - Enum: 8 byte integer, then the value as a String would be stored
+ *
+ * Values are stored in host byte order. Arguments of class type are
+ * converted to text with their operator<< when they are recorded.
+ */
+class EncodedArgs
+{
+  public:
+    enum Type : uint8_t
+    {
+        Signed,
+        Unsigned,
+        Char,
+        Bool,
+        Float,
+        Pointer,
+        String,
+        Enum,
+    };
+
+  private:
+    std::vector<uint8_t> bytes;
+    uint8_t num = 0;
+
+    template <typename T>
+    void
+    append(const T &val)
+    {
+        const uint8_t *p = reinterpret_cast<const uint8_t *>(&val);
+        bytes.insert(bytes.end(), p, p + sizeof(T));
+    }
+
+    void
+    header(Type type, size_t size)
+    {
+        bytes.push_back(type);
+        bytes.push_back(size);
+        num++;
+    }
+
+    void
+    appendString(const char *str, size_t len)
+    {
+        append<uint32_t>(len);
+        bytes.insert(bytes.end(), str, str + len);
+    }
+
+    template <typename T>
+    void
+    putInteger(const T &arg, std::true_type)
+    {
+        header(Signed, sizeof(T));
+        append<int64_t>(arg);
+    }
+
+    template <typename T>
+    void
+    putInteger(const T &arg, std::false_type)
+    {
+        header(Unsigned, sizeof(T));
+        append<uint64_t>(arg);
+    }
+
+    template <typename T>
+    void
+    putEnum(const T &arg)
+    {
+        std::ostringstream str;
+        str << arg;
+        header(Enum, sizeof(T));
+        append<int64_t>(static_cast<int64_t>(arg));
+        appendString(str.str().data(), str.str().size());
+    }
+
+    /** Types that are neither numbers, enums, strings nor pointers */
+    template <typename T>
+    void
+    putObject(const T &arg)
+    {
+        std::ostringstream str;
+        str << arg;
+        put(str.str());
+    }
+
+    template <typename T>
+    void
+    putOther(const T &arg, std::integral_constant<int, 0>)
+    {
+        putInteger(arg, std::is_signed<T>());
+    }
+
+    template <typename T>
+    void
+    putOther(const T &arg, std::integral_constant<int, 1>)
+    {
+        putEnum(arg);
+    }
+
+    template <typename T>
+    void
+    putOther(const T &arg, std::integral_constant<int, 2>)
+    {
+        header(Float, sizeof(T));
+        append<double>(arg);
+    }
+
+    template <typename T>
+    void
+    putOther(const T &arg, std::integral_constant<int, 3>)
+    {
+        header(Pointer, sizeof(T));
+        append<uint64_t>(reinterpret_cast<uintptr_t>(arg));
+    }
+
+    template <typename T>
+    void
+    putOther(const T &arg, std::integral_constant<int, 4>)
+    {
+        putObject(arg);
+    }
+
+    template <typename T>
+    using Kind = std::integral_constant<int,
+          std::is_integral<T>::value ? 0 :
+          std::is_enum<T>::value ? 1 :
+          std::is_floating_point<T>::value ? 2 :
+          std::is_pointer<T>::value ? 3 : 4>;
+
+    void
+    putChar(int val, size_t size)
+    {
+        header(Char, size);
+        append<int64_t>(val);
+    }
+
+    void
+    put(bool arg)
+    {
+        header(Bool, sizeof(arg));
+        append<uint64_t>(arg);
+    }
+
+    void put(char arg) { putChar(arg, sizeof(arg)); }
+    void put(signed char arg) { putChar(arg, sizeof(arg)); }
+    void put(unsigned char arg) { putChar(arg, sizeof(arg)); }
+
+    void
+    put(const char *arg)
+    {
+        header(String, sizeof(arg));
+        appendString(arg, arg ? std::strlen(arg) : 0);
+    }
+
+    void put(char *arg) { put(static_cast<const char *>(arg)); }
+
+    void
+    put(const std::string &arg)
+    {
+        header(String, sizeof(arg));
+        appendString(arg.data(), arg.size());
+    }
+
+    template <typename T>
+    void
+    put(const T &arg)
+    {
+        putOther(arg, Kind<T>());
+    }
+
+  public:
+    /** The arguments of the message currently being logged by a thread */
+    static EncodedArgs &
+    local()
+    {
+        static thread_local EncodedArgs args;
+        return args;
+    }
+
+    void
+    clear()
+    {
+        bytes.clear();
+        num = 0;
+    }
+
+    void add() {}
+
+    template <typename T, typename ...Rest>
+    void
+    add(const T &arg, const Rest &...rest)
+    {
+        put(arg);
+        add(rest...);
+    }
+
+    /** Number of arguments */
+    uint8_t count() const { return num; }
+
+    const uint8_t *data() const { return bytes.data(); }
+    size_t size() const { return bytes.size(); }
+
+    /** Format the arguments with cprintf, as the original message was */
+    void format(std::ostream &os, const char *fmt) const;
+};
+
+} // namespace Trace
+
+#endif // __BASE_TRACE_ARGS_HH__
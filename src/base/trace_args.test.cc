@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "base/cprintf.hh"
+#include "base/trace_args.hh"
+
+using namespace Trace;
+
+namespace {
+
+enum Plain { PlainA, PlainB = 7 };
+
+struct Point { int x, y; };
+
+std::ostream &
+operator<<(std::ostream &os, const Point &p)
+{
+    return os << "(" << p.x << ", " << p.y << ")";
+}
+
+/** Walks over the arguments in an EncodedArgs */
+class Decoder
+{
+  private:
+    const uint8_t *pos;
+
+    template <typename T>
+    T
+    get()
+    {
+        T val;
+        std::memcpy(&val, pos, sizeof(T));
+        pos += sizeof(T);
+        return val;
+    }
+
+  public:
+    Decoder(const EncodedArgs &args) : pos(args.data()) {}
+
+    EncodedArgs::Type type;
+    size_t size;
+
+    void
+    next()
+    {
+        type = static_cast<EncodedArgs::Type>(get<uint8_t>());
+        size = get<uint8_t>();
+    }
+
+    int64_t integer() { return get<int64_t>(); }
+    double floating() { return get<double>(); }
+
+    std::string
+    string()
+    {
+        uint32_t len = get<uint32_t>();
+        std::string str(reinterpret_cast<const char *>(pos), len);
+        pos += len;
+        return str;
+    }
+};
+
+} // anonymous namespace
+
+TEST(EncodedArgs, Empty)
+{
+    EncodedArgs args;
+    args.add();
+    EXPECT_EQ(0, args.count());
+    EXPECT_EQ(0, args.size());
+}
+
+TEST(EncodedArgs, Integers)
+{
+    EncodedArgs args;
+    args.add(-5, (unsigned short)65535, 'a', (unsigned char)200, true,
+             0x123456789abcULL);
+    EXPECT_EQ(6, args.count());
+
+    Decoder dec(args);
+    dec.next();
+    EXPECT_EQ(EncodedArgs::Signed, dec.type);
+    EXPECT_EQ(sizeof(int), dec.size);
+    EXPECT_EQ(-5, dec.integer());
+
+    dec.next();
+    EXPECT_EQ(EncodedArgs::Unsigned, dec.type);
+    EXPECT_EQ(sizeof(short), dec.size);
+    EXPECT_EQ(65535, dec.integer());
+
+    dec.next();
+    EXPECT_EQ(EncodedArgs::Char, dec.type);
+    EXPECT_EQ('a', dec.integer());
+
+    dec.next();
+    EXPECT_EQ(EncodedArgs::Char, dec.type);
+    EXPECT_EQ(200, dec.integer());
+
+    dec.next();
+    EXPECT_EQ(EncodedArgs::Bool, dec.type);
+    EXPECT_EQ(1, dec.integer());
+
+    dec.next();
+    EXPECT_EQ(EncodedArgs::Unsigned, dec.type);
+    EXPECT_EQ(8, dec.size);
+    EXPECT_EQ(0x123456789abcLL, dec.integer());
+}
+
+TEST(EncodedArgs, Strings)
+{
+    const char *cstr = "cstr";
+    char buf[] = "buf";
+    std::string str("string");
+
+    EncodedArgs args;
+    args.add(cstr, buf, str, "literal", (const char *)nullptr);
+    EXPECT_EQ(5, args.count());
+
+    Decoder dec(args);
+    for (auto expected : { "cstr", "buf", "string", "literal", "" }) {
+        dec.next();
+        EXPECT_EQ(EncodedArgs::String, dec.type);
+        EXPECT_EQ(expected, dec.string());
+    }
+}
+
+TEST(EncodedArgs, Others)
+{
+    int x = 0;
+    EncodedArgs args;
+    args.add(2.5, 1.5f, &x, PlainB, Point{3, 4});
+    EXPECT_EQ(5, args.count());
+
+    Decoder dec(args);
+    dec.next();
+    EXPECT_EQ(EncodedArgs::Float, dec.type);
+    EXPECT_EQ(sizeof(double), dec.size);
+    EXPECT_EQ(2.5, dec.floating());
+
+    dec.next();
+    EXPECT_EQ(EncodedArgs::Float, dec.type);
+    EXPECT_EQ(sizeof(float), dec.size);
+    EXPECT_EQ(1.5, dec.floating());
+
+    dec.next();
+    EXPECT_EQ(EncodedArgs::Pointer, dec.type);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&x), dec.integer());
+
+    dec.next();
+    EXPECT_EQ(EncodedArgs::Enum, dec.type);
+    EXPECT_EQ(7, dec.integer());
+    EXPECT_EQ("7", dec.string());
+
+    dec.next();
+    EXPECT_EQ(EncodedArgs::String, dec.type);
+    EXPECT_EQ("(3, 4)", dec.string());
+}
+
+TEST(EncodedArgs, Clear)
+{
+    EncodedArgs args;
+    args.add(1, 2, 3);
+    args.clear();
+    EXPECT_EQ(0, args.count());
+    EXPECT_EQ(0, args.size());
+
+    args.add(4);
+    EXPECT_EQ(1, args.count());
+    Decoder dec(args);
+    dec.next();
+    EXPECT_EQ(4, dec.integer());
+}
+
+#define FORMAT_TEST(...)                                 \
+    do {                                                 \
+        EncodedArgs args;                                \
+        args.add(__VA_ARGS__);                           \
+        std::ostringstream expected, formatted;          \
+        ccprintf(expected, fmt, __VA_ARGS__);            \
+        args.format(formatted, fmt);                     \
+        EXPECT_EQ(expected.str(), formatted.str());      \
+    } while (0)
+
+TEST(EncodedArgs, Format)
+{
+    const char *fmt;
+    int x = 0;
+
+    fmt = "%d %s %x %#x %08x %-6d| %+d\n";
+    FORMAT_TEST(-5, std::string("str"), 255, 0xbeef, -1, 42, 7);
+
+    fmt = "%c %c %d %d %s %d\n";
+    FORMAT_TEST('a', 66, 'c', (unsigned char)200, (unsigned char)200,
+                (signed char)-3);
+
+    fmt = "%f %.2f %e %.3e %g %10.4f %s %d %s\n";
+    FORMAT_TEST(1.5, 3.14159, 12345.678, 0.000123, 1e20, -2.5, 0.1, 2.75,
+                1.25f);
+
+    fmt = "%s %d %x %s %p %#o %hd %x\n";
+    FORMAT_TEST(true, false, PlainB, Point{1, 2}, (void *)&x, 8, (short)-2,
+                (short)-2);
+
+    fmt = "%*d|%d %s\n";
+    FORMAT_TEST(6, 12, 13, "literal");
+
+    fmt = "%d %s\n";
+    FORMAT_TEST(0x123456789abcULL, -0x123456789abcLL);
+}
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/trace_binary.hh"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+
+#include "base/compiler.hh"
+#include "base/logging.hh"
+#include "debug/FmtFlag.hh"
+#include "debug/FmtTicksOff.hh"
+
+namespace Trace {
+
+const char BinaryLogger::Magic[8] = "gem5dbt";
+const uint32_t BinaryLogger::Version;
+const size_t BinaryLogger::MaxQueuedChunks;
+
+namespace {
+
+/**
+ * The loggers that are still alive. Nothing deletes the global debug
+ * logger, so the buffered records are written out by an atexit handler.
+ */
+std::mutex liveLock;
+std::set<BinaryLogger *> live;
+
+void
+flushLive()
+{
+    std::lock_guard<std::mutex> lock(liveLock);
+    for (auto *logger : live)
+        logger->flush();
+}
+
+uint64_t
+nextSerial()
+{
+    static std::atomic<uint64_t> serial(0);
+    return ++serial;
+}
+
+} // anonymous namespace
+
+BinaryLogger::BinaryLogger(std::ostream &_stream, size_t chunk_size)
+    : stream(_stream), chunkSize(chunk_size), serial(nextSerial()),
+      textBuf(*this), textStream(&textBuf)
+{
+    deferFormatting = true;
+
+    stream.write(Magic, sizeof(Magic));
+    stream.write(reinterpret_cast<const char *>(&Version), sizeof(Version));
+
+    writer = std::thread([this]() { writeChunks(); });
+
+    std::lock_guard<std::mutex> lock(liveLock);
+    static bool registered = false;
+    if (!registered) {
+        std::atexit(flushLive);
+        registered = true;
+    }
+    live.insert(this);
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    {
+        std::lock_guard<std::mutex> lock(liveLock);
+        live.erase(this);
+    }
+
+    flush();
+
+    {
+        std::lock_guard<std::mutex> lock(queueLock);
+        stopping = true;
+    }
+    queueCond.notify_all();
+    writer.join();
+}
+
+BinaryLogger::ThreadBuffer &
+BinaryLogger::threadBuffer()
+{
+    static thread_local std::pair<uint64_t, ThreadBuffer *> cached(0,
+                                                                   nullptr);
+    if (M5_LIKELY(cached.first == serial))
+        return *cached.second;
+
+    std::lock_guard<std::mutex> lock(buffersLock);
+    buffers.emplace_back(new ThreadBuffer);
+    buffers.back()->data.reserve(chunkSize);
+    cached = std::make_pair(serial, buffers.back().get());
+    return *cached.second;
+}
+
+uint32_t
+BinaryLogger::defineString(ThreadBuffer &buf, const std::string &str,
+        const std::string **interned)
+{
+    std::lock_guard<std::mutex> lock(stringsLock);
+    auto it = stringIds.find(str);
+    if (it == stringIds.end()) {
+        // Id 0 is reserved for the empty string
+        uint32_t id = stringIds.size() + 1;
+        it = stringIds.emplace(str, id).first;
+
+        buf.put<uint8_t>(DefineString);
+        buf.put<uint32_t>(id);
+        buf.put<uint32_t>(str.size());
+        buf.put(str.data(), str.size());
+    }
+    if (interned)
+        *interned = &it->first;
+    return it->second;
+}
+
+uint32_t
+BinaryLogger::stringId(ThreadBuffer &buf, const std::string &str)
+{
+    if (str.empty())
+        return 0;
+
+    auto it = buf.strings.find(str);
+    if (M5_LIKELY(it != buf.strings.end()))
+        return it->second;
+
+    uint32_t id = defineString(buf, str);
+    buf.strings.emplace(str, id);
+    return id;
+}
+
+uint32_t
+BinaryLogger::formatId(ThreadBuffer &buf, const char *fmt)
+{
+    // Format strings are almost always literals, so they are looked up
+    // by address. The comparison catches the odd format that lives in a
+    // buffer which has been reused for a different string.
+    auto it = buf.formats.find(fmt);
+    if (M5_LIKELY(it != buf.formats.end() &&
+                  std::strcmp(it->second.first->c_str(), fmt) == 0)) {
+        return it->second.second;
+    }
+
+    const std::string *interned;
+    uint32_t id = defineString(buf, fmt, &interned);
+    buf.formats[fmt] = std::make_pair(interned, id);
+    return id;
+}
+
+static uint8_t
+formatBits()
+{
+    uint8_t bits = 0;
+    if (!DTRACE(FmtTicksOff))
+        bits |= BinaryLogger::ShowTick;
+    if (DTRACE(FmtFlag))
+        bits |= BinaryLogger::ShowFlag;
+    return bits;
+}
+
+void
+BinaryLogger::logArgs(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt, const EncodedArgs &args)
+{
+    if (!name.empty() && ignore.match(name))
+        return;
+
+    ThreadBuffer &buf = threadBuffer();
+
+    const uint32_t name_id = stringId(buf, name);
+    const uint32_t flag_id = stringId(buf, flag);
+    const uint32_t fmt_id = formatId(buf, fmt);
+
+    buf.put<uint8_t>(Message);
+    buf.put<uint8_t>(formatBits());
+    buf.put<uint64_t>(when);
+    buf.put<uint32_t>(name_id);
+    buf.put<uint32_t>(flag_id);
+    buf.put<uint32_t>(fmt_id);
+    buf.put<uint8_t>(args.count());
+    buf.put<uint32_t>(args.size());
+    buf.put(args.data(), args.size());
+
+    if (buf.data.size() >= chunkSize)
+        submit(buf);
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!name.empty() && ignore.match(name))
+        return;
+
+    ThreadBuffer &buf = threadBuffer();
+
+    const uint32_t name_id = stringId(buf, name);
+    const uint32_t flag_id = stringId(buf, flag);
+
+    buf.put<uint8_t>(Text);
+    buf.put<uint8_t>(formatBits());
+    buf.put<uint64_t>(when);
+    buf.put<uint32_t>(name_id);
+    buf.put<uint32_t>(flag_id);
+    buf.put<uint32_t>(message.size());
+    buf.put(message.data(), message.size());
+
+    if (buf.data.size() >= chunkSize)
+        submit(buf);
+}
+
+void
+BinaryLogger::submit(ThreadBuffer &buf)
+{
+    if (buf.data.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(queueLock);
+    queueCond.wait(lock, [this]() {
+        return queue.size() < MaxQueuedChunks;
+    });
+
+    queue.push_back(std::move(buf.data));
+    if (spares.empty()) {
+        buf.data = std::vector<uint8_t>();
+        buf.data.reserve(chunkSize);
+    } else {
+        buf.data = std::move(spares.back());
+        spares.pop_back();
+    }
+    lock.unlock();
+    queueCond.notify_all();
+}
+
+void
+BinaryLogger::writeChunks()
+{
+    std::unique_lock<std::mutex> lock(queueLock);
+    while (true) {
+        queueCond.wait(lock, [this]() {
+            return !queue.empty() || stopping;
+        });
+        if (queue.empty())
+            return;
+
+        std::vector<uint8_t> chunk = std::move(queue.front());
+        queue.pop_front();
+        writing = true;
+        lock.unlock();
+
+        stream.write(reinterpret_cast<const char *>(chunk.data()),
+                     chunk.size());
+        chunk.clear();
+
+        lock.lock();
+        writing = false;
+        if (spares.size() < MaxQueuedChunks)
+            spares.push_back(std::move(chunk));
+        queueCond.notify_all();
+    }
+}
+
+void
+BinaryLogger::flush()
+{
+    textStream.flush();
+
+    {
+        std::lock_guard<std::mutex> lock(buffersLock);
+        for (auto &buf : buffers)
+            submit(*buf);
+    }
+
+    std::unique_lock<std::mutex> lock(queueLock);
+    queueCond.wait(lock, [this]() { return queue.empty() && !writing; });
+    stream.flush();
+}
+
+int
+BinaryLogger::TextBuf::overflow(int c)
+{
+    if (c == traits_type::eof())
+        return traits_type::not_eof(c);
+
+    line.push_back(c);
+    if (c == '\n')
+        sync();
+    return c;
+}
+
+std::streamsize
+BinaryLogger::TextBuf::xsputn(const char *s, std::streamsize n)
+{
+    const char *end = s + n;
+    while (s != end) {
+        const char *nl = static_cast<const char *>(
+                std::memchr(s, '\n', end - s));
+        if (!nl) {
+            line.append(s, end);
+            break;
+        }
+        line.append(s, nl + 1);
+        sync();
+        s = nl + 1;
+    }
+    return n;
+}
+
+int
+BinaryLogger::TextBuf::sync()
+{
+    if (!line.empty()) {
+        logger.logMessage(MaxTick, "", "", line);
+        line.clear();
+    }
+    return 0;
+}
+
+} // namespace Trace
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_TRACE_BINARY_HH__
+#define __BASE_TRACE_BINARY_HH__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/trace.hh"
+
+namespace Trace {
+
+/**
+ * Logger that records debug messages in a binary file instead of
+ * formatting them. Every message is stored as its tick, the ids of its
+ * object name, debug flag and format string, and its raw arguments (see
+ * EncodedArgs). Strings are stored once, the first time they are used.
+ * util/decode_debug_trace.py renders the file as the text the
+ * OstreamLogger would have printed.
+ *
+ * Records are appended to a buffer owned by the logging thread. Full
+ * buffers are handed to a writer thread, so the simulation threads never
+ * block on the output stream unless the writer falls behind by more than
+ * MaxQueuedChunks buffers.
+ *
+ * File layout, in host byte order:
+ *   header:   "gem5dbt\0", uint32_t version
+ *   string:   uint8_t DefineString, uint32_t id, uint32_t len, chars
+ *   message:  uint8_t Message, uint8_t format, uint64_t tick,
+ *             uint32_t name, uint32_t flag, uint32_t fmt,
+ *             uint8_t num_args, uint32_t len, encoded arguments
+ *   text:     uint8_t Text, uint8_t format, uint64_t tick,
+ *             uint32_t name, uint32_t flag, uint32_t len, chars
+ *
+ * String id 0 is the empty string. The format byte holds the
+ * ShowTick/ShowFlag bits the FmtTicksOff and FmtFlag debug flags had
+ * when the message was logged.
+ */
+class BinaryLogger : public Logger
+{
+  public:
+    static const char Magic[8];
+    static const uint32_t Version = 1;
+
+    enum Record : uint8_t
+    {
+        DefineString = 1,
+        Message = 2,
+        Text = 3,
+    };
+
+    enum FormatBits : uint8_t
+    {
+        ShowTick = 0x1,
+        ShowFlag = 0x2,
+    };
+
+    BinaryLogger(std::ostream &stream, size_t chunk_size=256 * 1024);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    void logArgs(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const EncodedArgs &args) override;
+
+    /** Text written here is logged as raw (tick-less) messages */
+    std::ostream &getOstream() override { return textStream; }
+
+    /**
+     * Write out everything that has been logged so far. The buffers of
+     * all threads are flushed, so this must only be called while no
+     * other thread is logging, e.g., when the simulator exits.
+     */
+    void flush();
+
+  private:
+    static const size_t MaxQueuedChunks = 16;
+
+    struct ThreadBuffer
+    {
+        std::vector<uint8_t> data;
+        /** Format string pointers that have been seen by this thread */
+        std::unordered_map<const char *, std::pair<const std::string *,
+            uint32_t>> formats;
+        /** Names and flags that have been seen by this thread */
+        std::unordered_map<std::string, uint32_t> strings;
+
+        template <typename T>
+        void
+        put(const T &val)
+        {
+            const uint8_t *p = reinterpret_cast<const uint8_t *>(&val);
+            data.insert(data.end(), p, p + sizeof(T));
+        }
+
+        void
+        put(const void *src, size_t len)
+        {
+            const uint8_t *p = static_cast<const uint8_t *>(src);
+            data.insert(data.end(), p, p + len);
+        }
+    };
+
+    /** Turns lines written to getOstream() into Text records */
+    class TextBuf : public std::streambuf
+    {
+      private:
+        BinaryLogger &logger;
+        std::string line;
+
+      protected:
+        int overflow(int c) override;
+        std::streamsize xsputn(const char *s, std::streamsize n) override;
+        int sync() override;
+
+      public:
+        TextBuf(BinaryLogger &_logger) : logger(_logger) {}
+    };
+
+    std::ostream &stream;
+    const size_t chunkSize;
+
+    /** Distinguishes loggers in the per thread buffer cache */
+    const uint64_t serial;
+
+    TextBuf textBuf;
+    std::ostream textStream;
+
+    std::mutex buffersLock;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    std::mutex stringsLock;
+    std::unordered_map<std::string, uint32_t> stringIds;
+
+    std::mutex queueLock;
+    std::condition_variable queueCond;
+    std::deque<std::vector<uint8_t>> queue;
+    std::vector<std::vector<uint8_t>> spares;
+    bool writing = false;
+    bool stopping = false;
+    std::thread writer;
+
+    ThreadBuffer &threadBuffer();
+
+    /**
+     * Map a string to its id, adding a DefineString record to buf when
+     * the string has not been seen before by any thread.
+     */
+    uint32_t defineString(ThreadBuffer &buf, const std::string &str,
+            const std::string **interned=nullptr);
+
+    uint32_t stringId(ThreadBuffer &buf, const std::string &str);
+    uint32_t formatId(ThreadBuffer &buf, const char *fmt);
+
+    /** Hand the records in buf over to the writer thread */
+    void submit(ThreadBuffer &buf);
+
+    void writeChunks();
+};
+
+} // namespace Trace
+
+#endif // __BASE_TRACE_BINARY_HH__
@@ -56,9 +56,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstddef>
 #include <cstdio>
+#include <cstring>
 
 #include "base/atomicio.hh"
 #include "base/logging.hh"
@@ -75,6 +77,8 @@ const PixelConverter VncServer::pixelConverter(
     8, 8, 8,  // 8 bits / channel
     ByteOrder::little);
 
+const unsigned VncServer::TileSize;
+
 /** @file
  * Implementiation of a VNC server
  */
@@ -115,7 +119,7 @@ VncServer::DataEvent::process(int revent)
  */
 VncServer::VncServer(const Params &p)
     : VncInput(p), listenEvent(NULL), dataEvent(NULL), number(p.number),
-      dataFd(-1), sendUpdate(false),
+      dataFd(-1), sendUpdate(false), fullUpdate(true),
       supportsRawEnc(false), supportsResizeEnc(false)
 {
     if (p.port)
@@ -473,6 +477,9 @@ VncServer::sendServerInit()
     if (!write(&msg))
         return;
     curState = NormalPhase;
+
+    // A new client needs to be sent everything
+    fullUpdate = true;
 }
 
 void
@@ -560,6 +567,9 @@ VncServer::requestFbUpdate()
     DPRINTF(VNC, " -- x = %d y = %d w = %d h = %d\n", fbr.x, fbr.y, fbr.width,
             fbr.height);
 
+    if (!fbr.incremental)
+        fullUpdate = true;
+
     sendFrameBufferUpdate();
 }
 
@@ -621,6 +631,50 @@ VncServer::recvCutText()
 }
 
 
+bool
+VncServer::rectChanged(unsigned x, unsigned y, unsigned w, unsigned h) const
+{
+    for (unsigned row = y; row < y + h; ++row) {
+        const size_t offset = row * fb->width() + x;
+        if (std::memcmp(&fb->pixels[offset], &clientPixels[offset],
+                   w * sizeof(Pixel))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool
+VncServer::sendRect(unsigned x, unsigned y, unsigned w, unsigned h)
+{
+    FrameBufferRect fbr;
+    fbr.x = htobe((uint16_t)x);
+    fbr.y = htobe((uint16_t)y);
+    fbr.width = htobe((uint16_t)w);
+    fbr.height = htobe((uint16_t)h);
+    fbr.encoding = htobe((int32_t)EncodingRaw);
+
+    if (!write(&fbr))
+        return false;
+
+    std::vector<uint8_t> line_buffer(pixelConverter.length * w);
+    for (unsigned row = y; row < y + h; ++row) {
+        // Convert and send a line at a time
+        const size_t offset = row * fb->width() + x;
+        pixelConverter.fromPixels(line_buffer.data(), &fb->pixels[offset], w);
+
+        if (!write(line_buffer.data(), line_buffer.size()))
+            return false;
+
+        std::copy(fb->pixels.begin() + offset,
+                  fb->pixels.begin() + offset + w,
+                  clientPixels.begin() + offset);
+    }
+
+    return true;
+}
+
 void
 VncServer::sendFrameBufferUpdate()
 {
@@ -633,43 +687,65 @@ VncServer::sendFrameBufferUpdate()
     // The client will request data constantly, unless we throttle it
     sendUpdate = false;
 
-    DPRINTF(VNC, "Sending framebuffer update\n");
+    assert(fb);
 
-    FrameBufferUpdate fbu;
-    FrameBufferRect fbr;
+    const unsigned width = fb->width();
+    const unsigned height = fb->height();
 
-    fbu.type = ServerFrameBufferUpdate;
-    fbu.num_rects = 1;
-    fbr.x = 0;
-    fbr.y = 0;
-    fbr.width = videoWidth();
-    fbr.height = videoHeight();
-    fbr.encoding = EncodingRaw;
+    if (clientPixels.size() != fb->area()) {
+        clientPixels.resize(fb->area());
+        fullUpdate = true;
+    }
 
-    // fix up endian
-    fbu.num_rects = htobe(fbu.num_rects);
-    fbr.x = htobe(fbr.x);
-    fbr.y = htobe(fbr.y);
-    fbr.width = htobe(fbr.width);
-    fbr.height = htobe(fbr.height);
-    fbr.encoding = htobe(fbr.encoding);
+    // Only send the tiles which changed since the last update, merging
+    // horizontally adjacent ones into a single rectangle.
+    struct Rect { unsigned x, y, w, h; };
+    std::vector<Rect> rects;
+    if (fullUpdate) {
+        rects.push_back({ 0, 0, width, height });
+    } else {
+        for (unsigned y = 0; y < height; y += TileSize) {
+            const unsigned h = std::min(TileSize, height - y);
+            unsigned run_start = width;
+            for (unsigned x = 0; x < width; x += TileSize) {
+                const unsigned w = std::min(TileSize, width - x);
+                if (rectChanged(x, y, w, h)) {
+                    if (run_start == width)
+                        run_start = x;
+                } else if (run_start != width) {
+                    rects.push_back({ run_start, y, x - run_start, h });
+                    run_start = width;
+                }
+            }
+            if (run_start != width)
+                rects.push_back({ run_start, y, width - run_start, h });
+        }
+    }
 
-    // send headers to client
-    if (!write(&fbu) || !write(&fbr))
+    // The number of rectangles in an update is limited to 16 bits
+    if (rects.size() > UINT16_MAX)
+        rects.assign(1, { 0, 0, width, height });
+
+    if (rects.empty()) {
+        DPRINTF(VNC, "Frame buffer unchanged, not sending update\n");
         return;
+    }
 
-    assert(fb);
+    DPRINTF(VNC, "Sending framebuffer update (%d rectangles)\n",
+            rects.size());
 
-    std::vector<uint8_t> line_buffer(pixelConverter.length * fb->width());
-    for (int y = 0; y < fb->height(); ++y) {
-        // Convert and send a line at a time
-        uint8_t *raw_pixel(line_buffer.data());
-        for (unsigned x = 0; x < fb->width(); ++x) {
-            pixelConverter.fromPixel(raw_pixel, fb->pixel(x, y));
-            raw_pixel += pixelConverter.length;
-        }
+    fullUpdate = false;
 
-        if (!write(line_buffer.data(), line_buffer.size()))
+    FrameBufferUpdate fbu;
+    fbu.type = ServerFrameBufferUpdate;
+    fbu.num_rects = htobe((uint16_t)rects.size());
+
+    // send headers to client
+    if (!write(&fbu))
+        return;
+
+    for (const auto &rect : rects) {
+        if (!sendRect(rect.x, rect.y, rect.w, rect.h))
             return;
     }
 }
@@ -43,6 +43,7 @@
 #define __BASE_VNC_VNC_SERVER_HH__
 
 #include <iostream>
+#include <vector>
 
 #include "base/vnc/vncinput.hh"
 #include "base/circlebuf.hh"
@@ -190,6 +191,18 @@ class VncServer : public VncInput
      * client will constantly request data that is pointless */
     bool sendUpdate;
 
+    /** Send the whole frame buffer with the next update */
+    bool fullUpdate;
+
+    /**
+     * Frame buffer contents as last sent to the client. Updates only
+     * include the tiles which differ from it.
+     */
+    std::vector<Pixel> clientPixels;
+
+    /** Width and height of the tiles updates are made of */
+    static const unsigned TileSize = 16;
+
     /** The one and only pixel format we support */
     PixelFormat pixelFormat;
 
@@ -274,6 +287,15 @@ class VncServer : public VncInput
      */
     void sendFrameBufferUpdate();
 
+    /**
+     * Check if a rectangle of the frame buffer differs from what the
+     * client was last sent.
+     */
+    bool rectChanged(unsigned x, unsigned y, unsigned w, unsigned h) const;
+
+    /** Send the pixels of a rectangle of the frame buffer */
+    bool sendRect(unsigned x, unsigned y, unsigned w, unsigned h);
+
     /** Receive pixel foramt message from client and process it. */
     void setPixelFormat();
 
@@ -53,6 +53,7 @@ from m5.objects.CPUTracers import ExeTracer
 from m5.objects.SubSystem import SubSystem
 from m5.objects.ClockDomain import *
 from m5.objects.Platform import Platform
+from m5.objects.SimPoint import SimPoint
 
 default_tracer = ExeTracer()
 
@@ -251,6 +252,11 @@ class BaseCPU(ClockedObject):
     def addCheckerCpu(self):
         pass
 
+    def addSimPointProbe(self, interval):
+        simpoint = SimPoint()
+        simpoint.interval = interval
+        self.probeListener = simpoint
+
     def createPhandleKey(self, thread):
         # This method creates a unique key for this cpu as a function of a
         # certain thread
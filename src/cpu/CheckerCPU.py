@@ -37,3 +37,6 @@ class CheckerCPU(BaseCPU):
         "Update the checker with the main CPU's state on an error")
     warnOnlyOnLoadError = Param.Bool(True,
         "If a load result is incorrect, only print a warning and do not exit")
+    verifyBatchSize = Param.Unsigned(1,
+        "Number of committed instructions to buffer and verify together, "
+        "1 verifies every instruction as it commits")
@@ -239,7 +239,7 @@ BaseCPU::mwaitAtomic(ThreadID tid, ThreadContext *tc, BaseMMU *mmu)
     assert(tid < numThreads);
     AddressMonitor &monitor = addressMonitor[tid];
 
-    RequestPtr req = std::make_shared<Request>();
+    RequestPtr req = Request::create();
 
     Addr addr = monitor.vAddr;
     int block_size = cacheLineSize();
@@ -347,11 +347,19 @@ BaseCPU::regProbePoints()
 
     ppSleeping = new ProbePointArg<bool>(this->getProbeManager(),
                                          "Sleeping");
+
+    ppRetiredInstTrace = new ProbePointArg<RetiredInstInfo>(
+        getProbeManager(), "RetiredInstTrace");
 }
 
 void
 BaseCPU::probeInstCommit(const StaticInstPtr &inst, Addr pc)
 {
+#if TRACING_ON
+    if (ppRetiredInstTrace->hasListeners())
+        ppRetiredInstTrace->notify(RetiredInstInfo{inst.get(), pc});
+#endif
+
     if (!inst->isMicroop() || inst->isLastMicroop()) {
         ppRetiredInsts->notify(1);
         ppRetiredInstsPC->notify(pc);
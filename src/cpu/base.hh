@@ -183,6 +183,20 @@ class BaseCPU : public ClockedObject
         return [port](PacketPtr pkt)->void { port->sendFunctional(pkt); };
     }
 
+    /**
+     * Returns a delegate requesting functional back doors for use with
+     * port proxies, or an empty function if back doors can't be used.
+     */
+    virtual PortProxy::SendMemBackdoorReqFunc
+    getSendMemBackdoorReq()
+    {
+        auto port = dynamic_cast<RequestPort *>(&getDataPort());
+        assert(port);
+        return [port](const AddrRange &range, MemBackdoorPtr &backdoor) {
+            port->sendMemBackdoorReq(range, backdoor);
+        };
+    }
+
     /**
      * Purely virtual method that returns a reference to the instruction
      * port. All subclasses must implement this method.
@@ -473,6 +487,13 @@ class BaseCPU : public ClockedObject
      */
     virtual void probeInstCommit(const StaticInstPtr &inst, Addr pc);
 
+    /** What the RetiredInstTrace probe point passes to its listeners */
+    struct RetiredInstInfo
+    {
+        const StaticInst *inst;
+        Addr pc;
+    };
+
    protected:
     /**
      * Helper method to instantiate probe points belonging to this
@@ -517,6 +538,13 @@ class BaseCPU : public ClockedObject
      * remaining threadContexts are disabled.
      */
     ProbePointArg<bool> *ppSleeping;
+
+    /**
+     * Every committed instruction, micro-ops included, for instruction
+     * tracers. Nothing is done for it unless someone is listening, and
+     * it is compiled out of builds without tracing.
+     */
+    ProbePointArg<RetiredInstInfo> *ppRetiredInstTrace;
     /** @} */
 
     enum CPUState {
@@ -52,6 +52,7 @@
 
 #include "arch/generic/tlb.hh"
 #include "arch/utility.hh"
+#include "base/circular_queue.hh"
 #include "base/trace.hh"
 #include "config/the_isa.hh"
 #include "cpu/checker/cpu.hh"
@@ -90,7 +91,7 @@ class BaseDynInst : public ExecContext, public RefCounted
     typedef RefCountingPtr<BaseDynInst<Impl> > BaseDynInstPtr;
 
     // The list of instructions iterator type.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename CircularQueue<DynInstPtr>::iterator ListIt;
 
   protected:
     enum Status {
@@ -77,6 +77,9 @@ CheckerCPU::CheckerCPU(const Params &p)
 
     exitOnError = p.exitOnError;
     warnOnlyOnLoadError = p.warnOnlyOnLoadError;
+    verifyBatchSize = p.verifyBatchSize;
+    fatal_if(verifyBatchSize == 0,
+             "%s: verifyBatchSize must be at least 1.", name());
     mmu = p.mmu;
     workload = p.workload;
 
@@ -148,7 +151,7 @@ CheckerCPU::genMemFragmentRequest(Addr frag_addr, int size,
                                                     size_left));
     auto it_end = byte_enable.cbegin() + (size - size_left);
     if (isAnyActiveElement(it_start, it_end)) {
-        mem_req = std::make_shared<Request>(frag_addr, frag_size,
+        mem_req = Request::create(frag_addr, frag_size,
                 flags, requestorId, thread->pcState().instAddr(),
                 tc->contextId());
         mem_req->setByteEnable(std::vector<bool>(it_start, it_end));
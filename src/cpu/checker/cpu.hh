@@ -81,6 +81,12 @@ class Request;
  * Checker's state through any ThreadContext accesses.  This allows the
  * checker to be able to correctly verify instructions, even with
  * external accesses to the ThreadContext that change state.
+ *
+ * With a verifyBatchSize above one, completed instructions are
+ * buffered and verified together once the batch is full. Instructions
+ * that depend on state younger instructions may change (serializing
+ * and non-speculative instructions, faults, misc register writes,
+ * etc.) are verified right away, together with the batch before them.
  */
 class CheckerCPU : public BaseCPU, public ExecContext
 {
@@ -606,6 +612,14 @@ class CheckerCPU : public BaseCPU, public ExecContext
             dumpAndExit();
     }
 
+    /**
+     * Verify the instructions buffered for batched verification. This
+     * is needed before the checker state is changed from the outside,
+     * as the buffered instructions have to see the state they
+     * committed with.
+     */
+    virtual void verifyBatch() { }
+
     bool checkFlags(const RequestPtr &unverified_req, Addr vAddr,
                     Addr pAddr, int flags);
 
@@ -625,6 +639,9 @@ class CheckerCPU : public BaseCPU, public ExecContext
     bool updateOnError;
     bool warnOnlyOnLoadError;
 
+    /** Number of committed instructions verified together */
+    unsigned verifyBatchSize;
+
     InstSeqNum youngestSN;
 };
 
@@ -651,6 +668,7 @@ class Checker : public CheckerCPU
     void advancePC(const Fault &fault);
 
     void verify(const DynInstPtr &inst);
+    void verifyBatch() override;
 
     void validateInst(const DynInstPtr &inst);
     void validateExecution(const DynInstPtr &inst);
@@ -672,6 +690,13 @@ class Checker : public CheckerCPU
 
     void dumpAndExit(const DynInstPtr &inst);
 
+    /**
+     * Check if verifying a completed instruction can be postponed to
+     * the end of the batch, i.e. if the instruction does not depend on
+     * state that younger instructions may change before then.
+     */
+    bool canDefer(const DynInstPtr &inst) const;
+
     bool updateThisCycle;
 
     DynInstPtr unverifiedInst;
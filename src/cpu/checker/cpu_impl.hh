@@ -120,13 +120,28 @@ Checker<Impl>::verify(const DynInstPtr &completed_inst)
 {
     DynInstPtr inst;
 
+    // When verifying in batches, buffer completed instructions until
+    // the batch is full, or until an instruction has to be checked
+    // right away, which first checks the ones buffered before it.
+    if (verifyBatchSize > 1 && completed_inst->isCompleted() &&
+        youngestSN < completed_inst->seqNum && canDefer(completed_inst)) {
+        DPRINTF(Checker, "Adding instruction [sn:%lli] PC:%s to batch\n",
+                completed_inst->seqNum, completed_inst->pcState());
+        instList.push_back(completed_inst);
+        youngestSN = completed_inst->seqNum;
+        if (instList.size() < verifyBatchSize)
+            return;
+    }
+
     // Make sure serializing instructions are actually
     // seen as serializing to commit. instList should be
-    // empty in these cases.
+    // empty in these cases, apart from completed instructions
+    // waiting for their batch to be verified.
     if ((completed_inst->isSerializing() ||
         completed_inst->isSerializeBefore()) &&
         (!instList.empty() ?
-         (instList.front()->seqNum != completed_inst->seqNum) : 0)) {
+         (instList.front()->seqNum != completed_inst->seqNum &&
+          !(verifyBatchSize > 1 && instList.front()->isCompleted())) : 0)) {
         panic("%lli: Instruction sn:%lli at PC %s is serializing before but is"
               " entering instList with other instructions\n", curTick(),
               completed_inst->seqNum, completed_inst->pcState());
@@ -233,7 +248,7 @@ Checker<Impl>::verify(const DynInstPtr &completed_inst)
             // If not in the middle of a macro instruction
             if (!curMacroStaticInst) {
                 // set up memory request for instruction fetch
-                auto mem_req = std::make_shared<Request>(
+                auto mem_req = Request::create(
                     fetch_PC, sizeof(TheISA::MachInst), 0, requestorId,
                     fetch_PC, thread->contextId());
 
@@ -428,10 +443,51 @@ Checker<Impl>::verify(const DynInstPtr &completed_inst)
     unverifiedInst = NULL;
 }
 
+template <class Impl>
+void
+Checker<Impl>::verifyBatch()
+{
+    // Nothing to do while already verifying, or if the oldest
+    // instruction is still waiting to complete
+    if (unverifiedInst || instList.empty() ||
+        !instList.front()->isCompleted()) {
+        return;
+    }
+
+    verify(instList.front());
+}
+
+template <class Impl>
+bool
+Checker<Impl>::canDefer(const DynInstPtr &inst) const
+{
+    if (inst->isSerializing() || inst->isSerializeBefore() ||
+        inst->isSerializeAfter() || inst->isNonSpeculative() ||
+        inst->isSquashAfter() || inst->isUnverifiable() ||
+        inst->isStoreConditional() || inst->isReadBarrier() ||
+        inst->isWriteBarrier() || inst->getFault() != NoFault) {
+        return false;
+    }
+
+    // A load checked late may see the data of younger stores
+    if (inst->isLoad() && !warnOnlyOnLoadError)
+        return false;
+
+    // Misc register side effects are compared with the main CPU's
+    // current values, which younger instructions may change
+    for (int i = 0; i < inst->numDestRegs(); i++) {
+        if (inst->destRegIdx(i).isMiscReg())
+            return false;
+    }
+
+    return true;
+}
+
 template <class Impl>
 void
 Checker<Impl>::switchOut()
 {
+    verifyBatch();
     instList.clear();
 }
 
@@ -670,6 +726,11 @@ Checker<Impl>::dumpAndExit(const DynInstPtr &inst)
             inst->threadNumber,
             inst->isCompleted());
     inst->dump();
+    if (!instList.empty()) {
+        cprintf("Verified with %i younger committed instructions "
+                "pending:\n", instList.size());
+        dumpInsts();
+    }
     CheckerCPU::dumpAndExit();
 }
 
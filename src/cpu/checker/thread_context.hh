@@ -60,7 +60,9 @@ namespace TheISA
  * verified.  This CheckerThreadContext is then used by the main CPU
  * in place of its usual ThreadContext class.  It handles updating the
  * checker's state any time state is updated externally through the
- * ThreadContext.
+ * ThreadContext. Instructions the checker buffered for batched
+ * verification are verified first, so they see the state they
+ * committed with.
  */
 template <class TC>
 class CheckerThreadContext : public ThreadContext
@@ -208,6 +210,7 @@ class CheckerThreadContext : public ThreadContext
     void
     copyArchRegs(ThreadContext *tc) override
     {
+        checkerCPU->verifyBatch();
         actualTC->copyArchRegs(tc);
         checkerTC->copyArchRegs(tc);
     }
@@ -215,6 +218,7 @@ class CheckerThreadContext : public ThreadContext
     void
     clearArchRegs() override
     {
+        checkerCPU->verifyBatch();
         actualTC->clearArchRegs();
         checkerTC->clearArchRegs();
     }
@@ -333,6 +337,7 @@ class CheckerThreadContext : public ThreadContext
     void
     setIntReg(RegIndex reg_idx, RegVal val) override
     {
+        checkerCPU->verifyBatch();
         actualTC->setIntReg(reg_idx, val);
         checkerTC->setIntReg(reg_idx, val);
     }
@@ -340,6 +345,7 @@ class CheckerThreadContext : public ThreadContext
     void
     setFloatReg(RegIndex reg_idx, RegVal val) override
     {
+        checkerCPU->verifyBatch();
         actualTC->setFloatReg(reg_idx, val);
         checkerTC->setFloatReg(reg_idx, val);
     }
@@ -347,6 +353,7 @@ class CheckerThreadContext : public ThreadContext
     void
     setVecReg(const RegId& reg, const TheISA::VecRegContainer& val) override
     {
+        checkerCPU->verifyBatch();
         actualTC->setVecReg(reg, val);
         checkerTC->setVecReg(reg, val);
     }
@@ -354,6 +361,7 @@ class CheckerThreadContext : public ThreadContext
     void
     setVecElem(const RegId& reg, const TheISA::VecElem& val) override
     {
+        checkerCPU->verifyBatch();
         actualTC->setVecElem(reg, val);
         checkerTC->setVecElem(reg, val);
     }
@@ -362,6 +370,7 @@ class CheckerThreadContext : public ThreadContext
     setVecPredReg(const RegId& reg,
             const TheISA::VecPredRegContainer& val) override
     {
+        checkerCPU->verifyBatch();
         actualTC->setVecPredReg(reg, val);
         checkerTC->setVecPredReg(reg, val);
     }
@@ -369,6 +378,7 @@ class CheckerThreadContext : public ThreadContext
     void
     setCCReg(RegIndex reg_idx, RegVal val) override
     {
+        checkerCPU->verifyBatch();
         actualTC->setCCReg(reg_idx, val);
         checkerTC->setCCReg(reg_idx, val);
     }
@@ -380,6 +390,7 @@ class CheckerThreadContext : public ThreadContext
     void
     pcState(const TheISA::PCState &val) override
     {
+        checkerCPU->verifyBatch();
         DPRINTF(Checker, "Changing PC to %s, old PC %s\n",
                          val, checkerTC->pcState());
         checkerTC->pcState(val);
@@ -390,6 +401,7 @@ class CheckerThreadContext : public ThreadContext
     void
     setNPC(Addr val)
     {
+        checkerCPU->verifyBatch();
         checkerTC->setNPC(val);
         actualTC->setNPC(val);
     }
@@ -424,6 +436,7 @@ class CheckerThreadContext : public ThreadContext
     void
     setMiscRegNoEffect(RegIndex misc_reg, RegVal val) override
     {
+        checkerCPU->verifyBatch();
         DPRINTF(Checker, "Setting misc reg with no effect: %d to both Checker"
                          " and O3..\n", misc_reg);
         checkerTC->setMiscRegNoEffect(misc_reg, val);
@@ -433,6 +446,7 @@ class CheckerThreadContext : public ThreadContext
     void
     setMiscReg(RegIndex misc_reg, RegVal val) override
     {
+        checkerCPU->verifyBatch();
         DPRINTF(Checker, "Setting misc reg with effect: %d to both Checker"
                          " and O3..\n", misc_reg);
         checkerTC->setMiscReg(misc_reg, val);
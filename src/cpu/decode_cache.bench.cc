@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "cpu/decode_cache.hh"
+#include "cpu/static_inst.hh"
+
+namespace
+{
+
+/** Distinct machine instructions, like the working set of a program. */
+std::vector<uint64_t>
+machInsts(int n)
+{
+    std::mt19937_64 rng(0);
+    std::vector<uint64_t> insts(n);
+    for (auto &inst: insts)
+        inst = rng();
+    return insts;
+}
+
+void
+InstMapFind(benchmark::State &state)
+{
+    DecodeCache::InstMap<uint64_t> map;
+    const auto insts = machInsts(state.range(0));
+    for (auto inst: insts)
+        map.insert(inst, StaticInst::nopStaticInstPtr);
+
+    size_t i = 0;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(map.find(insts[i]));
+        if (++i == insts.size())
+            i = 0;
+    }
+}
+
+void
+InstMapInsert(benchmark::State &state)
+{
+    const auto insts = machInsts(state.range(0));
+    for (auto _: state) {
+        DecodeCache::InstMap<uint64_t> map;
+        for (auto inst: insts)
+            map.insert(inst, StaticInst::nopStaticInstPtr);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * insts.size());
+}
+
+/** Straight line fetch through the pages of a program. */
+void
+AddrMapSequential(benchmark::State &state)
+{
+    DecodeCache::AddrMap<StaticInstPtr> map;
+    const Addr bytes = state.range(0) << 12;
+
+    Addr pc = 0;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(map.lookup(pc));
+        pc = (pc + 4) % bytes;
+    }
+}
+
+/** Jumps between the pages of a program. */
+void
+AddrMapRandom(benchmark::State &state)
+{
+    DecodeCache::AddrMap<StaticInstPtr> map;
+    std::mt19937_64 rng(0);
+    std::uniform_int_distribution<Addr> dist(0, (state.range(0) << 10) - 1);
+    std::vector<Addr> pcs(4096);
+    for (auto &pc: pcs)
+        pc = dist(rng) * 4;
+
+    size_t i = 0;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(map.lookup(pcs[i]));
+        i = (i + 1) % pcs.size();
+    }
+}
+
+} // anonymous namespace
+
+BENCHMARK(InstMapFind)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK(InstMapInsert)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK(AddrMapSequential)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(AddrMapRandom)->RangeMultiplier(4)->Range(1, 256);
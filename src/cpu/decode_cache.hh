@@ -29,17 +29,163 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "base/bitfield.hh"
-#include "cpu/static_inst_fwd.hh"
+#include "base/types.hh"
+#include "base/uncontended_mutex.hh"
+#include "cpu/static_inst.hh"
 
 namespace DecodeCache
 {
 
-/// Hash for decoded instructions.
+/**
+ * Hash for decoded instructions, which may be shared by the decoders of
+ * CPUs running on different event queue threads.
+ *
+ * Entries are never removed or changed once they are in the map, so
+ * lookups don't take any lock, and decoders may keep pointers to them.
+ * The instructions are marked as shared when they are added. The map is split in shards, each with an
+ * open addressing table of pointers to immutable entries. Inserts lock
+ * their shard, and replace its table with a larger copy when it gets
+ * half full. Replaced tables are kept until the map is destroyed since
+ * lookups may still be going through them.
+ */
 template <typename EMI>
-using InstMap = std::unordered_map<EMI, StaticInstPtr>;
+class InstMap
+{
+  public:
+    struct Entry
+    {
+        const EMI machInst;
+        const StaticInstPtr inst;
+    };
+
+  private:
+
+    struct Table
+    {
+        const size_t mask;
+        std::unique_ptr<std::atomic<const Entry *>[]> slots;
+
+        Table(size_t size) :
+            mask(size - 1), slots(new std::atomic<const Entry *>[size])
+        {
+            for (size_t i = 0; i < size; i++)
+                slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+    };
+
+    struct Shard
+    {
+        std::atomic<Table *> table;
+        /** Serialises inserts, lookups don't need it. */
+        UncontendedMutex lock;
+        std::vector<std::unique_ptr<Table>> tables;
+        std::vector<std::unique_ptr<const Entry>> entries;
+    };
+
+    static constexpr unsigned NumShardsShift = 4;
+    static constexpr size_t InitialShardSize = 64;
+
+    Shard shards[1 << NumShardsShift];
+
+    static size_t
+    hash(const EMI &mach_inst)
+    {
+        // Machine instructions often hash to themselves, mix the bits
+        // so that both the shard and the slot depend on all of them.
+        return std::hash<EMI>()(mach_inst) * 0x9e3779b97f4a7c15ULL;
+    }
+
+    static size_t
+    shardIndex(size_t h)
+    {
+        return h >> (sizeof(size_t) * 8 - NumShardsShift);
+    }
+
+    static const Entry *
+    findIn(const Table &table, size_t h, const EMI &mach_inst)
+    {
+        for (size_t i = h & table.mask; ; i = (i + 1) & table.mask) {
+            const Entry *entry =
+                table.slots[i].load(std::memory_order_acquire);
+            if (!entry || entry->machInst == mach_inst)
+                return entry;
+        }
+    }
+
+    static void
+    insertIn(Table &table, size_t h, const Entry *entry)
+    {
+        size_t i = h & table.mask;
+        while (table.slots[i].load(std::memory_order_relaxed))
+            i = (i + 1) & table.mask;
+        table.slots[i].store(entry, std::memory_order_release);
+    }
+
+  public:
+    InstMap()
+    {
+        for (auto &shard: shards) {
+            shard.tables.emplace_back(new Table(InitialShardSize));
+            shard.table.store(shard.tables.back().get(),
+                              std::memory_order_relaxed);
+        }
+    }
+
+    InstMap(const InstMap &) = delete;
+    InstMap &operator=(const InstMap &) = delete;
+
+    /**
+     * Find the instruction decoded from a machine instruction.
+     * @return The entry, or nullptr if it isn't in the map.
+     */
+    const Entry *
+    find(const EMI &mach_inst) const
+    {
+        const size_t h = hash(mach_inst);
+        const Shard &shard = shards[shardIndex(h)];
+        return findIn(*shard.table.load(std::memory_order_acquire), h,
+                      mach_inst);
+    }
+
+    /**
+     * Add the instruction decoded from a machine instruction, unless
+     * another thread got there first.
+     * @return The entry in the map for the machine instruction.
+     */
+    const Entry *
+    insert(const EMI &mach_inst, const StaticInstPtr &inst)
+    {
+        const size_t h = hash(mach_inst);
+        Shard &shard = shards[shardIndex(h)];
+        std::lock_guard<UncontendedMutex> guard(shard.lock);
+
+        Table *table = shard.table.load(std::memory_order_relaxed);
+        if (const Entry *entry = findIn(*table, h, mach_inst))
+            return entry;
+
+        if (2 * (shard.entries.size() + 1) > table->mask + 1) {
+            Table *bigger = new Table(2 * (table->mask + 1));
+            for (auto &entry: shard.entries)
+                insertIn(*bigger, hash(entry->machInst), entry.get());
+            shard.tables.emplace_back(bigger);
+            shard.table.store(bigger, std::memory_order_release);
+            table = bigger;
+        }
+
+        inst->markShared();
+        shard.entries.emplace_back(new Entry{mach_inst, inst});
+        insertIn(*table, h, shard.entries.back().get());
+        return shard.entries.back().get();
+    }
+};
 
 /// A sparse map from an Addr to a Value, stored in page chunks.
 template<class Value, Addr CacheChunkShift = 12>
@@ -66,68 +212,49 @@ class AddrMap
         Value items[CacheChunkBytes];
     };
     // A map of cache chunks which allows a sparse mapping.
-    typedef typename std::unordered_map<Addr, CacheChunk *> ChunkMap;
-    typedef typename ChunkMap::iterator ChunkIt;
-    // Mini cache of recent lookups.
-    ChunkIt recent[2];
+    typedef typename std::unordered_map<Addr, std::unique_ptr<CacheChunk>>
+        ChunkMap;
     ChunkMap chunkMap;
 
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
-    void
-    update(ChunkIt recentest)
+    // Direct-mapped slots of recently used chunks, indexed by the low
+    // bits of the chunk number.
+    static constexpr unsigned NumSlotsShift = 6;
+    struct Slot
     {
-        recent[1] = recent[0];
-        recent[0] = recentest;
+        Addr chunkAddr = 0;
+        CacheChunk *chunk = nullptr;
+    };
+    Slot slots[1 << NumSlotsShift];
+
+    static constexpr unsigned
+    slotIndex(Addr addr)
+    {
+        return bits(addr, CacheChunkShift + NumSlotsShift - 1,
+                    CacheChunkShift);
     }
 
-    /// Attempt to find the CacheChunk which goes with a particular
-    /// address. First check the small cache of recent results, then
-    /// actually look in the hash map.
+    /// Find the CacheChunk which goes with a particular address in
+    /// the hash map, adding one if there isn't any yet.
     /// @param addr The address to look up.
     CacheChunk *
-    getChunk(Addr addr)
-    {
-        Addr chunk_addr = chunkStart(addr);
-
-        // Check against recent lookups.
-        if (recent[0] != chunkMap.end()) {
-            if (recent[0]->first == chunk_addr)
-                return recent[0]->second;
-            if (recent[1] != chunkMap.end() &&
-                    recent[1]->first == chunk_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
-        }
-
-        // Actually look in the hash_map.
-        ChunkIt it = chunkMap.find(chunk_addr);
-        if (it != chunkMap.end()) {
-            update(it);
-            return it->second;
-        }
-
-        // Didn't find an existing chunk, so add a new one.
-        CacheChunk *newChunk = new CacheChunk;
-        typename ChunkMap::value_type to_insert(chunk_addr, newChunk);
-        update(chunkMap.insert(to_insert).first);
-        return newChunk;
-    }
-
-  public:
-    /// Constructor
-    AddrMap()
+    findChunk(Addr addr)
     {
-        recent[0] = recent[1] = chunkMap.end();
+        auto &chunk = chunkMap[chunkStart(addr)];
+        if (!chunk)
+            chunk.reset(new CacheChunk());
+        return chunk.get();
     }
 
+  public:
     Value &
     lookup(Addr addr)
     {
-        CacheChunk *chunk = getChunk(addr);
-        return chunk->items[chunkOffset(addr)];
+        Slot &slot = slots[slotIndex(addr)];
+        if (!slot.chunk || slot.chunkAddr != chunkStart(addr)) {
+            slot.chunkAddr = chunkStart(addr);
+            slot.chunk = findChunk(addr);
+        }
+        return slot.chunk->items[chunkOffset(addr)];
     }
 };
 
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_DYN_INST_POOL_HH__
+#define __CPU_DYN_INST_POOL_HH__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "base/logging.hh"
+
+/**
+ * A recycling pool for the dynamic instructions of one CPU.
+ *
+ * All the instructions of a CPU have the same size, so the pool keeps
+ * a single free list of fixed size blocks. Blocks are carved out of
+ * chunks obtained from the global operator new, and are only returned
+ * to the system when the pool is destroyed. The pool is sized up front
+ * for the number of instructions the CPU can have in flight and grows a
+ * chunk at a time if that estimate turns out to be too small.
+ *
+ * Every block starts with a small header pointing back to its pool, so
+ * instructions can be released without knowing where they came from.
+ * Instructions allocated outside of a pool have a null header and are
+ * handed back to the global operator delete.
+ *
+ * The pool is not thread safe, instructions must be allocated and
+ * released by the thread simulating their CPU.
+ */
+class DynInstPool
+{
+  public:
+    /** Room reserved in front of every object for the pool pointer. */
+    static const size_t HeaderSize = alignof(std::max_align_t);
+    /** Number of blocks added to the pool when it runs dry. */
+    static const size_t ChunkBlocks = 64;
+
+    static_assert(HeaderSize >= sizeof(DynInstPool *),
+                  "The block header must have room for the pool pointer");
+
+    struct Stats
+    {
+        /** Number of allocations. */
+        uint64_t allocs = 0;
+        /** Allocations served from recycled blocks. */
+        uint64_t hits = 0;
+        /** Number of blocks reserved by the pool. */
+        uint64_t reserved = 0;
+        /** Number of blocks currently handed out. */
+        uint64_t inUse = 0;
+        /** High-water mark of inUse. */
+        uint64_t peak = 0;
+    };
+
+  private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    const size_t objectSize;
+    const size_t blockSize;
+
+    FreeBlock *freeList = nullptr;
+    std::vector<void *> chunks;
+
+    Stats _stats;
+
+    static DynInstPool *&
+    owner(void *obj)
+    {
+        return *reinterpret_cast<DynInstPool **>(
+            static_cast<char *>(obj) - HeaderSize);
+    }
+
+    /** Carve a new chunk into the given number of blocks. */
+    void
+    refill(size_t blocks)
+    {
+        char *chunk = static_cast<char *>(::operator new(blocks * blockSize));
+        chunks.push_back(chunk);
+        _stats.reserved += blocks;
+
+        for (size_t i = blocks; i-- > 0; ) {
+            FreeBlock *block =
+                reinterpret_cast<FreeBlock *>(chunk + i * blockSize);
+            block->next = freeList;
+            freeList = block;
+        }
+    }
+
+    void
+    release(void *block)
+    {
+        FreeBlock *free_block = static_cast<FreeBlock *>(block);
+        free_block->next = freeList;
+        freeList = free_block;
+        --_stats.inUse;
+    }
+
+  public:
+    /**
+     * @param object_size Size of the objects served by the pool.
+     * @param reserve Number of blocks to reserve up front.
+     */
+    DynInstPool(size_t object_size, size_t reserve)
+        : objectSize(object_size),
+          blockSize(HeaderSize + (object_size + HeaderSize - 1) /
+                    HeaderSize * HeaderSize)
+    {
+        if (reserve)
+            refill(reserve);
+    }
+
+    ~DynInstPool()
+    {
+        for (auto *chunk : chunks)
+            ::operator delete(chunk);
+    }
+
+    DynInstPool(const DynInstPool &) = delete;
+    DynInstPool &operator=(const DynInstPool &) = delete;
+
+    void *
+    allocate(size_t size)
+    {
+        panic_if(size > objectSize, "Dynamic instruction of %d bytes "
+                 "allocated from a pool of %d byte blocks.\n",
+                 size, objectSize);
+
+        ++_stats.allocs;
+        if (freeList)
+            ++_stats.hits;
+        else
+            refill(ChunkBlocks);
+
+        FreeBlock *block = freeList;
+        freeList = block->next;
+        _stats.peak = std::max(_stats.peak, ++_stats.inUse);
+
+        void *obj = reinterpret_cast<char *>(block) + HeaderSize;
+        owner(obj) = this;
+        return obj;
+    }
+
+    /** Allocate an object that doesn't belong to any pool. */
+    static void *
+    allocateUnpooled(size_t size)
+    {
+        void *obj = static_cast<char *>(::operator new(HeaderSize + size)) +
+            HeaderSize;
+        owner(obj) = nullptr;
+        return obj;
+    }
+
+    /** Release an object obtained from allocate or allocateUnpooled. */
+    static void
+    deallocate(void *obj)
+    {
+        if (!obj)
+            return;
+
+        void *block = static_cast<char *>(obj) - HeaderSize;
+        DynInstPool *pool = owner(obj);
+        if (pool)
+            pool->release(block);
+        else
+            ::operator delete(block);
+    }
+
+    const Stats &stats() const { return _stats; }
+};
+
+#endif // __CPU_DYN_INST_POOL_HH__
@@ -62,10 +62,23 @@ class BaseKvmCPU(BaseCPU):
     def support_take_over(cls):
         return True
 
+    def addSimPointProbe(self, interval):
+        # Basic blocks can only be observed through the host's branch
+        # records, so make sure they are being sampled.
+        if not self.branchSamplePeriod:
+            self.branchSamplePeriod = 10007
+        super(BaseKvmCPU, self).addSimPointProbe(interval)
+
     useCoalescedMMIO = Param.Bool(False, "Use coalesced MMIO (EXPERIMENTAL)")
     usePerfOverflow = Param.Bool(False, "Use perf event overflow counters (EXPERIMENTAL)")
     alwaysSyncTC = Param.Bool(False,
                               "Always sync thread contexts on entry/exit")
+    branchSamplePeriod = Param.UInt64(0, "Sample the host's branch records "
+        "every N guest branches and report them through the BranchStacks "
+        "probe, 0 to disable")
+    memSamplePeriod = Param.UInt64(0, "Sample the address of every N-th "
+        "guest load with the host's precise sampling (e.g., PEBS) and "
+        "report them through the MemSamples probe, 0 to disable")
 
     hostFreq = Param.Clock("2GHz", "Host clock frequency")
     hostFactor = Param.Float(1.0, "Cycle scale factor")
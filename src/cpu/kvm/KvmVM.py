@@ -44,3 +44,8 @@ class KvmVM(SimObject):
 
     coalescedMMIO = \
       VectorParam.AddrRange([], "memory ranges for coalesced MMIO")
+    notifyMMIO = VectorParam.Addr([], "4 byte MMIO registers, such as "
+        "virtio queue notify registers, whose writes are signalled through "
+        "eventfds instead of VM exits")
+    notifyMMIOValues = Param.Unsigned(8, "Number of values, counting from "
+        "0, that writes to each notifyMMIO register are signalled for")
@@ -74,6 +74,10 @@ BaseKvmCPU::BaseKvmCPU(const BaseKvmCPUParams &params)
       tickEvent([this]{ tick(); }, "BaseKvmCPU tick",
                 false, Event::CPU_Tick_Pri),
       activeInstPeriod(0),
+      branchSamplePeriod(params.branchSamplePeriod),
+      ppBranchStacks(nullptr),
+      memSamplePeriod(params.memSamplePeriod),
+      ppMemSamples(nullptr),
       perfControlledByTimer(params.usePerfOverflow),
       hostFactor(params.hostFactor), stats(this),
       ctrInsts(0)
@@ -160,6 +164,17 @@ BaseKvmCPU::startup()
     schedule(startupEvent, curTick());
 }
 
+void
+BaseKvmCPU::regProbePoints()
+{
+    BaseCPU::regProbePoints();
+
+    ppBranchStacks = new ProbePointArg<ProbePoints::BranchStacks>(
+        getProbeManager(), "BranchStacks");
+    ppMemSamples = new ProbePointArg<ProbePoints::MemSamples>(
+        getProbeManager(), "MemSamples");
+}
+
 BaseKvmCPU::Status
 BaseKvmCPU::KVMCpuPort::nextIOState() const
 {
@@ -269,11 +284,19 @@ BaseKvmCPU::StatGroup::StatGroup(Stats::Group *parent)
              "number of VM exits due to memory mapped IO"),
     ADD_STAT(numCoalescedMMIO, UNIT_COUNT,
              "number of coalesced memory mapped IO requests"),
+    ADD_STAT(numMMIONotifications, UNIT_COUNT,
+             "number of memory mapped IO writes signalled through eventfds"),
     ADD_STAT(numIO, UNIT_COUNT, "number of VM exits due to legacy IO"),
     ADD_STAT(numHalt, UNIT_COUNT,
              "number of VM exits due to wait for interrupt instructions"),
     ADD_STAT(numInterrupts, UNIT_COUNT, "number of interrupts delivered"),
-    ADD_STAT(numHypercalls, UNIT_COUNT, "number of hypercalls")
+    ADD_STAT(numHypercalls, UNIT_COUNT, "number of hypercalls"),
+    ADD_STAT(numBranchSamples, UNIT_COUNT, "number of branch stacks sampled"),
+    ADD_STAT(numBranchSamplesLost, UNIT_COUNT,
+             "number of branch stacks lost by the host"),
+    ADD_STAT(numMemSamples, UNIT_COUNT, "number of memory accesses sampled"),
+    ADD_STAT(numMemSamplesLost, UNIT_COUNT,
+             "number of memory access samples lost by the host")
 {
 }
 
@@ -414,6 +437,10 @@ BaseKvmCPU::notifyFork()
         _kvmRun = NULL;
 
         hwInstructions.detach();
+        if (hwBranchSamples.attached())
+            hwBranchSamples.detach();
+        if (hwMemSamples.attached())
+            hwMemSamples.detach();
         hwCycles.detach();
     }
 }
@@ -768,6 +795,11 @@ BaseKvmCPU::kvmRun(Tick ticks)
         stats.committedInsts += instsExecuted;
         ctrInsts += instsExecuted;
 
+        if (hwBranchSamples.attached())
+            readBranchSamples(instsExecuted);
+        if (hwMemSamples.attached())
+            readMemSamples();
+
         DPRINTF(KvmRun,
                 "KVM: Executed %i instructions in %i cycles "
                 "(%i ticks, sim cycles: %i).\n",
@@ -776,7 +808,7 @@ BaseKvmCPU::kvmRun(Tick ticks)
 
     ++stats.numVMExits;
 
-    return ticksExecuted + flushCoalescedMMIO();
+    return ticksExecuted + flushCoalescedMMIO() + flushMMIONotifiers();
 }
 
 void
@@ -1073,7 +1105,7 @@ BaseKvmCPU::doMMIOAccess(Addr paddr, void *data, int size, bool write)
     ThreadContext *tc(thread->getTC());
     syncThreadContext();
 
-    RequestPtr mmio_req = std::make_shared<Request>(
+    RequestPtr mmio_req = Request::create(
         paddr, size, Request::UNCACHEABLE, dataRequestorId());
 
     mmio_req->setContext(tc->contextId());
@@ -1174,6 +1206,28 @@ BaseKvmCPU::flushCoalescedMMIO()
     return ticks;
 }
 
+Tick
+BaseKvmCPU::flushMMIONotifiers()
+{
+    if (!vm.hasMMIONotifiers())
+        return 0;
+
+    vm.pollMMIONotifiers(mmioNotifications);
+
+    Tick ticks(0);
+    for (const KvmVM::MMIONotifier *notifier : mmioNotifications) {
+        DPRINTF(KvmIO, "KVM: Handling MMIO notifier (addr: 0x%x, "
+                "value: %u)\n", notifier->addr, notifier->value);
+
+        ++stats.numMMIONotifications;
+        // The guest runs natively, so its byte order is the host's.
+        uint32_t data(notifier->value);
+        ticks += doMMIOAccess(notifier->addr, &data, sizeof(data), true);
+    }
+
+    return ticks;
+}
+
 /**
  * Dummy handler for KVM kick signals.
  *
@@ -1275,6 +1329,100 @@ BaseKvmCPU::setupCounters()
                     0); // TID (0 => currentThread)
 
     setupInstCounter();
+
+    if (branchSamplePeriod) {
+        DPRINTF(Kvm, "Attaching branch sampler...\n");
+        PerfKvmCounterConfig cfgBranches(PERF_TYPE_HARDWARE,
+                                         PERF_COUNT_HW_BRANCH_INSTRUCTIONS);
+        cfgBranches.exclude_hv(true)
+            .exclude_host(true)
+            .samplePeriod(branchSamplePeriod)
+            .sampleType(0)
+            .branchSampleType(PERF_SAMPLE_BRANCH_ANY)
+            .ringPages(64);
+        hwBranchSamples.attach(cfgBranches,
+                               0, // TID (0 => currentThread)
+                               hwCycles);
+    }
+
+    if (memSamplePeriod) {
+        DPRINTF(Kvm, "Attaching memory sampler...\n");
+        // L1D read accesses are the generic name of the load event that
+        // supports precise sampling with a data address, e.g.,
+        // MEM_INST_RETIRED.ALL_LOADS on Intel.
+        PerfKvmCounterConfig cfgMem(PERF_TYPE_HW_CACHE,
+            PERF_COUNT_HW_CACHE_L1D |
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16));
+        cfgMem.exclude_hv(true)
+            .exclude_host(true)
+            .samplePeriod(memSamplePeriod)
+            .sampleType(PERF_SAMPLE_ADDR)
+            .preciseIp(2)
+            .ringPages(64);
+        hwMemSamples.attach(cfgMem,
+                            0, // TID (0 => currentThread)
+                            hwCycles);
+    }
+}
+
+void
+BaseKvmCPU::readBranchSamples(uint64_t insts)
+{
+    branchStacks.insts = insts;
+    branchStacks.stacks.clear();
+
+    hwBranchSamples.readSamples([this](const perf_event_header &header) {
+        if (header.type == PERF_RECORD_LOST) {
+            // The record is followed by an ID and the number of lost
+            // samples.
+            const uint64_t *lost = (const uint64_t *)(&header + 1);
+            stats.numBranchSamplesLost += lost[1];
+            return;
+        }
+        if (header.type != PERF_RECORD_SAMPLE)
+            return;
+
+        // Only the branch stack was requested, which is its number of
+        // entries followed by the entries, most recent first.
+        const uint64_t nr = *(const uint64_t *)(&header + 1);
+        const perf_branch_entry *entries =
+            (const perf_branch_entry *)((const uint64_t *)(&header + 1) + 1);
+        branchStacks.stacks.emplace_back();
+        auto &stack = branchStacks.stacks.back();
+        stack.reserve(nr);
+        for (uint64_t i = nr; i-- > 0;)
+            stack.emplace_back(entries[i].from, entries[i].to);
+        ++stats.numBranchSamples;
+    });
+
+    ppBranchStacks->notify(branchStacks);
+}
+
+void
+BaseKvmCPU::readMemSamples()
+{
+    memSamples.clear();
+
+    hwMemSamples.readSamples([this](const perf_event_header &header) {
+        if (header.type == PERF_RECORD_LOST) {
+            const uint64_t *lost = (const uint64_t *)(&header + 1);
+            stats.numMemSamplesLost += lost[1];
+            return;
+        }
+        if (header.type != PERF_RECORD_SAMPLE)
+            return;
+
+        // Only the data address was requested. It is 0 when the
+        // hardware couldn't tell.
+        const uint64_t addr = *(const uint64_t *)(&header + 1);
+        if (addr) {
+            memSamples.push_back(addr);
+            ++stats.numMemSamples;
+        }
+    });
+
+    ppMemSamples->notify(memSamples);
 }
 
 bool
@@ -51,6 +51,7 @@
 #include "cpu/base.hh"
 #include "cpu/simple_thread.hh"
 #include "sim/faults.hh"
+#include "sim/probe/pmu.hh"
 
 /** Signal to use to trigger exits from KVM */
 #define KVM_KICK_SIGNAL SIGRTMIN
@@ -82,6 +83,7 @@ class BaseKvmCPU : public BaseCPU
 
     void init() override;
     void startup() override;
+    void regProbePoints() override;
 
     void serializeThread(CheckpointOut &cp, ThreadID tid) const override;
     void unserializeThread(CheckpointIn &cp, ThreadID tid) override;
@@ -647,6 +649,17 @@ class BaseKvmCPU : public BaseCPU
      */
     Tick flushCoalescedMMIO();
 
+    /**
+     * Service the MMIO register writes KVM signalled through
+     * eventfds, see KvmVM::notifyMMIO().
+     *
+     * @return Number of ticks spent servicing the writes
+     */
+    Tick flushMMIONotifiers();
+
+    /** Notifiers found by the last flushMMIONotifiers() */
+    std::vector<const KvmVM::MMIONotifier *> mmioNotifications;
+
     /**
      * Setup a signal handler to catch the timer signal used to
      * switch back to the monitor.
@@ -758,6 +771,52 @@ class BaseKvmCPU : public BaseCPU
      */
     PerfKvmCounter hwInstructions;
 
+    /**
+     * Guest branch sampler.
+     *
+     * Records the host's branch stack every branchSamplePeriod guest
+     * branches. Only attached if sampling has been requested.
+     */
+    PerfKvmCounter hwBranchSamples;
+
+    /** Branches between samples, 0 if not sampling */
+    const uint64_t branchSamplePeriod;
+
+    /**
+     * Read the branch samples taken during the last guest entry and
+     * pass them on to the BranchStacks probe.
+     *
+     * @param insts Instructions executed during the entry
+     */
+    void readBranchSamples(uint64_t insts);
+
+    /** Branch stacks read from hwBranchSamples */
+    ProbePoints::BranchStacks branchStacks;
+
+    ProbePointArg<ProbePoints::BranchStacks> *ppBranchStacks;
+
+    /**
+     * Guest memory access sampler.
+     *
+     * Records the data address of every memSamplePeriod guest
+     * loads. Only attached if sampling has been requested.
+     */
+    PerfKvmCounter hwMemSamples;
+
+    /** Loads between samples, 0 if not sampling */
+    const uint64_t memSamplePeriod;
+
+    /**
+     * Read the memory samples taken during the last guest entry and
+     * pass them on to the MemSamples probe.
+     */
+    void readMemSamples();
+
+    /** Addresses read from hwMemSamples */
+    ProbePoints::MemSamples memSamples;
+
+    ProbePointArg<ProbePoints::MemSamples> *ppMemSamples;
+
     /**
      * Does the runTimer control the performance counters?
      *
@@ -789,10 +848,15 @@ class BaseKvmCPU : public BaseCPU
         Stats::Scalar numExitSignal;
         Stats::Scalar numMMIO;
         Stats::Scalar numCoalescedMMIO;
+        Stats::Scalar numMMIONotifications;
         Stats::Scalar numIO;
         Stats::Scalar numHalt;
         Stats::Scalar numInterrupts;
         Stats::Scalar numHypercalls;
+        Stats::Scalar numBranchSamples;
+        Stats::Scalar numBranchSamplesLost;
+        Stats::Scalar numMemSamples;
+        Stats::Scalar numMemSamplesLost;
     } stats;
     /* @} */
 
@@ -180,7 +180,7 @@ PerfKvmCounter::attach(PerfKvmCounterConfig &config,
         panic("PerfKvmCounter::attach failed (%i)\n", errno);
     }
 
-    mmapPerf(1);
+    mmapPerf(config.dataPages);
 }
 
 pid_t
@@ -204,7 +204,7 @@ PerfKvmCounter::mmapPerf(int pages)
 
     ringNumPages = pages + 1;
     ringBuffer = (struct perf_event_mmap_page *)mmap(
-        NULL, ringNumPages * 4096,
+        NULL, ringNumPages * pageSize,
         PROT_READ | PROT_WRITE, MAP_SHARED,
         fd, 0);
     if (ringBuffer == MAP_FAILED)
@@ -212,6 +212,51 @@ PerfKvmCounter::mmapPerf(int pages)
               errno);
 }
 
+size_t
+PerfKvmCounter::readSamples(
+    const std::function<void(const struct perf_event_header &)> &handler)
+{
+    assert(ringBuffer);
+
+    const uint64_t data_size = (ringNumPages - 1) * pageSize;
+    const uint8_t *data = (const uint8_t *)ringBuffer + pageSize;
+    // The kernel updates data_head before writing the records behind
+    // it, which have to be read after it.
+    const uint64_t head = __atomic_load_n(&ringBuffer->data_head,
+                                          __ATOMIC_ACQUIRE);
+    uint64_t tail = ringBuffer->data_tail;
+    size_t records = 0;
+
+    while (tail < head) {
+        const uint64_t offset = tail % data_size;
+        struct perf_event_header header;
+        if (offset + sizeof(header) <= data_size) {
+            memcpy(&header, data + offset, sizeof(header));
+        } else {
+            const size_t first = data_size - offset;
+            memcpy(&header, data + offset, first);
+            memcpy((uint8_t *)&header + first, data, sizeof(header) - first);
+        }
+
+        if (offset + header.size <= data_size) {
+            handler(*(const struct perf_event_header *)(data + offset));
+        } else {
+            const size_t first = data_size - offset;
+            sampleBuffer.resize(header.size);
+            memcpy(sampleBuffer.data(), data + offset, first);
+            memcpy(sampleBuffer.data() + first, data, header.size - first);
+            handler(*(const struct perf_event_header *)sampleBuffer.data());
+        }
+
+        tail += header.size;
+        ++records;
+    }
+
+    // Hand the space back to the kernel once the records are consumed.
+    __atomic_store_n(&ringBuffer->data_tail, tail, __ATOMIC_RELEASE);
+    return records;
+}
+
 int
 PerfKvmCounter::fcntl(int cmd, long p1)
 {
@@ -43,6 +43,9 @@
 
 #include <inttypes.h>
 
+#include <functional>
+#include <vector>
+
 #include "config/have_perf_attr_exclude_host.hh"
 
 /**
@@ -101,6 +104,56 @@ class PerfKvmCounterConfig
         return *this;
     }
 
+    /**
+     * Set the information recorded in each sample, see the
+     * PERF_SAMPLE_* flags in perf_event.h. Samples are read with
+     * PerfKvmCounter::readSamples().
+     *
+     * @param type Bit mask of PERF_SAMPLE_* flags
+     */
+    PerfKvmCounterConfig &sampleType(uint64_t type) {
+        attr.sample_type = type;
+        return *this;
+    }
+
+    /**
+     * Record the branch stack (last branch records) with every
+     * sample. The type of branches recorded is selected with the
+     * PERF_SAMPLE_BRANCH_* flags in perf_event.h.
+     *
+     * @param type Bit mask of PERF_SAMPLE_BRANCH_* flags
+     */
+    PerfKvmCounterConfig &branchSampleType(uint64_t type) {
+        attr.sample_type |= PERF_SAMPLE_BRANCH_STACK;
+        attr.branch_sample_type = type;
+        if (attr.size < PERF_ATTR_SIZE_VER2)
+            attr.size = PERF_ATTR_SIZE_VER2;
+        return *this;
+    }
+
+    /**
+     * Set how precise the instruction and data address of a sample
+     * have to be, see precise_ip in perf_event.h. Precise samples use
+     * hardware support such as Intel's PEBS.
+     *
+     * @param level 0 for any skid up to 3 for no skid
+     */
+    PerfKvmCounterConfig &preciseIp(unsigned level) {
+        attr.precise_ip = level;
+        return *this;
+    }
+
+    /**
+     * Set the number of pages of the sample ring buffer. Counters
+     * that don't sample only need the default single page.
+     *
+     * @param pages Number of data pages, must be a power of 2
+     */
+    PerfKvmCounterConfig &ringPages(int pages) {
+        dataPages = pages;
+        return *this;
+    }
+
     /**
      * Don't start the performance counter automatically when
      * attaching it.
@@ -160,6 +213,9 @@ class PerfKvmCounterConfig
 
     /** Underlying perf_event_attr structure describing the counter */
     struct perf_event_attr attr;
+
+    /** Number of data pages of the sample ring buffer */
+    int dataPages = 1;
 };
 
 /**
@@ -297,6 +353,17 @@ public:
      */
     void enableSignals(int signal) { enableSignals(sysGettid(), signal); }
 
+    /**
+     * Consume the records written to the sample ring buffer since the
+     * last call. Records that wrap around the end of the buffer are
+     * copied, so the handler always sees a whole record.
+     *
+     * @param handler Called with each record, starting with its header
+     * @return Number of records read
+     */
+    size_t readSamples(
+        const std::function<void(const struct perf_event_header &)> &handler);
+
 private:
     // Disallow copying
     PerfKvmCounter(const PerfKvmCounter &that);
@@ -376,6 +443,9 @@ private:
 
     /** Cached host page size */
     long pageSize;
+
+    /** Buffer for records that wrap around the ring buffer */
+    std::vector<uint8_t> sampleBuffer;
 };
 
 #endif
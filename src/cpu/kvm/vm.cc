@@ -40,6 +40,7 @@
 
 #include <fcntl.h>
 #include <linux/kvm.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -131,6 +132,12 @@ Kvm::capCoalescedMMIO() const
     return checkExtension(KVM_CAP_COALESCED_MMIO);
 }
 
+bool
+Kvm::capIOEventFD() const
+{
+    return checkExtension(KVM_CAP_IOEVENTFD) != 0;
+}
+
 int
 Kvm::capNumMemSlots() const
 {
@@ -310,10 +317,26 @@ KvmVM::KvmVM(const KvmVMParams &params)
     /* Setup the coalesced MMIO regions */
     for (int i = 0; i < params.coalescedMMIO.size(); ++i)
         coalesceMMIO(params.coalescedMMIO[i]);
+
+    /* Setup the MMIO registers signalled through eventfds */
+    if (!params.notifyMMIO.empty() && !kvm->capIOEventFD()) {
+        warn("KVM: ioeventfd not supported by host OS, MMIO notify "
+             "registers will cause exits\n");
+    } else {
+        for (Addr addr : params.notifyMMIO) {
+            for (uint32_t value = 0; value < params.notifyMMIOValues;
+                 ++value) {
+                notifyMMIO(addr, value);
+            }
+        }
+    }
 }
 
 KvmVM::~KvmVM()
 {
+    for (const MMIONotifier &notifier : mmioNotifiers)
+        close(notifier.fd);
+
     if (vmFD != -1)
         close(vmFD);
 
@@ -330,6 +353,11 @@ KvmVM::notifyFork()
 
         vmFD = -1;
 
+        for (const MMIONotifier &notifier : mmioNotifiers)
+            close(notifier.fd);
+        mmioNotifiers.clear();
+        mmioNotifierFDs.clear();
+
         delete kvm;
         kvm = NULL;
     }
@@ -481,6 +509,54 @@ KvmVM::coalesceMMIO(Addr start, int size)
               errno);
 }
 
+void
+KvmVM::notifyMMIO(Addr addr, uint32_t value)
+{
+    const int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd == -1)
+        panic("KVM: Failed to create an eventfd (%i)\n", errno);
+
+    struct kvm_ioeventfd ioevent;
+    memset(&ioevent, 0, sizeof(ioevent));
+    ioevent.datamatch = value;
+    ioevent.addr = addr;
+    ioevent.len = sizeof(value);
+    ioevent.fd = fd;
+    ioevent.flags = KVM_IOEVENTFD_FLAG_DATAMATCH;
+
+    DPRINTF(Kvm, "KVM: Registering MMIO notifier (addr: 0x%x, value: %u)\n",
+            addr, value);
+    if (ioctl(KVM_IOEVENTFD, (void *)&ioevent) == -1)
+        panic("KVM: Failed to register MMIO notifier (%i)\n", errno);
+
+    mmioNotifiers.push_back({fd, addr, value});
+    mmioNotifierFDs.push_back({fd, POLLIN, 0});
+}
+
+void
+KvmVM::pollMMIONotifiers(std::vector<const MMIONotifier *> &signalled)
+{
+    signalled.clear();
+
+    // Look at all of the eventfds with a single system call, and only
+    // read the ones that were signalled.
+    int ready = poll(mmioNotifierFDs.data(), mmioNotifierFDs.size(), 0);
+    if (ready == -1 && errno != EINTR)
+        panic("KVM: Failed to poll the MMIO notifiers (%i)\n", errno);
+
+    for (int i = 0; ready > 0 && i < mmioNotifierFDs.size(); ++i) {
+        if (!(mmioNotifierFDs[i].revents & POLLIN))
+            continue;
+        --ready;
+
+        uint64_t count;
+        if (read(mmioNotifierFDs[i].fd, &count, sizeof(count)) ==
+            sizeof(count)) {
+            signalled.push_back(&mmioNotifiers[i]);
+        }
+    }
+}
+
 void
 KvmVM::setTSSAddress(Addr tss_address)
 {
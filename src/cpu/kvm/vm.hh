@@ -39,6 +39,8 @@
 #ifndef __CPU_KVM_KVMVM_HH__
 #define __CPU_KVM_KVMVM_HH__
 
+#include <poll.h>
+
 #include <vector>
 
 #include "base/addr_range.hh"
@@ -106,6 +108,9 @@ class Kvm
      */
     int capCoalescedMMIO() const;
 
+    /** Support for KvmVM::notifyMMIO(). */
+    bool capIOEventFD() const;
+
     /**
      * Attempt to determine how many memory slots are available. If it can't
      * be determined, this function returns 0.
@@ -321,6 +326,44 @@ class KvmVM : public SimObject
     void coalesceMMIO(const AddrRange &range);
     /** @} */
 
+    /**
+     * A register write that KVM signals through an eventfd instead of
+     * exiting to gem5.
+     */
+    struct MMIONotifier
+    {
+        /** eventfd signalled by the write */
+        int fd;
+        /** Physical address of the register */
+        Addr addr;
+        /** Value written */
+        uint32_t value;
+    };
+
+    /**
+     * Have KVM signal 4 byte writes of a value to an MMIO register,
+     * e.g., a virtio queue notify register, through an eventfd
+     * instead of exiting (KVM_IOEVENTFD). The guest continues right
+     * away, and the write is done later by whichever CPU polls the
+     * eventfd first. Writes of the same value that are signalled
+     * before they are polled are merged.
+     *
+     * @param addr Physical address of the register
+     * @param value Value written
+     */
+    void notifyMMIO(Addr addr, uint32_t value);
+
+    /**
+     * Find the notifier writes that were signalled since the last
+     * call, and clear them.
+     *
+     * @param signalled Filled with the signalled notifiers
+     */
+    void pollMMIONotifiers(std::vector<const MMIONotifier *> &signalled);
+
+    /** Are there any MMIO notifiers to poll? */
+    bool hasMMIONotifiers() const { return !mmioNotifiers.empty(); }
+
     /**
      * @addtogroup KvmInterrupts
      * @{
@@ -547,6 +590,10 @@ class KvmVM : public SimObject
     };
     std::vector<MemorySlot> memorySlots;
     uint32_t maxMemorySlot;
+
+    /** Registered MMIO notifiers and the poll set of their eventfds */
+    std::vector<MMIONotifier> mmioNotifiers;
+    std::vector<struct pollfd> mmioNotifierFDs;
 };
 
 #endif
@@ -277,6 +277,9 @@ class MinorCPU(BaseCPU):
 
     enableIdling = Param.Bool(True,
         "Enable cycle skipping when the processor is idle\n");
+    enableStageIdling = Param.Bool(True,
+        "Skip evaluating pipeline stages that have no work to do in a"
+        " cycle.  Only effective with enableIdling");
 
     branchPred = Param.BranchPredictor(TournamentBP(
         numThreads = Parent.numThreads), "Branch Predictor")
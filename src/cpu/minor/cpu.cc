@@ -48,7 +48,10 @@
 MinorCPU::MinorCPU(const MinorCPUParams &params) :
     BaseCPU(params),
     threadPolicy(params.threadPolicy),
-    stats(this)
+    /* The pool grows with the number of instructions in flight */
+    instPool(new DynInstPool(sizeof(Minor::MinorDynInst),
+                             DynInstPool::ChunkBlocks)),
+    stats(this, *instPool)
 {
     /* This is only written for one thread at the moment */
     Minor::MinorThread *thread;
@@ -47,6 +47,7 @@
 #include "cpu/minor/activity.hh"
 #include "cpu/minor/stats.hh"
 #include "cpu/base.hh"
+#include "cpu/dyn_inst_pool.hh"
 #include "cpu/simple_thread.hh"
 #include "enums/ThreadPolicy.hh"
 #include "params/MinorCPU.hh"
@@ -128,6 +129,11 @@ class MinorCPU : public BaseCPU
     void startup() override;
     void wakeup(ThreadID tid) override;
 
+    /** Storage of the dynamic instructions of this CPU. The pool is
+     *  never destroyed, since instructions may be held on to by other
+     *  objects until after the CPU is gone */
+    DynInstPool *instPool;
+
     /** Processor-specific statistics */
     Minor::MinorStats stats;
 
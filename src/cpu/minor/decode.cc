@@ -182,8 +182,8 @@ Decode::evaluate()
                         static_inst->fetchMicroop(
                                 decode_info.microopPC.microPC());
 
-                    output_inst =
-                        new MinorDynInst(static_micro_inst, inst->id);
+                    output_inst = new (*cpu.instPool)
+                        MinorDynInst(static_micro_inst, inst->id);
                     output_inst->pc = decode_info.microopPC;
                     output_inst->fault = NoFault;
 
@@ -293,6 +293,20 @@ Decode::evaluate()
         inputBuffer[inp.outputWire->threadId].pushTail();
 }
 
+bool
+Decode::needsToTick()
+{
+    if (!inp.outputWire->isBubble())
+        return true;
+
+    for (const auto &buffer : inputBuffer) {
+        if (!buffer.empty())
+            return true;
+    }
+
+    return false;
+}
+
 inline ThreadID
 Decode::getScheduledThread()
 {
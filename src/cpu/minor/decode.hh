@@ -149,6 +149,9 @@ class Decode : public Named
     /** Pass on input/buffer data to the output if you can */
     void evaluate();
 
+    /** Are there instructions for Decode to work on this cycle */
+    bool needsToTick();
+
     void minorTrace() const;
 
     /** Is this stage drained?  For Decoed, draining is initiated by
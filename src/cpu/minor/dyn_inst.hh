@@ -50,6 +50,7 @@
 
 #include "base/refcnt.hh"
 #include "base/types.hh"
+#include "cpu/dyn_inst_pool.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/minor/buffers.hh"
 #include "cpu/static_inst.hh"
@@ -154,7 +155,7 @@ std::ostream &operator <<(std::ostream &os, const MinorDynInst &inst);
  *  MinorDynInst implements the BubbleIF interface
  *  Has two separate notions of sequence number for pre/post-micro-op
  *  decomposition: fetchSeqNum and execSeqNum */
-class MinorDynInst : public RefCounted
+class MinorDynInst final : public RefCounted
 {
   private:
     /** A prototypical bubble instruction.  You must call MinorDynInst::init
@@ -243,6 +244,43 @@ class MinorDynInst : public RefCounted
         flatDestRegIdx(si ? si->numDestRegs() : 0)
     { }
 
+    /** Allocate an instruction from the recycling pool of its CPU. */
+    static void *
+    operator new(size_t size, DynInstPool &pool)
+    {
+        return pool.allocate(size);
+    }
+
+    static void *
+    operator new(size_t size)
+    {
+        return DynInstPool::allocateUnpooled(size);
+    }
+
+    static void
+    operator delete(void *p, DynInstPool &)
+    {
+        DynInstPool::deallocate(p);
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        DynInstPool::deallocate(p);
+    }
+
+    /** Drop a reference to the instruction, giving its storage straight
+     *  back to the pool with the last one */
+    void
+    decref() const
+    {
+        if (dropRef()) {
+            auto *inst = const_cast<MinorDynInst *>(this);
+            inst->MinorDynInst::~MinorDynInst();
+            DynInstPool::deallocate(inst);
+        }
+    }
+
   public:
     /** The BubbleIF interface. */
     bool isBubble() const { return id.fetchSeqNum == 0; }
@@ -1840,6 +1840,20 @@ Execute::drain()
     return (isDrained() ? 0 : 1);
 }
 
+bool
+Execute::needsToTick()
+{
+    if (!inp.outputWire->isBubble() || lsq.needsToTick())
+        return true;
+
+    for (ThreadID tid = 0; tid < cpu.numThreads; tid++) {
+        if (isInterrupted(tid))
+            return true;
+    }
+
+    return false;
+}
+
 bool
 Execute::isDrained()
 {
@@ -342,6 +342,11 @@ class Execute : public Named
     /** Pass on input/buffer data to the output if you can */
     void evaluate();
 
+    /** Has new input or an interrupt arrived for Execute?  Work on
+     *  instructions it already holds is signalled by Execute waking
+     *  itself up at the end of evaluate */
+    bool needsToTick();
+
     void minorTrace() const;
 
     /** After thread suspension, has Execute been drained of in-flight
@@ -702,6 +702,35 @@ Fetch1::evaluate()
     }
 }
 
+bool
+Fetch1::needsToTick()
+{
+    if (!inp.outputWire->isBubble() || !prediction.outputWire->isBubble())
+        return true;
+
+    if (!transfers.empty() && transfers.front()->isComplete())
+        return true;
+
+    if (icacheState == IcacheRunning && !requests.empty() &&
+        requests.front()->state != FetchRequest::InTranslation)
+    {
+        return true;
+    }
+
+    if (numInFlightFetches() < fetchLimit) {
+        for (ThreadID tid = 0; tid < cpu.numThreads; tid++) {
+            if (fetchInfo[tid].state == FetchRunning &&
+                nextStageReserve[tid].canReserve() &&
+                cpu.getContext(tid)->status() == ThreadContext::Active)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
 void
 Fetch1::wakeupFetch(ThreadID tid)
 {
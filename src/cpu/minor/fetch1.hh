@@ -51,6 +51,7 @@
 #include "cpu/minor/buffers.hh"
 #include "cpu/minor/cpu.hh"
 #include "cpu/minor/pipe_data.hh"
+#include "mem/mem_pool.hh"
 #include "mem/packet.hh"
 
 namespace Minor
@@ -177,10 +178,24 @@ class Fetch1 : public Named
             pc(pc_),
             fault(NoFault)
         {
-            request = std::make_shared<Request>();
+            request = Request::create();
         }
 
         ~FetchRequest();
+
+        /** One request is made for every line fetched, so take them
+         *  from the memory system object pool along with their packets */
+        static void *
+        operator new(size_t size)
+        {
+            return memPool().allocate(size);
+        }
+
+        static void
+        operator delete(void *p, size_t size)
+        {
+            memPool().deallocate(p, size);
+        }
     };
 
     typedef FetchRequest *FetchRequestPtr;
@@ -397,6 +412,11 @@ class Fetch1 : public Named
     /** Pass on input/buffer data to the output if you can */
     void evaluate();
 
+    /** Does Fetch1 have anything to do this cycle beyond what it has
+     *  already asked to be woken for?  That is, a branch to act on, a line
+     *  to issue or hand on, or room to fetch a new line */
+    bool needsToTick();
+
     /** Initiate fetch1 fetching */
     void wakeupFetch(ThreadID tid);
 
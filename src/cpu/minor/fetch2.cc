@@ -356,7 +356,7 @@ Fetch2::evaluate()
 
                 /* Make a new instruction and pick up the line, stream,
                  *  prediction, thread ids from the incoming line */
-                dyn_inst = new MinorDynInst(
+                dyn_inst = new (*cpu.instPool) MinorDynInst(
                         StaticInst::nullStaticInstPtr, line_in->id);
 
                 /* Fetch and prediction sequence numbers originate here */
@@ -402,7 +402,8 @@ Fetch2::evaluate()
 
                     /* Make a new instruction and pick up the line, stream,
                      *  prediction, thread ids from the incoming line */
-                    dyn_inst = new MinorDynInst(decoded_inst, line_in->id);
+                    dyn_inst = new (*cpu.instPool) MinorDynInst(
+                            decoded_inst, line_in->id);
 
                     /* Fetch and prediction sequence numbers originate here */
                     dyn_inst->id.fetchSeqNum = fetch_info.fetchSeqNum;
@@ -563,6 +564,20 @@ Fetch2::evaluate()
         inputBuffer[inp.outputWire->id.threadId].pushTail();
 }
 
+bool
+Fetch2::needsToTick()
+{
+    if (!inp.outputWire->isBubble() || !branchInp.outputWire->isBubble())
+        return true;
+
+    for (const auto &buffer : inputBuffer) {
+        if (!buffer.empty())
+            return true;
+    }
+
+    return false;
+}
+
 inline ThreadID
 Fetch2::getScheduledThread()
 {
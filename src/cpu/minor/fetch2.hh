@@ -216,6 +216,9 @@ class Fetch2 : public Named
     /** Pass on input/buffer data to the output if you can */
     void evaluate();
 
+    /** Is there a line or a branch for Fetch2 to work on this cycle */
+    bool needsToTick();
+
     void minorTrace() const;
 
 
@@ -55,6 +55,7 @@ Pipeline::Pipeline(MinorCPU &cpu_, const MinorCPUParams &params) :
     Ticked(cpu_, &(cpu_.BaseCPU::baseStats.numCycles)),
     cpu(cpu_),
     allow_idling(params.enableIdling),
+    allowStageIdling(params.enableIdling && params.enableStageIdling),
     f1ToF2(cpu.name() + ".f1ToF2", "lines",
         params.fetch1ToFetch2ForwardDelay),
     f2ToF1(cpu.name() + ".f2ToF1", "prediction",
@@ -82,6 +83,8 @@ Pipeline::Pipeline(MinorCPU &cpu_, const MinorCPUParams &params) :
         params.executeBranchDelay)))),
     needToSignalDrained(false)
 {
+    stageWanted.fill(true);
+
     if (params.fetch1ToFetch2ForwardDelay < 1) {
         fatal("%s: fetch1ToFetch2ForwardDelay must be >= 1 (%d)\n",
             cpu.name(), params.fetch1ToFetch2ForwardDelay);
@@ -126,11 +129,33 @@ Pipeline::evaluate()
 
     /* Note that it's important to evaluate the stages in order to allow
      *  'immediate', 0-time-offset TimeBuffer activity to be visible from
-     *  later stages to earlier ones in the same cycle */
-    execute.evaluate();
-    decode.evaluate();
-    fetch2.evaluate();
-    fetch1.evaluate();
+     *  later stages to earlier ones in the same cycle.
+     *
+     *  Stages with nothing to do are skipped.  A stage has work if it
+     *  asked to be woken for this cycle or has input to look at.  Execute
+     *  isn't evaluated just because it holds instructions as it wakes
+     *  itself whenever it could make progress with them next cycle.  A
+     *  blocked Execute then only runs again when its memory response
+     *  arrives */
+    if (canSkipStage(ExecuteStageId) && !execute.needsToTick())
+        cpu.stats.idleStageCycles[ExecuteStageId]++;
+    else
+        execute.evaluate();
+
+    if (canSkipStage(DecodeStageId) && !decode.needsToTick())
+        cpu.stats.idleStageCycles[DecodeStageId]++;
+    else
+        decode.evaluate();
+
+    if (canSkipStage(Fetch2StageId) && !fetch2.needsToTick())
+        cpu.stats.idleStageCycles[Fetch2StageId]++;
+    else
+        fetch2.evaluate();
+
+    if (canSkipStage(Fetch1StageId) && !fetch1.needsToTick())
+        cpu.stats.idleStageCycles[Fetch1StageId]++;
+    else
+        fetch1.evaluate();
 
     if (DTRACE(MinorTrace))
         minorTrace();
@@ -153,6 +178,10 @@ Pipeline::evaluate()
             stop();
         }
 
+        /* Remember which stages want to be evaluated next cycle */
+        for (unsigned int i = 0; i < Num_StageId; i++)
+            stageWanted[i] = activityRecorder.getStageActive(i);
+
         /* Deactivate all stages.  Note that the stages *could*
          *  activate and deactivate themselves but that's fraught
          *  with additional difficulty.
@@ -176,6 +205,18 @@ Pipeline::evaluate()
     }
 }
 
+bool
+Pipeline::canSkipStage(StageId stage_id) const
+{
+    /* Stages woken by events between cycles are still marked active in
+     *  the activity recorder */
+    return allowStageIdling && !needToSignalDrained &&
+        !stageWanted[CPUStageId] &&
+        !activityRecorder.getStageActive(CPUStageId) &&
+        !stageWanted[stage_id] &&
+        !activityRecorder.getStageActive(stage_id);
+}
+
 MinorCPU::MinorCPUPort &
 Pipeline::getInstPort()
 {
@@ -45,6 +45,8 @@
 #ifndef __CPU_MINOR_PIPELINE_HH__
 #define __CPU_MINOR_PIPELINE_HH__
 
+#include <array>
+
 #include "cpu/minor/activity.hh"
 #include "cpu/minor/cpu.hh"
 #include "cpu/minor/decode.hh"
@@ -74,6 +76,11 @@ class Pipeline : public Ticked
     /** Allow cycles to be skipped when the pipeline is idle */
     bool allow_idling;
 
+    /** Allow individual stages to be skipped when they have nothing to
+     *  do.  Needs allow_idling as stages only record that they want to
+     *  be evaluated when the pipeline can idle */
+    bool allowStageIdling;
+
     Latch<ForwardLineData> f1ToF2;
     Latch<BranchData> f2ToF1;
     Latch<ForwardInstData> f2ToD;
@@ -104,6 +111,17 @@ class Pipeline : public Ticked
     /** True after drain is called but draining isn't complete */
     bool needToSignalDrained;
 
+  protected:
+    /** Stages which asked to be evaluated in the next cycle.  These are
+     *  taken from the activity recorder just before it forgets them at
+     *  the end of evaluate */
+    std::array<bool, Num_StageId> stageWanted;
+
+    /** Can stage stage_id be skipped this cycle if it has no input?
+     *  True unless the stage, or the whole CPU, has been woken or
+     *  the pipeline is draining */
+    bool canSkipStage(StageId stage_id) const;
+
   public:
     Pipeline(MinorCPU &cpu_, const MinorCPUParams &params);
 
@@ -37,10 +37,12 @@
 
 #include "cpu/minor/stats.hh"
 
+#include "cpu/minor/pipeline.hh"
+
 namespace Minor
 {
 
-MinorStats::MinorStats(BaseCPU *base_cpu)
+MinorStats::MinorStats(BaseCPU *base_cpu, const DynInstPool &inst_pool)
     : Stats::Group(base_cpu),
     ADD_STAT(numInsts, UNIT_COUNT, "Number of instructions committed"),
     ADD_STAT(numOps, UNIT_COUNT,
@@ -53,14 +55,36 @@ MinorStats::MinorStats(BaseCPU *base_cpu)
     ADD_STAT(quiesceCycles, UNIT_CYCLE,
              "Total number of cycles that CPU has spent quiesced or waiting "
              "for an interrupt"),
+    ADD_STAT(idleStageCycles, UNIT_CYCLE,
+             "Number of cycles each pipeline stage was skipped as it had "
+             "nothing to do"),
     ADD_STAT(cpi, UNIT_RATE(Stats::Units::Cycle, Stats::Units::Count),
              "CPI: cycles per instruction"),
     ADD_STAT(ipc, UNIT_RATE(Stats::Units::Count, Stats::Units::Cycle),
              "IPC: instructions per cycle"),
-    ADD_STAT(committedInstType, UNIT_COUNT, "Class of committed instruction")
+    ADD_STAT(committedInstType, UNIT_COUNT, "Class of committed instruction"),
+    ADD_STAT(instAllocs, UNIT_COUNT,
+             "Number of dynamic instructions allocated"),
+    ADD_STAT(instAllocHits, UNIT_COUNT,
+             "Number of dynamic instructions allocated from recycled "
+             "storage"),
+    ADD_STAT(instPoolSize, UNIT_COUNT,
+             "Number of dynamic instructions the instruction pool has "
+             "storage for"),
+    ADD_STAT(instPoolPeak, UNIT_COUNT,
+             "High-water mark of the number of live dynamic instructions")
 {
     quiesceCycles.prereq(quiesceCycles);
 
+    idleStageCycles
+        .init(Pipeline::Num_StageId)
+        .subname(Pipeline::CPUStageId, "cpu")
+        .subname(Pipeline::Fetch1StageId, "fetch1")
+        .subname(Pipeline::Fetch2StageId, "fetch2")
+        .subname(Pipeline::DecodeStageId, "decode")
+        .subname(Pipeline::ExecuteStageId, "execute")
+        .flags(Stats::nozero);
+
     cpi.precision(6);
     cpi = base_cpu->baseStats.numCycles / numInsts;
 
@@ -71,6 +95,12 @@ MinorStats::MinorStats(BaseCPU *base_cpu)
         .init(base_cpu->numThreads, Enums::Num_OpClass)
         .flags(Stats::total | Stats::pdf | Stats::dist);
     committedInstType.ysubnames(Enums::OpClassStrings);
+
+    const DynInstPool *pool = &inst_pool;
+    instAllocs.functor([pool]() { return pool->stats().allocs; });
+    instAllocHits.functor([pool]() { return pool->stats().hits; });
+    instPoolSize.functor([pool]() { return pool->stats().reserved; });
+    instPoolPeak.functor([pool]() { return pool->stats().peak; });
 }
 
 };
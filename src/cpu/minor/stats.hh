@@ -46,6 +46,7 @@
 
 #include "base/statistics.hh"
 #include "cpu/base.hh"
+#include "cpu/dyn_inst_pool.hh"
 #include "sim/ticked_object.hh"
 
 namespace Minor
@@ -54,7 +55,7 @@ namespace Minor
 /** Currently unused stats class. */
 struct MinorStats : public Stats::Group
 {
-    MinorStats(BaseCPU *parent);
+    MinorStats(BaseCPU *parent, const DynInstPool &inst_pool);
 
     /** Number of simulated instructions */
     Stats::Scalar numInsts;
@@ -71,6 +72,10 @@ struct MinorStats : public Stats::Group
     /** Number of cycles in quiescent state */
     Stats::Scalar quiesceCycles;
 
+    /** Number of cycles each pipeline stage was skipped as it had
+     *  nothing to do */
+    Stats::Vector idleStageCycles;
+
     /** CPI/IPC for total cycle counts and macro insts */
     Stats::Formula cpi;
     Stats::Formula ipc;
@@ -78,6 +83,15 @@ struct MinorStats : public Stats::Group
     /** Number of instructions by type (OpClass) */
     Stats::Vector2d committedInstType;
 
+    /** Number of dynamic instructions allocated */
+    Stats::Value instAllocs;
+    /** Number of instructions allocated from recycled storage */
+    Stats::Value instAllocHits;
+    /** Number of instructions the pool has storage for */
+    Stats::Value instPoolSize;
+    /** Most instructions alive at the same time */
+    Stats::Value instPoolPeak;
+
 };
 
 }
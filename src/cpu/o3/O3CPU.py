@@ -71,6 +71,8 @@ class DerivO3CPU(BaseCPU):
         return True
 
     activity = Param.Unsigned(0, "Initial count")
+    skipMemStalls = Param.Bool(False, "Stop ticking while the pipeline "
+        "can only wait for the load at the head of the ROB")
 
     cacheStorePorts = Param.Unsigned(200, "Cache Ports. "
           "Constrains stores only.")
@@ -86,6 +88,9 @@ class DerivO3CPU(BaseCPU):
     fetchBufferSize = Param.Unsigned(64, "Fetch buffer size in bytes")
     fetchQueueSize = Param.Unsigned(32, "Fetch queue size in micro-ops "
                                     "per-thread")
+    fetchTargetQueueSize = Param.Unsigned(0, "Number of fetch buffer blocks "
+        "the BTB-driven fetch target queue runs ahead of fetch, prefetching "
+        "them into the ICache (0 disables it, needs classic caches)")
 
     renameToDecodeDelay = Param.Cycles(1, "Rename to decode delay")
     iewToDecodeDelay = Param.Cycles(1, "Issue/Execute/Writeback to decode "
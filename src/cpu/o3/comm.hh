@@ -49,6 +49,20 @@
 #include "cpu/inst_seq.hh"
 #include "sim/faults.hh"
 
+/**
+ * Drop the instructions a stage structure holds. Stages fill the
+ * instruction array from the front and count them in size, so nothing
+ * past that needs to be touched when a time buffer slot is reused.
+ */
+template<class DynInstPtr>
+inline void
+releaseInsts(DynInstPtr *insts, int &size)
+{
+    for (int i = 0; i < size; ++i)
+        insts[i] = nullptr;
+    size = 0;
+}
+
 /** Struct that defines the information passed from fetch to decode. */
 template<class Impl>
 struct DefaultFetchDefaultDecode {
@@ -60,6 +74,15 @@ struct DefaultFetchDefaultDecode {
     Fault fetchFault;
     InstSeqNum fetchFaultSN;
     bool clearFetchFault;
+
+    void
+    reset()
+    {
+        releaseInsts(insts, size);
+        fetchFault = NoFault;
+        fetchFaultSN = 0;
+        clearFetchFault = false;
+    }
 };
 
 /** Struct that defines the information passed from decode to rename. */
@@ -70,6 +93,8 @@ struct DefaultDecodeDefaultRename {
     int size;
 
     DynInstPtr insts[Impl::MaxWidth];
+
+    void reset() { releaseInsts(insts, size); }
 };
 
 /** Struct that defines the information passed from rename to IEW. */
@@ -80,6 +105,8 @@ struct DefaultRenameDefaultIEW {
     int size;
 
     DynInstPtr insts[Impl::MaxWidth];
+
+    void reset() { releaseInsts(insts, size); }
 };
 
 /** Struct that defines the information passed from IEW to commit. */
@@ -99,6 +126,22 @@ struct DefaultIEWDefaultCommit {
     bool branchMispredict[Impl::MaxThreads];
     bool branchTaken[Impl::MaxThreads];
     bool includeSquashInst[Impl::MaxThreads];
+
+    /** The PC is only looked at when squash is set, so it is left as is. */
+    void
+    reset()
+    {
+        releaseInsts(insts, size);
+        for (int tid = 0; tid < Impl::MaxThreads; ++tid) {
+            mispredictInst[tid] = nullptr;
+            mispredPC[tid] = 0;
+            squashedSeqNum[tid] = 0;
+            squash[tid] = false;
+            branchMispredict[tid] = false;
+            branchTaken[tid] = false;
+            includeSquashInst[tid] = false;
+        }
+    }
 };
 
 template<class Impl>
@@ -108,6 +151,8 @@ struct IssueStruct {
     int size;
 
     DynInstPtr insts[Impl::MaxWidth];
+
+    void reset() { releaseInsts(insts, size); }
 };
 
 /** Struct that defines all backwards communication. */
@@ -84,6 +84,7 @@ class DefaultCommit
     // Typedefs from the Impl.
     typedef typename Impl::O3CPU O3CPU;
     typedef typename Impl::DynInstPtr DynInstPtr;
+    typedef typename Impl::ThreadIDList ThreadIDList;
     typedef typename Impl::CPUPol CPUPol;
 
     typedef typename CPUPol::RenameMap RenameMap;
@@ -170,7 +171,7 @@ class DefaultCommit
     IEW *iewStage;
 
     /** Sets pointer to list of active threads. */
-    void setActiveThreads(std::list<ThreadID> *at_ptr);
+    void setActiveThreads(ThreadIDList *at_ptr);
 
     /** Sets pointer to the commited state rename map. */
     void setRenameMap(RenameMap rm_ptr[Impl::MaxThreads]);
@@ -196,6 +197,11 @@ class DefaultCommit
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /** Is the head of the ROB a load that is waiting for memory, with
+     *  nothing else commit could do in the meantime?
+     */
+    bool waitingOnMemory(ThreadID tid) const;
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
@@ -390,7 +396,7 @@ class DefaultCommit
     DynInstPtr squashAfterInst[Impl::MaxThreads];
 
     /** Priority List used for Commit Policy */
-    std::list<ThreadID> priority_list;
+    ThreadIDList priority_list;
 
     /** IEW to Commit delay. */
     const Cycles iewToCommitDelay;
@@ -459,7 +465,7 @@ class DefaultCommit
     bool checkEmptyROB[Impl::MaxThreads];
 
     /** Pointer to the list of active threads. */
-    std::list<ThreadID> *activeThreads;
+    ThreadIDList *activeThreads;
 
     /** Rename map interface. */
     RenameMap *renameMap[Impl::MaxThreads];
@@ -297,7 +297,7 @@ DefaultCommit<Impl>::setIEWStage(IEW *iew_stage)
 
 template<class Impl>
 void
-DefaultCommit<Impl>::setActiveThreads(std::list<ThreadID> *at_ptr)
+DefaultCommit<Impl>::setActiveThreads(ThreadIDList *at_ptr)
 {
     activeThreads = at_ptr;
 }
@@ -413,6 +413,21 @@ DefaultCommit<Impl>::isDrained() const
         interrupt == NoFault;
 }
 
+template <class Impl>
+bool
+DefaultCommit<Impl>::waitingOnMemory(ThreadID tid) const
+{
+    if (commitStatus[tid] != Running || trapInFlight[tid] ||
+            tcSquash[tid] || squashAfterInst[tid] || interrupt != NoFault ||
+            rob->isEmpty(tid)) {
+        return false;
+    }
+
+    const DynInstPtr &head = rob->readHeadInst(tid);
+    return head->isLoad() && head->isIssued() && !head->isExecuted() &&
+        !head->isSquashed() && !head->readyToCommit();
+}
+
 template <class Impl>
 void
 DefaultCommit<Impl>::takeOverFrom()
@@ -433,8 +448,8 @@ template <class Impl>
 void
 DefaultCommit<Impl>::deactivateThread(ThreadID tid)
 {
-    std::list<ThreadID>::iterator thread_it = std::find(priority_list.begin(),
-            priority_list.end(), tid);
+    auto thread_it = std::find(priority_list.begin(),
+                               priority_list.end(), tid);
 
     if (thread_it != priority_list.end()) {
         priority_list.erase(thread_it);
@@ -468,8 +483,8 @@ void
 DefaultCommit<Impl>::updateStatus()
 {
     // reset ROB changed variable
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -498,8 +513,8 @@ template <class Impl>
 bool
 DefaultCommit<Impl>::changedROBEntries()
 {
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -666,8 +681,8 @@ DefaultCommit<Impl>::tick()
     if (activeThreads->empty())
         return;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     // Check if any of the threads are done squashing.  Change the
     // status if they are done.
@@ -827,8 +842,8 @@ DefaultCommit<Impl>::commit()
     ////////////////////////////////////
     // Check for any possible squashes, handle them first
     ////////////////////////////////////
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     int num_squashing_threads = 0;
 
@@ -1533,8 +1548,8 @@ template<class Impl>
 ThreadID
 DefaultCommit<Impl>::roundRobin()
 {
-    std::list<ThreadID>::iterator pri_iter = priority_list.begin();
-    std::list<ThreadID>::iterator end      = priority_list.end();
+    auto pri_iter = priority_list.begin();
+    auto end = priority_list.end();
 
     while (pri_iter != end) {
         ThreadID tid = *pri_iter;
@@ -1564,8 +1579,8 @@ DefaultCommit<Impl>::oldestReady()
     unsigned oldest = 0;
     bool first = true;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -80,6 +80,12 @@ FullO3CPU<Impl>::FullO3CPU(const DerivO3CPUParams &params)
 #ifndef NDEBUG
       instcount(0),
 #endif
+      // Room for a full ROB and full fetch queues, the pool grows if
+      // more instructions are in flight.
+      instPool(new DynInstPool(sizeof(typename Impl::DynInst),
+                               params.numROBEntries +
+                               params.numThreads * params.fetchQueueSize)),
+      instList(2 * params.numROBEntries),
       removeInstsThisCycle(false),
       fetch(this, params),
       decode(this, params),
@@ -118,11 +124,17 @@ FullO3CPU<Impl>::FullO3CPU(const DerivO3CPUParams &params)
       globalSeqNum(1),
       system(params.system),
       lastRunningCycle(curCycle()),
+      skipMemStalls(params.skipMemStalls),
+      memStalled(false),
       cpuStats(this)
 {
     fatal_if(FullSystem && params.numThreads > 1,
             "SMT is not supported in O3 in full system mode currently.");
 
+    fatal_if(params.numThreads > Impl::MaxThreads,
+            "O3 CPU %s has %d threads, but was built with O3_MAX_THREADS=%d.",
+            name(), params.numThreads, Impl::MaxThreads);
+
     fatal_if(!FullSystem && params.numThreads < params.workload.size(),
             "More workload items (%d) than threads (%d) on CPU %s.",
             params.workload.size(), params.numThreads, name());
@@ -188,9 +200,9 @@ FullO3CPU<Impl>::FullO3CPU(const DerivO3CPUParams &params)
         active_threads = params.workload.size();
 
         if (active_threads > Impl::MaxThreads) {
-            panic("Workload Size too large. Increase the 'MaxThreads' "
-                  "constant in your O3CPU impl. file (e.g. o3/alpha/impl.hh) "
-                  "or edit your workload size.");
+            panic("Workload Size too large. Rebuild with a larger "
+                  "O3_MAX_THREADS (currently %d) or edit your workload "
+                  "size.", Impl::MaxThreads);
         }
     }
 
@@ -414,7 +426,23 @@ FullO3CPUStats::FullO3CPUStats(FullO3CPU *cpu)
       ADD_STAT(ccRegfileReads, UNIT_COUNT, "number of cc regfile reads"),
       ADD_STAT(ccRegfileWrites, UNIT_COUNT, "number of cc regfile writes"),
       ADD_STAT(miscRegfileReads, UNIT_COUNT, "number of misc regfile reads"),
-      ADD_STAT(miscRegfileWrites, UNIT_COUNT, "number of misc regfile writes")
+      ADD_STAT(miscRegfileWrites, UNIT_COUNT, "number of misc regfile writes"),
+      ADD_STAT(memStalls, UNIT_COUNT,
+               "Number of times the CPU stopped ticking while only waiting "
+               "for memory"),
+      ADD_STAT(memStallCycles, UNIT_CYCLE,
+               "Number of cycles the CPU didn't tick while only waiting for "
+               "memory"),
+      ADD_STAT(instAllocs, UNIT_COUNT,
+               "Number of dynamic instructions allocated"),
+      ADD_STAT(instAllocHits, UNIT_COUNT,
+               "Number of dynamic instructions allocated from recycled "
+               "storage"),
+      ADD_STAT(instPoolSize, UNIT_COUNT,
+               "Number of dynamic instructions the instruction pool has "
+               "storage for"),
+      ADD_STAT(instPoolPeak, UNIT_COUNT,
+               "High-water mark of the number of live dynamic instructions")
 {
     // Register any of the O3CPU's stats here.
     timesIdled
@@ -489,6 +517,12 @@ FullO3CPUStats::FullO3CPUStats(FullO3CPU *cpu)
 
     miscRegfileWrites
         .prereq(miscRegfileWrites);
+
+    const DynInstPool *pool = cpu->instPool;
+    instAllocs.functor([pool]() { return pool->stats().allocs; });
+    instAllocHits.functor([pool]() { return pool->stats().hits; });
+    instPoolSize.functor([pool]() { return pool->stats().reserved; });
+    instPoolPeak.functor([pool]() { return pool->stats().peak; });
 }
 
 template <class Impl>
@@ -501,6 +535,7 @@ FullO3CPU<Impl>::tick()
 
     ++baseStats.numCycles;
     updateCycleCounters(BaseCPU::CPU_STATE_ON);
+    memStalled = false;
 
 //    activity = false;
 
@@ -538,6 +573,11 @@ FullO3CPU<Impl>::tick()
             DPRINTF(O3CPU, "Idle!\n");
             lastRunningCycle = curCycle();
             cpuStats.timesIdled++;
+        } else if (stalledOnMemory()) {
+            DPRINTF(O3CPU, "Stalled on memory!\n");
+            lastRunningCycle = curCycle();
+            memStalled = true;
+            cpuStats.memStalls++;
         } else {
             schedule(tickEvent, clockEdge(Cycles(1)));
             DPRINTF(O3CPU, "Scheduling next tick!\n");
@@ -550,6 +590,40 @@ FullO3CPU<Impl>::tick()
     tryDrain();
 }
 
+template <class Impl>
+bool
+FullO3CPU<Impl>::stalledOnMemory()
+{
+    if (!skipMemStalls || activeThreads.empty() ||
+            drainState() != DrainState::Running) {
+        return false;
+    }
+
+    // Anything sent between the stages in the last few cycles shows up
+    // in the activity count on top of the active stages.
+    int active_stages = 0;
+    for (int idx = 0; idx < NumStages; ++idx)
+        active_stages += activityRec.getStageActive(idx);
+    if (activityRec.getActivityCount() != active_stages)
+        return false;
+
+    if (activityRec.getStageActive(DecodeIdx) ||
+            activityRec.getStageActive(RenameIdx) ||
+            activityRec.getStageActive(CommitIdx)) {
+        return false;
+    }
+
+    if (!fetch.isStalled() || !iew.isIdle())
+        return false;
+
+    for (ThreadID tid : activeThreads) {
+        if (!commit.waitingOnMemory(tid))
+            return false;
+    }
+
+    return true;
+}
+
 template <class Impl>
 void
 FullO3CPU<Impl>::init()
@@ -588,7 +662,7 @@ template <class Impl>
 void
 FullO3CPU<Impl>::activateThread(ThreadID tid)
 {
-    std::list<ThreadID>::iterator isActive =
+    auto isActive =
         std::find(activeThreads.begin(), activeThreads.end(), tid);
 
     DPRINTF(O3CPU, "[tid:%i] Calling activate thread.\n", tid);
@@ -611,7 +685,7 @@ FullO3CPU<Impl>::deactivateThread(ThreadID tid)
     assert(!commit.executingHtmTransaction(tid));
 
     //Remove From Active List, if Active
-    std::list<ThreadID>::iterator thread_it =
+    auto thread_it =
         std::find(activeThreads.begin(), activeThreads.end(), tid);
 
     DPRINTF(O3CPU, "[tid:%i] Calling deactivate thread.\n", tid);
@@ -1478,6 +1552,10 @@ template <class Impl>
 typename FullO3CPU<Impl>::ListIt
 FullO3CPU<Impl>::addInst(const DynInstPtr &inst)
 {
+    // The front end may hold more instructions than just the ROB, grow
+    // rather than overwrite the oldest ones
+    if (instList.full())
+        instList.grow(2 * instList.capacity());
     instList.push_back(inst);
 
     return --(instList.end());
@@ -1578,16 +1656,14 @@ FullO3CPU<Impl>::removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid)
             "list that are from [tid:%i] and above [sn:%lli] (end=%lli).\n",
             tid, seq_num, (*inst_iter)->seqNum);
 
-    while ((*inst_iter)->seqNum > seq_num) {
-
-        bool break_loop = (inst_iter == instList.begin());
-
+    // Entries cleared in an earlier cycle are skipped over
+    while (!*inst_iter || (*inst_iter)->seqNum > seq_num) {
         squashInstIt(inst_iter, tid);
 
-        inst_iter--;
-
-        if (break_loop)
+        if (inst_iter == instList.begin())
             break;
+
+        inst_iter--;
     }
 }
 
@@ -1595,7 +1671,7 @@ template <class Impl>
 inline void
 FullO3CPU<Impl>::squashInstIt(const ListIt &instIt, ThreadID tid)
 {
-    if ((*instIt)->threadNumber == tid) {
+    if (*instIt && (*instIt)->threadNumber == tid) {
         DPRINTF(O3CPU, "Squashing instruction, "
                 "[tid:%i] [sn:%lli] PC %s\n",
                 (*instIt)->threadNumber,
@@ -1617,17 +1693,26 @@ void
 FullO3CPU<Impl>::cleanUpRemovedInsts()
 {
     while (!removeList.empty()) {
+        DynInstPtr &inst = *removeList.front();
+        removeList.pop();
+
+        // An instruction may have been squashed twice in a cycle
+        if (!inst)
+            continue;
+
         DPRINTF(O3CPU, "Removing instruction, "
                 "[tid:%i] [sn:%lli] PC %s\n",
-                (*removeList.front())->threadNumber,
-                (*removeList.front())->seqNum,
-                (*removeList.front())->pcState());
+                inst->threadNumber, inst->seqNum, inst->pcState());
 
-        instList.erase(removeList.front());
-
-        removeList.pop();
+        inst = nullptr;
     }
 
+    // Drop the cleared entries at both ends of the list
+    while (!instList.empty() && !instList.front())
+        instList.pop_front();
+    while (!instList.empty() && !instList.back())
+        instList.pop_back();
+
     removeInstsThisCycle = false;
 }
 /*
@@ -1649,6 +1734,10 @@ FullO3CPU<Impl>::dumpInsts()
     cprintf("Dumping Instruction List\n");
 
     while (inst_list_it != instList.end()) {
+        if (!*inst_list_it) {
+            inst_list_it++;
+            continue;
+        }
         cprintf("Instruction:%i\nPC:%#x\n[tid:%i]\n[sn:%lli]\nIssued:%i\n"
                 "Squashed:%i\n\n",
                 num, (*inst_list_it)->instAddr(), (*inst_list_it)->threadNumber,
@@ -1670,6 +1759,22 @@ template <class Impl>
 void
 FullO3CPU<Impl>::wakeCPU()
 {
+    if (memStalled && !tickEvent.scheduled()) {
+        DPRINTF(Activity, "Waking up CPU stalled on memory\n");
+
+        memStalled = false;
+        Cycles cycles(curCycle() - lastRunningCycle);
+        // Same accounting as for an idle CPU below.
+        if (cycles > 1) {
+            --cycles;
+            cpuStats.memStallCycles += cycles;
+            baseStats.numCycles += cycles;
+        }
+
+        schedule(tickEvent, clockEdge());
+        return;
+    }
+
     if (activityRec.active() || tickEvent.scheduled()) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
@@ -1722,7 +1827,7 @@ FullO3CPU<Impl>::updateThreadPriority()
     if (activeThreads.size() > 1) {
         //DEFAULT TO ROUND ROBIN SCHEME
         //e.g. Move highest priority to end of thread list
-        std::list<ThreadID>::iterator list_begin = activeThreads.begin();
+        auto list_begin = activeThreads.begin();
 
         unsigned high_thread = *list_begin;
 
@@ -1820,7 +1925,7 @@ FullO3CPU<Impl>::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
     RequestPtr req =
-        std::make_shared<Request>(addr, size, flags, _dataRequestorId);
+        Request::create(addr, size, flags, _dataRequestorId);
 
     req->taskId(taskId());
     req->setContext(this->thread[tid]->contextId());
@@ -51,6 +51,7 @@
 
 #include "arch/generic/types.hh"
 #include "arch/types.hh"
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "config/the_isa.hh"
 #include "cpu/o3/comm.hh"
@@ -59,6 +60,7 @@
 #include "cpu/o3/thread_state.hh"
 #include "cpu/activity.hh"
 #include "cpu/base.hh"
+#include "cpu/dyn_inst_pool.hh"
 #include "cpu/simple_thread.hh"
 #include "cpu/timebuf.hh"
 #include "params/DerivO3CPU.hh"
@@ -95,11 +97,12 @@ class FullO3CPU : public BaseO3CPU
     typedef typename Impl::CPUPol CPUPolicy;
     typedef typename Impl::DynInstPtr DynInstPtr;
     typedef typename Impl::O3CPU O3CPU;
+    typedef typename Impl::ThreadIDList ThreadIDList;
 
     typedef O3ThreadState<Impl> ImplState;
     typedef O3ThreadState<Impl> Thread;
 
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename CircularQueue<DynInstPtr>::iterator ListIt;
 
     friend class O3ThreadContext<Impl>;
 
@@ -515,8 +518,20 @@ class FullO3CPU : public BaseO3CPU
     int instcount;
 #endif
 
-    /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    /** Storage of the dynamic instructions of this CPU. The pool is
+     *  never destroyed, since instructions may be held on to by other
+     *  objects, e.g. the checker, until after the CPU is gone.
+     */
+    DynInstPool *instPool;
+
+    /** List of all the instructions in flight, oldest first. The
+     *  entries of removed instructions are cleared at the end of the
+     *  cycle, and only dropped once they reach either end of the ring, so
+     *  the iterators of the remaining instructions stay valid. Entries
+     *  can be left in the middle when the instructions of one SMT thread
+     *  are squashed.
+     */
+    CircularQueue<DynInstPtr> instList;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
@@ -570,7 +585,7 @@ class FullO3CPU : public BaseO3CPU
     typename CPUPolicy::ROB rob;
 
     /** Active Threads List */
-    std::list<ThreadID> activeThreads;
+    ThreadIDList activeThreads;
 
     /**
      *  This is a list of threads that are trying to exit. Each thread id
@@ -681,6 +696,23 @@ class FullO3CPU : public BaseO3CPU
     /** The cycle that the CPU was last running, used for statistics. */
     Cycles lastRunningCycle;
 
+    /** Stop ticking when the pipeline is stalled on memory. */
+    const bool skipMemStalls;
+
+    /** Is the CPU descheduled until a load at the ROB head completes,
+     *  even though the activity recorder says it is active?
+     */
+    bool memStalled;
+
+    /**
+     * Check if the pipeline can do nothing but wait for the loads at
+     * the head of the ROBs: commit is waiting on them, no stage has
+     * any work left and there is no communication in flight between
+     * the stages. Fetch may still be marked active, but it can't make
+     * progress either.
+     */
+    bool stalledOnMemory();
+
     /** The cycle that the CPU was last activated by a new thread*/
     Tick lastActivatedCycle;
 
@@ -771,6 +803,21 @@ class FullO3CPU : public BaseO3CPU
         //number of misc
         Stats::Scalar miscRegfileReads;
         Stats::Scalar miscRegfileWrites;
+
+        /** Number of times the CPU stopped ticking while stalled on
+         *  memory. */
+        Stats::Scalar memStalls;
+        /** Number of cycles skipped while stalled on memory. */
+        Stats::Scalar memStallCycles;
+
+        /** Number of dynamic instructions allocated. */
+        Stats::Value instAllocs;
+        /** Number of instructions allocated from recycled storage. */
+        Stats::Value instAllocHits;
+        /** Number of instructions the pool has storage for. */
+        Stats::Value instPoolSize;
+        /** Most instructions alive at the same time. */
+        Stats::Value instPoolPeak;
     } cpuStats;
 
   public:
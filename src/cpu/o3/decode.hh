@@ -62,6 +62,7 @@ class DefaultDecode
     // Typedefs from the Impl.
     typedef typename Impl::O3CPU O3CPU;
     typedef typename Impl::DynInstPtr DynInstPtr;
+    typedef typename Impl::ThreadIDList ThreadIDList;
     typedef typename Impl::CPUPol CPUPol;
 
     // Typedefs from the CPU policy.
@@ -119,7 +120,7 @@ class DefaultDecode
     void setFetchQueue(TimeBuffer<FetchStruct> *fq_ptr);
 
     /** Sets pointer to list of active threads. */
-    void setActiveThreads(std::list<ThreadID> *at_ptr);
+    void setActiveThreads(ThreadIDList *at_ptr);
 
     /** Perform sanity checks after a drain. */
     void drainSanityCheck() const;
@@ -275,7 +276,7 @@ class DefaultDecode
     ThreadID numThreads;
 
     /** List of active thread ids */
-    std::list<ThreadID> *activeThreads;
+    ThreadIDList *activeThreads;
 
     /** Maximum size of the skid buffer. */
     unsigned skidBufferMax;
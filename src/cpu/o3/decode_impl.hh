@@ -191,7 +191,7 @@ DefaultDecode<Impl>::setFetchQueue(TimeBuffer<FetchStruct> *fq_ptr)
 
 template<class Impl>
 void
-DefaultDecode<Impl>::setActiveThreads(std::list<ThreadID> *at_ptr)
+DefaultDecode<Impl>::setActiveThreads(ThreadIDList *at_ptr)
 {
     activeThreads = at_ptr;
 }
@@ -416,8 +416,8 @@ template<class Impl>
 bool
 DefaultDecode<Impl>::skidsEmpty()
 {
-    list<ThreadID>::iterator threads = activeThreads->begin();
-    list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -434,8 +434,8 @@ DefaultDecode<Impl>::updateStatus()
 {
     bool any_unblocking = false;
 
-    list<ThreadID>::iterator threads = activeThreads->begin();
-    list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -558,8 +558,8 @@ DefaultDecode<Impl>::tick()
 
     toRenameIndex = 0;
 
-    list<ThreadID>::iterator threads = activeThreads->begin();
-    list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     sortInsts();
 
@@ -41,6 +41,8 @@
 #ifndef __CPU_O3_DEP_GRAPH_HH__
 #define __CPU_O3_DEP_GRAPH_HH__
 
+#include <vector>
+
 #include "cpu/o3/comm.hh"
 
 /** Node in a linked list. */
@@ -48,14 +50,18 @@ template <class DynInstPtr>
 class DependencyEntry
 {
   public:
+    /** Index terminating a list. */
+    static const int End = -1;
+
     DependencyEntry()
-        : inst(NULL), next(NULL)
+        : inst(NULL), next(End)
     { }
 
     DynInstPtr inst;
     //Might want to include data about what arch. register the
     //dependence is waiting on.
-    DependencyEntry<DynInstPtr> *next;
+    /** Index of the next node in the storage of the graph. */
+    int next;
 };
 
 /** Array of linked list that maintains the dependencies between
@@ -66,6 +72,12 @@ class DependencyEntry
  * the producing instruction of that register.  Instructions are put
  * on the list upon reaching the IQ, and are removed from the list
  * either when the producer completes, or the instruction is squashed.
+ *
+ * The nodes of all the lists live in a single flat array, linked by
+ * index, and are recycled through a free list. The array is sized up
+ * front for the expected number of consumers and only grows if that
+ * turns out to be too small, so inserting and removing consumers
+ * doesn't allocate memory.
 */
 template <class DynInstPtr>
 class DependencyGraph
@@ -75,13 +87,17 @@ class DependencyGraph
 
     /** Default construction.  Must call resize() prior to use. */
     DependencyGraph()
-        : numEntries(0), memAllocCounter(0), nodesTraversed(0), nodesRemoved(0)
+        : numEntries(0), freeNodes(DepEntry::End), memAllocCounter(0),
+          nodesTraversed(0), nodesRemoved(0)
     { }
 
     ~DependencyGraph();
 
-    /** Resize the dependency graph to have num_entries registers. */
-    void resize(int num_entries);
+    /**
+     * Resize the dependency graph to have num_entries registers, with
+     * room for num_nodes consumers before it has to grow.
+     */
+    void resize(int num_entries, int num_nodes=0);
 
     /** Clears all of the linked lists. */
     void reset();
@@ -107,24 +123,34 @@ class DependencyGraph
     bool empty() const;
 
     /** Checks if there are any dependents on a specific register. */
-    bool empty(PhysRegIndex idx) const { return !dependGraph[idx].next; }
+    bool empty(PhysRegIndex idx) const
+    { return dependGraph[idx].next == DepEntry::End; }
 
     /** Debugging function to dump out the dependency graph.
      */
     void dump();
 
   private:
-    /** Array of linked lists.  Each linked list is a list of all the
-     *  instructions that depend upon a given register.  The actual
-     *  register's index is used to index into the graph; ie all
-     *  instructions in flight that are dependent upon r34 will be
-     *  in the linked list of dependGraph[34].
+    /** Take a node off the free list, growing the storage if needed. */
+    int allocNode();
+
+    /** Put a node back on the free list. */
+    void freeNode(int node);
+
+    /** Storage of the linked lists. The first numEntries entries are
+     *  the heads of the lists, one per register; ie all instructions
+     *  in flight that are dependent upon r34 will be in the linked
+     *  list starting at dependGraph[34]. The nodes of the lists take
+     *  up the rest of the array.
      */
     std::vector<DepEntry> dependGraph;
 
     /** Number of linked lists; identical to the number of registers. */
     int numEntries;
 
+    /** Head of the list of unused nodes. */
+    int freeNodes;
+
     // Debug variable, remove when done testing.
     unsigned memAllocCounter;
 
@@ -142,10 +168,41 @@ DependencyGraph<DynInstPtr>::~DependencyGraph()
 
 template <class DynInstPtr>
 void
-DependencyGraph<DynInstPtr>::resize(int num_entries)
+DependencyGraph<DynInstPtr>::resize(int num_entries, int num_nodes)
 {
     numEntries = num_entries;
-    dependGraph.resize(numEntries);
+    dependGraph.clear();
+    dependGraph.resize(numEntries + num_nodes);
+    memAllocCounter = 0;
+
+    freeNodes = DepEntry::End;
+    for (int node = numEntries + num_nodes - 1; node >= numEntries; --node)
+        freeNode(node);
+}
+
+template <class DynInstPtr>
+int
+DependencyGraph<DynInstPtr>::allocNode()
+{
+    int node = freeNodes;
+    if (node == DepEntry::End) {
+        node = dependGraph.size();
+        dependGraph.emplace_back();
+    } else {
+        freeNodes = dependGraph[node].next;
+    }
+
+    ++memAllocCounter;
+    return node;
+}
+
+template <class DynInstPtr>
+void
+DependencyGraph<DynInstPtr>::freeNode(int node)
+{
+    dependGraph[node].inst = NULL;
+    dependGraph[node].next = freeNodes;
+    freeNodes = node;
 }
 
 template <class DynInstPtr>
@@ -153,27 +210,22 @@ void
 DependencyGraph<DynInstPtr>::reset()
 {
     // Clear the dependency graph
-    DepEntry *curr;
-    DepEntry *prev;
-
     for (int i = 0; i < numEntries; ++i) {
-        curr = dependGraph[i].next;
+        int curr = dependGraph[i].next;
 
-        while (curr) {
+        while (curr != DepEntry::End) {
             memAllocCounter--;
 
-            prev = curr;
-            curr = prev->next;
-            prev->inst = NULL;
-
-            delete prev;
+            int next = dependGraph[curr].next;
+            freeNode(curr);
+            curr = next;
         }
 
         if (dependGraph[i].inst) {
             dependGraph[i].inst = NULL;
         }
 
-        dependGraph[i].next = NULL;
+        dependGraph[i].next = DepEntry::End;
     }
 }
 
@@ -186,15 +238,14 @@ DependencyGraph<DynInstPtr>::insert(PhysRegIndex idx,
     //chain.
 
     // First create the entry that will be added to the head of the
-    // dependency chain.
-    DepEntry *new_entry = new DepEntry;
-    new_entry->next = dependGraph[idx].next;
-    new_entry->inst = new_inst;
+    // dependency chain. This may grow the storage, so no references
+    // into it are taken before.
+    int new_entry = allocNode();
+    dependGraph[new_entry].next = dependGraph[idx].next;
+    dependGraph[new_entry].inst = new_inst;
 
     // Then actually add it to the chain.
     dependGraph[idx].next = new_entry;
-
-    ++memAllocCounter;
 }
 
 
@@ -203,52 +254,48 @@ void
 DependencyGraph<DynInstPtr>::remove(PhysRegIndex idx,
                                     const DynInstPtr &inst_to_remove)
 {
-    DepEntry *prev = &dependGraph[idx];
-    DepEntry *curr = dependGraph[idx].next;
-
-    // Make sure curr isn't NULL.  Because this instruction is being
-    // removed from a dependency list, it must have been placed there at
-    // an earlier time.  The dependency chain should not be empty,
-    // unless the instruction dependent upon it is already ready.
-    if (curr == NULL) {
+    int prev = idx;
+    int curr = dependGraph[idx].next;
+
+    // Make sure curr isn't the end of the list.  Because this
+    // instruction is being removed from a dependency list, it must have
+    // been placed there at an earlier time.  The dependency chain should
+    // not be empty, unless the instruction dependent upon it is already
+    // ready.
+    if (curr == DepEntry::End) {
         return;
     }
 
     nodesRemoved++;
 
     // Find the instruction to remove within the dependency linked list.
-    while (curr->inst != inst_to_remove) {
+    while (dependGraph[curr].inst != inst_to_remove) {
         prev = curr;
-        curr = curr->next;
+        curr = dependGraph[curr].next;
         nodesTraversed++;
 
-        assert(curr != NULL);
+        assert(curr != DepEntry::End);
     }
 
     // Now remove this instruction from the list.
-    prev->next = curr->next;
+    dependGraph[prev].next = dependGraph[curr].next;
 
     --memAllocCounter;
 
-    // Could push this off to the destructor of DependencyEntry
-    curr->inst = NULL;
-
-    delete curr;
+    freeNode(curr);
 }
 
 template <class DynInstPtr>
 DynInstPtr
 DependencyGraph<DynInstPtr>::pop(PhysRegIndex idx)
 {
-    DepEntry *node;
-    node = dependGraph[idx].next;
+    int node = dependGraph[idx].next;
     DynInstPtr inst = NULL;
-    if (node) {
-        inst = node->inst;
-        dependGraph[idx].next = node->next;
-        node->inst = NULL;
+    if (node != DepEntry::End) {
+        inst = std::move(dependGraph[node].inst);
+        dependGraph[idx].next = dependGraph[node].next;
         memAllocCounter--;
-        delete node;
+        freeNode(node);
     }
     return inst;
 }
@@ -268,24 +315,21 @@ template <class DynInstPtr>
 void
 DependencyGraph<DynInstPtr>::dump()
 {
-    DepEntry *curr;
-
     for (int i = 0; i < numEntries; ++i)
     {
-        curr = &dependGraph[i];
+        const DepEntry &head = dependGraph[i];
 
-        if (curr->inst) {
+        if (head.inst) {
             cprintf("dependGraph[%i]: producer: %s [sn:%lli] consumer: ",
-                    i, curr->inst->pcState(), curr->inst->seqNum);
+                    i, head.inst->pcState(), head.inst->seqNum);
         } else {
             cprintf("dependGraph[%i]: No producer. consumer: ", i);
         }
 
-        while (curr->next != NULL) {
-            curr = curr->next;
-
-            cprintf("%s [sn:%lli] ",
-                    curr->inst->pcState(), curr->inst->seqNum);
+        for (int curr = head.next; curr != DepEntry::End;
+                curr = dependGraph[curr].next) {
+            cprintf("%s [sn:%lli] ", dependGraph[curr].inst->pcState(),
+                    dependGraph[curr].inst->seqNum);
         }
 
         cprintf("\n");
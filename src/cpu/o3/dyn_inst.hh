@@ -48,13 +48,14 @@
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/isa_specific.hh"
 #include "cpu/base_dyn_inst.hh"
+#include "cpu/dyn_inst_pool.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/reg_class.hh"
 
 class Packet;
 
 template <class Impl>
-class BaseO3DynInst : public BaseDynInst<Impl>
+class BaseO3DynInst final : public BaseDynInst<Impl>
 {
   public:
     /** Typedef for the CPU. */
@@ -75,6 +76,47 @@ class BaseO3DynInst : public BaseDynInst<Impl>
 
     ~BaseO3DynInst();
 
+    /** Allocate an instruction from the recycling pool of its CPU. */
+    static void *
+    operator new(size_t size, DynInstPool &pool)
+    {
+        return pool.allocate(size);
+    }
+
+    static void *
+    operator new(size_t size)
+    {
+        return DynInstPool::allocateUnpooled(size);
+    }
+
+    static void
+    operator delete(void *p, DynInstPool &)
+    {
+        DynInstPool::deallocate(p);
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        DynInstPool::deallocate(p);
+    }
+
+    /**
+     * Drop a reference to the instruction. Instructions are never
+     * derived from, so the last reference destroys the instruction
+     * without going through the virtual destructor and gives its
+     * storage straight back to the pool.
+     */
+    void
+    decref() const
+    {
+        if (this->dropRef()) {
+            auto *inst = const_cast<BaseO3DynInst *>(this);
+            inst->BaseO3DynInst::~BaseO3DynInst();
+            DynInstPool::deallocate(inst);
+        }
+    }
+
     /** Executes the instruction.*/
     Fault execute();
 
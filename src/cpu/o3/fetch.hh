@@ -75,6 +75,7 @@ class DefaultFetch
     typedef typename Impl::CPUPol CPUPol;
     typedef typename Impl::DynInst DynInst;
     typedef typename Impl::DynInstPtr DynInstPtr;
+    typedef typename Impl::ThreadIDList ThreadIDList;
     typedef typename Impl::O3CPU O3CPU;
 
     /** Typedefs from the CPU policy. */
@@ -205,7 +206,7 @@ class DefaultFetch
     SMTFetchPolicy fetchPolicy;
 
     /** List that has the threads organized by priority. */
-    std::list<ThreadID> priorityList;
+    ThreadIDList priorityList;
 
     /** Probe points. */
     ProbePointArg<DynInstPtr> *ppFetch;
@@ -227,7 +228,7 @@ class DefaultFetch
     void setTimeBuffer(TimeBuffer<TimeStruct> *time_buffer);
 
     /** Sets pointer to list of active threads. */
-    void setActiveThreads(std::list<ThreadID> *at_ptr);
+    void setActiveThreads(ThreadIDList *at_ptr);
 
     /** Sets pointer to time buffer used to communicate to the next stage. */
     void setFetchQueue(TimeBuffer<FetchStruct> *fq_ptr);
@@ -253,6 +254,11 @@ class DefaultFetch
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /** Is fetch unable to make progress until it is woken up, e.g. by
+     *  an icache response or by decode unblocking?
+     */
+    bool isStalled() const;
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
@@ -335,6 +341,17 @@ class DefaultFetch
     /** Checks if a thread is stalled. */
     bool checkStall(ThreadID tid) const;
 
+    /** Moves the fetch target queue of a thread along to the block being
+     * fetched and fills it up with the blocks the BTB predicts will be
+     * fetched next, prefetching them into the ICache.
+     */
+    void runAheadFetchTargets(ThreadID tid, Addr fetch_addr);
+
+    /** Sends an ICache prefetch for the fetch buffer block at block_pc, if
+     * it lies in the page of the last instruction translation.
+     */
+    void prefetchFetchTarget(ThreadID tid, Addr block_pc);
+
     /** Updates overall fetch stage status; to be called at the end of each
      * cycle. */
     FetchStatus updateFetchStatus();
@@ -510,6 +527,23 @@ class DefaultFetch
     /** Whether or not the fetch buffer data is valid. */
     bool fetchBufferValid[Impl::MaxThreads];
 
+    /** The number of fetch buffer blocks the fetch target queue runs ahead
+     * of fetch, zero if it is disabled. */
+    const unsigned fetchTargetQueueSize;
+
+    /** Addresses fetch is predicted to enter its next fetch buffer blocks
+     * at, starting with where it is in the block being fetched. */
+    std::deque<Addr> fetchTargetQueue[Impl::MaxThreads];
+
+    /** Virtual and physical page of the last instruction translation, so
+     * fetch targets on that page can be prefetched without the ITLB. */
+    Addr ftqVirtPage[Impl::MaxThreads];
+    Addr ftqPhysPage[Impl::MaxThreads];
+    bool ftqPageValid[Impl::MaxThreads];
+
+    /** Number of fetch target prefetches the ICache has not answered. */
+    unsigned ftqPrefetchesInFlight;
+
     /** Size of instructions. */
     int instSize;
 
@@ -517,7 +551,7 @@ class DefaultFetch
     Counter lastIcacheStall[Impl::MaxThreads];
 
     /** List of Active Threads */
-    std::list<ThreadID> *activeThreads;
+    ThreadIDList *activeThreads;
 
     /** Number of threads. */
     ThreadID numThreads;
@@ -592,6 +626,10 @@ class DefaultFetch
          * due to a squash.
          */
         Stats::Scalar tlbSquashes;
+        /** Number of blocks prefetched by the fetch target queue. */
+        Stats::Scalar ftqPrefetches;
+        /** Number of times fetch left the path of the fetch target queue. */
+        Stats::Scalar ftqResteers;
         /** Distribution of number of instructions fetched each cycle. */
         Stats::Distribution nisnDist;
         /** Rate of how often fetch was idle. */
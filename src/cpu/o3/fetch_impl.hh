@@ -50,6 +50,7 @@
 
 #include "arch/generic/tlb.hh"
 #include "arch/utility.hh"
+#include "base/intmath.hh"
 #include "base/random.hh"
 #include "base/types.hh"
 #include "config/the_isa.hh"
@@ -88,6 +89,8 @@ DefaultFetch<Impl>::DefaultFetch(O3CPU *_cpu, const DerivO3CPUParams &params)
       fetchBufferSize(params.fetchBufferSize),
       fetchBufferMask(fetchBufferSize - 1),
       fetchQueueSize(params.fetchQueueSize),
+      fetchTargetQueueSize(params.fetchTargetQueueSize),
+      ftqPrefetchesInFlight(0),
       numThreads(params.numThreads),
       numFetchingThreads(params.smtNumFetchingThreads),
       icachePort(this, _cpu),
@@ -125,6 +128,9 @@ DefaultFetch<Impl>::DefaultFetch(O3CPU *_cpu, const DerivO3CPUParams &params)
         fetchBufferValid[i] = false;
         lastIcacheStall[i] = 0;
         issuePipelinedIfetch[i] = false;
+        ftqVirtPage[i] = 0;
+        ftqPhysPage[i] = 0;
+        ftqPageValid[i] = false;
     }
 
     branchPred = params.branchPred;
@@ -194,6 +200,11 @@ FetchStatGroup::FetchStatGroup(O3CPU *cpu, DefaultFetch *fetch)
              "Number of outstanding Icache misses that were squashed"),
     ADD_STAT(tlbSquashes, UNIT_COUNT,
              "Number of outstanding ITLB misses that were squashed"),
+    ADD_STAT(ftqPrefetches, UNIT_COUNT,
+             "Number of fetch buffer blocks prefetched by the fetch target "
+             "queue"),
+    ADD_STAT(ftqResteers, UNIT_COUNT,
+             "Number of times fetch left the path of the fetch target queue"),
     ADD_STAT(nisnDist, UNIT_COUNT,
              "Number of instructions fetched each cycle (Total)"),
     ADD_STAT(idleRate, UNIT_RATIO, "Ratio of cycles fetch was idle",
@@ -240,6 +251,10 @@ FetchStatGroup::FetchStatGroup(O3CPU *cpu, DefaultFetch *fetch)
             .prereq(icacheSquashes);
         tlbSquashes
             .prereq(tlbSquashes);
+        ftqPrefetches
+            .prereq(ftqPrefetches);
+        ftqResteers
+            .prereq(ftqResteers);
         nisnDist
             .init(/* base value */ 0,
               /* last value */ fetch->fetchWidth,
@@ -267,7 +282,7 @@ DefaultFetch<Impl>::setTimeBuffer(TimeBuffer<TimeStruct> *time_buffer)
 
 template<class Impl>
 void
-DefaultFetch<Impl>::setActiveThreads(std::list<ThreadID> *at_ptr)
+DefaultFetch<Impl>::setActiveThreads(ThreadIDList *at_ptr)
 {
     activeThreads = at_ptr;
 }
@@ -307,6 +322,8 @@ DefaultFetch<Impl>::clearStates(ThreadID tid)
     fetchBufferPC[tid] = 0;
     fetchBufferValid[tid] = false;
     fetchQueue[tid].clear();
+    fetchTargetQueue[tid].clear();
+    ftqPageValid[tid] = false;
 
     // TODO not sure what to do with priorityList for now
     // priorityList.push_back(tid);
@@ -339,6 +356,8 @@ DefaultFetch<Impl>::resetStage()
         fetchBufferValid[tid] = false;
 
         fetchQueue[tid].clear();
+        fetchTargetQueue[tid].clear();
+        ftqPageValid[tid] = false;
 
         priorityList.push_back(tid);
     }
@@ -351,6 +370,14 @@ template<class Impl>
 void
 DefaultFetch<Impl>::processCacheCompletion(PacketPtr pkt)
 {
+    // Prefetches of the fetch target queue only warm the ICache.
+    if (pkt->req->isPrefetch()) {
+        assert(ftqPrefetchesInFlight > 0);
+        --ftqPrefetchesInFlight;
+        delete pkt;
+        return;
+    }
+
     ThreadID tid = cpu->contextToThread(pkt->req->contextId());
 
     DPRINTF(Fetch, "[tid:%i] Waking up from cache miss.\n", tid);
@@ -434,6 +461,10 @@ DefaultFetch<Impl>::isDrained() const
         if (!fetchQueue[i].empty())
             return false;
 
+        // Wait for the fetch target queue prefetches to come back
+        if (ftqPrefetchesInFlight)
+            return false;
+
         // Return false if not idle or drain stalled
         if (fetchStatus[i] != Idle) {
             if (fetchStatus[i] == Blocked && stalls[i].drain)
@@ -450,6 +481,28 @@ DefaultFetch<Impl>::isDrained() const
     return !finishTranslationEvent.scheduled();
 }
 
+template <class Impl>
+bool
+DefaultFetch<Impl>::isStalled() const
+{
+    for (ThreadID tid : *activeThreads) {
+        switch (fetchStatus[tid]) {
+          case Running:
+            if (!stalls[tid].decode &&
+                    fetchQueue[tid].size() < fetchQueueSize) {
+                return false;
+            }
+            break;
+          case Squashing:
+          case IcacheAccessComplete:
+            return false;
+          default:
+            break;
+        }
+    }
+    return true;
+}
+
 template <class Impl>
 void
 DefaultFetch<Impl>::takeOverFrom()
@@ -595,7 +648,7 @@ DefaultFetch<Impl>::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
     // Setup the memReq to do a read of the first instruction's address.
     // Set the appropriate read size and flags as well.
     // Build request here.
-    RequestPtr mem_req = std::make_shared<Request>(
+    RequestPtr mem_req = Request::create(
         fetchBufferBlockPC, fetchBufferSize,
         Request::INST_FETCH, cpu->instRequestorId(), pc,
         cpu->thread[tid]->contextId());
@@ -647,6 +700,11 @@ DefaultFetch<Impl>::finishTranslation(const Fault &fault,
             return;
         }
 
+        const Addr page_bytes = cpu->system->getPageBytes();
+        ftqVirtPage[tid] = roundDown(mem_req->getVaddr(), page_bytes);
+        ftqPhysPage[tid] = roundDown(mem_req->getPaddr(), page_bytes);
+        ftqPageValid[tid] = true;
+
         // Build packet here.
         PacketPtr data_pkt = new Packet(mem_req, MemCmd::ReadReq);
         data_pkt->dataDynamic(new uint8_t[fetchBufferSize]);
@@ -760,6 +818,7 @@ DefaultFetch<Impl>::doSquash(const TheISA::PCState &newPC,
 
     // Empty fetch queue
     fetchQueue[tid].clear();
+    fetchTargetQueue[tid].clear();
 
     // microops are being squashed, it is not known wheather the
     // youngest non-squashed microop was  marked delayed commit
@@ -806,8 +865,8 @@ typename DefaultFetch<Impl>::FetchStatus
 DefaultFetch<Impl>::updateFetchStatus()
 {
     //Check Running
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -859,8 +918,8 @@ template <class Impl>
 void
 DefaultFetch<Impl>::tick()
 {
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
     bool status_change = false;
 
     wroteToTimeBuffer = false;
@@ -1073,7 +1132,8 @@ DefaultFetch<Impl>::buildInst(ThreadID tid, StaticInstPtr staticInst,
 
     // Create a new DynInst from the instruction fetched.
     DynInstPtr instruction =
-        new DynInst(staticInst, curMacroop, thisPC, nextPC, seq, cpu);
+        new (*cpu->instPool) DynInst(staticInst, curMacroop, thisPC, nextPC,
+                                     seq, cpu);
     instruction->setTid(tid);
 
     instruction->setThreadState(cpu->thread[tid]);
@@ -1146,6 +1206,13 @@ DefaultFetch<Impl>::fetch(bool &status_change)
 
     bool inRom = isRomMicroPC(thisPC.microPC());
 
+    if (fetchTargetQueueSize && !stalls[tid].drain &&
+        (fetchStatus[tid] == Running ||
+         fetchStatus[tid] == IcacheWaitResponse ||
+         fetchStatus[tid] == IcacheAccessComplete)) {
+        runAheadFetchTargets(tid, fetchAddr);
+    }
+
     // If returning from the delay of a cache miss, then update the status
     // to running, otherwise do the cache access.  Possibly move this up
     // to tick() function.
@@ -1376,6 +1443,79 @@ DefaultFetch<Impl>::fetch(bool &status_change)
         !curMacroop;
 }
 
+template<class Impl>
+void
+DefaultFetch<Impl>::runAheadFetchTargets(ThreadID tid, Addr fetch_addr)
+{
+    std::deque<Addr> &ftq = fetchTargetQueue[tid];
+    const Addr block_pc = fetchBufferAlignPC(fetch_addr);
+
+    // Retire the blocks fetch has gone past. If fetch is not on the
+    // predicted path anymore start over from where it is.
+    auto it = std::find_if(ftq.begin(), ftq.end(), [&](Addr entry) {
+        return fetchBufferAlignPC(entry) == block_pc;
+    });
+    if (it == ftq.end()) {
+        if (!ftq.empty())
+            ++fetchStats.ftqResteers;
+        ftq.clear();
+        ftq.push_back(fetch_addr);
+    } else {
+        ftq.erase(ftq.begin(), it);
+        ftq.front() = fetch_addr;
+    }
+
+    while (ftq.size() <= fetchTargetQueueSize && !cacheBlocked) {
+        const Addr back = ftq.back();
+        const Addr next = branchPred->predictBlockExit(
+                tid, back, fetchBufferAlignPC(back) + fetchBufferSize);
+
+        // A block looping onto itself adds nothing more to prefetch.
+        if (next == back)
+            break;
+
+        DPRINTF(Fetch, "[tid:%i] Fetch target queue runs ahead to %#x.\n",
+                tid, next);
+        ftq.push_back(next);
+        prefetchFetchTarget(tid, fetchBufferAlignPC(next));
+    }
+}
+
+template<class Impl>
+void
+DefaultFetch<Impl>::prefetchFetchTarget(ThreadID tid, Addr block_pc)
+{
+    // Without the ITLB only blocks on the last translated page can be
+    // prefetched.
+    const Addr page_bytes = cpu->system->getPageBytes();
+    if (!ftqPageValid[tid] ||
+        roundDown(block_pc, page_bytes) != ftqVirtPage[tid] ||
+        (fetchBufferValid[tid] && block_pc == fetchBufferPC[tid])) {
+        return;
+    }
+
+    RequestPtr req = Request::create(
+        ftqPhysPage[tid] + (block_pc - ftqVirtPage[tid]), fetchBufferSize,
+        Request::INST_FETCH | Request::PREFETCH, cpu->instRequestorId());
+    req->taskId(cpu->taskId());
+
+    PacketPtr pkt = new Packet(req, MemCmd::SoftPFReq);
+    pkt->allocate();
+
+    if (!icachePort.sendTimingReq(pkt)) {
+        // recvReqRetry clears the blocked cache when there is no demand
+        // request waiting to be retried.
+        DPRINTF(Fetch, "[tid:%i] Fetch target prefetch of %#x blocked.\n",
+                tid, block_pc);
+        delete pkt;
+        cacheBlocked = true;
+        return;
+    }
+
+    ++ftqPrefetchesInFlight;
+    ++fetchStats.ftqPrefetches;
+}
+
 template<class Impl>
 void
 DefaultFetch<Impl>::recvReqRetry()
@@ -1425,7 +1565,7 @@ DefaultFetch<Impl>::getFetchingThread()
             return InvalidThreadID;
         }
     } else {
-        std::list<ThreadID>::iterator thread = activeThreads->begin();
+        auto thread = activeThreads->begin();
         if (thread == activeThreads->end()) {
             return InvalidThreadID;
         }
@@ -1447,8 +1587,8 @@ template<class Impl>
 ThreadID
 DefaultFetch<Impl>::roundRobin()
 {
-    std::list<ThreadID>::iterator pri_iter = priorityList.begin();
-    std::list<ThreadID>::iterator end      = priorityList.end();
+    auto pri_iter = priorityList.begin();
+    auto end = priorityList.end();
 
     ThreadID high_pri;
 
@@ -1482,8 +1622,8 @@ DefaultFetch<Impl>::iqCount()
                         std::greater<unsigned> > PQ;
     std::map<unsigned, ThreadID> threadMap;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -1519,8 +1659,8 @@ DefaultFetch<Impl>::lsqCount()
                         std::greater<unsigned> > PQ;
     std::map<unsigned, ThreadID> threadMap;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -40,6 +40,17 @@ UnifiedFreeList::UnifiedFreeList(const std::string &_my_name,
 {
     DPRINTF(FreeList, "Creating new free list object.\n");
 
+    auto set_regs = [this](SimpleFreeList &list, RegClass cls) {
+        auto range = regFile->getRegIds(cls);
+        list.setRegs(range.first, range.second);
+    };
+    set_regs(intList, IntRegClass);
+    set_regs(floatList, FloatRegClass);
+    set_regs(vecList, VecRegClass);
+    set_regs(vecElemList, VecElemClass);
+    set_regs(predList, VecPredRegClass);
+    set_regs(ccList, CCRegClass);
+
     // Have the register file initialize the free list since it knows
     // about its internal organization
     regFile->initFreeList(this);
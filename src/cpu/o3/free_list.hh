@@ -42,9 +42,12 @@
 #ifndef __CPU_O3_FREE_LIST_HH__
 #define __CPU_O3_FREE_LIST_HH__
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
-#include <queue>
+#include <vector>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/o3/comm.hh"
@@ -57,44 +60,94 @@
  * determined by the rename map instance being accessed, all
  * architectural register index parameters and values in this class
  * are relative (e.g., %fp2 is just index 2).
+ *
+ * The list keeps one bit per register of its class, which are stored
+ * contiguously by the register file, so a register is found from its
+ * position in that storage and the lowest free one is handed out
+ * first.
  */
 class SimpleFreeList
 {
   private:
 
-    /** The actual free list */
-    std::queue<PhysRegIdPtr> freeRegs;
+    /** The registers this list can hold. */
+    PhysRegIdPtr regs = nullptr;
+    size_t numRegs = 0;
+
+    /** One bit per register, set if the register is free. */
+    std::vector<uint64_t> freeMask;
+
+    /** The number of free registers. */
+    unsigned numFree = 0;
+
+    /** No word of freeMask below this one has a bit set. */
+    size_t firstWord = 0;
+
+    size_t
+    slot(PhysRegIdPtr reg) const
+    {
+        assert(reg >= regs && reg < regs + numRegs);
+        return reg - regs;
+    }
 
   public:
 
     SimpleFreeList() {};
 
+    /**
+     * Set the registers which can be put on this list. This has to be
+     * called before any of them are added.
+     */
+    template<class InputIt>
+    void
+    setRegs(InputIt first, InputIt last)
+    {
+        assert(!numFree);
+        numRegs = last - first;
+        regs = numRegs ? &*first : nullptr;
+        freeMask.assign((numRegs + 63) / 64, 0);
+        firstWord = freeMask.size();
+    }
+
     /** Add a physical register to the free list */
-    void addReg(PhysRegIdPtr reg) { freeRegs.push(reg); }
+    void
+    addReg(PhysRegIdPtr reg)
+    {
+        size_t idx = slot(reg);
+        uint64_t bit = 1ULL << (idx % 64);
+        assert(!(freeMask[idx / 64] & bit));
+        freeMask[idx / 64] |= bit;
+        firstWord = std::min(firstWord, idx / 64);
+        ++numFree;
+    }
 
     /** Add physical registers to the free list */
     template<class InputIt>
     void
     addRegs(InputIt first, InputIt last) {
         std::for_each(first, last, [this](typename InputIt::value_type& reg) {
-            this->freeRegs.push(&reg);
+            this->addReg(&reg);
         });
     }
 
     /** Get the next available register from the free list */
     PhysRegIdPtr getReg()
     {
-        assert(!freeRegs.empty());
-        PhysRegIdPtr free_reg = freeRegs.front();
-        freeRegs.pop();
-        return free_reg;
+        assert(numFree);
+        while (!freeMask[firstWord])
+            ++firstWord;
+        uint64_t &word = freeMask[firstWord];
+        size_t idx = firstWord * 64 + ctz64(word);
+        word &= word - 1;
+        --numFree;
+        return regs + idx;
     }
 
     /** Return the number of free registers on the list. */
-    unsigned numFreeRegs() const { return freeRegs.size(); }
+    unsigned numFreeRegs() const { return numFree; }
 
     /** True iff there are free registers on the list. */
-    bool hasFreeRegs() const { return !freeRegs.empty(); }
+    bool hasFreeRegs() const { return numFree != 0; }
 };
 
 
@@ -296,8 +349,6 @@ UnifiedFreeList::addReg(PhysRegIdPtr freed_reg)
 {
     DPRINTF(FreeList,"Freeing register %i (%s).\n", freed_reg->index(),
             freed_reg->className());
-    //Might want to add in a check for whether or not this register is
-    //already in there.  A bit vector or something similar would be useful.
     switch (freed_reg->classValue()) {
         case IntRegClass:
             intList.addReg(freed_reg);
@@ -321,18 +372,6 @@ UnifiedFreeList::addReg(PhysRegIdPtr freed_reg)
             panic("Unexpected RegClass (%s)",
                                    freed_reg->className());
     }
-
-    // These assert conditions ensure that the number of free
-    // registers are not more than the # of total Physical  Registers.
-    // If this were false, it would mean that registers
-    // have been freed twice, overflowing the free register
-    // pool and potentially crashing SMT workloads.
-    // ----
-    // Comment out for now so as to not potentially break
-    // CMP and single-threaded workloads
-    // ----
-    // assert(freeIntRegs.size() <= numPhysicalIntRegs);
-    // assert(freeFloatRegs.size() <= numPhysicalFloatRegs);
 }
 
 
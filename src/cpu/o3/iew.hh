@@ -81,6 +81,7 @@ class DefaultIEW
     //Typedefs from Impl
     typedef typename Impl::CPUPol CPUPol;
     typedef typename Impl::DynInstPtr DynInstPtr;
+    typedef typename Impl::ThreadIDList ThreadIDList;
     typedef typename Impl::O3CPU O3CPU;
 
     typedef typename CPUPol::IQ IQ;
@@ -155,7 +156,7 @@ class DefaultIEW
     void setIEWQueue(TimeBuffer<IEWStruct> *iq_ptr);
 
     /** Sets pointer to list of active threads. */
-    void setActiveThreads(std::list<ThreadID> *at_ptr);
+    void setActiveThreads(ThreadIDList *at_ptr);
 
     /** Sets pointer to the scoreboard. */
     void setScoreboard(Scoreboard *sb_ptr);
@@ -166,6 +167,9 @@ class DefaultIEW
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /** Does the stage have nothing to issue or write back? */
+    bool isIdle();
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
@@ -418,7 +422,7 @@ class DefaultIEW
     ThreadID numThreads;
 
     /** Pointer to list of active threads. */
-    std::list<ThreadID> *activeThreads;
+    ThreadIDList *activeThreads;
 
     /** Maximum size of the skid buffer. */
     unsigned skidBufferMax;
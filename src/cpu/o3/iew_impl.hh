@@ -327,7 +327,7 @@ DefaultIEW<Impl>::setIEWQueue(TimeBuffer<IEWStruct> *iq_ptr)
 
 template<class Impl>
 void
-DefaultIEW<Impl>::setActiveThreads(std::list<ThreadID> *at_ptr)
+DefaultIEW<Impl>::setActiveThreads(ThreadIDList *at_ptr)
 {
     activeThreads = at_ptr;
 
@@ -371,6 +371,17 @@ DefaultIEW<Impl>::isDrained() const
     return drained;
 }
 
+template <class Impl>
+bool
+DefaultIEW<Impl>::isIdle()
+{
+    for (ThreadID tid : *activeThreads) {
+        if (dispatchStatus[tid] == Unblocking)
+            return false;
+    }
+    return !instQueue.hasReadyInsts() && !ldstQueue.willWB();
+}
+
 template <class Impl>
 void
 DefaultIEW<Impl>::drainSanityCheck() const
@@ -640,8 +651,8 @@ DefaultIEW<Impl>::skidCount()
 {
     int max=0;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -657,8 +668,8 @@ template<class Impl>
 bool
 DefaultIEW<Impl>::skidsEmpty()
 {
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -676,8 +687,8 @@ DefaultIEW<Impl>::updateStatus()
 {
     bool any_unblocking = false;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -1174,8 +1185,8 @@ DefaultIEW<Impl>::executeInsts()
     wbNumInst = 0;
     wbCycle = 0;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -1481,8 +1492,8 @@ DefaultIEW<Impl>::tick()
     // Free function units marked as being freed this cycle.
     fuPool->processFreeUnits();
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     // Check stall and squash signals, dispatch any instructions.
     while (threads != end) {
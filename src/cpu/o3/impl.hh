@@ -30,7 +30,9 @@
 #define __CPU_O3_IMPL_HH__
 
 #include "config/the_isa.hh"
+#include "config/o3_max_threads.hh"
 #include "cpu/o3/cpu_policy.hh"
+#include "cpu/o3/thread_list.hh"
 
 // Forward declarations.
 template <class Impl>
@@ -72,8 +74,11 @@ struct O3CPUImpl
 
     enum {
       MaxWidth = 8,
-      MaxThreads = 4
+      MaxThreads = O3_MAX_THREADS
     };
+
+    /** Ordered list of thread IDs, e.g. of the active threads. */
+    typedef ThreadList<MaxThreads> ThreadIDList;
 };
 
 #endif // __CPU_O3_SPARC_IMPL_HH__
@@ -84,6 +84,7 @@ class InstructionQueue
     //Typedefs from the Impl.
     typedef typename Impl::O3CPU O3CPU;
     typedef typename Impl::DynInstPtr DynInstPtr;
+    typedef typename Impl::ThreadIDList ThreadIDList;
 
     typedef typename Impl::CPUPol::IEW IEW;
     typedef typename Impl::CPUPol::MemDepUnit MemDepUnit;
@@ -134,7 +135,7 @@ class InstructionQueue
     void resetState();
 
     /** Sets active threads list. */
-    void setActiveThreads(std::list<ThreadID> *at_ptr);
+    void setActiveThreads(ThreadIDList *at_ptr);
 
     /** Sets the timer buffer between issue and execute. */
     void setIssueToExecuteQueue(TimeBuffer<IssueStruct> *i2eQueue);
@@ -357,39 +358,27 @@ class InstructionQueue
 
     typedef typename std::map<InstSeqNum, DynInstPtr>::iterator NonSpecMapIt;
 
-    /** Entry for the list age ordering by op class. */
-    struct ListOrderEntry {
-        OpClass queueType;
-        InstSeqNum oldestInst;
-    };
+    static_assert(Num_OpClasses <= 64,
+                  "The ready queues must fit in a 64 bit mask");
 
-    /** List that contains the age order of the oldest instruction of each
-     *  ready queue.  Used to select the oldest instruction available
-     *  among op classes.
-     *  @todo: Might be better to just move these entries around instead
-     *  of creating new ones every time the position changes due to an
-     *  instruction issuing.  Not sure std::list supports this.
+    /** Mask of the op classes that have instructions in their ready
+     *  queue. The oldest ready instruction is found by comparing the
+     *  heads of those queues, so the age order of the queues doesn't
+     *  have to be maintained as instructions become ready and issue.
      */
-    std::list<ListOrderEntry> listOrder;
-
-    typedef typename std::list<ListOrderEntry>::iterator ListOrderIt;
+    uint64_t readyOpClasses;
 
-    /** Tracks if each ready queue is on the age order list. */
-    bool queueOnList[Num_OpClasses];
-
-    /** Iterators of each ready queue.  Points to their spot in the age order
-     *  list.
-     */
-    ListOrderIt readyIt[Num_OpClasses];
+    /** Push an instruction onto the ready queue of its op class. */
+    void pushReadyInst(const DynInstPtr &inst);
 
-    /** Add an op class to the age order list. */
-    void addToOrderList(OpClass op_class);
+    /** Pop the oldest instruction of a ready queue. */
+    void popReadyInst(OpClass op_class);
 
     /**
-     * Called when the oldest instruction has been removed from a ready queue;
-     * this places that ready queue into the proper spot in the age order list.
+     * Find the op class among the ones in the mask that has the oldest
+     * ready instruction.
      */
-    void moveToYoungerInst(ListOrderIt age_order_it);
+    OpClass oldestReadyOpClass(uint64_t op_classes) const;
 
     DependencyGraph<DynInstPtr> dependGraph;
 
@@ -404,7 +393,7 @@ class InstructionQueue
     ThreadID numThreads;
 
     /** Pointer to list of active threads. */
-    std::list<ThreadID> *activeThreads;
+    ThreadIDList *activeThreads;
 
     /** Per Thread IQ count */
     unsigned count[Impl::MaxThreads];
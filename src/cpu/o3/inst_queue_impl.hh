@@ -45,6 +45,7 @@
 #include <limits>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "cpu/o3/fu_pool.hh"
 #include "cpu/o3/inst_queue.hh"
@@ -106,8 +107,9 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
                     params.numPhysCCRegs;
 
     //Create an entry for each physical register within the
-    //dependency graph.
-    dependGraph.resize(numPhysRegs);
+    //dependency graph, with room for a couple of unready sources per
+    //instruction in the queue.
+    dependGraph.resize(numPhysRegs, 2 * numEntries);
 
     // Resize the register scoreboard.
     regScoreboard.resize(numPhysRegs);
@@ -413,11 +415,9 @@ InstructionQueue<Impl>::resetState()
     for (int i = 0; i < Num_OpClasses; ++i) {
         while (!readyInsts[i].empty())
             readyInsts[i].pop();
-        queueOnList[i] = false;
-        readyIt[i] = listOrder.end();
     }
+    readyOpClasses = 0;
     nonSpecInsts.clear();
-    listOrder.clear();
     deferredMemInsts.clear();
     blockedMemInsts.clear();
     retryMemInsts.clear();
@@ -426,7 +426,7 @@ InstructionQueue<Impl>::resetState()
 
 template <class Impl>
 void
-InstructionQueue<Impl>::setActiveThreads(list<ThreadID> *at_ptr)
+InstructionQueue<Impl>::setActiveThreads(ThreadIDList *at_ptr)
 {
     activeThreads = at_ptr;
 }
@@ -496,8 +496,8 @@ InstructionQueue<Impl>::resetEntries()
     if (iqPolicy != SMTQueuePolicy::Dynamic || numThreads > 1) {
         int active_threads = activeThreads->size();
 
-        list<ThreadID>::iterator threads = activeThreads->begin();
-        list<ThreadID>::iterator end = activeThreads->end();
+        auto threads = activeThreads->begin();
+        auto end = activeThreads->end();
 
         while (threads != end) {
             ThreadID tid = *threads++;
@@ -554,17 +554,7 @@ template <class Impl>
 bool
 InstructionQueue<Impl>::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
-        return true;
-    }
-
-    for (int i = 0; i < Num_OpClasses; ++i) {
-        if (!readyInsts[i].empty()) {
-            return true;
-        }
-    }
-
-    return false;
+    return readyOpClasses != 0;
 }
 
 template <class Impl>
@@ -688,55 +678,40 @@ InstructionQueue<Impl>::getInstToExecute()
 
 template <class Impl>
 void
-InstructionQueue<Impl>::addToOrderList(OpClass op_class)
+InstructionQueue<Impl>::pushReadyInst(const DynInstPtr &inst)
 {
-    assert(!readyInsts[op_class].empty());
-
-    ListOrderEntry queue_entry;
-
-    queue_entry.queueType = op_class;
-
-    queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
-
-    ListOrderIt list_it = listOrder.begin();
-    ListOrderIt list_end_it = listOrder.end();
-
-    while (list_it != list_end_it) {
-        if ((*list_it).oldestInst > queue_entry.oldestInst) {
-            break;
-        }
-
-        list_it++;
-    }
-
-    readyIt[op_class] = listOrder.insert(list_it, queue_entry);
-    queueOnList[op_class] = true;
+    OpClass op_class = inst->opClass();
+    readyInsts[op_class].push(inst);
+    readyOpClasses |= ULL(1) << op_class;
 }
 
 template <class Impl>
 void
-InstructionQueue<Impl>::moveToYoungerInst(ListOrderIt list_order_it)
+InstructionQueue<Impl>::popReadyInst(OpClass op_class)
 {
-    // Get iterator of next item on the list
-    // Delete the original iterator
-    // Determine if the next item is either the end of the list or younger
-    // than the new instruction.  If so, then add in a new iterator right here.
-    // If not, then move along.
-    ListOrderEntry queue_entry;
-    OpClass op_class = (*list_order_it).queueType;
-    ListOrderIt next_it = list_order_it;
-
-    ++next_it;
-
-    queue_entry.queueType = op_class;
-    queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
-
-    while (next_it != listOrder.end() &&
-           (*next_it).oldestInst < queue_entry.oldestInst) {
-        ++next_it;
-    }
+    readyInsts[op_class].pop();
+    if (readyInsts[op_class].empty())
+        readyOpClasses &= ~(ULL(1) << op_class);
+}
 
-    readyIt[op_class] = listOrder.insert(next_it, queue_entry);
+template <class Impl>
+OpClass
+InstructionQueue<Impl>::oldestReadyOpClass(uint64_t op_classes) const
+{
+    assert(op_classes);
+
+    OpClass oldest = static_cast<OpClass>(ctz64(op_classes));
+    InstSeqNum oldest_seq_num = readyInsts[oldest].top()->seqNum;
+    for (op_classes &= op_classes - 1; op_classes;
+            op_classes &= op_classes - 1) {
+        OpClass op_class = static_cast<OpClass>(ctz64(op_classes));
+        InstSeqNum seq_num = readyInsts[op_class].top()->seqNum;
+        if (seq_num < oldest_seq_num) {
+            oldest = op_class;
+            oldest_seq_num = seq_num;
+        }
+    }
+    return oldest;
 }
 
 template <class Impl>
@@ -782,20 +757,18 @@ InstructionQueue<Impl>::scheduleReadyInsts()
         addReadyMemInst(mem_inst);
     }
 
-    // Have iterator to head of the list
-    // While I haven't exceeded bandwidth or reached the end of the list,
-    // Try to get a FU that can do what this op needs.
-    // If successful, change the oldestInst to the new top of the list, put
-    // the queue in the proper place in the list.
-    // Increment the iterator.
+    // While I haven't exceeded bandwidth or run out of ready queues,
+    // pick the queue with the oldest ready instruction and try to get a
+    // FU that can do what this op needs.
+    // If successful, the queue stays a candidate with its next oldest
+    // instruction. Otherwise it is not considered again this cycle.
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
     int total_issued = 0;
-    ListOrderIt order_it = listOrder.begin();
-    ListOrderIt order_end_it = listOrder.end();
+    uint64_t candidates = readyOpClasses;
 
-    while (total_issued < totalWidth && order_it != order_end_it) {
-        OpClass op_class = (*order_it).queueType;
+    while (total_issued < totalWidth && candidates) {
+        OpClass op_class = oldestReadyOpClass(candidates);
 
         assert(!readyInsts[op_class].empty());
 
@@ -809,19 +782,9 @@ InstructionQueue<Impl>::scheduleReadyInsts()
             iqIOStats.intInstQueueReads++;
         }
 
-        assert(issuing_inst->seqNum == (*order_it).oldestInst);
-
         if (issuing_inst->isSquashed()) {
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
-
-            listOrder.erase(order_it++);
+            popReadyInst(op_class);
+            candidates &= readyOpClasses | ~(ULL(1) << op_class);
 
             ++iqStats.squashedInstsIssued;
 
@@ -882,14 +845,8 @@ InstructionQueue<Impl>::scheduleReadyInsts()
                     tid, issuing_inst->pcState(),
                     issuing_inst->seqNum);
 
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
+            popReadyInst(op_class);
+            candidates &= readyOpClasses | ~(ULL(1) << op_class);
 
             issuing_inst->setIssued();
             ++total_issued;
@@ -908,12 +865,11 @@ InstructionQueue<Impl>::scheduleReadyInsts()
                 memDepUnit[tid].issue(issuing_inst);
             }
 
-            listOrder.erase(order_it++);
             iqStats.statIssuedInstType[tid][op_class]++;
         } else {
             iqStats.statFuBusy[op_class]++;
             iqStats.fuBusy[tid]++;
-            ++order_it;
+            candidates &= ~(ULL(1) << op_class);
         }
     }
 
@@ -1083,17 +1039,7 @@ InstructionQueue<Impl>::addReadyMemInst(const DynInstPtr &ready_inst)
 {
     OpClass op_class = ready_inst->opClass();
 
-    readyInsts[op_class].push(ready_inst);
-
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
-    }
+    pushReadyInst(ready_inst);
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
             "the ready list, PC %s opclass:%i [sn:%llu].\n",
@@ -1453,17 +1399,7 @@ InstructionQueue<Impl>::addIfReady(const DynInstPtr &inst)
                 "the ready list, PC %s opclass:%i [sn:%llu].\n",
                 inst->pcState(), op_class, inst->seqNum);
 
-        readyInsts[op_class].push(inst);
-
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
-        }
+        pushReadyInst(inst);
     }
 }
 
@@ -1499,21 +1435,7 @@ InstructionQueue<Impl>::dumpLists()
 
     cprintf("\n");
 
-    ListOrderIt list_order_it = listOrder.begin();
-    ListOrderIt list_order_end_it = listOrder.end();
-    int i = 1;
-
-    cprintf("List order: ");
-
-    while (list_order_it != list_order_end_it) {
-        cprintf("%i OpClass:%i [sn:%llu] ", i, (*list_order_it).queueType,
-                (*list_order_it).oldestInst);
-
-        ++list_order_it;
-        ++i;
-    }
-
-    cprintf("\n");
+    cprintf("Ready op classes: %#x\n", readyOpClasses);
 }
 
 
@@ -71,6 +71,7 @@ class LSQ
   public:
     typedef typename Impl::O3CPU O3CPU;
     typedef typename Impl::DynInstPtr DynInstPtr;
+    typedef typename Impl::ThreadIDList ThreadIDList;
     typedef typename Impl::CPUPol::IEW IEW;
     typedef typename Impl::CPUPol::LSQUnit LSQUnit;
 
@@ -413,7 +414,7 @@ class LSQ
                    const std::vector<bool>& byte_enable)
         {
             if (isAnyActiveElement(byte_enable.begin(), byte_enable.end())) {
-                auto request = std::make_shared<Request>(
+                auto request = Request::create(
                         addr, size, _flags, _inst->requestorId(),
                         _inst->instAddr(), _inst->contextId(),
                         std::move(_amo_op));
@@ -860,7 +861,7 @@ class LSQ
     std::string name() const;
 
     /** Sets the pointer to the list of active threads. */
-    void setActiveThreads(std::list<ThreadID> *at_ptr);
+    void setActiveThreads(ThreadIDList *at_ptr);
 
     /** Perform sanity checks after a drain. */
     void drainSanityCheck() const;
@@ -1165,7 +1166,7 @@ class LSQ
     }
 
     /** List of Active Threads in System. */
-    std::list<ThreadID> *activeThreads;
+    ThreadIDList *activeThreads;
 
     /** Total Size of LQ Entries. */
     unsigned LQEntries;
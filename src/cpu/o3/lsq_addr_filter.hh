@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_LSQ_ADDR_FILTER_HH__
+#define __CPU_O3_LSQ_ADDR_FILTER_HH__
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include "base/types.hh"
+
+/**
+ * Counting filter over the address ranges accessed by the entries of a
+ * load or store queue.
+ *
+ * Addresses are split in granules of 2^shift bytes, and every granule
+ * an entry touches increments the counter of the bucket it hashes to.
+ * Ranges spanning more than MaxGranules granules are only counted as
+ * wide and are assumed to overlap anything. A range can only overlap
+ * an entry in the queue if one of the buckets of its granules is
+ * non-zero, so the filter may report false positives but never false
+ * negatives. This lets the LSQ skip searching its queues for the vast
+ * majority of accesses that don't alias with anything in flight.
+ */
+class LSQAddrFilter
+{
+  public:
+    static const size_t NumBuckets = 256;
+    static const Addr MaxGranules = 8;
+
+  private:
+    std::array<uint32_t, NumBuckets> counts;
+    /** Number of ranges too wide to be hashed. */
+    uint32_t wideCount;
+    unsigned shift;
+
+    static size_t
+    bucket(Addr granule)
+    {
+        return (granule ^ (granule >> 8) ^ (granule >> 16)) % NumBuckets;
+    }
+
+    Addr first(Addr addr) const { return addr >> shift; }
+
+    Addr
+    last(Addr addr, unsigned size) const
+    {
+        return (addr + std::max(size, 1u) - 1) >> shift;
+    }
+
+    bool
+    wide(Addr addr, unsigned size) const
+    {
+        return last(addr, size) - first(addr) >= MaxGranules;
+    }
+
+    void
+    update(Addr addr, unsigned size, int delta)
+    {
+        if (wide(addr, size)) {
+            assert(delta > 0 || wideCount);
+            wideCount += delta;
+            return;
+        }
+        for (Addr g = first(addr); g <= last(addr, size); ++g) {
+            assert(delta > 0 || counts[bucket(g)]);
+            counts[bucket(g)] += delta;
+        }
+    }
+
+  public:
+    /** @param _shift Log2 of the granule size in bytes. */
+    explicit LSQAddrFilter(unsigned _shift=6) : shift(_shift) { clear(); }
+
+    /** Change the granule size, the filter must be empty. */
+    void setShift(unsigned _shift) { assert(empty()); shift = _shift; }
+
+    void insert(Addr addr, unsigned size) { update(addr, size, 1); }
+    void remove(Addr addr, unsigned size) { update(addr, size, -1); }
+
+    /** Could the range overlap any of the ranges in the filter? */
+    bool
+    mayOverlap(Addr addr, unsigned size) const
+    {
+        if (wideCount)
+            return true;
+        if (wide(addr, size))
+            return !empty();
+        for (Addr g = first(addr); g <= last(addr, size); ++g) {
+            if (counts[bucket(g)])
+                return true;
+        }
+        return false;
+    }
+
+    bool
+    empty() const
+    {
+        return !wideCount &&
+            std::all_of(counts.begin(), counts.end(),
+                        [](uint32_t c) { return c == 0; });
+    }
+
+    void
+    clear()
+    {
+        counts.fill(0);
+        wideCount = 0;
+    }
+};
+
+#endif // __CPU_O3_LSQ_ADDR_FILTER_HH__
@@ -116,7 +116,7 @@ LSQ<Impl>::name() const
 
 template<class Impl>
 void
-LSQ<Impl>::setActiveThreads(std::list<ThreadID> *at_ptr)
+LSQ<Impl>::setActiveThreads(ThreadIDList *at_ptr)
 {
     activeThreads = at_ptr;
     assert(activeThreads != 0);
@@ -254,8 +254,8 @@ template<class Impl>
 void
 LSQ<Impl>::writebackStores()
 {
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -274,8 +274,8 @@ bool
 LSQ<Impl>::violation()
 {
     /* Answers: Does Anybody Have a Violation?*/
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -369,8 +369,8 @@ LSQ<Impl>::getCount()
 {
     unsigned total = 0;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -387,8 +387,8 @@ LSQ<Impl>::numLoads()
 {
     unsigned total = 0;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -405,8 +405,8 @@ LSQ<Impl>::numStores()
 {
     unsigned total = 0;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -423,8 +423,8 @@ LSQ<Impl>::numFreeLoadEntries()
 {
     unsigned total = 0;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -441,8 +441,8 @@ LSQ<Impl>::numFreeStoreEntries()
 {
     unsigned total = 0;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -471,8 +471,8 @@ template<class Impl>
 bool
 LSQ<Impl>::isFull()
 {
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -507,8 +507,8 @@ template<class Impl>
 bool
 LSQ<Impl>::lqEmpty() const
 {
-    std::list<ThreadID>::const_iterator threads = activeThreads->begin();
-    std::list<ThreadID>::const_iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -524,8 +524,8 @@ template<class Impl>
 bool
 LSQ<Impl>::sqEmpty() const
 {
-    std::list<ThreadID>::const_iterator threads = activeThreads->begin();
-    std::list<ThreadID>::const_iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -541,8 +541,8 @@ template<class Impl>
 bool
 LSQ<Impl>::lqFull()
 {
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -570,8 +570,8 @@ template<class Impl>
 bool
 LSQ<Impl>::sqFull()
 {
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -599,8 +599,8 @@ template<class Impl>
 bool
 LSQ<Impl>::isStalled()
 {
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -626,8 +626,8 @@ template<class Impl>
 bool
 LSQ<Impl>::hasStoresToWB()
 {
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -643,8 +643,8 @@ template<class Impl>
 bool
 LSQ<Impl>::willWB()
 {
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -660,8 +660,8 @@ template<class Impl>
 void
 LSQ<Impl>::dumpInsts() const
 {
-    std::list<ThreadID>::const_iterator threads = activeThreads->begin();
-    std::list<ThreadID>::const_iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -732,7 +732,7 @@ LSQ<Impl>::pushRequest(const DynInstPtr& inst, bool isLoad, uint8_t *data,
             inst->effAddrValid(true);
 
             if (cpu->checker) {
-                inst->reqToVerify = std::make_shared<Request>(*req->request());
+                inst->reqToVerify = Request::create(*req->request());
             }
             Fault fault;
             if (isLoad)
@@ -887,7 +887,7 @@ LSQ<Impl>::SplitDataRequest::initiateTranslation()
     Addr final_addr = addrBlockAlign(_addr + _size, cacheLineSize);
     uint32_t size_so_far = 0;
 
-    mainReq = std::make_shared<Request>(base_addr,
+    mainReq = Request::create(base_addr,
                 _size, _flags, _inst->requestorId(),
                 _inst->instAddr(), _inst->contextId());
     mainReq->setByteEnable(_byteEnable);
@@ -53,6 +53,7 @@
 #include "arch/locked_mem.hh"
 #include "config/the_isa.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/o3/lsq_addr_filter.hh"
 #include "cpu/timebuf.hh"
 #include "debug/HtmCpu.hh"
 #include "debug/LSQUnit.hh"
@@ -100,10 +101,17 @@ class LSQUnit
         uint32_t _size;
         /** Valid entry. */
         bool _valid;
+        /** Address range recorded in the address filter of the queue. */
+        /** @{ */
+        Addr _filterAddr;
+        uint32_t _filterSize;
+        bool _inFilter;
+        /** @} */
       public:
         /** Constructs an empty store queue entry. */
         LSQEntry()
-            : inst(nullptr), req(nullptr), _size(0), _valid(false)
+            : inst(nullptr), req(nullptr), _size(0), _valid(false),
+              _inFilter(false)
         {
         }
 
@@ -146,6 +154,28 @@ class LSQUnit
         const uint32_t& size() const { return _size; }
         const DynInstPtr& instruction() const { return inst; }
         /** @} */
+
+        /** Record the access of the entry in an address filter,
+         *  replacing what was recorded before. */
+        void
+        addToFilter(LSQAddrFilter &filter, Addr addr, uint32_t size)
+        {
+            removeFromFilter(filter);
+            filter.insert(addr, size);
+            _filterAddr = addr;
+            _filterSize = size;
+            _inFilter = true;
+        }
+
+        /** Drop the access of the entry from an address filter. */
+        void
+        removeFromFilter(LSQAddrFilter &filter)
+        {
+            if (_inFilter) {
+                filter.remove(_filterAddr, _filterSize);
+                _inFilter = false;
+            }
+        }
     };
 
     class SQEntry : public LSQEntry
@@ -506,6 +536,18 @@ class LSQUnit
     /** Should loads be checked for dependency issues */
     bool checkLoads;
 
+    /** Filter over the addresses of the loads in the LQ whose effective
+     *  address is known, used to skip checkViolations when no load can
+     *  conflict. Its granules are at least as coarse as the ones of
+     *  the dependency checks.
+     */
+    LSQAddrFilter loadFilter;
+
+    /** Filter over the addresses of the stores in the SQ that have
+     *  data, used to skip searching for a store to forward from.
+     */
+    LSQAddrFilter storeFilter;
+
     /** The number of load instructions in the LQ. */
     int loads;
     /** The number of store instructions in the SQ. */
@@ -640,6 +682,7 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
 
     load_req.setRequest(req);
     assert(load_inst);
+    load_req.addToFilter(loadFilter, load_inst->effAddr, load_inst->effSize);
 
     assert(!load_inst->isExecuted());
 
@@ -731,11 +774,14 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
         }
     }
 
-    // Check the SQ for any previous stores that might lead to forwarding
+    // Check the SQ for any previous stores that might lead to forwarding,
+    // unless none of the stores can overlap with the load.
     auto store_it = load_inst->sqIt;
     assert (store_it >= storeWBIt);
+    bool may_forward = storeFilter.mayOverlap(
+        req->mainRequest()->getVaddr(), req->mainRequest()->getSize());
     // End once we've reached the top of the LSQ
-    while (store_it != storeWBIt) {
+    while (may_forward && store_it != storeWBIt) {
         // Move the index to one younger
         store_it--;
         assert(store_it->valid());
@@ -968,6 +1014,8 @@ LSQUnit<Impl>::write(LSQRequest *req, uint8_t *data, int store_idx)
     storeQueue[store_idx].setRequest(req);
     unsigned size = req->_size;
     storeQueue[store_idx].size() = size;
+    storeQueue[store_idx].addToFilter(storeFilter,
+        storeQueue[store_idx].instruction()->effAddr, size);
     bool store_no_data =
         req->mainRequest()->getFlags() & Request::STORE_NO_DATA;
     storeQueue[store_idx].isAllZeros() = store_no_data;
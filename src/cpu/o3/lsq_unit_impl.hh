@@ -230,6 +230,7 @@ LSQUnit<Impl>::init(O3CPU *cpu_ptr, IEW *iew_ptr,
 
     depCheckShift = params.LSQDepCheckShift;
     checkLoads = params.LSQCheckLoads;
+    loadFilter.setShift(std::max(depCheckShift, 6u));
     needsTSO = params.needsTSO;
 
     resetState();
@@ -253,6 +254,9 @@ LSQUnit<Impl>::resetState()
 
     stalled = false;
 
+    loadFilter.clear();
+    storeFilter.clear();
+
     cacheBlockMask = ~(cpu->cacheLineSize() - 1);
 }
 
@@ -538,6 +542,10 @@ LSQUnit<Impl>::checkViolations(typename LoadQueue::iterator& loadIt,
     Addr inst_eff_addr1 = inst->effAddr >> depCheckShift;
     Addr inst_eff_addr2 = (inst->effAddr + inst->effSize - 1) >> depCheckShift;
 
+    // Every load the search below could match is in the filter.
+    if (!loadFilter.mayOverlap(inst->effAddr, inst->effSize))
+        return NoFault;
+
     /** @todo in theory you only need to check an instruction that has executed
      * however, there isn't a good way in the pipeline at the moment to check
      * all instructions that will execute before the store writes back. Thus,
@@ -739,6 +747,7 @@ LSQUnit<Impl>::commitLoad()
     DPRINTF(LSQUnit, "Committing head load instruction, PC %s\n",
             loadQueue.front().instruction()->pcState());
 
+    loadQueue.front().removeFromFilter(loadFilter);
     loadQueue.front().clear();
     loadQueue.pop_front();
 
@@ -978,6 +987,7 @@ LSQUnit<Impl>::squash(const InstSeqNum &squashed_num)
         }
         // Clear the smart pointer to make sure it is decremented.
         loadQueue.back().instruction()->setSquashed();
+        loadQueue.back().removeFromFilter(loadFilter);
         loadQueue.back().clear();
 
         --loads;
@@ -1051,6 +1061,7 @@ LSQUnit<Impl>::squash(const InstSeqNum &squashed_num)
         // Must delete request now that it wasn't handed off to
         // memory.  This is quite ugly.  @todo: Figure out the proper
         // place to really handle request deletes.
+        storeQueue.back().removeFromFilter(storeFilter);
         storeQueue.back().clear();
         --stores;
 
@@ -1171,6 +1182,7 @@ LSQUnit<Impl>::completeStore(typename StoreQueue::iterator store_idx)
     DynInstPtr store_inst = store_idx->instruction();
     if (store_idx == storeQueue.begin()) {
         do {
+            storeQueue.front().removeFromFilter(storeFilter);
             storeQueue.front().clear();
             storeQueue.pop_front();
             --stores;
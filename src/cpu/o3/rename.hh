@@ -45,6 +45,7 @@
 #include <list>
 #include <utility>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "config/the_isa.hh"
 #include "cpu/timebuf.hh"
@@ -71,6 +72,7 @@ class DefaultRename
     // Typedefs from the Impl.
     typedef typename Impl::CPUPol CPUPol;
     typedef typename Impl::DynInstPtr DynInstPtr;
+    typedef typename Impl::ThreadIDList ThreadIDList;
     typedef typename Impl::O3CPU O3CPU;
 
     // Typedefs from the CPUPol
@@ -168,7 +170,7 @@ class DefaultRename
     void clearStates(ThreadID tid);
 
     /** Sets pointer to list of active threads. */
-    void setActiveThreads(std::list<ThreadID> *at_ptr);
+    void setActiveThreads(ThreadIDList *at_ptr);
 
     /** Sets pointer to rename maps (per-thread structures). */
     void setRenameMap(RenameMap rm_ptr[Impl::MaxThreads]);
@@ -296,6 +298,8 @@ class DefaultRename
      * register for that arch. register, and the new physical register.
      */
     struct RenameHistory {
+        RenameHistory() = default;
+
         RenameHistory(InstSeqNum _instSeqNum, const RegId& _archReg,
                       PhysRegIdPtr _newPhysReg,
                       PhysRegIdPtr _prevPhysReg)
@@ -316,9 +320,10 @@ class DefaultRename
     };
 
     /** A per-thread list of all destination register renames, used to either
-     * undo rename mappings or free old physical registers.
+     * undo rename mappings or free old physical registers. The oldest
+     * rename is at the front and the youngest at the back.
      */
-    std::list<RenameHistory> historyBuffer[Impl::MaxThreads];
+    CircularQueue<RenameHistory> historyBuffer[Impl::MaxThreads];
 
     /** Pointer to CPU. */
     O3CPU *cpu;
@@ -360,7 +365,7 @@ class DefaultRename
     FreeList *freeList;
 
     /** Pointer to the list of active threads. */
-    std::list<ThreadID> *activeThreads;
+    ThreadIDList *activeThreads;
 
     /** Pointer to the scoreboard. */
     Scoreboard *scoreboard;
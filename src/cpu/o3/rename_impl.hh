@@ -42,7 +42,7 @@
 #ifndef __CPU_O3_RENAME_IMPL_HH__
 #define __CPU_O3_RENAME_IMPL_HH__
 
-#include <list>
+#include <algorithm>
 
 #include "arch/registers.hh"
 #include "config/the_isa.hh"
@@ -273,7 +273,7 @@ DefaultRename<Impl>::resetStage()
 
 template<class Impl>
 void
-DefaultRename<Impl>::setActiveThreads(std::list<ThreadID> *at_ptr)
+DefaultRename<Impl>::setActiveThreads(ThreadIDList *at_ptr)
 {
     activeThreads = at_ptr;
 }
@@ -403,8 +403,8 @@ DefaultRename<Impl>::tick()
 
     sortInsts();
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     // Check stall and squash signals.
     while (threads != end) {
@@ -819,8 +819,8 @@ template<class Impl>
 bool
 DefaultRename<Impl>::skidsEmpty()
 {
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -838,8 +838,8 @@ DefaultRename<Impl>::updateStatus()
 {
     bool any_unblocking = false;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -930,21 +930,20 @@ template <class Impl>
 void
 DefaultRename<Impl>::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
 {
-    typename std::list<RenameHistory>::iterator hb_it =
-        historyBuffer[tid].begin();
+    auto &history = historyBuffer[tid];
 
     // After a syscall squashes everything, the history buffer may be empty
     // but the ROB may still be squashing instructions.
     // Go through the most recent instructions, undoing the mappings
     // they did and freeing up the registers.
-    while (!historyBuffer[tid].empty() &&
-           hb_it->instSeqNum > squashed_seq_num) {
-        assert(hb_it != historyBuffer[tid].end());
+    while (!history.empty() &&
+           history.back().instSeqNum > squashed_seq_num) {
+        const RenameHistory &hb_entry = history.back();
 
         DPRINTF(Rename, "[tid:%i] Removing history entry with sequence "
                 "number %i (archReg: %d, newPhysReg: %d, prevPhysReg: %d).\n",
-                tid, hb_it->instSeqNum, hb_it->archReg.index(),
-                hb_it->newPhysReg->index(), hb_it->prevPhysReg->index());
+                tid, hb_entry.instSeqNum, hb_entry.archReg.index(),
+                hb_entry.newPhysReg->index(), hb_entry.prevPhysReg->index());
 
         // Undo the rename mapping only if it was really a change.
         // Special regs that are not really renamed (like misc regs
@@ -952,22 +951,22 @@ DefaultRename<Impl>::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
         // is the same as the old one.  While it would be merely a
         // waste of time to update the rename table, we definitely
         // don't want to put these on the free list.
-        if (hb_it->newPhysReg != hb_it->prevPhysReg) {
+        if (hb_entry.newPhysReg != hb_entry.prevPhysReg) {
             // Tell the rename map to set the architected register to the
             // previous physical register that it was renamed to.
-            renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
+            renameMap[tid]->setEntry(hb_entry.archReg, hb_entry.prevPhysReg);
 
             // Put the renamed physical register back on the free list.
-            freeList->addReg(hb_it->newPhysReg);
+            freeList->addReg(hb_entry.newPhysReg);
         }
 
         // Notify potential listeners that the register mapping needs to be
         // removed because the instruction it was mapped to got squashed. Note
-        // that this is done before hb_it is incremented.
-        ppSquashInRename->notify(std::make_pair(hb_it->instSeqNum,
-                                                hb_it->newPhysReg));
+        // that this is done before the entry is removed.
+        ppSquashInRename->notify(std::make_pair(hb_entry.instSeqNum,
+                                                hb_entry.newPhysReg));
 
-        historyBuffer[tid].erase(hb_it++);
+        history.pop_back();
 
         ++stats.undoneMaps;
     }
@@ -984,15 +983,12 @@ DefaultRename<Impl>::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
             "history buffer %u (size=%i), until [sn:%llu].\n",
             tid, tid, historyBuffer[tid].size(), inst_seq_num);
 
-    typename std::list<RenameHistory>::iterator hb_it =
-        historyBuffer[tid].end();
+    auto &history = historyBuffer[tid];
 
-    --hb_it;
-
-    if (historyBuffer[tid].empty()) {
+    if (history.empty()) {
         DPRINTF(Rename, "[tid:%i] History buffer is empty.\n", tid);
         return;
-    } else if (hb_it->instSeqNum > inst_seq_num) {
+    } else if (history.front().instSeqNum > inst_seq_num) {
         DPRINTF(Rename, "[tid:%i] [sn:%llu] "
                 "Old sequence number encountered. "
                 "Ensure that a syscall happened recently.\n",
@@ -1004,26 +1000,26 @@ DefaultRename<Impl>::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
     // number. Some or even all of the committed instructions may not have
     // rename histories if they did not have destination registers that were
     // renamed.
-    while (!historyBuffer[tid].empty() &&
-           hb_it != historyBuffer[tid].end() &&
-           hb_it->instSeqNum <= inst_seq_num) {
+    while (!history.empty() &&
+           history.front().instSeqNum <= inst_seq_num) {
+        const RenameHistory &hb_entry = history.front();
 
         DPRINTF(Rename, "[tid:%i] Freeing up older rename of reg %i (%s), "
                 "[sn:%llu].\n",
-                tid, hb_it->prevPhysReg->index(),
-                hb_it->prevPhysReg->className(),
-                hb_it->instSeqNum);
+                tid, hb_entry.prevPhysReg->index(),
+                hb_entry.prevPhysReg->className(),
+                hb_entry.instSeqNum);
 
         // Don't free special phys regs like misc and zero regs, which
         // can be recognized because the new mapping is the same as
         // the old one.
-        if (hb_it->newPhysReg != hb_it->prevPhysReg) {
-            freeList->addReg(hb_it->prevPhysReg);
+        if (hb_entry.newPhysReg != hb_entry.prevPhysReg) {
+            freeList->addReg(hb_entry.prevPhysReg);
         }
 
         ++stats.committedMaps;
 
-        historyBuffer[tid].erase(hb_it--);
+        history.pop_front();
     }
 }
 
@@ -1128,12 +1124,14 @@ DefaultRename<Impl>::renameDestRegs(const DynInstPtr &inst, ThreadID tid)
                                rename_result.first,
                                rename_result.second);
 
-        historyBuffer[tid].push_front(hb_entry);
+        auto &history = historyBuffer[tid];
+        if (history.full())
+            history.grow(std::max<size_t>(2 * history.capacity(), 64));
+        history.push_back(hb_entry);
 
         DPRINTF(Rename, "[tid:%i] [sn:%llu] "
                 "Adding instruction to history buffer (size=%i).\n",
-                tid,(*historyBuffer[tid].begin()).instSeqNum,
-                historyBuffer[tid].size());
+                tid, history.back().instSeqNum, history.size());
 
         // Tell the instruction to rename the appropriate destination
         // register (dest_idx) to the new physical register
@@ -1435,24 +1433,21 @@ template <class Impl>
 void
 DefaultRename<Impl>::dumpHistory()
 {
-    typename std::list<RenameHistory>::iterator buf_it;
-
     for (ThreadID tid = 0; tid < numThreads; tid++) {
+        const auto &history = historyBuffer[tid];
 
-        buf_it = historyBuffer[tid].begin();
-
-        while (buf_it != historyBuffer[tid].end()) {
+        // Youngest first
+        for (size_t idx = history.tail(); history.isValidIdx(idx); --idx) {
+            const RenameHistory &hb_entry = history[idx];
             cprintf("Seq num: %i\nArch reg[%s]: %i New phys reg:"
                     " %i[%s] Old phys reg: %i[%s]\n",
-                    (*buf_it).instSeqNum,
-                    (*buf_it).archReg.className(),
-                    (*buf_it).archReg.index(),
-                    (*buf_it).newPhysReg->index(),
-                    (*buf_it).newPhysReg->className(),
-                    (*buf_it).prevPhysReg->index(),
-                    (*buf_it).prevPhysReg->className());
-
-            buf_it++;
+                    hb_entry.instSeqNum,
+                    hb_entry.archReg.className(),
+                    hb_entry.archReg.index(),
+                    hb_entry.newPhysReg->index(),
+                    hb_entry.newPhysReg->className(),
+                    hb_entry.prevPhysReg->index(),
+                    hb_entry.prevPhysReg->className());
         }
     }
 }
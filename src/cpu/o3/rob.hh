@@ -46,6 +46,7 @@
 #include <vector>
 
 #include "arch/registers.hh"
+#include "base/circular_queue.hh"
 #include "base/types.hh"
 #include "config/the_isa.hh"
 #include "enums/SMTQueuePolicy.hh"
@@ -62,9 +63,10 @@ class ROB
     //Typedefs from the Impl.
     typedef typename Impl::O3CPU O3CPU;
     typedef typename Impl::DynInstPtr DynInstPtr;
+    typedef typename Impl::ThreadIDList ThreadIDList;
 
     typedef std::pair<RegIndex, PhysRegIndex> UnmapInfo;
-    typedef typename std::list<DynInstPtr>::iterator InstIt;
+    typedef typename CircularQueue<DynInstPtr>::iterator InstIt;
 
     /** Possible ROB statuses. */
     enum Status {
@@ -92,7 +94,7 @@ class ROB
     /** Sets pointer to the list of active threads.
      *  @param at_ptr Pointer to the list of active threads.
      */
-    void setActiveThreads(std::list<ThreadID> *at_ptr);
+    void setActiveThreads(ThreadIDList *at_ptr);
 
     /** Perform sanity checks after a drain. */
     void drainSanityCheck() const;
@@ -265,7 +267,7 @@ class ROB
     O3CPU *cpu;
 
     /** Active Threads in CPU */
-    std::list<ThreadID> *activeThreads;
+    ThreadIDList *activeThreads;
 
     /** Number of instructions in the ROB. */
     unsigned numEntries;
@@ -276,8 +278,8 @@ class ROB
     /** Max Insts a Thread Can Have in the ROB */
     unsigned maxEntries[Impl::MaxThreads];
 
-    /** ROB List of Instructions */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    /** ROB List of Instructions, a ring of numEntries per thread */
+    std::vector<CircularQueue<DynInstPtr>> instList;
 
     /** Number of instructions that can be squashed in a single cycle. */
     unsigned squashWidth;
@@ -299,7 +301,7 @@ class ROB
      *  when squashing, the instructions are marked as squashed but not
      *  immediately removed, meaning the tail iterator remains the same before
      *  and after a squash.
-     *  This will always be set to cpu->instList.end() if it is invalid.
+     *  This will always be set to InstIt() if it is invalid.
      */
     InstIt squashIt[Impl::MaxThreads];
 
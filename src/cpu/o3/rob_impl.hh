@@ -41,6 +41,7 @@
 #ifndef __CPU_O3_ROB_IMPL_HH__
 #define __CPU_O3_ROB_IMPL_HH__
 
+#include <algorithm>
 #include <list>
 
 #include "base/logging.hh"
@@ -54,6 +55,8 @@ ROB<Impl>::ROB(O3CPU *_cpu, const DerivO3CPUParams &params)
     : robPolicy(params.smtROBPolicy),
       cpu(_cpu),
       numEntries(params.numROBEntries),
+      instList(Impl::MaxThreads,
+               CircularQueue<DynInstPtr>(params.numROBEntries)),
       squashWidth(params.squashWidth),
       numInstsInROB(0),
       numThreads(params.numThreads),
@@ -101,7 +104,7 @@ ROB<Impl>::resetState()
 {
     for (ThreadID tid = 0; tid  < Impl::MaxThreads; tid++) {
         threadEntries[tid] = 0;
-        squashIt[tid] = instList[tid].end();
+        squashIt[tid] = InstIt();
         squashedSeqNum[tid] = 0;
         doneSquashing[tid] = true;
     }
@@ -109,8 +112,8 @@ ROB<Impl>::resetState()
 
     // Initialize the "universal" ROB head & tail point to invalid
     // pointers
-    head = instList[0].end();
-    tail = instList[0].end();
+    head = InstIt();
+    tail = InstIt();
 }
 
 template <class Impl>
@@ -122,7 +125,7 @@ ROB<Impl>::name() const
 
 template <class Impl>
 void
-ROB<Impl>::setActiveThreads(std::list<ThreadID> *at_ptr)
+ROB<Impl>::setActiveThreads(ThreadIDList *at_ptr)
 {
     DPRINTF(ROB, "Setting active threads list pointer.\n");
     activeThreads = at_ptr;
@@ -151,8 +154,8 @@ ROB<Impl>::resetEntries()
     if (robPolicy != SMTQueuePolicy::Dynamic || numThreads > 1) {
         auto active_threads = activeThreads->size();
 
-        std::list<ThreadID>::iterator threads = activeThreads->begin();
-        std::list<ThreadID>::iterator end = activeThreads->end();
+        auto threads = activeThreads->begin();
+        auto end = activeThreads->end();
 
         while (threads != end) {
             ThreadID tid = *threads++;
@@ -211,6 +214,7 @@ ROB<Impl>::insertInst(const DynInstPtr &inst)
 
     ThreadID tid = inst->threadNumber;
 
+    assert(!instList[tid].full());
     instList[tid].push_back(inst);
 
     //Set Up head iterator if this is the 1st instruction in the ROB
@@ -242,11 +246,10 @@ ROB<Impl>::retireHead(ThreadID tid)
 
     assert(numInstsInROB > 0);
 
-    // Get the head ROB instruction by copying it and remove it from the list
-    InstIt head_it = instList[tid].begin();
-
-    DynInstPtr head_inst = std::move(*head_it);
-    instList[tid].erase(head_it);
+    // Get the head ROB instruction by moving it out of the ring, so the
+    // entry does not keep it alive, and remove it
+    DynInstPtr head_inst = std::move(instList[tid].front());
+    instList[tid].pop_front();
 
     assert(head_inst->readyToCommit());
 
@@ -286,8 +289,8 @@ bool
 ROB<Impl>::canCommit()
 {
     //@todo: set ActiveThreads through ROB or CPU
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -322,13 +325,13 @@ ROB<Impl>::doSquash(ThreadID tid)
     DPRINTF(ROB, "[tid:%i] Squashing instructions until [sn:%llu].\n",
             tid, squashedSeqNum[tid]);
 
-    assert(squashIt[tid] != instList[tid].end());
+    assert(squashIt[tid].dereferenceable());
 
     if ((*squashIt[tid])->seqNum < squashedSeqNum[tid]) {
         DPRINTF(ROB, "[tid:%i] Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
+        squashIt[tid] = InstIt();
 
         doneSquashing[tid] = true;
         return;
@@ -348,7 +351,7 @@ ROB<Impl>::doSquash(ThreadID tid)
 
     for (int numSquashed = 0;
          numSquashed < numInstsToSquash &&
-         squashIt[tid] != instList[tid].end() &&
+         squashIt[tid].dereferenceable() &&
          (*squashIt[tid])->seqNum > squashedSeqNum[tid];
          ++numSquashed)
     {
@@ -368,17 +371,14 @@ ROB<Impl>::doSquash(ThreadID tid)
             DPRINTF(ROB, "Reached head of instruction list while "
                     "squashing.\n");
 
-            squashIt[tid] = instList[tid].end();
+            squashIt[tid] = InstIt();
 
             doneSquashing[tid] = true;
 
             return;
         }
 
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
-
-        if ((*squashIt[tid]) == (*tail_thread))
+        if ((*squashIt[tid]) == instList[tid].back())
             robTailUpdate = true;
 
         squashIt[tid]--;
@@ -390,7 +390,7 @@ ROB<Impl>::doSquash(ThreadID tid)
         DPRINTF(ROB, "[tid:%i] Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
+        squashIt[tid] = InstIt();
 
         doneSquashing[tid] = true;
     }
@@ -409,8 +409,8 @@ ROB<Impl>::updateHead()
     bool first_valid = true;
 
     // @todo: set ActiveThreads through ROB or CPU
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -438,7 +438,7 @@ ROB<Impl>::updateHead()
     }
 
     if (first_valid) {
-        head = instList[0].end();
+        head = InstIt();
     }
 
 }
@@ -447,11 +447,11 @@ template <class Impl>
 void
 ROB<Impl>::updateTail()
 {
-    tail = instList[0].end();
+    tail = InstIt();
     bool first_valid = true;
 
-    std::list<ThreadID>::iterator threads = activeThreads->begin();
-    std::list<ThreadID>::iterator end = activeThreads->end();
+    auto threads = activeThreads->begin();
+    auto end = activeThreads->end();
 
     while (threads != end) {
         ThreadID tid = *threads++;
@@ -548,10 +548,13 @@ template <class Impl>
 typename Impl::DynInstPtr
 ROB<Impl>::findInst(ThreadID tid, InstSeqNum squash_inst)
 {
-    for (InstIt it = instList[tid].begin(); it != instList[tid].end(); it++) {
-        if ((*it)->seqNum == squash_inst) {
-            return *it;
-        }
+    // The instructions of a thread are in sequence number order
+    InstIt it = std::lower_bound(instList[tid].begin(), instList[tid].end(),
+            squash_inst, [](const DynInstPtr &inst, InstSeqNum seq_num) {
+                return inst->seqNum < seq_num;
+            });
+    if (it != instList[tid].end() && (*it)->seqNum == squash_inst) {
+        return *it;
     }
     return NULL;
 }
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_THREAD_LIST_HH__
+#define __CPU_O3_THREAD_LIST_HH__
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/types.hh"
+
+/**
+ * An ordered list of thread IDs, such as the active threads or a round
+ * robin priority order, stored inline. It replaces std::list for these
+ * lists, which hold at most MaxThreads entries and are walked by every
+ * stage on every cycle. When the CPU is built with a single thread
+ * (O3_MAX_THREADS=1) the loops over it collapse to a single check.
+ *
+ * Like std::list, erasing an entry invalidates iterators to it, but
+ * unlike it also those to the entries that follow.
+ */
+template <int Max>
+class ThreadList
+{
+  private:
+    ThreadID threads[Max];
+    int count = 0;
+
+  public:
+    typedef ThreadID *iterator;
+    typedef const ThreadID *const_iterator;
+
+    iterator begin() { return threads; }
+    iterator end() { return threads + count; }
+    const_iterator begin() const { return threads; }
+    const_iterator end() const { return threads + count; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    ThreadID front() const { assert(count); return threads[0]; }
+
+    void clear() { count = 0; }
+
+    void
+    push_back(ThreadID tid)
+    {
+        assert(count < Max);
+        threads[count++] = tid;
+    }
+
+    /** Remove an entry, keeping the others in order. */
+    iterator
+    erase(iterator it)
+    {
+        assert(it >= begin() && it < end());
+        std::copy(it + 1, end(), it);
+        --count;
+        return it;
+    }
+};
+
+#endif // __CPU_O3_THREAD_LIST_HH__
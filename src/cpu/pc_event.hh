@@ -29,6 +29,7 @@
 #ifndef __PC_EVENT_HH__
 #define __PC_EVENT_HH__
 
+#include <algorithm>
 #include <vector>
 
 #include "base/logging.hh"
@@ -121,6 +122,15 @@ class PCEventQueue : public PCEventScope
     range_t equal_range(Addr pc);
     range_t equal_range(PCEvent *event) { return equal_range(event->pc()); }
 
+    /** Is there an event for a PC between first and last inclusive? */
+    bool
+    anyInRange(Addr first, Addr last) const
+    {
+        auto it = std::lower_bound(pcMap.begin(), pcMap.end(), first,
+                                   MapCompare());
+        return it != pcMap.end() && (*it)->pc() <= last;
+    }
+
     void dump() const;
 };
 
@@ -35,6 +35,7 @@
 
 #include "base/sat_counter.hh"
 #include "cpu/pred/bpred_unit.hh"
+#include "mem/mem_pool.hh"
 #include "params/BiModeBP.hh"
 
 /**
@@ -65,7 +66,7 @@ class BiModeBP : public BPredUnit
   private:
     void updateGlobalHistReg(ThreadID tid, bool taken);
 
-    struct BPHistory {
+    struct BPHistory : public MemPoolAllocated {
         unsigned globalHistoryReg;
         // was the taken array's prediction used?
         // true: takenPred used
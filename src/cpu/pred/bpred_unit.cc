@@ -53,8 +53,9 @@
 BPredUnit::BPredUnit(const Params &params)
     : SimObject(params),
       numThreads(params.numThreads),
-      predHist(numThreads),
+      predHist(numThreads, History(InitialHistorySize)),
       BTB(params.BTBEntries,
+          params.BTBAssoc,
           params.BTBTagSize,
           params.instShiftAmt,
           params.numThreads),
@@ -105,6 +106,8 @@ BPredUnit::regProbePoints()
 {
     ppBranches = pmuProbePoint("Branches");
     ppMisses = pmuProbePoint("Misses");
+    ppCommittedBranch = new ProbePointArg<CommittedBranch>(
+        getProbeManager(), "CommittedBranch");
 }
 
 void
@@ -201,10 +204,9 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
             if (inst->isDirectCtrl() || !iPred) {
                 ++stats.BTBLookups;
                 // Check BTB on direct branches
-                if (BTB.valid(pc.instAddr(), tid)) {
+                // If it's not a return, use the BTB to get target addr.
+                if (BTB.lookup(pc.instAddr(), tid, target)) {
                     ++stats.BTBHits;
-                    // If it's not a return, use the BTB to get target addr.
-                    target = BTB.lookup(pc.instAddr(), tid);
                     DPRINTF(Branch,
                             "[tid:%i] [sn:%llu] Instruction %s predicted "
                             "target is %s\n",
@@ -281,7 +283,9 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
         iPred->updateDirectionInfo(tid, orig_pred_taken);
     }
 
-    predHist[tid].push_front(predict_record);
+    if (predHist[tid].full())
+        predHist[tid].grow(2 * predHist[tid].capacity());
+    predHist[tid].push_back(predict_record);
 
     DPRINTF(Branch,
             "[tid:%i] [sn:%llu] History entry added. "
@@ -291,6 +295,20 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
     return pred_taken;
 }
 
+Addr
+BPredUnit::predictBlockExit(ThreadID tid, Addr start_pc,
+                            Addr block_end) const
+{
+    // Branches are looked up at the granularity the BTB is indexed at,
+    // which finds them wherever they are within that granule.
+    const Addr step = ULL(1) << instShiftAmt;
+    for (Addr pc = start_pc & ~(step - 1); pc < block_end; pc += step) {
+        if (const TheISA::PCState *target = BTB.probe(pc, tid))
+            return target->instAddr();
+    }
+    return block_end;
+}
+
 void
 BPredUnit::update(const InstSeqNum &done_sn, ThreadID tid)
 {
@@ -298,19 +316,25 @@ BPredUnit::update(const InstSeqNum &done_sn, ThreadID tid)
             "sn:%llu]\n", tid, done_sn);
 
     while (!predHist[tid].empty() &&
-           predHist[tid].back().seqNum <= done_sn) {
+           predHist[tid].front().seqNum <= done_sn) {
+        if (ppCommittedBranch->hasListeners()) {
+            const PredictorHistory &hist = predHist[tid].front();
+            ppCommittedBranch->notify({tid, hist.pc, hist.target,
+                                       hist.predTaken, hist.inst.get()});
+        }
+
         // Update the branch predictor with the correct results.
-        update(tid, predHist[tid].back().pc,
-                    predHist[tid].back().predTaken,
-                    predHist[tid].back().bpHistory, false,
-                    predHist[tid].back().inst,
-                    predHist[tid].back().target);
+        update(tid, predHist[tid].front().pc,
+                    predHist[tid].front().predTaken,
+                    predHist[tid].front().bpHistory, false,
+                    predHist[tid].front().inst,
+                    predHist[tid].front().target);
 
         if (iPred) {
-            iPred->commit(done_sn, tid, predHist[tid].back().indirectHistory);
+            iPred->commit(done_sn, tid, predHist[tid].front().indirectHistory);
         }
 
-        predHist[tid].pop_back();
+        predHist[tid].pop_front();
     }
 }
 
@@ -324,35 +348,35 @@ BPredUnit::squash(const InstSeqNum &squashed_sn, ThreadID tid)
     }
 
     while (!pred_hist.empty() &&
-           pred_hist.front().seqNum > squashed_sn) {
-        if (pred_hist.front().usedRAS) {
+           pred_hist.back().seqNum > squashed_sn) {
+        if (pred_hist.back().usedRAS) {
             DPRINTF(Branch, "[tid:%i] [squash sn:%llu]"
                     " Restoring top of RAS to: %i,"
                     " target: %s\n", tid, squashed_sn,
-                    pred_hist.front().RASIndex, pred_hist.front().RASTarget);
+                    pred_hist.back().RASIndex, pred_hist.back().RASTarget);
 
-            RAS[tid].restore(pred_hist.front().RASIndex,
-                             pred_hist.front().RASTarget);
-        } else if (pred_hist.front().wasCall && pred_hist.front().pushedRAS) {
+            RAS[tid].restore(pred_hist.back().RASIndex,
+                             pred_hist.back().RASTarget);
+        } else if (pred_hist.back().wasCall && pred_hist.back().pushedRAS) {
              // Was a call but predicated false. Pop RAS here
              DPRINTF(Branch, "[tid:%i] [squash sn:%llu] Squashing"
                      "  Call [sn:%llu] PC: %s Popping RAS\n", tid, squashed_sn,
-                     pred_hist.front().seqNum, pred_hist.front().pc);
+                     pred_hist.back().seqNum, pred_hist.back().pc);
              RAS[tid].pop();
         }
 
         // This call should delete the bpHistory.
-        squash(tid, pred_hist.front().bpHistory);
+        squash(tid, pred_hist.back().bpHistory);
         if (iPred) {
-            iPred->deleteIndirectInfo(tid, pred_hist.front().indirectHistory);
+            iPred->deleteIndirectInfo(tid, pred_hist.back().indirectHistory);
         }
 
         DPRINTF(Branch, "[tid:%i] [squash sn:%llu] "
                 "Removing history for [sn:%llu] "
-                "PC %#x\n", tid, squashed_sn, pred_hist.front().seqNum,
-                pred_hist.front().pc);
+                "PC %#x\n", tid, squashed_sn, pred_hist.back().seqNum,
+                pred_hist.back().pc);
 
-        pred_hist.pop_front();
+        pred_hist.pop_back();
 
         DPRINTF(Branch, "[tid:%i] [squash sn:%llu] predHist.size(): %i\n",
                 tid, squashed_sn, predHist[tid].size());
@@ -391,16 +415,13 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
     // fix up the entry.
     if (!pred_hist.empty()) {
 
-        auto hist_it = pred_hist.begin();
-        //HistoryIt hist_it = find(pred_hist.begin(), pred_hist.end(),
-        //                       squashed_sn);
+        auto hist_it = pred_hist.getIterator(pred_hist.tail());
 
-        //assert(hist_it != pred_hist.end());
-        if (pred_hist.front().seqNum != squashed_sn) {
-            DPRINTF(Branch, "Front sn %i != Squash sn %i\n",
-                    pred_hist.front().seqNum, squashed_sn);
+        if (pred_hist.back().seqNum != squashed_sn) {
+            DPRINTF(Branch, "Back sn %i != Squash sn %i\n",
+                    pred_hist.back().seqNum, squashed_sn);
 
-            assert(pred_hist.front().seqNum == squashed_sn);
+            assert(pred_hist.back().seqNum == squashed_sn);
         }
 
 
@@ -421,16 +442,16 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
         // the branch actually commits.
 
         // Remember the correct direction for the update at commit.
-        pred_hist.front().predTaken = actually_taken;
-        pred_hist.front().target = corrTarget.instAddr();
+        pred_hist.back().predTaken = actually_taken;
+        pred_hist.back().target = corrTarget.instAddr();
 
         update(tid, (*hist_it).pc, actually_taken,
-               pred_hist.front().bpHistory, true, pred_hist.front().inst,
+               pred_hist.back().bpHistory, true, pred_hist.back().inst,
                corrTarget.instAddr());
 
         if (iPred) {
             iPred->changeDirectionPrediction(tid,
-                pred_hist.front().indirectHistory, actually_taken);
+                pred_hist.back().indirectHistory, actually_taken);
         }
 
         if (actually_taken) {
@@ -447,7 +468,7 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
                 ++stats.indirectMispredicted;
                 if (iPred) {
                     iPred->recordTarget(
-                        hist_it->seqNum, pred_hist.front().indirectHistory,
+                        hist_it->seqNum, pred_hist.back().indirectHistory,
                         corrTarget, tid);
                 }
             } else {
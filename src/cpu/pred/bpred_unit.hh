@@ -42,8 +42,7 @@
 #ifndef __CPU_PRED_BPRED_UNIT_HH__
 #define __CPU_PRED_BPRED_UNIT_HH__
 
-#include <deque>
-
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/pred/btb.hh"
@@ -63,6 +62,16 @@ class BPredUnit : public SimObject
 {
   public:
       typedef BranchPredictorParams Params;
+
+    /** A branch committed through update(), with its resolved outcome */
+    struct CommittedBranch
+    {
+        ThreadID tid;
+        Addr pc;
+        Addr target;
+        bool taken;
+        const StaticInst *inst;
+    };
     /**
      * @param params The params object, that has the size of the BP and BTB.
      */
@@ -157,6 +166,18 @@ class BPredUnit : public SimObject
     TheISA::PCState BTBLookup(Addr instPC)
     { return BTB.lookup(instPC, 0); }
 
+    /**
+     * Predicts where the instructions of a fetch block are left for, to
+     * run ahead of fetch. Only the BTB is looked at, and every branch it
+     * holds is taken to be taken; no predictor state is changed.
+     * @param tid The thread id.
+     * @param start_pc The address fetch enters the block at.
+     * @param block_end The address following the block.
+     * @return The target of the first branch found in the BTB after
+     * start_pc, or block_end if there is none.
+     */
+    Addr predictBlockExit(ThreadID tid, Addr start_pc, Addr block_end) const;
+
     /**
      * Updates the BP with taken/not taken information.
      * @param inst_PC The branch's PC that will be updated.
@@ -190,6 +211,10 @@ class BPredUnit : public SimObject
          * Makes a predictor history struct that contains any
          * information needed to update the predictor, BTB, and RAS.
          */
+        PredictorHistory() : PredictorHistory(0, 0, false, nullptr, nullptr,
+                                              0, nullptr)
+        {}
+
         PredictorHistory(const InstSeqNum &seq_num, Addr instPC,
                          bool pred_taken, void *bp_history,
                          void *indirect_history, ThreadID _tid,
@@ -252,10 +277,18 @@ class BPredUnit : public SimObject
         Addr target;
 
         /** The branch instrction */
-        const StaticInstPtr inst;
+        StaticInstPtr inst;
     };
 
-    typedef std::deque<PredictorHistory> History;
+    /**
+     * Branches in flight, oldest first. The ring grows when it is full,
+     * so it settles to the number of branches the CPU can have in flight
+     * and predictions don't allocate after that.
+     */
+    typedef CircularQueue<PredictorHistory> History;
+
+    /** Initial capacity of the per-thread history rings */
+    static const size_t InitialHistorySize = 64;
 
     /** Number of the threads for which the branch history is maintained. */
     const unsigned numThreads;
@@ -336,6 +369,9 @@ class BPredUnit : public SimObject
     /** Miss-predicted branches */
     ProbePoints::PMUUPtr ppMisses;
 
+    /** Branches committed, in program order; used to record traces */
+    ProbePointArg<CommittedBranch> *ppCommittedBranch;
+
     /** @} */
 };
 
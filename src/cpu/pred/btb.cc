@@ -33,10 +33,13 @@
 #include "debug/Fetch.hh"
 
 DefaultBTB::DefaultBTB(unsigned _numEntries,
+                       unsigned _assoc,
                        unsigned _tagBits,
                        unsigned _instShiftAmt,
                        unsigned _num_threads)
     : numEntries(_numEntries),
+      assoc(_assoc),
+      useCount(0),
       tagBits(_tagBits),
       instShiftAmt(_instShiftAmt),
       log2NumThreads(floorLog2(_num_threads))
@@ -47,17 +50,24 @@ DefaultBTB::DefaultBTB(unsigned _numEntries,
         fatal("BTB entries is not a power of 2!");
     }
 
+    if (assoc == 0 || numEntries % assoc || !isPowerOf2(numEntries / assoc)) {
+        fatal("BTB associativity must divide the entries in a power of 2 "
+              "number of sets!");
+    }
+
     btb.resize(numEntries);
 
     for (unsigned i = 0; i < numEntries; ++i) {
         btb[i].valid = false;
     }
 
-    idxMask = numEntries - 1;
+    numSets = numEntries / assoc;
+
+    idxMask = numSets - 1;
 
     tagMask = (1 << tagBits) - 1;
 
-    tagShiftAmt = instShiftAmt + floorLog2(numEntries);
+    tagShiftAmt = instShiftAmt + floorLog2(numSets);
 }
 
 void
@@ -70,7 +80,7 @@ DefaultBTB::reset()
 
 inline
 unsigned
-DefaultBTB::getIndex(Addr instPC, ThreadID tid)
+DefaultBTB::getIndex(Addr instPC, ThreadID tid) const
 {
     // Need to shift PC over by the word offset.
     return ((instPC >> instShiftAmt)
@@ -80,27 +90,42 @@ DefaultBTB::getIndex(Addr instPC, ThreadID tid)
 
 inline
 Addr
-DefaultBTB::getTag(Addr instPC)
+DefaultBTB::getTag(Addr instPC) const
 {
     return (instPC >> tagShiftAmt) & tagMask;
 }
 
-bool
-DefaultBTB::valid(Addr instPC, ThreadID tid)
+const DefaultBTB::BTBEntry *
+DefaultBTB::findEntry(Addr instPC, ThreadID tid) const
 {
     unsigned btb_idx = getIndex(instPC, tid);
 
     Addr inst_tag = getTag(instPC);
 
-    assert(btb_idx < numEntries);
+    assert(btb_idx < numSets);
 
-    if (btb[btb_idx].valid
-        && inst_tag == btb[btb_idx].tag
-        && btb[btb_idx].tid == tid) {
-        return true;
-    } else {
-        return false;
+    const BTBEntry *set = &btb[btb_idx * assoc];
+    for (unsigned way = 0; way < assoc; ++way) {
+        if (set[way].valid
+            && inst_tag == set[way].tag
+            && set[way].tid == tid) {
+            return &set[way];
+        }
     }
+    return nullptr;
+}
+
+DefaultBTB::BTBEntry *
+DefaultBTB::findEntry(Addr instPC, ThreadID tid)
+{
+    return const_cast<BTBEntry *>(
+        static_cast<const DefaultBTB *>(this)->findEntry(instPC, tid));
+}
+
+bool
+DefaultBTB::valid(Addr instPC, ThreadID tid)
+{
+    return findEntry(instPC, tid) != nullptr;
 }
 
 // @todo Create some sort of return struct that has both whether or not the
@@ -109,30 +134,50 @@ DefaultBTB::valid(Addr instPC, ThreadID tid)
 TheISA::PCState
 DefaultBTB::lookup(Addr instPC, ThreadID tid)
 {
-    unsigned btb_idx = getIndex(instPC, tid);
+    TheISA::PCState target = 0;
+    lookup(instPC, tid, target);
+    return target;
+}
 
-    Addr inst_tag = getTag(instPC);
+bool
+DefaultBTB::lookup(Addr instPC, ThreadID tid, TheISA::PCState &target)
+{
+    BTBEntry *entry = findEntry(instPC, tid);
+    if (!entry)
+        return false;
 
-    assert(btb_idx < numEntries);
+    entry->lastUse = ++useCount;
+    target = entry->target;
+    return true;
+}
 
-    if (btb[btb_idx].valid
-        && inst_tag == btb[btb_idx].tag
-        && btb[btb_idx].tid == tid) {
-        return btb[btb_idx].target;
-    } else {
-        return 0;
-    }
+const TheISA::PCState *
+DefaultBTB::probe(Addr instPC, ThreadID tid) const
+{
+    const BTBEntry *entry = findEntry(instPC, tid);
+    return entry ? &entry->target : nullptr;
 }
 
 void
 DefaultBTB::update(Addr instPC, const TheISA::PCState &target, ThreadID tid)
 {
-    unsigned btb_idx = getIndex(instPC, tid);
-
-    assert(btb_idx < numEntries);
+    BTBEntry *entry = findEntry(instPC, tid);
+
+    if (!entry) {
+        // Replace an invalid way if there is one, the LRU one otherwise.
+        unsigned btb_idx = getIndex(instPC, tid);
+        assert(btb_idx < numSets);
+        BTBEntry *set = &btb[btb_idx * assoc];
+        entry = &set[0];
+        for (unsigned way = 0; way < assoc && entry->valid; ++way) {
+            if (!set[way].valid || set[way].lastUse < entry->lastUse)
+                entry = &set[way];
+        }
+    }
 
-    btb[btb_idx].tid = tid;
-    btb[btb_idx].valid = true;
-    btb[btb_idx].target = target;
-    btb[btb_idx].tag = getTag(instPC);
+    entry->tid = tid;
+    entry->valid = true;
+    entry->target = target;
+    entry->tag = getTag(instPC);
+    entry->lastUse = ++useCount;
 }
@@ -40,7 +40,7 @@ class DefaultBTB
     struct BTBEntry
     {
         BTBEntry()
-            : tag(0), target(0), valid(false)
+            : tag(0), target(0), valid(false), lastUse(0)
         {}
 
         /** The entry's tag. */
@@ -54,16 +54,20 @@ class DefaultBTB
 
         /** Whether or not the entry is valid. */
         bool valid;
+
+        /** When the entry was last used, to replace the LRU way. */
+        uint64_t lastUse;
     };
 
   public:
-    /** Creates a BTB with the given number of entries, number of bits per
-     *  tag, and instruction offset amount.
+    /** Creates a BTB with the given number of entries, associativity,
+     *  number of bits per tag, and instruction offset amount.
      *  @param numEntries Number of entries for the BTB.
+     *  @param assoc Number of ways of each set of the BTB.
      *  @param tagBits Number of bits for each tag in the BTB.
      *  @param instShiftAmt Offset amount for instructions to ignore alignment.
      */
-    DefaultBTB(unsigned numEntries, unsigned tagBits,
+    DefaultBTB(unsigned numEntries, unsigned assoc, unsigned tagBits,
                unsigned instShiftAmt, unsigned numThreads);
 
     void reset();
@@ -82,6 +86,22 @@ class DefaultBTB
      */
     bool valid(Addr instPC, ThreadID tid);
 
+    /** Looks up an address in the BTB, in a single search of its set.
+     *  @param inst_PC The address of the branch to look up.
+     *  @param target Set to the target of the branch on a hit.
+     *  @param tid The thread id.
+     *  @return Whether or not the branch exists in the BTB.
+     */
+    bool lookup(Addr instPC, ThreadID tid, TheISA::PCState &target);
+
+    /** Looks up an address without counting it as a use of the entry,
+     *  for looking ahead of the branches being predicted.
+     *  @param inst_PC The address of the branch to look up.
+     *  @param tid The thread id.
+     *  @return The entry of the branch, or nullptr if it is not there.
+     */
+    const TheISA::PCState *probe(Addr instPC, ThreadID tid) const;
+
     /** Updates the BTB with the target of a branch.
      *  @param inst_PC The address of the branch being updated.
      *  @param target_PC The target address of the branch.
@@ -95,20 +115,36 @@ class DefaultBTB
      *  @param inst_PC The branch to look up.
      *  @return Returns the index into the BTB.
      */
-    inline unsigned getIndex(Addr instPC, ThreadID tid);
+    inline unsigned getIndex(Addr instPC, ThreadID tid) const;
 
     /** Returns the tag bits of a given address.
      *  @param inst_PC The branch's address.
      *  @return Returns the tag bits.
      */
-    inline Addr getTag(Addr instPC);
+    inline Addr getTag(Addr instPC) const;
+
+    /** Returns the entry of a branch, or nullptr if it is not in the BTB.
+     *  @param inst_PC The branch's address.
+     *  @param tid The thread id.
+     */
+    BTBEntry *findEntry(Addr instPC, ThreadID tid);
+    const BTBEntry *findEntry(Addr instPC, ThreadID tid) const;
 
-    /** The actual BTB. */
+    /** The actual BTB, with the ways of each set next to each other. */
     std::vector<BTBEntry> btb;
 
     /** The number of entries in the BTB. */
     unsigned numEntries;
 
+    /** The number of ways of each set. */
+    unsigned assoc;
+
+    /** The number of sets in the BTB. */
+    unsigned numSets;
+
+    /** Counter giving the order in which entries were used. */
+    uint64_t useCount;
+
     /** The index mask. */
     unsigned idxMask;
 
@@ -98,13 +98,20 @@ MultiperspectivePerceptron::ThreadData::ThreadData(int num_filters,
         modpath_histories[modpath_indices[i]].resize(modpath_lengths[i]);
     }
 
+    size_t num_weights = 0;
     for (int i = 0; i < table_sizes.size(); i += 1) {
-        mpreds.push_back(0);
-        tables.push_back(std::vector<short int>(table_sizes[i]));
-        sign_bits.push_back(std::vector<std::array<bool, 2>>(table_sizes[i]));
-        for (int j = 0; j < table_sizes[i]; j += 1) {
+        num_weights += table_sizes[i];
+    }
+    mpreds.resize(table_sizes.size(), 0);
+    entries.resize(table_sizes.size());
+    bestMask.resize(table_sizes.size(), 0);
+    weights.resize(num_weights, 0);
+    signBits.resize(num_weights * MaxSignBits, 0);
+    size_t entry = 0;
+    for (int i = 0; i < table_sizes.size(); i += 1) {
+        for (int j = 0; j < table_sizes[i]; j += 1, entry += 1) {
             for (int k = 0; k < n_sign_bits; k += 1) {
-                sign_bits[i][j][k] = (i & 1) | (k & 1);
+                signBits[entry * MaxSignBits + k] = (i & 1) | (k & 1);
             }
         }
     }
@@ -128,6 +135,8 @@ MultiperspectivePerceptron::MultiperspectivePerceptron(
     modhist_indices(), modhist_lengths(), modpath_indices(), modpath_lengths()
 {
     fatal_if(speculative_update, "Speculative update not implemented");
+    fatal_if(n_sign_bits < 1 || n_sign_bits > MaxSignBits,
+             "n_sign_bits must be between 1 and %d", MaxSignBits);
 }
 
 void
@@ -156,6 +165,23 @@ MultiperspectivePerceptron::init()
     computeBits(p.num_filter_entries, p.num_local_histories,
                 p.local_history_length, p.ignore_path_size);
 
+    unsigned int offset = 0;
+    tableXlat.resize(specs.size() * XlatSize, 0);
+    tableScaledXlat.resize(specs.size() * XlatSize, 0);
+    for (int i = 0; i < specs.size(); i += 1) {
+        const HistorySpec &spec = *specs[i];
+        fatal_if(spec.width != 5 && spec.width != 6,
+                 "Feature %d has unsupported width %d", i, spec.width);
+        tableOffsets.push_back(offset);
+        offset += table_sizes[i];
+        const int max_weight = (1 << (spec.width - 1)) - 1;
+        for (int c = 0; c <= max_weight; c += 1) {
+            const int weight = (spec.width == 5) ? xlat4[c] : xlat[c];
+            tableXlat[i * XlatSize + c] = weight;
+            tableScaledXlat[i * XlatSize + c] = spec.coeff * weight;
+        }
+    }
+
     for (int i = 0; i < threadData.size(); i += 1) {
         threadData[i] = new ThreadData(p.num_filter_entries,
                                        p.num_local_histories,
@@ -299,6 +325,15 @@ MultiperspectivePerceptron::getIndex(ThreadID tid, const MPPBranchInfo &bi,
     return h;
 }
 
+void
+MultiperspectivePerceptron::computeEntries(ThreadID tid,
+        const MPPBranchInfo &bi, std::vector<unsigned int> &entries) const
+{
+    for (int i = 0; i < specs.size(); i += 1) {
+        entries[i] = tableOffsets[i] + getIndex(tid, bi, *specs[i], i);
+    }
+}
+
 int
 MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
 {
@@ -321,42 +356,43 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
     } else if (lhist == ((1<<(history_len-1))-1)) {
         bi.yout = biasmostly1;
     }
+    ThreadData &td = *threadData[tid];
     // find the best subset of features to use in case of a low-confidence
     // branch
     findBest(tid, best_preds);
+    std::fill(td.bestMask.begin(), td.bestMask.end(), 0);
+    if (threshold >= 0) {
+        for (int j = 0; j < std::min(nbest, (int) best_preds.size()); j += 1) {
+            td.bestMask[best_preds[j]] = 1;
+        }
+    }
+
+    // hash all the features first, so that the sum below is a flat loop
+    // over the packed weights
+    computeEntries(tid, bi, td.entries);
 
     // begin computation of the sum for low-confidence branch
     int bestval = 0;
-
-    for (int i = 0; i < specs.size(); i += 1) {
-        HistorySpec const &spec = *specs[i];
-        // get the hash to index the table
-        unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-        // add the weight; first get the weight's magnitude
-        int counter = threadData[tid]->tables[i][hashed_idx];
-        // get the sign
-        bool sign =
-          threadData[tid]->sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
-        // apply the transfer function and multiply by a coefficient
-        int weight = spec.coeff * ((spec.width == 5) ?
-                                   xlat4[counter] : xlat[counter]);
+    int yout = 0;
+
+    const unsigned int *entries = td.entries.data();
+    const int8_t *weights = td.weights.data();
+    const uint8_t *sign_bits = td.signBits.data() + bi.getHPC() % n_sign_bits;
+    const uint8_t *best_mask = td.bestMask.data();
+    const int *xlat_tables = tableScaledXlat.data();
+    const int num_specs = specs.size();
+    for (int i = 0; i < num_specs; i += 1) {
+        const unsigned int entry = entries[i];
+        // the magnitude, through the transfer function and scaled by the
+        // coefficient of the feature
+        const int weight = xlat_tables[i * XlatSize + weights[entry]];
         // apply the sign
-        int val = sign ? -weight : weight;
-        // add the value
-        bi.yout += val;
+        const int val = sign_bits[entry * MaxSignBits] ? -weight : weight;
+        yout += val;
         // if this is one of those good features, add the value to bestval
-        if (threshold >= 0) {
-            for (int j = 0;
-                 j < std::min(nbest, (int) best_preds.size());
-                 j += 1)
-            {
-                if (best_preds[j] == i) {
-                    bestval += val;
-                    break;
-                }
-            }
-        }
+        bestval += best_mask[i] ? val : 0;
     }
+    bi.yout += yout;
     // apply a fudge factor to affect when training is triggered
     bi.yout *= fudge;
     return bestval;
@@ -402,27 +438,26 @@ MultiperspectivePerceptron::satIncDec(bool taken, bool &sign, int &counter,
 void
 MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
 {
-    std::vector<std::vector<short int>> &tables = threadData[tid]->tables;
-    std::vector<std::vector<std::array<bool, 2>>> &sign_bits =
-            threadData[tid]->sign_bits;
+    ThreadData &td = *threadData[tid];
+    std::vector<int8_t> &weights = td.weights;
+    std::vector<unsigned int> &entries = td.entries;
+    const unsigned int sign_bit = bi.getHPC() % n_sign_bits;
     std::vector<int> &mpreds = threadData[tid]->mpreds;
     // was the prediction correct?
     bool correct = (bi.yout >= 1) == taken;
     // what is the magnitude of yout?
     int abs_yout = abs(bi.yout);
+    // the features are hashed once; all the loops below use these entries
+    computeEntries(tid, bi, entries);
     // keep track of mispredictions per table
     if (threshold >= 0) if (!tuneonly || (abs_yout <= threshold)) {
         bool halve = false;
 
         // for each table, figure out if there was a misprediction
         for (int i = 0; i < specs.size(); i += 1) {
-            HistorySpec const &spec = *specs[i];
-            // get the hash to index the table
-            unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-            bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
-            int counter = tables[i][hashed_idx];
-            int weight = spec.coeff * ((spec.width == 5) ?
-                                       xlat4[counter] : xlat[counter]);
+            const unsigned int entry = entries[i];
+            bool sign = td.signBits[entry * MaxSignBits + sign_bit];
+            int weight = tableScaledXlat[i * XlatSize + weights[entry]];
             if (sign) weight = -weight;
             bool pred = weight >= 1;
             if (pred != taken) {
@@ -465,17 +500,18 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
     int newyout = 0;
     for (int i = 0; i < specs.size(); i += 1) {
         HistorySpec const &spec = *specs[i];
+        const unsigned int entry = entries[i];
         // get the magnitude
-        unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-        int counter = tables[i][hashed_idx];
+        int counter = weights[entry];
         // get the sign
-        bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+        uint8_t &sign_ref = td.signBits[entry * MaxSignBits + sign_bit];
+        bool sign = sign_ref;
         // increment/decrement if taken/not taken
         satIncDec(taken, sign, counter, (1 << (spec.width - 1)) - 1);
         // update the magnitude and sign
-        tables[i][hashed_idx] = counter;
-        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits] = sign;
-        int weight = ((spec.width == 5) ? xlat4[counter] : xlat[counter]);
+        weights[entry] = counter;
+        sign_ref = sign;
+        int weight = tableXlat[i * XlatSize + counter];
         // update the new version of yout
         if (sign) {
             newyout -= weight;
@@ -499,13 +535,10 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 found = false;
                 for (int j = 0; j < specs.size(); j += 1) {
                     int i = (nrand + j) % specs.size();
-                    HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-                    int counter = tables[i][hashed_idx];
-                    bool sign =
-                        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
-                    int weight = ((spec.width == 5) ?
-                            xlat4[counter] : xlat[counter]);
+                    const unsigned int entry = entries[i];
+                    int counter = weights[entry];
+                    bool sign = td.signBits[entry * MaxSignBits + sign_bit];
+                    int weight = tableXlat[i * XlatSize + counter];
                     int signed_weight = sign ? -weight : weight;
                     pout = newyout - signed_weight;
                     if ((pout >= 1) == taken) {
@@ -517,17 +550,14 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 }
                 if (besti != -1) {
                     int i = besti;
-                    HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-                    int counter = tables[i][hashed_idx];
-                    bool sign =
-                        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+                    const unsigned int entry = entries[i];
+                    int counter = weights[entry];
+                    bool sign = td.signBits[entry * MaxSignBits + sign_bit];
                     if (counter > 1) {
                         counter--;
-                        tables[i][hashed_idx] = counter;
+                        weights[entry] = counter;
                     }
-                    int weight = ((spec.width == 5) ?
-                            xlat4[counter] : xlat[counter]);
+                    int weight = tableXlat[i * XlatSize + counter];
                     int signed_weight = sign ? -weight : weight;
                     int out = pout + signed_weight;
                     round_counter += 1;
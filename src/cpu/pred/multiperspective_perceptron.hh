@@ -39,7 +39,7 @@
 #ifndef __CPU_PRED_MULTIPERSPECTIVE_PERCEPTRON_HH__
 #define __CPU_PRED_MULTIPERSPECTIVE_PERCEPTRON_HH__
 
-#include <array>
+#include <cstdint>
 #include <vector>
 
 #include "cpu/pred/bpred_unit.hh"
@@ -284,6 +284,11 @@ class MultiperspectivePerceptron : public BPredUnit
     /** Transfer function for 5-width tables */
     static int xlat4[];
 
+    /** Number of entries of the per-table transfer functions */
+    static constexpr int XlatSize = 32;
+    /** Maximum number of sign bits kept per weight */
+    static constexpr int MaxSignBits = 2;
+
     /** History data is kept for each thread */
     struct ThreadData {
         ThreadData(int num_filter, int n_local_histories,
@@ -342,14 +347,33 @@ class MultiperspectivePerceptron : public BPredUnit
         int occupancy;
 
         std::vector<int> mpreds;
-        std::vector<std::vector<short int>> tables;
-        std::vector<std::vector<std::array<bool, 2>>> sign_bits;
+        /**
+         * Weights of all the predictor tables, packed back to back; table
+         * i starts at tableOffsets[i]. The perceptron keeps magnitudes here
+         * and their signs in signBits, MPP-TAGE keeps signed counters
+         */
+        std::vector<int8_t> weights;
+        /** Sign bits of each weight, MaxSignBits per weight */
+        std::vector<uint8_t> signBits;
+        /** Position in weights of each feature for the current branch */
+        std::vector<unsigned int> entries;
+        /** Whether each feature is one of the nbest of this thread */
+        std::vector<uint8_t> bestMask;
     };
     std::vector<ThreadData *> threadData;
 
     /** Predictor tables */
     std::vector<HistorySpec *> specs;
     std::vector<int> table_sizes;
+    /** Offset of the first weight of each table in ThreadData::weights */
+    std::vector<unsigned int> tableOffsets;
+    /**
+     * Transfer function of each table (XlatSize entries per table), as is
+     * and multiplied by the coefficient of the feature, so that the weight
+     * sums do not depend on the width or the coefficient of each spec
+     */
+    std::vector<int> tableXlat;
+    std::vector<int> tableScaledXlat;
 
     /** runtime values and data used to count the size in bits */
     bool doing_local;
@@ -436,6 +460,16 @@ class MultiperspectivePerceptron : public BPredUnit
      */
     unsigned int getIndex(ThreadID tid, const MPPBranchInfo &bi,
             const HistorySpec &spec, int index) const;
+
+    /**
+     * Computes the position in ThreadData::weights of the weight selected
+     * by every feature for the given branch
+     * @param tid Thread ID of the branch
+     * @param bi branch informaiton data
+     * @param entries vector to write the positions to, one per table
+     */
+    void computeEntries(ThreadID tid, const MPPBranchInfo &bi,
+            std::vector<unsigned int> &entries) const;
     /**
      * Finds the best subset of features to use in case of a low-confidence
      * branch, returns the result as an ordered vector of the indices to the
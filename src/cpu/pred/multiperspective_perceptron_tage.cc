@@ -220,11 +220,7 @@ MPP_TAGE::updatePathAndGlobalHistory(
         path >>= 1;
         updateGHist(tHist.gHist, dir, tHist.globalHistory, tHist.ptGhist);
         tHist.pathHist = (tHist.pathHist << 1) ^ pathbit;
-        for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].update(tHist.gHist);
-            tHist.computeTags[0][i].update(tHist.gHist);
-            tHist.computeTags[1][i].update(tHist.gHist);
-        }
+        tHist.folded.update(tHist.gHist);
     }
 }
 
@@ -423,10 +419,11 @@ int
 MultiperspectivePerceptronTAGE::computePartialSum(ThreadID tid,
                                                   MPPTAGEBranchInfo &bi) const
 {
+    const int8_t *weights = threadData[tid]->weights.data();
     int yout = 0;
     for (int i = 0; i < specs.size(); i += 1) {
         yout += specs[i]->coeff *
-            threadData[tid]->tables[i][getIndex(tid, bi, *specs[i], i)];
+            weights[tableOffsets[i] + getIndex(tid, bi, *specs[i], i)];
     }
     return yout;
 }
@@ -439,10 +436,9 @@ MultiperspectivePerceptronTAGE::updatePartial(ThreadID tid,
     // update tables
     for (int i = 0; i < specs.size(); i += 1) {
         unsigned int idx = getIndex(tid, bi, *specs[i], i);
-        short int *c =
-            &threadData[tid]->tables[i][idx];
-        short int max_weight = (1 << (specs[i]->width - 1)) - 1;
-        short int min_weight = -(1 << (specs[i]->width - 1));
+        int8_t *c = &threadData[tid]->weights[tableOffsets[i] + idx];
+        int8_t max_weight = (1 << (specs[i]->width - 1)) - 1;
+        int8_t min_weight = -(1 << (specs[i]->width - 1));
         if (taken) {
             if (*c < max_weight) {
                 *c += 1;
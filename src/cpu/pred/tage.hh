@@ -53,6 +53,7 @@
 #include "base/types.hh"
 #include "cpu/pred/bpred_unit.hh"
 #include "cpu/pred/tage_base.hh"
+#include "mem/mem_pool.hh"
 #include "params/TAGE.hh"
 
 class TAGE: public BPredUnit
@@ -60,7 +61,7 @@ class TAGE: public BPredUnit
   protected:
     TAGEBase *tage;
 
-    struct TageBranchInfo {
+    struct TageBranchInfo : public MemPoolAllocated {
         TAGEBase::BranchInfo *tageBranchInfo;
 
         TageBranchInfo(TAGEBase &tage) : tageBranchInfo(tage.makeBranchInfo())
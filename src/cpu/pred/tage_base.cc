@@ -121,10 +121,7 @@ TAGEBase::init()
     assert(tagTableTagWidths[0] == 0);
 
     for (auto& history : threadHistory) {
-        history.computeIndices = new FoldedHistory[nHistoryTables+1];
-        history.computeTags[0] = new FoldedHistory[nHistoryTables+1];
-        history.computeTags[1] = new FoldedHistory[nHistoryTables+1];
-
+        history.folded.init(nHistoryTables);
         initFoldedHistories(history);
     }
 
@@ -145,12 +142,9 @@ void
 TAGEBase::initFoldedHistories(ThreadHistory & history)
 {
     for (int i = 1; i <= nHistoryTables; i++) {
-        history.computeIndices[i].init(
-            histLengths[i], (logTagTableSizes[i]));
-        history.computeTags[0][i].init(
-            history.computeIndices[i].origLength, tagTableTagWidths[i]);
-        history.computeTags[1][i].init(
-            history.computeIndices[i].origLength, tagTableTagWidths[i]-1);
+        history.folded.init(i, 0, histLengths[i], (logTagTableSizes[i]));
+        history.folded.init(i, 1, histLengths[i], tagTableTagWidths[i]);
+        history.folded.init(i, 2, histLengths[i], tagTableTagWidths[i]-1);
         DPRINTF(Tage, "HistLength:%d, TTSize:%d, TTTWidth:%d\n",
                 histLengths[i], logTagTableSizes[i], tagTableTagWidths[i]);
     }
@@ -186,14 +180,8 @@ TAGEBase::btbUpdate(ThreadID tid, Addr branch_pc, BranchInfo* &bi)
         DPRINTF(Tage, "BTB miss resets prediction: %lx\n", branch_pc);
         assert(tHist.gHist == &tHist.globalHistory[tHist.ptGhist]);
         tHist.gHist[0] = 0;
-        for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].comp = bi->ci[i];
-            tHist.computeTags[0][i].comp = bi->ct0[i];
-            tHist.computeTags[1][i].comp = bi->ct1[i];
-            tHist.computeIndices[i].update(tHist.gHist);
-            tHist.computeTags[0][i].update(tHist.gHist);
-            tHist.computeTags[1][i].update(tHist.gHist);
-        }
+        tHist.folded.restore(bi->folded);
+        tHist.folded.update(tHist.gHist);
     }
 }
 
@@ -230,7 +218,7 @@ TAGEBase::gindex(ThreadID tid, Addr pc, int bank) const
     index =
         shiftedPc ^
         (shiftedPc >> ((int) abs(logTagTableSizes[bank] - bank) + 1)) ^
-        threadHistory[tid].computeIndices[bank].comp ^
+        threadHistory[tid].folded.index(bank) ^
         F(threadHistory[tid].pathHist, hlen, bank);
 
     return (index & ((ULL(1) << (logTagTableSizes[bank])) - 1));
@@ -242,8 +230,8 @@ uint16_t
 TAGEBase::gtag(ThreadID tid, Addr pc, int bank) const
 {
     int tag = (pc >> instShiftAmt) ^
-              threadHistory[tid].computeTags[0][bank].comp ^
-              (threadHistory[tid].computeTags[1][bank].comp << 1);
+              threadHistory[tid].folded.tag(0, bank) ^
+              (threadHistory[tid].folded.tag(1, bank) << 1);
 
     return (tag & ((ULL(1) << tagTableTagWidths[bank]) - 1));
 }
@@ -601,17 +589,9 @@ TAGEBase::updateHistories(ThreadID tid, Addr branch_pc, bool taken,
     }
 
     //prepare next index and tag computations for user branchs
-    for (int i = 1; i <= nHistoryTables; i++)
-    {
-        if (speculative) {
-            bi->ci[i]  = tHist.computeIndices[i].comp;
-            bi->ct0[i] = tHist.computeTags[0][i].comp;
-            bi->ct1[i] = tHist.computeTags[1][i].comp;
-        }
-        tHist.computeIndices[i].update(tHist.gHist);
-        tHist.computeTags[0][i].update(tHist.gHist);
-        tHist.computeTags[1][i].update(tHist.gHist);
-    }
+    if (speculative)
+        tHist.folded.save(bi->folded);
+    tHist.folded.update(tHist.gHist);
     DPRINTF(Tage, "Updating global histories with branch:%lx; taken?:%d, "
             "path Hist: %x; pointer:%d\n", branch_pc, taken, tHist.pathHist,
             tHist.ptGhist);
@@ -635,14 +615,8 @@ TAGEBase::squash(ThreadID tid, bool taken, TAGEBase::BranchInfo *bi,
     tHist.ptGhist = bi->ptGhist;
     tHist.gHist = &(tHist.globalHistory[tHist.ptGhist]);
     tHist.gHist[0] = (taken ? 1 : 0);
-    for (int i = 1; i <= nHistoryTables; i++) {
-        tHist.computeIndices[i].comp = bi->ci[i];
-        tHist.computeTags[0][i].comp = bi->ct0[i];
-        tHist.computeTags[1][i].comp = bi->ct1[i];
-        tHist.computeIndices[i].update(tHist.gHist);
-        tHist.computeTags[0][i].update(tHist.gHist);
-        tHist.computeTags[1][i].update(tHist.gHist);
-    }
+    tHist.folded.restore(bi->folded);
+    tHist.folded.update(tHist.gHist);
 }
 
 void
@@ -48,10 +48,12 @@
 #ifndef __CPU_PRED_TAGE_BASE
 #define __CPU_PRED_TAGE_BASE
 
+#include <algorithm>
 #include <vector>
 
 #include "base/statistics.hh"
 #include "cpu/static_inst.hh"
+#include "mem/mem_pool.hh"
 #include "params/TAGEBase.hh"
 #include "sim/sim_object.hh"
 
@@ -76,33 +78,101 @@ class TAGEBase : public SimObject
     // Folded History Table - compressed history
     // to mix with instruction PC to index partially
     // tagged tables.
-    struct FoldedHistory
+    //
+    // Each tagged table has three foldings of the global history, one
+    // for its index and two for its tag. They are kept together as a
+    // structure of arrays, so that the foldings of all the tables are
+    // updated by a single loop without dependencies between iterations,
+    // which the compiler turns into vector code.
+    class FoldedHistories
     {
-        unsigned comp;
-        int compLength;
-        int origLength;
-        int outpoint;
-        int bufferSize;
+      public:
+        /** Number of foldings per table */
+        static const int PerTable = 3;
 
-        FoldedHistory()
+        /** Size the arrays for tables 1 to num_tables */
+        void
+        init(int num_tables)
         {
-            comp = 0;
+            const size_t size = PerTable * (num_tables + 1);
+            comp.assign(size, 0);
+            mask.assign(size, 0);
+            origLength.assign(size, 0);
+            compLength.assign(size, 0);
+            outpoint.assign(size, 0);
         }
 
-        void init(int original_length, int compressed_length)
+        /**
+         * Set up a folding.
+         *
+         * @param bank The table
+         * @param kind 0 for the index, 1 and 2 for the tag
+         */
+        void
+        init(int bank, int kind, int original_length, int compressed_length)
         {
-            origLength = original_length;
-            compLength = compressed_length;
-            outpoint = original_length % compressed_length;
+            const int i = PerTable * bank + kind;
+            origLength[i] = original_length;
+            compLength[i] = compressed_length;
+            outpoint[i] = original_length % compressed_length;
+            mask[i] = (ULL(1) << compressed_length) - 1;
         }
 
-        void update(uint8_t * h)
+        unsigned &index(int bank) { return comp[PerTable * bank]; }
+        unsigned index(int bank) const { return comp[PerTable * bank]; }
+
+        unsigned &
+        tag(int which, int bank)
+        {
+            return comp[PerTable * bank + 1 + which];
+        }
+
+        unsigned
+        tag(int which, int bank) const
+        {
+            return comp[PerTable * bank + 1 + which];
+        }
+
+        /** Number of values saved and restored by save and restore */
+        size_t size() const { return comp.size(); }
+
+        void
+        save(unsigned *dst) const
         {
-            comp = (comp << 1) | h[0];
-            comp ^= h[origLength] << outpoint;
-            comp ^= (comp >> compLength);
-            comp &= (ULL(1) << compLength) - 1;
+            std::copy(comp.begin() + PerTable, comp.end(), dst + PerTable);
         }
+
+        void
+        restore(const unsigned *src)
+        {
+            std::copy(src + PerTable, src + comp.size(),
+                      comp.begin() + PerTable);
+        }
+
+        /** Shift the latest outcome h[0] into every folding */
+        void
+        update(const uint8_t *h)
+        {
+            const unsigned in = h[0];
+            unsigned *c = comp.data();
+            const unsigned *m = mask.data();
+            const unsigned *ol = origLength.data();
+            const unsigned *cl = compLength.data();
+            const unsigned *op = outpoint.data();
+            for (size_t i = PerTable; i < comp.size(); ++i) {
+                unsigned v = (c[i] << 1) | in;
+                v ^= unsigned(h[ol[i]]) << op[i];
+                v ^= v >> cl[i];
+                c[i] = v & m[i];
+            }
+        }
+
+      private:
+        std::vector<unsigned> comp;
+        std::vector<unsigned> mask;
+        std::vector<unsigned> origLength;
+        std::vector<unsigned> compLength;
+        std::vector<unsigned> outpoint;
     };
 
   public:
@@ -117,7 +187,7 @@ class TAGEBase : public SimObject
     };
 
     // Primary branch history entry
-    struct BranchInfo
+    struct BranchInfo : public MemPoolAllocated
     {
         int pathHist;
         int ptGhist;
@@ -136,16 +206,15 @@ class TAGEBase : public SimObject
 
         // Pointer to dynamically allocated storage
         // to save table indices and folded histories.
-        // To do one call to new instead of five.
+        // To do one call to new instead of three.
         int *storage;
+        size_t storageSize;
 
         // Pointers to actual saved array within the dynamically
         // allocated storage.
         int *tableIndices;
         int *tableTags;
-        int *ci;
-        int *ct0;
-        int *ct1;
+        unsigned *folded;
 
         // for stats purposes
         unsigned provider;
@@ -161,17 +230,17 @@ class TAGEBase : public SimObject
               provider(-1)
         {
             int sz = tage.nHistoryTables + 1;
-            storage = new int [sz * 5];
+            const int folded_sz = FoldedHistories::PerTable * sz;
+            storageSize = (sz * 2 + folded_sz) * sizeof(int);
+            storage = static_cast<int *>(memPool().allocate(storageSize));
             tableIndices = storage;
             tableTags = storage + sz;
-            ci = tableTags + sz;
-            ct0 = ci + sz;
-            ct1 = ct0 + sz;
+            folded = reinterpret_cast<unsigned *>(tableTags + sz);
         }
 
         virtual ~BranchInfo()
         {
-            delete[] storage;
+            memPool().deallocate(storage, storageSize);
         }
     };
 
@@ -448,8 +517,7 @@ class TAGEBase : public SimObject
         int ptGhist;
 
         // Speculative folded histories.
-        FoldedHistory *computeIndices;
-        FoldedHistory *computeTags[2];
+        FoldedHistories folded;
     };
 
     std::vector<ThreadHistory> threadHistory;
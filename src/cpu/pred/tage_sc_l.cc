@@ -181,7 +181,7 @@ TAGE_SC_L_TAGE::gindex(ThreadID tid, Addr pc, int bank) const
     // pc is not shifted by instShiftAmt in this implementation
     index = shortPc ^
             (shortPc >> ((int) abs(logTagTableSizes[bank] - bank) + 1)) ^
-            threadHistory[tid].computeIndices[bank].comp ^
+            threadHistory[tid].folded.index(bank) ^
             F(threadHistory[tid].pathHist, hlen, bank);
 
     index = gindex_ext(index, bank);
@@ -247,11 +247,7 @@ TAGE_SC_L_TAGE::updatePathAndGlobalHistory(
             // The 8KB implementation does not do this truncation
             tHist.pathHist = (tHist.pathHist & ((ULL(1) << pathHistBits) - 1));
         }
-        for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].update(tHist.gHist);
-            tHist.computeTags[0][i].update(tHist.gHist);
-            tHist.computeTags[1][i].update(tHist.gHist);
-        }
+        tHist.folded.update(tHist.gHist);
     }
 }
 
@@ -200,8 +200,8 @@ uint16_t
 TAGE_SC_L_TAGE_64KB::gtag(ThreadID tid, Addr pc, int bank) const
 {
     // very similar to the TAGE implementation, but w/o shifting the pc
-    int tag = pc ^ threadHistory[tid].computeTags[0][bank].comp ^
-              (threadHistory[tid].computeTags[1][bank].comp << 1);
+    int tag = pc ^ threadHistory[tid].folded.tag(0, bank) ^
+              (threadHistory[tid].folded.tag(1, bank) << 1);
 
     return (tag & ((ULL(1) << tagTableTagWidths[bank]) - 1));
 }
@@ -143,12 +143,10 @@ TAGE_SC_L_TAGE_8KB::initFoldedHistories(ThreadHistory & history)
     // Some hardcoded values are used here
     // (they do not seem to depend on any parameter)
     for (int i = 1; i <= nHistoryTables; i++) {
-        history.computeIndices[i].init(
+        history.folded.init(i, 0,
             histLengths[i], 17 + (2 * ((i - 1) / 2) % 4));
-        history.computeTags[0][i].init(
-            history.computeIndices[i].origLength, 13);
-        history.computeTags[1][i].init(
-            history.computeIndices[i].origLength, 11);
+        history.folded.init(i, 1, histLengths[i], 13);
+        history.folded.init(i, 2, histLengths[i], 11);
         DPRINTF(TageSCL, "HistLength:%d, TTSize:%d, TTTWidth:%d\n",
                 histLengths[i], logTagTableSizes[i], tagTableTagWidths[i]);
     }
@@ -164,16 +162,16 @@ TAGE_SC_L_TAGE_8KB::gindex_ext(int index, int bank) const
 uint16_t
 TAGE_SC_L_TAGE_8KB::gtag(ThreadID tid, Addr pc, int bank) const
 {
-    int tag = (threadHistory[tid].computeIndices[bank - 1].comp << 2) ^ pc ^
+    int tag = (threadHistory[tid].folded.index(bank - 1) << 2) ^ pc ^
               (pc >> instShiftAmt) ^
-              threadHistory[tid].computeIndices[bank].comp;
+              threadHistory[tid].folded.index(bank);
     int hlen = (histLengths[bank] > pathHistBits) ? pathHistBits :
                                                     histLengths[bank];
 
     tag = (tag >> 1) ^ ((tag & 1) << 10) ^
            F(threadHistory[tid].pathHist, hlen, bank);
-    tag ^= threadHistory[tid].computeTags[0][bank].comp ^
-           (threadHistory[tid].computeTags[1][bank].comp << 1);
+    tag ^= threadHistory[tid].folded.tag(0, bank) ^
+           (threadHistory[tid].folded.tag(1, bank) << 1);
 
     return ((tag ^ (tag >> tagTableTagWidths[bank]))
             & ((ULL(1) << tagTableTagWidths[bank]) - 1));
@@ -46,6 +46,7 @@
 #include "base/sat_counter.hh"
 #include "base/types.hh"
 #include "cpu/pred/bpred_unit.hh"
+#include "mem/mem_pool.hh"
 #include "params/TournamentBP.hh"
 
 /**
@@ -151,7 +152,7 @@ class TournamentBP : public BPredUnit
      * when the BP can use this information to update/restore its
      * state properly.
      */
-    struct BPHistory {
+    struct BPHistory : public MemPoolAllocated {
 #ifdef DEBUG
         BPHistory()
         { newCount++; }
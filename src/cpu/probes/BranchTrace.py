@@ -0,0 +1,47 @@
+# Copyright (c) 2021 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+
+from m5.params import *
+from m5.proxy import *
+from m5.objects.Probe import ProbeListenerObject
+
+# Write every branch committed by a CPU to a compressed trace, which
+# BranchTraceReplay replays against branch predictors without a CPU.
+# The manager must be the branch predictor of the CPU, which is the
+# default when the trace is made a child of it.
+class BranchTrace(ProbeListenerObject):
+    type = 'BranchTrace'
+    cxx_header = 'cpu/probes/branch_trace.hh'
+
+    cpu = Param.BaseCPU(Parent.any, "CPU whose instructions are counted")
+    trace_file = Param.String("", "Trace output file, the object name "
+                              "followed by .btrc.gz if not set")
+    batch_size = Param.Unsigned(4096, "Number of branches written in one go")
+    write_depth = Param.Unsigned(4, "Number of batches queued for the "
+                                 "writer thread, 0 writes them on the "
+                                 "simulation thread")
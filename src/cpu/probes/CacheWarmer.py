@@ -0,0 +1,51 @@
+# Copyright (c) 2021 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+from m5.params import *
+from m5.proxy import *
+from m5.objects.Probe import ProbeListenerObject
+from m5.util.pybind import PyBindMethod
+
+# Record the memory accesses a KVM CPU samples while fast-forwarding
+# and replay the most recent ones into the caches and TLBs before a
+# detailed CPU takes over, so it doesn't start with cold state. The
+# manager must be the KVM CPU, which needs a non-zero memSamplePeriod.
+class CacheWarmer(ProbeListenerObject):
+    type = 'CacheWarmer'
+    cxx_header = 'cpu/probes/cache_warmer.hh'
+
+    cxx_exports = [
+        PyBindMethod("warm"),
+    ]
+
+    system = Param.System(Parent.any, "System the warmer belongs to")
+    cpu = Param.BaseCPU("CPU whose TLBs are warmed, and whose first "
+                        "thread translates the sampled addresses")
+    cache = Param.BaseCache("Cache the accesses are replayed into, its "
+                            "misses fill the levels below it")
+    window = Param.Unsigned(65536, "Number of most recent sampled accesses "
+                            "replayed")
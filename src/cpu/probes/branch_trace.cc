@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/probes/branch_trace.hh"
+
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "cpu/base.hh"
+#include "params/BranchTrace.hh"
+#include "sim/byteswap.hh"
+
+const char BranchTrace::fileMagic[8] =
+    { 'g', 'e', 'm', '5', 'b', 't', 'r', 'c' };
+
+namespace
+{
+
+template <class T>
+void
+writeInt(gzFile stream, T val)
+{
+    val = htole(val);
+    gzwrite(stream, &val, sizeof(val));
+}
+
+} // anonymous namespace
+
+BranchTrace::BranchTrace(const BranchTraceParams &p)
+    : ProbeListenerObject(p), cpu(p.cpu), lastInsts(0), stream(nullptr),
+      writer([this](const std::vector<Record> &batch) {
+                 gzwrite(stream, batch.data(),
+                         batch.size() * sizeof(Record));
+             }, p.batch_size, p.write_depth)
+{
+    const std::string filename = simout.resolve(
+        p.trace_file != "" ? p.trace_file : name() + ".btrc.gz");
+    stream = gzopen(filename.c_str(), "wb");
+    fatal_if(!stream, "%s: Can't open trace file %s.\n", name(), filename);
+
+    gzwrite(stream, fileMagic, sizeof(fileMagic));
+    writeInt<uint32_t>(stream, version);
+    writeInt<uint32_t>(stream, sizeof(Record));
+
+    registerExitCallback([this]() { closeStream(); });
+}
+
+void
+BranchTrace::regProbeListeners()
+{
+    typedef ProbeListenerArg<BranchTrace, BPredUnit::CommittedBranch>
+        CommittedBranchListener;
+    listeners.push_back(new CommittedBranchListener(this, "CommittedBranch",
+                &BranchTrace::traceBranch));
+}
+
+void
+BranchTrace::traceBranch(const BPredUnit::CommittedBranch &branch)
+{
+    const StaticInst *inst = branch.inst;
+
+    uint8_t type = 0;
+    if (inst->isCondCtrl())
+        type |= Record::Conditional;
+    if (inst->isIndirectCtrl())
+        type |= Record::Indirect;
+    if (inst->isCall())
+        type |= Record::Call;
+    if (inst->isReturn())
+        type |= Record::Return;
+
+    // The predictor is updated a little after the branch commits, so
+    // the count may include a few younger instructions. They are
+    // accounted to the next branch, so the total is exact.
+    const Counter insts = cpu->totalInsts();
+
+    Record record;
+    record.pc = htole<uint64_t>(branch.pc);
+    record.target = htole<uint64_t>(branch.target);
+    record.insts = htole<uint32_t>(insts - lastInsts);
+    record.tid = htole<uint16_t>(branch.tid);
+    record.type = type;
+    record.taken = branch.taken;
+    writer.write(record);
+
+    lastInsts = insts;
+}
+
+void
+BranchTrace::closeStream()
+{
+    writer.close();
+    gzclose(stream);
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * @file
+ * A compressed trace of the branches committed by a CPU, which can be
+ * replayed against branch predictors without a CPU model by
+ * BranchTraceReplay.
+ *
+ * The trace is fed by the CommittedBranch probe point of BPredUnit.
+ * Records are gzip compressed by a background thread. All integers are
+ * little endian. The uncompressed stream starts with a header:
+ *
+ *   char[8]  "gem5btrc"
+ *   uint32   version
+ *   uint32   size of a record
+ *
+ * followed by fixed size records, see BranchTrace::Record.
+ */
+
+#ifndef __CPU_PROBES_BRANCH_TRACE_HH__
+#define __CPU_PROBES_BRANCH_TRACE_HH__
+
+#include <zlib.h>
+
+#include <cstdint>
+
+#include "base/batched_writer.hh"
+#include "base/types.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "sim/probe/probe.hh"
+
+class BaseCPU;
+struct BranchTraceParams;
+
+class BranchTrace : public ProbeListenerObject
+{
+  public:
+    static const char fileMagic[8];
+    static const uint32_t version = 1;
+
+    /** A committed branch */
+    struct Record
+    {
+        enum Type : uint8_t
+        {
+            Conditional = 0x1,
+            Indirect = 0x2,
+            Call = 0x4,
+            Return = 0x8,
+        };
+
+        uint64_t pc;
+        uint64_t target;
+        /**
+         * Instructions committed since the previous branch of the
+         * trace, this one included
+         */
+        uint32_t insts;
+        uint16_t tid;
+        uint8_t type;
+        uint8_t taken;
+    };
+    static_assert(sizeof(Record) == 24, "Unexpected trace record size");
+
+    BranchTrace(const BranchTraceParams &params);
+
+    void regProbeListeners() override;
+
+  private:
+    void traceBranch(const BPredUnit::CommittedBranch &branch);
+
+    /**
+     * Callback to write out the buffered records and close the file on
+     * exit, as SimObjects are not destroyed.
+     */
+    void closeStream();
+
+    /** CPU whose committed instructions are counted */
+    BaseCPU *const cpu;
+    /** Instructions the CPU had committed at the previous branch */
+    Counter lastInsts;
+
+    gzFile stream;
+    BatchedWriter<Record> writer;
+};
+
+#endif // __CPU_PROBES_BRANCH_TRACE_HH__
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/probes/cache_warmer.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "cpu/base.hh"
+#include "cpu/thread_context.hh"
+#include "debug/CacheWarmer.hh"
+#include "mem/cache/base.hh"
+#include "mem/packet.hh"
+#include "params/CacheWarmer.hh"
+#include "sim/system.hh"
+
+CacheWarmer::CacheWarmer(const CacheWarmerParams &p)
+    : ProbeListenerObject(p), cpu(p.cpu), cache(p.cache),
+      requestorId(p.system->getRequestorId(this)),
+      samples(p.window), next(0), numSamples(0), stats(this)
+{
+    fatal_if(p.window == 0, "%s: The window can't be empty.\n", name());
+}
+
+void
+CacheWarmer::regProbeListeners()
+{
+    typedef ProbeListenerArg<CacheWarmer, ProbePoints::MemSamples>
+        MemSamplesListener;
+    listeners.push_back(new MemSamplesListener(this, "MemSamples",
+                &CacheWarmer::recordSamples));
+}
+
+void
+CacheWarmer::recordSamples(const ProbePoints::MemSamples &addrs)
+{
+    for (Addr addr : addrs) {
+        samples[next] = addr;
+        next = (next + 1) % samples.size();
+        if (numSamples < samples.size())
+            ++numSamples;
+        else
+            ++stats.samplesDropped;
+    }
+    stats.samples += addrs.size();
+}
+
+void
+CacheWarmer::warm()
+{
+    fatal_if(cpu->switchedOut(), "%s: %s must be running to warm its "
+             "TLBs.\n", name(), cpu->name());
+
+    ThreadContext *tc = cpu->getContext(0);
+    const Addr blk_size = cache->getBlockSize();
+
+    DPRINTF(CacheWarmer, "Replaying %d accesses.\n", numSamples);
+
+    size_t idx = (next + samples.size() - numSamples) % samples.size();
+    for (; numSamples; --numSamples, idx = (idx + 1) % samples.size()) {
+        const Addr vaddr = samples[idx];
+        RequestPtr req = Request::create(
+            vaddr, 1, 0, requestorId, 0, tc->contextId());
+
+        // Translating also fills the TLBs
+        if (tc->getMMUPtr()->translateAtomic(req, tc, BaseTLB::Read) !=
+            NoFault) {
+            ++stats.translationFaults;
+            continue;
+        }
+        ++stats.replayed;
+
+        const Addr blk_addr = req->getPaddr() & ~(blk_size - 1);
+        if (cache->inCache(blk_addr, req->isSecure())) {
+            ++stats.hits;
+            continue;
+        }
+
+        RequestPtr blk_req = Request::create(
+            blk_addr, blk_size, req->getFlags(), requestorId);
+        Packet pkt(blk_req, MemCmd::ReadReq);
+        pkt.allocate();
+        cache->warmAccess(&pkt);
+        ++stats.fills;
+    }
+
+    ++stats.warmings;
+}
+
+CacheWarmer::CacheWarmerStats::CacheWarmerStats(Stats::Group *parent)
+    : Stats::Group(parent),
+      ADD_STAT(samples, UNIT_COUNT, "Number of sampled accesses recorded"),
+      ADD_STAT(samplesDropped, UNIT_COUNT,
+               "Number of sampled accesses that fell out of the window "
+               "before being replayed"),
+      ADD_STAT(warmings, UNIT_COUNT, "Number of times the state was warmed"),
+      ADD_STAT(replayed, UNIT_COUNT,
+               "Number of accesses replayed into the cache"),
+      ADD_STAT(translationFaults, UNIT_COUNT,
+               "Number of accesses dropped as they didn't translate"),
+      ADD_STAT(hits, UNIT_COUNT,
+               "Number of replayed accesses the cache already held"),
+      ADD_STAT(fills, UNIT_COUNT,
+               "Number of replayed accesses that filled the cache"),
+      ADD_STAT(hitRate, UNIT_RATIO,
+               "Fraction of the replayed accesses the cache already held",
+               hits / replayed)
+{
+}
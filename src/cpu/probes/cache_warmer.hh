@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Warms caches and TLBs up with the memory accesses a KVM CPU samples
+ * while fast-forwarding, before a detailed CPU takes over.
+ *
+ * KVM CPUs bypass the caches, so they would otherwise hand over cold
+ * caches at every switch. The warmer keeps the data addresses of the
+ * last window samples of the MemSamples probe. When asked to warm,
+ * the system is drained and no longer bypasses the caches: each
+ * address is translated by the detailed CPU's MMU, which fills its
+ * TLBs, and read atomically from the first level cache, which fills it
+ * and the levels below.
+ */
+
+#ifndef __CPU_PROBES_CACHE_WARMER_HH__
+#define __CPU_PROBES_CACHE_WARMER_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/request.hh"
+#include "sim/probe/pmu.hh"
+#include "sim/probe/probe.hh"
+
+class BaseCache;
+class BaseCPU;
+struct CacheWarmerParams;
+
+class CacheWarmer : public ProbeListenerObject
+{
+  public:
+    CacheWarmer(const CacheWarmerParams &params);
+
+    void regProbeListeners() override;
+
+    /**
+     * Replay the recorded accesses, oldest first, and forget them.
+     */
+    void warm();
+
+  private:
+    void recordSamples(const ProbePoints::MemSamples &addrs);
+
+    /** CPU whose MMU translates and caches the addresses */
+    BaseCPU *const cpu;
+    /** Cache the accesses are replayed into */
+    BaseCache *const cache;
+    const RequestorID requestorId;
+
+    /** Ring of the last samples, next is where the next one goes */
+    std::vector<Addr> samples;
+    size_t next;
+    /** Number of valid samples in the ring */
+    size_t numSamples;
+
+    struct CacheWarmerStats : public Stats::Group
+    {
+        CacheWarmerStats(Stats::Group *parent);
+
+        Stats::Scalar samples;
+        Stats::Scalar samplesDropped;
+        Stats::Scalar warmings;
+        Stats::Scalar replayed;
+        Stats::Scalar translationFaults;
+        Stats::Scalar hits;
+        Stats::Scalar fills;
+        Stats::Formula hitRate;
+    } stats;
+};
+
+#endif // __CPU_PROBES_CACHE_WARMER_HH__
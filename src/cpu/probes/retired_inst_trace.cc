@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/probes/retired_inst_trace.hh"
+
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "params/RetiredInstTrace.hh"
+#include "sim/byteswap.hh"
+#include "sim/core.hh"
+
+const char RetiredInstTrace::fileMagic[8] =
+    { 'g', 'e', 'm', '5', 'i', 't', 'r', 'c' };
+
+namespace
+{
+
+template <class T>
+void
+writeInt(std::ostream &os, T val)
+{
+    val = htole(val);
+    os.write(reinterpret_cast<const char *>(&val), sizeof(val));
+}
+
+} // anonymous namespace
+
+RetiredInstTrace::RetiredInstTrace(const RetiredInstTraceParams &p)
+    : ProbeListenerObject(p),
+      writer([this](const std::vector<Record> &batch) {
+                 stream.write(reinterpret_cast<const char *>(batch.data()),
+                              batch.size() * sizeof(Record));
+             }, p.batch_size, p.write_depth)
+{
+    fatal_if(!TRACING_ON, "%s: Instruction traces need a build with "
+             "tracing enabled.\n", name());
+
+    const std::string filename = simout.resolve(
+        p.trace_file != "" ? p.trace_file : name() + ".itrc");
+    stream.open(filename, std::ios::out | std::ios::binary |
+                std::ios::trunc);
+    fatal_if(!stream, "%s: Can't open trace file %s.\n", name(), filename);
+
+    const std::string cpu_name = p.manager->name();
+    stream.write(fileMagic, sizeof(fileMagic));
+    writeInt<uint32_t>(stream, version);
+    writeInt<uint32_t>(stream, sizeof(Record));
+    writeInt<uint64_t>(stream, SimClock::Frequency);
+    writeInt<uint32_t>(stream, cpu_name.size());
+    stream.write(cpu_name.data(), cpu_name.size());
+
+    registerExitCallback([this]() { closeStream(); });
+}
+
+void
+RetiredInstTrace::regProbeListeners()
+{
+    typedef ProbeListenerArg<RetiredInstTrace, BaseCPU::RetiredInstInfo>
+        RetiredInstListener;
+    listeners.push_back(new RetiredInstListener(this, "RetiredInstTrace",
+                &RetiredInstTrace::traceInst));
+}
+
+void
+RetiredInstTrace::traceInst(const BaseCPU::RetiredInstInfo &info)
+{
+    const StaticInst *inst = info.inst;
+
+    uint16_t flags = 0;
+    if (inst->isMicroop())
+        flags |= Record::IsMicroop;
+    if (inst->isLastMicroop())
+        flags |= Record::IsLastMicroop;
+    if (inst->isLoad())
+        flags |= Record::IsLoad;
+    if (inst->isStore() || inst->isAtomic())
+        flags |= Record::IsStore;
+    if (inst->isControl())
+        flags |= Record::IsControl;
+
+    Record record;
+    record.tick = htole<uint64_t>(curTick());
+    record.pc = htole<uint64_t>(info.pc);
+    record.opClass = htole<uint16_t>(inst->opClass());
+    record.flags = htole(flags);
+    record.pad = 0;
+    writer.write(record);
+}
+
+void
+RetiredInstTrace::closeStream()
+{
+    writer.close();
+    stream.close();
+}
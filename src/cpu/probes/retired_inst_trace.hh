@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A binary trace of the instructions committed by a CPU.
+ *
+ * The trace is fed by the RetiredInstTrace probe point of BaseCPU and
+ * written out by a background thread, so tracing costs little more
+ * than copying a record per instruction. All integers are little
+ * endian. The file starts with a header:
+ *
+ *   char[8]  "gem5itrc"
+ *   uint32   version
+ *   uint32   size of a record
+ *   uint64   tick frequency
+ *   uint32   length of the name of the CPU, followed by the name
+ *
+ * followed by fixed size records, see RetiredInstTrace::Record.
+ */
+
+#ifndef __CPU_PROBES_RETIRED_INST_TRACE_HH__
+#define __CPU_PROBES_RETIRED_INST_TRACE_HH__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "base/batched_writer.hh"
+#include "cpu/base.hh"
+#include "sim/probe/probe.hh"
+
+struct RetiredInstTraceParams;
+
+class RetiredInstTrace : public ProbeListenerObject
+{
+  public:
+    static const char fileMagic[8];
+    static const uint32_t version = 1;
+
+    /** A committed instruction */
+    struct Record
+    {
+        enum Flag : uint16_t
+        {
+            IsMicroop = 0x1,
+            IsLastMicroop = 0x2,
+            IsLoad = 0x4,
+            IsStore = 0x8,
+            IsControl = 0x10,
+        };
+
+        uint64_t tick;
+        uint64_t pc;
+        uint16_t opClass;
+        uint16_t flags;
+        uint32_t pad;
+    };
+    static_assert(sizeof(Record) == 24, "Unexpected trace record size");
+
+    RetiredInstTrace(const RetiredInstTraceParams &params);
+
+    void regProbeListeners() override;
+
+  private:
+    void traceInst(const BaseCPU::RetiredInstInfo &info);
+
+    /**
+     * Callback to write out the buffered records and close the file on
+     * exit, as SimObjects are not destroyed.
+     */
+    void closeStream();
+
+    std::ofstream stream;
+    BatchedWriter<Record> writer;
+};
+
+#endif // __CPU_PROBES_RETIRED_INST_TRACE_HH__
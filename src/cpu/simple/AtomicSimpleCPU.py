@@ -38,7 +38,6 @@
 
 from m5.params import *
 from m5.objects.BaseSimpleCPU import BaseSimpleCPU
-from m5.objects.SimPoint import SimPoint
 
 class AtomicSimpleCPU(BaseSimpleCPU):
     """Simple CPU model executing a configurable number of
@@ -59,8 +58,11 @@ class AtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
-
-    def addSimPointProbe(self, interval):
-        simpoint = SimPoint()
-        simpoint.interval = interval
-        self.probeListener = simpoint
+    inst_block_cache = Param.Bool(False, "Replay recently decoded blocks "
+        "of instructions instead of fetching and decoding each of them, "
+        "which skips most instruction fetches (for fast-forwarding)")
+    inst_block_cache_blocks = Param.Unsigned(16384, "Number of blocks "
+        "kept in the instruction block cache")
+    fuse_microops = Param.Bool(False, "Execute all the micro-ops of a "
+        "macro-op back to back in the cycle of the first one, instead of "
+        "one per cycle (for fast-forwarding)")
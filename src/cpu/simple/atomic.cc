@@ -77,16 +77,29 @@ AtomicSimpleCPU::AtomicSimpleCPU(const AtomicSimpleCPUParams &p)
       width(p.width), locked(false),
       simulate_data_stalls(p.simulate_data_stalls),
       simulate_inst_stalls(p.simulate_inst_stalls),
+      fuseMicroops(p.fuse_microops),
+      replayBlock(nullptr), replayPos(0), buildBlock(nullptr),
+      buildVAddr(0), buildPAddr(0), endBlock(false),
+      fetchPAddr(0), fetchInOneRegion(false),
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
       ppCommit(nullptr)
 {
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
-    data_amo_req = std::make_shared<Request>();
+    ifetch_req = Request::create();
+    data_read_req = Request::create();
+    data_write_req = Request::create();
+    data_amo_req = Request::create();
+
+    if (p.inst_block_cache) {
+        fatal_if(simulate_inst_stalls, "The instruction block cache "
+                 "can't be used when simulating instruction stalls.");
+        fatal_if(numThreads > 1, "The instruction block cache doesn't "
+                 "support multiple threads.");
+        instBlockCache.reset(
+            new InstBlockCache(p.inst_block_cache_blocks));
+    }
 }
 
 
@@ -147,6 +160,12 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have been changed behind our back, e.g. by a KVM CPU
+    // or when restoring a checkpoint.
+    leaveInstBlocks();
+    if (instBlockCache)
+        instBlockCache->clear();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -191,6 +210,7 @@ void
 AtomicSimpleCPU::switchOut()
 {
     BaseSimpleCPU::switchOut();
+    leaveInstBlocks();
 
     assert(!tickEvent.scheduled());
     assert(_status == BaseSimpleCPU::Running || _status == Idle);
@@ -298,6 +318,7 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
         for (auto &t_info : cpu->threadInfo) {
             TheISA::handleLockedSnoop(t_info->thread, pkt, cacheBlockMask);
         }
+        cpu->invalidateInstBlocks(pkt->getAddr(), pkt->getSize());
     }
 
     return 0;
@@ -325,6 +346,9 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
             TheISA::handleLockedSnoop(t_info->thread, pkt, cacheBlockMask);
         }
     }
+
+    if (pkt->isInvalidate() || pkt->isWrite())
+        cpu->invalidateInstBlocks(pkt->getAddr(), pkt->getSize());
 }
 
 bool
@@ -503,6 +527,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
+                    invalidateInstBlocks(req->getPaddr(), req->getSize());
                 }
                 dcache_access = true;
                 assert(!pkt.isError());
@@ -590,6 +615,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         } else {
             dcache_latency += sendPacket(dcachePort, &pkt);
+            invalidateInstBlocks(req->getPaddr(), req->getSize());
         }
 
         dcache_access = true;
@@ -628,14 +654,28 @@ AtomicSimpleCPU::tick()
     SimpleThread *thread = t_info.thread;
 
     Tick latency = 0;
+    bool fused = false;
 
     for (int i = 0; i < width || locked; ++i) {
-        baseStats.numCycles++;
-        updateCycleCounters(BaseCPU::CPU_STATE_ON);
+        if (!fused) {
+            baseStats.numCycles++;
+            updateCycleCounters(BaseCPU::CPU_STATE_ON);
+        }
 
         if (!curStaticInst || !curStaticInst->isDelayedCommit()) {
-            checkForInterrupts();
-            checkPcEventQueue();
+            if (instBlockCache) {
+                // Interrupts are only taken between replayed blocks,
+                // which end at the first control instruction anyway.
+                const TheISA::PCState pc = thread->pcState();
+                if (!inInstBlock())
+                    checkForInterrupts();
+                checkPcEventQueue();
+                if (!(thread->pcState() == pc))
+                    endBlock = true;
+            } else {
+                checkForInterrupts();
+                checkPcEventQueue();
+            }
         }
 
         // We must have just got suspended by a PC event
@@ -650,11 +690,28 @@ AtomicSimpleCPU::tick()
 
         bool needToFetch = !isRomMicroPC(pcState.microPC()) &&
                            !curMacroStaticInst;
+        if (needToFetch && instBlockCache) {
+            if (auto *cached = nextBlockInst(pcState)) {
+                predecodedInst = cached->inst;
+                predecodedPC = cached->decodedPC;
+                needToFetch = false;
+            }
+        }
         if (needToFetch) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
             fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
                                                  BaseTLB::Execute);
+            if (instBlockCache && fault == NoFault) {
+                const Addr paddr = ifetch_req->getPaddr();
+                if (t_info.fetchOffset == 0) {
+                    fetchPAddr = paddr + pcState.instAddr() -
+                        ifetch_req->getVaddr();
+                    fetchInOneRegion = true;
+                } else if (!InstBlockCache::sameRegion(paddr, fetchPAddr)) {
+                    fetchInOneRegion = false;
+                }
+            }
         }
 
         if (fault == NoFault) {
@@ -677,6 +734,9 @@ AtomicSimpleCPU::tick()
 
             preExecute();
 
+            if (instBlockCache && needToFetch && !t_info.stayAtPC)
+                recordBlockInst(pcState);
+
             Tick stall_ticks = 0;
             if (curStaticInst) {
                 fault = curStaticInst->execute(&t_info, traceData);
@@ -721,8 +781,26 @@ AtomicSimpleCPU::tick()
             }
 
         }
+        if (instBlockCache && curStaticInst &&
+            (fault != NoFault || curStaticInst->isControl() ||
+             curStaticInst->isSerializing() ||
+             curStaticInst->isNonSpeculative() ||
+             curStaticInst->isSquashAfter() ||
+             curStaticInst->isSyscall() || curStaticInst->isQuiesce())) {
+            // Later instructions may be decoded differently, or not be
+            // the next ones in memory.
+            endBlock = true;
+        }
+
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
+
+        // Go straight on with the next micro-op of the macro-op, which
+        // then doesn't use up a slot of the width or another cycle.
+        fused = fuseMicroops && fault == NoFault && curMacroStaticInst &&
+            _status != Idle;
+        if (fused)
+            --i;
     }
 
     if (tryCompleteDrain())
@@ -736,6 +814,87 @@ AtomicSimpleCPU::tick()
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+const InstBlockCache::Inst *
+AtomicSimpleCPU::nextBlockInst(const TheISA::PCState &pc)
+{
+    if (!replayBlock)
+        return nullptr;
+
+    if (replayPos < replayBlock->insts.size()) {
+        const InstBlockCache::Inst &next = replayBlock->insts[replayPos];
+        if (next.fetchPC == pc) {
+            ++replayPos;
+            return &next;
+        }
+    }
+
+    leaveInstBlocks();
+    return nullptr;
+}
+
+void
+AtomicSimpleCPU::recordBlockInst(const TheISA::PCState &fetch_pc)
+{
+    SimpleThread *thread = threadInfo[curThread]->thread;
+    const StaticInstPtr &decoded =
+        curMacroStaticInst ? curMacroStaticInst : curStaticInst;
+    if (!decoded)
+        return;
+
+    if (buildBlock && !endBlock && fetchInOneRegion &&
+        buildBlock->insts.size() < InstBlockCache::MaxBlockInsts &&
+        InstBlockCache::sameRegion(fetch_pc.instAddr(), buildVAddr) &&
+        InstBlockCache::sameRegion(fetchPAddr, buildPAddr)) {
+        buildBlock->insts.push_back({fetch_pc, thread->pcState(), decoded});
+        return;
+    }
+
+    // This instruction starts a new block.
+    buildBlock = nullptr;
+    endBlock = false;
+    if (!fetchInOneRegion)
+        return;
+
+    replayBlock = instBlockCache->lookup(fetchPAddr, fetch_pc, decoded);
+    if (replayBlock) {
+        ++replayBlock->entries;
+        replayPos = 1;
+        return;
+    }
+
+    buildBlock = &instBlockCache->insert(fetchPAddr);
+    buildBlock->insts.push_back({fetch_pc, thread->pcState(), decoded});
+    buildVAddr = fetch_pc.instAddr();
+    buildPAddr = fetchPAddr;
+}
+
+void
+AtomicSimpleCPU::leaveInstBlocks()
+{
+    // The decoder hasn't seen the replayed instructions, make sure it
+    // starts afresh with the next one.
+    if (replayBlock)
+        threadInfo[curThread]->thread->decoder.reset();
+    replayBlock = nullptr;
+    buildBlock = nullptr;
+    endBlock = false;
+}
+
+PortProxy::SendFunctionalFunc
+AtomicSimpleCPU::getSendFunctional()
+{
+    if (!instBlockCache)
+        return BaseSimpleCPU::getSendFunctional();
+
+    // Port proxies write memory on behalf of system calls or loaders,
+    // which may modify code.
+    return [this](PacketPtr pkt) {
+        if (pkt->isWrite())
+            invalidateInstBlocks(pkt->getAddr(), pkt->getSize());
+        dcachePort.sendFunctional(pkt);
+    };
+}
+
 Tick
 AtomicSimpleCPU::fetchInstMem()
 {
@@ -41,8 +41,11 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <memory>
+
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
+#include "cpu/simple/inst_block_cache.hh"
 #include "mem/request.hh"
 #include "params/AtomicSimpleCPU.hh"
 #include "sim/probe/probe.hh"
@@ -63,9 +66,11 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     bool locked;
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
+    /** Execute the micro-ops of a macro-op within a single cycle. */
+    const bool fuseMicroops;
 
     // main simulation loop (one cycle)
-    void tick();
+    virtual void tick();
 
     /**
      * Check if a system is in a drained state.
@@ -103,6 +108,57 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     virtual Tick sendPacket(RequestPort &port, const PacketPtr &pkt);
     virtual Tick fetchInstMem();
 
+    /** Decoded instruction blocks, if enabled. */
+    std::unique_ptr<InstBlockCache> instBlockCache;
+    /** Block being replayed, if any. */
+    InstBlockCache::Block *replayBlock;
+    /** Index of the next instruction of the replayed block. */
+    size_t replayPos;
+    /** Block being built, if any. */
+    InstBlockCache::Block *buildBlock;
+    /** Virtual and physical address of the start of the built block. */
+    Addr buildVAddr;
+    Addr buildPAddr;
+    /** Should the built block end before the next instruction? */
+    bool endBlock;
+    /**
+     * Physical address of the instruction being fetched, and whether
+     * all of it was fetched from the same region.
+     */
+    Addr fetchPAddr;
+    bool fetchInOneRegion;
+
+    /** Are we in the middle of a replayed block? */
+    bool
+    inInstBlock() const
+    {
+        return replayBlock && replayPos < replayBlock->insts.size();
+    }
+
+    /**
+     * Get the next instruction of the replayed block if it was fetched
+     * with the current PC state, leaving the block otherwise.
+     */
+    const InstBlockCache::Inst *nextBlockInst(const TheISA::PCState &pc);
+
+    /**
+     * Add a freshly decoded instruction to the block being built, or
+     * start a new block with it, replaying the cached one if it
+     * matches.
+     */
+    void recordBlockInst(const TheISA::PCState &fetch_pc);
+
+    /** Stop replaying or building blocks. */
+    void leaveInstBlocks();
+
+    /** Drop the blocks a write to physical memory may have modified. */
+    void
+    invalidateInstBlocks(Addr paddr, Addr size)
+    {
+        if (instBlockCache && instBlockCache->invalidate(paddr, size))
+            leaveInstBlocks();
+    }
+
     /**
      * An AtomicCPUPort overrides the default behaviour of the
      * recvAtomicSnoop and ignores the packet instead of panicking. It
@@ -146,6 +202,10 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
         bool isSnooping() const { return true; }
 
+        // Snoops are only used to update the monitors and locked
+        // addresses, no data is held on this side.
+        bool mayCacheData() const override { return false; }
+
         Addr cacheBlockMask;
       protected:
         BaseSimpleCPU *cpu;
@@ -178,6 +238,8 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     /** Return a reference to the instruction port. */
     Port &getInstPort() override { return icachePort; }
 
+    PortProxy::SendFunctionalFunc getSendFunctional() override;
+
     /** Perform snoop for other cpu-local thread contexts. */
     void threadSnoop(PacketPtr pkt, ThreadID sender);
 
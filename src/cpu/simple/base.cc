@@ -328,19 +328,26 @@ BaseSimpleCPU::preExecute()
         //We're not in the middle of a macro instruction
         StaticInstPtr instPtr = NULL;
 
-        TheISA::Decoder *decoder = &(thread->decoder);
-
-        //Predecode, ie bundle up an ExtMachInst
-        //If more fetch data is needed, pass it in.
-        Addr fetchPC = (pcState.instAddr() & PCMask) + t_info.fetchOffset;
-        //if (decoder->needMoreBytes())
-            decoder->moreBytes(pcState, fetchPC, inst);
-        //else
-        //    decoder->process();
-
-        //Decode an instruction if one is ready. Otherwise, we'll have to
-        //fetch beyond the MachInst at the current pc.
-        instPtr = decoder->decode(pcState);
+        if (predecodedInst) {
+            instPtr = predecodedInst;
+            pcState = predecodedPC;
+            predecodedInst = NULL;
+        } else {
+            TheISA::Decoder *decoder = &(thread->decoder);
+
+            //Predecode, ie bundle up an ExtMachInst
+            //If more fetch data is needed, pass it in.
+            Addr fetchPC = (pcState.instAddr() & PCMask) +
+                t_info.fetchOffset;
+            //if (decoder->needMoreBytes())
+                decoder->moreBytes(pcState, fetchPC, inst);
+            //else
+            //    decoder->process();
+
+            //Decode an instruction if one is ready. Otherwise, we'll have
+            //to fetch beyond the MachInst at the current pc.
+            instPtr = decoder->decode(pcState);
+        }
         if (instPtr) {
             t_info.stayAtPC = false;
             thread->pcState(pcState);
@@ -103,6 +103,14 @@ class BaseSimpleCPU : public BaseCPU
     StaticInstPtr curStaticInst;
     StaticInstPtr curMacroStaticInst;
 
+    /**
+     * An instruction decoded earlier which preExecute() should use
+     * instead of decoding the fetched bytes, and the PC state it was
+     * decoded with.
+     */
+    StaticInstPtr predecodedInst;
+    TheISA::PCState predecodedPC;
+
   protected:
     enum Status {
         Idle,
@@ -54,7 +54,9 @@
 
 class BaseSimpleCPU;
 
-class SimpleExecContext : public ExecContext
+// Final, so that the simple CPUs call the methods of their contexts
+// directly.
+class SimpleExecContext final : public ExecContext
 {
   public:
     BaseSimpleCPU *cpu;
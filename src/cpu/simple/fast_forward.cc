@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/fast_forward.hh"
+
+#include <cstring>
+
+#include "cpu/simple/exec_context.hh"
+#include "sim/system.hh"
+
+FastForwardCPU::FastForwardCPU(const FastForwardCPUParams &p)
+    : NonCachingSimpleCPU(p),
+      translationThreshold(p.translation_threshold),
+      ffStats(this)
+{
+    fatal_if(!instBlockCache,
+             "The fast-forward CPU needs the instruction block cache.");
+    fatal_if(branchPred, "The fast-forward CPU can't use a branch "
+             "predictor.");
+    fatal_if(simulate_data_stalls, "The fast-forward CPU doesn't "
+             "simulate data stalls.");
+}
+
+FastForwardCPU::
+FastForwardCPUStats::FastForwardCPUStats(Stats::Group *parent)
+    : Stats::Group(parent),
+      ADD_STAT(translatedBlocks, UNIT_COUNT,
+               "Number of instruction blocks translated"),
+      ADD_STAT(untranslatableBlocks, UNIT_COUNT,
+               "Number of hot instruction blocks which couldn't be "
+               "translated"),
+      ADD_STAT(translatedInsts, UNIT_COUNT,
+               "Number of instructions run from translated blocks"),
+      ADD_STAT(backdoorAccesses, UNIT_COUNT,
+               "Number of data accesses done through a memory backdoor")
+{
+}
+
+void
+FastForwardCPU::tick()
+{
+    // The first instruction of a block has just been fetched and
+    // matched by the interpreter, the rest of it may be translated.
+    if (inInstBlock() && replayPos == 1) {
+        if (!replayBlock->translation &&
+            replayBlock->entries >= translationThreshold) {
+            translate(*replayBlock);
+        }
+
+        // Keep the translation alive, a store may drop the block.
+        std::shared_ptr<const BlockTranslation> tr =
+            replayBlock->translation;
+        if (tr && canRunTranslation(*tr)) {
+            runTranslation(*tr);
+            return;
+        }
+    }
+
+    NonCachingSimpleCPU::tick();
+}
+
+void
+FastForwardCPU::translate(InstBlockCache::Block &block)
+{
+    auto tr = std::make_shared<BlockTranslation>();
+
+    for (size_t i = 1; i < block.insts.size(); ++i) {
+        const InstBlockCache::Inst &inst = block.insts[i];
+        const StaticInstPtr &si = inst.inst;
+
+        // Microcode and instructions which have to be alone in the
+        // pipeline are left to the interpreter.
+        if (si->isMacroop() || si->isMicroop() || si->isDelayedCommit() ||
+            si->isSerializing() || si->isNonSpeculative() ||
+            si->isSquashAfter() || si->isSyscall() || si->isQuiesce()) {
+            break;
+        }
+
+        if (tr->ops.empty()) {
+            tr->entryPC = inst.fetchPC;
+            tr->firstPC = inst.fetchPC.instAddr();
+        }
+        tr->lastPC = inst.fetchPC.instAddr();
+        tr->ops.push_back({inst.decodedPC, si});
+
+        if (si->isControl())
+            break;
+    }
+
+    if (tr->ops.empty())
+        ffStats.untranslatableBlocks++;
+    else
+        ffStats.translatedBlocks++;
+
+    block.translation = tr;
+}
+
+bool
+FastForwardCPU::canRunTranslation(const BlockTranslation &tr) const
+{
+    if (tr.ops.empty())
+        return false;
+
+    const SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+
+    if (_status != BaseSimpleCPU::Running || locked || t_info.stayAtPC ||
+        curMacroStaticInst || !(thread->pcState() == tr.entryPC)) {
+        return false;
+    }
+
+    // PC and instruction count events are only checked by the
+    // interpreter.
+    if (thread->pcEventQueue.anyInRange(tr.firstPC, tr.lastPC))
+        return false;
+
+    const EventQueue &inst_events = thread->comInstEventQueue;
+    return inst_events.empty() ||
+        inst_events.nextTick() > t_info.numInst + tr.ops.size();
+}
+
+void
+FastForwardCPU::runTranslation(const BlockTranslation &tr)
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+
+    Cycles cycles(0);
+    for (const BlockTranslation::Op &op : tr.ops) {
+        ++cycles;
+        baseStats.numCycles++;
+        updateCycleCounters(BaseCPU::CPU_STATE_ON);
+
+        // This is what preExecute() does for a decoded instruction.
+        thread->setIntReg(TheISA::ZeroReg, 0);
+        t_info.setPredicate(true);
+        t_info.setMemAccPredicate(true);
+        thread->pcState(op.pc);
+        curStaticInst = op.inst;
+#if TRACING_ON
+        traceData = tracer->getInstRecord(curTick(), thread->getTC(),
+                curStaticInst, op.pc, curMacroStaticInst);
+#endif // TRACING_ON
+        ++replayPos;
+
+        Fault fault = curStaticInst->execute(&t_info, traceData);
+        if (fault == NoFault) {
+            countInst();
+            ppCommit->notify(std::make_pair(thread, curStaticInst));
+        } else if (traceData) {
+            traceFault();
+        }
+        postExecute();
+
+        instCnt++;
+        ffStats.translatedInsts++;
+
+        advancePC(fault);
+
+        // Leave the block on a fault, or if a store dropped it.
+        if (fault != NoFault) {
+            leaveInstBlocks();
+            break;
+        }
+        if (!replayBlock)
+            break;
+    }
+
+    if (tryCompleteDrain())
+        return;
+
+    if (_status != Idle)
+        reschedule(tickEvent, curTick() + cyclesToTicks(cycles), true);
+}
+
+Tick
+FastForwardCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
+{
+    if (&port == &dcachePort && accessBackdoor(pkt))
+        return 0;
+
+    return NonCachingSimpleCPU::sendPacket(port, pkt);
+}
+
+bool
+FastForwardCPU::accessBackdoor(const PacketPtr &pkt)
+{
+    const bool is_write = pkt->cmd == MemCmd::WriteReq;
+    if (!is_write && pkt->cmd != MemCmd::ReadReq)
+        return false;
+
+    if (pkt->req->isUncacheable() || pkt->req->isMasked())
+        return false;
+
+    // Writes through a backdoor aren't snooped, so the other CPUs
+    // wouldn't see them clear their exclusive monitors.
+    if (is_write && system->threads.size() > 1)
+        return false;
+
+    auto bd_it = memBackdoors.contains(pkt->getAddrRange());
+    if (bd_it == memBackdoors.end())
+        return false;
+
+    MemBackdoorPtr bd = bd_it->second;
+    if (is_write ? !bd->writeable() : !bd->readable())
+        return false;
+
+    uint8_t *host_addr = bd->ptr() + (pkt->getAddr() - bd->range().start());
+    if (is_write)
+        std::memcpy(host_addr, pkt->getConstPtr<uint8_t>(), pkt->getSize());
+    else
+        std::memcpy(pkt->getPtr<uint8_t>(), host_addr, pkt->getSize());
+
+    pkt->makeResponse();
+    ffStats.backdoorAccesses++;
+    return true;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_FAST_FORWARD_HH__
+#define __CPU_SIMPLE_FAST_FORWARD_HH__
+
+#include <vector>
+
+#include "arch/types.hh"
+#include "base/statistics.hh"
+#include "cpu/simple/noncaching.hh"
+#include "cpu/static_inst.hh"
+#include "params/FastForwardCPU.hh"
+
+/**
+ * A hot block of the instruction block cache, translated for the
+ * FastForwardCPU. It holds the instructions after the first one of the
+ * block, which is always fetched and decoded to check that the block
+ * still applies.
+ */
+struct BlockTranslation
+{
+    struct Op
+    {
+        /** PC state to execute the instruction with. */
+        TheISA::PCState pc;
+        StaticInstPtr inst;
+    };
+
+    /** PC state the block must be at to run the translation. */
+    TheISA::PCState entryPC;
+    /**
+     * Instructions to run, empty if the block couldn't be translated.
+     * Only the last one may change the control flow.
+     */
+    std::vector<Op> ops;
+    /** Addresses of the first and last instructions, for PC events. */
+    Addr firstPC = 0;
+    Addr lastPC = 0;
+};
+
+/**
+ * The FastForwardCPU is a NonCachingSimpleCPU which translates the
+ * blocks of its instruction block cache once they have been entered
+ * often enough. A translated block runs in a single event, without
+ * fetching, decoding, or checking for interrupts and PC events between
+ * its instructions. Blocks that can't be translated, or that would
+ * hit a PC or instruction count event, run on the interpreter.
+ *
+ * Data accesses to memory that hands out a backdoor are done directly
+ * on the host copy of the memory.
+ */
+class FastForwardCPU : public NonCachingSimpleCPU
+{
+  public:
+    FastForwardCPU(const FastForwardCPUParams &p);
+
+  protected:
+    void tick() override;
+    Tick sendPacket(RequestPort &port, const PacketPtr &pkt) override;
+
+    /** Translate a block, or record that it can't be translated. */
+    void translate(InstBlockCache::Block &block);
+
+    /** Can a translation run from the current state? */
+    bool canRunTranslation(const BlockTranslation &tr) const;
+
+    /** Run a translation of the replayed block. */
+    void runTranslation(const BlockTranslation &tr);
+
+    /**
+     * Do a plain read or write through a memory backdoor.
+     *
+     * @return True if the packet was handled.
+     */
+    bool accessBackdoor(const PacketPtr &pkt);
+
+    /** Number of entries after which a block is translated. */
+    const unsigned translationThreshold;
+
+    struct FastForwardCPUStats : public Stats::Group
+    {
+        FastForwardCPUStats(Stats::Group *parent);
+
+        /** Number of blocks translated. */
+        Stats::Scalar translatedBlocks;
+        /** Number of blocks which couldn't be translated. */
+        Stats::Scalar untranslatableBlocks;
+        /** Number of instructions run from translations. */
+        Stats::Scalar translatedInsts;
+        /** Number of data accesses done through a backdoor. */
+        Stats::Scalar backdoorAccesses;
+    } ffStats;
+};
+
+#endif // __CPU_SIMPLE_FAST_FORWARD_HH__
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/inst_block_cache.hh"
+
+InstBlockCache::Block *
+InstBlockCache::lookup(Addr paddr, const TheISA::PCState &fetch_pc,
+                       const StaticInstPtr &inst)
+{
+    auto it = blocks.find(paddr);
+    if (it == blocks.end() || it->second.insts.empty())
+        return nullptr;
+
+    const Inst &first = it->second.insts.front();
+    if (first.inst != inst || !(first.fetchPC == fetch_pc))
+        return nullptr;
+
+    return &it->second;
+}
+
+InstBlockCache::Block &
+InstBlockCache::insert(Addr paddr)
+{
+    auto it = blocks.find(paddr);
+    if (it != blocks.end()) {
+        it->second = Block();
+        return it->second;
+    }
+
+    if (blocks.size() >= maxBlocks)
+        clear();
+
+    regions[paddr >> RegionShift].push_back(paddr);
+    return blocks[paddr];
+}
+
+bool
+InstBlockCache::invalidateRegions(Addr first, Addr last)
+{
+    bool dropped = false;
+    auto drop = [this, &dropped](std::unordered_map<Addr,
+            std::vector<Addr>>::iterator it) {
+        for (Addr paddr : it->second)
+            blocks.erase(paddr);
+        dropped = true;
+        return regions.erase(it);
+    };
+
+    if (last - first >= regions.size()) {
+        // Large writes, e.g. loading an image, are cheaper to check
+        // against the regions holding blocks than the other way round.
+        for (auto it = regions.begin(); it != regions.end(); ) {
+            if (it->first >= first && it->first <= last)
+                it = drop(it);
+            else
+                ++it;
+        }
+    } else {
+        for (Addr region = first; region <= last; ++region) {
+            auto it = regions.find(region);
+            if (it != regions.end())
+                drop(it);
+        }
+    }
+    return dropped;
+}
+
+void
+InstBlockCache::clear()
+{
+    blocks.clear();
+    regions.clear();
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_INST_BLOCK_CACHE_HH__
+#define __CPU_SIMPLE_INST_BLOCK_CACHE_HH__
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/types.hh"
+#include "base/types.hh"
+#include "cpu/static_inst.hh"
+
+/**
+ * A cache of decoded instruction sequences, which lets the atomic CPU
+ * skip fetching and decoding instructions it has recently executed.
+ *
+ * A block is a run of sequential instructions which starts with the
+ * instruction fetched from a physical address and ends at the first
+ * instruction that may redirect control flow or change how later
+ * instructions are decoded. The first instruction of a block is always
+ * fetched and decoded as usual, which checks that the translation and
+ * the decoder state still match the ones the block was built with.
+ *
+ * All the instructions of a block are in the same 4 KiB region, both
+ * virtually and physically, so that the translation of the first one
+ * holds for all of them. Blocks in a region are dropped when it is
+ * written to.
+ */
+struct BlockTranslation;
+
+class InstBlockCache
+{
+  public:
+    struct Inst
+    {
+        /** PC state the instruction was fetched with. */
+        TheISA::PCState fetchPC;
+        /** PC state after the instruction has been decoded. */
+        TheISA::PCState decodedPC;
+        StaticInstPtr inst;
+    };
+
+    struct Block
+    {
+        std::vector<Inst> insts;
+        /** Number of times the block was entered from its start. */
+        unsigned entries = 0;
+        /**
+         * The block translated by the FastForwardCPU once it is hot,
+         * which goes away with the block.
+         */
+        std::shared_ptr<const BlockTranslation> translation;
+    };
+
+    /** Instructions of a block share an aligned region of this size. */
+    static const unsigned RegionShift = 12;
+
+    /** Maximum number of instructions in a block. */
+    static const size_t MaxBlockInsts = 64;
+
+    /**
+     * @param max_blocks Number of blocks kept before the cache is
+     *        flushed to make space for new ones.
+     */
+    InstBlockCache(size_t max_blocks) : maxBlocks(max_blocks) {}
+
+    /**
+     * Find the block starting with an instruction.
+     *
+     * @param paddr Physical address the instruction was fetched from.
+     * @param fetch_pc PC state it was fetched with.
+     * @param inst The decoded instruction.
+     * @return The block, or nullptr if there is no matching block.
+     */
+    Block *lookup(Addr paddr, const TheISA::PCState &fetch_pc,
+                  const StaticInstPtr &inst);
+
+    /**
+     * Start a new, empty block for the instruction fetched from a
+     * physical address, replacing any block already there. This may
+     * flush the cache and invalidates all the blocks returned earlier.
+     */
+    Block &insert(Addr paddr);
+
+    /**
+     * Drop the blocks in the regions a write touches.
+     *
+     * @return True if any block was dropped.
+     */
+    bool
+    invalidate(Addr paddr, Addr size)
+    {
+        if (regions.empty() || !size)
+            return false;
+        return invalidateRegions(paddr >> RegionShift,
+                                 (paddr + size - 1) >> RegionShift);
+    }
+
+    /** Drop all the blocks. */
+    void clear();
+
+    /** Can an instruction at a virtual address join a block? */
+    static bool
+    sameRegion(Addr a, Addr b)
+    {
+        return (a >> RegionShift) == (b >> RegionShift);
+    }
+
+  private:
+    bool invalidateRegions(Addr first, Addr last);
+
+    const size_t maxBlocks;
+
+    /** Blocks, indexed by the physical address of their start. */
+    std::unordered_map<Addr, Block> blocks;
+    /** Start addresses of the blocks, indexed by physical region. */
+    std::unordered_map<Addr, std::vector<Addr>> regions;
+};
+
+#endif // __CPU_SIMPLE_INST_BLOCK_CACHE_HH__
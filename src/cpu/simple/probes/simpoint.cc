@@ -46,7 +46,8 @@ SimPoint::SimPoint(const SimPointParams &p)
       intervalDrift(0),
       simpointStream(NULL),
       currentBBV(0, 0),
-      currentBBVInstCount(0)
+      currentBBVInstCount(0),
+      lastPC(0)
 {
     simpointStream = simout.create(p.profile_file, false);
     if (!simpointStream)
@@ -65,76 +66,131 @@ SimPoint::init()
 void
 SimPoint::regProbeListeners()
 {
-    typedef ProbeListenerArg<SimPoint, std::pair<SimpleThread*,StaticInstPtr>>
-        SimPointListener;
-    listeners.push_back(new SimPointListener(this, "Commit",
-                                             &SimPoint::profile));
+    typedef ProbeListenerArg<SimPoint, uint64_t> PMUListener;
+    listeners.push_back(new PMUListener(this, "RetiredInstsPC",
+                                        &SimPoint::retiredInst));
+    listeners.push_back(new PMUListener(this, "RetiredBranches",
+                                        &SimPoint::retiredBranch));
+
+    typedef ProbeListenerArg<SimPoint, ProbePoints::BranchStacks>
+        BranchStacksListener;
+    listeners.push_back(new BranchStacksListener(this, "BranchStacks",
+                                                 &SimPoint::sampledBranches));
 }
 
 void
-SimPoint::profile(const std::pair<SimpleThread*, StaticInstPtr>& p)
+SimPoint::retiredInst(const uint64_t &pc)
 {
-    SimpleThread* thread = p.first;
-    const StaticInstPtr &inst = p.second;
-
-    if (inst->isMicroop() && !inst->isLastMicroop())
-        return;
-
     if (!currentBBVInstCount)
-        currentBBV.first = thread->pcState().instAddr();
+        currentBBV.first = pc;
 
     ++intervalCount;
     ++currentBBVInstCount;
+    lastPC = pc;
+}
 
-    // If inst is control inst, assume end of basic block.
-    if (inst->isControl()) {
-        currentBBV.second = thread->pcState().instAddr();
-
-        auto map_itr = bbMap.find(currentBBV);
-        if (map_itr == bbMap.end()){
-            // If a new (previously unseen) basic block is found,
-            // add a new unique id, record num of insts and insert
-            // into bbMap.
-            BBInfo info;
-            info.id = bbMap.size() + 1;
-            info.insts = currentBBVInstCount;
-            info.count = currentBBVInstCount;
-            bbMap.insert(std::make_pair(currentBBV, info));
-        } else {
-            // If basic block is seen before, just increment the count by the
-            // number of insts in basic block.
-            BBInfo& info = map_itr->second;
-            info.count += currentBBVInstCount;
-        }
-        currentBBVInstCount = 0;
-
-        // Reached end of interval if the sum of the current inst count
-        // (intervalCount) and the excessive inst count from the previous
-        // interval (intervalDrift) is greater than/equal to the interval size.
-        if (intervalCount + intervalDrift >= intervalSize) {
-            // summarize interval and display BBV info
-            std::vector<std::pair<uint64_t, uint64_t> > counts;
-            for (auto map_itr = bbMap.begin(); map_itr != bbMap.end();
-                    ++map_itr) {
-                BBInfo& info = map_itr->second;
-                if (info.count != 0) {
-                    counts.push_back(std::make_pair(info.id, info.count));
-                    info.count = 0;
-                }
-            }
-            std::sort(counts.begin(), counts.end());
-
-            // Print output BBV info
-            *simpointStream->stream() << "T";
-            for (auto cnt_itr = counts.begin(); cnt_itr != counts.end();
-                    ++cnt_itr) {
-                *simpointStream->stream() << ":" << cnt_itr->first
-                                << ":" << cnt_itr->second << " ";
+void
+SimPoint::retiredBranch(const uint64_t &count)
+{
+    // The CPUs report a control inst after the inst itself, so it is
+    // the last one of the current basic block.
+    if (!currentBBVInstCount)
+        return;
+
+    currentBBV.second = lastPC;
+    countBlock(currentBBV, currentBBVInstCount);
+    currentBBVInstCount = 0;
+
+    checkInterval();
+}
+
+void
+SimPoint::sampledBranches(const ProbePoints::BranchStacks &samples)
+{
+    std::vector<std::pair<BasicBlockRange, Addr>> blocks;
+    Addr total_size = 0;
+    for (const auto &stack : samples.stacks) {
+        for (size_t i = 1; i < stack.size(); ++i) {
+            // The block runs from the target of one branch to the
+            // branch of the next. Anything else, e.g., if there was an
+            // interrupt in between, is not a block.
+            BasicBlockRange bb(stack[i - 1].second, stack[i].first);
+            if (bb.second < bb.first ||
+                bb.second - bb.first >= MaxSampledBlockSize) {
+                continue;
             }
-            *simpointStream->stream() << "\n";
+            Addr size = bb.second - bb.first + 1;
+            blocks.emplace_back(bb, size);
+            total_size += size;
+        }
+    }
+
+    if (total_size) {
+        for (const auto &block : blocks) {
+            uint64_t insts = (double)samples.insts * block.second /
+                total_size + 0.5;
+            if (insts)
+                countBlock(block.first, insts);
+        }
+    }
+
+    intervalCount += samples.insts;
+    checkInterval();
+}
+
+void
+SimPoint::countBlock(const BasicBlockRange &bb, uint64_t insts)
+{
+    auto map_itr = bbMap.find(bb);
+    if (map_itr == bbMap.end()){
+        // If a new (previously unseen) basic block is found,
+        // add a new unique id, record num of insts and insert
+        // into bbMap.
+        BBInfo info;
+        info.id = bbMap.size() + 1;
+        info.insts = insts;
+        info.count = insts;
+        bbMap.insert(std::make_pair(bb, info));
+    } else {
+        // If basic block is seen before, just increment the count by the
+        // number of insts in basic block.
+        BBInfo& info = map_itr->second;
+        info.count += insts;
+    }
+}
 
-            intervalDrift = (intervalCount + intervalDrift) - intervalSize;
-            intervalCount = 0;
+void
+SimPoint::checkInterval()
+{
+    // Reached end of interval if the sum of the current inst count
+    // (intervalCount) and the excessive inst count from the previous
+    // interval (intervalDrift) is greater than/equal to the interval size.
+    if (intervalCount + intervalDrift < intervalSize)
+        return;
+
+    // summarize interval and display BBV info
+    std::vector<std::pair<uint64_t, uint64_t> > counts;
+    for (auto map_itr = bbMap.begin(); map_itr != bbMap.end();
+            ++map_itr) {
+        BBInfo& info = map_itr->second;
+        if (info.count != 0) {
+            counts.push_back(std::make_pair(info.id, info.count));
+            info.count = 0;
         }
     }
+    std::sort(counts.begin(), counts.end());
+
+    // Print output BBV info
+    *simpointStream->stream() << "T";
+    for (auto cnt_itr = counts.begin(); cnt_itr != counts.end();
+            ++cnt_itr) {
+        *simpointStream->stream() << ":" << cnt_itr->first
+                        << ":" << cnt_itr->second << " ";
+    }
+    *simpointStream->stream() << "\n";
+
+    // A sampled batch may span several intervals, they are reported
+    // as one.
+    intervalDrift = (intervalCount + intervalDrift) % intervalSize;
+    intervalCount = 0;
 }
@@ -41,8 +41,8 @@
 #include <unordered_map>
 
 #include "base/output.hh"
-#include "cpu/simple_thread.hh"
 #include "params/SimPoint.hh"
+#include "sim/probe/pmu.hh"
 #include "sim/probe/probe.hh"
 
 /**
@@ -81,12 +81,34 @@ class SimPoint : public ProbeListenerObject
 
     /**
      * Profile basic blocks for SimPoints.
-     * Called at every macro inst to increment basic block inst counts and
-     * to profile block if end of block.
+     * Called at every retired macro inst to increment the current
+     * basic block's inst count.
      */
-    void profile(const std::pair<SimpleThread*, StaticInstPtr>&);
+    void retiredInst(const uint64_t &pc);
+
+    /**
+     * Called at every retired control inst, which ends the current
+     * basic block.
+     */
+    void retiredBranch(const uint64_t &count);
+
+    /**
+     * Profile the basic blocks between sampled branches. The blocks
+     * are weighted by their size, scaled to the number of instructions
+     * executed while the samples were taken.
+     */
+    void sampledBranches(const ProbePoints::BranchStacks &samples);
 
   private:
+    /** Add dynamic insts to a basic block's count. */
+    void countBlock(const BasicBlockRange &bb, uint64_t insts);
+
+    /** Write out the BBV if the end of the interval has been reached. */
+    void checkInterval();
+
+    /** Blocks between sampled branches larger than this are ignored */
+    static const Addr MaxSampledBlockSize = 4096;
+
     /** SimPoint profiling interval size in instructions */
     const uint64_t intervalSize;
 
@@ -113,6 +135,8 @@ class SimPoint : public ProbeListenerObject
     BasicBlockRange currentBBV;
     /** inst count in current basic block */
     uint64_t currentBBVInstCount;
+    /** PC of the last inst retired */
+    Addr lastPC;
 };
 
 #endif // __CPU_SIMPLE_PROBES_SIMPOINT_HH__
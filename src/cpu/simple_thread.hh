@@ -85,9 +85,13 @@ class CheckerCPU;
  * all the necessary state for full architecture-level functional
  * simulation.  See the AtomicSimpleCPU or TimingSimpleCPU for
  * examples.
+ *
+ * The class is final so that the register accessors, which the simple
+ * CPUs call for every operand, are bound statically when called
+ * through a SimpleThread pointer.
  */
 
-class SimpleThread : public ThreadState, public ThreadContext
+class SimpleThread final : public ThreadState, public ThreadContext
 {
   public:
     typedef ThreadContext::Status Status;
@@ -92,6 +92,23 @@ StaticInst::hasBranchTarget(const TheISA::PCState &pc, ThreadContext *tc,
     return false;
 }
 
+void
+StaticInst::markShared()
+{
+    if (shared)
+        return;
+    shared = true;
+
+    if (!isMacroop())
+        return;
+    for (MicroPC upc = 0; ; upc++) {
+        StaticInstPtr microop = fetchMicroop(upc);
+        microop->markShared();
+        if (microop->isLastMicroop())
+            break;
+    }
+}
+
 StaticInstPtr
 StaticInst::fetchMicroop(MicroPC upc) const
 {
@@ -289,6 +289,12 @@ class StaticInst : public RefCounted, public StaticInstFlags
      */
     mutable std::string *cachedDisassembly;
 
+  private:
+    /// Is the instruction in a decode cache shared by all the CPUs?
+    bool shared;
+
+  protected:
+
     /**
      * Internal function to generate disassembly string.
      */
@@ -306,12 +312,27 @@ class StaticInst : public RefCounted, public StaticInstFlags
           _numSrcRegs(0), _numDestRegs(0), _numFPDestRegs(0),
           _numIntDestRegs(0), _numCCDestRegs(0), _numVecDestRegs(0),
           _numVecElemDestRegs(0), _numVecPredDestRegs(0), machInst(_machInst),
-          mnemonic(_mnemonic), cachedDisassembly(0)
+          mnemonic(_mnemonic), cachedDisassembly(0), shared(false)
     { }
 
   public:
     virtual ~StaticInst();
 
+    /**
+     * Instructions in a shared decode cache are never freed and may be
+     * used from several event queue threads at once. Their reference
+     * count is left alone, so copying pointers to them neither races
+     * nor bounces cache lines between threads.
+     */
+    void incref() const { if (!shared) RefCounted::incref(); }
+    void decref() const { if (!shared) RefCounted::decref(); }
+
+    /**
+     * Make this instruction, and its microops if it is a macroop,
+     * shared. This must be done before other threads can see it.
+     */
+    void markShared();
+
     virtual Fault execute(ExecContext *xc,
                           Trace::InstRecord *traceData) const = 0;
 
@@ -0,0 +1,51 @@
+# Copyright (c) 2021 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+
+from m5.params import *
+from m5.SimObject import SimObject
+
+# Replay a trace recorded by BranchTrace against branch predictors,
+# without a CPU, and report their mispredictions per thousand
+# instructions. The simulation exits once all the predictors are done.
+class BranchTraceReplay(SimObject):
+    type = 'BranchTraceReplay'
+    cxx_header = 'cpu/testers/bpred_replay/branch_trace_replay.hh'
+
+    trace_file = Param.String("Branch trace to replay")
+    predictors = VectorParam.BranchPredictor("Branch predictors to replay "
+                                             "the trace against")
+    numThreads = Param.Unsigned(1, "Number of hardware threads in the trace")
+    host_threads = Param.Unsigned(0, "Number of host threads replaying "
+                                  "predictors in parallel, 0 for one per "
+                                  "predictor")
+    max_branches = Param.Counter(0, "Number of branches to replay, 0 for "
+                                 "the whole trace")
+    batch_size = Param.Unsigned(4096, "Number of branches read in one go")
+    read_depth = Param.Unsigned(4, "Number of batches decompressed ahead "
+                                "of each predictor, 0 reads them on the "
+                                "replay thread")
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/testers/bpred_replay/branch_trace_replay.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "base/batched_reader.hh"
+#include "base/logging.hh"
+#include "base/random.hh"
+#include "params/BranchTraceReplay.hh"
+#include "sim/byteswap.hh"
+#include "sim/sim_exit.hh"
+
+namespace
+{
+
+const uint8_t TypeMask = BranchTrace::Record::Conditional |
+    BranchTrace::Record::Indirect | BranchTrace::Record::Call |
+    BranchTrace::Record::Return;
+
+/** The parts of a branch instruction the predictors look at */
+class ReplayBranchInst : public StaticInst
+{
+  public:
+    ReplayBranchInst(uint8_t type)
+        : StaticInst("replayed branch", TheISA::ExtMachInst(), No_OpClass)
+    {
+        const bool cond = type & BranchTrace::Record::Conditional;
+        const bool indirect = type & BranchTrace::Record::Indirect;
+        flags[IsControl] = true;
+        flags[IsCondControl] = cond;
+        flags[IsUncondControl] = !cond;
+        flags[IsDirectControl] = !indirect;
+        flags[IsIndirectControl] = indirect;
+        flags[IsCall] = type & BranchTrace::Record::Call;
+        flags[IsReturn] = type & BranchTrace::Record::Return;
+    }
+
+    Fault
+    execute(ExecContext *xc, Trace::InstRecord *traceData) const override
+    {
+        panic("Replayed branches can't be executed.\n");
+    }
+
+    void
+    advancePC(TheISA::PCState &pcState) const override
+    {
+        pcState.advance();
+    }
+
+    std::string
+    generateDisassembly(Addr pc,
+            const Loader::SymbolTable *symtab) const override
+    {
+        return mnemonic;
+    }
+};
+
+template <class T>
+bool
+readInt(gzFile stream, T &val)
+{
+    if (gzread(stream, &val, sizeof(val)) != sizeof(val))
+        return false;
+    val = letoh(val);
+    return true;
+}
+
+bool
+readRecord(gzFile stream, BranchTrace::Record &record)
+{
+    if (gzread(stream, &record, sizeof(record)) != sizeof(record))
+        return false;
+    record.pc = letoh(record.pc);
+    record.target = letoh(record.target);
+    record.insts = letoh(record.insts);
+    record.tid = letoh(record.tid);
+    return true;
+}
+
+} // anonymous namespace
+
+BranchTraceReplay::BranchTraceReplay(const BranchTraceReplayParams &p)
+    : SimObject(p), traceFile(p.trace_file), predictors(p.predictors),
+      numThreads(p.numThreads),
+      hostThreads(p.host_threads ? p.host_threads : p.predictors.size()),
+      maxBranches(p.max_branches), batchSize(p.batch_size),
+      readDepth(p.read_depth),
+      replayEvent([this]{ replayAll(); }, name()),
+      stats(*this)
+{
+    fatal_if(predictors.empty(), "%s: No predictors to replay.\n", name());
+
+    gzFile stream = openTrace();
+    fatal_if(!stream, "%s: %s is not a readable branch trace.\n", name(),
+             traceFile);
+    gzclose(stream);
+
+    for (uint8_t type = 0; type <= TypeMask; ++type) {
+        StaticInstPtr inst = new ReplayBranchInst(type);
+        // The instructions are used by all the replay threads.
+        inst->markShared();
+        branchInsts.push_back(inst);
+    }
+}
+
+void
+BranchTraceReplay::startup()
+{
+    schedule(replayEvent, curTick());
+}
+
+gzFile
+BranchTraceReplay::openTrace() const
+{
+    gzFile stream = gzopen(traceFile.c_str(), "rb");
+    if (!stream)
+        return nullptr;
+
+    char magic[sizeof(BranchTrace::fileMagic)];
+    uint32_t version, record_size;
+    if (gzread(stream, magic, sizeof(magic)) != sizeof(magic) ||
+        memcmp(magic, BranchTrace::fileMagic, sizeof(magic)) != 0 ||
+        !readInt(stream, version) || version != BranchTrace::version ||
+        !readInt(stream, record_size) || record_size != sizeof(Record)) {
+        gzclose(stream);
+        return nullptr;
+    }
+
+    gzbuffer(stream, 1 << 20);
+    return stream;
+}
+
+void
+BranchTraceReplay::replay(BPredUnit &bpred, Result &result) const
+{
+    // Give every predictor the same random draws, whichever thread
+    // replays it.
+    random_mt.init(Random::threadSeed());
+
+    gzFile stream = openTrace();
+    panic_if(!stream, "%s: Can't reopen %s.\n", name(), traceFile);
+
+    BatchedReader<Record> reader(
+        [stream](Record &record) { return readRecord(stream, record); },
+        batchSize, readDepth);
+    reader.start();
+
+    Record record;
+    while ((!maxBranches || result.branches < maxBranches) &&
+           reader.read(record)) {
+        panic_if(record.tid >= numThreads,
+                 "%s: Branch of thread %d in a trace of %d threads.\n",
+                 name(), record.tid, numThreads);
+
+        const StaticInstPtr &inst = branchInsts[record.type & TypeMask];
+        const ThreadID tid = record.tid;
+        const bool taken = record.taken;
+        void *bp_history = nullptr;
+
+        ++result.branches;
+        result.insts += record.insts;
+        if (inst->isCondCtrl()) {
+            ++result.condBranches;
+            if (bpred.lookup(tid, record.pc, bp_history) != taken) {
+                ++result.mispredicts;
+                // Restore the speculative state, as a squash would.
+                bpred.update(tid, record.pc, taken, bp_history, true,
+                             inst, record.target);
+            }
+        } else {
+            bpred.uncondBranch(tid, record.pc, bp_history);
+        }
+        bpred.update(tid, record.pc, taken, bp_history, false, inst,
+                     record.target);
+    }
+
+    reader.stop();
+    gzclose(stream);
+}
+
+void
+BranchTraceReplay::replayAll()
+{
+    std::vector<Result> results(predictors.size());
+    std::atomic<size_t> next_predictor(0);
+    auto worker = [&]() {
+        for (size_t i = next_predictor++; i < predictors.size();
+             i = next_predictor++) {
+            replay(*predictors[i], results[i]);
+        }
+    };
+
+    const unsigned num_workers =
+        std::min<size_t>(hostThreads, predictors.size());
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < num_workers; ++i)
+        workers.emplace_back(worker);
+    worker();
+    for (auto &thread : workers)
+        thread.join();
+
+    for (size_t i = 0; i < predictors.size(); ++i) {
+        const Result &result = results[i];
+        stats.insts[i] = result.insts;
+        stats.branches[i] = result.branches;
+        stats.condBranches[i] = result.condBranches;
+        stats.mispredicts[i] = result.mispredicts;
+
+        inform("%s: %d branches, %d conditional, %d mispredicted, "
+               "%.3f MPKI\n", predictors[i]->name(), result.branches,
+               result.condBranches, result.mispredicts,
+               result.insts ? 1000.0 * result.mispredicts / result.insts :
+               0.0);
+    }
+
+    exitSimLoop("branch trace replayed");
+}
+
+BranchTraceReplay::ReplayStats::ReplayStats(BranchTraceReplay &replay)
+    : Stats::Group(&replay),
+      ADD_STAT(insts, UNIT_COUNT, "Instructions covered by the trace"),
+      ADD_STAT(branches, UNIT_COUNT, "Branches replayed"),
+      ADD_STAT(condBranches, UNIT_COUNT, "Conditional branches replayed"),
+      ADD_STAT(mispredicts, UNIT_COUNT,
+               "Conditional branches mispredicted"),
+      ADD_STAT(mpki, UNIT_RATIO,
+               "Mispredictions per thousand instructions")
+{
+    const size_t num_predictors = replay.predictors.size();
+    insts.init(num_predictors);
+    branches.init(num_predictors);
+    condBranches.init(num_predictors);
+    mispredicts.init(num_predictors);
+    for (size_t i = 0; i < num_predictors; ++i) {
+        // Statistic names can't have dots in them.
+        const std::string &path = replay.predictors[i]->name();
+        const std::string name = path.substr(path.rfind('.') + 1);
+        insts.subname(i, name);
+        branches.subname(i, name);
+        condBranches.subname(i, name);
+        mispredicts.subname(i, name);
+    }
+
+    mpki.precision(3);
+    mpki = 1000 * mispredicts / insts;
+}
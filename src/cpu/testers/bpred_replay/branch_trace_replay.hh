@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * @file
+ * Replay a branch trace recorded by BranchTrace against a set of branch
+ * predictors, without a CPU model, to compare predictor designs.
+ */
+
+#ifndef __CPU_TESTERS_BPRED_REPLAY_BRANCH_TRACE_REPLAY_HH__
+#define __CPU_TESTERS_BPRED_REPLAY_BRANCH_TRACE_REPLAY_HH__
+
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "cpu/probes/branch_trace.hh"
+#include "cpu/static_inst.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+struct BranchTraceReplayParams;
+
+/**
+ * Each predictor sees the branches of the trace in commit order, and
+ * is updated with the outcome of a branch before the next one is
+ * predicted, as in the championship branch prediction frameworks. A
+ * misprediction first corrects the speculative state of the predictor,
+ * as a squash in the CPU would, and then updates it. There is no wrong
+ * path, and the BTB, RAS and indirect predictor are not exercised.
+ *
+ * The predictors are independent, so they are replayed in parallel on
+ * host threads, each of which decompresses the trace on its own. The
+ * results are reported through the statistics and a summary printed
+ * once all the predictors are done, after which the simulation exits.
+ */
+class BranchTraceReplay : public SimObject
+{
+  public:
+    typedef BranchTrace::Record Record;
+
+    BranchTraceReplay(const BranchTraceReplayParams &params);
+
+    void startup() override;
+
+  private:
+    /** What replaying the trace against a predictor resulted in */
+    struct Result
+    {
+        Counter insts = 0;
+        Counter branches = 0;
+        Counter condBranches = 0;
+        Counter mispredicts = 0;
+    };
+
+    /** Replay all the predictors and exit the simulation */
+    void replayAll();
+
+    /** Replay the trace against one predictor, on the calling thread */
+    void replay(BPredUnit &bpred, Result &result) const;
+
+    /**
+     * Open the trace and read its header.
+     *
+     * @return The stream positioned at the first record, or nullptr if
+     *         the trace can't be opened or has an unexpected header.
+     */
+    gzFile openTrace() const;
+
+    const std::string traceFile;
+    const std::vector<BPredUnit *> predictors;
+    const unsigned numThreads;
+    const unsigned hostThreads;
+    const Counter maxBranches;
+    const size_t batchSize;
+    const size_t readDepth;
+
+    /** Instruction standing for each type of branch in the trace */
+    std::vector<StaticInstPtr> branchInsts;
+
+    EventFunctionWrapper replayEvent;
+
+    struct ReplayStats : public Stats::Group
+    {
+        ReplayStats(BranchTraceReplay &replay);
+
+        Stats::Vector insts;
+        Stats::Vector branches;
+        Stats::Vector condBranches;
+        Stats::Vector mispredicts;
+        Stats::Formula mpki;
+    } stats;
+};
+
+#endif // __CPU_TESTERS_BPRED_REPLAY_BRANCH_TRACE_REPLAY_HH__
@@ -28,6 +28,7 @@
 
 #include "cpu/testers/garnet_synthetic_traffic/GarnetSyntheticTraffic.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <set>
@@ -87,6 +88,8 @@ GarnetSyntheticTraffic::GarnetSyntheticTraffic(const Params &p)
       injRate(p.inj_rate),
       injVnet(p.inj_vnet),
       precision(p.precision),
+      geometricInjection(p.geometric_injection),
+      injProb(0), nextInjectCycle(0), lastCountedCycle(0),
       responseLimit(p.response_limit),
       requestorId(p.system->getRequestorId(this))
 {
@@ -100,6 +103,17 @@ GarnetSyntheticTraffic::GarnetSyntheticTraffic(const Params &p)
     }
     traffic = trafficStringToEnum[trafficType];
 
+    // tick() injects if a number drawn uniformly from [0, 10^precision]
+    // is below injRate * 10^precision, which is the probability used
+    // here for every cycle
+    double injRange = pow((double) 10, (double) precision);
+    double injCount = std::max(ceil(injRate * injRange), 0.0);
+    injProb = std::min(injCount, injRange + 1) / (injRange + 1);
+
+    // the first cycle (0) counts as one of the trials
+    if (geometricInjection)
+        nextInjectCycle = injectionGap() - Cycles(1);
+
     id = TESTER_NETWORK++;
     DPRINTF(GarnetSyntheticTraffic,"Config Created: Name = %s , and id = %d\n",
             name(), id);
@@ -131,6 +145,7 @@ GarnetSyntheticTraffic::completeRequest(PacketPtr pkt)
 
     assert(pkt->isResponse());
     noResponseCycles = 0;
+    lastCountedCycle = curCycle();
     delete pkt;
 }
 
@@ -138,6 +153,11 @@ GarnetSyntheticTraffic::completeRequest(PacketPtr pkt)
 void
 GarnetSyntheticTraffic::tick()
 {
+    if (geometricInjection) {
+        geometricTick();
+        return;
+    }
+
     if (++noResponseCycles >= responseLimit) {
         fatal("%s deadlocked at cycle %d\n", name(), curTick());
     }
@@ -177,6 +197,69 @@ GarnetSyntheticTraffic::tick()
     }
 }
 
+Cycles
+GarnetSyntheticTraffic::injectionGap()
+{
+    // effectively never inject, without overflowing the cycle count
+    const double max_gap = 1e15;
+
+    if (injProb >= 1.0)
+        return Cycles(1);
+    if (injProb <= 0.0)
+        return Cycles(max_gap);
+
+    // inverse transform of a uniform number in (0, 1]
+    double u = 1.0 - random_mt.random<double>();
+    double gap = 1.0 + floor(log(u) / log1p(-injProb));
+    return Cycles(std::min(gap, max_gap));
+}
+
+void
+GarnetSyntheticTraffic::geometricTick()
+{
+    // the skipped cycles count towards the deadlock limit, as if the
+    // tester had ticked through them
+    noResponseCycles += curCycle() - lastCountedCycle;
+    lastCountedCycle = curCycle();
+    if (noResponseCycles >= responseLimit) {
+        fatal("%s deadlocked at cycle %d\n", name(), curTick());
+    }
+
+    // this wake-up may only be for the end of the simulation or the
+    // deadlock check
+    if (curCycle() >= nextInjectCycle) {
+        bool senderEnable = true;
+
+        if (numPacketsMax >= 0 && numPacketsSent >= numPacketsMax)
+            senderEnable = false;
+
+        if (singleSender >= 0 && id != singleSender)
+            senderEnable = false;
+
+        if (senderEnable)
+            generatePkt();
+
+        nextInjectCycle = curCycle() + injectionGap();
+    }
+
+    if (curTick() >= simCycles) {
+        exitSimLoop("Network Tester completed simCycles");
+        return;
+    }
+
+    // wake up for the next injection, the end of the simulation or
+    // the deadlock check, whichever comes first
+    Tick when = clockEdge(ticksToCycles(simCycles - curTick()));
+    Cycles deadlock_at = curCycle() +
+        Cycles(responseLimit - noResponseCycles);
+    when = std::min(when, clockEdge(deadlock_at - curCycle()));
+    if (nextInjectCycle < deadlock_at)
+        when = std::min(when, clockEdge(nextInjectCycle - curCycle()));
+
+    if (!tickEvent.scheduled())
+        schedule(tickEvent, when);
+}
+
 void
 GarnetSyntheticTraffic::generatePkt()
 {
@@ -288,20 +371,20 @@ GarnetSyntheticTraffic::generatePkt()
     if (injReqType == 0) {
         // generate packet for virtual network 0
         requestType = MemCmd::ReadReq;
-        req = std::make_shared<Request>(paddr, access_size, flags,
-                                        requestorId);
+        req = Request::create(paddr, access_size, flags,
+                              requestorId);
     } else if (injReqType == 1) {
         // generate packet for virtual network 1
         requestType = MemCmd::ReadReq;
         flags.set(Request::INST_FETCH);
-        req = std::make_shared<Request>(
+        req = Request::create(
             0x0, access_size, flags, requestorId, 0x0, 0);
         req->setPaddr(paddr);
     } else {  // if (injReqType == 2)
         // generate packet for virtual network 2
         requestType = MemCmd::WriteReq;
-        req = std::make_shared<Request>(paddr, access_size, flags,
-                                        requestorId);
+        req = Request::create(paddr, access_size, flags,
+                              requestorId);
     }
 
     req->setContext(id);
@@ -128,6 +128,21 @@ class GarnetSyntheticTraffic : public ClockedObject
     int injVnet;
     int precision;
 
+    /**
+     * Skip the cycles without injection, rather than drawing a random
+     * number every cycle to decide whether to inject.
+     */
+    const bool geometricInjection;
+
+    /** Probability of injecting in any given cycle. */
+    double injProb;
+
+    /** Next cycle to inject in, with geometric injection. */
+    Cycles nextInjectCycle;
+
+    /** Cycle up to which noResponseCycles accounts for. */
+    Cycles lastCountedCycle;
+
     const Cycles responseLimit;
 
     RequestorID requestorId;
@@ -135,6 +150,15 @@ class GarnetSyntheticTraffic : public ClockedObject
     void completeRequest(PacketPtr pkt);
 
     void generatePkt();
+
+    /**
+     * Draw the number of cycles until the next injection, counting the
+     * injecting cycle, for geometric injection.
+     */
+    Cycles injectionGap();
+
+    /** Wake up only when there is something to do. */
+    void geometricTick();
     void sendPkt(PacketPtr pkt);
     void initTrafficType();
 
@@ -49,6 +49,10 @@ class GarnetSyntheticTraffic(ClockedObject):
                                 Default is to inject in all three vnets")
     precision = Param.Int(3, "Number of digits of precision \
                               after decimal point")
+    geometric_injection = Param.Bool(False, "Draw the number of cycles \
+                              until the next injection from a geometric \
+                              distribution and only wake up then, instead \
+                              of deciding whether to inject every cycle")
     response_limit = Param.Cycles(5000000, "Cycles before exiting \
                                             due to lack of progress")
     test = RequestPort("Port to the memory system to test")
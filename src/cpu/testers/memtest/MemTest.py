@@ -50,6 +50,10 @@ class MemTest(ClockedObject):
     interval = Param.Cycles(1, "Interval between request packets")
     size = Param.Unsigned(65536, "Size of memory region to use (bytes)")
     max_loads = Param.Counter(0, "Number of loads to execute before exiting")
+    requests_per_tick = Param.Unsigned(1, "Number of requests issued on "
+        "each tick, to load the memory system harder")
+    max_outstanding = Param.Unsigned(100, "Number of outstanding requests "
+        "after which the tester waits for responses")
 
     # Control the mix of packets and if functional accesses are part of
     # the mix or not
@@ -40,6 +40,7 @@
 
 #include "cpu/testers/memtest/memtest.hh"
 
+#include "base/intmath.hh"
 #include "base/random.hh"
 #include "base/statistics.hh"
 #include "base/trace.hh"
@@ -89,9 +90,16 @@ MemTest::MemTest(const Params &p)
       percentReads(p.percent_reads),
       percentFunctional(p.percent_functional),
       percentUncacheable(p.percent_uncacheable),
+      requestsPerTick(p.requests_per_tick),
+      maxOutstanding(p.max_outstanding),
       requestorId(p.system->getRequestorId(this)),
       blockSize(p.system->cacheLineSize()),
       blockAddrMask(blockSize - 1),
+      regionBlocks(divCeil(size, blockSize)),
+      outstandingAddrs(3 * regionBlocks, false),
+      numOutstanding(0),
+      waitingForResponse(false),
+      referenceData(3 * regionBlocks, 0),
       progressInterval(p.progress_interval),
       progressCheck(p.progress_check),
       nextProgressMessage(p.progress_interval),
@@ -107,6 +115,15 @@ MemTest::MemTest(const Params &p)
     baseAddr2 = 0x400000;
     uncacheAddr = 0x800000;
 
+    fatal_if(size > baseAddr2 - baseAddr1, "%s: the tested regions overlap "
+             "for a size of more than %#x\n", name(), baseAddr2 - baseAddr1);
+    fatal_if(requestsPerTick == 0, "%s: requests_per_tick must not be 0\n",
+             name());
+    // Leave some free addresses to pick new requests from
+    fatal_if(maxOutstanding == 0 || maxOutstanding >= regionBlocks,
+             "%s: max_outstanding must be between 1 and %d\n", name(),
+             regionBlocks - 1);
+
     // set up counters
     numReads = 0;
     numWrites = 0;
@@ -132,9 +149,10 @@ MemTest::completeRequest(PacketPtr pkt, bool functional)
     assert(req->getSize() == 1);
 
     // this address is no longer outstanding
-    auto remove_addr = outstandingAddrs.find(req->getPaddr());
-    assert(remove_addr != outstandingAddrs.end());
-    outstandingAddrs.erase(remove_addr);
+    const unsigned index = addrIndex(req->getPaddr());
+    assert(outstandingAddrs[index]);
+    outstandingAddrs[index] = false;
+    numOutstanding--;
 
     DPRINTF(MemTest, "Completing %s at address %x (blk %x) %s\n",
             pkt->isWrite() ? "write" : "read",
@@ -149,7 +167,7 @@ MemTest::completeRequest(PacketPtr pkt, bool functional)
                 pkt->isWrite() ? "Write" : "Read", req->getPaddr());
     } else {
         if (pkt->isRead()) {
-            uint8_t ref_data = referenceData[req->getPaddr()];
+            uint8_t ref_data = referenceData[index];
             if (pkt_data[0] != ref_data) {
                 panic("%s: read of %x (blk %x) @ cycle %d "
                       "returns %x, expected %x\n", name(),
@@ -173,7 +191,7 @@ MemTest::completeRequest(PacketPtr pkt, bool functional)
             assert(pkt->isWrite());
 
             // update the reference data
-            referenceData[req->getPaddr()] = pkt_data[0];
+            referenceData[index] = pkt_data[0];
             numWrites++;
             stats.numWrites++;
         }
@@ -184,10 +202,17 @@ MemTest::completeRequest(PacketPtr pkt, bool functional)
 
     // finally shift the response timeout forward if we are still
     // expecting responses; deschedule it otherwise
-    if (outstandingAddrs.size() != 0)
+    if (numOutstanding != 0)
         reschedule(noResponseEvent, clockEdge(progressCheck));
     else if (noResponseEvent.scheduled())
         deschedule(noResponseEvent);
+
+    // start issuing requests again if we were waiting for responses
+    if (waitingForResponse) {
+        waitingForResponse = false;
+        schedule(tickEvent, clockEdge(interval));
+        reschedule(noRequestEvent, clockEdge(progressCheck), true);
+    }
 }
 MemTest::MemTestStats::MemTestStats(Stats::Group *parent)
       : Stats::Group(parent),
@@ -203,6 +228,38 @@ MemTest::tick()
     // we should never tick if we are waiting for a retry
     assert(!retryPkt);
 
+    // there is no point in ticking if we are waiting for a retry
+    bool keep_ticking = true;
+    for (unsigned i = 0; i < requestsPerTick && keep_ticking &&
+             numOutstanding < maxOutstanding; i++) {
+        keep_ticking = issueRequest();
+    }
+
+    if (!keep_ticking) {
+        DPRINTF(MemTest, "Waiting for retry\n");
+    } else if (numOutstanding >= maxOutstanding) {
+        DPRINTF(MemTest, "Waiting for responses\n");
+        waitingForResponse = true;
+        // the response timeout guards progress until we tick again
+        if (noRequestEvent.scheduled())
+            deschedule(noRequestEvent);
+    } else {
+        // schedule the next tick
+        schedule(tickEvent, clockEdge(interval));
+
+        // finally shift the timeout for sending of requests forwards
+        // as we have successfully sent a packet
+        reschedule(noRequestEvent, clockEdge(progressCheck), true);
+    }
+
+    // Schedule noResponseEvent now if we are expecting a response
+    if (!noResponseEvent.scheduled() && (numOutstanding != 0))
+        schedule(noResponseEvent, clockEdge(progressCheck));
+}
+
+bool
+MemTest::issueRequest()
+{
     // create a new request
     unsigned cmd = random_mt.random(0, 100);
     uint8_t data = random_mt.random<uint8_t>();
@@ -225,32 +282,21 @@ MemTest::tick()
         } else  {
             paddr = ((base) ? baseAddr1 : baseAddr2) + offset;
         }
-    } while (outstandingAddrs.find(paddr) != outstandingAddrs.end());
+    } while (outstandingAddrs[addrIndex(paddr)]);
 
     bool do_functional = (random_mt.random(0, 100) < percentFunctional) &&
         !uncacheable;
-    RequestPtr req = std::make_shared<Request>(paddr, 1, flags, requestorId);
+    RequestPtr req = Request::create(paddr, 1, flags, requestorId);
     req->setContext(id);
 
-    outstandingAddrs.insert(paddr);
-
-    // sanity check
-    panic_if(outstandingAddrs.size() > 100,
-             "Tester %s has more than 100 outstanding requests\n", name());
+    outstandingAddrs[addrIndex(paddr)] = true;
+    numOutstanding++;
 
     PacketPtr pkt = nullptr;
     uint8_t *pkt_data = new uint8_t[1];
 
     if (cmd < percentReads) {
-        // start by ensuring there is a reference value if we have not
-        // seen this address before
-        M5_VAR_USED uint8_t ref_data = 0;
-        auto ref = referenceData.find(req->getPaddr());
-        if (ref == referenceData.end()) {
-            referenceData[req->getPaddr()] = 0;
-        } else {
-            ref_data = ref->second;
-        }
+        M5_VAR_USED uint8_t ref_data = referenceData[addrIndex(paddr)];
 
         DPRINTF(MemTest,
                 "Initiating %sread at addr %x (blk %x) expecting %x\n",
@@ -269,30 +315,14 @@ MemTest::tick()
         pkt_data[0] = data;
     }
 
-    // there is no point in ticking if we are waiting for a retry
-    bool keep_ticking = true;
     if (do_functional) {
         pkt->setSuppressFuncError();
         port.sendFunctional(pkt);
         completeRequest(pkt, true);
+        return true;
     } else {
-        keep_ticking = sendPkt(pkt);
+        return sendPkt(pkt);
     }
-
-    if (keep_ticking) {
-        // schedule the next tick
-        schedule(tickEvent, clockEdge(interval));
-
-        // finally shift the timeout for sending of requests forwards
-        // as we have successfully sent a packet
-        reschedule(noRequestEvent, clockEdge(progressCheck), true);
-    } else {
-        DPRINTF(MemTest, "Waiting for retry\n");
-    }
-
-    // Schedule noResponseEvent now if we are expecting a response
-    if (!noResponseEvent.scheduled() && (outstandingAddrs.size() != 0))
-        schedule(noResponseEvent, clockEdge(progressCheck));
 }
 
 void
@@ -315,8 +345,15 @@ MemTest::recvRetry()
         DPRINTF(MemTest, "Proceeding after successful retry\n");
 
         retryPkt = nullptr;
-        // kick things into action again
-        schedule(tickEvent, clockEdge(interval));
-        reschedule(noRequestEvent, clockEdge(progressCheck), true);
+        // kick things into action again, unless the retried request
+        // filled up the outstanding requests
+        if (numOutstanding >= maxOutstanding) {
+            waitingForResponse = true;
+            if (noRequestEvent.scheduled())
+                deschedule(noRequestEvent);
+        } else {
+            schedule(tickEvent, clockEdge(interval));
+            reschedule(noRequestEvent, clockEdge(progressCheck), true);
+        }
     }
 }
@@ -41,8 +41,7 @@
 #ifndef __CPU_MEMTEST_MEMTEST_HH__
 #define __CPU_MEMTEST_MEMTEST_HH__
 
-#include <set>
-#include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "mem/port.hh"
@@ -63,6 +62,10 @@
  * In addition to verifying the data, the tester also has timeouts for
  * both requests and responses, thus checking that the memory-system
  * is making progress.
+ *
+ * Several requests may be issued on each tick, and the tester waits
+ * for responses once a given number of requests are outstanding, so
+ * that the memory system can be stressed with few testers.
  */
 class MemTest : public ClockedObject
 {
@@ -82,6 +85,13 @@ class MemTest : public ClockedObject
 
     EventFunctionWrapper tickEvent;
 
+    /**
+     * Create and send a new request.
+     *
+     * @return false if the request has to be retried
+     */
+    bool issueRequest();
+
     void noRequest();
 
     EventFunctionWrapper noRequestEvent;
@@ -125,20 +135,35 @@ class MemTest : public ClockedObject
     const unsigned percentFunctional;
     const unsigned percentUncacheable;
 
+    const unsigned requestsPerTick;
+    const unsigned maxOutstanding;
+
     /** Request id for all generated traffic */
     RequestorID requestorId;
 
     unsigned int id;
 
-    std::set<Addr> outstandingAddrs;
-
-    // store the expected value for the addresses we have touched
-    std::unordered_map<Addr, uint8_t> referenceData;
-
     const unsigned blockSize;
 
     const Addr blockAddrMask;
 
+    /**
+     * Number of blocks of each of the regions. A tester only accesses
+     * one byte of each block, so its addresses are indexed by region
+     * and block.
+     */
+    const unsigned regionBlocks;
+
+    // whether each address has a request outstanding
+    std::vector<bool> outstandingAddrs;
+    unsigned numOutstanding;
+
+    // whether the tester stopped ticking until a response comes back
+    bool waitingForResponse;
+
+    // store the expected value for all the addresses, which start as 0
+    std::vector<uint8_t> referenceData;
+
     /**
      * Get the block aligned address.
      *
@@ -154,6 +179,21 @@ class MemTest : public ClockedObject
     Addr baseAddr2;
     Addr uncacheAddr;
 
+    /**
+     * Get the index of an address in the reference data.
+     *
+     * @param addr Address accessed by this tester
+     * @return The index of the address
+     */
+    unsigned
+    addrIndex(Addr addr) const
+    {
+        unsigned region = addr >= uncacheAddr ? 2 : addr >= baseAddr2 ? 1 : 0;
+        Addr base = region == 2 ? uncacheAddr :
+            region == 1 ? baseAddr2 : baseAddr1;
+        return region * regionBlocks + (addr - base) / blockSize;
+    }
+
     const unsigned progressInterval;  // frequency of progress reports
     const Cycles progressCheck;
     Tick nextProgressMessage;   // access # for next progress report
@@ -79,6 +79,13 @@ class BaseTrafficGen(ClockedObject):
     progress_check = Param.Latency('1ms', "Time before exiting " \
                                    "due to lack of progress")
 
+    # Generate requests in batches. The linear, random and strided
+    # generators compute the addresses of a whole batch at once, and
+    # all the packets due before the next clock edge, up to a batch,
+    # are sent from a single event rather than one event per packet.
+    # A batch size of 1 keeps the per packet timing.
+    batch_size = Param.Unsigned(1, "Number of requests generated at once")
+
     # Generator type used for applying Stream and/or Substream IDs to requests
     stream_gen = Param.StreamGenType('none',
         "Generator for adding Stream and/or Substream ID's to requests")
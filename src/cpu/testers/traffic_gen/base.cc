@@ -70,6 +70,7 @@ BaseTrafficGen::BaseTrafficGen(const BaseTrafficGenParams &p)
       system(p.system),
       elasticReq(p.elastic_req),
       progressCheck(p.progress_check),
+      batchSize(p.batch_size),
       noProgressEvent([this]{ noProgress(); }, name()),
       nextTransitionTick(0),
       nextPacketTick(0),
@@ -175,43 +176,12 @@ BaseTrafficGen::update()
         transition();
     } else {
         assert(curTick() >= nextPacketTick);
-        // get the next packet and try to send it
-        PacketPtr pkt = activeGenerator->getNextPacket();
+        sendNextPacket();
 
-        // If generating stream/substream IDs are enabled,
-        // try to pick and assign them to the new packet
-        if (streamGenerator) {
-            auto sid = streamGenerator->pickStreamID();
-            auto ssid = streamGenerator->pickSubstreamID();
-
-            pkt->req->setStreamId(sid);
-
-            if (streamGenerator->ssidValid()) {
-                pkt->req->setSubstreamId(ssid);
-            }
-        }
-
-        // suppress packets that are not destined for a memory, such as
-        // device accesses that could be part of a trace
-        if (pkt && system->isMemAddr(pkt->getAddr())) {
-            stats.numPackets++;
-            // Only attempts to send if not blocked by pending responses
-            blockedWaitingResp = allocateWaitingRespSlot(pkt);
-            if (blockedWaitingResp || !port.sendTimingReq(pkt)) {
-                retryPkt = pkt;
-                retryPktTick = curTick();
-            }
-        } else if (pkt) {
-            DPRINTF(TrafficGen, "Suppressed packet %s 0x%x\n",
-                    pkt->cmdString(), pkt->getAddr());
-
-            ++stats.numSuppressed;
-            if (!(static_cast<int>(stats.numSuppressed.value()) % 10000))
-                warn("%s suppressed %d packets with non-memory addresses\n",
-                     name(), stats.numSuppressed.value());
-
-            delete pkt;
-            pkt = nullptr;
+        if (batchSize > 1 && activeGenerator->batchable() &&
+            retryPkt == NULL) {
+            sendBatch();
+            return;
         }
     }
 
@@ -224,6 +194,78 @@ BaseTrafficGen::update()
     }
 }
 
+void
+BaseTrafficGen::sendNextPacket()
+{
+    // get the next packet and try to send it
+    PacketPtr pkt = activeGenerator->getNextPacket();
+
+    // If generating stream/substream IDs are enabled,
+    // try to pick and assign them to the new packet
+    if (streamGenerator) {
+        auto sid = streamGenerator->pickStreamID();
+        auto ssid = streamGenerator->pickSubstreamID();
+
+        pkt->req->setStreamId(sid);
+
+        if (streamGenerator->ssidValid()) {
+            pkt->req->setSubstreamId(ssid);
+        }
+    }
+
+    // suppress packets that are not destined for a memory, such as
+    // device accesses that could be part of a trace
+    if (pkt && system->isMemAddr(pkt->getAddr())) {
+        stats.numPackets++;
+        // Only attempts to send if not blocked by pending responses
+        blockedWaitingResp = allocateWaitingRespSlot(pkt);
+        if (blockedWaitingResp || !port.sendTimingReq(pkt)) {
+            retryPkt = pkt;
+            retryPktTick = curTick();
+        }
+    } else if (pkt) {
+        DPRINTF(TrafficGen, "Suppressed packet %s 0x%x\n",
+                pkt->cmdString(), pkt->getAddr());
+
+        ++stats.numSuppressed;
+        if (!(static_cast<int>(stats.numSuppressed.value()) % 10000))
+            warn("%s suppressed %d packets with non-memory addresses\n",
+                 name(), stats.numSuppressed.value());
+
+        delete pkt;
+        pkt = nullptr;
+    }
+}
+
+void
+BaseTrafficGen::sendBatch()
+{
+    // The generators return the tick of the next packet relative to
+    // the current tick, accumulate the intervals to find the packets
+    // that fall within the current clock cycle.
+    Tick cycle_end = clockEdge();
+    if (cycle_end == curTick())
+        cycle_end += clockPeriod();
+
+    Tick when = curTick();
+    for (unsigned sent = 1; retryPkt == NULL; ++sent) {
+        const Tick next = activeGenerator->nextPacketTick(elasticReq, 0);
+        when = next == MaxTick ? MaxTick : when + (next - curTick());
+
+        if (sent == batchSize || when >= cycle_end ||
+            when >= nextTransitionTick) {
+            nextPacketTick = when;
+            scheduleUpdate();
+            return;
+        }
+
+        sendNextPacket();
+    }
+
+    // if we are waiting for a retry or for a response, the next update
+    // is scheduled once the packet has been sent
+}
+
 void
 BaseTrafficGen::transition()
 {
@@ -385,7 +427,8 @@ BaseTrafficGen::createLinear(Tick duration,
                                                   end_addr, blocksize,
                                                   system->cacheLineSize(),
                                                   min_period, max_period,
-                                                  read_percent, data_limit));
+                                                  read_percent, data_limit,
+                                                  batchSize));
 }
 
 std::shared_ptr<BaseGen>
@@ -399,7 +442,8 @@ BaseTrafficGen::createRandom(Tick duration,
                                                   end_addr, blocksize,
                                                   system->cacheLineSize(),
                                                   min_period, max_period,
-                                                  read_percent, data_limit));
+                                                  read_percent, data_limit,
+                                                  batchSize));
 }
 
 std::shared_ptr<BaseGen>
@@ -533,7 +577,8 @@ BaseTrafficGen::createStrided(Tick duration,
                                                   system->cacheLineSize(),
                                                   stride_size, gen_id,
                                                   min_period, max_period,
-                                                  read_percent, data_limit));
+                                                  read_percent, data_limit,
+                                                  batchSize));
 }
 
 std::shared_ptr<BaseGen>
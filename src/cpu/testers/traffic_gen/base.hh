@@ -84,6 +84,12 @@ class BaseTrafficGen : public ClockedObject
      */
     const Tick progressCheck;
 
+    /**
+     * Number of requests generated at once, and the maximum number of
+     * packets sent from one update.
+     */
+    const unsigned batchSize;
+
   private:
     /**
      * Receive a retry from the neighbouring port and attempt to
@@ -157,6 +163,18 @@ class BaseTrafficGen : public ClockedObject
      */
     void update();
 
+    /**
+     * Get the next packet from the active generator and try to send
+     * it, leaving it in retryPkt if it is not accepted.
+     */
+    void sendNextPacket();
+
+    /**
+     * In batch mode, send the packets that are due before the next
+     * clock edge, after the one sent by the current update.
+     */
+    void sendBatch();
+
     /** The instance of request port used by the traffic generator. */
     TrafficGenPort port;
 
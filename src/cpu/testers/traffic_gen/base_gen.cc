@@ -40,6 +40,7 @@
 #include <algorithm>
 
 #include "base/logging.hh"
+#include "base/random.hh"
 #include "cpu/testers/traffic_gen/base.hh"
 
 BaseGen::BaseGen(SimObject &obj, RequestorID requestor_id, Tick _duration)
@@ -53,20 +54,19 @@ BaseGen::getPacket(Addr addr, unsigned size, const MemCmd& cmd,
                    Request::FlagsType flags)
 {
     // Create new request
-    RequestPtr req = std::make_shared<Request>(addr, size, flags,
-                                               requestorId);
+    RequestPtr req = Request::create(addr, size, flags,
+                                     requestorId);
     // Dummy PC to have PC-based prefetchers latch on; get entropy into higher
     // bits
     req->setPC(((Addr)requestorId) << 2);
 
-    // Embed it in a packet
+    // Embed it in a packet, the data comes from the memory pool
     PacketPtr pkt = new Packet(req, cmd);
-
-    uint8_t* pkt_data = new uint8_t[req->getSize()];
-    pkt->dataDynamic(pkt_data);
+    pkt->allocate();
 
     if (cmd.isWrite()) {
-        std::fill_n(pkt_data, req->getSize(), (uint8_t)requestorId);
+        std::fill_n(pkt->getPtr<uint8_t>(), req->getSize(),
+                    (uint8_t)requestorId);
     }
 
     return pkt;
@@ -77,12 +77,16 @@ StochasticGen::StochasticGen(SimObject &obj,
                              Addr start_addr, Addr end_addr,
                              Addr _blocksize, Addr cacheline_size,
                              Tick min_period, Tick max_period,
-                             uint8_t read_percent, Addr data_limit)
+                             uint8_t read_percent, Addr data_limit,
+                             unsigned batch_size)
         : BaseGen(obj, requestor_id, _duration),
           startAddr(start_addr), endAddr(end_addr),
           blocksize(_blocksize), cacheLineSize(cacheline_size),
           minPeriod(min_period), maxPeriod(max_period),
-          readPercent(read_percent), dataLimit(data_limit)
+          readPercent(read_percent), dataLimit(data_limit),
+          batchSize(std::max(batch_size, 1U)),
+          batchAddrs(batchSize), batchReads(batchSize),
+          batchPos(batchSize)
 {
     if (blocksize > cacheLineSize)
         fatal("TrafficGen %s block size (%d) is larger than "
@@ -95,3 +99,23 @@ StochasticGen::StochasticGen(SimObject &obj,
     if (min_period > max_period)
         fatal("%s cannot have min_period > max_period", name());
 }
+
+bool
+StochasticGen::nextRequest(Addr &addr)
+{
+    if (batchPos == batchSize) {
+        // choose if we generate reads or writes, the draws from the
+        // random number generator happen in the same order as when
+        // generating one request at a time if the batch size is one
+        for (auto &is_read : batchReads) {
+            is_read = readPercent != 0 &&
+                (readPercent == 100 ||
+                 random_mt.random(0, 100) < readPercent);
+        }
+        generateAddrs(batchAddrs.data(), batchSize);
+        batchPos = 0;
+    }
+
+    addr = batchAddrs[batchPos];
+    return batchReads[batchPos++];
+}
@@ -45,6 +45,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "base/types.hh"
 #include "mem/packet.hh"
@@ -131,6 +132,16 @@ class BaseGen
      */
     virtual Tick nextPacketTick(bool elastic, Tick delay) const = 0;
 
+    /**
+     * Can several packets be sent from one update in batch mode? This
+     * requires nextPacketTick() to draw the interval to the next
+     * packet from the current tick, which is the case for the
+     * stochastic generators but not e.g. for traces.
+     *
+     * @return true if the generator supports batch mode
+     */
+    virtual bool batchable() const { return false; }
+
 };
 
 class StochasticGen : public BaseGen
@@ -141,7 +152,10 @@ class StochasticGen : public BaseGen
                   Addr start_addr, Addr end_addr,
                   Addr _blocksize, Addr cacheline_size,
                   Tick min_period, Tick max_period,
-                  uint8_t read_percent, Addr data_limit);
+                  uint8_t read_percent, Addr data_limit,
+                  unsigned batch_size=1);
+
+    bool batchable() const override { return true; }
 
   protected:
     /** Start of address range */
@@ -167,6 +181,46 @@ class StochasticGen : public BaseGen
 
     /** Maximum amount of data to manipulate */
     const Addr dataLimit;
+
+    /**
+     * Number of requests generated at once. The commands and
+     * addresses of a whole batch are computed in one go, ahead of
+     * the packets they end up in.
+     */
+    const unsigned batchSize;
+
+    /**
+     * Get the next request of the current batch, generating a new
+     * batch once the current one has been used up.
+     *
+     * @param addr Address of the request
+     * @return True if the request is a read
+     */
+    bool nextRequest(Addr &addr);
+
+    /**
+     * Drop the requests generated ahead, to be called when the
+     * address sequence starts over.
+     */
+    void resetBatch() { batchPos = batchAddrs.size(); }
+
+    /**
+     * Generate the addresses of a batch of requests.
+     *
+     * @param addrs Array to fill in
+     * @param count Number of addresses to generate
+     */
+    virtual void generateAddrs(Addr *addrs, unsigned count) = 0;
+
+  private:
+    /** Addresses of the requests in the current batch */
+    std::vector<Addr> batchAddrs;
+
+    /** Commands of the requests in the current batch, 1 for reads */
+    std::vector<uint8_t> batchReads;
+
+    /** Index of the next request in the current batch */
+    unsigned batchPos;
 };
 
 #endif
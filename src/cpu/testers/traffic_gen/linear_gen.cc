@@ -49,39 +49,42 @@ LinearGen::enter()
     // reset the address and the data counter
     nextAddr = startAddr;
     dataManipulated = 0;
+    resetBatch();
+}
+
+void
+LinearGen::generateAddrs(Addr *addrs, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i) {
+        addrs[i] = nextAddr;
+
+        // increment the address
+        nextAddr += blocksize;
+
+        // If we have reached the end of the address space, reset the
+        // address to the start of the range
+        if (nextAddr > endAddr) {
+            DPRINTF(TrafficGen, "Wrapping address to the start of "
+                    "the range\n");
+            nextAddr = startAddr;
+        }
+    }
 }
 
 PacketPtr
 LinearGen::getNextPacket()
 {
-    // choose if we generate a read or a write here
-    bool isRead = readPercent != 0 &&
-        (readPercent == 100 || random_mt.random(0, 100) < readPercent);
-
-    assert((readPercent == 0 && !isRead) || (readPercent == 100 && isRead) ||
-           readPercent != 100);
+    Addr addr;
+    bool isRead = nextRequest(addr);
 
     DPRINTF(TrafficGen, "LinearGen::getNextPacket: %c to addr %x, size %d\n",
-            isRead ? 'r' : 'w', nextAddr, blocksize);
+            isRead ? 'r' : 'w', addr, blocksize);
 
     // Add the amount of data manipulated to the total
     dataManipulated += blocksize;
 
-    PacketPtr pkt = getPacket(nextAddr, blocksize,
-                              isRead ? MemCmd::ReadReq : MemCmd::WriteReq);
-
-    // increment the address
-    nextAddr += blocksize;
-
-    // If we have reached the end of the address space, reset the
-    // address to the start of the range
-    if (nextAddr > endAddr) {
-        DPRINTF(TrafficGen, "Wrapping address to the start of "
-                "the range\n");
-        nextAddr = startAddr;
-    }
-
-    return pkt;
+    return getPacket(addr, blocksize,
+                     isRead ? MemCmd::ReadReq : MemCmd::WriteReq);
 }
 
 Tick
@@ -77,16 +77,18 @@ class LinearGen : public StochasticGen
      * @param max_period Upper limit of random inter-transaction time
      * @param read_percent Percent of transactions that are reads
      * @param data_limit Upper limit on how much data to read/write
+     * @param batch_size Number of requests generated at once
      */
     LinearGen(SimObject &obj,
               RequestorID requestor_id, Tick _duration,
               Addr start_addr, Addr end_addr,
               Addr _blocksize, Addr cacheline_size,
               Tick min_period, Tick max_period,
-              uint8_t read_percent, Addr data_limit)
+              uint8_t read_percent, Addr data_limit,
+              unsigned batch_size=1)
         : StochasticGen(obj, requestor_id, _duration, start_addr, end_addr,
                         _blocksize, cacheline_size, min_period, max_period,
-                        read_percent, data_limit),
+                        read_percent, data_limit, batch_size),
           nextAddr(0),
           dataManipulated(0)
     { }
@@ -97,6 +99,9 @@ class LinearGen : public StochasticGen
 
     Tick nextPacketTick(bool elastic, Tick delay) const;
 
+  protected:
+    void generateAddrs(Addr *addrs, unsigned count) override;
+
   private:
     /** Address of next request */
     Addr nextAddr;
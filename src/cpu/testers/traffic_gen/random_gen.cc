@@ -48,23 +48,26 @@ RandomGen::enter()
 {
     // reset the counter to zero
     dataManipulated = 0;
+    resetBatch();
 }
 
-PacketPtr
-RandomGen::getNextPacket()
+void
+RandomGen::generateAddrs(Addr *addrs, unsigned count)
 {
-    // choose if we generate a read or a write here
-    bool isRead = readPercent != 0 &&
-        (readPercent == 100 || random_mt.random(0, 100) < readPercent);
+    for (unsigned i = 0; i < count; ++i) {
+        // address of the request
+        Addr addr = random_mt.random(startAddr, endAddr - 1);
 
-    assert((readPercent == 0 && !isRead) || (readPercent == 100 && isRead) ||
-           readPercent != 100);
-
-    // address of the request
-    Addr addr = random_mt.random(startAddr, endAddr - 1);
+        // round down to start address of block
+        addrs[i] = addr - addr % blocksize;
+    }
+}
 
-    // round down to start address of block
-    addr -= addr % blocksize;
+PacketPtr
+RandomGen::getNextPacket()
+{
+    Addr addr;
+    bool isRead = nextRequest(addr);
 
     DPRINTF(TrafficGen, "RandomGen::getNextPacket: %c to addr %x, size %d\n",
             isRead ? 'r' : 'w', addr, blocksize);
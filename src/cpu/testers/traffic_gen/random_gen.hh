@@ -75,16 +75,18 @@ class RandomGen : public StochasticGen
      * @param max_period Upper limit of random inter-transaction time
      * @param read_percent Percent of transactions that are reads
      * @param data_limit Upper limit on how much data to read/write
+     * @param batch_size Number of requests generated at once
      */
     RandomGen(SimObject &obj,
               RequestorID requestor_id, Tick _duration,
               Addr start_addr, Addr end_addr,
               Addr _blocksize, Addr cacheline_size,
               Tick min_period, Tick max_period,
-              uint8_t read_percent, Addr data_limit)
+              uint8_t read_percent, Addr data_limit,
+              unsigned batch_size=1)
         : StochasticGen(obj, requestor_id, _duration, start_addr, end_addr,
                         _blocksize, cacheline_size, min_period, max_period,
-                        read_percent, data_limit),
+                        read_percent, data_limit, batch_size),
           dataManipulated(0)
     { }
 
@@ -95,6 +97,8 @@ class RandomGen : public StochasticGen
     Tick nextPacketTick(bool elastic, Tick delay) const;
 
   protected:
+    void generateAddrs(Addr *addrs, unsigned count) override;
+
     /**
      * Counter to determine the amount of data
      * manipulated. Used to determine if we should continue
@@ -81,6 +81,7 @@ class StridedGen : public StochasticGen
      * @param max_period Upper limit of random inter-transaction time
      * @param read_percent Percent of transactions that are reads
      * @param data_limit Upper limit on how much data to read/write
+     * @param batch_size Number of requests generated at once
      */
     StridedGen(SimObject &obj,
               RequestorID requestor_id, Tick _duration,
@@ -88,10 +89,11 @@ class StridedGen : public StochasticGen
               Addr _blocksize, Addr cacheline_size,
               Addr stride_size, int gen_id,
               Tick min_period, Tick max_period,
-              uint8_t read_percent, Addr data_limit)
+              uint8_t read_percent, Addr data_limit,
+              unsigned batch_size=1)
         : StochasticGen(obj, requestor_id, _duration, start_addr, end_addr,
                         _blocksize, cacheline_size, min_period, max_period,
-                        read_percent, data_limit),
+                        read_percent, data_limit, batch_size),
           nextAddr(0),
           dataManipulated(0),
           strideSize(stride_size),
@@ -104,6 +106,9 @@ class StridedGen : public StochasticGen
 
     Tick nextPacketTick(bool elastic, Tick delay) const;
 
+  protected:
+    void generateAddrs(Addr *addrs, unsigned count) override;
+
   private:
     /** Address of next request */
     Addr nextAddr;
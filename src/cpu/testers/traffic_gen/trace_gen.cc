@@ -45,17 +45,29 @@
 #include "proto/packet.pb.h"
 
 TraceGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+    : batchPos(0)
 {
+    if (PacketTraceReader::isPacketTrace(filename))
+        blockTrace.reset(new PacketTraceReader(filename));
+    else
+        trace.reset(new ProtoInputStream(filename));
     init();
 }
 
 void
 TraceGen::InputStream::init()
 {
+    if (blockTrace) {
+        if (blockTrace->header().tickFreq != SimClock::Frequency) {
+            panic("Trace was recorded with a different tick frequency %d\n",
+                  blockTrace->header().tickFreq);
+        }
+        return;
+    }
+
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
-    if (!trace.read(header_msg)) {
+    if (!trace->read(header_msg)) {
         panic("Failed to read packet header from trace\n");
     } else if (header_msg.tick_freq() != SimClock::Frequency) {
         panic("Trace was recorded with a different tick frequency %d\n",
@@ -66,15 +78,38 @@ TraceGen::InputStream::init()
 void
 TraceGen::InputStream::reset()
 {
-    trace.reset();
+    if (blockTrace) {
+        blockTrace->reset();
+        batch.clear();
+        batchPos = 0;
+    } else {
+        trace->reset();
+    }
     init();
 }
 
 bool
 TraceGen::InputStream::read(TraceElement& element)
 {
+    if (blockTrace) {
+        // Decode a whole block at a time
+        if (batchPos == batch.size()) {
+            batchPos = 0;
+            if (!blockTrace->readBatch(batch))
+                return false;
+        }
+
+        const PacketTraceRecord &record = batch[batchPos++];
+        element.cmd = MemCmd(record.cmd);
+        element.addr = record.addr;
+        element.blocksize = record.size;
+        element.tick = record.tick;
+        element.flags = record.flags;
+        return true;
+    }
+
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (trace->read(pkt_msg)) {
         element.cmd = pkt_msg.cmd();
         element.addr = pkt_msg.addr();
         element.blocksize = pkt_msg.size();
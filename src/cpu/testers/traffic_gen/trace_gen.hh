@@ -44,10 +44,14 @@
 #ifndef __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 #define __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 
+#include <memory>
+#include <vector>
+
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base_gen.hh"
 #include "mem/packet.hh"
+#include "proto/packet_trace.hh"
 #include "proto/protoio.hh"
 
 /**
@@ -100,7 +104,8 @@ class TraceGen : public BaseGen
     /**
      * The InputStream encapsulates a trace file and the
      * internal buffers and populates TraceElements based on
-     * the input.
+     * the input. Both protobuf and block based packet traces are
+     * supported, the format is detected when opening the file.
      */
     class InputStream
     {
@@ -108,7 +113,14 @@ class TraceGen : public BaseGen
       private:
 
         /// Input file stream for the protobuf trace
-        ProtoInputStream trace;
+        std::unique_ptr<ProtoInputStream> trace;
+
+        /// Reader for a block based trace
+        std::unique_ptr<PacketTraceReader> blockTrace;
+
+        /// The block being replayed, and the next record in it
+        std::vector<PacketTraceRecord> batch;
+        size_t batchPos;
 
       public:
 
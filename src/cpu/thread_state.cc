@@ -92,6 +92,7 @@ ThreadState::initMemProxies(ThreadContext *tc)
         // itself is created in the base cpu constructor and the
         // getSendFunctional is a virtual function
         physProxy = new PortProxy(baseCpu->getSendFunctional(),
+                                  baseCpu->getSendMemBackdoorReq(),
                                   baseCpu->cacheLineSize());
 
         assert(virtProxy == NULL);
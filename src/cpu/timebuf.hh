@@ -181,12 +181,32 @@ class TimeBuffer
         int ptr = base + future;
         if (ptr >= (int)size)
             ptr -= size;
-        (reinterpret_cast<T *>(index[ptr]))->~T();
-        std::memset(index[ptr], 0, sizeof(T));
-        new (index[ptr]) T;
+        resetSlot(reinterpret_cast<T *>(index[ptr]), 0);
     }
 
   protected:
+    /**
+     * Return a slot that is about to be reused to its initial state.
+     * Types that know which of their members were written, such as the
+     * O3 stage structures, can provide a reset() that only clears
+     * those instead of having the whole slot rebuilt.
+     */
+    template <class U>
+    static auto
+    resetSlot(U *slot, int) -> decltype(slot->reset(), void())
+    {
+        slot->reset();
+    }
+
+    template <class U>
+    static void
+    resetSlot(U *slot, long)
+    {
+        slot->~U();
+        std::memset(static_cast<void *>(slot), 0, sizeof(U));
+        new (slot) U;
+    }
+
     //Calculate the index into this->index for element at position idx
     //relative to now
     inline int calculateVectorIndex(int idx) const
@@ -83,3 +83,13 @@ class TraceCPU(BaseCPU):
     progressMsgInterval = Param.Unsigned(0, "Interval of committed "\
                                          "instructions at which to print a"\
                                          " progress msg")
+
+    # The traces are inflated and parsed by a background thread, which
+    # runs up to decodeQueueDepth batches of decodeBatchSize records ahead
+    # of the replay. A depth of 0 decodes the traces in the simulation
+    # thread instead.
+    decodeBatchSize = Param.Unsigned(1024, "Number of trace records "\
+                                     "decoded in one batch")
+    decodeQueueDepth = Param.Unsigned(4, "Number of trace record batches "\
+                                      "decoded ahead of the replay, 0 to "\
+                                      "decode synchronously")
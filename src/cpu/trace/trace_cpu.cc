@@ -50,7 +50,8 @@ TraceCPU::TraceCPU(const TraceCPUParams &params)
         dataRequestorID(params.system->getRequestorId(this, "data")),
         instTraceFile(params.instTraceFile),
         dataTraceFile(params.dataTraceFile),
-        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile),
+        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile,
+                  params),
         dcacheGen(*this, ".dside", dcachePort, dataRequestorID, dataTraceFile,
                   params),
         icacheNextEvent([this]{ schedIcacheNext(); }, name()),
@@ -589,7 +590,7 @@ TraceCPU::ElasticDataGen::executeMemReq(GraphNode* node_ptr)
     }
 
     // Create a request and the packet containing request
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         node_ptr->physAddr, node_ptr->size, node_ptr->flags, requestorId);
     req->setReqInstSeqNum(node_ptr->seqNum);
 
@@ -1078,7 +1079,7 @@ TraceCPU::FixedRetryGen::send(Addr addr, unsigned size, const MemCmd& cmd,
 {
 
     // Create new request
-    auto req = std::make_shared<Request>(addr, size, flags, requestorId);
+    auto req = Request::create(addr, size, flags, requestorId);
     req->setPC(pc);
 
     // If this is not done it triggers assert in L1 cache for invalid contextId
@@ -1183,10 +1184,14 @@ TraceCPU::DcachePort::recvReqRetry()
 }
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
-        const std::string& filename, const double time_multiplier) :
+        const std::string& filename, const double time_multiplier,
+        const TraceCPUParams &params) :
     trace(filename),
     timeMultiplier(time_multiplier),
-    microOpCount(0)
+    microOpCount(0),
+    decodedOpCount(0),
+    reader([this](GraphNode& element) { return decode(element); },
+           params.decodeBatchSize, params.decodeQueueDepth)
 {
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::InstDepRecordHeader header_msg;
@@ -1202,77 +1207,94 @@ TraceCPU::ElasticDataGen::InputStream::InputStream(
         // when the data dependency trace was captured in the o3cpu model
         windowSize = header_msg.window_size();
     }
+
+    // Only start decoding once the header has been read
+    reader.start();
 }
 
 void
 TraceCPU::ElasticDataGen::InputStream::reset()
 {
+    reader.stop();
     trace.reset();
+    reader.start();
 }
 
 bool
 TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
 {
+    if (!reader.read(*element))
+        return false;
+
+    microOpCount = element->robNum;
+    return true;
+}
+
+bool
+TraceCPU::ElasticDataGen::InputStream::decode(GraphNode& element)
+{
+    // This may run in the reader thread, so it must only touch the trace
+    // and the counters that are private to decoding.
     ProtoMessage::InstDepRecord pkt_msg;
     if (trace.read(pkt_msg)) {
         // Required fields
-        element->seqNum = pkt_msg.seq_num();
-        element->type = pkt_msg.type();
+        element.seqNum = pkt_msg.seq_num();
+        element.type = pkt_msg.type();
         // Scale the compute delay to effectively scale the Trace CPU frequency
-        element->compDelay = pkt_msg.comp_delay() * timeMultiplier;
+        element.compDelay = pkt_msg.comp_delay() * timeMultiplier;
 
         // Repeated field robDepList
-        element->robDep.clear();
+        element.robDep.clear();
         for (int i = 0; i < (pkt_msg.rob_dep()).size(); i++) {
-            element->robDep.push_back(pkt_msg.rob_dep(i));
+            element.robDep.push_back(pkt_msg.rob_dep(i));
         }
 
         // Repeated field
-        element->regDep.clear();
+        element.regDep.clear();
         for (int i = 0; i < (pkt_msg.reg_dep()).size(); i++) {
             // There is a possibility that an instruction has both, a register
             // and order dependency on an instruction. In such a case, the
             // register dependency is omitted
             bool duplicate = false;
-            for (auto &dep: element->robDep) {
+            for (auto &dep: element.robDep) {
                 duplicate |= (pkt_msg.reg_dep(i) == dep);
             }
             if (!duplicate)
-                element->regDep.push_back(pkt_msg.reg_dep(i));
+                element.regDep.push_back(pkt_msg.reg_dep(i));
         }
 
         // Optional fields
         if (pkt_msg.has_p_addr())
-            element->physAddr = pkt_msg.p_addr();
+            element.physAddr = pkt_msg.p_addr();
         else
-            element->physAddr = 0;
+            element.physAddr = 0;
 
         if (pkt_msg.has_v_addr())
-            element->virtAddr = pkt_msg.v_addr();
+            element.virtAddr = pkt_msg.v_addr();
         else
-            element->virtAddr = 0;
+            element.virtAddr = 0;
 
         if (pkt_msg.has_size())
-            element->size = pkt_msg.size();
+            element.size = pkt_msg.size();
         else
-            element->size = 0;
+            element.size = 0;
 
         if (pkt_msg.has_flags())
-            element->flags = pkt_msg.flags();
+            element.flags = pkt_msg.flags();
         else
-            element->flags = 0;
+            element.flags = 0;
 
         if (pkt_msg.has_pc())
-            element->pc = pkt_msg.pc();
+            element.pc = pkt_msg.pc();
         else
-            element->pc = 0;
+            element.pc = 0;
 
         // ROB occupancy number
-        ++microOpCount;
+        ++decodedOpCount;
         if (pkt_msg.has_weight()) {
-            microOpCount += pkt_msg.weight();
+            decodedOpCount += pkt_msg.weight();
         }
-        element->robNum = microOpCount;
+        element.robNum = decodedOpCount;
         return true;
     }
 
@@ -1366,8 +1388,11 @@ TraceCPU::ElasticDataGen::GraphNode::typeToStr() const
     return Record::RecordType_Name(type);
 }
 
-TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceCPU::FixedRetryGen::InputStream::InputStream(
+        const std::string& filename, const TraceCPUParams &params) :
+    trace(filename),
+    reader([this](TraceElement& element) { return decode(element); },
+           params.decodeBatchSize, params.decodeQueueDepth)
 {
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
@@ -1379,25 +1404,35 @@ TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
                   header_msg.tick_freq());
         }
     }
+
+    reader.start();
 }
 
 void
 TraceCPU::FixedRetryGen::InputStream::reset()
 {
+    reader.stop();
     trace.reset();
+    reader.start();
 }
 
 bool
 TraceCPU::FixedRetryGen::InputStream::read(TraceElement* element)
+{
+    return reader.read(*element);
+}
+
+bool
+TraceCPU::FixedRetryGen::InputStream::decode(TraceElement& element)
 {
     ProtoMessage::Packet pkt_msg;
     if (trace.read(pkt_msg)) {
-        element->cmd = pkt_msg.cmd();
-        element->addr = pkt_msg.addr();
-        element->blocksize = pkt_msg.size();
-        element->tick = pkt_msg.tick();
-        element->flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
-        element->pc = pkt_msg.has_pc() ? pkt_msg.pc() : 0;
+        element.cmd = pkt_msg.cmd();
+        element.addr = pkt_msg.addr();
+        element.blocksize = pkt_msg.size();
+        element.tick = pkt_msg.tick();
+        element.flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
+        element.pc = pkt_msg.has_pc() ? pkt_msg.pc() : 0;
         return true;
     }
 
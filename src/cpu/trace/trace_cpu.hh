@@ -45,6 +45,7 @@
 #include <unordered_map>
 
 #include "arch/registers.hh"
+#include "base/batched_reader.hh"
 #include "base/statistics.hh"
 #include "cpu/base.hh"
 #include "debug/TraceCPUData.hh"
@@ -375,13 +376,26 @@ class TraceCPU : public BaseCPU
             // Input file stream for the protobuf trace
             ProtoInputStream trace;
 
+            /** Decoder of the messages read from the trace */
+            BatchedReader<TraceElement> reader;
+
+            /**
+             * Decode the next message of the trace, called by the reader.
+             *
+             * @param element Trace element to populate
+             * @return True if an element could be read successfully
+             */
+            bool decode(TraceElement& element);
+
           public:
             /**
              * Create a trace input stream for a given file name.
              *
              * @param filename Path to the file to read from
+             * @param params TraceCPU parameters setting up trace decoding
              */
-            InputStream(const std::string& filename);
+            InputStream(const std::string& filename,
+                        const TraceCPUParams &params);
 
             /**
              * Reset the stream such that it can be played once
@@ -404,11 +418,12 @@ class TraceCPU : public BaseCPU
         /* Constructor */
         FixedRetryGen(TraceCPU& _owner, const std::string& _name,
                    RequestPort& _port, RequestorID requestor_id,
-                   const std::string& trace_file) :
+                   const std::string& trace_file,
+                   const TraceCPUParams &params) :
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file),
+            trace(trace_file, params),
             genName(owner.name() + ".fixedretry." + _name),
             retryPkt(nullptr),
             delta(0),
@@ -773,21 +788,40 @@ class TraceCPU : public BaseCPU
             /** Count of committed ops read from trace plus the filtered ops */
             uint64_t microOpCount;
 
+            /**
+             * Count of ops decoded so far, which runs ahead of microOpCount
+             * when the trace is decoded in the background.
+             */
+            uint64_t decodedOpCount;
+
             /**
              * The window size that is read from the header of the protobuf
              * trace and used to process the dependency trace
              */
             uint32_t windowSize;
 
+            /** Decoder of the records read from the trace */
+            BatchedReader<GraphNode> reader;
+
+            /**
+             * Decode the next record of the trace, called by the reader.
+             *
+             * @param element Graph node to populate
+             * @return True if an element could be read successfully
+             */
+            bool decode(GraphNode& element);
+
           public:
             /**
              * Create a trace input stream for a given file name.
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param params TraceCPU parameters setting up trace decoding
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier,
+                        const TraceCPUParams &params);
 
             /**
              * Reset the stream such that it can be played once
@@ -822,7 +856,7 @@ class TraceCPU : public BaseCPU
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file, 1.0 / params.freqMultiplier),
+            trace(trace_file, 1.0 / params.freqMultiplier, params),
             genName(owner.name() + ".elastic." + _name),
             retryPkt(nullptr),
             traceComplete(false),
@@ -90,6 +90,14 @@ class DmaDevice(PioDevice):
         "Substream identifier used by an IOMMU to distinguish amongst "
         "several devices attached to it")
 
+    dma_non_coherent = Param.Bool(False,
+        "The DMA port reaches memory without passing through any coherent "
+        "cache, so transfers may use bursts larger than a cache line and "
+        "atomic mode may access memory through backdoors")
+    dma_burst_size = Param.MemorySize('256B',
+        "Size and alignment of DMA bursts on a non-coherent path, "
+        "typically the memory controller's access granularity")
+
     def addIommuProperty(self, state, node):
         """
         This method takes an FdtState and a FdtNode as parameters, and
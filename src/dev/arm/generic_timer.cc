@@ -63,7 +63,8 @@ SystemCounter::SystemCounter(const SystemCounterParams &p)
       _activeFreqEntry(0),
       _updateTick(0),
       _freqUpdateEvent([this]{ freqUpdateCallback(); }, name()),
-      _nextFreqEntry(0)
+      _nextFreqEntry(0),
+      _timerEvent([this]{ timerCallback(); }, name() + ".timerEvent")
 {
     fatal_if(_freqTable.empty(), "SystemCounter::SystemCounter: Base "
         "frequency not provided\n");
@@ -204,6 +205,56 @@ SystemCounter::notifyListeners() const
         listener->notify();
 }
 
+void
+SystemCounter::scheduleTimer(ArchTimer &timer, Tick when)
+{
+    descheduleTimer(timer);
+
+    timer._timerEntry = _timers.emplace(when, &timer);
+    timer._timerScheduled = true;
+
+    if (!_timerEvent.scheduled() || when < _timerEvent.when())
+        reschedule(_timerEvent, when, true);
+}
+
+void
+SystemCounter::descheduleTimer(ArchTimer &timer)
+{
+    if (!timer._timerScheduled)
+        return;
+
+    const bool was_first = timer._timerEntry == _timers.begin();
+    _timers.erase(timer._timerEntry);
+    timer._timerScheduled = false;
+
+    // Only the earliest compare event has the shared event scheduled
+    // for it. The event isn't scheduled while it is being serviced,
+    // timerCallback() takes care of it then.
+    if (was_first && _timerEvent.scheduled()) {
+        if (_timers.empty())
+            deschedule(_timerEvent);
+        else
+            reschedule(_timerEvent, _timers.begin()->first);
+    }
+}
+
+void
+SystemCounter::timerCallback()
+{
+    while (!_timers.empty() && _timers.begin()->first <= curTick()) {
+        ArchTimer &timer = *_timers.begin()->second;
+        _timers.erase(_timers.begin());
+        timer._timerScheduled = false;
+        timer.counterLimitReached();
+    }
+
+    // Raising an interrupt may have reprogrammed some timers already.
+    if (!_timers.empty())
+        reschedule(_timerEvent, _timers.begin()->first, true);
+    else if (_timerEvent.scheduled())
+        deschedule(_timerEvent);
+}
+
 void
 SystemCounter::serialize(CheckpointOut &cp) const
 {
@@ -254,7 +305,7 @@ ArchTimer::ArchTimer(const std::string &name,
     : _name(name), _parent(parent), _systemCounter(sysctr),
       _interrupt(interrupt),
       _control(0), _counterLimit(0), _offset(0),
-      _counterLimitReachedEvent([this]{ counterLimitReached(); }, name)
+      _timerScheduled(false)
 {
     _systemCounter.registerListener(this);
 }
@@ -280,8 +331,7 @@ ArchTimer::counterLimitReached()
 void
 ArchTimer::updateCounter()
 {
-    if (_counterLimitReachedEvent.scheduled())
-        _parent.deschedule(_counterLimitReachedEvent);
+    _systemCounter.descheduleTimer(*this);
     if (value() >= _counterLimit) {
         counterLimitReached();
     } else {
@@ -294,8 +344,7 @@ ArchTimer::updateCounter()
         _control.istatus = 0;
 
         if (scheduleEvents()) {
-            _parent.schedule(_counterLimitReachedEvent,
-                             whenValue(_counterLimit));
+            _systemCounter.scheduleTimer(*this, whenValue(_counterLimit));
         }
     }
 }
@@ -385,8 +434,7 @@ ArchTimer::unserialize(CheckpointIn &cp)
 DrainState
 ArchTimer::drain()
 {
-    if (_counterLimitReachedEvent.scheduled())
-        _parent.deschedule(_counterLimitReachedEvent);
+    _systemCounter.descheduleTimer(*this);
 
     return DrainState::Drained;
 }
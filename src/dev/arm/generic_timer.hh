@@ -39,6 +39,7 @@
 #define __DEV_ARM_GENERIC_TIMER_HH__
 
 #include <cstdint>
+#include <map>
 #include <vector>
 
 #include "arch/arm/isa_device.hh"
@@ -63,6 +64,7 @@
 ///     G6.2  - The AArch32 view of the Generic Timer
 ///     I2 - System Level Implementation of the Generic Timer
 
+class ArchTimer;
 class Checkpoint;
 struct SystemCounterParams;
 struct GenericTimerParams;
@@ -109,6 +111,9 @@ class SystemCounter : public SimObject
     static constexpr size_t MAX_FREQ_ENTRIES = 1004;
 
   public:
+    /// Pending compare events of the timers using this counter, by tick
+    typedef std::multimap<Tick, ArchTimer *> TimerQueue;
+
     SystemCounter(const SystemCounterParams &p);
 
     /// Validates a System Counter reference
@@ -150,6 +155,15 @@ class SystemCounter : public SimObject
     Tick whenValue(uint64_t target_val);
     Tick whenValue(uint64_t cur_val, uint64_t target_val) const;
 
+    /// Schedules the compare event of a timer. The events of all the
+    /// timers are served by a single event at the earliest deadline, so
+    /// reprogramming a timer which isn't the next one to fire doesn't
+    /// touch the event queue, and timers firing together are handled at
+    /// once.
+    void scheduleTimer(ArchTimer &timer, Tick when);
+    /// Cancels the compare event of a timer, if there is one
+    void descheduleTimer(ArchTimer &timer);
+
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 
@@ -163,6 +177,12 @@ class SystemCounter : public SimObject
     /// Callback for the frequency update
     void freqUpdateCallback();
 
+    /// Pending timer compare events and the event serving them
+    TimerQueue _timers;
+    EventFunctionWrapper _timerEvent;
+    /// Fires the timers whose compare event is due
+    void timerCallback();
+
     /// Updates the counter value.
     void updateValue(void);
 
@@ -210,7 +230,11 @@ class ArchTimer : public SystemCounterListener, public Drainable,
 
     /// Called when the upcounter reaches the programmed value.
     void counterLimitReached();
-    EventFunctionWrapper _counterLimitReachedEvent;
+
+    friend class SystemCounter;
+    /// Entry of the compare event in the system counter's timer queue
+    SystemCounter::TimerQueue::iterator _timerEntry;
+    bool _timerScheduled;
 
     virtual bool scheduleEvents() { return true; }
 
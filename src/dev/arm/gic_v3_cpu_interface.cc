@@ -2023,7 +2023,7 @@ Gicv3CPUInterface::highestActiveGroup() const
 void
 Gicv3CPUInterface::updateDistributor()
 {
-    distributor->update();
+    distributor->update(redistributor);
 }
 
 void
@@ -42,6 +42,7 @@
 
 #include <algorithm>
 
+#include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "debug/GIC.hh"
 #include "dev/arm/gic_v3.hh"
@@ -81,6 +82,7 @@ Gicv3Distributor::Gicv3Distributor(Gicv3 * gic, uint32_t it_lines)
       irqGrpmod(it_lines, 0),
       irqNsacr(it_lines, 0),
       irqAffinityRouting(it_lines, 0),
+      irqReady(divCeil(it_lines, 64), 0),
       gicdTyper(0),
       gicdPidr0(0x92),
       gicdPidr1(0xb4),
@@ -554,6 +556,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
                 }
 
                 irqEnabled[int_id] = true;
+                updateReady(int_id);
             }
         }
 
@@ -583,6 +586,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
                 }
 
                 irqEnabled[int_id] = false;
+                updateReady(int_id);
             }
         }
 
@@ -613,6 +617,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
                         "int_id %d (SPI) pending bit set\n", int_id);
                 irqPending[int_id] = true;
                 irqPendingIspendr[int_id] = true;
+                updateReady(int_id);
             }
         }
 
@@ -641,6 +646,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
 
             if (clear && treatAsEdgeTriggered(int_id)) {
                 irqPending[int_id] = false;
+                updateReady(int_id);
                 clearIrqCpuInterface(int_id);
             }
         }
@@ -667,6 +673,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
 
             if (active) {
                 irqActive[int_id] = 1;
+                updateReady(int_id);
             }
         }
 
@@ -696,6 +703,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
                 }
 
                 irqActive[int_id] = false;
+                updateReady(int_id);
             }
         }
 
@@ -1006,9 +1014,11 @@ Gicv3Distributor::sendInt(uint32_t int_id)
     panic_if(int_id > itLines, "Invalid SPI!");
     irqPending[int_id] = true;
     irqPendingIspendr[int_id] = false;
+    updateReady(int_id);
     DPRINTF(GIC, "Gicv3Distributor::sendInt(): "
             "int_id %d (SPI) pending bit set\n", int_id);
-    update();
+    // Only the CPU interface the SPI wins can be affected.
+    update(nullptr);
 }
 
 void
@@ -1027,9 +1037,15 @@ Gicv3Distributor::deassertSPI(uint32_t int_id)
     panic_if(int_id < Gicv3::SGI_MAX + Gicv3::PPI_MAX, "Invalid SPI!");
     panic_if(int_id > itLines, "Invalid SPI!");
     irqPending[int_id] = false;
-    clearIrqCpuInterface(int_id);
+    updateReady(int_id);
 
-    update();
+    auto cpu_interface = route(int_id);
+    if (cpu_interface) {
+        cpu_interface->resetHppi(int_id);
+        update(cpu_interface->redistributor);
+    } else {
+        update(nullptr);
+    }
 }
 
 Gicv3CPUInterface*
@@ -1077,17 +1093,25 @@ Gicv3Distributor::clearIrqCpuInterface(uint32_t int_id)
         cpu_interface->resetHppi(int_id);
 }
 
+/*
+ * Fold the pending SPIs into the highest priority pending interrupt of
+ * the CPU interfaces they are routed to, recording in hppiChanged the
+ * interfaces whose hppi changed.
+ */
 void
-Gicv3Distributor::update()
+Gicv3Distributor::updateSPIs()
 {
-    // Find the highest priority pending SPI
-    for (int int_id = Gicv3::SGI_MAX + Gicv3::PPI_MAX; int_id < itLines;
-         int_id++) {
-        Gicv3::GroupId int_group = getIntGroup(int_id);
-        bool group_enabled = groupEnabled(int_group);
+    hppiChanged.clear();
 
-        if (irqPending[int_id] && irqEnabled[int_id] &&
-            !irqActive[int_id] && group_enabled) {
+    // Find the highest priority pending SPI. Only the words of the ready
+    // bitmap with bits set need to be looked at.
+    for (int word = 0; word < irqReady.size(); word++) {
+        for (uint64_t ready = irqReady[word]; ready; ready &= ready - 1) {
+            const int int_id = word * 64 + ctz64(ready);
+            Gicv3::GroupId int_group = getIntGroup(int_id);
+
+            if (!groupEnabled(int_group))
+                continue;
 
             // Find the cpu interface where to route the interrupt
             Gicv3CPUInterface *target_cpu_interface = route(int_id);
@@ -1102,9 +1126,20 @@ Gicv3Distributor::update()
                 target_cpu_interface->hppi.intid = int_id;
                 target_cpu_interface->hppi.prio = irqPriority[int_id];
                 target_cpu_interface->hppi.group = int_group;
+
+                if (std::find(hppiChanged.begin(), hppiChanged.end(),
+                              target_cpu_interface) == hppiChanged.end()) {
+                    hppiChanged.push_back(target_cpu_interface);
+                }
             }
         }
     }
+}
+
+void
+Gicv3Distributor::update()
+{
+    updateSPIs();
 
     // Update all redistributors
     for (int i = 0; i < gic->getSystem()->threads.size(); i++) {
@@ -1112,6 +1147,26 @@ Gicv3Distributor::update()
     }
 }
 
+/*
+ * Cheaper alternative to update() for changes which can only affect
+ * the given redistributor (if any) and the CPU interfaces SPIs are
+ * routed to. Changes to the group enables or to routing must use
+ * update() instead.
+ */
+void
+Gicv3Distributor::update(Gicv3Redistributor *target)
+{
+    updateSPIs();
+
+    if (target)
+        target->update();
+
+    for (auto *cpu_interface : hppiChanged) {
+        if (cpu_interface->redistributor != target)
+            cpu_interface->redistributor->update();
+    }
+}
+
 Gicv3::IntStatus
 Gicv3Distributor::intStatus(uint32_t int_id) const
 {
@@ -1165,12 +1220,14 @@ Gicv3Distributor::activateIRQ(uint32_t int_id)
         irqPending[int_id] = false;
     }
     irqActive[int_id] = true;
+    updateReady(int_id);
 }
 
 void
 Gicv3Distributor::deactivateIRQ(uint32_t int_id)
 {
     irqActive[int_id] = false;
+    updateReady(int_id);
 }
 
 void
@@ -1211,4 +1268,7 @@ Gicv3Distributor::unserialize(CheckpointIn & cp)
     UNSERIALIZE_CONTAINER(irqGrpmod);
     UNSERIALIZE_CONTAINER(irqNsacr);
     UNSERIALIZE_CONTAINER(irqAffinityRouting);
+
+    for (int int_id = 0; int_id < itLines; int_id++)
+        updateReady(int_id);
 }
@@ -161,6 +161,17 @@ class Gicv3Distributor : public Serializable
     std::vector <uint8_t> irqNsacr;
     std::vector <IROUTER> irqAffinityRouting;
 
+    /**
+     * Bitmap of the SPIs which are pending, enabled and not active,
+     * i.e. the only ones update() has to consider. It is derived from
+     * irqPending, irqEnabled and irqActive, which must be followed by a
+     * call to updateReady() whenever they change.
+     */
+    std::vector <uint64_t> irqReady;
+
+    /** CPU interfaces whose hppi the last SPI scan changed */
+    std::vector <Gicv3CPUInterface *> hppiChanged;
+
     uint32_t gicdTyper;
     uint32_t gicdPidr0;
     uint32_t gicdPidr1;
@@ -251,9 +262,22 @@ class Gicv3Distributor : public Serializable
         return !DS && !is_secure_access && getIntGroup(int_id) != Gicv3::G1NS;
     }
 
+    void
+    updateReady(uint32_t int_id)
+    {
+        const uint64_t mask = 1ULL << (int_id % 64);
+        if (irqPending[int_id] && irqEnabled[int_id] && !irqActive[int_id])
+            irqReady[int_id / 64] |= mask;
+        else
+            irqReady[int_id / 64] &= ~mask;
+    }
+
+    void updateSPIs();
+
     void serialize(CheckpointOut & cp) const override;
     void unserialize(CheckpointIn & cp) override;
     void update();
+    void update(Gicv3Redistributor *target);
     Gicv3CPUInterface* route(uint32_t int_id);
 
   public:
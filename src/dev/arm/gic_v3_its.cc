@@ -93,7 +93,7 @@ ItsProcess::doRead(Yield &yield, Addr addr, void *ptr, size_t size)
     ItsAction a;
     a.type = ItsActionType::SEND_REQ;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, 0, its.requestorId);
 
     req->taskId(ContextSwitchTaskId::DMA);
@@ -117,7 +117,7 @@ ItsProcess::doWrite(Yield &yield, Addr addr, void *ptr, size_t size)
     ItsAction a;
     a.type = ItsActionType::SEND_REQ;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, 0, its.requestorId);
 
     req->taskId(ContextSwitchTaskId::DMA);
@@ -431,11 +431,12 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
         if (!pe_was_low_power && peInLowPowerState) {
             DPRINTF(GIC, "Gicv3Redistributor::write(): "
                     "PE entering in low power state\n");
-            updateDistributor();
+            // This changes where 1 of N SPIs can be routed to.
+            distributor->update();
         } else if (pe_was_low_power && !peInLowPowerState) {
             DPRINTF(GIC, "Gicv3Redistributor::write(): powering up PE\n");
             cpuInterface->deassertWakeRequest();
-            updateDistributor();
+            distributor->update();
         }
         break;
       }
@@ -790,7 +791,7 @@ Gicv3Redistributor::intStatus(uint32_t int_id) const
 void
 Gicv3Redistributor::updateDistributor()
 {
-    distributor->update();
+    distributor->update(this);
 }
 
 /*
@@ -78,7 +78,7 @@ SMMUProcess::doRead(Yield &yield, Addr addr, void *ptr, size_t size)
     SMMUAction a;
     a.type = ACTION_SEND_REQ;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, 0, smmu.requestorId);
 
     req->taskId(ContextSwitchTaskId::DMA);
@@ -111,7 +111,7 @@ SMMUProcess::doWrite(Yield &yield, Addr addr, const void *ptr, size_t size)
     SMMUAction a;
     a.type = ACTION_SEND_REQ;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, 0, smmu.requestorId);
 
     req->taskId(ContextSwitchTaskId::DMA);
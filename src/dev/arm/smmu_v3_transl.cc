@@ -87,7 +87,9 @@ SMMUTranslationProcess::SMMUTranslationProcess(const std::string &name,
     ifc.xlateSlotsRemaining--;
 
     ifc.pendingMemAccesses++;
-    reinit();
+
+    // The coroutine is created by beginTransaction(), which every user
+    // calls right away.
 }
 
 SMMUTranslationProcess::~SMMUTranslationProcess()
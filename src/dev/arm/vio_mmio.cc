@@ -50,7 +50,9 @@ MmioVirtIO::MmioVirtIO(const MmioVirtIOParams &params)
 {
     fatal_if(!interrupt, "No MMIO VirtIO interrupt specified\n");
 
-    vio.registerKickCallback([this]() { kick(); });
+    vio.registerKickCallback([this](VirtIODeviceBase::QueueID queue) {
+        kick(queue);
+    });
 }
 
 MmioVirtIO::~MmioVirtIO()
@@ -255,9 +257,10 @@ MmioVirtIO::write(Addr offset, uint32_t value)
 }
 
 void
-MmioVirtIO::kick()
+MmioVirtIO::kick(VirtIODeviceBase::QueueID queue)
 {
-    DPRINTF(VIOIface, "kick(): Sending interrupt...\n");
+    // There is only one interrupt, shared by all queues.
+    DPRINTF(VIOIface, "kick(%i): Sending interrupt...\n", queue);
     setInterrupts(interruptStatus | INT_USED_RING);
 }
 
@@ -45,6 +45,7 @@
 #include <cstring>
 #include <utility>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/DMA.hh"
@@ -53,12 +54,21 @@
 #include "sim/system.hh"
 
 DmaPort::DmaPort(ClockedObject *dev, System *s,
-                 uint32_t sid, uint32_t ssid)
+                 uint32_t sid, uint32_t ssid, bool non_coherent,
+                 Addr burst_size)
     : RequestPort(dev->name() + ".dma", dev),
       device(dev), sys(s), requestorId(s->getRequestorId(dev)),
       sendEvent([this]{ sendDma(); }, dev->name()),
-      defaultSid(sid), defaultSSid(ssid), cacheLineSize(s->cacheLineSize())
-{ }
+      defaultSid(sid), defaultSSid(ssid), cacheLineSize(s->cacheLineSize()),
+      nonCoherent(non_coherent),
+      chunkSize(non_coherent ? burst_size : cacheLineSize)
+{
+    fatal_if(nonCoherent && (!isPowerOf2(burst_size) ||
+                             burst_size < (Addr)cacheLineSize),
+             "%s: DMA burst size (%d) must be a power of two no smaller "
+             "than the cache line size (%d).", name(), burst_size,
+             cacheLineSize);
+}
 
 void
 DmaPort::handleRespPacket(PacketPtr pkt, Tick delay)
@@ -110,7 +120,7 @@ DmaPort::handleResp(DmaReqState *state, Addr addr, Addr size, Tick delay)
 PacketPtr
 DmaPort::DmaReqState::createPacket()
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
             gen.addr(), gen.size(), flags, id);
     req->setStreamId(sid);
     req->setSubstreamId(ssid);
@@ -138,7 +148,8 @@ DmaPort::recvTimingResp(PacketPtr pkt)
 }
 
 DmaDevice::DmaDevice(const Params &p)
-    : PioDevice(p), dmaPort(this, sys, p.sid, p.ssid)
+    : PioDevice(p), dmaPort(this, sys, p.sid, p.ssid,
+                            p.dma_non_coherent, p.dma_burst_size)
 { }
 
 void
@@ -177,9 +188,9 @@ DmaPort::dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
 
     // One DMA request sender state for every action, that is then
     // split into many requests and packets based on the block size,
-    // i.e. cache line size.
+    // i.e. cache line size, or the burst size on a non-coherent path.
     transmitList.push_back(
-            new DmaReqState(cmd, addr, cacheLineSize, size,
+            new DmaReqState(cmd, addr, chunkSize, size,
                 data, flag, requestorId, sid, ssid, event, delay));
     pendingCount++;
 
@@ -340,7 +351,9 @@ DmaPort::sendDma()
 
         trySendTimingReq();
     } else if (sys->isAtomicMode()) {
-        const bool bypass = sys->bypassCaches();
+        // Without coherent caches on the path, memory always holds the
+        // current data and can be accessed directly.
+        const bool bypass = sys->bypassCaches() || nonCoherent;
 
         // Send everything there is to send in zero time.
         while (!transmitList.empty()) {
@@ -174,6 +174,17 @@ class DmaPort : public RequestPort, public Drainable
 
     const int cacheLineSize;
 
+    /**
+     * True if this port reaches memory without passing through any
+     * coherent cache. Transfers are then split into bursts of
+     * chunkSize rather than cache lines, and atomic mode accesses
+     * memory through backdoors.
+     */
+    const bool nonCoherent;
+
+    /** Size and alignment of the packets a transfer is split into. */
+    const Addr chunkSize;
+
   protected:
 
     bool recvTimingResp(PacketPtr pkt) override;
@@ -181,7 +192,8 @@ class DmaPort : public RequestPort, public Drainable
 
   public:
 
-    DmaPort(ClockedObject *dev, System *s, uint32_t sid=0, uint32_t ssid=0);
+    DmaPort(ClockedObject *dev, System *s, uint32_t sid=0, uint32_t ssid=0,
+            bool non_coherent=false, Addr burst_size=0);
 
     void
     dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
@@ -63,6 +63,8 @@ class EtherLink(SimObject):
     speed = Param.NetworkBandwidth('1Gbps', "link speed")
     dump = Param.EtherDump(NULL, "dump object")
 
+class DistTransport(ScopedEnum): vals = ['tcp', 'shm']
+
 class DistEtherLink(SimObject):
     type = 'DistEtherLink'
     cxx_header = "dev/net/dist_etherlink.hh"
@@ -77,8 +79,14 @@ class DistEtherLink(SimObject):
     sync_repeat = Param.Latency('10us', "dist sync barrier repeat")
     server_name = Param.String('localhost', "Message server name")
     server_port = Param.UInt32('2200', "Message server port")
+    transport = Param.DistTransport('tcp', "How the gem5 processes talk "
+        "to each other, shm only works if they all run on the same host")
+    shm_ring_size = Param.MemorySize('1MiB', "Size of the shared memory "
+        "ring in each direction of the link (shm transport)")
     is_switch = Param.Bool(False, "true if this a link in etherswitch")
     dist_sync_on_pseudo_op = Param.Bool(False, "Start sync with pseudo_op")
+    dist_sync_skip_idle = Param.Bool(False, "Skip the periodic syncs while "
+        "no gem5 peer has anything to do (set on the switch)")
     num_nodes = Param.UInt32('2', "Number of simulate nodes")
 
 class EtherBus(SimObject):
@@ -41,6 +41,7 @@
 
 #include "dev/net/dist_iface.hh"
 
+#include <algorithm>
 #include <queue>
 #include <thread>
 
@@ -80,6 +81,27 @@ DistIface::Sync::init(Tick start_tick, Tick repeat_tick)
     }
 }
 
+Tick
+DistIface::Sync::localNextEvent()
+{
+    // The other queues can't be looked at safely from here, so don't let
+    // the sync be skipped at all
+    if (numMainEventQueues > 1) {
+        minArrival = MaxTick;
+        return curTick();
+    }
+
+    // The receiver threads may be adding events to the queue
+    EventQueue *eventq = curEventQueue();
+    eventq->lock();
+    Tick next = eventq->empty() ? MaxTick : eventq->nextTick();
+    eventq->unlock();
+
+    next = std::min(next, minArrival);
+    minArrival = MaxTick;
+    return next;
+}
+
 void
 DistIface::Sync::abort()
 {
@@ -90,9 +112,11 @@ DistIface::Sync::abort()
     cv.notify_one();
 }
 
-DistIface::SyncSwitch::SyncSwitch(int num_nodes)
+DistIface::SyncSwitch::SyncSwitch(int num_nodes, bool skip_idle)
 {
     numNodes = num_nodes;
+    skipIdle = skip_idle;
+    minNodeEvent = MaxTick;
     waitNum = num_nodes;
     numExitReq = 0;
     numCkptReq = 0;
@@ -102,6 +126,8 @@ DistIface::SyncSwitch::SyncSwitch(int num_nodes)
     doStopSync = false;
     nextAt = std::numeric_limits<Tick>::max();
     nextRepeat = std::numeric_limits<Tick>::max();
+    nextEventAt = 0;
+    minArrival = MaxTick;
     isAbort = false;
 }
 
@@ -116,12 +142,17 @@ DistIface::SyncNode::SyncNode()
     doStopSync = false;
     nextAt = std::numeric_limits<Tick>::max();
     nextRepeat = std::numeric_limits<Tick>::max();
+    nextEventAt = 0;
+    minArrival = MaxTick;
     isAbort = false;
 }
 
 bool
 DistIface::SyncNode::run(bool same_tick)
 {
+    // The switch decides whether this is used
+    const Tick next_event = localNextEvent();
+
     std::unique_lock<std::mutex> sync_lock(lock);
     Header header;
 
@@ -131,6 +162,7 @@ DistIface::SyncNode::run(bool same_tick)
     // initiate the global synchronisation
     header.msgType = MsgType::cmdSyncReq;
     header.sendTick = curTick();
+    header.nextEventTick = next_event;
     header.syncRepeat = nextRepeat;
     header.needCkpt = needCkpt;
     header.needStopSync = needStopSync;
@@ -166,9 +198,16 @@ DistIface::SyncSwitch::run(bool same_tick)
         return false;
     assert(!same_tick || (nextAt == curTick()));
     waitNum = numNodes;
+    // All the packets the nodes sent before their sync requests have
+    // been received by now, so they are accounted for by our own next
+    // event.
+    if (skipIdle)
+        nextEventAt = std::min(minNodeEvent, localNextEvent());
+    minNodeEvent = MaxTick;
     // Complete the global synchronisation
     header.msgType = MsgType::cmdSyncAck;
     header.sendTick = nextAt;
+    header.nextEventTick = nextEventAt;
     header.syncRepeat = nextRepeat;
     if (doCkpt || numCkptReq == numNodes) {
         doCkpt = true;
@@ -197,6 +236,7 @@ DistIface::SyncSwitch::run(bool same_tick)
 bool
 DistIface::SyncSwitch::progress(Tick send_tick,
                                  Tick sync_repeat,
+                                 Tick next_event,
                                  ReqType need_ckpt,
                                  ReqType need_exit,
                                  ReqType need_stop_sync)
@@ -210,6 +250,8 @@ DistIface::SyncSwitch::progress(Tick send_tick,
         nextAt = send_tick;
     if (nextRepeat > sync_repeat)
         nextRepeat = sync_repeat;
+    if (minNodeEvent > next_event)
+        minNodeEvent = next_event;
 
     if (need_ckpt == ReqType::collective)
         numCkptReq++;
@@ -238,6 +280,7 @@ DistIface::SyncSwitch::progress(Tick send_tick,
 bool
 DistIface::SyncNode::progress(Tick max_send_tick,
                                Tick next_repeat,
+                               Tick next_event,
                                ReqType do_ckpt,
                                ReqType do_exit,
                                ReqType do_stop_sync)
@@ -249,6 +292,7 @@ DistIface::SyncNode::progress(Tick max_send_tick,
 
     nextAt = max_send_tick;
     nextRepeat = next_repeat;
+    nextEventAt = next_event;
     doCkpt = (do_ckpt != ReqType::none);
     doExit = (do_exit != ReqType::none);
     doStopSync = (do_stop_sync != ReqType::none);
@@ -421,7 +465,18 @@ DistIface::SyncEvent::process()
     }
     // schedule the next periodic sync
     repeat = DistIface::sync->nextRepeat;
-    schedule(curTick() + repeat);
+    Tick next = curTick() + repeat;
+    // If nobody does anything before nextEventAt, a packet can't be sent
+    // before then either, so the current quantum can be stretched until a
+    // repeat interval after it. A packet sent right at nextEventAt must
+    // still arrive in the next quantum, hence the one tick less.
+    const Tick idle_until = DistIface::sync->nextEventAt;
+    if (idle_until < MaxTick - repeat && idle_until + repeat - 1 > next) {
+        DPRINTF(DistEthernet, "Skipping the dist syncs up to %lu\n",
+                idle_until);
+        next = idle_until + repeat - 1;
+    }
+    schedule(next);
 }
 
 void
@@ -604,7 +659,8 @@ DistIface::DistIface(unsigned dist_rank,
                      Tick sync_repeat,
                      EventManager *em,
                      bool use_pseudo_op,
-                     bool is_switch, int num_nodes) :
+                     bool is_switch, int num_nodes,
+                     bool sync_skip_idle) :
     syncStart(sync_start), syncRepeat(sync_repeat),
     recvThread(nullptr), recvScheduler(em), syncStartOnPseudoOp(use_pseudo_op),
     rank(dist_rank), size(dist_size)
@@ -616,7 +672,7 @@ DistIface::DistIface(unsigned dist_rank,
         assert(syncEvent == nullptr);
         isSwitch = is_switch;
         if (is_switch)
-            sync = new SyncSwitch(num_nodes);
+            sync = new SyncSwitch(num_nodes, sync_skip_idle);
         else
             sync = new SyncNode();
         syncEvent = new SyncEvent();
@@ -656,6 +712,11 @@ DistIface::packetOut(EthPacketPtr pkt, Tick send_delay)
     header.dataPacketLength = pkt->length;
     header.simLength = pkt->simLength;
 
+    // The switch needs the receive tick to tell whether the peers are
+    // idle. The sync interval is no longer than any link delay.
+    sync->minArrival = std::min(sync->minArrival,
+                                curTick() + send_delay + sync->nextRepeat);
+
     // Send out the packet and the meta info.
     sendPacket(header, pkt);
 
@@ -701,6 +762,7 @@ DistIface::recvThreadFunc(Event *recv_done, Tick link_delay)
             // everything else must be synchronisation related command
             if (!sync->progress(header.sendTick,
                                 header.syncRepeat,
+                                header.nextEventTick,
                                 header.needCkpt,
                                 header.needExit,
                                 header.needStopSync))
@@ -151,12 +151,32 @@ class DistIface : public Drainable, public Serializable
          * Tick for the next periodic sync (if the event is not scheduled yet)
          */
         Tick nextAt;
+        /**
+         * The earliest tick any of the gem5 peers may do anything at
+         * after the last completed sync, or 0 if idle periods are not to
+         * be skipped. Nothing can be sent before this tick, so the next
+         * periodic sync is not needed until a repeat interval after it.
+         */
+        Tick nextEventAt;
+        /**
+         * Lower bound of the receive ticks of the packets sent since the
+         * last sync. Only accessed by the simulation thread.
+         */
+        Tick minArrival;
         /**
          *  Flag is set if the sync is aborted (e.g. due to connection lost)
          */
         bool isAbort;
 
         friend class SyncEvent;
+        friend class DistIface;
+
+        /**
+         * The earliest tick this gem5 process may do anything at unless it
+         * receives a packet, i.e. its next event or the arrival of a packet
+         * it has sent. This also starts a new period for minArrival.
+         */
+        Tick localNextEvent();
 
       public:
         /**
@@ -181,6 +201,7 @@ class DistIface : public Drainable, public Serializable
          */
         virtual bool progress(Tick send_tick,
                               Tick next_repeat,
+                              Tick next_event,
                               ReqType do_ckpt,
                               ReqType do_exit,
                               ReqType do_stop_sync) = 0;
@@ -223,6 +244,7 @@ class DistIface : public Drainable, public Serializable
         bool run(bool same_tick) override;
         bool progress(Tick max_req_tick,
                       Tick next_repeat,
+                      Tick next_event,
                       ReqType do_ckpt,
                       ReqType do_exit,
                       ReqType do_stop_sync) override;
@@ -254,14 +276,24 @@ class DistIface : public Drainable, public Serializable
          *  Number of connected simulated nodes
          */
         unsigned numNodes;
+        /**
+         * Skip the periodic syncs while all the gem5 peers are idle
+         */
+        bool skipIdle;
+        /**
+         * The earliest next event tick reported by the nodes in the
+         * ongoing sync
+         */
+        Tick minNodeEvent;
 
       public:
-        SyncSwitch(int num_nodes);
+        SyncSwitch(int num_nodes, bool skip_idle);
         ~SyncSwitch() {}
 
         bool run(bool same_tick) override;
         bool progress(Tick max_req_tick,
                       Tick next_repeat,
+                      Tick next_event,
                       ReqType do_ckpt,
                       ReqType do_exit,
                       ReqType do_stop_sync) override;
@@ -291,6 +323,9 @@ class DistIface : public Drainable, public Serializable
      * for each simulated Ethernet link.
      * 3. Simulation thread(s) then waits until all receiver threads
      * complete the ongoing barrier. The global sync event is done.
+     * 4. The next sync is scheduled a repeat interval later, or a repeat
+     * interval after the earliest next event of all the peers if the
+     * switch skips idle periods (see Sync::nextEventAt).
      */
     class SyncEvent : public GlobalSyncEvent
     {
@@ -570,6 +605,8 @@ class DistIface : public Drainable, public Serializable
      * @param sync_start Start tick for dist synchronisation
      * @param sync_repeat Frequency for dist synchronisation
      * @param em The event manager associated with the simulated Ethernet link
+     * @param sync_skip_idle Skip the periodic syncs while no gem5 peer has
+     * anything to do (only used by the switch)
      */
     DistIface(unsigned dist_rank,
               unsigned dist_size,
@@ -578,7 +615,8 @@ class DistIface : public Drainable, public Serializable
               EventManager *em,
               bool use_pseudo_op,
               bool is_switch,
-              int num_nodes);
+              int num_nodes,
+              bool sync_skip_idle);
 
     virtual ~DistIface();
     /**
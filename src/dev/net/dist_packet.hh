@@ -84,6 +84,12 @@ class DistHeaderPkt
          */
         MsgType msgType;
         Tick sendTick;
+        /**
+         * Used by sync messages: the earliest tick the sender (sync
+         * request) or any of the gem5 peers (sync ack) may do anything
+         * at, see DistIface::Sync::nextEventAt.
+         */
+        Tick nextEventTick;
         /**
          * Length used for modeling timing in the simulator.
          * (from EthPacketData::simLength).
@@ -34,6 +34,72 @@
 #include "base/logging.hh"
 #include "sim/serialize.hh"
 
+namespace
+{
+
+/**
+ * Free packet buffers of the sizes most packets use: frames up to a
+ * standard MTU, and the 16KiB buffers the NIC models transmit from.
+ * The pool is per thread and only holds plain pointers, so it doesn't
+ * need any locking and can't be destroyed while packets still exist.
+ */
+struct BufferPool
+{
+    static const unsigned NumClasses = 2;
+    static const unsigned MaxFree = 128;
+
+    uint8_t *free[NumClasses][MaxFree];
+    unsigned numFree[NumClasses];
+};
+
+const unsigned classSizes[BufferPool::NumClasses] = { 2048, 16384 };
+
+thread_local BufferPool bufferPool;
+
+/** Size class a request falls in, or NumClasses if it is too large. */
+unsigned
+sizeClass(unsigned size)
+{
+    unsigned i = 0;
+    while (i < BufferPool::NumClasses && size > classSizes[i])
+        i++;
+    return i;
+}
+
+} // anonymous namespace
+
+void
+EthPacketData::allocate(unsigned size)
+{
+    assert(!data);
+
+    const unsigned cls = sizeClass(size);
+    if (cls == BufferPool::NumClasses) {
+        data = new uint8_t[size];
+        bufLength = size;
+        return;
+    }
+
+    bufLength = classSizes[cls];
+    if (bufferPool.numFree[cls])
+        data = bufferPool.free[cls][--bufferPool.numFree[cls]];
+    else
+        data = new uint8_t[bufLength];
+}
+
+void
+EthPacketData::release()
+{
+    const unsigned cls = sizeClass(bufLength);
+    if (cls < BufferPool::NumClasses && bufLength == classSizes[cls] &&
+        bufferPool.numFree[cls] < BufferPool::MaxFree) {
+        bufferPool.free[cls][bufferPool.numFree[cls]++] = data;
+    } else {
+        delete [] data;
+    }
+    data = nullptr;
+}
+
 void
 EthPacketData::serialize(const std::string &base, CheckpointOut &cp) const
 {
@@ -62,7 +128,7 @@ EthPacketData::unserialize(const std::string &base, CheckpointIn &cp)
     }
     assert(length <= bufLength);
     if (!data)
-        data = new uint8_t[bufLength];
+        allocate(bufLength);
     arrayParamIn(cp, base + ".data", data, length);
     if (!optParamIn(cp, base + ".simLength", simLength))
         simLength = length;
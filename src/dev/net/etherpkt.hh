@@ -75,13 +75,23 @@ class EthPacketData
     { }
 
     explicit EthPacketData(unsigned size)
-        : data(new uint8_t[size]), bufLength(size), length(0), simLength(0)
-    { }
+        : data(nullptr), bufLength(0), length(0), simLength(0)
+    { allocate(size); }
 
-    ~EthPacketData() { if (data) delete [] data; }
+    ~EthPacketData() { if (data) release(); }
 
     void serialize(const std::string &base, CheckpointOut &cp) const;
     void unserialize(const std::string &base, CheckpointIn &cp);
+
+  private:
+    /**
+     * Allocate a buffer of at least size bytes. Buffers of the common
+     * sizes are recycled through a per-thread pool, so creating a packet
+     * normally doesn't need to allocate memory for the data.
+     */
+    void allocate(unsigned size);
+    /** Return the buffer to the pool, or free it. */
+    void release();
 };
 
 typedef std::shared_ptr<EthPacketData> EthPacketPtr;
@@ -32,6 +32,8 @@
 
 #include "dev/net/etherswitch.hh"
 
+#include <algorithm>
+
 #include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/EthernetAll.hh"
@@ -126,7 +128,7 @@ EtherSwitch::Interface::Interface(const std::string &name,
     : EtherInt(name), ticksPerByte(rate), switchDelay(delay),
       delayVar(delay_var), interfaceId(id), parent(etherSwitch),
       outputFifo(name + ".outputFifo", outputBufferSize),
-      txEvent([this]{ transmit(); }, name)
+      txEvent([this]{ transmit(); }, name), txBlocked(false)
 {
 }
 
@@ -181,9 +183,17 @@ EtherSwitch::Interface::transmit()
 
     if (!sendPacket(outputFifo.front())) {
         DPRINTF(Ethernet, "output port busy...retry later\n");
-        if (!txEvent.scheduled())
-            parent->schedule(txEvent, curTick() + SimClock::Int::ns);
+        // The peer calls sendDone() when it is ready again, which
+        // saves polling it every nanosecond. Still retry eventually
+        // in case it never does.
+        txBlocked = true;
+        if (!txEvent.scheduled()) {
+            parent->schedule(txEvent, curTick() +
+                             std::max<Tick>(SimClock::Int::ns,
+                                            switchingDelay()));
+        }
     } else {
+        txBlocked = false;
         DPRINTF(Ethernet, "packet sent: len=%d\n", outputFifo.front()->length);
         outputFifo.pop();
         // schedule an event to send the pkt at
@@ -194,6 +204,16 @@ EtherSwitch::Interface::transmit()
     }
 }
 
+void
+EtherSwitch::Interface::sendDone()
+{
+    if (!txBlocked)
+        return;
+
+    txBlocked = false;
+    parent->reschedule(txEvent, curTick(), true);
+}
+
 Tick
 EtherSwitch::Interface::switchingDelay()
 {
@@ -33,9 +33,9 @@
 #ifndef __DEV_ETHERSWITCH_HH__
 #define __DEV_ETHERSWITCH_HH__
 
-#include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/inet.hh"
@@ -78,7 +78,11 @@ class EtherSwitch : public SimObject
          * enqueue packet to the outputFifo
          */
         void enqueue(EthPacketPtr packet, unsigned senderId);
-        void sendDone() {}
+        /**
+         * The peer finished receiving a packet, retry a transmission
+         * which found it busy.
+         */
+        void sendDone();
         Tick switchingDelay();
 
         Interface* lookupDestPort(Net::EthAddr destAddr);
@@ -169,6 +173,8 @@ class EtherSwitch : public SimObject
         PortFifo outputFifo;
         void transmit();
         EventFunctionWrapper txEvent;
+        /** The peer was busy, waiting for it to call sendDone() */
+        bool txBlocked;
     };
 
     struct SwitchTableEntry {
@@ -182,7 +188,7 @@ class EtherSwitch : public SimObject
     // all interfaces of the switch
     std::vector<Interface*> interfaces;
     // table that maps MAC address to interfaces
-    std::map<uint64_t, SwitchTableEntry> forwardingTable;
+    std::unordered_map<uint64_t, SwitchTableEntry> forwardingTable;
 
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
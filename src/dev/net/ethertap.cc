@@ -51,8 +51,10 @@
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#include <cerrno>
 #include <cstring>
 #include <deque>
 #include <string>
@@ -188,6 +190,12 @@ EtherTapBase::sendSimulated(void *data, size_t len)
     packet->simLength = len;
     memcpy(packet->data, data, len);
 
+    sendSimulated(packet);
+}
+
+void
+EtherTapBase::sendSimulated(EthPacketPtr packet)
+{
     DPRINTF(Ethernet, "EtherTap real->sim len=%d\n", packet->length);
     DDUMP(EthernetData, packet->data, packet->length);
     if (!packetBuffer.empty() || !interface->sendPacket(packet)) {
@@ -387,11 +395,34 @@ EtherTapStub::recvReal(int revent)
 bool
 EtherTapStub::sendReal(const void *data, size_t len)
 {
+    // Send the length and the frame with a single system call. A
+    // partial write has to be completed, or the stream would lose its
+    // framing.
     uint32_t frame_len = htonl(len);
-    ssize_t ret = write(socket, &frame_len, sizeof(frame_len));
-    if (ret != sizeof(frame_len))
-        return false;
-    return write(socket, data, len) == len;
+    struct iovec iov[2] = {
+        { &frame_len, sizeof(frame_len) },
+        { const_cast<void *>(data), len },
+    };
+    struct iovec *cur = iov;
+    int cnt = 2;
+    while (cnt) {
+        ssize_t ret = writev(socket, cur, cnt);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+
+        while (cnt && (size_t)ret >= cur->iov_len) {
+            ret -= cur->iov_len;
+            cur++;
+            cnt--;
+        }
+        if (cnt) {
+            cur->iov_base = (uint8_t *)cur->iov_base + ret;
+            cur->iov_len -= ret;
+        }
+    }
+    return true;
 }
 
 
@@ -431,15 +462,22 @@ EtherTap::recvReal(int revent)
     if (!(revent & POLLIN))
         return;
 
-    ssize_t ret;
-    while ((ret = read(tap, buffer, buflen))) {
+    // Read frames straight into packets, the buffer of the packet
+    // allocated last goes back to the pool when there's nothing left.
+    while (true) {
+        EthPacketPtr packet = std::make_shared<EthPacketData>(buflen);
+        ssize_t ret = read(tap, packet->data, buflen);
+        if (ret == 0)
+            break;
         if (ret < 0) {
             if (errno == EAGAIN)
                 break;
             panic("Failed to read from tap device.\n");
         }
 
-        sendSimulated(buffer, ret);
+        packet->length = ret;
+        packet->simLength = ret;
+        sendSimulated(packet);
     }
 }
 
@@ -97,6 +97,7 @@ class EtherTapBase : public SimObject
 
     bool recvSimulated(EthPacketPtr packet);
     void sendSimulated(void *data, size_t len);
+    void sendSimulated(EthPacketPtr packet);
 
   protected:
     std::queue<EthPacketPtr> packetBuffer;
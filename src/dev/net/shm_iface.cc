@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory based interface class for dist-gem5 runs on one host.
+ */
+
+#include "dev/net/shm_iface.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <csignal>
+#include <cstring>
+#include <thread>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/DistEthernet.hh"
+#include "debug/DistEthernetCmd.hh"
+#include "sim/sim_exit.hh"
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+              "The shared memory rings need lock free atomics");
+
+namespace
+{
+
+const uint32_t segmentMagic = 0x67356473; // "g5ds"
+
+/** How long to busy wait for the peer before going to sleep. */
+const int spinCount = 2000;
+
+/**
+ * Sleep until the word is signalled or no longer holds the value,
+ * giving up after a while so the caller can check on the peer.
+ */
+void
+futexWait(std::atomic<uint32_t> *word, uint32_t value)
+{
+#if defined(__linux__)
+    const timespec timeout = { 0, 100 * 1000 * 1000 };
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT,
+            value, &timeout, nullptr, 0);
+#else
+    if (word->load() == value)
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+#endif
+}
+
+void
+futexWake(std::atomic<uint32_t> *word)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE,
+            INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+} // anonymous namespace
+
+std::vector<ShmIface *> ShmIface::ifaceRegistry;
+
+ShmIface::ShmIface(const std::string &key_prefix, unsigned ring_size,
+                   unsigned dist_rank, unsigned dist_size,
+                   Tick sync_start, Tick sync_repeat,
+                   EventManager *em, bool use_pseudo_op, bool is_switch,
+                   int num_nodes, bool sync_skip_idle) :
+    DistIface(dist_rank, dist_size, sync_start, sync_repeat, em, use_pseudo_op,
+              is_switch, num_nodes, sync_skip_idle),
+    segment(nullptr), segmentSize(0),
+    keyPrefix(key_prefix), ringSize(ring_size), isSwitch(is_switch),
+    txRing(nullptr), txData(nullptr), rxRing(nullptr), rxData(nullptr)
+{
+    fatal_if(!isPowerOf2(ringSize) || ringSize < sizeof(Header),
+             "The dist shared memory ring size (%u) must be a power of "
+             "two of at least %u bytes.", ringSize, sizeof(Header));
+}
+
+ShmIface::~ShmIface()
+{
+    ifaceRegistry.erase(std::remove(ifaceRegistry.begin(),
+                                    ifaceRegistry.end(), this),
+                        ifaceRegistry.end());
+    if (!segment)
+        return;
+
+    if (!isSwitch && segment->state.load() != Connected)
+        shm_unlink(segmentName(rank, distIfaceId).c_str());
+
+    // Wake up the peer as well as our own receiver thread, which is
+    // joined by the DistIface destructor. As the receiver thread may
+    // still be looking at the segment, it stays mapped until exit.
+    segment->closed.store(1);
+    for (auto &ring : segment->ring) {
+        notify(ring.dataReady);
+        notify(ring.spaceReady);
+    }
+}
+
+std::string
+ShmIface::segmentName(unsigned node_rank, unsigned iface_id) const
+{
+    return "/" + keyPrefix + "." + std::to_string(node_rank) + "." +
+        std::to_string(iface_id);
+}
+
+void
+ShmIface::mapSegment(int fd)
+{
+    void *addr = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    panic_if(addr == MAP_FAILED, "mmap() failed: %s", strerror(errno));
+    close(fd);
+    segment = static_cast<Segment *>(addr);
+}
+
+void
+ShmIface::createSegment()
+{
+    const std::string seg_name = segmentName(rank, distIfaceId);
+    // Remove what a crashed run may have left behind
+    shm_unlink(seg_name.c_str());
+    int fd = shm_open(seg_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    panic_if(fd < 0, "shm_open(%s) failed: %s", seg_name, strerror(errno));
+
+    segmentSize = sizeof(Segment) + 2 * (size_t)ringSize;
+    panic_if(ftruncate(fd, segmentSize) != 0, "ftruncate(%s) failed: %s",
+             seg_name, strerror(errno));
+    mapSegment(fd);
+
+    // The segment is zero filled, fill in the rest before the switch
+    // may look at it.
+    segment->magic = segmentMagic;
+    segment->ringSize = ringSize;
+    segment->nodeRank = rank;
+    segment->nodeIfaceId = distIfaceId;
+    segment->nodeIfaceNum = distIfaceNum;
+    segment->pid[0] = getpid();
+    segment->state.store(Ready);
+
+    DPRINTF(DistEthernet, "Created %s, waiting for the switch "
+            "(distIfaceId:%d)\n", seg_name, distIfaceId);
+    uint32_t state;
+    while ((state = segment->state.load()) != Connected)
+        futexWait(&segment->state, state);
+    inform("Link okay  (iface:%d -> switch iface:%d)", distIfaceId,
+           segment->switchIfaceId);
+}
+
+void
+ShmIface::attachSegment()
+{
+    static unsigned cur_rank = 0;
+    static unsigned cur_id = 0;
+
+    const std::string seg_name = segmentName(cur_rank, cur_id);
+    DPRINTF(DistEthernet, "Waiting for %s\n", seg_name);
+    while (true) {
+        int fd = shm_open(seg_name.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            panic_if(errno != ENOENT, "shm_open(%s) failed: %s", seg_name,
+                     strerror(errno));
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+
+        struct stat st;
+        panic_if(fstat(fd, &st) != 0, "fstat(%s) failed: %s", seg_name,
+                 strerror(errno));
+        if (st.st_size < (off_t)sizeof(Segment)) {
+            // The node has not sized the segment yet
+            close(fd);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        segmentSize = st.st_size;
+        mapSegment(fd);
+
+        while (segment->state.load() == Creating)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (segment->state.load() == Ready &&
+            (kill(segment->pid[0], 0) == 0 || errno != ESRCH)) {
+            break;
+        }
+
+        // Left behind by a node which is gone, wait for the new one
+        munmap(segment, segmentSize);
+        segment = nullptr;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    fatal_if(segment->magic != segmentMagic ||
+             segmentSize != sizeof(Segment) + 2 * (size_t)segment->ringSize,
+             "%s is not a dist-gem5 link segment of this gem5 version.",
+             seg_name);
+    ringSize = segment->ringSize;
+
+    segment->switchIfaceId = distIfaceId;
+    segment->pid[1] = getpid();
+    segment->state.store(Connected);
+    futexWake(&segment->state);
+    // Both sides have it mapped, so the name is not needed any more
+    shm_unlink(seg_name.c_str());
+
+    inform("Link okay  (iface:%d -> (node:%d, iface:%d))",
+           distIfaceId, segment->nodeRank, segment->nodeIfaceId);
+    if (segment->nodeIfaceId < segment->nodeIfaceNum - 1) {
+        cur_id++;
+    } else {
+        cur_rank++;
+        cur_id = 0;
+    }
+}
+
+bool
+ShmIface::peerAlive() const
+{
+    if (segment->closed.load())
+        return false;
+    return kill(segment->pid[isSwitch ? 0 : 1], 0) == 0 || errno != ESRCH;
+}
+
+template <class Pred>
+bool
+ShmIface::wait(Waiter &waiter, Pred pred)
+{
+    for (int i = 0; i < spinCount; i++) {
+        if (pred())
+            return true;
+    }
+
+    while (true) {
+        // The peer only makes the futex call if somebody sleeps
+        waiter.sleepers.fetch_add(1);
+        uint32_t seq = waiter.seq.load();
+        bool ready = pred();
+        if (!ready)
+            futexWait(&waiter.seq, seq);
+        waiter.sleepers.fetch_sub(1);
+
+        if (ready || pred())
+            return true;
+        if (!peerAlive())
+            return pred();
+    }
+}
+
+void
+ShmIface::notify(Waiter &waiter)
+{
+    waiter.seq.fetch_add(1);
+    if (waiter.sleepers.load())
+        futexWake(&waiter.seq);
+}
+
+void
+ShmIface::sendShm(const void *buf, unsigned length)
+{
+    const uint8_t *src = static_cast<const uint8_t *>(buf);
+    Ring &ring = *txRing;
+    while (length > 0) {
+        const uint64_t head = ring.head.load(std::memory_order_relaxed);
+        if (!wait(ring.spaceReady,
+                  [&]{ return head - ring.tail.load() < ringSize; })) {
+            exitSimLoop("Message server closed connection, simulation "
+                        "is exiting");
+            return;
+        }
+
+        // Messages larger than the free space are passed on in pieces
+        const unsigned n = std::min<uint64_t>(length,
+                ringSize - (head - ring.tail.load()));
+        const unsigned offset = head & (ringSize - 1);
+        const unsigned first = std::min(n, ringSize - offset);
+        memcpy(txData + offset, src, first);
+        memcpy(txData, src + first, n - first);
+        ring.head.store(head + n);
+        notify(ring.dataReady);
+
+        src += n;
+        length -= n;
+    }
+}
+
+bool
+ShmIface::recvShm(void *buf, unsigned length)
+{
+    uint8_t *dst = static_cast<uint8_t *>(buf);
+    Ring &ring = *rxRing;
+    while (length > 0) {
+        const uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        if (!wait(ring.dataReady,
+                  [&]{ return ring.head.load() != tail; })) {
+            inform("recv(): Connection closed");
+            return false;
+        }
+
+        const unsigned n = std::min<uint64_t>(length,
+                ring.head.load() - tail);
+        const unsigned offset = tail & (ringSize - 1);
+        const unsigned first = std::min(n, ringSize - offset);
+        memcpy(dst, rxData + offset, first);
+        memcpy(dst + first, rxData, n - first);
+        ring.tail.store(tail + n);
+        notify(ring.spaceReady);
+
+        dst += n;
+        length -= n;
+    }
+    return true;
+}
+
+void
+ShmIface::sendPacket(const Header &header, const EthPacketPtr &packet)
+{
+    sendShm(&header, sizeof(header));
+    sendShm(packet->data, packet->length);
+}
+
+void
+ShmIface::sendCmd(const Header &header)
+{
+    DPRINTF(DistEthernetCmd, "ShmIface::sendCmd() type: %d\n",
+            static_cast<int>(header.msgType));
+    // Global commands (i.e. sync request) are always sent by the primary
+    // DistIface to all the links of this process.
+    for (auto iface: ifaceRegistry)
+        iface->sendShm(&header, sizeof(header));
+}
+
+bool
+ShmIface::recvHeader(Header &header)
+{
+    bool ret = recvShm(&header, sizeof(header));
+    DPRINTF(DistEthernetCmd, "ShmIface::recvHeader() type: %d ret: %d\n",
+            static_cast<int>(header.msgType), ret);
+    return ret;
+}
+
+void
+ShmIface::recvPacket(const Header &header, EthPacketPtr &packet)
+{
+    packet = std::make_shared<EthPacketData>(header.dataPacketLength);
+    bool ret = recvShm(packet->data, header.dataPacketLength);
+    panic_if(!ret, "Error while reading shared memory ring");
+    packet->simLength = header.simLength;
+    packet->length = header.dataPacketLength;
+}
+
+void
+ShmIface::initTransport()
+{
+    // As with the TCPIface, the links are set up in the init phase, once
+    // the number of dist interfaces of each process is known.
+    if (isSwitch)
+        attachSegment();
+    else
+        createSegment();
+
+    uint8_t *data = reinterpret_cast<uint8_t *>(segment + 1);
+    const int tx = isSwitch ? 1 : 0;
+    txRing = &segment->ring[tx];
+    txData = data + tx * (size_t)ringSize;
+    rxRing = &segment->ring[1 - tx];
+    rxData = data + (1 - tx) * (size_t)ringSize;
+
+    ifaceRegistry.push_back(this);
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory based interface class for dist-gem5 runs on one host.
+ *
+ * Each dist link is carried over a segment in /dev/shm holding one
+ * single producer, single consumer byte ring per direction. Messages are
+ * copied straight into the ring of the peer, so sending and receiving a
+ * packet does not need any system call unless the other side is asleep
+ * waiting for data or space, in which case it is woken through a futex.
+ * The messages exchanged are the same as with the TCPIface, so the
+ * dist synchronisation works unchanged on top of this transport.
+ */
+#ifndef __DEV_NET_SHM_IFACE_HH__
+#define __DEV_NET_SHM_IFACE_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dev/net/dist_iface.hh"
+
+class EventManager;
+
+class ShmIface : public DistIface
+{
+  private:
+    /**
+     * A word a thread of one process can sleep on until a thread of the
+     * peer process signals it.
+     */
+    struct Waiter
+    {
+        std::atomic<uint32_t> seq;
+        std::atomic<uint32_t> sleepers;
+    };
+
+    /** A byte ring filled by one process and drained by the other. */
+    struct Ring
+    {
+        /** Bytes written into the ring since it was created. */
+        alignas(64) std::atomic<uint64_t> head;
+        /** Bytes read from the ring since it was created. */
+        alignas(64) std::atomic<uint64_t> tail;
+        /** Signalled when data is added to an empty ring. */
+        alignas(64) Waiter dataReady;
+        /** Signalled when space is freed in the ring. */
+        Waiter spaceReady;
+    };
+
+    enum SegmentState : uint32_t
+    {
+        Creating,
+        /** The compute node waits for the switch to attach. */
+        Ready,
+        Connected,
+    };
+
+    /**
+     * The start of a segment. The data of the two rings follows it, the
+     * node to switch ring first.
+     */
+    struct Segment
+    {
+        uint32_t magic;
+        std::atomic<uint32_t> state;
+        /** Set once either side has detached from the segment. */
+        std::atomic<uint32_t> closed;
+        uint32_t ringSize;
+        uint32_t nodeRank;
+        uint32_t nodeIfaceId;
+        uint32_t nodeIfaceNum;
+        uint32_t switchIfaceId;
+        int32_t pid[2];
+        Ring ring[2];
+    };
+
+    Segment *segment;
+    size_t segmentSize;
+
+    std::string keyPrefix;
+    unsigned ringSize;
+    bool isSwitch;
+
+    Ring *txRing;
+    uint8_t *txData;
+    Ring *rxRing;
+    uint8_t *rxData;
+
+    /**
+     * All the interfaces of this process, which the sync commands are
+     * sent through.
+     */
+    static std::vector<ShmIface *> ifaceRegistry;
+
+    std::string segmentName(unsigned node_rank, unsigned iface_id) const;
+
+    /** Create the segment of this compute node link and wait for the
+     * switch to attach to it. */
+    void createSegment();
+    /** Attach to the segment of the next compute node link. */
+    void attachSegment();
+    void mapSegment(int fd);
+
+    /** Is the other side of the link still there? */
+    bool peerAlive() const;
+
+    /**
+     * Block until the predicate holds or the peer is gone.
+     *
+     * @return False if the peer detached before the predicate held.
+     */
+    template <class Pred>
+    bool wait(Waiter &waiter, Pred pred);
+    static void notify(Waiter &waiter);
+
+    /**
+     * Copy a message into the transmit ring, blocking while the ring is
+     * full.
+     */
+    void sendShm(const void *buf, unsigned length);
+    /**
+     * Copy the next length bytes out of the receive ring.
+     *
+     * @return False if the peer detached.
+     */
+    bool recvShm(void *buf, unsigned length);
+
+  protected:
+
+    void sendPacket(const Header &header,
+                    const EthPacketPtr &packet) override;
+
+    void sendCmd(const Header &header) override;
+
+    bool recvHeader(Header &header) override;
+
+    void recvPacket(const Header &header, EthPacketPtr &packet) override;
+
+    void initTransport() override;
+
+  public:
+    /**
+     * @param key_prefix Prefix of the names of the shared memory
+     * segments, which has to be the same in all the gem5 processes of
+     * the run.
+     * @param ring_size Size in bytes of the ring in each direction of a
+     * link. Only the value used by the compute nodes matters.
+     * @param sync_start The tick for the first dist synchronisation.
+     * @param sync_repeat The frequency of dist synchronisation.
+     * @param em The EventManager object associated with the simulated
+     * Ethernet link.
+     */
+    ShmIface(const std::string &key_prefix, unsigned ring_size,
+             unsigned dist_rank, unsigned dist_size,
+             Tick sync_start, Tick sync_repeat, EventManager *em,
+             bool use_pseudo_op, bool is_switch, int num_nodes,
+             bool sync_skip_idle);
+
+    ~ShmIface() override;
+};
+
+#endif // __DEV_NET_SHM_IFACE_HH__
@@ -46,6 +46,7 @@
 #include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <cerrno>
@@ -80,9 +81,9 @@ TCPIface::TCPIface(std::string server_name, unsigned server_port,
                    unsigned dist_rank, unsigned dist_size,
                    Tick sync_start, Tick sync_repeat,
                    EventManager *em, bool use_pseudo_op, bool is_switch,
-                   int num_nodes) :
+                   int num_nodes, bool sync_skip_idle) :
     DistIface(dist_rank, dist_size, sync_start, sync_repeat, em, use_pseudo_op,
-              is_switch, num_nodes), serverName(server_name),
+              is_switch, num_nodes, sync_skip_idle), serverName(server_name),
     serverPort(server_port), isSwitch(is_switch), listening(false)
 {
     if (is_switch && isPrimary) {
@@ -296,8 +297,38 @@ TCPIface::recvTCP(int sock, void *buf, unsigned length)
 void
 TCPIface::sendPacket(const Header &header, const EthPacketPtr &packet)
 {
-    sendTCP(sock, &header, sizeof(header));
-    sendTCP(sock, packet->data, packet->length);
+    // Gather the header and the data into one message, so they end up
+    // in the same segment and cost a single system call.
+    struct iovec iov[2] = {
+        { const_cast<Header *>(&header), sizeof(header) },
+        { packet->data, packet->length },
+    };
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+
+    ssize_t ret = ::sendmsg(sock, &msg, MSG_NOSIGNAL);
+    if (ret < 0) {
+        if (errno == ECONNRESET || errno == EPIPE) {
+            exitSimLoop("Message server closed connection, simulation "
+                        "is exiting");
+            return;
+        } else {
+            panic("sendmsg() failed: %s", strerror(errno));
+        }
+    }
+
+    // Blocking sockets only return early if interrupted, send whatever
+    // is left the slow way.
+    if ((size_t)ret < sizeof(header)) {
+        sendTCP(sock, (const uint8_t *)&header + ret, sizeof(header) - ret);
+        ret = 0;
+    } else {
+        ret -= sizeof(header);
+    }
+    if ((size_t)ret < packet->length)
+        sendTCP(sock, packet->data + ret, packet->length - ret);
 }
 
 void
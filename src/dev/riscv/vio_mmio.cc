@@ -48,7 +48,9 @@ MmioVirtIO::MmioVirtIO(const MmioVirtIOParams &params)
       hostFeaturesSelect(0), guestFeaturesSelect(0), pageSize(0),
       interruptStatus(0), vio(*params.vio)
 {
-    vio.registerKickCallback([this]() { kick(); });
+    vio.registerKickCallback([this](VirtIODeviceBase::QueueID queue) {
+        kick(queue);
+    });
 }
 
 MmioVirtIO::~MmioVirtIO()
@@ -252,9 +254,10 @@ MmioVirtIO::write(Addr offset, uint32_t value)
 }
 
 void
-MmioVirtIO::kick()
+MmioVirtIO::kick(VirtIODeviceBase::QueueID queue)
 {
-    DPRINTF(VirtIOMMIO, "kick(): Sending interrupt...\n");
+    // There is only one interrupt, shared by all queues.
+    DPRINTF(VirtIOMMIO, "kick(%i): Sending interrupt...\n", queue);
     setInterrupts(interruptStatus | INT_USED_RING);
 }
 
@@ -96,7 +96,7 @@ class MmioVirtIO : public PlicIntDevice
     uint32_t read(Addr offset);
     void write(Addr offset, uint32_t value);
 
-    void kick();
+    void kick(VirtIODeviceBase::QueueID queue);
     void setInterrupts(uint32_t value);
 
     uint32_t hostFeaturesSelect;
@@ -42,5 +42,7 @@ class CowDiskImage(DiskImage):
     cxx_header = "dev/storage/disk_image.hh"
     child = Param.DiskImage(RawDiskImage(read_only=True),
                             "child image")
-    table_size = Param.Int(65536, "initial table size")
+    table_size = Param.Int(65536, "unused, the table grows as needed")
+    overlay = Param.Bool(False, "Keep the layer in image_file as a sparse "
+        "overlay which is written to as the disk is, instead of in memory")
     image_file = ""
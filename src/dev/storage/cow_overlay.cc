@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dev/storage/cow_overlay.hh"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "sim/byteswap.hh"
+
+namespace
+{
+
+const char Magic[8] = { 'G', '5', 'C', 'O', 'W', 'O', 'V', 'L' };
+
+} // anonymous namespace
+
+const uint32_t CowOverlay::Version;
+const unsigned CowOverlay::SectorsPerExtent;
+const unsigned CowOverlay::ExtentBytes;
+const unsigned CowOverlay::L2Bits;
+const uint64_t CowOverlay::L1Offset;
+const uint64_t CowOverlay::Alignment;
+
+bool
+CowOverlay::L2Entry::isValid(unsigned idx) const
+{
+    return valid[idx / 64] & (1ULL << (idx % 64));
+}
+
+void
+CowOverlay::L2Entry::setValid(unsigned idx)
+{
+    valid[idx / 64] |= 1ULL << (idx % 64);
+}
+
+CowOverlay::CowOverlay(const std::string &_filename, uint64_t disk_sectors)
+    : filename(_filename), fd(-1), diskSectors(disk_sectors), fileEnd(0)
+{
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+    fatal_if(fd < 0, "Could not open COW overlay %s: %s", filename,
+             strerror(errno));
+    fatal_if(flock(fd, LOCK_EX | LOCK_NB) != 0,
+             "COW overlay %s is in use by another simulation.", filename);
+
+    struct stat st;
+    fatal_if(fstat(fd, &st) != 0, "Could not stat %s: %s", filename,
+             strerror(errno));
+
+    uint64_t extents = divCeil(diskSectors, SectorsPerExtent);
+    l1.resize(divCeil(extents, 1 << L2Bits), 0);
+    l2.resize(l1.size());
+
+    if (st.st_size == 0)
+        create();
+    else
+        load();
+
+    fileEnd = roundUp(std::max<uint64_t>(st.st_size,
+                L1Offset + l1.size() * sizeof(uint64_t)), Alignment);
+}
+
+CowOverlay::~CowOverlay()
+{
+    if (fd >= 0)
+        ::close(fd);
+}
+
+void
+CowOverlay::readFully(void *data, size_t size, uint64_t offset) const
+{
+    uint8_t *ptr = (uint8_t *)data;
+    while (size) {
+        ssize_t ret = pread(fd, ptr, size, offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        panic_if(ret <= 0, "Error reading COW overlay %s: %s", filename,
+                 ret ? strerror(errno) : "unexpected end of file");
+        ptr += ret;
+        size -= ret;
+        offset += ret;
+    }
+}
+
+void
+CowOverlay::writeFully(const void *data, size_t size, uint64_t offset)
+{
+    const uint8_t *ptr = (const uint8_t *)data;
+    while (size) {
+        ssize_t ret = pwrite(fd, ptr, size, offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        panic_if(ret <= 0, "Error writing COW overlay %s: %s", filename,
+                 strerror(errno));
+        ptr += ret;
+        size -= ret;
+        offset += ret;
+    }
+}
+
+uint64_t
+CowOverlay::allocate(uint64_t size)
+{
+    uint64_t offset = fileEnd;
+    fileEnd = roundUp(fileEnd + size, Alignment);
+    // Extend the file so partially written extents can be read whole.
+    panic_if(ftruncate(fd, fileEnd) != 0, "Could not extend %s: %s",
+             filename, strerror(errno));
+    return offset;
+}
+
+void
+CowOverlay::create()
+{
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = htole(Version);
+    header.sectorsPerExtent = htole((uint32_t)SectorsPerExtent);
+    header.diskSectors = htole(diskSectors);
+    header.l1Entries = htole((uint64_t)l1.size());
+    writeFully(&header, sizeof(header), 0);
+
+    std::vector<uint64_t> zeros(l1.size(), 0);
+    writeFully(zeros.data(), zeros.size() * sizeof(uint64_t), L1Offset);
+}
+
+void
+CowOverlay::load()
+{
+    Header header;
+    readFully(&header, sizeof(header), 0);
+    fatal_if(memcmp(header.magic, Magic, sizeof(Magic)) != 0,
+             "%s is not a COW overlay.", filename);
+    fatal_if(letoh(header.version) != Version,
+             "COW overlay %s has version %d, expected %d.", filename,
+             letoh(header.version), Version);
+    fatal_if(letoh(header.sectorsPerExtent) != SectorsPerExtent,
+             "COW overlay %s uses %d sector extents, expected %d.",
+             filename, letoh(header.sectorsPerExtent), SectorsPerExtent);
+    fatal_if(letoh(header.diskSectors) != diskSectors,
+             "COW overlay %s is for a disk of %d sectors, not %d.",
+             filename, letoh(header.diskSectors), diskSectors);
+    fatal_if(letoh(header.l1Entries) != l1.size(),
+             "COW overlay %s has a corrupt header.", filename);
+
+    readFully(l1.data(), l1.size() * sizeof(uint64_t), L1Offset);
+    for (auto &offset: l1)
+        offset = letoh(offset);
+}
+
+CowOverlay::L2Table *
+CowOverlay::table(uint64_t index) const
+{
+    if (!l1[index])
+        return nullptr;
+
+    auto &t = l2[index];
+    if (!t) {
+        t.reset(new L2Table);
+        readFully(t->data(), sizeof(L2Table), l1[index]);
+        for (auto &entry: *t) {
+            entry.offset = letoh(entry.offset);
+            for (auto &bits: entry.valid)
+                bits = letoh(bits);
+        }
+    }
+    return t.get();
+}
+
+const CowOverlay::L2Entry *
+CowOverlay::find(uint64_t extent) const
+{
+    L2Table *t = table(extent >> L2Bits);
+    if (!t)
+        return nullptr;
+    const L2Entry &entry = (*t)[extent & mask(L2Bits)];
+    return entry.offset ? &entry : nullptr;
+}
+
+CowOverlay::L2Entry &
+CowOverlay::findOrCreate(uint64_t extent)
+{
+    uint64_t index = extent >> L2Bits;
+    L2Table *t = table(index);
+    if (!t) {
+        // Write out the new L2 table before pointing the L1 table at it.
+        l2[index].reset(new L2Table);
+        t = l2[index].get();
+        memset(t->data(), 0, sizeof(L2Table));
+        l1[index] = allocate(sizeof(L2Table));
+        writeFully(t->data(), sizeof(L2Table), l1[index]);
+
+        uint64_t offset = htole(l1[index]);
+        writeFully(&offset, sizeof(offset),
+                   L1Offset + index * sizeof(uint64_t));
+    }
+
+    L2Entry &entry = (*t)[extent & mask(L2Bits)];
+    if (!entry.offset)
+        entry.offset = allocate(ExtentBytes);
+    return entry;
+}
+
+void
+CowOverlay::writeEntry(uint64_t extent, const L2Entry &entry)
+{
+    L2Entry out;
+    out.offset = htole(entry.offset);
+    for (unsigned i = 0; i < SectorsPerExtent / 64; i++)
+        out.valid[i] = htole(entry.valid[i]);
+    writeFully(&out, sizeof(out), l1[extent >> L2Bits] +
+               (extent & mask(L2Bits)) * sizeof(L2Entry));
+}
+
+bool
+CowOverlay::present(uint64_t sector) const
+{
+    const L2Entry *entry = find(sector / SectorsPerExtent);
+    return entry && entry->isValid(sector % SectorsPerExtent);
+}
+
+void
+CowOverlay::read(uint64_t sector, uint8_t *data, unsigned count) const
+{
+    while (count) {
+        // Sectors are contiguous within an extent, so read up to the end
+        // of each one in one go.
+        unsigned idx = sector % SectorsPerExtent;
+        unsigned n = std::min(count, SectorsPerExtent - idx);
+        const L2Entry *entry = find(sector / SectorsPerExtent);
+        assert(entry);
+        readFully(data, n * SectorSize, entry->offset + idx * SectorSize);
+
+        sector += n;
+        data += n * SectorSize;
+        count -= n;
+    }
+}
+
+void
+CowOverlay::write(uint64_t sector, const uint8_t *data, unsigned count)
+{
+    while (count) {
+        uint64_t extent = sector / SectorsPerExtent;
+        unsigned idx = sector % SectorsPerExtent;
+        unsigned n = std::min(count, SectorsPerExtent - idx);
+
+        // The data goes out before the entry marking it valid.
+        L2Entry &entry = findOrCreate(extent);
+        writeFully(data, n * SectorSize, entry.offset + idx * SectorSize);
+        for (unsigned i = 0; i < n; i++)
+            entry.setValid(idx + i);
+        writeEntry(extent, entry);
+
+        sector += n;
+        data += n * SectorSize;
+        count -= n;
+    }
+}
+
+void
+CowOverlay::clear()
+{
+    std::fill(l1.begin(), l1.end(), 0);
+    for (auto &t: l2)
+        t.reset();
+
+    uint64_t end = L1Offset + l1.size() * sizeof(uint64_t);
+    panic_if(ftruncate(fd, end) != 0, "Could not truncate %s: %s",
+             filename, strerror(errno));
+    create();
+    fileEnd = roundUp(end, Alignment);
+}
+
+uint64_t
+CowOverlay::size() const
+{
+    uint64_t sectors = 0;
+    for (uint64_t i = 0; i < l1.size(); i++) {
+        const L2Table *t = table(i);
+        if (!t)
+            continue;
+        for (const auto &entry: *t) {
+            for (auto bits: entry.valid)
+                sectors += popCount(bits);
+        }
+    }
+    return sectors;
+}
+
+void
+CowOverlay::forEach(const std::function<void(uint64_t,
+                    const CowDiskImage::Extent &)> &f) const
+{
+    std::unique_ptr<CowDiskImage::Extent> ext(new CowDiskImage::Extent);
+    for (uint64_t i = 0; i < l1.size(); i++) {
+        const L2Table *t = table(i);
+        if (!t)
+            continue;
+        for (uint64_t j = 0; j < t->size(); j++) {
+            const L2Entry &entry = (*t)[j];
+            if (!entry.offset)
+                continue;
+
+            ext->valid.reset();
+            for (unsigned k = 0; k < SectorsPerExtent; k++)
+                ext->valid[k] = entry.isValid(k);
+            readFully(ext->data, ExtentBytes, entry.offset);
+            f((i << L2Bits) | j, *ext);
+        }
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __DEV_STORAGE_COW_OVERLAY_HH__
+#define __DEV_STORAGE_COW_OVERLAY_HH__
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dev/storage/disk_image.hh"
+
+/**
+ * A copy-on-write layer kept in a sparse file instead of in memory.
+ * Written sectors go straight to the file and are read back from it on
+ * demand, so the layer persists without being saved and its size isn't
+ * limited by the simulator's memory.
+ *
+ * The file starts with a header followed by a table with one entry per
+ * L2 table. L2 tables and extents are appended to the file as they're
+ * needed. Each L2 table entry holds the file offset of an extent and a
+ * mask of the sectors in it which have been written.
+ *
+ * The file is locked while it's open so two simulations can't write to
+ * the same overlay, while they can still share the image beneath it.
+ */
+class CowOverlay : public CowDiskImage::ExtentStore
+{
+  public:
+    static const uint32_t Version = 1;
+
+  protected:
+    static const unsigned SectorsPerExtent = CowDiskImage::SectorsPerExtent;
+    static const unsigned ExtentBytes = SectorsPerExtent * SectorSize;
+    static const unsigned L2Bits = 9;
+    static const uint64_t L1Offset = 4096;
+    static const uint64_t Alignment = 4096;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t sectorsPerExtent;
+        uint64_t diskSectors;
+        uint64_t l1Entries;
+    };
+
+    struct L2Entry
+    {
+        /** Offset of the extent in the file, 0 if it isn't allocated. */
+        uint64_t offset;
+        uint64_t valid[SectorsPerExtent / 64];
+
+        bool isValid(unsigned idx) const;
+        void setValid(unsigned idx);
+    };
+
+    typedef std::array<L2Entry, 1 << L2Bits> L2Table;
+
+    std::string filename;
+    int fd;
+    uint64_t diskSectors;
+    /** End of the allocated part of the file. */
+    uint64_t fileEnd;
+
+    /** File offsets of the L2 tables, 0 for ones not allocated yet. */
+    std::vector<uint64_t> l1;
+    /** L2 tables which have been read from the file so far. */
+    mutable std::vector<std::unique_ptr<L2Table>> l2;
+
+    void readFully(void *data, size_t size, uint64_t offset) const;
+    void writeFully(const void *data, size_t size, uint64_t offset);
+    uint64_t allocate(uint64_t size);
+
+    void create();
+    void load();
+
+    /** Get an L2 table, reading it in if needed. */
+    L2Table *table(uint64_t index) const;
+    /** Find an extent's entry, returning nullptr if it's not allocated. */
+    const L2Entry *find(uint64_t extent) const;
+    /** Find an extent's entry, allocating the extent if needed. */
+    L2Entry &findOrCreate(uint64_t extent);
+    void writeEntry(uint64_t extent, const L2Entry &entry);
+
+  public:
+    CowOverlay(const std::string &filename, uint64_t disk_sectors);
+    ~CowOverlay();
+
+    bool present(uint64_t sector) const override;
+    void read(uint64_t sector, uint8_t *data,
+              unsigned count) const override;
+    void write(uint64_t sector, const uint8_t *data,
+               unsigned count) override;
+    void clear() override;
+
+    uint64_t size() const override;
+
+    void forEach(const std::function<void(uint64_t,
+                 const CowDiskImage::Extent &)> &f) const override;
+};
+
+#endif // __DEV_STORAGE_COW_OVERLAY_HH__
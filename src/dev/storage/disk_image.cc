@@ -32,30 +32,174 @@
 
 #include "dev/storage/disk_image.hh"
 
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <cassert>
 #include <cerrno>
+#include <climits>
 #include <cstring>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "base/callback.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/DiskImageRead.hh"
 #include "debug/DiskImageWrite.hh"
+#include "dev/storage/cow_overlay.hh"
 #include "sim/byteswap.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
+////////////////////////////////////////////////////////////////////////
+//
+// Disk image
+//
+std::streampos
+DiskImage::readSectors(uint8_t *data, std::streampos offset,
+                       unsigned count) const
+{
+    std::streampos total = 0;
+    for (unsigned i = 0; i < count; i++) {
+        std::streampos bytes = read(data + i * SectorSize, offset + (std::streamoff)i);
+        total += bytes;
+        if (bytes != SectorSize)
+            break;
+    }
+    return total;
+}
+
+std::streampos
+DiskImage::writeSectors(const uint8_t *data, std::streampos offset,
+                        unsigned count)
+{
+    std::streampos total = 0;
+    for (unsigned i = 0; i < count; i++) {
+        std::streampos bytes = write(data + i * SectorSize, offset + (std::streamoff)i);
+        total += bytes;
+        if (bytes != SectorSize)
+            break;
+    }
+    return total;
+}
+
+namespace
+{
+
+size_t
+iovSize(const struct iovec *iov, int iovcnt)
+{
+    size_t size = 0;
+    for (int i = 0; i < iovcnt; i++)
+        size += iov[i].iov_len;
+    return size;
+}
+
+/**
+ * Copy up to bytes bytes between a contiguous buffer and a list of
+ * buffers, in the direction given by to_iov.
+ */
+void
+copyIov(uint8_t *buf, const struct iovec *iov, int iovcnt, size_t bytes,
+        bool to_iov)
+{
+    for (int i = 0; i < iovcnt && bytes; i++) {
+        size_t len = std::min(iov[i].iov_len, bytes);
+        if (to_iov)
+            memcpy(iov[i].iov_base, buf, len);
+        else
+            memcpy(buf, iov[i].iov_base, len);
+        buf += len;
+        bytes -= len;
+    }
+}
+
+/**
+ * Move up to bytes bytes between a file and a list of buffers using
+ * preadv/pwritev, restarting after short transfers.
+ *
+ * @return The number of bytes transferred.
+ */
+size_t
+transferIov(int fd, const struct iovec *iov, int iovcnt, off_t start,
+            size_t bytes, bool write)
+{
+    std::vector<struct iovec> vec;
+    for (int i = 0; i < iovcnt && bytes; i++) {
+        size_t len = std::min(iov[i].iov_len, bytes);
+        vec.push_back({ iov[i].iov_base, len });
+        bytes -= len;
+    }
+
+    size_t done = 0;
+    size_t first = 0;
+    while (first < vec.size()) {
+        int cnt = std::min<size_t>(vec.size() - first, IOV_MAX);
+        ssize_t ret = write ? pwritev(fd, &vec[first], cnt, start + done) :
+                              preadv(fd, &vec[first], cnt, start + done);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            break;
+        done += ret;
+
+        // Skip whatever has been transferred already.
+        while (ret > 0) {
+            if ((size_t)ret >= vec[first].iov_len) {
+                ret -= vec[first].iov_len;
+                first++;
+            } else {
+                vec[first].iov_base = (uint8_t *)vec[first].iov_base + ret;
+                vec[first].iov_len -= ret;
+                ret = 0;
+            }
+        }
+    }
+    return done;
+}
+
+} // anonymous namespace
+
+std::streampos
+DiskImage::readSectorsv(const struct iovec *iov, int iovcnt,
+                        std::streampos offset) const
+{
+    size_t size = iovSize(iov, iovcnt);
+    assert(size % SectorSize == 0);
+
+    std::vector<uint8_t> data(size);
+    std::streampos bytes = readSectors(data.data(), offset,
+                                       size / SectorSize);
+    copyIov(data.data(), iov, iovcnt, bytes, true);
+    return bytes;
+}
+
+std::streampos
+DiskImage::writeSectorsv(const struct iovec *iov, int iovcnt,
+                         std::streampos offset)
+{
+    size_t size = iovSize(iov, iovcnt);
+    assert(size % SectorSize == 0);
+
+    std::vector<uint8_t> data(size);
+    copyIov(data.data(), iov, iovcnt, size, false);
+    return writeSectors(data.data(), offset, size / SectorSize);
+}
+
 ////////////////////////////////////////////////////////////////////////
 //
 // Raw Disk image
 //
 RawDiskImage::RawDiskImage(const Params &p)
-    : DiskImage(p), disk_size(0)
+    : DiskImage(p), fd(-1), mapping(nullptr), readonly(p.read_only),
+      disk_size(0)
 {
     open(p.image_file, p.read_only);
 }
@@ -84,58 +228,179 @@ RawDiskImage::open(const std::string &filename, bool rd_only)
         readonly = rd_only;
         file = filename;
 
-        std::ios::openmode mode = std::ios::in | std::ios::binary;
-        if (!readonly)
-            mode |= std::ios::out;
-        stream.open(file.c_str(), mode);
-        if (!stream.is_open())
+        fd = ::open(file.c_str(), readonly ? O_RDONLY : O_RDWR);
+        if (fd < 0)
             panic("Error opening %s", filename);
+
+        // Any number of simulations may share an image read only, but
+        // only one may have it open when it's written to.
+        fatal_if(flock(fd, (readonly ? LOCK_SH : LOCK_EX) | LOCK_NB) != 0,
+                 "Disk image %s is being written to by another simulation, "
+                 "or is in use and can't be opened read-write.", filename);
+
+        off_t end = lseek(fd, 0, SEEK_END);
+        if (end < 0)
+            panic("Could not determine the size of %s", filename);
+        disk_size = end;
+
+        if (end > 0) {
+            void *m = mmap(nullptr, end,
+                           readonly ? PROT_READ : PROT_READ | PROT_WRITE,
+                           MAP_SHARED, fd, 0);
+            if (m != MAP_FAILED) {
+                mapping = (uint8_t *)m;
+            } else {
+                warn("Could not map %s (%s), falling back to pread/pwrite.",
+                     filename, strerror(errno));
+            }
+        }
     }
 }
 
 void
 RawDiskImage::close()
 {
-    stream.close();
+    if (mapping) {
+        munmap(mapping, disk_size);
+        mapping = nullptr;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
 }
 
 std::streampos
 RawDiskImage::size() const
 {
-    if (disk_size == 0) {
-        if (!stream.is_open())
-            panic("file not open!\n");
-        stream.seekg(0, std::ios::end);
-        disk_size = stream.tellg();
-    }
+    if (fd < 0)
+        panic("file not open!\n");
 
     return disk_size / SectorSize;
 }
 
+size_t
+RawDiskImage::accessSize(std::streampos offset, unsigned count) const
+{
+    uint64_t start = (uint64_t)offset * SectorSize;
+    if (start >= (uint64_t)disk_size)
+        return 0;
+    return std::min<uint64_t>((uint64_t)count * SectorSize,
+                              (uint64_t)disk_size - start);
+}
+
 std::streampos
 RawDiskImage::read(uint8_t *data, std::streampos offset) const
+{
+    return readSectors(data, offset, 1);
+}
+
+std::streampos
+RawDiskImage::write(const uint8_t *data, std::streampos offset)
+{
+    return writeSectors(data, offset, 1);
+}
+
+std::streampos
+RawDiskImage::readSectors(uint8_t *data, std::streampos offset,
+                          unsigned count) const
 {
     if (!initialized)
         panic("RawDiskImage not initialized");
 
-    if (!stream.is_open())
+    if (fd < 0)
         panic("file not open!\n");
 
-    stream.seekg(offset * SectorSize, std::ios::beg);
-    if (!stream.good())
-        panic("Could not seek to location in file");
+    off_t start = (off_t)offset * SectorSize;
+    size_t bytes = accessSize(offset, count);
+    if (mapping) {
+        memcpy(data, mapping + start, bytes);
+    } else {
+        size_t done = 0;
+        while (done < bytes) {
+            ssize_t ret = pread(fd, data + done, bytes - done, start + done);
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0)
+                break;
+            done += ret;
+        }
+        bytes = done;
+    }
+
+    DPRINTF(DiskImageRead, "read: offset=%d count=%d\n",
+            (uint64_t)offset, count);
+    DDUMP(DiskImageRead, data, bytes);
 
-    std::streampos pos = stream.tellg();
-    stream.read((char *)data, SectorSize);
+    return bytes;
+}
 
-    DPRINTF(DiskImageRead, "read: offset=%d\n", (uint64_t)offset);
-    DDUMP(DiskImageRead, data, SectorSize);
+std::streampos
+RawDiskImage::writeSectors(const uint8_t *data, std::streampos offset,
+                           unsigned count)
+{
+    if (!initialized)
+        panic("RawDiskImage not initialized");
+
+    if (readonly)
+        panic("Cannot write to a read only disk image");
 
-    return stream.tellg() - pos;
+    if (fd < 0)
+        panic("file not open!\n");
+
+    DPRINTF(DiskImageWrite, "write: offset=%d count=%d\n",
+            (uint64_t)offset, count);
+    DDUMP(DiskImageWrite, data, count * SectorSize);
+
+    off_t start = (off_t)offset * SectorSize;
+    size_t bytes = accessSize(offset, count);
+    if (mapping) {
+        memcpy(mapping + start, data, bytes);
+    } else {
+        size_t done = 0;
+        while (done < bytes) {
+            ssize_t ret = pwrite(fd, data + done, bytes - done, start + done);
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0)
+                break;
+            done += ret;
+        }
+        bytes = done;
+    }
+
+    return bytes;
 }
 
 std::streampos
-RawDiskImage::write(const uint8_t *data, std::streampos offset)
+RawDiskImage::readSectorsv(const struct iovec *iov, int iovcnt,
+                           std::streampos offset) const
+{
+    if (!initialized)
+        panic("RawDiskImage not initialized");
+
+    if (fd < 0)
+        panic("file not open!\n");
+
+    size_t size = iovSize(iov, iovcnt);
+    assert(size % SectorSize == 0);
+
+    off_t start = (off_t)offset * SectorSize;
+    size_t bytes = accessSize(offset, size / SectorSize);
+    if (mapping)
+        copyIov(mapping + start, iov, iovcnt, bytes, true);
+    else
+        bytes = transferIov(fd, iov, iovcnt, start, bytes, false);
+
+    DPRINTF(DiskImageRead, "readv: offset=%d count=%d iovcnt=%d\n",
+            (uint64_t)offset, size / SectorSize, iovcnt);
+
+    return bytes;
+}
+
+std::streampos
+RawDiskImage::writeSectorsv(const struct iovec *iov, int iovcnt,
+                            std::streampos offset)
 {
     if (!initialized)
         panic("RawDiskImage not initialized");
@@ -143,19 +408,23 @@ RawDiskImage::write(const uint8_t *data, std::streampos offset)
     if (readonly)
         panic("Cannot write to a read only disk image");
 
-    if (!stream.is_open())
+    if (fd < 0)
         panic("file not open!\n");
 
-    stream.seekp(offset * SectorSize, std::ios::beg);
-    if (!stream.good())
-        panic("Could not seek to location in file");
+    size_t size = iovSize(iov, iovcnt);
+    assert(size % SectorSize == 0);
 
-    DPRINTF(DiskImageWrite, "write: offset=%d\n", (uint64_t)offset);
-    DDUMP(DiskImageWrite, data, SectorSize);
+    DPRINTF(DiskImageWrite, "writev: offset=%d count=%d iovcnt=%d\n",
+            (uint64_t)offset, size / SectorSize, iovcnt);
 
-    std::streampos pos = stream.tellp();
-    stream.write((const char *)data, SectorSize);
-    return stream.tellp() - pos;
+    off_t start = (off_t)offset * SectorSize;
+    size_t bytes = accessSize(offset, size / SectorSize);
+    if (mapping)
+        copyIov(mapping + start, iov, iovcnt, bytes, false);
+    else
+        bytes = transferIov(fd, iov, iovcnt, start, bytes, true);
+
+    return bytes;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -165,16 +434,128 @@ RawDiskImage::write(const uint8_t *data, std::streampos offset)
 const uint32_t CowDiskImage::VersionMajor = 1;
 const uint32_t CowDiskImage::VersionMinor = 0;
 
+unsigned
+CowDiskImage::ExtentTable::index(uint64_t extent, unsigned level)
+{
+    return (extent >> (level * RadixBits)) & ((1 << RadixBits) - 1);
+}
+
+const CowDiskImage::Extent *
+CowDiskImage::ExtentTable::find(uint64_t extent) const
+{
+    const Node *node = &root;
+    for (unsigned level = Levels - 1; level > 0; level--) {
+        node = node->children[index(extent, level)].get();
+        if (!node)
+            return nullptr;
+    }
+    return node->extents[index(extent, 0)].get();
+}
+
+CowDiskImage::Extent &
+CowDiskImage::ExtentTable::findOrCreate(uint64_t extent)
+{
+    panic_if(extent >> (Levels * RadixBits),
+             "Extent %d is beyond what the COW table can hold.", extent);
+
+    Node *node = &root;
+    for (unsigned level = Levels - 1; level > 0; level--) {
+        auto &child = node->children[index(extent, level)];
+        if (!child)
+            child.reset(new Node);
+        node = child.get();
+    }
+
+    auto &ext = node->extents[index(extent, 0)];
+    if (!ext)
+        ext.reset(new Extent);
+    return *ext;
+}
+
+bool
+CowDiskImage::ExtentTable::present(uint64_t sector) const
+{
+    const Extent *ext = find(sector / SectorsPerExtent);
+    return ext && ext->valid[sector % SectorsPerExtent];
+}
+
+void
+CowDiskImage::ExtentTable::read(uint64_t sector, uint8_t *data,
+                                unsigned count) const
+{
+    for (unsigned i = 0; i < count; i++, sector++) {
+        const Extent *ext = find(sector / SectorsPerExtent);
+        unsigned idx = sector % SectorsPerExtent;
+        assert(ext && ext->valid[idx]);
+        memcpy(data + i * SectorSize, ext->data + idx * SectorSize,
+               SectorSize);
+    }
+}
+
+void
+CowDiskImage::ExtentTable::write(uint64_t sector, const uint8_t *data,
+                                 unsigned count)
+{
+    for (unsigned i = 0; i < count; i++, sector++) {
+        Extent &ext = findOrCreate(sector / SectorsPerExtent);
+        unsigned idx = sector % SectorsPerExtent;
+        memcpy(ext.data + idx * SectorSize, data + i * SectorSize,
+               SectorSize);
+        if (!ext.valid[idx]) {
+            ext.valid[idx] = true;
+            numSectors++;
+        }
+    }
+}
+
+void
+CowDiskImage::ExtentTable::clear()
+{
+    root = Node();
+    numSectors = 0;
+}
+
+void
+CowDiskImage::ExtentTable::forEach(const Node &node, unsigned level,
+        uint64_t prefix,
+        const std::function<void(uint64_t, const Extent &)> &f) const
+{
+    for (unsigned i = 0; i < (1 << RadixBits); i++) {
+        uint64_t extent = (prefix << RadixBits) | i;
+        if (level > 0) {
+            if (node.children[i])
+                forEach(*node.children[i], level - 1, extent, f);
+        } else if (node.extents[i]) {
+            f(extent, *node.extents[i]);
+        }
+    }
+}
+
+void
+CowDiskImage::ExtentTable::forEach(
+        const std::function<void(uint64_t, const Extent &)> &f) const
+{
+    forEach(root, Levels - 1, 0, f);
+}
+
 CowDiskImage::CowDiskImage(const Params &p)
-    : DiskImage(p), filename(p.image_file), child(p.child), table(NULL)
+    : DiskImage(p), filename(p.image_file), child(p.child),
+      overlay(p.overlay)
 {
-    if (filename.empty()) {
-        initSectorTable(p.table_size);
+    if (overlay) {
+        fatal_if(filename.empty(), "%s: A COW overlay needs an image_file.",
+                 name());
+        fatal_if(p.read_only, "%s: COW overlays can't be read only.",
+                 name());
+        table.reset(new CowOverlay(filename, child->size()));
+        initialized = true;
+    } else if (filename.empty()) {
+        initSectorTable();
     } else {
         if (!open(filename)) {
             if (p.read_only)
                 fatal("could not open read-only file");
-            initSectorTable(p.table_size);
+            initSectorTable();
         }
 
         if (!p.read_only)
@@ -182,20 +563,13 @@ CowDiskImage::CowDiskImage(const Params &p)
     }
 }
 
-CowDiskImage::~CowDiskImage()
-{
-    SectorTable::iterator i = table->begin();
-    SectorTable::iterator end = table->end();
-
-    while (i != end) {
-        delete (*i).second;
-        ++i;
-    }
-}
-
 void
 CowDiskImage::notifyFork()
 {
+    if (overlay)
+        fatal("%s: Can't fork while writing to the COW overlay %s.",
+              name(), filename);
+
     if (!dynamic_cast<const Params &>(params()).read_only &&
         !filename.empty()) {
         inform("Disabling saving of COW image in forked child process.\n");
@@ -258,18 +632,20 @@ CowDiskImage::open(const std::string &file)
 
     uint64_t sector_count;
     SafeReadSwap(stream, sector_count);
-    table = new SectorTable(sector_count);
-
+    if (table)
+        table->clear();
+    else
+        table.reset(new ExtentTable);
 
     for (uint64_t i = 0; i < sector_count; i++) {
         uint64_t offset;
         SafeReadSwap(stream, offset);
 
-        Sector *sector = new Sector;
-        SafeRead(stream, sector, sizeof(Sector));
+        uint8_t data[SectorSize];
+        SafeRead(stream, data, SectorSize);
 
-        assert(table->find(offset) == table->end());
-        (*table)[offset] = sector;
+        assert(!table->present(offset));
+        table->write(offset, data, 1);
     }
 
     stream.close();
@@ -279,9 +655,9 @@ CowDiskImage::open(const std::string &file)
 }
 
 void
-CowDiskImage::initSectorTable(int hash_size)
+CowDiskImage::initSectorTable()
 {
-    table = new SectorTable(hash_size);
+    table.reset(new ExtentTable);
 
     initialized = true;
 }
@@ -320,9 +696,10 @@ CowDiskImage::save() const
     // filename will be set to the empty string to disable saving of
     // the COW image in a forked child process. Save will still be
     // called because there is no easy way to unregister the exit
-    // callback.
-    if (!filename.empty())
-        save(filename);}
+    // callback. Overlays are kept up to date as they're written.
+    if (!filename.empty() && !overlay)
+        save(filename);
+}
 
 void
 CowDiskImage::save(const std::string &file) const
@@ -342,18 +719,19 @@ CowDiskImage::save(const std::string &file) const
     SafeWriteSwap(stream, (uint32_t)VersionMinor);
     SafeWriteSwap(stream, (uint64_t)table->size());
 
-    uint64_t size = table->size();
-    SectorTable::iterator iter = table->begin();
-    SectorTable::iterator end = table->end();
-
-    for (uint64_t i = 0; i < size; i++) {
-        if (iter == end)
-            panic("Incorrect Table Size during save of COW disk image");
+    uint64_t written = 0;
+    table->forEach([&](uint64_t extent, const Extent &ext) {
+        for (unsigned i = 0; i < SectorsPerExtent; i++) {
+            if (!ext.valid[i])
+                continue;
+            SafeWriteSwap(stream, extent * SectorsPerExtent + i);
+            SafeWrite(stream, ext.data + i * SectorSize, SectorSize);
+            written++;
+        }
+    });
 
-        SafeWriteSwap(stream, (uint64_t)(*iter).first);
-        SafeWrite(stream, (*iter).second->data, sizeof(Sector));
-        ++iter;
-    }
+    if (written != table->size())
+        panic("Incorrect Table Size during save of COW disk image");
 
     stream.close();
 }
@@ -361,13 +739,22 @@ CowDiskImage::save(const std::string &file) const
 void
 CowDiskImage::writeback()
 {
-    SectorTable::iterator i = table->begin();
-    SectorTable::iterator end = table->end();
-
-    while (i != end) {
-        child->write((*i).second->data, (*i).first);
-        ++i;
-    }
+    table->forEach([this](uint64_t extent, const Extent &ext) {
+        // Write back each run of valid sectors with a single access.
+        unsigned i = 0;
+        while (i < SectorsPerExtent) {
+            if (!ext.valid[i]) {
+                i++;
+                continue;
+            }
+            unsigned run = 1;
+            while (i + run < SectorsPerExtent && ext.valid[i + run])
+                run++;
+            child->writeSectors(ext.data + i * SectorSize,
+                                extent * SectorsPerExtent + i, run);
+            i += run;
+        }
+    });
 }
 
 std::streampos
@@ -376,6 +763,19 @@ CowDiskImage::size() const
 
 std::streampos
 CowDiskImage::read(uint8_t *data, std::streampos offset) const
+{
+    return readSectors(data, offset, 1);
+}
+
+std::streampos
+CowDiskImage::write(const uint8_t *data, std::streampos offset)
+{
+    return writeSectors(data, offset, 1);
+}
+
+std::streampos
+CowDiskImage::readSectors(uint8_t *data, std::streampos offset,
+                          unsigned count) const
 {
     if (!initialized)
         panic("CowDiskImage not initialized");
@@ -383,19 +783,39 @@ CowDiskImage::read(uint8_t *data, std::streampos offset) const
     if (offset > size())
         panic("access out of bounds");
 
-    SectorTable::const_iterator i = table->find(offset);
-    if (i == table->end())
-        return child->read(data, offset);
-    else {
-        memcpy(data, (*i).second->data, SectorSize);
-        DPRINTF(DiskImageRead, "read: offset=%d\n", (uint64_t)offset);
-        DDUMP(DiskImageRead, data, SectorSize);
-        return SectorSize;
+    uint64_t sector = offset;
+    unsigned done = 0;
+    while (done < count) {
+        // Handle runs of sectors which are or aren't in this layer with a
+        // single access each.
+        uint8_t *dest = data + done * SectorSize;
+        bool in_layer = table->present(sector);
+        unsigned run = 1;
+        while (done + run < count &&
+                table->present(sector + run) == in_layer) {
+            run++;
+        }
+
+        if (in_layer) {
+            table->read(sector, dest, run);
+            DPRINTF(DiskImageRead, "read: offset=%d count=%d\n", sector,
+                    run);
+            DDUMP(DiskImageRead, dest, run * SectorSize);
+        } else {
+            std::streampos bytes = child->readSectors(dest, sector, run);
+            if (bytes != run * SectorSize)
+                return done * SectorSize + bytes;
+        }
+        done += run;
+        sector += run;
     }
+
+    return done * SectorSize;
 }
 
 std::streampos
-CowDiskImage::write(const uint8_t *data, std::streampos offset)
+CowDiskImage::writeSectors(const uint8_t *data, std::streampos offset,
+                           unsigned count)
 {
     if (!initialized)
         panic("RawDiskImage not initialized");
@@ -403,19 +823,13 @@ CowDiskImage::write(const uint8_t *data, std::streampos offset)
     if (offset > size())
         panic("access out of bounds");
 
-    SectorTable::iterator i = table->find(offset);
-    if (i == table->end()) {
-        Sector *sector = new Sector;
-        memcpy(sector, data, SectorSize);
-        table->insert(make_pair(offset, sector));
-    } else {
-        memcpy((*i).second->data, data, SectorSize);
-    }
+    table->write(offset, data, count);
 
-    DPRINTF(DiskImageWrite, "write: offset=%d\n", (uint64_t)offset);
-    DDUMP(DiskImageWrite, data, SectorSize);
+    DPRINTF(DiskImageWrite, "write: offset=%d count=%d\n",
+            (uint64_t)offset, count);
+    DDUMP(DiskImageWrite, data, count * SectorSize);
 
-    return SectorSize;
+    return count * SectorSize;
 }
 
 void
@@ -33,8 +33,13 @@
 #ifndef __DEV_STORAGE_DISK_IMAGE_HH__
 #define __DEV_STORAGE_DISK_IMAGE_HH__
 
+#include <sys/uio.h>
+
+#include <array>
+#include <bitset>
 #include <fstream>
-#include <unordered_map>
+#include <functional>
+#include <memory>
 
 #include "params/CowDiskImage.hh"
 #include "params/DiskImage.hh"
@@ -62,18 +67,50 @@ class DiskImage : public SimObject
                                 std::streampos offset) const = 0;
     virtual std::streampos write(const uint8_t *data,
                                  std::streampos offset) = 0;
+
+    /**
+     * Read or write count consecutive sectors starting at offset. The
+     * default implementations go through the single sector accessors,
+     * images which can do better should override them.
+     *
+     * @return The number of bytes transferred.
+     */
+    virtual std::streampos readSectors(uint8_t *data, std::streampos offset,
+                                       unsigned count) const;
+    virtual std::streampos writeSectors(const uint8_t *data,
+                                        std::streampos offset,
+                                        unsigned count);
+
+    /**
+     * Scatter/gather versions of readSectors() and writeSectors(). The
+     * buffers are used in order and must add up to a whole number of
+     * sectors. The default implementations bounce the data through a
+     * temporary buffer.
+     *
+     * @return The number of bytes transferred.
+     */
+    virtual std::streampos readSectorsv(const struct iovec *iov, int iovcnt,
+                                        std::streampos offset) const;
+    virtual std::streampos writeSectorsv(const struct iovec *iov,
+                                         int iovcnt, std::streampos offset);
 };
 
 /**
- * Specialization for accessing a raw disk image
+ * Specialization for accessing a raw disk image. The image is mapped into
+ * the simulator's address space so sectors are accessed with plain
+ * copies, falling back to pread/pwrite if the file can't be mapped.
  */
 class RawDiskImage : public DiskImage
 {
   protected:
-    mutable std::fstream stream;
+    int fd;
+    uint8_t *mapping;
     std::string file;
     bool readonly;
-    mutable std::streampos disk_size;
+    std::streampos disk_size;
+
+    /** Clamp an access to the end of the image, returning its length. */
+    size_t accessSize(std::streampos offset, unsigned count) const;
 
   public:
     typedef RawDiskImageParams Params;
@@ -89,6 +126,16 @@ class RawDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    std::streampos readSectors(uint8_t *data, std::streampos offset,
+                               unsigned count) const override;
+    std::streampos writeSectors(const uint8_t *data, std::streampos offset,
+                                unsigned count) override;
+
+    std::streampos readSectorsv(const struct iovec *iov, int iovcnt,
+                                std::streampos offset) const override;
+    std::streampos writeSectorsv(const struct iovec *iov, int iovcnt,
+                                 std::streampos offset) override;
 };
 
 /**
@@ -100,6 +147,8 @@ class RawDiskImage : public DiskImage
  * This object is designed to provide a mechanism for persistant
  * changes to a main disk image, or to provide a place for temporary
  * changes to the image to take place that later may be thrown away.
+ * The layer is normally held in memory and saved to image_file at exit,
+ * or, if overlay is set, kept in image_file as a CowOverlay.
  */
 class CowDiskImage : public DiskImage
 {
@@ -107,25 +156,102 @@ class CowDiskImage : public DiskImage
     static const uint32_t VersionMajor;
     static const uint32_t VersionMinor;
 
+    /** Sectors are stored in 64 KiB extents. */
+    static const unsigned SectorsPerExtent = 128;
+
+    struct Extent {
+        /** Which sectors of the extent have been written to this layer. */
+        std::bitset<SectorsPerExtent> valid;
+        uint8_t data[SectorsPerExtent * SectorSize];
+    };
+
+    /** Storage for the sectors written to a copy-on-write layer. */
+    class ExtentStore
+    {
+      public:
+        virtual ~ExtentStore() {}
+
+        /** Whether a sector has been written to this layer. */
+        virtual bool present(uint64_t sector) const = 0;
+        /** Read count sectors, all of which have to be present. */
+        virtual void read(uint64_t sector, uint8_t *data,
+                          unsigned count) const = 0;
+        virtual void write(uint64_t sector, const uint8_t *data,
+                           unsigned count) = 0;
+        /** Drop every sector written so far. */
+        virtual void clear() = 0;
+
+        /** Number of sectors held by the store. */
+        virtual uint64_t size() const = 0;
+
+        /** Call f for every extent in increasing extent order. */
+        virtual void forEach(
+            const std::function<void(uint64_t, const Extent &)> &f)
+            const = 0;
+    };
+
   protected:
-    struct Sector {
-        uint8_t data[SectorSize];
+    /**
+     * Radix tree of the extents written to this layer, indexed by the
+     * extent number. Every level consumes RadixBits of it, which covers
+     * images of up to 2^(Levels * RadixBits) extents.
+     */
+    class ExtentTable : public ExtentStore
+    {
+      public:
+        static const unsigned RadixBits = 8;
+        static const unsigned Levels = 4;
+
+      protected:
+        struct Node
+        {
+            std::array<std::unique_ptr<Node>, 1 << RadixBits> children;
+            std::array<std::unique_ptr<Extent>, 1 << RadixBits> extents;
+        };
+
+        Node root;
+        uint64_t numSectors;
+
+        static unsigned index(uint64_t extent, unsigned level);
+        void forEach(const Node &node, unsigned level, uint64_t prefix,
+                const std::function<void(uint64_t, const Extent &)> &f)
+            const;
+
+        /** Look up an extent, returning nullptr if it isn't present. */
+        const Extent *find(uint64_t extent) const;
+        /** Look up an extent, allocating an empty one if needed. */
+        Extent &findOrCreate(uint64_t extent);
+
+      public:
+        ExtentTable() : numSectors(0) {}
+
+        bool present(uint64_t sector) const override;
+        void read(uint64_t sector, uint8_t *data,
+                  unsigned count) const override;
+        void write(uint64_t sector, const uint8_t *data,
+                   unsigned count) override;
+        void clear() override;
+
+        uint64_t size() const override { return numSectors; }
+
+        void forEach(const std::function<void(uint64_t, const Extent &)> &f)
+            const override;
     };
-    typedef std::unordered_map<uint64_t, Sector *> SectorTable;
 
   protected:
     std::string filename;
     DiskImage *child;
-    SectorTable *table;
+    std::unique_ptr<ExtentStore> table;
+    /** Whether the layer lives in a CowOverlay file rather than memory. */
+    bool overlay;
 
   public:
     typedef CowDiskImageParams Params;
     CowDiskImage(const Params &p);
-    ~CowDiskImage();
 
     void notifyFork() override;
 
-    void initSectorTable(int hash_size);
+    void initSectorTable();
     bool open(const std::string &file);
     void save() const;
     void save(const std::string &file) const;
@@ -138,6 +264,11 @@ class CowDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    std::streampos readSectors(uint8_t *data, std::streampos offset,
+                               unsigned count) const override;
+    std::streampos writeSectors(const uint8_t *data, std::streampos offset,
+                                unsigned count) override;
 };
 
 void SafeRead(std::ifstream &stream, void *data, int count);
@@ -44,5 +44,7 @@ class VirtIOBlock(VirtIODeviceBase):
     cxx_header = 'dev/virtio/block.hh'
 
     queueSize = Param.Unsigned(128, "Output queue size (pages)")
+    numQueues = Param.Unsigned(1, "Number of request queues, guests "
+                               "normally use one per CPU")
 
     image = Param.DiskImage("Disk image")
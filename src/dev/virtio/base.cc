@@ -37,6 +37,8 @@
 
 #include "dev/virtio/base.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/VIO.hh"
 #include "params/VirtIODeviceBase.hh"
@@ -211,6 +213,50 @@ VirtDescriptor::chainWrite(size_t offset, const uint8_t *src, size_t size)
     }
 }
 
+bool
+VirtDescriptor::chainHostIov(size_t offset, size_t size, bool write,
+                             std::vector<struct iovec> &iov) const
+{
+    const VirtDescriptor *desc(this);
+    const size_t full_size(size);
+    const size_t first(iov.size());
+    do {
+        if (offset < desc->size()) {
+            if (write ? !desc->isOutgoing() : !desc->isIncoming())
+                panic("Trying to map a descriptor in the wrong direction\n");
+
+            const size_t chunk_size(std::min(desc->size() - offset, size));
+            uint8_t *ptr(desc->memProxy->hostPtrPhys(
+                             desc->desc.addr + offset, chunk_size, write));
+            if (!ptr) {
+                iov.resize(first);
+                return false;
+            }
+
+            // Guests frequently split physically contiguous buffers
+            // into several descriptors, merge them back together.
+            if (iov.size() > first &&
+                (uint8_t *)iov.back().iov_base + iov.back().iov_len == ptr) {
+                iov.back().iov_len += chunk_size;
+            } else {
+                iov.push_back({ ptr, chunk_size });
+            }
+            size -= chunk_size;
+            offset = 0;
+        } else {
+            offset -= desc->size();
+        }
+    } while ((desc = desc->next()) != NULL &&
+             (write || desc->isIncoming()) && size > 0);
+
+    if (size != 0) {
+        panic("Failed to map %i bytes of chain of %i bytes @ offset %i\n",
+              full_size, chainSize(), offset);
+    }
+
+    return true;
+}
+
 size_t
 VirtDescriptor::chainSize() const
 {
@@ -490,6 +536,15 @@ VirtIODeviceBase::registerQueue(VirtQueue &queue)
     _queues.push_back(&queue);
 }
 
+void
+VirtIODeviceBase::kick(const VirtQueue &queue)
+{
+    assert(transKick);
+    auto it = std::find(_queues.begin(), _queues.end(), &queue);
+    assert(it != _queues.end());
+    transKick(it - _queues.begin());
+}
+
 
 VirtIODummyDevice::VirtIODummyDevice(const VirtIODummyDeviceParams &params)
     : VirtIODeviceBase(params, ID_INVALID, 0, 0)
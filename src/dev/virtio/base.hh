@@ -38,6 +38,8 @@
 #ifndef __DEV_VIRTIO_BASE_HH__
 #define __DEV_VIRTIO_BASE_HH__
 
+#include <sys/uio.h>
+
 #include <cstdint>
 #include <functional>
 #include <vector>
@@ -251,6 +253,25 @@ class VirtDescriptor
      * @param size Size (in bytes).
      */
     void chainWrite(size_t offset, const uint8_t *src, size_t size);
+    /**
+     * Resolve part of a descriptor chain into host memory.
+     *
+     * This method follows the descriptor chain the same way as
+     * chainRead() and chainWrite(), but instead of copying the data it
+     * appends pointers to the guest's buffers to a list of iovecs. This
+     * allows devices to transfer data directly between guest memory and
+     * host files, e.g., using preadv()/pwritev().
+     *
+     * @param offset Offset into the chain (in bytes).
+     * @param size Size (in bytes).
+     * @param write true if the device is going to write to the buffers.
+     * @param iov List to append the host buffers to.
+     * @return false if some of the data isn't backed by host memory, in
+     * which case iov is left untouched and the device needs to fall
+     * back to chainRead()/chainWrite().
+     */
+    bool chainHostIov(size_t offset, size_t size, bool write,
+                      std::vector<struct iovec> &iov) const;
     /**
      * Retrieve the size of this descriptor chain.
      *
@@ -624,13 +645,13 @@ class VirtIODeviceBase : public SimObject
      * method used to inform the guest is transport dependent, but is
      * typically through an interrupt. Device models call this method
      * to tell the transport interface to notify the guest.
+     *
+     * The queue is passed on to the transport, which allows transports
+     * with more than one interrupt to route the notification.
+     *
+     * @param queue Queue the guest should look at.
      */
-    void
-    kick()
-    {
-        assert(transKick);
-        transKick();
-    };
+    void kick(const VirtQueue &queue);
 
     /**
      * Register a new VirtQueue with the device model.
@@ -747,10 +768,11 @@ class VirtIODeviceBase : public SimObject
       * Register a callback to kick the guest through the transport
       * interface.
       *
-      * @param callback Callback into transport interface.
+      * @param callback Callback into transport interface, it gets the
+      *                 ID of the queue which was updated.
       */
     void
-    registerKickCallback(const std::function<void()> &callback)
+    registerKickCallback(const std::function<void(QueueID)> &callback)
     {
         assert(!transKick);
         transKick = callback;
@@ -891,7 +913,7 @@ class VirtIODeviceBase : public SimObject
     std::vector<VirtQueue *> _queues;
 
     /** Callbacks to kick the guest through the transport layer  */
-    std::function<void()> transKick;
+    std::function<void(QueueID)> transKick;
 };
 
 class VirtIODummyDevice : public VirtIODeviceBase
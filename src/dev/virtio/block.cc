@@ -37,19 +37,35 @@
 
 #include "dev/virtio/block.hh"
 
+#include <cstring>
+
+#include "base/cprintf.hh"
 #include "debug/VIOBlock.hh"
 #include "params/VirtIOBlock.hh"
 #include "sim/system.hh"
 
 VirtIOBlock::VirtIOBlock(const Params &params)
-    : VirtIODeviceBase(params, ID_BLOCK, sizeof(Config), 0),
-      qRequests(params.system->physProxy, byteOrder,
-                params.queueSize, *this),
+    : VirtIODeviceBase(params, ID_BLOCK, sizeof(Config),
+                       params.numQueues > 1 ? F_MQ : 0),
       image(*params.image)
 {
-    registerQueue(qRequests);
+    fatal_if(params.numQueues == 0 || params.numQueues > 0xffff,
+             "%s: Unsupported number of request queues (%i).\n",
+             name(), params.numQueues);
+
+    for (unsigned i = 0; i < params.numQueues; ++i) {
+        const std::string q_name(params.numQueues > 1 ?
+                                 csprintf("%s.qRequests%i", name(), i) :
+                                 name() + ".qRequests");
+        qRequests.emplace_back(new RequestQueue(
+            params.system->physProxy, byteOrder, params.queueSize, *this,
+            q_name));
+        registerQueue(*qRequests.back());
+    }
 
+    memset(&config, 0, sizeof(config));
     config.capacity = image.size();
+    config.num_queues = params.numQueues;
 }
 
 
@@ -60,8 +76,9 @@ VirtIOBlock::~VirtIOBlock()
 void
 VirtIOBlock::readConfig(PacketPtr pkt, Addr cfgOffset)
 {
-    Config cfg_out;
+    Config cfg_out(config);
     cfg_out.capacity = htog(config.capacity, byteOrder);
+    cfg_out.num_queues = htog(config.num_queues, byteOrder);
 
     readConfigBlob(pkt, cfgOffset, (uint8_t *)&cfg_out);
 }
@@ -70,7 +87,6 @@ VirtIOBlock::Status
 VirtIOBlock::read(const BlkRequest &req, VirtDescriptor *desc_chain,
                   size_t off_data, size_t size)
 {
-    std::vector<uint8_t> data(size);
     uint64_t sector(req.sector);
 
     DPRINTF(VIOBlock, "Read request starting @ sector %i (size: %i)\n",
@@ -79,12 +95,23 @@ VirtIOBlock::read(const BlkRequest &req, VirtDescriptor *desc_chain,
     if (size % SectorSize != 0)
         panic("Unexpected request/sector size relationship\n");
 
-    for (Addr offset = 0; offset < size; offset += SectorSize) {
-        if (image.read(&data[offset], sector) != SectorSize) {
-            warn("Failed to read sector %i\n", sector);
+    // Read straight into the guest's buffers if they are backed by host
+    // memory.
+    std::vector<struct iovec> iov;
+    if (desc_chain->chainHostIov(off_data, size, true, iov)) {
+        if (image.readSectorsv(iov.data(), iov.size(), sector) != size) {
+            warn("Failed to read sectors %i-%i\n", sector,
+                 sector + size / SectorSize - 1);
             return S_IOERR;
         }
-        ++sector;
+        return S_OK;
+    }
+
+    std::vector<uint8_t> data(size);
+    if (image.readSectors(&data[0], sector, size / SectorSize) != size) {
+        warn("Failed to read sectors %i-%i\n", sector,
+             sector + size / SectorSize - 1);
+        return S_IOERR;
     }
 
     desc_chain->chainWrite(off_data, &data[0], size);
@@ -96,7 +123,6 @@ VirtIOBlock::Status
 VirtIOBlock::write(const BlkRequest &req, VirtDescriptor *desc_chain,
                   size_t off_data, size_t size)
 {
-    std::vector<uint8_t> data(size);
     uint64_t sector(req.sector);
 
     DPRINTF(VIOBlock, "Write request starting @ sector %i (size: %i)\n",
@@ -105,15 +131,23 @@ VirtIOBlock::write(const BlkRequest &req, VirtDescriptor *desc_chain,
     if (size % SectorSize != 0)
         panic("Unexpected request/sector size relationship\n");
 
+    std::vector<struct iovec> iov;
+    if (desc_chain->chainHostIov(off_data, size, false, iov)) {
+        if (image.writeSectorsv(iov.data(), iov.size(), sector) != size) {
+            warn("Failed to write sectors %i-%i\n", sector,
+                 sector + size / SectorSize - 1);
+            return S_IOERR;
+        }
+        return S_OK;
+    }
 
+    std::vector<uint8_t> data(size);
     desc_chain->chainRead(off_data, &data[0], size);
 
-    for (Addr offset = 0; offset < size; offset += SectorSize) {
-        if (image.write(&data[offset], sector) != SectorSize) {
-            warn("Failed to write sector %i\n", sector);
-            return S_IOERR;
-        }
-        ++sector;
+    if (image.writeSectors(&data[0], sector, size / SectorSize) != size) {
+        warn("Failed to write sectors %i-%i\n", sector,
+             sector + size / SectorSize - 1);
+        return S_IOERR;
     }
 
     return S_OK;
@@ -162,5 +196,5 @@ VirtIOBlock::RequestQueue::onNotifyDescriptor(VirtDescriptor *desc)
 
     // Tell the guest that we are done with this descriptor.
     produceDescriptor(desc, sizeof(BlkRequest) + data_size + sizeof(Status));
-    parent.kick();
+    parent.kick(*this);
 }
@@ -38,6 +38,10 @@
 #ifndef __DEV_VIRTIO_BLOCK_HH__
 #define __DEV_VIRTIO_BLOCK_HH__
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "dev/virtio/base.hh"
 #include "dev/storage/disk_image.hh"
 
@@ -48,6 +52,10 @@ struct VirtIOBlockParams;
  *
  * The block device uses the following queues:
  *  -# Requests
+ *  -# Additional request queues (if F_MQ has been negotiated)
+ *
+ * All request queues are equivalent, multi-queue capable guests
+ * typically use one queue per CPU to avoid lock contention.
  *
  * A guest issues a request by creating a descriptor chain that starts
  * with a BlkRequest. Immediately after the BlkRequest follows the
@@ -83,6 +91,24 @@ class VirtIOBlock : public VirtIODeviceBase
      */
     struct M5_ATTR_PACKED Config {
         uint64_t capacity;
+        uint32_t size_max;
+        uint32_t seg_max;
+        struct M5_ATTR_PACKED {
+            uint16_t cylinders;
+            uint8_t heads;
+            uint8_t sectors;
+        } geometry;
+        uint32_t blk_size;
+        struct M5_ATTR_PACKED {
+            uint8_t physical_block_exp;
+            uint8_t alignment_offset;
+            uint16_t min_io_size;
+            uint32_t opt_io_size;
+        } topology;
+        uint8_t writeback;
+        uint8_t unused0;
+        /** Number of request queues, valid if F_MQ is offered */
+        uint16_t num_queues;
     };
     Config config;
 
@@ -95,6 +121,7 @@ class VirtIOBlock : public VirtIODeviceBase
     static const FeatureBits F_RO = (1 << 5);
     static const FeatureBits F_BLK_SIZE = (1 << 6);
     static const FeatureBits F_TOPOLOGY = (1 << 10);
+    static const FeatureBits F_MQ = (1 << 12);
     /** @} */
 
     /** @{
@@ -162,20 +189,22 @@ class VirtIOBlock : public VirtIODeviceBase
     {
       public:
         RequestQueue(PortProxy &proxy, ByteOrder bo,
-                uint16_t size, VirtIOBlock &_parent)
-            : VirtQueue(proxy, bo, size), parent(_parent) {}
+                uint16_t size, VirtIOBlock &_parent,
+                const std::string &_name)
+            : VirtQueue(proxy, bo, size), parent(_parent), _name(_name) {}
         virtual ~RequestQueue() {}
 
         void onNotifyDescriptor(VirtDescriptor *desc);
 
-        std::string name() const { return parent.name() + ".qRequests"; }
+        std::string name() const { return _name; }
 
       protected:
         VirtIOBlock &parent;
+        const std::string _name;
     };
 
-    /** Device I/O request queue */
-    RequestQueue qRequests;
+    /** Device I/O request queues */
+    std::vector<std::unique_ptr<RequestQueue>> qRequests;
 
     /** Image backing this device */
     DiskImage &image;
@@ -90,7 +90,7 @@ VirtIOConsole::TermRecvQueue::trySend()
 
         // Tell the guest that we are done with this descriptor.
         produceDescriptor(d, len);
-        parent.kick();
+        parent.kick(*this);
     }
 }
 
@@ -110,5 +110,5 @@ VirtIOConsole::TermTransQueue::onNotifyDescriptor(VirtDescriptor *desc)
 
     // Tell the guest that we are done with this descriptor.
     produceDescriptor(desc, 0);
-    parent.kick();
+    parent.kick(*this);
 }
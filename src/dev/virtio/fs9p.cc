@@ -160,32 +160,51 @@ VirtIO9PBase::FSQueue::onNotifyDescriptor(VirtDescriptor *desc)
     parent.recvTMsg(header, data, sizeof(data));
 }
 
+VirtDescriptor *
+VirtIO9PBase::rMsgDescriptor(P9Tag tag)
+{
+    // Find the first output descriptor
+    VirtDescriptor *out_desc(pendingTransactions[tag]);
+    while (out_desc && !out_desc->isOutgoing())
+        out_desc = out_desc->next();
+    if (!out_desc)
+        panic("sendRMsg: Framing error, no output descriptor.\n");
+
+    return out_desc;
+}
+
+bool
+VirtIO9PBase::rMsgHostIov(const P9MsgHeader &header, size_t size,
+                          std::vector<struct iovec> &iov)
+{
+    if (DTRACE(VIO9PData))
+        return false;
+
+    return rMsgDescriptor(header.tag)->chainHostIov(
+        sizeof(P9MsgHeader), size, true, iov);
+}
+
 void
 VirtIO9PBase::sendRMsg(const P9MsgHeader &header, const uint8_t *data, size_t size)
 {
     DPRINTF(VIO9P, "Sending RMsg\n");
-    dumpMsg(header, data, size);
+    dumpMsg(header, data, data ? size : 0);
     DPRINTF(VIO9P, "\tPending transactions: %i\n", pendingTransactions.size());
     assert(header.len >= sizeof(header));
 
+    VirtDescriptor *out_desc(rMsgDescriptor(header.tag));
     VirtDescriptor *main_desc(pendingTransactions[header.tag]);
     pendingTransactions.erase(header.tag);
 
-    // Find the first output descriptor
-    VirtDescriptor *out_desc(main_desc);
-    while (out_desc && !out_desc->isOutgoing())
-        out_desc = out_desc->next();
-    if (!out_desc)
-        panic("sendRMsg: Framing error, no output descriptor.\n");
-
     P9MsgHeader header_out(htop9(header));
     header_out.len = htop9(sizeof(P9MsgHeader) + size);
 
     out_desc->chainWrite(0, (uint8_t *)&header_out, sizeof(header_out));
-    out_desc->chainWrite(sizeof(header_out), data, size);
+    if (data)
+        out_desc->chainWrite(sizeof(header_out), data, size);
 
     queue.produceDescriptor(main_desc, sizeof(P9MsgHeader) + size);
-    kick();
+    kick(queue);
 }
 
 void
@@ -271,6 +290,16 @@ VirtIO9PProxy::serverDataReady()
     const ssize_t payload_len(header.len - sizeof(header));
     if (payload_len < 0)
         panic("Payload length is negative!\n");
+    // Receive the payload straight into the guest's buffers if
+    // possible.
+    std::vector<struct iovec> iov;
+    if (rMsgHostIov(header, payload_len, iov)) {
+        for (const auto &v : iov)
+            readAll((uint8_t *)v.iov_base, v.iov_len);
+        sendRMsg(header, nullptr, payload_len);
+        return;
+    }
+
     uint8_t data[payload_len];
     readAll(data, payload_len);
 
@@ -41,6 +41,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/pollevent.hh"
 #include "dev/virtio/base.hh"
@@ -173,10 +174,25 @@ class VirtIO9PBase : public VirtIODeviceBase
      * Send a 9p RPC message reply.
      *
      * @param header 9p message header.
-     * @param data Pointer to data in message.
+     * @param data Pointer to data in message, or nullptr if the data
+     *             has already been stored in the buffers returned by
+     *             rMsgHostIov().
      * @param size Size of data (excluding header)
      */
     void sendRMsg(const P9MsgHeader &header, const uint8_t *data, size_t size);
+    /**
+     * Get the guest buffers the data of a 9p RPC message reply goes
+     * into, allowing transports to receive replies without copying.
+     *
+     * @param header 9p message header.
+     * @param size Size of data (excluding header)
+     * @param iov List to append the host buffers to.
+     * @return false if the buffers aren't backed by host memory or the
+     * message data is being traced, in which case the data has to be
+     * passed to sendRMsg().
+     */
+    bool rMsgHostIov(const P9MsgHeader &header, size_t size,
+                     std::vector<struct iovec> &iov);
 
     /**
      * Dump a 9p RPC message on the debug output
@@ -188,6 +204,9 @@ class VirtIO9PBase : public VirtIODeviceBase
     void dumpMsg(const P9MsgHeader &header, const uint8_t *data, size_t size);
 
   private:
+    /** Find the first descriptor the reply to a transaction goes in. */
+    VirtDescriptor *rMsgDescriptor(P9Tag tag);
+
     /**
      * Map between 9p transaction tags and descriptors where they
      * appeared.
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dev/virtio/net.hh"
+
+#include <cstring>
+
+#include "base/cprintf.hh"
+#include "base/inet.hh"
+#include "base/trace.hh"
+#include "debug/VIONet.hh"
+#include "params/VirtIONet.hh"
+#include "sim/system.hh"
+
+VirtIONet::VirtIONet(const Params &params)
+    : VirtIODeviceBase(params, ID_NET, sizeof(Config),
+                       F_MAC | (params.numQueuePairs > 1 ?
+                                F_CTRL_VQ | F_MQ : 0)),
+      interface(name() + ".int0", *this),
+      activePairs(1), txNext(0), stats(this)
+{
+    fatal_if(params.numQueuePairs == 0 || params.numQueuePairs > 0x8000,
+             "%s: Unsupported number of queue pairs (%i).\n",
+             name(), params.numQueuePairs);
+
+    // The queue order is fixed by the specification: receive and
+    // transmit queues alternate, the control queue comes last.
+    PortProxy &proxy(params.system->physProxy);
+    for (unsigned i = 0; i < params.numQueuePairs; ++i) {
+        rxQueues.emplace_back(new RxQueue(
+            proxy, byteOrder, params.queueSize, params.rxFifoSize, *this,
+            csprintf("%s.qRx%i", name(), i)));
+        registerQueue(*rxQueues.back());
+
+        txQueues.emplace_back(new TxQueue(
+            proxy, byteOrder, params.queueSize, *this,
+            csprintf("%s.qTx%i", name(), i)));
+        registerQueue(*txQueues.back());
+    }
+
+    if (deviceFeatures & F_CTRL_VQ) {
+        qCtrl.reset(new CtrlQueue(proxy, byteOrder, params.ctrlQueueSize,
+                                  *this));
+        registerQueue(*qCtrl);
+    }
+
+    memset(&config, 0, sizeof(config));
+    memcpy(config.mac, params.hardware_address.bytes(), sizeof(config.mac));
+    config.max_virtqueue_pairs = params.numQueuePairs;
+}
+
+VirtIONet::~VirtIONet()
+{
+}
+
+void
+VirtIONet::readConfig(PacketPtr pkt, Addr cfgOffset)
+{
+    Config cfg_out(config);
+    cfg_out.status = htog(config.status, byteOrder);
+    cfg_out.max_virtqueue_pairs = htog(config.max_virtqueue_pairs,
+                                       byteOrder);
+
+    readConfigBlob(pkt, cfgOffset, (uint8_t *)&cfg_out);
+}
+
+void
+VirtIONet::reset()
+{
+    VirtIODeviceBase::reset();
+
+    for (auto &q : rxQueues)
+        q->fifo.clear();
+    activePairs = 1;
+    txNext = 0;
+    txPacket = nullptr;
+}
+
+Port &
+VirtIONet::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "interface")
+        return interface;
+    return VirtIODeviceBase::getPort(if_name, idx);
+}
+
+void
+VirtIONet::serialize(CheckpointOut &cp) const
+{
+    VirtIODeviceBase::serialize(cp);
+
+    SERIALIZE_SCALAR(activePairs);
+    SERIALIZE_SCALAR(txNext);
+
+    bool txPacketExists = txPacket != nullptr;
+    SERIALIZE_SCALAR(txPacketExists);
+    if (txPacketExists)
+        txPacket->serialize("txPacket", cp);
+
+    for (unsigned i = 0; i < rxQueues.size(); ++i)
+        rxQueues[i]->fifo.serialize(csprintf("rxFifo%i", i), cp);
+}
+
+void
+VirtIONet::unserialize(CheckpointIn &cp)
+{
+    VirtIODeviceBase::unserialize(cp);
+
+    UNSERIALIZE_SCALAR(activePairs);
+    UNSERIALIZE_SCALAR(txNext);
+
+    bool txPacketExists;
+    UNSERIALIZE_SCALAR(txPacketExists);
+    txPacket = nullptr;
+    if (txPacketExists) {
+        txPacket = std::make_shared<EthPacketData>();
+        txPacket->unserialize("txPacket", cp);
+    }
+
+    for (unsigned i = 0; i < rxQueues.size(); ++i)
+        rxQueues[i]->fifo.unserialize(csprintf("rxFifo%i", i), cp);
+}
+
+unsigned
+VirtIONet::rxQueueIndex(const EthPacketPtr &pkt) const
+{
+    if (activePairs == 1)
+        return 0;
+
+    Net::IpPtr ip(pkt);
+    if (!ip)
+        return 0;
+
+    uint32_t hash = ip->src() ^ ip->dst();
+    Net::TcpPtr tcp(ip);
+    Net::UdpPtr udp(ip);
+    if (tcp)
+        hash ^= (tcp->sport() << 16) | tcp->dport();
+    else if (udp)
+        hash ^= (udp->sport() << 16) | udp->dport();
+
+    // Mix the bits so nearby addresses and ports end up on different
+    // queues.
+    hash *= 0x9e3779b1;
+    return (hash >> 16) % activePairs;
+}
+
+bool
+VirtIONet::recvPacket(EthPacketPtr pkt)
+{
+    stats.rxBytes += pkt->length;
+    stats.rxPackets++;
+
+    if (!getDeviceStatus().driver_ok) {
+        DPRINTF(VIONet, "Driver not ready, packet dropped\n");
+        stats.rxDrops++;
+        return true;
+    }
+
+    RxQueue &q(*rxQueues[rxQueueIndex(pkt)]);
+    DPRINTF(VIONet, "Received packet (len: %i) for %s\n",
+            pkt->length, q.name());
+    if (!q.fifo.push(pkt)) {
+        DPRINTF(VIONet, "Receive FIFO full, packet dropped\n");
+        stats.rxDrops++;
+        return false;
+    }
+
+    q.deliver();
+    return true;
+}
+
+void
+VirtIONet::RxQueue::deliver()
+{
+    bool produced(false);
+    while (!fifo.empty()) {
+        VirtDescriptor *desc(consumeDescriptor());
+        if (!desc)
+            break;
+
+        EthPacketPtr pkt(fifo.front());
+        fifo.pop();
+
+        uint32_t len(0);
+        if (desc->chainSize() >= sizeof(NetHeader) + pkt->length) {
+            // No offloads, so all fields are zero: a complete packet
+            // which doesn't need a checksum or segmentation.
+            NetHeader hdr;
+            memset(&hdr, 0, sizeof(hdr));
+            desc->chainWrite(0, (uint8_t *)&hdr, sizeof(hdr));
+            desc->chainWrite(sizeof(hdr), pkt->data, pkt->length);
+            len = sizeof(hdr) + pkt->length;
+        } else {
+            DPRINTF(VIONet, "Buffer too small (%i) for packet (%i)\n",
+                    desc->chainSize(), pkt->length);
+            parent.stats.rxDrops++;
+        }
+
+        // A zero length tells the guest the buffer wasn't used.
+        produceDescriptor(desc, len);
+        produced = true;
+    }
+
+    if (produced)
+        parent.kick(*this);
+}
+
+void
+VirtIONet::transmit()
+{
+    while (true) {
+        if (txPacket) {
+            if (!interface.sendPacket(txPacket)) {
+                DPRINTF(VIONet, "Link busy, waiting to transmit\n");
+                return;
+            }
+            txPacket = nullptr;
+        }
+
+        // Find the next queue with a pending packet.
+        VirtDescriptor *desc(nullptr);
+        TxQueue *q(nullptr);
+        for (unsigned i = 0; i < txQueues.size() && !desc; ++i) {
+            q = txQueues[(txNext + i) % txQueues.size()].get();
+            desc = q->consumeDescriptor();
+        }
+        if (!desc)
+            return;
+        txNext = (txNext + 1) % txQueues.size();
+
+        const size_t size(desc->chainSize());
+        if (size > sizeof(NetHeader)) {
+            const unsigned len(size - sizeof(NetHeader));
+            txPacket = std::make_shared<EthPacketData>(len);
+            txPacket->length = len;
+            txPacket->simLength = len;
+            desc->chainRead(sizeof(NetHeader), txPacket->data, len);
+
+            DPRINTF(VIONet, "Transmitting packet (len: %i) from %s\n",
+                    len, q->name());
+            stats.txBytes += len;
+            stats.txPackets++;
+        } else {
+            warn("%s: Ignoring empty packet.\n", q->name());
+        }
+
+        // The packet has been copied, so the buffer can be returned to
+        // the guest before the packet leaves.
+        q->produceDescriptor(desc, 0);
+        kick(*q);
+    }
+}
+
+void
+VirtIONet::CtrlQueue::onNotifyDescriptor(VirtDescriptor *desc)
+{
+    CtrlHeader hdr;
+    desc->chainRead(0, (uint8_t *)&hdr, sizeof(hdr));
+    const size_t size(desc->chainSize());
+
+    CtrlStatus status(CTRL_ERR);
+    if (hdr.cls == CTRL_MQ && hdr.cmd == CTRL_MQ_VQ_PAIRS_SET &&
+        size >= sizeof(hdr) + sizeof(uint16_t) + sizeof(status)) {
+        uint16_t pairs;
+        desc->chainRead(sizeof(hdr), (uint8_t *)&pairs, sizeof(pairs));
+        pairs = gtoh(pairs, byteOrder);
+        if (pairs >= 1 && pairs <= parent.rxQueues.size()) {
+            DPRINTF(VIONet, "Using %i queue pairs\n", pairs);
+            parent.activePairs = pairs;
+            status = CTRL_OK;
+        }
+    } else {
+        DPRINTF(VIONet, "Unsupported control command %i:%i\n",
+                hdr.cls, hdr.cmd);
+    }
+
+    // The status is in the last byte of the chain.
+    desc->chainWrite(size - sizeof(status), &status, sizeof(status));
+    produceDescriptor(desc, sizeof(status));
+    parent.kick(*this);
+}
+
+VirtIONet::VirtIONetStats::VirtIONetStats(Stats::Group *parent)
+    : Stats::Group(parent),
+      ADD_STAT(txBytes, UNIT_BYTE, "Bytes Transmitted"),
+      ADD_STAT(rxBytes, UNIT_BYTE, "Bytes Received"),
+      ADD_STAT(txPackets, UNIT_COUNT, "Number of Packets Transmitted"),
+      ADD_STAT(rxPackets, UNIT_COUNT, "Number of Packets Received"),
+      ADD_STAT(rxDrops, UNIT_COUNT, "Number of received packets dropped")
+{
+}
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __DEV_VIRTIO_NET_HH__
+#define __DEV_VIRTIO_NET_HH__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "dev/net/etherint.hh"
+#include "dev/net/etherpkt.hh"
+#include "dev/net/pktfifo.hh"
+#include "dev/virtio/base.hh"
+
+struct VirtIONetParams;
+
+/**
+ * VirtIO network device
+ *
+ * The network device uses the following queues:
+ *  -# Receive queue 0
+ *  -# Transmit queue 0
+ *  -# Receive and transmit queues 1 to N-1 (if F_MQ is offered)
+ *  -# Control queue (if F_CTRL_VQ is offered)
+ *
+ * Every packet is preceded by a NetHeader in both directions. The
+ * device doesn't offer any offloads, so the header only tells the
+ * guest that received packets are complete and unsegmented.
+ *
+ * Packets received from the wire are spread over the active receive
+ * queues by hashing their addresses and ports, which keeps each flow
+ * on a single queue. A packet which can't be delivered right away
+ * because the guest hasn't posted any buffers waits in a small FIFO
+ * belonging to its queue, and is dropped if that FIFO overflows.
+ *
+ * Transmitted packets are sent as soon as the link is ready, the
+ * transmit queues are served round robin.
+ *
+ * @see http://docs.oasis-open.org/virtio/virtio/v1.0/virtio-v1.0.html
+ */
+class VirtIONet : public VirtIODeviceBase
+{
+  public:
+    typedef VirtIONetParams Params;
+    VirtIONet(const Params &params);
+    virtual ~VirtIONet();
+
+    void readConfig(PacketPtr pkt, Addr cfgOffset) override;
+    void reset() override;
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+  protected:
+    static const DeviceId ID_NET = 0x01;
+
+    /**
+     * Network device configuration structure
+     *
+     * @note This needs to be changed if the supported feature set
+     * changes!
+     */
+    struct M5_ATTR_PACKED Config {
+        uint8_t mac[6];
+        uint16_t status;
+        /** Number of queue pairs, valid if F_MQ is offered */
+        uint16_t max_virtqueue_pairs;
+    };
+    Config config;
+
+    /** @{
+     * @name Feature bits
+     */
+    static const FeatureBits F_MAC = (1 << 5);
+    static const FeatureBits F_CTRL_VQ = (1 << 17);
+    static const FeatureBits F_MQ = (1 << 22);
+    /** @} */
+
+    /** Header preceding every packet */
+    struct M5_ATTR_PACKED NetHeader {
+        uint8_t flags;
+        uint8_t gso_type;
+        uint16_t hdr_len;
+        uint16_t gso_size;
+        uint16_t csum_start;
+        uint16_t csum_offset;
+    };
+
+    /** @{
+     * @name Control queue commands
+     */
+    /** Header of a control queue request */
+    struct M5_ATTR_PACKED CtrlHeader {
+        uint8_t cls;
+        uint8_t cmd;
+    };
+
+    typedef uint8_t CtrlStatus;
+    static const CtrlStatus CTRL_OK = 0;
+    static const CtrlStatus CTRL_ERR = 1;
+
+    /** Multiqueue control class */
+    static const uint8_t CTRL_MQ = 4;
+    /** Set the number of active queue pairs */
+    static const uint8_t CTRL_MQ_VQ_PAIRS_SET = 0;
+    /** @} */
+
+    /** Handle a packet from the wire. */
+    bool recvPacket(EthPacketPtr pkt);
+    /** Send as many packets as the link accepts. */
+    void transmit();
+
+    /** Pick the receive queue for a packet. */
+    unsigned rxQueueIndex(const EthPacketPtr &pkt) const;
+
+  protected:
+    /** Virtqueue for incoming packets */
+    class RxQueue : public VirtQueue
+    {
+      public:
+        RxQueue(PortProxy &proxy, ByteOrder bo, uint16_t size,
+                unsigned fifo_size, VirtIONet &_parent,
+                const std::string &_name)
+            : VirtQueue(proxy, bo, size), fifo(fifo_size),
+              parent(_parent), _name(_name) {}
+
+        /** The guest posted new buffers */
+        void onNotify() override { deliver(); }
+
+        /** Move packets from the FIFO into the guest's buffers. */
+        void deliver();
+
+        std::string name() const { return _name; }
+
+        /** Packets waiting for buffers */
+        PacketFifo fifo;
+
+      protected:
+        VirtIONet &parent;
+        const std::string _name;
+    };
+
+    /** Virtqueue for outgoing packets */
+    class TxQueue : public VirtQueue
+    {
+      public:
+        TxQueue(PortProxy &proxy, ByteOrder bo, uint16_t size,
+                VirtIONet &_parent, const std::string &_name)
+            : VirtQueue(proxy, bo, size), parent(_parent), _name(_name) {}
+
+        /**
+         * New packets are pulled from the queue when the link is
+         * ready rather than as soon as the guest posts them.
+         */
+        void onNotify() override { parent.transmit(); }
+
+        std::string name() const { return _name; }
+
+      protected:
+        VirtIONet &parent;
+        const std::string _name;
+    };
+
+    /** Virtqueue for control requests */
+    class CtrlQueue : public VirtQueue
+    {
+      public:
+        CtrlQueue(PortProxy &proxy, ByteOrder bo, uint16_t size,
+                  VirtIONet &_parent)
+            : VirtQueue(proxy, bo, size), parent(_parent) {}
+
+        void onNotifyDescriptor(VirtDescriptor *desc) override;
+
+        std::string name() const { return parent.name() + ".qCtrl"; }
+
+      protected:
+        VirtIONet &parent;
+    };
+
+    /** Interface to the Ethernet link */
+    class Interface : public EtherInt
+    {
+      public:
+        Interface(const std::string &name, VirtIONet &_parent)
+            : EtherInt(name), parent(_parent) {}
+
+        bool recvPacket(EthPacketPtr pkt) override
+        { return parent.recvPacket(pkt); }
+        void sendDone() override { parent.transmit(); }
+
+      protected:
+        VirtIONet &parent;
+    };
+
+    std::vector<std::unique_ptr<RxQueue>> rxQueues;
+    std::vector<std::unique_ptr<TxQueue>> txQueues;
+    std::unique_ptr<CtrlQueue> qCtrl;
+
+    Interface interface;
+
+    /** Number of queue pairs enabled by the guest */
+    unsigned activePairs;
+    /** Transmit queue to look at first */
+    unsigned txNext;
+    /** Packet waiting for the link to become ready */
+    EthPacketPtr txPacket;
+
+    struct VirtIONetStats : public Stats::Group
+    {
+        VirtIONetStats(Stats::Group *parent);
+
+        Stats::Scalar txBytes;
+        Stats::Scalar rxBytes;
+        Stats::Scalar txPackets;
+        Stats::Scalar rxPackets;
+        Stats::Scalar rxDrops;
+    } stats;
+};
+
+#endif // __DEV_VIRTIO_NET_HH__
@@ -55,7 +55,9 @@ PciVirtIO::PciVirtIO(const Params &params)
     // used to check accesses later on.
     BARs[0]->size(alignToPowerOfTwo(BAR0_SIZE_BASE + vio.configSize));
 
-    vio.registerKickCallback([this]() { kick(); });
+    vio.registerKickCallback([this](VirtIODeviceBase::QueueID queue) {
+        kick(queue);
+    });
 }
 
 PciVirtIO::~PciVirtIO()
@@ -216,9 +218,10 @@ PciVirtIO::write(PacketPtr pkt)
 }
 
 void
-PciVirtIO::kick()
+PciVirtIO::kick(VirtIODeviceBase::QueueID queue)
 {
-    DPRINTF(VIOIface, "kick(): Sending interrupt...\n");
+    // There is only one interrupt, shared by all queues.
+    DPRINTF(VIOIface, "kick(%i): Sending interrupt...\n", queue);
     interruptDeliveryPending = true;
     intrPost();
 }
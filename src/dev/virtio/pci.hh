@@ -54,7 +54,7 @@ class PciVirtIO : public PciDevice
     Tick read(PacketPtr pkt);
     Tick write(PacketPtr pkt);
 
-    void kick();
+    void kick(VirtIODeviceBase::QueueID queue);
 
   protected:
     /** @{ */
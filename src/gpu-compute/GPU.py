@@ -232,6 +232,9 @@ class Shader(ClockedObject):
     timer_period = Param.Clock('10us', "system timer period")
     idlecu_timeout = Param.Tick(0, "Idle CU watchdog timeout threshold")
     max_valu_insts = Param.Int(0, "Maximum vALU insts before exiting")
+    cu_event_queues = Param.Unsigned(1, "Number of event queues (host "
+        "threads) to spread the CUs over, see "
+        "m5.simulate.partitionComputeUnits()")
 
 class GPUComputeDriver(HSADriver):
     type = 'GPUComputeDriver'
@@ -241,6 +244,12 @@ class GPUDispatcher(SimObject):
     type = 'GPUDispatcher'
     cxx_header = 'gpu-compute/dispatcher.hh'
 
+    kernel_sampling = Param.Bool(False, "Fast-forward repeated launches of "
+        "a kernel once enough of them have been simulated in detail")
+    detailed_samples = Param.Unsigned(1, "Number of launches of a kernel "
+        "(same name and dimensions) to simulate in detail before "
+        "fast-forwarding the rest when kernel_sampling is enabled")
+
 class GPUCommandProcessor(HSADevice):
     type = 'GPUCommandProcessor'
     cxx_header = 'gpu-compute/gpu_command_processor.hh'
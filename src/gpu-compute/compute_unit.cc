@@ -36,6 +36,7 @@
 #include <limits>
 
 #include "arch/x86/isa_traits.hh"
+#include "base/intmath.hh"
 #include "base/output.hh"
 #include "debug/GPUDisp.hh"
 #include "debug/GPUExec.hh"
@@ -136,6 +137,7 @@ ComputeUnit::ComputeUnit(const Params &p) : ClockedObject(p),
     idleWfs = p.n_wf * numVectorALUs;
     lastVaddrWF.resize(numVectorALUs);
     wfList.resize(numVectorALUs);
+    activeWfs.resize(divCeil(p.n_wf * numVectorALUs, 64), 0);
 
     wfBarrierSlots.resize(p.num_barrier_slots, WFBarrier());
 
@@ -232,6 +234,16 @@ ComputeUnit::numExeUnits() const
         numVectorSharedMemUnits + numScalarMemUnits;
 }
 
+void
+ComputeUnit::setWfActive(int simd_id, int wf_slot_id, bool active)
+{
+    const int idx = simd_id * wfSlotsPerSimd() + wf_slot_id;
+    if (active)
+        activeWfs[idx / 64] |= ULL(1) << (idx % 64);
+    else
+        activeWfs[idx / 64] &= ~(ULL(1) << (idx % 64));
+}
+
 // index into readyList of the first memory unit
 int
 ComputeUnit::firstMemUnit() const
@@ -320,6 +332,7 @@ ComputeUnit::startWavefront(Wavefront *w, int waveId, LdsChunk *ldsChunk,
     w->execMask() = init_mask;
 
     w->kernId = task->dispatchId();
+    w->fastForward = task->fastForward();
     w->wfId = waveId;
     w->initMask = init_mask.to_ullong();
 
@@ -356,7 +369,7 @@ ComputeUnit::startWavefront(Wavefront *w, int waveId, LdsChunk *ldsChunk,
     DPRINTF(GPUDisp, "CU%d: increase ref ctr wg[%d] to [%d]\n",
                     cu_id, w->wgId, refCount);
 
-    w->instructionBuffer.clear();
+    w->instructionBuffer.flush();
 
     if (w->pendingFetch)
         w->dropFetch = true;
@@ -1033,6 +1046,25 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt)
         fatal("pkt is not a read nor a write\n");
     }
 
+    if (gpuDynInst->wavefront()->fastForward) {
+        pkt = functionalMemAccess(pkt, TLB_mode,
+                                  tlbPort[perLaneTLB ? index : 0],
+                                  memPort[0]);
+
+        // a functional write is complete once performed, there is no
+        // separate write completion to wait for
+        if (pkt->cmd == MemCmd::WriteResp)
+            pkt->cmd = MemCmd::WriteCompleteResp;
+
+        pkt->senderState =
+            new ComputeUnit::DataPort::SenderState(gpuDynInst, index, nullptr);
+        gpuDynInst->memStatusVector[pkt->getAddr()].push_back(index);
+
+        schedule(memPort[index].createMemRespEvent(pkt),
+                 curTick() + resp_tick_latency);
+        return;
+    }
+
     stats.tlbCycles -= curTick();
     ++stats.tlbRequests;
 
@@ -1129,7 +1161,7 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt)
                     gpuDynInst->wfSlotId, tmp_vaddr);
 
             tlbPort[tlbPort_index].retries.push_back(pkt);
-        } else if (!tlbPort[tlbPort_index].sendTimingReq(pkt)) {
+        } else if (!sendTLBReq(tlbPort[tlbPort_index], pkt)) {
             // Stall the data port;
             // No more packet will be issued till
             // ruby indicates resources are freed by
@@ -1195,6 +1227,19 @@ ComputeUnit::sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt)
 
     BaseTLB::Mode tlb_mode = pkt->isRead() ? BaseTLB::Read : BaseTLB::Write;
 
+    if (gpuDynInst->wavefront()->fastForward) {
+        pkt = functionalMemAccess(pkt, tlb_mode, scalarDTLBPort,
+                                  scalarDataPort);
+        pkt->senderState =
+            new ComputeUnit::ScalarDataPort::SenderState(gpuDynInst);
+
+        schedule(new EventFunctionWrapper(
+                     [this, pkt]{ scalarDataPort.recvTimingResp(pkt); },
+                     "ScalarDataPort functional response", true),
+                 curTick() + resp_tick_latency);
+        return;
+    }
+
     pkt->senderState =
         new ComputeUnit::ScalarDTLBPort::SenderState(gpuDynInst);
 
@@ -1205,7 +1250,7 @@ ComputeUnit::sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt)
     if (scalarDTLBPort.isStalled()) {
         assert(scalarDTLBPort.retries.size());
         scalarDTLBPort.retries.push_back(pkt);
-    } else if (!scalarDTLBPort.sendTimingReq(pkt)) {
+    } else if (!sendTLBReq(scalarDTLBPort, pkt)) {
         scalarDTLBPort.stallPort();
         scalarDTLBPort.retries.push_back(pkt);
     } else {
@@ -1215,6 +1260,72 @@ ComputeUnit::sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt)
     }
 }
 
+bool
+ComputeUnit::sendTLBReq(RequestPort &port, PacketPtr pkt)
+{
+    EventQueue::ScopedMigration migrate(shader->eventQueue());
+    return port.sendTimingReq(pkt);
+}
+
+void
+ComputeUnit::countVecOperands(int num_src, int num_dst)
+{
+    if (eventQueue() == shader->eventQueue()) {
+        shader->incVectorInstSrcOperand(num_src);
+        shader->incVectorInstDstOperand(num_dst);
+    } else {
+        ++pendingSrcOperands[num_src];
+        ++pendingDstOperands[num_dst];
+    }
+}
+
+PacketPtr
+ComputeUnit::functionalMemAccess(PacketPtr pkt, BaseTLB::Mode tlb_mode,
+                                 RequestPort &tlb_port, RequestPort &mem_port)
+{
+    pkt->senderState =
+        new X86ISA::GpuTLB::TranslationState(tlb_mode, shader->gpuTc);
+
+    tlb_port.sendFunctional(pkt);
+
+    X86ISA::GpuTLB::TranslationState *sender_state =
+        safe_cast<X86ISA::GpuTLB::TranslationState*>(pkt->senderState);
+
+    delete sender_state->tlbEntry;
+    delete sender_state;
+
+    // the packet still carries the virtual address, build a new one from
+    // the translated request
+    PacketPtr new_pkt = new Packet(pkt->req, pkt->cmd);
+    new_pkt->dataStatic(pkt->getPtr<uint8_t>());
+    delete pkt;
+
+    if (new_pkt->isAtomicOp()) {
+        // functional accesses do not apply atomic ops, so do the
+        // read-modify-write here
+        std::vector<uint8_t> data(new_pkt->getSize());
+
+        Packet read_pkt(new_pkt->req, MemCmd::ReadReq);
+        read_pkt.dataStatic(data.data());
+        mem_port.sendFunctional(&read_pkt);
+
+        if (new_pkt->req->isAtomicReturn())
+            new_pkt->setData(data.data());
+
+        (*new_pkt->getAtomicOp())(data.data());
+
+        Packet write_pkt(new_pkt->req, MemCmd::WriteReq);
+        write_pkt.dataStatic(data.data());
+        mem_port.sendFunctional(&write_pkt);
+
+        new_pkt->makeResponse();
+    } else {
+        mem_port.sendFunctional(new_pkt);
+    }
+
+    return new_pkt;
+}
+
 void
 ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
                                   bool kernelMemSync,
@@ -1224,7 +1335,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
            gpuDynInst->executedAs() == Enums::SC_GLOBAL);
 
     if (!req) {
-        req = std::make_shared<Request>(
+        req = Request::create(
             0, 0, 0, requestorId(), 0, gpuDynInst->wfDynId);
     }
 
@@ -1376,6 +1487,9 @@ ComputeUnit::DataPort::processMemRespEvent(PacketPtr pkt)
 bool
 ComputeUnit::DTLBPort::recvTimingResp(PacketPtr pkt)
 {
+    // the TLBs may respond from another event queue
+    EventQueue::ScopedMigration migrate(computeUnit->eventQueue());
+
     Addr line = pkt->req->getPaddr();
 
     DPRINTF(GPUTLB, "CU%d: DTLBPort received %#x->%#x\n", computeUnit->cu_id,
@@ -1484,7 +1598,7 @@ ComputeUnit::DTLBPort::recvTimingResp(PacketPtr pkt)
             if (!stride)
                 break;
 
-            RequestPtr prefetch_req = std::make_shared<Request>(
+            RequestPtr prefetch_req = Request::create(
                 vaddr + stride * pf * X86ISA::PageBytes,
                 sizeof(uint8_t), 0,
                 computeUnit->requestorId(),
@@ -1618,6 +1732,7 @@ ComputeUnit::ScalarDataPort::MemReqEvent::process()
 void
 ComputeUnit::DTLBPort::recvReqRetry()
 {
+    EventQueue::ScopedMigration migrate(computeUnit->eventQueue());
     int len = retries.size();
 
     DPRINTF(GPUTLB, "CU%d: DTLB recvReqRetry - %d pending requests\n",
@@ -1634,7 +1749,7 @@ ComputeUnit::DTLBPort::recvReqRetry()
         M5_VAR_USED Addr vaddr = pkt->req->getVaddr();
         DPRINTF(GPUTLB, "CU%d: retrying D-translaton for address%#x", vaddr);
 
-        if (!sendTimingReq(pkt)) {
+        if (!computeUnit->sendTLBReq(*this, pkt)) {
             // Stall port
             stallPort();
             DPRINTF(GPUTLB, ": failed again\n");
@@ -1649,6 +1764,9 @@ ComputeUnit::DTLBPort::recvReqRetry()
 bool
 ComputeUnit::ScalarDTLBPort::recvTimingResp(PacketPtr pkt)
 {
+    // the TLBs may respond from another event queue
+    EventQueue::ScopedMigration migrate(computeUnit->eventQueue());
+
     assert(pkt->senderState);
 
     X86ISA::GpuTLB::TranslationState *translation_state =
@@ -1709,6 +1827,9 @@ ComputeUnit::ScalarDTLBPort::recvTimingResp(PacketPtr pkt)
 bool
 ComputeUnit::ITLBPort::recvTimingResp(PacketPtr pkt)
 {
+    // the TLBs may respond from another event queue
+    EventQueue::ScopedMigration migrate(computeUnit->eventQueue());
+
     M5_VAR_USED Addr line = pkt->req->getPaddr();
     DPRINTF(GPUTLB, "CU%d: ITLBPort received %#x->%#x\n",
             computeUnit->cu_id, pkt->req->getVaddr(), line);
@@ -1762,6 +1883,7 @@ ComputeUnit::ITLBPort::recvTimingResp(PacketPtr pkt)
 void
 ComputeUnit::ITLBPort::recvReqRetry()
 {
+    EventQueue::ScopedMigration migrate(computeUnit->eventQueue());
 
     int len = retries.size();
     DPRINTF(GPUTLB, "CU%d: ITLB recvReqRetry - %d pending requests\n", len);
@@ -1778,7 +1900,7 @@ ComputeUnit::ITLBPort::recvReqRetry()
         M5_VAR_USED Addr vaddr = pkt->req->getVaddr();
         DPRINTF(GPUTLB, "CU%d: retrying I-translaton for address%#x", vaddr);
 
-        if (!sendTimingReq(pkt)) {
+        if (!computeUnit->sendTLBReq(*this, pkt)) {
             stallPort(); // Stall port
             DPRINTF(GPUTLB, ": failed again\n");
             break;
@@ -1803,8 +1925,7 @@ ComputeUnit::updateInstStats(GPUDynInstPtr gpuDynInst)
         }
     } else {
         if (gpuDynInst->isALU()) {
-            shader->total_valu_insts++;
-            if (shader->total_valu_insts == shader->max_valu_insts) {
+            if (++shader->total_valu_insts == shader->max_valu_insts) {
                 exitSimLoop("max vALU insts");
             }
             stats.vALUInsts++;
@@ -1984,7 +2105,7 @@ ComputeUnit::sendToLds(GPUDynInstPtr gpuDynInst)
 {
     // this is just a request to carry the GPUDynInstPtr
     // back and forth
-    RequestPtr newRequest = std::make_shared<Request>();
+    RequestPtr newRequest = Request::create();
     newRequest->setPaddr(0x0);
 
     // ReadReq is not evaluted by the LDS but the Packet ctor requires this
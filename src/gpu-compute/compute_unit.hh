@@ -34,11 +34,13 @@
 #ifndef __COMPUTE_UNIT_HH__
 #define __COMPUTE_UNIT_HH__
 
+#include <array>
 #include <deque>
 #include <map>
 #include <unordered_set>
 #include <vector>
 
+#include "arch/generic/tlb.hh"
 #include "base/callback.hh"
 #include "base/compiler.hh"
 #include "base/statistics.hh"
@@ -249,6 +251,9 @@ class ComputeUnit : public ClockedObject
 
     // Return total number of execution units on this CU
     int numExeUnits() const;
+    int wfSlotsPerSimd() const { return wfList[0].size(); }
+    // Called by a wavefront when it leaves or enters the stopped state
+    void setWfActive(int simd_id, int wf_slot_id, bool active);
     // index into readyList of the first memory unit
     int firstMemUnit() const;
     // index into readyList of the last memory unit
@@ -288,6 +293,10 @@ class ComputeUnit : public ClockedObject
 
     typedef ComputeUnitParams Params;
     std::vector<std::vector<Wavefront*>> wfList;
+    // Bitmap of the WF slots, indexed by simdId * wfSlotsPerSimd() +
+    // wfSlotId, whose wavefront isn't stopped. A stopped wavefront can
+    // never be ready, so the scoreboard check stage only visits these.
+    std::vector<uint64_t> activeWfs;
     int cu_id;
 
     // array of vector register files, one per SIMD
@@ -412,6 +421,23 @@ class ComputeUnit : public ClockedObject
 
     void resetRegisterPool();
 
+    /**
+     * Send a translation request to the TLB hierarchy. The TLBs stay on
+     * the shader's event queue when the CUs are spread over several
+     * queues (Shader.cu_event_queues), so the request is sent from it.
+     */
+    bool sendTLBReq(RequestPort &port, PacketPtr pkt);
+
+    /**
+     * Count the vector operands of an executed instruction in the
+     * shader's stats. They are buffered in pendingSrcOperands and
+     * pendingDstOperands while this CU runs on its own event queue, and
+     * folded into the stats by the shader before they are dumped.
+     */
+    void countVecOperands(int num_src, int num_dst);
+    std::array<uint64_t, 4> pendingSrcOperands{};
+    std::array<uint64_t, 4> pendingDstOperands{};
+
   private:
     WFBarrier&
     barrierSlot(int bar_id)
@@ -448,6 +474,14 @@ class ComputeUnit : public ClockedObject
     virtual void init() override;
     void sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt);
     void sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt);
+    /**
+     * Translate and perform a memory access functionally, bypassing the
+     * timing TLB and cache hierarchy. Used for the WFs of fast-forwarded
+     * kernel launches. pkt is consumed and the response is returned.
+     */
+    PacketPtr functionalMemAccess(PacketPtr pkt, BaseTLB::Mode tlb_mode,
+                                  RequestPort &tlb_port,
+                                  RequestPort &mem_port);
     void injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
                               bool kernelMemSync,
                               RequestPtr req=nullptr);
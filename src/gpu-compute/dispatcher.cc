@@ -34,6 +34,9 @@
 
 #include "gpu-compute/dispatcher.hh"
 
+#include <algorithm>
+
+#include "base/cprintf.hh"
 #include "debug/GPUAgentDisp.hh"
 #include "debug/GPUDisp.hh"
 #include "debug/GPUKernelInfo.hh"
@@ -49,7 +52,8 @@ GPUDispatcher::GPUDispatcher(const Params &p)
     : SimObject(p), shader(nullptr), gpuCmdProc(nullptr),
       tickEvent([this]{ exec(); },
           "GPU Dispatcher tick", false, Event::CPU_Tick_Pri),
-      dispatchActive(false), stats(this)
+      dispatchActive(false), kernelSampling(p.kernel_sampling),
+      detailedSamples(p.detailed_samples), stats(this)
 {
     schedule(&tickEvent, 0);
 }
@@ -119,6 +123,18 @@ GPUDispatcher::dispatch(HSAQueueEntry *task)
     DPRINTF(GPUAgentDisp, "launching kernel: %s, dispatch ID: %d\n",
             task->kernelName(), task->dispatchId());
 
+    if (kernelSampling) {
+        auto sample = kernelSamples.find(kernelSignature(task));
+        if (sample != kernelSamples.end() &&
+            sample->second.numSamples >= detailedSamples) {
+            task->fastForward(true);
+            ++stats.numKernelsFastForwarded;
+            DPRINTF(GPUDisp, "fast-forwarding kernel: %s, dispatch ID: %d\n",
+                    task->kernelName(), task->dispatchId());
+        }
+        kernelStartTicks[task->dispatchId()] = curTick();
+    }
+
     execIds.push(task->dispatchId());
     dispatchActive = true;
     hsaQueueEntries.emplace(task->dispatchId(), task);
@@ -224,6 +240,7 @@ GPUDispatcher::exec()
 bool
 GPUDispatcher::isReachingKernelEnd(Wavefront *wf)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     int kern_id = wf->kernId;
     assert(hsaQueueEntries.find(kern_id) != hsaQueueEntries.end());
     auto task = hsaQueueEntries[kern_id];
@@ -243,6 +260,7 @@ GPUDispatcher::isReachingKernelEnd(Wavefront *wf)
  */
 void
 GPUDispatcher::updateInvCounter(int kern_id, int val) {
+    EventQueue::ScopedMigration migrate(eventQueue());
     assert(val == -1 || val == 1);
 
     auto task = hsaQueueEntries[kern_id];
@@ -263,6 +281,7 @@ GPUDispatcher::updateInvCounter(int kern_id, int val) {
  */
 bool
 GPUDispatcher::updateWbCounter(int kern_id, int val) {
+    EventQueue::ScopedMigration migrate(eventQueue());
     assert(val == -1 || val == 1);
 
     auto task = hsaQueueEntries[kern_id];
@@ -277,12 +296,16 @@ GPUDispatcher::updateWbCounter(int kern_id, int val) {
  */
 int
 GPUDispatcher::getOutstandingWbs(int kernId) {
+    EventQueue::ScopedMigration migrate(eventQueue());
     auto task = hsaQueueEntries[kernId];
 
     return task->outstandingWbs();
 }
 
 /**
+ * The methods called by the CUs migrate to the event queue of the
+ * dispatcher, as the CUs may run on other queues.
+ *
  * When an end program instruction detects that the last WF in
  * a WG has completed it will call this method on the dispatcher.
  * If we detect that this is the last WG for the given task, then
@@ -293,6 +316,7 @@ GPUDispatcher::getOutstandingWbs(int kernId) {
 void
 GPUDispatcher::notifyWgCompl(Wavefront *wf)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     int kern_id = wf->kernId;
     DPRINTF(GPUDisp, "notify WgCompl %d\n", wf->wgId);
     auto task = hsaQueueEntries[kern_id];
@@ -303,32 +327,33 @@ GPUDispatcher::notifyWgCompl(Wavefront *wf)
         curTick(), wf->wgId, kern_id, wf->computeUnit->cu_id);
 
     if (task->numWgCompleted() == task->numWgTotal()) {
-        // Notify the HSA PP that this kernel is complete
-        gpuCmdProc->hsaPacketProc()
-            .finishPkt(task->dispPktPtr(), task->queueId());
-        if (task->completionSignal()) {
-            /**
-            * HACK: The semantics of the HSA signal is to decrement
-            * the current signal value. We cheat here and read out
-            * he value from main memory using functional access and
-            * then just DMA the decremented value.
-            */
-            uint64_t signal_value =
-                gpuCmdProc->functionalReadHsaSignal(task->completionSignal());
-
-            DPRINTF(GPUDisp, "HSA AQL Kernel Complete with completion "
-                    "signal! Addr: %d\n", task->completionSignal());
-
-            gpuCmdProc->updateHsaSignal(task->completionSignal(),
-                                        signal_value - 1);
+        if (!kernelSampling) {
+            finishKernel(task);
         } else {
-            DPRINTF(GPUDisp, "HSA AQL Kernel Complete! No completion "
-                "signal\n");
+            auto start = kernelStartTicks.find(kern_id);
+            assert(start != kernelStartTicks.end());
+            KernelSample &sample = kernelSamples[kernelSignature(task)];
+            Tick end_tick = curTick();
+
+            if (task->fastForward() && sample.numSamples) {
+                // complete no earlier than the average detailed launch
+                end_tick = std::max(end_tick, start->second +
+                    sample.totalTicks / sample.numSamples);
+            } else if (!task->fastForward()) {
+                ++sample.numSamples;
+                sample.totalTicks += curTick() - start->second;
+            }
+            kernelStartTicks.erase(start);
+
+            if (end_tick > curTick()) {
+                schedule(new EventFunctionWrapper(
+                             [this, task]{ finishKernel(task); },
+                             "GPU Dispatcher kernel completion", true),
+                         end_tick);
+            } else {
+                finishKernel(task);
+            }
         }
-
-        DPRINTF(GPUWgLatency, "Kernel Complete ticks:%d kernel:%d\n",
-                curTick(), kern_id);
-        DPRINTF(GPUKernelInfo, "Completed kernel %d\n", kern_id);
     }
 
     if (!tickEvent.scheduled()) {
@@ -336,9 +361,57 @@ GPUDispatcher::notifyWgCompl(Wavefront *wf)
     }
 }
 
+/**
+ * Signal the completion of a kernel to the HSA packet processor and
+ * the host.
+ */
+void
+GPUDispatcher::finishKernel(HSAQueueEntry *task)
+{
+    // Notify the HSA PP that this kernel is complete
+    gpuCmdProc->hsaPacketProc()
+        .finishPkt(task->dispPktPtr(), task->queueId());
+    if (task->completionSignal()) {
+        /**
+        * HACK: The semantics of the HSA signal is to decrement
+        * the current signal value. We cheat here and read out
+        * he value from main memory using functional access and
+        * then just DMA the decremented value.
+        */
+        uint64_t signal_value =
+            gpuCmdProc->functionalReadHsaSignal(task->completionSignal());
+
+        DPRINTF(GPUDisp, "HSA AQL Kernel Complete with completion "
+                "signal! Addr: %d\n", task->completionSignal());
+
+        gpuCmdProc->updateHsaSignal(task->completionSignal(),
+                                    signal_value - 1);
+    } else {
+        DPRINTF(GPUDisp, "HSA AQL Kernel Complete! No completion "
+            "signal\n");
+    }
+
+    DPRINTF(GPUWgLatency, "Kernel Complete ticks:%d kernel:%d\n",
+            curTick(), task->dispatchId());
+    DPRINTF(GPUKernelInfo, "Completed kernel %d\n", task->dispatchId());
+}
+
+/**
+ * Kernel launches with the same code and dimensions are considered
+ * samples of the same kernel.
+ */
+std::string
+GPUDispatcher::kernelSignature(HSAQueueEntry *task) const
+{
+    return csprintf("%s:%d,%d,%d:%d,%d,%d", task->kernelName(),
+                    task->gridSize(0), task->gridSize(1), task->gridSize(2),
+                    task->wgSize(0), task->wgSize(1), task->wgSize(2));
+}
+
 void
 GPUDispatcher::scheduleDispatch()
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     if (!tickEvent.scheduled()) {
         schedule(&tickEvent, curTick() + shader->clockPeriod());
     }
@@ -348,6 +421,8 @@ GPUDispatcher::GPUDispatcherStats::GPUDispatcherStats(Stats::Group *parent)
     : Stats::Group(parent),
       ADD_STAT(numKernelLaunched, "number of kernel launched"),
       ADD_STAT(cyclesWaitingForDispatch, "number of cycles with outstanding "
-               "wavefronts that are waiting to be dispatched")
+               "wavefronts that are waiting to be dispatched"),
+      ADD_STAT(numKernelsFastForwarded, "number of kernel launches "
+               "fast-forwarded by kernel sampling")
 {
 }
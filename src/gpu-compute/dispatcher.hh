@@ -43,7 +43,9 @@
 #ifndef __GPU_COMPUTE_DISPATCHER_HH__
 #define __GPU_COMPUTE_DISPATCHER_HH__
 
+#include <map>
 #include <queue>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -81,6 +83,19 @@ class GPUDispatcher : public SimObject
     HSAQueueEntry* hsaTask(int disp_id);
 
   private:
+    /**
+     * Timing gathered from the detailed launches of one kernel
+     * signature, used to time the fast-forwarded launches.
+     */
+    struct KernelSample
+    {
+        int numSamples = 0;
+        Tick totalTicks = 0;
+    };
+
+    std::string kernelSignature(HSAQueueEntry *task) const;
+    void finishKernel(HSAQueueEntry *task);
+
     Shader *shader;
     GPUCommandProcessor *gpuCmdProc;
     EventFunctionWrapper tickEvent;
@@ -91,6 +106,12 @@ class GPUDispatcher : public SimObject
     std::queue<int> doneIds;
     // is there a kernel in execution?
     bool dispatchActive;
+    // sample kernel launches and fast-forward repeated ones
+    const bool kernelSampling;
+    const int detailedSamples;
+    std::map<std::string, KernelSample> kernelSamples;
+    // tick at which each in-flight kernel was dispatched
+    std::unordered_map<int, Tick> kernelStartTicks;
 
   protected:
     struct GPUDispatcherStats : public Stats::Group
@@ -99,6 +120,7 @@ class GPUDispatcher : public SimObject
 
         Stats::Scalar numKernelLaunched;
         Stats::Scalar cyclesWaitingForDispatch;
+        Stats::Scalar numKernelsFastForwarded;
     } stats;
 };
 
@@ -159,7 +159,7 @@ FetchUnit::initiateFetch(Wavefront *wavefront)
             computeUnit.cu_id, wavefront->simdId, wavefront->wfSlotId, vaddr);
 
     // set up virtual request
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         vaddr, computeUnit.cacheLineSize(), Request::INST_FETCH,
         computeUnit.requestorId(), 0, 0, nullptr);
 
@@ -182,7 +182,7 @@ FetchUnit::initiateFetch(Wavefront *wavefront)
                     vaddr);
 
             computeUnit.sqcTLBPort.retries.push_back(pkt);
-        } else if (!computeUnit.sqcTLBPort.sendTimingReq(pkt)) {
+        } else if (!computeUnit.sendTLBReq(computeUnit.sqcTLBPort, pkt)) {
             // Stall the data port;
             // No more packet is issued till
             // ruby indicates resources are freed by
@@ -42,7 +42,7 @@
 GPUDynInst::GPUDynInst(ComputeUnit *_cu, Wavefront *_wf,
                        GPUStaticInst *static_inst, InstSeqNum instSeqNum)
     : GPUExecContext(_cu, _wf), scalarAddr(0), addr(computeUnit()->wfSize(),
-      (Addr)0), numScalarReqs(0), isSaveRestore(false),
+      (Addr)0), numScalarReqs(0), numVectorReqs(0), isSaveRestore(false),
       _staticInst(static_inst), _seqNum(instSeqNum)
 {
     statusVector.assign(TheGpuISA::NumVecElemPerVecReg, 0);
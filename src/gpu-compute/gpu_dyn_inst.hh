@@ -415,6 +415,11 @@ class GPUDynInst : public GPUExecContext
     // of outstanding reqs here
     int numScalarReqs;
 
+    // number of packets a vector memory instruction was split into. lanes
+    // accessing consecutive bytes of a cache line share a packet, and a
+    // misaligned lane needs two, so this may differ from the active lanes
+    int numVectorReqs;
+
     Tick getAccessTime() const { return accessTime; }
 
     void setAccessTime(Tick currentTime) { accessTime = currentTime; }
@@ -77,16 +77,7 @@ namespace X86ISA
         accessDistance = p.accessDistance;
 
         tlb.assign(size, TlbEntry());
-
-        freeList.resize(numSets);
-        entryList.resize(numSets);
-
-        for (int set = 0; set < numSets; ++set) {
-            for (int way = 0; way < assoc; ++way) {
-                int x = set * assoc + way;
-                freeList[set].push_back(&tlb.at(x));
-            }
-        }
+        lruClock = 0;
 
         FA = (size == assoc);
 
@@ -158,31 +149,29 @@ namespace X86ISA
     TlbEntry*
     GpuTLB::insert(Addr vpn, TlbEntry &entry)
     {
-        TlbEntry *newEntry = nullptr;
-
         /**
          * vpn holds the virtual page address
          * The least significant bits are simply masked
          */
         int set = (vpn >> PageShift) & setMask;
+        TlbEntry *ways = &tlb[set * assoc];
 
-        if (!freeList[set].empty()) {
-            newEntry = freeList[set].front();
-            freeList[set].pop_front();
-        } else {
-            newEntry = entryList[set].back();
-            entryList[set].pop_back();
+        // invalid ways have an lruSeq of 0, so they are picked first
+        TlbEntry *newEntry = ways;
+        for (int way = 1; way < assoc && newEntry->lruSeq; ++way) {
+            if (ways[way].lruSeq < newEntry->lruSeq)
+                newEntry = &ways[way];
         }
 
         *newEntry = entry;
         newEntry->vaddr = vpn;
-        entryList[set].push_front(newEntry);
+        newEntry->lruSeq = ++lruClock;
 
         return newEntry;
     }
 
-    GpuTLB::EntryList::iterator
-    GpuTLB::lookupIt(Addr va, bool update_lru)
+    TlbEntry*
+    GpuTLB::lookupEntry(Addr va, bool update_lru)
     {
         int set = (va >> PageShift) & setMask;
 
@@ -190,38 +179,32 @@ namespace X86ISA
             assert(!set);
         }
 
-        auto entry = entryList[set].begin();
-        for (; entry != entryList[set].end(); ++entry) {
-            int page_size = (*entry)->size();
+        TlbEntry *ways = &tlb[set * assoc];
+        for (int way = 0; way < assoc; ++way) {
+            TlbEntry *entry = &ways[way];
+            if (!entry->lruSeq)
+                continue;
+
+            int page_size = entry->size();
 
-            if ((*entry)->vaddr <= va && (*entry)->vaddr + page_size > va) {
+            if (entry->vaddr <= va && entry->vaddr + page_size > va) {
                 DPRINTF(GPUTLB, "Matched vaddr %#x to entry starting at %#x "
-                        "with size %#x.\n", va, (*entry)->vaddr, page_size);
+                        "with size %#x.\n", va, entry->vaddr, page_size);
 
-                if (update_lru) {
-                    entryList[set].push_front(*entry);
-                    entryList[set].erase(entry);
-                    entry = entryList[set].begin();
-                }
+                if (update_lru)
+                    entry->lruSeq = ++lruClock;
 
-                break;
+                return entry;
             }
         }
 
-        return entry;
+        return nullptr;
     }
 
     TlbEntry*
     GpuTLB::lookup(Addr va, bool update_lru)
     {
-        int set = (va >> PageShift) & setMask;
-
-        auto entry = lookupIt(va, update_lru);
-
-        if (entry == entryList[set].end())
-            return nullptr;
-        else
-            return *entry;
+        return lookupEntry(va, update_lru);
     }
 
     void
@@ -229,13 +212,8 @@ namespace X86ISA
     {
         DPRINTF(GPUTLB, "Invalidating all entries.\n");
 
-        for (int i = 0; i < numSets; ++i) {
-            while (!entryList[i].empty()) {
-                TlbEntry *entry = entryList[i].front();
-                entryList[i].pop_front();
-                freeList[i].push_back(entry);
-            }
-        }
+        for (auto &entry : tlb)
+            entry.lruSeq = 0;
     }
 
     void
@@ -249,30 +227,19 @@ namespace X86ISA
     {
         DPRINTF(GPUTLB, "Invalidating all non global entries.\n");
 
-        for (int i = 0; i < numSets; ++i) {
-            for (auto entryIt = entryList[i].begin();
-                 entryIt != entryList[i].end();) {
-                if (!(*entryIt)->global) {
-                    freeList[i].push_back(*entryIt);
-                    entryList[i].erase(entryIt++);
-                } else {
-                    ++entryIt;
-                }
-            }
+        for (auto &entry : tlb) {
+            if (!entry.global)
+                entry.lruSeq = 0;
         }
     }
 
     void
     GpuTLB::demapPage(Addr va, uint64_t asn)
     {
+        TlbEntry *entry = lookupEntry(va, false);
 
-        int set = (va >> PageShift) & setMask;
-        auto entry = lookupIt(va, false);
-
-        if (entry != entryList[set].end()) {
-            freeList[set].push_back(*entry);
-            entryList[set].erase(entry);
-        }
+        if (entry)
+            entry->lruSeq = 0;
     }
 
 
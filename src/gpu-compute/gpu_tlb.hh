@@ -35,7 +35,6 @@
 #define __GPU_TLB_HH__
 
 #include <fstream>
-#include <list>
 #include <queue>
 #include <string>
 #include <vector>
@@ -66,8 +65,6 @@ namespace X86ISA
       protected:
         friend class Walker;
 
-        typedef std::list<TlbEntry*> EntryList;
-
         uint32_t configAddress;
 
       public:
@@ -102,7 +99,7 @@ namespace X86ISA
         void setConfigAddress(uint32_t addr);
 
       protected:
-        EntryList::iterator lookupIt(Addr va, bool update_lru=true);
+        TlbEntry *lookupEntry(Addr va, bool update_lru=true);
         Walker *walker;
 
       public:
@@ -139,23 +136,16 @@ namespace X86ISA
          */
         bool accessDistance;
 
-        std::vector<TlbEntry> tlb;
-
-        /*
-         * It's a per-set list. As long as we have not reached
-         * the full capacity of the given set, grab an entry from
-         * the freeList.
-         */
-        std::vector<EntryList> freeList;
-
         /**
-         * An entryList per set is the equivalent of an LRU stack;
-         * it's used to guide replacement decisions. The head of the list
-         * contains the MRU TLB entry of the given set. If the freeList
-         * for this set is empty, the last element of the list
-         * is evicted (i.e., dropped on the floor).
+         * The TLB entries, stored set by set: the ways of set s are
+         * tlb[s * assoc] to tlb[s * assoc + assoc - 1]. An entry's
+         * lruSeq is the value of lruClock when it was last inserted or
+         * hit, which guides replacement, and an lruSeq of 0 marks the
+         * way as invalid. A free way is therefore always the first
+         * choice for replacement, followed by the LRU entry of the set.
          */
-        std::vector<EntryList> entryList;
+        std::vector<TlbEntry> tlb;
+        uint64_t lruClock;
 
         Fault translateInt(bool read, const RequestPtr &req,
                            ThreadContext *tc);
@@ -83,7 +83,7 @@ class HSAQueueEntry
                          private_segment_size),
           _contextId(0), _wgId{{ 0, 0, 0 }},
           _numWgTotal(1), numWgArrivedAtBarrier(0), _numWgCompleted(0),
-          _globalWgId(0), dispatchComplete(false)
+          _globalWgId(0), dispatchComplete(false), _fastForward(false)
 
     {
         // Precompiled BLIT kernels actually violate the spec a bit
@@ -204,6 +204,22 @@ class HSAQueueEntry
         return dispatchComplete;
     }
 
+    /**
+     * Whether the dispatcher's kernel sampling has chosen to fast-forward
+     * this launch instead of simulating it in detail.
+     */
+    bool
+    fastForward() const
+    {
+        return _fastForward;
+    }
+
+    void
+    fastForward(bool val)
+    {
+        _fastForward = val;
+    }
+
     int
     wgId(int dim) const
     {
@@ -470,6 +486,7 @@ class HSAQueueEntry
     int _numWgCompleted;
     int _globalWgId;
     bool dispatchComplete;
+    bool _fastForward;
 
     std::bitset<NumVectorInitFields> initialVgprState;
     std::bitset<NumScalarInitFields> initialSgprState;
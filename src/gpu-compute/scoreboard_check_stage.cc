@@ -33,6 +33,7 @@
 
 #include "gpu-compute/scoreboard_check_stage.hh"
 
+#include "base/bitfield.hh"
 #include "debug/GPUExec.hh"
 #include "debug/GPUSched.hh"
 #include "debug/GPUSync.hh"
@@ -252,9 +253,23 @@ ScoreboardCheckStage::exec()
      */
     toSchedule.reset();
 
-    // Iterate over all WF slots across all SIMDs.
-    for (int simdId = 0; simdId < computeUnit.numVectorALUs; ++simdId) {
-        for (int wfSlot = 0; wfSlot < computeUnit.shader->n_wf; ++wfSlot) {
+    // Iterate over the WF slots of all SIMDs whose wavefront isn't
+    // stopped, in SIMD and then slot order. The stopped ones would
+    // only be counted as NRDY_WF_STOP.
+    const int n_wf = computeUnit.shader->n_wf;
+    const int slots_per_simd = computeUnit.wfSlotsPerSimd();
+    int num_checked = 0;
+    for (size_t word = 0; word < computeUnit.activeWfs.size(); ++word) {
+        uint64_t active = computeUnit.activeWfs[word];
+        while (active) {
+            const int idx = word * 64 + ctz64(active);
+            active &= active - 1;
+
+            const int simdId = idx / slots_per_simd;
+            const int wfSlot = idx % slots_per_simd;
+            if (wfSlot >= n_wf)
+                continue;
+
             // reset the ready status of each wavefront
             Wavefront *curWave = computeUnit.wfList[simdId][wfSlot];
             nonrdytype_e rdyStatus = NRDY_ILLEGAL;
@@ -272,8 +287,11 @@ ScoreboardCheckStage::exec()
                 toSchedule.markWFReady(curWave, exeResType);
             }
             collectStatistics(rdyStatus);
+            num_checked++;
         }
     }
+    stats.stallCycles[NRDY_WF_STOP] +=
+        computeUnit.numVectorALUs * n_wf - num_checked;
 }
 
 ScoreboardCheckStage::
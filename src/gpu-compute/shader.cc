@@ -201,11 +201,13 @@ Shader::prepareInvalidate(HSAQueueEntry *task) {
     for (int i_cu = 0; i_cu < n_cu; ++i_cu) {
         // create a request to hold INV info; the request's fields will
         // be updated in cu before use
-        auto req = std::make_shared<Request>(0, 0, 0,
-                                             cuList[i_cu]->requestorId(),
-                                             0, -1);
+        auto req = Request::create(0, 0, 0,
+                                   cuList[i_cu]->requestorId(),
+                                   0, -1);
 
         _dispatcher.updateInvCounter(kernId, +1);
+
+        EventQueue::ScopedMigration migrate(cuList[i_cu]->eventQueue());
         // all necessary INV flags are all set now, call cu to execute
         cuList[i_cu]->doInvalidate(req, task->dispatchId());
 
@@ -219,6 +221,9 @@ Shader::prepareInvalidate(HSAQueueEntry *task) {
  */
 void
 Shader::prepareFlush(GPUDynInstPtr gpuDynInst){
+    // called by a CU, which may run on another event queue
+    EventQueue::ScopedMigration migrate(eventQueue());
+
     int kernId = gpuDynInst->kern_id;
     // flush has never been started, performed only once at kernel end
     assert(_dispatcher.getOutstandingWbs(kernId) == 0);
@@ -227,6 +232,8 @@ Shader::prepareFlush(GPUDynInstPtr gpuDynInst){
     // assuming that L2 cache is shared by all cus in the shader
     int i_cu = 0;
     _dispatcher.updateWbCounter(kernId, +1);
+
+    EventQueue::ScopedMigration migrate_cu(cuList[i_cu]->eventQueue());
     cuList[i_cu]->doFlush(gpuDynInst);
 }
 
@@ -246,17 +253,31 @@ Shader::dispatchWorkgroups(HSAQueueEntry *task)
         // (a) wg_rem is true - there are unassigned workgroups in the grid
         // (b) there are enough free slots in cu cuList[i] for this wg
         int num_wfs_in_wg = 0;
-        bool can_disp = cuList[curCu]->hasDispResources(task, num_wfs_in_wg);
-        if (!task->dispComplete() && can_disp) {
+        bool dispatched = false;
+        bool cu_was_idle = false;
+        {
+            // the CU may run on another event queue
+            EventQueue::ScopedMigration migrate(cuList[curCu]->eventQueue());
+            bool can_disp = cuList[curCu]->hasDispResources(task,
+                                                            num_wfs_in_wg);
+            if (!task->dispComplete() && can_disp) {
+                DPRINTF(GPUDisp, "Dispatching a workgroup to CU %d: WG %d\n",
+                                curCu, task->globalWgId());
+                DPRINTF(GPUAgentDisp, "Dispatching a workgroup to CU %d: "
+                        "WG %d\n", curCu, task->globalWgId());
+                DPRINTF(GPUWgLatency, "WG Begin cycle:%d wg:%d cu:%d\n",
+                        curTick(), task->globalWgId(), curCu);
+
+                cu_was_idle = !cuList[curCu]->tickEvent.scheduled();
+                cuList[curCu]->dispWorkgroup(task, num_wfs_in_wg);
+                dispatched = true;
+            }
+        }
+
+        if (dispatched) {
             scheduledSomething = true;
-            DPRINTF(GPUDisp, "Dispatching a workgroup to CU %d: WG %d\n",
-                            curCu, task->globalWgId());
-            DPRINTF(GPUAgentDisp, "Dispatching a workgroup to CU %d: WG %d\n",
-                            curCu, task->globalWgId());
-            DPRINTF(GPUWgLatency, "WG Begin cycle:%d wg:%d cu:%d\n",
-                    curTick(), task->globalWgId(), curCu);
-
-            if (!cuList[curCu]->tickEvent.scheduled()) {
+
+            if (cu_was_idle) {
                 if (!_activeCus)
                     _lastInactiveTick = curTick();
                 _activeCus++;
@@ -264,7 +285,6 @@ Shader::dispatchWorkgroups(HSAQueueEntry *task)
 
             panic_if(_activeCus <= 0 || _activeCus > cuList.size(),
                      "Invalid activeCu size\n");
-            cuList[curCu]->dispWorkgroup(task, num_wfs_in_wg);
 
             task->markWgDispatch();
             ++disp_count;
@@ -355,6 +375,17 @@ Shader::doFunctionalAccess(const RequestPtr &req, MemCmd cmd, void *data,
 void
 Shader::ScheduleAdd(int *val,Tick when,int x)
 {
+    // a CU on another event queue applies the add itself, the counters
+    // belong to its WFs
+    if (curEventQueue() != eventQueue()) {
+        curEventQueue()->schedule(new EventFunctionWrapper([val, x]
+            {
+                *val += x;
+                panic_if(*val < 0, "Negative counter value\n");
+            }, name() + ".scheduledAdd", true), curTick() + when);
+        return;
+    }
+
     sa_val.push_back(val);
     when += curTick();
     sa_when.push_back(when);
@@ -380,7 +411,7 @@ Shader::AccessMem(uint64_t address, void *ptr, uint32_t size, int cu_id,
     for (ChunkGenerator gen(address, size, cuList.at(cu_id)->cacheLineSize());
          !gen.done(); gen.next()) {
 
-        RequestPtr req = std::make_shared<Request>(
+        RequestPtr req = Request::create(
             gen.addr(), gen.size(), 0,
             cuList[0]->requestorId(), 0, 0, nullptr);
 
@@ -449,6 +480,7 @@ Shader::functionalTLBAccess(PacketPtr pkt, int cu_id, BaseTLB::Mode mode)
 void
 Shader::sampleStore(const Tick accessTime)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     stats.storeLatencyDist.sample(accessTime);
     stats.allLatencyDist.sample(accessTime);
 }
@@ -459,6 +491,7 @@ Shader::sampleStore(const Tick accessTime)
 void
 Shader::sampleLoad(const Tick accessTime)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     stats.loadLatencyDist.sample(accessTime);
     stats.allLatencyDist.sample(accessTime);
 }
@@ -466,6 +499,7 @@ Shader::sampleLoad(const Tick accessTime)
 void
 Shader::sampleInstRoundTrip(std::vector<Tick> roundTripTime)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     // Only sample instructions that go all the way to main memory
     if (roundTripTime.size() != InstMemoryHop::InstMemoryHopMax) {
         return;
@@ -486,6 +520,7 @@ Shader::sampleInstRoundTrip(std::vector<Tick> roundTripTime)
 void
 Shader::sampleLineRoundTrip(const std::map<Addr, std::vector<Tick>>& lineMap)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     stats.coalsrLineAddresses.sample(lineMap.size());
     std::vector<Tick> netTimes;
 
@@ -514,6 +549,8 @@ Shader::sampleLineRoundTrip(const std::map<Addr, std::vector<Tick>>& lineMap)
 
 void
 Shader::notifyCuSleep() {
+    EventQueue::ScopedMigration migrate(eventQueue());
+
     // If all CUs attached to his shader are asleep, update shaderActiveTicks
     panic_if(_activeCus <= 0 || _activeCus > cuList.size(),
              "Invalid activeCu size\n");
@@ -522,6 +559,35 @@ Shader::notifyCuSleep() {
         stats.shaderActiveTicks += curTick() - _lastInactiveTick;
 }
 
+void
+Shader::foldPendingOperands(bool discard)
+{
+    for (auto *cu : cuList) {
+        for (size_t i = 0; i < cu->pendingSrcOperands.size(); ++i) {
+            if (!discard) {
+                stats.vectorInstSrcOperand[i] += cu->pendingSrcOperands[i];
+                stats.vectorInstDstOperand[i] += cu->pendingDstOperands[i];
+            }
+            cu->pendingSrcOperands[i] = 0;
+            cu->pendingDstOperands[i] = 0;
+        }
+    }
+}
+
+void
+Shader::preDumpStats()
+{
+    ClockedObject::preDumpStats();
+    foldPendingOperands(false);
+}
+
+void
+Shader::resetStats()
+{
+    ClockedObject::resetStats();
+    foldPendingOperands(true);
+}
+
 Shader::ShaderStats::ShaderStats(Stats::Group *parent, int wf_size)
     : Stats::Group(parent),
       ADD_STAT(allLatencyDist, "delay distribution for all"),
@@ -34,6 +34,7 @@
 #ifndef __SHADER_HH__
 #define __SHADER_HH__
 
+#include <atomic>
 #include <functional>
 #include <string>
 
@@ -230,11 +231,14 @@ class Shader : public ClockedObject
     GPUDispatcher &_dispatcher;
 
     int64_t max_valu_insts;
-    int64_t total_valu_insts;
+    // counted by all CUs, which may run on different event queues
+    std::atomic<int64_t> total_valu_insts;
 
     Shader(const Params &p);
     ~Shader();
     virtual void init();
+    void preDumpStats() override;
+    void resetStats() override;
 
     // Run shader scheduled adds
     void execScheduledAdds();
@@ -287,6 +291,12 @@ class Shader : public ClockedObject
     }
 
   protected:
+    /**
+     * Move the vector operand counts buffered by the CUs running on
+     * their own event queues into the stats, or drop them on a reset.
+     */
+    void foldPendingOperands(bool discard);
+
     struct ShaderStats : public Stats::Group
     {
         ShaderStats(Stats::Group *parent, int wf_size);
@@ -34,6 +34,7 @@
 #include "gpu-compute/tlb_coalescer.hh"
 
 #include <cstring>
+#include <utility>
 
 #include "arch/x86/isa_traits.hh"
 #include "base/logging.hh"
@@ -141,9 +142,10 @@ void
 TLBCoalescer::updatePhysAddresses(PacketPtr pkt)
 {
     Addr virt_page_addr = roundDown(pkt->req->getVaddr(), X86ISA::PageBytes);
+    coalescedReq &coalesced_pkts = issuedTranslationsTable[virt_page_addr];
 
     DPRINTF(GPUTLB, "Update phys. addr. for %d coalesced reqs for page %#x\n",
-            issuedTranslationsTable[virt_page_addr].size(), virt_page_addr);
+            coalesced_pkts.size(), virt_page_addr);
 
     TheISA::GpuTLB::TranslationState *sender_state =
         safe_cast<TheISA::GpuTLB::TranslationState*>(pkt->senderState);
@@ -162,8 +164,8 @@ TLBCoalescer::updatePhysAddresses(PacketPtr pkt)
     Addr phys_page_paddr = pkt->req->getPaddr();
     phys_page_paddr &= ~(page_size - 1);
 
-    for (int i = 0; i < issuedTranslationsTable[virt_page_addr].size(); ++i) {
-        PacketPtr local_pkt = issuedTranslationsTable[virt_page_addr][i];
+    for (int i = 0; i < coalesced_pkts.size(); ++i) {
+        PacketPtr local_pkt = coalesced_pkts[i];
         TheISA::GpuTLB::TranslationState *sender_state =
             safe_cast<TheISA::GpuTLB::TranslationState*>(
                     local_pkt->senderState);
@@ -277,21 +279,20 @@ TLBCoalescer::CpuSidePort::recvTimingReq(PacketPtr pkt)
     // given coalescingWindow.
     int64_t tick_index = sender_state->issueTime / coalescer->coalescingWindow;
 
-    if (coalescer->coalescerFIFO.count(tick_index)) {
-        coalescedReq_cnt = coalescer->coalescerFIFO[tick_index].size();
-    }
+    // the packet ends up in this window whether or not it coalesces
+    std::vector<coalescedReq> &window = coalescer->coalescerFIFO[tick_index];
+    coalescedReq_cnt = window.size();
 
     // see if we can coalesce the incoming pkt with another
     // coalesced request with the same tick_index
     for (int i = 0; i < coalescedReq_cnt; ++i) {
-        first_packet = coalescer->coalescerFIFO[tick_index][i][0];
+        first_packet = window[i][0];
 
         if (coalescer->canCoalesce(pkt, first_packet)) {
-            coalescer->coalescerFIFO[tick_index][i].push_back(pkt);
+            window[i].push_back(pkt);
 
             DPRINTF(GPUTLB, "Coalesced req %i w/ tick_index %d has %d reqs\n",
-                    i, tick_index,
-                    coalescer->coalescerFIFO[tick_index][i].size());
+                    i, tick_index, window[i].size());
 
             didCoalesce = true;
             break;
@@ -305,13 +306,10 @@ TLBCoalescer::CpuSidePort::recvTimingReq(PacketPtr pkt)
         if (update_stats)
             coalescer->stats.coalescedAccesses++;
 
-        std::vector<PacketPtr> new_array;
-        new_array.push_back(pkt);
-        coalescer->coalescerFIFO[tick_index].push_back(new_array);
+        window.emplace_back(1, pkt);
 
         DPRINTF(GPUTLB, "coalescerFIFO[%d] now has %d coalesced reqs after "
-                "push\n", tick_index,
-                coalescer->coalescerFIFO[tick_index].size());
+                "push\n", tick_index, window.size());
     }
 
     //schedule probeTLBEvent next cycle to send the
@@ -482,9 +480,9 @@ TLBCoalescer::processProbeTLBEvent()
                 DPRINTF(GPUTLB, "Successfully sent TLB request for page %#x",
                        virt_page_addr);
 
-                //copy coalescedReq to issuedTranslationsTable
+                //move coalescedReq to issuedTranslationsTable
                 issuedTranslationsTable[virt_page_addr]
-                    = iter->second[vector_index];
+                    = std::move(iter->second[vector_index]);
 
                 //erase the entry of this coalesced req
                 iter->second.erase(iter->second.begin() + vector_index);
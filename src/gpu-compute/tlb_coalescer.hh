@@ -35,8 +35,10 @@
 #define __TLB_COALESCER_HH__
 
 #include <list>
+#include <map>
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "arch/generic/tlb.hh"
@@ -84,7 +86,8 @@ class TLBCoalescer : public ClockedObject
     bool disableCoalescing;
 
     /*
-     * This is a hash map with <tick_index> as a key.
+     * This is a map with <tick_index> as a key, ordered so that the
+     * oldest coalescing window is always probed first.
      * It contains a vector of coalescedReqs per <tick_index>.
      * Requests are buffered here until they can be issued to
      * the TLB, at which point they are copied to the
@@ -97,8 +100,7 @@ class TLBCoalescer : public ClockedObject
      * option is to change it to curTick(), so we coalesce based
      * on the receive time.
      */
-    typedef std::unordered_map<int64_t, std::vector<coalescedReq>>
-        CoalescingFIFO;
+    typedef std::map<int64_t, std::vector<coalescedReq>> CoalescingFIFO;
 
     CoalescingFIFO coalescerFIFO;
 
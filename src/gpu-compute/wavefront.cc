@@ -45,8 +45,10 @@
 #include "gpu-compute/vector_register_file.hh"
 
 Wavefront::Wavefront(const Params &p)
-  : SimObject(p), wfSlotId(p.wf_slot_id), simdId(p.simdId),
-    maxIbSize(p.max_ib_size), _gpuISA(*this),
+  : SimObject(p), wfSlotId(p.wf_slot_id), fastForward(false),
+    simdId(p.simdId),
+    maxIbSize(p.max_ib_size), instructionBuffer(p.max_ib_size + 1),
+    _gpuISA(*this),
     vmWaitCnt(-1), expWaitCnt(-1), lgkmWaitCnt(-1),
     vmemInstsIssued(0), expInstsIssued(0), lgkmInstsIssued(0),
     sleepCnt(0), barId(WFBarrier::InvalidID), stats(this)
@@ -547,6 +549,8 @@ Wavefront::setStatus(status_e newStatus)
             assert(computeUnit->idleWfs >= 0);
         }
     }
+    if ((status == S_STOPPED) != (newStatus == S_STOPPED))
+        computeUnit->setWfActive(simdId, wfSlotId, newStatus != S_STOPPED);
     status = newStatus;
 }
 
@@ -556,6 +560,8 @@ Wavefront::start(uint64_t _wf_dyn_id, Addr init_pc)
     wfDynId = _wf_dyn_id;
     _pc = init_pc;
 
+    if (status == S_STOPPED)
+        computeUnit->setWfActive(simdId, wfSlotId, true);
     status = S_RUNNING;
 
     vecReads.resize(maxVgprs, 0);
@@ -904,8 +910,8 @@ Wavefront::exec()
     }
     computeUnit->srf[simdId]->waveExecuteInst(this, ii);
 
-    computeUnit->shader->incVectorInstSrcOperand(ii->numSrcVecOperands());
-    computeUnit->shader->incVectorInstDstOperand(ii->numDstVecOperands());
+    computeUnit->countVecOperands(ii->numSrcVecOperands(),
+                                  ii->numDstVecOperands());
     computeUnit->stats.numInstrExecuted++;
     stats.numInstrExecuted++;
     computeUnit->instExecPerSimd[simdId]++;
@@ -958,6 +964,8 @@ Wavefront::exec()
     if (pc() == old_pc) {
         // PC not modified by instruction, proceed to next
         _gpuISA.advancePC(ii);
+        // The ring keeps its storage, so drop the reference explicitly.
+        instructionBuffer.front() = nullptr;
         instructionBuffer.pop_front();
     } else {
         DPRINTF(GPUExec, "CU%d: WF[%d][%d]: wave%d %s taken branch\n",
@@ -1187,7 +1195,9 @@ Wavefront::nextInstr()
 void
 Wavefront::discardFetch()
 {
-    instructionBuffer.clear();
+    for (auto &ii : instructionBuffer)
+        ii = nullptr;
+    instructionBuffer.flush();
     dropFetch |= pendingFetch;
 
     /**
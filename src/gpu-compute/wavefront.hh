@@ -35,13 +35,13 @@
 #define __GPU_COMPUTE_WAVEFRONT_HH__
 
 #include <cassert>
-#include <deque>
 #include <list>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
 #include "arch/gpu_isa.hh"
+#include "base/circular_queue.hh"
 #include "base/logging.hh"
 #include "base/statistics.hh"
 #include "base/stats/group.hh"
@@ -93,6 +93,9 @@ class Wavefront : public SimObject
     // HW slot id where the WF is mapped to inside a SIMD unit
     const int wfSlotId;
     int kernId;
+    // the WF belongs to a fast-forwarded kernel launch, its memory
+    // accesses are done functionally
+    bool fastForward;
     // SIMD unit where the WV has been scheduled
     const int simdId;
     // id of the execution unit (or pipeline) where the oldest instruction
@@ -104,7 +107,10 @@ class Wavefront : public SimObject
     ComputeUnit *computeUnit;
     int maxIbSize;
 
-    std::deque<GPUDynInstPtr> instructionBuffer;
+    // Fixed size ring of decoded instructions. It holds one more entry
+    // than maxIbSize, as the fetch unit may finish decoding an
+    // instruction split across fetch buffer lines when the IB is full.
+    CircularQueue<GPUDynInstPtr> instructionBuffer;
 
     bool pendingFetch;
     bool dropFetch;
@@ -66,6 +66,11 @@ class AbstractMemory(ClockedObject):
     # the kernel, e.g. using ATAG or ACPI
     conf_table_reported = Param.Bool(True, "Report to configuration table")
 
+    # The backing store of the memory can be bound to a host NUMA node,
+    # typically the one running the event queue thread of the memory
+    host_numa_node = Param.Int(-1, "Host NUMA node holding the backing "
+                               "store, -1 for the default host policy")
+
     # Image file to load into this memory as its initial contents. This is
     # particularly useful for ROMs.
     image_file = Param.String('',
@@ -59,6 +59,13 @@ class CommMonitor(SimObject):
     # control the sample period window length of this monitor
     sample_period = Param.Clock("1ms", "Sample period for histograms")
 
+    # only instrument a subset of the transactions to reduce the host
+    # time spent in the monitor, counting each instrumented transaction
+    # as this many; the counting is done separately for a number of
+    # address buckets so that interleaved streams are all sampled
+    sample_ratio = Param.Unsigned(1, "Instrument one in this many "
+                                     "transactions")
+
     # for each histogram, set the number of bins and enable the user
     # to disable the measurement, reads and writes use the same
     # parameters
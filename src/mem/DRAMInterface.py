@@ -65,6 +65,13 @@ class DRAMInterface(MemInterface):
     # performance being lower when enabled
     enable_dram_powerdown = Param.Bool(False, "Enable powerdown states")
 
+    # Let idle ranks skip their refresh events and account for the
+    # refreshes (energy and power state residency) when the next request
+    # arrives or the stats are dumped. This has no effect with powerdown
+    # enabled, as idle ranks then go to self-refresh instead.
+    lazy_idle_refresh = Param.Bool(False, "Account for refresh of idle "
+                                   "ranks without scheduling events")
+
     # For power modelling we need to know if the DRAM has a DLL or not
     dll = Param.Bool(True, "DRAM has DLL or not")
 
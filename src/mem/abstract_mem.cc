@@ -40,6 +40,7 @@
 
 #include "mem/abstract_mem.hh"
 
+#include <algorithm>
 #include <vector>
 
 #include "arch/locked_mem.hh"
@@ -57,7 +58,7 @@ AbstractMemory::AbstractMemory(const Params &p) :
              (MemBackdoor::Flags)(MemBackdoor::Readable |
                                   MemBackdoor::Writeable)),
     confTableReported(p.conf_table_reported), inAddrMap(p.in_addr_map),
-    kvmMap(p.kvm_map), _system(NULL),
+    kvmMap(p.kvm_map), _hostNumaNode(p.host_numa_node), _system(NULL),
     stats(*this)
 {
     panic_if(!range.valid() || !range.size(),
@@ -240,6 +241,36 @@ AbstractMemory::getAddrRange() const
     return range;
 }
 
+void
+AbstractMemory::getFunctionalBackdoor(MemBackdoorPtr &bd_ptr)
+{
+    if (_system && _system->isAtomicMode())
+        getBackdoor(bd_ptr);
+}
+
+void
+AbstractMemory::drainResume()
+{
+    backdoor.invalidate();
+}
+
+std::list<LockedAddr>
+AbstractMemory::getLockedAddrList() const
+{
+    std::list<LockedAddr> locked_addrs;
+    for (const auto &l : lockedContexts)
+        locked_addrs.emplace_back(l.second, l.first);
+    return locked_addrs;
+}
+
+void
+AbstractMemory::addLockedAddr(LockedAddr addr)
+{
+    backdoor.invalidate();
+    lockedContexts[addr.contextId] = addr.addr;
+    lockedLines[addr.addr].push_back(addr.contextId);
+}
+
 // Add load-locked to tracking list.  Should only be called if the
 // operation is a load and the LLSC flag is set.
 void
@@ -247,25 +278,33 @@ AbstractMemory::trackLoadLocked(PacketPtr pkt)
 {
     const RequestPtr &req = pkt->req;
     Addr paddr = LockedAddr::mask(req->getPaddr());
+    ContextID cid = req->contextId();
 
     // first we check if we already have a locked addr for this
     // xc.  Since each xc only gets one, we just update the
     // existing record with the new address.
-    std::list<LockedAddr>::iterator i;
-
-    for (i = lockedAddrList.begin(); i != lockedAddrList.end(); ++i) {
-        if (i->matchesContext(req)) {
-            DPRINTF(LLSC, "Modifying lock record: context %d addr %#x\n",
-                    req->contextId(), paddr);
-            i->addr = paddr;
-            return;
+    auto i = lockedContexts.find(cid);
+    if (i != lockedContexts.end()) {
+        DPRINTF(LLSC, "Modifying lock record: context %d addr %#x\n",
+                cid, paddr);
+        if (i->second != paddr) {
+            auto line = lockedLines.find(i->second);
+            assert(line != lockedLines.end());
+            auto &cids = line->second;
+            cids.erase(std::find(cids.begin(), cids.end(), cid));
+            if (cids.empty())
+                lockedLines.erase(line);
+            lockedLines[paddr].push_back(cid);
+            i->second = paddr;
         }
+        return;
     }
 
     // no record for this xc: need to allocate a new one
     DPRINTF(LLSC, "Adding lock record: context %d addr %#x\n",
-            req->contextId(), paddr);
-    lockedAddrList.push_front(LockedAddr(req));
+            cid, paddr);
+    lockedContexts.emplace(cid, paddr);
+    lockedLines[paddr].push_back(cid);
     backdoor.invalidate();
 }
 
@@ -286,54 +325,47 @@ AbstractMemory::checkLockedAddrList(PacketPtr pkt)
     // otherwise.
     bool allowStore = !isLLSC;
 
-    // Iterate over list.  Note that there could be multiple matching records,
-    // as more than one context could have done a load locked to this location.
-    // Only remove records when we succeed in finding a record for (xc, addr);
-    // then, remove all records with this address.  Failed store-conditionals do
-    // not blow unrelated reservations.
-    std::list<LockedAddr>::iterator i = lockedAddrList.begin();
+    // Only the contexts with a lock on this address are affected by
+    // the store. There could be several of them, as more than one
+    // context could have done a load locked to this location.
+    auto line = lockedLines.find(paddr);
 
     if (isLLSC) {
-        while (i != lockedAddrList.end()) {
-            if (i->addr == paddr && i->matchesContext(req)) {
-                // it's a store conditional, and as far as the memory system can
-                // tell, the requesting context's lock is still valid.
+        assert(req->hasContextId());
+        if (line != lockedLines.end()) {
+            const auto &cids = line->second;
+            if (std::find(cids.begin(), cids.end(), req->contextId()) !=
+                cids.end()) {
+                // it's a store conditional, and as far as the memory
+                // system can tell, the requesting context's lock is
+                // still valid.
                 DPRINTF(LLSC, "StCond success: context %d addr %#x\n",
                         req->contextId(), paddr);
                 allowStore = true;
-                break;
             }
-            // If we didn't find a match, keep searching!  Someone else may well
-            // have a reservation on this line here but we may find ours in just
-            // a little while.
-            i++;
         }
         req->setExtraData(allowStore ? 1 : 0);
     }
     // LLSCs that succeeded AND non-LLSC stores both fall into here:
-    if (allowStore) {
-        // We write address paddr.  However, there may be several entries with a
-        // reservation on this address (for other contextIds) and they must all
-        // be removed.
-        i = lockedAddrList.begin();
-        while (i != lockedAddrList.end()) {
-            if (i->addr == paddr) {
-                DPRINTF(LLSC, "Erasing lock record: context %d addr %#x\n",
-                        i->contextId, paddr);
-                ContextID owner_cid = i->contextId;
-                assert(owner_cid != InvalidContextID);
-                ContextID requestor_cid = req->hasContextId() ?
-                                           req->contextId() :
-                                           InvalidContextID;
-                if (owner_cid != requestor_cid) {
-                    ThreadContext* ctx = system()->threads[owner_cid];
-                    TheISA::globalClearExclusive(ctx);
-                }
-                i = lockedAddrList.erase(i);
-            } else {
-                i++;
+    if (allowStore && line != lockedLines.end()) {
+        // We write address paddr.  However, there may be several
+        // reservations on this address (for other contextIds) and they
+        // must all be removed. Failed store-conditionals do not blow
+        // unrelated reservations.
+        ContextID requestor_cid = req->hasContextId() ?
+                                   req->contextId() :
+                                   InvalidContextID;
+        for (ContextID owner_cid : line->second) {
+            DPRINTF(LLSC, "Erasing lock record: context %d addr %#x\n",
+                    owner_cid, paddr);
+            assert(owner_cid != InvalidContextID);
+            if (owner_cid != requestor_cid) {
+                ThreadContext* ctx = system()->threads[owner_cid];
+                TheISA::globalClearExclusive(ctx);
             }
+            lockedContexts.erase(owner_cid);
         }
+        lockedLines.erase(line);
     }
 
     return allowStore;
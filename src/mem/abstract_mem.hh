@@ -46,6 +46,11 @@
 #ifndef __MEM_ABSTRACT_MEMORY_HH__
 #define __MEM_ABSTRACT_MEMORY_HH__
 
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
 #include "mem/backdoor.hh"
 #include "mem/port.hh"
 #include "params/AbstractMemory.hh"
@@ -123,12 +128,21 @@ class AbstractMemory : public ClockedObject
     // Should KVM map this memory for the guest
     const bool kvmMap;
 
-    std::list<LockedAddr> lockedAddrList;
+    // Host NUMA node of the backing store, or -1 if not bound
+    const int _hostNumaNode;
+
+    // Locked address of each context holding a lock. Each context
+    // holds at most one lock.
+    std::map<ContextID, Addr> lockedContexts;
+
+    // Contexts holding a lock on each locked address, so that stores
+    // only have to look up their own address
+    std::unordered_map<Addr, std::vector<ContextID>> lockedLines;
 
     // helper function for checkLockedAddrs(): we really want to
-    // inline a quick check for an empty locked addr list (hopefully
-    // the common case), and do the full list search (if necessary) in
-    // this out-of-line function
+    // inline a quick check for no locked addrs (hopefully the common
+    // case), and do the lookup (if necessary) in this out-of-line
+    // function
     bool checkLockedAddrList(PacketPtr pkt);
 
     // Record the address of a load-locked operation so that we can
@@ -145,7 +159,7 @@ class AbstractMemory : public ClockedObject
     // non-conditional stores must clear any matching lock addresses.
     bool writeOK(PacketPtr pkt) {
         const RequestPtr &req = pkt->req;
-        if (lockedAddrList.empty()) {
+        if (lockedLines.empty()) {
             // no locked addrs: nothing to check, store_conditional fails
             bool isLLSC = pkt->isLLSC();
             if (isLLSC) {
@@ -153,7 +167,7 @@ class AbstractMemory : public ClockedObject
             }
             return !isLLSC; // only do write if not an sc
         } else {
-            // iterate over list...
+            // look up the address...
             return checkLockedAddrList(pkt);
         }
     }
@@ -230,28 +244,35 @@ class AbstractMemory : public ClockedObject
     void
     getBackdoor(MemBackdoorPtr &bd_ptr)
     {
-        if (lockedAddrList.empty() && backdoor.ptr())
+        if (lockedLines.empty() && backdoor.ptr())
             bd_ptr = &backdoor;
     }
 
+    /**
+     * Get a back door for functional accesses. Functional accesses may
+     * only bypass the memory controller while the system is in atomic
+     * mode, since there can't be any packets in flight that would have
+     * to be updated.
+     */
+    void getFunctionalBackdoor(MemBackdoorPtr &bd_ptr);
+
+    /**
+     * Whether a back door may be used depends on the memory mode and on
+     * the components in between, e.g. if caches are bypassed, so back
+     * doors are dropped whenever the simulation is resumed as the mode
+     * may have changed.
+     */
+    void drainResume() override;
+
     /**
      * Get the list of locked addresses to allow checkpointing.
      */
-    const std::list<LockedAddr> &
-    getLockedAddrList() const
-    {
-        return lockedAddrList;
-    }
+    std::list<LockedAddr> getLockedAddrList() const;
 
     /**
      * Add a locked address to allow for checkpointing.
      */
-    void
-    addLockedAddr(LockedAddr addr)
-    {
-        backdoor.invalidate();
-        lockedAddrList.push_back(addr);
-    }
+    void addLockedAddr(LockedAddr addr);
 
     /** read the system pointer
      * Implemented for completeness with the setter
@@ -324,6 +345,14 @@ class AbstractMemory : public ClockedObject
      */
     bool isKvmMap() const { return kvmMap; }
 
+    /**
+     * Host NUMA node the backing store of this memory should be
+     * allocated on.
+     *
+     * @return the host node, or -1 for the default host policy
+     */
+    int hostNumaNode() const { return _hostNumaNode; }
+
     /**
      * Perform an untimed memory access and update all the state
      * (e.g. locked addresses) and statistics accordingly. The packet
@@ -246,37 +246,44 @@ Bridge::BridgeRequestPort::trySendTiming()
 {
     assert(!transmitList.empty());
 
-    DeferredPacket req = transmitList.front();
+    // Send all the packets that are due at this clock edge in one go,
+    // rather than scheduling an event for each of them
+    do {
+        DeferredPacket req = transmitList.front();
 
-    assert(req.tick <= curTick());
+        assert(req.tick <= curTick());
 
-    PacketPtr pkt = req.pkt;
+        PacketPtr pkt = req.pkt;
 
-    DPRINTF(Bridge, "trySend request addr 0x%x, queue size %d\n",
-            pkt->getAddr(), transmitList.size());
+        DPRINTF(Bridge, "trySend request addr 0x%x, queue size %d\n",
+                pkt->getAddr(), transmitList.size());
+
+        // if the send failed, then we try again once we receive a
+        // retry, and therefore there is no need to take any action
+        if (!sendTimingReq(pkt))
+            return;
 
-    if (sendTimingReq(pkt)) {
         // send successful
         transmitList.pop_front();
         DPRINTF(Bridge, "trySend request successful\n");
 
-        // If there are more packets to send, schedule event to try again.
-        if (!transmitList.empty()) {
-            DeferredPacket next_req = transmitList.front();
-            DPRINTF(Bridge, "Scheduling next send\n");
-            bridge.schedule(sendEvent, std::max(next_req.tick,
-                                                bridge.clockEdge()));
-        }
-
         // if we have stalled a request due to a full request queue,
         // then send a retry at this point, also note that if the
         // request we stalled was waiting for the response queue
         // rather than the request queue we might stall it again
         cpuSidePort.retryStalledReq();
+    } while (!transmitList.empty() && !sendEvent.scheduled() &&
+             transmitList.front().tick <= curTick() &&
+             bridge.clockEdge() == curTick());
+
+    // If there are more packets to send, schedule event to try
+    // again. A retried request may already have scheduled it.
+    if (!transmitList.empty() && !sendEvent.scheduled()) {
+        DeferredPacket next_req = transmitList.front();
+        DPRINTF(Bridge, "Scheduling next send\n");
+        bridge.schedule(sendEvent, std::max(next_req.tick,
+                                            bridge.clockEdge()));
     }
-
-    // if the send failed, then we try again once we receive a retry,
-    // and therefore there is no need to take any action
 }
 
 void
@@ -284,16 +291,23 @@ Bridge::BridgeResponsePort::trySendTiming()
 {
     assert(!transmitList.empty());
 
-    DeferredPacket resp = transmitList.front();
+    // Send all the packets that are due at this clock edge in one go,
+    // rather than scheduling an event for each of them
+    do {
+        DeferredPacket resp = transmitList.front();
 
-    assert(resp.tick <= curTick());
+        assert(resp.tick <= curTick());
 
-    PacketPtr pkt = resp.pkt;
+        PacketPtr pkt = resp.pkt;
 
-    DPRINTF(Bridge, "trySend response addr 0x%x, outstanding %d\n",
-            pkt->getAddr(), outstandingResponses);
+        DPRINTF(Bridge, "trySend response addr 0x%x, outstanding %d\n",
+                pkt->getAddr(), outstandingResponses);
+
+        // if the send failed, then we try again once we receive a
+        // retry, and therefore there is no need to take any action
+        if (!sendTimingResp(pkt))
+            return;
 
-    if (sendTimingResp(pkt)) {
         // send successful
         transmitList.pop_front();
         DPRINTF(Bridge, "trySend response successful\n");
@@ -301,14 +315,6 @@ Bridge::BridgeResponsePort::trySendTiming()
         assert(outstandingResponses != 0);
         --outstandingResponses;
 
-        // If there are more packets to send, schedule event to try again.
-        if (!transmitList.empty()) {
-            DeferredPacket next_resp = transmitList.front();
-            DPRINTF(Bridge, "Scheduling next send\n");
-            bridge.schedule(sendEvent, std::max(next_resp.tick,
-                                                bridge.clockEdge()));
-        }
-
         // if there is space in the request queue and we were stalling
         // a request, it will definitely be possible to accept it now
         // since there is guaranteed space in the response queue
@@ -317,10 +323,17 @@ Bridge::BridgeResponsePort::trySendTiming()
             retryReq = false;
             sendRetryReq();
         }
+    } while (!transmitList.empty() && !sendEvent.scheduled() &&
+             transmitList.front().tick <= curTick() &&
+             bridge.clockEdge() == curTick());
+
+    // If there are more packets to send, schedule event to try again
+    if (!transmitList.empty() && !sendEvent.scheduled()) {
+        DeferredPacket next_resp = transmitList.front();
+        DPRINTF(Bridge, "Scheduling next send\n");
+        bridge.schedule(sendEvent, std::max(next_resp.tick,
+                                            bridge.clockEdge()));
     }
-
-    // if the send failed, then we try again once we receive a retry,
-    // and therefore there is no need to take any action
 }
 
 void
@@ -130,6 +130,14 @@ class BaseCache(ClockedObject):
     # cache.
     writeback_clean = Param.Bool(False, "Writeback clean lines")
 
+    # Only model the state of the blocks and the timing of the cache,
+    # rather than keeping a copy of their data. The blocks read and write
+    # the backing store of the memories directly, so this must be set for
+    # all the caches of the system, and requires caches to only hold
+    # addresses of memories that are not null.
+    tags_only = Param.Bool(False, "Don't store data, access the backing "
+                           "store of the memories instead")
+
     # Control whether this cache should be mostly inclusive or mostly
     # exclusive with respect to upstream caches. The behaviour on a
     # fill is determined accordingly. For a mostly inclusive cache,
@@ -83,6 +83,7 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       prefetcher(p.prefetcher),
       writeAllocator(p.write_allocator),
       writebackClean(p.writeback_clean),
+      tagsOnly(p.tags_only),
       tempBlockWriteback(nullptr),
       writebackTempBlockAtomicEvent([this]{ writebackTempBlockAtomic(); },
                                     name(), false,
@@ -96,6 +97,7 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       sequentialAccess(p.sequential_access),
       numTarget(p.tgts_per_mshr),
       forwardSnoops(true),
+      passBackdoors(false),
       clusivity(p.clusivity),
       isReadOnly(p.is_read_only),
       replaceExpansions(p.replace_expansions),
@@ -130,6 +132,8 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
         "Compressed cache %s does not have a compression algorithm", name());
     if (compressor)
         compressor->setCache(this);
+    fatal_if(tagsOnly && compressor,
+        "Compressed cache %s can't be tags only", name());
 }
 
 BaseCache::~BaseCache()
@@ -193,6 +197,27 @@ BaseCache::init()
     forwardSnoops = cpuSidePort.isSnooping();
 }
 
+void
+BaseCache::startup()
+{
+    updatePassBackdoors();
+}
+
+void
+BaseCache::drainResume()
+{
+    updatePassBackdoors();
+}
+
+void
+BaseCache::updatePassBackdoors()
+{
+    passBackdoors = system->bypassCaches() && !isDirty();
+    warn_if(system->bypassCaches() && !passBackdoors,
+            "%s holds dirty data while caches are bypassed, not passing "
+            "on memory back doors.\n", name());
+}
+
 Port &
 BaseCache::getPort(const std::string &if_name, PortID idx)
 {
@@ -695,8 +720,10 @@ BaseCache::updateBlockData(CacheBlk *blk, const PacketPtr cpkt,
         }
     }
 
-    // Actually perform the data update
-    if (cpkt) {
+    // Actually perform the data update. The data of fills and writebacks
+    // was read from the backing store a tags only block points to.
+    if (cpkt && !(tagsOnly && (cpkt->isResponse() || cpkt->isEviction() ||
+                               cpkt->cmd == MemCmd::WriteClean))) {
         cpkt->writeDataToBlock(blk->data, blkSize);
     }
 
@@ -1439,6 +1466,8 @@ BaseCache::handleFill(PacketPtr pkt, CacheBlk *blk, PacketList &writebacks,
             // current request and then get rid of it
             blk = tempBlock;
             tempBlock->insert(addr, is_secure);
+            if (tagsOnly)
+                setTagsOnlyData(tempBlock, addr);
             DPRINTF(Cache, "using temp block for %#llx (%s)\n", addr,
                     is_secure ? "s" : "ns");
         }
@@ -1553,6 +1582,8 @@ BaseCache::allocateBlock(const PacketPtr pkt, PacketList &writebacks)
 
     // Insert new block at victimized entry
     tags->insertBlock(pkt, victim);
+    if (tagsOnly)
+        setTagsOnlyData(victim, addr);
 
     // If using a compressor, set compression data. This must be done after
     // insertion, as the compression bit may be set.
@@ -1564,6 +1595,14 @@ BaseCache::allocateBlock(const PacketPtr pkt, PacketList &writebacks)
     return victim;
 }
 
+void
+BaseCache::setTagsOnlyData(CacheBlk *blk, Addr addr)
+{
+    blk->data = system->getPhysMem().toHostAddr(addr);
+    fatal_if(!blk->data, "Tags only cache %s can't hold %#x, which is not "
+             "backed by a memory", name(), addr);
+}
+
 void
 BaseCache::invalidateBlock(CacheBlk *blk)
 {
@@ -1603,7 +1642,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1631,8 +1670,14 @@ BaseCache::writebackBlk(CacheBlk *blk)
     // make sure the block is not marked dirty
     blk->clearCoherenceBits(CacheBlk::DirtyBit);
 
-    pkt->allocate();
-    pkt->setDataFromBlock(blk->data, blkSize);
+    // The data of a tags only block is the backing store itself, which
+    // the packet can refer to rather than carrying a copy
+    if (tagsOnly) {
+        pkt->dataStatic(blk->data);
+    } else {
+        pkt->allocate();
+        pkt->setDataFromBlock(blk->data, blkSize);
+    }
 
     // When a block is compressed, it must first be decompressed before being
     // sent for writeback.
@@ -1646,7 +1691,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1676,8 +1721,14 @@ BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
     // make sure the block is not marked dirty
     blk->clearCoherenceBits(CacheBlk::DirtyBit);
 
-    pkt->allocate();
-    pkt->setDataFromBlock(blk->data, blkSize);
+    // The data of a tags only block is the backing store itself, which
+    // the packet can refer to rather than carrying a copy
+    if (tagsOnly) {
+        pkt->dataStatic(blk->data);
+    } else {
+        pkt->allocate();
+        pkt->setDataFromBlock(blk->data, blkSize);
+    }
 
     // When a block is compressed, it must first be decompressed before being
     // sent for writeback.
@@ -1720,7 +1771,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -2441,6 +2492,19 @@ BaseCache::CpuSidePort::recvAtomic(PacketPtr pkt)
     }
 }
 
+Tick
+BaseCache::CpuSidePort::recvAtomicBackdoor(PacketPtr pkt,
+                                           MemBackdoorPtr &backdoor)
+{
+    if (cache->passBackdoors) {
+        return cache->memSidePort.sendAtomicBackdoor(pkt, backdoor);
+    } else {
+        // Every access has to go through the cache to keep it up to
+        // date, so there's no back door to hand out.
+        return recvAtomic(pkt);
+    }
+}
+
 void
 BaseCache::CpuSidePort::recvFunctional(PacketPtr pkt)
 {
@@ -2455,6 +2519,14 @@ BaseCache::CpuSidePort::recvFunctional(PacketPtr pkt)
     cache->functionalAccess(pkt, true);
 }
 
+void
+BaseCache::CpuSidePort::recvMemBackdoorReq(const AddrRange &range,
+                                           MemBackdoorPtr &backdoor)
+{
+    if (cache->passBackdoors)
+        cache->memSidePort.sendMemBackdoorReq(range, backdoor);
+}
+
 AddrRangeList
 BaseCache::CpuSidePort::getAddrRanges() const
 {
@@ -316,8 +316,14 @@ class BaseCache : public ClockedObject
 
         virtual Tick recvAtomic(PacketPtr pkt) override;
 
+        virtual Tick recvAtomicBackdoor(PacketPtr pkt,
+                                        MemBackdoorPtr &backdoor) override;
+
         virtual void recvFunctional(PacketPtr pkt) override;
 
+        virtual void recvMemBackdoorReq(const AddrRange &range,
+                                        MemBackdoorPtr &backdoor) override;
+
         virtual AddrRangeList getAddrRanges() const override;
 
       public:
@@ -666,6 +672,23 @@ class BaseCache : public ClockedObject
      */
     const bool writebackClean;
 
+    /**
+     * Whether the cache only models tags. The data pointer of a block then
+     * refers to the backing store of the memory holding its address, so
+     * fills and writebacks don't need to copy any data, while accesses
+     * read and write the memory directly.
+     */
+    const bool tagsOnly;
+
+    /**
+     * Point the data of a block to the backing store of the memory of an
+     * address, for a tags only cache.
+     *
+     * @param blk The block that was just filled.
+     * @param addr The address of the block.
+     */
+    void setTagsOnlyData(CacheBlk *blk, Addr addr);
+
     /**
      * Writebacks from the tempBlock, resulting on the response path
      * in atomic mode, must happen after the call to recvAtomic has
@@ -919,6 +942,19 @@ class BaseCache : public ClockedObject
     /** Do we forward snoops from mem side port through to cpu side port? */
     bool forwardSnoops;
 
+    /**
+     * Do we pass memory back doors from the mem side port through to
+     * the cpu side port? This is only done while the system bypasses
+     * caches and the cache doesn't hold any dirty data, as accesses
+     * through a back door would miss it otherwise. The contents of the
+     * cache can't change while it is bypassed, so this only has to be
+     * updated when the simulation is (re)started.
+     */
+    bool passBackdoors;
+
+    /** Update passBackdoors according to the current memory mode. */
+    void updatePassBackdoors();
+
     /**
      * Clusivity with respect to the upstream cache, determining if we
      * fill into both this cache and the cache above on a miss. Note
@@ -1141,6 +1177,8 @@ class BaseCache : public ClockedObject
     ~BaseCache();
 
     void init() override;
+    void startup() override;
+    void drainResume() override;
 
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
@@ -1157,6 +1195,23 @@ class BaseCache : public ClockedObject
 
     const AddrRangeList &getAddrRanges() const { return addrRanges; }
 
+    /**
+     * Perform an atomic access outside of the normal request flow,
+     * e.g., to warm the cache up with accesses recorded while the caches
+     * were bypassed. Misses fill the levels below as well. The system
+     * must be drained and must not bypass the caches.
+     *
+     * @param pkt The access, which is turned into a response
+     * @return The latency of the access
+     */
+    Tick
+    warmAccess(PacketPtr pkt)
+    {
+        panic_if(system->bypassCaches(),
+                 "%s: Can't warm a cache that is bypassed.\n", name());
+        return recvAtomic(pkt);
+    }
+
     MSHR *allocateMissBuffer(PacketPtr pkt, Tick time, bool sched_send = true)
     {
         MSHR *mshr = mshrQueue.allocate(pkt->getBlockAddr(blkSize), blkSize,
@@ -50,6 +50,7 @@
 #include <cstdint>
 #include <iosfwd>
 #include <list>
+#include <memory>
 #include <string>
 
 #include "base/printable.hh"
@@ -500,18 +501,21 @@ class TempCacheBlk final : public CacheBlk
      */
     Addr _addr;
 
+    /** The block's own storage, data may point elsewhere. */
+    std::unique_ptr<uint8_t[]> storage;
+
   public:
     /**
      * Creates a temporary cache block, with its own storage.
      * @param size The size (in bytes) of this cache block.
      */
-    TempCacheBlk(unsigned size) : CacheBlk()
+    TempCacheBlk(unsigned size) : CacheBlk(), storage(new uint8_t[size])
     {
-        data = new uint8_t[size];
+        data = storage.get();
     }
     TempCacheBlk(const TempCacheBlk&) = delete;
     TempCacheBlk& operator=(const TempCacheBlk&) = delete;
-    ~TempCacheBlk() { delete [] data; };
+    ~TempCacheBlk() {};
 
     /**
      * Invalidate the block and clear all state.
@@ -53,6 +53,10 @@ class BaseCacheCompressor(SimObject):
     decomp_extra_latency = Param.Cycles(1, "Number of extra cycles required "
         "to finish decompression (e.g., due to shifting and packaging).")
 
+    memo_entries = Param.Unsigned(0, "Number of compression results "
+        "memoized by line contents, to avoid compressing the same data "
+        "again. Must be a power of 2; 0 disables memoization")
+
 class BaseDictionaryCompressor(BaseCacheCompressor):
     type = 'BaseDictionaryCompressor'
     abstract = True
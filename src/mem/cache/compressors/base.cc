@@ -36,8 +36,10 @@
 #include <climits>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
 #include "mem/cache/base.hh"
@@ -83,7 +85,8 @@ Base::Base(const Params &p)
     compExtraLatency(p.comp_extra_latency),
     decompChunksPerCycle(p.decomp_chunks_per_cycle),
     decompExtraLatency(p.decomp_extra_latency),
-    cache(nullptr), stats(*this)
+    cache(nullptr), memo(p.memo_entries),
+    memoData(p.memo_entries * (blkSize / sizeof(uint64_t))), stats(*this)
 {
     fatal_if(64 % chunkSizeBits,
         "64 must be a multiple of the chunk granularity.");
@@ -96,6 +99,9 @@ Base::Base(const Params &p)
         "chunks in the input");
 
     fatal_if(blkSize < sizeThreshold, "Compressed data must fit in a block");
+
+    fatal_if(!isPowerOf2(memo.size()) && !memo.empty(),
+        "The number of memoized compressions must be a power of 2");
 }
 
 void
@@ -144,6 +150,23 @@ Base::fromChunks(const std::vector<Chunk>& chunks, uint64_t* data) const
 std::unique_ptr<Base::CompressionData>
 Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
 {
+    // Look for a memoized result of the same line contents
+    MemoEntry *memo_entry = nullptr;
+    uint64_t *memo_data = nullptr;
+    uint64_t hash = 0;
+    if (!memo.empty()) {
+        hash = hashLine(data);
+        const std::size_t index = hash & (memo.size() - 1);
+        memo_entry = &memo[index];
+        memo_data = &memoData[index * (blkSize / sizeof(uint64_t))];
+        if (memo_entry->valid && memo_entry->hash == hash &&
+            !std::memcmp(memo_data, data, blkSize)) {
+            stats.memoHits++;
+            return memoizedCompress(*memo_entry, comp_lat, decomp_lat);
+        }
+        stats.memoMisses++;
+    }
+
     // Apply compression
     std::unique_ptr<CompressionData> comp_data =
         compress(toChunks(data), comp_lat, decomp_lat);
@@ -164,13 +187,52 @@ Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
     // Get compression size. If compressed size is greater than the size
     // threshold, the compression is seen as unsuccessful
     std::size_t comp_size_bits = comp_data->getSizeBits();
-    if (comp_size_bits > sizeThreshold * CHAR_BIT) {
+    const bool failed = comp_size_bits > sizeThreshold * CHAR_BIT;
+    if (failed) {
         comp_size_bits = blkSize * CHAR_BIT;
         comp_data->setSizeBits(comp_size_bits);
+    }
+
+    // Memoize the result, replacing whichever line was using the entry
+    if (memo_entry) {
+        memo_entry->valid = true;
+        memo_entry->hash = hash;
+        memo_entry->sizeBits = comp_size_bits;
+        memo_entry->failed = failed;
+        memo_entry->compLat = comp_lat;
+        memo_entry->decompLat = decomp_lat;
+        std::memcpy(memo_data, data, blkSize);
+    }
+
+    updateCompressionStats(comp_size_bits, failed, comp_lat, decomp_lat);
+
+    return comp_data;
+}
+
+std::unique_ptr<Base::CompressionData>
+Base::memoizedCompress(const MemoEntry& entry, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    comp_lat = entry.compLat;
+    decomp_lat = entry.decompLat;
+
+    std::unique_ptr<CompressionData> comp_data(new CompressionData());
+    comp_data->setSizeBits(entry.sizeBits);
+
+    updateCompressionStats(entry.sizeBits, entry.failed, comp_lat,
+        decomp_lat);
+
+    return comp_data;
+}
+
+void
+Base::updateCompressionStats(std::size_t comp_size_bits, bool failed,
+    Cycles comp_lat, Cycles decomp_lat)
+{
+    if (failed) {
         stats.failedCompressions++;
     }
 
-    // Update stats
     stats.compressions++;
     stats.compressionSizeBits += comp_size_bits;
     if (comp_size_bits != 0) {
@@ -183,10 +245,34 @@ Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
     DPRINTF(CacheComp, "Compressed cache line from %d to %d bits. " \
             "Compression latency: %llu, decompression latency: %llu\n",
             blkSize*8, comp_size_bits, comp_lat, decomp_lat);
+}
 
-    return comp_data;
+uint64_t
+Base::hashLine(const uint64_t* data) const
+{
+    // Accumulate the words with the rounds and the final avalanche of
+    // xxHash64. Lines are small and always a multiple of 8 bytes, so a
+    // single accumulator is enough
+    const uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+    const uint64_t prime3 = 0x165667B19E3779F9ULL;
+    uint64_t hash = prime3 + blkSize;
+    for (std::size_t i = 0; i < blkSize / sizeof(uint64_t); i++) {
+        uint64_t word = data[i] * prime2;
+        word = ((word << 31) | (word >> 33)) * prime1;
+        hash ^= word;
+        hash = ((hash << 27) | (hash >> 37)) * prime1 + prime2;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
 }
 
+
 Cycles
 Base::getDecompressionLatency(const CacheBlk* blk)
 {
@@ -237,7 +323,13 @@ Base::BaseStats::BaseStats(Base& _compressor)
     ADD_STAT(avgCompressionSizeBits,
              UNIT_RATE(Stats::Units::Bit, Stats::Units::Count),
              "Average compression size"),
-    ADD_STAT(decompressions, UNIT_COUNT, "Total number of decompressions")
+    ADD_STAT(decompressions, UNIT_COUNT, "Total number of decompressions"),
+    ADD_STAT(memoHits, UNIT_COUNT,
+             "Number of compressions served by memoized results"),
+    ADD_STAT(memoMisses, UNIT_COUNT,
+             "Number of compressions not found in the memoized results"),
+    ADD_STAT(memoHitRate, UNIT_RATIO,
+             "Ratio of compressions served by memoized results")
 {
 }
 
@@ -260,6 +352,11 @@ Base::BaseStats::regStats()
 
     avgCompressionSizeBits.flags(Stats::total | Stats::nozero | Stats::nonan);
     avgCompressionSizeBits = compressionSizeBits / compressions;
+
+    memoHits.flags(Stats::nozero);
+    memoMisses.flags(Stats::nozero);
+    memoHitRate.flags(Stats::nozero | Stats::nonan);
+    memoHitRate = memoHits / (memoHits + memoMisses);
 }
 
 } // namespace Compressor
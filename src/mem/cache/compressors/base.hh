@@ -37,6 +37,7 @@
 #define __MEM_CACHE_COMPRESSORS_BASE_HH__
 
 #include <cstdint>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "base/types.hh"
@@ -123,6 +124,71 @@ class Base : public SimObject
     /** Pointer to the parent cache. */
     BaseCache* cache;
 
+    /**
+     * A memoized compression result. Only what the caches use from a
+     * compression is kept: its size and latencies.
+     */
+    struct MemoEntry
+    {
+        /** Whether the entry holds a result. */
+        bool valid = false;
+
+        /** Hash of the line contents. */
+        uint64_t hash = 0;
+
+        /** Compressed size, in bits, after the size threshold is applied. */
+        std::size_t sizeBits = 0;
+
+        /** Whether the size threshold was not achieved. */
+        bool failed = false;
+
+        Cycles compLat;
+        Cycles decompLat;
+    };
+
+    /**
+     * Direct-mapped table of memoized compression results, indexed by the
+     * hash of the line contents. Empty if memoization is disabled.
+     */
+    std::vector<MemoEntry> memo;
+
+    /**
+     * Contents of the lines whose compression results are memoized, used
+     * to tell apart lines with colliding hashes. Entry i of the memo owns
+     * the blkSize bytes starting at i * blkSize.
+     */
+    std::vector<uint64_t> memoData;
+
+    /**
+     * Hash the contents of a cache line.
+     *
+     * @param data The cache line.
+     * @return The hash of the line.
+     */
+    uint64_t hashLine(const uint64_t* data) const;
+
+    /**
+     * Build the result of a compression from a memoized result.
+     *
+     * @param entry The memoized result.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     * @return Compression data holding only the compressed size.
+     */
+    std::unique_ptr<CompressionData> memoizedCompress(const MemoEntry& entry,
+        Cycles& comp_lat, Cycles& decomp_lat);
+
+    /**
+     * Account a compression in the stats.
+     *
+     * @param comp_size_bits Compressed size, in bits.
+     * @param failed Whether the size threshold was not achieved.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     */
+    void updateCompressionStats(std::size_t comp_size_bits, bool failed,
+        Cycles comp_lat, Cycles decomp_lat);
+
     struct BaseStats : public Stats::Group
     {
         const Base& compressor;
@@ -148,6 +214,15 @@ class Base : public SimObject
 
         /** Number of decompressions performed. */
         Stats::Scalar decompressions;
+
+        /** Number of compressions served by the memoized results. */
+        Stats::Scalar memoHits;
+
+        /** Number of compressions that had to be performed. */
+        Stats::Scalar memoMisses;
+
+        /** Ratio of compressions served by the memoized results. */
+        Stats::Formula memoHitRate;
     } stats;
 
     /**
@@ -204,6 +279,10 @@ class Base : public SimObject
      * Apply the compression process to the cache line. Ignores compression
      * cycles.
      *
+     * If memoization is enabled and the line contents were compressed
+     * recently, the memoized result is returned instead. It only contains
+     * the compressed size, so it must not be decompressed.
+     *
      * @param data The cache line to be compressed.
      * @param comp_lat Compression latency in number of cycles.
      * @param decomp_lat Decompression latency in number of cycles.
@@ -101,6 +101,15 @@ class BaseDelta : public DictionaryCompressor<BaseType>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    std::size_t
+    getPatternSize(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes,
+        const int match_location) const override
+    {
+        return PatternFactory::getPatternSize(bytes, dict_bytes,
+            match_location);
+    }
+
     std::string
     getName(int number) const override
     {
@@ -96,6 +96,15 @@ class CPack : public DictionaryCompressor<uint32_t>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    std::size_t getPatternSize(
+        const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes,
+        const int match_location) const override
+    {
+        return PatternFactory::getPatternSize(bytes, dict_bytes,
+            match_location);
+    }
+
     void addToDictionary(DictionaryEntry data) override;
 
   public:
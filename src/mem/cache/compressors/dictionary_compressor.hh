@@ -163,6 +163,23 @@ class DictionaryCompressor : public BaseDictionaryCompressor
                                                     match_location);
             }
         }
+
+        /**
+         * Get the size of the pattern getPattern() would instantiate. The
+         * pattern only lives on the stack, so that candidates can be
+         * compared without allocating them.
+         */
+        static std::size_t
+        getPatternSize(const DictionaryEntry& bytes,
+            const DictionaryEntry& dict_bytes, const int match_location)
+        {
+            if (Head::isPattern(bytes, dict_bytes, match_location)) {
+                return Head(bytes, match_location).getSizeBits();
+            } else {
+                return Factory<Tail...>::getPatternSize(bytes, dict_bytes,
+                                                        match_location);
+            }
+        }
     };
 
     /**
@@ -184,6 +201,13 @@ class DictionaryCompressor : public BaseDictionaryCompressor
         {
             return std::unique_ptr<Pattern>(new Head(bytes, match_location));
         }
+
+        static std::size_t
+        getPatternSize(const DictionaryEntry& bytes,
+            const DictionaryEntry& dict_bytes, const int match_location)
+        {
+            return Head(bytes, match_location).getSizeBits();
+        }
     };
 
     /** The dictionary. */
@@ -198,6 +222,16 @@ class DictionaryCompressor : public BaseDictionaryCompressor
     getPattern(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
         const int match_location) const = 0;
 
+    /**
+     * Get the size, in bits, of the pattern getPattern() would return for
+     * the same arguments, without instantiating it. As with getPattern(),
+     * classes that inherit from this base class have to implement the call
+     * to their factory's getPatternSize.
+     */
+    virtual std::size_t
+    getPatternSize(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes, const int match_location) const = 0;
+
     /**
      * Compress data.
      *
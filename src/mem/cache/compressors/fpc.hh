@@ -107,17 +107,31 @@ class FPC : public DictionaryCompressor<uint32_t>
         return patternNames[number];
     };
 
+    /**
+     * Convenience factory declaration. The templates must be organized by
+     * size, with the smallest first, and "no-match" last.
+     */
+    using PatternFactory = Factory<ZeroRun, SignExtended4Bits,
+        SignExtended1Byte, SignExtendedHalfword, ZeroPaddedHalfword,
+        SignExtendedTwoHalfwords, RepBytes, Uncompressed>;
+
     std::unique_ptr<Pattern> getPattern(
         const DictionaryEntry& bytes,
         const DictionaryEntry& dict_bytes,
         const int match_location) const override
     {
-        using PatternFactory = Factory<ZeroRun, SignExtended4Bits,
-            SignExtended1Byte, SignExtendedHalfword, ZeroPaddedHalfword,
-            SignExtendedTwoHalfwords, RepBytes, Uncompressed>;
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    std::size_t getPatternSize(
+        const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes,
+        const int match_location) const override
+    {
+        return PatternFactory::getPatternSize(bytes, dict_bytes,
+            match_location);
+    }
+
     void addToDictionary(const DictionaryEntry data) override;
 
     std::unique_ptr<DictionaryCompressor::CompData>
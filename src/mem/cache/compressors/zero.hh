@@ -89,6 +89,15 @@ class Zero : public DictionaryCompressor<uint64_t>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    std::size_t
+    getPatternSize(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes,
+        const int match_location) const override
+    {
+        return PatternFactory::getPatternSize(bytes, dict_bytes,
+            match_location);
+    }
+
     void addToDictionary(DictionaryEntry data) override;
 
     std::unique_ptr<Base::CompressionData> compress(
@@ -58,6 +58,24 @@ class AssociativeSet {
     /** Vector containing the entries of the container */
     std::vector<Entry> entries;
 
+    /**
+     * Whether the entries are laid out set after set, as the set associative
+     * indexing policy does, so lookups can index them directly instead of
+     * going through the indexing policy.
+     */
+    bool flat;
+    /** Set and tag bit positions of the keys, when the layout is flat */
+    int setShift;
+    unsigned setMask;
+    int tagShift;
+
+    /** Get the tag of a key */
+    Addr
+    extractTag(Addr addr) const
+    {
+        return flat ? addr >> tagShift : indexingPolicy->extractTag(addr);
+    }
+
   public:
     /**
      * Public constructor
@@ -96,11 +114,13 @@ class AssociativeSet {
 
     /**
      * Find the set of entries that could be replaced given
-     * that we want to add a new entry with the provided key
+     * that we want to add a new entry with the provided key. The entries
+     * are of type Entry, the reference is only valid until the next call.
      * @param addr key to select the set of entries
      * @result vector of candidates matching with the provided key
      */
-    std::vector<Entry *> getPossibleEntries(const Addr addr) const;
+    const std::vector<ReplaceableEntry *> &
+    getPossibleEntries(const Addr addr) const;
 
     /**
      * Indicate that an entry has just been inserted
@@ -31,13 +31,15 @@
 
 #include "base/intmath.hh"
 #include "mem/cache/prefetch/associative_set.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
 
 template<class Entry>
 AssociativeSet<Entry>::AssociativeSet(int assoc, int num_entries,
         BaseIndexingPolicy *idx_policy, ReplacementPolicy::Base *rpl_policy,
         Entry const &init_value)
   : associativity(assoc), numEntries(num_entries), indexingPolicy(idx_policy),
-    replacementPolicy(rpl_policy), entries(numEntries, init_value)
+    replacementPolicy(rpl_policy), entries(numEntries, init_value),
+    flat(false), setShift(0), setMask(0), tagShift(0)
 {
     fatal_if(!isPowerOf2(num_entries), "The number of entries of an "
              "AssociativeSet<> must be a power of 2");
@@ -48,14 +50,42 @@ AssociativeSet<Entry>::AssociativeSet(int assoc, int num_entries,
         indexingPolicy->setEntry(entry, entry_idx);
         entry->replacementData = replacementPolicy->instantiateEntry();
     }
+
+    auto *set_assoc = dynamic_cast<SetAssociative *>(indexingPolicy);
+    if (set_assoc && set_assoc->getSetMask() + 1 == numEntries / assoc) {
+        flat = true;
+        for (unsigned int entry_idx = 0; entry_idx < numEntries;
+             entry_idx += 1) {
+            flat = flat && entries[entry_idx].getSet() == entry_idx / assoc &&
+                entries[entry_idx].getWay() == entry_idx % assoc;
+        }
+        setShift = set_assoc->getSetShift();
+        setMask = set_assoc->getSetMask();
+        tagShift = set_assoc->getTagShift();
+    }
 }
 
 template<class Entry>
 Entry*
 AssociativeSet<Entry>::findEntry(Addr addr, bool is_secure) const
 {
-    Addr tag = indexingPolicy->extractTag(addr);
-    const std::vector<ReplaceableEntry*> selected_entries =
+    Addr tag = extractTag(addr);
+
+    if (flat) {
+        // The entries are all exactly of type Entry, so the accessors can
+        // be bound statically and inlined
+        const Entry *set =
+            &entries[((addr >> setShift) & setMask) * associativity];
+        for (int way = 0; way < associativity; ++way) {
+            if ((set[way].Entry::getTag() == tag) && set[way].Entry::isValid()
+                && set[way].isSecure() == is_secure) {
+                return const_cast<Entry *>(&set[way]);
+            }
+        }
+        return nullptr;
+    }
+
+    const std::vector<ReplaceableEntry*> &selected_entries =
         indexingPolicy->getPossibleEntries(addr);
 
     for (const auto& location : selected_entries) {
@@ -80,7 +110,7 @@ Entry*
 AssociativeSet<Entry>::findVictim(Addr addr)
 {
     // Get possible entries to be victimized
-    const std::vector<ReplaceableEntry*> selected_entries =
+    const std::vector<ReplaceableEntry*> &selected_entries =
         indexingPolicy->getPossibleEntries(addr);
     Entry* victim = static_cast<Entry*>(replacementPolicy->getVictim(
                             selected_entries));
@@ -91,25 +121,17 @@ AssociativeSet<Entry>::findVictim(Addr addr)
 
 
 template<class Entry>
-std::vector<Entry *>
+const std::vector<ReplaceableEntry *> &
 AssociativeSet<Entry>::getPossibleEntries(const Addr addr) const
 {
-    std::vector<ReplaceableEntry *> selected_entries =
-        indexingPolicy->getPossibleEntries(addr);
-    std::vector<Entry *> entries(selected_entries.size(), nullptr);
-
-    unsigned int idx = 0;
-    for (auto &entry : selected_entries) {
-        entries[idx++] = static_cast<Entry *>(entry);
-    }
-    return entries;
+    return indexingPolicy->getPossibleEntries(addr);
 }
 
 template<class Entry>
 void
 AssociativeSet<Entry>::insertEntry(Addr addr, bool is_secure, Entry* entry)
 {
-   entry->insert(indexingPolicy->extractTag(addr), is_secure);
+   entry->insert(extractTag(addr), is_secure);
    replacementPolicy->reset(entry->replacementData);
 }
 
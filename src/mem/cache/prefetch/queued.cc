@@ -38,6 +38,7 @@
 #include "mem/cache/prefetch/queued.hh"
 
 #include <cassert>
+#include <iterator>
 
 #include "arch/generic/tlb.hh"
 #include "base/logging.hh"
@@ -55,8 +56,8 @@ Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
                                             bool tag_prefetch,
                                             Tick t) {
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size,
-                                                0, requestor_id);
+    RequestPtr req = Request::create(paddr, blk_size,
+                                      0, requestor_id);
 
     if (pfInfo.isSecure()) {
         req->setFlags(Request::SECURE);
@@ -92,6 +93,51 @@ Queued::DeferredPacket::finish(const Fault &fault,
     owner->translationComplete(this, failed);
 }
 
+Queued::iterator
+Queued::DeferredQueue::find(Addr addr, bool is_secure)
+{
+    auto range = index.equal_range(addr);
+    for (auto entry = range.first; entry != range.second; ++entry) {
+        if (entry->second->pfInfo.isSecure() == is_secure) {
+            return entry->second;
+        }
+    }
+    return packets.end();
+}
+
+Queued::iterator
+Queued::DeferredQueue::find(const DeferredPacket *dp)
+{
+    auto range = index.equal_range(dp->pfInfo.getAddr());
+    for (auto entry = range.first; entry != range.second; ++entry) {
+        if (&*entry->second == dp) {
+            return entry->second;
+        }
+    }
+    return packets.end();
+}
+
+Queued::iterator
+Queued::DeferredQueue::insert(iterator pos, const DeferredPacket &dpp)
+{
+    iterator it = packets.insert(pos, dpp);
+    index.emplace(it->pfInfo.getAddr(), it);
+    return it;
+}
+
+Queued::iterator
+Queued::DeferredQueue::erase(iterator it)
+{
+    auto range = index.equal_range(it->pfInfo.getAddr());
+    for (auto entry = range.first; entry != range.second; ++entry) {
+        if (entry->second == it) {
+            index.erase(entry);
+            break;
+        }
+    }
+    return packets.erase(it);
+}
+
 Queued::Queued(const QueuedPrefetcherParams &p)
     : Base(p), queueSize(p.queue_size),
       missingTranslationQueueSize(
@@ -149,15 +195,11 @@ Queued::notify(const PacketPtr &pkt, const PrefetchInfo &pfi)
 
     // Squash queued prefetches if demand miss to same line
     if (queueSquash) {
-        auto itr = pfq.begin();
+        iterator itr = pfq.find(blk_addr, is_secure);
         while (itr != pfq.end()) {
-            if (itr->pfInfo.getAddr() == blk_addr &&
-                itr->pfInfo.isSecure() == is_secure) {
-                delete itr->pkt;
-                itr = pfq.erase(itr);
-            } else {
-                ++itr;
-            }
+            delete itr->pkt;
+            pfq.erase(itr);
+            itr = pfq.find(blk_addr, is_secure);
         }
     }
 
@@ -214,7 +256,7 @@ Queued::getPacket()
     }
 
     PacketPtr pkt = pfq.front().pkt;
-    pfq.pop_front();
+    pfq.erase(pfq.begin());
 
     prefetchStats.pfIssued++;
     issuedPrefetches += 1;
@@ -258,13 +300,7 @@ Queued::processMissingTranslations(unsigned max)
 void
 Queued::translationComplete(DeferredPacket *dp, bool failed)
 {
-    auto it = pfqMissingTranslation.begin();
-    while (it != pfqMissingTranslation.end()) {
-        if (&(*it) == dp) {
-            break;
-        }
-        it++;
-    }
+    iterator it = pfqMissingTranslation.find(dp);
     assert(it != pfqMissingTranslation.end());
     if (!failed) {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x succeeded: "
@@ -293,45 +329,38 @@ Queued::translationComplete(DeferredPacket *dp, bool failed)
 }
 
 bool
-Queued::alreadyInQueue(std::list<DeferredPacket> &queue,
+Queued::alreadyInQueue(DeferredQueue &queue,
                                  const PrefetchInfo &pfi, int32_t priority)
 {
-    bool found = false;
-    iterator it;
-    for (it = queue.begin(); it != queue.end() && !found; it++) {
-        found = it->pfInfo.sameAddr(pfi);
+    iterator it = queue.find(pfi.getAddr(), pfi.isSecure());
+    if (it == queue.end()) {
+        return false;
     }
 
     /* If the address is already in the queue, update priority and leave */
-    if (it != queue.end()) {
-        statsQueued.pfBufferHit++;
-        if (it->priority < priority) {
-            /* Update priority value and position in the queue */
-            it->priority = priority;
-            iterator prev = it;
-            while (prev != queue.begin()) {
-                prev--;
-                /* If the packet has higher priority, swap */
-                if (*it > *prev) {
-                    std::swap(*it, *prev);
-                    it = prev;
-                }
-            }
-            DPRINTF(HWPrefetch, "Prefetch addr already in "
-                "prefetch queue, priority updated\n");
-        } else {
-            DPRINTF(HWPrefetch, "Prefetch addr already in "
-                "prefetch queue\n");
+    statsQueued.pfBufferHit++;
+    if (it->priority < priority) {
+        /* Update priority value and position in the queue */
+        it->priority = priority;
+        iterator pos = it;
+        while (pos != queue.begin() && *it > *std::prev(pos)) {
+            --pos;
         }
+        queue.move(pos, it);
+        DPRINTF(HWPrefetch, "Prefetch addr already in "
+            "prefetch queue, priority updated\n");
+    } else {
+        DPRINTF(HWPrefetch, "Prefetch addr already in "
+            "prefetch queue\n");
     }
-    return found;
+    return true;
 }
 
 RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = Request::create(
             addr, blkSize, pkt->req->getFlags(), requestorId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
@@ -438,7 +467,7 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
 }
 
 void
-Queued::addToQueue(std::list<DeferredPacket> &queue,
+Queued::addToQueue(DeferredQueue &queue,
                              DeferredPacket &dpp)
 {
     /* Verify prefetch buffer space for request */
@@ -470,7 +499,7 @@ Queued::addToQueue(std::list<DeferredPacket> &queue,
     }
 
     if (queue.size() == 0) {
-        queue.emplace_back(dpp);
+        queue.insert(queue.end(), dpp);
     } else {
         iterator it = queue.end();
         do {
@@ -40,6 +40,7 @@
 
 #include <cstdint>
 #include <list>
+#include <unordered_map>
 #include <utility>
 
 #include "base/statistics.hh"
@@ -133,12 +134,66 @@ class Queued : public Base
         void startTranslation(BaseTLB *tlb);
     };
 
-    std::list<DeferredPacket> pfq;
-    std::list<DeferredPacket> pfqMissingTranslation;
-
     using const_iterator = std::list<DeferredPacket>::const_iterator;
     using iterator = std::list<DeferredPacket>::iterator;
 
+    /**
+     * A queue of deferred packets, kept in decreasing order of priority,
+     * and indexed by prefetch address so that finding a prefetch does not
+     * need to walk the queue. Queued packets must not be copied over each
+     * other, as the index and pending translations refer to them.
+     */
+    class DeferredQueue
+    {
+      private:
+        std::list<DeferredPacket> packets;
+        std::unordered_multimap<Addr, iterator> index;
+
+      public:
+        bool empty() const { return packets.empty(); }
+        size_t size() const { return packets.size(); }
+
+        DeferredPacket &front() { return packets.front(); }
+        const DeferredPacket &front() const { return packets.front(); }
+
+        iterator begin() { return packets.begin(); }
+        iterator end() { return packets.end(); }
+        const_iterator begin() const { return packets.begin(); }
+        const_iterator end() const { return packets.end(); }
+
+        /**
+         * Finds a queued prefetch of the given block.
+         * @param addr Address of the prefetch
+         * @param is_secure Whether the prefetch is to the secure space
+         * @return The prefetch found, or end() if there is none
+         */
+        iterator find(Addr addr, bool is_secure);
+
+        /**
+         * Finds a queued packet from its address in memory, e.g. when its
+         * translation completes.
+         * @param dp The queued packet
+         * @return The packet, or end() if it is not in this queue
+         */
+        iterator find(const DeferredPacket *dp);
+
+        /** Inserts a copy of dpp before pos. */
+        iterator insert(iterator pos, const DeferredPacket &dpp);
+
+        /** Removes a packet from the queue, without freeing its pkt. */
+        iterator erase(iterator it);
+
+        /** Moves the packet at it before pos, keeping it valid. */
+        void
+        move(iterator pos, iterator it)
+        {
+            packets.splice(pos, packets, it);
+        }
+    };
+
+    DeferredQueue pfq;
+    DeferredQueue pfqMissingTranslation;
+
     // PARAMETERS
 
     /** Maximum size of the prefetch queue */
@@ -204,7 +259,7 @@ class Queued : public Base
      * @param queue selected queue to use
      * @param dpp DeferredPacket to add
      */
-    void addToQueue(std::list<DeferredPacket> &queue, DeferredPacket &dpp);
+    void addToQueue(DeferredQueue &queue, DeferredPacket &dpp);
 
     /**
      * Starts the translations of the queued prefetches with a
@@ -232,7 +287,7 @@ class Queued : public Base
      * @param priority priority of the prefetch request to be added
      * @return True if the prefetch request was found in the queue
      */
-    bool alreadyInQueue(std::list<DeferredPacket> &queue,
+    bool alreadyInQueue(DeferredQueue &queue,
                         const PrefetchInfo &pfi, int32_t priority);
 
     /**
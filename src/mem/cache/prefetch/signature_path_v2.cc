@@ -54,10 +54,11 @@ SignaturePathV2::handleSignatureTableMiss(stride_t current_block,
 
     // This should return all entries of the GHR, since it is a fully
     // associative table
-    std::vector<GlobalHistoryEntry *> all_ghr_entries =
+    const auto &all_ghr_entries =
              globalHistoryRegister.getPossibleEntries(0 /* any value works */);
 
-    for (auto gh_entry : all_ghr_entries) {
+    for (auto entry : all_ghr_entries) {
+        auto gh_entry = static_cast<GlobalHistoryEntry *>(entry);
         if (gh_entry->lastBlock + gh_entry->delta == current_block) {
             new_signature = gh_entry->signature;
             new_conf = gh_entry->confidence;
@@ -45,10 +45,13 @@
 #ifndef __MEM_CACHE_QUEUE_HH__
 #define __MEM_CACHE_QUEUE_HH__
 
+#include <algorithm>
 #include <cassert>
 #include <string>
 #include <type_traits>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
@@ -97,6 +100,56 @@ class Queue : public Drainable
     /** Holds non allocated entries. */
     typename Entry::List freeList;
 
+    /**
+     * Index of the allocated entries by block address, so that lookups
+     * don't need to walk the whole queue. Each bucket chains its entries
+     * in allocation order, matching the order of allocatedList.
+     */
+    std::vector<QueueEntry *> buckets;
+    /** Shift turning the hash of a block address into a bucket. */
+    const unsigned bucketShift;
+
+    size_t
+    bucket(Addr blk_addr) const
+    {
+        return (blk_addr * 0x9e3779b97f4a7c15ULL) >> bucketShift;
+    }
+
+    /** Index a newly allocated entry, its block address must be set. */
+    void
+    addToIndex(Entry *entry)
+    {
+        QueueEntry **link = &buckets[bucket(entry->blkAddr)];
+        while (*link)
+            link = &(*link)->nextInBucket;
+        entry->nextInBucket = nullptr;
+        *link = entry;
+    }
+
+    void
+    removeFromIndex(Entry *entry)
+    {
+        QueueEntry **link = &buckets[bucket(entry->blkAddr)];
+        while (*link != entry) {
+            assert(*link);
+            link = &(*link)->nextInBucket;
+        }
+        *link = entry->nextInBucket;
+        entry->nextInBucket = nullptr;
+    }
+
+    Entry *
+    firstInBucket(Addr blk_addr) const
+    {
+        return static_cast<Entry *>(buckets[bucket(blk_addr)]);
+    }
+
+    static Entry *
+    nextInBucket(const Entry *entry)
+    {
+        return static_cast<Entry *>(entry->nextInBucket);
+    }
+
     typename Entry::Iterator addToReadyList(Entry* entry)
     {
         if (readyList.empty() ||
@@ -128,7 +181,9 @@ class Queue : public Drainable
      */
     Queue(const std::string &_label, int num_entries, int reserve) :
         label(_label), numEntries(num_entries + reserve),
-        numReserve(reserve), entries(numEntries), _numInService(0),
+        numReserve(reserve), entries(numEntries),
+        buckets(size_t(1) << ceilLog2(std::max(2 * numEntries, 2)), nullptr),
+        bucketShift(64 - ceilLog2(buckets.size())), _numInService(0),
         allocated(0)
     {
         for (int i = 0; i < numEntries; ++i) {
@@ -162,7 +217,8 @@ class Queue : public Drainable
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
-        for (const auto& entry : allocatedList) {
+        for (Entry *entry = firstInBucket(blk_addr); entry;
+                entry = nextInBucket(entry)) {
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
             // cache we never check for matches when adding new
@@ -199,6 +255,27 @@ class Queue : public Drainable
      * @return A pointer to the earliest matching entry.
      */
     Entry* findPending(const QueueEntry* entry) const
+    {
+        // Entries conflict when they have the same block address, so only
+        // the entries of its bucket need to be considered. The ready list
+        // decides which one is the earliest when there are several.
+        Entry *pending = nullptr;
+        for (Entry *candidate = firstInBucket(entry->blkAddr); candidate;
+                candidate = nextInBucket(candidate)) {
+            if (!candidate->inService && candidate->conflictAddr(entry)) {
+                if (pending)
+                    return findPendingInReadyList(entry);
+                pending = candidate;
+            }
+        }
+        return pending;
+    }
+
+    /**
+     * Find the earliest entry of the ready list that overlaps the given
+     * request of a different queue.
+     */
+    Entry* findPendingInReadyList(const QueueEntry* entry) const
     {
         for (const auto& ready_entry : readyList) {
             if (ready_entry->conflictAddr(entry)) {
@@ -234,6 +311,7 @@ class Queue : public Drainable
     void deallocate(Entry *entry)
     {
         allocatedList.erase(entry->allocIter);
+        removeFromIndex(entry);
         freeList.push_front(entry);
         allocated--;
         if (entry->inService) {
@@ -72,6 +72,9 @@ class QueueEntry : public Packet::SenderState
     /** True if the entry is uncacheable */
     bool _isUncacheable;
 
+    /** Next allocated entry in the same block address bucket. */
+    QueueEntry *nextInBucket;
+
   public:
     /**
      * A queue entry is holding packets that will be serviced as soon as
@@ -117,7 +120,7 @@ class QueueEntry : public Packet::SenderState
     bool isSecure;
 
     QueueEntry()
-        : readyTime(0), _isUncacheable(false),
+        : readyTime(0), _isUncacheable(false), nextInBucket(nullptr),
           inService(false), order(0), blkAddr(0), blkSize(0), isSecure(false)
     {}
 
@@ -68,6 +68,12 @@ class MRURP(BaseReplacementPolicy):
     cxx_class = 'ReplacementPolicy::MRU'
     cxx_header = "mem/cache/replacement_policies/mru_rp.hh"
 
+class PackedLRURP(BaseReplacementPolicy):
+    type = 'PackedLRURP'
+    cxx_class = 'ReplacementPolicy::PackedLRU'
+    cxx_header = "mem/cache/replacement_policies/packed_lru_rp.hh"
+    num_ways = Param.Int(Parent.assoc, "Number of ways in each set")
+
 class RandomRP(BaseReplacementPolicy):
     type = 'RandomRP'
     cxx_class = 'ReplacementPolicy::Random'
@@ -46,8 +46,8 @@ FIFO::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 const
 {
     // Reset insertion tick
-    std::static_pointer_cast<FIFOReplData>(
-        replacement_data)->tickInserted = Tick(0);
+    static_cast<FIFOReplData*>(
+        replacement_data.get())->tickInserted = Tick(0);
 }
 
 void
@@ -60,8 +60,8 @@ void
 FIFO::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Set insertion tick
-    std::static_pointer_cast<FIFOReplData>(
-        replacement_data)->tickInserted = curTick();
+    static_cast<FIFOReplData*>(
+        replacement_data.get())->tickInserted = curTick();
 }
 
 ReplaceableEntry*
@@ -74,10 +74,10 @@ FIFO::getVictim(const ReplacementCandidates& candidates) const
     ReplaceableEntry* victim = candidates[0];
     for (const auto& candidate : candidates) {
         // Update victim entry if necessary
-        if (std::static_pointer_cast<FIFOReplData>(
-                    candidate->replacementData)->tickInserted <
-                std::static_pointer_cast<FIFOReplData>(
-                    victim->replacementData)->tickInserted) {
+        if (static_cast<FIFOReplData*>(
+                    candidate->replacementData.get())->tickInserted <
+                static_cast<FIFOReplData*>(
+                    victim->replacementData.get())->tickInserted) {
             victim = candidate;
         }
     }
@@ -88,7 +88,7 @@ FIFO::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 FIFO::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new FIFOReplData());
+    return std::make_shared<FIFOReplData>();
 }
 
 } // namespace ReplacementPolicy
@@ -38,7 +38,7 @@ LRUIPVRP::reset(const std::shared_ptr<::ReplacementPolicy::ReplacementData>& rd)
      * - Fallback mode: set depth to (ways-1) to approximate "insert at LRU".
      * This mirrors common LRU variants where a new line must prove reuse.
      */
-    auto d = std::static_pointer_cast<IPVReplData>(rd);
+    auto d = static_cast<IPVReplData*>(rd.get());
     if (useIpv) {
         d->depth = static_cast<uint8_t>(IPV[IPV_K]); // IPV[16] == 13
     } else {
@@ -57,7 +57,7 @@ LRUIPVRP::touch(const std::shared_ptr<::ReplacementPolicy::ReplacementData>& rd)
      * A defensive clamp ensures i ∈ [0..k-1] in IPV mode, though it should not
      * trigger under normal operation.
      */
-    auto d = std::static_pointer_cast<IPVReplData>(rd);
+    auto d = static_cast<IPVReplData*>(rd.get());
     if (useIpv) {
         unsigned cur = d->depth;
         if (cur >= IPV_K) cur = IPV_K - 1; // defensive clamp
@@ -90,11 +90,11 @@ LRUIPVRP::getVictim(const ReplacementCandidates& candidates) const
     assert(!candidates.empty());
 
     ReplaceableEntry* victim = candidates[0];
-    unsigned worst = std::static_pointer_cast<IPVReplData>(
-        victim->replacementData)->depth;
+    unsigned worst = static_cast<IPVReplData*>(
+        victim->replacementData.get())->depth;
 
     for (auto* e : candidates) {
-        auto d = std::static_pointer_cast<IPVReplData>(e->replacementData);
+        auto d = static_cast<IPVReplData*>(e->replacementData.get());
         if (d->depth > worst) {
             worst = d->depth;
             victim = e;
@@ -46,24 +46,24 @@ LRU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 const
 {
     // Reset last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = Tick(0);
+    static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick = Tick(0);
 }
 
 void
 LRU::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Update last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = curTick();
+    static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick = curTick();
 }
 
 void
 LRU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Set last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = curTick();
+    static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick = curTick();
 }
 
 ReplaceableEntry*
@@ -76,10 +76,10 @@ LRU::getVictim(const ReplacementCandidates& candidates) const
     ReplaceableEntry* victim = candidates[0];
     for (const auto& candidate : candidates) {
         // Update victim entry if necessary
-        if (std::static_pointer_cast<LRUReplData>(
-                    candidate->replacementData)->lastTouchTick <
-                std::static_pointer_cast<LRUReplData>(
-                    victim->replacementData)->lastTouchTick) {
+        if (static_cast<LRUReplData*>(
+                    candidate->replacementData.get())->lastTouchTick <
+                static_cast<LRUReplData*>(
+                    victim->replacementData.get())->lastTouchTick) {
             victim = candidate;
         }
     }
@@ -90,7 +90,7 @@ LRU::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 LRU::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new LRUReplData());
+    return std::make_shared<LRUReplData>();
 }
 
 } // namespace ReplacementPolicy
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/packed_lru_rp.hh"
+
+#include <cassert>
+#include <memory>
+
+#include "base/logging.hh"
+#include "params/PackedLRURP.hh"
+
+namespace ReplacementPolicy {
+
+const unsigned PackedLRU::RankBits;
+const unsigned PackedLRU::MaxWays;
+
+PackedLRU::PackedLRU(const Params &p)
+  : Base(p), numWays(p.num_ways), lruRank(p.num_ways - 1), count(0)
+{
+    fatal_if(numWays < 1 || numWays > MaxWays,
+             "The packed LRU policy supports 1 to %d ways, not %d",
+             MaxWays, numWays);
+}
+
+void
+PackedLRU::move(const PackedLRUReplData *data, bool mru) const
+{
+    Ranks ranks = *data->ranks;
+    const Ranks rank = getRank(ranks, data->way);
+
+    // Ways more recent than this one age when it becomes the MRU, older
+    // ways get younger when it becomes the LRU
+    for (unsigned way = 0; way < numWays; ++way) {
+        const Ranks other = getRank(ranks, way);
+        if (mru && other < rank) {
+            ranks = setRank(ranks, way, other + 1);
+        } else if (!mru && other > rank) {
+            ranks = setRank(ranks, way, other - 1);
+        }
+    }
+
+    *data->ranks = setRank(ranks, data->way, mru ? 0 : lruRank);
+}
+
+void
+PackedLRU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+const
+{
+    move(static_cast<PackedLRUReplData*>(replacement_data.get()), false);
+}
+
+void
+PackedLRU::touch(const std::shared_ptr<ReplacementData>& replacement_data)
+const
+{
+    move(static_cast<PackedLRUReplData*>(replacement_data.get()), true);
+}
+
+void
+PackedLRU::reset(const std::shared_ptr<ReplacementData>& replacement_data)
+const
+{
+    move(static_cast<PackedLRUReplData*>(replacement_data.get()), true);
+}
+
+ReplaceableEntry*
+PackedLRU::getVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+
+    // All the candidates share the same word of ranks
+    const Ranks ranks = *static_cast<PackedLRUReplData*>(
+        candidates[0]->replacementData.get())->ranks;
+
+    // Visit all candidates to find the oldest one
+    ReplaceableEntry* victim = candidates[0];
+    Ranks victim_rank = 0;
+    for (const auto& candidate : candidates) {
+        const PackedLRUReplData* data = static_cast<PackedLRUReplData*>(
+            candidate->replacementData.get());
+        assert(data->ranks == static_cast<PackedLRUReplData*>(
+            candidates[0]->replacementData.get())->ranks);
+        const Ranks rank = getRank(ranks, data->way);
+        if (rank >= victim_rank) {
+            victim = candidate;
+            victim_rank = rank;
+        }
+    }
+
+    return victim;
+}
+
+std::shared_ptr<ReplacementData>
+PackedLRU::instantiateEntry()
+{
+    const unsigned way = count % numWays;
+
+    // Start a new set every numWays entries, with the ways ordered
+    if (way == 0) {
+        Ranks ranks = 0;
+        for (unsigned i = 0; i < numWays; ++i)
+            ranks = setRank(ranks, i, i);
+        sets.push_back(ranks);
+    }
+
+    count++;
+
+    return std::make_shared<PackedLRUReplData>(&sets.back(), way);
+}
+
+} // namespace ReplacementPolicy
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a Least Recently Used replacement policy that keeps the
+ * recency order of a whole set packed in a single word.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_LRU_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_LRU_RP_HH__
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+#include "mem/cache/replacement_policies/base.hh"
+
+struct PackedLRURPParams;
+
+namespace ReplacementPolicy {
+
+/**
+ * An LRU replacement policy whose metadata is shared per set. Instead of a
+ * timestamp per entry, the position of every way in the recency stack of
+ * its set is stored as a RankBits wide field of a single 64-bit word, rank
+ * 0 being the most recently used way. Touching an entry and selecting a
+ * victim only read and write that word.
+ *
+ * As with the TreePLRU policy, consecutive entries are assumed to belong to
+ * the same set, which holds for the set associative tag stores.
+ */
+class PackedLRU : public Base
+{
+  protected:
+    /** Width of the recency rank of a way. */
+    static const unsigned RankBits = 4;
+
+    /** Largest associativity that fits in a word of ranks. */
+    static const unsigned MaxWays = 64 / RankBits;
+
+    /** Recency ranks of the ways of a set. */
+    typedef uint64_t Ranks;
+
+    /** Packed-LRU-specific implementation of replacement data. */
+    struct PackedLRUReplData : ReplacementData
+    {
+        /** Ranks of the set, shared by all of its entries. */
+        Ranks *const ranks;
+
+        /** The way of this entry in its set. */
+        const unsigned way;
+
+        PackedLRUReplData(Ranks *ranks, unsigned way)
+          : ranks(ranks), way(way)
+        {}
+    };
+
+    /** Associativity of the sets. */
+    const unsigned numWays;
+
+    /** Rank of the least recently used way. */
+    const Ranks lruRank;
+
+    /**
+     * Recency ranks of every set. A deque is used so that the entries can
+     * keep pointers to their set while it grows.
+     */
+    std::deque<Ranks> sets;
+
+    /** Number of entries instantiated so far. */
+    uint64_t count;
+
+    /** Get the rank of a way. */
+    static Ranks
+    getRank(Ranks ranks, unsigned way)
+    {
+        return (ranks >> (way * RankBits)) & ((Ranks(1) << RankBits) - 1);
+    }
+
+    /** Set the rank of a way. */
+    static Ranks
+    setRank(Ranks ranks, unsigned way, Ranks rank)
+    {
+        const unsigned shift = way * RankBits;
+        const Ranks mask = ((Ranks(1) << RankBits) - 1) << shift;
+        return (ranks & ~mask) | (rank << shift);
+    }
+
+    /**
+     * Move a way to the given end of the recency stack of its set, and
+     * shift the ways that were between its old position and that end.
+     *
+     * @param data Replacement data of the way to move.
+     * @param mru Whether the way becomes the MRU or the LRU way.
+     */
+    void move(const PackedLRUReplData *data, bool mru) const;
+
+  public:
+    typedef PackedLRURPParams Params;
+    PackedLRU(const Params &p);
+    ~PackedLRU() = default;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     * Makes its way the LRU way of the set.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                              const override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Makes its way the MRU way of the set.
+     *
+     * @param replacement_data Replacement data to be touched.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Makes its way the MRU way of the set.
+     *
+     * @param replacement_data Replacement data to be reset.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Find replacement victim using the recency ranks. It is assumed that
+     * all candidates belong to the same set.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    /**
+     * Instantiate a replacement data entry. A new set is created every
+     * numWays entries.
+     *
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace ReplacementPolicy
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_LRU_RP_HH__
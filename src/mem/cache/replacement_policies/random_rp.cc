@@ -46,8 +46,8 @@ Random::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 const
 {
     // Unprioritize replacement data victimization
-    std::static_pointer_cast<RandomReplData>(
-        replacement_data)->valid = false;
+    static_cast<RandomReplData*>(
+        replacement_data.get())->valid = false;
 }
 
 void
@@ -59,8 +59,8 @@ void
 Random::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Unprioritize replacement data victimization
-    std::static_pointer_cast<RandomReplData>(
-        replacement_data)->valid = true;
+    static_cast<RandomReplData*>(
+        replacement_data.get())->valid = true;
 }
 
 ReplaceableEntry*
@@ -76,8 +76,8 @@ Random::getVictim(const ReplacementCandidates& candidates) const
     // Visit all candidates to search for an invalid entry. If one is found,
     // its eviction is prioritized
     for (const auto& candidate : candidates) {
-        if (!std::static_pointer_cast<RandomReplData>(
-                    candidate->replacementData)->valid) {
+        if (!static_cast<RandomReplData*>(
+                    candidate->replacementData.get())->valid) {
             victim = candidate;
             break;
         }
@@ -89,7 +89,7 @@ Random::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 Random::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new RandomReplData());
+    return std::make_shared<RandomReplData>();
 }
 
 } // namespace ReplacementPolicy
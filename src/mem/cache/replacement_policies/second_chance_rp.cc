@@ -57,8 +57,8 @@ SecondChance::invalidate(
     FIFO::invalidate(replacement_data);
 
     // Do not give a second chance to invalid entries
-    std::static_pointer_cast<SecondChanceReplData>(
-        replacement_data)->hasSecondChance = false;
+    static_cast<SecondChanceReplData*>(
+        replacement_data.get())->hasSecondChance = false;
 }
 
 void
@@ -68,8 +68,8 @@ SecondChance::touch(
     FIFO::touch(replacement_data);
 
     // Whenever an entry is touched, it is given a second chance
-    std::static_pointer_cast<SecondChanceReplData>(
-        replacement_data)->hasSecondChance = true;
+    static_cast<SecondChanceReplData*>(
+        replacement_data.get())->hasSecondChance = true;
 }
 
 void
@@ -79,8 +79,8 @@ SecondChance::reset(
     FIFO::reset(replacement_data);
 
     // Entries are inserted with a second chance
-    std::static_pointer_cast<SecondChanceReplData>(
-        replacement_data)->hasSecondChance = false;
+    static_cast<SecondChanceReplData*>(
+        replacement_data.get())->hasSecondChance = false;
 }
 
 ReplaceableEntry*
@@ -92,9 +92,9 @@ SecondChance::getVictim(const ReplacementCandidates& candidates) const
     // Search for invalid entries, as they have the eviction priority
     for (const auto& candidate : candidates) {
         // Cast candidate's replacement data
-        std::shared_ptr<SecondChanceReplData> candidate_replacement_data =
-            std::static_pointer_cast<SecondChanceReplData>(
-                candidate->replacementData);
+        SecondChanceReplData* candidate_replacement_data =
+            static_cast<SecondChanceReplData*>(
+                candidate->replacementData.get());
 
         // Stop iteration if found an invalid entry
         if ((candidate_replacement_data->tickInserted == Tick(0)) &&
@@ -111,13 +111,14 @@ SecondChance::getVictim(const ReplacementCandidates& candidates) const
         victim = FIFO::getVictim(candidates);
 
         // Cast victim's replacement data for code readability
-        std::shared_ptr<SecondChanceReplData> victim_replacement_data =
-            std::static_pointer_cast<SecondChanceReplData>(
-                victim->replacementData);
+        SecondChanceReplData* victim_replacement_data =
+            static_cast<SecondChanceReplData*>(
+                victim->replacementData.get());
 
         // If victim has a second chance, use it and repeat search
         if (victim_replacement_data->hasSecondChance) {
-            useSecondChance(victim_replacement_data);
+            useSecondChance(std::static_pointer_cast<SecondChanceReplData>(
+                victim->replacementData));
         } else {
             // Found victim
             search_victim = false;
@@ -130,7 +131,7 @@ SecondChance::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 SecondChance::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new SecondChanceReplData());
+    return std::make_shared<SecondChanceReplData>();
 }
 
 } // namespace ReplacementPolicy
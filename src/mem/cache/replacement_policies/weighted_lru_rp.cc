@@ -49,7 +49,7 @@ void
 WeightedLRU::touch(const std::shared_ptr<ReplacementData>&
                                                   replacement_data) const
 {
-    std::static_pointer_cast<WeightedLRUReplData>(replacement_data)->
+    static_cast<WeightedLRUReplData*>(replacement_data.get())->
                                                  last_touch_tick = curTick();
 }
 
@@ -57,9 +57,9 @@ void
 WeightedLRU::touch(const std::shared_ptr<ReplacementData>&
                         replacement_data, int occupancy) const
 {
-    std::static_pointer_cast<WeightedLRUReplData>(replacement_data)->
+    static_cast<WeightedLRUReplData*>(replacement_data.get())->
                                                   last_touch_tick = curTick();
-    std::static_pointer_cast<WeightedLRUReplData>(replacement_data)->
+    static_cast<WeightedLRUReplData*>(replacement_data.get())->
                                                   last_occ_ptr = occupancy;
 }
 
@@ -74,13 +74,13 @@ WeightedLRU::getVictim(const ReplacementCandidates& candidates) const
     // If two blocks have the same weight, evict the oldest one.
     for (const auto& candidate : candidates) {
         // candidate's replacement_data
-        std::shared_ptr<WeightedLRUReplData> candidate_replacement_data =
-            std::static_pointer_cast<WeightedLRUReplData>(
-                                             candidate->replacementData);
+        WeightedLRUReplData* candidate_replacement_data =
+            static_cast<WeightedLRUReplData*>(
+                                             candidate->replacementData.get());
         // victim's replacement_data
-        std::shared_ptr<WeightedLRUReplData> victim_replacement_data =
-            std::static_pointer_cast<WeightedLRUReplData>(
-                                             victim->replacementData);
+        WeightedLRUReplData* victim_replacement_data =
+            static_cast<WeightedLRUReplData*>(
+                                             victim->replacementData.get());
 
         if (candidate_replacement_data->last_occ_ptr <
                     victim_replacement_data->last_occ_ptr) {
@@ -100,7 +100,7 @@ WeightedLRU::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 WeightedLRU::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new WeightedLRUReplData);
+    return std::make_shared<WeightedLRUReplData>();
 }
 
 void
@@ -108,8 +108,8 @@ WeightedLRU::reset(const std::shared_ptr<ReplacementData>&
                                                     replacement_data) const
 {
     // Set last touch timestamp
-    std::static_pointer_cast<WeightedLRUReplData>(
-        replacement_data)->last_touch_tick = curTick();
+    static_cast<WeightedLRUReplData*>(
+        replacement_data.get())->last_touch_tick = curTick();
 }
 
 void
@@ -117,8 +117,8 @@ WeightedLRU::invalidate(const std::shared_ptr<ReplacementData>&
                                                     replacement_data) const
 {
     // Reset last touch timestamp
-    std::static_pointer_cast<WeightedLRUReplData>(
-        replacement_data)->last_touch_tick = Tick(0);
+    static_cast<WeightedLRUReplData*>(
+        replacement_data.get())->last_touch_tick = Tick(0);
 }
 
 } // namespace ReplacementPolicy
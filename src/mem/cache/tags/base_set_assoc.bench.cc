@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mem/cache/replacement_policies/lru_rp.hh"
+#include "mem/cache/tags/base_set_assoc.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "params/BaseSetAssoc.hh"
+#include "params/LRURP.hh"
+#include "params/SetAssociative.hh"
+#include "sim/gbench/clocked_object_fake.hh"
+
+namespace
+{
+
+const int BlkSize = 64;
+
+/**
+ * Tags which can be filled without a cache. BaseTags::insertBlock needs
+ * a packet and a System to account for the occupancy per requestor.
+ */
+class BenchTags : public BaseSetAssoc
+{
+  public:
+    using BaseSetAssoc::BaseSetAssoc;
+
+    void
+    fill(Addr addr)
+    {
+        std::vector<CacheBlk *> evict_blks;
+        CacheBlk *blk = findVictim(addr, false, 0, evict_blks);
+        assert(!blk->isValid());
+        blk->insert(extractTag(addr), false, 0, 0);
+        updateTagKey(blk);
+        replacementPolicy->reset(blk->replacementData);
+    }
+};
+
+/**
+ * Tags of the given size and associativity, filled to capacity. They
+ * are shared by the runs of the benchmarks, as SimObjects are never
+ * freed.
+ */
+BenchTags *
+getTags(uint64_t size, int assoc)
+{
+    static std::map<std::pair<uint64_t, int>, BenchTags *> all_tags;
+    BenchTags *&tags = all_tags[std::make_pair(size, assoc)];
+    if (tags)
+        return tags;
+
+    const std::string name = "bench.tags" + std::to_string(size) +
+        "_" + std::to_string(assoc);
+
+    // SimObjects keep a reference to their parameters.
+    auto *ip = new SetAssociativeParams();
+    ip->name = name + ".indexing_policy";
+    ip->eventq_index = 0;
+    ip->size = size;
+    ip->entry_size = BlkSize;
+    ip->assoc = assoc;
+
+    auto *rp = new LRURPParams();
+    rp->name = name + ".replacement_policy";
+    rp->eventq_index = 0;
+
+    auto *p = new BaseSetAssocParams();
+    GBench::clockedParams(*p, name);
+    p->system = nullptr;
+    p->size = size;
+    p->block_size = BlkSize;
+    p->tag_latency = Cycles(1);
+    p->warmup_percentage = 0;
+    p->sequential_access = false;
+    p->indexing_policy = ip->create();
+    p->entry_size = BlkSize;
+    p->assoc = assoc;
+    p->replacement_policy = rp->create();
+
+    tags = new BenchTags(*p);
+    tags->tagsInit();
+    for (Addr addr = 0; addr < size; addr += BlkSize)
+        tags->fill(addr);
+    return tags;
+}
+
+/** Random block addresses, either all resident or all absent. */
+std::vector<Addr>
+blockAddrs(uint64_t size, bool hit)
+{
+    std::mt19937_64 rng(0);
+    std::uniform_int_distribution<Addr> dist(0, size / BlkSize - 1);
+    std::vector<Addr> addrs(4096);
+    for (auto &addr: addrs)
+        addr = dist(rng) * BlkSize + (hit ? 0 : size);
+    return addrs;
+}
+
+void
+AccessBlock(benchmark::State &state, bool hit)
+{
+    const uint64_t size = state.range(0) << 10;
+    BenchTags *tags = getTags(size, state.range(1));
+    const auto addrs = blockAddrs(size, hit);
+
+    size_t i = 0;
+    Cycles lat;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(tags->accessBlock(addrs[i], false, lat));
+        i = (i + 1) % addrs.size();
+    }
+}
+
+} // anonymous namespace
+
+// Sizes in KiB and associativities of L1, L2 and LLC like caches.
+BENCHMARK_CAPTURE(AccessBlock, hit, true)
+    ->Args({32, 8})->Args({1024, 16})->Args({8192, 16});
+BENCHMARK_CAPTURE(AccessBlock, miss, false)
+    ->Args({32, 8})->Args({1024, 16})->Args({8192, 16});
@@ -49,8 +49,11 @@
 
 #include "base/intmath.hh"
 
+const Addr BaseSetAssoc::InvalidTagKey;
+
 BaseSetAssoc::BaseSetAssoc(const Params &p)
-    :BaseTags(p), allocAssoc(p.assoc), blks(p.size / p.block_size),
+    :BaseTags(p), allocAssoc(p.assoc), assoc(p.assoc),
+     blks(p.size / p.block_size), setAssocIndexing(nullptr),
      sequentialAccess(p.sequential_access),
      replacementPolicy(p.replacement_policy)
 {
@@ -80,12 +83,41 @@ BaseSetAssoc::tagsInit()
         // Associate a replacement data entry to the block
         blk->replacementData = replacementPolicy->instantiateEntry();
     }
+
+    // Skewed and other indexing policies spread the entries of an address
+    // over several sets, those are searched by BaseTags::findBlock.
+    setAssocIndexing = dynamic_cast<const SetAssociative *>(indexingPolicy);
+    if (setAssocIndexing)
+        tagKeys.assign(numBlocks, InvalidTagKey);
+}
+
+CacheBlk *
+BaseSetAssoc::findBlock(Addr addr, bool is_secure) const
+{
+    if (!setAssocIndexing)
+        return BaseTags::findBlock(addr, is_secure);
+
+    const Addr key = tagKey(extractTag(addr), is_secure);
+    const size_t first = setAssocIndexing->extractSet(addr) * assoc;
+    const Addr *keys = &tagKeys[first];
+
+    // Valid tags are unique within a set, so rather than stopping at the
+    // first match, which keeps compilers from vectorizing the loop, every
+    // way is compared and the matching one remembered.
+    unsigned match = assoc;
+    for (unsigned way = 0; way < assoc; ++way)
+        match = keys[way] == key ? way : match;
+
+    if (match == assoc)
+        return nullptr;
+    return const_cast<CacheBlk *>(&blks[first + match]);
 }
 
 void
 BaseSetAssoc::invalidate(CacheBlk *blk)
 {
     BaseTags::invalidate(blk);
+    updateTagKey(blk);
 
     // Decrease the number of tags in use
     stats.tagsInUse--;
@@ -98,6 +130,8 @@ void
 BaseSetAssoc::moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk)
 {
     BaseTags::moveBlock(src_blk, dest_blk);
+    updateTagKey(src_blk);
+    updateTagKey(dest_blk);
 
     // Since the blocks were using different replacement data pointers,
     // we must touch the replacement data of the new entry, and invalidate
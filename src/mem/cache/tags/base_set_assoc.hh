@@ -59,6 +59,7 @@
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
 #include "mem/packet.hh"
 #include "params/BaseSetAssoc.hh"
 
@@ -75,9 +76,48 @@ class BaseSetAssoc : public BaseTags
     /** The allocatable associativity of the cache (alloc mask). */
     unsigned allocAssoc;
 
+    /** The associativity of the cache. */
+    const unsigned assoc;
+
     /** The cache blocks. */
     std::vector<CacheBlk> blks;
 
+    /**
+     * The indexing policy if it maps every way of an address to the same
+     * set, nullptr otherwise. Lookups then only need to scan one row of
+     * tagKeys.
+     */
+    const SetAssociative *setAssocIndexing;
+
+    /**
+     * The tags of the blocks, laid out like blks so that the ways of a
+     * set are stored contiguously. A key packs a block's tag and secure
+     * bit; invalid blocks hold InvalidTagKey, which never matches a
+     * lookup. This lets a lookup compare all the ways of a set against a
+     * single value without touching the blocks themselves.
+     */
+    std::vector<Addr> tagKeys;
+
+    /** Key of the blocks that are not valid. */
+    static const Addr InvalidTagKey = MaxAddr;
+
+    /** Key of a valid block with the given tag and security. */
+    static Addr
+    tagKey(Addr tag, bool is_secure)
+    {
+        return (tag << 1) | (is_secure ? 1 : 0);
+    }
+
+    /** Mirror the current state of a block in its tag key. */
+    void
+    updateTagKey(const CacheBlk *blk)
+    {
+        if (setAssocIndexing) {
+            tagKeys[blk->getSet() * assoc + blk->getWay()] = blk->isValid() ?
+                tagKey(blk->getTag(), blk->isSecure()) : InvalidTagKey;
+        }
+    }
+
     /** Whether tags and data are accessed sequentially. */
     const bool sequentialAccess;
 
@@ -111,6 +151,16 @@ class BaseSetAssoc : public BaseTags
      */
     void invalidate(CacheBlk *blk) override;
 
+    /**
+     * Finds the given address in the cache. With a set associative
+     * indexing policy, only the tag keys of the address' set are read.
+     *
+     * @param addr The address to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the cache block if found.
+     */
+    CacheBlk *findBlock(Addr addr, bool is_secure) const override;
+
     /**
      * Access block and update replacement data. May not succeed, in which case
      * nullptr is returned. This has all the implications of a cache access and
@@ -168,7 +218,7 @@ class BaseSetAssoc : public BaseTags
                          std::vector<CacheBlk*>& evict_blks) override
     {
         // Get possible entries to be victimized
-        const std::vector<ReplaceableEntry*> entries =
+        const std::vector<ReplaceableEntry*> &entries =
             indexingPolicy->getPossibleEntries(addr);
 
         // Choose replacement victim from replacement candidates
@@ -192,6 +242,8 @@ class BaseSetAssoc : public BaseTags
         // Insert block
         BaseTags::insertBlock(pkt, blk);
 
+        updateTagKey(blk);
+
         // Increment tag counter
         stats.tagsInUse++;
 
@@ -72,6 +72,9 @@ FALRU::FALRU(const Params &p)
         fatal("Cache Size must be power of 2 for now");
 
     blks = new FALRUBlk[numBlocks];
+
+    tagHashBits = ceilLog2(numBlocks) + 1;
+    tagHash.resize(1ULL << tagHashBits);
 }
 
 FALRU::~FALRU()
@@ -106,15 +109,40 @@ FALRU::tagsInit()
     cacheTracking.init(head, tail);
 }
 
+size_t
+FALRU::tagHashFind(Addr key) const
+{
+    const size_t mask = tagHash.size() - 1;
+    size_t i = tagHashHome(key);
+    while (tagHash[i].blk && tagHash[i].key != key)
+        i = (i + 1) & mask;
+    return i;
+}
+
+void
+FALRU::tagHashErase(Addr key)
+{
+    const size_t mask = tagHash.size() - 1;
+    size_t hole = tagHashFind(key);
+    assert(tagHash[hole].blk);
+
+    // Shift the rest of the probe sequence back over the hole, leaving
+    // behind the entries whose home slot lies between the hole and them
+    for (size_t i = (hole + 1) & mask; tagHash[i].blk; i = (i + 1) & mask) {
+        if (((i - tagHashHome(tagHash[i].key)) & mask) >=
+            ((i - hole) & mask)) {
+            tagHash[hole] = tagHash[i];
+            hole = i;
+        }
+    }
+    tagHash[hole] = TagHashSlot();
+}
+
 void
 FALRU::invalidate(CacheBlk *blk)
 {
     // Erase block entry reference in the hash table
-    M5_VAR_USED auto num_erased =
-        tagHash.erase(std::make_pair(blk->getTag(), blk->isSecure()));
-
-    // Sanity check; only one block reference should be erased
-    assert(num_erased == 1);
+    tagHashErase(tagHashKey(blk->getTag(), blk->isSecure()));
 
     // Invalidate block entry. Must be done after the hash is erased
     BaseTags::invalidate(blk);
@@ -164,10 +192,7 @@ FALRU::findBlock(Addr addr, bool is_secure) const
     FALRUBlk* blk = nullptr;
 
     Addr tag = extractTag(addr);
-    auto iter = tagHash.find(std::make_pair(tag, is_secure));
-    if (iter != tagHash.end()) {
-        blk = (*iter).second;
-    }
+    blk = tagHash[tagHashFind(tagHashKey(tag, is_secure))].blk;
 
     if (blk && blk->isValid()) {
         assert(blk->getTag() == tag);
@@ -215,7 +240,10 @@ FALRU::insertBlock(const PacketPtr pkt, CacheBlk *blk)
     moveToHead(falruBlk);
 
     // Insert new block in the hash table
-    tagHash[std::make_pair(blk->getTag(), blk->isSecure())] = falruBlk;
+    const Addr key = tagHashKey(blk->getTag(), blk->isSecure());
+    TagHashSlot &slot = tagHash[tagHashFind(key)];
+    slot.key = key;
+    slot.blk = falruBlk;
 }
 
 void
@@ -49,7 +49,6 @@
 #include <cstdint>
 #include <functional>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/bitfield.hh"
@@ -118,20 +117,43 @@ class FALRU : public BaseTags
     /** The LRU block. */
     FALRUBlk *tail;
 
-    /** Hash table type mapping addresses to cache block pointers. */
-    struct PairHash
+    /**
+     * Slot of the address hash table. The key is the block address with
+     * the security state in its (otherwise zero) least significant bit.
+     */
+    struct TagHashSlot
     {
-        template <class T1, class T2>
-        std::size_t operator()(const std::pair<T1, T2> &p) const
-        {
-            return std::hash<T1>()(p.first) ^ std::hash<T2>()(p.second);
-        }
+        Addr key = 0;
+        FALRUBlk *blk = nullptr;
     };
-    typedef std::pair<Addr, bool> TagHashKey;
-    typedef std::unordered_map<TagHashKey, FALRUBlk *, PairHash> TagHash;
 
-    /** The address hash table. */
-    TagHash tagHash;
+    /**
+     * The address hash table, open addressed with linear probing. It
+     * has room for at least twice the number of blocks, so probe
+     * sequences stay short and it never allocates after construction.
+     */
+    std::vector<TagHashSlot> tagHash;
+    /** Number of bits of a tagHash index. */
+    unsigned tagHashBits;
+
+    static Addr
+    tagHashKey(Addr tag, bool is_secure)
+    {
+        return tag | is_secure;
+    }
+
+    /** Home slot of a key. */
+    size_t
+    tagHashHome(Addr key) const
+    {
+        return (key * 0x9E3779B97F4A7C15ULL) >> (64 - tagHashBits);
+    }
+
+    /** Slot holding the key, or the empty slot ending its probe sequence. */
+    size_t tagHashFind(Addr key) const;
+
+    /** Remove a key, which has to be present, from the hash table. */
+    void tagHashErase(Addr key);
 
     /**
      * Move a cache block to the MRU position.
@@ -140,11 +140,14 @@ class BaseIndexingPolicy : public SimObject
      * Should be called immediately before ReplacementPolicy's findVictim()
      * not to break cache resizing.
      *
+     * Lookups are frequent, so the entries are not copied: the returned
+     * reference is only valid until the next call to this function.
+     *
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    virtual std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr)
-                                                                    const = 0;
+    virtual const std::vector<ReplaceableEntry*> &
+    getPossibleEntries(const Addr addr) const = 0;
 
     /**
      * Regenerate an entry's address from its tag and assigned indexing bits.
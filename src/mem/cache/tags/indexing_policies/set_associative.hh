@@ -78,7 +78,7 @@ class ReplaceableEntry;
  */
 class SetAssociative : public BaseIndexingPolicy
 {
-  protected:
+  public:
     /**
      * Apply a hash function to calculate address set.
      *
@@ -87,7 +87,6 @@ class SetAssociative : public BaseIndexingPolicy
      */
     virtual uint32_t extractSet(const Addr addr) const;
 
-  public:
     /**
      * Convenience typedef.
      */
@@ -112,8 +111,8 @@ class SetAssociative : public BaseIndexingPolicy
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
-                                                                     override;
+    const std::vector<ReplaceableEntry*> &
+    getPossibleEntries(const Addr addr) const override;
 
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
@@ -124,6 +123,15 @@ class SetAssociative : public BaseIndexingPolicy
      */
     Addr regenerateAddr(const Addr tag, const ReplaceableEntry* entry) const
                                                                    override;
+
+    /**
+     * Get where the set and tag bits are in an address, so containers that
+     * lay their entries out in this policy's set and way order can find them
+     * without going through the policy.
+     */
+    int getSetShift() const { return setShift; }
+    unsigned getSetMask() const { return setMask; }
+    int getTagShift() const { return tagShift; }
 };
 
 #endif //__MEM_CACHE_INDEXING_POLICIES_SET_ASSOCIATIVE_HH__
@@ -39,7 +39,8 @@
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 
 SkewedAssociative::SkewedAssociative(const Params &p)
-    : BaseIndexingPolicy(p), msbShift(floorLog2(numSets) - 1)
+    : BaseIndexingPolicy(p), msbShift(floorLog2(numSets) - 1),
+      possibleEntries(assoc, nullptr)
 {
     if (assoc > NUM_SKEWING_FUNCTIONS) {
         warn_once("Associativity higher than number of skewing functions. " \
@@ -203,16 +204,14 @@ SkewedAssociative::regenerateAddr(const Addr tag,
            ((deskew(addr_set, entry->getWay()) & setMask) << setShift);
 }
 
-std::vector<ReplaceableEntry*>
+const std::vector<ReplaceableEntry*> &
 SkewedAssociative::getPossibleEntries(const Addr addr) const
 {
-    std::vector<ReplaceableEntry*> entries;
-
     // Parse all ways
     for (uint32_t way = 0; way < assoc; ++way) {
         // Apply hash to get set, and get way entry in it
-        entries.push_back(sets[extractSet(addr, way)][way]);
+        possibleEntries[way] = sets[extractSet(addr, way)][way];
     }
 
-    return entries;
+    return possibleEntries;
 }
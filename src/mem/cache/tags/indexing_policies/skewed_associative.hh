@@ -82,6 +82,12 @@ class SkewedAssociative : public BaseIndexingPolicy
      */
     const int msbShift;
 
+    /**
+     * The entries of the last address looked up, spread over one set per
+     * way, so that lookups don't need to allocate.
+     */
+    mutable std::vector<ReplaceableEntry*> possibleEntries;
+
     /**
      * The hash function itself. Uses the hash function H, as described in
      * "Skewed-Associative Caches", from Seznec et al. (section 3.3): It
@@ -157,8 +163,8 @@ class SkewedAssociative : public BaseIndexingPolicy
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
-                                                                   override;
+    const std::vector<ReplaceableEntry*> &
+    getPossibleEntries(const Addr addr) const override;
 
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
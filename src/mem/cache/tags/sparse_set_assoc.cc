@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of a set associative tag store that allocates its sets on
+ * demand.
+ */
+
+#include "mem/cache/tags/sparse_set_assoc.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "params/SparseSetAssoc.hh"
+
+const uint32_t SparseSetAssoc::NoSet;
+
+SparseSetAssoc::SparseSetAssoc(const Params &p)
+    : BaseTags(p), assoc(p.assoc), allocAssoc(p.assoc),
+      sequentialAccess(p.sequential_access),
+      replacementPolicy(p.replacement_policy), setAssocIndexing(nullptr),
+      setNumbers(64, NoSet), sets(64), numAllocatedSets(0)
+{
+    // There must be a indexing policy
+    fatal_if(!p.indexing_policy, "An indexing policy is required");
+
+    // Check parameters
+    if (blkSize < 4 || !isPowerOf2(blkSize)) {
+        fatal("Block size must be at least 4 and a power of 2");
+    }
+
+    // The data of the blocks is allocated along with their set
+    dataBlks.reset();
+}
+
+void
+SparseSetAssoc::tagsInit()
+{
+    setAssocIndexing = dynamic_cast<const SetAssociative *>(indexingPolicy);
+    fatal_if(!setAssocIndexing, "%s requires a set associative indexing "
+             "policy", name());
+}
+
+size_t
+SparseSetAssoc::findBucket(uint32_t set) const
+{
+    // Fibonacci hashing spreads consecutive sets over the table, linear
+    // probing then finds the set or a free bucket
+    const size_t mask = setNumbers.size() - 1;
+    size_t bucket = (set * 0x9e3779b97f4a7c15ULL) >>
+        (64 - floorLog2(setNumbers.size()));
+    while (setNumbers[bucket] != set && setNumbers[bucket] != NoSet)
+        bucket = (bucket + 1) & mask;
+    return bucket;
+}
+
+SparseSetAssoc::Set *
+SparseSetAssoc::getSet(uint32_t set) const
+{
+    return sets[findBucket(set)].get();
+}
+
+void
+SparseSetAssoc::grow()
+{
+    std::vector<uint32_t> old_numbers(setNumbers.size() * 2, NoSet);
+    std::vector<std::unique_ptr<Set>> old_sets(sets.size() * 2);
+    old_numbers.swap(setNumbers);
+    old_sets.swap(sets);
+
+    for (size_t i = 0; i < old_numbers.size(); ++i) {
+        if (old_numbers[i] != NoSet) {
+            const size_t bucket = findBucket(old_numbers[i]);
+            setNumbers[bucket] = old_numbers[i];
+            sets[bucket] = std::move(old_sets[i]);
+        }
+    }
+}
+
+SparseSetAssoc::Set &
+SparseSetAssoc::allocateSet(uint32_t set)
+{
+    size_t bucket = findBucket(set);
+    if (sets[bucket])
+        return *sets[bucket];
+
+    // Keep the table at most half full
+    if (2 * (numAllocatedSets + 1) > setNumbers.size()) {
+        grow();
+        bucket = findBucket(set);
+    }
+
+    setNumbers[bucket] = set;
+    sets[bucket].reset(new Set(assoc, blkSize));
+    numAllocatedSets++;
+
+    // Initialize the blocks the way BaseSetAssoc does; the replacement
+    // data of a set is instantiated in one go, as some replacement
+    // policies share it among consecutive entries
+    Set &new_set = *sets[bucket];
+    for (unsigned way = 0; way < assoc; ++way) {
+        CacheBlk* blk = &new_set.blks[way];
+        indexingPolicy->setEntry(blk, set * assoc + way);
+        blk->data = &new_set.data[blkSize * way];
+        blk->replacementData = replacementPolicy->instantiateEntry();
+    }
+
+    return new_set;
+}
+
+void
+SparseSetAssoc::invalidate(CacheBlk *blk)
+{
+    BaseTags::invalidate(blk);
+
+    // Decrease the number of tags in use
+    stats.tagsInUse--;
+
+    // Invalidate replacement data
+    replacementPolicy->invalidate(blk->replacementData);
+}
+
+CacheBlk*
+SparseSetAssoc::findBlock(Addr addr, bool is_secure) const
+{
+    Set *set = getSet(setAssocIndexing->extractSet(addr));
+    if (!set)
+        return nullptr;
+
+    const Addr tag = extractTag(addr);
+    for (auto &blk : set->blks) {
+        if (blk.matchTag(tag, is_secure))
+            return &blk;
+    }
+
+    return nullptr;
+}
+
+CacheBlk*
+SparseSetAssoc::accessBlock(Addr addr, bool is_secure, Cycles &lat)
+{
+    CacheBlk *blk = findBlock(addr, is_secure);
+
+    // Access all tags in parallel, hence one in each way.  The data side
+    // either accesses all blocks in parallel, or one block sequentially on
+    // a hit.  Sequential access with a miss doesn't access data.
+    stats.tagAccesses += allocAssoc;
+    if (sequentialAccess) {
+        if (blk != nullptr) {
+            stats.dataAccesses += 1;
+        }
+    } else {
+        stats.dataAccesses += allocAssoc;
+    }
+
+    // If a cache hit
+    if (blk != nullptr) {
+        // Update number of references to accessed block
+        blk->increaseRefCount();
+
+        // Update replacement data of accessed block
+        replacementPolicy->touch(blk->replacementData);
+    }
+
+    // The tag lookup latency is the same for a hit or a miss
+    lat = lookupLatency;
+
+    return blk;
+}
+
+CacheBlk*
+SparseSetAssoc::findVictim(Addr addr, const bool is_secure,
+                           const std::size_t size,
+                           std::vector<CacheBlk*>& evict_blks)
+{
+    // Make sure the entries of the set exist
+    allocateSet(setAssocIndexing->extractSet(addr));
+
+    // Get possible entries to be victimized
+    const std::vector<ReplaceableEntry*> &entries =
+        indexingPolicy->getPossibleEntries(addr);
+
+    // Choose replacement victim from replacement candidates
+    CacheBlk* victim = static_cast<CacheBlk*>(replacementPolicy->getVictim(
+                            entries));
+
+    // There is only one eviction for this replacement
+    evict_blks.push_back(victim);
+
+    return victim;
+}
+
+void
+SparseSetAssoc::insertBlock(const PacketPtr pkt, CacheBlk *blk)
+{
+    // Insert block
+    BaseTags::insertBlock(pkt, blk);
+
+    // Increment tag counter
+    stats.tagsInUse++;
+
+    // Update replacement policy
+    replacementPolicy->reset(blk->replacementData);
+}
+
+void
+SparseSetAssoc::moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk)
+{
+    BaseTags::moveBlock(src_blk, dest_blk);
+
+    // Since the blocks were using different replacement data pointers,
+    // we must touch the replacement data of the new entry, and invalidate
+    // the one that is being moved.
+    replacementPolicy->invalidate(src_blk->replacementData);
+    replacementPolicy->reset(dest_blk->replacementData);
+}
+
+void
+SparseSetAssoc::setWayAllocationMax(int ways)
+{
+    fatal_if(ways < 1, "Allocation limit must be greater than zero");
+    allocAssoc = ways;
+}
+
+Addr
+SparseSetAssoc::regenerateBlkAddr(const CacheBlk* blk) const
+{
+    return indexingPolicy->regenerateAddr(blk->getTag(), blk);
+}
+
+void
+SparseSetAssoc::forEachBlk(std::function<void(CacheBlk &)> visitor)
+{
+    std::vector<uint32_t> allocated;
+    allocated.reserve(numAllocatedSets);
+    for (auto set : setNumbers) {
+        if (set != NoSet)
+            allocated.push_back(set);
+    }
+    std::sort(allocated.begin(), allocated.end());
+
+    for (auto set : allocated) {
+        for (auto &blk : getSet(set)->blks)
+            visitor(blk);
+    }
+}
+
+bool
+SparseSetAssoc::anyBlk(std::function<bool(CacheBlk &)> visitor)
+{
+    for (auto &set : sets) {
+        if (!set)
+            continue;
+        for (auto &blk : set->blks) {
+            if (visitor(blk))
+                return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a set associative tag store that allocates its sets on
+ * demand.
+ */
+
+#ifndef __MEM_CACHE_TAGS_SPARSE_SET_ASSOC_HH__
+#define __MEM_CACHE_TAGS_SPARSE_SET_ASSOC_HH__
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/cache/cache_blk.hh"
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/tags/base.hh"
+#include "mem/packet.hh"
+
+struct SparseSetAssocParams;
+class SetAssociative;
+
+/**
+ * A set associative tag store for very large caches, such as DRAM caches
+ * or big shared LLCs, that are mostly empty during a simulation. Rather
+ * than allocating every block, its data and replacement data when the
+ * simulation starts, a set is only allocated the first time a block is
+ * filled into it. Sets that were never filled hold no valid blocks, so
+ * lookups in them miss without allocating anything.
+ *
+ * Allocated sets are found through an open addressed hash table indexed
+ * by set number. Allocated sets are kept until the end of the simulation;
+ * as the replacement data of a fresh set is the same as the one of a set
+ * of a conventional tag store that was never filled, the tag store
+ * behaves, and updates its stats, exactly like BaseSetAssoc.
+ *
+ * Only the set associative indexing policy is supported.
+ */
+class SparseSetAssoc : public BaseTags
+{
+  protected:
+    /** The blocks of a set and their data. */
+    struct Set
+    {
+        Set(unsigned assoc, unsigned blk_size)
+          : blks(assoc), data(new uint8_t[assoc * blk_size])
+        {}
+
+        std::vector<CacheBlk> blks;
+        std::unique_ptr<uint8_t[]> data;
+    };
+
+    /** The associativity of the cache. */
+    const unsigned assoc;
+
+    /** The allocatable associativity of the cache (alloc mask). */
+    unsigned allocAssoc;
+
+    /** Whether tags and data are accessed sequentially. */
+    const bool sequentialAccess;
+
+    /** Replacement policy */
+    ReplacementPolicy::Base *replacementPolicy;
+
+    /** The indexing policy, which must be set associative. */
+    const SetAssociative *setAssocIndexing;
+
+    /** Bucket of the hash table that doesn't hold a set. */
+    static const uint32_t NoSet = ~0;
+
+    /** Set number held by every bucket of the hash table. */
+    std::vector<uint32_t> setNumbers;
+
+    /** The set held by every bucket of the hash table. */
+    std::vector<std::unique_ptr<Set>> sets;
+
+    /** Number of sets allocated so far. */
+    size_t numAllocatedSets;
+
+    /**
+     * Find the bucket of a set, which is either the one it is held by or
+     * the empty bucket where it would be inserted.
+     *
+     * @param set The set number.
+     * @return Index of the bucket.
+     */
+    size_t findBucket(uint32_t set) const;
+
+    /**
+     * Get an allocated set.
+     *
+     * @param set The set number.
+     * @return The set, or nullptr if it was never allocated.
+     */
+    Set *getSet(uint32_t set) const;
+
+    /**
+     * Get a set, allocating it, its blocks and their replacement data if
+     * this is the first time it is used.
+     *
+     * @param set The set number.
+     * @return The set.
+     */
+    Set &allocateSet(uint32_t set);
+
+    /** Double the number of buckets of the hash table. */
+    void grow();
+
+  public:
+    /** Convenience typedef. */
+    typedef SparseSetAssocParams Params;
+
+    /**
+     * Construct and initialize this tag store.
+     */
+    SparseSetAssoc(const Params &p);
+
+    /**
+     * Check the indexing policy. No block is allocated upfront.
+     */
+    void tagsInit() override;
+
+    /**
+     * This function updates the tags when a block is invalidated. It also
+     * updates the replacement data.
+     *
+     * @param blk The block to invalidate.
+     */
+    void invalidate(CacheBlk *blk) override;
+
+    /**
+     * Finds the given address in the cache, without allocating the set it
+     * belongs to.
+     *
+     * @param addr The address to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the cache block if found.
+     */
+    CacheBlk *findBlock(Addr addr, bool is_secure) const override;
+
+    /**
+     * Access block and update replacement data. May not succeed, in which
+     * case nullptr is returned. Accounts for the same tag and data accesses
+     * as BaseSetAssoc, whether the set of the block is allocated or not.
+     *
+     * @param addr The address to find.
+     * @param is_secure True if the target memory space is secure.
+     * @param lat The latency of the tag lookup.
+     * @return Pointer to the cache block if found.
+     */
+    CacheBlk *accessBlock(Addr addr, bool is_secure, Cycles &lat) override;
+
+    /**
+     * Find replacement victim based on address, allocating the set of the
+     * address if needed. The list of evicted blocks only contains the
+     * victim.
+     *
+     * @param addr Address to find a victim for.
+     * @param is_secure True if the target memory space is secure.
+     * @param size Size, in bits, of new block to allocate.
+     * @param evict_blks Cache blocks to be evicted.
+     * @return Cache block to be replaced.
+     */
+    CacheBlk *findVictim(Addr addr, const bool is_secure,
+                         const std::size_t size,
+                         std::vector<CacheBlk*>& evict_blks) override;
+
+    /**
+     * Insert the new block into the cache and update replacement data.
+     *
+     * @param pkt Packet holding the address to update
+     * @param blk The block to update.
+     */
+    void insertBlock(const PacketPtr pkt, CacheBlk *blk) override;
+
+    void moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk) override;
+
+    /**
+     * Limit the allocation for the cache ways.
+     * @param ways The maximum number of ways available for replacement.
+     */
+    void setWayAllocationMax(int ways) override;
+
+    /**
+     * Get the way allocation mask limit.
+     * @return The maximum number of ways available for replacement.
+     */
+    int getWayAllocationMax() const override { return allocAssoc; }
+
+    /**
+     * Regenerate the block address from the tag and indexing location.
+     *
+     * @param block The block.
+     * @return the block address.
+     */
+    Addr regenerateBlkAddr(const CacheBlk* blk) const override;
+
+    /**
+     * Visit the blocks of the allocated sets, in the same order as
+     * BaseSetAssoc would. The blocks of the other sets are all invalid.
+     */
+    void forEachBlk(std::function<void(CacheBlk &)> visitor) override;
+
+    bool anyBlk(std::function<bool(CacheBlk &)> visitor) override;
+};
+
+#endif //__MEM_CACHE_TAGS_SPARSE_SET_ASSOC_HH__
@@ -335,8 +335,8 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
 
             // remember where to route the normal response to
             if (expect_response || expect_snoop_resp) {
-                assert(routeTo.find(pkt->req) == routeTo.end());
-                routeTo[pkt->req] = cpu_side_port_id;
+                assert(routeTo.find(pkt->req) == InvalidPortID);
+                routeTo.insert(pkt->req, cpu_side_port_id);
 
                 panic_if(routeTo.size() > maxRoutingTableSizeCheck,
                          "%s: Routing table exceeds %d packets\n",
@@ -390,21 +390,19 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
                 assert(rsp_pkt);
 
                 // determine the destination
-                const auto route_lookup = routeTo.find(rsp_pkt->req);
-                assert(route_lookup != routeTo.end());
-                rsp_port_id = route_lookup->second;
+                rsp_port_id = routeTo.find(rsp_pkt->req);
                 assert(rsp_port_id != InvalidPortID);
                 assert(rsp_port_id < respLayers.size());
                 // remove the request from the routing table
-                routeTo.erase(route_lookup);
+                routeTo.erase(rsp_pkt->req);
             }
             outstandingCMO.erase(cmo_lookup);
         } else {
             respond_directly = false;
             outstandingCMO.emplace(pkt->id, deferred_rsp);
             if (!pkt->isWrite()) {
-                assert(routeTo.find(pkt->req) == routeTo.end());
-                routeTo[pkt->req] = cpu_side_port_id;
+                assert(routeTo.find(pkt->req) == InvalidPortID);
+                routeTo.insert(pkt->req, cpu_side_port_id);
 
                 panic_if(routeTo.size() > maxRoutingTableSizeCheck,
                          "%s: Routing table exceeds %d packets\n",
@@ -445,9 +443,7 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     RequestPort *src_port = memSidePorts[mem_side_port_id];
 
     // determine the destination
-    const auto route_lookup = routeTo.find(pkt->req);
-    assert(route_lookup != routeTo.end());
-    const PortID cpu_side_port_id = route_lookup->second;
+    const PortID cpu_side_port_id = routeTo.find(pkt->req);
     assert(cpu_side_port_id != InvalidPortID);
     assert(cpu_side_port_id < respLayers.size());
 
@@ -489,7 +485,7 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
                                         + latency);
 
     // remove the request from the routing table
-    routeTo.erase(route_lookup);
+    routeTo.erase(pkt->req);
 
     respLayers[cpu_side_port_id]->succeededTiming(packetFinishTime);
 
@@ -549,8 +545,8 @@ CoherentXBar::recvTimingSnoopReq(PacketPtr pkt, PortID mem_side_port_id)
 
     // if we can expect a response, remember how to route it
     if (!cache_responding && pkt->cacheResponding()) {
-        assert(routeTo.find(pkt->req) == routeTo.end());
-        routeTo[pkt->req] = mem_side_port_id;
+        assert(routeTo.find(pkt->req) == InvalidPortID);
+        routeTo.insert(pkt->req, mem_side_port_id);
     }
 
     // a snoop request came from a connected CPU-side-port device (one of
@@ -568,9 +564,7 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
     ResponsePort* src_port = cpuSidePorts[cpu_side_port_id];
 
     // get the destination
-    const auto route_lookup = routeTo.find(pkt->req);
-    assert(route_lookup != routeTo.end());
-    const PortID dest_port_id = route_lookup->second;
+    const PortID dest_port_id = routeTo.find(pkt->req);
     assert(dest_port_id != InvalidPortID);
 
     // determine if the response is from a snoop request we
@@ -625,6 +619,10 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
     // determine how long to be crossbar layer is busy
     Tick packetFinishTime = clockEdge(headerLatency) + pkt->payloadDelay;
 
+    // remove the request from the routing table, before the packet is
+    // passed on and possibly deleted
+    routeTo.erase(pkt->req);
+
     // forward it either as a snoop response or a normal response
     if (forwardAsSnoop) {
         // this is a snoop response to a snoop request we forwarded,
@@ -679,9 +677,6 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
         respLayers[dest_port_id]->succeededTiming(packetFinishTime);
     }
 
-    // remove the request from the routing table
-    routeTo.erase(route_lookup);
-
     // stats updates
     transDist[pkt_cmd]++;
     snoops++;
@@ -1028,6 +1023,25 @@ CoherentXBar::recvFunctional(PacketPtr pkt, PortID cpu_side_port_id)
     }
 }
 
+void
+CoherentXBar::recvMemBackdoorReq(const AddrRange &range,
+                                 MemBackdoorPtr &backdoor)
+{
+    // a back door bypasses any snooper that could hold a more recent
+    // copy of the data, so only pass on the request if the snoopers
+    // are out of the picture
+    if (!system->bypassCaches()) {
+        for (const auto *p : snoopPorts) {
+            if (p->mayCacheData())
+                return;
+        }
+    }
+
+    PortID dest_id = findPort(range);
+
+    memSidePorts[dest_id]->sendMemBackdoorReq(range, backdoor);
+}
+
 void
 CoherentXBar::recvFunctionalSnoop(PacketPtr pkt, PortID mem_side_port_id)
 {
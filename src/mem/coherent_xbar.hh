@@ -133,6 +133,13 @@ class CoherentXBar : public BaseXBar
             xbar.recvFunctional(pkt, id);
         }
 
+        void
+        recvMemBackdoorReq(const AddrRange &range,
+                           MemBackdoorPtr &backdoor) override
+        {
+            xbar.recvMemBackdoorReq(range, backdoor);
+        }
+
         AddrRangeList
         getAddrRanges() const override
         {
@@ -371,6 +378,11 @@ class CoherentXBar : public BaseXBar
         transaction.*/
     void recvFunctional(PacketPtr pkt, PortID cpu_side_port_id);
 
+    /** Function called by the port when the crossbar is receiving a
+        request for a functional back door.*/
+    void recvMemBackdoorReq(const AddrRange &range,
+                            MemBackdoorPtr &backdoor);
+
     /** Function called by the port when the crossbar is receiving a functional
         snoop transaction.*/
     void recvFunctionalSnoop(PacketPtr pkt, PortID mem_side_port_id);
@@ -39,6 +39,7 @@
 
 #include "mem/comm_monitor.hh"
 
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/CommMonitor.hh"
 #include "sim/stats.hh"
@@ -50,13 +51,25 @@ CommMonitor::CommMonitor(const Params &params)
       samplePeriodicEvent([this]{ samplePeriodic(); }, name()),
       samplePeriodTicks(params.sample_period),
       samplePeriod(params.sample_period / SimClock::Float::s),
+      sampleRatio(params.sample_ratio),
       stats(this, params)
 {
+    fatal_if(sampleRatio == 0, "%s: sample_ratio must be at least 1\n",
+             name());
+
+    sampleCounts.fill(0);
+
     DPRINTF(CommMonitor,
             "Created monitor %s with sample period %d ticks (%f ms)\n",
             name(), samplePeriodTicks, samplePeriod * 1E3);
 }
 
+CommMonitor::~CommMonitor()
+{
+    for (auto *state : senderStatePool)
+        delete state;
+}
+
 void
 CommMonitor::init()
 {
@@ -84,6 +97,40 @@ CommMonitor::getPort(const std::string &if_name, PortID idx)
     }
 }
 
+bool
+CommMonitor::sampleTransaction(Addr addr)
+{
+    if (sampleRatio == 1)
+        return true;
+
+    // Hash the 64-byte block address into one of the buckets
+    const unsigned bucket = ((addr >> 6) * 0x9E3779B97F4A7C15ULL) >>
+        (64 - floorLog2(sampleBuckets));
+    if (++sampleCounts[bucket] < sampleRatio)
+        return false;
+
+    sampleCounts[bucket] = 0;
+    return true;
+}
+
+CommMonitor::CommMonitorSenderState *
+CommMonitor::allocSenderState()
+{
+    if (senderStatePool.empty())
+        return new CommMonitorSenderState(this, curTick());
+
+    auto *state = senderStatePool.back();
+    senderStatePool.pop_back();
+    state->transmitTime = curTick();
+    return state;
+}
+
+void
+CommMonitor::freeSenderState(CommMonitorSenderState *state)
+{
+    senderStatePool.push_back(state);
+}
+
 void
 CommMonitor::recvFunctional(PacketPtr pkt)
 {
@@ -247,99 +294,109 @@ CommMonitor::MonitorStats::MonitorStats(Stats::Group *parent,
 void
 CommMonitor::MonitorStats::updateReqStats(
     const ProbePoints::PacketInfo& pkt_info, bool is_atomic,
-    bool expects_response)
+    bool expects_response, unsigned weight)
 {
     if (pkt_info.cmd.isRead()) {
         // Increment number of observed read transactions
         if (!disableTransactionHists)
-            ++readTrans;
+            readTrans += weight;
 
         // Get sample of burst length
         if (!disableBurstLengthHists)
-            readBurstLengthHist.sample(pkt_info.size);
+            readBurstLengthHist.sample(pkt_info.size, weight);
 
         // Sample the masked address
         if (!disableAddrDists)
-            readAddrDist.sample(pkt_info.addr & readAddrMask);
-
-        if (!disableITTDists) {
-            // Sample value of read-read inter transaction time
-            if (timeOfLastRead != 0)
-                ittReadRead.sample(curTick() - timeOfLastRead);
-            timeOfLastRead = curTick();
-
-            // Sample value of req-req inter transaction time
-            if (timeOfLastReq != 0)
-                ittReqReq.sample(curTick() - timeOfLastReq);
-            timeOfLastReq = curTick();
-        }
+            readAddrDist.sample(pkt_info.addr & readAddrMask, weight);
+
         if (!is_atomic && !disableOutstandingHists && expects_response)
-            ++outstandingReadReqs;
+            outstandingReadReqs += weight;
 
     } else if (pkt_info.cmd.isWrite()) {
         // Same as for reads
         if (!disableTransactionHists)
-            ++writeTrans;
+            writeTrans += weight;
 
         if (!disableBurstLengthHists)
-            writeBurstLengthHist.sample(pkt_info.size);
+            writeBurstLengthHist.sample(pkt_info.size, weight);
 
         // Update the bandwidth stats on the request
         if (!disableBandwidthHists) {
-            writtenBytes += pkt_info.size;
-            totalWrittenBytes += pkt_info.size;
+            writtenBytes += pkt_info.size * weight;
+            totalWrittenBytes += pkt_info.size * weight;
         }
 
         // Sample the masked write address
         if (!disableAddrDists)
-            writeAddrDist.sample(pkt_info.addr & writeAddrMask);
-
-        if (!disableITTDists) {
-            // Sample value of write-to-write inter transaction time
-            if (timeOfLastWrite != 0)
-                ittWriteWrite.sample(curTick() - timeOfLastWrite);
-            timeOfLastWrite = curTick();
-
-            // Sample value of req-to-req inter transaction time
-            if (timeOfLastReq != 0)
-                ittReqReq.sample(curTick() - timeOfLastReq);
-            timeOfLastReq = curTick();
-        }
+            writeAddrDist.sample(pkt_info.addr & writeAddrMask, weight);
 
         if (!is_atomic && !disableOutstandingHists && expects_response)
-            ++outstandingWriteReqs;
+            outstandingWriteReqs += weight;
+    }
+
+    updateITTStats(pkt_info, weight);
+}
+
+void
+CommMonitor::MonitorStats::updateITTStats(
+    const ProbePoints::PacketInfo& pkt_info, unsigned weight)
+{
+    if (disableITTDists)
+        return;
+
+    Tick *time_of_last;
+    Stats::Distribution *itt;
+    if (pkt_info.cmd.isRead()) {
+        time_of_last = &timeOfLastRead;
+        itt = &ittReadRead;
+    } else if (pkt_info.cmd.isWrite()) {
+        time_of_last = &timeOfLastWrite;
+        itt = &ittWriteWrite;
+    } else {
+        return;
     }
+
+    // Sample value of read-read (write-write) inter transaction time
+    if (weight && *time_of_last != 0)
+        itt->sample(curTick() - *time_of_last, weight);
+    *time_of_last = curTick();
+
+    // Sample value of req-req inter transaction time
+    if (weight && timeOfLastReq != 0)
+        ittReqReq.sample(curTick() - timeOfLastReq, weight);
+    timeOfLastReq = curTick();
 }
 
 void
 CommMonitor::MonitorStats::updateRespStats(
-    const ProbePoints::PacketInfo& pkt_info, Tick latency, bool is_atomic)
+    const ProbePoints::PacketInfo& pkt_info, Tick latency, bool is_atomic,
+    unsigned weight)
 {
     if (pkt_info.cmd.isRead()) {
         // Decrement number of outstanding read requests
         if (!is_atomic && !disableOutstandingHists) {
-            assert(outstandingReadReqs != 0);
-            --outstandingReadReqs;
+            assert(outstandingReadReqs >= weight);
+            outstandingReadReqs -= weight;
         }
 
         if (!disableLatencyHists)
-            readLatencyHist.sample(latency);
+            readLatencyHist.sample(latency, weight);
 
         // Update the bandwidth stats based on responses for reads
         if (!disableBandwidthHists) {
-            readBytes += pkt_info.size;
-            totalReadBytes += pkt_info.size;
+            readBytes += pkt_info.size * weight;
+            totalReadBytes += pkt_info.size * weight;
         }
 
     } else if (pkt_info.cmd.isWrite()) {
         // Decrement number of outstanding write requests
         if (!is_atomic && !disableOutstandingHists) {
-            assert(outstandingWriteReqs != 0);
-            --outstandingWriteReqs;
+            assert(outstandingWriteReqs >= weight);
+            outstandingWriteReqs -= weight;
         }
 
         if (!disableLatencyHists)
-            writeLatencyHist.sample(latency);
+            writeLatencyHist.sample(latency, weight);
     }
 }
 
@@ -348,14 +405,20 @@ CommMonitor::recvAtomic(PacketPtr pkt)
 {
     const bool expects_response(pkt->needsResponse() &&
                                 !pkt->cacheResponding());
+    const bool sampled = sampleTransaction(pkt->getAddr());
     ProbePoints::PacketInfo req_pkt_info(pkt);
     ppPktReq->notify(req_pkt_info);
 
     const Tick delay(memSidePort.sendAtomic(pkt));
 
-    stats.updateReqStats(req_pkt_info, true, expects_response);
-    if (expects_response)
-        stats.updateRespStats(req_pkt_info, delay, true);
+    if (sampled) {
+        stats.updateReqStats(req_pkt_info, true, expects_response,
+                             sampleRatio);
+        if (expects_response)
+            stats.updateRespStats(req_pkt_info, delay, true, sampleRatio);
+    } else {
+        stats.updateITTStats(req_pkt_info, 0);
+    }
 
     // Some packets, such as WritebackDirty, don't need response.
     assert(pkt->isResponse() || !expects_response);
@@ -383,20 +446,28 @@ CommMonitor::recvTimingReq(PacketPtr pkt)
     const bool expects_response(pkt->needsResponse() &&
                                 !pkt->cacheResponding());
 
+    // A retried request is counted again towards its bucket, which
+    // only shifts the sampling point within the bucket
+    const bool sampled = sampleTransaction(pkt_info.addr);
+
     // If a cache miss is served by a cache, a monitor near the memory
     // would see a request which needs a response, but this response
     // would not come back from the memory. Therefore we additionally
-    // have to check the cacheResponding flag
-    if (expects_response && !stats.disableLatencyHists) {
-        pkt->pushSenderState(new CommMonitorSenderState(curTick()));
+    // have to check the cacheResponding flag. When sampling, the sender
+    // state also tells the response whether it was instrumented.
+    const bool annotate = expects_response && sampled &&
+        (sampleRatio > 1 || !stats.disableLatencyHists);
+    if (annotate) {
+        pkt->pushSenderState(allocSenderState());
     }
 
     // Attempt to send the packet
     bool successful = memSidePort.sendTimingReq(pkt);
 
     // If not successful, restore the sender state
-    if (!successful && expects_response && !stats.disableLatencyHists) {
-        delete pkt->popSenderState();
+    if (!successful && annotate) {
+        freeSenderState(
+            static_cast<CommMonitorSenderState *>(pkt->popSenderState()));
     }
 
     if (successful) {
@@ -406,7 +477,12 @@ CommMonitor::recvTimingReq(PacketPtr pkt)
     if (successful) {
         DPRINTF(CommMonitor, "Forwarded %s request\n", pkt->isRead() ? "read" :
                 pkt->isWrite() ? "write" : "non read/write");
-        stats.updateReqStats(pkt_info, false, expects_response);
+        if (sampled) {
+            stats.updateReqStats(pkt_info, false, expects_response,
+                                 sampleRatio);
+        } else {
+            stats.updateITTStats(pkt_info, 0);
+        }
     }
     return successful;
 }
@@ -422,28 +498,36 @@ CommMonitor::recvTimingResp(PacketPtr pkt)
     const ProbePoints::PacketInfo pkt_info(pkt);
 
     Tick latency = 0;
-    CommMonitorSenderState* received_state =
-        dynamic_cast<CommMonitorSenderState*>(pkt->senderState);
+    CommMonitorSenderState* received_state = nullptr;
+    bool sampled = true;
 
-    if (!stats.disableLatencyHists) {
-        // Restore initial sender state
-        if (received_state == NULL)
+    if (sampleRatio > 1 || !stats.disableLatencyHists) {
+        received_state =
+            dynamic_cast<CommMonitorSenderState*>(pkt->senderState);
+        if (received_state && received_state->monitor != this)
+            received_state = nullptr;
+
+        // Without sampling every response must carry our state
+        if (received_state == NULL && sampleRatio == 1)
             panic("Monitor got a response without monitor sender state\n");
 
+        sampled = received_state != nullptr;
+
         // Restore the sate
-        pkt->senderState = received_state->predecessor;
+        if (received_state)
+            pkt->senderState = received_state->predecessor;
     }
 
     // Attempt to send the packet
     bool successful = cpuSidePort.sendTimingResp(pkt);
 
-    if (!stats.disableLatencyHists) {
+    if (received_state) {
         // If packet successfully send, sample value of latency,
-        // afterwards delete sender state, otherwise restore state
+        // afterwards recycle sender state, otherwise restore state
         if (successful) {
             latency = curTick() - received_state->transmitTime;
             DPRINTF(CommMonitor, "Latency: %d\n", latency);
-            delete received_state;
+            freeSenderState(received_state);
         } else {
             // Don't delete anything and let the packet look like we
             // did not touch it
@@ -455,7 +539,8 @@ CommMonitor::recvTimingResp(PacketPtr pkt)
         ppPktResp->notify(pkt_info);
         DPRINTF(CommMonitor, "Received %s response\n", pkt->isRead() ? "read" :
                 pkt->isWrite() ?  "write" : "non read/write");
-        stats.updateRespStats(pkt_info, latency, false);
+        if (sampled)
+            stats.updateRespStats(pkt_info, latency, false, sampleRatio);
     }
     return successful;
 }
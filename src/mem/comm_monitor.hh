@@ -40,6 +40,9 @@
 #ifndef __MEM_COMM_MONITOR_HH__
 #define __MEM_COMM_MONITOR_HH__
 
+#include <array>
+#include <vector>
+
 #include "base/statistics.hh"
 #include "mem/port.hh"
 #include "params/CommMonitor.hh"
@@ -71,6 +74,7 @@ class CommMonitor : public SimObject
      * @param params Python parameters
      */
     CommMonitor(const Params &params);
+    ~CommMonitor();
 
     void init() override;
     void startup() override;
@@ -95,15 +99,24 @@ class CommMonitor : public SimObject
          * Construct a new sender state and store the time so we can
          * calculate round-trip latency.
          *
+         * @param _monitor Monitor that annotated the packet
          * @param _transmitTime Time of packet transmission
          */
-        CommMonitorSenderState(Tick _transmitTime)
-            : transmitTime(_transmitTime)
+        CommMonitorSenderState(const CommMonitor *_monitor,
+                               Tick _transmitTime)
+            : monitor(_monitor), transmitTime(_transmitTime)
         { }
 
         /** Destructor */
         ~CommMonitorSenderState() { }
 
+        /**
+         * Monitor that annotated the packet. When sampling, a response
+         * may come back without our state and with the one of another
+         * monitor on top.
+         */
+        const CommMonitor *monitor;
+
         /** Tick when request is transmitted */
         Tick transmitTime;
 
@@ -266,6 +279,21 @@ class CommMonitor : public SimObject
 
     bool tryTiming(PacketPtr pkt);
 
+    /**
+     * Decide whether to instrument a transaction, counting the
+     * transactions of each address bucket separately.
+     *
+     * @param addr Address of the request
+     * @return True if the transaction should be instrumented
+     */
+    bool sampleTransaction(Addr addr);
+
+    /** Get a sender state, reusing one of a completed transaction */
+    CommMonitorSenderState *allocSenderState();
+
+    /** Keep the sender state of a completed transaction for reuse */
+    void freeSenderState(CommMonitorSenderState *state);
+
     /** Stats declarations, all in a struct for convenience. */
     struct MonitorStats : public Stats::Group
     {
@@ -382,10 +410,22 @@ class CommMonitor : public SimObject
          */
         MonitorStats(Stats::Group *parent, const CommMonitorParams &params);
 
+        /**
+         * Update the stats of an instrumented request or response,
+         * counting it weight times.
+         */
         void updateReqStats(const ProbePoints::PacketInfo& pkt, bool is_atomic,
-                            bool expects_response);
+                            bool expects_response, unsigned weight);
         void updateRespStats(const ProbePoints::PacketInfo& pkt, Tick latency,
-                             bool is_atomic);
+                             bool is_atomic, unsigned weight);
+
+        /**
+         * Update the inter transaction times with a request. Requests
+         * that are not instrumented (weight 0) only move the time of
+         * the last request.
+         */
+        void updateITTStats(const ProbePoints::PacketInfo& pkt,
+                            unsigned weight);
     };
 
     /** This function is called periodically at the end of each time bin */
@@ -404,11 +444,26 @@ class CommMonitor : public SimObject
     /** Sample period in seconds */
     const double samplePeriod;
 
+    /** Instrument one in this many transactions */
+    const unsigned sampleRatio;
+
+    /** Number of address buckets counted separately when sampling */
+    static const unsigned sampleBuckets = 64;
+
+    /** Transactions seen in each address bucket since its last sample */
+    std::array<unsigned, sampleBuckets> sampleCounts;
+
     /** @} */
 
     /** Instantiate stats */
     MonitorStats stats;
 
+    /**
+     * Sender states of completed transactions. Annotating a packet
+     * reuses one of them rather than allocating a new one.
+     */
+    std::vector<CommMonitorSenderState *> senderStatePool;
+
   protected: // Probe points
     /**
      * @{
@@ -98,8 +98,8 @@ bool HMCController::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
 
     // remember where to route the response to
     if (expect_response) {
-        assert(routeTo.find(pkt->req) == routeTo.end());
-        routeTo[pkt->req] = cpu_side_port_id;
+        assert(routeTo.find(pkt->req) == InvalidPortID);
+        routeTo.insert(pkt->req, cpu_side_port_id);
     }
 
     reqLayers[mem_side_port_id]->succeededTiming(packetFinishTime);
@@ -854,12 +854,15 @@ MemCtrl::doBurstAccess(MemPacket* mem_pkt)
         // Update latency stats
         stats.requestorReadTotalLat[mem_pkt->requestorId()] +=
             mem_pkt->readyTime - mem_pkt->entryTime;
+        stats.readLatQuantiles.sample(mem_pkt->readyTime - mem_pkt->entryTime);
         stats.requestorReadBytes[mem_pkt->requestorId()] += mem_pkt->size;
     } else {
         ++writesThisTime;
         stats.requestorWriteBytes[mem_pkt->requestorId()] += mem_pkt->size;
         stats.requestorWriteTotalLat[mem_pkt->requestorId()] +=
             mem_pkt->readyTime - mem_pkt->entryTime;
+        stats.writeLatQuantiles.sample(
+            mem_pkt->readyTime - mem_pkt->entryTime);
     }
 }
 
@@ -1266,7 +1269,11 @@ MemCtrl::CtrlStats::CtrlStats(MemCtrl &_ctrl)
              "Per-requestor read average memory access latency"),
     ADD_STAT(requestorWriteAvgLat,
              UNIT_RATE(Stats::Units::Tick, Stats::Units::Count),
-             "Per-requestor write average memory access latency")
+             "Per-requestor write average memory access latency"),
+    ADD_STAT(readLatQuantiles, UNIT_TICK,
+             "Quantiles of the read memory access latency"),
+    ADD_STAT(writeLatQuantiles, UNIT_TICK,
+             "Quantiles of the write memory access latency")
 
 {
 }
@@ -1295,6 +1302,9 @@ MemCtrl::CtrlStats::regStats()
         .init(ctrl.writeBufferSize)
         .flags(nozero);
 
+    readLatQuantiles.init({ 0.5, 0.9, 0.99, 0.999 });
+    writeLatQuantiles.init({ 0.5, 0.9, 0.99, 0.999 });
+
     avgRdBWSys.precision(8);
     avgWrBWSys.precision(8);
     avgGap.precision(2);
@@ -1382,6 +1392,16 @@ MemCtrl::recvFunctional(PacketPtr pkt)
    }
 }
 
+void
+MemCtrl::recvMemBackdoorReq(const AddrRange &range, MemBackdoorPtr &backdoor)
+{
+    if (dram && range.isSubset(dram->getAddrRange())) {
+        dram->getFunctionalBackdoor(backdoor);
+    } else if (nvm && range.isSubset(nvm->getAddrRange())) {
+        nvm->getFunctionalBackdoor(backdoor);
+    }
+}
+
 Port &
 MemCtrl::getPort(const std::string &if_name, PortID idx)
 {
@@ -1484,6 +1504,13 @@ MemCtrl::MemoryPort::recvFunctional(PacketPtr pkt)
     pkt->popLabel();
 }
 
+void
+MemCtrl::MemoryPort::recvMemBackdoorReq(const AddrRange &range,
+                                        MemBackdoorPtr &backdoor)
+{
+    ctrl.recvMemBackdoorReq(range, backdoor);
+}
+
 Tick
 MemCtrl::MemoryPort::recvAtomic(PacketPtr pkt)
 {
@@ -46,6 +46,8 @@
 #ifndef __MEM_CTRL_HH__
 #define __MEM_CTRL_HH__
 
+#include <algorithm>
+#include <cassert>
 #include <deque>
 #include <string>
 #include <unordered_set>
@@ -53,6 +55,7 @@
 #include <vector>
 
 #include "base/callback.hh"
+#include "base/logging.hh"
 #include "base/statistics.hh"
 #include "enums/MemSched.hh"
 #include "mem/qos/mem_ctrl.hh"
@@ -205,9 +208,237 @@ class MemPacket
 
 };
 
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
+/**
+ * The memory packets are stored in multiple queues, one per QoS
+ * priority. Each queue keeps its packets in arrival order and
+ * additionally indexes them by rank, bank and row, so that the
+ * FR-FCFS schedulers can find the oldest row hit, or the oldest
+ * packet to a closed row, of a bank without walking the whole queue.
+ * Packets to DRAM and to NVM are indexed separately as their rank and
+ * bank numbers refer to different devices.
+ */
+class MemPacketQueue
+{
+  public:
+    typedef std::deque<MemPacket*>::iterator iterator;
+    typedef std::deque<MemPacket*>::const_iterator const_iterator;
+
+    /** A packet and its position in the arrival order of the queue */
+    struct Entry
+    {
+        uint64_t seq;
+        MemPacket *pkt;
+    };
+
+  private:
+    /** Packets of a bank targeting the same row, oldest first */
+    struct RowQueue
+    {
+        uint32_t row;
+        std::vector<Entry> entries;
+    };
+
+    /**
+     * Packets of a bank grouped by row. There are typically only a
+     * handful of distinct rows pending per bank, hence the rows are
+     * kept unordered in a vector.
+     */
+    struct BankQueue
+    {
+        std::vector<RowQueue> rows;
+        size_t size = 0;
+    };
+
+    std::deque<MemPacket*> packets;
+
+    /** Arrival sequence numbers of the packets, always increasing */
+    std::deque<uint64_t> seqs;
+
+    uint64_t nextSeq = 0;
+
+    /** Bank queues indexed by bankKey, for DRAM and NVM packets */
+    std::vector<BankQueue> banks[2];
+
+    static size_t
+    bankKey(uint8_t rank, uint8_t bank)
+    {
+        return (size_t(rank) << 8) | bank;
+    }
+
+    const BankQueue *
+    findBank(bool is_dram, uint8_t rank, uint8_t bank) const
+    {
+        const auto &b = banks[is_dram ? 0 : 1];
+        const size_t key = bankKey(rank, bank);
+        return key < b.size() ? &b[key] : nullptr;
+    }
+
+    void
+    index(MemPacket *pkt, uint64_t seq)
+    {
+        auto &b = banks[pkt->isDram() ? 0 : 1];
+        const size_t key = bankKey(pkt->rank, pkt->bank);
+        if (key >= b.size())
+            b.resize(key + 1);
+
+        BankQueue &bank = b[key];
+        ++bank.size;
+        for (auto &row : bank.rows) {
+            if (row.row == pkt->row) {
+                row.entries.push_back({seq, pkt});
+                return;
+            }
+        }
+        bank.rows.push_back({pkt->row, {{seq, pkt}}});
+    }
+
+    void
+    unindex(MemPacket *pkt, uint64_t seq)
+    {
+        BankQueue &bank =
+            banks[pkt->isDram() ? 0 : 1][bankKey(pkt->rank, pkt->bank)];
+        for (auto row = bank.rows.begin(); row != bank.rows.end(); ++row) {
+            if (row->row != pkt->row)
+                continue;
+
+            auto e = std::lower_bound(row->entries.begin(),
+                row->entries.end(), seq,
+                [](const Entry &a, uint64_t s) { return a.seq < s; });
+            assert(e != row->entries.end() && e->pkt == pkt);
+            row->entries.erase(e);
+            if (row->entries.empty()) {
+                if (row != bank.rows.end() - 1)
+                    *row = std::move(bank.rows.back());
+                bank.rows.pop_back();
+            }
+            --bank.size;
+            return;
+        }
+        panic("Memory packet missing from the queue index\n");
+    }
+
+  public:
+    iterator begin() { return packets.begin(); }
+    iterator end() { return packets.end(); }
+    const_iterator begin() const { return packets.begin(); }
+    const_iterator end() const { return packets.end(); }
+
+    size_t size() const { return packets.size(); }
+    bool empty() const { return packets.empty(); }
+    MemPacket *front() const { return packets.front(); }
+
+    void
+    push_back(MemPacket *pkt)
+    {
+        index(pkt, nextSeq);
+        packets.push_back(pkt);
+        seqs.push_back(nextSeq++);
+    }
+
+    iterator
+    erase(iterator it)
+    {
+        const auto offset = it - packets.begin();
+        unindex(*it, seqs[offset]);
+        seqs.erase(seqs.begin() + offset);
+        return packets.erase(it);
+    }
+
+    /** Get the position of an entry returned by the lookups below */
+    iterator
+    find(const Entry &entry)
+    {
+        auto s = std::lower_bound(seqs.begin(), seqs.end(), entry.seq);
+        assert(s != seqs.end() && *s == entry.seq);
+        return packets.begin() + (s - seqs.begin());
+    }
+
+    /** Number of queued packets to a bank */
+    size_t
+    bankSize(bool is_dram, uint8_t rank, uint8_t bank) const
+    {
+        const BankQueue *b = findBank(is_dram, rank, bank);
+        return b ? b->size : 0;
+    }
+
+    /**
+     * Oldest packet to a bank and row, or nullptr if there is none.
+     */
+    const Entry *
+    oldestInRow(bool is_dram, uint8_t rank, uint8_t bank,
+                uint32_t row) const
+    {
+        const BankQueue *b = findBank(is_dram, rank, bank);
+        if (!b)
+            return nullptr;
+        for (const auto &r : b->rows) {
+            if (r.row == row)
+                return &r.entries.front();
+        }
+        return nullptr;
+    }
+
+    /**
+     * Oldest packet to a bank targeting any other row than the given
+     * one, or nullptr if there is none.
+     */
+    const Entry *
+    oldestNotInRow(bool is_dram, uint8_t rank, uint8_t bank,
+                   uint32_t row) const
+    {
+        const BankQueue *b = findBank(is_dram, rank, bank);
+        if (!b)
+            return nullptr;
+        const Entry *oldest = nullptr;
+        for (const auto &r : b->rows) {
+            if (r.row != row &&
+                (!oldest || r.entries.front().seq < oldest->seq)) {
+                oldest = &r.entries.front();
+            }
+        }
+        return oldest;
+    }
+
+    /**
+     * Is there any other packet than the given one, to DRAM or NVM,
+     * with the same rank, bank and row?
+     */
+    bool
+    hasRowHit(const MemPacket *pkt) const
+    {
+        for (bool is_dram : { true, false }) {
+            const BankQueue *b = findBank(is_dram, pkt->rank, pkt->bank);
+            if (!b)
+                continue;
+            for (const auto &r : b->rows) {
+                if (r.row == pkt->row && (r.entries.size() > 1 ||
+                                          r.entries.front().pkt != pkt)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Is there any packet, to DRAM or NVM, with the same rank and bank
+     * as the given one but a different row?
+     */
+    bool
+    hasBankConflict(const MemPacket *pkt) const
+    {
+        for (bool is_dram : { true, false }) {
+            const BankQueue *b = findBank(is_dram, pkt->rank, pkt->bank);
+            if (!b)
+                continue;
+            for (const auto &r : b->rows) {
+                if (r.row != pkt->row)
+                    return true;
+            }
+        }
+        return false;
+    }
+};
 
 
 /**
@@ -256,6 +487,8 @@ class MemCtrl : public QoS::MemCtrl
                 PacketPtr pkt, MemBackdoorPtr &backdoor) override;
 
         void recvFunctional(PacketPtr pkt) override;
+        void recvMemBackdoorReq(const AddrRange &range,
+                                MemBackdoorPtr &backdoor) override;
 
         bool recvTimingReq(PacketPtr) override;
 
@@ -583,6 +816,10 @@ class MemCtrl : public QoS::MemCtrl
         // per-requestor raed and write average memory access latency
         Stats::Formula requestorReadAvgLat;
         Stats::Formula requestorWriteAvgLat;
+
+        // read and write memory access latency quantiles
+        Stats::Quantiles readLatQuantiles;
+        Stats::Quantiles writeLatQuantiles;
     };
 
     CtrlStats stats;
@@ -705,6 +942,8 @@ class MemCtrl : public QoS::MemCtrl
     Tick recvAtomic(PacketPtr pkt);
     Tick recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor);
     void recvFunctional(PacketPtr pkt);
+    void recvMemBackdoorReq(const AddrRange &range,
+                            MemBackdoorPtr &backdoor);
     bool recvTimingReq(PacketPtr pkt);
 
 };
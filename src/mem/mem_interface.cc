@@ -40,6 +40,8 @@
 
 #include "mem/mem_interface.hh"
 
+#include <algorithm>
+
 #include "base/bitfield.hh"
 #include "base/cprintf.hh"
 #include "base/trace.hh"
@@ -168,116 +170,129 @@ MemInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
-    std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
-
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
-
     // search for seamless row hits first, if no seamless row hit is
     // found then determine if there are other packets that can be issued
     // without incurring additional bus delay due to bank timing
     // Will select closed rows first to enable more open row possibilies
     // in future selections
-    bool found_hidden_bank = false;
-
-    // remember if we found a row hit, not seamless, but bank prepped
+    //
+    // Rather than walking the queue, the oldest row hit and the oldest
+    // row miss of every bank are looked up in the queue index, the
+    // order of preference is the same as for a walk in queue order. A
+    // queue only holds either reads or writes, hence all the packets
+    // of a bank have the same column timing and only the oldest one
+    // of each kind needs to be considered
+    const MemPacketQueue::Entry *seamless_pkt = nullptr;
+    Tick seamless_col_at = MaxTick;
+
+    // remember the oldest row hit, not seamless, but bank prepped
     // and ready
-    bool found_prepped_pkt = false;
+    const MemPacketQueue::Entry *prepped_pkt = nullptr;
+    Tick prepped_col_at = MaxTick;
 
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
-
-    Tick selected_col_at = MaxTick;
-    auto selected_pkt_it = queue.end();
+    // are there packets to closed rows in available ranks?
+    bool got_row_miss = false;
 
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        MemPacket* pkt = *i;
+    for (int i = 0; i < ranksPerChannel; i++) {
+        // check if rank is not doing a refresh and thus is available,
+        // if not, skip its banks
+        if (!ranks[i]->inRefIdleState()) {
+            DPRINTF(DRAM, "%s Rank %d not available\n", __func__, i);
+            continue;
+        }
 
-        // select optimal DRAM packet in Q
-        if (pkt->isDram()) {
-            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
-            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
-                                                        bank.wrAllowedAt;
+        for (int j = 0; j < banksPerRank; j++) {
+            const Bank& bank = ranks[i]->banks[j];
+            const MemPacketQueue::Entry *hit =
+                queue.oldestInRow(true, i, j, bank.openRow);
+            if (hit) {
+                const Tick col_allowed_at = hit->pkt->isRead() ?
+                    bank.rdAllowedAt : bank.wrAllowedAt;
+
+                // no additional rank-to-rank or same bank-group
+                // delays, or we switched read/write and might as well
+                // go for the row hit
+                if (col_allowed_at <= min_col_at) {
+                    // FCFS within the hits, giving priority to
+                    // commands that can issue seamlessly, without
+                    // additional delay, such as same rank accesses
+                    // and/or different bank-group accesses
+                    if (!seamless_pkt || hit->seq < seamless_pkt->seq) {
+                        seamless_pkt = hit;
+                        seamless_col_at = col_allowed_at;
+                    }
+                } else if (!prepped_pkt || hit->seq < prepped_pkt->seq) {
+                    prepped_pkt = hit;
+                    prepped_col_at = col_allowed_at;
+                }
+            }
 
-            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
-                    __func__, pkt->bank, pkt->row);
+            got_row_miss = got_row_miss ||
+                queue.oldestNotInRow(true, i, j, bank.openRow);
+        }
+    }
 
-            // check if rank is not doing a refresh and thus is available,
-            // if not, jump to the next packet
-            if (burstReady(pkt)) {
+    if (seamless_pkt) {
+        DPRINTF(DRAM, "%s Seamless buffer hit in bank %d, row %d\n",
+                __func__, seamless_pkt->pkt->bank, seamless_pkt->pkt->row);
+        return std::make_pair(queue.find(*seamless_pkt), seamless_col_at);
+    }
 
-                DPRINTF(DRAM,
-                        "%s bank %d - Rank %d available\n", __func__,
-                        pkt->bank, pkt->rank);
+    // if we have no row hit, prepped or not, and no seamless packet,
+    // just go for the earliest possible
+    const MemPacketQueue::Entry *earliest_pkt = nullptr;
+    Tick earliest_col_at = MaxTick;
 
-                // check if it is a row hit
-                if (bank.openRow == pkt->row) {
-                    // no additional rank-to-rank or same bank-group
-                    // delays, or we switched read/write and might as well
-                    // go for the row hit
-                    if (col_allowed_at <= min_col_at) {
-                        // FCFS within the hits, giving priority to
-                        // commands that can issue seamlessly, without
-                        // additional delay, such as same rank accesses
-                        // and/or different bank-group accesses
-                        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        // no need to look through the remaining queue entries
-                        break;
-                    } else if (!found_hidden_bank && !found_prepped_pkt) {
-                        // if we did not find a packet to a closed row that can
-                        // issue the bank commands without incurring delay, and
-                        // did not yet find a packet to a prepped row, remember
-                        // the current one
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        found_prepped_pkt = true;
-                        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                    }
-                } else if (!found_earliest_pkt) {
-                    // if we have not initialised the bank status, do it
-                    // now, and only once per scheduling decisions
-                    if (!filled_earliest_banks) {
-                        // determine entries with earliest bank delay
-                        std::tie(earliest_banks, hidden_bank_prep) =
-                            minBankPrep(queue, min_col_at);
-                        filled_earliest_banks = true;
-                    }
+    // can the PRE/ACT sequence be done without impacting utlization?
+    bool hidden_bank_prep = false;
 
-                    // bank is amongst first available banks
-                    // minBankPrep will give priority to packets that can
-                    // issue seamlessly
-                    if (bits(earliest_banks[pkt->rank],
-                             pkt->bank, pkt->bank)) {
-                        found_earliest_pkt = true;
-                        found_hidden_bank = hidden_bank_prep;
-
-                        // give priority to packets that can issue
-                        // bank commands 'behind the scenes'
-                        // any additional delay if any will be due to
-                        // col-to-col command requirements
-                        if (hidden_bank_prep || !found_prepped_pkt) {
-                            selected_pkt_it = i;
-                            selected_col_at = col_allowed_at;
-                        }
-                    }
+    if (got_row_miss) {
+        // determine entries with earliest bank delay
+        std::vector<uint32_t> earliest_banks;
+        std::tie(earliest_banks, hidden_bank_prep) =
+            minBankPrep(queue, min_col_at);
+
+        for (int i = 0; i < ranksPerChannel; i++) {
+            if (!ranks[i]->inRefIdleState())
+                continue;
+
+            for (int j = 0; j < banksPerRank; j++) {
+                // bank is amongst first available banks
+                // minBankPrep will give priority to packets that can
+                // issue seamlessly
+                if (!bits(earliest_banks[i], j, j))
+                    continue;
+
+                const Bank& bank = ranks[i]->banks[j];
+                const MemPacketQueue::Entry *miss =
+                    queue.oldestNotInRow(true, i, j, bank.openRow);
+                if (miss && (!earliest_pkt || miss->seq < earliest_pkt->seq)) {
+                    earliest_pkt = miss;
+                    earliest_col_at = miss->pkt->isRead() ?
+                        bank.rdAllowedAt : bank.wrAllowedAt;
                 }
-            } else {
-                DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                        pkt->bank, pkt->rank);
             }
         }
     }
 
-    if (selected_pkt_it == queue.end()) {
-        DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+    // give priority to packets that can issue bank commands 'behind
+    // the scenes', any additional delay if any will be due to
+    // col-to-col command requirements
+    if (earliest_pkt && (hidden_bank_prep || !prepped_pkt)) {
+        DPRINTF(DRAM, "%s Earliest bank %d, row %d\n", __func__,
+                earliest_pkt->pkt->bank, earliest_pkt->pkt->row);
+        return std::make_pair(queue.find(*earliest_pkt), earliest_col_at);
     }
 
-    return std::make_pair(selected_pkt_it, selected_col_at);
+    if (prepped_pkt) {
+        DPRINTF(DRAM, "%s Prepped row buffer hit in bank %d, row %d\n",
+                __func__, prepped_pkt->pkt->bank, prepped_pkt->pkt->row);
+        return std::make_pair(queue.find(*prepped_pkt), prepped_col_at);
+    }
+
+    DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+
+    return std::make_pair(queue.end(), MaxTick);
 }
 
 void
@@ -611,30 +626,18 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         bool got_more_hits = false;
         bool got_bank_conflict = false;
 
-        for (uint8_t i = 0; i < ctrl->numPriorities(); ++i) {
-            auto p = queue[i].begin();
-            // keep on looking until we find a hit or reach the end of the
-            // queue
-            // 1) if a hit is found, then both open and close adaptive
-            //    policies keep the page open
-            // 2) if no hit is found, got_bank_conflict is set to true if a
-            //    bank conflict request is waiting in the queue
-            // 3) make sure we are not considering the packet that we are
-            //    currently dealing with
-            while (!got_more_hits && p != queue[i].end()) {
-                if (mem_pkt != (*p)) {
-                    bool same_rank_bank = (mem_pkt->rank == (*p)->rank) &&
-                                          (mem_pkt->bank == (*p)->bank);
-
-                    bool same_row = mem_pkt->row == (*p)->row;
-                    got_more_hits |= same_rank_bank && same_row;
-                    got_bank_conflict |= same_rank_bank && !same_row;
-                }
-                ++p;
-            }
-
-            if (got_more_hits)
-                break;
+        // keep on looking until we find a hit or have looked at all
+        // the queues
+        // 1) if a hit is found, then both open and close adaptive
+        //    policies keep the page open
+        // 2) if no hit is found, got_bank_conflict is set to true if a
+        //    bank conflict request is waiting in the queue
+        // 3) the queues do not consider the packet that we are
+        //    currently dealing with as a hit
+        for (uint8_t i = 0; i < ctrl->numPriorities() && !got_more_hits;
+             ++i) {
+            got_more_hits = queue[i].hasRowHit(mem_pkt);
+            got_bank_conflict |= queue[i].hasBankConflict(mem_pkt);
         }
 
         // auto pre-charge when either
@@ -752,6 +755,7 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       maxAccessesPerRow(_p.max_accesses_per_row),
       timeStampOffset(0), activeRank(0),
       enableDRAMPowerdown(_p.enable_dram_powerdown),
+      lazyIdleRefresh(_p.lazy_idle_refresh && !_p.enable_dram_powerdown),
       lastStatsResetTick(0),
       stats(*this)
 {
@@ -928,6 +932,9 @@ DRAMInterface::isBusy()
 
 void DRAMInterface::setupRank(const uint8_t rank, const bool is_read)
 {
+    // catch up on any refreshes the rank skipped while idle
+    ranks[rank]->resumeRefresh();
+
     // increment entry count of the rank based on packet type
     if (is_read) {
         ++ranks[rank]->readEntries;
@@ -1051,25 +1058,17 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // delay on the data bus
     bool hidden_bank_prep = false;
 
-    // determine if we have queued transactions targetting the
-    // bank in question
-    std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
-    }
-
     // Find command with optimal bank timing
     // Will prioritize commands that can issue seamlessly.
     for (int i = 0; i < ranksPerChannel; i++) {
-        for (int j = 0; j < banksPerRank; j++) {
-            uint16_t bank_id = i * banksPerRank + j;
+        // make sure this rank is not currently refreshing.
+        if (!ranks[i]->inRefIdleState())
+            continue;
 
+        for (int j = 0; j < banksPerRank; j++) {
             // if we have waiting requests for the bank, and it is
             // amongst the first available, update the mask
-            if (got_waiting[bank_id]) {
-                // make sure this rank is not currently refreshing.
-                assert(ranks[i]->inRefIdleState());
+            if (queue.bankSize(true, i, j)) {
                 // simplistic approximation of when the bank can issue
                 // an activate, ignoring any rank-to-rank switching
                 // cost in this calculation
@@ -1122,7 +1121,8 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
                          int _rank, DRAMInterface& _dram)
     : EventManager(&_dram), dram(_dram),
       pwrStateTrans(PWR_IDLE), pwrStatePostRefresh(PWR_IDLE),
-      pwrStateTick(0), refreshDueAt(0), pwrState(PWR_IDLE),
+      pwrStateTick(0), refreshDueAt(0), refreshDeferred(false),
+      nextRefreshAt(0), pwrState(PWR_IDLE),
       refreshState(REF_IDLE), inLowPowerState(false), rank(_rank),
       readEntries(0), writeEntries(0), outstandingEvents(0),
       wakeUpAllowedAt(0), power(_p, false), banks(_p.banks_per_rank),
@@ -1171,6 +1171,8 @@ DRAMInterface::Rank::startup(Tick ref_tick)
 void
 DRAMInterface::Rank::suspend()
 {
+    resumeRefresh();
+
     deschedule(refreshEvent);
 
     // Update the stats
@@ -1180,6 +1182,87 @@ DRAMInterface::Rank::suspend()
     pwrStatePostRefresh = PWR_IDLE;
 }
 
+void
+DRAMInterface::Rank::deferRefresh()
+{
+    assert(refreshEvent.scheduled());
+    assert(refreshState == REF_IDLE && pwrState == PWR_IDLE);
+
+    nextRefreshAt = refreshEvent.when();
+    deschedule(refreshEvent);
+    refreshDeferred = true;
+
+    DPRINTF(DRAMState, "Rank %d idle, deferring refresh at %llu\n", rank,
+            nextRefreshAt);
+}
+
+void
+DRAMInterface::Rank::resumeRefresh()
+{
+    if (!refreshDeferred)
+        return;
+
+    refreshDeferred = false;
+
+    // replay the refreshes that completed while the rank was idle,
+    // following the same schedule as the refresh event would have,
+    // where each refresh is started as soon as it is due
+    Tick ref_at = nextRefreshAt;
+    Tick ref_done_at = 0;
+    while (ref_at + dram.tRFC <= curTick()) {
+        ref_done_at = ref_at + dram.tRFC;
+
+        stats.pwrStateTime[PWR_IDLE] += ref_at - pwrStateTick;
+        stats.pwrStateTime[PWR_REF] += dram.tRFC;
+        pwrStateTick = ref_done_at;
+
+        cmdList.push_back(Command(MemCommand::REF, 0, ref_at));
+
+        DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(ref_at, dram.tCK) -
+                dram.timeStampOffset, rank);
+
+        refreshDueAt = ref_at + dram.tREFI;
+        ref_at = refreshDueAt - dram.tRP;
+    }
+
+    if (ref_done_at != 0) {
+        for (auto &b : banks) {
+            b.actAllowedAt = std::max(b.actAllowedAt, ref_done_at);
+        }
+        // the energy is picked up with the next stats update
+        flushCmdList();
+    }
+
+    if (ref_at < curTick()) {
+        // a refresh is in progress, put the rank back in the state the
+        // refresh event would have left it in when starting it
+        stats.pwrStateTime[PWR_IDLE] += ref_at - pwrStateTick;
+        pwrStateTick = ref_at;
+        pwrState = PWR_REF;
+        pwrStateTrans = PWR_REF;
+        ++outstandingEvents;
+
+        ref_done_at = ref_at + dram.tRFC;
+        for (auto &b : banks) {
+            b.actAllowedAt = ref_done_at;
+        }
+
+        cmdList.push_back(Command(MemCommand::REF, 0, ref_at));
+
+        DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(ref_at, dram.tCK) -
+                dram.timeStampOffset, rank);
+
+        refreshDueAt = ref_at + dram.tREFI;
+        refreshState = REF_RUN;
+        schedule(refreshEvent, ref_done_at);
+    } else {
+        schedule(refreshEvent, ref_at);
+    }
+
+    DPRINTF(DRAMState, "Rank %d resuming refresh, next refresh event at "
+            "%llu\n", rank, refreshEvent.when());
+}
+
 bool
 DRAMInterface::Rank::isQueueEmpty() const
 {
@@ -1210,13 +1293,17 @@ void
 DRAMInterface::Rank::flushCmdList()
 {
     // at the moment sort the list of commands and update the counters
-    // for DRAMPower libray when doing a refresh
-    sort(cmdList.begin(), cmdList.end(), DRAMInterface::sortTime);
+    // for DRAMPower libray when doing a refresh; the commands are
+    // mostly issued in order, so only sort them when needed
+    if (!std::is_sorted(cmdList.begin(), cmdList.end(),
+                        DRAMInterface::sortTime)) {
+        sort(cmdList.begin(), cmdList.end(), DRAMInterface::sortTime);
+    }
 
     auto next_iter = cmdList.begin();
     // push to commands to DRAMPower
     for ( ; next_iter != cmdList.end() ; ++next_iter) {
-         Command cmd = *next_iter;
+         const Command &cmd = *next_iter;
          if (cmd.timeStamp <= curTick()) {
              // Move all commands at or before curTick to DRAMPower
              power.powerlib.doCommand(cmd.type, cmd.bank,
@@ -1228,10 +1315,9 @@ DRAMInterface::Rank::flushCmdList()
              break;
          }
     }
-    // reset cmdList to only contain commands after curTick
-    // if there are no commands after curTick, updated cmdList will be empty
-    // in this case, next_iter is cmdList.end()
-    cmdList.assign(next_iter, cmdList.end());
+    // reset cmdList to only contain commands after curTick, keeping
+    // its storage for the next commands
+    cmdList.erase(cmdList.begin(), next_iter);
 }
 
 void
@@ -1677,6 +1763,14 @@ DRAMInterface::Rank::processPowerEvent()
                            " rank %d\n", rank);
             dram.ctrl->restartScheduler(curTick());
         }
+
+        // with nothing queued for the rank, stop refreshing it through
+        // events until the next request arrives
+        if (dram.lazyIdleRefresh && pwrState == PWR_IDLE &&
+            readEntries == 0 && writeEntries == 0 &&
+            dram.ctrl->drainState() == DrainState::Running) {
+            deferRefresh();
+        }
     }
 
     if ((pwrState == PWR_ACT) && (refreshState == REF_PD_EXIT)) {
@@ -1815,6 +1909,8 @@ DRAMInterface::Rank::computeStats()
 {
     DPRINTF(DRAM,"Computing stats due to a dump callback\n");
 
+    resumeRefresh();
+
     // Update the stats
     updatePowerStats();
 
@@ -1825,6 +1921,8 @@ DRAMInterface::Rank::computeStats()
 
 void
 DRAMInterface::Rank::resetStats() {
+    resumeRefresh();
+
     // The only way to clear the counters in DRAMPower is to call
     // calcWindowEnergy function as that then calls clearCounters. The
     // clearCounters method itself is private.
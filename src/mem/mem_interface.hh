@@ -492,6 +492,17 @@ class DRAMInterface : public MemInterface
          */
         Tick refreshDueAt;
 
+        /**
+         * Set while the rank is idle and its refreshes are accounted
+         * for analytically rather than with a refresh event.
+         */
+        bool refreshDeferred;
+
+        /**
+         * Tick at which the deferred refresh event would have fired.
+         */
+        Tick nextRefreshAt;
+
         /**
          * Function to update Power Stats
          */
@@ -601,6 +612,20 @@ class DRAMInterface : public MemInterface
          */
         void suspend();
 
+        /**
+         * Stop scheduling refresh events for a rank that is idle after a
+         * refresh, remembering when the next one would have been due.
+         */
+        void deferRefresh();
+
+        /**
+         * Account for the refreshes a deferred rank would have performed
+         * up to now and get the refresh state machine going again. Any
+         * refresh still in progress at the current tick is put back in
+         * place with its events.
+         */
+        void resumeRefresh();
+
         /**
          * Check if there is no refresh and no preparation of refresh ongoing
          * i.e. the refresh state machine is in idle
@@ -767,6 +792,12 @@ class DRAMInterface : public MemInterface
     /** Enable or disable DRAM powerdown states. */
     bool enableDRAMPowerdown;
 
+    /**
+     * Account for the refreshes of idle ranks without scheduling
+     * events, until a request arrives.
+     */
+    bool lazyIdleRefresh;
+
     /** The time when stats were last reset used to calculate average power */
     Tick lastStatsResetTick;
 
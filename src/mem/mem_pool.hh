@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Pooled allocation of the objects created for every memory access:
+ * packets, requests and packet data buffers.
+ */
+
+#ifndef __MEM_MEM_POOL_HH__
+#define __MEM_MEM_POOL_HH__
+
+#include <cstddef>
+
+#include "base/slab_allocator.hh"
+
+//! Per-thread allocator for memory system objects. Use memPool() to
+//! access it.
+extern __thread SlabAllocator *_memPool;
+
+//! Allocate the memory system object allocator of the running thread.
+SlabAllocator *newMemPool();
+
+inline SlabAllocator &
+memPool()
+{
+    if (!_memPool)
+        _memPool = newMemPool();
+    return *_memPool;
+}
+
+//! Memory system object allocation statistics summed over all threads.
+SlabAllocator::Stats memPoolStats();
+
+/**
+ * Base class for small objects allocated and freed at a high rate,
+ * which draws them and the objects of derived classes from memPool().
+ * Classes deleted through a pointer to a base class need a virtual
+ * destructor so the block is returned with the right size.
+ */
+struct MemPoolAllocated
+{
+    static void *
+    operator new(size_t size)
+    {
+        return memPool().allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        memPool().deallocate(p, size);
+    }
+};
+
+/**
+ * Standard library allocator drawing from memPool(). Used with
+ * std::allocate_shared to place an object and its shared_ptr control
+ * block in a single pooled block.
+ */
+template <class T>
+class MemPoolAllocator
+{
+  public:
+    typedef T value_type;
+
+    MemPoolAllocator() = default;
+
+    template <class U>
+    MemPoolAllocator(const MemPoolAllocator<U> &) {}
+
+    T *
+    allocate(size_t n)
+    {
+        return static_cast<T *>(memPool().allocate(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *p, size_t n)
+    {
+        memPool().deallocate(p, n * sizeof(T));
+    }
+};
+
+template <class T, class U>
+bool
+operator==(const MemPoolAllocator<T> &, const MemPoolAllocator<U> &)
+{
+    return true;
+}
+
+template <class T, class U>
+bool
+operator!=(const MemPoolAllocator<T> &, const MemPoolAllocator<U> &)
+{
+    return false;
+}
+
+#endif // __MEM_MEM_POOL_HH__
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/multi_channel_mem_ctrl.hh"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/MemCtrl.hh"
+
+MultiChannelMemCtrl::MultiChannelMemCtrl(const MultiChannelMemCtrlParams &p)
+    : SimObject(p),
+      port(name() + ".port", *this),
+      gotRanges(p.port_channel_ports_connection_count, false),
+      retryReq(p.port_channel_ports_connection_count, false),
+      waitingRespRetry(false)
+{
+    for (int i = 0; i < p.port_channel_ports_connection_count; ++i) {
+        channelPorts.push_back(new ChannelRequestPort(
+            csprintf("%s.channel_ports[%d]", name(), i), *this, i));
+    }
+}
+
+MultiChannelMemCtrl::~MultiChannelMemCtrl()
+{
+    for (auto *p : channelPorts)
+        delete p;
+}
+
+void
+MultiChannelMemCtrl::init()
+{
+    if (!port.isConnected())
+        fatal("%s: port is not connected\n", name());
+    if (channelPorts.empty())
+        fatal("%s: no channels are connected\n", name());
+}
+
+Port &
+MultiChannelMemCtrl::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "port") {
+        return port;
+    } else if (if_name == "channel_ports" && idx >= 0 &&
+               idx < channelPorts.size()) {
+        return *channelPorts[idx];
+    } else {
+        return SimObject::getPort(if_name, idx);
+    }
+}
+
+PortID
+MultiChannelMemCtrl::decode(Addr addr) const
+{
+    // Find the last entry starting at or before the address
+    auto entry = std::upper_bound(decodeTable.begin(), decodeTable.end(),
+        addr, [](Addr a, const DecodeEntry &e)
+                 { return a < e.range.start(); });
+    if (entry != decodeTable.begin()) {
+        --entry;
+        if (addr < entry->range.end()) {
+            const PortID channel = entry->range.interleaved() ?
+                entry->channels[entry->range.selectIntlv(addr)] :
+                entry->channels.front();
+            if (channel != InvalidPortID)
+                return channel;
+        }
+    }
+
+    panic("%s: no channel serves address %#x\n", name(), addr);
+}
+
+void
+MultiChannelMemCtrl::buildDecodeTable()
+{
+    std::vector<std::pair<AddrRange, PortID>> channel_ranges;
+    for (const auto *p : channelPorts) {
+        for (const auto &r : p->getAddrRanges())
+            channel_ranges.emplace_back(r, p->getId());
+    }
+
+    // Ranges interleaving the same region have the same start and are
+    // ordered by their interleaving value
+    std::sort(channel_ranges.begin(), channel_ranges.end(),
+              [](const std::pair<AddrRange, PortID> &a,
+                 const std::pair<AddrRange, PortID> &b)
+              { return a.first < b.first; });
+
+    decodeTable.clear();
+    ranges.clear();
+    std::vector<AddrRange> stripes;
+    for (const auto &r : channel_ranges) {
+        if (decodeTable.empty() ||
+            !decodeTable.back().range.mergesWith(r.first)) {
+            fatal_if(!decodeTable.empty() &&
+                     decodeTable.back().range.end() > r.first.start(),
+                     "%s: range %s overlaps range %s\n", name(),
+                     r.first.to_string(),
+                     decodeTable.back().range.to_string());
+            decodeTable.push_back(DecodeEntry{r.first,
+                std::vector<PortID>(r.first.stripes(), InvalidPortID)});
+        }
+
+        PortID &channel =
+            decodeTable.back().channels[r.first.getIntlvMatch()];
+        fatal_if(channel != InvalidPortID,
+                 "%s: range %s is served by more than one channel\n",
+                 name(), r.first.to_string());
+        channel = r.second;
+    }
+
+    // Merge the stripes of the entries that are fully covered, the
+    // others are passed on as they are
+    auto r = channel_ranges.begin();
+    for (const auto &e : decodeTable) {
+        stripes.clear();
+        while (r != channel_ranges.end() && e.range.mergesWith(r->first))
+            stripes.push_back((r++)->first);
+
+        if (stripes.size() == e.range.stripes() && stripes.size() > 1)
+            ranges.push_back(AddrRange(stripes));
+        else
+            ranges.insert(ranges.end(), stripes.begin(), stripes.end());
+    }
+
+    DPRINTF(MemCtrl, "%s: decode table has %d entries for %d channels\n",
+            name(), decodeTable.size(), channelPorts.size());
+}
+
+void
+MultiChannelMemCtrl::recvRangeChange(PortID channel)
+{
+    gotRanges[channel] = true;
+    if (std::find(gotRanges.begin(), gotRanges.end(), false) !=
+        gotRanges.end()) {
+        return;
+    }
+
+    buildDecodeTable();
+    if (port.isConnected())
+        port.sendRangeChange();
+}
+
+AddrRangeList
+MultiChannelMemCtrl::getAddrRanges() const
+{
+    // The ranges are only known once all channels have told us
+    panic_if(std::find(gotRanges.begin(), gotRanges.end(), false) !=
+             gotRanges.end(),
+             "%s: address ranges requested before all channels are "
+             "known\n", name());
+    return ranges;
+}
+
+Tick
+MultiChannelMemCtrl::recvAtomic(PacketPtr pkt)
+{
+    return channelPorts[decode(pkt->getAddr())]->sendAtomic(pkt);
+}
+
+Tick
+MultiChannelMemCtrl::recvAtomicBackdoor(PacketPtr pkt,
+                                        MemBackdoorPtr &backdoor)
+{
+    return channelPorts[decode(pkt->getAddr())]->sendAtomicBackdoor(
+        pkt, backdoor);
+}
+
+void
+MultiChannelMemCtrl::recvFunctional(PacketPtr pkt)
+{
+    channelPorts[decode(pkt->getAddr())]->sendFunctional(pkt);
+}
+
+void
+MultiChannelMemCtrl::recvMemBackdoorReq(const AddrRange &range,
+                                        MemBackdoorPtr &backdoor)
+{
+    channelPorts[decode(range.start())]->sendMemBackdoorReq(range, backdoor);
+}
+
+bool
+MultiChannelMemCtrl::recvTimingReq(PacketPtr pkt)
+{
+    const PortID channel = decode(pkt->getAddr());
+    if (channelPorts[channel]->sendTimingReq(pkt))
+        return true;
+
+    // the channel will tell us when it can take requests again
+    retryReq[channel] = true;
+    return false;
+}
+
+void
+MultiChannelMemCtrl::recvReqRetry(PortID channel)
+{
+    if (retryReq[channel]) {
+        retryReq[channel] = false;
+        port.sendRetryReq();
+    }
+}
+
+bool
+MultiChannelMemCtrl::recvTimingResp(PacketPtr pkt, PortID channel)
+{
+    // responses are refused until the system side has asked for a
+    // retry, they are allowed through in the order they were refused
+    if (!waitingRespRetry && port.sendTimingResp(pkt))
+        return true;
+
+    waitingRespRetry = true;
+    respRetryList.push_back(channel);
+    return false;
+}
+
+void
+MultiChannelMemCtrl::recvRespRetry()
+{
+    assert(waitingRespRetry);
+    waitingRespRetry = false;
+
+    // keep on retrying the channels until the system side refuses a
+    // response again
+    while (!waitingRespRetry && !respRetryList.empty()) {
+        const PortID channel = respRetryList.front();
+        respRetryList.pop_front();
+        channelPorts[channel]->sendRetryResp();
+    }
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * MultiChannelMemCtrl declaration
+ */
+
+#ifndef __MEM_MULTI_CHANNEL_MEM_CTRL_HH__
+#define __MEM_MULTI_CHANNEL_MEM_CTRL_HH__
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "mem/port.hh"
+#include "params/MultiChannelMemCtrl.hh"
+#include "sim/sim_object.hh"
+
+/**
+ * The multi-channel memory controller is the single system interface
+ * of a set of single-channel memory controllers. The channels are
+ * connected directly to it, and the channel of every request is
+ * decoded from the interleaved address ranges of the channels, so
+ * that no crossbar is needed in front of the channels. The channels
+ * keep their own timing and statistics. Packets are passed on without
+ * any additional latency or buffering, a channel that cannot accept a
+ * request or a response is retried as soon as the other side is ready.
+ */
+class MultiChannelMemCtrl : public SimObject
+{
+  private:
+
+    class CtrlResponsePort : public ResponsePort
+    {
+      private:
+
+        MultiChannelMemCtrl &ctrl;
+
+      public:
+
+        CtrlResponsePort(const std::string &_name, MultiChannelMemCtrl &_ctrl)
+            : ResponsePort(_name, &_ctrl), ctrl(_ctrl)
+        { }
+
+      protected:
+
+        Tick recvAtomic(PacketPtr pkt) override
+        {
+            return ctrl.recvAtomic(pkt);
+        }
+
+        Tick
+        recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor) override
+        {
+            return ctrl.recvAtomicBackdoor(pkt, backdoor);
+        }
+
+        void recvFunctional(PacketPtr pkt) override
+        {
+            ctrl.recvFunctional(pkt);
+        }
+
+        void
+        recvMemBackdoorReq(const AddrRange &range,
+                           MemBackdoorPtr &backdoor) override
+        {
+            ctrl.recvMemBackdoorReq(range, backdoor);
+        }
+
+        bool recvTimingReq(PacketPtr pkt) override
+        {
+            return ctrl.recvTimingReq(pkt);
+        }
+
+        void recvRespRetry() override { ctrl.recvRespRetry(); }
+
+        AddrRangeList getAddrRanges() const override
+        {
+            return ctrl.getAddrRanges();
+        }
+    };
+
+    class ChannelRequestPort : public RequestPort
+    {
+      private:
+
+        MultiChannelMemCtrl &ctrl;
+
+      public:
+
+        ChannelRequestPort(const std::string &_name,
+                           MultiChannelMemCtrl &_ctrl, PortID _id)
+            : RequestPort(_name, &_ctrl, _id), ctrl(_ctrl)
+        { }
+
+      protected:
+
+        bool recvTimingResp(PacketPtr pkt) override
+        {
+            return ctrl.recvTimingResp(pkt, id);
+        }
+
+        void recvReqRetry() override { ctrl.recvReqRetry(id); }
+
+        void recvRangeChange() override { ctrl.recvRangeChange(id); }
+    };
+
+    /** The system interface of the controller */
+    CtrlResponsePort port;
+
+    /** The ports connected to the channel controllers */
+    std::vector<ChannelRequestPort *> channelPorts;
+
+    /**
+     * An entry of the channel decode table, covering either a single
+     * range or all the ranges that interleave the same region, in which
+     * case the channel is selected by the interleaving bits.
+     */
+    struct DecodeEntry
+    {
+        /** One of the ranges covered by the entry */
+        AddrRange range;
+
+        /** Channel of each stripe, indexed by the interleaving value */
+        std::vector<PortID> channels;
+    };
+
+    /** Decode table, sorted by start address */
+    std::vector<DecodeEntry> decodeTable;
+
+    /** The ranges of all the channels, merged where possible */
+    AddrRangeList ranges;
+
+    /** Channels we have received the address ranges of */
+    std::vector<bool> gotRanges;
+
+    /**
+     * Channels that refused a request, the refused requestor is told
+     * to retry when one of them asks for a retry.
+     */
+    std::vector<bool> retryReq;
+
+    /** Are we waiting for a response retry from the system side? */
+    bool waitingRespRetry;
+
+    /** Channels that had a response refused, in order */
+    std::deque<PortID> respRetryList;
+
+    /**
+     * Find the channel of an address.
+     *
+     * @param addr Address to decode
+     * @return The channel serving the address
+     */
+    PortID decode(Addr addr) const;
+
+    /** Rebuild the decode table once the ranges of all channels are in */
+    void buildDecodeTable();
+
+    Tick recvAtomic(PacketPtr pkt);
+    Tick recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor);
+    void recvFunctional(PacketPtr pkt);
+    void recvMemBackdoorReq(const AddrRange &range,
+                            MemBackdoorPtr &backdoor);
+    bool recvTimingReq(PacketPtr pkt);
+    void recvRespRetry();
+    AddrRangeList getAddrRanges() const;
+
+    bool recvTimingResp(PacketPtr pkt, PortID channel);
+    void recvReqRetry(PortID channel);
+    void recvRangeChange(PortID channel);
+
+  public:
+
+    MultiChannelMemCtrl(const MultiChannelMemCtrlParams &p);
+    ~MultiChannelMemCtrl();
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void init() override;
+};
+
+#endif //__MEM_MULTI_CHANNEL_MEM_CTRL_HH__
@@ -159,8 +159,8 @@ NoncoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
 
     // remember where to route the response to
     if (expect_response) {
-        assert(routeTo.find(pkt->req) == routeTo.end());
-        routeTo[pkt->req] = cpu_side_port_id;
+        assert(routeTo.find(pkt->req) == InvalidPortID);
+        routeTo.insert(pkt->req, cpu_side_port_id);
     }
 
     reqLayers[mem_side_port_id]->succeededTiming(packetFinishTime);
@@ -180,9 +180,7 @@ NoncoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     RequestPort *src_port = memSidePorts[mem_side_port_id];
 
     // determine the destination
-    const auto route_lookup = routeTo.find(pkt->req);
-    assert(route_lookup != routeTo.end());
-    const PortID cpu_side_port_id = route_lookup->second;
+    const PortID cpu_side_port_id = routeTo.find(pkt->req);
     assert(cpu_side_port_id != InvalidPortID);
     assert(cpu_side_port_id < respLayers.size());
 
@@ -219,7 +217,7 @@ NoncoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
                                         curTick() + latency);
 
     // remove the request from the routing table
-    routeTo.erase(route_lookup);
+    routeTo.erase(pkt->req);
 
     respLayers[cpu_side_port_id]->succeededTiming(packetFinishTime);
 
@@ -310,3 +308,14 @@ NoncoherentXBar::recvFunctional(PacketPtr pkt, PortID cpu_side_port_id)
     // forward the request to the appropriate destination
     memSidePorts[dest_id]->sendFunctional(pkt);
 }
+
+void
+NoncoherentXBar::recvMemBackdoorReq(const AddrRange &range,
+                                    MemBackdoorPtr &backdoor)
+{
+    // determine the destination port
+    PortID dest_id = findPort(range);
+
+    // forward the request to the appropriate destination
+    memSidePorts[dest_id]->sendMemBackdoorReq(range, backdoor);
+}
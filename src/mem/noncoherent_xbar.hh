@@ -123,6 +123,13 @@ class NoncoherentXBar : public BaseXBar
             xbar.recvFunctional(pkt, id);
         }
 
+        void
+        recvMemBackdoorReq(const AddrRange &range,
+                           MemBackdoorPtr &backdoor) override
+        {
+            xbar.recvMemBackdoorReq(range, backdoor);
+        }
+
         AddrRangeList
         getAddrRanges() const override
         {
@@ -176,6 +183,8 @@ class NoncoherentXBar : public BaseXBar
     Tick recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
                             MemBackdoorPtr *backdoor=nullptr);
     void recvFunctional(PacketPtr pkt, PortID cpu_side_port_id);
+    void recvMemBackdoorReq(const AddrRange &range,
+                            MemBackdoorPtr &backdoor);
 
   public:
 
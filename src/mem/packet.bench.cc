@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "sim/gbench/clocked_object_fake.hh"
+
+namespace
+{
+
+PacketPtr
+newRead(Addr addr, unsigned size)
+{
+    RequestPtr req = Request::create(addr, size, 0,
+                                     Request::funcRequestorId);
+    PacketPtr pkt = Packet::createRead(req);
+    pkt->allocate();
+    return pkt;
+}
+
+/** A read and its response, like a cache hit. */
+void
+ReadRoundTrip(benchmark::State &state)
+{
+    GBench::setupEventQueue();
+
+    Addr addr = 0;
+    for (auto _: state) {
+        PacketPtr pkt = newRead(addr, state.range(0));
+        pkt->makeResponse();
+        benchmark::DoNotOptimize(pkt->getConstPtr<uint8_t>());
+        delete pkt;
+        addr += 64;
+    }
+}
+
+/** Allocate a number of packets before freeing them, like misses do. */
+void
+Outstanding(benchmark::State &state)
+{
+    GBench::setupEventQueue();
+
+    std::vector<PacketPtr> pkts(state.range(0));
+    for (auto _: state) {
+        Addr addr = 0;
+        for (auto &pkt: pkts) {
+            pkt = newRead(addr, 64);
+            addr += 64;
+        }
+        for (auto pkt: pkts)
+            delete pkt;
+    }
+    state.SetItemsProcessed(state.iterations() * pkts.size());
+}
+
+} // anonymous namespace
+
+BENCHMARK(ReadRoundTrip)->Arg(8)->Arg(64);
+BENCHMARK(Outstanding)->RangeMultiplier(8)->Range(8, 4096);
@@ -59,6 +59,7 @@
 #include "base/printable.hh"
 #include "base/types.hh"
 #include "mem/htm.hh"
+#include "mem/mem_pool.hh"
 #include "mem/request.hh"
 #include "sim/byteswap.hh"
 #include "sim/core.hh"
@@ -317,6 +318,9 @@ class Packet : public Printable
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The dynamic data was allocated by allocate() from the
+        /// memory system object pool rather than with new [].
+        POOLED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -997,6 +1001,27 @@ class Packet : public Printable
         deleteData();
     }
 
+    /**
+     * @{
+     * Packets are allocated from the memory system object pool.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        return memPool().allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        memPool().deallocate(p, size);
+    }
+
+    // The class specific operator new hides the placement forms.
+    static void *operator new(size_t size, void *p) { return p; }
+    static void operator delete(void *p, void *place) {}
+    /** @} */
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1288,10 +1313,12 @@ class Packet : public Printable
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(POOLED_DATA))
+            memPool().deallocate(data, getSize());
+        else if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA);
         data = NULL;
     }
 
@@ -1303,8 +1330,13 @@ class Packet : public Printable
         // payload, actually allocate space
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
-            flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            if (getSize() <= SlabAllocator::MaxBlockSize) {
+                flags.set(DYNAMIC_DATA|POOLED_DATA);
+                data = static_cast<uint8_t *>(memPool().allocate(getSize()));
+            } else {
+                flags.set(DYNAMIC_DATA);
+                data = new uint8_t[getSize()];
+            }
         }
     }
 
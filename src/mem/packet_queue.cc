@@ -53,6 +53,7 @@ PacketQueue::PacketQueue(EventManager& _em, const std::string& _label,
       forceOrder(force_order),
       label(_label), waitingOnRetry(false)
 {
+    transmitList.grow(16);
 }
 
 PacketQueue::~PacketQueue()
@@ -128,24 +129,35 @@ PacketQueue::schedSendTiming(PacketPtr pkt, Tick when)
     // ourselves again before we had a chance to update waitingOnRetry
     // assert(waitingOnRetry || sendEvent.scheduled());
 
-    // this belongs in the middle somewhere, so search from the end to
-    // order by tick; however, if forceOrder is set, also make sure
+    // only schedule the send event if the packet goes first, as it is
+    // otherwise already scheduled for an earlier packet
+    if (insertDeferred(DeferredPacket(when, pkt), false))
+        schedSendEvent(when);
+}
+
+bool
+PacketQueue::insertDeferred(const DeferredPacket &dp, bool to_front)
+{
+    if (transmitList.full())
+        transmitList.grow(2 * transmitList.capacity());
+
+    // append the packet, and then move it forwards past the packets
+    // with a later tick; however, if forceOrder is set, also make sure
     // not to re-order in front of some existing packet with the same
     // address
-    auto it = transmitList.end();
-    while (it != transmitList.begin()) {
-        --it;
-        if ((forceOrder && it->pkt->matchAddr(pkt)) || it->tick <= when) {
-            // emplace inserts the element before the position pointed to by
-            // the iterator, so advance it one step
-            transmitList.emplace(++it, when, pkt);
-            return;
+    transmitList.push_back(dp);
+    size_t idx = transmitList.tail();
+    while (idx != transmitList.head()) {
+        const DeferredPacket &prev = transmitList[idx - 1];
+        if (!to_front && ((forceOrder && prev.pkt->matchAddr(dp.pkt)) ||
+                          prev.tick <= dp.tick)) {
+            break;
         }
+        transmitList[idx] = prev;
+        --idx;
     }
-    // either the packet list is empty or this has to be inserted
-    // before every other packet
-    transmitList.emplace_front(when, pkt);
-    schedSendEvent(when);
+    transmitList[idx] = dp;
+    return idx == transmitList.head();
 }
 
 void
@@ -210,7 +222,7 @@ PacketQueue::sendDeferredPacket()
         schedSendEvent(deferredPacketReadyTime());
     } else {
         // put the packet back at the front of the list
-        transmitList.emplace_front(dp);
+        insertDeferred(dp, true);
     }
 }
 
@@ -49,8 +49,7 @@
  * for the flow control of the port.
  */
 
-#include <list>
-
+#include "base/circular_queue.hh"
 #include "mem/port.hh"
 #include "sim/drain.hh"
 #include "sim/eventq.hh"
@@ -65,17 +64,30 @@ class PacketQueue : public Drainable
     /** A deferred packet, buffered to transmit later. */
     class DeferredPacket {
       public:
-        Tick tick;      ///< The tick when the packet is ready to transmit
-        PacketPtr pkt;  ///< Pointer to the packet to transmit
+        Tick tick = 0;            ///< The tick when the packet is ready
+        PacketPtr pkt = nullptr;  ///< Pointer to the packet to transmit
+        DeferredPacket() = default;
         DeferredPacket(Tick t, PacketPtr p)
             : tick(t), pkt(p)
         {}
     };
 
-    typedef std::list<DeferredPacket> DeferredPacketList;
+    /**
+     * The outgoing packets, ordered by tick. As packets are mostly
+     * added in order, a ring buffer lets us append them without
+     * allocating, and only shift a few packets for the others.
+     */
+    CircularQueue<DeferredPacket> transmitList;
 
-    /** A list of outgoing packets. */
-    DeferredPacketList transmitList;
+    /**
+     * Add a packet to the transmit list, after the last packet it
+     * may not overtake.
+     *
+     * @param dp Packet to add
+     * @param to_front Put the packet in front of all the others
+     * @return Whether the packet is now at the front of the list
+     */
+    bool insertDeferred(const DeferredPacket &dp, bool to_front);
 
     /** The manager which is used for the event queue */
     EventManager& em;
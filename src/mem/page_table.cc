@@ -33,14 +33,104 @@
  */
 #include "mem/page_table.hh"
 
+#include <algorithm>
 #include <string>
 
 #include "base/compiler.hh"
 #include "base/trace.hh"
 #include "debug/MMU.hh"
+#include "sim/eventq.hh"
 #include "sim/faults.hh"
 #include "sim/serialize.hh"
 
+EmulationPageTable::Leaf *
+EmulationPageTable::findLeaf(Addr leaf_num, bool alloc)
+{
+    CacheEntry &ce = cache[leaf_num % CacheEntries];
+    if (ce.tag == leaf_num)
+        return ce.leaf;
+
+    Node *node = &root;
+    for (unsigned level = 0; level < levels; level++) {
+        const unsigned shift = (levels - 1 - level) * LevelBits;
+        const unsigned idx = bits(leaf_num, shift + LevelBits - 1, shift);
+        if (level == levels - 1) {
+            if (node->leaves.empty()) {
+                if (!alloc)
+                    return nullptr;
+                node->leaves.resize(LeafEntries);
+            }
+            auto &leaf = node->leaves[idx];
+            if (!leaf) {
+                if (!alloc)
+                    return nullptr;
+                leaf.reset(new Leaf);
+            }
+            // Lookups from threads running in parallel race on the
+            // cache, so it is only filled by serial simulation.
+            if (!inParallelMode) {
+                ce.tag = leaf_num;
+                ce.leaf = leaf.get();
+            }
+            return leaf.get();
+        }
+        if (node->next.empty()) {
+            if (!alloc)
+                return nullptr;
+            node->next.resize(LeafEntries);
+        }
+        auto &next = node->next[idx];
+        if (!next) {
+            if (!alloc)
+                return nullptr;
+            next.reset(new Node);
+        }
+        node = next.get();
+    }
+    return nullptr;
+}
+
+void
+EmulationPageTable::freeLeaf(Addr leaf_num)
+{
+    CacheEntry &ce = cache[leaf_num % CacheEntries];
+    if (ce.tag == leaf_num)
+        ce = CacheEntry();
+
+    Node *node = &root;
+    for (unsigned level = 0; level < levels - 1; level++) {
+        const unsigned shift = (levels - 1 - level) * LevelBits;
+        node = node->next[bits(leaf_num, shift + LevelBits - 1,
+                               shift)].get();
+    }
+    node->leaves[bits(leaf_num, LevelBits - 1, 0)].reset();
+}
+
+template <class F>
+void
+EmulationPageTable::forEachEntry(const Node &node, unsigned level,
+                                 Addr leaf_num, F func) const
+{
+    if (level == levels - 1) {
+        for (unsigned i = 0; i < node.leaves.size(); i++) {
+            const Leaf *leaf = node.leaves[i].get();
+            if (!leaf)
+                continue;
+            const Addr base = ((leaf_num << LevelBits) | i) << LevelBits;
+            for (unsigned j = 0; j < LeafEntries; j++) {
+                if (leaf->valid[j])
+                    func((base | j) << pageShift, leaf->entries[j]);
+            }
+        }
+        return;
+    }
+    for (unsigned i = 0; i < node.next.size(); i++) {
+        if (node.next[i])
+            forEachEntry(*node.next[i], level + 1,
+                         (leaf_num << LevelBits) | i, func);
+    }
+}
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
@@ -51,20 +141,26 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        if (it != pTable.end()) {
-            // already mapped
-            panic_if(!clobber,
-                     "EmulationPageTable::allocate: addr %#x already mapped",
-                     vaddr);
-            it->second = Entry(paddr, flags);
-        } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
-        }
+        const Addr vpn = vaddr >> pageShift;
+        Leaf *leaf = findLeaf(vpn >> LevelBits, true);
+        // Fill the rest of this leaf in one go.
+        for (unsigned idx = vpn & mask(LevelBits);
+             idx < LeafEntries && size > 0; idx++) {
+            if (leaf->valid[idx]) {
+                // already mapped
+                panic_if(!clobber,
+                         "EmulationPageTable::allocate: addr %#x already "
+                         "mapped", vaddr);
+            } else {
+                leaf->valid[idx] = true;
+                numEntries++;
+            }
+            leaf->entries[idx] = Entry(paddr, flags);
 
-        size -= _pageSize;
-        vaddr += _pageSize;
-        paddr += _pageSize;
+            size -= _pageSize;
+            vaddr += _pageSize;
+            paddr += _pageSize;
+        }
     }
 }
 
@@ -78,12 +174,12 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
             new_vaddr, size);
 
     while (size > 0) {
-        M5_VAR_USED auto new_it = pTable.find(new_vaddr);
-        auto old_it = pTable.find(vaddr);
-        assert(old_it != pTable.end() && new_it == pTable.end());
+        const Entry *old_entry = lookup(vaddr);
+        assert(old_entry && !lookup(new_vaddr));
 
-        pTable.emplace(new_vaddr, old_it->second);
-        pTable.erase(old_it);
+        const Entry entry = *old_entry;
+        unmap(vaddr, _pageSize);
+        map(new_vaddr, entry.paddr, _pageSize, entry.flags);
         size -= _pageSize;
         vaddr += _pageSize;
         new_vaddr += _pageSize;
@@ -93,8 +189,9 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
-    for (auto &iter : pTable)
-        addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    forEachEntry(root, 0, 0, [addr_maps](Addr vaddr, const Entry &entry) {
+        addr_maps->push_back(std::make_pair(vaddr, entry.paddr));
+    });
 }
 
 void
@@ -105,11 +202,19 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        assert(it != pTable.end());
-        pTable.erase(it);
-        size -= _pageSize;
-        vaddr += _pageSize;
+        const Addr vpn = vaddr >> pageShift;
+        Leaf *leaf = findLeaf(vpn >> LevelBits);
+        assert(leaf);
+        for (unsigned idx = vpn & mask(LevelBits);
+             idx < LeafEntries && size > 0; idx++) {
+            assert(leaf->valid[idx]);
+            leaf->valid[idx] = false;
+            numEntries--;
+            size -= _pageSize;
+            vaddr += _pageSize;
+        }
+        if (leaf->valid.none())
+            freeLeaf(vpn >> LevelBits);
     }
 }
 
@@ -119,9 +224,20 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
-    for (int64_t offset = 0; offset < size; offset += _pageSize)
-        if (pTable.find(vaddr + offset) != pTable.end())
-            return false;
+    while (size > 0) {
+        const Addr vpn = vaddr >> pageShift;
+        const unsigned first = vpn & mask(LevelBits);
+        const unsigned count = std::min<int64_t>(LeafEntries - first,
+                divCeil(size, _pageSize));
+        const Leaf *leaf = findLeaf(vpn >> LevelBits);
+        if (leaf) {
+            for (unsigned idx = first; idx < first + count; idx++)
+                if (leaf->valid[idx])
+                    return false;
+        }
+        size -= count * _pageSize;
+        vaddr += count * _pageSize;
+    }
 
     return true;
 }
@@ -129,11 +245,12 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
 const EmulationPageTable::Entry *
 EmulationPageTable::lookup(Addr vaddr)
 {
-    Addr page_addr = pageAlign(vaddr);
-    PTableItr iter = pTable.find(page_addr);
-    if (iter == pTable.end())
+    const Addr vpn = vaddr >> pageShift;
+    const Leaf *leaf = findLeaf(vpn >> LevelBits);
+    const unsigned idx = vpn & mask(LevelBits);
+    if (!leaf || !leaf->valid[idx])
         return nullptr;
-    return &(iter->second);
+    return &leaf->entries[idx];
 }
 
 bool
@@ -169,17 +286,17 @@ void
 EmulationPageTable::serialize(CheckpointOut &cp) const
 {
     ScopedCheckpointSection sec(cp, "ptable");
-    paramOut(cp, "size", pTable.size());
+    paramOut(cp, "size", numEntries);
 
-    PTable::size_type count = 0;
-    for (auto &pte : pTable) {
+    uint64_t count = 0;
+    forEachEntry(root, 0, 0, [&cp, &count](Addr vaddr, const Entry &entry) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
 
-        paramOut(cp, "vaddr", pte.first);
-        paramOut(cp, "paddr", pte.second.paddr);
-        paramOut(cp, "flags", pte.second.flags);
-    }
-    assert(count == pTable.size());
+        paramOut(cp, "vaddr", vaddr);
+        paramOut(cp, "paddr", entry.paddr);
+        paramOut(cp, "flags", entry.flags);
+    });
+    assert(count == numEntries);
 }
 
 void
@@ -199,7 +316,14 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
 
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        const Addr vpn = vaddr >> pageShift;
+        Leaf *leaf = findLeaf(vpn >> LevelBits, true);
+        const unsigned idx = vpn & mask(LevelBits);
+        if (!leaf->valid[idx]) {
+            leaf->valid[idx] = true;
+            numEntries++;
+        }
+        leaf->entries[idx] = Entry(paddr, flags);
     }
 }
 
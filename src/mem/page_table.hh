@@ -35,8 +35,10 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <bitset>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
@@ -59,9 +61,54 @@ class EmulationPageTable : public Serializable
     };
 
   protected:
-    typedef std::unordered_map<Addr, Entry> PTable;
-    typedef PTable::iterator PTableItr;
-    PTable pTable;
+    /**
+     * The table is a radix tree indexed by virtual page number. Every
+     * node resolves LevelBits bits of it, and the leaves hold the
+     * entries for a naturally aligned run of LeafEntries pages, so
+     * mapping, unmapping or scanning a large region touches each leaf
+     * once instead of hashing every page.
+     */
+    static const unsigned LevelBits = 9;
+    static const unsigned LeafEntries = 1 << LevelBits;
+
+    struct Leaf
+    {
+        std::bitset<LeafEntries> valid;
+        Entry entries[LeafEntries];
+    };
+
+    /**
+     * An interior node. Nodes on the last interior level point to
+     * leaves, all others point to further nodes; only the matching
+     * vector is populated.
+     */
+    struct Node
+    {
+        std::vector<std::unique_ptr<Node>> next;
+        std::vector<std::unique_ptr<Leaf>> leaves;
+    };
+
+    /**
+     * A small direct mapped cache of recently used leaves, keyed by
+     * leaf number (vpn >> LevelBits), which lets most lookups skip the
+     * walk from the root.
+     */
+    static const unsigned CacheEntries = 64;
+
+    struct CacheEntry
+    {
+        Addr tag = MaxAddr;
+        Leaf *leaf = nullptr;
+    };
+
+    /** Find a leaf, optionally allocating it and the nodes above it. */
+    Leaf *findLeaf(Addr leaf_num, bool alloc=false);
+    /** Free the leaf with the given number and drop it from the cache. */
+    void freeLeaf(Addr leaf_num);
+
+    template <class F>
+    void forEachEntry(const Node &node, unsigned level, Addr leaf_num,
+                      F func) const;
 
     const Addr _pageSize;
     const Addr offsetMask;
@@ -69,12 +116,25 @@ class EmulationPageTable : public Serializable
     const uint64_t _pid;
     const std::string _name;
 
+    const unsigned pageShift;
+    /** Number of interior levels above the leaves. */
+    const unsigned levels;
+
+    Node root;
+    CacheEntry cache[CacheEntries];
+    /** Number of pages currently mapped. */
+    uint64_t numEntries;
+
   public:
 
     EmulationPageTable(
             const std::string &__name, uint64_t _pid, Addr _pageSize) :
             _pageSize(_pageSize), offsetMask(mask(floorLog2(_pageSize))),
-            _pid(_pid), _name(__name), shared(false)
+            _pid(_pid), _name(__name),
+            pageShift(floorLog2(_pageSize)),
+            levels(divCeil(sizeof(Addr) * 8 - pageShift - LevelBits,
+                           LevelBits)),
+            numEntries(0), shared(false)
     {
         assert(isPowerOf2(_pageSize));
     }
@@ -39,17 +39,27 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
@@ -68,16 +78,277 @@
 #endif
 #endif
 
+namespace
+{
+
+/**
+ * Bind a host memory region to a host NUMA node. The pages are only
+ * allocated on first touch, so this has to be done before the memory
+ * is written.
+ */
+void
+bindToHostNode(uint8_t *pmem, uint64_t size, int node)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    // MPOL_BIND from <numaif.h>, which is part of libnuma rather than
+    // of the C library
+    const int mpol_bind = 2;
+    const size_t bits = sizeof(unsigned long) * CHAR_BIT;
+    std::vector<unsigned long> node_mask(node / bits + 1, 0);
+    node_mask[node / bits] |= 1UL << (node % bits);
+    if (syscall(SYS_mbind, pmem, size, mpol_bind, node_mask.data(),
+                node_mask.size() * bits + 1, 0)) {
+        warn("Could not bind backing store to host NUMA node %d: %s\n",
+             node, std::strerror(errno));
+    }
+#else
+    warn("Could not bind backing store to host NUMA node %d, NUMA "
+         "binding is not supported on this host\n", node);
+#endif
+}
+
+/**
+ * Granularity of the zero page map of checkpoint shards. A shard is a
+ * gzip stream holding a ShardHeader, a bitmap with one bit per page
+ * that is set for the pages that aren't all zero, and the contents of
+ * those pages in order.
+ */
+const uint64_t shardPageSize = 4096;
+
+struct ShardHeader
+{
+    uint64_t pageSize;
+    uint64_t size;
+};
+
+bool
+isZeroPage(const uint8_t *page, uint64_t size)
+{
+    return page[0] == 0 && std::equal(page, page + size - 1, page + 1);
+}
+
+/**
+ * Run job for every shard index on a pool of threads. Jobs return an
+ * error message, or an empty string on success; the first error is
+ * fatal once all threads have finished since logging isn't thread
+ * safe.
+ */
+void
+forEachShard(size_t num_shards, unsigned threads,
+             const std::function<std::string(size_t)> &job)
+{
+    if (!threads)
+        threads = std::max(std::thread::hardware_concurrency(), 1U);
+    threads = std::min<size_t>(threads, num_shards);
+
+    std::atomic<size_t> next(0);
+    std::vector<std::string> errors(num_shards);
+    auto worker = [&]() {
+        for (size_t i = next++; i < num_shards; i = next++)
+            errors[i] = job(i);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool)
+        t.join();
+
+    for (const auto &error : errors) {
+        if (!error.empty())
+            fatal("%s\n", error);
+    }
+}
+
+std::string
+writeShard(const std::string &filepath, const uint8_t *data, uint64_t size)
+{
+    gzFile compressed = gzopen(filepath.c_str(), "wb");
+    if (compressed == NULL)
+        return "Can't open physical memory checkpoint file " + filepath;
+
+    const uint64_t num_pages = divCeil(size, shardPageSize);
+    std::vector<uint8_t> page_map(divCeil(num_pages, 8), 0);
+    for (uint64_t page = 0; page < num_pages; ++page) {
+        const uint64_t offset = page * shardPageSize;
+        if (!isZeroPage(data + offset,
+                        std::min(shardPageSize, size - offset))) {
+            page_map[page / 8] |= 1 << (page % 8);
+        }
+    }
+
+    const ShardHeader header = { shardPageSize, size };
+    bool ok = gzwrite(compressed, &header, sizeof(header)) ==
+        sizeof(header);
+    ok = ok && gzwrite(compressed, page_map.data(), page_map.size()) ==
+        (int)page_map.size();
+    for (uint64_t page = 0; ok && page < num_pages; ++page) {
+        if (!(page_map[page / 8] & (1 << (page % 8))))
+            continue;
+        const uint64_t offset = page * shardPageSize;
+        const unsigned len = std::min(shardPageSize, size - offset);
+        ok = gzwrite(compressed, data + offset, len) == (int)len;
+    }
+
+    if (gzclose(compressed) != Z_OK || !ok)
+        return "Write failed on physical memory checkpoint file " + filepath;
+    return "";
+}
+
+std::string
+readShard(const std::string &filepath, uint8_t *data, uint64_t size)
+{
+    gzFile compressed = gzopen(filepath.c_str(), "rb");
+    if (compressed == NULL)
+        return "Can't open physical memory checkpoint file " + filepath;
+
+    ShardHeader header;
+    bool ok = gzread(compressed, &header, sizeof(header)) ==
+        sizeof(header);
+    if (ok && (header.pageSize != shardPageSize || header.size != size)) {
+        gzclose(compressed);
+        return "Unexpected shard layout in physical memory checkpoint "
+            "file " + filepath;
+    }
+
+    // Zero pages aren't touched, the backing store starts out zeroed
+    const uint64_t num_pages = divCeil(size, shardPageSize);
+    std::vector<uint8_t> page_map(divCeil(num_pages, 8), 0);
+    ok = ok && gzread(compressed, page_map.data(), page_map.size()) ==
+        (int)page_map.size();
+    for (uint64_t page = 0; ok && page < num_pages; ++page) {
+        if (!(page_map[page / 8] & (1 << (page % 8))))
+            continue;
+        const uint64_t offset = page * shardPageSize;
+        const unsigned len = std::min(shardPageSize, size - offset);
+        ok = gzread(compressed, data + offset, len) == (int)len;
+    }
+
+    if (gzclose(compressed) != Z_OK || !ok)
+        return "Read failed on physical memory checkpoint file " + filepath;
+    return "";
+}
+
+/**
+ * Hash the contents of a shard to tell whether it changed since the
+ * last checkpoint. This needs to be much faster than compressing the
+ * shard, so it mixes 64-bit words in four independent lanes.
+ */
+uint64_t
+hashShard(const uint8_t *data, uint64_t size)
+{
+    const uint64_t mult = 0x9e3779b97f4a7c15ULL;
+    uint64_t lanes[4] = { size, mult, ~size, ~mult };
+
+    auto mix = [mult](uint64_t h, uint64_t w) {
+        h = (h ^ w) * mult;
+        return h ^ (h >> 29);
+    };
+
+    uint64_t offset = 0;
+    for (; offset + sizeof(lanes) <= size; offset += sizeof(lanes)) {
+        for (int l = 0; l < 4; ++l) {
+            uint64_t word;
+            std::memcpy(&word, data + offset + l * sizeof(word),
+                        sizeof(word));
+            lanes[l] = mix(lanes[l], word);
+        }
+    }
+    for (; offset < size; ++offset)
+        lanes[0] = mix(lanes[0], data[offset]);
+
+    uint64_t hash = lanes[0];
+    for (int l = 1; l < 4; ++l)
+        hash = mix(hash, lanes[l]);
+    return hash;
+}
+
+/** Canonical absolute path of a file, or an empty string. */
+std::string
+absolutePath(const std::string &path)
+{
+    std::string abs_path;
+    char *real_path = realpath(path.c_str(), nullptr);
+    if (real_path) {
+        abs_path = real_path;
+        free(real_path);
+    }
+    return abs_path;
+}
+
+/**
+ * Path of a file relative to a directory, both given as canonical
+ * absolute paths. Checkpoints only hold relative paths so that they
+ * can be moved together with the checkpoints they refer to.
+ */
+std::string
+relativePath(const std::string &dir, const std::string &path)
+{
+    auto split = [](const std::string &p) {
+        std::vector<std::string> parts;
+        for (size_t pos = 0; pos < p.size(); ) {
+            size_t next = p.find('/', pos);
+            if (next == std::string::npos)
+                next = p.size();
+            if (next > pos)
+                parts.push_back(p.substr(pos, next - pos));
+            pos = next + 1;
+        }
+        return parts;
+    };
+
+    const auto dir_parts = split(dir);
+    const auto path_parts = split(path);
+
+    size_t common = 0;
+    while (common < dir_parts.size() && common < path_parts.size() - 1 &&
+           dir_parts[common] == path_parts[common]) {
+        ++common;
+    }
+
+    std::string rel_path;
+    for (size_t i = common; i < dir_parts.size(); ++i)
+        rel_path += "../";
+    for (size_t i = common; i < path_parts.size(); ++i)
+        rel_path += path_parts[i] + (i + 1 < path_parts.size() ? "/" : "");
+    return rel_path;
+}
+
+} // anonymous namespace
+
 PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
-                               const std::string& shared_backstore) :
+                               const std::string& shared_backstore,
+                               uint64_t checkpoint_shard_size,
+                               unsigned checkpoint_threads,
+                               BackstoreHugePages huge_pages,
+                               const std::string& restore_image_cache,
+                               bool checkpoint_differential) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
-    sharedBackstore(shared_backstore)
+    sharedBackstore(shared_backstore), hugePages(huge_pages),
+    restoreImageCache(restore_image_cache),
+    checkpointShardSize(checkpoint_shard_size),
+    checkpointThreads(checkpoint_threads),
+    checkpointDifferential(checkpoint_differential)
 {
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
 
+    fatal_if(checkpointDifferential && !checkpointShardSize,
+             "Differential checkpoints need a checkpoint shard size\n");
+
+    fatal_if(hugePages == BackstoreHugePages::hugetlb &&
+             !sharedBackstore.empty(),
+             "Huge TLB pages cannot back a shared backing store\n");
+    fatal_if(!restoreImageCache.empty() && !sharedBackstore.empty(),
+             "Restored images cannot be mapped into a shared backing "
+             "store\n");
+    fatal_if(!restoreImageCache.empty() &&
+             hugePages == BackstoreHugePages::hugetlb,
+             "Restored images cannot be mapped with huge TLB pages\n");
+
     // add the memories from the system to the address map as
     // appropriate
     for (const auto& m : _memories) {
@@ -216,16 +487,51 @@ PhysicalMemory::createBackingStore(
         map_flags |= MAP_NORESERVE;
     }
 
+    if (hugePages == BackstoreHugePages::hugetlb) {
+#ifdef MAP_HUGETLB
+        map_flags |= MAP_HUGETLB;
+#else
+        fatal("Huge TLB pages are not supported on this host\n");
+#endif
+    }
+
     uint8_t* pmem = (uint8_t*) mmap(NULL, range.size(),
                                     PROT_READ | PROT_WRITE,
                                     map_flags, shm_fd, 0);
 
     if (pmem == (uint8_t*) MAP_FAILED) {
         perror("mmap");
+        fatal_if(hugePages == BackstoreHugePages::hugetlb,
+                 "Could not mmap %d bytes of huge TLB pages for range %s, "
+                 "is the huge page pool large enough?\n", range.size(),
+                 range.to_string());
         fatal("Could not mmap %d bytes for range %s!\n", range.size(),
               range.to_string());
     }
 
+    if (hugePages == BackstoreHugePages::transparent) {
+#ifdef MADV_HUGEPAGE
+        if (madvise(pmem, range.size(), MADV_HUGEPAGE))
+            warn("Could not use transparent huge pages for range %s: %s\n",
+                 range.to_string(), std::strerror(errno));
+#else
+        warn_once("Transparent huge pages are not supported on this host\n");
+#endif
+    }
+
+    // the memories sharing a backing store are interleaved, so they
+    // can only be bound to a single node as a whole
+    const int numa_node = _memories.front()->hostNumaNode();
+    for (const auto& m : _memories) {
+        if (m->hostNumaNode() != numa_node) {
+            warn("Memories of range %s are on different host NUMA nodes, "
+                 "using node %d\n", range.to_string(), numa_node);
+            break;
+        }
+    }
+    if (numa_node >= 0)
+        bindToHostNode(pmem, range.size(), numa_node);
+
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
@@ -252,6 +558,15 @@ PhysicalMemory::isMemAddr(Addr addr) const
     return addrMap.contains(addr) != addrMap.end();
 }
 
+uint8_t *
+PhysicalMemory::toHostAddr(Addr addr) const
+{
+    auto m = addrMap.contains(addr);
+    if (m == addrMap.end() || m->second->isNull())
+        return nullptr;
+    return m->second->toHostAddr(addr);
+}
+
 AddrRangeList
 PhysicalMemory::getConfAddrRanges() const
 {
@@ -314,8 +629,7 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
     std::vector<ContextID> lal_cid;
 
     for (auto& m : memories) {
-        const std::list<LockedAddr>& locked_addrs = m->getLockedAddrList();
-        for (const auto& l : locked_addrs) {
+        for (const auto& l : m->getLockedAddrList()) {
             lal_addr.push_back(l.addr);
             lal_cid.push_back(l.contextId);
         }
@@ -332,7 +646,10 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
     // store each backing store memory segment in a file
     for (auto& s : backingStore) {
         ScopedCheckpointSection sec(cp, csprintf("store%d", store_id));
-        serializeStore(cp, store_id++, s.range, s.pmem);
+        if (checkpointShardSize)
+            serializeStoreShards(cp, store_id++, s.range, s.pmem);
+        else
+            serializeStore(cp, store_id++, s.range, s.pmem);
     }
 }
 
@@ -383,6 +700,83 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 
 }
 
+void
+PhysicalMemory::serializeStoreShards(CheckpointOut &cp, unsigned int store_id,
+                                     AddrRange range, uint8_t* pmem) const
+{
+    long range_size = range.size();
+    uint64_t shard_size = checkpointShardSize;
+    const size_t num_shards = divCeil(range.size(), shard_size);
+
+    std::vector<std::string> shard_files;
+    for (size_t i = 0; i < num_shards; ++i) {
+        shard_files.push_back(csprintf("%s.store%d.shard%d.pmem",
+                                       name(), store_id, i));
+    }
+
+    DPRINTF(Checkpoint, "Serializing physical memory store %d with size %d "
+            "in %d shards\n", store_id, range_size, num_shards);
+
+    const std::string dir = CheckpointIn::dir() + "/";
+    if (!checkpointDifferential) {
+        forEachShard(num_shards, checkpointThreads, [&](size_t i) {
+                const uint64_t offset = i * shard_size;
+                return writeShard(dir + shard_files[i], pmem + offset,
+                                  std::min(shard_size, range.size() - offset));
+            });
+    } else {
+        // Shards that haven't changed since the last checkpoint refer
+        // to the file they were written to or restored from, which
+        // may be in an older checkpoint still
+        const std::string abs_dir = absolutePath(CheckpointIn::dir());
+        fatal_if(abs_dir.empty(), "Can't resolve checkpoint directory %s\n",
+                 CheckpointIn::dir());
+
+        if (lastShards.size() <= store_id)
+            lastShards.resize(store_id + 1);
+        std::vector<ShardRecord> &last = lastShards[store_id];
+        std::vector<ShardRecord> shards(num_shards);
+        std::vector<bool> reused(num_shards, false);
+
+        forEachShard(num_shards, checkpointThreads, [&](size_t i) {
+                const uint64_t offset = i * shard_size;
+                const uint64_t size =
+                    std::min(shard_size, range.size() - offset);
+                shards[i].hash = hashShard(pmem + offset, size);
+
+                if (last.size() == num_shards &&
+                    last[i].hash == shards[i].hash &&
+                    access(last[i].path.c_str(), R_OK) == 0) {
+                    shards[i].path = last[i].path;
+                    reused[i] = true;
+                    return std::string();
+                }
+
+                shards[i].path = abs_dir + "/" + shard_files[i];
+                return writeShard(shards[i].path, pmem + offset, size);
+            });
+
+        size_t num_reused = 0;
+        for (size_t i = 0; i < num_shards; ++i) {
+            if (reused[i]) {
+                shard_files[i] = relativePath(abs_dir, shards[i].path);
+                ++num_reused;
+            }
+        }
+
+        DPRINTF(Checkpoint, "Physical memory store %d reuses %d of %d "
+                "shards from earlier checkpoints\n", store_id, num_reused,
+                num_shards);
+
+        last = std::move(shards);
+    }
+
+    SERIALIZE_SCALAR(store_id);
+    SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(shard_size);
+    SERIALIZE_CONTAINER(shard_files);
+}
+
 void
 PhysicalMemory::unserialize(CheckpointIn &cp)
 {
@@ -411,11 +805,150 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
 void
 PhysicalMemory::unserializeStore(CheckpointIn &cp)
 {
-    const uint32_t chunk_size = 16384;
-
     unsigned int store_id;
     UNSERIALIZE_SCALAR(store_id);
 
+    // With an image cache, the restored contents of each backing store
+    // are kept as a plain file that is mapped copy-on-write, so only
+    // the first of the simulations restoring a checkpoint decompresses
+    // it and all of them share the pages they don't write
+    std::string cache_path;
+    time_t cpt_mtime = 0;
+    if (!restoreImageCache.empty()) {
+        struct stat cpt_stat;
+        const std::string cpt_file =
+            cp.getCptDir() + "/" + CheckpointIn::baseFilename;
+        if (stat(cpt_file.c_str(), &cpt_stat) == 0)
+            cpt_mtime = cpt_stat.st_mtime;
+
+        cache_path = cachedImagePath(cp, store_id);
+        if (mapCachedImage(cache_path, cpt_mtime, store_id))
+            return;
+    }
+
+    uint64_t shard_size = 0;
+    UNSERIALIZE_OPT_SCALAR(shard_size);
+    if (shard_size)
+        unserializeStoreShards(cp, store_id, shard_size);
+    else
+        unserializeStoreImage(cp, store_id);
+
+    if (!cache_path.empty() && writeCachedImage(cache_path, store_id) &&
+        !mapCachedImage(cache_path, cpt_mtime, store_id)) {
+        warn("Could not map the memory image %s just written\n",
+             cache_path);
+    }
+}
+
+std::string
+PhysicalMemory::cachedImagePath(CheckpointIn &cp,
+                                unsigned int store_id) const
+{
+    // The images of different checkpoints can share the cache, they
+    // are told apart by the checkpoint directory
+    std::string cpt_dir = cp.getCptDir();
+    char *real_dir = realpath(cpt_dir.c_str(), nullptr);
+    if (real_dir) {
+        cpt_dir = real_dir;
+        free(real_dir);
+    }
+
+    return csprintf("%s/%016x.%s.store%d.img", restoreImageCache,
+                    std::hash<std::string>()(cpt_dir), name(), store_id);
+}
+
+bool
+PhysicalMemory::writeCachedImage(const std::string &path,
+                                 unsigned int store_id) const
+{
+    const uint8_t *pmem = backingStore[store_id].pmem;
+    const uint64_t range_size = backingStore[store_id].range.size();
+
+    // Write to a private file first, and move it in place once it is
+    // complete, so that concurrent restores never see a partial image
+    const std::string tmp_path = csprintf("%s.%d.tmp", path, getpid());
+    int fd = open(tmp_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd == -1) {
+        warn("Could not create memory image %s: %s\n", tmp_path,
+             std::strerror(errno));
+        return false;
+    }
+
+    bool ok = ftruncate(fd, range_size) == 0;
+    static const uint8_t zero_page[shardPageSize] = {};
+    for (uint64_t offset = 0; ok && offset < range_size;
+         offset += shardPageSize) {
+        const uint64_t len = std::min(shardPageSize, range_size - offset);
+        if (std::memcmp(pmem + offset, zero_page, len) == 0)
+            continue;
+
+        uint64_t done = 0;
+        while (ok && done < len) {
+            const ssize_t ret = pwrite(fd, pmem + offset + done,
+                                       len - done, offset + done);
+            ok = ret > 0;
+            done += ok ? ret : 0;
+        }
+    }
+
+    ok = close(fd) == 0 && ok;
+    if (!ok || rename(tmp_path.c_str(), path.c_str())) {
+        warn("Could not write memory image %s: %s\n", path,
+             std::strerror(errno));
+        unlink(tmp_path.c_str());
+        return false;
+    }
+
+    DPRINTF(Checkpoint, "Wrote memory image %s with size %d\n", path,
+            range_size);
+    return true;
+}
+
+bool
+PhysicalMemory::mapCachedImage(const std::string &path, time_t min_mtime,
+                               unsigned int store_id)
+{
+    uint8_t *pmem = backingStore[store_id].pmem;
+    const uint64_t range_size = backingStore[store_id].range.size();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+
+    struct stat img_stat;
+    if (fstat(fd, &img_stat) || (uint64_t)img_stat.st_size != range_size ||
+        img_stat.st_mtime < min_mtime) {
+        DPRINTF(Checkpoint, "Ignoring stale memory image %s\n", path);
+        close(fd);
+        return false;
+    }
+
+    // Replace the anonymous backing store in place, the memories keep
+    // pointing at the same host addresses
+    int map_flags = MAP_PRIVATE | MAP_FIXED;
+    if (mmapUsingNoReserve)
+        map_flags |= MAP_NORESERVE;
+
+    void *addr = mmap(pmem, range_size, PROT_READ | PROT_WRITE, map_flags,
+                      fd, 0);
+    close(fd);
+    if (addr != pmem) {
+        // a failed fixed mapping may have removed the backing store
+        perror("mmap");
+        fatal("Could not map memory image %s for range %s\n", path,
+              backingStore[store_id].range.to_string());
+    }
+
+    DPRINTF(Checkpoint, "Mapped memory image %s with size %d\n", path,
+            range_size);
+    return true;
+}
+
+void
+PhysicalMemory::unserializeStoreImage(CheckpointIn &cp, unsigned int store_id)
+{
+    const uint32_t chunk_size = 16384;
+
     std::string filename;
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
@@ -467,3 +1000,51 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Close failed on physical memory checkpoint file '%s'\n",
               filename);
 }
+
+void
+PhysicalMemory::unserializeStoreShards(CheckpointIn &cp, unsigned int store_id,
+                                       uint64_t shard_size)
+{
+    uint8_t* pmem = backingStore[store_id].pmem;
+    AddrRange range = backingStore[store_id].range;
+
+    long range_size;
+    UNSERIALIZE_SCALAR(range_size);
+
+    std::vector<std::string> shard_files;
+    UNSERIALIZE_CONTAINER(shard_files);
+
+    DPRINTF(Checkpoint, "Unserializing physical memory store %d with size "
+            "%d from %d shards\n", store_id, range_size, shard_files.size());
+
+    if (range_size != range.size())
+        fatal("Memory range size has changed! Saw %lld, expected %lld\n",
+              range_size, range.size());
+
+    if (shard_files.size() != divCeil(range.size(), shard_size))
+        fatal("Physical memory store %d has %d shards, expected %d\n",
+              store_id, shard_files.size(), divCeil(range.size(), shard_size));
+
+    const std::string dir = cp.getCptDir() + "/";
+    forEachShard(shard_files.size(), checkpointThreads, [&](size_t i) {
+            const uint64_t offset = i * shard_size;
+            return readShard(dir + shard_files[i], pmem + offset,
+                             std::min(shard_size, range.size() - offset));
+        });
+
+    // Differential checkpoints taken from here on refer to the shards
+    // that are restored, if they have the same layout
+    if (checkpointDifferential && shard_size == checkpointShardSize) {
+        if (lastShards.size() <= store_id)
+            lastShards.resize(store_id + 1);
+        std::vector<ShardRecord> &last = lastShards[store_id];
+        last.resize(shard_files.size());
+        forEachShard(shard_files.size(), checkpointThreads, [&](size_t i) {
+                const uint64_t offset = i * shard_size;
+                last[i].path = absolutePath(dir + shard_files[i]);
+                last[i].hash = hashShard(pmem + offset,
+                    std::min(shard_size, range.size() - offset));
+                return std::string();
+            });
+    }
+}
@@ -39,11 +39,13 @@
 #define __MEM_PHYSICAL_HH__
 
 #include <cstdint>
+#include <ctime>
 #include <string>
 #include <vector>
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "enums/BackstoreHugePages.hh"
 #include "mem/packet.hh"
 #include "sim/serialize.hh"
 
@@ -135,6 +137,42 @@ class PhysicalMemory : public Serializable
 
     const std::string sharedBackstore;
 
+    // Host huge pages used for the backing store
+    const BackstoreHugePages hugePages;
+
+    // Directory of the uncompressed memory images that are mapped
+    // copy-on-write when restoring, empty to restore into anonymous
+    // memory
+    const std::string restoreImageCache;
+
+    // Size of the checkpoint image shards, 0 to write every backing
+    // store as a single image
+    const uint64_t checkpointShardSize;
+
+    // Number of threads compressing and decompressing shards, 0 to
+    // use one per host core
+    const unsigned checkpointThreads;
+
+    // Only write the shards that changed since the last checkpoint
+    const bool checkpointDifferential;
+
+    /**
+     * A shard of a backing store in the last checkpoint written or
+     * restored.
+     */
+    struct ShardRecord
+    {
+        // Absolute path of the file holding the shard
+        std::string path;
+        // Hash of the contents of the shard
+        uint64_t hash;
+    };
+
+    // Shards of each backing store in the last checkpoint, used by
+    // differential checkpoints to refer to the files of the shards
+    // that haven't changed since
+    mutable std::vector<std::vector<ShardRecord>> lastShards;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
@@ -167,7 +205,12 @@ class PhysicalMemory : public Serializable
     PhysicalMemory(const std::string& _name,
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
-                   const std::string& shared_backstore);
+                   const std::string& shared_backstore,
+                   uint64_t checkpoint_shard_size=0,
+                   unsigned checkpoint_threads=0,
+                   BackstoreHugePages huge_pages=BackstoreHugePages::none,
+                   const std::string& restore_image_cache="",
+                   bool checkpoint_differential=false);
 
     /**
      * Unmap all the backing store we have used.
@@ -189,6 +232,16 @@ class PhysicalMemory : public Serializable
      */
     bool isMemAddr(Addr addr) const;
 
+    /**
+     * Get the location of an address in the backing store, for models
+     * that access memory directly.
+     *
+     * @param addr A physical address
+     * @return Pointer to the host memory of the address, or nullptr if it
+     *         doesn't correspond to a memory that has a backing store
+     */
+    uint8_t *toHostAddr(Addr addr) const;
+
     /**
      * Get the memory ranges for all memories that are to be reported
      * to the configuration table. The ranges are merged before they
@@ -260,6 +313,22 @@ class PhysicalMemory : public Serializable
     void serializeStore(CheckpointOut &cp, unsigned int store_id,
                         AddrRange range, uint8_t* pmem) const;
 
+    /**
+     * Serialize a specific store as a set of shards that are
+     * compressed in parallel. Shards only contain the pages that
+     * aren't all zero, as recorded by a page map at their start.
+     *
+     * Differential checkpoints don't write the shards whose contents
+     * are the same as in the last checkpoint written or restored,
+     * they refer to the existing shard files instead.
+     *
+     * @param store_id Unique identifier of this backing store
+     * @param range The address range of this backing store
+     * @param pmem The host pointer to this backing store
+     */
+    void serializeStoreShards(CheckpointOut &cp, unsigned int store_id,
+                              AddrRange range, uint8_t* pmem) const;
+
     /**
      * Unserialize the memories in the system. As with the
      * serialization, this action is independent of how the address
@@ -272,6 +341,46 @@ class PhysicalMemory : public Serializable
      */
     void unserializeStore(CheckpointIn &cp);
 
+    /**
+     * Unserialize a sharded backing store, decompressing the shards
+     * in parallel.
+     */
+    void unserializeStoreShards(CheckpointIn &cp, unsigned int store_id,
+                                uint64_t shard_size);
+
+    /**
+     * Unserialize a backing store written as a single image.
+     */
+    void unserializeStoreImage(CheckpointIn &cp, unsigned int store_id);
+
+    /**
+     * Path of the cached uncompressed image of a backing store of the
+     * checkpoint being restored.
+     */
+    std::string cachedImagePath(CheckpointIn &cp,
+                                unsigned int store_id) const;
+
+    /**
+     * Write the contents of a backing store to the image cache. Pages
+     * that are all zero are left as holes in the image.
+     *
+     * @return whether the image was written
+     */
+    bool writeCachedImage(const std::string &path,
+                          unsigned int store_id) const;
+
+    /**
+     * Map a cached image copy-on-write in place of a backing store,
+     * the image is only used if it is newer than the checkpoint.
+     *
+     * @param path Path of the image
+     * @param min_mtime Modification time of the checkpoint
+     * @param store_id The backing store to replace
+     * @return whether the image was mapped
+     */
+    bool mapCachedImage(const std::string &path, time_t min_mtime,
+                        unsigned int store_id);
+
 };
 
 #endif //__MEM_PHYSICAL_HH__
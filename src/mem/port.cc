@@ -98,6 +98,11 @@ class DefaultResponsePort : public ResponsePort
 
     // Functional protocol.
     void recvFunctional(PacketPtr) override { blowUp(); }
+    void
+    recvMemBackdoorReq(const AddrRange &, MemBackdoorPtr &) override
+    {
+        blowUp();
+    }
 
     // General.
     AddrRangeList getAddrRanges() const override { return AddrRangeList(); }
@@ -153,7 +158,7 @@ RequestPort::getAddrRanges() const
 void
 RequestPort::printAddr(Addr a)
 {
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         a, 1, 0, Request::funcRequestorId);
 
     Packet pkt(req, MemCmd::PrintReq);
@@ -199,3 +204,11 @@ ResponsePort::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor)
     }
     return recvAtomic(pkt);
 }
+
+void
+ResponsePort::recvMemBackdoorReq(const AddrRange &range,
+                                 MemBackdoorPtr &backdoor)
+{
+    // Not providing a back door is always safe, the requester will
+    // keep using functional packets.
+}
@@ -109,6 +109,18 @@ class RequestPort: public Port, public AtomicRequestProtocol,
      */
     virtual bool isSnooping() const { return false; }
 
+    /**
+     * Determine if data snooped by this request port may be held in a
+     * copy on its side, e.g. in a cache. Functional back doors are
+     * never provided past such ports. The default implementation
+     * assumes any snooper may hold data, request ports that only snoop
+     * to observe accesses (e.g. to track load locked addresses) can
+     * override this to return false.
+     *
+     * @return true if the port may hold copies of snooped data
+     */
+    virtual bool mayCacheData() const { return isSnooping(); }
+
     /**
      * Get the address ranges of the connected responder port.
      */
@@ -158,6 +170,18 @@ class RequestPort: public Port, public AtomicRequestProtocol,
      */
     void sendFunctional(PacketPtr pkt) const;
 
+    /**
+     * Request a back door for functional accesses to the given range.
+     * The back door should be used in place of functional packets
+     * until it is invalidated.
+     *
+     * @param range Address range the back door should cover.
+     * @param backdoor Set to a back door pointer by the target if it
+     *        can provide one, left unchanged otherwise.
+     */
+    void sendMemBackdoorReq(const AddrRange &range,
+                            MemBackdoorPtr &backdoor) const;
+
   public:
     /* The timing protocol. */
 
@@ -287,6 +311,13 @@ class ResponsePort : public Port, public AtomicResponseProtocol,
      */
     bool isSnooping() const { return _requestPort->isSnooping(); }
 
+    /**
+     * Find out if the peer request port may hold copies of data.
+     *
+     * @return true if the peer request port may hold copies of data
+     */
+    bool mayCacheData() const { return _requestPort->mayCacheData(); }
+
     /**
      * Called by the owner to send a range change
      */
@@ -435,6 +466,8 @@ class ResponsePort : public Port, public AtomicResponseProtocol,
      * Default implementations.
      */
     Tick recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor) override;
+    void recvMemBackdoorReq(const AddrRange &range,
+                            MemBackdoorPtr &backdoor) override;
 
     bool
     tryTiming(PacketPtr pkt) override
@@ -488,6 +521,18 @@ RequestPort::sendFunctional(PacketPtr pkt) const
     }
 }
 
+inline void
+RequestPort::sendMemBackdoorReq(const AddrRange &range,
+                                MemBackdoorPtr &backdoor) const
+{
+    try {
+        return FunctionalRequestProtocol::sendMemBackdoorReq(
+                _responsePort, range, backdoor);
+    } catch (UnboundPortException) {
+        reportUnbound();
+    }
+}
+
 inline bool
 RequestPort::sendTimingReq(PacketPtr pkt)
 {
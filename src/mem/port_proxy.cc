@@ -37,16 +37,92 @@
 
 #include "mem/port_proxy.hh"
 
+#include <algorithm>
+#include <cstring>
+
 #include "base/chunk_generator.hh"
 
+MemBackdoorPtr
+PortProxy::findBackdoor(Addr addr, int size, bool write) const
+{
+    if (!sendBackdoorReq || size <= 0)
+        return nullptr;
+
+    BackdoorCache &cache = *backdoorCache;
+    const AddrRange range(addr, addr + size);
+
+    MemBackdoorPtr found = nullptr;
+    for (auto *bd : cache.backdoors) {
+        if (range.isSubset(bd->range())) {
+            found = bd;
+            break;
+        }
+    }
+
+    if (!found) {
+        // Don't keep asking if nobody is willing to provide back doors,
+        // e.g. because the system isn't in atomic mode.
+        if (cache.retryCountdown) {
+            cache.retryCountdown--;
+            return nullptr;
+        }
+
+        // Only ask for the first line of the access, functional packets
+        // never straddle lines either, so there's no risk of the
+        // request spanning multiple targets.
+        ChunkGenerator gen(addr, size, _cacheLineSize);
+        sendBackdoorReq(AddrRange(gen.addr(), gen.addr() + gen.size()),
+                        found);
+        if (!found) {
+            cache.retryCountdown = BackdoorRetryInterval;
+            return nullptr;
+        }
+
+        if (std::find(cache.backdoors.begin(), cache.backdoors.end(),
+                      found) == cache.backdoors.end()) {
+            cache.backdoors.push_back(found);
+            std::weak_ptr<BackdoorCache> weak_cache = backdoorCache;
+            found->addInvalidationCallback(
+                [weak_cache](const MemBackdoor &backdoor) {
+                    auto cache = weak_cache.lock();
+                    if (!cache)
+                        return;
+                    auto &bds = cache->backdoors;
+                    bds.erase(std::remove(bds.begin(), bds.end(),
+                                          &backdoor), bds.end());
+                });
+        }
+
+        if (!range.isSubset(found->range()))
+            return nullptr;
+    }
+
+    if (write ? !found->writeable() : !found->readable())
+        return nullptr;
+
+    return found;
+}
+
+uint8_t *
+PortProxy::hostPtrPhys(Addr addr, int size, bool write) const
+{
+    auto *bd = findBackdoor(addr, size, write);
+    return bd ? bd->ptr() + (addr - bd->range().start()) : nullptr;
+}
+
 void
 PortProxy::readBlobPhys(Addr addr, Request::Flags flags,
                         void *p, int size) const
 {
+    if (auto *bd = findBackdoor(addr, size, false)) {
+        std::memcpy(p, bd->ptr() + (addr - bd->range().start()), size);
+        return;
+    }
+
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
             gen.addr(), gen.size(), flags, Request::funcRequestorId);
 
         Packet pkt(req, MemCmd::ReadReq);
@@ -60,10 +136,15 @@ void
 PortProxy::writeBlobPhys(Addr addr, Request::Flags flags,
                          const void *p, int size) const
 {
+    if (auto *bd = findBackdoor(addr, size, true)) {
+        std::memcpy(bd->ptr() + (addr - bd->range().start()), p, size);
+        return;
+    }
+
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
             gen.addr(), gen.size(), flags, Request::funcRequestorId);
 
         Packet pkt(req, MemCmd::WriteReq);
@@ -59,6 +59,8 @@
 
 #include <functional>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include "mem/port.hh"
 #include "sim/byteswap.hh"
@@ -74,6 +76,10 @@
  *
  * The addresses are interpreted as physical addresses.
  *
+ * If the proxy can request back doors, accesses completely covered by a
+ * back door are done by copying data directly rather than sending
+ * functional packets. Back doors are kept until they are invalidated.
+ *
  * @sa SETranslatingProxy
  * @sa FSTranslatingProxy
  */
@@ -81,9 +87,40 @@ class PortProxy : FunctionalRequestProtocol
 {
   public:
     typedef std::function<void(PacketPtr pkt)> SendFunctionalFunc;
+    typedef std::function<void(const AddrRange &range,
+                               MemBackdoorPtr &backdoor)>
+        SendMemBackdoorReqFunc;
 
   private:
     SendFunctionalFunc sendFunctional;
+    SendMemBackdoorReqFunc sendBackdoorReq;
+
+    /**
+     * The back doors known to this proxy. They are shared with the
+     * invalidation callbacks, which may be called after the proxy has
+     * been destroyed.
+     */
+    struct BackdoorCache
+    {
+        std::vector<MemBackdoorPtr> backdoors;
+        /** Number of accesses left before asking for a back door again. */
+        unsigned retryCountdown = 0;
+    };
+    std::shared_ptr<BackdoorCache> backdoorCache;
+
+    /**
+     * Number of accesses done with functional packets before asking
+     * for a back door again after a request failed.
+     */
+    static const unsigned BackdoorRetryInterval = 64;
+
+    /**
+     * Find a back door covering a whole access.
+     *
+     * @return A back door allowing the access, or nullptr if functional
+     *         packets have to be used.
+     */
+    MemBackdoorPtr findBackdoor(Addr addr, int size, bool write) const;
 
     /** Granularity of any transactions issued through this proxy. */
     const unsigned int _cacheLineSize;
@@ -100,10 +137,20 @@ class PortProxy : FunctionalRequestProtocol
     PortProxy(SendFunctionalFunc func, unsigned int cacheLineSize) :
         sendFunctional(func), _cacheLineSize(cacheLineSize)
     {}
+    PortProxy(SendFunctionalFunc func, SendMemBackdoorReqFunc backdoor_func,
+              unsigned int cacheLineSize) :
+        sendFunctional(func), sendBackdoorReq(backdoor_func),
+        backdoorCache(new BackdoorCache), _cacheLineSize(cacheLineSize)
+    {}
     PortProxy(const RequestPort &port, unsigned int cacheLineSize) :
         sendFunctional([&port](PacketPtr pkt)->void {
                 port.sendFunctional(pkt);
-            }), _cacheLineSize(cacheLineSize)
+            }),
+        sendBackdoorReq([&port](const AddrRange &range,
+                                MemBackdoorPtr &backdoor)->void {
+                port.sendMemBackdoorReq(range, backdoor);
+            }),
+        backdoorCache(new BackdoorCache), _cacheLineSize(cacheLineSize)
     {}
     virtual ~PortProxy() { }
 
@@ -129,6 +176,15 @@ class PortProxy : FunctionalRequestProtocol
     void memsetBlobPhys(Addr addr, Request::Flags flags,
                         uint8_t v, int size) const;
 
+    /**
+     * Get a host pointer to size bytes of memory at physical address
+     * addr, if they are all covered by a back door allowing the access.
+     *
+     * @return A pointer to the data, or nullptr if the memory has to be
+     *         accessed through the blob accessors.
+     */
+    uint8_t *hostPtrPhys(Addr addr, int size, bool write) const;
+
 
 
     /** Methods to override in base classes */
@@ -45,3 +45,6 @@ class BaseMemProbe(SimObject):
     manager = VectorParam.SimObject(Parent.any,
                                     "Probe manager(s) to instrument")
     probe_name = Param.String("PktRequest", "Memory request probe to use")
+    batch_size = Param.Unsigned(0, "Number of intercepted requests to "
+        "buffer before analysing them as a batch (0 analyses each request "
+        "as it is observed)")
@@ -39,9 +39,17 @@ from m5.proxy import *
 
 from m5.objects.BaseMemProbe import BaseMemProbe
 
+# Unique addresses are either tracked exactly in a bitmap that is
+# allocated on demand, or estimated in a fixed size HyperLogLog sketch
+class MemFootprintTracking(ScopedEnum): vals = ['bitmap', 'hyperloglog']
+
 class MemFootprintProbe(BaseMemProbe):
     type = "MemFootprintProbe"
     cxx_header = "mem/probes/mem_footprint.hh"
     system = Param.System(Parent.any,
                           "System pointer to get cache line and mem size")
     page_size = Param.Unsigned(4096, "Page size for page-level footprint")
+    tracking = Param.MemFootprintTracking('bitmap',
+        "How unique cache lines and pages are tracked")
+    hll_precision = Param.Unsigned(14, "log2 of the number of HyperLogLog "
+        "registers, the standard error is 1.04 / sqrt(2^hll_precision)")
@@ -37,6 +37,10 @@ from m5.params import *
 from m5.proxy import *
 from m5.objects.BaseMemProbe import BaseMemProbe
 
+# Traces are either a stream of packet.proto messages, or use the
+# block based format of proto/packet_trace.hh that is faster to replay
+class MemTraceFormat(ScopedEnum): vals = ['protobuf', 'block']
+
 class MemTraceProbe(BaseMemProbe):
     type = 'MemTraceProbe'
     cxx_header = "mem/probes/mem_trace.hh"
@@ -50,5 +54,7 @@ class MemTraceProbe(BaseMemProbe):
     # packet trace output file, disabled by default
     trace_file = Param.String("", "Packet trace output file")
 
+    trace_format = Param.MemTraceFormat('protobuf', "Packet trace format")
+
     # System object to look up the name associated with a requestor ID
     system = Param.System(Parent.any, "System the probe belongs to")
@@ -52,6 +52,12 @@ class StackDistProbe(BaseMemProbe):
     # enable verification stack
     verify = Param.Bool(False, "Verify behaviuor with reference implementation")
 
+    # Only track a fraction of the cache lines, chosen by hashing their
+    # address, and scale the stack distances accordingly. This trades
+    # accuracy for speed and memory on large footprints. Note that the
+    # histograms only count the accesses to the sampled lines.
+    sample_rate = Param.Float(1.0, "Fraction of the cache lines to track")
+
     # linear histogram bins and enable/disable
     linear_hist_bins = Param.Unsigned('16', "Bins in linear histograms")
     disable_linear_hists = Param.Bool(False, "Disable linear histograms")
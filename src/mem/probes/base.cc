@@ -40,8 +40,9 @@
 #include "params/BaseMemProbe.hh"
 
 BaseMemProbe::BaseMemProbe(const BaseMemProbeParams &p)
-    : SimObject(p)
+    : SimObject(p), batchSize(p.batch_size)
 {
+    pending.reserve(batchSize);
 }
 
 void
@@ -56,3 +57,41 @@ BaseMemProbe::regProbeListeners()
         listeners[i].reset(new PacketListener(*this, mgr, p.probe_name));
     }
 }
+
+void
+BaseMemProbe::handleRequests(const BufferedRequest *reqs, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        handleRequest(reqs[i].pktInfo);
+}
+
+void
+BaseMemProbe::flushRequests()
+{
+    if (pending.empty())
+        return;
+
+    handleRequests(pending.data(), pending.size());
+    pending.clear();
+}
+
+DrainState
+BaseMemProbe::drain()
+{
+    flushRequests();
+    return DrainState::Drained;
+}
+
+void
+BaseMemProbe::preDumpStats()
+{
+    flushRequests();
+    SimObject::preDumpStats();
+}
+
+void
+BaseMemProbe::resetStats()
+{
+    flushRequests();
+    SimObject::resetStats();
+}
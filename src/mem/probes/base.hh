@@ -41,6 +41,7 @@
 #include <memory>
 #include <vector>
 
+#include "sim/cur_tick.hh"
 #include "sim/probe/mem.hh"
 #include "sim/sim_object.hh"
 
@@ -65,12 +66,40 @@ class BaseMemProbe : public SimObject
 
     void regProbeListeners() override;
 
+    DrainState drain() override;
+    void preDumpStats() override;
+    void resetStats() override;
+
   protected:
+    /** An intercepted Packet buffered together with its arrival tick. */
+    struct BufferedRequest
+    {
+        Tick when;
+        ProbePoints::PacketInfo pktInfo;
+    };
+
     /**
      * Callback to analyse intercepted Packets.
      */
     virtual void handleRequest(const ProbePoints::PacketInfo &pkt_info) = 0;
 
+    /**
+     * Callback to analyse a batch of intercepted Packets in the order
+     * they were observed. Only used when batching is enabled; the
+     * default implementation hands each Packet to handleRequest().
+     */
+    virtual void handleRequests(const BufferedRequest *reqs, size_t count);
+
+    /**
+     * Deliver any buffered Packets to handleRequests(). This is done
+     * automatically when the buffer fills up, before stats are dumped
+     * or reset, and when draining.
+     */
+    void flushRequests();
+
+    /** Number of Packets to buffer before delivery, 0 to disable */
+    const unsigned batchSize;
+
   private:
     class PacketListener : public ProbeListenerArgBase<ProbePoints::PacketInfo>
     {
@@ -81,7 +110,14 @@ class BaseMemProbe : public SimObject
               parent(_parent) {}
 
         void notify(const ProbePoints::PacketInfo &pkt_info) override {
-            parent.handleRequest(pkt_info);
+            if (!parent.batchSize) {
+                parent.handleRequest(pkt_info);
+                return;
+            }
+
+            parent.pending.push_back({curTick(), pkt_info});
+            if (parent.pending.size() >= parent.batchSize)
+                parent.flushRequests();
         }
 
       protected:
@@ -89,6 +125,9 @@ class BaseMemProbe : public SimObject
     };
 
     std::vector<std::unique_ptr<PacketListener>> listeners;
+
+    /** Packets waiting to be delivered in batch mode */
+    std::vector<BufferedRequest> pending;
 };
 
 #endif //  __MEM_PROBES_BASE_HH__
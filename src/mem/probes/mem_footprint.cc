@@ -38,19 +38,47 @@
 
 #include "mem/probes/mem_footprint.hh"
 
+#include <algorithm>
+#include <cmath>
+
 #include "base/intmath.hh"
 #include "params/MemFootprintProbe.hh"
 
+class MemFootprintProbe::BitmapTracker : public AddrTracker
+{
+  public:
+    void insert(Addr idx) override { bitmap.insert(idx); }
+    uint64_t count() const override { return bitmap.count(); }
+    void clear() override { bitmap.clear(); }
+
+  private:
+    PagedBitmap bitmap;
+};
+
+class MemFootprintProbe::HyperLogLogTracker : public AddrTracker
+{
+  public:
+    HyperLogLogTracker(unsigned precision) : hll(precision) {}
+
+    void insert(Addr idx) override { hll.insert(idx); }
+    uint64_t count() const override { return std::llround(hll.estimate()); }
+    void clear() override { hll.clear(); }
+
+  private:
+    HyperLogLog hll;
+};
+
 MemFootprintProbe::MemFootprintProbe(const MemFootprintProbeParams &p)
     : BaseMemProbe(p),
       cacheLineSizeLg2(floorLog2(p.system->cacheLineSize())),
       pageSizeLg2(floorLog2(p.page_size)),
       totalCacheLinesInMem(p.system->memSize() / p.system->cacheLineSize()),
       totalPagesInMem(p.system->memSize() / p.page_size),
-      cacheLines(),
-      cacheLinesAll(),
-      pages(),
-      pagesAll(),
+      tracking(p.tracking),
+      cacheLines(makeTracker(p)),
+      cacheLinesAll(makeTracker(p)),
+      pages(makeTracker(p)),
+      pagesAll(makeTracker(p)),
       system(p.system),
       stats(this)
 {
@@ -83,11 +111,18 @@ MemFootprintProbeStats::MemFootprintProbeStats(MemFootprintProbe *parent)
     registerResetCallback([parent]() { parent->statReset(); });
 }
 
-void
-MemFootprintProbe::insertAddr(Addr addr, AddrSet *set, uint64_t limit)
+std::unique_ptr<MemFootprintProbe::AddrTracker>
+MemFootprintProbe::makeTracker(const MemFootprintProbeParams &p) const
 {
-    set->insert(addr);
-    assert(set->size() <= limit);
+    switch (p.tracking) {
+      case MemFootprintTracking::bitmap:
+        return std::unique_ptr<AddrTracker>(new BitmapTracker());
+      case MemFootprintTracking::hyperloglog:
+        return std::unique_ptr<AddrTracker>(
+            new HyperLogLogTracker(p.hll_precision));
+      default:
+        panic("Unknown footprint tracking mode.");
+    }
 }
 
 void
@@ -96,25 +131,38 @@ MemFootprintProbe::handleRequest(const ProbePoints::PacketInfo &pi)
     if (!pi.cmd.isRequest() || !system->isMemAddr(pi.addr))
         return;
 
-    const Addr cl_addr = (pi.addr >> cacheLineSizeLg2) << cacheLineSizeLg2;
-    const Addr page_addr = (pi.addr >> pageSizeLg2) << pageSizeLg2;
-    insertAddr(cl_addr, &cacheLines, totalCacheLinesInMem);
-    insertAddr(cl_addr, &cacheLinesAll, totalCacheLinesInMem);
-    insertAddr(page_addr, &pages, totalPagesInMem);
-    insertAddr(page_addr, &pagesAll, totalPagesInMem);
+    const Addr cl_idx = pi.addr >> cacheLineSizeLg2;
+    const Addr page_idx = pi.addr >> pageSizeLg2;
+    cacheLines->insert(cl_idx);
+    cacheLinesAll->insert(cl_idx);
+    pages->insert(page_idx);
+    pagesAll->insert(page_idx);
+}
+
+void
+MemFootprintProbe::preDumpStats()
+{
+    BaseMemProbe::preDumpStats();
+
+    // Estimates can't exceed the size of the memory
+    const uint64_t cl = std::min(cacheLines->count(), totalCacheLinesInMem);
+    const uint64_t cl_all =
+        std::min(cacheLinesAll->count(), totalCacheLinesInMem);
+    const uint64_t pg = std::min(pages->count(), totalPagesInMem);
+    const uint64_t pg_all = std::min(pagesAll->count(), totalPagesInMem);
 
-    assert(cacheLines.size() <= cacheLinesAll.size());
-    assert(pages.size() <= pagesAll.size());
+    assert(cl <= cl_all || tracking == MemFootprintTracking::hyperloglog);
+    assert(pg <= pg_all || tracking == MemFootprintTracking::hyperloglog);
 
-    stats.cacheLine = cacheLines.size() << cacheLineSizeLg2;
-    stats.cacheLineTotal = cacheLinesAll.size() << cacheLineSizeLg2;
-    stats.page = pages.size() << pageSizeLg2;
-    stats.pageTotal = pagesAll.size() << pageSizeLg2;
+    stats.cacheLine = cl << cacheLineSizeLg2;
+    stats.cacheLineTotal = cl_all << cacheLineSizeLg2;
+    stats.page = pg << pageSizeLg2;
+    stats.pageTotal = pg_all << pageSizeLg2;
 }
 
 void
 MemFootprintProbe::statReset()
 {
-    cacheLines.clear();
-    pages.clear();
+    cacheLines->clear();
+    pages->clear();
 }
@@ -39,9 +39,12 @@
 #ifndef __MEM_PROBES_MEM_FOOTPRINT_HH__
 #define __MEM_PROBES_MEM_FOOTPRINT_HH__
 
-#include <unordered_set>
+#include <memory>
 
 #include "base/callback.hh"
+#include "base/hyperloglog.hh"
+#include "base/paged_bitmap.hh"
+#include "enums/MemFootprintTracking.hh"
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
 #include "sim/stats.hh"
@@ -51,15 +54,17 @@ struct MemFootprintProbeParams;
 
 /// Probe to track footprint of accessed memory
 /// Two granularity of footprint measurement i.e. cache line and page
+/// Unique addresses are either tracked exactly in a paged bitmap, or
+/// approximately in a fixed size HyperLogLog sketch
 class MemFootprintProbe : public BaseMemProbe
 {
   public:
-    typedef std::unordered_set<Addr> AddrSet;
-
     MemFootprintProbe(const MemFootprintProbeParams &p);
     // Fix footprint tracking state on stat reset
     void statReset();
 
+    void preDumpStats() override;
+
   protected:
     /// Cache Line size for footprint measurement (log2)
     const uint8_t cacheLineSizeLg2;
@@ -67,8 +72,25 @@ class MemFootprintProbe : public BaseMemProbe
     const uint8_t pageSizeLg2;
     const uint64_t totalCacheLinesInMem;
     const uint64_t totalPagesInMem;
+    /// How unique addresses are tracked
+    const MemFootprintTracking tracking;
+
+    /// Set of unique cache line or page numbers
+    class AddrTracker
+    {
+      public:
+        virtual ~AddrTracker() {}
+        virtual void insert(Addr idx) = 0;
+        virtual uint64_t count() const = 0;
+        virtual void clear() = 0;
+    };
+
+    class BitmapTracker;
+    class HyperLogLogTracker;
+
+    std::unique_ptr<AddrTracker>
+    makeTracker(const MemFootprintProbeParams &p) const;
 
-    void insertAddr(Addr addr, AddrSet *set, uint64_t limit);
     void handleRequest(const ProbePoints::PacketInfo &pkt_info) override;
 
     struct MemFootprintProbeStats : public Stats::Group
@@ -85,14 +107,14 @@ class MemFootprintProbe : public BaseMemProbe
         Stats::Scalar pageTotal;
     };
 
-    // Addr set to track unique cache lines accessed
-    AddrSet cacheLines;
-    // Addr set to track unique cache lines accessed since simulation begin
-    AddrSet cacheLinesAll;
-    // Addr set to track unique pages accessed
-    AddrSet pages;
-    // Addr set to track unique pages accessed since simulation begin
-    AddrSet pagesAll;
+    // Tracker of unique cache lines accessed
+    std::unique_ptr<AddrTracker> cacheLines;
+    // Tracker of unique cache lines accessed since simulation begin
+    std::unique_ptr<AddrTracker> cacheLinesAll;
+    // Tracker of unique pages accessed
+    std::unique_ptr<AddrTracker> pages;
+    // Tracker of unique pages accessed since simulation begin
+    std::unique_ptr<AddrTracker> pagesAll;
     System *system;
 
     MemFootprintProbeStats stats;
@@ -46,11 +46,17 @@
 MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
     : BaseMemProbe(p),
       traceStream(nullptr),
+      blockStream(nullptr),
       system(p.system),
-      withPC(p.with_pc)
+      withPC(p.with_pc),
+      format(p.trace_format),
+      compress(p.trace_compress)
 {
-    std::string filename;
-    if (p.trace_file != "") {
+    if (format == MemTraceFormat::block) {
+        // Block traces are compressed per block, whatever the name
+        filename = simout.resolve(p.trace_file != "" ? p.trace_file :
+                                  name() + ".ptrc");
+    } else if (p.trace_file != "") {
         // If the trace file is not specified as an absolute path,
         // append the current simulation output directory
         filename = simout.resolve(p.trace_file);
@@ -69,7 +75,10 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
                                   (p.trace_compress ? ".gz" : ""));
     }
 
-    traceStream = new ProtoOutputStream(filename);
+    // The block trace writes the header when it is created, this has to
+    // wait until the requestors are known
+    if (format == MemTraceFormat::protobuf)
+        traceStream = new ProtoOutputStream(filename);
 
     // Register a callback to compensate for the destructor not
     // being called. The callback forces the stream to flush and
@@ -80,6 +89,17 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
 void
 MemTraceProbe::startup()
 {
+    if (format == MemTraceFormat::block) {
+        PacketTraceHeader header;
+        header.objId = name();
+        header.tickFreq = SimClock::Frequency;
+        for (int i = 0; i < system->maxRequestors(); i++)
+            header.idStrings.emplace_back(i, system->getRequestorName(i));
+
+        blockStream = new PacketTraceWriter(filename, header, compress);
+        return;
+    }
+
     // Create a protobuf message for the header and write it to
     // the stream
     ProtoMessage::PacketHeader header_msg;
@@ -98,16 +118,51 @@ MemTraceProbe::startup()
 void
 MemTraceProbe::closeStreams()
 {
+    flushRequests();
+
     if (traceStream != NULL)
         delete traceStream;
+    if (blockStream != NULL)
+        delete blockStream;
 }
 
 void
 MemTraceProbe::handleRequest(const ProbePoints::PacketInfo &pkt_info)
 {
+    writeRecord(curTick(), pkt_info);
+}
+
+void
+MemTraceProbe::handleRequests(const BufferedRequest *reqs, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        writeRecord(reqs[i].when, reqs[i].pktInfo);
+}
+
+void
+MemTraceProbe::writeRecord(Tick when, const ProbePoints::PacketInfo &pkt_info)
+{
+    if (blockStream) {
+        PacketTraceRecord record;
+        record.tick = when;
+        record.cmd = pkt_info.cmd.toInt();
+        record.flags = pkt_info.flags;
+        record.addr = pkt_info.addr;
+        record.size = pkt_info.size;
+        record.pktId = pkt_info.id;
+        record.fields = PacketTraceRecord::HasFlags |
+            PacketTraceRecord::HasPktId;
+        if (withPC && pkt_info.pc != 0) {
+            record.pc = pkt_info.pc;
+            record.fields |= PacketTraceRecord::HasPC;
+        }
+        blockStream->write(record);
+        return;
+    }
+
     ProtoMessage::Packet pkt_msg;
 
-    pkt_msg.set_tick(curTick());
+    pkt_msg.set_tick(when);
     pkt_msg.set_cmd(pkt_info.cmd.toInt());
     pkt_msg.set_flags(pkt_info.flags);
     pkt_msg.set_addr(pkt_info.addr);
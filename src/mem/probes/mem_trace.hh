@@ -38,8 +38,12 @@
 #ifndef __MEM_PROBES_MEM_TRACE_HH__
 #define __MEM_PROBES_MEM_TRACE_HH__
 
+#include <string>
+
+#include "enums/MemTraceFormat.hh"
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
+#include "proto/packet_trace.hh"
 #include "proto/protoio.hh"
 
 struct MemTraceProbeParams;
@@ -52,6 +56,10 @@ class MemTraceProbe : public BaseMemProbe
 
   protected:
     void handleRequest(const ProbePoints::PacketInfo &pkt_info) override;
+    void handleRequests(const BufferedRequest *reqs, size_t count) override;
+
+    /** Write a single trace record for a Packet observed at tick when */
+    void writeRecord(Tick when, const ProbePoints::PacketInfo &pkt_info);
 
     /**
      * Callback to flush and close all open output streams on exit. If
@@ -66,12 +74,21 @@ class MemTraceProbe : public BaseMemProbe
     /** Trace output stream */
     ProtoOutputStream *traceStream;
 
+    /** Trace writer when using the block based format */
+    PacketTraceWriter *blockStream;
+
     System *system;
 
   private:
 
     /** Include the Program Counter in the memory trace */
     const bool withPC;
+
+    const MemTraceFormat format;
+
+    /** Trace file, and whether to compress it */
+    std::string filename;
+    const bool compress;
 };
 
 #endif //__MEM_PROBES_MEM_TRACE_HH__
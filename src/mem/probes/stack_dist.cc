@@ -45,7 +45,7 @@ StackDistProbe::StackDistProbe(const StackDistProbeParams &p)
       lineSize(p.line_size),
       disableLinearHists(p.disable_linear_hists),
       disableLogHists(p.disable_log_hists),
-      calc(p.verify),
+      calc(p.verify, p.sample_rate),
       stats(this)
 {
     fatal_if(p.system->cacheLineSize() > p.line_size,
@@ -99,6 +99,10 @@ StackDistProbe::handleRequest(const ProbePoints::PacketInfo &pkt_info)
     // Align the address to a cache line size
     const Addr aligned_addr(roundDown(pkt_info.addr, lineSize));
 
+    // Only the accesses to sampled lines are tracked
+    if (!calc.isSampled(aligned_addr))
+        return;
+
     // Calculate the stack distance
     const uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
     if (sd == StackDistCalc::Infinity) {
@@ -124,3 +128,12 @@ StackDistProbe::handleRequest(const ProbePoints::PacketInfo &pkt_info)
             stats.writeLogHist.sample(sd_lg2);
     }
 }
+
+void
+StackDistProbe::handleRequests(const BufferedRequest *reqs, size_t count)
+{
+    // Stack distances don't depend on time, so the batch is simply
+    // replayed without going through the virtual per-packet callback
+    for (size_t i = 0; i < count; i++)
+        StackDistProbe::handleRequest(reqs[i].pktInfo);
+}
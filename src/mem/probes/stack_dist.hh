@@ -52,6 +52,7 @@ class StackDistProbe : public BaseMemProbe
 
   protected:
     void handleRequest(const ProbePoints::PacketInfo &pkt_info) override;
+    void handleRequests(const BufferedRequest *reqs, size_t count) override;
 
   protected:
     // Cache line size to simulate
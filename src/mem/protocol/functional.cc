@@ -50,6 +50,14 @@ FunctionalRequestProtocol::send(
     return peer->recvFunctional(pkt);
 }
 
+void
+FunctionalRequestProtocol::sendMemBackdoorReq(
+        FunctionalResponseProtocol *peer, const AddrRange &range,
+        MemBackdoorPtr &backdoor) const
+{
+    return peer->recvMemBackdoorReq(range, backdoor);
+}
+
 /* The response protocol. */
 
 void
@@ -41,6 +41,8 @@
 #ifndef __MEM_GEM5_PROTOCOL_FUNCTIONAL_HH__
 #define __MEM_GEM5_PROTOCOL_FUNCTIONAL_HH__
 
+#include "base/addr_range.hh"
+#include "mem/backdoor.hh"
 #include "mem/packet.hh"
 
 class FunctionalResponseProtocol;
@@ -59,6 +61,17 @@ class FunctionalRequestProtocol
      */
     void send(FunctionalResponseProtocol *peer, PacketPtr pkt) const;
 
+    /**
+     * Request a back door for functional accesses to a range.
+     *
+     * @param range Address range the back door should cover.
+     * @param backdoor Set to a back door pointer by the target if it
+     *        can safely provide one.
+     */
+    void sendMemBackdoorReq(FunctionalResponseProtocol *peer,
+                            const AddrRange &range,
+                            MemBackdoorPtr &backdoor) const;
+
     /**
      * Receive a functional snoop request packet from the peer.
      */
@@ -83,6 +96,17 @@ class FunctionalResponseProtocol
      * Receive a functional request packet from the peer.
      */
     virtual void recvFunctional(PacketPtr pkt) = 0;
+
+    /**
+     * Receive a request for a back door for functional accesses. A
+     * back door must only be provided if accessing the data through
+     * it has the same effect as a functional packet would, i.e. no
+     * component between the requester and the data holds a copy of it
+     * that could differ, and no packets in flight would need to be
+     * updated. Not providing one is always correct.
+     */
+    virtual void recvMemBackdoorReq(const AddrRange &range,
+                                    MemBackdoorPtr &backdoor) = 0;
 };
 
 #endif //__MEM_GEM5_PROTOCOL_FUNCTIONAL_HH__
@@ -84,12 +84,13 @@ MemCtrl::logRequest(BusState dir, RequestorID id, uint8_t qos,
     // If needed, initialize all counters and statistics
     // for this requestor
     addRequestor(id);
+    auto &prios = packetPriorities[id];
 
     DPRINTF(QOS,
             "QoSMemCtrl::logRequest REQUESTOR %s [id %d] address %d"
             " prio %d this requestor q packets %d"
             " - queue size %d - requested entries %d\n",
-            requestors[id], id, addr, qos, packetPriorities[id][qos],
+            requestors[id], id, addr, qos, prios[qos],
             (dir == READ) ? readQueueSizes[qos]: writeQueueSizes[qos],
             entries);
 
@@ -101,19 +102,18 @@ MemCtrl::logRequest(BusState dir, RequestorID id, uint8_t qos,
         totalWriteQueueSize += entries;
     }
 
-    packetPriorities[id][qos] += entries;
-    for (auto j = 0; j < entries; ++j) {
-        requestTimes[id][addr].push_back(curTick());
-    }
+    prios[qos] += entries;
+    auto &times = requestTimes[id][addr];
+    times.insert(times.end(), entries, curTick());
 
     // Record statistics
     stats.avgPriority[id].sample(qos);
 
     // Compute avg priority distance
 
-    for (uint8_t i = 0; i < packetPriorities[id].size(); ++i) {
+    for (uint8_t i = 0; i < prios.size(); ++i) {
         uint8_t distance =
-            (abs(int(qos) - int(i))) * packetPriorities[id][i];
+            (abs(int(qos) - int(i))) * prios[i];
 
         if (distance > 0) {
             stats.avgPriorityDistance[id].sample(distance);
@@ -122,14 +122,14 @@ MemCtrl::logRequest(BusState dir, RequestorID id, uint8_t qos,
                     " registering priority distance %d for priority %d"
                     " (packets %d)\n",
                     requestors[id], id, distance, i,
-                    packetPriorities[id][i]);
+                    prios[i]);
         }
     }
 
     DPRINTF(QOS,
             "QoSMemCtrl::logRequest REQUESTOR %s [id %d] prio %d "
             "this requestor q packets %d - new queue size %d\n",
-            requestors[id], id, qos, packetPriorities[id][qos],
+            requestors[id], id, qos, prios[qos],
             (dir == READ) ? readQueueSizes[qos]: writeQueueSizes[qos]);
 
 }
@@ -140,12 +140,13 @@ MemCtrl::logResponse(BusState dir, RequestorID id, uint8_t qos,
 {
     panic_if(!hasRequestor(id),
         "Logging response with invalid requestor\n");
+    auto &prios = packetPriorities[id];
 
     DPRINTF(QOS,
             "QoSMemCtrl::logResponse REQUESTOR %s [id %d] address %d prio"
             " %d this requestor q packets %d"
             " - queue size %d - requested entries %d\n",
-            requestors[id], id, addr, qos, packetPriorities[id][qos],
+            requestors[id], id, addr, qos, prios[qos],
             (dir == READ) ? readQueueSizes[qos]: writeQueueSizes[qos],
             entries);
 
@@ -157,28 +158,24 @@ MemCtrl::logResponse(BusState dir, RequestorID id, uint8_t qos,
         totalWriteQueueSize -= entries;
     }
 
-    panic_if(packetPriorities[id][qos] == 0,
+    panic_if(prios[qos] == 0,
              "QoSMemCtrl::logResponse requestor %s negative packets "
              "for priority %d", requestors[id], qos);
 
-    packetPriorities[id][qos] -= entries;
+    prios[qos] -= entries;
 
-    for (auto j = 0; j < entries; ++j) {
-        auto it = requestTimes[id].find(addr);
-        panic_if(it == requestTimes[id].end(),
-                 "QoSMemCtrl::logResponse requestor %s unmatched response for"
-                 " address %d received", requestors[id], addr);
+    auto &id_times = requestTimes[id];
+    auto it = id_times.find(addr);
+    panic_if(it == id_times.end() || it->second.size() < entries,
+             "QoSMemCtrl::logResponse requestor %s unmatched response for"
+             " address %d received", requestors[id], addr);
 
+    for (auto j = 0; j < entries; ++j) {
         // Load request time
         uint64_t requestTime = it->second.front();
 
         // Remove request entry
         it->second.pop_front();
-
-        // Remove whole address entry if last one
-        if (it->second.empty()) {
-            requestTimes[id].erase(it);
-        }
         // Compute latency
         double latency = (double) (curTick() + delay - requestTime)
                 / SimClock::Float::s;
@@ -196,10 +193,15 @@ MemCtrl::logResponse(BusState dir, RequestorID id, uint8_t qos,
         }
     }
 
+    // Remove whole address entry if last one
+    if (it->second.empty()) {
+        id_times.erase(it);
+    }
+
     DPRINTF(QOS,
             "QoSMemCtrl::logResponse REQUESTOR %s [id %d] prio %d "
             "this requestor q packets %d - new queue size %d\n",
-            requestors[id], id, qos, packetPriorities[id][qos],
+            requestors[id], id, qos, prios[qos],
             (dir == READ) ? readQueueSizes[qos]: writeQueueSizes[qos]);
 }
 
@@ -355,10 +355,11 @@ void
 MemCtrl::escalateQueues(Queues& queues, uint64_t queue_entry_size,
                         RequestorID id, uint8_t curr_prio, uint8_t tgt_prio)
 {
+    auto &prios = packetPriorities[id];
     auto it = queues[curr_prio].begin();
     while (it != queues[curr_prio].end()) {
         // No packets left to move
-        if (packetPriorities[id][curr_prio] == 0)
+        if (prios[curr_prio] == 0)
             break;
 
         auto pkt = *it;
@@ -382,7 +383,7 @@ MemCtrl::escalateQueues(Queues& queues, uint64_t queue_entry_size,
                     requestors[id], id, pkt->getAddr(),
                     pkt->getSize(),
                     queue_entry_size, curr_prio, tgt_prio,
-                    packetPriorities[id][curr_prio], moved_entries);
+                    prios[curr_prio], moved_entries);
 
 
             if (pkt->isRead()) {
@@ -408,13 +409,13 @@ MemCtrl::escalateQueues(Queues& queues, uint64_t queue_entry_size,
             // Erase element from source packet queue, this will
             // increment the iterator
             it = queues[curr_prio].erase(it);
-            panic_if(packetPriorities[id][curr_prio] < moved_entries,
+            panic_if(prios[curr_prio] < moved_entries,
                      "QoSMemCtrl::escalate requestor %s negative packets "
                      "for priority %d",
                      requestors[id], tgt_prio);
 
-            packetPriorities[id][curr_prio] -= moved_entries;
-            packetPriorities[id][tgt_prio] += moved_entries;
+            prios[curr_prio] -= moved_entries;
+            prios[tgt_prio] += moved_entries;
         } else {
             // Increment iterator to next location in the queue
             it++;
@@ -431,11 +432,12 @@ MemCtrl::escalate(std::initializer_list<Queues*> queues,
     // If needed, initialize all counters and statistics
     // for this requestor
     addRequestor(id);
+    auto &prios = packetPriorities[id];
 
     DPRINTF(QOS,
             "QoSMemCtrl::escalate Requestor %s [id %d] to priority "
             "%d (currently %d packets)\n",requestors[id], id, tgt_prio,
-            packetPriorities[id][tgt_prio]);
+            prios[tgt_prio]);
 
     for (uint8_t curr_prio = 0; curr_prio < numPriorities(); ++curr_prio) {
         // Skip target priority
@@ -443,14 +445,14 @@ MemCtrl::escalate(std::initializer_list<Queues*> queues,
             continue;
 
         // Process other priority packet
-        while (packetPriorities[id][curr_prio] > 0) {
+        while (prios[curr_prio] > 0) {
             DPRINTF(QOS,
                     "QoSMemCtrl::escalate MID %d checking priority %d "
                     "(packets %d)- current packets in prio %d:  %d\n"
                     "\t(source read %d source write %d target read %d, "
                     "target write %d)\n",
-                    id, curr_prio, packetPriorities[id][curr_prio],
-                    tgt_prio, packetPriorities[id][tgt_prio],
+                    id, curr_prio, prios[curr_prio],
+                    tgt_prio, prios[tgt_prio],
                     readQueueSizes[curr_prio],
                     writeQueueSizes[curr_prio], readQueueSizes[tgt_prio],
                     writeQueueSizes[tgt_prio]);
@@ -466,7 +468,7 @@ MemCtrl::escalate(std::initializer_list<Queues*> queues,
     DPRINTF(QOS,
             "QoSMemCtrl::escalate Completed requestor %s [id %d] to priority "
             "%d (now %d packets)\n\t(total read %d, total write %d)\n",
-            requestors[id], id, tgt_prio, packetPriorities[id][tgt_prio],
+            requestors[id], id, tgt_prio, prios[tgt_prio],
             readQueueSizes[tgt_prio], writeQueueSizes[tgt_prio]);
 }
 
@@ -58,19 +58,27 @@ FixedPriorityPolicy::init()
 {
 }
 
+void
+FixedPriorityPolicy::setPriority(const std::pair<RequestorID, uint8_t> &prio)
+{
+    if (prio.first >= priorityMap.size())
+        priorityMap.resize(prio.first + 1, -1);
+
+    if (priorityMap[prio.first] == -1)
+        priorityMap[prio.first] = prio.second;
+}
+
 void
 FixedPriorityPolicy::initRequestorName(std::string requestor, uint8_t priority)
 {
-    priorityMap.insert(
-        this->pair<std::string, uint8_t>(requestor, priority));
+    setPriority(this->pair<std::string, uint8_t>(requestor, priority));
 }
 
 void
 FixedPriorityPolicy::initRequestorObj(const SimObject* requestor,
                                    uint8_t priority)
 {
-    priorityMap.insert(
-        this->pair<const SimObject*, uint8_t>(requestor, priority));
+    setPriority(this->pair<const SimObject*, uint8_t>(requestor, priority));
 }
 
 uint8_t
@@ -80,10 +88,8 @@ FixedPriorityPolicy::schedule(const RequestorID id, const uint64_t data)
     // if a match is found in the configured priority map, returns the
     // matching priority, else returns zero
 
-    auto ret = priorityMap.find(id);
-
-    if (ret != priorityMap.end()) {
-        return ret->second;
+    if (id < priorityMap.size() && priorityMap[id] != -1) {
+        return priorityMap[id];
     } else {
         DPRINTF(QOS, "Requestor %s (RequestorID %d) not present in "
                      "priorityMap, assigning default priority %d\n",
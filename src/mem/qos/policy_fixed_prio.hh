@@ -94,10 +94,15 @@ class FixedPriorityPolicy : public Policy
     const uint8_t defaultPriority;
 
     /**
-     * Priority map, associates configured requestors with
-     * a fixed QoS priority value
+     * Priority table, associates configured requestors with a fixed
+     * QoS priority value. It is indexed by RequestorID, which are
+     * small and dense, and holds -1 for the requestors that use the
+     * default priority.
      */
-    std::map<RequestorID, uint8_t> priorityMap;
+    std::vector<int> priorityMap;
+
+    /** Configure the priority of a requestor, unless already set */
+    void setPriority(const std::pair<RequestorID, uint8_t> &prio);
 };
 
 } // namespace QoS
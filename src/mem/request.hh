@@ -61,6 +61,7 @@
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
 #include "mem/htm.hh"
+#include "mem/mem_pool.hh"
 #include "sim/core.hh"
 
 /**
@@ -473,6 +474,19 @@ class Request
                                 other.atomicOpFunctor->clone() : nullptr);
     }
 
+    /**
+     * Create a request with the arguments of one of the constructors.
+     * The request and its shared_ptr control block are allocated
+     * together from the memory system object pool.
+     */
+    template <typename... Args>
+    static RequestPtr
+    create(Args&&... args)
+    {
+        return std::allocate_shared<Request>(MemPoolAllocator<Request>(),
+                                             std::forward<Args>(args)...);
+    }
+
     ~Request() {}
 
     /**
@@ -548,8 +562,8 @@ class Request
         assert(hasVaddr());
         assert(!hasPaddr());
         assert(split_addr > _vaddr && split_addr < _vaddr + _size);
-        req1 = std::make_shared<Request>(*this);
-        req2 = std::make_shared<Request>(*this);
+        req1 = Request::create(*this);
+        req2 = Request::create(*this);
         req1->_size = split_addr - _vaddr;
         req2->_vaddr = split_addr;
         req2->_size = _size - req1->_size;
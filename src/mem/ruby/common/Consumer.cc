@@ -40,34 +40,105 @@
 
 #include "mem/ruby/common/Consumer.hh"
 
+#include <algorithm>
+#include <functional>
+
+#include "base/bitfield.hh"
+
 Consumer::Consumer(ClockedObject *_em)
-    : m_wakeup_event([this]{ processCurrentEvent(); },
+    : m_wakeup_base(0), m_wakeup_period(0), m_wakeup_bits(0),
+      m_wakeup_event([this]{ processCurrentEvent(); },
                     "Consumer Event", false),
       em(_em)
 { }
 
+bool
+Consumer::alreadyScheduled(Tick time)
+{
+    if (m_wakeup_bits && time >= m_wakeup_base) {
+        const Tick offset = time - m_wakeup_base;
+        const Tick cycle = offset / m_wakeup_period;
+        if (offset % m_wakeup_period == 0 && cycle < WakeupWindow &&
+            bits(m_wakeup_bits, cycle)) {
+            return true;
+        }
+    }
+    return std::find(m_far_wakeups.begin(), m_far_wakeups.end(), time) !=
+        m_far_wakeups.end();
+}
+
 void
 Consumer::scheduleEvent(Cycles timeDelta)
 {
-    m_wakeup_ticks.insert(em->clockEdge(timeDelta));
+    addWakeup(em->clockEdge(timeDelta));
     scheduleNextWakeup();
 }
 
 void
 Consumer::scheduleEventAbsolute(Tick evt_time)
 {
-    m_wakeup_ticks.insert(
-        divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
+    addWakeup(divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
     scheduleNextWakeup();
 }
 
+void
+Consumer::addWakeup(Tick when)
+{
+    const Tick period = em->clockPeriod();
+    if (period != m_wakeup_period) {
+        // the clock has changed, the bitmap has to be set up again
+        flushWakeupBits();
+        m_wakeup_period = period;
+    }
+
+    if (!m_wakeup_bits)
+        m_wakeup_base = when;
+
+    if (when >= m_wakeup_base) {
+        const Tick offset = when - m_wakeup_base;
+        const Tick cycle = offset / period;
+        if (offset % period == 0 && cycle < WakeupWindow) {
+            m_wakeup_bits |= (uint64_t)1 << cycle;
+            return;
+        }
+    }
+
+    m_far_wakeups.push_back(when);
+    std::push_heap(m_far_wakeups.begin(), m_far_wakeups.end(),
+                   std::greater<Tick>());
+}
+
+void
+Consumer::flushWakeupBits()
+{
+    while (m_wakeup_bits) {
+        const int cycle = findLsbSet(m_wakeup_bits);
+        m_wakeup_bits &= ~((uint64_t)1 << cycle);
+        m_far_wakeups.push_back(m_wakeup_base + cycle * m_wakeup_period);
+        std::push_heap(m_far_wakeups.begin(), m_far_wakeups.end(),
+                       std::greater<Tick>());
+    }
+}
+
+Tick
+Consumer::nextWakeup() const
+{
+    Tick next = MaxTick;
+    if (m_wakeup_bits) {
+        next = m_wakeup_base +
+            findLsbSet(m_wakeup_bits) * m_wakeup_period;
+    }
+    if (!m_far_wakeups.empty())
+        next = std::min(next, m_far_wakeups.front());
+    return next;
+}
+
 void
 Consumer::scheduleNextWakeup()
 {
     // look for the next tick in the future to schedule
-    auto it = m_wakeup_ticks.lower_bound(em->clockEdge());
-    if (it != m_wakeup_ticks.end()) {
-        Tick when = *it;
+    const Tick when = nextWakeup();
+    if (when != MaxTick) {
         assert(when >= em->clockEdge());
         if (m_wakeup_event.scheduled() && (when < m_wakeup_event.when()))
             em->reschedule(m_wakeup_event, when, true);
@@ -79,12 +150,23 @@ Consumer::scheduleNextWakeup()
 void
 Consumer::processCurrentEvent()
 {
-    auto curr = m_wakeup_ticks.begin();
-    assert(em->clockEdge() == *curr);
+    const Tick now = em->clockEdge();
+    assert(nextWakeup() == now);
+
+    // remove the current tick from the pending wakeups, moving the
+    // bitmap on to start with the next cycle, wake up, and then
+    // schedule the next wakeup
+    if (m_wakeup_bits && now >= m_wakeup_base) {
+        const Tick cycles = (now - m_wakeup_base) / m_wakeup_period + 1;
+        m_wakeup_bits = cycles < WakeupWindow ? m_wakeup_bits >> cycles : 0;
+        m_wakeup_base += cycles * m_wakeup_period;
+    }
+    while (!m_far_wakeups.empty() && m_far_wakeups.front() == now) {
+        std::pop_heap(m_far_wakeups.begin(), m_far_wakeups.end(),
+                      std::greater<Tick>());
+        m_far_wakeups.pop_back();
+    }
 
-    // remove the current tick from the wakeup list, wake up, and then schedule
-    // the next wakeup
-    m_wakeup_ticks.erase(curr);
     wakeup();
     scheduleNextWakeup();
 }
@@ -47,8 +47,9 @@
 #ifndef __MEM_RUBY_COMMON_CONSUMER_HH__
 #define __MEM_RUBY_COMMON_CONSUMER_HH__
 
+#include <cstdint>
 #include <iostream>
-#include <set>
+#include <vector>
 
 #include "sim/clocked_object.hh"
 
@@ -65,11 +66,7 @@ class Consumer
     virtual void print(std::ostream& out) const = 0;
     virtual void storeEventInfo(int info) {}
 
-    bool
-    alreadyScheduled(Tick time)
-    {
-        return m_wakeup_ticks.find(time) != m_wakeup_ticks.end();
-    }
+    bool alreadyScheduled(Tick time);
 
     ClockedObject *
     getObject()
@@ -81,10 +78,33 @@ class Consumer
     void scheduleEvent(Cycles timeDelta);
 
   private:
-    std::set<Tick> m_wakeup_ticks;
+    /** Number of cycles covered by the wakeup bitmap. */
+    static const unsigned WakeupWindow = 64;
+
+    /**
+     * Pending wakeups. Wakeups in the next WakeupWindow cycles, which
+     * is where nearly all of them are, are kept in a bitmap. The rest
+     * go to a min-heap, which may hold duplicates. There is at most
+     * one event scheduled for all of them.
+     */
+    /** @{ */
+    /** Clock edge of the first cycle covered by the bitmap. */
+    Tick m_wakeup_base;
+    /** Clock period the bitmap was set up with. */
+    Tick m_wakeup_period;
+    /** Bit n is set if a wakeup is due n cycles after m_wakeup_base. */
+    uint64_t m_wakeup_bits;
+    std::vector<Tick> m_far_wakeups;
+    /** @} */
+
     EventFunctionWrapper m_wakeup_event;
     ClockedObject *em;
 
+    void addWakeup(Tick when);
+    void flushWakeupBits();
+    /** Get the earliest pending wakeup, MaxTick if there is none. */
+    Tick nextWakeup() const;
+
     void scheduleNextWakeup();
     void processCurrentEvent();
 };
@@ -43,37 +43,55 @@
 #include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
+#if !RUBY_BLOCK_SIZE_BYTES
+int
+DataBlock::blockSize()
+{
+    return RubySystem::getBlockSizeBytes();
+}
+#endif
+
 DataBlock::DataBlock(const DataBlock &cp)
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
+#if RUBY_BLOCK_SIZE_BYTES
+    m_data = m_storage;
+    m_alloc = false;
+#else
+    m_data = new uint8_t[blockSize()];
     m_alloc = true;
+#endif
+    memcpy(m_data, cp.m_data, blockSize());
 }
 
 void
 DataBlock::alloc()
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
+#if RUBY_BLOCK_SIZE_BYTES
+    m_data = m_storage;
+    m_alloc = false;
+#else
+    m_data = new uint8_t[blockSize()];
     m_alloc = true;
+#endif
     clear();
 }
 
 void
 DataBlock::clear()
 {
-    memset(m_data, 0, RubySystem::getBlockSizeBytes());
+    memset(m_data, 0, blockSize());
 }
 
 bool
 DataBlock::equal(const DataBlock& obj) const
 {
-    return !memcmp(m_data, obj.m_data, RubySystem::getBlockSizeBytes());
+    return !memcmp(m_data, obj.m_data, blockSize());
 }
 
 void
 DataBlock::copyPartial(const DataBlock &dblk, const WriteMask &mask)
 {
-    for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
+    for (int i = 0; i < blockSize(); i++) {
         if (mask.getMask(i, 1)) {
             m_data[i] = dblk.m_data[i];
         }
@@ -83,7 +101,7 @@ DataBlock::copyPartial(const DataBlock &dblk, const WriteMask &mask)
 void
 DataBlock::atomicPartial(const DataBlock &dblk, const WriteMask &mask)
 {
-    for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
+    for (int i = 0; i < blockSize(); i++) {
         m_data[i] = dblk.m_data[i];
     }
     mask.performAtomic(m_data);
@@ -92,7 +110,7 @@ DataBlock::atomicPartial(const DataBlock &dblk, const WriteMask &mask)
 void
 DataBlock::print(std::ostream& out) const
 {
-    int size = RubySystem::getBlockSizeBytes();
+    int size = blockSize();
     out << "[ ";
     for (int i = 0; i < size; i++) {
         out << std::setw(2) << std::setfill('0') << std::hex
@@ -104,7 +122,7 @@ DataBlock::print(std::ostream& out) const
 const uint8_t*
 DataBlock::getData(int offset, int len) const
 {
-    assert(offset + len <= RubySystem::getBlockSizeBytes());
+    assert(offset + len <= blockSize());
     return &m_data[offset];
 }
 
@@ -124,13 +142,13 @@ void
 DataBlock::setData(PacketPtr pkt)
 {
     int offset = getOffset(pkt->getAddr());
-    assert(offset + pkt->getSize() <= RubySystem::getBlockSizeBytes());
+    assert(offset + pkt->getSize() <= blockSize());
     pkt->writeData(&m_data[offset]);
 }
 
 DataBlock &
 DataBlock::operator=(const DataBlock & obj)
 {
-    memcpy(m_data, obj.m_data, RubySystem::getBlockSizeBytes());
+    memcpy(m_data, obj.m_data, blockSize());
     return *this;
 }
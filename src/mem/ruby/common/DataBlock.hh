@@ -47,13 +47,25 @@
 #include <iomanip>
 #include <iostream>
 
+#include "config/ruby_block_size_bytes.hh"
 #include "mem/packet.hh"
 
 class WriteMask;
 
+/**
+ * The data of a cache block. If the block size is fixed at build time
+ * (RUBY_BLOCK_SIZE_BYTES), the data is kept inline rather than
+ * allocated, and all the copies and comparisons are of a constant size.
+ */
 class DataBlock
 {
   public:
+#if RUBY_BLOCK_SIZE_BYTES
+    static constexpr int blockSize() { return RUBY_BLOCK_SIZE_BYTES; }
+#else
+    static int blockSize();
+#endif
+
     DataBlock()
     {
         alloc();
@@ -88,6 +100,9 @@ class DataBlock
     void alloc();
     uint8_t *m_data;
     bool m_alloc;
+#if RUBY_BLOCK_SIZE_BYTES
+    alignas(16) uint8_t m_storage[RUBY_BLOCK_SIZE_BYTES];
+#endif
 };
 
 inline void
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "mem/ruby/common/NetDest.hh"
+
+/*
+ * The sets of a NetDest are as large as the number of controllers of
+ * each machine type, which is 0 without a Ruby system. The operations
+ * below work on whole bit vectors, so their cost doesn't depend on it.
+ */
+
+namespace
+{
+
+void
+Or(benchmark::State &state)
+{
+    NetDest a, b;
+    for (auto _: state)
+        benchmark::DoNotOptimize(a.OR(b));
+}
+
+void
+And(benchmark::State &state)
+{
+    NetDest a, b;
+    for (auto _: state)
+        benchmark::DoNotOptimize(a.AND(b));
+}
+
+void
+AddNetDest(benchmark::State &state)
+{
+    NetDest a, b;
+    for (auto _: state) {
+        a.addNetDest(b);
+        benchmark::ClobberMemory();
+    }
+}
+
+/** Empty sets, the worst case as every set has to be checked. */
+void
+IntersectionIsNotEmpty(benchmark::State &state)
+{
+    NetDest a, b;
+    for (auto _: state)
+        benchmark::DoNotOptimize(a.intersectionIsNotEmpty(b));
+}
+
+void
+IsSuperset(benchmark::State &state)
+{
+    NetDest a, b;
+    for (auto _: state)
+        benchmark::DoNotOptimize(a.isSuperset(b));
+}
+
+void
+Count(benchmark::State &state)
+{
+    NetDest a;
+    for (auto _: state)
+        benchmark::DoNotOptimize(a.count());
+}
+
+void
+Copy(benchmark::State &state)
+{
+    NetDest a;
+    for (auto _: state) {
+        NetDest b(a);
+        benchmark::DoNotOptimize(b);
+    }
+}
+
+} // anonymous namespace
+
+BENCHMARK(Or);
+BENCHMARK(And);
+BENCHMARK(AddNetDest);
+BENCHMARK(IntersectionIsNotEmpty);
+BENCHMARK(IsSuperset);
+BENCHMARK(Count);
+BENCHMARK(Copy);
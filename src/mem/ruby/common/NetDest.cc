@@ -108,6 +108,8 @@ NetDest::getAllDest()
     std::vector<NodeID> dest;
     dest.clear();
     for (int i = 0; i < m_bits.size(); i++) {
+        if (m_bits[i].isEmpty())
+            continue;
         for (int j = 0; j < m_bits[i].getSize(); j++) {
             if (m_bits[i].isElement(j)) {
                 int id = MachineType_base_number((MachineType)i) + j;
@@ -139,11 +141,10 @@ NetDest::smallestElement() const
 {
     assert(count() > 0);
     for (int i = 0; i < m_bits.size(); i++) {
-        for (NodeID j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                MachineID mach = {MachineType_from_base_level(i), j};
-                return mach;
-            }
+        if (!m_bits[i].isEmpty()) {
+            MachineID mach = {MachineType_from_base_level(i),
+                              m_bits[i].smallestElement()};
+            return mach;
         }
     }
     panic("No smallest element of an empty set.");
@@ -152,12 +153,10 @@ NetDest::smallestElement() const
 MachineID
 NetDest::smallestElement(MachineType machine) const
 {
-    int size = m_bits[MachineType_base_level(machine)].getSize();
-    for (NodeID j = 0; j < size; j++) {
-        if (m_bits[MachineType_base_level(machine)].isElement(j)) {
-            MachineID mach = {machine, j};
-            return mach;
-        }
+    const Set &set = m_bits[MachineType_base_level(machine)];
+    if (!set.isEmpty()) {
+        MachineID mach = {machine, set.smallestElement()};
+        return mach;
     }
 
     panic("No smallest element of given MachineType.");
@@ -192,10 +191,8 @@ NetDest
 NetDest::OR(const NetDest& orNetDest) const
 {
     assert(m_bits.size() == orNetDest.getSize());
-    NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].OR(orNetDest.m_bits[i]);
-    }
+    NetDest result(*this);
+    result.addNetDest(orNetDest);
     return result;
 }
 
@@ -204,9 +201,9 @@ NetDest
 NetDest::AND(const NetDest& andNetDest) const
 {
     assert(m_bits.size() == andNetDest.getSize());
-    NetDest result;
+    NetDest result(*this);
     for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].AND(andNetDest.m_bits[i]);
+        result.m_bits[i].intersectSet(andNetDest.m_bits[i]);
     }
     return result;
 }
@@ -246,8 +243,7 @@ NetDest::isElement(MachineID element) const
 void
 NetDest::resize()
 {
-    m_bits.resize(MachineType_base_level(MachineType_NUM));
-    assert(m_bits.size() == MachineType_NUM);
+    assert(MachineType_base_level(MachineType_NUM) == m_bits.size());
 
     for (int i = 0; i < m_bits.size(); i++) {
         m_bits[i].setSize(MachineType_base_count((MachineType)i));
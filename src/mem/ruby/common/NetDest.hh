@@ -29,6 +29,7 @@
 #ifndef __MEM_RUBY_COMMON_NETDEST_HH__
 #define __MEM_RUBY_COMMON_NETDEST_HH__
 
+#include <array>
 #include <iostream>
 #include <vector>
 
@@ -105,7 +106,9 @@ class NetDest
 
     NodeID bitIndex(NodeID index) const { return index; }
 
-    std::vector<Set> m_bits;  // a vector of bit vectors - i.e. Sets
+    // One bit vector (Set) per machine type. The sets are stored inline
+    // so that copying a NetDest doesn't allocate.
+    std::array<Set, MachineType_NUM> m_bits;
 };
 
 inline std::ostream&
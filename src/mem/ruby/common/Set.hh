@@ -36,6 +36,7 @@
 #include <cassert>
 #include <iostream>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "mem/ruby/common/TypeDefines.hh"
 
@@ -104,6 +105,16 @@ class Set
         bits &= (~obj.bits);
     }
 
+    /*
+     * This function clears bits that are =0 in the parameter set
+     */
+    void
+    intersectSet(const Set& obj)
+    {
+        assert(m_nSize == obj.m_nSize);
+        bits &= obj.bits;
+    }
+
     void clear() { bits.reset(); }
 
     /*
@@ -112,9 +123,7 @@ class Set
     void broadcast()
     {
         bits.set();
-        for (int j = m_nSize; j < NUMBER_BITS_PER_SET; ++j) {
-            bits.reset(j);
-        }
+        bits >>= NUMBER_BITS_PER_SET - m_nSize;
     }
 
     /*
@@ -189,11 +198,16 @@ class Set
 
     NodeID smallestElement() const
     {
+#if NUMBER_BITS_PER_SET <= 64
+        if (bits.any())
+            return findLsbSet(bits.to_ullong());
+#else
         for (int i = 0; i < m_nSize; ++i) {
             if (bits.test(i)) {
                 return i;
             }
         }
+#endif
         panic("No smallest element of an empty set.");
     }
 
@@ -32,10 +32,16 @@
 
 #include "mem/ruby/system/RubySystem.hh"
 
+#if RUBY_BLOCK_SIZE_BYTES
+WriteMask::WriteMask()
+    : mSize(RUBY_BLOCK_SIZE_BYTES), mAtomic(false)
+{}
+#else
 WriteMask::WriteMask()
     : mSize(RubySystem::getBlockSizeBytes()), mMask(mSize, false),
       mAtomic(false)
 {}
+#endif
 
 void
 WriteMask::print(std::ostream& out) const
@@ -41,15 +41,22 @@
 #ifndef __MEM_RUBY_COMMON_WRITEMASK_HH__
 #define __MEM_RUBY_COMMON_WRITEMASK_HH__
 
+#include <bitset>
 #include <cassert>
 #include <iomanip>
 #include <iostream>
 #include <vector>
 
 #include "base/amo.hh"
+#include "config/ruby_block_size_bytes.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/common/TypeDefines.hh"
 
+/**
+ * Byte mask of a cache block. If the block size is fixed at build time
+ * (RUBY_BLOCK_SIZE_BYTES), all masks are of that size and are kept in a
+ * bitset, so that combining and testing masks works on whole words.
+ */
 class WriteMask
 {
   public:
@@ -57,6 +64,21 @@ class WriteMask
 
     WriteMask();
 
+#if RUBY_BLOCK_SIZE_BYTES
+    WriteMask(int size)
+      : mSize(size), mAtomic(false)
+    {
+        assert(size == RUBY_BLOCK_SIZE_BYTES);
+    }
+
+    WriteMask(int size, std::vector<bool> & mask)
+      : WriteMask(size)
+    {
+        assert(mask.size() == size_t(mSize));
+        for (int i = 0; i < mSize; i++)
+            mMask[i] = mask[i];
+    }
+#else
     WriteMask(int size)
       : mSize(size), mMask(size, false), mAtomic(false)
     {}
@@ -64,10 +86,14 @@ class WriteMask
     WriteMask(int size, std::vector<bool> & mask)
       : mSize(size), mMask(mask), mAtomic(false)
     {}
+#endif
 
     WriteMask(int size, std::vector<bool> &mask, AtomicOpVector atomicOp)
-      : mSize(size), mMask(mask), mAtomic(true), mAtomicOp(atomicOp)
-    {}
+      : WriteMask(size, mask)
+    {
+        mAtomic = true;
+        mAtomicOp = atomicOp;
+    }
 
     ~WriteMask()
     {}
@@ -75,7 +101,11 @@ class WriteMask
     void
     clear()
     {
+#if RUBY_BLOCK_SIZE_BYTES
+        mMask.reset();
+#else
         mMask = std::vector<bool>(mSize, false);
+#endif
     }
 
     bool
@@ -96,9 +126,13 @@ class WriteMask
     void
     fillMask()
     {
+#if RUBY_BLOCK_SIZE_BYTES
+        mMask.set();
+#else
         for (int i = 0; i < mSize; i++) {
             mMask[i] = true;
         }
+#endif
     }
 
     bool
@@ -107,7 +141,7 @@ class WriteMask
         bool tmp = true;
         assert(mSize >= (offset + len));
         for (int i = 0; i < len; i++) {
-            tmp = tmp & mMask.at(offset + i);
+            tmp = tmp & mMask[offset + i];
         }
         return tmp;
     }
@@ -115,57 +149,77 @@ class WriteMask
     bool
     isOverlap(const WriteMask &readMask) const
     {
-        bool tmp = false;
         assert(mSize == readMask.mSize);
+#if RUBY_BLOCK_SIZE_BYTES
+        return (mMask & readMask.mMask).any();
+#else
+        bool tmp = false;
         for (int i = 0; i < mSize; i++) {
             if (readMask.mMask.at(i)) {
                 tmp = tmp | mMask.at(i);
             }
         }
         return tmp;
+#endif
     }
 
     bool
     cmpMask(const WriteMask &readMask) const
     {
-        bool tmp = true;
         assert(mSize == readMask.mSize);
+#if RUBY_BLOCK_SIZE_BYTES
+        return (readMask.mMask & ~mMask).none();
+#else
+        bool tmp = true;
         for (int i = 0; i < mSize; i++) {
             if (readMask.mMask.at(i)) {
                 tmp = tmp & mMask.at(i);
             }
         }
         return tmp;
+#endif
     }
 
     bool isEmpty() const
     {
+#if RUBY_BLOCK_SIZE_BYTES
+        return mMask.none();
+#else
         for (int i = 0; i < mSize; i++) {
             if (mMask.at(i)) {
                 return false;
             }
         }
         return true;
+#endif
     }
 
     bool
     isFull() const
     {
+#if RUBY_BLOCK_SIZE_BYTES
+        return mMask.all();
+#else
         for (int i = 0; i < mSize; i++) {
             if (!mMask.at(i)) {
                 return false;
             }
         }
         return true;
+#endif
     }
 
     void
     andMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
+#if RUBY_BLOCK_SIZE_BYTES
+        mMask &= writeMask.mMask;
+#else
         for (int i = 0; i < mSize; i++) {
             mMask[i] = (mMask.at(i)) & (writeMask.mMask.at(i));
         }
+#endif
 
         if (writeMask.mAtomic) {
             mAtomic = true;
@@ -177,9 +231,13 @@ class WriteMask
     orMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
+#if RUBY_BLOCK_SIZE_BYTES
+        mMask |= writeMask.mMask;
+#else
         for (int i = 0; i < mSize; i++) {
             mMask[i] = (mMask.at(i)) | (writeMask.mMask.at(i));
         }
+#endif
 
         if (writeMask.mAtomic) {
             mAtomic = true;
@@ -191,9 +249,13 @@ class WriteMask
     setInvertedMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
+#if RUBY_BLOCK_SIZE_BYTES
+        mMask = ~writeMask.mMask;
+#else
         for (int i = 0; i < mSize; i++) {
             mMask[i] = !writeMask.mMask.at(i);
         }
+#endif
     }
 
     int
@@ -208,6 +270,10 @@ class WriteMask
     int
     count(int offset = 0) const
     {
+#if RUBY_BLOCK_SIZE_BYTES
+        if (offset == 0)
+            return mMask.count();
+#endif
         int count = 0;
         for (int i = offset; i < mSize; ++i)
             count += mMask[i];
@@ -252,7 +318,11 @@ class WriteMask
 
   private:
     int mSize;
+#if RUBY_BLOCK_SIZE_BYTES
+    std::bitset<RUBY_BLOCK_SIZE_BYTES> mMask;
+#else
     std::vector<bool> mMask;
+#endif
     bool mAtomic;
     AtomicOpVector mAtomicOp;
 };
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+
+#include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+#include "params/MessageBuffer.hh"
+#include "sim/clocked_object.hh"
+#include "sim/gbench/clocked_object_fake.hh"
+
+namespace
+{
+
+class BenchMessage : public Message
+{
+  public:
+    using Message::Message;
+
+    MsgPtr clone() const override { return new BenchMessage(*this); }
+    void print(std::ostream &out) const override { out << "[BenchMessage]"; }
+};
+
+/** A consumer which leaves the messages to the benchmark. */
+class BenchConsumer : public Consumer
+{
+  public:
+    using Consumer::Consumer;
+
+    void wakeup() override {}
+    void print(std::ostream &out) const override { out << "[BenchConsumer]"; }
+};
+
+/**
+ * A buffer of the given kind connected to a consumer. Buffers are
+ * shared by the runs of the benchmarks, as SimObjects are never freed.
+ */
+MessageBuffer *
+getBuffer(bool ordered)
+{
+    static MessageBuffer *buffers[2];
+    MessageBuffer *&buffer = buffers[ordered];
+    if (buffer)
+        return buffer;
+
+    const std::string name = ordered ? "bench.ordered" : "bench.unordered";
+
+    // SimObjects keep a reference to their parameters.
+    auto *cp = new ClockedObjectParams();
+    GBench::clockedParams(*cp, name + "_consumer");
+    auto *consumer = new BenchConsumer(new ClockedObject(*cp));
+
+    auto *p = new MessageBufferParams();
+    p->name = name;
+    p->eventq_index = 0;
+    p->ordered = ordered;
+    p->buffer_size = 0;
+    p->randomization = MessageRandomization::disabled;
+    // The messages are ready as soon as they are enqueued, so that the
+    // benchmark doesn't need to advance the simulated time.
+    p->allow_zero_latency = true;
+
+    buffer = new MessageBuffer(*p);
+    buffer->setConsumer(consumer);
+    return buffer;
+}
+
+/** Enqueue a number of messages, then dequeue all of them. */
+void
+EnqueueDequeue(benchmark::State &state, bool ordered)
+{
+    MessageBuffer *buffer = getBuffer(ordered);
+    const Tick now = curTick();
+    const int count = state.range(0);
+
+    for (auto _: state) {
+        for (int i = 0; i < count; i++)
+            buffer->enqueue(new BenchMessage(now), now, 0);
+        for (int i = 0; i < count; i++)
+            buffer->dequeue(now);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+} // anonymous namespace
+
+BENCHMARK_CAPTURE(EnqueueDequeue, unordered, false)
+    ->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK_CAPTURE(EnqueueDequeue, ordered, true)
+    ->RangeMultiplier(4)->Range(1, 256);
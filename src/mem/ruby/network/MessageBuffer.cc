@@ -48,6 +48,7 @@
 #include "base/stl_helpers.hh"
 #include "debug/RubyQueue.hh"
 #include "mem/ruby/system/RubySystem.hh"
+#include "sim/eventq.hh"
 
 using m5::stl_helpers::operator<<;
 
@@ -64,6 +65,8 @@ MessageBuffer::MessageBuffer(const Params &p)
     ADD_STAT(m_stall_time, "Average number of cycles messages are stalled in "
                            "this MB"),
     ADD_STAT(m_stall_count, "Number of times messages were stalled"),
+    ADD_STAT(m_stall_depth, "Number of messages stalled on an address when "
+                            "they are reanalyzed"),
     ADD_STAT(m_occupancy, "Average occupancy of buffer capacity")
 {
     m_msg_counter = 0;
@@ -74,7 +77,6 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_msgs_this_cycle = 0;
     m_priority_rank = 0;
 
-    m_stall_msg_map.clear();
     m_input_link_id = 0;
     m_vnet_id = 0;
 
@@ -93,6 +95,10 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_stall_count
         .flags(Stats::nozero);
 
+    m_stall_depth
+        .init(8)
+        .flags(Stats::nozero);
+
     m_occupancy
         .flags(Stats::nozero);
 
@@ -190,6 +196,13 @@ random_time()
 void
 MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
 {
+    assert(m_consumer != NULL);
+    if (inParallelMode &&
+        m_consumer->getObject()->eventQueue() != curEventQueue()) {
+        enqueueRemote(message, current_time, delta);
+        return;
+    }
+
     // record current time incase we have a pop that also adjusts my size
     if (m_time_last_time_enqueue < current_time) {
         m_msgs_this_cycle = 0;  // first msg this cycle
@@ -224,13 +237,41 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
         }
     }
 
+    insert(message, current_time, arrival_time);
+}
+
+void
+MessageBuffer::enqueueRemote(MsgPtr message, Tick current_time, Tick delta)
+{
+    fatal_if(m_max_size != 0, "%s: Buffers between event queues must be "
+             "unbounded.\n", name());
+    fatal_if(delta < simQuantum, "%s: Messages between event queues must "
+             "take at least a simulation quantum (%d ticks), not %d.\n",
+             name(), simQuantum, delta);
+
+    // Random delays aren't applied to messages between event queues, as
+    // they depend on the arrival time of the previous message which the
+    // sender can't see.
+    Tick arrival_time = current_time + delta;
+    m_consumer->getObject()->eventQueue()->schedule(
+        new EventFunctionWrapper([this, message, current_time, arrival_time]
+            {
+                m_msg_counter++;
+                insert(message, current_time, arrival_time);
+            }, name() + ".remoteEnqueue", true),
+        arrival_time);
+}
+
+void
+MessageBuffer::insert(MsgPtr message, Tick current_time, Tick arrival_time)
+{
     // Check the arrival time
     assert(arrival_time >= current_time);
     if (m_strict_fifo) {
         if (arrival_time < m_last_arrival_time) {
             panic("FIFO ordering violated: %s name: %s current time: %d "
-                  "delta: %d arrival_time: %d last arrival_time: %d\n",
-                  *this, name(), current_time, delta, arrival_time,
+                  "arrival_time: %d last arrival_time: %d\n",
+                  *this, name(), current_time, arrival_time,
                   m_last_arrival_time);
         }
     }
@@ -264,7 +305,6 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
             arrival_time, *(message.get()));
 
     // Schedule the wakeup
-    assert(m_consumer != NULL);
     m_consumer->scheduleEventAbsolute(arrival_time);
     m_consumer->storeEventInfo(m_vnet_id);
 }
@@ -350,10 +390,14 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 }
 
 void
-MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
+MessageBuffer::reanalyzeList(MsgList &lt, Tick schdTick)
 {
+    m_stall_depth.sample(lt.size());
+    m_stall_map_size -= lt.size();
+    assert(m_stall_map_size >= 0);
+
     while (!lt.empty()) {
-        MsgPtr m = lt.front();
+        MsgPtr m = lt.pop_front();
         assert(m->getLastEnqueueTime() <= schdTick);
 
         m_prio_heap.push_back(m);
@@ -364,8 +408,6 @@ MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
 
         DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
             schdTick, *(m.get()));
-
-        lt.pop_front();
     }
 }
 
@@ -373,7 +415,7 @@ void
 MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "ReanalyzeMessages %#x\n", addr);
-    assert(m_stall_msg_map.count(addr) > 0);
+    assert(hasStalledMsg(addr));
 
     //
     // Put all stalled messages associated with this address back on the
@@ -381,10 +423,8 @@ MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle
     //
-    m_stall_map_size -= m_stall_msg_map[addr].size();
-    assert(m_stall_map_size >= 0);
-    reanalyzeList(m_stall_msg_map[addr], current_time);
-    m_stall_msg_map.erase(addr);
+    MsgList stalled = m_stall_msg_map.take(addr);
+    reanalyzeList(stalled, current_time);
 }
 
 void
@@ -397,13 +437,12 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
     // prio heap.  The reanalyzeList call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle.
+    // The addresses are visited in no particular order, which is fine as
+    // the heap orders the messages by their enqueue time and counter.
     //
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end(); ++map_iter) {
-        m_stall_map_size -= map_iter->second.size();
-        assert(m_stall_map_size >= 0);
-        reanalyzeList(map_iter->second, current_time);
-    }
+    m_stall_msg_map.forEach([this, current_time](Addr, MsgList &stalled) {
+        reanalyzeList(stalled, current_time);
+    });
     m_stall_msg_map.clear();
 }
 
@@ -424,7 +463,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     // Instead the controller is responsible to call reanalyzeMessages when
     // these addresses change state.
     //
-    (m_stall_msg_map[addr]).push_back(message);
+    m_stall_msg_map[addr].push_back(message);
     m_stall_map_size++;
     m_stall_count++;
 }
@@ -432,7 +471,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
 bool
 MessageBuffer::hasStalledMsg(Addr addr) const
 {
-    return (m_stall_msg_map.count(addr) != 0);
+    return m_stall_msg_map.find(addr) != nullptr;
 }
 
 void
@@ -440,29 +479,25 @@ MessageBuffer::deferEnqueueingMessage(Addr addr, MsgPtr message)
 {
     DPRINTF(RubyQueue, "Deferring enqueueing message: %s, Address %#x\n",
             *(message.get()), addr);
-    (m_deferred_msg_map[addr]).push_back(message);
+    m_deferred_msg_map[addr].push_back(message);
 }
 
 void
 MessageBuffer::enqueueDeferredMessages(Addr addr, Tick curTime, Tick delay)
 {
     assert(!isDeferredMsgMapEmpty(addr));
-    std::vector<MsgPtr>& msg_vec = m_deferred_msg_map[addr];
-    assert(msg_vec.size() > 0);
+    MsgList deferred = m_deferred_msg_map.take(addr);
+    assert(!deferred.empty());
 
     // enqueue all deferred messages associated with this address
-    for (MsgPtr m : msg_vec) {
-        enqueue(m, curTime, delay);
-    }
-
-    msg_vec.clear();
-    m_deferred_msg_map.erase(addr);
+    while (!deferred.empty())
+        enqueue(deferred.pop_front(), curTime, delay);
 }
 
 bool
 MessageBuffer::isDeferredMsgMapEmpty(Addr addr) const
 {
-    return m_deferred_msg_map.count(addr) == 0;
+    return m_deferred_msg_map.find(addr) == nullptr;
 }
 
 void
@@ -507,22 +542,21 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
 
     // Check the stall queue and write any messages that may
     // correspond to the address in the packet.
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end();
-         ++map_iter) {
-
-        for (std::list<MsgPtr>::iterator it = (map_iter->second).begin();
-            it != (map_iter->second).end(); ++it) {
-
-            Message *msg = (*it).get();
+    bool read_done = false;
+    m_stall_msg_map.forEach([&](Addr, MsgList &stalled) {
+        stalled.forEach([&](Message *msg) {
+            if (read_done)
+                return;
             if (is_read && !mask && msg->functionalRead(pkt))
-                return 1;
+                read_done = true;
             else if (is_read && mask && msg->functionalRead(pkt, *mask))
                 num_functional_accesses++;
             else if (!is_read && msg->functionalWrite(pkt))
                 num_functional_accesses++;
-        }
-    }
+        });
+    });
+    if (read_done)
+        return 1;
 
     return num_functional_accesses;
 }
@@ -51,7 +51,6 @@
 #include <functional>
 #include <iostream>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/trace.hh"
@@ -60,6 +59,7 @@
 #include "mem/port.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/network/MsgListTable.hh"
 #include "mem/ruby/network/dummy_port.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 #include "params/MessageBuffer.hh"
@@ -114,6 +114,18 @@ class MessageBuffer : public SimObject
 
     const MsgPtr &peekMsgPtr() const { return m_prio_heap.front(); }
 
+    /**
+     * Enqueue a message that can be dequeued delta ticks from now.
+     *
+     * The consumer of the buffer may run on another event queue than
+     * the sender, which makes the buffer a synchronization boundary
+     * between the two queues. The message is then only inserted when
+     * the consumer's queue gets to its arrival time. Queues are only
+     * kept in step at quantum boundaries, so such messages have to take
+     * at least a simulation quantum, and the buffer has to be unbounded
+     * since the sender can't see its occupancy. The sender must not
+     * keep any reference to the message once it is enqueued.
+     */
     void enqueue(MsgPtr message, Tick curTime, Tick delta);
 
     // Defer enqueueing a message to a later cycle by putting it aside and not
@@ -179,7 +191,13 @@ class MessageBuffer : public SimObject
     }
 
   private:
-    void reanalyzeList(std::list<MsgPtr> &, Tick);
+    void reanalyzeList(MsgList &, Tick);
+
+    /** Insert a message sent at current_time into the heap. */
+    void insert(MsgPtr message, Tick current_time, Tick arrival_time);
+
+    /** Hand a message over to a consumer on another event queue. */
+    void enqueueRemote(MsgPtr message, Tick current_time, Tick delta);
 
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
@@ -191,10 +209,6 @@ class MessageBuffer : public SimObject
 
     std::function<void()> m_dequeue_callback;
 
-    // use a std::map for the stalled messages as this container is
-    // sorted and ensures a well-defined iteration order
-    typedef std::map<Addr, std::list<MsgPtr> > StallMsgMapType;
-
     /**
      * A map from line addresses to lists of stalled messages for that line.
      * If this buffer allows the receiver to stall messages, on a stall
@@ -208,15 +222,14 @@ class MessageBuffer : public SimObject
      * moved back to the m_prio_heap in the same order. This prevents starving
      * older requests with younger ones.
      */
-    StallMsgMapType m_stall_msg_map;
+    MsgListTable m_stall_msg_map;
 
     /**
      * A map from line addresses to corresponding vectors of messages that
      * are deferred for enqueueing. Messages in this map are waiting to be
      * enqueued into the message buffer.
      */
-    typedef std::unordered_map<Addr, std::vector<MsgPtr>> DeferredMsgMapType;
-    DeferredMsgMapType m_deferred_msg_map;
+    MsgListTable m_deferred_msg_map;
 
     /**
      * Current size of the stall map.
@@ -261,6 +274,7 @@ class MessageBuffer : public SimObject
     Stats::Average m_buf_msgs;
     Stats::Average m_stall_time;
     Stats::Scalar m_stall_count;
+    Stats::Histogram m_stall_depth;
     Stats::Formula m_occupancy;
 };
 
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_MSGLISTTABLE_HH__
+#define __MEM_RUBY_NETWORK_MSGLISTTABLE_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+
+/**
+ * First in, first out list of messages. The list is threaded through
+ * the messages themselves, so adding a message doesn't allocate
+ * anything, but a message can only be in one list at a time.
+ */
+class MsgList
+{
+  private:
+    MsgPtr head;
+    Message *tail = nullptr;
+    size_t count = 0;
+
+  public:
+    MsgList() = default;
+    MsgList(MsgList &&other) { *this = std::move(other); }
+
+    MsgList &
+    operator=(MsgList &&other)
+    {
+        clear();
+        head = std::move(other.head);
+        tail = other.tail;
+        count = other.count;
+        other.tail = nullptr;
+        other.count = 0;
+        return *this;
+    }
+
+    ~MsgList() { clear(); }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    void
+    push_back(const MsgPtr &msg)
+    {
+        assert(!msg->m_next_in_list);
+        if (tail)
+            tail->m_next_in_list = msg;
+        else
+            head = msg;
+        tail = msg.get();
+        count++;
+    }
+
+    MsgPtr
+    pop_front()
+    {
+        assert(count);
+        MsgPtr msg = std::move(head);
+        head = std::move(msg->m_next_in_list);
+        if (--count == 0)
+            tail = nullptr;
+        return msg;
+    }
+
+    /** Call f on every message of the list, from the oldest one. */
+    template <class F>
+    void
+    forEach(F f) const
+    {
+        for (Message *msg = head.get(); msg; msg = msg->m_next_in_list.get())
+            f(msg);
+    }
+
+    void
+    clear()
+    {
+        // Unlink the messages one by one rather than letting the chain
+        // of pointers destroy itself recursively
+        while (count)
+            pop_front();
+    }
+};
+
+/**
+ * Lists of messages indexed by line address. This is an open-addressed
+ * table with linear probing, so finding the list of an address takes a
+ * few probes of a contiguous array of keys. Inserting or erasing a list
+ * may move the other lists within the table.
+ */
+class MsgListTable
+{
+  private:
+    /** Key of the empty slots. Line addresses are aligned. */
+    static const Addr EmptyKey = MaxAddr;
+
+    /** Initial number of slots, a power of 2. */
+    static const size_t MinSlots = 16;
+
+    std::vector<Addr> keys;
+    std::vector<MsgList> lists;
+    size_t mask = 0;
+    unsigned shift = 0;
+    size_t count = 0;
+
+    /** Slot where the probe sequence of an address starts. */
+    size_t
+    home(Addr addr) const
+    {
+        // Fibonacci hashing, the high bits of the product depend on all
+        // the bits of the address
+        return (addr * 0x9E3779B97F4A7C15ULL) >> shift;
+    }
+
+    size_t next(size_t slot) const { return (slot + 1) & mask; }
+
+    size_t
+    findSlot(Addr addr) const
+    {
+        for (size_t slot = home(addr); ; slot = next(slot)) {
+            if (keys[slot] == addr || keys[slot] == EmptyKey)
+                return slot;
+        }
+    }
+
+    void
+    rehash(size_t num_slots)
+    {
+        std::vector<Addr> old_keys(num_slots, Addr(EmptyKey));
+        std::vector<MsgList> old_lists(num_slots);
+        old_keys.swap(keys);
+        old_lists.swap(lists);
+        mask = num_slots - 1;
+        shift = 64 - floorLog2(num_slots);
+
+        for (size_t i = 0; i < old_keys.size(); i++) {
+            if (old_keys[i] == EmptyKey)
+                continue;
+            size_t slot = home(old_keys[i]);
+            while (keys[slot] != EmptyKey)
+                slot = next(slot);
+            keys[slot] = old_keys[i];
+            lists[slot] = std::move(old_lists[i]);
+        }
+    }
+
+  public:
+    MsgListTable() { rehash(MinSlots); }
+
+    /** Number of addresses with a list. */
+    size_t size() const { return count; }
+
+    /** Get the list of an address, nullptr if it has none. */
+    MsgList *
+    find(Addr addr)
+    {
+        size_t slot = findSlot(addr);
+        return keys[slot] == addr ? &lists[slot] : nullptr;
+    }
+
+    const MsgList *
+    find(Addr addr) const
+    {
+        size_t slot = findSlot(addr);
+        return keys[slot] == addr ? &lists[slot] : nullptr;
+    }
+
+    /** Get the list of an address, creating an empty one if needed. */
+    MsgList &
+    operator[](Addr addr)
+    {
+        assert(addr != EmptyKey);
+        // Keep the load factor at or below 1/2, so that missing
+        // addresses are found to be missing after a few probes
+        if (2 * (count + 1) > keys.size())
+            rehash(2 * keys.size());
+
+        size_t slot = findSlot(addr);
+        if (keys[slot] == EmptyKey) {
+            keys[slot] = addr;
+            count++;
+        }
+        return lists[slot];
+    }
+
+    /**
+     * Take the list of an address out of the table. The following
+     * lists of its probe sequence are shifted back, so that no
+     * tombstones are needed.
+     */
+    MsgList
+    take(Addr addr)
+    {
+        size_t slot = findSlot(addr);
+        assert(keys[slot] == addr);
+        MsgList list = std::move(lists[slot]);
+
+        size_t hole = slot;
+        for (size_t i = next(slot); keys[i] != EmptyKey; i = next(i)) {
+            // A list can fill the hole if the hole lies between the
+            // list's home slot and its current slot
+            const size_t ideal = home(keys[i]);
+            if (((i - ideal) & mask) >= ((i - hole) & mask)) {
+                keys[hole] = keys[i];
+                lists[hole] = std::move(lists[i]);
+                hole = i;
+            }
+        }
+        keys[hole] = EmptyKey;
+        count--;
+        return list;
+    }
+
+    /** Call f on the address and list of every entry of the table. */
+    template <class F>
+    void
+    forEach(F f)
+    {
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (keys[i] != EmptyKey)
+                f(keys[i], lists[i]);
+        }
+    }
+
+    void
+    clear()
+    {
+        if (!count)
+            return;
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (keys[i] != EmptyKey) {
+                keys[i] = EmptyKey;
+                lists[i].clear();
+            }
+        }
+        count = 0;
+    }
+};
+
+#endif // __MEM_RUBY_NETWORK_MSGLISTTABLE_HH__
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/network/analytical/AnalyticalNetwork.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/RubyNetwork.hh"
+#include "mem/ruby/network/BasicLink.hh"
+#include "mem/ruby/network/BasicRouter.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+
+AnalyticalNetwork::AnalyticalNetwork(const Params &p)
+    : Network(p), Consumer(this), m_sample_period(p.sample_period),
+      m_max_utilization(p.max_utilization), networkStats(this)
+{
+    fatal_if(m_sample_period == 0, "%s: The sample period must be "
+             "non-zero.\n", name());
+    fatal_if(m_max_utilization <= 0 || m_max_utilization >= 1,
+             "%s: The maximum utilization must be between 0 and 1.\n",
+             name());
+
+    for (auto *router : p.routers) {
+        const int id = router->params().router_id;
+        assert(id >= 0);
+        if (id >= m_router_latency.size())
+            m_router_latency.resize(id + 1, Cycles(0));
+        m_router_latency[id] = Cycles(router->params().latency);
+    }
+    m_router_links.resize(m_router_latency.size());
+    m_node_links.resize(m_nodes, -1);
+}
+
+void
+AnalyticalNetwork::init()
+{
+    Network::init();
+
+    // The topology pointer should have already been initialized in
+    // the parent class network constructor.
+    assert(m_topology_ptr != NULL);
+    m_topology_ptr->createLinks(this);
+
+    m_last_arrival.resize(m_nodes);
+    for (NodeID node = 0; node < m_nodes; node++)
+        m_last_arrival[node].resize(m_fromNetQueues[node].size(), 0);
+}
+
+int
+AnalyticalNetwork::addLink(BasicLink *link, int dest_router,
+                           NodeID dest_node,
+                           const std::vector<NetDest> &routing_table_entry)
+{
+    fatal_if(link->m_bandwidth_factor <= 0, "%s: The bandwidth factor "
+             "of a link must be positive.\n", link->name());
+    assert(dest_router < (int)m_router_links.size());
+
+    Link l;
+    l.latency = link->m_latency;
+    l.bandwidth = link->m_bandwidth_factor;
+    l.dest_router = dest_router;
+    l.dest_node = dest_node;
+    l.routes = routing_table_entry;
+    m_links.push_back(l);
+    return m_links.size() - 1;
+}
+
+// From a router to an endpoint node
+void
+AnalyticalNetwork::makeExtOutLink(SwitchID src, NodeID global_dest,
+                                  BasicLink* link,
+                                  std::vector<NetDest>& routing_table_entry)
+{
+    NodeID local_dest = getLocalNodeID(global_dest);
+    assert(local_dest < m_nodes);
+    assert(src < m_router_links.size());
+
+    m_router_links[src].push_back(
+        addLink(link, -1, local_dest, routing_table_entry));
+}
+
+// From an endpoint node to a router
+void
+AnalyticalNetwork::makeExtInLink(NodeID global_src, SwitchID dest,
+                                 BasicLink* link,
+                                 std::vector<NetDest>& routing_table_entry)
+{
+    NodeID local_src = getLocalNodeID(global_src);
+    assert(local_src < m_nodes);
+
+    m_node_links[local_src] = addLink(link, dest, 0, routing_table_entry);
+    for (auto *buffer : m_toNetQueues[local_src]) {
+        if (buffer != nullptr)
+            buffer->setConsumer(this);
+    }
+}
+
+// From a router to a router
+void
+AnalyticalNetwork::makeInternalLink(SwitchID src, SwitchID dest,
+                                    BasicLink* link,
+                                    std::vector<NetDest>& routing_table_entry,
+                                    PortDirection src_outport,
+                                    PortDirection dst_inport)
+{
+    assert(src < m_router_links.size());
+    m_router_links[src].push_back(
+        addLink(link, dest, 0, routing_table_entry));
+}
+
+void
+AnalyticalNetwork::wakeup()
+{
+    const Tick current_time = clockEdge();
+
+    for (NodeID node = 0; node < m_nodes; node++) {
+        for (int vnet = 0; vnet < m_toNetQueues[node].size(); vnet++) {
+            MessageBuffer *buffer = m_toNetQueues[node][vnet];
+            if (buffer == nullptr)
+                continue;
+
+            while (buffer->isReady(current_time)) {
+                if (!sendMessage(buffer, node, vnet, current_time)) {
+                    // Try again once the destination has made room
+                    networkStats.stallCount++;
+                    scheduleEvent(Cycles(1));
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool
+AnalyticalNetwork::sendMessage(MessageBuffer *buffer, NodeID src, int vnet,
+                               Tick current_time)
+{
+    MsgPtr msg_ptr = buffer->peekMsgPtr();
+    const int bytes = MessageSizeType_to_int(msg_ptr->getMessageSize());
+
+    m_deliveries.clear();
+    m_used_links.clear();
+    assert(m_node_links[src] >= 0);
+    route(m_node_links[src], vnet, msg_ptr->getDestination(), bytes,
+          Cycles(0), Cycles(0), Cycles(0), 0);
+
+    for (const auto &delivery : m_deliveries) {
+        const auto &queues = m_fromNetQueues[delivery.node];
+        panic_if(vnet >= queues.size() || queues[vnet] == nullptr,
+                 "%s: Node %d has no buffer for vnet %d.\n", name(),
+                 delivery.node, vnet);
+        if (!queues[vnet]->areNSlotsAvailable(1, current_time))
+            return false;
+    }
+
+    DPRINTF(RubyNetwork, "Sending message from node %d on vnet %d to "
+            "%d nodes: %s\n", src, vnet, m_deliveries.size(), *msg_ptr);
+
+    buffer->dequeue(current_time);
+    for (int link_id : m_used_links)
+        m_links[link_id].window_bytes += bytes;
+
+    networkStats.msgBytes += bytes;
+    for (int i = 0; i < m_deliveries.size(); i++) {
+        const Delivery &delivery = m_deliveries[i];
+
+        // Every destination but the last gets a private copy of the
+        // message, as enqueueing it modifies it
+        MsgPtr out_msg_ptr = msg_ptr;
+        if (i + 1 < m_deliveries.size())
+            out_msg_ptr = msg_ptr->clone();
+        out_msg_ptr->getDestination() = delivery.destination;
+
+        // The estimated delays change over time, so a message may be
+        // estimated to arrive before the previous one. Hold it back to
+        // keep the destination buffer in order.
+        Tick arrival_time = current_time + cyclesToTicks(delivery.latency);
+        Tick &last_arrival = m_last_arrival[delivery.node][vnet];
+        arrival_time = std::max(arrival_time, last_arrival);
+        last_arrival = arrival_time;
+
+        m_fromNetQueues[delivery.node][vnet]->enqueue(
+            out_msg_ptr, current_time, arrival_time - current_time);
+
+        networkStats.msgCount++;
+        networkStats.totalLatency += delivery.latency;
+        networkStats.totalQueueingLatency += delivery.queueing;
+        networkStats.totalHops += delivery.hops;
+    }
+
+    return true;
+}
+
+void
+AnalyticalNetwork::route(int link_id, int vnet, const NetDest &dests,
+                         int bytes, Cycles latency, Cycles queueing,
+                         Cycles serialization, int hops)
+{
+    Link &link = m_links[link_id];
+    m_used_links.push_back(link_id);
+
+    const Cycles wait = queueingDelay(link, bytes);
+    latency += link.latency + wait;
+    queueing += wait;
+    serialization = std::max(serialization,
+                             Cycles(divCeil(bytes, link.bandwidth)));
+
+    if (link.dest_router < 0) {
+        m_deliveries.push_back({ link.dest_node, dests,
+                                 std::max(latency + serialization,
+                                          Cycles(1)),
+                                 queueing, hops });
+        return;
+    }
+
+    // Fork the message at the router, in the same way as the switches
+    // of the simple network
+    latency += m_router_latency[link.dest_router];
+    NetDest remaining = dests;
+    for (int out : m_router_links[link.dest_router]) {
+        const NetDest &reachable = m_links[out].routes[vnet];
+        if (!remaining.intersectionIsNotEmpty(reachable))
+            continue;
+        route(out, vnet, remaining.AND(reachable), bytes, latency,
+              queueing, serialization, hops + 1);
+        remaining.removeNetDest(reachable);
+    }
+}
+
+Cycles
+AnalyticalNetwork::queueingDelay(Link &link, int bytes)
+{
+    const Cycles now = curCycle();
+    if (now >= link.window_start + m_sample_period) {
+        link.utilization = double(link.window_bytes) /
+            (double(link.bandwidth) * (now - link.window_start));
+        link.window_start = now;
+        link.window_bytes = 0;
+    }
+
+    // Mean waiting time of an M/D/1 queue
+    const double rho = std::min(link.utilization, m_max_utilization);
+    const double service = double(bytes) / link.bandwidth;
+    return Cycles(std::llround(service * rho / (2 * (1 - rho))));
+}
+
+void
+AnalyticalNetwork::print(std::ostream& out) const
+{
+    out << "[AnalyticalNetwork]";
+}
+
+AnalyticalNetwork::
+NetworkStats::NetworkStats(Stats::Group *parent)
+    : Stats::Group(parent),
+      ADD_STAT(msgCount, "Number of messages delivered"),
+      ADD_STAT(msgBytes, "Number of bytes sent"),
+      ADD_STAT(stallCount, "Number of times a message couldn't be sent "
+                           "because a destination buffer was full"),
+      ADD_STAT(totalLatency, "Total latency of the messages (cycles)"),
+      ADD_STAT(totalQueueingLatency, "Total estimated queueing latency of "
+                                     "the messages (cycles)"),
+      ADD_STAT(totalHops, "Total number of routers traversed"),
+      ADD_STAT(avgLatency, "Average latency of the messages (cycles)"),
+      ADD_STAT(avgQueueingLatency, "Average estimated queueing latency "
+                                   "of the messages (cycles)"),
+      ADD_STAT(avgHops, "Average number of routers traversed")
+{
+    avgLatency = totalLatency / msgCount;
+    avgQueueingLatency = totalQueueingLatency / msgCount;
+    avgHops = totalHops / msgCount;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * A network that doesn't model switches and link buffers. When a
+ * message is sent, its latency to each destination is computed from
+ * the hops of its route, the bandwidth of the links and a queueing
+ * model of their contention, and it is put in the destination buffer
+ * right away to arrive after that latency. A message thus costs one
+ * wakeup of the network instead of one per hop.
+ *
+ * Each link is modelled as an M/D/1 queue. Its utilization is measured
+ * over windows of sample_period cycles, and the queueing delay of a
+ * message is estimated from the utilization of the previous window.
+ * Messages cut through the routers, so they are only serialized once,
+ * on the narrowest link of their route.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALNETWORK_HH__
+#define __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALNETWORK_HH__
+
+#include <iostream>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/network/Network.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+#include "params/AnalyticalNetwork.hh"
+
+class AnalyticalNetwork : public Network, public Consumer
+{
+  public:
+    typedef AnalyticalNetworkParams Params;
+    AnalyticalNetwork(const Params &p);
+    ~AnalyticalNetwork() = default;
+
+    void init();
+
+    // Methods used by Topology to setup the network
+    void makeExtOutLink(SwitchID src, NodeID dest, BasicLink* link,
+                     std::vector<NetDest>& routing_table_entry);
+    void makeExtInLink(NodeID src, SwitchID dest, BasicLink* link,
+                    std::vector<NetDest>& routing_table_entry);
+    void makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
+                          std::vector<NetDest>& routing_table_entry,
+                          PortDirection src_outport,
+                          PortDirection dst_inport);
+
+    void wakeup();
+    void collateStats() {}
+    void print(std::ostream& out) const;
+
+    // Messages are never held by the network, they are either in the
+    // buffers of the sender or in those of the receiver.
+    bool functionalRead(Packet *pkt) { return false; }
+    bool functionalRead(Packet *pkt, WriteMask &mask) { return false; }
+    uint32_t functionalWrite(Packet *pkt) { return 0; }
+
+  private:
+    struct Link
+    {
+        Cycles latency;
+        /** Bytes per cycle. */
+        int bandwidth;
+        /** Router at the end of the link, -1 for a link to a node. */
+        int dest_router;
+        NodeID dest_node;
+        /** Destinations reached through the link, by vnet. */
+        std::vector<NetDest> routes;
+
+        /** Utilization measured during the last window. */
+        double utilization = 0;
+        Cycles window_start = Cycles(0);
+        uint64_t window_bytes = 0;
+    };
+
+    /** A copy of a message to deliver to a node. */
+    struct Delivery
+    {
+        NodeID node;
+        NetDest destination;
+        Cycles latency;
+        Cycles queueing;
+        int hops;
+    };
+
+    int addLink(BasicLink *link, int dest_router, NodeID dest_node,
+                const std::vector<NetDest> &routing_table_entry);
+
+    /**
+     * Send the message at the head of the buffer of a node, unless one
+     * of its destination buffers is full.
+     *
+     * @return Whether the message could be sent.
+     */
+    bool sendMessage(MessageBuffer *buffer, NodeID src, int vnet,
+                     Tick current_time);
+
+    /**
+     * Follow the route of a message through a link, and record one
+     * delivery for each node it reaches.
+     */
+    void route(int link_id, int vnet, const NetDest &dests, int bytes,
+               Cycles latency, Cycles queueing, Cycles serialization,
+               int hops);
+
+    /** Estimated queueing delay of a message on a link. */
+    Cycles queueingDelay(Link &link, int bytes);
+
+    // Private copy constructor and assignment operator
+    AnalyticalNetwork(const AnalyticalNetwork& obj);
+    AnalyticalNetwork& operator=(const AnalyticalNetwork& obj);
+
+    const Cycles m_sample_period;
+    const double m_max_utilization;
+
+    std::vector<Link> m_links;
+    /** Latency of each router. */
+    std::vector<Cycles> m_router_latency;
+    /** Links leaving each router. */
+    std::vector<std::vector<int>> m_router_links;
+    /** Link from each node into the network. */
+    std::vector<int> m_node_links;
+    /** Arrival time of the last message put in each destination buffer. */
+    std::vector<std::vector<Tick>> m_last_arrival;
+
+    // Scratch space for sendMessage()
+    std::vector<Delivery> m_deliveries;
+    std::vector<int> m_used_links;
+
+    struct NetworkStats : public Stats::Group
+    {
+        NetworkStats(Stats::Group *parent);
+
+        Stats::Scalar msgCount;
+        Stats::Scalar msgBytes;
+        Stats::Scalar stallCount;
+        Stats::Scalar totalLatency;
+        Stats::Scalar totalQueueingLatency;
+        Stats::Scalar totalHops;
+        Stats::Formula avgLatency;
+        Stats::Formula avgQueueingLatency;
+        Stats::Formula avgHops;
+    } networkStats;
+};
+
+inline std::ostream&
+operator<<(std::ostream& out, const AnalyticalNetwork& obj)
+{
+    obj.print(out);
+    out << std::flush;
+    return out;
+}
+
+#endif // __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALNETWORK_HH__
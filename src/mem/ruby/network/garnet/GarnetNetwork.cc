@@ -31,6 +31,7 @@
 
 #include "mem/ruby/network/garnet/GarnetNetwork.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/cast.hh"
@@ -52,7 +53,10 @@
  */
 
 GarnetNetwork::GarnetNetwork(const Params &p)
-    : Network(p)
+    : Network(p), m_util_trace(nullptr),
+      m_util_interval(p.utilization_interval),
+      m_util_event([this]{ sampleUtilization(); },
+                   name() + ".utilizationSample")
 {
     m_num_rows = p.num_rows;
     m_ni_flit_size = p.ni_flit_size;
@@ -94,6 +98,18 @@ GarnetNetwork::GarnetNetwork(const Params &p)
 
     // Print Garnet version
     inform("Garnet version %s\n", garnetVersion);
+
+    if (!p.utilization_trace.empty()) {
+        fatal_if(m_util_interval == 0, "%s: The utilization sampling "
+                 "interval must be non-zero.\n", name());
+        m_util_trace = simout.create(p.utilization_trace, true);
+    }
+}
+
+GarnetNetwork::~GarnetNetwork()
+{
+    if (m_util_trace)
+        simout.close(m_util_trace);
 }
 
 void
@@ -110,6 +126,11 @@ GarnetNetwork::init()
     assert(m_topology_ptr != NULL);
     m_topology_ptr->createLinks(this);
 
+    // All the routes are known now
+    for (auto *router : m_routers)
+        router->compileRoutingTable();
+    assert(m_link_ends.size() == m_networklinks.size());
+
     // Initialize topology specific parameters
     if (getNumRows() > 0) {
         // Only for Mesh topology
@@ -164,6 +185,7 @@ GarnetNetwork::makeExtInLink(NodeID global_src, SwitchID dest, BasicLink* link,
 
     m_networklinks.push_back(net_link);
     m_creditlinks.push_back(credit_link);
+    m_link_ends.emplace_back(-1, dest);
 
     PortDirection dst_inport_dirn = "Local";
 
@@ -233,6 +255,7 @@ GarnetNetwork::makeExtOutLink(SwitchID src, NodeID global_dest,
 
     m_networklinks.push_back(net_link);
     m_creditlinks.push_back(credit_link);
+    m_link_ends.emplace_back(src, -1);
 
     PortDirection src_outport_dirn = "Local";
 
@@ -300,6 +323,7 @@ GarnetNetwork::makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
 
     m_networklinks.push_back(net_link);
     m_creditlinks.push_back(credit_link);
+    m_link_ends.emplace_back(src, dest);
 
     m_max_vcs_per_vnet = std::max(m_max_vcs_per_vnet,
                              std::max(m_routers[dest]->get_vc_per_vnet(),
@@ -546,6 +570,73 @@ GarnetNetwork::resetStats()
     for (int i = 0; i < m_creditlinks.size(); i++) {
         m_creditlinks[i]->resetStats();
     }
+
+    // The utilization samples count from the reset
+    std::fill(m_last_link_util.begin(), m_last_link_util.end(), 0);
+    std::fill(m_last_router_util.begin(), m_last_router_util.end(), 0);
+}
+
+namespace
+{
+
+template <typename T>
+void
+writeTraceValue(std::ostream &os, T value)
+{
+    os.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+} // anonymous namespace
+
+void
+GarnetNetwork::startup()
+{
+    Network::startup();
+
+    if (m_util_trace) {
+        writeTraceHeader();
+        schedule(m_util_event, clockEdge(m_util_interval));
+    }
+}
+
+void
+GarnetNetwork::writeTraceHeader()
+{
+    std::ostream &os = *m_util_trace->stream();
+    os.write("GARNETUT", 8);
+    writeTraceValue<uint32_t>(os, 1);
+    writeTraceValue<int32_t>(os, m_num_rows);
+    writeTraceValue<uint32_t>(os, m_routers.size());
+    writeTraceValue<uint32_t>(os, m_networklinks.size());
+    writeTraceValue<uint64_t>(os, cyclesToTicks(m_util_interval));
+    for (int i = 0; i < m_networklinks.size(); i++) {
+        writeTraceValue<int32_t>(os, m_link_ends[i].first);
+        writeTraceValue<int32_t>(os, m_link_ends[i].second);
+        writeTraceValue<uint32_t>(os, m_networklinks[i]->getType());
+    }
+
+    m_last_link_util.assign(m_networklinks.size(), 0);
+    m_last_router_util.assign(m_routers.size(), 0);
+}
+
+void
+GarnetNetwork::sampleUtilization()
+{
+    std::ostream &os = *m_util_trace->stream();
+    writeTraceValue<uint64_t>(os, curTick());
+    for (int i = 0; i < m_networklinks.size(); i++) {
+        const uint64_t flits = m_networklinks[i]->getLinkUtilization();
+        writeTraceValue<uint32_t>(os, flits - m_last_link_util[i]);
+        m_last_link_util[i] = flits;
+    }
+    for (int i = 0; i < m_routers.size(); i++) {
+        const uint64_t flits = m_routers[i]->get_crossbar_activity();
+        writeTraceValue<uint32_t>(os, flits - m_last_router_util[i]);
+        m_last_router_util[i] = flits;
+    }
+    os.flush();
+
+    schedule(m_util_event, clockEdge(m_util_interval));
 }
 
 void
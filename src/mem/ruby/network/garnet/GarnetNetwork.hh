@@ -33,8 +33,10 @@
 #define __MEM_RUBY_NETWORK_GARNET_0_GARNETNETWORK_HH__
 
 #include <iostream>
+#include <utility>
 #include <vector>
 
+#include "base/output.hh"
 #include "mem/ruby/network/Network.hh"
 #include "mem/ruby/network/fault_model/FaultModel.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
@@ -52,9 +54,10 @@ class GarnetNetwork : public Network
   public:
     typedef GarnetNetworkParams Params;
     GarnetNetwork(const Params &p);
-    ~GarnetNetwork() = default;
+    ~GarnetNetwork();
 
     void init();
+    void startup();
 
     const char *garnetVersion = "3.0";
 
@@ -189,6 +192,36 @@ class GarnetNetwork : public Network
     GarnetNetwork(const GarnetNetwork& obj);
     GarnetNetwork& operator=(const GarnetNetwork& obj);
 
+    /**
+     * @defgroup utilization_trace Utilization trace
+     *
+     * The number of flits sent over each flit link and through the
+     * crossbar of each router are sampled every utilization_interval
+     * cycles. The trace file starts with a header:
+     *     char magic[8] = "GARNETUT", uint32_t version = 1,
+     *     int32_t num_rows, uint32_t num_routers, uint32_t num_links,
+     *     uint64_t interval (ticks),
+     *     then for each link: int32_t src, int32_t dst, uint32_t type,
+     * where src and dst are router ids, or -1 for an NI, and type is a
+     * link_type. It is followed by one record per sample:
+     *     uint64_t tick, uint32_t flits[num_links],
+     *     uint32_t flits[num_routers],
+     * counting the flits since the previous sample. All values are in
+     * host byte order.
+     * @{
+     */
+    void writeTraceHeader();
+    void sampleUtilization();
+
+    OutputStream *m_util_trace;
+    const Cycles m_util_interval;
+    EventFunctionWrapper m_util_event;
+    /** The routers at both ends of each flit link, -1 for an NI. */
+    std::vector<std::pair<int, int>> m_link_ends;
+    std::vector<uint64_t> m_last_link_util;
+    std::vector<uint64_t> m_last_router_util;
+    /** @} */
+
     std::vector<VNET_type > m_vnet_type;
     std::vector<Router *> m_routers;   // All Routers in Network
     std::vector<NetworkLink *> m_networklinks; // All flit links in the network
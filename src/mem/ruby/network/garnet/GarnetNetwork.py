@@ -48,6 +48,13 @@ class GarnetNetwork(RubyNetwork):
     fault_model = Param.FaultModel(NULL, "network fault model");
     garnet_deadlock_threshold = Param.UInt32(50000,
                               "network-level deadlock threshold")
+    num_regions = Param.UInt32(1, "number of router regions, each "
+                               "simulated on an event queue of its own")
+    utilization_trace = Param.String("", "file the utilization of each "
+        "link and router is sampled to, empty to disable (see "
+        "util/garnet_heatmap.py)")
+    utilization_interval = Param.Cycles(10000, "cycles between two "
+                                        "utilization samples")
 
 class GarnetNetworkInterface(ClockedObject):
     type = 'GarnetNetworkInterface'
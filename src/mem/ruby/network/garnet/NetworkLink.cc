@@ -35,6 +35,7 @@
 #include "base/trace.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/CreditLink.hh"
+#include "sim/eventq.hh"
 
 NetworkLink::NetworkLink(const Params &p)
     : ClockedObject(p), Consumer(this), m_id(p.link_id),
@@ -66,6 +67,9 @@ NetworkLink::setVcsPerVnet(uint32_t consumerVcs)
 void
 NetworkLink::setSourceQueue(flitBuffer *src_queue, ClockedObject *srcClockObj)
 {
+    fatal_if(srcClockObj->eventQueue() != eventQueue(), "%s: A link must "
+             "be on the event queue of %s, which sends through it.\n",
+             name(), srcClockObj->name());
     link_srcQueue = src_queue;
     src_object = srcClockObj;
 }
@@ -89,17 +93,51 @@ NetworkLink::wakeup()
                 (mVnets.size() == 0));
         }
         t_flit->set_time(clockEdge(m_latency));
-        linkBuffer.insert(t_flit);
-        link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        if (inParallelMode &&
+            link_consumer->getObject()->eventQueue() != curEventQueue()) {
+            sendRemote(t_flit);
+        } else {
+            linkBuffer.insert(t_flit);
+            link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        }
         m_link_utilized++;
         m_vc_load[t_flit->get_vc()]++;
     }
 
     if (!link_srcQueue->isEmpty()) {
-        scheduleEvent(Cycles(1));
+        // Wake up once the next flit can be sent, rather than every
+        // cycle until then. Flits inserted later schedule their own
+        // wakeup.
+        Tick next_flit_time = link_srcQueue->peekTopFlit()->get_time();
+        Cycles delay(1);
+        if (next_flit_time > curTick()) {
+            delay = std::max(delay,
+                             ticksToCycles(next_flit_time - curTick()));
+        }
+        scheduleEvent(delay);
     }
 }
 
+void
+NetworkLink::sendRemote(flit *t_flit)
+{
+    const Tick arrival_time = t_flit->get_time();
+    fatal_if(arrival_time - curTick() < simQuantum, "%s: Links between "
+             "event queues must take at least a simulation quantum (%d "
+             "ticks), not %d.\n", name(), simQuantum,
+             arrival_time - curTick());
+
+    // The flit and the link buffer are only touched again once the
+    // consumer's queue gets to the arrival time, on its own thread.
+    link_consumer->getObject()->eventQueue()->schedule(
+        new EventFunctionWrapper([this, t_flit, arrival_time]
+            {
+                linkBuffer.insert(t_flit);
+                link_consumer->scheduleEventAbsolute(arrival_time);
+            }, name() + ".remoteDelivery", true),
+        arrival_time);
+}
+
 void
 NetworkLink::resetStats()
 {
@@ -79,6 +79,13 @@ class NetworkLink : public ClockedObject, public Consumer
     uint32_t bitWidth;
 
   private:
+    /**
+     * Hand a flit over to a consumer on another event queue. The link
+     * is then a synchronization boundary between the two queues, and
+     * its latency has to be at least a simulation quantum.
+     */
+    void sendRemote(flit *t_flit);
+
     const int m_id;
     link_type m_type;
     const Cycles m_latency;
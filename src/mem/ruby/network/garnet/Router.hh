@@ -79,6 +79,8 @@ class Router : public BasicRouter, public Consumer
     int get_num_inports()   { return m_input_unit.size(); }
     int get_num_outports()  { return m_output_unit.size(); }
     int get_id()            { return m_id; }
+    double get_crossbar_activity()
+    { return crossbarSwitch.get_crossbar_activity(); }
 
     void init_net_ptr(GarnetNetwork* net_ptr)
     {
@@ -107,6 +109,7 @@ class Router : public BasicRouter, public Consumer
     PortDirection getInportDirection(int inport);
 
     int route_compute(RouteInfo route, int inport, PortDirection direction);
+    void compileRoutingTable() { routingUnit.compileRoutingTable(); }
     void grant_switch(int inport, flit *t_flit);
     void schedule_wakeup(Cycles time);
 
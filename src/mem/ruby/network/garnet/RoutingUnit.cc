@@ -37,6 +37,7 @@
 #include "mem/ruby/slicc_interface/Message.hh"
 
 RoutingUnit::RoutingUnit(Router *router)
+    : m_num_dests(0)
 {
     m_router = router;
     m_routing_table.clear();
@@ -134,6 +135,66 @@ RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
     return output_link;
 }
 
+void
+RoutingUnit::compileRoutingTable()
+{
+    m_num_dests = MachineType_base_number(MachineType_NUM);
+    m_compiled_routes.assign(m_routing_table.size() * m_num_dests,
+                             CompiledRoute{0, 0});
+    m_route_candidates.clear();
+
+    for (int vnet = 0; vnet < m_routing_table.size(); vnet++) {
+        for (int m = 0; m < MachineType_NUM; m++) {
+            const MachineType type = (MachineType)m;
+            for (int num = 0; num < MachineType_base_count(type); num++) {
+                const MachineID dest = {type, (NodeID)num};
+                const int dest_ni = MachineType_base_number(type) + num;
+                CompiledRoute &route =
+                    m_compiled_routes[vnet * m_num_dests + dest_ni];
+
+                // Same selection as lookupRoutingTable()
+                int min_weight = INFINITE_;
+                for (int link = 0; link < m_routing_table[vnet].size();
+                     link++) {
+                    if (m_routing_table[vnet][link].isElement(dest))
+                        min_weight = std::min(min_weight,
+                                              m_weight_table[link]);
+                }
+
+                route.first = m_route_candidates.size();
+                for (int link = 0; link < m_routing_table[vnet].size();
+                     link++) {
+                    if (m_routing_table[vnet][link].isElement(dest) &&
+                        m_weight_table[link] == min_weight) {
+                        assert(link <= UINT16_MAX);
+                        m_route_candidates.push_back(link);
+                    }
+                }
+                route.count = m_route_candidates.size() - route.first;
+            }
+        }
+    }
+}
+
+int
+RoutingUnit::lookupCompiledTable(int vnet, int dest_ni)
+{
+    assert(dest_ni < m_num_dests);
+    const CompiledRoute &route =
+        m_compiled_routes[vnet * m_num_dests + dest_ni];
+
+    if (route.count == 0) {
+        fatal("Fatal Error:: No Route exists from this Router.");
+    }
+
+    // Randomly select any candidate output link, calling rand() exactly
+    // when lookupRoutingTable() would
+    int candidate = 0;
+    if (!(m_router->get_net_ptr())->isVNetOrdered(vnet))
+        candidate = rand() % route.count;
+
+    return m_route_candidates[route.first + candidate];
+}
 
 void
 RoutingUnit::addInDirection(PortDirection inport_dirn, int inport_idx)
@@ -166,7 +227,7 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
         // Multiple NIs may be connected to this router,
         // all with output port direction = "Local"
         // Get exact outport id from table
-        outport = lookupRoutingTable(route.vnet, route.net_dest);
+        outport = lookupCompiledTable(route.vnet, route.dest_ni);
         return outport;
     }
 
@@ -177,14 +238,14 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
 
     switch (routing_algorithm) {
         case TABLE_:  outport =
-            lookupRoutingTable(route.vnet, route.net_dest); break;
+            lookupCompiledTable(route.vnet, route.dest_ni); break;
         case XY_:     outport =
             outportComputeXY(route, inport, inport_dirn); break;
         // any custom algorithm
         case CUSTOM_: outport =
             outportComputeCustom(route, inport, inport_dirn); break;
         default: outport =
-            lookupRoutingTable(route.vnet, route.net_dest); break;
+            lookupCompiledTable(route.vnet, route.dest_ni); break;
     }
 
     assert(outport != -1);
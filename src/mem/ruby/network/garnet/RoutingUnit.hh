@@ -55,6 +55,14 @@ class RoutingUnit
     // get output port from routing table
     int  lookupRoutingTable(int vnet, NetDest net_dest);
 
+    // Precompute the candidate output ports of every (vnet, destination)
+    // pair, once all the routes have been added
+    void compileRoutingTable();
+
+    // get output port for a single destination node from the
+    // precomputed table
+    int  lookupCompiledTable(int vnet, int dest_ni);
+
     // Topology-specific direction based routing
     void addInDirection(PortDirection inport_dirn, int inport);
     void addOutDirection(PortDirection outport_dirn, int outport);
@@ -81,6 +89,18 @@ class RoutingUnit
     std::vector<std::vector<NetDest>> m_routing_table;
     std::vector<int> m_weight_table;
 
+    // Compiled routing table, indexed by vnet * m_num_dests + dest_ni.
+    // Each entry is the range of its minimum weight output ports in
+    // m_route_candidates, in increasing port order.
+    struct CompiledRoute
+    {
+        uint32_t first;
+        uint32_t count;
+    };
+    std::vector<CompiledRoute> m_compiled_routes;
+    std::vector<uint16_t> m_route_candidates;
+    int m_num_dests;
+
     // Inport and Outport direction to idx maps
     std::map<PortDirection, int> m_inports_dirn2idx;
     std::map<int, PortDirection> m_inports_idx2dirn;
@@ -123,7 +123,7 @@ SwitchAllocator::arbitrate_inports()
                 // check if the flit in this InputVC is allowed to be sent
                 // send_allowed conditions described in that function.
                 bool make_request =
-                    send_allowed(inport, invc, outport, outvc);
+                    send_allowed(inport, invc, outport, outvc, curTick());
 
                 if (make_request) {
                     m_input_arbiter_activity++;
@@ -277,7 +277,8 @@ SwitchAllocator::arbitrate_outports()
  */
 
 bool
-SwitchAllocator::send_allowed(int inport, int invc, int outport, int outvc)
+SwitchAllocator::send_allowed(int inport, int invc, int outport, int outvc,
+                              Tick time)
 {
     // Check if outvc needed
     // Check if credit needed (for multi-flit packet)
@@ -322,7 +323,7 @@ SwitchAllocator::send_allowed(int inport, int invc, int outport, int outvc)
         int vc_base = vnet*m_vc_per_vnet;
         for (int vc_offset = 0; vc_offset < m_vc_per_vnet; vc_offset++) {
             int temp_vc = vc_base + vc_offset;
-            if (input_unit->need_stage(temp_vc, SA_, curTick()) &&
+            if (input_unit->need_stage(temp_vc, SA_, time) &&
                (input_unit->get_outport(temp_vc) == outport) &&
                (input_unit->get_enqueue_time(temp_vc) < t_enqueue_time)) {
                 return false;
@@ -348,7 +349,13 @@ SwitchAllocator::vc_allocate(int outport, int inport, int invc)
 }
 
 // Wakeup the router next cycle to perform SA again
-// if there are flits ready.
+// if there are flits ready that can be sent.
+//
+// Flits that are stuck waiting for a free output VC or for a credit
+// don't need the router to wake up every cycle: allocation only changes
+// the round robin state when it grants something, and the credits that
+// unblock such flits wake up the router when they arrive. Skipping the
+// cycles in between is therefore invisible.
 void
 SwitchAllocator::check_for_wakeup()
 {
@@ -359,8 +366,11 @@ SwitchAllocator::check_for_wakeup()
     }
 
     for (int i = 0; i < m_num_inports; i++) {
+        auto input_unit = m_router->getInputUnit(i);
         for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
+            if (input_unit->need_stage(j, SA_, nextCycle) &&
+                send_allowed(i, j, input_unit->get_outport(j),
+                             input_unit->get_outvc(j), nextCycle)) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
@@ -54,7 +54,8 @@ class SwitchAllocator : public Consumer
     void print(std::ostream& out) const {};
     void arbitrate_inports();
     void arbitrate_outports();
-    bool send_allowed(int inport, int invc, int outport, int outvc);
+    bool send_allowed(int inport, int invc, int outport, int outvc,
+                      Tick time);
     int vc_allocate(int outport, int inport, int invc);
 
     inline double
@@ -35,6 +35,7 @@
 #include <iostream>
 
 #include "base/types.hh"
+#include "mem/mem_pool.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 
@@ -47,6 +48,29 @@ class flit
 
     virtual ~flit(){};
 
+    /**
+     * @{
+     * Flits and credits are allocated from the memory system object
+     * pool. They have a single owner which deletes them once they
+     * have been consumed, so they don't need to be reference counted.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        return memPool().allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        memPool().deallocate(p, size);
+    }
+
+    // The class specific operator new hides the placement forms.
+    static void *operator new(size_t size, void *p) { return p; }
+    static void operator delete(void *p, void *place) {}
+    /** @} */
+
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
     Tick get_enqueue_time() { return m_enqueue_time; }
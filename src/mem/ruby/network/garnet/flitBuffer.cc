@@ -32,25 +32,37 @@
 #include "mem/ruby/network/garnet/flitBuffer.hh"
 
 flitBuffer::flitBuffer()
+    : m_buffer(4), m_head(0), m_count(0)
 {
     max_size = INFINITE_;
 }
 
 flitBuffer::flitBuffer(int maximum_size)
+    : m_buffer(4), m_head(0), m_count(0)
 {
     max_size = maximum_size;
 }
 
+void
+flitBuffer::grow()
+{
+    std::vector<flit *> new_buffer(2 * m_buffer.size());
+    for (int i = 0; i < m_count; i++)
+        new_buffer[i] = at(i);
+    m_buffer.swap(new_buffer);
+    m_head = 0;
+}
+
 bool
 flitBuffer::isEmpty()
 {
-    return (m_buffer.size() == 0);
+    return (m_count == 0);
 }
 
 bool
 flitBuffer::isReady(Tick curTime)
 {
-    if (m_buffer.size() != 0 ) {
+    if (m_count != 0 ) {
         flit *t_flit = peekTopFlit();
         if (t_flit->get_time() <= curTime)
             return true;
@@ -61,13 +73,13 @@ flitBuffer::isReady(Tick curTime)
 void
 flitBuffer::print(std::ostream& out) const
 {
-    out << "[flitBuffer: " << m_buffer.size() << "] " << std::endl;
+    out << "[flitBuffer: " << m_count << "] " << std::endl;
 }
 
 bool
 flitBuffer::isFull()
 {
-    return (m_buffer.size() >= max_size);
+    return (m_count >= max_size);
 }
 
 void
@@ -81,8 +93,8 @@ flitBuffer::functionalWrite(Packet *pkt)
 {
     uint32_t num_functional_writes = 0;
 
-    for (unsigned int i = 0; i < m_buffer.size(); ++i) {
-        if (m_buffer[i]->functionalWrite(pkt)) {
+    for (int i = 0; i < m_count; ++i) {
+        if (at(i)->functionalWrite(pkt)) {
             num_functional_writes++;
         }
     }
@@ -38,6 +38,12 @@
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "mem/ruby/network/garnet/flit.hh"
 
+/**
+ * Flits ordered by the time they are ready, and then by id. The flits
+ * are kept sorted in a ring buffer. They almost always arrive in order,
+ * in which case inserting a flit just appends it; a flit arriving out of
+ * order is moved back to its place.
+ */
 class flitBuffer
 {
   public:
@@ -49,34 +55,56 @@ class flitBuffer
     void print(std::ostream& out) const;
     bool isFull();
     void setMaxSize(int maximum);
-    int getSize() const { return m_buffer.size(); }
+    int getSize() const { return m_count; }
 
     flit *
     getTopFlit()
     {
-        flit *f = m_buffer.front();
-        std::pop_heap(m_buffer.begin(), m_buffer.end(), flit::greater);
-        m_buffer.pop_back();
+        assert(m_count > 0);
+        flit *f = m_buffer[m_head];
+        m_head = (m_head + 1) & (m_buffer.size() - 1);
+        m_count--;
         return f;
     }
 
     flit *
     peekTopFlit()
     {
-        return m_buffer.front();
+        return m_buffer[m_head];
     }
 
     void
     insert(flit *flt)
     {
-        m_buffer.push_back(flt);
-        std::push_heap(m_buffer.begin(), m_buffer.end(), flit::greater);
+        if (m_count == m_buffer.size())
+            grow();
+
+        int pos = m_count;
+        while (pos > 0 && flit::greater(at(pos - 1), flt)) {
+            at(pos) = at(pos - 1);
+            pos--;
+        }
+        at(pos) = flt;
+        m_count++;
     }
 
     uint32_t functionalWrite(Packet *pkt);
 
   private:
+    /** The i-th oldest flit. */
+    flit *&
+    at(int i)
+    {
+        return m_buffer[(m_head + i) & (m_buffer.size() - 1)];
+    }
+
+    /** Double the capacity of the ring. */
+    void grow();
+
+    // The size of the ring is always a power of 2
     std::vector<flit *> m_buffer;
+    int m_head;
+    int m_count;
     int max_size;
 };
 
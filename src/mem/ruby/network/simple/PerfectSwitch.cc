@@ -130,6 +130,11 @@ PerfectSwitch::operateVnet(int vnet)
             }
 
             operateMessageBuffer(buffer, incoming, vnet);
+
+            // The other ports have nothing to send on this vnet
+            if (m_pending_message_count[vnet] == 0) {
+                break;
+            }
         }
     }
 }
@@ -141,9 +146,12 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
     MsgPtr msg_ptr;
     Message *net_msg_ptr = NULL;
 
-    // temporary vectors to store the routing results
-    std::vector<LinkID> output_links;
-    std::vector<NetDest> output_link_destinations;
+    // The routing results are kept in members so that their storage is
+    // reused from one message to the next.
+    std::vector<LinkID> &output_links = m_output_links;
+    std::vector<NetDest> &output_link_destinations =
+        m_output_link_destinations;
+    NetDest &msg_dsts = m_msg_dsts;
     Tick current_time = m_switch->clockEdge();
 
     while (buffer->isReady(current_time)) {
@@ -156,7 +164,7 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
 
         output_links.clear();
         output_link_destinations.clear();
-        NetDest msg_dsts = net_msg_ptr->getDestination();
+        msg_dsts = net_msg_ptr->getDestination();
 
         // Unfortunately, the token-protocol sends some
         // zero-destination messages, so this assert isn't valid
@@ -192,9 +200,13 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
         }
 
         for (int i = 0; i < m_routing_table.size(); i++) {
+            // All destinations have been routed
+            if (msg_dsts.isEmpty())
+                break;
+
             // pick the next link to look at
             int link = m_link_order[i].m_link;
-            NetDest dst = m_routing_table[link];
+            const NetDest &dst = m_routing_table[link];
             DPRINTF(RubyNetwork, "dst: %s\n", dst);
 
             if (!msg_dsts.intersectionIsNotEmpty(dst))
@@ -41,10 +41,10 @@
 #include <vector>
 
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/common/TypeDefines.hh"
 
 class MessageBuffer;
-class NetDest;
 class SimpleNetwork;
 class Switch;
 
@@ -104,6 +104,11 @@ class PerfectSwitch : public Consumer
 
     SimpleNetwork* m_network_ptr;
     std::vector<int> m_pending_message_count;
+
+    // Scratch space for operateMessageBuffer()
+    std::vector<LinkID> m_output_links;
+    std::vector<NetDest> m_output_link_destinations;
+    NetDest m_msg_dsts;
 };
 
 inline std::ostream&
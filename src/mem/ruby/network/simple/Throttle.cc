@@ -89,15 +89,15 @@ Throttle::addLinks(const std::vector<MessageBuffer*>& in_vec,
 }
 
 void
-Throttle::operateVnet(int vnet, int &bw_remaining, bool &schedule_wakeup,
-                      MessageBuffer *in, MessageBuffer *out)
+Throttle::operateVnet(int vnet, Tick current_time, int &bw_remaining,
+                      bool &schedule_wakeup, MessageBuffer *in,
+                      MessageBuffer *out)
 {
     if (out == nullptr || in == nullptr) {
         return;
     }
 
     assert(m_units_remaining[vnet] >= 0);
-    Tick current_time = m_switch->clockEdge();
 
     while (bw_remaining > 0 && (in->isReady(current_time) ||
                                 m_units_remaining[vnet] > 0) &&
@@ -153,6 +153,7 @@ Throttle::wakeup()
 
     m_wakeups_wo_switch++;
     bool schedule_wakeup = false;
+    const Tick current_time = m_switch->clockEdge();
 
     // variable for deciding the direction in which to iterate
     bool iteration_direction = false;
@@ -164,14 +165,16 @@ Throttle::wakeup()
         iteration_direction = true;
     }
 
+    // Once the bandwidth of this cycle is used up, the remaining vnets
+    // can't send anything, and the throttle wakes up again anyway.
     if (iteration_direction) {
-        for (int vnet = 0; vnet < m_vnets; ++vnet) {
-            operateVnet(vnet, bw_remaining, schedule_wakeup,
+        for (int vnet = 0; vnet < m_vnets && bw_remaining > 0; ++vnet) {
+            operateVnet(vnet, current_time, bw_remaining, schedule_wakeup,
                         m_in[vnet], m_out[vnet]);
         }
     } else {
-        for (int vnet = m_vnets-1; vnet >= 0; --vnet) {
-            operateVnet(vnet, bw_remaining, schedule_wakeup,
+        for (int vnet = m_vnets-1; vnet >= 0 && bw_remaining > 0; --vnet) {
+            operateVnet(vnet, current_time, bw_remaining, schedule_wakeup,
                         m_in[vnet], m_out[vnet]);
         }
     }
@@ -83,8 +83,9 @@ class Throttle : public Consumer
   private:
     void init(NodeID node, Cycles link_latency, int link_bandwidth_multiplier,
               int endpoint_bandwidth);
-    void operateVnet(int vnet, int &bw_remainin, bool &schedule_wakeup,
-                     MessageBuffer *in, MessageBuffer *out);
+    void operateVnet(int vnet, Tick current_time, int &bw_remaining,
+                     bool &schedule_wakeup, MessageBuffer *in,
+                     MessageBuffer *out);
 
     // Private copy constructor and assignment operator
     Throttle(const Throttle& obj);
@@ -49,6 +49,7 @@
 
 #include "base/logging.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "mem/mem_pool.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/protocol/AccessPermission.hh"
 
@@ -64,6 +65,30 @@ class AbstractCacheEntry : public ReplaceableEntry
     AbstractCacheEntry();
     virtual ~AbstractCacheEntry() = 0;
 
+    /**
+     * @{
+     * Entries are allocated from the memory system object pool, which
+     * keeps the entries of a cache packed in a few large chunks rather
+     * than spread over the heap. The destructor is virtual, so the size
+     * of the actual entry type is passed on deletion.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        return memPool().allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        memPool().deallocate(p, size);
+    }
+
+    // The class specific operator new hides the placement forms.
+    static void *operator new(size_t size, void *p) { return p; }
+    static void operator delete(void *p, void *place) {}
+    /** @} */
+
     // Get/Set permission of the entry
     AccessPermission getPermission() const;
     void changePermission(AccessPermission new_perm);
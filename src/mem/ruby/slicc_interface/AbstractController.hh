@@ -146,6 +146,19 @@ class AbstractController : public ClockedObject, public Consumer
                                  const bool& was_miss)
     { }
 
+    //! These functions are used to install the contents of a cache trace
+    //! directly, instead of replaying it (see CacheRecorder::warmupBlocks).
+    //! A protocol supports this if all of its controllers return true from
+    //! warmupSupported(). warmupBlock() is first called on the controller
+    //! that recorded the block, which should install it if it can. If it
+    //! did, the function is then called on all the other controllers, so
+    //! that they can update their own state, e.g. the owner of the block.
+    virtual bool warmupSupported() { return false; }
+    virtual void warmupBlock(const Addr &addr, const DataBlock &data,
+                             const RubyRequestType &type,
+                             const MachineID &requestor)
+    { }
+
     //! Function for collating statistics from all the controllers of this
     //! particular type. This function should only be called from the
     //! version 0 of this controller type.
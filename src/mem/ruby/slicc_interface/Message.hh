@@ -42,18 +42,25 @@
 #define __MEM_RUBY_SLICC_INTERFACE_MESSAGE_HH__
 
 #include <iostream>
-#include <memory>
 #include <stack>
 
+#include "base/refcnt.hh"
+#include "mem/mem_pool.hh"
 #include "mem/packet.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/protocol/MessageSizeType.hh"
 
 class Message;
-typedef std::shared_ptr<Message> MsgPtr;
+typedef RefCountingPtr<Message> MsgPtr;
 
-class Message
+/**
+ * Base class of all Ruby messages. Messages are only ever accessed by
+ * the thread simulating the Ruby system, so they use a plain intrusive
+ * reference count, and they are allocated from the memory system
+ * object pool.
+ */
+class Message : public RefCounted
 {
   public:
     Message(Tick curTime)
@@ -62,10 +69,53 @@ class Message
           m_DelayedTicks(0), m_msg_counter(0)
     { }
 
-    Message(const Message &other) = default;
+    // The reference count is not copied, a copy starts out without
+    // any references to it.
+    Message(const Message &other)
+        : RefCounted(), m_time(other.m_time),
+          m_LastEnqueueTime(other.m_LastEnqueueTime),
+          m_DelayedTicks(other.m_DelayedTicks),
+          m_msg_counter(other.m_msg_counter),
+          incoming_link(other.incoming_link), vnet(other.vnet)
+    { }
+
+    Message &
+    operator=(const Message &other)
+    {
+        m_time = other.m_time;
+        m_LastEnqueueTime = other.m_LastEnqueueTime;
+        m_DelayedTicks = other.m_DelayedTicks;
+        m_msg_counter = other.m_msg_counter;
+        incoming_link = other.incoming_link;
+        vnet = other.vnet;
+        return *this;
+    }
 
     virtual ~Message() { }
 
+    /**
+     * @{
+     * Messages of all types are allocated from the memory system object
+     * pool. The destructor is virtual, so the size of the actual message
+     * type is passed on deletion.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        return memPool().allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        memPool().deallocate(p, size);
+    }
+
+    // The class specific operator new hides the placement forms.
+    static void *operator new(size_t size, void *p) { return p; }
+    static void operator delete(void *p, void *place) {}
+    /** @} */
+
     virtual MsgPtr clone() const = 0;
     virtual void print(std::ostream& out) const = 0;
 
@@ -124,6 +174,13 @@ class Message
     // Variables for required network traversal
     int incoming_link;
     int vnet;
+
+    /**
+     * Next message of the MsgList this message is in. It is not copied
+     * along with the message.
+     */
+    MsgPtr m_next_in_list;
+    friend class MsgList;
 };
 
 inline bool
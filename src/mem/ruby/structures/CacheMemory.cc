@@ -60,6 +60,8 @@ operator<<(std::ostream& out, const CacheMemory& obj)
     return out;
 }
 
+const Addr CacheMemory::InvalidTag;
+
 CacheMemory::CacheMemory(const Params &p)
     : SimObject(p),
     dataArray(p.dataArrayBanks, p.dataAccessLatency,
@@ -77,6 +79,7 @@ CacheMemory::CacheMemory(const Params &p)
     m_block_size = p.block_size;  // may be 0 at this point. Updated in init()
     m_use_occupancy = dynamic_cast<ReplacementPolicy::WeightedLRU*>(
                                     m_replacementPolicy_ptr) ? true : false;
+    m_htmLinesOverflow = false;
 }
 
 void
@@ -90,8 +93,8 @@ CacheMemory::init()
     m_cache_num_set_bits = floorLog2(m_cache_num_sets);
     assert(m_cache_num_set_bits > 0);
 
-    m_cache.resize(m_cache_num_sets,
-                    std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
+    m_tags.resize(m_cache_num_sets * m_cache_assoc, InvalidTag);
+    m_cache.resize(m_cache_num_sets * m_cache_assoc, nullptr);
     replacement_data.resize(m_cache_num_sets,
                                std::vector<ReplData>(m_cache_assoc, nullptr));
     // instantiate all the replacement_data here
@@ -107,11 +110,8 @@ CacheMemory::~CacheMemory()
 {
     if (m_replacementPolicy_ptr)
         delete m_replacementPolicy_ptr;
-    for (int i = 0; i < m_cache_num_sets; i++) {
-        for (int j = 0; j < m_cache_assoc; j++) {
-            delete m_cache[i][j];
-        }
-    }
+    for (auto *entry : m_cache)
+        delete entry;
 }
 
 // convert a Address to its location in the cache
@@ -128,13 +128,11 @@ CacheMemory::addressToCacheSet(Addr address) const
 int
 CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
-    assert(tag == makeLineAddress(tag));
-    // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
-            AccessPermission_NotPresent)
-            return it->second;
+    int loc = findTagInSetIgnorePermissions(cacheSet, tag);
+    if (loc != -1 &&
+        m_cache[wayIndex(cacheSet, loc)]->m_Permission !=
+        AccessPermission_NotPresent)
+        return loc;
     return -1; // Not found
 }
 
@@ -145,11 +143,14 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
                                            Addr tag) const
 {
     assert(tag == makeLineAddress(tag));
-    // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        return it->second;
-    return -1; // Not found
+    // search the set for the tags. A tag is held by at most one way, so
+    // all the tags of the set are compared without branching, which lets
+    // the compiler vectorize the loop.
+    const Addr *tags = &m_tags[wayIndex(cacheSet, 0)];
+    int loc = -1;
+    for (int i = 0; i < m_cache_assoc; i++)
+        loc = tags[i] == tag ? i : loc;
+    return loc;
 }
 
 // Given an unique cache block identifier (idx): return the valid address
@@ -166,7 +167,7 @@ CacheMemory::getAddressAtIdx(int idx) const
     int way = idx - set * m_cache_assoc;
     assert (way < m_cache_assoc);
 
-    AbstractCacheEntry* entry = m_cache[set][way];
+    AbstractCacheEntry* entry = m_cache[wayIndex(set, way)];
     if (entry == NULL ||
         entry->m_Permission == AccessPermission_Invalid ||
         entry->m_Permission == AccessPermission_NotPresent) {
@@ -244,7 +245,7 @@ CacheMemory::cacheAvail(Addr address) const
     int64_t cacheSet = addressToCacheSet(address);
 
     for (int i = 0; i < m_cache_assoc; i++) {
-        AbstractCacheEntry* entry = m_cache[cacheSet][i];
+        AbstractCacheEntry* entry = m_cache[wayIndex(cacheSet, i)];
         if (entry != NULL) {
             if (entry->m_Address == address ||
                 entry->m_Permission == AccessPermission_NotPresent) {
@@ -268,7 +269,7 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
 
     // Find the first open slot
     int64_t cacheSet = addressToCacheSet(address);
-    std::vector<AbstractCacheEntry*> &set = m_cache[cacheSet];
+    AbstractCacheEntry **set = &m_cache[wayIndex(cacheSet, 0)];
     for (int i = 0; i < m_cache_assoc; i++) {
         if (!set[i] || set[i]->m_Permission == AccessPermission_NotPresent) {
             if (set[i] && (set[i] != entry)) {
@@ -284,7 +285,7 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
             DPRINTF(RubyCache, "Allocate clearing lock for addr: %x\n",
                     address);
             set[i]->m_locked = -1;
-            m_tag_index[address] = i;
+            m_tags[wayIndex(cacheSet, i)] = address;
             set[i]->setPosition(cacheSet, i);
             set[i]->replacementData = replacement_data[cacheSet][i];
             set[i]->setLastAccess(curTick());
@@ -309,8 +310,8 @@ CacheMemory::deallocate(Addr address)
     uint32_t cache_set = entry->getSet();
     uint32_t way = entry->getWay();
     delete entry;
-    m_cache[cache_set][way] = NULL;
-    m_tag_index.erase(address);
+    m_cache[wayIndex(cache_set, way)] = NULL;
+    m_tags[wayIndex(cache_set, way)] = InvalidTag;
 }
 
 // Returns with the physical address of the conflicting cache line
@@ -324,10 +325,10 @@ CacheMemory::cacheProbe(Addr address) const
     std::vector<ReplaceableEntry*> candidates;
     for (int i = 0; i < m_cache_assoc; i++) {
         candidates.push_back(static_cast<ReplaceableEntry*>(
-                                                       m_cache[cacheSet][i]));
+                                           m_cache[wayIndex(cacheSet, i)]));
     }
-    return m_cache[cacheSet][m_replacementPolicy_ptr->
-                        getVictim(candidates)->getWay()]->m_Address;
+    return m_cache[wayIndex(cacheSet, m_replacementPolicy_ptr->
+                            getVictim(candidates)->getWay())]->m_Address;
 }
 
 // looks an address up in the cache
@@ -338,7 +339,7 @@ CacheMemory::lookup(Addr address)
     int64_t cacheSet = addressToCacheSet(address);
     int loc = findTagInSet(cacheSet, address);
     if (loc == -1) return NULL;
-    return m_cache[cacheSet][loc];
+    return m_cache[wayIndex(cacheSet, loc)];
 }
 
 // looks an address up in the cache
@@ -349,7 +350,7 @@ CacheMemory::lookup(Addr address) const
     int64_t cacheSet = addressToCacheSet(address);
     int loc = findTagInSet(cacheSet, address);
     if (loc == -1) return NULL;
-    return m_cache[cacheSet][loc];
+    return m_cache[wayIndex(cacheSet, loc)];
 }
 
 // Sets the most recently used bit for a cache block
@@ -396,8 +397,9 @@ CacheMemory::getReplacementWeight(int64_t set, int64_t loc)
     assert(set < m_cache_num_sets);
     assert(loc < m_cache_assoc);
     int ret = 0;
-    if (m_cache[set][loc] != NULL) {
-        ret = m_cache[set][loc]->getNumValidBlocks();
+    AbstractCacheEntry *entry = m_cache[wayIndex(set, loc)];
+    if (entry != NULL) {
+        ret = entry->getNumValidBlocks();
         assert(ret >= 0);
     }
 
@@ -411,29 +413,27 @@ CacheMemory::recordCacheContents(int cntrl, CacheRecorder* tr) const
     M5_VAR_USED uint64_t totalBlocks = (uint64_t)m_cache_num_sets *
                                        (uint64_t)m_cache_assoc;
 
-    for (int i = 0; i < m_cache_num_sets; i++) {
-        for (int j = 0; j < m_cache_assoc; j++) {
-            if (m_cache[i][j] != NULL) {
-                AccessPermission perm = m_cache[i][j]->m_Permission;
-                RubyRequestType request_type = RubyRequestType_NULL;
-                if (perm == AccessPermission_Read_Only) {
-                    if (m_is_instruction_only_cache) {
-                        request_type = RubyRequestType_IFETCH;
-                    } else {
-                        request_type = RubyRequestType_LD;
-                    }
-                } else if (perm == AccessPermission_Read_Write) {
-                    request_type = RubyRequestType_ST;
+    for (auto *entry : m_cache) {
+        if (entry != NULL) {
+            AccessPermission perm = entry->m_Permission;
+            RubyRequestType request_type = RubyRequestType_NULL;
+            if (perm == AccessPermission_Read_Only) {
+                if (m_is_instruction_only_cache) {
+                    request_type = RubyRequestType_IFETCH;
+                } else {
+                    request_type = RubyRequestType_LD;
                 }
+            } else if (perm == AccessPermission_Read_Write) {
+                request_type = RubyRequestType_ST;
+            }
 
-                if (request_type != RubyRequestType_NULL) {
-                    Tick lastAccessTick;
-                    lastAccessTick = m_cache[i][j]->getLastAccess();
-                    tr->addRecord(cntrl, m_cache[i][j]->m_Address,
-                                  0, request_type, lastAccessTick,
-                                  m_cache[i][j]->getDataBlk());
-                    warmedUpBlocks++;
-                }
+            if (request_type != RubyRequestType_NULL) {
+                Tick lastAccessTick;
+                lastAccessTick = entry->getLastAccess();
+                tr->addRecord(cntrl, entry->m_Address,
+                              0, request_type, lastAccessTick,
+                              entry->getDataBlk());
+                warmedUpBlocks++;
             }
         }
     }
@@ -449,10 +449,11 @@ CacheMemory::print(std::ostream& out) const
     out << "Cache dump: " << name() << std::endl;
     for (int i = 0; i < m_cache_num_sets; i++) {
         for (int j = 0; j < m_cache_assoc; j++) {
-            if (m_cache[i][j] != NULL) {
+            const AbstractCacheEntry *entry = m_cache[wayIndex(i, j)];
+            if (entry != NULL) {
                 out << "  Index: " << i
                     << " way: " << j
-                    << " entry: " << *m_cache[i][j] << std::endl;
+                    << " entry: " << *entry << std::endl;
             } else {
                 out << "  Index: " << i
                     << " way: " << j
@@ -475,6 +476,7 @@ CacheMemory::setLocked(Addr address, int context)
     AbstractCacheEntry* entry = lookup(address);
     assert(entry != nullptr);
     entry->setLocked(context);
+    htmTrackLine(address);
 }
 
 void
@@ -490,15 +492,11 @@ void
 CacheMemory::clearLockedAll(int context)
 {
     // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i) {
-        std::vector<AbstractCacheEntry*> set = *i;
-        for (auto j = set.begin(); j != set.end(); ++j) {
-            AbstractCacheEntry *line = *j;
-            if (line && line->isLocked(context)) {
-                DPRINTF(RubyCache, "Clear Lock for addr: %#x\n",
-                    line->m_Address);
-                line->clearLocked();
-            }
+    for (auto *line : m_cache) {
+        if (line && line->isLocked(context)) {
+            DPRINTF(RubyCache, "Clear Lock for addr: %#x\n",
+                line->m_Address);
+            line->clearLocked();
         }
     }
 }
@@ -661,79 +659,92 @@ CacheMemory::checkResourceAvailable(CacheResourceType res, Addr addr)
 bool
 CacheMemory::isBlockInvalid(int64_t cache_set, int64_t loc)
 {
-  return (m_cache[cache_set][loc]->m_Permission == AccessPermission_Invalid);
+  return (m_cache[wayIndex(cache_set, loc)]->m_Permission ==
+          AccessPermission_Invalid);
 }
 
 bool
 CacheMemory::isBlockNotBusy(int64_t cache_set, int64_t loc)
 {
-  return (m_cache[cache_set][loc]->m_Permission != AccessPermission_Busy);
+  return (m_cache[wayIndex(cache_set, loc)]->m_Permission !=
+          AccessPermission_Busy);
 }
 
 /* hardware transactional memory */
 
 void
-CacheMemory::htmAbortTransaction()
+CacheMemory::htmTrackLine(Addr address)
 {
-    uint64_t htmReadSetSize = 0;
-    uint64_t htmWriteSetSize = 0;
+    if (m_htmLinesOverflow)
+        return;
 
-    // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i)
-    {
-        std::vector<AbstractCacheEntry*> set = *i;
-
-        for (auto j = set.begin(); j != set.end(); ++j)
-        {
-            AbstractCacheEntry *line = *j;
-
-            if (line != nullptr) {
-                htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
-                htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
-                if (line->getInHtmWriteSet()) {
-                    line->invalidateEntry();
-                }
-                line->setInHtmWriteSet(false);
-                line->setInHtmReadSet(false);
-                line->clearLocked();
-            }
-        }
+    if (m_htmLines.size() >= (size_t)getNumBlocks()) {
+        m_htmLines.clear();
+        m_htmLinesOverflow = true;
+        return;
     }
 
-    cacheMemoryStats.htmTransAbortReadSet.sample(htmReadSetSize);
-    cacheMemoryStats.htmTransAbortWriteSet.sample(htmWriteSetSize);
-    DPRINTF(HtmMem, "htmAbortTransaction: read set=%u write set=%u\n",
-        htmReadSetSize, htmWriteSetSize);
+    m_htmLines.push_back(makeLineAddress(address));
 }
 
 void
-CacheMemory::htmCommitTransaction()
+CacheMemory::htmEndTransaction(bool abort)
 {
     uint64_t htmReadSetSize = 0;
     uint64_t htmWriteSetSize = 0;
 
-    // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i)
-    {
-        std::vector<AbstractCacheEntry*> set = *i;
-
-        for (auto j = set.begin(); j != set.end(); ++j)
-        {
-            AbstractCacheEntry *line = *j;
-            if (line != nullptr) {
-                htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
-                htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
-                line->setInHtmWriteSet(false);
-                line->setInHtmReadSet(false);
-                line->clearLocked();
-             }
+    auto end_line = [&](AbstractCacheEntry *line) {
+        htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
+        htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
+        if (abort && line->getInHtmWriteSet()) {
+            line->invalidateEntry();
         }
+        line->setInHtmWriteSet(false);
+        line->setInHtmReadSet(false);
+        line->clearLocked();
+    };
+
+    if (m_htmLinesOverflow) {
+        // iterate through every set and way to get a cache line
+        for (auto *line : m_cache) {
+            if (line != nullptr)
+                end_line(line);
+        }
+    } else {
+        // lines evicted since they were recorded no longer hold any
+        // state, and lines recorded twice are cleared by the first visit
+        for (Addr addr : m_htmLines) {
+            AbstractCacheEntry *line = lookup(addr);
+            if (line != nullptr)
+                end_line(line);
+        }
+    }
+    m_htmLines.clear();
+    m_htmLinesOverflow = false;
+
+    if (abort) {
+        cacheMemoryStats.htmTransAbortReadSet.sample(htmReadSetSize);
+        cacheMemoryStats.htmTransAbortWriteSet.sample(htmWriteSetSize);
+        DPRINTF(HtmMem, "htmAbortTransaction: read set=%u write set=%u\n",
+            htmReadSetSize, htmWriteSetSize);
+    } else {
+        cacheMemoryStats.htmTransCommitReadSet.sample(htmReadSetSize);
+        cacheMemoryStats.htmTransCommitWriteSet.sample(htmWriteSetSize);
+        DPRINTF(HtmMem, "htmCommitTransaction: read set=%u write set=%u\n",
+            htmReadSetSize, htmWriteSetSize);
     }
+}
 
-    cacheMemoryStats.htmTransCommitReadSet.sample(htmReadSetSize);
-    cacheMemoryStats.htmTransCommitWriteSet.sample(htmWriteSetSize);
-    DPRINTF(HtmMem, "htmCommitTransaction: read set=%u write set=%u\n",
-        htmReadSetSize, htmWriteSetSize);
+void
+CacheMemory::htmAbortTransaction()
+{
+    htmEndTransaction(true);
+}
+
+void
+CacheMemory::htmCommitTransaction()
+{
+    htmEndTransaction(false);
 }
 
 void
@@ -43,7 +43,6 @@
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -146,6 +145,9 @@ class CacheMemory : public SimObject
     // hardware transactional memory
     void htmAbortTransaction();
     void htmCommitTransaction();
+    // Record a line that joined the transactional read or write set, so
+    // ending the transaction does not have to look at every way
+    void htmTrackLine(Addr addr);
 
   public:
     int getCacheSize() const { return m_cache_size; }
@@ -157,6 +159,18 @@ class CacheMemory : public SimObject
     // convert a Address to its location in the cache
     int64_t addressToCacheSet(Addr address) const;
 
+    // Clear the transactional and lock state of the tracked lines (or of
+    // all lines if tracking overflowed), invalidating speculatively
+    // written lines on an abort
+    void htmEndTransaction(bool abort);
+
+    // Index of a way in the flat tag and entry arrays
+    int64_t
+    wayIndex(int64_t cacheSet, int way) const
+    {
+        return cacheSet * m_cache_assoc + way;
+    }
+
     // Given a cache tag: returns the index of the tag in a set.
     // returns -1 if the tag is not found.
     int findTagInSet(int64_t line, Addr tag) const;
@@ -170,10 +184,18 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    /** Tag of the ways that don't hold an entry. */
+    static const Addr InvalidTag = MaxAddr;
+
+    /**
+     * Line address held by every way, stored set by set. The tags of a
+     * set are contiguous so a lookup compares them in a single pass
+     * without touching the entries. Ways that don't hold an entry are
+     * tagged with InvalidTag.
+     */
+    std::vector<Addr> m_tags;
+    /** Entry held by every way, indexed like m_tags. */
+    std::vector<AbstractCacheEntry*> m_cache;
 
     /** We use the replacement policies from the Classic memory system. */
     ReplacementPolicy::Base *m_replacementPolicy_ptr;
@@ -205,6 +227,15 @@ class CacheMemory : public SimObject
      */
     bool m_use_occupancy;
 
+    /**
+     * Lines that may hold transactional or load-linked state since the
+     * last transaction ended. A line may appear more than once. Once
+     * more lines are recorded than the cache holds, recording stops and
+     * the end of the transaction falls back to scanning every way.
+     */
+    std::vector<Addr> m_htmLines;
+    bool m_htmLinesOverflow;
+
     private:
       struct CacheMemoryStats : public Stats::Group
       {
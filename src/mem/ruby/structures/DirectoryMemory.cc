@@ -50,7 +50,8 @@
 #include "sim/system.hh"
 
 DirectoryMemory::DirectoryMemory(const Params &p)
-    : SimObject(p), addrRanges(p.addr_ranges.begin(), p.addr_ranges.end())
+    : SimObject(p), m_compact_invalid(p.compact_invalid),
+      addrRanges(p.addr_ranges.begin(), p.addr_ranges.end())
 {
     m_size_bytes = 0;
     for (const auto &r: addrRanges) {
@@ -64,20 +65,28 @@ void
 DirectoryMemory::init()
 {
     m_num_entries = m_size_bytes / RubySystem::getBlockSizeBytes();
-    m_entries = new AbstractCacheEntry*[m_num_entries];
-    for (int i = 0; i < m_num_entries; i++)
-        m_entries[i] = NULL;
+    m_pages.resize(divCeil(m_num_entries, PageEntries));
 }
 
 DirectoryMemory::~DirectoryMemory()
 {
     // free up all the directory entries
-    for (uint64_t i = 0; i < m_num_entries; i++) {
-        if (m_entries[i] != NULL) {
-            delete m_entries[i];
-        }
+    for (auto &page : m_pages) {
+        if (!page)
+            continue;
+        for (auto *entry : page->entries)
+            delete entry;
     }
-    delete [] m_entries;
+}
+
+AbstractCacheEntry *&
+DirectoryMemory::entryAt(uint64_t idx)
+{
+    assert(idx < m_num_entries);
+    auto &page = m_pages[idx >> PageBits];
+    if (!page)
+        page.reset(new Page);
+    return page->entries[idx & (PageEntries - 1)];
 }
 
 bool
@@ -113,7 +122,9 @@ DirectoryMemory::lookup(Addr address)
 
     uint64_t idx = mapAddressToLocalIdx(address);
     assert(idx < m_num_entries);
-    return m_entries[idx];
+    // Don't allocate a page just to find out it's empty
+    const auto &page = m_pages[idx >> PageBits];
+    return page ? page->entries[idx & (PageEntries - 1)] : NULL;
 }
 
 AbstractCacheEntry*
@@ -124,10 +135,11 @@ DirectoryMemory::allocate(Addr address, AbstractCacheEntry *entry)
     DPRINTF(RubyCache, "Looking up address: %#x\n", address);
 
     idx = mapAddressToLocalIdx(address);
-    assert(idx < m_num_entries);
-    assert(m_entries[idx] == NULL);
+    AbstractCacheEntry *&slot = entryAt(idx);
+    assert(slot == NULL);
     entry->changePermission(AccessPermission_Read_Only);
-    m_entries[idx] = entry;
+    slot = entry;
+    m_pages[idx >> PageBits]->numEntries++;
 
     return entry;
 }
@@ -141,9 +153,23 @@ DirectoryMemory::deallocate(Addr address)
 
     idx = mapAddressToLocalIdx(address);
     assert(idx < m_num_entries);
-    assert(m_entries[idx] != NULL);
-    delete m_entries[idx];
-    m_entries[idx] = NULL;
+    auto &page = m_pages[idx >> PageBits];
+    assert(page);
+    AbstractCacheEntry *&slot = page->entries[idx & (PageEntries - 1)];
+    assert(slot != NULL);
+    delete slot;
+    slot = NULL;
+
+    // Give the page back once it's empty
+    if (--page->numEntries == 0)
+        page.reset();
+}
+
+void
+DirectoryMemory::invalidateBlock(Addr address)
+{
+    if (m_compact_invalid && lookup(address) != NULL)
+        deallocate(address);
 }
 
 void
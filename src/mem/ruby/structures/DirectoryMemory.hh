@@ -42,7 +42,9 @@
 #define __MEM_RUBY_STRUCTURES_DIRECTORYMEMORY_HH__
 
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "base/addr_range.hh"
 #include "mem/ruby/common/Address.hh"
@@ -82,6 +84,14 @@ class DirectoryMemory : public SimObject
     // Explicitly free up this address
     void deallocate(Addr address);
 
+    /**
+     * Tell the directory that a block is back in its invalid state, so
+     * its entry holds no information that a newly allocated entry
+     * wouldn't. When compaction is enabled the entry is freed, and it is
+     * up to the protocol to allocate it again when it's next needed.
+     */
+    void invalidateBlock(Addr address);
+
     void print(std::ostream& out) const;
     void recordRequestType(DirectoryRequestType requestType);
 
@@ -91,8 +101,28 @@ class DirectoryMemory : public SimObject
     DirectoryMemory& operator=(const DirectoryMemory& obj);
 
   private:
+    /** Number of entries in a page of the directory, as a power of 2. */
+    static const int PageBits = 12;
+    static const uint64_t PageEntries = ULL(1) << PageBits;
+
+    /**
+     * The entries are kept in pages that are only allocated once one of
+     * their entries is, so the memory used by the directory follows the
+     * memory actually touched rather than its size.
+     */
+    struct Page
+    {
+        AbstractCacheEntry *entries[PageEntries] = {};
+        /** Number of allocated entries in the page. */
+        uint64_t numEntries = 0;
+    };
+
+    AbstractCacheEntry *&entryAt(uint64_t idx);
+
     const std::string m_name;
-    AbstractCacheEntry **m_entries;
+    std::vector<std::unique_ptr<Page>> m_pages;
+    /** Free the entries of invalid blocks. */
+    const bool m_compact_invalid;
     // int m_size;  // # of memory module blocks this directory is
                     // responsible for
     uint64_t m_size_bytes;
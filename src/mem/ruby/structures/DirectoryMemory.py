@@ -46,3 +46,5 @@ class RubyDirectoryMemory(SimObject):
     cxx_header = "mem/ruby/structures/DirectoryMemory.hh"
     addr_ranges = VectorParam.AddrRange(
         Parent.addr_ranges, "Address range this directory responds to")
+    compact_invalid = Param.Bool(False, "Free the entries of blocks the "
+                                 "protocol has invalidated")
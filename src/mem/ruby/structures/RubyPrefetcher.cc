@@ -244,16 +244,24 @@ RubyPrefetcher::initializeStream(Addr address, int stride,
 PrefetchEntry *
 RubyPrefetcher::getPrefetchEntry(Addr address, uint32_t &index)
 {
-    // search all streams for a match
-    for (int i = 0; i < m_num_streams; i++) {
-        // search all the outstanding prefetches for this stream
-        if (m_array[i].m_is_valid) {
-            for (int j = 0; j < m_num_startup_pfs; j++) {
-                if (makeNextStrideAddress(m_array[i].m_address,
-                    -(m_array[i].m_stride*j)) == address) {
-                    return &(m_array[i]);
-                }
-            }
+    // The outstanding prefetches of a stream are the lines 0 to
+    // m_num_startup_pfs - 1 strides behind its last prefetched line, so
+    // an address belongs to a stream if its distance to that line is one
+    // of those multiples of the stride
+    const int64_t blk_bytes = RubySystem::getBlockSizeBytes();
+    for (auto &stream : m_array) {
+        if (!stream.m_is_valid)
+            continue;
+
+        const int64_t stride = stream.m_stride * blk_bytes;
+        const int64_t delta = makeLineAddress(stream.m_address) - address;
+        if (stride == 0 ? delta != 0 : delta % stride != 0)
+            continue;
+
+        const int64_t j = stride == 0 ? 0 : delta / stride;
+        if (j >= 0 && j < m_num_startup_pfs) {
+            index = j;
+            return &stream;
         }
     }
     return NULL;
@@ -40,7 +40,7 @@
 
 #include <cassert>
 #include <stack>
-#include <unordered_map>
+#include <vector>
 
 #include <base/statistics.hh>
 
@@ -75,10 +75,10 @@ class TBEStorage {
     TBEStorage(Stats::Group *parent, int number_of_TBEs);
 
     // Returns the current number of slots allocated
-    int size() const { return m_slots_used.size(); }
+    int size() const { return m_slots_used; }
 
     // Returns the total capacity of this TBEStorage table
-    int capacity() const { return m_slots_used.size() + m_slots_avail.size(); }
+    int capacity() const { return m_slot_entries.size(); }
 
     // Returns number of slots currently reserved
     int reserved() const { return m_reserved; }
@@ -114,8 +114,10 @@ class TBEStorage {
 
   private:
     int m_reserved;
-    std::stack<int> m_slots_avail;
-    std::unordered_map<int, int> m_slots_used;
+    std::stack<int, std::vector<int>> m_slots_avail;
+    // Number of entries assigned to each slot, which is free if 0
+    std::vector<int> m_slot_entries;
+    int m_slots_used;
 
     struct TBEStorageStats : public Stats::Group
     {
@@ -155,7 +157,9 @@ TBEStorage::addEntryToNewSlot()
     assert(slotsAvailable() > 0);
     assert(m_slots_avail.size() > 0);
     int slot = m_slots_avail.top();
-    m_slots_used[slot] = 1;
+    assert(m_slot_entries[slot] == 0);
+    m_slot_entries[slot] = 1;
+    ++m_slots_used;
     m_slots_avail.pop();
     m_stats.avg_size = size();
     m_stats.avg_util = utilization();
@@ -165,20 +169,17 @@ TBEStorage::addEntryToNewSlot()
 inline void
 TBEStorage::addEntryToSlot(int slot)
 {
-    auto iter = m_slots_used.find(slot);
-    assert(iter != m_slots_used.end());
-    iter->second += 1;
+    assert(m_slot_entries[slot] > 0);
+    m_slot_entries[slot] += 1;
 }
 
 inline void
 TBEStorage::removeEntryFromSlot(int slot)
 {
-    auto iter = m_slots_used.find(slot);
-    assert(iter != m_slots_used.end());
-    assert(iter->second > 0);
-    iter->second -= 1;
-    if (iter->second == 0) {
-        m_slots_used.erase(iter);
+    assert(m_slot_entries[slot] > 0);
+    m_slot_entries[slot] -= 1;
+    if (m_slot_entries[slot] == 0) {
+        --m_slots_used;
         m_slots_avail.push(slot);
     }
     m_stats.avg_size = size();
@@ -41,18 +41,33 @@
 #ifndef __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 #define __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 
+#include <algorithm>
+#include <deque>
 #include <iostream>
-#include <unordered_map>
+#include <vector>
 
+#include "base/intmath.hh"
+#include "base/logging.hh"
 #include "mem/ruby/common/Address.hh"
 
+/**
+ * The TBEs are kept in a slab of at most number_of_TBEs entries, which
+ * are created on demand and then recycled, and whose addresses do not
+ * change while they are allocated. An open-addressed hash table with
+ * linear probing maps line addresses to slab entries, so allocating
+ * and deallocating TBEs does not touch the heap once the slab has
+ * grown.
+ */
 template<class ENTRY>
 class TBETable
 {
   public:
     TBETable(int number_of_TBEs)
-        : m_number_of_TBEs(number_of_TBEs)
+        : m_number_of_TBEs(number_of_TBEs), m_size(0),
+          m_index_bits(ceilLog2(std::max(2 * number_of_TBEs, 2))),
+          m_index(1ULL << m_index_bits)
     {
+        m_free_slots.reserve(number_of_TBEs);
     }
 
     bool isPresent(Addr address) const;
@@ -61,7 +76,7 @@ class TBETable
     bool
     areNSlotsAvailable(int n, Tick current_time) const
     {
-        return (m_number_of_TBEs - m_map.size()) >= n;
+        return (m_number_of_TBEs - m_size) >= n;
     }
 
     ENTRY *getNullEntry();
@@ -75,11 +90,36 @@ class TBETable
     TBETable(const TBETable& obj);
     TBETable& operator=(const TBETable& obj);
 
+    /** An entry of the address index, which is free if slot is -1. */
+    struct IndexEntry
+    {
+        Addr address = 0;
+        int slot = -1;
+    };
+
+    /** Get the position of an address in the index if it did not collide. */
+    size_t
+    home(Addr address) const
+    {
+        // Line addresses have their low bits cleared, so mix them in
+        return (address * 0x9E3779B97F4A7C15ULL) >> (64 - m_index_bits);
+    }
+
+    /**
+     * Find the position of an address in the index, or the free
+     * position where it would be inserted.
+     */
+    size_t find(Addr address) const;
+
     // Data Members (m_prefix)
-    std::unordered_map<Addr, ENTRY> m_map;
+    std::deque<ENTRY> m_entries;
+    std::vector<int> m_free_slots;
 
   private:
     int m_number_of_TBEs;
+    int m_size;
+    const unsigned m_index_bits;
+    std::vector<IndexEntry> m_index;
 };
 
 template<class ENTRY>
@@ -91,13 +131,26 @@ operator<<(std::ostream& out, const TBETable<ENTRY>& obj)
     return out;
 }
 
+template<class ENTRY>
+inline size_t
+TBETable<ENTRY>::find(Addr address) const
+{
+    // The index is never more than half full, so there is always a
+    // free position to stop at
+    const size_t mask = m_index.size() - 1;
+    size_t pos = home(address);
+    while (m_index[pos].slot != -1 && m_index[pos].address != address)
+        pos = (pos + 1) & mask;
+    return pos;
+}
+
 template<class ENTRY>
 inline bool
 TBETable<ENTRY>::isPresent(Addr address) const
 {
     assert(address == makeLineAddress(address));
-    assert(m_map.size() <= m_number_of_TBEs);
-    return !!m_map.count(address);
+    assert(m_size <= m_number_of_TBEs);
+    return m_index[find(address)].slot != -1;
 }
 
 template<class ENTRY>
@@ -105,8 +158,23 @@ inline void
 TBETable<ENTRY>::allocate(Addr address)
 {
     assert(!isPresent(address));
-    assert(m_map.size() < m_number_of_TBEs);
-    m_map[address] = ENTRY();
+    panic_if(m_size >= m_number_of_TBEs,
+             "Allocating more than %d TBEs\n", m_number_of_TBEs);
+
+    int slot;
+    if (m_free_slots.empty()) {
+        slot = m_entries.size();
+        m_entries.emplace_back();
+    } else {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+        m_entries[slot] = ENTRY();
+    }
+
+    IndexEntry &entry = m_index[find(address)];
+    entry.address = address;
+    entry.slot = slot;
+    m_size++;
 }
 
 template<class ENTRY>
@@ -114,8 +182,30 @@ inline void
 TBETable<ENTRY>::deallocate(Addr address)
 {
     assert(isPresent(address));
-    assert(m_map.size() > 0);
-    m_map.erase(address);
+    assert(m_size > 0);
+
+    size_t pos = find(address);
+    m_free_slots.push_back(m_index[pos].slot);
+    m_size--;
+
+    // Move back the entries that follow in the same run and could be
+    // found from the freed position, so that lookups never stop short
+    const size_t mask = m_index.size() - 1;
+    size_t next = pos;
+    while (true) {
+        next = (next + 1) & mask;
+        if (m_index[next].slot == -1)
+            break;
+        const size_t next_home = home(m_index[next].address);
+        const bool stays = pos <= next ?
+            pos < next_home && next_home <= next :
+            pos < next_home || next_home <= next;
+        if (!stays) {
+            m_index[pos] = m_index[next];
+            pos = next;
+        }
+    }
+    m_index[pos].slot = -1;
 }
 
 template<class ENTRY>
@@ -130,8 +220,8 @@ template<class ENTRY>
 inline ENTRY*
 TBETable<ENTRY>::lookup(Addr address)
 {
-  if (m_map.find(address) != m_map.end()) return &(m_map.find(address)->second);
-  return NULL;
+    const int slot = m_index[find(address)].slot;
+    return slot == -1 ? nullptr : &m_entries[slot];
 }
 
 
@@ -31,34 +31,24 @@
 #include "mem/ruby/system/RubySystem.hh"
 
 TimerTable::TimerTable()
-    : m_next_time(0)
 {
     m_consumer_ptr  = NULL;
-    m_next_valid = false;
-    m_next_address = 0;
 }
 
 bool
 TimerTable::isReady(Tick curTime) const
 {
-    if (m_map.empty())
+    if (m_ready.empty())
         return false;
 
-    if (!m_next_valid) {
-        updateNext();
-    }
-    assert(m_next_valid);
-    return (curTime >= m_next_time);
+    return (curTime >= m_ready.begin()->first);
 }
 
 Addr
 TimerTable::nextAddress() const
 {
-    if (!m_next_valid) {
-        updateNext();
-    }
-    assert(m_next_valid);
-    return m_next_address;
+    assert(!m_ready.empty());
+    return m_ready.begin()->second;
 }
 
 void
@@ -68,55 +58,22 @@ TimerTable::set(Addr address, Tick ready_time)
     assert(!m_map.count(address));
 
     m_map[address] = ready_time;
+    m_ready.emplace(ready_time, address);
     assert(m_consumer_ptr != NULL);
     m_consumer_ptr->scheduleEventAbsolute(ready_time);
-    m_next_valid = false;
-
-    // Don't always recalculate the next ready address
-    if (ready_time <= m_next_time) {
-        m_next_valid = false;
-    }
 }
 
 void
 TimerTable::unset(Addr address)
 {
     assert(address == makeLineAddress(address));
-    assert(m_map.count(address));
-    m_map.erase(address);
-
-    // Don't always recalculate the next ready address
-    if (address == m_next_address) {
-        m_next_valid = false;
-    }
+    auto it = m_map.find(address);
+    assert(it != m_map.end());
+    m_ready.erase(std::make_pair(it->second, address));
+    m_map.erase(it);
 }
 
 void
 TimerTable::print(std::ostream& out) const
 {
 }
-
-void
-TimerTable::updateNext() const
-{
-    if (m_map.empty()) {
-        assert(!m_next_valid);
-        return;
-    }
-
-    AddressMap::const_iterator i = m_map.begin();
-    AddressMap::const_iterator end = m_map.end();
-
-    m_next_address = i->first;
-    m_next_time = i->second;
-    ++i;
-
-    for (; i != end; ++i) {
-        if (i->second < m_next_time) {
-            m_next_address = i->first;
-            m_next_time = i->second;
-        }
-    }
-
-    m_next_valid = true;
-}
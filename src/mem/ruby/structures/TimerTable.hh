@@ -31,8 +31,10 @@
 
 #include <cassert>
 #include <iostream>
-#include <map>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/Consumer.hh"
@@ -63,21 +65,21 @@ class TimerTable
     void print(std::ostream& out) const;
 
   private:
-    void updateNext() const;
-
     // Private copy constructor and assignment operator
     TimerTable(const TimerTable& obj);
     TimerTable& operator=(const TimerTable& obj);
 
     // Data Members (m_prefix)
 
-    // use a std::map for the address map as this container is sorted
-    // and ensures a well-defined iteration order
-    typedef std::map<Addr, Tick> AddressMap;
+    // the ready time of each address
+    typedef std::unordered_map<Addr, Tick> AddressMap;
     AddressMap m_map;
-    mutable bool m_next_valid;
-    mutable Tick m_next_time; // Only valid if m_next_valid is true
-    mutable Addr m_next_address;  // Only valid if m_next_valid is true
+
+    // the addresses sorted by ready time, and then by address, so
+    // that the next address is always the first one and ties are
+    // broken in a well-defined order
+    typedef std::set<std::pair<Tick, Addr>> ReadyQueue;
+    ReadyQueue m_ready;
 
     //! Consumer to signal a wakeup()
     Consumer* m_consumer_ptr;
@@ -76,7 +76,10 @@ WireBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
 
     Message* msg_ptr = message.get();
     msg_ptr->setLastEnqueueTime(arrival_time);
+    msg_ptr->setMsgCounter(m_msg_counter);
     m_message_queue.push_back(message);
+    push_heap(m_message_queue.begin(), m_message_queue.end(),
+        std::greater<MsgPtr>());
     if (m_consumer_ptr != NULL) {
         m_consumer_ptr->
             scheduleEventAbsolute(arrival_time);
@@ -30,6 +30,7 @@
 #include "mem/ruby/system/CacheRecorder.hh"
 
 #include "debug/RubyCacheTrace.hh"
+#include "mem/ruby/slicc_interface/AbstractController.hh"
 #include "mem/ruby/system/RubySystem.hh"
 #include "mem/ruby/system/Sequencer.hh"
 
@@ -83,9 +84,9 @@ CacheRecorder::enqueueNextFlushRequest()
     if (m_records_flushed < m_records.size()) {
         TraceRecord* rec = m_records[m_records_flushed];
         m_records_flushed++;
-        auto req = std::make_shared<Request>(rec->m_data_address,
-                                             m_block_size_bytes, 0,
-                                             Request::funcRequestorId);
+        auto req = Request::create(rec->m_data_address,
+                                   m_block_size_bytes, 0,
+                                   Request::funcRequestorId);
         MemCmd::Command requestType = MemCmd::FlushReq;
         Packet *pkt = new Packet(req, requestType);
 
@@ -115,19 +116,19 @@ CacheRecorder::enqueueNextFetchRequest()
 
             if (traceRecord->m_type == RubyRequestType_LD) {
                 requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
+                req = Request::create(
                     traceRecord->m_data_address + rec_bytes_read,
                     RubySystem::getBlockSizeBytes(), 0,
                                     Request::funcRequestorId);
             }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
                 requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
+                req = Request::create(
                         traceRecord->m_data_address + rec_bytes_read,
                         RubySystem::getBlockSizeBytes(),
                         Request::INST_FETCH, Request::funcRequestorId);
             }   else {
                 requestType = MemCmd::WriteReq;
-                req = std::make_shared<Request>(
+                req = Request::create(
                     traceRecord->m_data_address + rec_bytes_read,
                     RubySystem::getBlockSizeBytes(), 0,
                                 Request::funcRequestorId);
@@ -148,6 +149,74 @@ CacheRecorder::enqueueNextFetchRequest()
     }
 }
 
+uint64_t
+CacheRecorder::warmupBlocks(const std::vector<AbstractController *> &cntrls,
+                            RubySystem *ruby_system, bool validate)
+{
+    const uint32_t block_size = RubySystem::getBlockSizeBytes();
+    std::vector<uint8_t> read_data(block_size);
+    uint64_t blocks_installed = 0;
+
+    while (m_bytes_read < m_uncompressed_trace_size) {
+        TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
+                                                                m_bytes_read);
+
+        DPRINTF(RubyCacheTrace, "Installing %s\n", *traceRecord);
+
+        assert(traceRecord->m_cntrl_id < cntrls.size());
+        AbstractController *requestor = cntrls[traceRecord->m_cntrl_id];
+        const MachineID requestor_id = requestor->getMachineID();
+
+        for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
+                rec_bytes_read += block_size) {
+            const Addr addr = traceRecord->m_data_address + rec_bytes_read;
+            DataBlock data;
+            data.setData(traceRecord->m_data + rec_bytes_read, 0,
+                         block_size);
+
+            requestor->warmupBlock(addr, data, traceRecord->m_type,
+                                   requestor_id);
+            const AccessPermission perm =
+                requestor->getAccessPermission(addr);
+            if (perm != AccessPermission_Read_Only &&
+                perm != AccessPermission_Read_Write) {
+                DPRINTF(RubyCacheTrace, "Skipping %#x, not installed\n",
+                        addr);
+                continue;
+            }
+
+            for (auto *cntrl : cntrls) {
+                if (cntrl != requestor) {
+                    cntrl->warmupBlock(addr, data, traceRecord->m_type,
+                                       requestor_id);
+                }
+            }
+            blocks_installed++;
+
+            if (validate) {
+                auto req = Request::create(addr, block_size, 0,
+                                           Request::funcRequestorId);
+                Packet pkt(req, MemCmd::ReadReq);
+                pkt.dataStatic(read_data.data());
+                panic_if(!ruby_system->functionalRead(&pkt),
+                         "Block %#x cannot be read after being installed "
+                         "in %s.\n", addr, requestor->name());
+                panic_if(memcmp(read_data.data(), data.getData(0, block_size),
+                                block_size) != 0,
+                         "Block %#x installed in %s reads back different "
+                         "data.\n", addr, requestor->name());
+            }
+        }
+
+        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
+        m_records_read++;
+    }
+
+    DPRINTF(RubyCacheTrace, "Installed %d blocks from %d records\n",
+            blocks_installed, m_records_read);
+    return blocks_installed;
+}
+
 void
 CacheRecorder::addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                          RubyRequestType type, Tick time, DataBlock& data)
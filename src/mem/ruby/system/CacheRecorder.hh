@@ -43,6 +43,8 @@
 #include "mem/ruby/common/TypeDefines.hh"
 #include "mem/ruby/protocol/RubyRequestType.hh"
 
+class AbstractController;
+class RubySystem;
 class Sequencer;
 
 /*!
@@ -97,6 +99,23 @@ class CacheRecorder
      */
     void enqueueNextFetchRequest();
 
+    /*!
+     * Function for warming up the caches without simulating any
+     * requests. The recorded blocks are installed directly in the
+     * controllers in the states the protocol chooses for them, see
+     * AbstractController::warmupBlock(). Blocks the recording controller
+     * did not install, e.g. because the set was full, are skipped.
+     *
+     * @param cntrls Controllers of the system, indexed by the ids used
+     *        in the trace.
+     * @param ruby_system System to do the validation reads through.
+     * @param validate If set, check that a functional read of every
+     *        installed block returns the recorded data.
+     * @return The number of blocks installed.
+     */
+    uint64_t warmupBlocks(const std::vector<AbstractController *> &cntrls,
+                          RubySystem *ruby_system, bool validate);
+
   private:
     // Private copy constructor and assignment operator
     CacheRecorder(const CacheRecorder& obj);
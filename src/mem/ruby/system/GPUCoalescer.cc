@@ -630,12 +630,14 @@ GPUCoalescer::makeRequest(PacketPtr pkt)
         InstSeqNum seq_num = pkt->req->getReqInstSeqNum();
 
         // in the case of protocol tester, there is one packet per sequence
-        // number. The number of packets during simulation depends on the
-        // number of lanes actives for that vmem request (i.e., the popcnt
-        // of the exec_mask.
+        // number. The number of packets during simulation is decided by
+        // the CU when it builds the vmem request: active lanes that access
+        // consecutive bytes of a line share a packet, and a lane crossing
+        // a line boundary sends two.
         int num_packets = 1;
         if (!m_usingRubyTester) {
-            num_packets = getDynInst(pkt)->exec_mask.count();
+            num_packets = getDynInst(pkt)->numVectorReqs;
+            assert(num_packets > 0);
         }
 
         // the pkt is temporarily stored in the uncoalesced table until
@@ -164,11 +164,10 @@ HTMSequencer::htmCallback(Addr address,
                mode == HtmCallbackMode_ST_FAIL) {
         // transaction failed
         assert(address == makeLineAddress(address));
-        assert(m_RequestTable.find(address) != m_RequestTable.end());
+        assert(m_RequestTable.contains(address));
 
-        auto &seq_req_list = m_RequestTable[address];
-        while (!seq_req_list.empty()) {
-            SequencerRequest &request = seq_req_list.front();
+        while (m_RequestTable.contains(address)) {
+            SequencerRequest &request = *m_RequestTable.front(address);
 
             PacketPtr pkt = request.pkt;
             markRemoved();
@@ -189,11 +188,7 @@ HTMSequencer::htmCallback(Addr address,
             rubyHtmCallback(pkt, htm_return_code);
             testDrainComplete();
             pkt = nullptr;
-            seq_req_list.pop_front();
-        }
-        // free all outstanding requests corresponding to this address
-        if (seq_req_list.empty()) {
-            m_RequestTable.erase(address);
+            m_RequestTable.popFront(address);
         }
     } else {
         panic("unrecognised HTM callback mode\n");
@@ -48,6 +48,7 @@
 
 #include "base/intmath.hh"
 #include "base/statistics.hh"
+#include "config/ruby_block_size_bytes.hh"
 #include "debug/RubyCacheTrace.hh"
 #include "debug/RubySystem.hh"
 #include "mem/ruby/common/Address.hh"
@@ -71,12 +72,19 @@ bool RubySystem::m_cooldown_enabled = false;
 
 RubySystem::RubySystem(const Params &p)
     : ClockedObject(p), m_access_backing_store(p.access_backing_store),
+      m_direct_warmup(p.direct_warmup),
+      m_validate_warmup(p.validate_warmup && !p.access_backing_store),
       m_cache_recorder(NULL)
 {
     m_randomization = p.randomization;
 
     m_block_size_bytes = p.block_size_bytes;
     assert(isPowerOf2(m_block_size_bytes));
+    fatal_if(RUBY_BLOCK_SIZE_BYTES &&
+             m_block_size_bytes != RUBY_BLOCK_SIZE_BYTES,
+             "This binary was built for a Ruby block size of %d bytes, "
+             "but the block size is set to %d bytes.\n",
+             RUBY_BLOCK_SIZE_BYTES, m_block_size_bytes);
     m_block_size_bits = floorLog2(m_block_size_bytes);
     m_memory_size_bits = p.memory_size_bits;
 
@@ -422,7 +430,22 @@ RubySystem::startup()
     // Ruby finishes restoring the state is less than the time when the
     // state was checkpointed.
 
-    if (m_warmup_enabled) {
+    if (m_warmup_enabled && m_direct_warmup && directWarmupSupported()) {
+        // Installing the blocks directly doesn't simulate anything, so
+        // neither the clock nor the event queue need to be touched.
+        DPRINTF(RubyCacheTrace, "Installing ruby cache contents\n");
+        m_cache_recorder->warmupBlocks(m_abs_cntrl_vec, this,
+                                       m_validate_warmup);
+
+        delete m_cache_recorder;
+        m_cache_recorder = NULL;
+        m_systems_to_warmup--;
+        if (m_systems_to_warmup == 0) {
+            m_warmup_enabled = false;
+        }
+    } else if (m_warmup_enabled) {
+        warn_if(m_direct_warmup, "Direct cache warmup is not supported by "
+                "this protocol, replaying the cache trace instead.\n");
         DPRINTF(RubyCacheTrace, "Starting ruby cache warmup\n");
         // save the current tick value
         Tick curtick_original = curTick();
@@ -453,6 +476,16 @@ RubySystem::startup()
     resetStats();
 }
 
+bool
+RubySystem::directWarmupSupported() const
+{
+    for (auto *cntrl : m_abs_cntrl_vec) {
+        if (!cntrl->warmupSupported())
+            return false;
+    }
+    return true;
+}
+
 void
 RubySystem::processRubyEvent()
 {
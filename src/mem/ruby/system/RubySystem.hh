@@ -121,6 +121,9 @@ class RubySystem : public ClockedObject
                                      uint64_t uncompressed_trace_size);
 
     void processRubyEvent();
+
+    /** Can the caches be warmed up without replaying the trace? */
+    bool directWarmupSupported() const;
   private:
     // configuration parameters
     static bool m_randomization;
@@ -133,6 +136,8 @@ class RubySystem : public ClockedObject
     static bool m_cooldown_enabled;
     SimpleMemory *m_phys_mem;
     const bool m_access_backing_store;
+    const bool m_direct_warmup;
+    const bool m_validate_warmup;
 
     //std::vector<Network *> m_networks;
     std::vector<std::unique_ptr<Network>> m_networks;
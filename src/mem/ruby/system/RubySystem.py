@@ -47,6 +47,12 @@ class RubySystem(ClockedObject):
     access_backing_store = Param.Bool(False, "Use phys_mem as the functional \
         store and only use ruby for timing.")
 
+    direct_warmup = Param.Bool(False, "Restore the cache contents of a \
+        checkpoint by installing the blocks directly instead of replaying \
+        the accesses, if all the controllers support it")
+    validate_warmup = Param.Bool(True, "Check that the blocks installed by \
+        a direct warmup read back correctly")
+
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
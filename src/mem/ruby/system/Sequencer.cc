@@ -60,7 +60,8 @@
 #include "sim/system.hh"
 
 Sequencer::Sequencer(const Params &p)
-    : RubyPort(p), m_IncompleteTimes(MachineType_NUM),
+    : RubyPort(p), m_RequestTable(p.max_outstanding_requests),
+      m_IncompleteTimes(MachineType_NUM),
       deadlockCheckEvent([this]{ wakeup(); }, "Sequencer deadlock check")
 {
     m_outstanding_count = 0;
@@ -141,7 +142,7 @@ Sequencer::llscLoadLinked(const Addr claddr)
         "%s must have a dcache object to support LLSC requests.", name());
     AbstractCacheEntry *line = m_dataCache_ptr->lookup(claddr);
     if (line) {
-        line->setLocked(m_version);
+        m_dataCache_ptr->setLocked(claddr, m_version);
         DPRINTF(LLSC, "LLSC Monitor - inserting load linked - "
                       "addr=0x%lx - cpu=%u\n", claddr, m_version);
     }
@@ -217,21 +218,20 @@ Sequencer::wakeup()
     // Check across all outstanding requests
     int total_outstanding = 0;
 
-    for (const auto &table_entry : m_RequestTable) {
-        for (const auto &seq_req : table_entry.second) {
-            if (current_time - seq_req.issue_time < m_deadlock_threshold)
-                continue;
-
-            panic("Possible Deadlock detected. Aborting!\n version: %d "
-                  "request.paddr: 0x%x m_readRequestTable: %d current time: "
-                  "%u issue_time: %d difference: %d\n", m_version,
-                  seq_req.pkt->getAddr(), table_entry.second.size(),
-                  current_time * clockPeriod(), seq_req.issue_time
-                  * clockPeriod(), (current_time * clockPeriod())
-                  - (seq_req.issue_time * clockPeriod()));
-        }
-        total_outstanding += table_entry.second.size();
-    }
+    m_RequestTable.forEach([&](Addr line_addr,
+                               const SequencerRequest &seq_req) {
+        total_outstanding++;
+        if (current_time - seq_req.issue_time < m_deadlock_threshold)
+            return;
+
+        panic("Possible Deadlock detected. Aborting!\n version: %d "
+              "request.paddr: 0x%x m_readRequestTable: %d current time: "
+              "%u issue_time: %d difference: %d\n", m_version,
+              seq_req.pkt->getAddr(), m_RequestTable.count(line_addr),
+              current_time * clockPeriod(), seq_req.issue_time
+              * clockPeriod(), (current_time * clockPeriod())
+              - (seq_req.issue_time * clockPeriod()));
+    });
 
     assert(m_outstanding_count == total_outstanding);
 
@@ -246,12 +246,10 @@ Sequencer::functionalWrite(Packet *func_pkt)
 {
     int num_written = RubyPort::functionalWrite(func_pkt);
 
-    for (const auto &table_entry : m_RequestTable) {
-        for (const auto& seq_req : table_entry.second) {
-            if (seq_req.functionalWrite(func_pkt))
-                ++num_written;
-        }
-    }
+    m_RequestTable.forEach([&](Addr, const SequencerRequest &seq_req) {
+        if (seq_req.functionalWrite(func_pkt))
+            ++num_written;
+    });
 
     return num_written;
 }
@@ -299,13 +297,11 @@ Sequencer::insertRequest(PacketPtr pkt, RubyRequestType primary_type,
 
     Addr line_addr = makeLineAddress(pkt->getAddr());
     // Check if there is any outstanding request for the same cache line.
-    auto &seq_req_list = m_RequestTable[line_addr];
-    // Create a default entry
-    seq_req_list.emplace_back(pkt, primary_type,
-        secondary_type, curCycle());
+    const size_t num_line_reqs = m_RequestTable.insert(line_addr,
+        SequencerRequest(pkt, primary_type, secondary_type, curCycle()));
     m_outstanding_count++;
 
-    if (seq_req_list.size() > 1) {
+    if (num_line_reqs > 1) {
         return RequestStatus_Aliased;
     }
 
@@ -406,8 +402,7 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
     // to this cache line when response for the write comes back
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
-    auto &seq_req_list = m_RequestTable[address];
+    assert(m_RequestTable.contains(address));
 
     // Perform hitCallback on every cpu request made to this cache block while
     // ruby request was outstanding. Since only 1 ruby request was made,
@@ -415,8 +410,8 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
     bool ruby_request = true;
     int aliased_stores = 0;
     int aliased_loads = 0;
-    while (!seq_req_list.empty()) {
-        SequencerRequest &seq_req = seq_req_list.front();
+    while (m_RequestTable.contains(address)) {
+        SequencerRequest &seq_req = *m_RequestTable.front(address);
 
         if (noCoales && !ruby_request) {
             // Do not process follow-up requests
@@ -486,12 +481,7 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
                         initialRequestTime, forwardRequestTime,
                         firstResponseTime, !ruby_request);
         }
-        seq_req_list.pop_front();
-    }
-
-    // free all outstanding requests corresponding to this address
-    if (seq_req_list.empty()) {
-        m_RequestTable.erase(address);
+        m_RequestTable.popFront(address);
     }
 }
 
@@ -507,16 +497,15 @@ Sequencer::readCallback(Addr address, DataBlock& data,
     // or end of the corresponding list.
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
-    auto &seq_req_list = m_RequestTable[address];
+    assert(m_RequestTable.contains(address));
 
     // Perform hitCallback on every cpu request made to this cache block while
     // ruby request was outstanding. Since only 1 ruby request was made,
     // profile the ruby latency once.
     bool ruby_request = true;
     int aliased_loads = 0;
-    while (!seq_req_list.empty()) {
-        SequencerRequest &seq_req = seq_req_list.front();
+    while (m_RequestTable.contains(address)) {
+        SequencerRequest &seq_req = *m_RequestTable.front(address);
         if (ruby_request) {
             assert((seq_req.m_type == RubyRequestType_LD) ||
                    (seq_req.m_type == RubyRequestType_Load_Linked) ||
@@ -541,12 +530,7 @@ Sequencer::readCallback(Addr address, DataBlock& data,
                     initialRequestTime, forwardRequestTime,
                     firstResponseTime, !ruby_request);
         ruby_request = false;
-        seq_req_list.pop_front();
-    }
-
-    // free all outstanding requests corresponding to this address
-    if (seq_req_list.empty()) {
-        m_RequestTable.erase(address);
+        m_RequestTable.popFront(address);
     }
 }
 
@@ -775,11 +759,11 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
 
     // check if the packet has data as for example prefetch and flush
     // requests do not
-    std::shared_ptr<RubyRequest> msg =
-        std::make_shared<RubyRequest>(clockEdge(), pkt->getAddr(),
-                                      pkt->getSize(), pc, secondary_type,
-                                      RubyAccessMode_Supervisor, pkt,
-                                      PrefetchBit_No, proc_id, core_id);
+    RefCountingPtr<RubyRequest> msg =
+        new RubyRequest(clockEdge(), pkt->getAddr(),
+                        pkt->getSize(), pc, secondary_type,
+                        RubyAccessMode_Supervisor, pkt,
+                        PrefetchBit_No, proc_id, core_id);
 
     DPRINTFR(ProtocolTrace, "%15s %3s %10s%20s %6s>%-6s %#x %s\n",
             curTick(), m_version, "Seq", "Begin", "", "",
@@ -802,16 +786,17 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
     m_mandatory_q_ptr->enqueue(msg, clockEdge(), latency);
 }
 
-template <class KEY, class VALUE>
-std::ostream &
-operator<<(std::ostream &out, const std::unordered_map<KEY, VALUE> &map)
+static std::ostream &
+operator<<(std::ostream &out, const SequencerRequestTable &table)
 {
-    for (const auto &table_entry : map) {
-        out << "[ " << table_entry.first << " =";
-        for (const auto &seq_req : table_entry.second) {
-            out << " " << RubyRequestType_to_string(seq_req.m_second_type);
+    Addr last_line = MaxAddr;
+    table.forEach([&](Addr line_addr, const SequencerRequest &seq_req) {
+        if (line_addr != last_line) {
+            out << "[ " << line_addr << " =";
+            last_line = line_addr;
         }
-    }
+        out << " " << RubyRequestType_to_string(seq_req.m_second_type);
+    });
     out << " ]";
 
     return out;
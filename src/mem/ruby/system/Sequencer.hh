@@ -51,30 +51,9 @@
 #include "mem/ruby/protocol/SequencerRequestType.hh"
 #include "mem/ruby/structures/CacheMemory.hh"
 #include "mem/ruby/system/RubyPort.hh"
+#include "mem/ruby/system/SequencerRequestTable.hh"
 #include "params/RubySequencer.hh"
 
-struct SequencerRequest
-{
-    PacketPtr pkt;
-    RubyRequestType m_type;
-    RubyRequestType m_second_type;
-    Cycles issue_time;
-    SequencerRequest(PacketPtr _pkt, RubyRequestType _m_type,
-                     RubyRequestType _m_second_type, Cycles _issue_time)
-                : pkt(_pkt), m_type(_m_type), m_second_type(_m_second_type),
-                  issue_time(_issue_time)
-    {}
-
-    bool functionalWrite(Packet *func_pkt) const
-    {
-        // Follow-up on RubyRequest::functionalWrite
-        // This makes sure the hitCallback won't overrite the value we
-        // expect to find
-        assert(func_pkt->isWrite());
-        return func_pkt->trySatisfyFunctional(pkt);
-    }
-};
-
 std::ostream& operator<<(std::ostream& out, const SequencerRequest& obj);
 
 class Sequencer : public RubyPort
@@ -208,7 +187,7 @@ class Sequencer : public RubyPort
 
   protected:
     // RequestTable contains both read and write requests, handles aliasing
-    std::unordered_map<Addr, std::list<SequencerRequest>> m_RequestTable;
+    SequencerRequestTable m_RequestTable;
 
     Cycles m_deadlock_threshold;
 
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_SYSTEM_SEQUENCERREQUESTTABLE_HH__
+#define __MEM_RUBY_SYSTEM_SEQUENCERREQUESTTABLE_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "mem/ruby/protocol/RubyRequestType.hh"
+
+struct SequencerRequest
+{
+    PacketPtr pkt;
+    RubyRequestType m_type;
+    RubyRequestType m_second_type;
+    Cycles issue_time;
+    SequencerRequest(PacketPtr _pkt, RubyRequestType _m_type,
+                     RubyRequestType _m_second_type, Cycles _issue_time)
+                : pkt(_pkt), m_type(_m_type), m_second_type(_m_second_type),
+                  issue_time(_issue_time)
+    {}
+
+    bool functionalWrite(Packet *func_pkt) const
+    {
+        // Follow-up on RubyRequest::functionalWrite
+        // This makes sure the hitCallback won't overrite the value we
+        // expect to find
+        assert(func_pkt->isWrite());
+        return func_pkt->trySatisfyFunctional(pkt);
+    }
+};
+
+/**
+ * The outstanding requests of a sequencer, grouped by cache line.
+ *
+ * Requests are stored in slots which are allocated up front, enough
+ * for the maximum number of outstanding requests. The requests to a
+ * line are chained through their slots in the order they were
+ * inserted, and the chains are found through an open-addressed index
+ * of line addresses. Inserting and removing requests therefore doesn't
+ * allocate any memory, unless more requests than expected are
+ * outstanding (HTM aborts bypass the limit), in which case more slots
+ * are added. Requests never move while they are in the table.
+ */
+class SequencerRequestTable
+{
+  private:
+    static const int NoSlot = -1;
+
+    /** Address of the unused entries of the index. */
+    static const Addr EmptyKey = MaxAddr;
+
+    struct Slot
+    {
+        SequencerRequest req;
+        int next = NoSlot;
+
+        Slot() : req(nullptr, RubyRequestType_NULL, RubyRequestType_NULL,
+                     Cycles(0))
+        {}
+    };
+
+    struct Line
+    {
+        Addr addr = EmptyKey;
+        int head = NoSlot;
+        int tail = NoSlot;
+        size_t count = 0;
+    };
+
+    /** Slots are added in chunks, so that they never move. */
+    const size_t chunkSlots;
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    int freeSlots = NoSlot;
+
+    std::vector<Line> index;
+    size_t mask = 0;
+    unsigned shift = 0;
+    size_t numLines = 0;
+    size_t numRequests = 0;
+
+    Slot &
+    slot(int i)
+    {
+        return chunks[i / chunkSlots][i % chunkSlots];
+    }
+
+    const Slot &
+    slot(int i) const
+    {
+        return chunks[i / chunkSlots][i % chunkSlots];
+    }
+
+    void
+    addChunk()
+    {
+        const int first = chunks.size() * chunkSlots;
+        chunks.emplace_back(new Slot[chunkSlots]);
+        for (int i = first + chunkSlots - 1; i >= first; i--) {
+            slot(i).next = freeSlots;
+            freeSlots = i;
+        }
+    }
+
+    size_t
+    home(Addr addr) const
+    {
+        return (addr * 0x9E3779B97F4A7C15ULL) >> shift;
+    }
+
+    size_t next(size_t pos) const { return (pos + 1) & mask; }
+
+    /** Position of a line in the index, or of the slot it would use. */
+    size_t
+    findPos(Addr addr) const
+    {
+        for (size_t pos = home(addr); ; pos = next(pos)) {
+            if (index[pos].addr == addr || index[pos].addr == EmptyKey)
+                return pos;
+        }
+    }
+
+    void
+    rehash(size_t num_entries)
+    {
+        std::vector<Line> old_index(num_entries);
+        old_index.swap(index);
+        mask = num_entries - 1;
+        shift = 64 - floorLog2(num_entries);
+
+        for (const auto &line : old_index) {
+            if (line.addr != EmptyKey)
+                index[findPos(line.addr)] = line;
+        }
+    }
+
+    void
+    eraseLine(size_t pos)
+    {
+        // Shift the following lines of the probe sequence back, so that
+        // the index needs no tombstones
+        size_t hole = pos;
+        for (size_t i = next(pos); index[i].addr != EmptyKey; i = next(i)) {
+            const size_t ideal = home(index[i].addr);
+            if (((i - ideal) & mask) >= ((i - hole) & mask)) {
+                index[hole] = index[i];
+                hole = i;
+            }
+        }
+        index[hole] = Line();
+        numLines--;
+    }
+
+  public:
+    /**
+     * @param capacity Number of requests expected to be outstanding at
+     *        most.
+     */
+    SequencerRequestTable(size_t capacity)
+        : chunkSlots(capacity)
+    {
+        assert(capacity > 0);
+        addChunk();
+        rehash(size_t(1) << ceilLog2(2 * capacity));
+    }
+
+    /** Is there no outstanding request? */
+    bool empty() const { return numRequests == 0; }
+
+    /** Number of outstanding requests. */
+    size_t size() const { return numRequests; }
+
+    /** Are there outstanding requests to a line? */
+    bool
+    contains(Addr line_addr) const
+    {
+        return index[findPos(line_addr)].addr == line_addr;
+    }
+
+    /** Number of outstanding requests to a line. */
+    size_t
+    count(Addr line_addr) const
+    {
+        const Line &line = index[findPos(line_addr)];
+        return line.addr == line_addr ? line.count : 0;
+    }
+
+    /**
+     * Add a request to the end of the chain of its line.
+     *
+     * @return The number of requests to the line, including this one.
+     */
+    size_t
+    insert(Addr line_addr, const SequencerRequest &req)
+    {
+        assert(line_addr != EmptyKey);
+        if (freeSlots == NoSlot)
+            addChunk();
+        const int s = freeSlots;
+        freeSlots = slot(s).next;
+        slot(s).req = req;
+        slot(s).next = NoSlot;
+        numRequests++;
+
+        // Keep the load factor of the index at or below 1/2
+        if (2 * (numLines + 1) > index.size())
+            rehash(2 * index.size());
+
+        Line &line = index[findPos(line_addr)];
+        if (line.addr == EmptyKey) {
+            line.addr = line_addr;
+            line.head = s;
+            numLines++;
+        } else {
+            slot(line.tail).next = s;
+        }
+        line.tail = s;
+        return ++line.count;
+    }
+
+    /** Oldest request to a line, nullptr if there is none. */
+    SequencerRequest *
+    front(Addr line_addr)
+    {
+        const Line &line = index[findPos(line_addr)];
+        return line.addr == line_addr ? &slot(line.head).req : nullptr;
+    }
+
+    /** Remove the oldest request to a line. */
+    void
+    popFront(Addr line_addr)
+    {
+        const size_t pos = findPos(line_addr);
+        Line &line = index[pos];
+        assert(line.addr == line_addr);
+
+        const int s = line.head;
+        line.head = slot(s).next;
+        slot(s).req.pkt = nullptr;
+        slot(s).next = freeSlots;
+        freeSlots = s;
+        numRequests--;
+
+        if (--line.count == 0)
+            eraseLine(pos);
+    }
+
+    /**
+     * Call f(line_addr, req) on every outstanding request. The requests
+     * to a line are visited together, from the oldest one.
+     */
+    template <class F>
+    void
+    forEach(F f) const
+    {
+        for (const auto &line : index) {
+            if (line.addr == EmptyKey)
+                continue;
+            for (int s = line.head; s != NoSlot; s = slot(s).next)
+                f(line.addr, slot(s).req);
+        }
+    }
+};
+
+#endif // __MEM_RUBY_SYSTEM_SEQUENCERREQUESTTABLE_HH__
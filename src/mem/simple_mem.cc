@@ -288,6 +288,13 @@ SimpleMemory::MemoryPort::recvFunctional(PacketPtr pkt)
     memory.recvFunctional(pkt);
 }
 
+void
+SimpleMemory::MemoryPort::recvMemBackdoorReq(const AddrRange &range,
+                                             MemBackdoorPtr &_backdoor)
+{
+    memory.getFunctionalBackdoor(_backdoor);
+}
+
 bool
 SimpleMemory::MemoryPort::recvTimingReq(PacketPtr pkt)
 {
@@ -112,6 +112,12 @@ class StateMachine(Symbol):
     def __repr__(self):
         return "[StateMachine: %s]" % self.ident
 
+    @property
+    def useTransitionTable(self):
+        '''Dispatch transitions through a table of action sequences
+        rather than through a switch statement'''
+        return self.get("transition_table", "no") == "yes"
+
     def addState(self, state):
         assert self.table is None
         self.states[state.ident] = state
@@ -205,8 +211,156 @@ class StateMachine(Symbol):
                 if "desc" in action:
                     error_msg += ", "  + action.desc
                 action.warning(error_msg)
+            if "inline" in action and not self.useTransitionTable:
+                action.warning("Action %s is only inlined in machines " \
+                               "using a transition table" % action.ident)
         self.table = table
 
+    def transitionParams(self):
+        '''Parameters passed to the actions of a transition'''
+        params = []
+        if self.TBEType != None:
+            params.append("%s*& m_tbe_ptr" % self.TBEType.c_ident)
+        if self.EntryType != None:
+            params.append("%s*& m_cache_entry_ptr" % self.EntryType.c_ident)
+        params.append("Addr addr")
+        return params
+
+    def transitionArgs(self):
+        return [ p.split()[-1] for p in self.transitionParams() ]
+
+    def transitionCode(self, trans):
+        '''Code checking resources, setting the next state and running
+        the actions of a transition'''
+        ident = self.ident
+        case = self.symtab.codeFormatter()
+        # Only set next_state if it changes
+        if trans.state != trans.nextState:
+            if trans.nextState.isWildcard():
+                # When * is encountered as an end state of a transition,
+                # the next state is determined by calling the
+                # machine-specific getNextState function. The next state
+                # is determined before any actions of the transition
+                # execute, and therefore the next state calculation cannot
+                # depend on any of the transitionactions.
+                case('next_state = getNextState(addr); '
+                     'm_curTransitionNextState = next_state;')
+            else:
+                ns_ident = trans.nextState.ident
+                case('next_state = ${ident}_State_${ns_ident}; '
+                     'm_curTransitionNextState = next_state;')
+
+        actions = trans.actions
+        request_types = trans.request_types
+
+        # Check for resources
+        case_sorter = []
+        res = trans.resources
+        for key,val in res.items():
+            val = '''
+if (!%s.areNSlotsAvailable(%s, clockEdge()))
+    return TransitionResult_ResourceStall;
+''' % (key.code, val)
+            case_sorter.append(val)
+
+        # Check all of the request_types for resource constraints
+        for request_type in request_types:
+            val = '''
+if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
+    return TransitionResult_ResourceStall;
+}
+''' % (self.ident, request_type.ident)
+            case_sorter.append(val)
+
+        # Emit the code sequences in a sorted order.  This makes the
+        # output deterministic (without this the output order can vary
+        # since Map's keys() on a vector of pointers is not deterministic
+        for c in sorted(case_sorter):
+            case("$c")
+
+        # Record access types for this transition
+        for request_type in request_types:
+            case('recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);')
+
+        # Figure out if we stall
+        stall = False
+        for action in actions:
+            if action.ident == "z_stall":
+                stall = True
+                break
+
+        if stall:
+            case('return TransitionResult_ProtocolStall;')
+        else:
+            args = ", ".join(self.transitionArgs())
+            for action in actions:
+                case('${{action.ident}}($args);')
+            case('return TransitionResult_Valid;')
+
+        return str(case)
+
+    def actionInline(self, action):
+        '''Actions marked inline are only called from the action sequences
+        of a table driven machine, which are generated in the same file'''
+        if self.useTransitionTable and "inline" in action:
+            return "inline "
+        return ""
+
+    def printTransitionTable(self, code):
+        '''Output the action sequences and the transition table'''
+        ident = self.ident
+        c_ident = "%s_Controller" % self.ident
+        params = ", ".join(self.transitionParams())
+        funcs = self.transitionFuncs()
+
+        code('''
+// Action sequences
+''')
+        for case,name in funcs.items():
+            code('''
+TransitionResult
+$c_ident::$name(${ident}_State& next_state, $params)
+{
+''')
+            code.indent()
+            code('$case')
+            code.dedent()
+            code('}')
+            code()
+
+        table = {}
+        for trans in self.transitions:
+            table[(trans.state, trans.event)] = \
+                funcs[self.transitionCode(trans)]
+
+        code('''
+
+const $c_ident::TransitionFunc
+$c_ident::transitionTable[${ident}_State_NUM * ${ident}_Event_NUM] = {
+''')
+        code.indent()
+        for state in self.states.values():
+            code('// ${ident}_State_${{state.ident}}')
+            for event in self.events.values():
+                if (state, event) in table:
+                    name = table[(state, event)]
+                    code('&$c_ident::$name,')
+                else:
+                    code('nullptr,')
+        code.dedent()
+        code('};')
+
+    def transitionFuncs(self):
+        '''Map the code of every distinct transition to the name of the
+        function implementing it in a table driven machine'''
+        funcs = OrderedDict()
+        for trans in self.transitions:
+            case = self.transitionCode(trans)
+            if case not in funcs:
+                funcs[case] = "transition_%s_%s" % \
+                    (trans.state.ident, trans.event.ident)
+        return funcs
+
     # determine the port->msg buffer mappings
     def getBufferMaps(self, ident):
         msg_bufs = []
@@ -332,10 +486,12 @@ class $c_ident : public AbstractController
     int functionalWriteBuffers(PacketPtr&);
 
     void countTransition(${ident}_State state, ${ident}_Event event);
+    void countStall(${ident}_State state, ${ident}_Event event);
     void possibleTransition(${ident}_State state, ${ident}_Event event);
     uint64_t getEventCount(${ident}_Event event);
     bool isPossible(${ident}_State state, ${ident}_Event event);
     uint64_t getTransitionCount(${ident}_State state, ${ident}_Event event);
+    uint64_t getStallCount(${ident}_State state, ${ident}_Event event);
 
 private:
 ''')
@@ -380,6 +536,30 @@ TransitionResult doTransitionWorker(${ident}_Event event,
 
         code('''
                                     Addr addr);
+''')
+
+        if self.useTransitionTable:
+            params = ", ".join(self.transitionParams())
+            code('''
+
+/**
+ * Action sequence of one or more transitions. This checks that the
+ * resources needed by the transition are available, computes the next
+ * state and runs the actions of the transition.
+ */
+typedef TransitionResult (${ident}_Controller::*TransitionFunc)(
+    ${ident}_State& next_state, $params);
+
+/** Action sequences indexed by HASH_FUN(state, event). */
+static const TransitionFunc transitionTable[${ident}_State_NUM *
+                                            ${ident}_Event_NUM];
+
+''')
+            for name in self.transitionFuncs().values():
+                code('TransitionResult $name(${ident}_State& next_state, '
+                     '$params);')
+
+        code('''
 
 ${ident}_Event m_curTransitionEvent;
 ${ident}_State m_curTransitionNextState;
@@ -388,11 +568,13 @@ ${ident}_Event curTransitionEvent() { return m_curTransitionEvent; }
 ${ident}_State curTransitionNextState() { return m_curTransitionNextState; }
 
 int m_counters[${ident}_State_NUM][${ident}_Event_NUM];
+int m_stall_counters[${ident}_State_NUM][${ident}_Event_NUM];
 int m_event_counters[${ident}_Event_NUM];
 bool m_possible[${ident}_State_NUM][${ident}_Event_NUM];
 
 static std::vector<Stats::Vector *> eventVec;
 static std::vector<std::vector<Stats::Vector *> > transVec;
+static std::vector<std::vector<Stats::Vector *> > stallVec;
 static int m_num_controllers;
 
 // Internal functions
@@ -538,6 +720,7 @@ void unset_tbe(${{self.TBEType.c_ident}}*& m_tbe_ptr);
 int $c_ident::m_num_controllers = 0;
 std::vector<Stats::Vector *>  $c_ident::eventVec;
 std::vector<std::vector<Stats::Vector *> >  $c_ident::transVec;
+std::vector<std::vector<Stats::Vector *> >  $c_ident::stallVec;
 
 // for adding information to the protocol debug trace
 std::stringstream ${ident}_transitionComment;
@@ -587,6 +770,7 @@ for (int state = 0; state < ${ident}_State_NUM; state++) {
     for (int event = 0; event < ${ident}_Event_NUM; event++) {
         m_possible[state][event] = false;
         m_counters[state][event] = 0;
+        m_stall_counters[state][event] = 0;
     }
 }
 for (int event = 0; event < ${ident}_Event_NUM; event++) {
@@ -849,6 +1033,25 @@ $c_ident::regStats()
                 transVec[state].push_back(t);
             }
         }
+
+        for (${ident}_State state = ${ident}_State_FIRST;
+             state < ${ident}_State_NUM; ++state) {
+
+            stallVec.push_back(std::vector<Stats::Vector *>());
+
+            for (${ident}_Event event = ${ident}_Event_FIRST;
+                 event < ${ident}_Event_NUM; ++event) {
+                std::string stat_name = "${c_ident}." +
+                    ${ident}_State_to_string(state) +
+                    "." + ${ident}_Event_to_string(event) + ".stalls";
+                Stats::Vector *t =
+                    new Stats::Vector(profilerStatsPtr, stat_name.c_str());
+                t->init(m_num_controllers);
+                t->flags(Stats::pdf | Stats::total | Stats::oneline |
+                         Stats::nozero);
+                stallVec[state].push_back(t);
+            }
+        }
     }
 
     for (${ident}_Event event = ${ident}_Event_FIRST;
@@ -930,6 +1133,8 @@ $c_ident::collateStats()
                 assert(it != rs->m_abstract_controls[MachineType_${ident}].end());
                 (*transVec[state][event])[i] =
                     (($c_ident *)(*it).second)->getTransitionCount(state, event);
+                (*stallVec[state][event])[i] =
+                    (($c_ident *)(*it).second)->getStallCount(state, event);
             }
         }
     }
@@ -942,6 +1147,13 @@ $c_ident::countTransition(${ident}_State state, ${ident}_Event event)
     m_counters[state][event]++;
     m_event_counters[event]++;
 }
+
+void
+$c_ident::countStall(${ident}_State state, ${ident}_Event event)
+{
+    m_stall_counters[state][event]++;
+}
+
 void
 $c_ident::possibleTransition(${ident}_State state,
                              ${ident}_Event event)
@@ -968,6 +1180,12 @@ $c_ident::getTransitionCount(${ident}_State state,
     return m_counters[state][event];
 }
 
+uint64_t
+$c_ident::getStallCount(${ident}_State state, ${ident}_Event event)
+{
+    return m_stall_counters[state][event];
+}
+
 int
 $c_ident::getNumControllers()
 {
@@ -1003,6 +1221,7 @@ void $c_ident::resetStats()
     for (int state = 0; state < ${ident}_State_NUM; state++) {
         for (int event = 0; event < ${ident}_Event_NUM; event++) {
             m_counters[state][event] = 0;
+            m_stall_counters[state][event] = 0;
         }
     }
 
@@ -1074,9 +1293,10 @@ $c_ident::recordCacheTrace(int cntrl, CacheRecorder* tr)
                 if "c_code" not in action:
                  continue
 
+                inline = self.actionInline(action)
                 code('''
 /** \\brief ${{action.desc}} */
-void
+${inline}void
 $c_ident::${{action.ident}}(${{self.TBEType.c_ident}}*& m_tbe_ptr, ${{self.EntryType.c_ident}}*& m_cache_entry_ptr, Addr addr)
 {
     DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
@@ -1095,9 +1315,10 @@ $c_ident::${{action.ident}}(${{self.TBEType.c_ident}}*& m_tbe_ptr, ${{self.Entry
                 if "c_code" not in action:
                  continue
 
+                inline = self.actionInline(action)
                 code('''
 /** \\brief ${{action.desc}} */
-void
+${inline}void
 $c_ident::${{action.ident}}(${{self.TBEType.c_ident}}*& m_tbe_ptr, Addr addr)
 {
     DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
@@ -1110,9 +1331,10 @@ $c_ident::${{action.ident}}(${{self.TBEType.c_ident}}*& m_tbe_ptr, Addr addr)
                 if "c_code" not in action:
                  continue
 
+                inline = self.actionInline(action)
                 code('''
 /** \\brief ${{action.desc}} */
-void
+${inline}void
 $c_ident::${{action.ident}}(${{self.EntryType.c_ident}}*& m_cache_entry_ptr, Addr addr)
 {
     DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
@@ -1125,9 +1347,10 @@ $c_ident::${{action.ident}}(${{self.EntryType.c_ident}}*& m_cache_entry_ptr, Add
                 if "c_code" not in action:
                  continue
 
+                inline = self.actionInline(action)
                 code('''
 /** \\brief ${{action.desc}} */
-void
+${inline}void
 $c_ident::${{action.ident}}(Addr addr)
 {
     DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
@@ -1135,6 +1358,9 @@ $c_ident::${{action.ident}}(Addr addr)
 }
 
 ''')
+        if self.useTransitionTable:
+            self.printTransitionTable(code)
+
         for func in self.functions:
             code(func.generateCode())
 
@@ -1439,6 +1665,7 @@ if (result == TransitionResult_Valid) {
 
         code('''
 } else if (result == TransitionResult_ResourceStall) {
+    countStall(state, event);
     DPRINTFR(ProtocolTrace, "%15s %3s %10s%20s %6s>%-6s %#x %s\\n",
              curTick(), m_version, "${ident}",
              ${ident}_Event_to_string(event),
@@ -1446,6 +1673,7 @@ if (result == TransitionResult_Valid) {
              ${ident}_State_to_string(next_state),
              printAddress(addr), "Resource Stall");
 } else if (result == TransitionResult_ProtocolStall) {
+    countStall(state, event);
     DPRINTF(RubyGenerated, "stalling\\n");
     DPRINTFR(ProtocolTrace, "%15s %3s %10s%20s %6s>%-6s %#x %s\\n",
              curTick(), m_version, "${ident}",
@@ -1480,9 +1708,26 @@ ${ident}_Controller::doTransitionWorker(${ident}_Event event,
 {
     m_curTransitionEvent = event;
     m_curTransitionNextState = next_state;
-    switch(HASH_FUN(state, event)) {
 ''')
 
+        if self.useTransitionTable:
+            args = ", ".join(self.transitionArgs())
+            code('''
+    TransitionFunc func = transitionTable[HASH_FUN(state, event)];
+    if (func == nullptr) {
+        panic("Invalid transition\\n"
+              "%s time: %d addr: %#x event: %s state: %s\\n",
+              name(), curCycle(), addr, event, state);
+    }
+
+    return (this->*func)(next_state, $args);
+}
+''')
+            code.write(path, "%s_Transitions.cc" % self.ident)
+            return
+
+        code('    switch(HASH_FUN(state, event)) {')
+
         # This map will allow suppress generating duplicate code
         cases = OrderedDict()
 
@@ -1490,80 +1735,7 @@ ${ident}_Controller::doTransitionWorker(${ident}_Event event,
             case_string = "%s_State_%s, %s_Event_%s" % \
                 (self.ident, trans.state.ident, self.ident, trans.event.ident)
 
-            case = self.symtab.codeFormatter()
-            # Only set next_state if it changes
-            if trans.state != trans.nextState:
-                if trans.nextState.isWildcard():
-                    # When * is encountered as an end state of a transition,
-                    # the next state is determined by calling the
-                    # machine-specific getNextState function. The next state
-                    # is determined before any actions of the transition
-                    # execute, and therefore the next state calculation cannot
-                    # depend on any of the transitionactions.
-                    case('next_state = getNextState(addr); '
-                         'm_curTransitionNextState = next_state;')
-                else:
-                    ns_ident = trans.nextState.ident
-                    case('next_state = ${ident}_State_${ns_ident}; '
-                         'm_curTransitionNextState = next_state;')
-
-            actions = trans.actions
-            request_types = trans.request_types
-
-            # Check for resources
-            case_sorter = []
-            res = trans.resources
-            for key,val in res.items():
-                val = '''
-if (!%s.areNSlotsAvailable(%s, clockEdge()))
-    return TransitionResult_ResourceStall;
-''' % (key.code, val)
-                case_sorter.append(val)
-
-            # Check all of the request_types for resource constraints
-            for request_type in request_types:
-                val = '''
-if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
-    return TransitionResult_ResourceStall;
-}
-''' % (self.ident, request_type.ident)
-                case_sorter.append(val)
-
-            # Emit the code sequences in a sorted order.  This makes the
-            # output deterministic (without this the output order can vary
-            # since Map's keys() on a vector of pointers is not deterministic
-            for c in sorted(case_sorter):
-                case("$c")
-
-            # Record access types for this transition
-            for request_type in request_types:
-                case('recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);')
-
-            # Figure out if we stall
-            stall = False
-            for action in actions:
-                if action.ident == "z_stall":
-                    stall = True
-                    break
-
-            if stall:
-                case('return TransitionResult_ProtocolStall;')
-            else:
-                if self.TBEType != None and self.EntryType != None:
-                    for action in actions:
-                        case('${{action.ident}}(m_tbe_ptr, m_cache_entry_ptr, addr);')
-                elif self.TBEType != None:
-                    for action in actions:
-                        case('${{action.ident}}(m_tbe_ptr, addr);')
-                elif self.EntryType != None:
-                    for action in actions:
-                        case('${{action.ident}}(m_cache_entry_ptr, addr);')
-                else:
-                    for action in actions:
-                        case('${{action.ident}}(addr);')
-                case('return TransitionResult_Valid;')
-
-            case = str(case)
+            case = self.transitionCode(trans)
 
             # Look to see if this transition code is unique.
             if case not in cases:
@@ -48,13 +48,15 @@
 #include "sim/system.hh"
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
+const size_t SnoopFilter::SnoopFilterCache::NoSlot;
+const Addr SnoopFilter::SnoopFilterCache::EmptyKey;
 
 void
-SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
+SnoopFilter::eraseIfNullEntry(size_t sf_slot)
 {
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = cachedLocations.item(sf_slot);
     if ((sf_item.requested | sf_item.holder).none()) {
-        cachedLocations.erase(sf_it);
+        cachedLocations.erase(sf_slot);
         DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
                 __func__);
     }
@@ -75,8 +77,9 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         line_addr |= LineSecure;
     }
     SnoopMask req_port = portToMask(cpu_side_port);
-    reqLookupResult.it = cachedLocations.find(line_addr);
-    bool is_hit = (reqLookupResult.it != cachedLocations.end());
+    reqLookupResult.slot = cachedLocations.find(line_addr);
+    reqLookupResult.lineAddr = line_addr;
+    bool is_hit = (reqLookupResult.slot != SnoopFilterCache::NoSlot);
 
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
@@ -84,12 +87,11 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
     if (!is_hit && !allocate)
         return snoopDown(lookupLatency);
 
-    // If no hit in snoop filter create a new element and update iterator
+    // If no hit in snoop filter create a new element and update the slot
     if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
+        reqLookupResult.slot = cachedLocations.findOrInsert(line_addr);
     }
-    SnoopItem& sf_item = reqLookupResult.it->second;
+    SnoopItem& sf_item = cachedLocations.item(reqLookupResult.slot);
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -156,26 +158,37 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
-    if (reqLookupResult.it != cachedLocations.end()) {
+    if (reqLookupResult.slot != SnoopFilterCache::NoSlot) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
         Addr line_addr = (addr & ~(Addr(linesize - 1)));
         if (is_secure) {
             line_addr |= LineSecure;
         }
-        assert(reqLookupResult.it->first == line_addr);
+        assert(reqLookupResult.lineAddr == line_addr);
+
+        // Other entries may have been inserted or erased since the
+        // lookup, moving this one to another slot
+        size_t sf_slot = reqLookupResult.slot;
+        if (cachedLocations.key(sf_slot) != line_addr) {
+            sf_slot = cachedLocations.find(line_addr);
+            panic_if(sf_slot == SnoopFilterCache::NoSlot,
+                     "SF entry of %#x removed before the request finished\n",
+                     line_addr);
+        }
+
         if (will_retry) {
             SnoopItem retry_item = reqLookupResult.retryItem;
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult.it->second = retry_item;
+            cachedLocations.item(sf_slot) = retry_item;
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
                     __func__,  retry_item.requested, retry_item.holder);
         }
 
-        eraseIfNullEntry(reqLookupResult.it);
+        eraseIfNullEntry(sf_slot);
     }
 }
 
@@ -190,10 +203,11 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = (sf_it != cachedLocations.end());
+    const size_t sf_slot = cachedLocations.find(line_addr);
+    bool is_hit = (sf_slot != SnoopFilterCache::NoSlot);
 
-    panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
+    panic_if(!is_hit && maxEntryCount &&
+             (cachedLocations.size() >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
 
@@ -203,7 +217,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (!is_hit)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = cachedLocations.item(sf_slot);
 
     SnoopMask interested = (sf_item.holder | sf_item.requested);
 
@@ -233,7 +247,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         sf_item.holder = 0;
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(sf_slot);
     }
 
     return snoopSelected(maskToPortList(interested), lookupLatency);
@@ -263,7 +277,8 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    SnoopItem& sf_item =
+        cachedLocations.item(cachedLocations.findOrInsert(line_addr));
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -310,8 +325,8 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = sf_it != cachedLocations.end();
+    const size_t sf_slot = cachedLocations.find(line_addr);
+    bool is_hit = sf_slot != SnoopFilterCache::NoSlot;
 
     // Nothing to do if it is not a hit
     if (!is_hit)
@@ -321,7 +336,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     // Modified state, and we know that there are no other copies, or
     // they will all be invalidated imminently
     if (!cpkt->hasSharers()) {
-        SnoopItem& sf_item = sf_it->second;
+        SnoopItem& sf_item = cachedLocations.item(sf_slot);
 
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
@@ -329,7 +344,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
 
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(sf_slot);
     }
 }
 
@@ -352,12 +367,12 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    if (sf_it == cachedLocations.end())
+    const size_t sf_slot = cachedLocations.find(line_addr);
+    if (sf_slot == SnoopFilterCache::NoSlot)
         return;
 
     SnoopMask response_mask = portToMask(cpu_side_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = cachedLocations.item(sf_slot);
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -376,7 +391,7 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
         if (cpkt->isInvalidate()) {
             sf_item.holder &= ~response_mask;
         }
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(sf_slot);
     } else {
         // Any other response implies that a cache above will have the
         // block.
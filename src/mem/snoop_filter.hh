@@ -44,9 +44,10 @@
 #define __MEM_SNOOP_FILTER_HH__
 
 #include <bitset>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
@@ -92,7 +93,7 @@ class SnoopFilter : public SimObject {
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
     SnoopFilter (const SnoopFilterParams &p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
+        SimObject(p),
         linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
         maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
         stats(this)
@@ -215,10 +216,152 @@ class SnoopFilter : public SimObject {
         SnoopMask requested;
         SnoopMask holder;
     };
+
     /**
-     * HashMap of SnoopItems indexed by line address
+     * Hash map of SnoopItems indexed by line address. It is looked up by
+     * every request and snoop going through the crossbar, so it is an
+     * open-addressed table with linear probing: the keys are stored
+     * contiguously, apart from the items, so that a probe sequence
+     * usually stays within a cache line of the host. Items are referred
+     * to by the slot they are stored in. Inserting or erasing an item
+     * may move the other ones to a different slot.
      */
-    typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
+    class SnoopFilterCache
+    {
+      public:
+        /** Slot returned when a line is not tracked. */
+        static const size_t NoSlot = ~size_t(0);
+
+        SnoopFilterCache()
+        {
+            rehash(MinSlots);
+        }
+
+        /** Number of tracked lines. */
+        size_t size() const { return count; }
+
+        /**
+         * Find the slot of a line.
+         *
+         * @param line_addr Line address, including the status bits.
+         * @return The slot of the line, or NoSlot if it is not tracked.
+         */
+        size_t
+        find(Addr line_addr) const
+        {
+            for (size_t slot = home(line_addr); ; slot = next(slot)) {
+                if (keys[slot] == line_addr)
+                    return slot;
+                if (keys[slot] == EmptyKey)
+                    return NoSlot;
+            }
+        }
+
+        /**
+         * Find the slot of a line, tracking it with an empty item if it
+         * isn't tracked yet.
+         *
+         * @param line_addr Line address, including the status bits.
+         * @return The slot of the line.
+         */
+        size_t
+        findOrInsert(Addr line_addr)
+        {
+            assert(line_addr != EmptyKey);
+            // Keep the load factor at or below 1/2, so that missing
+            // lines are found to be missing after a few probes
+            if (2 * (count + 1) > keys.size())
+                rehash(2 * keys.size());
+
+            size_t slot = home(line_addr);
+            for (; keys[slot] != EmptyKey; slot = next(slot)) {
+                if (keys[slot] == line_addr)
+                    return slot;
+            }
+            keys[slot] = line_addr;
+            items[slot] = SnoopItem();
+            count++;
+            return slot;
+        }
+
+        /**
+         * Stop tracking the line stored in a slot. The following items
+         * of its probe sequence are shifted back, so that no tombstones
+         * are needed.
+         */
+        void
+        erase(size_t slot)
+        {
+            assert(keys[slot] != EmptyKey);
+            size_t hole = slot;
+            for (size_t i = next(slot); keys[i] != EmptyKey; i = next(i)) {
+                // An item can fill the hole if the hole lies between the
+                // item's home slot and its current slot
+                const size_t ideal = home(keys[i]);
+                if (((i - ideal) & mask) >= ((i - hole) & mask)) {
+                    keys[hole] = keys[i];
+                    items[hole] = items[i];
+                    hole = i;
+                }
+            }
+            keys[hole] = EmptyKey;
+            count--;
+        }
+
+        /** Line address stored in a slot. */
+        Addr key(size_t slot) const { return keys[slot]; }
+
+        /** Item stored in a slot. */
+        SnoopItem &item(size_t slot) { return items[slot]; }
+
+      private:
+        /**
+         * Key of the empty slots. Line addresses are aligned, and only
+         * the lowest bit is used for the status.
+         */
+        static const Addr EmptyKey = MaxAddr;
+
+        /** Initial number of slots, a power of 2. */
+        static const size_t MinSlots = 64;
+
+        std::vector<Addr> keys;
+        std::vector<SnoopItem> items;
+        size_t mask = 0;
+        unsigned shift = 0;
+        size_t count = 0;
+
+        /** Slot where the probe sequence of a line starts. */
+        size_t
+        home(Addr line_addr) const
+        {
+            // Fibonacci hashing, the high bits of the product depend on
+            // all the bits of the address
+            return (line_addr * 0x9E3779B97F4A7C15ULL) >> shift;
+        }
+
+        size_t next(size_t slot) const { return (slot + 1) & mask; }
+
+        void
+        rehash(size_t num_slots)
+        {
+            std::vector<Addr> old_keys(num_slots, EmptyKey);
+            std::vector<SnoopItem> old_items(num_slots);
+            old_keys.swap(keys);
+            old_items.swap(items);
+            mask = num_slots - 1;
+            shift = 64 - floorLog2(num_slots);
+
+            for (size_t i = 0; i < old_keys.size(); i++) {
+                if (old_keys[i] == EmptyKey)
+                    continue;
+                size_t slot = home(old_keys[i]);
+                while (keys[slot] != EmptyKey)
+                    slot = next(slot);
+                keys[slot] = old_keys[i];
+                items[slot] = old_items[i];
+            }
+        }
+    };
 
     /**
      * Simple factory methods for standard return values.
@@ -256,7 +399,7 @@ class SnoopFilter : public SimObject {
     /**
      * Removes snoop filter items which have no requestors and no holders.
      */
-    void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
+    void eraseIfNullEntry(size_t sf_slot);
 
     /** Simple hash set of cached addresses. */
     SnoopFilterCache cachedLocations;
@@ -268,8 +411,17 @@ class SnoopFilter : public SimObject {
      * This structure keeps track of the state previous to such changes.
      */
     struct ReqLookupResult {
-        /** Iterator used to store the result from lookupRequest. */
-        SnoopFilterCache::iterator it;
+        /**
+         * Slot of the entry found or allocated by lookupRequest, or
+         * NoSlot if there was none.
+         */
+        size_t slot = SnoopFilterCache::NoSlot;
+
+        /**
+         * Line address of the entry, used to find it again if it was
+         * moved to another slot in the meantime.
+         */
+        Addr lineAddr = 0;
 
         /**
          * Variable to temporarily store value of snoopfilter entry
@@ -277,18 +429,6 @@ class SnoopFilter : public SimObject {
          * (because of crossbar retry)
          */
         SnoopItem retryItem;
-
-        /**
-         * The constructor must be informed of the internal cache's end
-         * iterator, so do not allow the compiler to implictly define it.
-         *
-         * @param end_it Iterator to the end of the internal cache.
-         */
-        ReqLookupResult(SnoopFilterCache::iterator end_it)
-            : it(end_it), retryItem{0, 0}
-        {
-        }
-        ReqLookupResult() = delete;
     } reqLookupResult;
 
     /** List of all attached snooping CPU-side ports. */
@@ -299,7 +439,10 @@ class SnoopFilter : public SimObject {
     const unsigned linesize;
     /** Latency for doing a lookup in the filter */
     const Cycles lookupLatency;
-    /** Max capacity in terms of cache blocks tracked, for sanity checking */
+    /**
+     * Max capacity in terms of cache blocks tracked, for sanity checking.
+     * No limit is enforced if it is 0.
+     */
     const unsigned maxEntryCount;
 
     /**
@@ -54,6 +54,7 @@
 TranslatingPortProxy::TranslatingPortProxy(
         ThreadContext *tc, Request::Flags _flags) :
     PortProxy(tc->getCpuPtr()->getSendFunctional(),
+              tc->getCpuPtr()->getSendMemBackdoorReq(),
               tc->getSystemPtr()->cacheLineSize()), _tc(tc),
               pageBytes(tc->getSystemPtr()->getPageBytes()),
               flags(_flags)
@@ -82,7 +83,7 @@ TranslatingPortProxy::tryReadBlob(Addr addr, void *p, int size) const
     for (ChunkGenerator gen(addr, size, pageBytes); !gen.done();
          gen.next())
     {
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
                 gen.addr(), gen.size(), flags, Request::funcRequestorId, 0,
                 _tc->contextId());
 
@@ -104,7 +105,7 @@ TranslatingPortProxy::tryWriteBlob(
     for (ChunkGenerator gen(addr, size, pageBytes); !gen.done();
          gen.next())
     {
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
                 gen.addr(), gen.size(), flags, Request::funcRequestorId, 0,
                 _tc->contextId());
 
@@ -124,7 +125,7 @@ TranslatingPortProxy::tryMemsetBlob(Addr address, uint8_t v, int size) const
     for (ChunkGenerator gen(address, size, pageBytes); !gen.done();
          gen.next())
     {
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
                 gen.addr(), gen.size(), flags, Request::funcRequestorId, 0,
                 _tc->contextId());
 
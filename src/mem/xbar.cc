@@ -45,6 +45,8 @@
 
 #include "mem/xbar.hh"
 
+#include <algorithm>
+
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
@@ -330,6 +332,13 @@ BaseXBar::findPort(AddrRange addr_range)
     // ranges of all connected CPU-side-port modules
     assert(gotAllAddrRanges);
 
+    // Check the decode table first, it covers the whole address map
+    // unless a packet straddles ranges or interleaving stripes
+    const PortID decoded = decode(addr_range);
+    if (decoded != InvalidPortID) {
+        return decoded;
+    }
+
     // Check the address map interval tree
     auto i = portMap.contains(addr_range);
     if (i != portMap.end()) {
@@ -355,6 +364,64 @@ BaseXBar::findPort(AddrRange addr_range)
           name());
 }
 
+PortID
+BaseXBar::decode(const AddrRange &addr_range) const
+{
+    const Addr start = addr_range.start();
+    const Addr end = addr_range.end();
+
+    // Find the last entry starting at or before the range
+    auto entry = std::upper_bound(decodeTable.begin(), decodeTable.end(),
+        start, [](Addr addr, const DecodeEntry &e)
+                  { return addr < e.range.start(); });
+    if (entry == decodeTable.begin()) {
+        return InvalidPortID;
+    }
+    --entry;
+
+    const AddrRange &range = entry->range;
+    if (end > range.end() || start >= end) {
+        return InvalidPortID;
+    }
+    if (!range.interleaved()) {
+        return entry->ports.front();
+    }
+
+    // An interleaved range must fit in a single stripe
+    const uint8_t stripe = range.selectIntlv(start);
+    if (end - start > entry->granularity ||
+        range.selectIntlv(end - 1) != stripe) {
+        return InvalidPortID;
+    }
+    return entry->ports[stripe];
+}
+
+void
+BaseXBar::buildDecodeTable()
+{
+    decodeTable.clear();
+
+    // The address map is sorted by start address, and the ranges that
+    // interleave the same region are next to each other
+    for (const auto& r: portMap) {
+        if (decodeTable.empty() ||
+            !decodeTable.back().range.mergesWith(r.first)) {
+            panic_if(!decodeTable.empty() &&
+                     decodeTable.back().range.end() > r.first.start(),
+                     "%s: range %s overlaps range %s\n", name(),
+                     r.first.to_string(),
+                     decodeTable.back().range.to_string());
+            decodeTable.push_back(DecodeEntry{r.first,
+                r.first.granularity(),
+                std::vector<PortID>(r.first.stripes(), InvalidPortID)});
+        }
+        decodeTable.back().ports[r.first.getIntlvMatch()] = r.second;
+    }
+
+    DPRINTF(AddrRanges, "Decode table has %d entries\n",
+            decodeTable.size());
+}
+
 /** Function called by the port when the crossbar is receiving a range change.*/
 void
 BaseXBar::recvRangeChange(PortID mem_side_port_id)
@@ -433,6 +500,8 @@ BaseXBar::recvRangeChange(PortID mem_side_port_id)
     // modules, go ahead and tell our connected memory-side-port modules in
     // turn, this effectively assumes a tree structure of the system
     if (gotAllAddrRanges) {
+        buildDecodeTable();
+
         DPRINTF(AddrRanges, "Aggregating address ranges\n");
         xbarRanges.clear();
 
@@ -47,9 +47,10 @@
 #define __MEM_XBAR_HH__
 
 #include <deque>
-#include <unordered_map>
+#include <vector>
 
 #include "base/addr_range_map.hh"
+#include "base/intmath.hh"
 #include "base/types.hh"
 #include "mem/qport.hh"
 #include "params/BaseXBar.hh"
@@ -315,13 +316,164 @@ class BaseXBar : public ClockedObject
 
     AddrRangeMap<PortID, 3> portMap;
 
+    /**
+     * An entry of the address decode table. It covers either a single
+     * range of the address map, or all the ranges of the address map that
+     * interleave the same region, in which case the port of an address
+     * is selected directly by the address' interleaving bits.
+     */
+    struct DecodeEntry
+    {
+        /** One of the ranges covered by the entry. */
+        AddrRange range;
+
+        /** Interleaving granularity of the ranges. */
+        Addr granularity;
+
+        /**
+         * Port of each stripe, indexed by the interleaving value. A
+         * stripe served by no port is InvalidPortID.
+         */
+        std::vector<PortID> ports;
+    };
+
+    /**
+     * The address map, flattened into non-overlapping entries sorted by
+     * start address, so that the common lookups are a binary search
+     * rather than a search of the interval tree. It is rebuilt whenever
+     * the address map changes once all ranges are known.
+     */
+    std::vector<DecodeEntry> decodeTable;
+
+    /** Rebuild the decode table from the address map. */
+    void buildDecodeTable();
+
+    /**
+     * Look up a range in the decode table.
+     *
+     * @param addr_range Address range to find port for.
+     * @return id of the port of the range, or InvalidPortID if the
+     *         range is not fully contained in an entry.
+     */
+    PortID decode(const AddrRange &addr_range) const;
+
+    /**
+     * Table of the ports responses must be routed to, indexed by the
+     * request the response belongs to. Every routed packet is inserted
+     * in it and erased from it, so it is an open-addressed table with
+     * linear probing that doesn't allocate once it has grown to the
+     * number of outstanding packets.
+     */
+    class RouteTable
+    {
+      private:
+        static const size_t MinSlots = 64;
+
+        std::vector<const Request *> keys;
+        std::vector<PortID> ports;
+        size_t mask = 0;
+        unsigned shift = 0;
+        size_t count = 0;
+
+        size_t
+        home(const Request *req) const
+        {
+            return (reinterpret_cast<uintptr_t>(req) *
+                    0x9E3779B97F4A7C15ULL) >> shift;
+        }
+
+        size_t next(size_t slot) const { return (slot + 1) & mask; }
+
+        size_t
+        findSlot(const Request *req) const
+        {
+            size_t slot = home(req);
+            while (keys[slot] && keys[slot] != req)
+                slot = next(slot);
+            return slot;
+        }
+
+        void
+        rehash(size_t num_slots)
+        {
+            std::vector<const Request *> old_keys(num_slots, nullptr);
+            std::vector<PortID> old_ports(num_slots, InvalidPortID);
+            old_keys.swap(keys);
+            old_ports.swap(ports);
+            mask = num_slots - 1;
+            shift = 64 - floorLog2(num_slots);
+
+            for (size_t i = 0; i < old_keys.size(); i++) {
+                if (old_keys[i]) {
+                    const size_t slot = findSlot(old_keys[i]);
+                    keys[slot] = old_keys[i];
+                    ports[slot] = old_ports[i];
+                }
+            }
+        }
+
+      public:
+        RouteTable() { rehash(MinSlots); }
+
+        /** Number of requests with a route. */
+        size_t size() const { return count; }
+
+        /**
+         * Get the route of a request.
+         *
+         * @return The port to route the response to, or InvalidPortID if
+         *         the request has no route.
+         */
+        PortID
+        find(const RequestPtr &req) const
+        {
+            return ports[findSlot(req.get())];
+        }
+
+        /** Add the route of a request, which must not have one. */
+        void
+        insert(const RequestPtr &req, PortID port)
+        {
+            assert(port != InvalidPortID);
+            if (2 * (count + 1) > keys.size())
+                rehash(2 * keys.size());
+
+            const size_t slot = findSlot(req.get());
+            assert(!keys[slot]);
+            keys[slot] = req.get();
+            ports[slot] = port;
+            count++;
+        }
+
+        /** Remove the route of a request, which must have one. */
+        void
+        erase(const RequestPtr &req)
+        {
+            size_t hole = findSlot(req.get());
+            assert(keys[hole]);
+            // Shift back the following entries of the probe sequence
+            // that may fill the hole, so that no tombstones are needed
+            for (size_t i = next(hole); keys[i]; i = next(i)) {
+                if (((i - home(keys[i])) & mask) >= ((i - hole) & mask)) {
+                    keys[hole] = keys[i];
+                    ports[hole] = ports[i];
+                    hole = i;
+                }
+            }
+            keys[hole] = nullptr;
+            ports[hole] = InvalidPortID;
+            count--;
+        }
+    };
+
     /**
      * Remember where request packets came from so that we can route
      * responses to the appropriate port. This relies on the fact that
      * the underlying Request pointer inside the Packet stays
-     * constant.
+     * constant. The packets in flight keep their requests alive, so the
+     * table doesn't need to hold a reference to them.
      */
-    std::unordered_map<RequestPtr, PortID> routeTo;
+    RouteTable routeTo;
 
     /** all contigous ranges seen by this crossbar */
     AddrRangeList xbarRanges;
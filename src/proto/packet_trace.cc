@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "proto/packet_trace.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <cstring>
+
+#include "base/logging.hh"
+
+const char PacketTraceBlock::fileMagic[8] = {
+    'g', 'e', 'm', '5', 'p', 't', 'r', 'c'
+};
+
+namespace
+{
+
+void
+putVarint(std::vector<uint8_t> &buf, uint64_t value)
+{
+    while (value >= 0x80) {
+        buf.push_back(value | 0x80);
+        value >>= 7;
+    }
+    buf.push_back(value);
+}
+
+bool
+getVarint(const uint8_t *&p, const uint8_t *end, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && p != end; shift += 7) {
+        const uint8_t byte = *p++;
+        value |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+uint64_t
+zigzag(uint64_t value, uint64_t prev)
+{
+    const int64_t delta = value - prev;
+    return (uint64_t(delta) << 1) ^ uint64_t(delta >> 63);
+}
+
+uint64_t
+unzigzag(uint64_t value, uint64_t prev)
+{
+    return prev + ((value >> 1) ^ -(value & 1));
+}
+
+void
+put32(std::vector<uint8_t> &buf, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        buf.push_back(value >> (8 * i));
+}
+
+void
+put64(std::vector<uint8_t> &buf, uint64_t value)
+{
+    put32(buf, value);
+    put32(buf, value >> 32);
+}
+
+uint32_t
+get32(const uint8_t *p)
+{
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 |
+        uint32_t(p[3]) << 24;
+}
+
+uint64_t
+get64(const uint8_t *p)
+{
+    return get32(p) | uint64_t(get32(p + 4)) << 32;
+}
+
+} // anonymous namespace
+
+void
+PacketTraceBlock::encode(const std::vector<PacketTraceRecord> &records,
+                         std::vector<uint8_t> &payload)
+{
+    std::vector<uint8_t> columns[NumColumns];
+    Tick prev_tick = 0;
+    Addr prev_addr = 0;
+    uint64_t prev_id = 0;
+    Addr prev_pc = 0;
+
+    for (const auto &r : records) {
+        putVarint(columns[TickColumn], zigzag(r.tick, prev_tick));
+        putVarint(columns[CmdColumn], r.cmd);
+        putVarint(columns[AddrColumn], zigzag(r.addr, prev_addr));
+        putVarint(columns[SizeColumn], r.size);
+        putVarint(columns[FieldsColumn], r.fields);
+        if (r.fields & PacketTraceRecord::HasFlags)
+            putVarint(columns[FlagsColumn], r.flags);
+        if (r.fields & PacketTraceRecord::HasPktId) {
+            putVarint(columns[PktIdColumn], zigzag(r.pktId, prev_id));
+            prev_id = r.pktId;
+        }
+        if (r.fields & PacketTraceRecord::HasPC) {
+            putVarint(columns[PCColumn], zigzag(r.pc, prev_pc));
+            prev_pc = r.pc;
+        }
+        prev_tick = r.tick;
+        prev_addr = r.addr;
+    }
+
+    for (const auto &c : columns)
+        put32(payload, c.size());
+    for (const auto &c : columns)
+        payload.insert(payload.end(), c.begin(), c.end());
+}
+
+bool
+PacketTraceBlock::decode(const uint8_t *payload, size_t size,
+                         uint32_t num_records,
+                         std::vector<PacketTraceRecord> &records)
+{
+    if (size < NumColumns * 4)
+        return false;
+
+    const uint8_t *cur[NumColumns];
+    const uint8_t *end[NumColumns];
+    size_t offset = NumColumns * 4;
+    for (int c = 0; c < NumColumns; ++c) {
+        const uint32_t column_size = get32(payload + 4 * c);
+        if (column_size > size - offset)
+            return false;
+        cur[c] = payload + offset;
+        end[c] = payload + offset + column_size;
+        offset += column_size;
+    }
+
+    records.resize(num_records);
+    Tick prev_tick = 0;
+    Addr prev_addr = 0;
+    uint64_t prev_id = 0;
+    Addr prev_pc = 0;
+    uint64_t v;
+
+    auto next = [&](int c) { return getVarint(cur[c], end[c], v); };
+
+    for (auto &r : records) {
+        if (!next(TickColumn))
+            return false;
+        r.tick = prev_tick = unzigzag(v, prev_tick);
+        if (!next(CmdColumn))
+            return false;
+        r.cmd = v;
+        if (!next(AddrColumn))
+            return false;
+        r.addr = prev_addr = unzigzag(v, prev_addr);
+        if (!next(SizeColumn))
+            return false;
+        r.size = v;
+        if (!next(FieldsColumn))
+            return false;
+        r.fields = v;
+
+        r.flags = 0;
+        if (r.fields & PacketTraceRecord::HasFlags) {
+            if (!next(FlagsColumn))
+                return false;
+            r.flags = v;
+        }
+        r.pktId = 0;
+        if (r.fields & PacketTraceRecord::HasPktId) {
+            if (!next(PktIdColumn))
+                return false;
+            r.pktId = prev_id = unzigzag(v, prev_id);
+        }
+        r.pc = 0;
+        if (r.fields & PacketTraceRecord::HasPC) {
+            if (!next(PCColumn))
+                return false;
+            r.pc = prev_pc = unzigzag(v, prev_pc);
+        }
+    }
+
+    return true;
+}
+
+PacketTraceWriter::PacketTraceWriter(const std::string &_filename,
+                                     const PacketTraceHeader &header,
+                                     bool _compress, size_t block_records)
+    : stream(_filename, std::ios::out | std::ios::binary | std::ios::trunc),
+      filename(_filename), compress(_compress), blockRecords(block_records)
+{
+    if (!stream.good())
+        panic("Could not open %s for writing\n", filename);
+    panic_if(blockRecords == 0, "Packet trace blocks can't be empty\n");
+
+    std::vector<uint8_t> buf(PacketTraceBlock::fileMagic,
+                             PacketTraceBlock::fileMagic + 8);
+    put32(buf, PacketTraceBlock::version);
+    put32(buf, compress ? 1 : 0);
+    put64(buf, header.tickFreq);
+    put32(buf, header.objId.size());
+    buf.insert(buf.end(), header.objId.begin(), header.objId.end());
+    put32(buf, header.idStrings.size());
+    for (const auto &id : header.idStrings) {
+        put32(buf, id.first);
+        put32(buf, id.second.size());
+        buf.insert(buf.end(), id.second.begin(), id.second.end());
+    }
+    stream.write((const char *)buf.data(), buf.size());
+
+    pending.reserve(blockRecords);
+}
+
+PacketTraceWriter::~PacketTraceWriter()
+{
+    close();
+}
+
+void
+PacketTraceWriter::flushBlock()
+{
+    if (pending.empty())
+        return;
+
+    payload.clear();
+    PacketTraceBlock::encode(pending, payload);
+
+    const std::vector<uint8_t> *stored = &payload;
+    if (compress) {
+        uLongf compressed_size = compressBound(payload.size());
+        compressed.resize(compressed_size);
+        if (compress2(compressed.data(), &compressed_size, payload.data(),
+                      payload.size(), Z_DEFAULT_COMPRESSION) != Z_OK) {
+            panic("Failed to compress a block of %s\n", filename);
+        }
+        compressed.resize(compressed_size);
+        stored = &compressed;
+    }
+
+    std::vector<uint8_t> header;
+    put32(header, PacketTraceBlock::blockMagic);
+    put32(header, pending.size());
+    put32(header, stored->size());
+    put32(header, payload.size());
+    stream.write((const char *)header.data(), header.size());
+    stream.write((const char *)stored->data(), stored->size());
+
+    pending.clear();
+}
+
+void
+PacketTraceWriter::close()
+{
+    if (!stream.is_open())
+        return;
+
+    flushBlock();
+    stream.close();
+    if (stream.fail())
+        panic("Failed to write packet trace %s\n", filename);
+}
+
+PacketTraceReader::PacketTraceReader(const std::string &_filename)
+    : filename(_filename), data(nullptr), size(0), compressed(false),
+      firstBlock(0), offset(0)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        panic("Could not open %s for reading\n", filename);
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat))
+        panic("Could not stat %s\n", filename);
+    size = file_stat.st_size;
+
+    if (size) {
+        void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED)
+            panic("Could not map %s\n", filename);
+        data = static_cast<const uint8_t *>(addr);
+    }
+    ::close(fd);
+
+    // Parse the header, any inconsistency means this isn't a trace or
+    // it was truncated
+    size_t pos = 0;
+    auto need = [&](size_t bytes) {
+        if (size - pos < bytes)
+            fatal("%s is not a valid packet trace\n", filename);
+    };
+
+    need(24);
+    if (std::memcmp(data, PacketTraceBlock::fileMagic, 8))
+        fatal("%s is not a packet trace\n", filename);
+    const uint32_t version = get32(data + 8);
+    fatal_if(version != PacketTraceBlock::version,
+             "Packet trace %s has unsupported version %d\n", filename,
+             version);
+    compressed = get32(data + 12) & 1;
+    _header.tickFreq = get64(data + 16);
+    pos = 24;
+
+    need(4);
+    const uint32_t obj_id_size = get32(data + pos);
+    pos += 4;
+    need(obj_id_size);
+    _header.objId.assign((const char *)data + pos, obj_id_size);
+    pos += obj_id_size;
+
+    need(4);
+    const uint32_t num_id_strings = get32(data + pos);
+    pos += 4;
+    for (uint32_t i = 0; i < num_id_strings; ++i) {
+        need(8);
+        const uint32_t key = get32(data + pos);
+        const uint32_t length = get32(data + pos + 4);
+        pos += 8;
+        need(length);
+        _header.idStrings.emplace_back(key,
+            std::string((const char *)data + pos, length));
+        pos += length;
+    }
+
+    firstBlock = offset = pos;
+}
+
+PacketTraceReader::~PacketTraceReader()
+{
+    if (data)
+        munmap(const_cast<uint8_t *>(data), size);
+}
+
+bool
+PacketTraceReader::isPacketTrace(const std::string &filename)
+{
+    std::ifstream is(filename, std::ios::in | std::ios::binary);
+    char magic[8];
+    return is.read(magic, sizeof(magic)) &&
+        std::memcmp(magic, PacketTraceBlock::fileMagic, sizeof(magic)) == 0;
+}
+
+bool
+PacketTraceReader::readBatch(std::vector<PacketTraceRecord> &batch)
+{
+    if (offset == size) {
+        batch.clear();
+        return false;
+    }
+
+    fatal_if(size - offset < PacketTraceBlock::blockHeaderSize ||
+             get32(data + offset) != PacketTraceBlock::blockMagic,
+             "Corrupt block at offset %d of packet trace %s\n", offset,
+             filename);
+
+    const uint32_t num_records = get32(data + offset + 4);
+    const uint32_t stored_size = get32(data + offset + 8);
+    const uint32_t raw_size = get32(data + offset + 12);
+    const uint8_t *stored = data + offset + PacketTraceBlock::blockHeaderSize;
+    fatal_if(size - offset - PacketTraceBlock::blockHeaderSize < stored_size,
+             "Truncated block at offset %d of packet trace %s\n", offset,
+             filename);
+
+    const uint8_t *payload = stored;
+    if (compressed) {
+        buffer.resize(raw_size);
+        uLongf decompressed_size = raw_size;
+        fatal_if(uncompress(buffer.data(), &decompressed_size, stored,
+                            stored_size) != Z_OK ||
+                 decompressed_size != raw_size,
+                 "Failed to decompress block at offset %d of packet "
+                 "trace %s\n", offset, filename);
+        payload = buffer.data();
+    } else {
+        fatal_if(raw_size != stored_size,
+                 "Corrupt block at offset %d of packet trace %s\n", offset,
+                 filename);
+    }
+
+    fatal_if(!PacketTraceBlock::decode(payload, raw_size, num_records, batch),
+             "Corrupt block at offset %d of packet trace %s\n", offset,
+             filename);
+
+    offset += PacketTraceBlock::blockHeaderSize + stored_size;
+    return true;
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a block based, columnar packet trace format.
+ *
+ * The format stores the same information as the packet.proto traces,
+ * but is designed to be replayed quickly: the records are grouped in
+ * blocks, each block stores every field of its records as a separate
+ * column of variable length integers, delta encoded where the values
+ * are correlated, and is compressed on its own. A reader maps the file
+ * and decodes a whole block at a time.
+ *
+ * All integers are little endian. The file starts with a header:
+ *
+ *   char[8]  "gem5ptrc"
+ *   uint32   version
+ *   uint32   flags, bit 0 is set if the blocks are compressed
+ *   uint64   tick frequency
+ *   uint32   object id length, followed by the object id
+ *   uint32   number of id strings, each one a uint32 key, followed by
+ *            a uint32 length and the string
+ *
+ * followed by the blocks:
+ *
+ *   uint32   "pblk"
+ *   uint32   number of records
+ *   uint32   size of the block payload in the file
+ *   uint32   size of the payload when decompressed
+ *   payload  the size of every column, as uint32, followed by the
+ *            columns in the order of PacketTraceBlock::Column
+ */
+
+#ifndef __PROTO_PACKET_TRACE_HH__
+#define __PROTO_PACKET_TRACE_HH__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+
+/**
+ * A packet of a trace. The flags, packet id and PC are optional, which
+ * is recorded in the fields mask.
+ */
+struct PacketTraceRecord
+{
+    enum Field : uint8_t
+    {
+        HasFlags = 0x1,
+        HasPktId = 0x2,
+        HasPC = 0x4,
+    };
+
+    Tick tick = 0;
+    uint32_t cmd = 0;
+    Addr addr = 0;
+    uint32_t size = 0;
+    uint32_t flags = 0;
+    uint64_t pktId = 0;
+    Addr pc = 0;
+
+    /** The optional fields that are set */
+    uint8_t fields = 0;
+
+    bool
+    operator==(const PacketTraceRecord &r) const
+    {
+        return tick == r.tick && cmd == r.cmd && addr == r.addr &&
+            size == r.size && flags == r.flags && pktId == r.pktId &&
+            pc == r.pc && fields == r.fields;
+    }
+};
+
+/** The header of a trace */
+struct PacketTraceHeader
+{
+    std::string objId;
+    uint64_t tickFreq = 0;
+
+    /** Names of the requestors */
+    std::vector<std::pair<uint32_t, std::string>> idStrings;
+};
+
+/**
+ * Encoding and decoding of the blocks, shared by the writer and the
+ * reader.
+ */
+class PacketTraceBlock
+{
+  public:
+    static const char fileMagic[8];
+    static const uint32_t version = 1;
+    static const uint32_t blockMagic = 0x6b6c6270; // "pblk"
+
+    /** Bytes of the header of a block */
+    static const size_t blockHeaderSize = 16;
+
+    enum Column
+    {
+        TickColumn,  // zigzag encoded delta to the previous tick
+        CmdColumn,
+        AddrColumn,  // zigzag encoded delta to the previous address
+        SizeColumn,
+        FieldsColumn,
+        FlagsColumn, // only for the records with flags
+        PktIdColumn, // zigzag encoded delta, only for records with an id
+        PCColumn,    // zigzag encoded delta, only for records with a PC
+        NumColumns
+    };
+
+    /**
+     * Encode records into a block payload.
+     *
+     * @param records The records of the block
+     * @param payload Output buffer, the payload is appended to it
+     */
+    static void encode(const std::vector<PacketTraceRecord> &records,
+                       std::vector<uint8_t> &payload);
+
+    /**
+     * Decode a block payload.
+     *
+     * @param payload The decompressed payload
+     * @param size Size of the payload
+     * @param num_records Number of records in the block
+     * @param records Output, resized to the number of records
+     * @return false if the payload is malformed
+     */
+    static bool decode(const uint8_t *payload, size_t size,
+                       uint32_t num_records,
+                       std::vector<PacketTraceRecord> &records);
+};
+
+/**
+ * Write a packet trace. Records are buffered until a block is full,
+ * the last partial block is written when the writer is closed.
+ */
+class PacketTraceWriter
+{
+  public:
+    /** Default number of records per block */
+    static const size_t defaultBlockRecords = 4096;
+
+    /**
+     * Create a trace, truncating any existing file.
+     *
+     * @param filename Path of the trace
+     * @param header Header of the trace
+     * @param compress Whether to compress the blocks
+     * @param block_records Number of records per block
+     */
+    PacketTraceWriter(const std::string &filename,
+                      const PacketTraceHeader &header, bool compress=true,
+                      size_t block_records=defaultBlockRecords);
+
+    /** Close the trace if that wasn't done yet */
+    ~PacketTraceWriter();
+
+    /** Add a record to the trace */
+    void
+    write(const PacketTraceRecord &record)
+    {
+        pending.push_back(record);
+        if (pending.size() == blockRecords)
+            flushBlock();
+    }
+
+    /** Write the last block and close the file */
+    void close();
+
+  private:
+    std::ofstream stream;
+    const std::string filename;
+    const bool compress;
+    const size_t blockRecords;
+
+    std::vector<PacketTraceRecord> pending;
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> compressed;
+
+    void flushBlock();
+
+    PacketTraceWriter(const PacketTraceWriter &) = delete;
+    PacketTraceWriter &operator=(const PacketTraceWriter &) = delete;
+};
+
+/**
+ * Read a packet trace from a memory mapped file, one block at a time.
+ */
+class PacketTraceReader
+{
+  public:
+    /**
+     * Map a trace and read its header.
+     *
+     * @param filename Path of the trace
+     */
+    PacketTraceReader(const std::string &filename);
+
+    ~PacketTraceReader();
+
+    /**
+     * Check if a file is a packet trace in this format.
+     *
+     * @param filename Path of the file
+     * @return whether the file starts with the magic of the format
+     */
+    static bool isPacketTrace(const std::string &filename);
+
+    const PacketTraceHeader &header() const { return _header; }
+
+    /**
+     * Read the next block of the trace.
+     *
+     * @param batch Output, holds the records of the block
+     * @return false when the end of the trace has been reached
+     */
+    bool readBatch(std::vector<PacketTraceRecord> &batch);
+
+    /** Go back to the first block */
+    void reset() { offset = firstBlock; }
+
+  private:
+    const std::string filename;
+    const uint8_t *data;
+    size_t size;
+    bool compressed;
+
+    PacketTraceHeader _header;
+
+    /** Offset of the first block, and of the next one to read */
+    size_t firstBlock;
+    size_t offset;
+
+    /** Decompression buffer */
+    std::vector<uint8_t> buffer;
+
+    PacketTraceReader(const PacketTraceReader &) = delete;
+    PacketTraceReader &operator=(const PacketTraceReader &) = delete;
+};
+
+#endif //__PROTO_PACKET_TRACE_HH__
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "proto/packet_trace.hh"
+
+namespace
+{
+
+std::string
+tracePath(const std::string &name)
+{
+    return testing::TempDir() + "/packet_trace_test_" + name + ".ptrc";
+}
+
+PacketTraceHeader
+makeHeader()
+{
+    PacketTraceHeader header;
+    header.objId = "system.monitor";
+    header.tickFreq = 1000000000000ULL;
+    header.idStrings = { { 0, "writebacks" }, { 1, "cpu.inst" } };
+    return header;
+}
+
+std::vector<PacketTraceRecord>
+makeRecords(size_t count)
+{
+    std::vector<PacketTraceRecord> records(count);
+    for (size_t i = 0; i < count; ++i) {
+        PacketTraceRecord &r = records[i];
+        r.tick = 1000 * i + (i % 7);
+        r.cmd = i % 3 ? 1 : 4;
+        // addresses going up and down to exercise negative deltas
+        r.addr = (i % 2 ? 0x80000000 : 0x1000) + 64 * i;
+        r.size = 64;
+        if (i % 2) {
+            r.flags = i;
+            r.fields |= PacketTraceRecord::HasFlags;
+        }
+        if (i % 3) {
+            r.pktId = 1000 - i;
+            r.fields |= PacketTraceRecord::HasPktId;
+        }
+        if (i % 5 == 0) {
+            r.pc = 0xffffffff80000000ULL + 4 * i;
+            r.fields |= PacketTraceRecord::HasPC;
+        }
+    }
+    return records;
+}
+
+std::vector<PacketTraceRecord>
+readAll(PacketTraceReader &reader, size_t *num_batches=nullptr)
+{
+    std::vector<PacketTraceRecord> all, batch;
+    size_t batches = 0;
+    while (reader.readBatch(batch)) {
+        all.insert(all.end(), batch.begin(), batch.end());
+        ++batches;
+    }
+    if (num_batches)
+        *num_batches = batches;
+    return all;
+}
+
+} // anonymous namespace
+
+/** Records and the header survive a round trip, compressed or not */
+TEST(PacketTraceTest, RoundTrip)
+{
+    const auto records = makeRecords(1000);
+    for (bool compress : { true, false }) {
+        const std::string path = tracePath("round_trip");
+        {
+            PacketTraceWriter writer(path, makeHeader(), compress, 128);
+            for (const auto &r : records)
+                writer.write(r);
+        }
+
+        ASSERT_TRUE(PacketTraceReader::isPacketTrace(path));
+        PacketTraceReader reader(path);
+        EXPECT_EQ(reader.header().objId, "system.monitor");
+        EXPECT_EQ(reader.header().tickFreq, 1000000000000ULL);
+        EXPECT_EQ(reader.header().idStrings, makeHeader().idStrings);
+
+        size_t batches;
+        EXPECT_EQ(readAll(reader, &batches), records);
+        // 7 full blocks and a partial one
+        EXPECT_EQ(batches, 8);
+        std::remove(path.c_str());
+    }
+}
+
+/** Resetting the reader replays the trace from the start */
+TEST(PacketTraceTest, Reset)
+{
+    const std::string path = tracePath("reset");
+    const auto records = makeRecords(300);
+    {
+        PacketTraceWriter writer(path, makeHeader(), true, 100);
+        for (const auto &r : records)
+            writer.write(r);
+    }
+
+    PacketTraceReader reader(path);
+    std::vector<PacketTraceRecord> batch;
+    ASSERT_TRUE(reader.readBatch(batch));
+    ASSERT_EQ(batch.size(), 100);
+    reader.reset();
+    EXPECT_EQ(readAll(reader), records);
+    std::remove(path.c_str());
+}
+
+/** A trace without records only has a header */
+TEST(PacketTraceTest, Empty)
+{
+    const std::string path = tracePath("empty");
+    {
+        PacketTraceWriter writer(path, PacketTraceHeader(), true);
+        writer.close();
+    }
+
+    PacketTraceReader reader(path);
+    EXPECT_TRUE(reader.header().objId.empty());
+    std::vector<PacketTraceRecord> batch;
+    EXPECT_FALSE(reader.readBatch(batch));
+    EXPECT_TRUE(batch.empty());
+    std::remove(path.c_str());
+}
+
+/** Other files aren't mistaken for packet traces */
+TEST(PacketTraceTest, NotATrace)
+{
+    const std::string path = tracePath("not_a_trace");
+    {
+        std::ofstream os(path);
+        os << "gem5";
+    }
+    EXPECT_FALSE(PacketTraceReader::isPacketTrace(path));
+    EXPECT_FALSE(PacketTraceReader::isPacketTrace(tracePath("missing")));
+    std::remove(path.c_str());
+}
+
+/** Malformed block payloads are rejected rather than over-read */
+TEST(PacketTraceTest, DecodeTruncated)
+{
+    std::vector<uint8_t> payload;
+    PacketTraceBlock::encode(makeRecords(10), payload);
+
+    std::vector<PacketTraceRecord> records;
+    ASSERT_TRUE(PacketTraceBlock::decode(payload.data(), payload.size(), 10,
+                                         records));
+    EXPECT_FALSE(PacketTraceBlock::decode(payload.data(), payload.size(),
+                                          11, records));
+    EXPECT_FALSE(PacketTraceBlock::decode(payload.data(),
+                                          payload.size() - 1, 10, records));
+}
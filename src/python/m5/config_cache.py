@@ -0,0 +1,210 @@
+# Copyright (c) 2021 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Cached instantiation of configurations.
+
+Elaborating a large configuration in Python (building the SimObject
+tree, resolving proxies and converting every parameter) can take
+longer than the simulation it sets up. A ConfigCache stores the
+resolved configuration of the first run as an ini file, keyed by a
+hash of everything that can change it. Later runs with the same key
+skip the Python configuration entirely and build the C++ objects
+straight from the ini file with a CxxConfigManager.
+
+A config script opts in by only building its configuration on a
+cache miss:
+
+    cache = ConfigCache(args.config_cache)
+    if not cache.hit():
+        system = build_system(args)
+        root = Root(full_system=True, system=system)
+    cache.instantiate(args.checkpoint)
+    exit_event = m5.simulate()
+
+The default key covers the gem5 binary, the command line and the
+contents of every Python file loaded when the cache is created, so
+the cache has to be created after the script has imported the modules
+its configuration comes from.
+
+On a hit there are no Python SimObjects. Root.getInstance() returns a
+stand-in that gives access to the C++ objects, which is enough for
+m5.simulate(), m5.fork(), checkpointing and the statistics, but not
+for code that uses the Python objects after instantiation (e.g.,
+m5.switchCpus()). Caching requires gem5 to be built with
+--with-cxx-config; without it every run is a miss.
+"""
+
+import hashlib
+import os
+import shutil
+import sys
+import tempfile
+
+import _m5
+
+import m5
+from m5 import options, stats, ticks
+from m5.objects import Root
+from m5.util import inform, warn
+
+def available():
+    """True if this gem5 binary can instantiate cached configurations."""
+    return hasattr(_m5, "cxx_config")
+
+def defaultKey():
+    """Hash of the gem5 binary, the command line and the Python files
+    loaded so far."""
+    h = hashlib.sha256()
+    h.update(_m5.core.gem5Version.encode())
+    try:
+        st = os.stat("/proc/self/exe")
+        h.update(("%d %d" % (st.st_size, st.st_mtime_ns)).encode())
+    except OSError:
+        pass
+    for arg in sys.argv:
+        h.update(arg.encode() + b"\0")
+
+    files = set()
+    for module in list(sys.modules.values()):
+        path = getattr(module, "__file__", None)
+        if path and os.path.isfile(path):
+            files.add(os.path.abspath(path))
+    for path in sorted(files):
+        h.update(path.encode() + b"\0")
+        with open(path, "rb") as f:
+            h.update(hashlib.sha256(f.read()).digest())
+    return h.hexdigest()
+
+class _CachedObject(object):
+    """Stand-in for a Python SimObject wrapping a C++ object built from
+    a cached configuration."""
+
+    def __init__(self, name, cc_object):
+        self._name = name
+        self._ccObject = cc_object
+
+    def getCCObject(self):
+        return self._ccObject
+
+    def path(self):
+        return self._name
+
+    def path_list(self):
+        return self._name.split(".")
+
+    def __str__(self):
+        return self._name
+
+    def __getattr__(self, attr):
+        return getattr(self._ccObject, attr)
+
+class _CachedRoot(_CachedObject):
+    def __init__(self, config):
+        objects = config.objects()
+        super().__init__("root", objects[0][1])
+        self._config = config
+        self._descendants = [ self ] + \
+            [ _CachedObject(name, obj) for name, obj in objects[1:] ]
+
+    def path_list(self):
+        return []
+
+    def descendants(self):
+        return iter(self._descendants)
+
+class ConfigCache(object):
+    """Cache of resolved configurations.
+
+    Arguments:
+      directory -- Directory holding the cached configurations, shared
+                   between runs. Created if needed.
+      key -- Key of this configuration, defaultKey() if None.
+    """
+
+    def __init__(self, directory, key=None):
+        self.directory = directory
+        self.key = key if key is not None else defaultKey()
+        self.path = os.path.join(directory, self.key + ".ini")
+
+    def hit(self):
+        """True if the configuration is cached and can be restored."""
+        return available() and os.path.isfile(self.path)
+
+    def instantiate(self, ckpt_dir=None):
+        """Instantiate the simulator, from the cache if possible.
+
+        On a miss this is m5.instantiate() followed by storing the
+        configuration, on a hit the objects are built from the cache.
+        """
+        if self.hit():
+            inform("Instantiating cached configuration %s", self.path)
+            _instantiateIni(self.path, ckpt_dir)
+            return
+
+        m5.instantiate(ckpt_dir)
+        if available():
+            self._store()
+        else:
+            warn("Not caching the configuration, gem5 was built without "
+                 "--with-cxx-config")
+
+    def _store(self):
+        os.makedirs(self.directory, exist_ok=True)
+        # Write to a temporary file first so that concurrent runs never
+        # see a partial configuration
+        fd, tmp = tempfile.mkstemp(dir=self.directory, suffix=".tmp")
+        with os.fdopen(fd, "w") as ini_file:
+            root = Root.getInstance()
+            for obj in sorted(root.descendants(), key=lambda o: o.path()):
+                obj.print_ini(ini_file)
+        os.replace(tmp, self.path)
+
+def _instantiateIni(path, ckpt_dir):
+    """Counterpart of m5.instantiate() for a cached configuration."""
+    from m5 import simulate
+
+    ticks.fixGlobalFrequency()
+
+    if options.dump_config:
+        shutil.copyfile(path,
+                        os.path.join(options.outdir, options.dump_config))
+
+    stats.initSimStats()
+
+    config = _m5.cxx_config.IniConfig(path)
+    config.instantiate()
+
+    Root._the_instance = _CachedRoot(config)
+
+    stats.enable()
+
+    if ckpt_dir:
+        simulate._drain_manager.preCheckpointRestore()
+        config.loadState(ckpt_dir)
+    else:
+        config.initState()
+
+    simulate.updateStatEvents()
@@ -71,6 +71,7 @@ def parse_options():
     group = options.set_group
 
     listener_modes = ( "on", "off", "auto" )
+    debug_formats = ( "text", "binary" )
 
     # Help options
     option('-B', "--build-info", action="store_true", default=False,
@@ -144,6 +145,10 @@ def parse_options():
         help="End debug output at TICK")
     option("--debug-file", metavar="FILE", default="cout",
         help="Sets the output file for debug [Default: %default]")
+    option("--debug-format", metavar="{text,binary}",
+        choices=debug_formats, default="text",
+        help="Write debug output as text or as a binary trace that "
+        "util/decode_debug_trace.py renders offline [Default: %default]")
     option("--debug-ignore", metavar="EXPR", action='append', split=':',
         help="Ignore EXPR sim objects")
     option("--remote-gdb-port", type='int', default=7000,
@@ -417,7 +422,10 @@ def main(*args):
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_format == "binary":
+        trace.outputBinary(options.debug_file)
+    else:
+        trace.output(options.debug_file)
 
     for ignore in options.debug_ignore:
         _check_tracing()
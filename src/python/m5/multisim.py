@@ -0,0 +1,170 @@
+# Copyright (c) 2021 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Several independent simulations from one gem5 process.
+
+Design sweeps that launch one gem5 process per configuration pay for
+starting gem5, its Python interpreter and importing every SimObject
+class once per configuration. A MultiSim does that once: the parent
+process imports what the configurations need and then forks one child
+per configuration. Every child builds, instantiates and simulates its
+own Root in its own output directory, and the children share whatever
+the parent loaded copy-on-write.
+
+Each configuration is a function called with its name in the child. It
+builds the SimObject tree, instantiates it, simulates and returns the
+exit status of the child (None means 0):
+
+    def run(name):
+        system = build_system(cpu_type=name)
+        root = Root(full_system=False, system=system)
+        m5.instantiate()
+        exit_event = m5.simulate()
+        return exit_event.getCode()
+
+    multisim = MultiSim(dict((cpu, run) for cpu in ("o3", "minor")))
+    multisim.run()
+    sys.exit(0 if multisim.succeeded() else 1)
+
+The simulations run in processes rather than host threads: simulated
+time, the event queues, the statistics and the Root object are global
+to a gem5 process, so two Roots can not coexist in one. Consequently
+the parent must not create a Root itself; configurations that should
+start from common simulated state are better served by ForkedSweep
+in m5.sweep.
+"""
+
+import os
+import sys
+import traceback
+
+import _m5
+
+import m5
+from m5 import options
+from m5.util import fatal, inform
+
+class MultiSim(object):
+    """Fork the simulator once per configuration.
+
+    Arguments:
+      configs -- Dict, or list of (name, function) pairs, mapping
+                 configuration names to functions that build and run
+                 the configuration in the child.
+      simout -- Output directory of each child. Formatting keys are
+                "parent", the parent's output directory, and "name",
+                the name of the configuration.
+      max_parallel -- Number of children run at the same time, the
+                      number of host CPUs by default.
+    """
+
+    def __init__(self, configs, simout="%(parent)s/%(name)s",
+                 max_parallel=None):
+        if isinstance(configs, dict):
+            configs = sorted(configs.items())
+        self.configs = list(configs)
+        if not self.configs:
+            fatal("A multi-simulation needs at least one configuration")
+        names = [ name for name, _ in self.configs ]
+        if len(set(names)) != len(names):
+            fatal("Multi-simulation configuration names have to be unique")
+
+        self.simout = simout
+        self.maxParallel = max_parallel or os.cpu_count() or 1
+
+        # Exit status of each configuration, filled in by the parent
+        self.status = {}
+
+    def _reap(self, running):
+        pid, status = os.wait()
+        name = running.pop(pid)
+        if os.WIFSIGNALED(status):
+            self.status[name] = -os.WTERMSIG(status)
+        else:
+            self.status[name] = os.WEXITSTATUS(status)
+        inform("Simulation %s finished with status %d", name,
+               self.status[name])
+
+    def _child(self, name, config):
+        outdir = self.simout % {
+            "parent" : options.outdir,
+            "name" : name,
+        }
+        if not os.path.isdir(outdir):
+            os.makedirs(outdir)
+        options.outdir = outdir
+        _m5.core.setOutputDir(outdir)
+
+        # Mirror the redirection done by m5.main into the new directory
+        if options.redirect_stdout:
+            fd = os.open(os.path.join(outdir, options.stdout_file),
+                         os.O_WRONLY | os.O_CREAT | os.O_TRUNC)
+            os.dup2(fd, sys.stdout.fileno())
+            if not options.redirect_stderr:
+                os.dup2(fd, sys.stderr.fileno())
+        if options.redirect_stderr:
+            fd = os.open(os.path.join(outdir, options.stderr_file),
+                         os.O_WRONLY | os.O_CREAT | os.O_TRUNC)
+            os.dup2(fd, sys.stderr.fileno())
+
+        try:
+            code = config(name)
+        except SystemExit:
+            raise
+        except BaseException:
+            traceback.print_exc()
+            code = 1
+
+        # Never return into the parent's script
+        sys.exit(code or 0)
+
+    def run(self):
+        """Run every configuration and return once all have finished."""
+        if m5.objects.Root.getInstance() is not None:
+            fatal("A multi-simulation can not be started once a Root "
+                  "object exists")
+
+        running = {}
+        for name, config in self.configs:
+            while len(running) >= self.maxParallel:
+                self._reap(running)
+
+            sys.stdout.flush()
+            sys.stderr.flush()
+            pid = os.fork()
+            if pid == 0:
+                self._child(name, config)
+
+            inform("Started simulation %s (pid %d)", name, pid)
+            running[pid] = name
+
+        while running:
+            self._reap(running)
+
+    def succeeded(self):
+        """True if every configuration exited with status 0."""
+        return len(self.status) == len(self.configs) and \
+            all(s == 0 for s in self.status.values())
@@ -0,0 +1,228 @@
+# Copyright (c) 2021 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Periodic sampled simulation.
+
+The controller alternates between a fast CPU model and a detailed one
+in the style of SMARTS. Most instructions run on the fast CPUs, which
+keep caches and, when they share them with the detailed CPUs, branch
+predictors warm (functional warming). At regular intervals the
+detailed CPUs take over, first for a warm-up window that is not
+measured, which refills the pipeline and other short lived state, and
+then for a measurement window.
+
+The rate of progress over each measurement window, in ticks per
+instruction, is one sample. Sampling stops when the confidence
+interval of the mean is within the requested error, or when the
+workload or the simulation otherwise ends.
+
+Instruction counts are those of thread 0 of the first CPU in the
+lists, which have to be the same length and in matching order.
+"""
+
+import math
+
+import m5
+from m5 import stats
+from m5.util import fatal, inform
+
+def _normalQuantile(p):
+    """Inverse of the standard normal distribution function."""
+    lo, hi = -40.0, 40.0
+    for _ in range(200):
+        mid = (lo + hi) / 2
+        if 0.5 * (1 + math.erf(mid / math.sqrt(2))) < p:
+            lo = mid
+        else:
+            hi = mid
+    return (lo + hi) / 2
+
+class SampledSimulation(object):
+    """Run a system with sampling.
+
+    Arguments:
+      system -- The system containing the CPUs.
+      fast_cpus -- The CPUs used between samples. They have to be the
+                   active CPUs when run() is called.
+      detailed_cpus -- The switched out CPUs used for the samples.
+      interval -- Number of instructions from the start of one sample
+                  to the start of the next one.
+      warmup -- Number of instructions of detailed warm-up before
+                each measurement.
+      length -- Number of instructions measured per sample.
+      confidence -- Confidence level of the reported interval.
+      error -- Target half width of the confidence interval, relative
+               to the mean.
+      min_samples -- Number of samples always taken before looking at
+                     the confidence interval.
+      max_samples -- Stop after this many samples, None for no limit.
+      max_tick -- Absolute tick to stop the simulation at.
+      dump_stats -- Reset the statistics before and dump them after
+                    each measurement window.
+      warmers -- CacheWarmer objects asked to warm the caches and
+                 TLBs up once the detailed CPUs have taken over, when
+                 the fast CPUs don't use them (e.g., KVM CPUs).
+    """
+
+    def __init__(self, system, fast_cpus, detailed_cpus, interval,
+                 warmup, length, confidence=0.997, error=0.03,
+                 min_samples=30, max_samples=None, max_tick=m5.MaxTick,
+                 dump_stats=False, warmers=()):
+        if len(fast_cpus) != len(detailed_cpus) or not fast_cpus:
+            fatal("Sampling needs matching lists of fast and detailed CPUs")
+        if length <= 0:
+            fatal("The sample length has to be positive")
+        if warmup < 0 or interval < warmup + length:
+            fatal("The sampling interval (%d) is shorter than the warm-up "
+                  "and the measurement (%d + %d)", interval, warmup, length)
+        if not 0 < confidence < 1:
+            fatal("The confidence level has to be between 0 and 1")
+
+        self.system = system
+        self.toDetailed = list(zip(fast_cpus, detailed_cpus))
+        self.toFast = list(zip(detailed_cpus, fast_cpus))
+        self.interval = interval
+        self.warmup = warmup
+        self.length = length
+        self.z = _normalQuantile(0.5 + confidence / 2)
+        self.confidence = confidence
+        self.error = error
+        self.minSamples = max(min_samples, 2)
+        self.maxSamples = max_samples
+        self.maxTick = max_tick
+        self.dumpStats = dump_stats
+        self.warmers = list(warmers)
+
+        # Ticks per instruction of each measurement window
+        self.samples = []
+
+    def mean(self):
+        return sum(self.samples) / len(self.samples)
+
+    def halfWidth(self):
+        """Half width of the confidence interval of the mean."""
+        n = len(self.samples)
+        if n < 2:
+            return float('inf')
+        m = self.mean()
+        var = sum((s - m) ** 2 for s in self.samples) / (n - 1)
+        return self.z * math.sqrt(var / n)
+
+    def samplesNeeded(self):
+        """Estimate of the total number of samples needed to reach the
+        target error, from the variation seen so far."""
+        if len(self.samples) < 2 or self.mean() == 0:
+            return None
+        n = len(self.samples)
+        cov = self.halfWidth() * math.sqrt(n) / self.z / self.mean()
+        return int(math.ceil((self.z * cov / self.error) ** 2))
+
+    def converged(self):
+        if len(self.samples) < self.minSamples:
+            return False
+        return self.halfWidth() <= self.error * self.mean()
+
+    def _run(self, cpus, insts, cause):
+        """Run until the CPUs have executed a number of instructions.
+
+        @return None if they did, otherwise the event that stopped the
+                simulation first.
+        """
+        if insts <= 0:
+            return None
+        cpus[0].scheduleInstStop(0, insts, cause)
+        event = m5.simulate(self.maxTick - m5.curTick())
+        if event.getCause() == cause:
+            return None
+        return event
+
+    def _sample(self):
+        """Take one sample on the detailed CPUs, which are active.
+
+        @return The event that ended the simulation, if any.
+        """
+        detailed = [new for old, new in self.toDetailed]
+
+        event = self._run(detailed, self.warmup, "sample warm-up done")
+        if event is not None:
+            return event
+
+        if self.dumpStats:
+            stats.reset()
+        start = m5.curTick()
+        event = self._run(detailed, self.length, "sample done")
+        if event is not None:
+            return event
+        if self.dumpStats:
+            stats.dump()
+
+        self.samples.append(float(m5.curTick() - start) / self.length)
+        return None
+
+    def run(self):
+        """Run sampled simulation.
+
+        @return The event that ended the simulation, or None if it
+                stopped because enough samples were taken. The fast
+                CPUs are active again in the latter case.
+        """
+        fast = [old for old, new in self.toDetailed]
+        gap = self.interval - self.warmup - self.length
+        event = None
+
+        while self.maxSamples is None or \
+              len(self.samples) < self.maxSamples:
+            event = self._run(fast, gap, "sample start")
+            if event is not None:
+                break
+
+            m5.switchCpus(self.system, self.toDetailed, verbose=False)
+            for warmer in self.warmers:
+                warmer.warm()
+            event = self._sample()
+            if event is not None:
+                break
+            m5.switchCpus(self.system, self.toFast, verbose=False)
+
+            if self.converged():
+                break
+
+        self.report()
+        return event
+
+    def report(self):
+        n = len(self.samples)
+        if not n:
+            inform("Sampling ended before the first sample was taken")
+            return
+        m = self.mean()
+        print("Samples: %d" % n)
+        print("Mean ticks per instruction: %f +/- %f (%.1f%% confidence)" %
+              (m, self.halfWidth(), self.confidence * 100))
+        needed = self.samplesNeeded()
+        if needed is not None and needed > n:
+            print("Samples needed for a %.1f%% error: %d" %
+                  (self.error * 100, needed))
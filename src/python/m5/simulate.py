@@ -50,10 +50,12 @@ from . import stats
 from . import SimObject
 from . import ticks
 from . import objects
+from . import params
+from . import proxy
 from m5.util.dot_writer import do_dot, do_dvfs_dot
 from m5.util.dot_writer_ruby import do_ruby_dot
 
-from .util import fatal
+from .util import fatal, inform, warn
 from .util import attrdict
 
 # define a MaxTick parameter, unsigned 64 bit
@@ -87,6 +89,17 @@ def instantiate(ckpt_dir=None):
     # Unproxy in sorted order for determinism
     for obj in root.descendants(): obj.unproxyParams()
 
+    # Give KVM CPUs a thread each, or spread the cores over multiple
+    # event queues if requested. This needs the port connections and
+    # clock domains to be resolved.
+    if not partitionKvmCores(root) and \
+       root.eventq_partitioning.value != 'none':
+        partitionEventQueues(root,
+            ruby=(root.eventq_partitioning.value == 'cores_and_ruby'))
+
+    partitionComputeUnits(root)
+    partitionGarnetRegions(root)
+
     if options.dump_config:
         ini_file = open(os.path.join(options.outdir, options.dump_config), 'w')
         # Print ini sections in sorted order for easier diffing
@@ -151,6 +164,382 @@ def instantiate(ckpt_dir=None):
     # a checkpoint, If so, this call will shift them to be at a valid time.
     updateStatEvents()
 
+def _portPeers(obj):
+    """Return the SimObjects connected to the ports of obj."""
+    peers = []
+    for ref in obj._port_refs.values():
+        elements = getattr(ref, 'elements', [ ref ])
+        for el in elements:
+            if el.peer is not None and not proxy.isproxy(el.peer):
+                peers.append(el.peer.simobj)
+    return peers
+
+def _clockPeriod(obj):
+    """Return the clock period of a clocked object in ticks, or None."""
+    domain = obj._values.get('clk_domain')
+    divider = 1
+    while isinstance(domain, objects.DerivedClockDomain):
+        divider *= domain.clk_divider
+        domain = domain.clk_domain
+    if not isinstance(domain, objects.SrcClockDomain):
+        return None
+    return min(clk.getValue() for clk in domain.clock) * divider
+
+def _minLatency(obj):
+    """Estimate the smallest delay, in ticks, after which obj reacts to a
+    request it receives through a port. This is the shortest latency
+    parameter of the object, and at least one clock cycle."""
+    latencies = []
+    period = _clockPeriod(obj)
+    for name, desc in obj._params.items():
+        value = obj._values.get(name)
+        if value is None or proxy.isproxy(value):
+            continue
+        if desc.ptype is params.Cycles and period is not None:
+            latencies.append(max(value.value, 1) * period)
+        elif desc.ptype is params.Latency:
+            latencies.append(value.getValue())
+    if period is not None:
+        latencies.append(period)
+    latencies = [ l for l in latencies if l > 0 ]
+    return min(latencies) if latencies else None
+
+def _crossingLatencies(root):
+    """Return the smallest latency of the links crossing event queues,
+    by event queue of the object on either end."""
+    lookahead = {}
+    for obj in root.descendants():
+        for peer in _portPeers(obj):
+            index = int(obj.eventq_index)
+            if index == int(peer.eventq_index):
+                continue
+            lats = [ l for l in (_minLatency(obj), _minLatency(peer))
+                     if l is not None ]
+            if not lats:
+                fatal("Can't derive a simulation quantum for the link " \
+                      "between %s and %s, set root.sim_quantum.",
+                      obj.path(), peer.path())
+            link = min(lats)
+            lookahead[index] = min(lookahead.get(index, link), link)
+    return lookahead
+
+def _mergeLookahead(root, lookahead, num_queues, links):
+    """Lower the lookahead of the event queues in lookahead, and the
+    simulation quantum, to the latencies of the given links. Queues
+    without a lookahead get the new quantum."""
+    quantum = min(lookahead.values())
+    current = [ int(l) for l in root.eventq_lookahead ]
+    root.eventq_lookahead = [
+        min(lookahead.get(i, quantum),
+            current[i] if i < len(current) and current[i] else quantum)
+        for i in range(max(num_queues, len(current))) ]
+
+    if root.sim_quantum.getValue() == 0:
+        root.sim_quantum = quantum
+        inform("Using a simulation quantum of %d ticks.", quantum)
+    elif root.sim_quantum.getValue() > quantum:
+        warn("Simulation quantum (%d ticks) is larger than the smallest " \
+             "latency of the %s (%d ticks).",
+             root.sim_quantum.getValue(), links, quantum)
+
+# Default simulation quantum of KVM CPUs running on their own threads
+kvm_sim_quantum = 1e-3
+
+def partitionKvmCores(root):
+    """Run every KVM CPU on its own event queue, and so host thread.
+
+    All other objects, including the children of the KVM CPUs, stay on
+    event queue 0 with the KvmVM. The KVM CPUs lock and migrate to that
+    queue to access devices. The simulation quantum is kvm_sim_quantum,
+    unless root.sim_quantum is set. KVM CPUs only synchronize with the
+    devices at quantum boundaries, so the quantum is much larger than
+    the latencies partitionEventQueues() derives it from.
+
+    Nothing is done with fewer than two active KVM CPUs, or if any
+    object was moved off event queue 0 by the configuration.
+
+    @return True if the KVM CPUs were given event queues.
+
+    Has to be called after the parameters have been unproxied."""
+
+    kvm_cpu = getattr(objects, 'BaseKvmCPU', None)
+    if kvm_cpu is None:
+        return False
+
+    cpus = [ obj for obj in root.descendants()
+             if isinstance(obj, kvm_cpu) and not obj.switched_out ]
+    if len(cpus) < 2:
+        return False
+    if any(int(obj.eventq_index) != 0 for obj in root.descendants()):
+        return False
+
+    for index, cpu in enumerate(cpus):
+        cpu.eventq_index = index + 1
+
+    if root.sim_quantum.getValue() == 0:
+        root.sim_quantum = ticks.fromSeconds(kvm_sim_quantum)
+
+    inform("Running %d KVM CPUs on their own threads with a simulation "
+           "quantum of %d ticks.", len(cpus), root.sim_quantum.getValue())
+    return True
+
+def partitionEventQueues(root, ruby=False):
+    """Assign every core, and the components that only it talks to, to
+    its own event queue and derive a simulation quantum.
+
+    Each partition starts with a core and its children. Objects are
+    then added when at least one of their port peers is in the
+    partition and at most one is outside it, which pulls in private
+    caches and the crossbars that connect them. Everything else keeps
+    its event queue, so shared components stay on the same thread.
+    With ruby=True, the Ruby controllers whose sequencers only serve
+    cores of a partition are moved as well. Note that Ruby's message
+    buffers are currently not thread safe.
+
+    The quantum is the smallest latency of all links crossing a
+    partition boundary, unless root.sim_quantum is set explicitly. The
+    smallest latency of the links of each partition is used as the
+    lookahead of its event queue (see Root.adaptive_quantum).
+
+    Has to be called after the parameters have been unproxied."""
+
+    base_cpu = getattr(objects, 'BaseCPU', None)
+    if base_cpu is None:
+        return
+
+    partition = {}
+    cores = [ obj for obj in root.descendants() if isinstance(obj, base_cpu) ]
+
+    # CPUs that are switched in and out of the same core (same system
+    # and cpu_id) share a partition.
+    groups = {}
+    for core in cores:
+        cpu_id = int(core.cpu_id)
+        key = (core.system, cpu_id) if cpu_id >= 0 else core
+        groups.setdefault(key, len(groups) + 1)
+    if len(groups) < 2:
+        return
+
+    def assign(obj, index):
+        for child in obj.descendants():
+            partition.setdefault(child, index)
+
+    for core in cores:
+        cpu_id = int(core.cpu_id)
+        key = (core.system, cpu_id) if cpu_id >= 0 else core
+        assign(core, groups[key])
+
+    # Grow the partitions until they stop changing, objects without
+    # ports are covered by the partition of their parent.
+    candidates = [ obj for obj in root.descendants()
+                   if obj not in partition and obj._port_refs ]
+    changed = True
+    while changed:
+        changed = False
+        for obj in candidates:
+            if obj in partition:
+                continue
+            peers = [ p for p in _portPeers(obj) if p is not obj ]
+            inside = set(partition[p] for p in peers if p in partition)
+            outside = [ p for p in peers if p not in partition ]
+            if len(inside) == 1 and len(outside) <= 1:
+                assign(obj, inside.pop())
+                changed = True
+
+    if ruby and hasattr(objects, 'RubyController'):
+        for cntrl in root.descendants():
+            if not isinstance(cntrl, objects.RubyController) or \
+               cntrl in partition:
+                continue
+            for value in cntrl._values.values():
+                if not isinstance(value, objects.RubyPort):
+                    continue
+                ref = value._port_refs.get('in_ports')
+                users = [ el.peer.simobj for el in getattr(ref, 'elements', [])
+                          if el.peer is not None ]
+                served = set(partition.get(user) for user in users)
+                if len(served) == 1 and None not in served:
+                    index = served.pop()
+                    assign(cntrl, index)
+                    assign(value, index)
+
+    for obj, index in partition.items():
+        obj.eventq_index = index
+
+    lookahead = _crossingLatencies(root)
+
+    inform("Partitioned %d cores onto %d event queues.",
+           len(groups), len(groups) + 1)
+    if not lookahead:
+        return
+
+    quantum = min(lookahead.values())
+
+    root.eventq_lookahead = [ lookahead.get(i, quantum)
+                              for i in range(max(lookahead) + 1) ]
+
+    if root.sim_quantum.getValue() == 0:
+        root.sim_quantum = quantum
+        inform("Using a simulation quantum of %d ticks.", quantum)
+    elif root.sim_quantum.getValue() > quantum:
+        warn("Simulation quantum (%d ticks) is larger than the smallest " \
+             "cross-partition latency (%d ticks).",
+             root.sim_quantum.getValue(), quantum)
+
+def partitionComputeUnits(root):
+    """Spread the compute units of the shaders with cu_event_queues > 1
+    over event queues of their own.
+
+    The CUs are placed in bands of consecutive CUs, together with the
+    Ruby controllers (TCP, SQC, scalar cache) whose sequencers they are
+    connected to. CUs sharing a controller stay on the same queue. The
+    TLB hierarchy, the dispatcher and the rest of the shader stay on
+    the shader's queue, and the CUs migrate to it when they call them.
+    The Ruby message buffers to the network are the other boundary
+    between queues, their latency bounds the simulation quantum.
+
+    Has to be called after the parameters have been unproxied."""
+
+    shader_cls = getattr(objects, 'Shader', None)
+    if shader_cls is None:
+        return
+
+    shaders = [ obj for obj in root.descendants()
+                if isinstance(obj, shader_cls) and
+                int(obj.cu_event_queues) > 1 ]
+    if not shaders:
+        return
+
+    ruby_port = getattr(objects, 'RubyPort', None)
+    next_index = max(int(obj.eventq_index) for obj in root.descendants()) + 1
+
+    for shader in shaders:
+        if shader.dispatcher.kernel_sampling:
+            fatal("%s: Kernel sampling can't be used with CUs on multiple " \
+                  "event queues.", shader.path())
+
+        # Group the CUs that share a Ruby controller
+        cus = list(shader.CUs)
+        group = dict((cu, i) for i, cu in enumerate(cus))
+        cntrl_cus = {}
+        for cu in cus:
+            for peer in _portPeers(cu):
+                if ruby_port is None or not isinstance(peer, ruby_port):
+                    continue
+                cntrl = peer._parent
+                users = cntrl_cus.setdefault(cntrl, [])
+                for user in users:
+                    old = group[user]
+                    for other in cus:
+                        if group[other] == old:
+                            group[other] = group[cu]
+                users.append(cu)
+
+        units = {}
+        for cu in cus:
+            units.setdefault(group[cu], []).append(cu)
+        units = sorted(units.values(), key=lambda u: cus.index(u[0]))
+        queues = min(int(shader.cu_event_queues), len(units))
+
+        for i, unit in enumerate(units):
+            index = next_index + i * queues // len(units)
+            for cu in unit:
+                for obj in cu.descendants():
+                    obj.eventq_index = index
+        for cntrl, users in cntrl_cus.items():
+            for obj in cntrl.descendants():
+                obj.eventq_index = int(users[0].eventq_index)
+        next_index += queues
+
+        inform("Spread %d CUs of %s over %d event queues.", len(cus),
+               shader.path(), queues)
+
+    lookahead = _crossingLatencies(root)
+    if lookahead:
+        _mergeLookahead(root, lookahead, next_index,
+                        "links between event queues")
+
+def partitionGarnetRegions(root):
+    """Spread the routers of the Garnet networks with num_regions > 1
+    over event queues of their own, one per region.
+
+    Regions are made of consecutive router ids, which are bands of rows
+    in the mesh topologies. The network interfaces stay on the event
+    queue of the network, with the controllers they serve. Each flit
+    and credit link is moved to the queue of the object sending through
+    it, so the links between regions are the synchronization boundaries
+    between queues. Their latency is the lookahead of the queue sending
+    through them, and bounds the simulation quantum.
+
+    Has to be called after the parameters have been unproxied."""
+
+    garnet = getattr(objects, 'GarnetNetwork', None)
+    if garnet is None:
+        return
+
+    networks = [ obj for obj in root.descendants()
+                 if isinstance(obj, garnet) and int(obj.num_regions) > 1 ]
+    if not networks:
+        return
+
+    # Latencies of the links between regions, by sending queue
+    lookahead = {}
+    next_index = max(int(obj.eventq_index) for obj in root.descendants()) + 1
+
+    def place(link, src_index, dst_index, bridged):
+        link.eventq_index = src_index
+        if src_index == dst_index:
+            return
+        if bridged:
+            fatal("%s: Links with CDC or SerDes units can't cross Garnet "
+                  "regions.", link.path())
+        period = _clockPeriod(link)
+        if period is None:
+            fatal("Can't find the clock period of %s.", link.path())
+        latency = max(int(link.link_latency), 1) * period
+        lookahead[src_index] = min(lookahead.get(src_index, latency),
+                                   latency)
+
+    for network in networks:
+        routers = sorted(network.routers, key=lambda r: int(r.router_id))
+        regions = min(int(network.num_regions), len(routers))
+        for i, router in enumerate(routers):
+            router.eventq_index = next_index + i * regions // len(routers)
+        next_index += regions
+
+        ni_index = int(network.eventq_index)
+        for link in network.int_links:
+            src = int(link.src_node.eventq_index)
+            dst = int(link.dst_node.eventq_index)
+            bridged = link.src_cdc or link.dst_cdc or \
+                      link.src_serdes or link.dst_serdes
+            place(link.network_link, src, dst, bridged)
+            place(link.credit_link, dst, src, bridged)
+        for link in network.ext_links:
+            router = int(link.int_node.eventq_index)
+            bridged = link.ext_cdc or link.int_cdc or \
+                      link.ext_serdes or link.int_serdes
+            # The first links of a pair carry flits into the network,
+            # the second ones carry flits out of it.
+            place(link.network_links[0], ni_index, router, bridged)
+            place(link.credit_links[0], router, ni_index, bridged)
+            place(link.network_links[1], router, ni_index, bridged)
+            place(link.credit_links[1], ni_index, router, bridged)
+
+        # The bridges are set up for every link, and have to be on the
+        # queue of their link even when they aren't used.
+        for obj in network.descendants():
+            if isinstance(obj, objects.NetworkBridge):
+                obj.eventq_index = int(obj.link.eventq_index)
+
+        inform("Partitioned %s into %d regions.", network.path(), regions)
+
+    if not lookahead:
+        return
+
+    _mergeLookahead(root, lookahead, next_index,
+                    "links between Garnet regions")
+
 need_startup = True
 def simulate(*args, **kwargs):
     global need_startup
@@ -183,15 +572,26 @@ def simulate(*args, **kwargs):
 
     return sim_out
 
-def drain():
+def drain(objects=None):
     """Drain the simulator in preparation of a checkpoint or memory mode
     switch.
 
     This operation is a no-op if the simulator is already in the
     Drained state.
 
+    Arguments:
+      objects -- Only drain these SimObjects and leave the rest of the
+                 system running. They have to be resumed with
+                 _drain_manager.resumeObjects() before simulating on.
+
     """
 
+    if objects is None:
+        try_drain = _drain_manager.tryDrain
+    else:
+        cc_objects = [ obj.getCCObject() for obj in objects ]
+        try_drain = lambda: _drain_manager.tryDrainObjects(cc_objects)
+
     # Try to drain all objects. Draining might not be completed unless
     # all objects return that they are drained on the first call. This
     # is because as objects drain they may cause other objects to no
@@ -200,7 +600,7 @@ def drain():
         # Try to drain the system. The drain is successful if all
         # objects are done without simulation. We need to simulate
         # more if not.
-        if _drain_manager.tryDrain():
+        if try_drain():
             return True
 
         # WARNING: if a valid exit event occurs while draining, it
@@ -216,7 +616,8 @@ def drain():
     while not is_drained:
         is_drained = _drain()
 
-    assert _drain_manager.isDrained(), "Drain state inconsistent"
+    assert objects is not None or _drain_manager.isDrained(), \
+        "Drain state inconsistent"
 
 def memWriteback(root):
     for obj in root.descendants():
@@ -226,15 +627,17 @@ def memInvalidate(root):
     for obj in root.descendants():
         obj.memInvalidate()
 
-def checkpoint(dir):
+def checkpoint(dir, binary=False):
+    # With a cached configuration (m5.config_cache), the instance is
+    # a stand-in rather than a Root
     root = objects.Root.getInstance()
-    if not isinstance(root, objects.Root):
+    if root is None:
         raise TypeError("Checkpoint must be called on a root object.")
 
     drain()
     memWriteback(root)
     print("Writing checkpoint")
-    _m5.core.serializeAll(dir)
+    _m5.core.serializeAll(dir, binary)
 
 def _changeMemoryMode(system, mode):
     if not isinstance(system, (objects.Root, objects.System)):
@@ -245,7 +648,7 @@ def _changeMemoryMode(system, mode):
     else:
         print("System already in target mode. Memory mode unchanged.")
 
-def switchCpus(system, cpuList, verbose=True):
+def switchCpus(system, cpuList, verbose=True, quiesce_only=False):
     """Switch CPUs in a system.
 
     Note: This method may switch the memory mode of the system if that
@@ -255,6 +658,11 @@ def switchCpus(system, cpuList, verbose=True):
     Arguments:
       system -- Simulated system.
       cpuList -- (old_cpu, new_cpu) tuples
+      quiesce_only -- Only drain the CPUs and leave the memory system
+                      running, unless the memory mode changes. This
+                      makes frequent switches cheaper, but the memory
+                      system state at the switch differs from a full
+                      drain.
     """
 
     if verbose:
@@ -298,7 +706,15 @@ def switchCpus(system, cpuList, verbose=True):
     except KeyError:
         raise RuntimeError("Invalid memory mode (%s)" % memory_mode_name)
 
-    drain()
+    # Draining the CPUs is enough to hand them over, unless the memory
+    # system has to be drained for a change of memory mode
+    cpu_objects = None
+    if quiesce_only and not _drain_manager.isDrained() and \
+       system.getMemoryMode() == memory_mode:
+        cpu_objects = [ obj for cpu in old_cpus + new_cpus
+                        for obj in cpu.descendants() ]
+
+    drain(cpu_objects)
 
     # Now all of the CPUs are ready to be switched out
     for old_cpu, new_cpu in cpuList:
@@ -319,6 +735,11 @@ def switchCpus(system, cpuList, verbose=True):
     for old_cpu, new_cpu in cpuList:
         new_cpu.takeOverFrom(old_cpu)
 
+    # The system is still running, so resume the CPUs right away
+    if cpu_objects is not None:
+        _drain_manager.resumeObjects(
+            [ obj.getCCObject() for obj in cpu_objects ])
+
 def notifyFork(root):
     for obj in root.descendants():
         obj.notifyFork()
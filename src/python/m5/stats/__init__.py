@@ -183,6 +183,35 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
 
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
+@_url_factory([ "columnar", ])
+def _columnarFactory(fn, desc=True, formulas=True, delta=True):
+    """Output stats in a binary columnar format.
+
+    Columnar stat files are append-only binary files with one column
+    per stat value. The names, units and descriptions of the columns
+    are written once, later dumps only store values. This makes
+    frequent periodic dumps much cheaper than with the text format.
+
+    Files can be loaded with the m5.stats.columnar module, which can
+    also be used outside of gem5.
+
+    Known limitations:
+      * Sparse histograms are unsupported.
+      * Prerequisites are ignored, all stats are always stored.
+
+    Parameters:
+      * desc (bool): Output stat descriptions (default: True)
+      * formulas (bool): Output derived stats (default: True)
+      * delta (bool): Only store the stats that changed since the
+                      previous dump when that is smaller (default: True)
+
+    Example:
+      columnar://stats.cols?desc=False;delta=False
+
+    """
+
+    return _m5.stats.initColumnar(fn, desc, formulas, delta)
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
@@ -333,29 +362,38 @@ def prepare():
         stat.prepare()
 
     # New stats
-    _visit_stats(lambda g, s: s.prepare())
+    _flat_tree(Root.getInstance()).prepare()
 
-def _dump_to_visitor(visitor, roots=None):
-    # New stats
-    def dump_group(group):
-        for stat in group.getStats():
-            stat.visit(visitor)
-        for n, g in group.getStatGroups().items():
-            visitor.beginGroup(n)
-            dump_group(g)
-            visitor.endGroup()
+# Flattened stat hierarchies, indexed by the SimObject at their root.
+flat_trees = {}
 
+def _flat_tree(root):
+    '''Get the flattened stat hierarchy below a SimObject
+
+    The stat hierarchy can't change once stats have been enabled, so it
+    is flattened on its first use and reused by all later dumps. This
+    keeps the walk of the hierarchy out of Python.
+
+    '''
+
+    tree = flat_trees.get(root)
+    if tree is None:
+        tree = _m5.stats.FlatTree(root.getCCObject())
+        flat_trees[root] = tree
+    return tree
+
+def _dump_to_visitor(visitor, roots=None):
     if roots:
         # New stats from selected subroots.
         for root in roots:
             for p in root.path_list():
                 visitor.beginGroup(p)
-            dump_group(root)
+            _flat_tree(root).visit(visitor)
             for p in reversed(root.path_list()):
                 visitor.endGroup()
     else:
         # New stats starting from root.
-        dump_group(Root.getInstance())
+        _flat_tree(Root.getInstance()).visit(visitor)
 
         # Legacy stats
         for stat in stats_list:
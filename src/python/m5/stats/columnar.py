@@ -0,0 +1,198 @@
+# Copyright (c) 2021 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Reader for the binary columnar stat files written by the "columnar" stat
+visitor (see src/base/stats/columnar.hh for the file layout).
+
+The module doesn't depend on the rest of gem5 and can be used from a plain
+Python interpreter to load stats after a simulation:
+
+    stats = ColumnarStats("m5out/stats.cols")
+    for tick, ipc in zip(stats.ticks, stats.column("system.cpu.ipc")):
+        print(tick, ipc)
+
+It can also be run as a script to print one of the dumps of a file.
+"""
+
+import struct
+
+MAGIC = b"gem5cols"
+VERSION = 1
+
+RECORD_SCHEMA = 1
+RECORD_DUMP = 2
+RECORD_DELTA = 3
+
+class Schema(object):
+    """Columns of the dumps following a schema record."""
+
+    def __init__(self, names, units, descs):
+        self.names = names
+        self.units = units
+        self.descs = descs
+        self.index = { name: i for i, name in enumerate(names) }
+
+class ColumnarStats(object):
+    """All the dumps stored in a columnar stat file.
+
+    Each dump is stored as a list of values in the order of the columns
+    of its schema. Delta records are expanded when the file is loaded.
+    """
+
+    def __init__(self, path):
+        self.schemas = []
+        self.ticks = []
+        # Tuples of (schema, values), one per dump
+        self.dumps = []
+
+        with open(path, "rb") as f:
+            self._load(f.read(), path)
+
+    def _load(self, data, path):
+        if data[:len(MAGIC)] != MAGIC:
+            raise ValueError("%s isn't a columnar stat file" % path)
+
+        offset = len(MAGIC)
+        for order in ("<", ">"):
+            version, marker = struct.unpack_from(order + "II", data, offset)
+            if marker == 0x01020304:
+                break
+        else:
+            raise ValueError("%s: unknown byte order" % path)
+        offset += 8
+
+        if version != VERSION:
+            raise ValueError("%s: unsupported version %d" % (path, version))
+
+        header = struct.Struct(order + "IQ")
+        schema = None
+        values = None
+        while offset + header.size <= len(data):
+            rtype, size = header.unpack_from(data, offset)
+            offset += header.size
+            payload = data[offset:offset + size]
+            offset += size
+            if len(payload) != size:
+                raise ValueError("%s: truncated record" % path)
+
+            if rtype == RECORD_SCHEMA:
+                schema = self._parseSchema(order, payload)
+                self.schemas.append(schema)
+                values = None
+            elif rtype == RECORD_DUMP:
+                tick, = struct.unpack_from(order + "Q", payload)
+                values = list(struct.unpack_from(
+                    "%s%dd" % (order, len(schema.names)), payload, 8))
+                self.ticks.append(tick)
+                self.dumps.append((schema, values))
+            elif rtype == RECORD_DELTA:
+                if values is None:
+                    raise ValueError("%s: delta without a full dump" % path)
+                tick, count = struct.unpack_from(order + "QQ", payload)
+                indices = struct.unpack_from(
+                    "%s%dI" % (order, count), payload, 16)
+                changed = struct.unpack_from(
+                    "%s%dd" % (order, count), payload, 16 + 4 * count)
+                values = list(values)
+                for i, value in zip(indices, changed):
+                    values[i] = value
+                self.ticks.append(tick)
+                self.dumps.append((schema, values))
+            else:
+                raise ValueError("%s: unknown record type %d" % (path, rtype))
+
+    @staticmethod
+    def _parseSchema(order, payload):
+        count, = struct.unpack_from(order + "Q", payload)
+        offset = 8
+
+        def string():
+            nonlocal offset
+            length, = struct.unpack_from(order + "I", payload, offset)
+            offset += 4
+            s = payload[offset:offset + length].decode("utf-8")
+            offset += length
+            return s
+
+        names, units, descs = [], [], []
+        for _ in range(count):
+            names.append(string())
+            units.append(string())
+            descs.append(string())
+
+        return Schema(names, units, descs)
+
+    def __len__(self):
+        return len(self.dumps)
+
+    @property
+    def names(self):
+        """Column names of the latest schema."""
+        return self.schemas[-1].names if self.schemas else []
+
+    def column(self, name):
+        """Values of a stat across all dumps.
+
+        Dumps that didn't include the stat (e.g., dumps of a different
+        part of the stat tree) have None as value.
+        """
+        result = []
+        for schema, values in self.dumps:
+            i = schema.index.get(name)
+            result.append(values[i] if i is not None else None)
+        return result
+
+    def dump(self, n):
+        """Dictionary mapping stat names to their values in dump n."""
+        schema, values = self.dumps[n]
+        return dict(zip(schema.names, values))
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(
+        description="Print a dump of a columnar stat file")
+    parser.add_argument("file", help="Columnar stat file")
+    parser.add_argument("--dump", type=int, default=-1,
+                        help="Dump to print (default: the last one)")
+    args = parser.parse_args()
+
+    stats = ColumnarStats(args.file)
+    if not len(stats):
+        return
+
+    schema, values = stats.dumps[args.dump]
+    print("# tick %d" % stats.ticks[args.dump])
+    for name, unit, desc, value in zip(schema.names, schema.units,
+                                       schema.descs, values):
+        line = "%-60s %20.6f" % (name, value)
+        if desc:
+            line += " # %s (%s)" % (desc, unit)
+        print(line)
+
+if __name__ == "__main__":
+    main()
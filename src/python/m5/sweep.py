@@ -0,0 +1,156 @@
+# Copyright (c) 2021 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Forked configuration sweeps.
+
+Runs several variants of a configuration from one warmed-up state.
+The parent drains the simulator once, at the point where the variants
+diverge, and forks one child per variant with m5.fork(). The children
+share the parent's host memory copy-on-write, so the warm-up (loading
+a checkpoint, warming caches and predictors, etc.) is only simulated
+and only stored once.
+
+Parameters can not be changed after instantiation, so a variant is a
+function that reconfigures the running simulator through the run-time
+interfaces the objects offer, e.g., switching to a different set of
+switched out CPUs with m5.switchCpus() or changing a clock domain's
+performance level. Anything that has to differ between variants must
+therefore be instantiated in the parent.
+
+Example:
+
+    sweep = ForkedSweep({
+        "o3": lambda root: m5.switchCpus(system, zip(kvm, o3)),
+        "minor": lambda root: m5.switchCpus(system, zip(kvm, minor)),
+    })
+    variant = sweep.run()
+    if variant is None:
+        # Parent, all variants have finished
+        sys.exit(0 if sweep.succeeded() else 1)
+    exit_event = m5.simulate()
+
+Forking requires the simulator's listeners (terminals, GDB ports, etc.)
+to be disabled with m5.disableAllListeners().
+"""
+
+import os
+import sys
+
+import m5
+from m5 import stats
+from m5.util import fatal, inform
+
+class ForkedSweep(object):
+    """Fork the simulator once per variant.
+
+    Arguments:
+      variants -- Dict, or list of (name, function) pairs, mapping
+                  variant names to functions called with the Root
+                  object in the child to apply the variant.
+      simout -- Output directory of each child. Accepts the same
+                formatting keys as m5.fork() plus "variant", the name
+                of the variant.
+      max_parallel -- Number of children run at the same time, the
+                      number of host CPUs by default.
+      reset_stats -- Reset the statistics in each child after applying
+                     the variant, so they only cover the part of the
+                     run that differs between variants.
+    """
+
+    def __init__(self, variants, simout="%(parent)s.%(variant)s",
+                 max_parallel=None, reset_stats=True):
+        if isinstance(variants, dict):
+            variants = sorted(variants.items())
+        self.variants = list(variants)
+        if not self.variants:
+            fatal("A sweep needs at least one variant")
+        names = [ name for name, _ in self.variants ]
+        if len(set(names)) != len(names):
+            fatal("Sweep variant names have to be unique")
+
+        self.simout = simout
+        self.maxParallel = max_parallel or os.cpu_count() or 1
+        self.resetStats = reset_stats
+
+        # Exit status of each variant, filled in by the parent
+        self.status = {}
+
+    def _simout(self, name):
+        # Substitute the variant name now and leave the other keys to
+        # m5.fork()
+        return self.simout % {
+            "parent" : "%(parent)s",
+            "fork_seq" : "%(fork_seq)i",
+            "pid" : "%(pid)i",
+            "variant" : name.replace("%", "%%"),
+        }
+
+    def _reap(self, running):
+        pid, status = os.wait()
+        name = running.pop(pid)
+        if os.WIFSIGNALED(status):
+            self.status[name] = -os.WTERMSIG(status)
+        else:
+            self.status[name] = os.WEXITSTATUS(status)
+        inform("Sweep variant %s finished with status %d", name,
+               self.status[name])
+
+    def run(self):
+        """Fork the variants.
+
+        Returns the name of the variant in the children, after the
+        variant has been applied, and None in the parent once all the
+        children have exited.
+        """
+        # Drain once; the children start from exactly this state
+        m5.drain()
+
+        running = {}
+        for name, apply in self.variants:
+            while len(running) >= self.maxParallel:
+                self._reap(running)
+
+            sys.stdout.flush()
+            sys.stderr.flush()
+            pid = m5.fork(self._simout(name))
+            if pid == 0:
+                apply(m5.objects.Root.getInstance())
+                if self.resetStats:
+                    stats.reset()
+                return name
+
+            inform("Forked sweep variant %s (pid %d)", name, pid)
+            running[pid] = name
+
+        while running:
+            self._reap(running)
+
+        return None
+
+    def succeeded(self):
+        """True if every variant exited with status 0."""
+        return len(self.status) == len(self.variants) and \
+            all(s == 0 for s in self.status.values())
@@ -117,6 +117,8 @@ init_drain(py::module_ &m_native)
         m, "DrainManager")
         .def("tryDrain", &DrainManager::tryDrain)
         .def("resume", &DrainManager::resume)
+        .def("tryDrainObjects", &DrainManager::tryDrainObjects)
+        .def("resumeObjects", &DrainManager::resumeObjects)
         .def("preCheckpointRestore", &DrainManager::preCheckpointRestore)
         .def("isDrained", &DrainManager::isDrained)
         .def("state", &DrainManager::state)
@@ -281,7 +283,10 @@ pybind_init_core(py::module_ &m_native)
         .def("disableAllListeners", &ListenSocket::disableAll)
         .def("listenersDisabled", &ListenSocket::allDisabled)
         .def("listenersLoopbackOnly", &ListenSocket::loopbackOnly)
-        .def("seedRandom", [](uint64_t seed) { random_mt.init(seed); })
+        .def("seedRandom", [](uint64_t seed) {
+                random_mt.init(seed);
+                Random::setThreadSeed(seed);
+            })
 
 
         .def("fixClockFrequency", &fixClockFrequency)
@@ -307,7 +312,8 @@ pybind_init_core(py::module_ &m_native)
      * Serialization helpers
      */
     m_core
-        .def("serializeAll", &Serializable::serializeAll)
+        .def("serializeAll", &Serializable::serializeAll,
+             py::arg("cpt_dir"), py::arg("binary") = false)
         .def("unserializeGlobals", &Serializable::unserializeGlobals)
         .def("getCheckpoint", [](const std::string &cpt_dir) {
             return new CheckpointIn(cpt_dir, pybindSimObjectResolver);
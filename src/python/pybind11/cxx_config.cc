@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+#include "python/pybind11/pybind.hh"
+#include "sim/cxx_config.hh"
+#include "sim/cxx_config_ini.hh"
+#include "sim/cxx_manager.hh"
+#include "sim/init.hh"
+#include "sim/serialize.hh"
+#include "sim/sim_object.hh"
+
+namespace py = pybind11;
+
+namespace
+{
+
+/**
+ * A system instantiated from a config.ini file by a CxxConfigManager,
+ * bypassing the Python configuration. Used by m5.config_cache to
+ * restore cached configurations.
+ */
+class IniConfig
+{
+  private:
+    CxxIniFile file;
+    std::unique_ptr<CxxConfigManager> manager;
+
+    /** Run f, turning configuration errors into Python exceptions */
+    template <class F>
+    void
+    guard(F f)
+    {
+        try {
+            f();
+        } catch (CxxConfigManager::Exception &e) {
+            throw std::runtime_error(e.name + ": " + e.message);
+        }
+    }
+
+  public:
+    IniConfig(const std::string &filename)
+    {
+        if (!file.load(filename))
+            throw std::runtime_error("Can't load config file " + filename);
+        manager.reset(new CxxConfigManager(file));
+    }
+
+    /** Create all objects, bind their ports and register their stats */
+    void
+    instantiate()
+    {
+        guard([this]() {
+            manager->instantiate();
+            manager->bindStatGroups();
+        });
+    }
+
+    void initState() { guard([this]() { manager->initState(); }); }
+
+    void
+    loadState(const std::string &cpt_dir)
+    {
+        CheckpointIn cp(cpt_dir, manager->getSimObjectResolver());
+        Serializable::unserializeGlobals(cp);
+        guard([this, &cp]() { manager->loadState(cp); });
+    }
+
+    /** Names and objects, in the order objects are initialised */
+    std::vector<std::pair<std::string, SimObject *>>
+    objects() const
+    {
+        std::vector<std::pair<std::string, SimObject *>> objs;
+        for (auto *obj : manager->objectsInOrder)
+            objs.emplace_back(obj->name(), obj);
+        return objs;
+    }
+};
+
+void
+cxx_config_pybind(py::module_ &m_internal)
+{
+    py::module_ m = m_internal.def_submodule("cxx_config");
+
+    cxxConfigInit();
+
+    py::class_<IniConfig>(m, "IniConfig")
+        .def(py::init<const std::string &>())
+        .def("instantiate", &IniConfig::instantiate)
+        .def("initState", &IniConfig::initState)
+        .def("loadState", &IniConfig::loadState)
+        .def("objects", &IniConfig::objects,
+             py::return_value_policy::reference)
+        ;
+}
+EmbeddedPyBind embed_("cxx_config", &cxx_config_pybind);
+
+} // anonymous namespace
@@ -48,6 +48,7 @@
 #include "base/debug.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "base/trace_binary.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -67,6 +68,17 @@ output(const char *filename)
     Trace::setDebugLogger(new Trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+outputBinary(const char *filename)
+{
+    OutputStream *file_stream = simout.find(filename);
+
+    if (!file_stream)
+        file_stream = simout.create(filename, true);
+
+    Trace::setDebugLogger(new Trace::BinaryLogger(*file_stream->stream()));
+}
+
 static void
 ignore(const char *expr)
 {
@@ -121,6 +133,7 @@ pybind_init_debug(py::module_ &m_native)
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("outputBinary", &outputBinary)
         .def("ignore", &ignore)
         .def("enable", &Trace::enable)
         .def("disable", &Trace::disable)
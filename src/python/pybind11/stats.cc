@@ -44,6 +44,8 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/columnar.hh"
+#include "base/stats/flat_tree.hh"
 #include "base/stats/text.hh"
 #if USE_HDF5
 #include "base/stats/hdf5.hh"
@@ -106,6 +108,7 @@ pybind_init_stats(py::module_ &m_native)
     m
         .def("initSimStats", &Stats::initSimStats)
         .def("initText", &Stats::initText, py::return_value_policy::reference)
+        .def("initColumnar", &Stats::initColumnar)
 #if USE_HDF5
         .def("initHDF5", &Stats::initHDF5)
 #endif
@@ -249,4 +252,10 @@ pybind_init_stats(py::module_ &m_native)
                  return cast_stat_info(stat);
              })
         ;
+
+    py::class_<Stats::FlatTree>(m, "FlatTree")
+        .def(py::init<const Stats::Group &>())
+        .def("visit", &Stats::FlatTree::visit)
+        .def("prepare", &Stats::FlatTree::prepare)
+        ;
 }
@@ -44,6 +44,10 @@ class Process(SimObject):
     useArchPT = Param.Bool('false', 'maintain an in-memory version of the page\
                             table in an architecture-specific format')
     kvmInSE = Param.Bool('false', 'initialize the process for KvmCPU in SE')
+    directSyscallIO = Param.Bool(False, "Let I/O system calls access "
+        "guest memory directly through the memory backdoor instead of "
+        "copying it through a proxy. Only safe when no caches hold guest "
+        "data; always done when the system bypasses caches")
     maxStackSize = Param.MemorySize('64MiB', 'maximum size of the stack')
 
     uid = Param.Int(100, 'user id')
@@ -30,6 +30,16 @@ from m5.SimObject import SimObject
 from m5.params import *
 from m5.util import fatal
 
+# Storage backend of the main event queues. 'list' keeps pending events
+# in a single sorted list, 'calendar' uses a calendar queue, which
+# scales better when many events are pending at the same time.
+class EventQueueBackend(ScopedEnum): vals = ['list', 'calendar']
+
+# Automatic assignment of SimObjects to event queues (and thus host
+# threads), see m5.simulate.partitionEventQueues().
+class EventQueuePartitioning(ScopedEnum):
+    vals = ['none', 'cores', 'cores_and_ruby']
+
 class Root(SimObject):
 
     _the_instance = None
@@ -63,9 +73,46 @@ class Root(SimObject):
     eventq_index = 0
 
     # Simulation Quantum for multiple main event queue simulation.
-    # Needs to be set explicitly for a multi-eventq simulation.
+    # Needs to be set explicitly for a multi-eventq simulation, unless
+    # it is derived by the automatic event queue partitioning.
     sim_quantum = Param.Tick(0, "simulation quantum")
 
+    # An adaptive quantum places the next synchronization at the
+    # earliest tick any event queue could send an event to another
+    # queue, i.e., its next event plus its lookahead. The lookahead of
+    # a queue defaults to sim_quantum.
+    adaptive_quantum = Param.Bool(False, "let the quantum adapt to the "
+                                  "lookahead of the event queues")
+    eventq_lookahead = VectorParam.Tick([], "minimum latency of the events "
+                                        "each event queue sends to other "
+                                        "queues")
+
+    eventq_partitioning = Param.EventQueuePartitioning('none',
+        "automatically place each core and its private components on "
+        "its own event queue, a quantum is derived unless set explicitly")
+
+    event_profile_period = Param.Unsigned(0, "time one in every N events "
+        "serviced and write a host time profile to eventprofile.folded "
+        "and eventprofile.txt in the output directory, 0 disables "
+        "profiling")
+    flight_recorder_events = Param.Unsigned(1024, "keep the last N "
+        "serviced events of every event queue and write them to "
+        "flight_recorder.txt in the output directory on panic, fatal, a "
+        "crash or SIGQUIT, 0 disables the flight recorder")
+    flight_recorder_messages = Param.Unsigned(1024, "number of debug "
+        "messages of the flight_recorder_flags kept per event queue")
+    flight_recorder_flags = VectorParam.String([], "debug flags whose "
+        "messages are kept by the flight recorder instead of being printed")
+    eventq_backend = Param.EventQueueBackend('list',
+        "storage backend used by the main event queues")
+    live_stats_port = Param.TcpPort(0, "serve the simulated tick, host "
+        "memory, event queue sizes and live_stats over HTTP, in the text "
+        "format of Prometheus, on this port, 0 disables the server")
+    live_stats = VectorParam.String(['simInsts', 'hostInstRate',
+        'hostEvents', 'hostEventRate', 'hostTickRate', 'hostSeconds'],
+        "statistics served by the live statistics server, named relative "
+        "to the root")
+
     full_system = Param.Bool("if this is a full system simulation")
 
     # Time syncing prevents the simulation from running faster than real time.
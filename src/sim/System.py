@@ -48,6 +48,12 @@ from m5.objects.SimpleMemory import *
 class MemoryMode(Enum): vals = ['invalid', 'atomic', 'timing',
                                 'atomic_noncaching']
 
+# Huge pages backing the simulated memory on the host, either
+# transparent huge pages that the host kernel may or may not provide,
+# or pages from the reserved huge TLB pool
+class BackstoreHugePages(ScopedEnum): vals = ['none', 'transparent',
+                                              'hugetlb']
+
 if buildEnv['TARGET_ISA'] in ('sparc', 'power'):
     default_byte_order = 'big'
 else:
@@ -87,6 +93,32 @@ class System(SimObject):
         "use to directly address the backstore from another host-OS process. "
         "Leave this empty to unset the MAP_SHARED flag.")
 
+    # Huge pages reduce the host TLB misses of large simulated memories
+    backstore_huge_pages = Param.BackstoreHugePages('none', "host huge "
+        "pages backing the memory, hugetlb requires a huge page pool to "
+        "be reserved on the host")
+
+    # Checkpoints split the backing store images in shards that are
+    # compressed and restored in parallel, and leave out zero pages.
+    checkpoint_shard_size = Param.MemorySize("256MiB", "size of the shards "
+        "of checkpointed memory images, 0 to write one image per backing "
+        "store in the legacy format")
+    checkpoint_threads = Param.Unsigned(0, "number of threads compressing "
+        "and decompressing memory image shards, 0 for one per host core")
+    # Differential checkpoints only write the shards that changed since
+    # the previous checkpoint taken or restored and refer to the files
+    # of the older checkpoints for the others, which must be kept.
+    checkpoint_differential = Param.Bool(False, "only write the memory "
+        "shards that changed since the previous checkpoint")
+
+    # Simulations restoring the same checkpoint on a host can share the
+    # memory pages they don't write. The first restore of a checkpoint
+    # leaves an uncompressed image of the memory in the cache directory,
+    # later restores map it copy-on-write rather than decompressing it.
+    restore_image_cache = Param.String("", "directory of the uncompressed "
+        "memory images mapped copy-on-write when restoring a checkpoint, "
+        "leave this empty to restore into private memory")
+
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
     byte_order = Param.ByteOrder(default_byte_order,
@@ -44,6 +44,8 @@ extern volatile bool async_statreset;   ///< Async request to reset stats.
 extern volatile bool async_exit;        ///< Async request to exit simulator.
 extern volatile bool async_io;          ///< Async I/O request (SIGIO).
 extern volatile bool async_exception;   ///< Python exception.
+extern volatile bool async_flightdump;  ///< Async request to dump the
+                                        ///< flight recorder.
 //@}
 
 #endif // __ASYNC_HH__
@@ -41,6 +41,7 @@
 #include <algorithm>
 #include <functional>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/ClockDomain.hh"
@@ -64,10 +65,59 @@ ClockDomain::ClockDomain(const Params &p, VoltageDomain *voltage_domain)
     : SimObject(p),
       _clockPeriod(0),
       _voltageDomain(voltage_domain),
+      _generation(0),
       stats(*this)
 {
 }
 
+void
+ClockDomain::changeClockPeriod(Tick clock_period)
+{
+    if (clock_period == _clockPeriod)
+        return;
+
+    // Without members there is nobody to keep up to date, members
+    // registering later start from the current period
+    if (!members.empty()) {
+        // Bound the log by bringing all members up to date once in a
+        // while, rather than at every change
+        if (periodChanges.size() == maxPeriodChanges) {
+            for (auto m : members)
+                m->updateClockPeriod();
+            periodChanges.clear();
+        }
+
+        periodChanges.push_back({curTick(), clock_period});
+        ++_generation;
+    }
+
+    _clockPeriod = clock_period;
+
+    for (auto l : listeners)
+        l->updateClockPeriod();
+}
+
+void
+ClockDomain::applyPeriodChanges(Tick &tick, Cycles &cycle, Tick &period,
+                                uint64_t &generation) const
+{
+    const uint64_t first = _generation - periodChanges.size();
+    assert(generation >= first);
+
+    for (; generation != _generation; ++generation) {
+        const PeriodChange &change = periodChanges[generation - first];
+
+        // Align to the first edge of the old period at or after the
+        // change, the new period applies from there
+        if (tick < change.when) {
+            Cycles elapsed(divCeil(change.when - tick, period));
+            cycle += elapsed;
+            tick += elapsed * period;
+        }
+        period = change.period;
+    }
+}
+
 double
 ClockDomain::voltage() const
 {
@@ -115,12 +165,7 @@ SrcClockDomain::clockPeriod(Tick clock_period)
         fatal("%s has a clock period of zero\n", name());
     }
 
-    // Align all members to the current tick
-    for (auto m = members.begin(); m != members.end(); ++m) {
-        (*m)->updateClockPeriod();
-    }
-
-    _clockPeriod = clock_period;
+    changeClockPeriod(clock_period);
 
     DPRINTF(ClockDomain,
             "Setting clock period to %d ticks for source clock %s\n",
@@ -205,14 +250,9 @@ DerivedClockDomain::DerivedClockDomain(const Params &p) :
 void
 DerivedClockDomain::updateClockPeriod()
 {
-    // Align all members to the current tick
-    for (auto m = members.begin(); m != members.end(); ++m) {
-        (*m)->updateClockPeriod();
-    }
-
     // recalculate the clock period, relying on the fact that changes
     // propagate downwards in the tree
-    _clockPeriod = parent.clockPeriod() * clockDivider;
+    changeClockPeriod(parent.clockPeriod() * clockDivider);
 
     DPRINTF(ClockDomain,
             "Setting clock period to %d ticks for derived clock %s\n",
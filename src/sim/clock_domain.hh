@@ -92,6 +92,43 @@ class ClockDomain : public SimObject
      */
     std::vector<Clocked *> members;
 
+    /**
+     * Members that want to be told about clock period changes right
+     * away. The others pick the changes up lazily.
+     */
+    std::vector<Clocked *> listeners;
+
+    /** A clock period change: when it happened and the new period */
+    struct PeriodChange
+    {
+        Tick when;
+        Tick period;
+    };
+
+    /**
+     * Clock period changes that members may not have applied yet,
+     * oldest first. The last one is generation _generation - 1.
+     */
+    std::vector<PeriodChange> periodChanges;
+
+    /** Number of clock period changes seen by the members */
+    uint64_t _generation;
+
+    /**
+     * Number of logged changes after which all members are brought up
+     * to date instead of logging more.
+     */
+    static const size_t maxPeriodChanges = 64;
+
+    /**
+     * Change the clock period. Members align their clock edges to the
+     * old period up to the change lazily, the next time they look at
+     * their clock.
+     *
+     * @param clock_period New clock period in ticks
+     */
+    void changeClockPeriod(Tick clock_period);
+
   public:
 
     typedef ClockDomainParams Params;
@@ -116,6 +153,38 @@ class ClockDomain : public SimObject
         members.push_back(c);
     }
 
+    /**
+     * Have a member's clockPeriodUpdated() called as soon as the clock
+     * period changes.
+     *
+     * @param Clocked to notify
+     */
+    void
+    notifyOnClockPeriodChange(Clocked *c)
+    {
+        assert(std::find(members.begin(), members.end(), c) != members.end());
+        listeners.push_back(c);
+    }
+
+    /**
+     * Get the number of clock period changes so far. Members compare
+     * it with the generation they last applied to see if they are up
+     * to date.
+     */
+    uint64_t generation() const { return _generation; }
+
+    /**
+     * Apply the clock period changes a member has not seen yet to its
+     * clock edge, cycle count and period.
+     *
+     * @param tick Next clock edge of the member
+     * @param cycle Cycle count at that edge
+     * @param period Clock period last seen by the member
+     * @param generation Generation last seen by the member
+     */
+    void applyPeriodChanges(Tick &tick, Cycles &cycle, Tick &period,
+                            uint64_t &generation) const;
+
     /**
      * Get the voltage domain.
      *
@@ -41,7 +41,8 @@
 #include "sim/power/power_model.hh"
 
 ClockedObject::ClockedObject(const ClockedObjectParams &p) :
-    SimObject(p), Clocked(*p.clk_domain), powerState(p.power_state)
+    SimObject(p), Clocked(*p.clk_domain), _quiescentUntil(0),
+    powerState(p.power_state)
 {
     // Register the power_model with the object
     // Slightly counter-intuitively, power models need to to register with the
@@ -45,6 +45,7 @@
 #define __SIM_CLOCKED_OBJECT_HH__
 
 
+#include "base/callback.hh"
 #include "params/ClockedObject.hh"
 #include "sim/core.hh"
 #include "sim/clock_domain.hh"
@@ -68,6 +69,12 @@ class Clocked
     // 'tick'
     mutable Cycles cycle;
 
+    // The clock period 'tick' and 'cycle' advance by, and the clock
+    // domain generation it belongs to. Clock period changes of the
+    // domain are applied lazily, when the generations differ.
+    mutable Tick period;
+    mutable uint64_t generation;
+
     /**
      *  Align cycle and tick to the next clock edge if not already done. When
      *  complete, tick must be at least curTick().
@@ -75,6 +82,10 @@ class Clocked
     void
     update() const
     {
+        // catch up with clock period changes since the last update
+        if (generation != clockDomain.generation())
+            clockDomain.applyPeriodChanges(tick, cycle, period, generation);
+
         // both tick and cycle are up-to-date and we are done, note
         // that the >= is important as it captures cases where tick
         // has already passed curTick()
@@ -83,7 +94,7 @@ class Clocked
 
         // optimise for the common case and see if the tick should be
         // advanced by a single clock period
-        tick += clockPeriod();
+        tick += period;
         ++cycle;
 
         // see if we are done at this point
@@ -93,9 +104,9 @@ class Clocked
         // if not, we have to recalculate the cycle and tick, we
         // perform the calculations in terms of relative cycles to
         // allow changes to the clock period in the future
-        Cycles elapsedCycles(divCeil(curTick() - tick, clockPeriod()));
+        Cycles elapsedCycles(divCeil(curTick() - tick, period));
         cycle += elapsedCycles;
-        tick += elapsedCycles * clockPeriod();
+        tick += elapsedCycles * period;
     }
 
     /**
@@ -110,7 +121,8 @@ class Clocked
      * parameters.
      */
     Clocked(ClockDomain &clk_domain)
-        : tick(0), cycle(0), clockDomain(clk_domain)
+        : tick(0), cycle(0), period(clk_domain.clockPeriod()),
+          generation(clk_domain.generation()), clockDomain(clk_domain)
     {
         // Register with the clock domain, so that if the clock domain
         // frequency changes, we can update this object's tick.
@@ -133,21 +145,35 @@ class Clocked
     void
     resetClock() const
     {
-        Cycles elapsedCycles(divCeil(curTick(), clockPeriod()));
+        period = clockPeriod();
+        generation = clockDomain.generation();
+        Cycles elapsedCycles(divCeil(curTick(), period));
         cycle = elapsedCycles;
-        tick = elapsedCycles * clockPeriod();
+        tick = elapsedCycles * period;
     }
 
     /**
      * A hook subclasses can implement so they can do any extra work that's
-     * needed when the clock rate is changed.
+     * needed when the clock rate is changed. It is only called for objects
+     * that asked for it with notifyClockPeriodUpdates().
      */
     virtual void clockPeriodUpdated() {}
 
+    /**
+     * Have clockPeriodUpdated() called as soon as the clock period of
+     * the clock domain changes.
+     */
+    void
+    notifyClockPeriodUpdates()
+    {
+        clockDomain.notifyOnClockPeriodChange(this);
+    }
+
   public:
 
     /**
-     * Update the tick to the current tick.
+     * Apply the pending clock period changes and update the tick to the
+     * current tick.
      */
     void
     updateClockPeriod()
@@ -177,7 +203,7 @@ class Clocked
         update();
 
         // figure out when this future cycle is
-        return tick + clockPeriod() * cycles;
+        return tick + period * cycles;
     }
 
     /**
@@ -230,6 +256,13 @@ class Clocked
  */
 class ClockedObject : public SimObject, public Clocked
 {
+  private:
+    /** Tick before which the object has declared it has no work. */
+    Tick _quiescentUntil;
+
+    /** Callbacks run when the object is woken up. */
+    CallbackQueue wakeUpCallbacks;
+
   public:
     ClockedObject(const ClockedObjectParams &p);
 
@@ -239,6 +272,58 @@ class ClockedObject : public SimObject, public Clocked
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 
+    /**
+     * @{
+     * Idle skipping.
+     *
+     * An object that is evaluated every cycle can declare that it
+     * has no work to do for a number of cycles, e.g. because all it
+     * is waiting for is a timer. Per-cycle loops driving the object
+     * (see Ticked) then skip straight to the end of the quiescent
+     * period instead of visiting every empty cycle. Work arriving
+     * earlier must end the quiescent period with wakeUp().
+     */
+
+    /** Declare that the object has no work until it is woken up. */
+    void quiesce() { _quiescentUntil = MaxTick; }
+
+    /**
+     * Declare that the object has no work during the next @p cycles
+     * cycles.
+     */
+    void
+    quiesce(Cycles cycles)
+    {
+        if (cycles >= (MaxTick - curTick()) / clockPeriod())
+            quiesce();
+        else
+            _quiescentUntil = clockEdge(cycles);
+    }
+
+    /** End the quiescent period and notify the per-cycle loops. */
+    void
+    wakeUp()
+    {
+        if (quiescent()) {
+            _quiescentUntil = 0;
+            wakeUpCallbacks.process();
+        }
+    }
+
+    /** Is the object in a quiescent period? */
+    bool quiescent() const { return _quiescentUntil > curTick(); }
+
+    /** Tick at which the current quiescent period ends, if any. */
+    Tick quiescentUntil() const { return _quiescentUntil; }
+
+    /** Register a callback to run when the object is woken up. */
+    void
+    onWakeUp(const std::function<void()> &callback)
+    {
+        wakeUpCallbacks.push_back(callback);
+    }
+    /** @} */
+
     PowerState *powerState;
 };
 
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *
+ * main() of gem5.cxx, a gem5 binary without the Python interpreter.
+ * It builds the simulated system from a config.ini file written by a
+ * Python run of gem5 (see --dump-config) using a CxxConfigManager, and
+ * runs it. The simulation control is that of a simple config script:
+ * run until an exit event, writing checkpoints on the way when the
+ * workload asks for them.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/debug.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/str.hh"
+#include "base/trace.hh"
+#include "base/types.hh"
+#include "sim/core.hh"
+#include "sim/cxx_config.hh"
+#include "sim/cxx_config_ini.hh"
+#include "sim/cxx_manager.hh"
+#include "sim/cxx_stats.hh"
+#include "sim/drain.hh"
+#include "sim/eventq.hh"
+#include "sim/init_signals.hh"
+#include "sim/serialize.hh"
+#include "sim/sim_events.hh"
+#include "sim/sim_object.hh"
+#include "sim/simulate.hh"
+#include "sim/stat_control.hh"
+
+namespace
+{
+
+void
+usage(const char *prog_name)
+{
+    std::cerr << "Usage: " << prog_name << " [OPTIONS] CONFIG.INI\n\n"
+        "Run a system described by a config.ini file without Python.\n\n"
+        "Options:\n"
+        "  --outdir=DIR            Output directory (default: m5out)\n"
+        "  --stats-file=FILE       Stats file, relative to the output\n"
+        "                          directory (default: stats.txt)\n"
+        "  --debug-flags=FLAGS     Comma separated debug flags to set,\n"
+        "                          -FLAG clears a flag\n"
+        "  --debug-file=FILE       Debug output file (default: cout)\n"
+        "  --param=OBJ.PARAM=VAL   Override a parameter, may be repeated\n"
+        "  --restore=DIR           Restore a checkpoint\n"
+        "  --max-tick=TICK         Stop the simulation at TICK\n";
+    std::exit(EXIT_FAILURE);
+}
+
+/** Match "--name=value", returning value */
+bool
+option(const std::string &arg, const char *name, std::string &value)
+{
+    const std::string prefix = csprintf("--%s=", name);
+    if (arg.compare(0, prefix.size(), prefix) != 0)
+        return false;
+    value = arg.substr(prefix.size());
+    return true;
+}
+
+void
+drain(CxxConfigManager &manager)
+{
+    while (manager.drain() > 0) {
+        GlobalSimLoopExitEvent *exit_event = simulate();
+        if (exit_event->getCause() != "Finished drain")
+            warn("Exit event '%s' ignored while draining\n",
+                 exit_event->getCause());
+    }
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    std::string outdir = "m5out";
+    std::string stats_file = "stats.txt";
+    std::string debug_flags;
+    std::string debug_file = "cout";
+    std::string restore_dir;
+    std::string config_file;
+    std::vector<std::string> params;
+    Tick max_tick = MaxTick;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        std::string value;
+        if (option(arg, "outdir", outdir) ||
+                option(arg, "stats-file", stats_file) ||
+                option(arg, "debug-flags", debug_flags) ||
+                option(arg, "debug-file", debug_file) ||
+                option(arg, "restore", restore_dir)) {
+            continue;
+        } else if (option(arg, "param", value)) {
+            params.push_back(value);
+        } else if (option(arg, "max-tick", value)) {
+            if (!to_number(value, max_tick))
+                usage(argv[0]);
+        } else if (arg[0] == '-' || !config_file.empty()) {
+            usage(argv[0]);
+        } else {
+            config_file = arg;
+        }
+    }
+    if (config_file.empty())
+        usage(argv[0]);
+
+    cxxConfigInit();
+    initSignals();
+
+    // The default tick rate of the Python configuration (1 THz)
+    setClockFrequency(1000000000000ULL);
+    curEventQueue(getEventQueue(0));
+
+    setOutputDir(outdir);
+
+    std::vector<std::string> flags;
+    tokenize(flags, debug_flags, ',');
+    for (const auto &flag : flags) {
+        if (flag[0] == '-')
+            clearDebugFlag(flag.c_str() + 1);
+        else
+            setDebugFlag(flag.c_str());
+    }
+    OutputStream *debug_stream = simout.findOrCreate(debug_file);
+    Trace::setDebugLogger(new Trace::OstreamLogger(*debug_stream->stream()));
+    Trace::enable();
+
+    CxxConfig::statsInit(stats_file);
+
+    CxxIniFile config;
+    if (!config.load(config_file))
+        fatal("Can't open config file '%s'\n", config_file);
+
+    CxxConfigManager manager(config);
+    try {
+        for (const auto &param : params) {
+            const auto eq = param.find('=');
+            const auto dot = param.rfind('.', eq);
+            if (eq == std::string::npos || dot == std::string::npos)
+                fatal("Bad parameter override '%s', expected "
+                      "OBJ.PARAM=VALUE\n", param);
+            manager.setParam(param.substr(0, dot),
+                             param.substr(dot + 1, eq - dot - 1),
+                             param.substr(eq + 1));
+        }
+
+        manager.instantiate();
+        manager.bindStatGroups();
+    } catch (CxxConfigManager::Exception &e) {
+        fatal("Config problem in sim object %s: %s\n", e.name, e.message);
+    }
+
+    CxxConfig::statsEnable(*manager.findObject("root"));
+
+    if (!restore_dir.empty()) {
+        DrainManager::instance().preCheckpointRestore();
+        CheckpointIn checkpoint(restore_dir,
+                                manager.getSimObjectResolver());
+        Serializable::unserializeGlobals(checkpoint);
+        manager.loadState(checkpoint);
+    } else {
+        manager.initState();
+    }
+    Stats::updateEvents();
+
+    manager.startup();
+    CxxConfig::statsReset();
+
+    GlobalSimLoopExitEvent *exit_event;
+    while (true) {
+        if (DrainManager::instance().isDrained())
+            manager.drainResume();
+
+        exit_event = simulate(max_tick - curTick());
+        if (exit_event->getCause() != "checkpoint")
+            break;
+
+        drain(manager);
+        Serializable::serializeAll(
+            simout.resolve(csprintf("cpt.%d", curTick())));
+    }
+
+    inform("Exiting @ tick %i because %s\n", curTick(),
+           exit_event->getCause());
+
+    CxxConfig::statsDump();
+    doExitCleanup();
+
+    return exit_event->getCode();
+}
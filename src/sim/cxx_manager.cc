@@ -609,6 +609,33 @@ CxxConfigManager::instantiate(bool build_all)
     forEachObject(&SimObject::regProbeListeners);
 }
 
+void
+CxxConfigManager::bindStatGroups()
+{
+    for (auto i = objectsInOrder.begin(); i != objectsInOrder.end(); ++i) {
+        const std::string &object_name = (*i)->name();
+        if (object_name == "root")
+            continue;
+
+        /* Attach to the nearest ancestor that was instantiated */
+        std::string parent_name = object_name;
+        auto parent = objectsByName.end();
+        while (parent == objectsByName.end() && parent_name != "root") {
+            auto dot = parent_name.rfind('.');
+            parent_name = dot == std::string::npos ? "root" :
+                parent_name.substr(0, dot);
+            parent = objectsByName.find(parent_name);
+        }
+
+        if (parent != objectsByName.end() && parent->second) {
+            auto dot = object_name.rfind('.');
+            const std::string leaf = dot == std::string::npos ?
+                object_name : object_name.substr(dot + 1);
+            parent->second->addStatGroup(leaf.c_str(), *i);
+        }
+    }
+}
+
 void
 CxxConfigManager::initState()
 {
@@ -274,6 +274,11 @@ class CxxConfigManager
      *  instantiate */
     void instantiate(bool build_all = true);
 
+    /** Add each object's statistics to those of its parent, giving the
+     *  same stat hierarchy as objects instantiated from Python.  Call
+     *  this after instantiate() */
+    void bindStatGroups();
+
     /** Call initState on all objects */
     void initState();
 
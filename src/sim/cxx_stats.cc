@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/cxx_stats.hh"
+
+#include <memory>
+
+#include "base/logging.hh"
+#include "base/statistics.hh"
+#include "base/stats/flat_tree.hh"
+#include "base/stats/group.hh"
+#include "base/stats/info.hh"
+#include "base/stats/output.hh"
+#include "base/stats/text.hh"
+#include "sim/stat_control.hh"
+
+namespace CxxConfig
+{
+
+namespace
+{
+
+/** Output the stats are dumped to */
+Stats::Output *output = nullptr;
+
+/** Root of the stat hierarchy */
+Stats::Group *statsRoot = nullptr;
+
+/** Flattened hierarchy, built by statsEnable() */
+std::unique_ptr<Stats::FlatTree> tree;
+
+void
+checkAndEnable(Stats::Info *info)
+{
+    fatal_if(!info->check() || !info->baseCheck(),
+             "statistic '%s' (%d) was not properly initialized "
+             "by a regStats() function\n", info->name, info->id);
+
+    if (!(info->flags & Stats::display))
+        info->name = csprintf("__Stat%06d", info->id);
+
+    info->enable();
+}
+
+void
+enableGroup(const Stats::Group &group)
+{
+    for (auto *info : group.getStats())
+        checkAndEnable(info);
+    for (const auto &g : group.getStatGroups())
+        enableGroup(*g.second);
+}
+
+} // anonymous namespace
+
+void
+statsInit(const std::string &filename, bool desc, bool spaces)
+{
+    Stats::initSimStats();
+    output = Stats::initText(filename, desc, spaces);
+    Stats::registerHandlers(statsReset, statsDump);
+}
+
+void
+statsEnable(Stats::Group &root)
+{
+    // Legacy stats
+    for (auto *info : Stats::statsList())
+        checkAndEnable(info);
+
+    enableGroup(root);
+    statsRoot = &root;
+    tree.reset(new Stats::FlatTree(root));
+
+    Stats::enable();
+}
+
+void
+statsDump()
+{
+    panic_if(!tree, "Stats dumped before being enabled\n");
+
+    Stats::processDumpQueue();
+    statsRoot->preDumpStats();
+
+    for (auto *info : Stats::statsList())
+        info->prepare();
+    tree->prepare();
+
+    if (!output || !output->valid())
+        return;
+
+    output->begin();
+    tree->visit(*output);
+    for (auto *info : Stats::statsList())
+        info->visit(*output);
+    output->end();
+}
+
+void
+statsReset()
+{
+    if (statsRoot)
+        statsRoot->resetStats();
+
+    for (auto *info : Stats::statsList())
+        info->reset();
+
+    Stats::processResetQueue();
+}
+
+} // namespace CxxConfig
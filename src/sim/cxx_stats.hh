@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *
+ * Statistics handling for systems instantiated without Python, e.g.,
+ * by a CxxConfigManager. This does what m5.stats does for Python
+ * configurations: it enables the stats once the objects have been
+ * created, and dumps and resets them from the stat hierarchy below
+ * the root object.
+ */
+
+#ifndef __SIM_CXX_STATS_HH__
+#define __SIM_CXX_STATS_HH__
+
+#include <string>
+
+namespace Stats
+{
+class Group;
+} // namespace Stats
+
+namespace CxxConfig
+{
+
+/**
+ * Initialise the statistics. Call this before any SimObject is
+ * created.
+ *
+ * @param filename Text stats file, relative to the output directory.
+ * @param desc Print the descriptions and units of the stats.
+ * @param spaces Align the columns of the stats file.
+ */
+void statsInit(const std::string &filename, bool desc=true,
+               bool spaces=true);
+
+/**
+ * Check and enable all the statistics. Call this once all objects have
+ * been instantiated and their stats registered.
+ *
+ * @param root Group at the root of the stat hierarchy, normally the
+ * Root object.
+ */
+void statsEnable(Stats::Group &root);
+
+/** Dump the statistics to the stats file */
+void statsDump();
+
+/** Reset the statistics */
+void statsReset();
+
+} // namespace CxxConfig
+
+#endif // __SIM_CXX_STATS_HH__
@@ -128,6 +128,54 @@ DrainManager::resume()
     _state = DrainState::Running;
 }
 
+bool
+DrainManager::tryDrainObjects(const std::vector<Drainable *> &objs)
+{
+    panic_if(_state != DrainState::Running,
+             "Trying to drain objects of a system that is not running\n");
+
+    panic_if(_count != 0,
+             "Drain counter must be zero at the start of a drain cycle\n");
+
+    DPRINTF(Drain, "Trying to drain %u of %u objects.\n", objs.size(),
+            drainableCount());
+    for (auto *obj : objs) {
+        DrainState status = obj->dmDrain();
+        if (DTRACE(Drain) && status != DrainState::Drained) {
+            SimObject *temp = dynamic_cast<SimObject*>(obj);
+            if (temp)
+                DPRINTF(Drain, "Failed to drain %s\n", temp->name());
+        }
+        _count += status == DrainState::Drained ? 0 : 1;
+    }
+
+    if (_count == 0) {
+        DPRINTF(Drain, "Objects drained.\n");
+        return true;
+    } else {
+        DPRINTF(Drain, "Need another drain cycle. %u/%u objects not ready.\n",
+                _count, objs.size());
+        return false;
+    }
+}
+
+void
+DrainManager::resumeObjects(const std::vector<Drainable *> &objs)
+{
+    panic_if(_state != DrainState::Running,
+             "Trying to resume objects of a system that is not running\n");
+
+    panic_if(_count != 0,
+             "Resume called in the middle of a drain cycle. %u objects "
+             "left to drain.\n", _count);
+
+    DPRINTF(Drain, "Resuming %u objects.\n", objs.size());
+    for (auto *obj : objs) {
+        if (obj->drainState() != DrainState::Running)
+            obj->dmDrainResume();
+    }
+}
+
 void
 DrainManager::preCheckpointRestore()
 {
@@ -111,6 +111,27 @@ class DrainManager
      */
     void resume();
 
+    /**
+     * Try to drain some of the objects in the system.
+     *
+     * This works like tryDrain(), but only the given objects are
+     * drained, while the rest of the system keeps running. It is
+     * meant to quiesce the CPUs for a handover without draining the
+     * memory system, and is only allowed while the system is running.
+     *
+     * @param objs Objects to drain
+     * @return true if all the objects were drained successfully,
+     * false if more simulation is needed.
+     */
+    bool tryDrainObjects(const std::vector<Drainable *> &objs);
+
+    /**
+     * Resume objects drained with tryDrainObjects().
+     *
+     * @param objs Objects to resume
+     */
+    void resumeObjects(const std::vector<Drainable *> &objs);
+
     /**
      * Run state fixups before a checkpoint restore operation.
      *
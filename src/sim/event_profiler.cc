@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_profiler.hh"
+
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/output.hh"
+#include "sim/core.hh"
+#include "sim/eventq.hh"
+
+namespace
+{
+
+unsigned mainProfilePeriod = 0;
+bool dumpRegistered = false;
+std::vector<EventProfiler *> mainProfilers;
+
+/** Frames can't contain the separators of the folded stack format. */
+void
+appendFrame(std::string &key, const std::string &frame)
+{
+    if (!key.empty())
+        key += ';';
+    for (char c : frame)
+        key += (c == ';' || c == ' ') ? '_' : c;
+}
+
+} // anonymous namespace
+
+EventProfiler::EventProfiler(unsigned _period)
+    : period(_period), countdown(_period)
+{
+}
+
+std::string
+EventProfiler::key(const Event *event)
+{
+    std::string key;
+
+    // Events that don't override name() are named after their
+    // instance, those are only told apart by their description.
+    const std::string name = event->name();
+    if (name.compare(0, 6, "Event_") != 0) {
+        size_t begin = 0;
+        while (begin <= name.size()) {
+            size_t end = std::min(name.find('.', begin), name.size());
+            appendFrame(key, name.substr(begin, end - begin));
+            begin = end + 1;
+        }
+    }
+
+    appendFrame(key, event->description());
+    return key;
+}
+
+void
+EventProfiler::record(const std::string &key, Clock::duration elapsed)
+{
+    Entry &entry = profile[key];
+    entry.ns += period *
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    entry.count += period;
+}
+
+void
+setMainEventProfilePeriod(unsigned period)
+{
+    mainProfilePeriod = period;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->setProfiler(newMainEventProfiler());
+
+    if (period && !dumpRegistered) {
+        registerExitCallback(dumpMainEventProfile);
+        dumpRegistered = true;
+    }
+}
+
+EventProfiler *
+newMainEventProfiler()
+{
+    if (!mainProfilePeriod)
+        return nullptr;
+
+    mainProfilers.push_back(new EventProfiler(mainProfilePeriod));
+    return mainProfilers.back();
+}
+
+void
+dumpMainEventProfile()
+{
+    EventProfiler::Profile merged;
+    for (const auto *profiler : mainProfilers) {
+        for (const auto &it : profiler->getProfile()) {
+            EventProfiler::Entry &entry = merged[it.first];
+            entry.ns += it.second.ns;
+            entry.count += it.second.count;
+        }
+    }
+
+    std::vector<std::pair<std::string, EventProfiler::Entry>> sorted(
+        merged.begin(), merged.end());
+    std::sort(sorted.begin(), sorted.end(),
+              [](const std::pair<std::string, EventProfiler::Entry> &a,
+                 const std::pair<std::string, EventProfiler::Entry> &b) {
+                  return a.second.ns > b.second.ns;
+              });
+
+    OutputStream *folded = simout.create("eventprofile.folded");
+    for (const auto &it : sorted)
+        *folded->stream() << it.first << " " << it.second.ns << "\n";
+    simout.close(folded);
+
+    OutputStream *summary = simout.create("eventprofile.txt");
+    std::ostream &os = *summary->stream();
+    ccprintf(os, "%16s %14s %10s  %s\n", "host ns", "events", "ns/event",
+             "event");
+    for (const auto &it : sorted) {
+        const EventProfiler::Entry &entry = it.second;
+        ccprintf(os, "%16d %14d %10.1f  %s\n", entry.ns, entry.count,
+                 entry.count ? (double)entry.ns / entry.count : 0.0,
+                 it.first);
+    }
+    simout.close(summary);
+}
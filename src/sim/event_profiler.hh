@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_EVENT_PROFILER_HH__
+#define __SIM_EVENT_PROFILER_HH__
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+class Event;
+
+/**
+ * Sampling profiler charging host time to the events serviced by an
+ * event queue.
+ *
+ * One in every period serviced events is timed, and its host time
+ * and count are scaled by the period. Samples are grouped by the name
+ * of the event, which for most events starts with the name of the
+ * SimObject that owns it, and by its description.
+ *
+ * At exit, the profile of all main event queues is written to the
+ * output directory: eventprofile.folded uses the folded stack format
+ * of flame graph tools with one frame per component of the event name
+ * and host nanoseconds as the weight, eventprofile.txt lists the time
+ * and number of events of every group.
+ */
+class EventProfiler
+{
+  public:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Entry
+    {
+        /** Estimated host time in nanoseconds. */
+        uint64_t ns = 0;
+        /** Estimated number of events. */
+        uint64_t count = 0;
+    };
+
+    typedef std::unordered_map<std::string, Entry> Profile;
+
+  private:
+    const unsigned period;
+    unsigned countdown;
+    Profile profile;
+
+  public:
+    EventProfiler(unsigned _period);
+
+    /** Should the event about to be serviced be timed? */
+    bool
+    sample()
+    {
+        if (--countdown)
+            return false;
+        countdown = period;
+        return true;
+    }
+
+    /**
+     * Name under which samples of an event are recorded. This has to
+     * be computed before the event is processed since processing may
+     * free it.
+     */
+    static std::string key(const Event *event);
+
+    /** Record a sampled event. */
+    void record(const std::string &key, Clock::duration elapsed);
+
+    const Profile &getProfile() const { return profile; }
+};
+
+/**
+ * Profile all main event queues, timing one in every @p period
+ * events, and schedule the profile to be written out at exit. Queues
+ * created later are profiled as well. A period of 0 disables
+ * profiling.
+ */
+void setMainEventProfilePeriod(unsigned period);
+
+/**
+ * Create the profiler of a new main event queue, returns nullptr if
+ * profiling is disabled.
+ */
+EventProfiler *newMainEventProfiler();
+
+/** Write the merged profile of all main event queues. */
+void dumpMainEventProfile();
+
+#endif // __SIM_EVENT_PROFILER_HH__
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+namespace
+{
+
+/**
+ * An event which schedules itself again when it is processed, so that
+ * the queue keeps the same number of pending events.
+ */
+class BenchEvent : public Event
+{
+  private:
+    EventQueue &eq;
+    std::minstd_rand &rng;
+    const bool clocked;
+
+  public:
+    BenchEvent(EventQueue &_eq, std::minstd_rand &_rng, bool _clocked)
+        : eq(_eq), rng(_rng), clocked(_clocked)
+    {}
+
+    /**
+     * Delay of the next occurrence. Clocked events fall on the edges of
+     * a 500 tick clock in the next 16 cycles, so many of them share a
+     * tick like the events of clocked objects do.
+     */
+    Tick
+    delay()
+    {
+        return clocked ? 500 * (1 + rng() % 16) : 1 + rng() % 8000;
+    }
+
+    void process() override { eq.schedule(this, eq.getCurTick() + delay()); }
+};
+
+void
+ScheduleService(benchmark::State &state, EventQueueBackend backend,
+                bool clocked)
+{
+    EventQueue eq("bench", backend);
+    EventQueue *old_eq = curEventQueue();
+    curEventQueue(&eq);
+
+    std::minstd_rand rng(0);
+    std::vector<std::unique_ptr<BenchEvent>> events;
+    for (int i = 0; i < state.range(0); i++) {
+        events.emplace_back(new BenchEvent(eq, rng, clocked));
+        eq.schedule(events.back().get(), events.back()->delay());
+    }
+
+    // Each iteration services the earliest event, which schedules
+    // itself again.
+    for (auto _: state)
+        eq.serviceOne();
+
+    for (auto &event: events) {
+        if (event->scheduled())
+            eq.deschedule(event.get());
+    }
+    curEventQueue(old_eq);
+}
+
+} // anonymous namespace
+
+BENCHMARK_CAPTURE(ScheduleService, list_spread,
+                  EventQueueBackend::list, false)
+    ->RangeMultiplier(8)->Range(8, 32768);
+BENCHMARK_CAPTURE(ScheduleService, list_clocked,
+                  EventQueueBackend::list, true)
+    ->RangeMultiplier(8)->Range(8, 32768);
+BENCHMARK_CAPTURE(ScheduleService, calendar_spread,
+                  EventQueueBackend::calendar, false)
+    ->RangeMultiplier(8)->Range(8, 32768);
+BENCHMARK_CAPTURE(ScheduleService, calendar_clocked,
+                  EventQueueBackend::calendar, true)
+    ->RangeMultiplier(8)->Range(8, 32768);
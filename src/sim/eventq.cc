@@ -30,6 +30,7 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <mutex>
@@ -37,6 +38,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/smt.hh"
@@ -44,6 +46,7 @@
 #include "sim/core.hh"
 
 Tick simQuantum = 0;
+bool adaptiveSimQuantum = false;
 
 //
 // Main Event Queues
@@ -56,22 +59,54 @@ std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+__thread SlabAllocator *_eventAllocator = nullptr;
+
+static SlabAllocatorSet eventAllocators;
+
+SlabAllocator *
+newEventAllocator()
+{
+    return eventAllocators.create();
+}
+
+SlabAllocator::Stats
+eventAllocatorStats()
+{
+    return eventAllocators.stats();
+}
+
+static EventQueueBackend mainEventQueueBackend = EventQueueBackend::list;
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
     while (numMainEventQueues <= index) {
         numMainEventQueues++;
         mainEventQueue.push_back(
-            new EventQueue(csprintf("MainEventQueue-%d", index)));
+            new EventQueue(csprintf("MainEventQueue-%d", index),
+                           mainEventQueueBackend));
+        mainEventQueue.back()->setProfiler(newMainEventProfiler());
+        mainEventQueue.back()->setRecorder(newMainFlightRecorder());
     }
 
     return mainEventQueue[index];
 }
 
+void
+setMainEventQueueBackend(EventQueueBackend backend)
+{
+    mainEventQueueBackend = backend;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->setBackend(backend);
+}
+
 #ifndef NDEBUG
 Counter Event::instanceCounter = 0;
 #endif
 
+const size_t EventQueue::CalMinBuckets;
+const size_t EventQueue::CalWidthSamples;
+
 Event::~Event()
 {
     assert(!scheduled());
@@ -106,19 +141,17 @@ Event::insertBefore(Event *event, Event *curr)
     return event;
 }
 
-void
-EventQueue::insert(Event *event)
+Event *
+EventQueue::insertBin(Event *top, Event *event)
 {
     // Deal with the head case
-    if (!head || *event <= *head) {
-        head = Event::insertBefore(event, head);
-        return;
-    }
+    if (!top || *event <= *top)
+        return Event::insertBefore(event, top);
 
     // Figure out either which 'in bin' list we are on, or where a new list
     // needs to be inserted
-    Event *prev = head;
-    Event *curr = head->nextBin;
+    Event *prev = top;
+    Event *curr = top->nextBin;
     while (curr && *curr < *event) {
         prev = curr;
         curr = curr->nextBin;
@@ -127,6 +160,16 @@ EventQueue::insert(Event *event)
     // Note: this operation may render all nextBin pointers on the
     // prev 'in bin' list stale (except for the top one)
     prev->nextBin = Event::insertBefore(event, curr);
+    return top;
+}
+
+void
+EventQueue::insert(Event *event)
+{
+    if (backend == EventQueueBackend::calendar)
+        calInsert(event);
+    else
+        head = insertBin(head, event);
 }
 
 Event *
@@ -160,24 +203,20 @@ Event::removeItem(Event *event, Event *top)
     return top;
 }
 
-void
-EventQueue::remove(Event *event)
+Event *
+EventQueue::removeBin(Event *top, Event *event)
 {
-    if (head == NULL)
+    if (top == NULL)
         panic("event not found!");
 
-    assert(event->queue == this);
-
-    // deal with an event on the head's 'in bin' list (event has the same
-    // time as the head)
-    if (*head == *event) {
-        head = Event::removeItem(event, head);
-        return;
-    }
+    // deal with an event on the top's 'in bin' list (event has the same
+    // time as the top)
+    if (*top == *event)
+        return Event::removeItem(event, top);
 
     // Find the 'in bin' list that this event belongs on
-    Event *prev = head;
-    Event *curr = head->nextBin;
+    Event *prev = top;
+    Event *curr = top->nextBin;
     while (curr && *curr < *event) {
         prev = curr;
         curr = curr->nextBin;
@@ -190,17 +229,182 @@ EventQueue::remove(Event *event)
     // we remove an item, it returns the new top item (which may be
     // unchanged)
     prev->nextBin = Event::removeItem(event, curr);
+    return top;
+}
+
+void
+EventQueue::remove(Event *event)
+{
+    assert(event->queue == this);
+
+    if (backend == EventQueueBackend::calendar)
+        calRemove(event);
+    else
+        head = removeBin(head, event);
+}
+
+void
+EventQueue::calInsert(Event *event)
+{
+    const size_t bucket = calBucket(event->when());
+    calBuckets[bucket] = insertBin(calBuckets[bucket], event);
+
+    // An event in the same bin as the head is pushed on top of it, so
+    // it becomes the new head as well.
+    if (!head || *event <= *head)
+        head = event;
+
+    if (++calSize > 2 * calBuckets.size())
+        calResize(2 * calBuckets.size());
+}
+
+void
+EventQueue::calRemove(Event *event)
+{
+    const size_t bucket = calBucket(event->when());
+    calBuckets[bucket] = removeBin(calBuckets[bucket], event);
+    --calSize;
+
+    // Every remaining event is at least as late as the head, so the
+    // search for the new head can start at the old head's tick.
+    if (event == head)
+        head = calFindHead(event->when());
+
+    if (calSize < calBuckets.size() / 2 && calBuckets.size() > CalMinBuckets)
+        calResize(calBuckets.size() / 2);
 }
 
 Event *
-EventQueue::serviceOne()
+EventQueue::calFindHead(Tick from) const
+{
+    // Walk the buckets for one calendar "year", starting at the
+    // bucket that covers 'from'. The top of a bucket is the earliest
+    // event in it, so the first bucket whose top falls in the slot
+    // being scanned holds the earliest event in the queue.
+    const size_t num_buckets = calBuckets.size();
+    Tick slot = from >> calWidthShift;
+    for (size_t i = 0; i < num_buckets; ++i, ++slot) {
+        Event *top = calBuckets[slot & (num_buckets - 1)];
+        if (top && (top->when() >> calWidthShift) == slot)
+            return top;
+    }
+
+    // Nothing happens during the next year, fall back to a direct
+    // search of all buckets.
+    Event *min = nullptr;
+    for (auto *top : calBuckets) {
+        if (top && (!min || *top < *min))
+            min = top;
+    }
+    return min;
+}
+
+std::vector<Event *>
+EventQueue::calSortedBins() const
+{
+    std::vector<Event *> bins;
+    for (auto *top : calBuckets) {
+        for (Event *bin = top; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    }
+
+    // Bins have unique (when, priority) keys, so this is a total order.
+    std::sort(bins.begin(), bins.end(),
+              [](const Event *a, const Event *b) { return *a < *b; });
+    return bins;
+}
+
+void
+EventQueue::calRebuild(const std::vector<Event *> &bins, size_t num_buckets)
+{
+    assert(isPowerOf2(num_buckets));
+
+    // Estimate the bucket width from the separation of the earliest
+    // bins. Gaps much larger than the average (e.g., far-future exit
+    // events) are ignored, and the width is set to roughly three
+    // times the remaining average separation.
+    const size_t samples = std::min(bins.size(), CalWidthSamples);
+    if (samples > 1) {
+        const Tick avg = (bins[samples - 1]->when() - bins[0]->when()) /
+            (samples - 1);
+        Tick span = 0;
+        size_t gaps = 0;
+        for (size_t i = 1; i < samples; ++i) {
+            const Tick gap = bins[i]->when() - bins[i - 1]->when();
+            if (gap / 2 <= avg) {
+                span += gap;
+                ++gaps;
+            }
+        }
+
+        const Tick avg_gap = gaps ? span / gaps : 0;
+        if (avg_gap > 0)
+            calWidthShift = std::min(ceilLog2(avg_gap) + 2, 63);
+    }
+
+    calBuckets.assign(num_buckets, nullptr);
+    std::vector<Event *> tails(num_buckets, nullptr);
+    for (auto *bin : bins) {
+        const size_t bucket = calBucket(bin->when());
+        bin->nextBin = nullptr;
+        if (tails[bucket])
+            tails[bucket]->nextBin = bin;
+        else
+            calBuckets[bucket] = bin;
+        tails[bucket] = bin;
+    }
+
+    head = bins.empty() ? nullptr : bins.front();
+}
+
+void
+EventQueue::calResize(size_t num_buckets)
+{
+    calRebuild(calSortedBins(), num_buckets);
+}
+
+Event *
+EventQueue::calDrain()
+{
+    std::vector<Event *> bins = calSortedBins();
+    for (size_t i = 0; i < bins.size(); ++i)
+        bins[i]->nextBin = i + 1 < bins.size() ? bins[i + 1] : nullptr;
+
+    calRebuild(std::vector<Event *>(), CalMinBuckets);
+    calSize = 0;
+
+    return bins.empty() ? nullptr : bins.front();
+}
+
+void
+EventQueue::calFill(Event *list)
+{
+    std::vector<Event *> bins;
+    size_t size = 0;
+    for (Event *bin = list; bin; bin = bin->nextBin) {
+        bins.push_back(bin);
+        for (Event *event = bin; event; event = event->nextInBin)
+            ++size;
+    }
+
+    size_t num_buckets = CalMinBuckets;
+    while (size > 2 * num_buckets)
+        num_buckets *= 2;
+
+    calRebuild(bins, num_buckets);
+    calSize = size;
+}
+
+Event *
+EventQueue::popHead()
 {
-    std::lock_guard<EventQueue> lock(*this);
     Event *event = head;
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (backend == EventQueueBackend::calendar) {
+        calRemove(event);
+    } else if (next) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -212,13 +416,32 @@ EventQueue::serviceOne()
         head = head->nextBin;
     }
 
+    return event;
+}
+
+Event *
+EventQueue::processHead()
+{
+    Event *event = popHead();
+
     // handle action
     if (!event->squashed()) {
-        // forward current cycle to the time when this event occurs.
-        setCurTick(event->when());
         if (DTRACE(Event))
             event->trace("executed");
-        event->process();
+        ++_numServiced;
+        if (recorder) {
+            recorder->record(event->when(), event->priority(),
+                             event->description(),
+                             event->isManaged() ? nullptr : event);
+        }
+        if (profiler && profiler->sample()) {
+            const std::string key = EventProfiler::key(event);
+            const auto start = EventProfiler::Clock::now();
+            event->process();
+            profiler->record(key, EventProfiler::Clock::now() - start);
+        } else {
+            event->process();
+        }
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -233,6 +456,38 @@ EventQueue::serviceOne()
     return NULL;
 }
 
+Event *
+EventQueue::serviceOne()
+{
+    std::lock_guard<EventQueue> lock(*this);
+
+    // forward current cycle to the time when this event occurs.
+    if (!head->squashed())
+        setCurTick(head->when());
+
+    return processHead();
+}
+
+Event *
+EventQueue::serviceBin()
+{
+    std::lock_guard<EventQueue> lock(*this);
+
+    // Events scheduled for the same tick and priority by the events
+    // being serviced join the bin and are serviced in this call too.
+    const Tick when = head->when();
+    const Event::Priority priority = head->priority();
+    setCurTick(when);
+
+    do {
+        Event *exit_event = processHead();
+        if (exit_event)
+            return exit_event;
+    } while (head && head->when() == when && head->priority() == priority);
+
+    return NULL;
+}
+
 void
 Event::serialize(CheckpointOut &cp) const
 {
@@ -283,6 +538,20 @@ EventQueue::checkpointReschedule(Event *event)
     if (event->flags.isSet(Event::Scheduled))
         insert(event);
 }
+size_t
+EventQueue::numPending() const
+{
+    if (backend == EventQueueBackend::calendar)
+        return calSize;
+
+    size_t pending = 0;
+    for (Event *bin = head; bin; bin = bin->nextBin) {
+        for (Event *event = bin; event; event = event->nextInBin)
+            ++pending;
+    }
+    return pending;
+}
+
 void
 EventQueue::dump() const
 {
@@ -293,15 +562,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
-            Event *nextInBin = nextBin;
+        for (auto *bin : sortedBins()) {
+            Event *nextInBin = bin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -316,8 +582,33 @@ EventQueue::debugVerify() const
     Tick time = 0;
     short priority = 0;
 
-    Event *nextBin = head;
-    while (nextBin) {
+    if (backend == EventQueueBackend::calendar) {
+        size_t size = 0;
+        for (size_t i = 0; i < calBuckets.size(); ++i) {
+            for (Event *bin = calBuckets[i]; bin; bin = bin->nextBin) {
+                if (calBucket(bin->when()) != i) {
+                    cprintf("bin in the wrong calendar bucket!");
+                    bin->dump();
+                    return false;
+                }
+                for (Event *event = bin; event; event = event->nextInBin)
+                    ++size;
+            }
+        }
+
+        if (size != calSize) {
+            cprintf("calendar size mismatch!");
+            return false;
+        }
+
+        if (head != calFindHead(head ? head->when() : 0)) {
+            cprintf("head is not the earliest event!");
+            head->dump();
+            return false;
+        }
+    }
+
+    for (auto *nextBin : sortedBins()) {
         Event *nextInBin = nextBin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
@@ -343,21 +634,50 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
 }
 
+std::vector<Event *>
+EventQueue::sortedBins() const
+{
+    if (backend == EventQueueBackend::calendar)
+        return calSortedBins();
+
+    std::vector<Event *> bins;
+    for (Event *bin = head; bin; bin = bin->nextBin)
+        bins.push_back(bin);
+    return bins;
+}
+
 Event*
 EventQueue::replaceHead(Event* s)
 {
+    if (backend == EventQueueBackend::calendar) {
+        // Hand the pending events out as a single sorted list of bins,
+        // just like the list backend does.
+        Event *t = calDrain();
+        calFill(s);
+        return t;
+    }
+
     Event* t = head;
     head = s;
     return t;
 }
 
+void
+EventQueue::setBackend(EventQueueBackend new_backend)
+{
+    if (new_backend == backend)
+        return;
+
+    Event *bins = replaceHead(nullptr);
+    backend = new_backend;
+    replaceHead(bins);
+}
+
 void
 dumpMainQueue()
 {
@@ -417,29 +737,47 @@ Event::dump() const
     }
 }
 
-EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+EventQueue::EventQueue(const std::string &n, EventQueueBackend _backend)
+    : objName(n), head(NULL), _curTick(0), backend(_backend), lookahead(0),
+      profiler(nullptr), recorder(nullptr), _numServiced(0),
+      calBuckets(CalMinBuckets, nullptr), calWidthShift(10), calSize(0),
+      async_queue(nullptr)
 {
 }
 
 void
 EventQueue::asyncInsert(Event *event)
 {
-    async_queue_mutex.lock();
-    async_queue.push_back(event);
-    async_queue_mutex.unlock();
+    Event *top = async_queue.load(std::memory_order_relaxed);
+    do {
+        event->nextBin = top;
+    } while (!async_queue.compare_exchange_weak(top, event,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
 }
 
 void
 EventQueue::handleAsyncInsertions()
 {
     assert(this == curEventQueue());
-    async_queue_mutex.lock();
 
-    while (!async_queue.empty()) {
-        insert(async_queue.front());
-        async_queue.pop_front();
+    // Take all pending events at once. The consumer never pops single
+    // items, so the stack doesn't suffer from the ABA problem.
+    Event *event = async_queue.exchange(nullptr, std::memory_order_acquire);
+
+    // The stack holds the events in reverse order, flip it so events
+    // are inserted in the order they were scheduled.
+    Event *pending = nullptr;
+    while (event) {
+        Event *next = event->nextBin;
+        event->nextBin = pending;
+        pending = event;
+        event = next;
     }
 
-    async_queue_mutex.unlock();
+    while (pending) {
+        Event *next = pending->nextBin;
+        insert(pending);
+        pending = next;
+    }
 }
@@ -36,6 +36,7 @@
 #define __SIM_EVENTQ_HH__
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <functional>
@@ -43,13 +44,18 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
+#include "base/slab_allocator.hh"
 #include "base/types.hh"
 #include "base/uncontended_mutex.hh"
 #include "debug/Event.hh"
+#include "enums/EventQueueBackend.hh"
 #include "sim/core.hh"
+#include "sim/event_profiler.hh"
+#include "sim/flight_recorder.hh"
 #include "sim/serialize.hh"
 
 class EventQueue;       // forward declaration
@@ -62,6 +68,13 @@ class BaseGlobalEvent;
 //! Queue B should be at least simQuantum ticks away in future.
 extern Tick simQuantum;
 
+//! Let the distance between two quantum barriers adapt to the
+//! simulation. At every barrier, the next one is placed at the
+//! earliest tick at which any queue could send an event to another
+//! queue (its next event plus its lookahead), which lets idle phases
+//! pass in a single quantum.
+extern bool adaptiveSimQuantum;
+
 //! Current number of allocated main event queues.
 extern uint32_t numMainEventQueues;
 
@@ -82,9 +95,32 @@ extern bool inParallelMode;
 //! is with in bounds.
 EventQueue *getEventQueue(uint32_t index);
 
+//! Select the storage backend used by all main event queues. Existing
+//! queues are converted in place and queues allocated later by
+//! getEventQueue() use the new backend.
+void setMainEventQueueBackend(EventQueueBackend backend);
+
 inline EventQueue *curEventQueue() { return _curEventQueue; }
 inline void curEventQueue(EventQueue *q);
 
+//! Per-thread allocator that events are allocated from. Use
+//! eventAllocator() to access it.
+extern __thread SlabAllocator *_eventAllocator;
+
+//! Allocate the event allocator of the running thread.
+SlabAllocator *newEventAllocator();
+
+inline SlabAllocator &
+eventAllocator()
+{
+    if (!_eventAllocator)
+        _eventAllocator = newEventAllocator();
+    return *_eventAllocator;
+}
+
+//! Event allocation statistics summed over all threads.
+SlabAllocator::Stats eventAllocatorStats();
+
 /**
  * Common base class for Event and GlobalEvent, so they can share flag
  * and priority definitions and accessor functions.  This class should
@@ -439,6 +475,30 @@ class Event : public EventBase, public Serializable
     void dump() const;
     /** @}*/ //end of api group
 
+    /**
+     * @{
+     * Events are allocated from a per-thread slab allocator. Many
+     * events, AutoDelete events in particular, are allocated and
+     * freed in the inner simulation loop and would otherwise spend a
+     * sizable part of their life in malloc.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        return eventAllocator().allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        eventAllocator().deallocate(p, size);
+    }
+
+    // The class specific operator new hides the placement forms.
+    static void *operator new(size_t size, void *p) { return p; }
+    static void operator delete(void *p, void *place) {}
+    /** @} */
+
   public:
     /*
      * This member function is invoked when the event is processed
@@ -615,6 +675,14 @@ operator!=(const Event &l, const Event &r)
  * events must happen at least one simulation quantum into the future,
  * otherwise they risk being scheduled in the past by
  * handleAsyncInsertions().
+ *
+ * Pending events are kept in one of two storage backends. The list
+ * backend keeps all bins in a single sorted list, which makes
+ * insertion linear in the number of pending bins. The calendar
+ * backend hashes bins into buckets by time (a calendar queue), each
+ * bucket holding a short sorted list of bins, which makes insertion
+ * and removal amortized constant time for large queues. Both backends
+ * service events in exactly the same order.
  */
 class EventQueue
 {
@@ -625,11 +693,50 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
-    //! Mutex to protect async queue.
-    UncontendedMutex async_queue_mutex;
+    //! Storage backend used for the pending events.
+    EventQueueBackend backend;
+
+    //! Minimum latency of the events this queue schedules on other
+    //! queues, 0 if it is simQuantum.
+    Tick lookahead;
+
+    //! Host time profiler of the serviced events, if enabled.
+    EventProfiler *profiler;
+
+    //! Ring of the most recently serviced events, if enabled.
+    FlightRecorder *recorder;
+
+    //! Number of events processed since the queue was created.
+    uint64_t _numServiced;
 
-    //! List of events added by other threads to this event queue.
-    std::list<Event*> async_queue;
+    /**
+     * Calendar queue state, only used by the calendar backend. Every
+     * bucket holds a sorted list (linked through nextBin) of the bins
+     * whose tick maps to it. The head pointer always refers to the
+     * earliest bin, so the rest of the event queue code does not need
+     * to know which backend is in use.
+     */
+    std::vector<Event *> calBuckets;
+    //! log2 of the number of ticks covered by a calendar bucket.
+    unsigned calWidthShift;
+    //! Number of events stored in the calendar.
+    size_t calSize;
+
+    //! Smallest number of buckets used by the calendar.
+    static const size_t CalMinBuckets = 16;
+    //! Number of bins sampled to estimate the bucket width.
+    static const size_t CalWidthSamples = 32;
+
+    /**
+     * Events added by other threads to this event queue.
+     *
+     * This is a lock-free, multiple producer single consumer stack
+     * linked through Event::nextBin, which is unused until the event
+     * is inserted in the queue. Producers push with a CAS and the
+     * owning thread takes the whole stack at once, so scheduling
+     * across queues never blocks and never allocates.
+     */
+    std::atomic<Event *> async_queue;
 
     /**
      * Lock protecting event handling.
@@ -658,6 +765,43 @@ class EventQueue
     void insert(Event *event);
     void remove(Event *event);
 
+    //! Remove the head event from the queue and return it. The caller
+    //! must hold the queue lock.
+    Event *popHead();
+
+    //! Pop and process the head event without updating the current
+    //! tick. Returns the event if it is an exit event. The caller must
+    //! hold the queue lock.
+    Event *processHead();
+
+    //! Insert / remove an event in a sorted list of bins starting at
+    //! top. Returns the new top of the list.
+    static Event *insertBin(Event *top, Event *event);
+    static Event *removeBin(Event *top, Event *event);
+
+    /**
+     * @{
+     * Calendar backend helpers.
+     */
+    size_t
+    calBucket(Tick when) const
+    {
+        return (when >> calWidthShift) & (calBuckets.size() - 1);
+    }
+
+    void calInsert(Event *event);
+    void calRemove(Event *event);
+    Event *calFindHead(Tick from) const;
+    std::vector<Event *> calSortedBins() const;
+    void calRebuild(const std::vector<Event *> &bins, size_t num_buckets);
+    void calResize(size_t num_buckets);
+    Event *calDrain();
+    void calFill(Event *bins);
+    /** @} */
+
+    //! Return the tops of all bins in service order.
+    std::vector<Event *> sortedBins() const;
+
     //! Function for adding events to the async queue. The added events
     //! are added to main event queue later. Threads, other than the
     //! owning thread, should call this function instead of insert().
@@ -742,7 +886,8 @@ class EventQueue
     /**
      * @ingroup api_eventq
      */
-    EventQueue(const std::string &n);
+    EventQueue(const std::string &n,
+               EventQueueBackend _backend=EventQueueBackend::list);
 
     /**
      * @ingroup api_eventq
@@ -854,8 +999,50 @@ class EventQueue
     Tick getCurTick() const { return _curTick; }
     Event *getHead() const { return head; }
 
+    /**
+     * Minimum latency of the events scheduled by this queue on other
+     * queues. This is used to place the next quantum barrier when the
+     * quantum is adaptive, and defaults to simQuantum.
+     */
+    Tick getLookahead() const { return lookahead ? lookahead : simQuantum; }
+    void setLookahead(Tick newVal) { lookahead = newVal; }
+
+    /**
+     * Profile the host time spent servicing events. The profiler is
+     * not owned by the queue; nullptr disables profiling.
+     */
+    void setProfiler(EventProfiler *p) { profiler = p; }
+    EventProfiler *getProfiler() const { return profiler; }
+
+    /**
+     * Record the serviced events in a flight recorder. The recorder is
+     * not owned by the queue; nullptr disables recording.
+     */
+    void setRecorder(FlightRecorder *r) { recorder = r; }
+    FlightRecorder *getRecorder() const { return recorder; }
+
+    /** Number of (non-squashed) events processed by this queue. */
+    uint64_t numServiced() const { return _numServiced; }
+
+    /**
+     * Number of events scheduled in this queue. This walks the list
+     * backend, so it is meant for reporting rather than simulation.
+     */
+    size_t numPending() const;
+
     Event *serviceOne();
 
+    /**
+     * Service the events of the head bin, i.e. all the events
+     * scheduled for the earliest tick with the same priority, in a
+     * single call. The queue lock is taken and the current tick is
+     * updated once for the whole bin. Servicing stops early if an
+     * exit event is processed.
+     *
+     * @return The exit event that was processed, if any.
+     */
+    Event *serviceBin();
+
     /**
      * process all events up to the given timestamp.  we inline a quick test
      * to see if there are any events to process; if so, call the internal
@@ -936,6 +1123,13 @@ class EventQueue
      */
     Event* replaceHead(Event* s);
 
+    /**
+     * Switch the storage backend of this queue. Pending events are
+     * moved to the new backend and keep their relative order.
+     */
+    void setBackend(EventQueueBackend new_backend);
+    EventQueueBackend getBackend() const { return backend; }
+
     /**@{*/
     /**
      * Provide an interface for locking/unlocking the event queue.
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/flight_recorder.hh"
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_set>
+
+#include "base/cprintf.hh"
+#include "base/debug.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/trace.hh"
+#include "sim/core.hh"
+#include "sim/eventq.hh"
+
+namespace
+{
+
+size_t mainNumEvents = 0;
+size_t mainNumMessages = 0;
+bool hookRegistered = false;
+std::vector<FlightRecorder *> mainRecorders;
+
+size_t
+ringSize(size_t n)
+{
+    return n ? (size_t)1 << ceilLog2(n) : 1;
+}
+
+/**
+ * Debug logger that diverts the messages of some flags to the flight
+ * recorder of the current event queue and passes everything else on.
+ */
+class RecordingLogger : public Trace::Logger
+{
+  private:
+    Trace::Logger *next;
+    std::unordered_set<std::string> flags;
+
+    static FlightRecorder *
+    recorder()
+    {
+        EventQueue *eq = curEventQueue();
+        if (!eq && numMainEventQueues)
+            eq = mainEventQueue[0];
+        return eq ? eq->getRecorder() : nullptr;
+    }
+
+  public:
+    RecordingLogger(Trace::Logger *_next,
+                    const std::unordered_set<std::string> &_flags)
+        : next(_next), flags(_flags)
+    {
+        deferFormatting = true;
+    }
+
+    void
+    logArgs(Tick when, const std::string &name, const std::string &flag,
+            const char *fmt, const Trace::EncodedArgs &args) override
+    {
+        if (flags.count(flag)) {
+            if (FlightRecorder *r = recorder())
+                r->record(when, name, flag, fmt, args);
+        } else if (next->defersFormatting()) {
+            next->logArgs(when, name, flag, fmt, args);
+        } else {
+            std::ostringstream line;
+            args.format(line, fmt);
+            next->logMessage(when, name, flag, line.str());
+        }
+    }
+
+    void
+    logMessage(Tick when, const std::string &name, const std::string &flag,
+               const std::string &message) override
+    {
+        if (flags.count(flag)) {
+            if (FlightRecorder *r = recorder())
+                r->record(when, name, flag, message);
+        } else {
+            next->logMessage(when, name, flag, message);
+        }
+    }
+
+    std::ostream &getOstream() override { return next->getOstream(); }
+};
+
+void
+dumpOnExit()
+{
+    dumpMainFlightRecorders("panic or fatal error", true);
+}
+
+} // anonymous namespace
+
+FlightRecorder::FlightRecorder(size_t num_events, size_t num_messages)
+    : eventMask(ringSize(num_events) - 1),
+      messageMask(ringSize(num_messages) - 1),
+      events(eventMask + 1), messages(messageMask + 1)
+{
+}
+
+const std::string *
+FlightRecorder::intern(const std::string &str)
+{
+    return &*strings.insert(str).first;
+}
+
+FlightRecorder::MessageRecord &
+FlightRecorder::nextMessage(Tick when, const std::string &name,
+                            const std::string &flag)
+{
+    MessageRecord &rec = messages[numMessages++ & messageMask];
+    rec.when = when;
+    rec.name = intern(name);
+    rec.flag = intern(flag);
+    return rec;
+}
+
+void
+FlightRecorder::record(Tick when, const std::string &name,
+                       const std::string &flag, const char *fmt,
+                       const Trace::EncodedArgs &args)
+{
+    MessageRecord &rec = nextMessage(when, name, flag);
+    rec.fmt = fmt;
+    rec.args = args;
+    rec.text.clear();
+}
+
+void
+FlightRecorder::record(Tick when, const std::string &name,
+                       const std::string &flag, const std::string &text)
+{
+    MessageRecord &rec = nextMessage(when, name, flag);
+    rec.fmt = nullptr;
+    rec.args.clear();
+    rec.text = text;
+}
+
+void
+FlightRecorder::dump(std::ostream &os) const
+{
+    const uint64_t num_events = std::min<uint64_t>(numEvents, events.size());
+    ccprintf(os, "Last %d of %d serviced events:\n", num_events, numEvents);
+    ccprintf(os, "%20s %5s  %s\n", "tick", "prio", "event");
+    for (uint64_t i = numEvents - num_events; i < numEvents; ++i) {
+        const EventRecord &rec = events[i & eventMask];
+        ccprintf(os, "%20d %5d  %s", rec.when, rec.priority,
+                 rec.description);
+        if (rec.event)
+            ccprintf(os, "  %s", rec.event->name());
+        os << "\n";
+    }
+
+    if (!numMessages)
+        return;
+
+    const uint64_t num_messages =
+        std::min<uint64_t>(numMessages, messages.size());
+    ccprintf(os, "\nLast %d of %d recorded debug messages:\n", num_messages,
+             numMessages);
+    for (uint64_t i = numMessages - num_messages; i < numMessages; ++i) {
+        const MessageRecord &rec = messages[i & messageMask];
+        if (rec.when != MaxTick)
+            ccprintf(os, "%7d: ", rec.when);
+        os << *rec.flag << ": ";
+        if (!rec.name->empty())
+            os << *rec.name << ": ";
+        if (rec.fmt)
+            rec.args.format(os, rec.fmt);
+        else
+            os << rec.text;
+    }
+}
+
+void
+setMainFlightRecorder(size_t num_events, size_t num_messages,
+                      const std::vector<std::string> &flags)
+{
+    mainNumEvents = num_events;
+    mainNumMessages = num_messages;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->setRecorder(newMainFlightRecorder());
+
+    if (!num_events)
+        return;
+
+    if (!hookRegistered) {
+        Logger::addExitHook(dumpOnExit);
+        hookRegistered = true;
+    }
+
+    if (flags.empty() || !num_messages)
+        return;
+
+    // Messages are logged with the names of simple flags
+    std::unordered_set<std::string> names;
+    for (const auto &flag_name : flags) {
+        Debug::Flag *flag = Debug::findFlag(flag_name);
+        fatal_if(!flag, "Unknown debug flag '%s' for the flight recorder.",
+                 flag_name);
+        flag->enable();
+
+        auto *compound = dynamic_cast<Debug::CompoundFlag *>(flag);
+        if (compound) {
+            for (auto *kid : compound->kids())
+                names.insert(kid->name());
+        } else {
+            names.insert(flag->name());
+        }
+    }
+
+    Trace::setDebugLogger(
+        new RecordingLogger(Trace::getDebugLogger(), names));
+}
+
+FlightRecorder *
+newMainFlightRecorder()
+{
+    if (!mainNumEvents)
+        return nullptr;
+
+    mainRecorders.push_back(
+        new FlightRecorder(mainNumEvents, mainNumMessages));
+    return mainRecorders.back();
+}
+
+void
+dumpMainFlightRecorders(const std::string &reason, bool crash)
+{
+    // A crash while dumping must not dump again
+    static bool dumping = false;
+    static bool crashed = false;
+    if (dumping || crashed || mainRecorders.empty())
+        return;
+    dumping = true;
+    crashed = crash;
+
+    OutputStream *out = simout.create("flight_recorder.txt");
+    std::ostream &os = *out->stream();
+    ccprintf(os, "Flight recorder dump at tick %d: %s\n", curTick(), reason);
+    for (size_t i = 0; i < mainRecorders.size(); ++i) {
+        ccprintf(os, "\n=== Event queue %d ===\n", i);
+        mainRecorders[i]->dump(os);
+        os.flush();
+    }
+    simout.close(out);
+
+    dumping = false;
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_FLIGHT_RECORDER_HH__
+#define __SIM_FLIGHT_RECORDER_HH__
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "base/trace_args.hh"
+#include "base/types.hh"
+
+class Event;
+
+/**
+ * Ring buffers of the most recent events serviced by an event queue and
+ * of the most recent debug messages logged by its thread.
+ *
+ * Recording an event only stores its tick, priority, description and,
+ * unless it is managed (and may be deleted once serviced), a pointer to
+ * it. The name of the event is only looked up when the rings are dumped.
+ * Debug messages are recorded for the flags selected with
+ * setMainFlightRecorder, with their arguments encoded, and are only
+ * formatted when the rings are dumped.
+ *
+ * The rings of all main event queues are dumped to flight_recorder.txt
+ * in the output directory on panic, fatal, a crash, and when the
+ * simulator receives SIGQUIT.
+ */
+class FlightRecorder
+{
+  public:
+    struct EventRecord
+    {
+        Tick when = 0;
+        int priority = 0;
+        const char *description = nullptr;
+        /** The event, nullptr if it may not outlive being serviced. */
+        const Event *event = nullptr;
+    };
+
+    struct MessageRecord
+    {
+        Tick when = 0;
+        const std::string *name = nullptr;
+        const std::string *flag = nullptr;
+        /** Format of the message, nullptr if it was logged as text. */
+        const char *fmt = nullptr;
+        Trace::EncodedArgs args;
+        std::string text;
+    };
+
+  private:
+    /** The rings are sized to powers of two, indexed with these masks. */
+    const size_t eventMask;
+    const size_t messageMask;
+
+    std::vector<EventRecord> events;
+    std::vector<MessageRecord> messages;
+    uint64_t numEvents = 0;
+    uint64_t numMessages = 0;
+
+    /** Names and flags of the recorded messages. */
+    std::unordered_set<std::string> strings;
+
+    const std::string *intern(const std::string &str);
+    MessageRecord &nextMessage(Tick when, const std::string &name,
+                               const std::string &flag);
+
+  public:
+    FlightRecorder(size_t num_events, size_t num_messages);
+
+    /** Record an event that is about to be serviced. */
+    void
+    record(Tick when, int priority, const char *description,
+           const Event *event)
+    {
+        EventRecord &rec = events[numEvents++ & eventMask];
+        rec.when = when;
+        rec.priority = priority;
+        rec.description = description;
+        rec.event = event;
+    }
+
+    /** Record a debug message. */
+    void record(Tick when, const std::string &name, const std::string &flag,
+                const char *fmt, const Trace::EncodedArgs &args);
+
+    /** Record a debug message that has already been formatted. */
+    void record(Tick when, const std::string &name, const std::string &flag,
+                const std::string &text);
+
+    /** Write the recorded events and messages, oldest first. */
+    void dump(std::ostream &os) const;
+};
+
+/**
+ * Create a flight recorder for every main event queue, including queues
+ * created later, keeping the last @p num_events events and the last @p
+ * num_messages debug messages of the given flags. Messages of these
+ * flags only go to the recorder, not to the debug output. The
+ * recorders are disabled if @p num_events is 0.
+ */
+void setMainFlightRecorder(size_t num_events, size_t num_messages,
+                           const std::vector<std::string> &flags);
+
+/**
+ * Create the recorder of a new main event queue, returns nullptr if
+ * recording is disabled.
+ */
+FlightRecorder *newMainFlightRecorder();
+
+/**
+ * Write the recorders of all main event queues to the output directory.
+ * Only the first dump of a @p crash is written, so that, e.g., the abort
+ * following a panic does not replace the dump made for the panic.
+ */
+void dumpMainFlightRecorders(const std::string &reason, bool crash=false);
+
+#endif // __SIM_FLIGHT_RECORDER_HH__
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_GBENCH_CLOCKED_OBJECT_FAKE_HH__
+#define __SIM_GBENCH_CLOCKED_OBJECT_FAKE_HH__
+
+#include <string>
+
+#include "params/ClockedObject.hh"
+#include "params/PowerState.hh"
+#include "params/SrcClockDomain.hh"
+#include "params/VoltageDomain.hh"
+#include "sim/clock_domain.hh"
+#include "sim/eventq.hh"
+#include "sim/power_state.hh"
+#include "sim/voltage_domain.hh"
+
+namespace GBench
+{
+
+/**
+ * Make the first main event queue current, so that curTick() and the
+ * objects created by a microbenchmark have a queue to work with.
+ */
+inline EventQueue *
+setupEventQueue()
+{
+    EventQueue *eq = getEventQueue(0);
+    curEventQueue(eq);
+    return eq;
+}
+
+/** A 1GHz clock domain shared by the objects of a microbenchmark. */
+inline SrcClockDomain *
+clockDomain()
+{
+    static SrcClockDomain *domain = []() {
+        // SimObjects keep a reference to their parameters.
+        auto *vp = new VoltageDomainParams();
+        vp->name = "bench.voltage_domain";
+        vp->eventq_index = 0;
+        vp->voltage = { 1.0 };
+
+        auto *cp = new SrcClockDomainParams();
+        cp->name = "bench.clk_domain";
+        cp->eventq_index = 0;
+        cp->clock = { 1000 };
+        cp->voltage_domain = vp->create();
+        cp->domain_id = -1;
+        cp->init_perf_level = 0;
+        return cp->create();
+    }();
+    return domain;
+}
+
+/**
+ * Fill in the parameters every ClockedObject needs, so that a
+ * microbenchmark can create objects which are normally built from
+ * Python. The params must outlive the object.
+ */
+inline void
+clockedParams(ClockedObjectParams &p, const std::string &name)
+{
+    setupEventQueue();
+
+    auto *pp = new PowerStateParams();
+    pp->name = name + ".power_state";
+    pp->eventq_index = 0;
+    pp->default_state = Enums::UNDEFINED;
+    pp->clk_gate_min = 1000;
+    pp->clk_gate_max = 1000000000000;
+    pp->clk_gate_bins = 20;
+
+    p.name = name;
+    p.eventq_index = 0;
+    p.clk_domain = clockDomain();
+    p.power_state = pp->create();
+}
+
+} // namespace GBench
+
+#endif // __SIM_GBENCH_CLOCKED_OBJECT_FAKE_HH__
@@ -140,6 +140,22 @@ GlobalEvent::BarrierEvent::process()
 void
 GlobalSyncEvent::BarrierEvent::process()
 {
+    GlobalSyncEvent *sync = static_cast<GlobalSyncEvent *>(_globalEvent);
+    EventQueue *eq = curEventQueue();
+
+    if (sync->adaptive) {
+        // Once all queues have arrived, nobody schedules events on
+        // other queues until the next sync is placed, so it is safe to
+        // merge the async events and look at the head of the queue.
+        globalBarrier();
+        eq->handleAsyncInsertions();
+
+        const Tick next = eq->empty() ? MaxTick : eq->nextTick();
+        const Tick lookahead = eq->getLookahead();
+        sync->publish(next > MaxTick - lookahead ? MaxTick :
+                      next + lookahead);
+    }
+
     // wait for all queues to arrive at barrier, then process event
     if (globalBarrier()) {
         _globalEvent->process();
@@ -148,13 +164,25 @@ GlobalSyncEvent::BarrierEvent::process()
     // second barrier to force all queues to wait for event processing
     // to finish before continuing
     globalBarrier();
-    curEventQueue()->handleAsyncInsertions();
+    eq->handleAsyncInsertions();
+}
+
+void
+GlobalSyncEvent::publish(Tick when)
+{
+    Tick cur = nextSync.load();
+    while (when < cur && !nextSync.compare_exchange_weak(cur, when))
+        ;
 }
 
 void
 GlobalSyncEvent::process()
 {
-    if (repeat) {
+    if (adaptive) {
+        const Tick when = nextSync.exchange(MaxTick);
+        assert(when > curTick());
+        schedule(when);
+    } else if (repeat) {
         schedule(curTick() + repeat);
     }
 }
@@ -30,6 +30,7 @@
 #ifndef __SIM_GLOBAL_EVENT_HH__
 #define __SIM_GLOBAL_EVENT_HH__
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 
@@ -201,6 +202,13 @@ class GlobalEvent : public BaseGlobalEventTemplate<GlobalEvent>
  * A special global event that synchronizes all threads and forces
  * them to process asynchronously enqueued events.  Useful for
  * separating quanta in a quantum-based parallel simulation.
+ *
+ * An adaptive sync event doesn't repeat at a fixed interval. Instead,
+ * every queue publishes the earliest tick at which it could schedule
+ * an event on another queue (its next event plus its lookahead) and
+ * the next sync is placed at the earliest of them. No event crosses
+ * queues before that tick, so the window is safe, and phases where
+ * all queues are idle are skipped in a single step.
  */
 class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
 {
@@ -217,11 +225,13 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
     };
 
     GlobalSyncEvent(Priority p, Flags f)
-        : Base(p, f), repeat(0)
+        : Base(p, f), repeat(0), adaptive(false), nextSync(MaxTick)
     { }
 
-    GlobalSyncEvent(Tick when, Tick _repeat, Priority p, Flags f)
-        : Base(p, f), repeat(_repeat)
+    GlobalSyncEvent(Tick when, Tick _repeat, Priority p, Flags f,
+                    bool _adaptive=false)
+        : Base(p, f), repeat(_repeat), adaptive(_adaptive),
+          nextSync(MaxTick)
     {
         schedule(when);
     }
@@ -231,6 +241,17 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
     const char *description() const;
 
     Tick repeat;
+
+    //! Place the next sync using the lookahead of the queues rather
+    //! than the repeat interval.
+    bool adaptive;
+
+  private:
+    //! Earliest tick any queue could send an event to another queue.
+    std::atomic<Tick> nextSync;
+
+    //! Lower nextSync to the given tick.
+    void publish(Tick when);
 };
 
 
@@ -60,6 +60,7 @@
 #include "sim/backtrace.hh"
 #include "sim/core.hh"
 #include "sim/eventq.hh"
+#include "sim/flight_recorder.hh"
 
 // Use an separate stack for fatal signal handlers
 static uint8_t fatalSigStack[2 * SIGSTKSZ];
@@ -128,6 +129,16 @@ dumprstStatsHandler(int sigtype)
     getEventQueue(0)->wakeup();
 }
 
+/// Flight recorder dump signal handler.
+static void
+dumpFlightRecorderHandler(int sigtype)
+{
+    async_event = true;
+    async_flightdump = true;
+    /* Wake up some event queue to handle event */
+    getEventQueue(0)->wakeup();
+}
+
 /// Exit signal handler.
 void
 exitNowHandler(int sigtype)
@@ -151,6 +162,7 @@ abortHandler(int sigtype)
     }
 
     print_backtrace();
+    dumpMainFlightRecorders("aborted", true);
     raiseFatalSignal(sigtype);
 }
 
@@ -161,6 +173,7 @@ segvHandler(int sigtype)
     STATIC_ERR("gem5 has encountered a segmentation fault!\n\n");
 
     print_backtrace();
+    dumpMainFlightRecorders("segmentation fault", true);
     raiseFatalSignal(SIGSEGV);
 }
 
@@ -191,6 +204,9 @@ initSignals()
     // Dump intermediate stats and reset them
     installSignalHandler(SIGUSR2, dumprstStatsHandler);
 
+    // Dump the flight recorder
+    installSignalHandler(SIGQUIT, dumpFlightRecorderHandler);
+
     // Exit cleanly on Interrupt (Ctrl-C)
     installSignalHandler(SIGINT, exitNowHandler);
 
@@ -37,6 +37,8 @@
 
 #include "sim/linear_solver.hh"
 
+#include <cmath>
+
 std::vector <double>
 LinearSystem::solve() const
 {
@@ -83,3 +85,75 @@ LinearSystem::solve() const
 
     return ret;
 }
+
+void
+SparseLinearSystem::addCoefficient(unsigned eq, unsigned unkw, double value)
+{
+    assert(eq < rows.size() && unkw < rows.size());
+
+    Row &row = rows[eq];
+    if (eq == unkw) {
+        row.diag += value;
+        return;
+    }
+
+    for (auto &coeff: row.coeffs) {
+        if (coeff.unkw == unkw) {
+            coeff.value += value;
+            return;
+        }
+    }
+    row.coeffs.push_back({unkw, value});
+}
+
+bool
+SparseLinearSystem::solve(std::vector<double> &x, double tolerance,
+                          unsigned max_iters) const
+{
+    x.resize(rows.size(), 0.0);
+
+    for (unsigned iter = 0; iter < max_iters; iter++) {
+        double max_delta = 0;
+        for (unsigned i = 0; i < rows.size(); i++) {
+            const Row &row = rows[i];
+            double sum = constants[i];
+            for (auto &coeff: row.coeffs)
+                sum += coeff.value * x[coeff.unkw];
+
+            const double xi = -sum / row.diag;
+            max_delta = std::max(max_delta, std::abs(xi - x[i]));
+            x[i] = xi;
+        }
+
+        if (max_delta <= tolerance)
+            return true;
+    }
+
+    return false;
+}
+
+std::vector<double>
+SparseLinearSystem::solveDense() const
+{
+    LinearSystem ls(rows.size());
+    for (unsigned i = 0; i < rows.size(); i++) {
+        ls[i][i] = rows[i].diag;
+        for (auto &coeff: rows[i].coeffs)
+            ls[i][coeff.unkw] = coeff.value;
+        ls[i][ls[i].cnt()] = constants[i];
+    }
+    return ls.solve();
+}
+
+std::string
+SparseLinearSystem::toStr() const
+{
+    std::ostringstream oss;
+    for (unsigned i = 0; i < rows.size(); i++) {
+        oss << rows[i].diag << "*x" << i;
+        for (auto &coeff: rows[i].coeffs)
+            oss << " + " << coeff.value << "*x" << coeff.unkw;
+        oss << " + " << constants[i] << " = 0\n";
+    }
+    return oss.str();
+}
@@ -38,6 +38,7 @@
 #ifndef __SIM_LINEAR_SOLVER_HH__
 #define __SIM_LINEAR_SOLVER_HH__
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <string>
@@ -129,4 +130,67 @@ class LinearSystem {
     std::vector < LinearEquation > matrix;
 };
 
+/**
+ * A linear system whose coefficients are fixed once it is built and
+ * whose constant terms may change between solves, stored as sparse
+ * rows. Equation i reads sum_j(a_ij * x_j) + c_i = 0, like
+ * LinearEquation. It is solved iteratively, starting from the previous
+ * solution, which converges in a few iterations when the constant
+ * terms change little between solves.
+ */
+class SparseLinearSystem {
+  public:
+    SparseLinearSystem(unsigned unknowns = 0)
+        : rows(unknowns), constants(unknowns, 0.0)
+    {}
+
+    unsigned size() const { return rows.size(); }
+
+    // Add to the coefficient of an unknown in an equation
+    void addCoefficient(unsigned eq, unsigned unkw, double value);
+
+    // Add to the constant term of an equation
+    void addConstant(unsigned eq, double value) {
+        assert(eq < constants.size());
+        constants[eq] += value;
+    }
+
+    // Set all the constant terms to zero
+    void clearConstants() {
+        std::fill(constants.begin(), constants.end(), 0.0);
+    }
+
+    /**
+     * Solve the system with Gauss-Seidel iterations.
+     *
+     * @param x Initial guess, replaced with the solution
+     * @param tolerance Largest change of an unknown in the last
+     *                  iteration for the solution to be accepted
+     * @param max_iters Number of iterations to give up after
+     * @return true if the solution converged
+     */
+    bool solve(std::vector<double> &x, double tolerance,
+               unsigned max_iters) const;
+
+    // Solve the system with dense Gauss elimination
+    std::vector<double> solveDense() const;
+
+    std::string toStr() const;
+
+  private:
+    struct Coefficient {
+        unsigned unkw;
+        double value;
+    };
+
+    /** Off-diagonal coefficients and diagonal of each equation */
+    struct Row {
+        std::vector<Coefficient> coeffs;
+        double diag = 0;
+    };
+
+    std::vector<Row> rows;
+    std::vector<double> constants;
+};
+
 #endif
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "sim/linear_solver.hh"
+
+namespace
+{
+
+/**
+ * Nodal equations of a chain of n nodes connected by conductances g,
+ * with node 0 tied to a reference at temp and a power p injected into
+ * the last node.
+ */
+SparseLinearSystem
+chain(unsigned n, double g, double temp, double p)
+{
+    SparseLinearSystem sys(n);
+    for (unsigned i = 0; i + 1 < n; i++) {
+        sys.addCoefficient(i, i, -g);
+        sys.addCoefficient(i, i + 1, g);
+        sys.addCoefficient(i + 1, i + 1, -g);
+        sys.addCoefficient(i + 1, i, g);
+    }
+    sys.addCoefficient(0, 0, -g);
+    sys.addConstant(0, g * temp);
+    sys.addConstant(n - 1, p);
+    return sys;
+}
+
+} // anonymous namespace
+
+TEST(SparseLinearSystemTest, MatchesDense)
+{
+    SparseLinearSystem sys = chain(8, 2.0, 300.0, 1.0);
+
+    std::vector<double> dense = sys.solveDense();
+    std::vector<double> x;
+    EXPECT_TRUE(sys.solve(x, 1e-12, 100000));
+
+    ASSERT_EQ(dense.size(), x.size());
+    for (unsigned i = 0; i < x.size(); i++) {
+        // All of p flows through the chain into the reference
+        EXPECT_NEAR(300.0 + 0.5 * (i + 1), dense[i], 1e-9);
+        EXPECT_NEAR(dense[i], x[i], 1e-9);
+    }
+}
+
+TEST(SparseLinearSystemTest, WarmStart)
+{
+    SparseLinearSystem sys = chain(8, 2.0, 300.0, 1.0);
+
+    std::vector<double> x;
+    EXPECT_TRUE(sys.solve(x, 1e-12, 100000));
+
+    // Starting from the solution converges in a single iteration
+    EXPECT_TRUE(sys.solve(x, 1e-12, 1));
+
+    // And changing the constant terms keeps the coefficients
+    sys.clearConstants();
+    sys.addConstant(0, 2.0 * 310.0);
+    sys.addConstant(7, 1.0);
+    EXPECT_TRUE(sys.solve(x, 1e-12, 100000));
+    EXPECT_NEAR(310.0 + 0.5 * 8, x[7], 1e-9);
+}
+
+TEST(SparseLinearSystemTest, NotConverged)
+{
+    SparseLinearSystem sys = chain(64, 2.0, 300.0, 1.0);
+
+    std::vector<double> x;
+    EXPECT_FALSE(sys.solve(x, 1e-12, 2));
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/live_stats.hh"
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+#include "base/atomicio.hh"
+#include "base/cprintf.hh"
+#include "base/hostinfo.hh"
+#include "base/logging.hh"
+#include "base/stats/group.hh"
+#include "base/stats/info.hh"
+#include "sim/core.hh"
+#include "sim/eventq.hh"
+
+namespace
+{
+
+std::unique_ptr<LiveStatsServer> server;
+
+/** Host time to wait for a client to send its request, in ms. */
+const int RequestTimeout = 100;
+
+void
+printValue(std::ostream &os, double value)
+{
+    if (std::isnan(value))
+        os << "NaN";
+    else if (std::isinf(value))
+        os << (value > 0 ? "+Inf" : "-Inf");
+    else
+        ccprintf(os, "%.17g", value);
+}
+
+} // anonymous namespace
+
+void
+LiveStatsServer::ListenEvent::process(int revent)
+{
+    server->serve();
+}
+
+LiveStatsServer::LiveStatsServer(const Stats::Group &root, int port,
+                                 const std::vector<std::string> &names)
+    : listenEvent(nullptr)
+{
+    for (const auto &name : names) {
+        const Stats::Info *info = root.resolveStat(name);
+        if (!info) {
+            warn("Not serving unknown statistic '%s'.", name);
+        } else if (!dynamic_cast<const Stats::ScalarInfo *>(info) &&
+                   !dynamic_cast<const Stats::VectorInfo *>(info)) {
+            warn("Not serving statistic '%s', which is not a scalar, "
+                 "vector or formula.", name);
+        } else {
+            stats.emplace_back(name, info);
+        }
+    }
+
+    if (ListenSocket::allDisabled()) {
+        warn_once("Sockets disabled, not serving live statistics");
+        return;
+    }
+
+    while (!listener.listen(port, true))
+        port++;
+
+    ccprintf(std::cerr, "Serving live statistics on port %d\n", port);
+
+    listenEvent = new ListenEvent(this, listener.getfd(), POLLIN);
+    pollQueue.schedule(listenEvent);
+}
+
+LiveStatsServer::~LiveStatsServer()
+{
+    delete listenEvent;
+}
+
+std::string
+LiveStatsServer::render() const
+{
+    std::ostringstream os;
+
+    ccprintf(os, "# TYPE gem5_sim_ticks counter\n");
+    ccprintf(os, "gem5_sim_ticks %d\n", curTick());
+    ccprintf(os, "# TYPE gem5_host_memory_bytes gauge\n");
+    ccprintf(os, "gem5_host_memory_bytes %d\n", memUsage());
+
+    ccprintf(os, "# TYPE gem5_eventq_serviced counter\n");
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        ccprintf(os, "gem5_eventq_serviced{queue=\"%d\"} %d\n", i,
+                 mainEventQueue[i]->numServiced());
+    }
+    ccprintf(os, "# TYPE gem5_eventq_pending gauge\n");
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        ccprintf(os, "gem5_eventq_pending{queue=\"%d\"} %d\n", i,
+                 mainEventQueue[i]->numPending());
+    }
+
+    ccprintf(os, "# TYPE gem5_stat gauge\n");
+    for (const auto &stat : stats) {
+        const Stats::Info *info = stat.second;
+        double value;
+        if (auto *scalar = dynamic_cast<const Stats::ScalarInfo *>(info))
+            value = scalar->result();
+        else
+            value = static_cast<const Stats::VectorInfo *>(info)->total();
+
+        ccprintf(os, "gem5_stat{name=\"%s\"} ", stat.first);
+        printValue(os, value);
+        os << "\n";
+    }
+
+    return os.str();
+}
+
+void
+LiveStatsServer::serve()
+{
+    int fd = listener.accept(true);
+    if (fd < 0)
+        return;
+
+    // The request itself does not matter, but it has to be read, as
+    // closing a socket with unread data resets the connection
+    pollfd pfd = { fd, POLLIN, 0 };
+    if (poll(&pfd, 1, RequestTimeout) > 0) {
+        char request[4096];
+        M5_VAR_USED ssize_t len = ::read(fd, request, sizeof(request));
+    }
+
+    const std::string body = render();
+    std::ostringstream os;
+    ccprintf(os, "HTTP/1.0 200 OK\r\n"
+             "Content-Type: text/plain; version=0.0.4\r\n"
+             "Content-Length: %d\r\n"
+             "Connection: close\r\n"
+             "\r\n", body.size());
+    os << body;
+
+    const std::string response = os.str();
+    atomic_write(fd, response.data(), response.size());
+    ::close(fd);
+}
+
+void
+startLiveStats(const Stats::Group &root, int port,
+               const std::vector<std::string> &names)
+{
+    if (port == 0)
+        return;
+
+    server.reset(new LiveStatsServer(root, port, names));
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_LIVE_STATS_HH__
+#define __SIM_LIVE_STATS_HH__
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/pollevent.hh"
+#include "base/socket.hh"
+
+namespace Stats
+{
+class Group;
+class Info;
+} // namespace Stats
+
+/**
+ * Server reporting the progress of a running simulation over HTTP.
+ *
+ * Every request, whatever its path, is answered with a few values in
+ * the text exposition format of Prometheus: the current tick, the host
+ * memory used, the number of events serviced and pending in each main
+ * event queue, and the current value of a selection of scalar
+ * statistics. Statistics are sampled when the request is answered,
+ * without dumping or resetting them.
+ *
+ * Connections are accepted through the PollQueue, which the main
+ * simulation loop services between events, so answering a request
+ * never races with the simulated model and costs nothing when no
+ * request comes in.
+ */
+class LiveStatsServer
+{
+  private:
+    class ListenEvent : public PollEvent
+    {
+      private:
+        LiveStatsServer *server;
+
+      public:
+        ListenEvent(LiveStatsServer *s, int fd, int e)
+            : PollEvent(fd, e), server(s)
+        {}
+
+        void process(int revent) override;
+    };
+
+    ListenSocket listener;
+    ListenEvent *listenEvent;
+
+    /** The served statistics and their names. */
+    std::vector<std::pair<std::string, const Stats::Info *>> stats;
+
+    /** Answer the next pending connection. */
+    void serve();
+
+  public:
+    /**
+     * @param root Group the statistic names are relative to
+     * @param port TCP port to listen on
+     * @param names Names of the served statistics
+     */
+    LiveStatsServer(const Stats::Group &root, int port,
+                    const std::vector<std::string> &names);
+    ~LiveStatsServer();
+
+    /** Format the current values, as sent in the body of a response. */
+    std::string render() const;
+};
+
+/**
+ * Start serving live statistics, unless the port is 0.
+ *
+ * @param root Group the statistic names are relative to
+ * @param port TCP port to listen on
+ * @param names Names of the served statistics
+ */
+void startLiveStats(const Stats::Group &root, int port,
+                    const std::vector<std::string> &names);
+
+#endif // __SIM_LIVE_STATS_HH__
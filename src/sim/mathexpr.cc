@@ -38,6 +38,7 @@
 #include "sim/mathexpr.hh"
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <regex>
 #include <string>
@@ -163,6 +164,87 @@ MathExpr::eval(const Node *n, EvalCallback fn) const {
     return 0;
 }
 
+MathExpr::Program
+MathExpr::compile(SlotCallback fn) const
+{
+    Program prog;
+    prog.stack.resize(compile(root, fn, prog));
+    return prog;
+}
+
+int
+MathExpr::compile(const Node *n, SlotCallback fn, Program &prog) const
+{
+    if (n->op == sValue) {
+        prog.steps.push_back({sValue, n->value, -1});
+        return 1;
+    } else if (n->op == sVariable) {
+        prog.steps.push_back({sVariable, 0, fn(n->variable)});
+        return 1;
+    }
+
+    panic_if(n->op == nInvalid, "Invalid node!\n");
+
+    const size_t first = prog.steps.size();
+    const int l_depth = n->l ? compile(n->l, fn, prog) : 0;
+    const int r_depth = compile(n->r, fn, prog);
+
+    // Fold the node if all its operands are constant
+    bool constant = true;
+    for (size_t i = first; i < prog.steps.size(); ++i)
+        constant = constant && prog.steps[i].op == sValue;
+
+    if (constant) {
+        const double a = n->l ? prog.steps[first].value : 0;
+        const double b = prog.steps.back().value;
+        prog.steps.resize(first);
+        for (auto &opt : ops) {
+            if (opt.op == n->op)
+                prog.steps.push_back({sValue, opt.fn(a, b), -1});
+        }
+        return 1;
+    }
+
+    prog.steps.push_back({n->op, 0, -1});
+    return std::max(l_depth, r_depth + (n->l ? 1 : 0));
+}
+
+double
+MathExpr::Program::eval(const double *vars) const
+{
+    assert(!steps.empty());
+
+    double *sp = stack.data();
+    for (const auto &step : steps) {
+        switch (step.op) {
+          case sValue:
+            *sp++ = step.value;
+            break;
+          case sVariable:
+            *sp++ = vars[step.slot];
+            break;
+          case uNeg:
+            sp[-1] = -sp[-1];
+            break;
+          default:
+            {
+                const double b = *--sp;
+                double &a = sp[-1];
+                switch (step.op) {
+                  case bAdd: a = a + b; break;
+                  case bSub: a = a - b; break;
+                  case bMul: a = a * b; break;
+                  case bDiv: a = a / b; break;
+                  case bPow: a = std::pow(a, b); break;
+                  default: panic("Invalid step!\n");
+                }
+            }
+        }
+    }
+
+    return stack[0];
+}
+
 std::string
 MathExpr::toStr(Node *n, std::string prefix) const {
     std::string ret;
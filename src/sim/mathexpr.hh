@@ -45,11 +45,52 @@
 #include <vector>
 
 class MathExpr {
+  private:
+    enum Operator {
+        bAdd, bSub, bMul, bDiv, bPow, uNeg, sValue, sVariable, nInvalid
+    };
+
   public:
 
     MathExpr(std::string expr);
 
     typedef std::function<double(std::string)> EvalCallback;
+    typedef std::function<int(const std::string &)> SlotCallback;
+
+    /**
+     * The expression compiled to a flat list of postfix steps, with
+     * constant subexpressions folded and each variable replaced by an
+     * index into an array of values. Evaluating it needs neither a tree
+     * walk nor a lookup by name.
+     */
+    class Program
+    {
+      public:
+        /**
+         * Evaluates the program
+         *
+         * @param vars Values of the variables, by slot
+         *
+         * @return The value of the expression
+         */
+        double eval(const double *vars) const;
+
+        bool empty() const { return steps.empty(); }
+
+      private:
+        friend class MathExpr;
+
+        struct Step
+        {
+            Operator op;
+            double value;
+            int slot;
+        };
+
+        std::vector<Step> steps;
+        /** Evaluation stack, sized for the program when compiled */
+        mutable std::vector<double> stack;
+    };
 
     /**
      * Prints an ASCII representation of the expression tree
@@ -83,10 +124,16 @@ class MathExpr {
         return vars;
     }
 
+    /**
+     * Compiles the expression
+     *
+     * @param fn A callback function returning the slot of a variable
+     *
+     * @return The compiled expression
+     */
+    Program compile(SlotCallback fn) const;
+
   private:
-    enum Operator {
-        bAdd, bSub, bMul, bDiv, bPow, uNeg, sValue, sVariable, nInvalid
-    };
 
     // Match operators
     const int MAX_PRIO = 4;
@@ -137,6 +184,10 @@ class MathExpr {
     /** Eval a node */
     double eval(const Node *n, EvalCallback fn) const;
 
+    /** Append the steps of a node to a program, return the stack depth
+     * they need */
+    int compile(const Node *n, SlotCallback fn, Program &prog) const;
+
     /** Return all variable reachable from a node to a vector of
      * strings */
     void getVariables(const Node *n, std::vector<std::string> &vars) const;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sim/mathexpr.hh"
+
+namespace
+{
+
+/** Evaluate an expression both as a tree and compiled */
+void
+checkExpr(const std::string &str, double expected)
+{
+    const std::vector<std::string> names = {"x", "y", "z"};
+    const std::map<std::string, double> vars = {
+        {"x", 3}, {"y", 1.5}, {"z", 0.25}};
+    const double values[] = {3, 1.5, 0.25};
+
+    MathExpr expr(str);
+    MathExpr::Program prog = expr.compile([&](const std::string &name) {
+        return std::find(names.begin(), names.end(), name) - names.begin();
+    });
+
+    EXPECT_DOUBLE_EQ(expected,
+        expr.eval([&](std::string name) { return vars.at(name); }));
+    EXPECT_DOUBLE_EQ(expected, prog.eval(values));
+}
+
+} // anonymous namespace
+
+TEST(MathExprTest, Constants)
+{
+    checkExpr("1+2*3", 7);
+    checkExpr("(1+2)*3", 9);
+    checkExpr("2^3^2", 64);
+    checkExpr("-4/2", -2);
+}
+
+TEST(MathExprTest, Variables)
+{
+    checkExpr("x", 3);
+    checkExpr("-x+2^3", 5);
+    checkExpr("(x-y)*(x+y)/2", 3.375);
+    checkExpr("x-y-z", 1.25);
+    checkExpr("x/y/z", 8);
+    checkExpr("2*(3+4)*x", 42);
+}
+
+TEST(MathExprTest, CompiledConstantFolding)
+{
+    // The constant part is folded, the program can be evaluated
+    // without any variables.
+    MathExpr expr("(2+3)*4");
+    MathExpr::Program prog = expr.compile([](const std::string &) {
+        return -1;
+    });
+    EXPECT_DOUBLE_EQ(20, prog.eval(nullptr));
+}
+
+TEST(MathExprTest, CompiledRepeatedVariable)
+{
+    int slots = 0;
+    MathExpr expr("x*x+x");
+    MathExpr::Program prog = expr.compile([&](const std::string &) {
+        ++slots;
+        return 0;
+    });
+    const double x = 2;
+    EXPECT_EQ(3, slots);
+    EXPECT_DOUBLE_EQ(6, prog.eval(&x));
+}
@@ -29,8 +29,11 @@
 #include "sim/mem_state.hh"
 
 #include <cassert>
+#include <iterator>
+#include <vector>
 
 #include "arch/generic/mmu.hh"
+#include "base/compiler.hh"
 #include "debug/Vma.hh"
 #include "mem/se_translating_port_proxy.hh"
 #include "sim/process.hh"
@@ -65,7 +68,7 @@ MemState::operator=(const MemState &in)
     _nextThreadStackBase = in._nextThreadStackBase;
     _mmapEnd = in._mmapEnd;
     _endBrkPoint = in._endBrkPoint;
-    _vmaList = in._vmaList; /* This assignment does a deep copy. */
+    _vmas = in._vmas; /* This assignment does a deep copy. */
 
     return *this;
 }
@@ -76,15 +79,25 @@ MemState::resetOwner(Process *owner)
     _ownerProcess = owner;
 }
 
+MemState::VmaMap::iterator
+MemState::firstVmaEndingAfter(Addr addr)
+{
+    auto vma = _vmas.upper_bound(addr);
+    if (vma != _vmas.begin()) {
+        auto prev = std::prev(vma);
+        if (prev->second.end() > addr)
+            return prev;
+    }
+    return vma;
+}
+
 bool
 MemState::isUnmapped(Addr start_addr, Addr length)
 {
     Addr end_addr = start_addr + length;
-    const AddrRange range(start_addr, end_addr);
-    for (const auto &vma : _vmaList) {
-        if (vma.intersects(range))
-            return false;
-    }
+    auto vma = firstVmaEndingAfter(start_addr);
+    if (vma != _vmas.end() && vma->second.start() < end_addr)
+        return false;
 
     /**
      * In case someone skips the VMA interface and just directly maps memory
@@ -130,10 +143,8 @@ MemState::updateBrkRegion(Addr old_brk, Addr new_brk)
      * for the extra memory that is requested so we do not create a situation
      * where there can be overlapping mappings in the regions.
      *
-     * Since we do not track the type of the region and we also do not
-     * coalesce the regions together, we can create a fragmented set of
-     * heap regions. To resolve this, we keep the furthest point ever mapped
-     * by the _endBrkPoint field.
+     * Since the heap may have been partially unmapped, we keep the
+     * furthest point ever mapped by the _endBrkPoint field.
      */
     if (page_aligned_brk > _endBrkPoint) {
         auto length = page_aligned_brk - _endBrkPoint;
@@ -147,11 +158,8 @@ MemState::updateBrkRegion(Addr old_brk, Addr new_brk)
         }
 
         /**
-         * Note that the heap regions are always contiguous but there is
-         * no mechanism right now to coalesce together memory that belongs
-         * to the same region with similar access permissions. This could be
-         * implemented if it actually becomes necessary; probably only
-         * necessary if the list becomes too long to walk.
+         * The heap regions are always contiguous, so mapRegion merges
+         * this extension into the existing heap VMA.
          */
         mapRegion(_endBrkPoint, length, "heap");
         _endBrkPoint = page_aligned_brk;
@@ -174,10 +182,28 @@ MemState::mapRegion(Addr start_addr, Addr length,
     assert(isUnmapped(start_addr, length));
 
     /**
-     * Record the region in our list structure.
+     * Anonymous regions which directly follow an anonymous region of the
+     * same name, like successive heap extensions, are merged into it so
+     * that the number of VMAs stays small.
      */
-    _vmaList.emplace_back(AddrRange(start_addr, start_addr + length),
-                          _pageBytes, region_name, sim_fd, offset);
+    if (sim_fd == -1) {
+        auto prev = _vmas.lower_bound(start_addr);
+        if (prev != _vmas.begin()) {
+            VMA &vma = std::prev(prev)->second;
+            if (vma.end() == start_addr && !vma.hasHostBuf() &&
+                vma.getName() == region_name) {
+                vma.extendRegionRight(start_addr + length);
+                return;
+            }
+        }
+    }
+
+    /**
+     * Record the region in our map structure.
+     */
+    _vmas.emplace(start_addr,
+                  VMA(AddrRange(start_addr, start_addr + length),
+                      _pageBytes, region_name, sim_fd, offset));
 }
 
 void
@@ -186,64 +212,66 @@ MemState::unmapRegion(Addr start_addr, Addr length)
     Addr end_addr = start_addr + length;
     const AddrRange range(start_addr, end_addr);
 
-    auto vma = std::begin(_vmaList);
-    while (vma != std::end(_vmaList)) {
-        if (vma->isStrictSuperset(range)) {
+    auto vma = firstVmaEndingAfter(start_addr);
+    while (vma != _vmas.end() && vma->first < end_addr) {
+        VMA &area = vma->second;
+        if (area.isStrictSuperset(range)) {
             DPRINTF(Vma, "memstate: split vma [0x%x - 0x%x] into "
                     "[0x%x - 0x%x] and [0x%x - 0x%x]\n",
-                    vma->start(), vma->end(),
-                    vma->start(), start_addr,
-                    end_addr, vma->end());
+                    area.start(), area.end(),
+                    area.start(), start_addr,
+                    end_addr, area.end());
             /**
              * Need to split into two smaller regions.
-             * Create a clone of the old VMA and slice it to the right.
+             * Create a clone of the old VMA and slice it to the left.
              */
-            _vmaList.push_back(*vma);
-            _vmaList.back().sliceRegionRight(start_addr);
+            VMA right(area);
+            right.sliceRegionLeft(end_addr);
 
             /**
              * Slice old VMA to encapsulate the left region.
              */
-            vma->sliceRegionLeft(end_addr);
+            area.sliceRegionRight(start_addr);
+            _vmas.emplace(end_addr, right);
 
             /**
              * Region cannot be in any more VMA, because it is completely
              * contained in this one!
              */
             break;
-        } else if (vma->isSubset(range)) {
+        } else if (area.isSubset(range)) {
             DPRINTF(Vma, "memstate: destroying vma [0x%x - 0x%x]\n",
-                    vma->start(), vma->end());
+                    area.start(), area.end());
             /**
              * Need to nuke the existing VMA.
              */
-            vma = _vmaList.erase(vma);
+            vma = _vmas.erase(vma);
 
             continue;
 
-        } else if (vma->intersects(range)) {
+        } else if (area.start() < start_addr) {
+            DPRINTF(Vma, "memstate: resizing vma [0x%x - 0x%x] "
+                    "into [0x%x - 0x%x]\n",
+                    area.start(), area.end(),
+                    area.start(), start_addr);
             /**
-             * Trim up the existing VMA.
+             * Overlaps from the right.
              */
-            if (vma->start() < start_addr) {
-                DPRINTF(Vma, "memstate: resizing vma [0x%x - 0x%x] "
-                        "into [0x%x - 0x%x]\n",
-                        vma->start(), vma->end(),
-                        vma->start(), start_addr);
-                /**
-                 * Overlaps from the right.
-                 */
-                vma->sliceRegionRight(start_addr);
-            } else {
-                DPRINTF(Vma, "memstate: resizing vma [0x%x - 0x%x] "
-                        "into [0x%x - 0x%x]\n",
-                        vma->start(), vma->end(),
-                        end_addr, vma->end());
-                /**
-                 * Overlaps from the left.
-                 */
-                vma->sliceRegionLeft(end_addr);
-            }
+            area.sliceRegionRight(start_addr);
+        } else {
+            DPRINTF(Vma, "memstate: resizing vma [0x%x - 0x%x] "
+                    "into [0x%x - 0x%x]\n",
+                    area.start(), area.end(),
+                    end_addr, area.end());
+            /**
+             * Overlaps from the left. The VMA now starts at end_addr, so
+             * it has to be re-keyed. It is the last one in the range.
+             */
+            VMA right(area);
+            right.sliceRegionLeft(end_addr);
+            _vmas.erase(vma);
+            _vmas.emplace(end_addr, right);
+            break;
         }
 
         vma++;
@@ -283,71 +311,52 @@ MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
     Addr end_addr = start_addr + length;
     const AddrRange range(start_addr, end_addr);
 
-    auto vma = std::begin(_vmaList);
-    while (vma != std::end(_vmaList)) {
-        if (vma->isStrictSuperset(range)) {
-            /**
-             * Create clone of the old VMA and slice right.
-             */
-            _vmaList.push_back(*vma);
-            _vmaList.back().sliceRegionRight(start_addr);
-
+    /**
+     * Cut the parts of the VMAs that fall inside the range out of the
+     * map first and put them back at their new addresses afterwards, so
+     * that the moved areas are never mistaken for ones still to move.
+     */
+    std::vector<VMA> moved;
+    auto vma = firstVmaEndingAfter(start_addr);
+    while (vma != _vmas.end() && vma->first < end_addr) {
+        VMA &area = vma->second;
+        if (area.isSubset(range)) {
             /**
-             * Create clone of the old VMA and slice it left.
+             * Just go ahead and move it!
              */
-            _vmaList.push_back(*vma);
-            _vmaList.back().sliceRegionLeft(end_addr);
+            moved.push_back(area);
+            vma = _vmas.erase(vma);
+            continue;
+        }
 
-            /**
-             * Slice the old VMA left and right to adjust the file backing,
-             * then overwrite the virtual addresses!
-             */
-            vma->sliceRegionLeft(start_addr);
-            vma->sliceRegionRight(end_addr);
-            vma->remap(new_start_addr);
+        /**
+         * Create a clone of the old VMA covering just the moved part,
+         * then trim the old VMA to what is left outside the range.
+         */
+        VMA inner(area);
+        if (area.start() < start_addr)
+            inner.sliceRegionLeft(start_addr);
+        if (area.end() > end_addr) {
+            inner.sliceRegionRight(end_addr);
+
+            VMA right(area);
+            right.sliceRegionLeft(end_addr);
+            _vmas.emplace(end_addr, right);
+        }
+        moved.push_back(inner);
 
-            /**
-             * The region cannot be in any more VMAs, because it is
-             * completely contained in this one!
-             */
-            break;
-        } else if (vma->isSubset(range)) {
-            /**
-             * Just go ahead and remap it!
-             */
-            vma->remap(vma->start() - start_addr + new_start_addr);
-        } else if (vma->intersects(range)) {
-            /**
-             * Create a clone of the old VMA.
-             */
-            _vmaList.push_back(*vma);
-
-            if (vma->start() < start_addr) {
-                /**
-                 * Overlaps from the right.
-                 */
-                _vmaList.back().sliceRegionRight(start_addr);
-
-                /**
-                 * Remap the old region.
-                 */
-                vma->sliceRegionLeft(start_addr);
-                vma->remap(new_start_addr);
-            } else {
-                /**
-                 * Overlaps from the left.
-                 */
-                _vmaList.back().sliceRegionLeft(end_addr);
-
-                /**
-                 * Remap the old region.
-                 */
-                vma->sliceRegionRight(end_addr);
-                vma->remap(new_start_addr + vma->start() - start_addr);
-            }
+        if (area.start() < start_addr) {
+            area.sliceRegionRight(start_addr);
+            vma++;
+        } else {
+            vma = _vmas.erase(vma);
         }
+    }
 
-        vma++;
+    for (auto &area : moved) {
+        area.remap(area.start() - start_addr + new_start_addr);
+        M5_VAR_USED auto inserted = _vmas.emplace(area.start(), area);
+        assert(inserted.second);
     }
 
     /**
@@ -387,31 +396,31 @@ MemState::fixupFault(Addr vaddr)
      * Check if we are accessing a mapped virtual address. If so then we
      * just haven't allocated it a physical page yet and can do so here.
      */
-    for (const auto &vma : _vmaList) {
-        if (vma.contains(vaddr)) {
-            Addr vpage_start = roundDown(vaddr, _pageBytes);
-            _ownerProcess->allocateMem(vpage_start, _pageBytes);
+    auto it = firstVmaEndingAfter(vaddr);
+    if (it != _vmas.end() && it->second.contains(vaddr)) {
+        const VMA &vma = it->second;
+        Addr vpage_start = roundDown(vaddr, _pageBytes);
+        _ownerProcess->allocateMem(vpage_start, _pageBytes);
 
+        /**
+         * We are assuming that fresh pages are zero-filled, so there is
+         * no need to zero them out when there is no backing file.
+         * This assumption will not hold true if/when physical pages
+         * are recycled.
+         */
+        if (vma.hasHostBuf()) {
             /**
-             * We are assuming that fresh pages are zero-filled, so there is
-             * no need to zero them out when there is no backing file.
-             * This assumption will not hold true if/when physical pages
-             * are recycled.
+             * Write the memory for the host buffer contents for all
+             * ThreadContexts associated with this process.
              */
-            if (vma.hasHostBuf()) {
-                /**
-                 * Write the memory for the host buffer contents for all
-                 * ThreadContexts associated with this process.
-                 */
-                for (auto &cid : _ownerProcess->contextIds) {
-                    auto *tc = _ownerProcess->system->threads[cid];
-                    SETranslatingPortProxy
-                        virt_mem(tc, SETranslatingPortProxy::Always);
-                    vma.fillMemPages(vpage_start, _pageBytes, virt_mem);
-                }
+            for (auto &cid : _ownerProcess->contextIds) {
+                auto *tc = _ownerProcess->system->threads[cid];
+                SETranslatingPortProxy
+                    virt_mem(tc, SETranslatingPortProxy::Always);
+                vma.fillMemPages(vpage_start, _pageBytes, virt_mem);
             }
-            return true;
         }
+        return true;
     }
 
     /**
@@ -478,7 +487,8 @@ MemState::printVmaList()
 {
     std::stringstream file_content;
 
-    for (auto vma : _vmaList) {
+    for (const auto &it : _vmas) {
+        const VMA &vma = it.second;
         std::stringstream line;
         line << std::hex << vma.start() << "-";
         line << std::hex << vma.end() << " ";
@@ -29,7 +29,7 @@
 #ifndef SRC_SIM_MEM_STATE_HH
 #define SRC_SIM_MEM_STATE_HH
 
-#include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -192,9 +192,10 @@ class MemState : public Serializable
         paramOut(cp, "mmapEnd", _mmapEnd);
 
         ScopedCheckpointSection sec(cp, "vmalist");
-        paramOut(cp, "size", _vmaList.size());
+        paramOut(cp, "size", _vmas.size());
         int count = 0;
-        for (auto vma : _vmaList) {
+        for (const auto &it : _vmas) {
+            const VMA &vma = it.second;
             ScopedCheckpointSection sec(cp, csprintf("Vma%d", count++));
             paramOut(cp, "name", vma.getName());
             paramOut(cp, "addrRangeStart", vma.start());
@@ -224,7 +225,7 @@ class MemState : public Serializable
             paramIn(cp, "name", name);
             paramIn(cp, "addrRangeStart", start);
             paramIn(cp, "addrRangeEnd", end);
-            _vmaList.emplace_back(AddrRange(start, end), _pageBytes, name);
+            _vmas.emplace(start, VMA(AddrRange(start, end), _pageBytes, name));
         }
     }
 
@@ -253,19 +254,26 @@ class MemState : public Serializable
      */
     Addr _endBrkPoint;
 
+    typedef std::map<Addr, VMA> VmaMap;
+
+    /**
+     * Find the first VMA which ends after addr, i.e. the VMA containing
+     * addr or, if there is none, the next VMA above it.
+     */
+    VmaMap::iterator firstVmaEndingAfter(Addr addr);
+
     /**
-     * The _vmaList member is a list of virtual memory areas in the target
+     * The _vmas member holds the virtual memory areas in the target
      * application space that have been allocated by the target. In most
      * operating systems, lazy allocation is used and these structures (or
      * equivalent ones) are used to track the valid address ranges.
      *
-     * This could use a more efficient data structure like an interval
-     * tree, but it is unclear whether the vmas will be modified often enough
-     * for the improvement in lookup time to matter. Unmapping VMAs currently
-     * modifies the list while iterating so the STL container must either
-     * support this or the unmapping method must be changed.
+     * VMAs never overlap, so keying them by start address gives an
+     * interval map: the VMA containing an address, or all the VMAs
+     * intersecting a range, are found with a single ordered lookup
+     * rather than a walk of every area.
      */
-    std::list<VMA> _vmaList;
+    VmaMap _vmas;
 };
 
 #endif
@@ -95,6 +95,10 @@ class ThermalModel(ClockedObject):
     ]
 
     step = Param.Float(0.01, "Simulation step (in seconds) for thermal simulation")
+    solver_tolerance = Param.Float(1e-6, "Largest temperature change "
+        "(in Kelvin) of the last iteration of the thermal solver")
+    solver_max_iterations = Param.Unsigned(1000, "Iterations of the "
+        "thermal solver before falling back to Gauss elimination")
 
     def populate(self):
         if not hasattr(self,"_capacitors"): self._capacitors = []
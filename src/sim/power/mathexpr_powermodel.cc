@@ -53,30 +53,86 @@ MathExprPowerModel::MathExprPowerModel(const Params &p)
 void
 MathExprPowerModel::startup()
 {
-    for (auto expr: {dyn_expr, st_expr}) {
-        std::vector<std::string> vars = expr.getVariables();
-
-        for (auto var: vars) {
-            // Automatic variables:
-            if (var == "temp" || var == "voltage" || var == "clock_period") {
-                continue;
-            }
-
-            auto *info = Stats::resolve(var);
-            fatal_if(!info, "Failed to evaluate %s in expression:\n%s\n",
-                     var, expr.toStr());
-            statsMap[var] = info;
+    // Compile the expressions once, so that the power samples neither
+    // walk the expression trees nor look up stats by name.
+    for (auto *expr: {&dyn_expr, &st_expr}) {
+        MathExpr::Program prog = expr->compile(
+            [this, expr](const std::string &name) {
+                return resolve(*expr, name);
+            });
+
+        if (expr == &dyn_expr)
+            dyn_prog = prog;
+        else
+            st_prog = prog;
+    }
+
+    values.resize(variables.size());
+}
+
+int
+MathExprPowerModel::resolve(const MathExpr &expr, const std::string &name)
+{
+    using namespace Stats;
+
+    auto it = slots.find(name);
+    if (it != slots.end())
+        return it->second;
+
+    Variable var{Variable::Scalar, nullptr, nullptr};
+
+    // Automatic variables:
+    if (name == "temp") {
+        var.kind = Variable::Temp;
+    } else if (name == "voltage") {
+        var.kind = Variable::Voltage;
+    } else if (name == "clock_period") {
+        var.kind = Variable::ClockPeriod;
+    } else {
+        auto *info = Stats::resolve(name);
+        fatal_if(!info, "Failed to evaluate %s in expression:\n%s\n",
+                 name, expr.toStr());
+        statsMap[name] = info;
+
+        // Only these stat types are supported right now
+        if ((var.scalar = dynamic_cast<const ScalarInfo *>(info))) {
+            var.kind = Variable::Scalar;
+        } else if ((var.formula = dynamic_cast<const FormulaInfo *>(info))) {
+            var.kind = Variable::Formula;
+        } else {
+            panic("Unknown stat type!\n");
         }
     }
+
+    variables.push_back(var);
+    return slots[name] = variables.size() - 1;
 }
 
 double
-MathExprPowerModel::eval(const MathExpr &expr) const
+MathExprPowerModel::eval(const MathExpr::Program &prog) const
 {
-    return expr.eval(
-        std::bind(&MathExprPowerModel::getStatValue,
-                  this, std::placeholders::_1)
-        );
+    for (size_t i = 0; i < variables.size(); ++i) {
+        const Variable &var = variables[i];
+        switch (var.kind) {
+          case Variable::Temp:
+            values[i] = _temp.toCelsius();
+            break;
+          case Variable::Voltage:
+            values[i] = clocked_object->voltage();
+            break;
+          case Variable::ClockPeriod:
+            values[i] = clocked_object->clockPeriod();
+            break;
+          case Variable::Scalar:
+            values[i] = var.scalar->value();
+            break;
+          case Variable::Formula:
+            values[i] = var.formula->total();
+            break;
+        }
+    }
+
+    return prog.eval(values.data());
 }
 
 double
@@ -39,6 +39,7 @@
 #define __SIM_MATHEXPR_POWERMODEL_PM_HH__
 
 #include <unordered_map>
+#include <vector>
 
 #include "params/MathExprPowerModel.hh"
 #include "sim/mathexpr.hh"
@@ -46,6 +47,8 @@
 
 namespace Stats {
     class Info;
+    class ScalarInfo;
+    class FormulaInfo;
 }
 
 /**
@@ -64,14 +67,14 @@ class MathExprPowerModel : public PowerModelState
      *
      * @return Power (Watts) consumed by this object (dynamic component)
      */
-    double getDynamicPower() const override { return eval(dyn_expr); }
+    double getDynamicPower() const override { return eval(dyn_prog); }
 
     /**
      * Get the static power consumption.
      *
      * @return Power (Watts) consumed by this object (static component)
      */
-    double getStaticPower() const override { return eval(st_expr); }
+    double getStaticPower() const override { return eval(st_prog); }
 
     /**
      * Get the value for a variable (maps to a stat)
@@ -86,18 +89,40 @@ class MathExprPowerModel : public PowerModelState
     void regStats() override;
 
   private:
+    /** A variable of the expressions, resolved at startup */
+    struct Variable
+    {
+        enum Kind { Temp, Voltage, ClockPeriod, Scalar, Formula };
+
+        Kind kind;
+        const Stats::ScalarInfo *scalar;
+        const Stats::FormulaInfo *formula;
+    };
+
     /**
-     * Evaluate an expression in the context of this object, fatal if
-     * evaluation fails.
+     * Evaluate a compiled expression in the context of this object.
      *
-     * @param expr Expression to evaluate
+     * @param prog Compiled expression to evaluate
      * @return Value of expression.
      */
-    double eval(const MathExpr &expr) const;
+    double eval(const MathExpr::Program &prog) const;
+
+    /** Return the slot of a variable, resolving it on first use */
+    int resolve(const MathExpr &expr, const std::string &name);
 
     // Math expressions for dynamic and static power
     MathExpr dyn_expr, st_expr;
 
+    // The expressions compiled at startup, with the stats resolved
+    MathExpr::Program dyn_prog, st_prog;
+
+    // Variables used by the compiled expressions, by slot
+    std::vector<Variable> variables;
+    std::unordered_map<std::string, int> slots;
+
+    // Values of the variables when evaluating an expression
+    mutable std::vector<double> values;
+
     // Map that contains relevant stats for this power model
     std::unordered_map<std::string, const Stats::Info*> statsMap;
 };
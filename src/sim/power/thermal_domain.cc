@@ -80,12 +80,12 @@ ThermalDomain::emitUpdate()
 }
 
 
-LinearEquation
-ThermalDomain::getEquation(ThermalNode * tn, unsigned n, double step) const
+void
+ThermalDomain::addConstants(SparseLinearSystem &sys, double step) const
 {
-    LinearEquation eq(n);
+    if (node->isref)
+        return;
+
     double power = subsystem->getDynamicPower() + subsystem->getStaticPower();
-    if (tn == node)
-        eq[eq.cnt()] = power;
-    return eq;
+    sys.addConstant(node->id, power);
 }
@@ -40,7 +40,7 @@
 
 #include "sim/sim_object.hh"
 
-class LinearEquation;
+class SparseLinearSystem;
 class ThermalNode;
 
 /**
@@ -51,9 +51,16 @@ class ThermalNode;
 class ThermalEntity
 {
   public:
-    // Get the equation given a node and a step in seconds (assuming N nodes)
-    virtual LinearEquation getEquation(ThermalNode *tn, unsigned n,
-                                       double step) const = 0;
+    /**
+     * Add the terms of this entity to the nodal equations of the nodes
+     * it is connected to, given a step in seconds. The coefficients of
+     * the unknown temperatures are constant and added once, when the
+     * system is built. The constant terms are added before every step.
+     */
+    virtual void addCoefficients(SparseLinearSystem &sys,
+                                 double step) const {}
+    virtual void addConstants(SparseLinearSystem &sys,
+                              double step) const = 0;
 };
 
 
@@ -37,6 +37,7 @@
 
 #include "sim/power/thermal_model.hh"
 
+#include "base/logging.hh"
 #include "base/statistics.hh"
 #include "params/ThermalCapacitor.hh"
 #include "params/ThermalModel.hh"
@@ -55,11 +56,10 @@ ThermalReference::ThermalReference(const Params &p)
 {
 }
 
-LinearEquation
-ThermalReference::getEquation(ThermalNode * n, unsigned nnodes,
-                              double step) const {
-    // Just return an empty equation
-    return LinearEquation(nnodes);
+void
+ThermalReference::addConstants(SparseLinearSystem &sys, double step) const
+{
+    // The node has a fixed temperature and no equation
 }
 
 /**
@@ -70,31 +70,36 @@ ThermalResistor::ThermalResistor(const Params &p)
 {
 }
 
-LinearEquation
-ThermalResistor::getEquation(ThermalNode * n, unsigned nnodes,
-                             double step) const
+void
+ThermalResistor::addCoefficients(SparseLinearSystem &sys, double step) const
 {
-    // i[n] = (Vn2 - Vn1)/R
-    LinearEquation eq(nnodes);
+    // i[node1] = (Vn2 - Vn1)/R, i[node2] = -i[node1]
+    const double g = 1.0 / _resistance;
 
-    if (n != node1 && n != node2)
-        return eq;
+    if (!node1->isref) {
+        sys.addCoefficient(node1->id, node1->id, -g);
+        if (!node2->isref)
+            sys.addCoefficient(node1->id, node2->id, g);
+    }
 
-    if (node1->isref)
-        eq[eq.cnt()] += -node1->temp.toKelvin() / _resistance;
-    else
-        eq[node1->id] += -1.0f / _resistance;
+    if (!node2->isref) {
+        sys.addCoefficient(node2->id, node2->id, -g);
+        if (!node1->isref)
+            sys.addCoefficient(node2->id, node1->id, g);
+    }
+}
 
-    if (node2->isref)
-        eq[eq.cnt()] += node2->temp.toKelvin() / _resistance;
-    else
-        eq[node2->id] += 1.0f / _resistance;
+void
+ThermalResistor::addConstants(SparseLinearSystem &sys, double step) const
+{
+    // A reference node contributes a constant term instead
+    const double g = 1.0 / _resistance;
 
-    // We've assumed n was node1, reverse if necessary
-    if (n == node2)
-        eq *= -1.0f;
+    if (!node1->isref && node2->isref)
+        sys.addConstant(node1->id, node2->temp.toKelvin() * g);
 
-    return eq;
+    if (!node2->isref && node1->isref)
+        sys.addConstant(node2->id, node1->temp.toKelvin() * g);
 }
 
 /**
@@ -105,42 +110,53 @@ ThermalCapacitor::ThermalCapacitor(const Params &p)
 {
 }
 
-LinearEquation
-ThermalCapacitor::getEquation(ThermalNode * n, unsigned nnodes,
-                              double step) const
+void
+ThermalCapacitor::addCoefficients(SparseLinearSystem &sys, double step) const
 {
     // i(t) = C * d(Vn2 - Vn1)/dt
-    // i[n] = C/step * (Vn2 - Vn1 - Vn2[n-1] + Vn1[n-1])
-    LinearEquation eq(nnodes);
+    // i[node1] = C/step * (Vn2 - Vn1 - Vn2[n-1] + Vn1[n-1])
+    // i[node2] = -i[node1]
+    const double k = _capacitance / step;
+
+    if (!node1->isref) {
+        sys.addCoefficient(node1->id, node1->id, -k);
+        if (!node2->isref)
+            sys.addCoefficient(node1->id, node2->id, k);
+    }
 
-    if (n != node1 && n != node2)
-        return eq;
+    if (!node2->isref) {
+        sys.addCoefficient(node2->id, node2->id, -k);
+        if (!node1->isref)
+            sys.addCoefficient(node2->id, node1->id, k);
+    }
+}
 
-    eq[eq.cnt()] += _capacitance / step *
-        (node1->temp - node2->temp).toKelvin();
+void
+ThermalCapacitor::addConstants(SparseLinearSystem &sys, double step) const
+{
+    // The temperatures of the previous step, and those of reference
+    // nodes, are constant terms
+    const double k = _capacitance / step;
 
+    double cnt = k * (node1->temp - node2->temp).toKelvin();
     if (node1->isref)
-        eq[eq.cnt()] += _capacitance / step * (-node1->temp.toKelvin());
-    else
-        eq[node1->id] += -1.0f * _capacitance / step;
-
+        cnt -= k * node1->temp.toKelvin();
     if (node2->isref)
-        eq[eq.cnt()] += _capacitance / step * (node2->temp.toKelvin());
-    else
-        eq[node2->id] += 1.0f * _capacitance / step;
-
-    // We've assumed n was node1, reverse if necessary
-    if (n == node2)
-        eq *= -1.0f;
+        cnt += k * node2->temp.toKelvin();
 
-    return eq;
+    if (!node1->isref)
+        sys.addConstant(node1->id, cnt);
+    if (!node2->isref)
+        sys.addConstant(node2->id, -cnt);
 }
 
 /**
  * ThermalModel
  */
 ThermalModel::ThermalModel(const Params &p)
-    : ClockedObject(p), stepEvent([this]{ doStep(); }, name()), _step(p.step)
+    : ClockedObject(p), stepEvent([this]{ doStep(); }, name()),
+      _step(p.step), solverTolerance(p.solver_tolerance),
+      solverMaxIterations(p.solver_max_iterations)
 {
 }
 
@@ -148,20 +164,18 @@ void
 ThermalModel::doStep()
 {
     // Calculate new temperatures!
-    // For each node in the system, create the kirchhoff nodal equation
-    LinearSystem ls(eq_nodes.size());
-    for (unsigned i = 0; i < eq_nodes.size(); i++) {
-        auto n = eq_nodes[i];
-        LinearEquation node_equation (eq_nodes.size());
-        for (auto e : entities) {
-            LinearEquation eq = e->getEquation(n, eq_nodes.size(), _step);
-            node_equation = node_equation + eq;
-        }
-        ls[i] = node_equation;
+    // The kirchhoff nodal equations only change in their constant terms
+    system.clearConstants();
+    for (auto e : entities)
+        e->addConstants(system, _step);
+
+    // Get temperatures for this iteration, starting from the last ones
+    if (!system.solve(temps, solverTolerance, solverMaxIterations)) {
+        warn_once("%s: Thermal solver did not converge in %d iterations, "
+                  "using Gauss elimination.\n", name(), solverMaxIterations);
+        temps = system.solveDense();
     }
 
-    // Get temperatures for this iteration
-    std::vector <double> temps = ls.solve();
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->temp = Temperature::fromKelvin(temps[i]);
 
@@ -202,6 +216,16 @@ ThermalModel::startup()
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->id = i;
 
+    // Build the nodal equations, the step is constant so only their
+    // constant terms change over time
+    system = SparseLinearSystem(eq_nodes.size());
+    for (auto e : entities)
+        e->addCoefficients(system, _step);
+
+    temps.resize(eq_nodes.size());
+    for (unsigned i = 0; i < eq_nodes.size(); i++)
+        temps[i] = eq_nodes[i]->temp.toKelvin();
+
     // Schedule first thermal update
     schedule(stepEvent, curTick() + SimClock::Int::s * _step);
 }
@@ -42,6 +42,7 @@
 
 #include "base/temperature.hh"
 #include "sim/clocked_object.hh"
+#include "sim/linear_solver.hh"
 #include "sim/power/thermal_domain.hh"
 #include "sim/power/thermal_entity.hh"
 #include "sim/power/thermal_node.hh"
@@ -68,8 +69,9 @@ class ThermalResistor : public SimObject, public ThermalEntity
         node2 = n2;
     }
 
-    LinearEquation getEquation(ThermalNode * tn, unsigned n,
-                               double step) const override;
+    void addCoefficients(SparseLinearSystem &sys,
+                         double step) const override;
+    void addConstants(SparseLinearSystem &sys, double step) const override;
 
   private:
     /* Resistance value in K/W */
@@ -89,8 +91,9 @@ class ThermalCapacitor : public SimObject, public ThermalEntity
     typedef ThermalCapacitorParams Params;
     ThermalCapacitor(const Params &p);
 
-    LinearEquation getEquation(ThermalNode * tn, unsigned n,
-                               double step) const override;
+    void addCoefficients(SparseLinearSystem &sys,
+                         double step) const override;
+    void addConstants(SparseLinearSystem &sys, double step) const override;
 
     void setNodes(ThermalNode * n1, ThermalNode * n2) {
         node1 = n1;
@@ -120,8 +123,7 @@ class ThermalReference : public SimObject, public ThermalEntity
         node = n;
     }
 
-    LinearEquation getEquation(ThermalNode * tn, unsigned n,
-                               double step) const override;
+    void addConstants(SparseLinearSystem &sys, double step) const override;
 
     /* Fixed temperature value */
     const Temperature _temperature;
@@ -170,11 +172,20 @@ class ThermalModel : public ClockedObject
     std::vector <ThermalNode*> nodes;
     std::vector <ThermalNode*> eq_nodes;
 
+    /** Nodal equations of eq_nodes, built at startup */
+    SparseLinearSystem system;
+    /** Temperatures of the last step, in Kelvin */
+    std::vector <double> temps;
+
     /** Stepping event to update the model values */
     EventFunctionWrapper stepEvent;
 
     /** Step in seconds for thermal updates */
     const double _step;
+
+    /** Convergence criteria of the iterative solver */
+    const double solverTolerance;
+    const unsigned solverMaxIterations;
 };
 
 #endif
@@ -39,7 +39,10 @@
 #define __SIM_PROBE_PMU_HH__
 
 #include <memory>
+#include <utility>
+#include <vector>
 
+#include "base/types.hh"
 #include "sim/probe/probe.hh"
 
 namespace ProbePoints {
@@ -55,6 +58,27 @@ namespace ProbePoints {
 typedef ProbePointArg<uint64_t> PMU;
 typedef std::unique_ptr<PMU> PMUUPtr;
 
+/**
+ * Taken branches sampled by a hardware branch recorder, e.g., the last
+ * branch records of the host while a KVM CPU runs. Each stack holds
+ * the (source, target) pairs of consecutive taken branches, oldest
+ * first, so the code between the target of one branch and the source
+ * of the next is a basic block that was executed.
+ */
+struct BranchStacks
+{
+    /** Instructions executed while the samples were taken. */
+    uint64_t insts = 0;
+    std::vector<std::vector<std::pair<Addr, Addr>>> stacks;
+};
+
+/**
+ * Data addresses of memory accesses sampled by the hardware, e.g., the
+ * host's precise load samples while a KVM CPU runs, oldest first. The
+ * addresses are virtual addresses of the sampled context.
+ */
+typedef std::vector<Addr> MemSamples;
+
 }
 
 #endif
@@ -268,7 +268,7 @@ class ProbePointArg : public ProbePoint
      *
      * @return Whether this probe has any listener.
      */
-    bool hasListeners() const { return listeners.size() > 0; }
+    bool hasListeners() const { return M5_UNLIKELY(!listeners.empty()); }
 
     /**
      * @brief adds a ProbeListener to this ProbePoints notify list.
@@ -294,9 +294,24 @@ class ProbePointArg : public ProbePoint
 
     /**
      * @brief called at the ProbePoint call site, passes arg to each listener.
+     *
+     * Most probe points have no listeners attached, so the common case
+     * is reduced to a single, statically predicted branch and the
+     * dispatch loop is kept out of line to avoid bloating every call
+     * site.
+     *
      * @param arg the argument to pass to each listener.
      */
     void notify(const Arg &arg)
+    {
+        if (M5_LIKELY(listeners.empty()))
+            return;
+        notifyListeners(arg);
+    }
+
+  private:
+    M5_NO_INLINE void
+    notifyListeners(const Arg &arg)
     {
         for (auto l = listeners.begin(); l != listeners.end(); ++l) {
             (*l)->notify(arg);
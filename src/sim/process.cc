@@ -44,6 +44,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <array>
 #include <climits>
 #include <csignal>
@@ -112,6 +113,7 @@ Process::Process(const ProcessParams &params, EmulationPageTable *pTable,
     : SimObject(params), system(params.system),
       useArchPT(params.useArchPT),
       kvmInSE(params.kvmInSE),
+      directSyscallIO(params.directSyscallIO),
       useForClone(false),
       pTable(pTable),
       objFile(obj_file),
@@ -305,6 +307,8 @@ Process::drain()
 void
 Process::allocateMem(Addr vaddr, int64_t size, bool clobber)
 {
+    System::ScopedThreadsLock lock(*system);
+
     // Check if the page has been mapped by other cores if not to clobber.
     // When running multithreaded programs in SE-mode with DerivO3CPU model,
     // there are cases where two or more cores have page faults on the same
@@ -348,9 +352,46 @@ Process::replicatePage(Addr vaddr, Addr new_paddr, ThreadContext *old_tc,
 bool
 Process::fixupFault(Addr vaddr)
 {
+    System::ScopedThreadsLock lock(*system);
     return memState->fixupFault(vaddr);
 }
 
+bool
+Process::hostBuffers(Addr vaddr, uint64_t size,
+                     std::vector<struct iovec> &iov)
+{
+    // Going around the caches is only safe when they can't hold guest data.
+    if (!directSyscallIO && !system->bypassCaches())
+        return false;
+
+    const Addr page_bytes = pTable->pageSize();
+    const Addr end = vaddr + size;
+    while (vaddr < end) {
+        Addr paddr;
+        if (!pTable->translate(vaddr, paddr) &&
+            !(fixupFault(vaddr) && pTable->translate(vaddr, paddr))) {
+            return false;
+        }
+
+        uint8_t *host = system->getPhysMem().toHostAddr(paddr);
+        if (!host)
+            return false;
+
+        const Addr len =
+            std::min(end, roundDown(vaddr, page_bytes) + page_bytes) - vaddr;
+        if (!iov.empty() &&
+            (uint8_t *)iov.back().iov_base + iov.back().iov_len == host) {
+            iov.back().iov_len += len;
+        } else {
+            if (iov.size() >= IOV_MAX)
+                return false;
+            iov.push_back({ host, len });
+        }
+        vaddr += len;
+    }
+    return true;
+}
+
 void
 Process::serialize(CheckpointOut &cp) const
 {
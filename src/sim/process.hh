@@ -31,6 +31,7 @@
 #define __PROCESS_HH__
 
 #include <inttypes.h>
+#include <sys/uio.h>
 
 #include <map>
 #include <memory>
@@ -111,6 +112,19 @@ class Process : public SimObject
     /// @return Whether the fault has been fixed.
     bool fixupFault(Addr vaddr);
 
+    /**
+     * Resolve the guest buffer [vaddr, vaddr + size) into host memory so
+     * that system calls can do I/O on it directly. Pages of the buffer
+     * which haven't been touched yet are allocated like on a fault, and
+     * ranges which are contiguous on the host are merged.
+     *
+     * @param iov Host ranges covering the buffer are appended to it.
+     * @return False if the buffer can't be accessed directly, in which
+     *         case it must be copied through a port proxy instead.
+     */
+    bool hostBuffers(Addr vaddr, uint64_t size,
+                     std::vector<struct iovec> &iov);
+
     // After getting registered with system object, tell process which
     // system-wide context id it is assigned.
     void
@@ -163,6 +177,8 @@ class Process : public SimObject
     bool useArchPT;
     // running KVM requires special initialization
     bool kvmInSE;
+    // let syscalls do I/O directly on the guest memory backing store
+    bool directSyscallIO;
     // flag for using the process as a thread which shares page tables
     bool useForClone;
 
@@ -44,10 +44,28 @@
 #include "base/trace.hh"
 #include "config/the_isa.hh"
 #include "debug/TimeSync.hh"
+#include "mem/mem_pool.hh"
+#include "sim/event_profiler.hh"
 #include "sim/eventq.hh"
+#include "sim/flight_recorder.hh"
 #include "sim/full_system.hh"
+#include "sim/live_stats.hh"
 #include "sim/root.hh"
 
+namespace
+{
+
+uint64_t
+servicedEvents()
+{
+    uint64_t events = 0;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        events += mainEventQueue[i]->numServiced();
+    return events;
+}
+
+} // anonymous namespace
+
 Root *Root::_root = NULL;
 Root::RootStats Root::RootStats::instance;
 Root::RootStats &rootStats = Root::RootStats::instance;
@@ -66,9 +84,32 @@ Root::RootStats::RootStats()
              UNIT_RATE(Stats::Units::Tick, Stats::Units::Second),
              "The number of ticks simulated per host second (ticks/s)"),
     ADD_STAT(hostMemory, UNIT_BYTE, "Number of bytes of host memory used"),
+    ADD_STAT(hostEvents, UNIT_COUNT, "Number of events processed"),
+    ADD_STAT(hostEventRate,
+             UNIT_RATE(Stats::Units::Count, Stats::Units::Second),
+             "The number of events processed per host second (events/s)"),
+    ADD_STAT(hostEventAllocs, UNIT_COUNT, "Number of events allocated"),
+    ADD_STAT(hostEventAllocHits, UNIT_COUNT,
+             "Number of events allocated from recycled event memory"),
+    ADD_STAT(hostEventAllocHitRate, UNIT_RATIO,
+             "Fraction of events allocated from recycled event memory"),
+    ADD_STAT(hostEventAllocMemory, UNIT_BYTE,
+             "High-water mark of the host memory reserved for events"),
+    ADD_STAT(hostMemPoolAllocs, UNIT_COUNT,
+             "Number of packets, requests and packet buffers allocated"),
+    ADD_STAT(hostMemPoolAllocHits, UNIT_COUNT,
+             "Number of packets, requests and packet buffers allocated "
+             "from recycled memory"),
+    ADD_STAT(hostMemPoolAllocHitRate, UNIT_RATIO,
+             "Fraction of packets, requests and packet buffers allocated "
+             "from recycled memory"),
+    ADD_STAT(hostMemPoolMemory, UNIT_BYTE,
+             "High-water mark of the host memory reserved for packets, "
+             "requests and packet buffers"),
 
     statTime(true),
-    startTick(0)
+    startTick(0),
+    startEvents(0)
 {
     simFreq.scalar(SimClock::Frequency);
     simTicks.functor([this]() { return curTick() - startTick; });
@@ -79,6 +120,22 @@ Root::RootStats::RootStats()
         .prereq(hostMemory)
         ;
 
+    hostEvents.functor([this]() { return servicedEvents() - startEvents; });
+
+    hostEventAllocs.functor([]() { return eventAllocatorStats().allocs; });
+    hostEventAllocHits.functor([]() { return eventAllocatorStats().hits; });
+    hostEventAllocMemory
+        .functor([]() { return eventAllocatorStats().reserved; })
+        .prereq(hostEventAllocMemory)
+        ;
+
+    hostMemPoolAllocs.functor([]() { return memPoolStats().allocs; });
+    hostMemPoolAllocHits.functor([]() { return memPoolStats().hits; });
+    hostMemPoolMemory
+        .functor([]() { return memPoolStats().reserved; })
+        .prereq(hostMemPoolMemory)
+        ;
+
     hostSeconds
         .functor([this]() {
                 Time now;
@@ -89,9 +146,13 @@ Root::RootStats::RootStats()
         ;
 
     hostTickRate.precision(0);
+    hostEventRate.precision(0);
 
     simSeconds = simTicks / simFreq;
     hostTickRate = simTicks / hostSeconds;
+    hostEventRate = hostEvents / hostSeconds;
+    hostEventAllocHitRate = hostEventAllocHits / hostEventAllocs;
+    hostMemPoolAllocHitRate = hostMemPoolAllocHits / hostMemPoolAllocs;
 }
 
 void
@@ -99,6 +160,7 @@ Root::RootStats::resetStats()
 {
     statTime.setTimer();
     startTick = curTick();
+    startEvents = servicedEvents();
 
     Stats::Group::resetStats();
 }
@@ -178,6 +240,14 @@ Root::Root(const RootParams &p, int)
     lastTime.setTimer();
 
     simQuantum = p.sim_quantum;
+    adaptiveSimQuantum = p.adaptive_quantum;
+    for (uint32_t i = 0; i < p.eventq_lookahead.size(); ++i)
+        getEventQueue(i)->setLookahead(p.eventq_lookahead[i]);
+    setMainEventQueueBackend(p.eventq_backend);
+    setMainEventProfilePeriod(p.event_profile_period);
+    setMainFlightRecorder(p.flight_recorder_events,
+                          p.flight_recorder_messages,
+                          p.flight_recorder_flags);
 
     // Some of the statistics are global and need to be accessed by
     // stat formulas. The most convenient way to implement that is by
@@ -190,6 +260,9 @@ void
 Root::startup()
 {
     timeSyncEnable(params().time_sync_enable);
+
+    // Statistics are only registered once the objects are created
+    startLiveStats(*this, params().live_stats_port, params().live_stats);
 }
 
 void
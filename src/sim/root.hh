@@ -104,6 +104,19 @@ class Root : public SimObject
         Stats::Formula hostTickRate;
         Stats::Value hostMemory;
 
+        Stats::Value hostEvents;
+        Stats::Formula hostEventRate;
+
+        Stats::Value hostEventAllocs;
+        Stats::Value hostEventAllocHits;
+        Stats::Formula hostEventAllocHitRate;
+        Stats::Value hostEventAllocMemory;
+
+        Stats::Value hostMemPoolAllocs;
+        Stats::Value hostMemPoolAllocHits;
+        Stats::Formula hostMemPoolAllocHitRate;
+        Stats::Value hostMemPoolMemory;
+
         static RootStats instance;
 
       private:
@@ -114,6 +127,7 @@ class Root : public SimObject
 
         Time statTime;
         Tick startTick;
+        uint64_t startEvents;
     };
 
   public:
@@ -53,6 +53,7 @@
 #include <string>
 #include <vector>
 
+#include "base/binary_inifile.hh"
 #include "base/inifile.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
@@ -181,13 +182,29 @@ Serializable::unserializeSection(CheckpointIn &cp, const char *name)
 }
 
 void
-Serializable::serializeAll(const std::string &cpt_dir)
+Serializable::serializeAll(const std::string &cpt_dir, bool binary)
 {
     std::string dir = CheckpointIn::setDir(cpt_dir);
     if (mkdir(dir.c_str(), 0775) == -1 && errno != EEXIST)
             fatal("couldn't mkdir %s\n", dir);
 
     std::string cpt_file = dir + CheckpointIn::baseFilename;
+    if (binary) {
+        // The writer encodes the ini text as it is produced, so the
+        // serialize() methods don't need to know about the format.
+        BinaryIniWriter writer(cpt_file);
+        fatal_if(!writer.good(), "Unable to open file %s for writing\n",
+                 cpt_file);
+        std::ostream outstream(&writer);
+
+        globals.serializeSection(outstream, "Globals");
+        SimObject::serializeAll(outstream);
+
+        fatal_if(!writer.close(), "Failed to write checkpoint file %s\n",
+                 cpt_file);
+        return;
+    }
+
     std::ofstream outstream(cpt_file.c_str());
     time_t t = time(NULL);
     if (!outstream.is_open())
@@ -266,10 +283,19 @@ CheckpointIn::dir()
 
 CheckpointIn::CheckpointIn(const std::string &cpt_dir,
         SimObjectResolver &resolver)
-    : db(new IniFile), objNameResolver(resolver), _cptDir(setDir(cpt_dir))
+    : db(nullptr), objNameResolver(resolver), _cptDir(setDir(cpt_dir))
 {
     std::string filename = getCptDir() + "/" + CheckpointIn::baseFilename;
-    if (!db->load(filename)) {
+    bool loaded;
+    if (BinaryIni::isBinary(filename)) {
+        BinaryIniFile *bin = new BinaryIniFile;
+        loaded = bin->load(filename);
+        db = bin;
+    } else {
+        db = new IniFile;
+        loaded = db->load(filename);
+    }
+    if (!loaded) {
         fatal("Can't load checkpoint file '%s'\n", filename);
     }
 }
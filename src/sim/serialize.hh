@@ -308,9 +308,15 @@ class Serializable
     /**
      * Serializes all the SimObjects.
      *
+     * @param cpt_dir Directory to write the checkpoint to.
+     * @param binary Write m5.cpt in the indexed binary format (see
+     * base/binary_inifile.hh) rather than as an ini file. Both formats
+     * are detected automatically on restore.
+     *
      * @ingroup api_serialize
      */
-    static void serializeAll(const std::string &cpt_dir);
+    static void serializeAll(const std::string &cpt_dir,
+                             bool binary=false);
 
     /**
      * @ingroup api_serialize
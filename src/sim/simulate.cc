@@ -38,6 +38,7 @@
 #include "base/types.hh"
 #include "sim/async.hh"
 #include "sim/eventq.hh"
+#include "sim/flight_recorder.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
 #include "sim/stat_control.hh"
@@ -113,11 +114,13 @@ simulate(Tick num_cycles)
     GlobalSyncEvent *quantum_event = NULL;
     if (numMainEventQueues > 1) {
         if (simQuantum == 0) {
-            fatal("Quantum for multi-eventq simulation not specified");
+            fatal("Quantum for multi-eventq simulation not specified, "
+                  "set Root.sim_quantum or Root.eventq_partitioning");
         }
 
         quantum_event = new GlobalSyncEvent(curTick() + simQuantum, simQuantum,
-                            EventBase::Progress_Event_Pri, 0);
+                            EventBase::Progress_Event_Pri, 0,
+                            adaptiveSimQuantum);
 
         inParallelMode = true;
     }
@@ -202,6 +205,11 @@ doSimLoop(EventQueue *eventq)
                 pollQueue.service();
             }
 
+            if (async_flightdump) {
+                async_flightdump = false;
+                dumpMainFlightRecorders("SIGQUIT received");
+            }
+
             if (async_exit) {
                 async_exit = false;
                 exitSimLoop("user interrupt received");
@@ -213,7 +221,7 @@ doSimLoop(EventQueue *eventq)
             }
         }
 
-        Event *exit_event = eventq->serviceOne();
+        Event *exit_event = eventq->serviceBin();
         if (exit_event != NULL) {
             return exit_event;
         }
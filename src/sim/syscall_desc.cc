@@ -31,6 +31,7 @@
 
 #include "base/types.hh"
 #include "sim/syscall_debug_macros.hh"
+#include "sim/system.hh"
 
 class ThreadContext;
 
@@ -39,7 +40,11 @@ SyscallDesc::doSyscall(ThreadContext *tc)
 {
     DPRINTF_SYSCALL(Base, "Calling %s...\n", dumper(name(), tc));
 
-    SyscallReturn retval = executor(this, tc);
+    SyscallReturn retval;
+    {
+        System::ScopedThreadsLock lock(*tc->getSystemPtr());
+        retval = executor(this, tc);
+    }
 
     if (retval.needsRetry())
         DPRINTF_SYSCALL(Base, "Needs retry.\n", name());
@@ -84,6 +84,7 @@
 #include <cerrno>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "arch/generic/tlb.hh"
 #include "arch/utility.hh"
@@ -1567,10 +1568,22 @@ readvFunc(SyscallDesc *desc, ThreadContext *tc,
 
     PortProxy &prox = tc->getVirtProxy();
     typename OS::tgt_iovec tiov[count];
+    prox.readBlob(tiov_base, tiov, count * sizeof(typename OS::tgt_iovec));
+
+    std::vector<struct iovec> direct_iov;
+    bool direct = true;
+    for (size_t i = 0; i < count && direct; ++i) {
+        direct = p->hostBuffers(gtoh(tiov[i].iov_base, OS::byteOrder),
+                                gtoh(tiov[i].iov_len, OS::byteOrder),
+                                direct_iov);
+    }
+    if (direct) {
+        int result = readv(sim_fd, direct_iov.data(), direct_iov.size());
+        return (result == -1) ? -errno : result;
+    }
+
     struct iovec hiov[count];
     for (size_t i = 0; i < count; ++i) {
-        prox.readBlob(tiov_base + (i * sizeof(typename OS::tgt_iovec)),
-                      &tiov[i], sizeof(typename OS::tgt_iovec));
         hiov[i].iov_len = gtoh(tiov[i].iov_len, OS::byteOrder);
         hiov[i].iov_base = new char [hiov[i].iov_len];
     }
@@ -1580,7 +1593,7 @@ readvFunc(SyscallDesc *desc, ThreadContext *tc,
 
     for (size_t i = 0; i < count; ++i) {
         if (result != -1) {
-            prox.writeBlob(htog(tiov[i].iov_base, OS::byteOrder),
+            prox.writeBlob(gtoh(tiov[i].iov_base, OS::byteOrder),
                            hiov[i].iov_base, hiov[i].iov_len);
         }
         delete [] (char *)hiov[i].iov_base;
@@ -1603,16 +1616,27 @@ writevFunc(SyscallDesc *desc, ThreadContext *tc,
     int sim_fd = hbfdp->getSimFD();
 
     PortProxy &prox = tc->getVirtProxy();
+    typename OS::tgt_iovec tiov[count];
+    prox.readBlob(tiov_base, tiov, count * sizeof(typename OS::tgt_iovec));
+
+    std::vector<struct iovec> direct_iov;
+    bool direct = true;
+    for (size_t i = 0; i < count && direct; ++i) {
+        direct = p->hostBuffers(gtoh(tiov[i].iov_base, OS::byteOrder),
+                                gtoh(tiov[i].iov_len, OS::byteOrder),
+                                direct_iov);
+    }
+    if (direct) {
+        int result = writev(sim_fd, direct_iov.data(), direct_iov.size());
+        return (result == -1) ? -errno : result;
+    }
+
     struct iovec hiov[count];
     for (size_t i = 0; i < count; ++i) {
-        typename OS::tgt_iovec tiov;
-
-        prox.readBlob(tiov_base + i*sizeof(typename OS::tgt_iovec),
-                      &tiov, sizeof(typename OS::tgt_iovec));
-        hiov[i].iov_len = gtoh(tiov.iov_len, OS::byteOrder);
+        hiov[i].iov_len = gtoh(tiov[i].iov_len, OS::byteOrder);
         hiov[i].iov_base = new char [hiov[i].iov_len];
-        prox.readBlob(gtoh(tiov.iov_base, OS::byteOrder), hiov[i].iov_base,
-                      hiov[i].iov_len);
+        prox.readBlob(gtoh(tiov[i].iov_base, OS::byteOrder),
+                      hiov[i].iov_base, hiov[i].iov_len);
     }
 
     int result = writev(sim_fd, hiov, count);
@@ -1778,6 +1802,12 @@ pread64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
+    std::vector<struct iovec> hiov;
+    if (p->hostBuffers(bufPtr, nbytes, hiov)) {
+        int bytes_read = preadv(sim_fd, hiov.data(), hiov.size(), offset);
+        return (bytes_read == -1) ? -errno : bytes_read;
+    }
+
     BufferArg bufArg(bufPtr, nbytes);
 
     int bytes_read = pread(sim_fd, bufArg.bufferPtr(), nbytes, offset);
@@ -1799,6 +1829,13 @@ pwrite64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
+    std::vector<struct iovec> hiov;
+    if (p->hostBuffers(bufPtr, nbytes, hiov)) {
+        int bytes_written = pwritev(sim_fd, hiov.data(), hiov.size(),
+                                    offset);
+        return (bytes_written == -1) ? -errno : bytes_written;
+    }
+
     BufferArg bufArg(bufPtr, nbytes);
     bufArg.copyIn(tc->getVirtProxy());
 
@@ -2404,6 +2441,12 @@ readFunc(SyscallDesc *desc, ThreadContext *tc,
         && !(hbfdp->getFlags() & OS::TGT_O_NONBLOCK))
         return SyscallReturn::retry();
 
+    std::vector<struct iovec> hiov;
+    if (p->hostBuffers(buf_ptr, nbytes, hiov)) {
+        int bytes_read = readv(sim_fd, hiov.data(), hiov.size());
+        return (bytes_read == -1) ? -errno : bytes_read;
+    }
+
     BufferArg buf_arg(buf_ptr, nbytes);
     int bytes_read = read(sim_fd, buf_arg.bufferPtr(), nbytes);
 
@@ -2425,9 +2468,6 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = hbfdp->getSimFD();
 
-    BufferArg buf_arg(buf_ptr, nbytes);
-    buf_arg.copyIn(tc->getVirtProxy());
-
     struct pollfd pfd;
     pfd.fd = sim_fd;
     pfd.events = POLLOUT;
@@ -2444,7 +2484,15 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
             return SyscallReturn::retry();
     }
 
-    int bytes_written = write(sim_fd, buf_arg.bufferPtr(), nbytes);
+    int bytes_written;
+    std::vector<struct iovec> hiov;
+    if (p->hostBuffers(buf_ptr, nbytes, hiov)) {
+        bytes_written = writev(sim_fd, hiov.data(), hiov.size());
+    } else {
+        BufferArg buf_arg(buf_ptr, nbytes);
+        buf_arg.copyIn(tc->getVirtProxy());
+        bytes_written = write(sim_fd, buf_arg.bufferPtr(), nbytes);
+    }
 
     if (bytes_written != -1)
         fsync(sim_fd);
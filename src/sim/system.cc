@@ -42,6 +42,7 @@
 #include "sim/system.hh"
 
 #include <algorithm>
+#include <functional>
 
 #include "arch/remote_gdb.hh"
 #include "arch/utility.hh"
@@ -215,7 +216,9 @@ System::System(const Params &p)
       kvmVM(nullptr),
 #endif
       physmem(name() + ".physmem", p.memories, p.mmap_using_noreserve,
-              p.shared_backstore),
+              p.shared_backstore, p.checkpoint_shard_size,
+              p.checkpoint_threads, p.backstore_huge_pages,
+              p.restore_image_cache, p.checkpoint_differential),
       memoryMode(p.mem_mode),
       _cacheLineSize(p.cache_line_size),
       workItemsBegin(0),
@@ -506,6 +509,50 @@ System::workItemEnd(uint32_t tid, uint32_t workid)
     lastWorkItemStarted.erase(p);
 }
 
+namespace
+{
+
+/** Whether this host thread holds a System::ScopedThreadsLock. */
+thread_local bool threadsLockHeld = false;
+
+} // anonymous namespace
+
+System::ScopedThreadsLock::ScopedThreadsLock(System &sys)
+{
+    if (!inParallelMode || threadsLockHeld)
+        return;
+
+    EventQueue *cur = curEventQueue();
+    std::vector<EventQueue *> order(1, cur);
+    for (auto *tc : sys.threads) {
+        EventQueue *eq = tc->getCpuPtr()->eventQueue();
+        if (std::find(order.begin(), order.end(), eq) == order.end()) {
+            order.push_back(eq);
+            queues.push_back(eq);
+        }
+    }
+    std::sort(order.begin(), order.end(), std::less<EventQueue *>());
+
+    // Give up the current queue first so that every thread takes the
+    // locks, including the one of its own queue, in the same order.
+    cur->unlock();
+    for (auto *eq : order)
+        eq->lock();
+
+    threadsLockHeld = locked = true;
+}
+
+System::ScopedThreadsLock::~ScopedThreadsLock()
+{
+    if (!locked)
+        return;
+
+    // The current queue was locked before and stays locked.
+    for (auto *eq : queues)
+        eq->unlock();
+    threadsLockHeld = false;
+}
+
 void
 System::printSystems()
 {
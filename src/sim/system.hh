@@ -604,6 +604,32 @@ class System : public SimObject, public PCEventScope
 
     FutexMap futexMap;
 
+    /**
+     * Exclusive access to the syscall emulation state shared by the
+     * threads of this system.
+     *
+     * When the CPUs run on parallel event queues, emulating a system
+     * call or handling an SE mode page fault touches state that other
+     * threads use concurrently: page tables, memory state, file
+     * descriptors, futexes and the other threads' contexts. This takes
+     * the service locks of all event queues hosting the system's
+     * threads, in queue order to avoid deadlocks, so those queues are
+     * stopped between two events while it is held. Queues of other
+     * systems keep running. Nesting is allowed and it does nothing
+     * outside of parallel mode.
+     */
+    class ScopedThreadsLock
+    {
+      public:
+        ScopedThreadsLock(System &sys);
+        ~ScopedThreadsLock();
+
+      private:
+        /** Queues locked in addition to the current one. */
+        std::vector<EventQueue *> queues;
+        bool locked = false;
+    };
+
     static const int maxPID = 32768;
 
     /** Process set to track which PIDs have already been allocated */
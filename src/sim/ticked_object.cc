@@ -48,20 +48,54 @@ Ticked::Ticked(ClockedObject &object_,
     event([this]{ processClockEvent(); }, object_.name(), false, priority),
     running(false),
     lastStopped(0),
+    lastTicked(0),
     /* Allocate numCycles if an external stat wasn't passed in */
     numCyclesLocal((imported_num_cycles ? NULL : new Stats::Scalar)),
     numCycles((imported_num_cycles ? *imported_num_cycles :
         *numCyclesLocal))
-{ }
+{
+    object.onWakeUp([this]{ processWakeUp(); });
+}
 
 void
 Ticked::processClockEvent() {
+    // More than one cycle has passed if a quiescent period was skipped
+    const Cycles now = object.curCycle();
+    const Cycles delta = now > lastTicked ? now - lastTicked : Cycles(1);
+    lastTicked = now;
+
     ++tickCycles;
-    ++numCycles;
-    countCycles(Cycles(1));
+    numCycles += delta;
+    countCycles(delta);
     evaluate();
-    if (running)
-        object.schedule(event, object.clockEdge(Cycles(1)));
+    if (running && !event.scheduled())
+        scheduleNextTick();
+}
+
+void
+Ticked::scheduleNextTick()
+{
+    const Tick next = object.clockEdge(Cycles(1));
+    const Tick wake_up = object.quiescentUntil();
+    if (wake_up <= next) {
+        object.schedule(event, next);
+    } else if (wake_up != MaxTick) {
+        object.schedule(event, wake_up);
+    }
+    // Otherwise, stay idle until processWakeUp() is called.
+}
+
+void
+Ticked::processWakeUp()
+{
+    if (!running)
+        return;
+
+    const Tick next = object.clockEdge(Cycles(1));
+    if (!event.scheduled())
+        object.schedule(event, next);
+    else if (event.when() > next)
+        object.reschedule(event, next);
 }
 
 void
@@ -67,12 +67,24 @@ class Ticked : public Serializable
     /** Evaluate and reschedule */
     void processClockEvent();
 
+    /**
+     * Schedule the next evaluation, skipping the quiescent period of
+     * the object, if any.
+     */
+    void scheduleNextTick();
+
+    /** The object was woken up from a quiescent period */
+    void processWakeUp();
+
     /** Have I been started? and am not stopped */
     bool running;
 
     /** Time of last stop event to calculate run time */
     Cycles lastStopped;
 
+    /** Cycle of the last evaluation, or of the last start */
+    Cycles lastTicked;
+
   private:
     /** Locally allocated stats */
     Stats::Scalar *numCyclesLocal;
@@ -108,6 +120,7 @@ class Ticked : public Serializable
             running = true;
             numCycles += cyclesSinceLastStopped();
             countCycles(cyclesSinceLastStopped());
+            lastTicked = object.curCycle();
         }
     }
 
@@ -151,7 +164,7 @@ class Ticked : public Serializable
      * cycle and when restarting the ticked object. The delta
      * parameter indicates the number of cycles elapsed since the
      * previous call is normally '1' unless the object has been
-     * stopped and restarted.
+     * stopped and restarted or has skipped a quiescent period.
      *
      * @param delta Number of cycles since the previous call.
      */
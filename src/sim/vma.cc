@@ -95,6 +95,19 @@ VMA::sliceRegionLeft(Addr slice_addr)
     sanityCheck();
 }
 
+void
+VMA::extendRegionRight(Addr new_end)
+{
+    assert(!hasHostBuf());
+
+    _addrRange = AddrRange(_addrRange.start(), new_end);
+
+    DPRINTF(Vma, "extend right vma start %#x end %#x\n", _addrRange.start(),
+            _addrRange.end());
+
+    sanityCheck();
+}
+
 void
 VMA::sanityCheck()
 {
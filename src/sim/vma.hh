@@ -101,14 +101,19 @@ class VMA
      */
     void sliceRegionLeft(Addr slice_addr);
 
-    const std::string& getName() { return _vmaName; }
+    /**
+     * Grow an anonymous virtual memory area so that it ends at new_end.
+     */
+    void extendRegionRight(Addr new_end);
+
+    const std::string& getName() const { return _vmaName; }
 
     /**
      * Defer AddrRange related calls to the AddrRange.
      */
-    Addr size() { return _addrRange.size(); }
-    Addr start() { return _addrRange.start(); }
-    Addr end() { return _addrRange.end(); }
+    Addr size() const { return _addrRange.size(); }
+    Addr start() const { return _addrRange.start(); }
+    Addr end() const { return _addrRange.end(); }
 
     bool
     mergesWith(const AddrRange& r) const
@@ -24,6 +24,7 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from m5.SimObject import SimObject, cxxMethod
+from m5.params import *
 
 # This class represents the systemc kernel. There should be exactly one in the
 # simulation. It receives gem5 SimObject lifecycle callbacks (init, regStats,
@@ -33,6 +34,10 @@ class SystemC_Kernel(SimObject):
     cxx_class = 'sc_gem5::Kernel'
     cxx_header = 'systemc/core/kernel.hh'
 
+    tlm_global_quantum = Param.Latency('0ns', "Time loosely timed TLM "
+        "initiators may run ahead of SystemC time (0 keeps the value set "
+        "by sc_main)")
+
 # This class represents systemc sc_object instances in python config files. It
 # inherits from SimObject in python, but the c++ version, sc_core::sc_object,
 # doesn't inherit from gem5's c++ SimObject class.
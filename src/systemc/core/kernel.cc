@@ -33,6 +33,8 @@
 #include "systemc/core/port.hh"
 #include "systemc/core/sc_main_fiber.hh"
 #include "systemc/core/scheduler.hh"
+#include "systemc/ext/core/sc_time.hh"
+#include "systemc/ext/tlm_core/2/quantum/global_quantum.hh"
 
 namespace sc_gem5
 {
@@ -55,7 +57,8 @@ sc_core::sc_status Kernel::status() { return _status; }
 void Kernel::status(sc_core::sc_status s) { _status = s; }
 
 Kernel::Kernel(const Params &params, int) :
-    SimObject(params), t0Event(this, false, EventBase::Default_Pri - 1)
+    SimObject(params), t0Event(this, false, EventBase::Default_Pri - 1),
+    globalQuantum(params.tlm_global_quantum)
 {
     // Install ourselves as the scheduler's event manager.
     ::sc_gem5::scheduler.setEventQueue(eventQueue());
@@ -70,6 +73,11 @@ Kernel::init()
     if (stopAfterCallbacks)
         fatal("Simulation called sc_stop during elaboration.\n");
 
+    if (globalQuantum) {
+        tlm::tlm_global_quantum::instance().set(
+                sc_core::sc_time::from_value(globalQuantum));
+    }
+
     status(::sc_core::SC_BEFORE_END_OF_ELABORATION);
     for (auto p: allPorts)
         p->sc_port_base()->before_end_of_elaboration();
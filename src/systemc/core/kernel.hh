@@ -66,6 +66,9 @@ class Kernel : public SimObject
     static void stopWork();
 
     EventWrapper<Kernel, &Kernel::t0Handler> t0Event;
+
+    /** TLM global quantum to install, 0 to leave it alone */
+    const Tick globalQuantum;
 };
 
 extern Kernel *kernel;
@@ -40,6 +40,8 @@ class Gem5ToTlmBridgeBase(SystemC_ScModule):
     gem5 = ResponsePort('gem5 response port')
     addr_ranges = VectorParam.AddrRange([],
             'Addresses served by this port\'s TLM side')
+    dmi_enable = Param.Bool(True, "Serve atomic and functional accesses "
+            "directly from DMI regions granted by the TLM target")
 
 class TlmToGem5BridgeBase(SystemC_ScModule):
     type = 'TlmToGem5BridgeBase'
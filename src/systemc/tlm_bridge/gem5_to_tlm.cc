@@ -98,10 +98,11 @@ addPacketToPayloadConversionStep(PacketToPayloadConversionStep step)
 
 /**
  * Convert a gem5 packet to a TLM payload by copying all the relevant
- * information to new tlm payload.
+ * information to new tlm payload. The payload's data pointer refers
+ * directly to the packet's data, so no data is copied.
  */
 tlm::tlm_generic_payload *
-packet2payload(PacketPtr packet)
+packet2payload(PacketPtr packet, Gem5SystemC::MemoryManager &mm)
 {
     tlm::tlm_generic_payload *trans = mm.allocate();
     trans->acquire();
@@ -130,8 +131,14 @@ packet2payload(PacketPtr packet)
     }
 
     // Attach the packet pointer to the TLM transaction to keep track.
-    auto *extension = new Gem5SystemC::Gem5Extension(packet);
-    trans->set_auto_extension(extension);
+    // The extension isn't freed when the payload is returned to the
+    // memory manager, so recycled payloads only need it updated.
+    Gem5SystemC::Gem5Extension *extension = nullptr;
+    trans->get_extension(extension);
+    if (extension)
+        extension->setPacket(packet);
+    else
+        trans->set_extension(new Gem5SystemC::Gem5Extension(packet));
 
     // Apply all conversion steps necessary in this specific setup.
     for (auto &step : extraPacketToPayloadSteps) {
@@ -141,6 +148,12 @@ packet2payload(PacketPtr packet)
     return trans;
 }
 
+tlm::tlm_generic_payload *
+packet2payload(PacketPtr packet)
+{
+    return packet2payload(packet, mm);
+}
+
 template <unsigned int BITWIDTH>
 void
 Gem5ToTlmBridge<BITWIDTH>::pec(
@@ -204,7 +217,7 @@ Gem5ToTlmBridge<BITWIDTH>::getBackdoor(tlm::tlm_generic_payload &trans)
     AddrRange r(start, end);
     auto it = backdoorMap.contains(r);
     if (it != backdoorMap.end())
-        return it->second;
+        return it->second.backdoor;
 
     // If not, ask the target for one.
     tlm::tlm_dmi dmi_data;
@@ -219,11 +232,49 @@ Gem5ToTlmBridge<BITWIDTH>::getBackdoor(tlm::tlm_generic_payload &trans)
     backdoor->readable(dmi_data.is_read_allowed());
     backdoor->writeable(dmi_data.is_write_allowed());
 
-    backdoorMap.insert(dmi_r, backdoor);
+    backdoorMap.insert(dmi_r, DmiRegion{backdoor,
+            dmi_data.get_read_latency(), dmi_data.get_write_latency()});
 
     return backdoor;
 }
 
+template <unsigned int BITWIDTH>
+MemBackdoorPtr
+Gem5ToTlmBridge<BITWIDTH>::accessDmi(PacketPtr packet, Tick &latency)
+{
+    if (!dmiEnabled || backdoorMap.empty())
+        return nullptr;
+
+    // Only plain reads and writes can be served from host memory.
+    if ((packet->req->getFlags() & Request::NO_ACCESS) != 0 ||
+            packet->isRead() == packet->isWrite() || packet->isLLSC()) {
+        return nullptr;
+    }
+
+    AddrRange r(packet->getAddr(), packet->getAddr() + packet->getSize());
+    auto it = backdoorMap.contains(r);
+    if (it == backdoorMap.end())
+        return nullptr;
+
+    const DmiRegion &dmi = it->second;
+    uint8_t *host = dmi.backdoor->ptr() +
+        (packet->getAddr() - dmi.backdoor->range().start());
+
+    if (packet->isRead()) {
+        if (!dmi.backdoor->readable())
+            return nullptr;
+        packet->setData(host);
+        latency = dmi.readLatency.value();
+    } else {
+        if (!dmi.backdoor->writeable())
+            return nullptr;
+        packet->writeData(host);
+        latency = dmi.writeLatency.value();
+    }
+
+    return dmi.backdoor;
+}
+
 // Similar to TLM's blocking transport (LT)
 template <unsigned int BITWIDTH>
 Tick
@@ -232,14 +283,25 @@ Gem5ToTlmBridge<BITWIDTH>::recvAtomic(PacketPtr packet)
     panic_if(packet->cacheResponding(),
              "Should not see packets where cache is responding");
 
+    Tick latency;
+    if (accessDmi(packet, latency)) {
+        if (packet->needsResponse())
+            packet->makeResponse();
+        return latency;
+    }
+
     // Prepare the transaction.
-    auto *trans = packet2payload(packet);
+    auto *trans = packet2payload(packet, mm);
 
     sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
 
     if (trans->get_command() != tlm::TLM_IGNORE_COMMAND) {
         // Execute b_transport:
         socket->b_transport(*trans, delay);
+        // If the hint said we could use DMI, remember the region so
+        // that later accesses can bypass the transport interface.
+        if (dmiEnabled && trans->is_dmi_allowed())
+            getBackdoor(*trans);
     }
 
     if (packet->needsResponse())
@@ -258,10 +320,18 @@ Gem5ToTlmBridge<BITWIDTH>::recvAtomicBackdoor(
     panic_if(packet->cacheResponding(),
              "Should not see packets where cache is responding");
 
+    Tick latency;
+    backdoor = accessDmi(packet, latency);
+    if (backdoor) {
+        if (packet->needsResponse())
+            packet->makeResponse();
+        return latency;
+    }
+
     sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
 
     // Prepare the transaction.
-    auto *trans = packet2payload(packet);
+    auto *trans = packet2payload(packet, mm);
 
     if (trans->get_command() != tlm::TLM_IGNORE_COMMAND) {
         // Execute b_transport:
@@ -323,7 +393,7 @@ Gem5ToTlmBridge<BITWIDTH>::recvTimingReq(PacketPtr packet)
      */
 
     // Prepare the transaction.
-    auto *trans = packet2payload(packet);
+    auto *trans = packet2payload(packet, mm);
 
     /*
      * Pay for annotated transport delays.
@@ -423,8 +493,12 @@ template <unsigned int BITWIDTH>
 void
 Gem5ToTlmBridge<BITWIDTH>::recvFunctional(PacketPtr packet)
 {
+    Tick latency;
+    if (accessDmi(packet, latency))
+        return;
+
     // Prepare the transaction.
-    auto *trans = packet2payload(packet);
+    auto *trans = packet2payload(packet, mm);
 
     /* Execute Debug Transport: */
     unsigned int bytes = socket->transport_dbg(*trans);
@@ -459,8 +533,8 @@ Gem5ToTlmBridge<BITWIDTH>::invalidate_direct_mem_ptr(
         if (it == backdoorMap.end())
             break;
 
-        it->second->invalidate();
-        delete it->second;
+        it->second.backdoor->invalidate();
+        delete it->second.backdoor;
         backdoorMap.erase(it);
     };
 }
@@ -474,7 +548,8 @@ Gem5ToTlmBridge<BITWIDTH>::Gem5ToTlmBridge(
     wrapper(socket, std::string(name()) + ".tlm", InvalidPortID),
     system(params.system), blockingRequest(nullptr),
     needToSendRequestRetry(false), blockingResponse(nullptr),
-    addrRanges(params.addr_ranges.begin(), params.addr_ranges.end())
+    addrRanges(params.addr_ranges.begin(), params.addr_ranges.end()),
+    dmiEnabled(params.dmi_enable)
 {
 }
 
@@ -69,6 +69,7 @@
 #include "systemc/ext/core/sc_module_name.hh"
 #include "systemc/ext/tlm_core/2/generic_payload/gp.hh"
 #include "systemc/ext/tlm_utils/simple_initiator_socket.h"
+#include "systemc/tlm_bridge/sc_mm.hh"
 #include "systemc/tlm_port_wrapper.hh"
 
 namespace sc_gem5
@@ -80,6 +81,8 @@ using PacketToPayloadConversionStep =
 void addPacketToPayloadConversionStep(PacketToPayloadConversionStep step);
 
 tlm::tlm_generic_payload *packet2payload(PacketPtr packet);
+tlm::tlm_generic_payload *packet2payload(PacketPtr packet,
+                                         Gem5SystemC::MemoryManager &mm);
 
 class Gem5ToTlmBridgeBase : public sc_core::sc_module
 {
@@ -167,11 +170,39 @@ class Gem5ToTlmBridge : public Gem5ToTlmBridgeBase
 
     AddrRangeList addrRanges;
 
+    /**
+     * Payloads are pooled per bridge so that they, and the gem5
+     * extension attached to them, are recycled rather than allocated
+     * for every transaction.
+     */
+    Gem5SystemC::MemoryManager mm;
+
+    /** Serve atomic and functional accesses through granted DMI regions */
+    const bool dmiEnabled;
+
   protected:
     void pec(tlm::tlm_generic_payload &trans, const tlm::tlm_phase &phase);
 
+    /** A DMI region granted by the target and its access latencies */
+    struct DmiRegion
+    {
+        MemBackdoorPtr backdoor;
+        sc_core::sc_time readLatency;
+        sc_core::sc_time writeLatency;
+    };
+
     MemBackdoorPtr getBackdoor(tlm::tlm_generic_payload &trans);
-    AddrRangeMap<MemBackdoorPtr> backdoorMap;
+    AddrRangeMap<DmiRegion> backdoorMap;
+
+    /**
+     * Try to complete an access directly through a DMI region we
+     * already know about, bypassing the TLM transport interface.
+     *
+     * @param packet the access to perform.
+     * @param latency set to the access latency given by the target.
+     * @return the back door used, or nullptr if the access wasn't done.
+     */
+    MemBackdoorPtr accessDmi(PacketPtr packet, Tick &latency);
 
     // The gem5 port interface.
     Tick recvAtomic(PacketPtr packet);
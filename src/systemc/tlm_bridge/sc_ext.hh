@@ -53,6 +53,7 @@ class Gem5Extension: public tlm::tlm_extension<Gem5Extension>
     static Gem5Extension &getExtension(
             const tlm::tlm_generic_payload &payload);
     PacketPtr getPacket();
+    void setPacket(PacketPtr _packet) { packet = _packet; }
 
   private:
     PacketPtr packet;
@@ -64,6 +64,7 @@
 #include "sim/system.hh"
 #include "systemc/ext/core/sc_module_name.hh"
 #include "systemc/ext/core/sc_time.hh"
+#include "systemc/ext/tlm_core/2/quantum/global_quantum.hh"
 
 namespace sc_gem5
 {
@@ -109,7 +110,7 @@ payload2packet(RequestorID _id, tlm::tlm_generic_payload &trans)
     }
 
     Request::Flags flags;
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         trans.get_address(), trans.get_data_length(), flags, _id);
 
     /*
@@ -163,15 +164,9 @@ TlmToGem5Bridge<BITWIDTH>::sendBeginResp(tlm::tlm_generic_payload &trans,
 }
 
 template <unsigned int BITWIDTH>
-void
-TlmToGem5Bridge<BITWIDTH>::handleBeginReq(tlm::tlm_generic_payload &trans)
+PacketPtr
+TlmToGem5Bridge<BITWIDTH>::prepareRequest(tlm::tlm_generic_payload &trans)
 {
-    sc_assert(!waitForRetry);
-    sc_assert(pendingRequest == nullptr);
-    sc_assert(pendingPacket == nullptr);
-
-    trans.acquire();
-
     PacketPtr pkt = nullptr;
 
     Gem5SystemC::Gem5Extension *extension = nullptr;
@@ -189,6 +184,21 @@ TlmToGem5Bridge<BITWIDTH>::handleBeginReq(tlm::tlm_generic_payload &trans)
     auto tlmSenderState = new TlmSenderState(trans);
     pkt->pushSenderState(tlmSenderState);
 
+    return pkt;
+}
+
+template <unsigned int BITWIDTH>
+void
+TlmToGem5Bridge<BITWIDTH>::handleBeginReq(tlm::tlm_generic_payload &trans)
+{
+    sc_assert(!waitForRetry);
+    sc_assert(pendingRequest == nullptr);
+    sc_assert(pendingPacket == nullptr);
+
+    trans.acquire();
+
+    PacketPtr pkt = prepareRequest(trans);
+
     // If the packet doesn't need a response, we should send BEGIN_RESP by
     // ourselves.
     bool needsResponse = pkt->needsResponse();
@@ -288,10 +298,57 @@ TlmToGem5Bridge<BITWIDTH>::nb_transport_fw(
 
     // ... and queue the valid transaction
     trans.acquire();
+
+    // Initiators that are temporally decoupled run ahead of SystemC time
+    // within the global quantum. Waiting in the PEQ for time to catch up
+    // would cost an event and a context switch per transaction, so the
+    // request goes to gem5 right away instead.
+    if (phase == tlm::BEGIN_REQ &&
+            tlm::tlm_global_quantum::instance().get() !=
+            sc_core::SC_ZERO_TIME) {
+        return sendDecoupledReq(trans, phase, delay);
+    }
+
     peq.notify(trans, phase, delay);
     return tlm::TLM_ACCEPTED;
 }
 
+template <unsigned int BITWIDTH>
+tlm::tlm_sync_enum
+TlmToGem5Bridge<BITWIDTH>::sendDecoupledReq(tlm::tlm_generic_payload &trans,
+                                            tlm::tlm_phase &phase,
+                                            sc_core::sc_time &delay)
+{
+    sc_assert(!waitForRetry);
+
+    PacketPtr pkt = prepareRequest(trans);
+    // gem5 components account for the header delay, which makes the
+    // request take effect at the initiator's local time.
+    pkt->headerDelay = delay.value();
+
+    bool needsResponse = pkt->needsResponse();
+    if (!bmp.sendTimingReq(pkt)) {
+        // The port is blocked, so wait for a retry as usual. By then
+        // SystemC time has caught up and END_REQ is sent backwards.
+        pkt->headerDelay = 0;
+        trans.acquire();
+        waitForRetry = true;
+        pendingRequest = &trans;
+        pendingPacket = pkt;
+        return tlm::TLM_ACCEPTED;
+    }
+
+    if (needsResponse) {
+        phase = tlm::END_REQ;
+        return tlm::TLM_UPDATED;
+    }
+
+    // No response will come back from gem5.
+    trans.set_response_status(tlm::TLM_OK_RESPONSE);
+    trans.release();
+    return tlm::TLM_COMPLETED;
+}
+
 template <unsigned int BITWIDTH>
 void
 TlmToGem5Bridge<BITWIDTH>::b_transport(tlm::tlm_generic_payload &trans,
@@ -137,9 +137,20 @@ class TlmToGem5Bridge : public TlmToGem5BridgeBase
     void sendBeginResp(tlm::tlm_generic_payload &trans,
                        sc_core::sc_time &delay);
 
+    PacketPtr prepareRequest(tlm::tlm_generic_payload &trans);
+
     void handleBeginReq(tlm::tlm_generic_payload &trans);
     void handleEndResp(tlm::tlm_generic_payload &trans);
 
+    /**
+     * Send a request to gem5 as soon as it arrives, rather than when
+     * SystemC time catches up with the initiator's local time. The
+     * local time offset is carried in the packet's header delay.
+     */
+    tlm::tlm_sync_enum sendDecoupledReq(tlm::tlm_generic_payload &trans,
+                                        tlm::tlm_phase &phase,
+                                        sc_core::sc_time &delay);
+
     void destroyPacket(PacketPtr pkt);
 
     void checkTransaction(tlm::tlm_generic_payload &trans);
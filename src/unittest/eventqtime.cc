@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2021 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Event queue microbenchmark.
+ *
+ * Replays the scheduling activity of a simulation on every event queue
+ * backend and reports the time spent by each of them. Traces are
+ * recorded by running gem5 with --debug-flags=Event; lines that are
+ * not event trace messages are ignored. Without a trace, a synthetic
+ * "hold" workload with a fixed number of pending events is used.
+ *
+ * usage: eventqtime trace <file>
+ *        eventqtime hold <pending events> <operations>
+ */
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/random.hh"
+#include "base/str.hh"
+#include "base/time.hh"
+#include "sim/eventq.hh"
+
+namespace
+{
+
+const std::vector<std::pair<EventQueueBackend, const char *>> backends = {
+    { EventQueueBackend::list, "list" },
+    { EventQueueBackend::calendar, "calendar" },
+};
+
+class ReplayEvent : public Event
+{
+  public:
+    void process() override {}
+    const char *description() const override { return "replay"; }
+};
+
+/**
+ * Synthetic event that keeps itself scheduled, modelling a clocked
+ * object with a fixed period.
+ */
+class HoldEvent : public Event
+{
+  private:
+    EventQueue &queue;
+    Tick period;
+
+  public:
+    HoldEvent(EventQueue &_queue, Tick _period)
+        : queue(_queue), period(_period)
+    {}
+
+    void
+    process() override
+    {
+        queue.schedule(this, queue.getCurTick() + period);
+    }
+
+    const char *description() const override { return "hold"; }
+};
+
+struct TraceOp
+{
+    enum Type { Schedule, Deschedule, Reschedule, Execute };
+
+    Type type;
+    size_t event;
+    Tick when;
+};
+
+/**
+ * Parse an Event debug trace. Messages end with
+ * "<instance> <action> @ <when>", the instance string is used to tell
+ * events apart.
+ */
+size_t
+parseTrace(std::istream &is, std::vector<TraceOp> &ops)
+{
+    std::unordered_map<std::string, size_t> ids;
+    std::string line;
+    while (std::getline(is, line)) {
+        std::vector<std::string> tokens;
+        tokenize(tokens, line, ' ', true);
+        if (tokens.size() < 4 || tokens[tokens.size() - 2] != "@")
+            continue;
+
+        TraceOp op;
+        const std::string &action = tokens[tokens.size() - 3];
+        if (action == "scheduled")
+            op.type = TraceOp::Schedule;
+        else if (action == "descheduled")
+            op.type = TraceOp::Deschedule;
+        else if (action == "rescheduled")
+            op.type = TraceOp::Reschedule;
+        else if (action == "executed")
+            op.type = TraceOp::Execute;
+        else
+            continue;
+
+        if (!to_number(tokens.back(), op.when))
+            continue;
+
+        auto id = ids.emplace(tokens[tokens.size() - 4], ids.size());
+        op.event = id.first->second;
+        ops.push_back(op);
+    }
+
+    return ids.size();
+}
+
+void
+replay(EventQueue &queue, const std::vector<TraceOp> &ops,
+       std::vector<ReplayEvent> &events)
+{
+    // Events that were pending when tracing started, or that ran in
+    // a slightly different order because the trace doesn't record
+    // priorities, are simply skipped.
+    for (const auto &op : ops) {
+        ReplayEvent &event = events[op.event];
+        switch (op.type) {
+          case TraceOp::Schedule:
+          case TraceOp::Reschedule:
+            if (op.when < queue.getCurTick())
+                break;
+            if (event.scheduled())
+                queue.reschedule(&event, op.when);
+            else
+                queue.schedule(&event, op.when);
+            break;
+          case TraceOp::Deschedule:
+            if (event.scheduled())
+                queue.deschedule(&event);
+            break;
+          case TraceOp::Execute:
+            if (event.scheduled())
+                queue.serviceOne();
+            break;
+        }
+    }
+}
+
+void
+report(const char *backend, uint64_t ops, const Time &elapsed)
+{
+    const double seconds = elapsed;
+    cprintf("%-10s %d operations in %.3fs (%.1f ns/op)\n", backend, ops,
+            seconds, ops ? seconds * 1e9 / ops : 0.0);
+}
+
+void
+runTrace(const char *file)
+{
+    std::ifstream is(file);
+    if (!is)
+        panic("Can't open trace file '%s'\n", file);
+
+    std::vector<TraceOp> ops;
+    const size_t num_events = parseTrace(is, ops);
+    cprintf("%d trace operations on %d events\n", ops.size(), num_events);
+
+    for (const auto &backend : backends) {
+        std::vector<ReplayEvent> events(num_events);
+        EventQueue queue("replay", backend.first);
+        curEventQueue(&queue);
+
+        Time start, end;
+        start.setTimer();
+        replay(queue, ops, events);
+        end.setTimer();
+
+        report(backend.second, ops.size(), end - start);
+        curEventQueue(nullptr);
+    }
+}
+
+void
+runHold(size_t pending, uint64_t num_ops)
+{
+    for (const auto &backend : backends) {
+        // Use the same periods for every backend.
+        Random rng(0);
+        std::vector<HoldEvent *> events;
+        EventQueue queue("hold", backend.first);
+        curEventQueue(&queue);
+
+        for (size_t i = 0; i < pending; ++i) {
+            const Tick period = rng.random<Tick>(1, 1000) * 500;
+            events.push_back(new HoldEvent(queue, period));
+            queue.schedule(events.back(), rng.random<Tick>(0, period));
+        }
+
+        Time start, end;
+        start.setTimer();
+        for (uint64_t i = 0; i < num_ops; ++i)
+            queue.serviceOne();
+        end.setTimer();
+
+        report(backend.second, num_ops, end - start);
+
+        for (auto *event : events) {
+            queue.deschedule(event);
+            delete event;
+        }
+        curEventQueue(nullptr);
+    }
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char *argv[])
+{
+    const std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "trace" && argc == 3) {
+        runTrace(argv[2]);
+    } else if (mode == "hold" && argc == 4) {
+        size_t pending;
+        uint64_t num_ops;
+        if (!to_number(argv[2], pending) || !to_number(argv[3], num_ops))
+            panic("Invalid hold model parameters\n");
+        runHold(pending, num_ops);
+    } else {
+        panic("usage: %s trace <file>\n"
+              "       %s hold <pending events> <operations>\n",
+              argv[0], argv[0]);
+    }
+
+    return 0;
+}
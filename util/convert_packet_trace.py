@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2021 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts packet traces between the protobuf format of
+# src/proto/packet.proto and the block based format of
+# src/proto/packet_trace.hh, in either direction. Protobuf traces are
+# compressed if the output file name ends with .gz.
+
+import argparse
+import gzip
+import os
+import struct
+import subprocess
+import sys
+import zlib
+
+import protolib
+
+util_dir = os.path.dirname(os.path.realpath(__file__))
+# Make sure the proto definitions are up to date.
+subprocess.check_call(['make', '--quiet', '-C', util_dir, 'packet_pb2.py'])
+import packet_pb2
+
+FILE_MAGIC = b'gem5ptrc'
+VERSION = 1
+BLOCK_MAGIC = 0x6b6c6270
+
+HAS_FLAGS = 0x1
+HAS_PKT_ID = 0x2
+HAS_PC = 0x4
+
+# Column order of a block, see PacketTraceBlock::Column
+TICK, CMD, ADDR, SIZE, FIELDS, FLAGS, PKT_ID, PC = range(8)
+NUM_COLUMNS = 8
+
+MASK64 = (1 << 64) - 1
+
+def put_varint(buf, value):
+    while value >= 0x80:
+        buf.append((value & 0x7f) | 0x80)
+        value >>= 7
+    buf.append(value)
+
+def get_varint(buf, pos):
+    value = 0
+    shift = 0
+    while True:
+        byte = buf[pos]
+        pos += 1
+        value |= (byte & 0x7f) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+def zigzag(value, prev):
+    delta = (value - prev) & MASK64
+    if delta & (1 << 63):
+        delta -= 1 << 64
+    return ((delta << 1) ^ (delta >> 63)) & MASK64
+
+def unzigzag(value, prev):
+    return (prev + ((value >> 1) ^ -(value & 1))) & MASK64
+
+def encode_block(packets):
+    columns = [bytearray() for _ in range(NUM_COLUMNS)]
+    prev = { TICK: 0, ADDR: 0, PKT_ID: 0, PC: 0 }
+    for p in packets:
+        fields = 0
+        put_varint(columns[TICK], zigzag(p.tick, prev[TICK]))
+        put_varint(columns[CMD], p.cmd)
+        put_varint(columns[ADDR], zigzag(p.addr, prev[ADDR]))
+        put_varint(columns[SIZE], p.size)
+        if p.HasField('flags'):
+            fields |= HAS_FLAGS
+        if p.HasField('pkt_id'):
+            fields |= HAS_PKT_ID
+        if p.HasField('pc'):
+            fields |= HAS_PC
+        put_varint(columns[FIELDS], fields)
+        if fields & HAS_FLAGS:
+            put_varint(columns[FLAGS], p.flags)
+        if fields & HAS_PKT_ID:
+            put_varint(columns[PKT_ID], zigzag(p.pkt_id, prev[PKT_ID]))
+            prev[PKT_ID] = p.pkt_id
+        if fields & HAS_PC:
+            put_varint(columns[PC], zigzag(p.pc, prev[PC]))
+            prev[PC] = p.pc
+        prev[TICK] = p.tick
+        prev[ADDR] = p.addr
+
+    payload = bytearray()
+    for c in columns:
+        payload += struct.pack('<I', len(c))
+    for c in columns:
+        payload += c
+    return bytes(payload)
+
+def decode_block(payload, num_records):
+    sizes = struct.unpack_from('<%dI' % NUM_COLUMNS, payload)
+    pos = [0] * NUM_COLUMNS
+    offset = 4 * NUM_COLUMNS
+    for c in range(NUM_COLUMNS):
+        pos[c] = offset
+        offset += sizes[c]
+
+    def next_value(c):
+        value, pos[c] = get_varint(payload, pos[c])
+        return value
+
+    prev = { TICK: 0, ADDR: 0, PKT_ID: 0, PC: 0 }
+    for _ in range(num_records):
+        p = packet_pb2.Packet()
+        p.tick = prev[TICK] = unzigzag(next_value(TICK), prev[TICK])
+        p.cmd = next_value(CMD)
+        p.addr = prev[ADDR] = unzigzag(next_value(ADDR), prev[ADDR])
+        p.size = next_value(SIZE)
+        fields = next_value(FIELDS)
+        if fields & HAS_FLAGS:
+            p.flags = next_value(FLAGS)
+        if fields & HAS_PKT_ID:
+            p.pkt_id = prev[PKT_ID] = unzigzag(next_value(PKT_ID),
+                                               prev[PKT_ID])
+        if fields & HAS_PC:
+            p.pc = prev[PC] = unzigzag(next_value(PC), prev[PC])
+        yield p
+
+def write_block(block_out, packets, compress):
+    payload = encode_block(packets)
+    stored = zlib.compress(payload) if compress else payload
+    block_out.write(struct.pack('<4I', BLOCK_MAGIC, len(packets),
+                                len(stored), len(payload)))
+    block_out.write(stored)
+
+def proto_to_block(in_file, out_file, compress, block_records):
+    proto_in = protolib.openFileRd(in_file)
+    if proto_in.read(4) != b'gem5':
+        print("Unrecognized file", in_file)
+        exit(-1)
+
+    header = packet_pb2.PacketHeader()
+    protolib.decodeMessage(proto_in, header)
+
+    with open(out_file, 'wb') as block_out:
+        obj_id = header.obj_id.encode()
+        block_out.write(FILE_MAGIC)
+        block_out.write(struct.pack('<IIQI', VERSION, 1 if compress else 0,
+                                    header.tick_freq, len(obj_id)))
+        block_out.write(obj_id)
+        block_out.write(struct.pack('<I', len(header.id_strings)))
+        for id_string in header.id_strings:
+            value = id_string.value.encode()
+            block_out.write(struct.pack('<II', id_string.key, len(value)))
+            block_out.write(value)
+
+        num_packets = 0
+        packets = []
+        packet = packet_pb2.Packet()
+        while protolib.decodeMessage(proto_in, packet):
+            packets.append(packet)
+            packet = packet_pb2.Packet()
+            if len(packets) == block_records:
+                write_block(block_out, packets, compress)
+                num_packets += len(packets)
+                packets = []
+        if packets:
+            write_block(block_out, packets, compress)
+            num_packets += len(packets)
+
+    proto_in.close()
+    print("Converted packets:", num_packets)
+
+def block_to_proto(in_file, out_file):
+    with open(in_file, 'rb') as block_in:
+        data = block_in.read()
+
+    if data[:8] != FILE_MAGIC:
+        print("Unrecognized file", in_file)
+        exit(-1)
+
+    version, flags, tick_freq, obj_id_len = struct.unpack_from('<IIQI',
+                                                               data, 8)
+    if version != VERSION:
+        print("Unsupported packet trace version", version)
+        exit(-1)
+    compressed = flags & 1
+    pos = 28
+
+    header = packet_pb2.PacketHeader()
+    header.obj_id = data[pos:pos + obj_id_len].decode()
+    header.tick_freq = tick_freq
+    pos += obj_id_len
+    num_id_strings, = struct.unpack_from('<I', data, pos)
+    pos += 4
+    for _ in range(num_id_strings):
+        key, length = struct.unpack_from('<II', data, pos)
+        pos += 8
+        id_string = header.id_strings.add()
+        id_string.key = key
+        id_string.value = data[pos:pos + length].decode()
+        pos += length
+
+    if out_file.endswith('.gz'):
+        proto_out = gzip.open(out_file, 'wb')
+    else:
+        proto_out = open(out_file, 'wb')
+
+    # Write the magic number in 4-byte Little Endian, similar to what
+    # is done in src/proto/protoio.cc
+    proto_out.write(b'gem5')
+    protolib.encodeMessage(proto_out, header)
+
+    num_packets = 0
+    while pos < len(data):
+        magic, num_records, stored_size, raw_size = \
+            struct.unpack_from('<4I', data, pos)
+        if magic != BLOCK_MAGIC:
+            print("Corrupt block at offset", pos)
+            exit(-1)
+        pos += 16
+        payload = data[pos:pos + stored_size]
+        if compressed:
+            payload = zlib.decompress(payload)
+        pos += stored_size
+
+        for packet in decode_block(payload, num_records):
+            protolib.encodeMessage(proto_out, packet)
+        num_packets += num_records
+
+    proto_out.close()
+    print("Converted packets:", num_packets)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert packet traces between the protobuf and the "
+        "block based formats")
+    parser.add_argument("direction", choices=["to-block", "to-proto"],
+                        help="to-block converts a protobuf trace to the "
+                        "block format, to-proto the other way around")
+    parser.add_argument("input", help="Input trace")
+    parser.add_argument("output", help="Output trace")
+    parser.add_argument("--no-compress", action="store_true",
+                        help="Do not compress the blocks")
+    parser.add_argument("--block-records", type=int, default=4096,
+                        help="Number of packets per block")
+    args = parser.parse_args()
+
+    if args.direction == "to-block":
+        proto_to_block(args.input, args.output, not args.no_compress,
+                       args.block_records)
+    else:
+        block_to_proto(args.input, args.output)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2021 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Convert gem5 checkpoint files (m5.cpt) between the ini format and the
+# indexed binary format written by m5.checkpoint(dir, binary=True). The
+# format is described in src/base/binary_inifile.hh. gem5 detects both
+# formats on restore; converting to ini is mainly useful to inspect a
+# checkpoint or to run util/cpt_upgrader.py on it.
+#
+# Usage:
+#   cpt_binary.py [-o OUTPUT] (--to-binary | --to-ini) CHECKPOINT
+#
+# CHECKPOINT may be a checkpoint directory or an m5.cpt file. Without
+# -o the file is converted in place.
+
+import argparse
+import os.path as osp
+import shutil
+import struct
+import sys
+
+MAGIC = b"gem5bini"
+VERSION = 1
+BYTE_ORDER_MARKER = 0x01020304
+HEADER = struct.Struct("=8sIIQ")
+
+def is_binary(path):
+    with open(path, "rb") as f:
+        return f.read(len(MAGIC)) == MAGIC
+
+def read_ini(path):
+    """Parse an ini checkpoint the same way IniFile::load() does.
+    Returns a list of (section, [(key, value)]) in file order."""
+    sections = []
+    entries = None
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            if line[0] == "[" and line[-1] == "]":
+                entries = []
+                sections.append((line[1:-1].strip(), entries))
+                continue
+            if entries is None:
+                continue
+            key, sep, value = line.partition("=")
+            if not sep:
+                raise ValueError("Can't parse .ini line %s" % line)
+            if key.endswith("+"):
+                raise ValueError("Appending entries are not supported: %s"
+                                 % line)
+            entries.append((key.strip(), value.strip()))
+    return sections
+
+def read_binary(path):
+    """Read a binary checkpoint into the same structure as read_ini()."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    magic, version, marker, index_offset = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("%s is not a version %d binary checkpoint" %
+                         (path, VERSION))
+    if marker != BYTE_ORDER_MARKER:
+        raise ValueError("%s was written with a different byte order" % path)
+
+    def string(pos):
+        length, = struct.unpack_from("=I", data, pos)
+        pos += 4
+        return data[pos:pos + length].decode(), pos + length
+
+    pos = index_offset
+    count, = struct.unpack_from("=I", data, pos)
+    pos += 4
+    sections = []
+    for _ in range(count):
+        name, pos = string(pos)
+        offset, = struct.unpack_from("=Q", data, pos)
+        pos += 8
+
+        entries = []
+        nentries, = struct.unpack_from("=I", data, offset)
+        offset += 4
+        for _ in range(nentries):
+            key, offset = string(offset)
+            value, offset = string(offset)
+            entries.append((key, value))
+        sections.append((name, entries))
+    return sections
+
+def write_ini(path, sections):
+    with open(path, "w") as f:
+        for name, entries in sections:
+            f.write("\n[%s]\n" % name)
+            for key, value in entries:
+                f.write("%s=%s\n" % (key, value))
+
+def write_binary(path, sections):
+    def string(s):
+        b = s.encode()
+        return struct.pack("=I", len(b)) + b
+
+    with open(path, "wb") as f:
+        f.write(HEADER.pack(MAGIC, VERSION, BYTE_ORDER_MARKER, 0))
+        index = [struct.pack("=I", len(sections))]
+        for name, entries in sections:
+            index.append(string(name) + struct.pack("=Q", f.tell()))
+            f.write(struct.pack("=I", len(entries)))
+            for key, value in entries:
+                f.write(string(key) + string(value))
+        index_offset = f.tell()
+        f.write(b"".join(index))
+        f.seek(0)
+        f.write(HEADER.pack(MAGIC, VERSION, BYTE_ORDER_MARKER, index_offset))
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert gem5 checkpoints between the ini and the "
+        "binary m5.cpt formats")
+    group = parser.add_mutually_exclusive_group(required=True)
+    group.add_argument("--to-binary", action="store_true",
+                       help="Convert an ini checkpoint to binary")
+    group.add_argument("--to-ini", action="store_true",
+                       help="Convert a binary checkpoint to ini")
+    parser.add_argument("-o", "--output", default=None,
+                        help="Output file (default: convert in place)")
+    parser.add_argument("checkpoint",
+                        help="Checkpoint directory or m5.cpt file")
+    args = parser.parse_args()
+
+    src = args.checkpoint
+    if osp.isdir(src):
+        src = osp.join(src, "m5.cpt")
+    dst = args.output if args.output else src
+
+    binary = is_binary(src)
+    if binary == args.to_binary:
+        print("%s is already in the requested format" % src)
+        if dst != src:
+            shutil.copyfile(src, dst)
+    elif args.to_binary:
+        write_binary(dst, read_ini(src))
+    else:
+        write_ini(dst, read_binary(src))
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,593 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2021 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Render a binary debug trace, as written by gem5 when run with
+# --debug-format=binary, as the text gem5 would have printed.
+#
+# Usage: decode_debug_trace.py <binary trace> [<text output>]
+#
+# The formatting rules mirror cprintf (src/base/cprintf.cc and
+# src/base/cprintf_formats.hh), including its quirks, so that the output
+# can be diffed against a text trace of the same run.
+
+import argparse
+import gzip
+import struct
+import sys
+
+MAGIC = b'gem5dbt\0'
+VERSION = 1
+
+MAX_TICK = 2**64 - 1
+
+# Record types
+DEFINE_STRING = 1
+MESSAGE = 2
+TEXT = 3
+
+# Format bits
+SHOW_TICK = 0x1
+SHOW_FLAG = 0x2
+
+# Argument types, see Trace::EncodedArgs
+SIGNED, UNSIGNED, CHAR, BOOL, FLOAT, POINTER, STRING, ENUM = range(8)
+
+class Arg(object):
+    def __init__(self, kind, size, value=None, text=None):
+        self.kind = kind
+        self.size = size
+        self.value = value
+        self.text = text
+
+class Format(object):
+    # Formats
+    NONE, STRING, INTEGER, CHARACTER, FLOATING = range(5)
+    # Bases
+    DEC, HEX, OCT = range(3)
+    # Float formats
+    BEST, FIXED, SCIENTIFIC = range(3)
+
+    def __init__(self):
+        self.clear()
+
+    def clear(self):
+        self.alternate_form = False
+        self.flush_left = False
+        self.print_sign = False
+        self.blank_space = False
+        self.fill_zero = False
+        self.uppercase = False
+        self.base = Format.DEC
+        self.format = Format.NONE
+        self.float_format = Format.BEST
+        self.precision = -1
+        self.width = 0
+        self.get_precision = False
+        self.get_width = False
+
+class Stream(object):
+    """The bits of std::ostream state that cprintf relies on."""
+
+    def __init__(self):
+        self.out = []
+        self.precision = 6
+        self.reset()
+
+    def reset(self):
+        self.fill = ' '
+        self.width = 0
+        self.left = False
+        self.showbase = False
+        self.showpos = False
+        self.uppercase = False
+        self.base = Format.DEC
+        self.float_format = Format.BEST
+
+    def write(self, s):
+        self.out.append(s)
+
+    def pad(self, s):
+        width, self.width = self.width, 0
+        if width > len(s):
+            if self.left:
+                return s + self.fill * (width - len(s))
+            return self.fill * (width - len(s)) + s
+        return s
+
+    def integer(self, value, size, signed):
+        if self.base == Format.DEC:
+            if value < 0:
+                s = '-%d' % -value
+            elif signed and self.showpos:
+                s = '+%d' % value
+            else:
+                s = '%d' % value
+        else:
+            value &= (1 << (8 * size)) - 1
+            if self.base == Format.HEX:
+                s = ('%X' if self.uppercase else '%x') % value
+                if self.showbase and value:
+                    s = ('0X' if self.uppercase else '0x') + s
+            else:
+                s = '%o' % value
+                if self.showbase and value:
+                    s = '0' + s
+        self.write(self.pad(s))
+
+    def floating(self, value):
+        if self.float_format == Format.FIXED:
+            conv = 'f'
+        elif self.float_format == Format.SCIENTIFIC:
+            conv = 'e'
+        else:
+            conv = 'g'
+        if self.uppercase:
+            conv = conv.upper()
+        spec = '%' + ('+' if self.showpos else '') + '.*' + conv
+        self.write(self.pad(spec % (self.precision, value)))
+
+    def pointer(self, value):
+        self.write(self.pad('0x%x' % value if value else '0'))
+
+    def string(self, s):
+        self.write(self.pad(s))
+
+    def arg(self, arg):
+        """operator<< for a recorded argument"""
+        if arg.kind == CHAR:
+            self.string(chr(arg.value & 0xff))
+        elif arg.kind == BOOL:
+            self.integer(arg.value, 8, True)
+        elif arg.kind == SIGNED:
+            self.integer(arg.value, arg.size, True)
+        elif arg.kind == UNSIGNED:
+            self.integer(arg.value, arg.size, False)
+        elif arg.kind == ENUM:
+            # Enums without an operator<< are printed as integers
+            if arg.text == str(arg.value):
+                self.integer(arg.value, arg.size, True)
+            else:
+                self.string(arg.text)
+        elif arg.kind == FLOAT:
+            self.floating(arg.value)
+        elif arg.kind == POINTER:
+            self.pointer(arg.value)
+        else:
+            self.string(arg.text)
+
+def default_text(arg):
+    """What a freshly constructed stringstream would print for arg"""
+    stream = Stream()
+    stream.arg(arg)
+    return ''.join(stream.out)
+
+def format_char(stream, arg, fmt):
+    if arg.kind in (CHAR, SIGNED, UNSIGNED):
+        stream.write(chr(arg.value & 0xff))
+    else:
+        stream.write('<bad arg type for char format>')
+
+def format_integer(stream, arg, fmt):
+    if arg.kind == CHAR:
+        arg = Arg(SIGNED, 4, arg.value)
+
+    stream.base = fmt.base
+    if fmt.alternate_form:
+        if not fmt.fill_zero:
+            stream.showbase = True
+        elif fmt.base == Format.HEX:
+            stream.write('0x')
+            fmt.width -= 2
+        elif fmt.base == Format.OCT:
+            stream.write('0')
+            fmt.width -= 1
+    if fmt.fill_zero:
+        stream.fill = '0'
+    if fmt.width > 0:
+        stream.width = fmt.width
+    if fmt.flush_left and not fmt.fill_zero:
+        stream.left = True
+    if fmt.print_sign:
+        stream.showpos = True
+    if fmt.uppercase:
+        stream.uppercase = True
+
+    stream.arg(arg)
+
+    stream.base = Format.DEC
+    stream.showbase = stream.showpos = stream.uppercase = stream.left = False
+
+def format_float(stream, arg, fmt):
+    if arg.kind != FLOAT or arg.size > 8:
+        stream.write('<bad arg type for float format>')
+        return
+
+    if fmt.fill_zero:
+        stream.fill = '0'
+
+    if fmt.float_format == Format.BEST:
+        if fmt.precision != -1:
+            stream.precision = fmt.precision
+        if fmt.width > 0:
+            stream.width = fmt.width
+    else:
+        if fmt.precision != -1:
+            if fmt.width > 0:
+                stream.width = fmt.width
+            if fmt.float_format == Format.SCIENTIFIC and fmt.precision == 0:
+                fmt.precision = 1
+            else:
+                stream.float_format = fmt.float_format
+            stream.precision = fmt.precision
+        elif fmt.width > 0:
+            stream.width = fmt.width
+        if fmt.float_format == Format.SCIENTIFIC and fmt.uppercase:
+            stream.uppercase = True
+
+    stream.arg(arg)
+
+    stream.float_format = Format.BEST
+    stream.uppercase = False
+
+def format_string(stream, arg, fmt):
+    if fmt.width > 0:
+        text = default_text(arg)
+        if fmt.width > len(text):
+            spaces = ' ' * (fmt.width - len(text))
+            if fmt.flush_left:
+                stream.write(text + spaces)
+            else:
+                stream.write(spaces + text)
+            return
+    stream.arg(arg)
+
+class Print(object):
+    """A port of cp::Print"""
+
+    def __init__(self, fmt):
+        self.stream = Stream()
+        self.format = fmt
+        self.ptr = 0
+        self.cont = False
+        self.fmt = Format()
+
+    def char(self, offset=0):
+        pos = self.ptr + offset
+        return self.format[pos] if pos < len(self.format) else '\0'
+
+    def literal(self):
+        pos = self.ptr
+        end = len(self.format)
+        while pos < end and self.format[pos] not in '%\n\r':
+            pos += 1
+        self.stream.write(self.format[self.ptr:pos])
+        self.ptr = pos
+
+    def process(self):
+        self.fmt.clear()
+
+        while self.ptr < len(self.format):
+            c = self.char()
+            if c == '%':
+                if self.char(1) != '%':
+                    self.process_flag()
+                    return
+                self.stream.write('%')
+                self.ptr += 2
+            elif c == '\n':
+                self.stream.write('\n')
+                self.ptr += 1
+            elif c == '\r':
+                self.ptr += 1
+                if self.char() != '\n':
+                    self.stream.write('\n')
+            else:
+                self.literal()
+
+    def process_flag(self):
+        fmt = self.fmt
+        done = False
+        end_number = False
+        have_precision = False
+        number = 0
+
+        self.stream.reset()
+
+        while not done:
+            self.ptr += 1
+            c = self.char()
+            if '0' <= c <= '9':
+                if end_number:
+                    continue
+            elif number > 0:
+                end_number = True
+
+            if c == 's':
+                fmt.format = Format.STRING
+                done = True
+            elif c == 'c':
+                fmt.format = Format.CHARACTER
+                done = True
+            elif c == 'l':
+                continue
+            elif c == 'p':
+                fmt.format = Format.INTEGER
+                fmt.base = Format.HEX
+                fmt.alternate_form = True
+                done = True
+            elif c in 'xX':
+                fmt.uppercase = fmt.uppercase or c == 'X'
+                fmt.base = Format.HEX
+                fmt.format = Format.INTEGER
+                done = True
+            elif c == 'o':
+                fmt.base = Format.OCT
+                fmt.format = Format.INTEGER
+                done = True
+            elif c in 'diu':
+                fmt.format = Format.INTEGER
+                done = True
+            elif c in 'gG':
+                fmt.uppercase = fmt.uppercase or c == 'G'
+                fmt.format = Format.FLOATING
+                fmt.float_format = Format.BEST
+                done = True
+            elif c in 'eE':
+                fmt.uppercase = fmt.uppercase or c == 'E'
+                fmt.format = Format.FLOATING
+                fmt.float_format = Format.SCIENTIFIC
+                done = True
+            elif c == 'f':
+                fmt.format = Format.FLOATING
+                fmt.float_format = Format.FIXED
+                done = True
+            elif c == 'n':
+                self.stream.write("we don't do %n!!!\n")
+                done = True
+            elif c == '#':
+                fmt.alternate_form = True
+            elif c == '-':
+                fmt.flush_left = True
+            elif c == '+':
+                fmt.print_sign = True
+            elif c == ' ':
+                fmt.blank_space = True
+            elif c == '.':
+                fmt.width = number
+                fmt.precision = 0
+                have_precision = True
+                number = 0
+                end_number = False
+            elif c == '0' and number == 0:
+                fmt.fill_zero = True
+            elif '0' <= c <= '9':
+                number = number * 10 + ord(c) - ord('0')
+            elif c == '*':
+                if have_precision:
+                    fmt.get_precision = True
+                else:
+                    fmt.get_width = True
+            else:
+                done = True
+
+            if end_number:
+                if have_precision:
+                    fmt.precision = number
+                else:
+                    fmt.width = number
+                end_number = False
+                number = 0
+
+            if done:
+                if fmt.format == Format.INTEGER and have_precision:
+                    fmt.width = fmt.precision
+                    fmt.fill_zero = True
+                elif (fmt.format == Format.FLOATING and not have_precision
+                        and fmt.fill_zero):
+                    fmt.precision = fmt.width
+
+        self.ptr += 1
+
+    def add_arg(self, arg):
+        if not self.cont:
+            self.process()
+
+        fmt = self.fmt
+        if fmt.get_width or fmt.get_precision:
+            # Only int arguments are taken as numbers
+            number = arg.value if arg.kind == SIGNED and arg.size == 4 else 0
+            if fmt.get_width:
+                fmt.get_width = False
+                fmt.width = number
+            else:
+                fmt.get_precision = False
+                fmt.precision = number
+            self.cont = True
+            return
+
+        if fmt.format == Format.CHARACTER:
+            format_char(self.stream, arg, fmt)
+        elif fmt.format == Format.INTEGER:
+            format_integer(self.stream, arg, fmt)
+        elif fmt.format == Format.FLOATING:
+            format_float(self.stream, arg, fmt)
+        elif fmt.format == Format.STRING:
+            format_string(self.stream, arg, fmt)
+        else:
+            self.stream.write('<bad format>')
+
+    def end_args(self):
+        while self.ptr < len(self.format):
+            c = self.char()
+            if c == '%':
+                if self.char(1) != '%':
+                    self.stream.write('<extra arg>')
+                self.stream.write('%')
+                self.ptr += 2
+            elif c == '\n':
+                self.stream.write('\n')
+                self.ptr += 1
+            elif c == '\r':
+                self.ptr += 1
+                if self.char() != '\n':
+                    self.stream.write('\n')
+            else:
+                self.literal()
+
+def cprintf(fmt, args):
+    printer = Print(fmt)
+    for arg in args:
+        printer.add_arg(arg)
+    printer.end_args()
+    return ''.join(printer.stream.out)
+
+class Reader(object):
+    def __init__(self, f):
+        self.f = f
+
+    def read(self, size):
+        data = self.f.read(size)
+        if len(data) != size:
+            raise EOFError
+        return data
+
+    def unpack(self, fmt):
+        return struct.unpack(fmt, self.read(struct.calcsize(fmt)))
+
+    def string(self, size):
+        # Latin-1 maps every byte to one character and back
+        return self.read(size).decode('latin-1')
+
+def decode_args(data, count):
+    args = []
+    pos = 0
+    for _ in range(count):
+        kind, size = struct.unpack_from('<BB', data, pos)
+        pos += 2
+        if kind == STRING:
+            length, = struct.unpack_from('<I', data, pos)
+            pos += 4
+            args.append(Arg(kind, size,
+                            text=data[pos:pos + length].decode('latin-1')))
+            pos += length
+            continue
+
+        if kind in (SIGNED, CHAR, ENUM):
+            value, = struct.unpack_from('<q', data, pos)
+        elif kind == FLOAT:
+            value, = struct.unpack_from('<d', data, pos)
+        else:
+            value, = struct.unpack_from('<Q', data, pos)
+        pos += 8
+
+        arg = Arg(kind, size, value)
+        if kind == ENUM:
+            length, = struct.unpack_from('<I', data, pos)
+            pos += 4
+            arg.text = data[pos:pos + length].decode('latin-1')
+            pos += length
+        args.append(arg)
+    return args
+
+def records(path):
+    opener = gzip.open if path.endswith('.gz') else open
+    with opener(path, 'rb') as f:
+        reader = Reader(f)
+        try:
+            magic = reader.read(len(MAGIC))
+            version, = reader.unpack('<I')
+        except EOFError:
+            magic = None
+        if magic != MAGIC:
+            sys.exit('%s is not a binary debug trace' % path)
+        if version != VERSION:
+            sys.exit('Unsupported binary debug trace version %d' % version)
+
+        while True:
+            try:
+                kind = reader.read(1)[0]
+            except EOFError:
+                return
+            if kind == DEFINE_STRING:
+                sid, length = reader.unpack('<II')
+                yield kind, (sid, reader.string(length))
+            elif kind == MESSAGE:
+                bits, when, name, flag, fmt, count, length = \
+                    reader.unpack('<BQIIIBI')
+                yield kind, (bits, when, name, flag, fmt, count,
+                             reader.read(length))
+            elif kind == TEXT:
+                bits, when, name, flag, length = reader.unpack('<BQIII')
+                yield kind, (bits, when, name, flag, reader.string(length))
+            else:
+                sys.exit('Corrupt binary debug trace, unknown record %d' %
+                         kind)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Render a binary gem5 debug trace as text.')
+    parser.add_argument('input', help='binary trace, may be gzipped')
+    parser.add_argument('output', nargs='?',
+                        help='text output [default: stdout]')
+    args = parser.parse_args()
+
+    # Threads may use a string before the record defining it is written
+    # out, so collect all definitions first.
+    strings = { 0: '' }
+    for kind, record in records(args.input):
+        if kind == DEFINE_STRING:
+            strings[record[0]] = record[1]
+
+    if args.output:
+        out = open(args.output, 'w', encoding='latin-1', newline='')
+    else:
+        out = open(sys.stdout.fileno(), 'w', encoding='latin-1',
+                   newline='', closefd=False)
+
+    with out:
+        for kind, record in records(args.input):
+            if kind == MESSAGE:
+                bits, when, name, flag, fmt, count, data = record
+                message = cprintf(strings[fmt], decode_args(data, count))
+            elif kind == TEXT:
+                bits, when, name, flag, message = record
+            else:
+                continue
+
+            name = strings[name]
+            flag = strings[flag]
+            if bits & SHOW_TICK and when != MAX_TICK:
+                out.write('%7d: ' % when)
+            if bits & SHOW_FLAG and flag:
+                out.write(flag + ': ')
+            if name:
+                out.write(name + ': ')
+            out.write(message)
+
+if __name__ == '__main__':
+    main()
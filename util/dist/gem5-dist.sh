@@ -317,14 +317,19 @@ start_func "switch" $SW_HOST "$ENV_ARGS" $GEM5_EXE -d $RUN_DIR/m5out.switch   \
           --dist-server-port=$SW_PORT
 SW_PID=$!
 
-# block here till switch process starts
-connected $RUN_DIR/log.switch "tcp_iface listening on port" "switch" $SW_PID
-LINE=$(grep -r "tcp_iface listening on port" $RUN_DIR/log.switch)
+# block here till switch process starts (with the shm transport the
+# nodes wait for the switch to attach to their links themselves)
+if ! echo "$SW_ARGS $CF_ARGS" | grep -q -e "--dist-transport[= ]shm"
+then
+    connected $RUN_DIR/log.switch "tcp_iface listening on port" "switch" \
+        $SW_PID
+    LINE=$(grep -r "tcp_iface listening on port" $RUN_DIR/log.switch)
 
-IFS=' ' read -ra ADDR <<< "$LINE"
-# actual port that switch is listening on may be different
-# from what we specified if the port was busy
-SW_PORT=${ADDR[5]}
+    IFS=' ' read -ra ADDR <<< "$LINE"
+    # actual port that switch is listening on may be different
+    # from what we specified if the port was busy
+    SW_PORT=${ADDR[5]}
+fi
 
 # Now launch all the gem5 processes with ssh.
 echo "START $(date)"
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2021 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script plots the utilization trace written by a GarnetNetwork
+# with the utilization_trace parameter set (--garnet-utilization-trace
+# in configs/network/Network.py). It draws two heatmaps: the flits
+# through each router laid out on the rows of the mesh, either for the
+# whole run or for a single sample, and the flits over each link for
+# every sample. The trace is read in the byte order of this host.
+
+import argparse
+import gzip
+import struct
+import sys
+
+try:
+    import matplotlib
+    matplotlib.use('Agg')
+    import matplotlib.pyplot as plt
+    import numpy as np
+except ImportError:
+    print("Failed to import matplotlib and numpy")
+    sys.exit(-1)
+
+MAGIC = b'GARNETUT'
+LINK_TYPES = ['ext_in', 'ext_out', 'int']
+
+def read_exact(f, size):
+    data = f.read(size)
+    if len(data) != size:
+        raise EOFError
+    return data
+
+def read_trace(path):
+    opener = gzip.open if path.endswith('.gz') else open
+    with opener(path, 'rb') as f:
+        if read_exact(f, len(MAGIC)) != MAGIC:
+            sys.exit("%s is not a garnet utilization trace" % path)
+        version, rows, routers, links, interval = \
+            struct.unpack('=IiIIQ', read_exact(f, 24))
+        if version != 1:
+            sys.exit("Unsupported trace version %d" % version)
+
+        ends = [struct.unpack('=iiI', read_exact(f, 12))
+                for _ in range(links)]
+
+        record = struct.Struct('=Q%dI' % (links + routers))
+        ticks, samples = [], []
+        while True:
+            try:
+                values = record.unpack(read_exact(f, record.size))
+            except EOFError:
+                break
+            ticks.append(values[0])
+            samples.append(values[1:])
+
+    samples = np.array(samples, dtype=np.uint64).reshape(-1,
+                                                         links + routers)
+    return {
+        'rows' : rows,
+        'interval' : interval,
+        'ends' : ends,
+        'ticks' : np.array(ticks, dtype=np.uint64),
+        'links' : samples[:, :links],
+        'routers' : samples[:, links:],
+    }
+
+def link_label(end):
+    src, dst, kind = end
+    src = 'ni' if src < 0 else 'r%d' % src
+    dst = 'ni' if dst < 0 else 'r%d' % dst
+    return '%s->%s (%s)' % (src, dst, LINK_TYPES[kind])
+
+def plot_routers(ax, trace, sample):
+    routers = trace['routers']
+    flits = routers.sum(axis=0) if sample is None else routers[sample]
+    # Average over the run so both modes have the same unit
+    if sample is None:
+        flits = flits / float(len(routers))
+
+    rows = trace['rows']
+    if rows <= 0 or len(flits) % rows:
+        rows = 1
+    grid = np.asarray(flits, dtype=float).reshape(rows, -1)
+
+    im = ax.imshow(grid, cmap='hot', interpolation='nearest')
+    ax.set_xlabel('Column')
+    ax.set_ylabel('Row')
+    ax.set_title('Router crossbar flits per sample' +
+                 ('' if sample is None else ' (sample %d)' % sample))
+    for (r, c), value in np.ndenumerate(grid):
+        ax.text(c, r, '%d' % (r * grid.shape[1] + c), ha='center',
+                va='center', color='grey', fontsize=6)
+    plt.colorbar(im, ax=ax)
+
+def plot_links(ax, trace, int_only):
+    links = trace['links']
+    select = [i for i, end in enumerate(trace['ends'])
+              if not int_only or end[2] == 2]
+    im = ax.imshow(links[:, select].T.astype(float), cmap='hot',
+                   aspect='auto', interpolation='nearest')
+    ax.set_xlabel('Sample (%d ticks each)' % trace['interval'])
+    ax.set_ylabel('Link')
+    ax.set_title('Link flits per sample')
+    if len(select) <= 64:
+        ax.set_yticks(range(len(select)))
+        ax.set_yticklabels([link_label(trace['ends'][i]) for i in select],
+                           fontsize=5)
+    plt.colorbar(im, ax=ax)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Plot a garnet utilization trace as heatmaps.")
+    parser.add_argument('trace', help="utilization trace file")
+    parser.add_argument('output', help="image file to write, e.g. out.png")
+    parser.add_argument('--sample', type=int, default=None,
+                        help="plot the routers for this sample only "
+                        "instead of the average over the run")
+    parser.add_argument('--int-links', action='store_true',
+                        help="only plot the router to router links")
+    args = parser.parse_args()
+
+    trace = read_trace(args.trace)
+    if not len(trace['ticks']):
+        sys.exit("The trace does not contain any samples")
+    if args.sample is not None and \
+            not 0 <= args.sample < len(trace['ticks']):
+        sys.exit("The trace only contains %d samples" %
+                 len(trace['ticks']))
+
+    fig, (router_ax, link_ax) = plt.subplots(
+        1, 2, figsize=(14, 6), gridspec_kw={'width_ratios' : [1, 2]})
+    plot_routers(router_ax, trace, args.sample)
+    plot_links(link_ax, trace, args.int_links)
+    fig.tight_layout()
+    fig.savefig(args.output, dpi=150)
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2021 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Host performance regression suite.
+#
+# Runs the MiBench programs in benchmarks/ on every combination of the
+# selected CPU models and memory systems, and records how fast the
+# simulator ran each of them on this host: simulated instructions per
+# host second, events per host second and the peak resident set size of
+# the gem5 process. The results are written as JSON. If a baseline from
+# an earlier run is given, each configuration is compared with it and
+# the script exits with a non-zero status if any of them regressed by
+# more than the threshold.
+#
+# The Ruby configurations need a binary built with
+# PROTOCOL=MESI_Two_Level, passed with --gem5-ruby; they are skipped if
+# it is not given. Host throughput depends on the host and on the
+# build, so a baseline is only meaningful for the machine and build
+# variant that produced it.
+#
+# Typical use:
+#
+#   util/host-perf.py --gem5 build/ARM/gem5.opt \
+#       --gem5-ruby build/ARM_MESI_Two_Level/gem5.opt \
+#       --output baseline.json
+#   util/host-perf.py --gem5 build/ARM/gem5.opt \
+#       --gem5-ruby build/ARM_MESI_Two_Level/gem5.opt \
+#       --baseline baseline.json --output results.json
+
+import argparse
+import json
+import os
+import platform
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+bench_dir = os.path.join(root, 'benchmarks')
+se_script = os.path.join(root, 'configs', 'example', 'se.py')
+
+# Program and arguments of each benchmark, relative to benchmarks/.
+benchmarks = {
+    'basicmath': ('basicmath/basicmath_small', []),
+    'qsort': ('qsort/qsort_small', ['qsort/input_small.dat']),
+    'dijkstra': ('dijkstra/dijkstra_small', ['dijkstra/input.dat']),
+    'fft': ('FFT/fft', ['4', '4096']),
+}
+
+cpu_types = [ 'AtomicSimpleCPU', 'TimingSimpleCPU', 'MinorCPU', 'DerivO3CPU' ]
+
+# se.py options of each memory system, and whether it needs the Ruby
+# binary.
+memory_systems = {
+    'classic': (['--caches', '--l2cache'], False),
+    'ruby': (['--ruby'], True),
+    'garnet': (['--ruby', '--network=garnet'], True),
+}
+
+# Metrics kept for each run. Rates regress when they drop, sizes when
+# they grow.
+rate_metrics = [ 'hostInstRate', 'hostEventRate' ]
+size_metrics = [ 'peakRSS' ]
+stat_names = [ 'simInsts', 'hostSeconds', 'hostInstRate', 'hostEvents',
+               'hostEventRate' ]
+
+def parse_stats(path):
+    """Return the selected statistics of the first dump in a stats.txt."""
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            if line.startswith('---------- End Simulation Statistics'):
+                break
+            fields = line.split()
+            if len(fields) >= 2 and fields[0] in stat_names:
+                stats[fields[0]] = float(fields[1])
+    return stats
+
+def run_one(gem5, outdir, bench, cpu, mem_opts, maxinsts):
+    prog, prog_args = benchmarks[bench]
+    cmd = [ gem5, '--outdir=' + outdir, se_script,
+            '--cpu-type=' + cpu,
+            '--cmd=' + os.path.join(bench_dir, prog) ]
+    if prog_args:
+        cmd.append('--options=' + ' '.join(
+            os.path.join(bench_dir, a) if '/' in a else a
+            for a in prog_args))
+    if maxinsts:
+        cmd.append('--maxinsts=%d' % maxinsts)
+    cmd += mem_opts
+
+    with open(os.path.join(outdir, 'host-perf.log'), 'w') as log:
+        start = time.time()
+        proc = subprocess.Popen(cmd, stdout=log, stderr=subprocess.STDOUT)
+        # wait4 returns the resource usage of this child alone, unlike
+        # getrusage(RUSAGE_CHILDREN) which keeps the largest of all.
+        _, status, usage = os.wait4(proc.pid, 0)
+        wall = time.time() - start
+
+    if not os.WIFEXITED(status) or os.WEXITSTATUS(status) != 0:
+        raise RuntimeError("'%s' failed, see %s" %
+                           (' '.join(cmd), log.name))
+
+    stats = parse_stats(os.path.join(outdir, 'stats.txt'))
+    missing = [ s for s in stat_names if s not in stats ]
+    if missing:
+        raise RuntimeError("%s lacks %s" % (os.path.join(outdir, 'stats.txt'),
+                                            ', '.join(missing)))
+    # ru_maxrss is in KiB on Linux.
+    stats['peakRSS'] = usage.ru_maxrss * 1024
+    stats['wallSeconds'] = wall
+    return stats
+
+def run_config(args, gem5, bench, cpu, mem):
+    mem_opts, _ = memory_systems[mem]
+    runs = []
+    for i in range(args.repeat):
+        with tempfile.TemporaryDirectory(prefix='host-perf-') as outdir:
+            runs.append(run_one(gem5, outdir, bench, cpu, mem_opts,
+                                args.maxinsts))
+
+    # The median is less sensitive than the mean to the occasional run
+    # that gets descheduled by the host.
+    result = { k : statistics.median(r[k] for r in runs) for k in runs[0] }
+    result['runs'] = len(runs)
+    return result
+
+def compare(results, baseline, threshold):
+    """Print the change of each metric and return the regressions."""
+    regressions = []
+    for name in sorted(results):
+        if name not in baseline:
+            print("%-40s no baseline" % name)
+            continue
+        cur, base = results[name], baseline[name]
+        changes = []
+        for metric in rate_metrics + size_metrics:
+            if not base.get(metric):
+                continue
+            change = cur[metric] / base[metric] - 1
+            changes.append('%s %+.1f%%' % (metric, change * 100))
+            worse = -change if metric in rate_metrics else change
+            if worse > threshold:
+                regressions.append((name, metric, change))
+        print("%-40s %s" % (name, ', '.join(changes)))
+    return regressions
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Measure the host performance of gem5 on the "
+                    "MiBench programs and compare it with a baseline.")
+    parser.add_argument('--gem5', required=True,
+                        help="gem5 binary used for the classic memory "
+                             "system")
+    parser.add_argument('--gem5-ruby',
+                        help="gem5 binary built with "
+                             "PROTOCOL=MESI_Two_Level for the Ruby and "
+                             "Garnet memory systems")
+    parser.add_argument('--benchmarks', nargs='+', default=list(benchmarks),
+                        choices=list(benchmarks))
+    parser.add_argument('--cpus', nargs='+', default=cpu_types,
+                        choices=cpu_types)
+    parser.add_argument('--memory', nargs='+', default=list(memory_systems),
+                        choices=list(memory_systems))
+    parser.add_argument('--repeat', type=int, default=3,
+                        help="runs of each configuration, the median "
+                             "is reported (default: %(default)s)")
+    parser.add_argument('--maxinsts', type=int, default=0,
+                        help="stop each run after this many instructions")
+    parser.add_argument('--output', '-o',
+                        help="write the results to this JSON file")
+    parser.add_argument('--baseline', '-b',
+                        help="JSON results of an earlier run to compare with")
+    parser.add_argument('--threshold', type=float, default=0.1,
+                        help="relative change counted as a regression "
+                             "(default: %(default)s)")
+    args = parser.parse_args()
+
+    results = {}
+    for mem in args.memory:
+        needs_ruby = memory_systems[mem][1]
+        gem5 = args.gem5_ruby if needs_ruby else args.gem5
+        if not gem5:
+            print("Skipping %s, no --gem5-ruby binary given" % mem)
+            continue
+        for cpu in args.cpus:
+            for bench in args.benchmarks:
+                name = '/'.join((bench, cpu, mem))
+                print("Running %s" % name, flush=True)
+                results[name] = run_config(args, os.path.abspath(gem5),
+                                           bench, cpu, mem)
+
+    report = {
+        'host': platform.node(),
+        'machine': platform.machine(),
+        'processor': platform.processor(),
+        'gem5': os.path.abspath(args.gem5),
+        'gem5_ruby':
+            os.path.abspath(args.gem5_ruby) if args.gem5_ruby else None,
+        'time': time.strftime('%Y-%m-%dT%H:%M:%S'),
+        'results': results,
+    }
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+
+    if not args.baseline:
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    if baseline.get('host') != report['host']:
+        print("Warning: the baseline was measured on %s" %
+              baseline.get('host'))
+    regressions = compare(results, baseline['results'], args.threshold)
+    for name, metric, change in regressions:
+        print("Regression: %s %s changed by %+.1f%%" %
+              (name, metric, change * 100))
+    return 1 if regressions else 0
+
+if __name__ == '__main__':
+    sys.exit(main())